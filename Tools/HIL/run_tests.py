@@ -172,6 +172,9 @@ class TestHardwareMethods(unittest.TestCase):
     def test_List(self):
         self.assertTrue(do_test(self.TEST_DEVICE, self.TEST_BAUDRATE, "List"))
 
+    def test_LockFreeByteRing(self):
+        self.assertTrue(do_test(self.TEST_DEVICE, self.TEST_BAUDRATE, "LockFreeByteRing"))
+
     def test_mathlib(self):
         self.assertTrue(do_test(self.TEST_DEVICE, self.TEST_BAUDRATE, "mathlib"))
 
@@ -10,6 +10,7 @@ Stream ULog data over MAVLink.
 from __future__ import print_function
 import sys, select, os
 import datetime
+from collections import deque
 from timeit import default_timer as timer
 os.environ['MAVLINK20'] = '1' # The commands require mavlink 2
 from argparse import ArgumentParser
@@ -31,8 +32,12 @@ class LoggingCompleted(Exception):
 class MavlinkLogStreaming():
     '''Streams log data via MAVLink.
        Assumptions:
-       - the sender only sends one acked message at a time
+       - the sender can have multiple acked messages in flight (MAV_ULOG_WIN),
+         they are reordered by sequence number before writing
        - the data is in the ULog format '''
+
+    PENDING_TIMEOUT = 3 # [s] give up waiting for a missing acked message after this time
+
     def __init__(self, portname, baudrate, output_filename, debug=0):
         self.baudrate = 0
         self._debug = debug
@@ -51,6 +56,8 @@ class MavlinkLogStreaming():
         self.last_sequence = -1
         self.logging_started = False
         self.num_dropouts = 0
+        self.pending_acked = {} # sequence -> (message, receive time) of out-of-order acked messages
+        self.ready = deque() # (data, first message start, num dropouts) in sequence order
         self.target_component = 1
         self.got_sig_int = False
 
@@ -121,6 +128,15 @@ class MavlinkLogStreaming():
     def read_message(self):
         ''' read a single mavlink message, handle ACK & return a tuple of (data, first
         message start, num dropouts) '''
+        if self.ready:
+            return self.ready.popleft()
+
+        if self.pending_acked and min(t for _, t in self.pending_acked.values()) < \
+                timer() - self.PENDING_TIMEOUT:
+            self.debug('timeout waiting for acked message '+str((self.last_sequence + 1) & 0xffff))
+            self.flush_pending_acked()
+            return self.next_ready()
+
         m = self.mav.recv_match(type=['LOGGING_DATA_ACKED',
                             'LOGGING_DATA', 'COMMAND_ACK'], blocking=True,
                             timeout=0.05)
@@ -149,25 +165,58 @@ class MavlinkLogStreaming():
                 self.mav.mav.logging_ack_send(self.mav.target_system,
                         self.target_component, m.sequence)
 
-            if is_newer:
-                if num_drops > 0:
-                    self.num_dropouts += num_drops
+            if not is_newer or m.sequence in self.pending_acked:
+                self.debug('dup/reordered message '+str(m.sequence))
+
+            elif m.get_type() == 'LOGGING_DATA_ACKED' and (num_drops > 0 or
+                    (self.last_sequence == -1 and m.sequence != 0)):
+                # an earlier acked message is missing, the sender re-sends it
+                # (the log starts with sequence 0)
+                self.pending_acked[m.sequence] = (m, timer())
 
+            else:
                 if m.get_type() == 'LOGGING_DATA':
+                    # all the acked data is sent before the first unacked message
+                    self.flush_pending_acked()
+                    is_newer, num_drops = self.check_sequence(m.sequence)
                     if not self.got_header_section:
                         print('Header received in {:0.2f}s (size: {:.1f} KB)'.format(
                               timer()-self.start_time, self.file.tell()/1024))
                         self.logging_started = True
                         self.got_header_section = True
-                self.last_sequence = m.sequence
-                return m.data[:m.length], m.first_message_offset, num_drops
+                self.add_ready(m, num_drops)
+
+                # messages that were waiting for this one
+                while (self.last_sequence + 1) & 0xffff in self.pending_acked:
+                    pending, _ = self.pending_acked.pop((self.last_sequence + 1) & 0xffff)
+                    self.add_ready(pending, 0)
+
+        return self.next_ready()
 
-            else:
-                self.debug('dup/reordered message '+str(m.sequence))
 
+    def next_ready(self):
+        if self.ready:
+            return self.ready.popleft()
         return None, 0, 0
 
 
+    def add_ready(self, m, num_drops):
+        if num_drops > 0:
+            self.num_dropouts += num_drops
+        self.last_sequence = m.sequence
+        self.ready.append((m.data[:m.length], m.first_message_offset, num_drops))
+
+
+    def flush_pending_acked(self):
+        ''' give up on missing acked messages and use the received ones in sequence order '''
+        sequences = sorted(self.pending_acked.keys(),
+                key=lambda seq: (seq - self.last_sequence) & 0xffff)
+        for seq in sequences:
+            _, num_drops = self.check_sequence(seq)
+            pending, _ = self.pending_acked.pop(seq)
+            self.add_ready(pending, num_drops)
+
+
     def check_sequence(self, seq):
         ''' check if a sequence is newer than the previously received one & if
         there were dropped messages between the last and this '''
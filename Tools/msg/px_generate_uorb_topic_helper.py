@@ -277,6 +277,34 @@ def add_padding_bytes(fields, search_path):
     return (struct_size, num_padding_bytes)
 
 
+def get_struct_offsets(msg_fields, search_path, name_prefix='', base_offset=0):
+    """
+    Get the offsets of all (flattened) builtin fields within the generated
+    uORB struct, which uses sorted fields and padding (see add_padding_bytes)
+    returns a dict of field name (e.g. 'esc[0].esc_rpm') to byte offset
+    """
+    sorted_fields = sorted(msg_fields, key=sizeof_field_type, reverse=True)
+    add_padding_bytes(sorted_fields, search_path)
+    offsets = {}
+    offset = base_offset
+    for field in sorted_fields:
+        if field.is_header:
+            continue
+        array_size = field.array_len if field.is_array else 1
+        if field.is_builtin:
+            offsets[name_prefix + field.name] = offset
+        else:
+            children_fields = get_children_fields(field.base_type, search_path)
+            for i in range(array_size):
+                sub_name_prefix = name_prefix + field.name
+                if array_size > 1:
+                    sub_name_prefix += '[' + str(i) + ']'
+                offsets.update(get_struct_offsets(children_fields, search_path, sub_name_prefix + '.',
+                                                  offset + i * field.sizeof_field_type))
+        offset += field.sizeof_field_type * array_size
+    return offsets
+
+
 def convert_type(spec_type, use_short_type=False):
     """
     Convert from msg type to C type
@@ -301,6 +329,17 @@ def convert_type(spec_type, use_short_type=False):
     return c_type
 
 
+def constant_value(constant):
+    """
+    C literal of a constant: integers as before, floating point constants (e.g. fixed point scales) keep their value
+    """
+    if constant.type == 'float32':
+        return repr(float(constant.val)) + 'f'
+    elif constant.type == 'float64':
+        return repr(float(constant.val))
+    return str(int(constant.val))
+
+
 def print_field_def(field):
     """
     Print the C type from a field
@@ -96,6 +96,21 @@ def add_fields(msg_fields, name_prefix='', offset=0):
 
 fields, struct_size = add_fields(spec.parsed_fields())
 
+# group consecutive fields that are contiguous in CDR and have the same relative layout in the uORB
+# struct (fields are sorted by size in the struct), so that each group is copied with a single memcpy
+struct_offsets = get_struct_offsets(spec.parsed_fields(), search_path)
+blocks = []
+cdr_offset = 0
+for field_type, field_name, field_size, padding in fields:
+	cdr_offset += padding
+	block = blocks[-1] if blocks else None
+	if block is None or padding > 0 or struct_offsets[field_name] - block['struct_offset'] != cdr_offset - block['cdr_offset']:
+		block = {'padding': padding, 'cdr_offset': cdr_offset, 'struct_offset': struct_offsets[field_name], 'fields': []}
+		blocks.append(block)
+	block['fields'].append((field_type, field_name, field_size, cdr_offset - block['cdr_offset']))
+	cdr_offset += field_size
+	block['size'] = cdr_offset - block['cdr_offset']
+
 }@
 
 // auto-generated file
@@ -103,6 +118,7 @@ fields, struct_size = add_fields(spec.parsed_fields())
 #pragma once
 
 #include <ucdr/microcdr.h>
+#include <stddef.h>
 #include <string.h>
 #include <uORB/topics/@(topic).h>
 
@@ -128,26 +144,26 @@ static inline bool ucdr_serialize_@(topic)(const void* data, ucdrBuffer& buf, in
 {
 	const @(uorb_struct)& topic = *static_cast<const @(uorb_struct)*>(data);
 @{
-for field_type, field_name, field_size, padding in fields:
-	if padding > 0:
-		print('\tbuf.iterator += {:}; // padding'.format(padding))
-		print('\tbuf.offset += {:}; // padding'.format(padding))
-
-	print('\tstatic_assert(sizeof(topic.{0}) == {1}, "size mismatch");'.format(field_name, field_size))
+for block in blocks:
+	if block['padding'] > 0:
+		print('\tbuf.iterator += {:}; // padding'.format(block['padding']))
+		print('\tbuf.offset += {:}; // padding'.format(block['padding']))
 
-	if field_type == 'uint64' and field_name == 'timestamp':
-		print('\tconst uint64_t timestamp_adjusted = topic.timestamp + time_offset;')
-		print('\tmemcpy(buf.iterator, &timestamp_adjusted, sizeof(topic.{0}));'.format(field_name))
+	first_field = block['fields'][0][1]
+	for field_type, field_name, field_size, offset in block['fields']:
+		print('\tstatic_assert(sizeof(topic.{0}) == {1}, "size mismatch");'.format(field_name, field_size))
+		if offset > 0:
+			print('\tstatic_assert(offsetof({0}, {1}) - offsetof({0}, {2}) == {3}, "layout mismatch");'.format(uorb_struct, field_name, first_field, offset))
 
-	elif field_type == 'uint64' and field_name == 'timestamp_sample':
-		print('\tconst uint64_t timestamp_sample_adjusted = topic.timestamp_sample + time_offset;')
-		print('\tmemcpy(buf.iterator, &timestamp_sample_adjusted, sizeof(topic.{0}));'.format(field_name))
+	print('\tmemcpy(buf.iterator, &topic.{0}, {1});'.format(first_field, block['size']))
 
-	else:
-		print('\tmemcpy(buf.iterator, &topic.{0}, sizeof(topic.{0}));'.format(field_name))
+	for field_type, field_name, field_size, offset in block['fields']:
+		if field_type == 'uint64' and (field_name == 'timestamp' or field_name == 'timestamp_sample'):
+			print('\tconst uint64_t {0}_adjusted = topic.{0} + time_offset;'.format(field_name))
+			print('\tmemcpy(buf.iterator + {0}, &{1}_adjusted, sizeof(topic.{1}));'.format(offset, field_name))
 
-	print('\tbuf.iterator += sizeof(topic.{:});'.format(field_name))
-	print('\tbuf.offset += sizeof(topic.{:});'.format(field_name))
+	print('\tbuf.iterator += {:};'.format(block['size']))
+	print('\tbuf.offset += {:};'.format(block['size']))
 
 }@
 	return true;
@@ -156,20 +172,26 @@ for field_type, field_name, field_size, padding in fields:
 static inline bool ucdr_deserialize_@(topic)(ucdrBuffer& buf, @(uorb_struct)& topic, int64_t time_offset = 0)
 {
 @{
-for field_type, field_name, field_size, padding in fields:
-	if padding > 0:
-		print('\tbuf.iterator += {:}; // padding'.format(padding))
-		print('\tbuf.offset += {:}; // padding'.format(padding))
-
-	print('\tstatic_assert(sizeof(topic.{0}) == {1}, "size mismatch");'.format(field_name, field_size))
-	print('\tmemcpy(&topic.{0}, buf.iterator, sizeof(topic.{0}));'.format(field_name))
-
-	if field_type == 'uint64' and (field_name == 'timestamp' or field_name == 'timestamp_sample'):
-		print('\tif (topic.{0} == 0) topic.{0} = hrt_absolute_time();'.format(field_name, field_name))
-		print('\telse topic.{0} = math::min(topic.{0} - time_offset, hrt_absolute_time());'.format(field_name, field_name))
-
-	print('\tbuf.iterator += sizeof(topic.{:});'.format(field_name))
-	print('\tbuf.offset += sizeof(topic.{:});'.format(field_name))
+for block in blocks:
+	if block['padding'] > 0:
+		print('\tbuf.iterator += {:}; // padding'.format(block['padding']))
+		print('\tbuf.offset += {:}; // padding'.format(block['padding']))
+
+	first_field = block['fields'][0][1]
+	for field_type, field_name, field_size, offset in block['fields']:
+		print('\tstatic_assert(sizeof(topic.{0}) == {1}, "size mismatch");'.format(field_name, field_size))
+		if offset > 0:
+			print('\tstatic_assert(offsetof({0}, {1}) - offsetof({0}, {2}) == {3}, "layout mismatch");'.format(uorb_struct, field_name, first_field, offset))
+
+	print('\tmemcpy(&topic.{0}, buf.iterator, {1});'.format(first_field, block['size']))
+
+	for field_type, field_name, field_size, offset in block['fields']:
+		if field_type == 'uint64' and (field_name == 'timestamp' or field_name == 'timestamp_sample'):
+			print('\tif (topic.{0} == 0) topic.{0} = hrt_absolute_time();'.format(field_name))
+			print('\telse topic.{0} = math::min(topic.{0} - time_offset, hrt_absolute_time());'.format(field_name))
+
+	print('\tbuf.iterator += {:};'.format(block['size']))
+	print('\tbuf.offset += {:};'.format(block['size']))
 
 }@
 	return true;
@@ -68,6 +68,11 @@ uorb_struct_upper = name_snake_case.upper()
 
 #include <uORB/uORB.h>
 
+#ifdef __cplusplus
+#include <stddef.h>
+#include <uORB/uORBFieldTable.hpp>
+#endif
+
 @##############################
 @# Includes for dependencies
 @##############################
@@ -85,7 +90,7 @@ for field in spec.parsed_fields():
 @# Constants c style
 #ifndef __cplusplus
 @[for constant in spec.constants]@
-#define @(uorb_struct_upper)_@(constant.name) @(int(constant.val))
+#define @(uorb_struct_upper)_@(constant.name) @(constant_value(constant))
 @[end for]
 #endif
 
@@ -124,7 +129,7 @@ for constant in spec.constants:
     else:
         raise Exception("Type {0} not supported, add to to template file!".format(type_name))
 
-    print('\tstatic constexpr %s %s = %s;'%(type_px4, constant.name, int(constant.val)))
+    print('\tstatic constexpr %s %s = %s;'%(type_px4, constant.name, constant_value(constant)))
 }
 #endif
 };
@@ -137,6 +142,40 @@ namespace px4 {
 } // namespace px4
 #endif
 
+@##############################
+@# Compile-time field layout
+@##############################
+@{
+
+def print_field_table():
+    sorted_fields = sorted(spec.parsed_fields(), key=sizeof_field_type, reverse=True)
+    add_padding_bytes(sorted_fields, search_path)
+    fields = [field for field in sorted_fields if not field.is_header]
+
+    print('static constexpr FieldDescriptor %s_fields[] = {' % name_snake_case)
+    for field in fields:
+        array_length = field.array_len if field.is_array else 1
+        if field.is_builtin:
+            type_name = bare_name(field.type)
+            print('\t{"%s", offsetof(%s, %s), %d, %d, FieldType::%s, nullptr},' %
+                  (field.name, uorb_struct, field.name, msgtype_size_map[type_name], array_length, type_name.upper()))
+        else:
+            nested_name = re.sub(r'(?<!^)(?=[A-Z])', '_', bare_name(field.type)).lower()
+            print('\t{"%s", offsetof(%s, %s), sizeof(%s_s), %d, FieldType::NESTED, &%s},' %
+                  (field.name, uorb_struct, field.name, nested_name, array_length, nested_name))
+    print('};')
+    print('')
+    print('static constexpr FieldTable %s{"%s", %s_fields, %d, sizeof(%s)};' % (name_snake_case, name_snake_case, name_snake_case, len(fields), uorb_struct))
+}@
+
+#ifdef __cplusplus
+namespace uORB {
+	namespace fields {
+@print_field_table()
+	} // namespace fields
+} // namespace uORB
+#endif
+
 /* register this as object request broker structure */
 @[for topic in topics]@
 ORB_DECLARE(@topic);
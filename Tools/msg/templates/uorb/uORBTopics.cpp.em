@@ -68,6 +68,25 @@ const struct orb_metadata *const *orb_get_topics()
 	return uorb_topics_list;
 }
 
+@[for topic_name in all_topics]@
+extern const uORB::FieldTable *const __orb_field_table_@(topic_name);
+@[end for]
+
+static const uORB::FieldTable *const *const uorb_field_tables[ORB_TOPICS_COUNT] = {
+@[for idx, topic_name in enumerate(all_topics, 1)]@
+	&__orb_field_table_@(topic_name)@[if idx != all_topics], @[end if]
+@[end for]
+};
+
+const uORB::FieldTable *orb_get_field_table(ORB_ID id)
+{
+	if (id == ORB_ID::INVALID) {
+		return nullptr;
+	}
+
+	return *uorb_field_tables[static_cast<orb_id_size_t>(id)];
+}
+
 const struct orb_metadata *get_orb_meta(ORB_ID id)
 {
 	if (id == ORB_ID::INVALID) {
@@ -69,3 +69,13 @@ enum class ORB_ID : orb_id_size_t {
 };
 
 const struct orb_metadata *get_orb_meta(ORB_ID id);
+
+namespace uORB
+{
+struct FieldTable;
+}
+
+/*
+ * Returns the compile-time field layout of a topic (nullptr for ORB_ID::INVALID)
+ */
+const uORB::FieldTable *orb_get_field_table(ORB_ID id);
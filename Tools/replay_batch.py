@@ -0,0 +1,234 @@
+#! /usr/bin/env python3
+"""
+Replays a set of .ulg files in parallel with a replay build of PX4 and hashes the
+replayed output topics per sample, to check that a change does not alter the
+output (e.g. of the estimator) for any of the logs.
+
+Build the replay target once (any posix SITL target works):
+
+    replay=/any/log.ulg make px4_sitl_default
+
+Record the golden hashes with the current code:
+
+    ./Tools/replay_batch.py --golden golden.json --update-golden logs/
+
+Then check a change against them:
+
+    ./Tools/replay_batch.py --golden golden.json logs/
+
+Each log runs in its own px4 instance (working directory rootfs/<instance>),
+without wall-time pacing (PX4_SIM_SPEED_FACTOR=0). The exit code is 1 if any
+log diverges from the golden hashes or fails to replay.
+"""
+
+import argparse
+import concurrent.futures
+import glob
+import hashlib
+import json
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+try:
+    from pyulog import ULog
+except ImportError:
+    print("Failed to import pyulog, install it with: pip3 install --user pyulog")
+    sys.exit(1)
+
+
+def get_arguments():
+    parser = argparse.ArgumentParser(description='Replay logs in parallel and compare the replayed topics '
+                                                 'against golden hashes.')
+    parser.add_argument('logs', nargs='+',
+                        help='.ulg files or directories (searched recursively) to replay')
+    parser.add_argument('--build-dir', default='build/px4_sitl_default_replay',
+                        help='replay build directory (default: %(default)s)')
+    parser.add_argument('--mode', default='ekf2', choices=['ekf2', 'full'],
+                        help='replay mode, ekf2 (replay_mode=ekf2) or full system-wide replay (default: %(default)s)')
+    parser.add_argument('-t', '--topics', nargs='+', default=['estimator_states'],
+                        help='replayed topics to hash (default: %(default)s)')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                        help='number of parallel replays (default: number of CPUs)')
+    parser.add_argument('--timeout', type=float, default=600.,
+                        help='timeout per replay in seconds (default: %(default)s)')
+    parser.add_argument('--golden', required=True,
+                        help='JSON file with the golden hashes')
+    parser.add_argument('--update-golden', action='store_true',
+                        help='write the hashes of this run to the golden file instead of comparing')
+    return parser.parse_args()
+
+
+def find_logs(paths):
+    logs = []
+
+    for path in paths:
+        if os.path.isdir(path):
+            logs += sorted(glob.glob(os.path.join(path, '**/*.ulg'), recursive=True))
+        else:
+            logs.append(path)
+
+    # never replay the output of a previous replay
+    return [os.path.abspath(log) for log in logs if not log.endswith('_replayed.ulg')]
+
+
+def log_key(log_file):
+    """ golden hashes are keyed by file name and content, so that renamed or moved logs still match """
+    with open(log_file, 'rb') as f:
+        return '{:s}:{:s}'.format(os.path.basename(log_file), hashlib.sha1(f.read()).hexdigest()[:12])
+
+
+def hash_topics(ulog_file, topics):
+    """
+    Hash each sample of the given topics.
+    Returns {'<topic>[<multi_id>]': [[timestamp, hash], ...]}.
+    """
+    ulog = ULog(ulog_file, topics)
+    hashes = {}
+
+    for dataset in sorted(ulog.data_list, key=lambda d: (d.name, d.multi_id)):
+        fields = sorted(dataset.data.keys())
+        columns = [dataset.data[field] for field in fields]
+        samples = []
+
+        for i, timestamp in enumerate(dataset.data['timestamp']):
+            sample = hashlib.sha1()
+
+            for column in columns:
+                sample.update(column[i].tobytes())
+
+            samples.append([int(timestamp), sample.hexdigest()[:16]])
+
+        hashes['{:s}[{:d}]'.format(dataset.name, dataset.multi_id)] = samples
+
+    return hashes
+
+
+def replay(build_dir, mode, topics, timeout, instance, log_file):
+    """ replay a single log in px4 instance `instance` and return the hashes of the replayed topics """
+    working_dir = os.path.join(build_dir, 'rootfs', str(instance))
+
+    # start from a clean working directory, rc.replay keeps replay_params.txt otherwise
+    shutil.rmtree(working_dir, ignore_errors=True)
+
+    env = os.environ.copy()
+    env['replay'] = log_file
+    env['PX4_SIM_SPEED_FACTOR'] = '0'
+
+    if mode == 'ekf2':
+        env['replay_mode'] = 'ekf2'
+
+    else:
+        env.pop('replay_mode', None)
+
+    with open(os.path.join(build_dir, 'replay_{:d}.txt'.format(instance)), 'w') as output:
+        subprocess.run([os.path.join(build_dir, 'bin', 'px4'), '-d', '-i', str(instance)], env=env,
+                       stdout=output, stderr=subprocess.STDOUT, timeout=timeout, check=True)
+
+    replayed = glob.glob(os.path.join(working_dir, 'log', '**', '*_replayed.ulg'), recursive=True)
+
+    if not replayed:
+        raise RuntimeError('no replayed log written')
+
+    return hash_topics(max(replayed, key=os.path.getmtime), topics)
+
+
+def compare(golden, hashes):
+    """ return a description of the first divergence per topic, empty if equal """
+    divergences = []
+
+    for topic in sorted(set(golden) | set(hashes)):
+        expected = golden.get(topic)
+        actual = hashes.get(topic)
+
+        if expected is None or actual is None:
+            divergences.append('{:s}: {:s}'.format(topic, 'missing' if actual is None else 'not in golden'))
+            continue
+
+        for (expected_t, expected_hash), (actual_t, actual_hash) in zip(expected, actual):
+            if expected_t != actual_t or expected_hash != actual_hash:
+                divergences.append('{:s}: diverges at timestamp {:d}'.format(topic, min(expected_t, actual_t)))
+                break
+
+        else:
+            if len(expected) != len(actual):
+                divergences.append('{:s}: {:d} samples instead of {:d}'.format(topic, len(actual), len(expected)))
+
+    return divergences
+
+
+def main():
+    args = get_arguments()
+
+    build_dir = os.path.abspath(args.build_dir)
+
+    if not os.path.isfile(os.path.join(build_dir, 'bin', 'px4')):
+        print('{:s} does not contain a px4 replay build'.format(build_dir))
+        sys.exit(1)
+
+    logs = find_logs(args.logs)
+    print('replaying {:d} logs with {:d} jobs'.format(len(logs), args.jobs))
+
+    golden = {}
+
+    if os.path.isfile(args.golden):
+        with open(args.golden) as f:
+            golden = json.load(f)
+
+    results = {}
+    failed = []
+    diverged = []
+    start = time.time()
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        futures = {executor.submit(replay, build_dir, args.mode, args.topics, args.timeout, instance, log): log
+                   for instance, log in enumerate(logs)}
+
+        for future in concurrent.futures.as_completed(futures):
+            log = futures[future]
+            key = log_key(log)
+
+            try:
+                results[key] = future.result()
+
+            except Exception as e:
+                print('FAIL     {:s}: {}'.format(log, e))
+                failed.append(log)
+                continue
+
+            if args.update_golden:
+                print('RECORDED {:s}'.format(log))
+
+            elif key not in golden:
+                print('NEW      {:s} (no golden hashes)'.format(log))
+
+            else:
+                divergences = compare(golden[key], results[key])
+
+                if divergences:
+                    diverged.append(log)
+                    print('DIVERGED {:s}'.format(log))
+
+                    for divergence in divergences:
+                        print('           {:s}'.format(divergence))
+
+                else:
+                    print('OK       {:s}'.format(log))
+
+    print('{:d} logs in {:.1f} s: {:d} diverged, {:d} failed'.format(len(logs), time.time() - start,
+                                                                   len(diverged), len(failed)))
+
+    if args.update_golden:
+        golden.update(results)
+
+        with open(args.golden, 'w') as f:
+            json.dump(golden, f, sort_keys=True)
+
+    if diverged or failed:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""
+Convert a heatshrink compressed log file (.ulgz, written with SDLOG_COMPRESS) to ULog.
+
+File layout:
+- the ULog file header and flag bits message, uncompressed
+- blocks: 0xA5 0x5A, compressed size (uint16 LE), uncompressed size (uint16 LE), heatshrink data
+- optionally uncompressed ULog data appended by the hardfault handler, the appended
+  offsets in the flag bits message are translated to the decompressed file
+"""
+
+import argparse
+import struct
+import sys
+
+WINDOW_BITS = 8  # must match HEATSHRINK_STATIC_WINDOW_BITS
+LOOKAHEAD_BITS = 4  # must match HEATSHRINK_STATIC_LOOKAHEAD_BITS
+
+HEADER_SIZE = 16 + 3 + 8 + 8 + 3 * 8  # file header + flag bits message
+APPENDED_OFFSETS_POS = 16 + 3 + 8 + 8
+BLOCK_MARKER = b'\xa5\x5a'
+BLOCK_HEADER_SIZE = 6
+
+
+def heatshrink_decode(data, max_size):
+    """ decode a heatshrink stream, stops at the end of the input or after max_size bytes """
+    out = bytearray()
+    bit_pos = 0
+    num_bits = len(data) * 8
+
+    def get_bits(count):
+        nonlocal bit_pos
+        if bit_pos + count > num_bits:
+            return None
+        value = 0
+        for _ in range(count):
+            byte = data[bit_pos >> 3]
+            value = (value << 1) | ((byte >> (7 - (bit_pos & 7))) & 1)
+            bit_pos += 1
+        return value
+
+    while len(out) < max_size:
+        tag = get_bits(1)
+        if tag is None:
+            break
+        if tag:
+            literal = get_bits(8)
+            if literal is None:
+                break
+            out.append(literal)
+        else:
+            index = get_bits(WINDOW_BITS)
+            count = get_bits(LOOKAHEAD_BITS)
+            if index is None or count is None:
+                break
+            offset = index + 1
+            for _ in range(count + 1):
+                # the window is initially zero-filled
+                out.append(out[-offset] if offset <= len(out) else 0)
+    return out
+
+
+def decompress(data):
+    if len(data) < HEADER_SIZE or data[0:7] != b'ULog\x01\x12\x35':
+        raise ValueError('not a compressed ULog file')
+
+    out = bytearray(data[0:HEADER_SIZE])
+    pos = HEADER_SIZE
+    num_blocks = 0
+
+    while pos < len(data):
+        if data[pos:pos + 2] != BLOCK_MARKER:
+            # uncompressed data appended after a crash, adjust the offsets (file offsets at the time of appending)
+            for i in range(3):
+                offset_pos = APPENDED_OFFSETS_POS + i * 8
+                offset, = struct.unpack_from('<Q', out, offset_pos)
+                if offset >= pos:
+                    struct.pack_into('<Q', out, offset_pos, offset - pos + len(out))
+            print('{:} bytes of appended data'.format(len(data) - pos))
+            out += data[pos:]
+            break
+
+        if pos + BLOCK_HEADER_SIZE > len(data):
+            print('Warning: truncated block at the end of the file', file=sys.stderr)
+            break
+
+        compressed_size, uncompressed_size = struct.unpack_from('<HH', data, pos + 2)
+        block = data[pos + BLOCK_HEADER_SIZE:pos + BLOCK_HEADER_SIZE + compressed_size]
+
+        decoded = heatshrink_decode(block, uncompressed_size)
+        if len(block) != compressed_size or len(decoded) != uncompressed_size:
+            print('Warning: incomplete block at the end of the file', file=sys.stderr)
+            out += decoded
+            break
+
+        out += decoded
+        pos += BLOCK_HEADER_SIZE + compressed_size
+        num_blocks += 1
+
+    print('{:} blocks, {:} -> {:} bytes'.format(num_blocks, len(data), len(out)))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a compressed log (.ulgz) to ULog')
+    parser.add_argument('input', help='compressed log file')
+    parser.add_argument('-o', '--output', help='output file (default: input with .ulg extension)')
+    args = parser.parse_args()
+
+    output = args.output
+    if output is None:
+        output = args.input[:-1] if args.input.endswith('.ulgz') else args.input + '.ulg'
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    with open(output, 'wb') as f:
+        f.write(decompress(data))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+Convert a ULog file with delta encoded data messages (written with SDLOG_DELTA) to a
+standard ULog file, so it can be read by any ULog parser.
+
+A delta encoded data message ('G') has the same header as a data message ('D'),
+followed by a bitmask with one bit per top-level field of the logged format
+(LSB first) and the values of the fields that changed since the previous data
+message with the same msg_id.
+
+The message sizes change, so the seek index messages (SDLOG_INDEX) are dropped,
+and the appended data offsets are adjusted.
+"""
+
+import argparse
+import struct
+import sys
+
+HEADER_SIZE = 16
+FLAG_BITS_SIZE = 3 + 8 + 8 + 3 * 8
+
+ULOG_COMPAT_FLAG0_SEEK_INDEX_MASK = 1 << 1
+ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK = 1 << 0
+ULOG_INCOMPAT_FLAG0_DELTA_DATA_MASK = 1 << 1
+
+TYPE_SIZES = {
+    'int8_t': 1, 'uint8_t': 1, 'bool': 1, 'char': 1,
+    'int16_t': 2, 'uint16_t': 2,
+    'int32_t': 4, 'uint32_t': 4, 'float': 4,
+    'int64_t': 8, 'uint64_t': 8, 'double': 8,
+}
+
+
+class FormatError(Exception):
+    pass
+
+
+def field_size(type_str, formats, cache):
+    """ size of a field type, e.g. 'float[3]' or a nested message type """
+    count = 1
+    if '[' in type_str:
+        type_str, array = type_str.split('[')
+        count = int(array.rstrip(']'))
+    if type_str in TYPE_SIZES:
+        return TYPE_SIZES[type_str] * count
+    return message_size(type_str, formats, cache) * count
+
+
+def message_size(name, formats, cache):
+    if name not in cache:
+        if name not in formats:
+            raise FormatError('missing format for {:}'.format(name))
+        cache[name] = sum(size for _, size in fields_of(name, formats, cache))
+    return cache[name]
+
+
+def fields_of(name, formats, cache):
+    """ list of (offset, size) of the top-level fields of a message """
+    fields = []
+    offset = 0
+    for field in formats[name].split(';'):
+        if not field:
+            continue
+        type_str = field.split(' ')[0]
+        size = field_size(type_str, formats, cache)
+        fields.append((offset, size))
+        offset += size
+    return fields
+
+
+def delta_decode(fields, encoded, reference):
+    """ apply an encoded delta to reference (bytearray) """
+    fields = [(offset, min(offset + size, len(reference)) - offset)
+              for offset, size in fields if offset < len(reference)]
+    mask_size = (len(fields) + 7) // 8
+    if len(encoded) < mask_size:
+        return False
+    pos = mask_size
+    for i, (offset, length) in enumerate(fields):
+        if encoded[i // 8] & (1 << (i % 8)):
+            if pos + length > len(encoded):
+                return False
+            reference[offset:offset + length] = encoded[pos:pos + length]
+            pos += length
+    return pos == len(encoded)
+
+
+def convert(data):
+    if len(data) < HEADER_SIZE + FLAG_BITS_SIZE or data[0:7] != b'ULog\x01\x12\x35':
+        raise ValueError('not a ULog file')
+
+    out = bytearray(data[0:HEADER_SIZE])
+    formats = {}
+    size_cache = {}
+    msg_names = {}  # msg_id -> message name
+    references = {}  # msg_id -> last data
+    appended_offset = None
+    flag_bits_pos = None
+    num_decoded = 0
+    num_skipped = 0
+    pos = HEADER_SIZE
+
+    while pos + 3 <= len(data):
+        if appended_offset is not None and pos >= appended_offset:
+            break
+
+        msg_size, msg_type = struct.unpack_from('<HB', data, pos)
+        if pos + 3 + msg_size > len(data):
+            print('Warning: truncated message at the end of the file', file=sys.stderr)
+            break
+        payload = data[pos + 3:pos + 3 + msg_size]
+        msg = data[pos:pos + 3 + msg_size]
+        pos += 3 + msg_size
+        msg_type = chr(msg_type)
+
+        if msg_type == 'B':
+            flag_bits_pos = len(out)
+            if payload[8] & ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK:
+                appended, = struct.unpack_from('<Q', payload, 16)
+                if appended > 0:
+                    appended_offset = appended
+
+        elif msg_type == 'F':
+            name, fields = payload.decode('utf-8', 'replace').split(':', 1)
+            formats[name] = fields
+
+        elif msg_type == 'A':
+            msg_id, = struct.unpack_from('<H', payload, 1)
+            msg_names[msg_id] = payload[3:].decode('utf-8', 'replace')
+
+        elif msg_type == 'D':
+            msg_id, = struct.unpack_from('<H', payload, 0)
+            references[msg_id] = bytearray(payload[2:])
+
+        elif msg_type == 'G':
+            msg_id, = struct.unpack_from('<H', payload, 0)
+            reference = references.get(msg_id)
+            name = msg_names.get(msg_id)
+            if reference is None or name not in formats or \
+                    not delta_decode(fields_of(name, formats, size_cache), payload[2:], reference):
+                # no keyframe yet (or inconsistent data): drop it, the next keyframe resynchronizes
+                references.pop(msg_id, None)
+                num_skipped += 1
+                continue
+            msg = struct.pack('<HBH', len(reference) + 2, ord('D'), msg_id) + reference
+            num_decoded += 1
+
+        elif msg_type in ('X', 'Y', 'Z'):
+            continue  # seek index, the offsets are not valid anymore
+
+        out += msg
+
+    if flag_bits_pos is not None:
+        out[flag_bits_pos + 3] &= ~ULOG_COMPAT_FLAG0_SEEK_INDEX_MASK & 0xff
+        out[flag_bits_pos + 3 + 8] &= ~ULOG_INCOMPAT_FLAG0_DELTA_DATA_MASK & 0xff
+        if appended_offset is not None and appended_offset < len(data):
+            for i in range(3):
+                offset_pos = flag_bits_pos + 3 + 16 + i * 8
+                offset, = struct.unpack_from('<Q', out, offset_pos)
+                if offset >= appended_offset:
+                    struct.pack_into('<Q', out, offset_pos, offset - appended_offset + len(out))
+            print('{:} bytes of appended data'.format(len(data) - appended_offset))
+            out += data[appended_offset:]
+
+    print('{:} delta messages decoded, {:} skipped'.format(num_decoded, num_skipped))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a ULog file with delta encoded data to standard ULog')
+    parser.add_argument('input', help='ULog file')
+    parser.add_argument('-o', '--output', help='output file (default: input with _decoded.ulg suffix)')
+    args = parser.parse_args()
+
+    output = args.output
+    if output is None:
+        base = args.input[:-4] if args.input.endswith('.ulg') else args.input
+        output = base + '_decoded.ulg'
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    with open(output, 'wb') as f:
+        f.write(convert(data))
+
+
+if __name__ == '__main__':
+    main()
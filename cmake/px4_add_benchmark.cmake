@@ -0,0 +1,131 @@
+############################################################################
+#
+# Copyright (c) 2026 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#=============================================================================
+#
+#	px4_add_benchmark
+#
+#	Adds a Google Benchmark executable to the benchmark_results target.
+#	The benchmark name is inferred from the source file name without the
+#	"Benchmark" suffix, e.g. MatrixBenchmark.cpp -> benchmark-Matrix.
+#
+#	Usage:
+#		px4_add_benchmark(SRC <file>
+#			[FUNCTIONAL]
+#			[EXTRA_SRCS <files>]
+#			[COMPILE_FLAGS <flags>]
+#			[INCLUDES <dirs>]
+#			[LINKLIBS <libs>])
+#
+#	Input:
+#		SRC		: benchmark source file, without main()
+#		FUNCTIONAL	: link against the PX4 system (uORB, parameters)
+#				  and initialize it before running
+#		EXTRA_SRCS	: additional source files
+#		COMPILE_FLAGS	: additional compile flags
+#		INCLUDES	: additional include directories
+#		LINKLIBS	: libraries to benchmark
+#
+#	Every benchmark writes its results as JSON to
+#	${PX4_BINARY_DIR}/benchmarks/<name>.json, which includes the host CPU
+#	and caches, so results from different machines can be told apart and
+#	compared with Google Benchmark's tools/compare.py.
+#
+function(px4_add_benchmark)
+	# skip if benchmarks are not configured
+	if(PX4_BENCHMARKS)
+		px4_parse_function_args(
+			NAME px4_add_benchmark
+			OPTIONS FUNCTIONAL
+			ONE_VALUE SRC
+			MULTI_VALUE EXTRA_SRCS COMPILE_FLAGS INCLUDES LINKLIBS
+			REQUIRED SRC
+			ARGN ${ARGN})
+
+		# infer benchmark name from source filename
+		get_filename_component(BENCHMARKNAME ${SRC} NAME_WE)
+		string(REPLACE Benchmark "" BENCHMARKNAME ${BENCHMARKNAME})
+		set(BENCHMARKNAME benchmark-${BENCHMARKNAME})
+
+		add_executable(${BENCHMARKNAME} EXCLUDE_FROM_ALL ${SRC} ${EXTRA_SRCS})
+
+		if(FUNCTIONAL)
+			target_link_libraries(${BENCHMARKNAME} PRIVATE ${LINKLIBS} benchmark_functional_main
+			                                                   px4_layer
+			                                                   px4_platform
+			                                                   uORB
+			                                                   systemlib
+			                                                   cdev
+			                                                   px4_work_queue
+			                                                   px4_daemon
+			                                                   work_queue
+			                                                   parameters
+			                                                   events
+			                                                   perf
+			                                                   tinybson
+			                                                   uorb_msgs
+			                                                   test_stubs) # put test_stubs last
+
+			target_compile_definitions(${BENCHMARKNAME} PRIVATE MODULE_NAME="${BENCHMARKNAME}")
+
+		else()
+			target_link_libraries(${BENCHMARKNAME} PRIVATE ${LINKLIBS} benchmark::benchmark_main)
+		endif()
+
+		if(COMPILE_FLAGS)
+			target_compile_options(${BENCHMARKNAME} PRIVATE ${COMPILE_FLAGS})
+		endif()
+
+		if(INCLUDES)
+			target_include_directories(${BENCHMARKNAME} PRIVATE ${INCLUDES})
+		endif()
+
+		# build all benchmarks before running any, a compile in parallel distorts the results
+		add_dependencies(benchmark_build ${BENCHMARKNAME})
+
+		# USES_TERMINAL runs the benchmarks one after another
+		add_custom_target(${BENCHMARKNAME}-run
+			COMMAND ${CMAKE_COMMAND} -E make_directory ${PX4_BINARY_DIR}/benchmarks
+			COMMAND ${BENCHMARKNAME}
+				--benchmark_out=${PX4_BINARY_DIR}/benchmarks/${BENCHMARKNAME}.json
+				--benchmark_out_format=json
+				--benchmark_repetitions=${PX4_BENCHMARK_REPETITIONS}
+				--benchmark_report_aggregates_only=true
+				--benchmark_filter=${PX4_BENCHMARK_FILTER}
+			USES_TERMINAL
+			WORKING_DIRECTORY ${PX4_BINARY_DIR})
+
+		add_dependencies(${BENCHMARKNAME}-run benchmark_build)
+		add_dependencies(benchmark_results ${BENCHMARKNAME}-run)
+	endif()
+endfunction()
@@ -198,4 +198,13 @@ function(px4_add_common_flags)
 		-D__STDC_FORMAT_MACROS
 		)
 
+	# the header-only matrix library needs the same SIMD configuration in all translation units
+	if(CONFIG_LIB_MATRIX_SIMD)
+		add_definitions(-DMATRIX_SIMD)
+
+		if(CONFIG_LIB_MATRIX_SIMD_BITEXACT)
+			add_definitions(-DMATRIX_SIMD_BITEXACT)
+		endif()
+	endif()
+
 endfunction()
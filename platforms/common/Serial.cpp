@@ -32,6 +32,14 @@
  ****************************************************************************/
 
 #include <px4_platform_common/Serial.hpp>
+#include <px4_platform_common/time.h>
+#include <drivers/drv_hrt.h>
+
+#ifndef MODULE_NAME
+#define MODULE_NAME "Serial"
+#endif
+
+#include <px4_platform_common/log.h>
 
 namespace device
 {
@@ -89,6 +97,125 @@ ssize_t Serial::write(const void *buffer, size_t buffer_size)
 	return _impl.write(buffer, buffer_size);
 }
 
+ssize_t Serial::writev(const struct iovec *iov, int iovcnt)
+{
+	return _impl.writev(iov, iovcnt);
+}
+
+void Serial::setReceiveBuffer(uint8_t *buffer, size_t buffer_size)
+{
+	_rx_buffer = buffer;
+	_rx_size = buffer ? buffer_size : 0;
+	_rx_tail = 0;
+	_rx_count = 0;
+}
+
+ssize_t Serial::receiveAvailable()
+{
+	const size_t free = _rx_size - _rx_count;
+
+	if (free == 0) {
+		return 0;
+	}
+
+	const size_t head = (_rx_tail + _rx_count) % _rx_size;
+
+	struct iovec iov[2];
+	iov[0].iov_base = &_rx_buffer[head];
+	iov[0].iov_len = (_rx_size - head < free) ? _rx_size - head : free;
+	iov[1].iov_base = &_rx_buffer[0];
+	iov[1].iov_len = free - iov[0].iov_len;
+
+	const ssize_t ret = _impl.readv(iov, iov[1].iov_len > 0 ? 2 : 1);
+
+	if (ret > 0) {
+		_rx_count += ret;
+	}
+
+	return ret;
+}
+
+ssize_t Serial::receive(size_t threshold, uint32_t timeout_ms, uint32_t idle_us)
+{
+	if (_rx_buffer == nullptr) {
+		PX4_ERR("no receive buffer set");
+		return -1;
+	}
+
+	if (threshold > _rx_size) {
+		threshold = _rx_size;
+	}
+
+	// 10 bits per byte (start, 8 data, stop)
+	const uint32_t baudrate = getBaudrate();
+	const hrt_abstime byte_time_us = baudrate > 0 ? (10000000 + baudrate - 1) / baudrate : 1000;
+
+	const hrt_abstime start_time_us = hrt_absolute_time();
+	const hrt_abstime timeout_us = (hrt_abstime)timeout_ms * 1000;
+	hrt_abstime last_received_us = start_time_us;
+
+	while (true) {
+		const ssize_t received = receiveAvailable();
+
+		if (received < 0) {
+			return -1;
+		}
+
+		const hrt_abstime now = hrt_absolute_time();
+
+		if (received > 0) {
+			last_received_us = now;
+		}
+
+		if (_rx_count >= threshold || _rx_count == _rx_size) {
+			break;
+		}
+
+		const hrt_abstime elapsed_us = now - start_time_us;
+		const hrt_abstime idle_elapsed_us = now - last_received_us;
+
+		if ((idle_us > 0 && _rx_count > 0 && idle_elapsed_us >= idle_us) || elapsed_us >= timeout_us) {
+			break;
+		}
+
+		hrt_abstime wait_us = timeout_us - elapsed_us;
+
+		if (idle_us > 0 && _rx_count > 0 && idle_us - idle_elapsed_us < wait_us) {
+			wait_us = idle_us - idle_elapsed_us;
+		}
+
+		if (received > 0) {
+			// data is arriving, sleep until the rest should be there
+			const hrt_abstime missing_us = (threshold - _rx_count) * byte_time_us;
+			px4_usleep(missing_us < wait_us ? missing_us : wait_us);
+
+		} else if (_impl.waitForData(wait_us) < 0) {
+			return -1;
+		}
+	}
+
+	return _rx_count;
+}
+
+size_t Serial::peek(const uint8_t **data) const
+{
+	*data = _rx_buffer ? &_rx_buffer[_rx_tail] : nullptr;
+	return (_rx_size - _rx_tail < _rx_count) ? _rx_size - _rx_tail : _rx_count;
+}
+
+void Serial::consume(size_t count)
+{
+	if (count >= _rx_count) {
+		// start at the beginning again, this keeps the data contiguous as long as possible
+		_rx_tail = 0;
+		_rx_count = 0;
+
+	} else {
+		_rx_tail = (_rx_tail + count) % _rx_size;
+		_rx_count -= count;
+	}
+}
+
 ssize_t Serial::writeBlocking(const void *buffer, size_t buffer_size, uint32_t timeout_ms)
 {
 	return _impl.writeBlocking(buffer, buffer_size, timeout_ms);
@@ -0,0 +1,318 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file heap_usage.cpp
+ *
+ * Heap usage attribution, see heap_usage.h.
+ */
+
+#include <px4_platform_common/heap_usage.h>
+
+#if defined(CONFIG_HEAP_USAGE)
+
+#include <px4_platform_common/log.h>
+
+#include <inttypes.h>
+#include <new>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace px4
+{
+namespace heap_usage
+{
+
+static constexpr int MAX_THREADS = 64;
+static constexpr int MAX_TAGS = 96; ///< the last tag collects the allocations once the table is full
+static constexpr size_t TAG_LENGTH = 24;
+
+struct ThreadSlot {
+	pthread_t thread;
+	const char *tag;
+	bool used;
+};
+
+struct TagUsage {
+	char name[TAG_LENGTH];
+	size_t current;
+	size_t peak;
+	uint32_t allocations; ///< number of live allocations
+};
+
+/**
+ * Prepended to each allocation, keeps the alignment of the returned pointer
+ */
+struct alignas(alignof(max_align_t)) Header {
+	size_t size;
+	uint16_t tag;
+};
+
+// statically initialized, allocations can happen before the static constructors ran
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static ThreadSlot threads[MAX_THREADS] {};
+static TagUsage tags[MAX_TAGS] {};
+static int num_tags = 0;
+
+static int find_thread_locked(pthread_t thread)
+{
+	for (int i = 0; i < MAX_THREADS; i++) {
+		if (threads[i].used && pthread_equal(threads[i].thread, thread)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static uint16_t tag_index_locked(const char *name)
+{
+	for (int i = 0; i < num_tags; i++) {
+		if (strncmp(tags[i].name, name, TAG_LENGTH - 1) == 0) {
+			return i;
+		}
+	}
+
+	if (num_tags < MAX_TAGS - 1) {
+		strncpy(tags[num_tags].name, name, TAG_LENGTH - 1);
+		return num_tags++;
+	}
+
+	if (tags[MAX_TAGS - 1].name[0] == '\0') {
+		strncpy(tags[MAX_TAGS - 1].name, "(other)", TAG_LENGTH - 1);
+		num_tags = MAX_TAGS;
+	}
+
+	return MAX_TAGS - 1;
+}
+
+static uint16_t current_tag_locked()
+{
+	const pthread_t self = pthread_self();
+	const int slot = find_thread_locked(self);
+
+	if ((slot >= 0) && (threads[slot].tag != nullptr)) {
+		return tag_index_locked(threads[slot].tag);
+	}
+
+	char name[TAG_LENGTH] {};
+
+	if ((pthread_getname_np(self, name, sizeof(name)) != 0) || (name[0] == '\0')) {
+		strncpy(name, "(unknown)", sizeof(name) - 1);
+	}
+
+	return tag_index_locked(name);
+}
+
+int register_thread()
+{
+	pthread_mutex_lock(&mutex);
+
+	const pthread_t self = pthread_self();
+	int slot = find_thread_locked(self);
+
+	for (int i = 0; (slot < 0) && (i < MAX_THREADS); i++) {
+		if (!threads[i].used) {
+			threads[i].thread = self;
+			threads[i].tag = nullptr;
+			threads[i].used = true;
+			slot = i;
+		}
+	}
+
+	pthread_mutex_unlock(&mutex);
+	return slot;
+}
+
+void unregister_thread(int slot)
+{
+	if ((slot >= 0) && (slot < MAX_THREADS)) {
+		pthread_mutex_lock(&mutex);
+		threads[slot].used = false;
+		threads[slot].tag = nullptr;
+		pthread_mutex_unlock(&mutex);
+	}
+}
+
+void set_tag(int slot, const char *tag)
+{
+	// only the thread itself changes its tag, the allocation path reads it under the lock
+	if ((slot >= 0) && (slot < MAX_THREADS)) {
+		pthread_mutex_lock(&mutex);
+		threads[slot].tag = tag;
+		pthread_mutex_unlock(&mutex);
+	}
+}
+
+const char *get_tag(int slot)
+{
+	return ((slot >= 0) && (slot < MAX_THREADS)) ? threads[slot].tag : nullptr;
+}
+
+Scope::Scope(const char *tag)
+{
+	pthread_mutex_lock(&mutex);
+	_registered = (find_thread_locked(pthread_self()) < 0);
+	pthread_mutex_unlock(&mutex);
+
+	_slot = register_thread();
+	_previous_tag = get_tag(_slot);
+	set_tag(_slot, tag);
+}
+
+Scope::~Scope()
+{
+	if (_registered) {
+		unregister_thread(_slot);
+
+	} else {
+		set_tag(_slot, _previous_tag);
+	}
+}
+
+void print_status()
+{
+	size_t total = 0;
+	size_t total_allocations = 0;
+
+	// the lock blocks the allocations of the other threads while printing (printf does not use operator new)
+	pthread_mutex_lock(&mutex);
+
+	PX4_INFO_RAW("%-*s %10s %10s %8s\n", (int)TAG_LENGTH, "TAG", "CURRENT(B)", "PEAK(B)", "ALLOCS");
+
+	for (int i = 0; i < num_tags; i++) {
+		PX4_INFO_RAW("%-*s %10zu %10zu %8" PRIu32 "\n", (int)TAG_LENGTH, tags[i].name, tags[i].current, tags[i].peak,
+			     tags[i].allocations);
+		total += tags[i].current;
+		total_allocations += tags[i].allocations;
+	}
+
+	pthread_mutex_unlock(&mutex);
+
+	PX4_INFO_RAW("total: %zu B in %zu allocations (%zu B overhead)\n", total, total_allocations,
+		     total_allocations * sizeof(Header));
+}
+
+static void *allocate(size_t size)
+{
+	Header *header = static_cast<Header *>(malloc(sizeof(Header) + size));
+
+	if (header == nullptr) {
+		return nullptr;
+	}
+
+	pthread_mutex_lock(&mutex);
+
+	const uint16_t tag = current_tag_locked();
+	tags[tag].current += size;
+	tags[tag].allocations++;
+
+	if (tags[tag].current > tags[tag].peak) {
+		tags[tag].peak = tags[tag].current;
+	}
+
+	pthread_mutex_unlock(&mutex);
+
+	header->size = size;
+	header->tag = tag;
+	return header + 1;
+}
+
+static void deallocate(void *ptr)
+{
+	if (ptr == nullptr) {
+		return;
+	}
+
+	Header *header = static_cast<Header *>(ptr) - 1;
+
+	pthread_mutex_lock(&mutex);
+	tags[header->tag].current -= header->size;
+	tags[header->tag].allocations--;
+	pthread_mutex_unlock(&mutex);
+
+	free(header);
+}
+
+} // namespace heap_usage
+} // namespace px4
+
+/*
+  Replace the global allocation functions (see platforms/qurt/new_delete.cpp).
+  The aligned variants are left to the standard library.
+ */
+void *operator new (size_t size)
+{
+	return px4::heap_usage::allocate(size);
+}
+
+void *operator new[](size_t size)
+{
+	return px4::heap_usage::allocate(size);
+}
+
+void *operator new (size_t size, std::nothrow_t const &) noexcept
+{
+	return px4::heap_usage::allocate(size);
+}
+
+void *operator new[](size_t size, std::nothrow_t const &) noexcept
+{
+	return px4::heap_usage::allocate(size);
+}
+
+void operator delete (void *ptr) noexcept
+{
+	px4::heap_usage::deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	px4::heap_usage::deallocate(ptr);
+}
+
+void operator delete (void *ptr, size_t) noexcept
+{
+	px4::heap_usage::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+	px4::heap_usage::deallocate(ptr);
+}
+
+#endif // CONFIG_HEAP_USAGE
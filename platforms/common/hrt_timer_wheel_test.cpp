@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <px4_platform_common/hrt_timer_wheel.h>
+
+#include <gtest/gtest.h>
+
+// To run: make tests TESTFILTER=hrt_timer_wheel
+
+static constexpr hrt_abstime kSlack = (1u << HRT_WHEEL_TICK_SHIFT) - 1;
+
+class HrtTimerWheelTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		memset(_calls, 0, sizeof(_calls));
+		hrt_wheel_init(&_wheel, _now);
+	}
+
+	void add(int index, hrt_abstime deadline)
+	{
+		_calls[index].deadline = deadline;
+		hrt_wheel_add(&_wheel, &_calls[index]);
+	}
+
+	// advance to the next timer event and return the number of invoked callouts
+	int run_next()
+	{
+		const hrt_abstime next = hrt_wheel_next_deadline(&_wheel);
+
+		if (next == HRT_WHEEL_NONE) {
+			return -1;
+		}
+
+		_now = max_time(_now, next);
+
+		int invoked = 0;
+		struct hrt_call *call;
+
+		while ((call = hrt_wheel_pop_due(&_wheel, _now)) != nullptr) {
+			EXPECT_LE(call->deadline, _now);
+			EXPECT_LE(_now, max_time(call->deadline, _start) + kSlack);
+			call->deadline = 0;
+			invoked++;
+		}
+
+		return invoked;
+	}
+
+	static hrt_abstime max_time(hrt_abstime a, hrt_abstime b) { return (a > b) ? a : b; }
+
+	static constexpr hrt_abstime _start{123456789};
+	hrt_abstime _now{_start};
+	struct hrt_timer_wheel _wheel;
+	struct hrt_call _calls[8];
+};
+
+TEST_F(HrtTimerWheelTest, empty)
+{
+	EXPECT_EQ(hrt_wheel_next_deadline(&_wheel), HRT_WHEEL_NONE);
+	EXPECT_EQ(hrt_wheel_pop_due(&_wheel, _now + 1000), nullptr);
+}
+
+TEST_F(HrtTimerWheelTest, order)
+{
+	// level 0, upper levels and the overflow list
+	const hrt_abstime delays[] = {400000000, 100, 70000, 5, 2000000, 300, 20000000, 1000};
+
+	for (int i = 0; i < 8; i++) {
+		add(i, _now + delays[i]);
+	}
+
+	hrt_abstime last = 0;
+	int invoked = 0;
+
+	while (invoked < 8) {
+		const int n = run_next();
+		ASSERT_GE(n, 0);
+
+		if (n > 0) {
+			EXPECT_GE(_now, last);
+			last = _now;
+			invoked += n;
+		}
+	}
+
+	for (int i = 0; i < 8; i++) {
+		EXPECT_EQ(_calls[i].deadline, 0u);
+	}
+
+	EXPECT_EQ(hrt_wheel_next_deadline(&_wheel), HRT_WHEEL_NONE);
+}
+
+TEST_F(HrtTimerWheelTest, cancel)
+{
+	add(0, _now + 50);
+	add(1, _now + 50000);
+	add(2, _now + 60);
+
+	hrt_wheel_remove(&_wheel, &_calls[0]);
+	hrt_wheel_remove(&_wheel, &_calls[1]);
+	hrt_wheel_remove(&_wheel, &_calls[1]); // not queued anymore
+
+	EXPECT_EQ(run_next(), 1);
+	EXPECT_EQ(_calls[2].deadline, 0u);
+	EXPECT_NE(_calls[0].deadline, 0u);
+	EXPECT_EQ(hrt_wheel_next_deadline(&_wheel), HRT_WHEEL_NONE);
+}
+
+TEST_F(HrtTimerWheelTest, expired)
+{
+	add(0, _now - 1000);
+	EXPECT_EQ(hrt_wheel_pop_due(&_wheel, _now + kSlack), &_calls[0]);
+}
+
+TEST_F(HrtTimerWheelTest, late_wakeup)
+{
+	add(0, _now + 10);
+	add(1, _now + 30000);
+	add(2, _now + 3000000);
+
+	// the timer event comes much later than requested
+	_now += 5000000;
+	int invoked = 0;
+
+	while (hrt_wheel_pop_due(&_wheel, _now) != nullptr) {
+		invoked++;
+	}
+
+	EXPECT_EQ(invoked, 3);
+}
@@ -66,8 +66,24 @@ public:
 	ssize_t readAtLeast(uint8_t *buffer, size_t buffer_size, size_t character_count = 1, uint32_t timeout_ms = 0);
 
 	ssize_t write(const void *buffer, size_t buffer_size);
+	ssize_t writev(const struct iovec *iov, int iovcnt);
 	ssize_t writeBlocking(const void *buffer, size_t buffer_size, uint32_t timeout_ms = 0);
 
+	// Receive ring buffer: receive() fills the caller provided buffer from the port with a
+	// single readv() call per wakeup, and the data is parsed in place with peek()/consume().
+	void setReceiveBuffer(uint8_t *buffer, size_t buffer_size);
+
+	// Wait until at least threshold bytes are buffered, the ring is full, the line was idle
+	// for idle_us after receiving data (0 to disable) or the timeout expired. While data is
+	// arriving, the thread sleeps for the expected time of the missing bytes instead of
+	// waking up per byte. Returns the number of buffered bytes, or -1 on error.
+	ssize_t receive(size_t threshold, uint32_t timeout_ms, uint32_t idle_us = 0);
+
+	// Contiguous part of the buffered data, at most the total number of buffered bytes
+	size_t peek(const uint8_t **data) const;
+	size_t receivedBytes() const { return _rx_count; }
+	void consume(size_t count);
+
 	void flush();
 
 	// If port is already open then the following configuration functions
@@ -107,8 +123,15 @@ private:
 	Serial(const Serial &);
 	Serial &operator=(const Serial &);
 
+	ssize_t receiveAvailable();
+
 	// platform implementation
 	SerialImpl _impl;
+
+	uint8_t *_rx_buffer{nullptr};
+	size_t _rx_size{0};
+	size_t _rx_tail{0};
+	size_t _rx_count{0};
 };
 
 } // namespace device
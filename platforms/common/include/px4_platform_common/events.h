@@ -95,6 +95,12 @@ constexpr unsigned sizeofArguments(const T &t, const Args &... args)
  */
 void send(event_s &event);
 
+/**
+ * publish/send a batch of events with consecutive sequence numbers.
+ * This avoids interleaving with events from other threads and takes the publication lock only once.
+ */
+void send(event_s *events, int num_events);
+
 /**
  * Generate event ID from an event name
  */
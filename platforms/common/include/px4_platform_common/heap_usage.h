@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file heap_usage.h
+ *
+ * Heap usage attribution (CONFIG_HEAP_USAGE).
+ *
+ * The C++ allocations (operator new/delete) are attributed to a tag per
+ * thread: the running WorkItem on a work queue thread, the module while a
+ * module command (e.g. start) runs, or the thread name otherwise.
+ * The current and peak number of bytes are kept per tag.
+ * Allocations with malloc() are not attributed.
+ */
+
+#pragma once
+
+#include <px4_platform_common/px4_config.h>
+
+#if defined(CONFIG_HEAP_USAGE)
+
+namespace px4
+{
+namespace heap_usage
+{
+
+/**
+ * Register the calling thread for tagged allocations.
+ * @return the slot of the thread, or -1 if the table is full
+ */
+int register_thread();
+
+void unregister_thread(int slot);
+
+/**
+ * Attribute the following allocations of the thread in slot to tag, nullptr for the thread name.
+ * The string has to stay valid until the tag is changed again.
+ */
+void set_tag(int slot, const char *tag);
+
+const char *get_tag(int slot);
+
+/**
+ * Print the current and peak heap usage per tag.
+ */
+void print_status();
+
+/**
+ * Attribute the allocations of the calling thread to tag within the scope.
+ */
+class Scope
+{
+public:
+	explicit Scope(const char *tag);
+	~Scope();
+
+	Scope(const Scope &) = delete;
+	Scope &operator=(const Scope &) = delete;
+
+private:
+	int _slot{-1};
+	bool _registered{false};
+	const char *_previous_tag{nullptr};
+};
+
+} // namespace heap_usage
+} // namespace px4
+
+#endif // CONFIG_HEAP_USAGE
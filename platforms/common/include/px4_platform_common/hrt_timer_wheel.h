@@ -0,0 +1,371 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file hrt_timer_wheel.h
+ *
+ * Hierarchical timer wheel for the HRT callouts (CONFIG_HRT_TIMER_WHEEL).
+ *
+ * Insert and cancel are O(1), callouts are kept in doubly linked slot lists.
+ * Level 0 has 256 slots of one tick each, the 3 upper levels 64 slots each,
+ * which are cascaded down as time advances. Callouts further out than the
+ * wheel range are kept in an overflow list, re-sorted once per wheel rotation.
+ *
+ * A tick is the largest power of 2 microseconds within the configured slack.
+ * The callouts of a tick are invoked together at the latest deadline of the
+ * tick, so they are delayed by at most the slack and never invoked early.
+ *
+ * The caller is responsible for locking, callouts must be zero initialized.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+
+#if !defined(CONFIG_HRT_TIMER_WHEEL_SLACK_US)
+# define CONFIG_HRT_TIMER_WHEEL_SLACK_US 0
+#endif
+
+#define HRT_WHEEL_SLACK_TICKS	(CONFIG_HRT_TIMER_WHEEL_SLACK_US + 1)
+#define HRT_WHEEL_TICK_SHIFT	((HRT_WHEEL_SLACK_TICKS >= 256) ? 8 : (HRT_WHEEL_SLACK_TICKS >= 128) ? 7 : \
+				 (HRT_WHEEL_SLACK_TICKS >= 64) ? 6 : (HRT_WHEEL_SLACK_TICKS >= 32) ? 5 : \
+				 (HRT_WHEEL_SLACK_TICKS >= 16) ? 4 : (HRT_WHEEL_SLACK_TICKS >= 8) ? 3 : \
+				 (HRT_WHEEL_SLACK_TICKS >= 4) ? 2 : (HRT_WHEEL_SLACK_TICKS >= 2) ? 1 : 0)
+
+#define HRT_WHEEL_LEVELS	4
+#define HRT_WHEEL_L0_BITS	8
+#define HRT_WHEEL_LN_BITS	6
+#define HRT_WHEEL_L0_SIZE	(1u << HRT_WHEEL_L0_BITS)
+#define HRT_WHEEL_LN_SIZE	(1u << HRT_WHEEL_LN_BITS)
+#define HRT_WHEEL_SLOTS		(HRT_WHEEL_L0_SIZE + (HRT_WHEEL_LEVELS - 1) * HRT_WHEEL_LN_SIZE)
+#define HRT_WHEEL_RANGE_BITS	(HRT_WHEEL_L0_BITS + (HRT_WHEEL_LEVELS - 1) * HRT_WHEEL_LN_BITS)
+
+#define HRT_WHEEL_NONE		UINT64_MAX
+
+struct hrt_timer_wheel {
+	struct hrt_call	*slots[HRT_WHEEL_SLOTS];
+	uint32_t	occupied[(HRT_WHEEL_SLOTS + 31) / 32];	///< bitmap of the non-empty slots
+	uint8_t		latest[HRT_WHEEL_L0_SIZE];		///< latest deadline of a level 0 slot, relative to the tick start
+	struct hrt_call	*overflow;
+	uint64_t	tick;					///< current tick, never ahead of the time
+};
+
+static inline unsigned hrt_wheel_level_shift(unsigned level)
+{
+	return (level == 0) ? 0 : HRT_WHEEL_L0_BITS + (level - 1) * HRT_WHEEL_LN_BITS;
+}
+
+static inline unsigned hrt_wheel_level_offset(unsigned level)
+{
+	return (level == 0) ? 0 : HRT_WHEEL_L0_SIZE + (level - 1) * HRT_WHEEL_LN_SIZE;
+}
+
+static inline uint64_t hrt_wheel_mask(unsigned bits)
+{
+	return (((uint64_t)1) << bits) - 1;
+}
+
+/**
+ * Find the first non-empty slot in [first, end), -1 if none.
+ */
+static inline int hrt_wheel_find(const struct hrt_timer_wheel *wheel, unsigned first, unsigned end)
+{
+	while (first < end) {
+		const uint32_t word = wheel->occupied[first / 32] >> (first % 32);
+
+		if (word != 0) {
+			const unsigned slot = first + __builtin_ctz(word);
+			return (slot < end) ? (int)slot : -1;
+		}
+
+		first = (first | 31) + 1;
+	}
+
+	return -1;
+}
+
+static inline void hrt_wheel_link(struct hrt_call **head, struct hrt_call *entry)
+{
+	entry->wheel_next = *head;
+
+	if (*head != NULL) {
+		(*head)->wheel_pprev = &entry->wheel_next;
+	}
+
+	entry->wheel_pprev = head;
+	*head = entry;
+}
+
+static inline void hrt_wheel_init(struct hrt_timer_wheel *wheel, hrt_abstime now)
+{
+	memset(wheel, 0, sizeof(*wheel));
+	wheel->tick = now >> HRT_WHEEL_TICK_SHIFT;
+}
+
+/**
+ * Insert a callout by its deadline, a deadline in the past is due immediately.
+ */
+static inline void hrt_wheel_add(struct hrt_timer_wheel *wheel, struct hrt_call *entry)
+{
+	uint64_t tick = entry->deadline >> HRT_WHEEL_TICK_SHIFT;
+
+	if (tick < wheel->tick) {
+		tick = wheel->tick;
+	}
+
+	const uint64_t delta = tick - wheel->tick;
+	unsigned slot;
+
+	if (delta < HRT_WHEEL_L0_SIZE) {
+		slot = tick & (HRT_WHEEL_L0_SIZE - 1);
+
+		const hrt_abstime tick_start = tick << HRT_WHEEL_TICK_SHIFT;
+		const uint8_t offset = (entry->deadline > tick_start) ? (uint8_t)(entry->deadline - tick_start) : 0;
+
+		if ((wheel->slots[slot] == NULL) || (offset > wheel->latest[slot])) {
+			wheel->latest[slot] = offset;
+		}
+
+	} else {
+		unsigned level = 1;
+
+		while ((level < HRT_WHEEL_LEVELS) && (delta >> (hrt_wheel_level_shift(level) + HRT_WHEEL_LN_BITS)) != 0) {
+			level++;
+		}
+
+		if (level == HRT_WHEEL_LEVELS) {
+			hrt_wheel_link(&wheel->overflow, entry);
+			return;
+		}
+
+		slot = hrt_wheel_level_offset(level) + ((tick >> hrt_wheel_level_shift(level)) & (HRT_WHEEL_LN_SIZE - 1));
+	}
+
+	wheel->occupied[slot / 32] |= 1u << (slot % 32);
+	hrt_wheel_link(&wheel->slots[slot], entry);
+}
+
+/**
+ * Remove a callout, nothing happens if it isn't queued.
+ */
+static inline void hrt_wheel_remove(struct hrt_timer_wheel *wheel, struct hrt_call *entry)
+{
+	struct hrt_call **pprev = entry->wheel_pprev;
+
+	if (pprev == NULL) {
+		return;
+	}
+
+	*pprev = entry->wheel_next;
+
+	if (entry->wheel_next != NULL) {
+		entry->wheel_next->wheel_pprev = pprev;
+	}
+
+	// the entry was the only one of its slot
+	if ((pprev >= &wheel->slots[0]) && (pprev < &wheel->slots[HRT_WHEEL_SLOTS]) && (*pprev == NULL)) {
+		const unsigned slot = pprev - &wheel->slots[0];
+		wheel->occupied[slot / 32] &= ~(1u << (slot % 32));
+	}
+
+	entry->wheel_next = NULL;
+	entry->wheel_pprev = NULL;
+}
+
+static inline void hrt_wheel_readd(struct hrt_timer_wheel *wheel, struct hrt_call *list)
+{
+	while (list != NULL) {
+		struct hrt_call *next = list->wheel_next;
+		hrt_wheel_add(wheel, list);
+		list = next;
+	}
+}
+
+/**
+ * Move the callouts of the upper level slots starting at tick down, highest level first.
+ */
+static inline void hrt_wheel_cascade(struct hrt_timer_wheel *wheel, uint64_t tick)
+{
+	if ((tick & hrt_wheel_mask(HRT_WHEEL_RANGE_BITS)) == 0) {
+		struct hrt_call *list = wheel->overflow;
+		wheel->overflow = NULL;
+		hrt_wheel_readd(wheel, list);
+	}
+
+	for (unsigned level = HRT_WHEEL_LEVELS - 1; level > 0; level--) {
+		const unsigned shift = hrt_wheel_level_shift(level);
+
+		if ((tick & hrt_wheel_mask(shift)) == 0) {
+			const unsigned slot = hrt_wheel_level_offset(level) + ((tick >> shift) & (HRT_WHEEL_LN_SIZE - 1));
+			struct hrt_call *list = wheel->slots[slot];
+
+			wheel->slots[slot] = NULL;
+			wheel->occupied[slot / 32] &= ~(1u << (slot % 32));
+			hrt_wheel_readd(wheel, list);
+		}
+	}
+}
+
+/**
+ * A cascade at the aligned tick would move callouts of the given or a higher level.
+ */
+static inline bool hrt_wheel_cascade_pending(const struct hrt_timer_wheel *wheel, uint64_t tick, unsigned level)
+{
+	for (; level < HRT_WHEEL_LEVELS; level++) {
+		const unsigned shift = hrt_wheel_level_shift(level);
+
+		if ((tick & hrt_wheel_mask(shift)) != 0) {
+			return false;
+		}
+
+		const unsigned slot = hrt_wheel_level_offset(level) + ((tick >> shift) & (HRT_WHEEL_LN_SIZE - 1));
+
+		if (wheel->slots[slot] != NULL) {
+			return true;
+		}
+	}
+
+	return ((tick & hrt_wheel_mask(HRT_WHEEL_RANGE_BITS)) == 0) && (wheel->overflow != NULL);
+}
+
+/**
+ * Earliest tick after the current level 0 rotation at which callouts need to move,
+ * possibly earlier than necessary but never later. HRT_WHEEL_NONE if the wheel is empty.
+ */
+static inline uint64_t hrt_wheel_next_cascade(const struct hrt_timer_wheel *wheel)
+{
+	uint64_t tick = (wheel->tick | (HRT_WHEEL_L0_SIZE - 1)) + 1;
+
+	// level 0 callouts of the next rotation
+	if (hrt_wheel_find(wheel, 0, wheel->tick & (HRT_WHEEL_L0_SIZE - 1)) >= 0) {
+		return tick;
+	}
+
+	for (unsigned level = 1; level < HRT_WHEEL_LEVELS; level++) {
+		const unsigned shift = hrt_wheel_level_shift(level);
+		const unsigned offset = hrt_wheel_level_offset(level);
+		const unsigned index = (tick >> shift) & (HRT_WHEEL_LN_SIZE - 1);
+		const uint64_t rotation = hrt_wheel_mask(shift + HRT_WHEEL_LN_BITS);
+
+		if (hrt_wheel_cascade_pending(wheel, tick, level + 1)) {
+			return tick;
+		}
+
+		const int slot = hrt_wheel_find(wheel, offset + index, offset + HRT_WHEEL_LN_SIZE);
+
+		if (slot >= 0) {
+			return (tick & ~rotation) | ((uint64_t)(slot - offset) << shift);
+		}
+
+		// continue with the next rotation of this level
+		tick = (tick | rotation) + 1;
+
+		if (hrt_wheel_find(wheel, offset, offset + index) >= 0) {
+			return tick;
+		}
+	}
+
+	return (wheel->overflow != NULL) ? tick : HRT_WHEEL_NONE;
+}
+
+/**
+ * Time of the next timer event: the latest deadline of the next level 0 tick, or the next
+ * cascade. HRT_WHEEL_NONE if the wheel is empty.
+ */
+static inline hrt_abstime hrt_wheel_next_deadline(const struct hrt_timer_wheel *wheel)
+{
+	const int slot = hrt_wheel_find(wheel, wheel->tick & (HRT_WHEEL_L0_SIZE - 1), HRT_WHEEL_L0_SIZE);
+
+	if (slot >= 0) {
+		const uint64_t tick = (wheel->tick & ~(uint64_t)(HRT_WHEEL_L0_SIZE - 1)) | (unsigned)slot;
+		return (tick << HRT_WHEEL_TICK_SHIFT) + wheel->latest[slot];
+	}
+
+	const uint64_t tick = hrt_wheel_next_cascade(wheel);
+
+	return (tick == HRT_WHEEL_NONE) ? HRT_WHEEL_NONE : (tick << HRT_WHEEL_TICK_SHIFT);
+}
+
+/**
+ * Advance the wheel to now and remove one callout which is due, NULL if there is none.
+ */
+static inline struct hrt_call *hrt_wheel_pop_due(struct hrt_timer_wheel *wheel, hrt_abstime now)
+{
+	const uint64_t now_tick = now >> HRT_WHEEL_TICK_SHIFT;
+
+	while (wheel->tick <= now_tick) {
+		const int slot = hrt_wheel_find(wheel, wheel->tick & (HRT_WHEEL_L0_SIZE - 1), HRT_WHEEL_L0_SIZE);
+
+		if (slot >= 0) {
+			const uint64_t tick = (wheel->tick & ~(uint64_t)(HRT_WHEEL_L0_SIZE - 1)) | (unsigned)slot;
+
+			if (tick > now_tick) {
+				wheel->tick = now_tick;
+				return NULL;
+			}
+
+			wheel->tick = tick;
+
+			for (struct hrt_call *call = wheel->slots[slot]; call != NULL; call = call->wheel_next) {
+				if (call->deadline <= now) {
+					hrt_wheel_remove(wheel, call);
+					return call;
+				}
+			}
+
+			// only callouts later within the current tick
+			return NULL;
+		}
+
+		const uint64_t cascade = hrt_wheel_next_cascade(wheel);
+
+		if ((cascade == HRT_WHEEL_NONE) || (cascade > now_tick)) {
+			wheel->tick = now_tick;
+			return NULL;
+		}
+
+		wheel->tick = cascade;
+		hrt_wheel_cascade(wheel, cascade);
+	}
+
+	return NULL;
+}
+
+#endif // CONFIG_HRT_TIMER_WHEEL
@@ -37,7 +37,7 @@
 
 #if defined(BOARD_ENABLE_LOG_HISTORY)
 #include <stdio.h>
-#include <px4_platform_common/sem.h>
+#include <containers/LockFreeByteRing.hpp>
 
 #ifndef BOARD_LOG_HISTORY_SIZE
 #define BOARD_LOG_HISTORY_SIZE (1024*4) // default buffer size
@@ -46,23 +46,15 @@
 class LogHistory
 {
 public:
-	LogHistory() { px4_sem_init(&_lock, 0, 1); }
-	~LogHistory() { px4_sem_destroy(&_lock); }
+	/**
+	 * Log a null terminated string. Lock-free, can be used from any context.
+	 */
+	void write(const char *buffer) { _log_history.write(buffer, strlen(buffer)); }
 
-	void write(const char *buffer);
 	void print(FILE *out);
 
 private:
-	void lock() { do {} while (px4_sem_wait(&_lock) != 0); }
-	void unlock() { px4_sem_post(&_lock); }
-
-	int size();
-	int read(char *buffer, int buffer_length, int *offset);
-
-	char _log_history[BOARD_LOG_HISTORY_SIZE];
-	int _head{0};
-	int _tail{0};
-	px4_sem_t _lock;
+	LockFreeByteRing<BOARD_LOG_HISTORY_SIZE> _log_history;
 };
 
 #endif
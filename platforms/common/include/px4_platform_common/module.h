@@ -42,6 +42,7 @@
 #include <stdbool.h>
 
 #include <px4_platform_common/atomic.h>
+#include <px4_platform_common/heap_usage.h>
 #include <px4_platform_common/time.h>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/tasks.h>
@@ -136,6 +137,10 @@ public:
 		}
 
 		if (strcmp(argv[1], "start") == 0) {
+#if defined(CONFIG_HEAP_USAGE)
+			// attribute the allocations of the instantiation to the module
+			px4::heap_usage::Scope heap_usage_scope(argv[0]);
+#endif // CONFIG_HEAP_USAGE
 			// Pass the 'start' argument too, because later on px4_getopt() will ignore the first argument.
 			return start_command_base(argc - 1, argv + 1);
 		}
@@ -364,16 +369,14 @@ protected:
 	 */
 	static int wait_until_running(int timeout_ms = 1000)
 	{
-		int i = 0;
+		// the new thread might already be running (e.g. if it has a higher priority), so check before sleeping
+		for (int i = 0; !_object.load(); ++i) {
+			if (i >= timeout_ms / 2) {
+				PX4_ERR("Timed out while waiting for thread to start");
+				return -1;
+			}
 
-		do {
 			px4_usleep(2000);
-
-		} while (!_object.load() && ++i < timeout_ms / 2);
-
-		if (i >= timeout_ms / 2) {
-			PX4_ERR("Timed out while waiting for thread to start");
-			return -1;
 		}
 
 		return 0;
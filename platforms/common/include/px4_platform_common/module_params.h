@@ -83,11 +83,35 @@ protected:
 	 */
 	virtual void updateParams()
 	{
+		// read before the values, so that changes during the update are seen next time
+		const uint32_t generation = param_generation();
+
 		for (const auto &child : _children) {
 			child->updateParams();
 		}
 
 		updateParamsImpl();
+		_params_generation = generation;
+	}
+
+	/**
+	 * @brief Like updateParams(), but skipped if none of the parameters of this class and its children
+	 *        changed since the last update, e.g. on a notification about a parameter of another module.
+	 *        Only use this if all the parameters of the tree are defined with DEFINE_PARAMETERS().
+	 * @return true if updateParams() was called
+	 */
+	bool updateParamsIfChanged()
+	{
+		const uint32_t generation = param_generation();
+
+		if (paramsChanged()) {
+			updateParams();
+			return true;
+		}
+
+		// skip the unrelated changes next time
+		setParamsGeneration(generation);
+		return false;
 	}
 
 	/**
@@ -95,8 +119,35 @@ protected:
 	 */
 	virtual void updateParamsImpl() {}
 
+	/**
+	 * @brief The implementation for this is generated with the macro DEFINE_PARAMETERS()
+	 * @return true if one of the parameters changed after the given generation
+	 */
+	virtual bool paramsChangedImpl(uint32_t generation) const { return false; }
+
 private:
+	bool paramsChanged()
+	{
+		for (const auto &child : _children) {
+			if (child->paramsChanged()) {
+				return true;
+			}
+		}
+
+		return paramsChangedImpl(_params_generation);
+	}
+
+	void setParamsGeneration(uint32_t generation)
+	{
+		for (const auto &child : _children) {
+			child->setParamsGeneration(generation);
+		}
+
+		_params_generation = generation;
+	}
+
 	/** @list _children The module parameter list of inheriting classes. */
 	List<ModuleParams *> _children;
 	ModuleParams *_parent{nullptr};
+	uint32_t _params_generation{0}; ///< param_generation() of the last update
 };
@@ -62,6 +62,9 @@ inline static param_t param_handle(px4::params p)
 #define _CALL_UPDATE(x) \
 	STRIP(x).update();
 
+#define _CALL_CHANGED(x) \
+	|| param_changed_since(STRIP(x).handle(), generation)
+
 // define the parameter update method, which will update all parameters.
 // It is marked as 'final', so that wrong usages lead to a compile error (see below)
 #define _DEFINE_PARAMETER_UPDATE_METHOD(...) \
@@ -69,6 +72,9 @@ inline static param_t param_handle(px4::params p)
 	void updateParamsImpl() final { \
 		APPLY_ALL(_CALL_UPDATE, __VA_ARGS__) \
 	} \
+	bool paramsChangedImpl(uint32_t generation) const final { \
+		return false APPLY_ALL(_CALL_CHANGED, __VA_ARGS__); \
+	} \
 	private:
 
 // Define a list of parameters. This macro also creates code to update parameters.
@@ -88,6 +94,9 @@ inline static param_t param_handle(px4::params p)
 		parent_class::updateParamsImpl(); \
 		APPLY_ALL(_CALL_UPDATE, __VA_ARGS__) \
 	} \
+	bool paramsChangedImpl(uint32_t generation) const override { \
+		return parent_class::paramsChangedImpl(generation) APPLY_ALL(_CALL_CHANGED, __VA_ARGS__); \
+	} \
 	private:
 
 #define DEFINE_PARAMETERS_CUSTOM_PARENT(parent_class, ...) \
@@ -56,6 +56,7 @@ struct print_load_s {
 	uint64_t new_time{0};
 	uint64_t interval_start_time{0};
 	uint64_t last_times[CONFIG_FS_PROCFS_MAX_TASKS] {};
+	uint64_t last_irq_time{0};
 	float interval_time_us{0.f};
 };
 
@@ -54,12 +54,17 @@ public:
 	void ScheduleDelayed(uint32_t delay_us);
 
 	/**
-	 * Schedule repeating run with optional delay.
+	 * Schedule repeating run with optional delay and execution budget.
+	 * A Run() exceeding the budget is counted and reported, low criticality items can additionally
+	 * skip their next run to give the other items on the queue time to catch up.
 	 *
 	 * @param interval_us		The interval in microseconds.
 	 * @param delay_us		The delay (optional) in microseconds.
+	 * @param budget_us		The execution budget (optional) of a single run in microseconds, 0 to disable.
+	 * @param skip_next_on_overrun	Skip the next run after an overrun (optional).
 	 */
-	void ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us = 0);
+	void ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us = 0, uint32_t budget_us = 0,
+				bool skip_next_on_overrun = false);
 
 	/**
 	 * Schedule next run at a specific time.
@@ -38,11 +38,16 @@
 
 #include <containers/IntrusiveQueue.hpp>
 #include <containers/IntrusiveSortedList.hpp>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <drivers/drv_hrt.h>
 #include <lib/mathlib/mathlib.h>
 #include <lib/perf/perf_counter.h>
 
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+#include <uORB/LatencyHistogram.hpp>
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
 #include <string.h>
 
 namespace px4
@@ -70,8 +75,55 @@ public:
 		}
 	}
 
+	/**
+	 * Schedule from a uORB callback, i.e. as the next stage of a pipeline (see CONFIG_WQ_DIRECT_CHAIN).
+	 */
+	inline void ScheduleChained()
+	{
+		if (_wq != nullptr) {
+			_wq->Add(this, true);
+		}
+	}
+
 	virtual void print_run_status();
 
+	/**
+	 * Set a deadline relative to the trigger (ScheduleNow(), callback or interval), default 0: no deadline.
+	 * Work queues in earliest deadline first mode run the queued item with the earliest deadline first,
+	 * on every queue a start after the deadline is counted as a miss.
+	 */
+	void SetDeadline(uint32_t deadline_us) { _deadline_us = deadline_us; }
+
+	uint32_t deadline_misses() const { return _deadline_misses; }
+
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+	/**
+	 * Run as a fused pipeline stage: if scheduled from a Run() on the same single threaded work queue,
+	 * the item runs directly after that Run() returns instead of being queued.
+	 */
+	void SetInline(bool enable) { _inline = enable; }
+#endif // CONFIG_WQ_INLINE_CHAIN
+
+	/**
+	 * Number of runs exceeding the execution budget (see ScheduledWorkItem::ScheduleOnInterval())
+	 */
+	uint32_t budget_overruns() const { return _budget_overruns; }
+
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+	/**
+	 * Deepest stack use of Run() below the work queue loop in bytes
+	 */
+	uint32_t stack_usage() const { return _stack_usage; }
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+	/**
+	 * Execution time of Run() and latency from the first ScheduleNow() of a pending run until Run() starts
+	 */
+	const uORB::LatencyHistogram &run_time_histogram() const { return _run_time_histogram; }
+	const uORB::LatencyHistogram &schedule_latency_histogram() const { return _schedule_latency_histogram; }
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
 	/**
 	 * Switch to a different WorkQueue.
 	 * NOTE: Caller is responsible for synchronization.
@@ -83,6 +135,11 @@ public:
 
 	const char *ItemName() const { return _item_name; }
 
+	/**
+	 * Relative priority of the WorkQueue the item is currently attached to (INT8_MIN if none).
+	 */
+	int8_t WorkQueuePriority() const { return (_wq != nullptr) ? _wq->get_config().relative_priority : INT8_MIN; }
+
 protected:
 
 	explicit WorkItem(const char *name, const wq_config_t &config);
@@ -122,6 +179,18 @@ protected:
 	bool Init(const wq_config_t &config);
 	void Deinit();
 
+	/**
+	 * Print the optional deadline and histogram statistics, appended to the print_run_status() line
+	 */
+	void print_run_status_details();
+
+	/**
+	 * Set the execution budget of a single Run(), 0 to disable.
+	 * @param budget_us		maximum execution time in microseconds
+	 * @param skip_next_on_overrun	skip the next run after an overrun (for low criticality items)
+	 */
+	void SetBudget(uint32_t budget_us, bool skip_next_on_overrun);
+
 	float elapsed_time() const;
 	float average_rate() const;
 	float average_interval() const;
@@ -131,9 +200,41 @@ protected:
 	uint32_t	_run_count{0};
 
 private:
+	friend class WorkQueue;
 
 	WorkQueue	*_wq{nullptr};
 
+	hrt_abstime	_deadline{0};        ///< absolute deadline of the pending run
+	uint32_t	_deadline_us{0};     ///< deadline relative to the trigger, 0 if unused
+	uint32_t	_deadline_misses{0};
+
+	hrt_abstime	_budget_event_time{0}; ///< last overrun report
+	uint32_t	_budget_us{0};         ///< execution budget of Run(), 0 if unused
+	uint32_t	_budget_overruns{0};
+	uint32_t	_budget_skips{0};
+	bool		_skip_next_on_overrun{false};
+	bool		_skip_next{false};
+
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+	bool		_inline{false};
+#endif // CONFIG_WQ_INLINE_CHAIN
+
+#if defined(WQ_LOCKFREE_ADD)
+	WorkItem	*_inbox_next{nullptr};
+	px4::atomic_bool _inbox_pending{false};
+	hrt_abstime	_trigger_time{0};    ///< time of the Add() to the inbox
+#endif // WQ_LOCKFREE_ADD
+
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+	uint32_t	_stack_usage{0};
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+	hrt_abstime	_schedule_time{0};
+	uORB::LatencyHistogram _run_time_histogram{};
+	uORB::LatencyHistogram _schedule_latency_histogram{};
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
 };
 
 } // namespace px4
@@ -42,6 +42,12 @@
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/sem.h>
 #include <px4_platform_common/tasks.h>
+#include <drivers/drv_hrt.h>
+
+// lockstep needs the work lock in Add() to register the component
+#if defined(CONFIG_WQ_LOCKFREE_ADD) && !defined(ENABLE_LOCKSTEP_SCHEDULER)
+# define WQ_LOCKFREE_ADD
+#endif
 
 namespace px4
 {
@@ -51,6 +57,8 @@ class WorkItem;
 class WorkQueue : public IntrusiveSortedListNode<WorkQueue *>
 {
 public:
+	static constexpr uint8_t MAX_THREADS = 8;
+
 	explicit WorkQueue(const wq_config_t &wq_config);
 	WorkQueue() = delete;
 
@@ -62,17 +70,37 @@ public:
 	bool Attach(WorkItem *item);
 	void Detach(WorkItem *item);
 
-	void Add(WorkItem *item);
+	/**
+	 * Queue an item to run.
+	 * @param chained scheduled by a uORB callback. With CONFIG_WQ_DIRECT_CHAIN a chained item scheduled
+	 *                from a Run() on this queue runs right after the current item, other items keep FIFO order.
+	 */
+	void Add(WorkItem *item, bool chained = false);
 	void Remove(WorkItem *item);
 
 	void Clear();
 
+	/**
+	 * Process the queue, called by each worker thread (more than one in pool mode).
+	 */
 	void Run();
 
+	unsigned num_threads() const
+	{
+		return (_config.num_threads == 0) ? 1 : ((_config.num_threads > MAX_THREADS) ? MAX_THREADS : _config.num_threads);
+	}
+
 	void request_stop() { _should_exit.store(true); }
 
 	void print_status(bool last = false);
 
+	/**
+	 * Call visitor for the attached WorkItem with the given index, while the queue is locked.
+	 * @param index item index, reduced by the number of items of this queue if out of range
+	 * @return true if the item was found in this queue
+	 */
+	bool visit_item(unsigned &index, void (*visitor)(const WorkQueue &wq, const WorkItem &item, void *arg), void *arg);
+
 	// WorkQueues sorted numerically by relative priority (-1 to -255)
 	bool operator<=(const WorkQueue &rhs) const { return _config.relative_priority >= rhs.get_config().relative_priority; }
 
@@ -82,6 +110,34 @@ private:
 
 	inline void SignalWorkerThread();
 
+	/**
+	 * Remove and return the next item to run, must hold work_lock.
+	 * FIFO, or the earliest deadline first in EDF mode. In pool mode items running on another
+	 * worker are skipped and stay queued.
+	 */
+	WorkItem *Pop();
+
+	bool IsRunning(const WorkItem *item) const;
+
+#if defined(WQ_LOCKFREE_ADD)
+	// move the items of the inbox to the run queue in the order they were added, must hold work_lock
+	void DrainInbox();
+#endif // WQ_LOCKFREE_ADD
+
+	// the calling thread is a worker of this queue
+	bool IsWorkerThread() const;
+
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+	// run the inline items scheduled by the item that just returned, worker thread only
+	void RunInline();
+#endif // CONFIG_WQ_INLINE_CHAIN
+
+	// item is still attached (not deleted), must hold work_lock
+	bool IsAttached(const WorkItem *item);
+
+	// count and report a Run() exceeding the item budget, must hold work_lock (temporarily released)
+	void BudgetOverrun(WorkItem *item, uint32_t run_time, hrt_abstime now);
+
 #ifdef __PX4_NUTTX
 	// In NuttX work can be enqueued from an ISR
 	void work_lock() { _flags = enter_critical_section(); }
@@ -95,12 +151,30 @@ private:
 #endif
 
 	IntrusiveQueue<WorkItem *>	_q;
+
+#if defined(WQ_LOCKFREE_ADD)
+	px4::atomic<WorkItem *>		_inbox{nullptr}; ///< lock-free stack of added items, newest first
+#endif // WQ_LOCKFREE_ADD
 	px4_sem_t			_process_lock;
 	px4_sem_t			_exit_lock;
 	const wq_config_t		&_config;
 	BlockingList<WorkItem *>	_work_items;
 	px4::atomic_bool		_should_exit{false};
 
+	WorkItem			*_running[MAX_THREADS] {}; ///< item currently run by each worker
+	px4::atomic<uint8_t>		_next_worker{0};
+
+#if defined(CONFIG_WQ_DIRECT_CHAIN)
+	pthread_t			_worker_threads[MAX_THREADS] {};
+#endif // CONFIG_WQ_DIRECT_CHAIN
+
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+	static constexpr uint8_t MAX_INLINE_ITEMS = 4;
+
+	WorkItem			*_inline_items[MAX_INLINE_ITEMS] {}; ///< pending inline items, in order of scheduling
+	uint8_t				_num_inline_items{0};
+#endif // CONFIG_WQ_INLINE_CHAIN
+
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	int _lockstep_component {-1};
 #endif // ENABLE_LOCKSTEP_SCHEDULER
@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file sched_trace.h
+ *
+ * Low-overhead scheduler trace (CONFIG_SCHED_TRACE).
+ *
+ * Timestamped events (work item start/stop, uORB publish, HRT callouts and
+ * work queue wakeups) are recorded into a ring buffer per CPU. Recording is
+ * lock-free and can be done from any context, including interrupts.
+ * The buffers can be dumped in the Chrome trace event format, which can be
+ * opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ */
+
+#pragma once
+
+#include <px4_platform_common/defines.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+enum sched_trace_type {
+	SCHED_TRACE_WQ_ITEM_START,	/**< arg: work item name */
+	SCHED_TRACE_WQ_ITEM_STOP,	/**< arg: work item name */
+	SCHED_TRACE_ORB_PUBLISH,	/**< arg: topic name */
+	SCHED_TRACE_HRT_CALLOUT,	/**< arg: callout function */
+	SCHED_TRACE_WQ_WAKE,		/**< arg: work queue name, the worker thread semaphore is posted */
+};
+
+struct sched_trace_event {
+	uint64_t	timestamp;
+	uintptr_t	arg;		/**< static string or pointer, depending on the type */
+	uint32_t	tid;		/**< task/thread ID, 0 in interrupt context */
+	uint8_t		type;		/**< sched_trace_type */
+	uint8_t		cpu;
+};
+
+__BEGIN_DECLS
+
+#if defined(CONFIG_SCHED_TRACE)
+
+/**
+ * Record an event, if tracing is enabled.
+ */
+__EXPORT void sched_trace_record(enum sched_trace_type type, uintptr_t arg);
+
+/**
+ * Start (clearing the buffers) or stop recording.
+ */
+__EXPORT void sched_trace_enable(bool enable);
+
+__EXPORT bool sched_trace_enabled(void);
+
+/**
+ * Number of events recorded since the trace was started, including overwritten ones.
+ */
+__EXPORT uint32_t sched_trace_event_count(void);
+
+/**
+ * Stop recording and write the buffered events to a file in the Chrome trace event (JSON) format.
+ *
+ * @return 0 on success, -errno otherwise
+ */
+__EXPORT int sched_trace_dump(const char *path);
+
+#define SCHED_TRACE(type, arg) sched_trace_record((type), (uintptr_t)(arg))
+
+#else
+
+#define SCHED_TRACE(type, arg)
+
+#endif // CONFIG_SCHED_TRACE
+
+__END_DECLS
@@ -45,7 +45,7 @@ void LogHistory::print(FILE *out)
 	int total_size_read = 0;
 
 	do {
-		int read_size = read(buffer, buffer_length, &offset);
+		int read_size = _log_history.read(buffer, buffer_length, &offset);
 
 		if (read_size <= 0) {
 			break;
@@ -61,87 +61,4 @@ void LogHistory::print(FILE *out)
 	} while (total_size_read < BOARD_LOG_HISTORY_SIZE);
 }
 
-// Log a null terminated string to the circular history buffer.
-void LogHistory::write(const char *buffer)
-{
-	lock(); // same rule as for printf: this cannot be used from IRQ handlers
-
-	int i = 0;
-
-	while (buffer[i] != '\0') {
-
-		_log_history[_tail] = buffer[i++];
-		_tail = (_tail + 1) % BOARD_LOG_HISTORY_SIZE;
-
-		if (_tail == _head) {
-			_head = (_head + 1) % BOARD_LOG_HISTORY_SIZE;
-		}
-	}
-
-	unlock();
-}
-
-int LogHistory::size()
-{
-	lock();
-	int size;
-
-	if (_head <= _tail) {
-		size = _tail - _head;
-
-	} else {
-		size = BOARD_LOG_HISTORY_SIZE - (_head - _tail);
-	}
-
-	unlock();
-	return size;
-}
-
-int LogHistory::read(char *buffer, int buffer_length, int *offset)
-{
-	lock();
-
-	if (*offset == -1) {
-		*offset = _head;
-	}
-
-	int size = 0;
-
-	if (*offset < _tail) {
-		size = _tail - *offset;
-
-		if (size > buffer_length) {
-			size = buffer_length;
-		}
-
-		memcpy(buffer, _log_history + *offset, size);
-
-	} else if (_tail < *offset) {
-		size = BOARD_LOG_HISTORY_SIZE - *offset;
-
-		if (size > buffer_length) {
-			size = buffer_length;
-		}
-
-		memcpy(buffer, _log_history + *offset, size);
-		buffer += size;
-		buffer_length -= size;
-
-		int size_secondary = _tail;
-
-		if (size_secondary > buffer_length) {
-			size_secondary = buffer_length;
-		}
-
-		if (size_secondary > 0) {
-			memcpy(buffer, _log_history, size_secondary);
-			size += size_secondary;
-		}
-	}
-
-	unlock();
-	*offset = (*offset + size) % BOARD_LOG_HISTORY_SIZE;
-	return size;
-}
-
 #endif
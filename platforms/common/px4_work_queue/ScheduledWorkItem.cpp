@@ -55,8 +55,10 @@ void ScheduledWorkItem::ScheduleDelayed(uint32_t delay_us)
 	hrt_call_after(&_call, delay_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
-void ScheduledWorkItem::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us)
+void ScheduledWorkItem::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us, uint32_t budget_us,
+		bool skip_next_on_overrun)
 {
+	SetBudget(budget_us, skip_next_on_overrun);
 	hrt_call_every(&_call, delay_us, interval_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
@@ -75,8 +77,10 @@ void ScheduledWorkItem::ScheduleClear()
 void ScheduledWorkItem::print_run_status()
 {
 	if (_call.period > 0) {
-		PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us (%" PRId64 " us)\n", _item_name, (double)average_rate(),
+		PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us (%" PRId64 " us)", _item_name, (double)average_rate(),
 			     (double)average_interval(), _call.period);
+		print_run_status_details();
+		PX4_INFO_RAW("\n");
 
 	} else {
 		WorkItem::print_run_status();
@@ -132,9 +132,39 @@ float WorkItem::average_interval() const
 	return 0.f;
 }
 
+void WorkItem::SetBudget(uint32_t budget_us, bool skip_next_on_overrun)
+{
+	_budget_us = budget_us;
+	_skip_next_on_overrun = skip_next_on_overrun;
+}
+
+void WorkItem::print_run_status_details()
+{
+	if (_deadline_us > 0) {
+		PX4_INFO_RAW(" (deadline %" PRIu32 " us, %" PRIu32 " missed)", _deadline_us, _deadline_misses);
+	}
+
+	if (_budget_us > 0) {
+		PX4_INFO_RAW(" (budget %" PRIu32 " us, %" PRIu32 " overruns, %" PRIu32 " skipped)", _budget_us, _budget_overruns,
+			     _budget_skips);
+	}
+
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+	PX4_INFO_RAW(" stack: %" PRIu32 " B", _stack_usage);
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+	PX4_INFO_RAW(" run p99/max: %" PRIu32 "/%" PRIu32 " us, latency p99/max: %" PRIu32 "/%" PRIu32 " us",
+		     _run_time_histogram.percentile_us(99), _run_time_histogram.max_us(),
+		     _schedule_latency_histogram.percentile_us(99), _schedule_latency_histogram.max_us());
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+}
+
 void WorkItem::print_run_status()
 {
-	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us\n", _item_name, (double)average_rate(), (double)average_interval());
+	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us", _item_name, (double)average_rate(), (double)average_interval());
+	print_run_status_details();
+	PX4_INFO_RAW("\n");
 
 	// reset statistics
 	_run_count = 0;
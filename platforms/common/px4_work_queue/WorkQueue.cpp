@@ -36,14 +36,81 @@
 
 #include <string.h>
 
+#include <px4_platform_common/events.h>
+#include <px4_platform_common/heap_usage.h>
 #include <px4_platform_common/log.h>
+#include <px4_platform_common/sched_trace.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/time.h>
 #include <drivers/drv_hrt.h>
 
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE) && defined(__PX4_NUTTX)
+# include <nuttx/sched.h>
+#endif
+
+using namespace time_literals;
+
 namespace px4
 {
 
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+static constexpr uint32_t STACK_PAINT_PATTERN = 0xdeadbeef; // same as the NuttX stack coloration
+static constexpr uintptr_t STACK_PAINT_MARGIN = 128;        // kept free below the frame of stack_paint()
+
+/**
+ * Lowest address of the stack of the calling thread, 0 if unknown
+ */
+static uintptr_t stack_limit()
+{
+#if defined(__PX4_NUTTX)
+	return (uintptr_t)nxsched_self()->stack_base_ptr;
+#elif defined(__PX4_LINUX)
+	pthread_attr_t attr;
+	void *addr = nullptr;
+	size_t size = 0;
+
+	if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+		pthread_attr_getstack(&attr, &addr, &size);
+		pthread_attr_destroy(&attr);
+	}
+
+	return (uintptr_t)addr;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Lowest address between limit and top that is not painted
+ */
+static uintptr_t stack_lowest_used(uintptr_t limit, uintptr_t top)
+{
+	const uint32_t *p = (const uint32_t *)limit;
+
+	while (((uintptr_t)p < top) && (*p == STACK_PAINT_PATTERN)) {
+		p++;
+	}
+
+	return (uintptr_t)p;
+}
+
+/**
+ * Repaint the stack used since the last paint, up to a margin below the frame of this function.
+ * @return the top of the painted area
+ */
+static __attribute__((noinline)) uintptr_t stack_paint(uintptr_t limit)
+{
+	volatile uint32_t marker = 0;
+	const uintptr_t top = ((uintptr_t)&marker - STACK_PAINT_MARGIN) & ~(uintptr_t)(sizeof(uint32_t) - 1);
+
+	for (uint32_t *p = (uint32_t *)stack_lowest_used(limit, top); (uintptr_t)p < top; p++) {
+		*p = STACK_PAINT_PATTERN;
+	}
+
+	return top;
+}
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
 WorkQueue::WorkQueue(const wq_config_t &config) :
 	_config(config)
 {
@@ -105,6 +172,16 @@ void WorkQueue::Detach(WorkItem *item)
 
 	_work_items.remove(item);
 
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+
+	for (uint8_t i = 0; i < _num_inline_items; i++) {
+		if (_inline_items[i] == item) {
+			_inline_items[i] = nullptr;
+		}
+	}
+
+#endif // CONFIG_WQ_INLINE_CHAIN
+
 	if (_work_items.size() == 0) {
 		// shutdown, no active WorkItems
 		PX4_DEBUG("stopping: %s, last active WorkItem closing", _config.name);
@@ -126,8 +203,57 @@ void WorkQueue::Detach(WorkItem *item)
 	}
 }
 
-void WorkQueue::Add(WorkItem *item)
+void WorkQueue::Add(WorkItem *item, bool chained)
 {
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+
+	// fused pipeline stage scheduled by the running item, only the worker itself touches the inline items
+	if (item->_inline && (num_threads() == 1) && IsWorkerThread()) {
+		for (uint8_t i = 0; i < _num_inline_items; i++) {
+			if (_inline_items[i] == item) {
+				return;
+			}
+		}
+
+		if (_num_inline_items < MAX_INLINE_ITEMS) {
+			_inline_items[_num_inline_items++] = item;
+			return;
+		}
+	}
+
+#endif // CONFIG_WQ_INLINE_CHAIN
+
+#if defined(WQ_LOCKFREE_ADD)
+# if defined(CONFIG_WQ_DIRECT_CHAIN)
+
+	if (!IsWorkerThread())
+# endif // CONFIG_WQ_DIRECT_CHAIN
+	{
+		bool pending = false;
+
+		// already waiting in the inbox, the worker has been signalled
+		if (!item->_inbox_pending.compare_exchange(&pending, true)) {
+			return;
+		}
+
+# if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+		item->_trigger_time = hrt_absolute_time();
+# else
+		item->_trigger_time = (item->_deadline_us > 0) ? hrt_absolute_time() : 0;
+# endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
+		WorkItem *head = _inbox.load();
+
+		do {
+			item->_inbox_next = head;
+		} while (!_inbox.compare_exchange(&head, item));
+
+		SignalWorkerThread();
+		return;
+	}
+
+#endif // WQ_LOCKFREE_ADD
+
 	work_lock();
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
@@ -138,17 +264,223 @@ void WorkQueue::Add(WorkItem *item)
 
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
+	if (!_q.queued(item)) {
+		// the deadline is relative to the first trigger of a pending run
+		if (item->_deadline_us > 0) {
+			item->_deadline = hrt_absolute_time() + item->_deadline_us;
+		}
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+		item->_schedule_time = hrt_absolute_time();
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+	}
+
+#if defined(CONFIG_WQ_DIRECT_CHAIN)
+
+	// scheduled from a Run() on this queue, the worker checks the queue again before waiting
+	if (IsWorkerThread()) {
+		// only the next stage of a pipeline runs right away, an item rescheduling itself
+		// (or anything else) keeps FIFO order and cannot starve the rest of the queue
+		if (chained && !IsRunning(item)) {
+			_q.push_front(item);
+
+		} else {
+			_q.push(item);
+		}
+
+		work_unlock();
+		return;
+	}
+
+#endif // CONFIG_WQ_DIRECT_CHAIN
+
 	_q.push(item);
 	work_unlock();
 
 	SignalWorkerThread();
 }
 
+#if defined(WQ_LOCKFREE_ADD)
+void WorkQueue::DrainInbox()
+{
+	WorkItem *head = _inbox.load();
+
+	while (!_inbox.compare_exchange(&head, nullptr)) {}
+
+	// reverse into the order of addition
+	WorkItem *items = nullptr;
+
+	while (head != nullptr) {
+		WorkItem *next = head->_inbox_next;
+		head->_inbox_next = items;
+		items = head;
+		head = next;
+	}
+
+	while (items != nullptr) {
+		WorkItem *item = items;
+		items = item->_inbox_next;
+		item->_inbox_next = nullptr;
+
+		if (!_q.queued(item)) {
+			// the deadline is relative to the first trigger of a pending run
+			if (item->_deadline_us > 0) {
+				item->_deadline = item->_trigger_time + item->_deadline_us;
+			}
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+			item->_schedule_time = item->_trigger_time;
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
+			_q.push(item);
+		}
+
+		// the item can be added to the inbox again from here on
+		item->_inbox_pending.store(false);
+	}
+}
+#endif // WQ_LOCKFREE_ADD
+
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+void WorkQueue::RunInline()
+{
+	// items scheduled by an inline item are appended and run in the same loop
+	for (uint8_t i = 0; i < _num_inline_items; i++) {
+		WorkItem *item = _inline_items[i];
+		_inline_items[i] = nullptr;
+
+		// cleared if detached in the meantime
+		if (item != nullptr) {
+#if defined(CONFIG_SCHED_TRACE)
+			const char *item_name = item->ItemName();
+#endif // CONFIG_SCHED_TRACE
+
+			SCHED_TRACE(SCHED_TRACE_WQ_ITEM_START, item_name);
+			item->RunPreamble();
+			item->Run();
+			SCHED_TRACE(SCHED_TRACE_WQ_ITEM_STOP, item_name);
+		}
+	}
+
+	_num_inline_items = 0;
+}
+#endif // CONFIG_WQ_INLINE_CHAIN
+
+bool WorkQueue::IsWorkerThread() const
+{
+#if defined(CONFIG_WQ_DIRECT_CHAIN)
+	const pthread_t self = pthread_self();
+
+	for (unsigned i = 0; i < num_threads(); i++) {
+		if (pthread_equal(_worker_threads[i], self)) {
+			return true;
+		}
+	}
+
+#endif // CONFIG_WQ_DIRECT_CHAIN
+
+	return false;
+}
+
+void WorkQueue::BudgetOverrun(WorkItem *item, uint32_t run_time, hrt_abstime now)
+{
+	item->_budget_overruns++;
+
+	if (item->_skip_next_on_overrun) {
+		item->_skip_next = true;
+	}
+
+	// report at most every 10 seconds per item
+	if ((item->_budget_event_time == 0) || (now - item->_budget_event_time > 10_s)) {
+		item->_budget_event_time = now;
+
+		const uint32_t budget = item->_budget_us;
+		const char *name = item->ItemName();
+
+		// don't publish while holding the lock (critical section on NuttX)
+		work_unlock();
+
+		PX4_WARN("%s: %s exceeded budget (%" PRIu32 " us > %" PRIu32 " us)", _config.name, name, run_time, budget);
+
+		/* EVENT
+		 * @description
+		 * A work item ran longer than its execution budget and might delay the other items on the same work queue.
+		 * Check <tt>work_queue status</tt> for details.
+		 */
+		events::send<uint32_t, uint32_t>(events::ID("px4_work_queue_budget_overrun"), events::Log::Warning,
+						 "Work item exceeded execution budget ({1} us, budget {2} us)", run_time, budget);
+
+		work_lock();
+	}
+}
+
+bool WorkQueue::IsAttached(const WorkItem *item)
+{
+	for (WorkItem *attached : _work_items) {
+		if (attached == item) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool WorkQueue::IsRunning(const WorkItem *item) const
+{
+	for (unsigned i = 0; i < num_threads(); i++) {
+		if (_running[i] == item) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+WorkItem *WorkQueue::Pop()
+{
+	const bool pool = (num_threads() > 1);
+
+#if defined(WQ_LOCKFREE_ADD)
+	DrainInbox();
+#endif // WQ_LOCKFREE_ADD
+
+	if (!_config.edf && !pool) {
+		return _q.pop();
+	}
+
+	WorkItem *next = nullptr;
+
+	for (WorkItem *item : _q) {
+		// never run an item concurrently with itself
+		if (pool && IsRunning(item)) {
+			continue;
+		}
+
+		if (next == nullptr) {
+			next = item;
+
+			if (!_config.edf) {
+				break;
+			}
+
+		} else if ((item->_deadline_us > 0) && ((next->_deadline_us == 0) || (item->_deadline < next->_deadline))) {
+			next = item;
+		}
+	}
+
+	if (next != nullptr) {
+		_q.remove(next);
+	}
+
+	return next;
+}
+
 void WorkQueue::SignalWorkerThread()
 {
 	int sem_val;
 
 	if (px4_sem_getvalue(&_process_lock, &sem_val) == 0 && sem_val <= 0) {
+		SCHED_TRACE(SCHED_TRACE_WQ_WAKE, _config.name);
 		px4_sem_post(&_process_lock);
 	}
 }
@@ -156,6 +488,9 @@ void WorkQueue::SignalWorkerThread()
 void WorkQueue::Remove(WorkItem *item)
 {
 	work_lock();
+#if defined(WQ_LOCKFREE_ADD)
+	DrainInbox();
+#endif // WQ_LOCKFREE_ADD
 	_q.remove(item);
 	work_unlock();
 }
@@ -164,6 +499,10 @@ void WorkQueue::Clear()
 {
 	work_lock();
 
+#if defined(WQ_LOCKFREE_ADD)
+	DrainInbox();
+#endif // WQ_LOCKFREE_ADD
+
 	while (!_q.empty()) {
 		_q.pop();
 	}
@@ -173,6 +512,22 @@ void WorkQueue::Clear()
 
 void WorkQueue::Run()
 {
+	const unsigned worker = _next_worker.fetch_add(1) % MAX_THREADS;
+	const bool pool = (num_threads() > 1);
+
+#if defined(CONFIG_WQ_DIRECT_CHAIN)
+	_worker_threads[worker] = pthread_self();
+#endif // CONFIG_WQ_DIRECT_CHAIN
+
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+	// limit aligned up to a word, the painted area is scanned word by word
+	const uintptr_t stack_low = (stack_limit() + sizeof(uint32_t) - 1) & ~(uintptr_t)(sizeof(uint32_t) - 1);
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
+#if defined(CONFIG_HEAP_USAGE)
+	const int heap_usage_slot = heap_usage::register_thread();
+#endif // CONFIG_HEAP_USAGE
+
 	while (!should_exit()) {
 		// loop as the wait may be interrupted by a signal
 		do {} while (px4_sem_wait(&_process_lock) != 0);
@@ -180,19 +535,106 @@ void WorkQueue::Run()
 		work_lock();
 
 		// process queued work
-		while (!_q.empty()) {
-			WorkItem *work = _q.pop();
+		WorkItem *work;
+
+		while ((work = Pop()) != nullptr) {
+			if (work->_skip_next) {
+				// the previous run exceeded its budget, leave this one to the other items
+				work->_skip_next = false;
+				work->_budget_skips++;
+				continue;
+			}
+
+			if ((work->_deadline_us > 0) && (hrt_absolute_time() > work->_deadline)) {
+				work->_deadline_misses++;
+			}
+
+			_running[worker] = work;
+
+			if (pool) {
+				// more work left, wake up an idle worker
+				if (!_q.empty()) {
+					SignalWorkerThread();
+				}
+			}
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+			const hrt_abstime run_start = hrt_absolute_time();
+			work->_schedule_latency_histogram.record(run_start - work->_schedule_time);
+#else
+			const hrt_abstime run_start = (work->_budget_us > 0) ? hrt_absolute_time() : 0;
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
+#if defined(CONFIG_SCHED_TRACE)
+			const char *item_name = work->ItemName();
+#endif // CONFIG_SCHED_TRACE
 
 			work_unlock(); // unlock work queue to run (item may requeue itself)
+
+#if defined(CONFIG_HEAP_USAGE)
+			heap_usage::set_tag(heap_usage_slot, work->ItemName());
+#endif // CONFIG_HEAP_USAGE
+
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+			const uintptr_t stack_top = (stack_low != 0) ? stack_paint(stack_low) : 0;
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
+			SCHED_TRACE(SCHED_TRACE_WQ_ITEM_START, item_name);
 			work->RunPreamble();
 			work->Run();
 			// Note: after Run() we cannot access work anymore, as it might have been deleted
+			SCHED_TRACE(SCHED_TRACE_WQ_ITEM_STOP, item_name);
+
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+			// fused stages count towards the run time of the item that triggered them
+			RunInline();
+#endif // CONFIG_WQ_INLINE_CHAIN
+
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+			const uint32_t stack_used = (stack_top != 0) ? (stack_top - stack_lowest_used(stack_low, stack_top)) : 0;
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
+#if defined(CONFIG_HEAP_USAGE)
+			heap_usage::set_tag(heap_usage_slot, nullptr);
+#endif // CONFIG_HEAP_USAGE
+
 			work_lock(); // re-lock
+
+			_running[worker] = nullptr;
+
+#if defined(CONFIG_WQ_ITEM_STACK_USAGE)
+
+			if ((stack_used > 0) && IsAttached(work) && (stack_used > work->_stack_usage)) {
+				work->_stack_usage = stack_used;
+			}
+
+#endif // CONFIG_WQ_ITEM_STACK_USAGE
+
+			// Detach() needs the work lock, an item that is still attached has not been deleted
+			if ((run_start != 0) && IsAttached(work)) {
+				const hrt_abstime now = hrt_absolute_time();
+				const uint32_t run_time = now - run_start;
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+				work->_run_time_histogram.record(run_time);
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
+				if ((work->_budget_us > 0) && (run_time > work->_budget_us)) {
+					BudgetOverrun(work, run_time, now);
+				}
+			}
 		}
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 
-		if (_q.empty()) {
+		bool workers_idle = true;
+
+		for (unsigned i = 0; i < num_threads(); i++) {
+			workers_idle = workers_idle && (_running[i] == nullptr);
+		}
+
+		// in pool mode another worker might still be running an item
+		if (_q.empty() && workers_idle) {
 			px4_lockstep_unregister_component(_lockstep_component);
 			_lockstep_component = -1;
 		}
@@ -202,9 +644,35 @@ void WorkQueue::Run()
 		work_unlock();
 	}
 
+#if defined(CONFIG_HEAP_USAGE)
+	heap_usage::unregister_thread(heap_usage_slot);
+#endif // CONFIG_HEAP_USAGE
+
+	// wake up the remaining workers of the pool so they can exit as well
+	SignalWorkerThread();
+
 	PX4_DEBUG("%s: exiting", _config.name);
 }
 
+bool WorkQueue::visit_item(unsigned &index, void (*visitor)(const WorkQueue &wq, const WorkItem &item, void *arg),
+			   void *arg)
+{
+	work_lock();
+
+	for (WorkItem *item : _work_items) {
+		if (index == 0) {
+			visitor(*this, *item, arg);
+			work_unlock();
+			return true;
+		}
+
+		index--;
+	}
+
+	work_unlock();
+	return false;
+}
+
 void WorkQueue::print_status(bool last)
 {
 	const size_t num_items = _work_items.size();
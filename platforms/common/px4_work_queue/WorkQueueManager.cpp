@@ -86,14 +86,41 @@ FindWorkQueueByName(const char *name)
 	return nullptr;
 }
 
+#if defined(CONFIG_WQ_SHARED_THREADS)
+# if (CONFIG_WQ_HP_DEFAULT_THREADS > 1) || (CONFIG_WQ_LP_DEFAULT_THREADS > 1)
+#  error "CONFIG_WQ_SHARED_THREADS requires a single hp_default and lp_default thread"
+# endif
+
+static const wq_config_t &
+SharedWorkQueueConfig(const wq_config_t &wq)
+{
+	// the test queues are kept separate, the tests rely on distinct threads
+	if (strncmp(wq.name, "wq:test", 7) == 0) {
+		return wq;
+	}
+
+	if (wq.relative_priority >= wq_configurations::hp_default.relative_priority) {
+		return wq_configurations::hp_default;
+	}
+
+	return wq_configurations::lp_default;
+}
+#endif // CONFIG_WQ_SHARED_THREADS
+
 WorkQueue *
-WorkQueueFindOrCreate(const wq_config_t &new_wq)
+WorkQueueFindOrCreate(const wq_config_t &requested_wq)
 {
 	if (!_wq_manager_running.load()) {
 		PX4_ERR("not running");
 		return nullptr;
 	}
 
+#if defined(CONFIG_WQ_SHARED_THREADS)
+	const wq_config_t &new_wq = SharedWorkQueueConfig(requested_wq);
+#else
+	const wq_config_t &new_wq = requested_wq;
+#endif
+
 	// search list for existing work queue
 	WorkQueue *wq = FindWorkQueueByName(new_wq.name);
 
@@ -228,6 +255,39 @@ const wq_config_t &ins_instance_to_wq(uint8_t instance)
 	return wq_configurations::INS0;
 }
 
+static size_t
+WorkQueueStackSize(const wq_config_t &wq)
+{
+#if defined(__PX4_NUTTX) || defined(__PX4_QURT)
+	return math::max(PTHREAD_STACK_MIN, PX4_STACK_ADJUSTED(wq.stacksize));
+#elif defined(__PX4_POSIX)
+	// On posix system , the desired stacksize round to the nearest multiplier of the system pagesize
+	// It is a requirement of the  pthread_attr_setstacksize* function
+	const unsigned int page_size = sysconf(_SC_PAGESIZE);
+	const size_t stacksize_adj = math::max((int)PTHREAD_STACK_MIN, PX4_STACK_ADJUSTED(wq.stacksize));
+	return (stacksize_adj + page_size - (stacksize_adj % page_size));
+#endif
+}
+
+#if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT)
+// additional worker of a work queue in pool mode
+static void *
+WorkQueueWorker(void *context)
+{
+	WorkQueue *wq = static_cast<WorkQueue *>(context);
+
+#ifdef __PX4_DARWIN
+	pthread_setname_np(wq->get_name());
+#else
+	pthread_setname_np(pthread_self(), wq->get_name());
+#endif
+
+	wq->Run();
+
+	return nullptr;
+}
+#endif
+
 static void *
 WorkQueueRunner(void *context)
 {
@@ -237,14 +297,80 @@ WorkQueueRunner(void *context)
 	// add to work queue list
 	_wq_manager_wqs_list->add(&wq);
 
+	unsigned num_workers = 0;
+
+#if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT)
+	// pool mode: the other workers inherit priority, policy and CPU affinity of this thread
+	pthread_t workers[WorkQueue::MAX_THREADS - 1];
+
+	if (wq.num_threads() > 1) {
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setstacksize(&attr, WorkQueueStackSize(*config));
+		pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+
+		for (unsigned i = 1; i < wq.num_threads(); i++) {
+			int ret_create = pthread_create(&workers[num_workers], &attr, WorkQueueWorker, &wq);
+
+			if (ret_create == 0) {
+				num_workers++;
+
+			} else {
+				PX4_ERR("failed to create worker %u for %s (%i)", i, config->name, ret_create);
+			}
+		}
+
+		pthread_attr_destroy(&attr);
+	}
+
+#endif
+
 	wq.Run();
 
+#if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT)
+
+	for (unsigned i = 0; i < num_workers; i++) {
+		pthread_join(workers[i], nullptr);
+	}
+
+#endif
+
 	// remove from work queue list
 	_wq_manager_wqs_list->remove(&wq);
 
 	return nullptr;
 }
 
+#if defined(__PX4_LINUX) || defined(CONFIG_SMP)
+# define WQ_CPU_AFFINITY
+/**
+ * CPU affinity of a work queue: runtime override from the environment (POSIX only,
+ * PX4_WQ_CPU_AFFINITY="wq:rate_ctrl=0x2,wq:SPI1=0x2"), otherwise the Kconfig mask.
+ */
+static uint32_t WorkQueueCpuMask(const wq_config_t &wq)
+{
+#if defined(__PX4_POSIX)
+	const char *affinity = getenv("PX4_WQ_CPU_AFFINITY");
+	const size_t name_len = strlen(wq.name);
+
+	while ((affinity != nullptr) && (*affinity != '\0')) {
+		if ((strncmp(affinity, wq.name, name_len) == 0) && (affinity[name_len] == '=')) {
+			return strtoul(affinity + name_len + 1, nullptr, 0);
+		}
+
+		affinity = strchr(affinity, ',');
+
+		if (affinity != nullptr) {
+			affinity++;
+		}
+	}
+
+#endif // __PX4_POSIX
+
+	return wq.cpu_mask;
+}
+#endif // __PX4_LINUX || CONFIG_SMP
+
 #if defined(__PX4_NUTTX) && !defined(CONFIG_BUILD_FLAT)
 // Wrapper for px4_task_spawn_cmd interface
 inline static int
@@ -274,15 +400,7 @@ WorkQueueManagerRun(int, char **)
 			// create new work queue
 
 			// stack size
-#if defined(__PX4_NUTTX) || defined(__PX4_QURT)
-			const size_t stacksize = math::max(PTHREAD_STACK_MIN, PX4_STACK_ADJUSTED(wq->stacksize));
-#elif defined(__PX4_POSIX)
-			// On posix system , the desired stacksize round to the nearest multiplier of the system pagesize
-			// It is a requirement of the  pthread_attr_setstacksize* function
-			const unsigned int page_size = sysconf(_SC_PAGESIZE);
-			const size_t stacksize_adj = math::max((int)PTHREAD_STACK_MIN, PX4_STACK_ADJUSTED(wq->stacksize));
-			const size_t stacksize = (stacksize_adj + page_size - (stacksize_adj % page_size));
-#endif
+			const size_t stacksize = WorkQueueStackSize(*wq);
 
 			// priority
 			int sched_priority = sched_get_priority_max(SCHED_FIFO) + wq->relative_priority;
@@ -324,6 +442,28 @@ WorkQueueManagerRun(int, char **)
 				PX4_ERR("setting sched params for %s failed (%i)", wq->name, ret_setschedparam);
 			}
 
+#if defined(WQ_CPU_AFFINITY)
+			const uint32_t cpu_mask = WorkQueueCpuMask(*wq);
+
+			if (cpu_mask != 0) {
+				cpu_set_t cpuset;
+				CPU_ZERO(&cpuset);
+
+				for (unsigned cpu = 0; cpu < 32; cpu++) {
+					if (cpu_mask & (1u << cpu)) {
+						CPU_SET(cpu, &cpuset);
+					}
+				}
+
+				int ret_setaffinity = pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+
+				if (ret_setaffinity != 0) {
+					PX4_ERR("setting CPU affinity 0x%" PRIx32 " for %s failed (%i)", cpu_mask, wq->name, ret_setaffinity);
+				}
+			}
+
+#endif // WQ_CPU_AFFINITY
+
 			// create thread
 			pthread_t thread;
 			int ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
@@ -520,4 +660,23 @@ WorkQueueManagerStatus()
 	return PX4_OK;
 }
 
+bool
+WorkQueueManagerVisitItem(unsigned index, void (*visitor)(const WorkQueue &wq, const WorkItem &item, void *arg),
+			  void *arg)
+{
+	if (_wq_manager_should_exit.load() || !_wq_manager_running.load()) {
+		return false;
+	}
+
+	LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		if (wq->visit_item(index, visitor, arg)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 } // namespace px4
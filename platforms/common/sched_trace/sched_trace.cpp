@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file sched_trace.cpp
+ *
+ * Scheduler trace ring buffers, see sched_trace.h.
+ */
+
+#include <px4_platform_common/sched_trace.h>
+
+#if defined(CONFIG_SCHED_TRACE)
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#if defined(__PX4_NUTTX)
+# include <nuttx/arch.h>
+#elif defined(__PX4_LINUX)
+# include <sched.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#else
+# include <pthread.h>
+#endif
+
+#if defined(CONFIG_SMP)
+static constexpr unsigned NUM_BUFFERS = CONFIG_SMP_NCPUS;
+#else
+static constexpr unsigned NUM_BUFFERS = 1;
+#endif
+
+static constexpr uint32_t BUFFER_SIZE = CONFIG_SCHED_TRACE_BUFFER_EVENTS;
+static_assert((BUFFER_SIZE & (BUFFER_SIZE - 1)) == 0, "CONFIG_SCHED_TRACE_BUFFER_EVENTS must be a power of 2");
+
+struct TraceBuffer {
+	px4::atomic<uint32_t>		head{0};	///< number of recorded events, wraps around
+	struct sched_trace_event	events[BUFFER_SIZE];
+};
+
+static TraceBuffer trace_buffers[NUM_BUFFERS];
+static px4::atomic_bool trace_enabled{false};
+
+static inline unsigned current_cpu()
+{
+#if defined(CONFIG_SMP)
+	return up_cpu_index();
+#elif defined(__PX4_LINUX)
+	const int cpu = sched_getcpu();
+	return (cpu > 0) ? cpu : 0;
+#else
+	return 0;
+#endif
+}
+
+static inline uint32_t current_tid()
+{
+#if defined(__PX4_NUTTX)
+
+	if (up_interrupt_context()) {
+		return 0;
+	}
+
+	return getpid();
+#elif defined(__PX4_LINUX)
+	// gettid is a syscall, so look it up once per thread
+	static thread_local const uint32_t tid = syscall(SYS_gettid);
+	return tid;
+#else
+	return (uintptr_t)pthread_self();
+#endif
+}
+
+void sched_trace_record(enum sched_trace_type type, uintptr_t arg)
+{
+	if (!trace_enabled.load()) {
+		return;
+	}
+
+	// on POSIX all threads share the buffer and only the event is tagged with the CPU
+	const unsigned cpu = current_cpu();
+	TraceBuffer &buffer = trace_buffers[cpu % NUM_BUFFERS];
+
+	struct sched_trace_event &event = buffer.events[buffer.head.fetch_add(1) & (BUFFER_SIZE - 1)];
+	event.timestamp = hrt_absolute_time();
+	event.arg = arg;
+	event.tid = current_tid();
+	event.type = type;
+	event.cpu = cpu;
+}
+
+void sched_trace_enable(bool enable)
+{
+	if (enable) {
+		trace_enabled.store(false);
+
+		for (auto &buffer : trace_buffers) {
+			buffer.head.store(0);
+		}
+	}
+
+	trace_enabled.store(enable);
+}
+
+bool sched_trace_enabled()
+{
+	return trace_enabled.load();
+}
+
+uint32_t sched_trace_event_count()
+{
+	uint32_t count = 0;
+
+	for (auto &buffer : trace_buffers) {
+		count += buffer.head.load();
+	}
+
+	return count;
+}
+
+static const char *event_name(const struct sched_trace_event &event)
+{
+	const char *name = (const char *)event.arg;
+	return (name != nullptr) ? name : "unknown";
+}
+
+static int write_event(FILE *file, const struct sched_trace_event &event, bool first)
+{
+	const char *separator = first ? "" : ",\n";
+
+	switch (event.type) {
+	case SCHED_TRACE_WQ_ITEM_START:
+	case SCHED_TRACE_WQ_ITEM_STOP:
+		return fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"wq\",\"ph\":\"%s\",\"ts\":%" PRIu64
+			       ",\"pid\":0,\"tid\":%" PRIu32 ",\"args\":{\"cpu\":%u}}", separator, event_name(event),
+			       (event.type == SCHED_TRACE_WQ_ITEM_START) ? "B" : "E", event.timestamp, event.tid, event.cpu);
+
+	case SCHED_TRACE_ORB_PUBLISH:
+		return fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"uorb\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%" PRIu64
+			       ",\"pid\":0,\"tid\":%" PRIu32 ",\"args\":{\"cpu\":%u}}", separator, event_name(event),
+			       event.timestamp, event.tid, event.cpu);
+
+	case SCHED_TRACE_HRT_CALLOUT:
+		return fprintf(file, "%s{\"name\":\"hrt_callout\",\"cat\":\"hrt\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%" PRIu64
+			       ",\"pid\":0,\"tid\":%" PRIu32 ",\"args\":{\"cpu\":%u,\"callout\":\"0x%" PRIxPTR "\"}}", separator,
+			       event.timestamp, event.tid, event.cpu, event.arg);
+
+	case SCHED_TRACE_WQ_WAKE:
+		return fprintf(file, "%s{\"name\":\"wake %s\",\"cat\":\"wq\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%" PRIu64
+			       ",\"pid\":0,\"tid\":%" PRIu32 ",\"args\":{\"cpu\":%u}}", separator, event_name(event),
+			       event.timestamp, event.tid, event.cpu);
+	}
+
+	return 0;
+}
+
+int sched_trace_dump(const char *path)
+{
+	trace_enabled.store(false);
+
+	// let events that are being recorded complete
+	px4_usleep(1000);
+
+	FILE *file = fopen(path, "w");
+
+	if (file == nullptr) {
+		return -errno;
+	}
+
+	bool ok = fprintf(file, "{\"traceEvents\":[\n") > 0;
+	bool first = true;
+
+	for (auto &buffer : trace_buffers) {
+		const uint32_t head = buffer.head.load();
+		const uint32_t count = (head < BUFFER_SIZE) ? head : BUFFER_SIZE;
+
+		for (uint32_t i = head - count; ok && (i != head); i++) {
+			ok = write_event(file, buffer.events[i & (BUFFER_SIZE - 1)], first) >= 0;
+			first = false;
+		}
+	}
+
+	ok = ok && (fprintf(file, "\n]}\n") > 0);
+
+	if (fclose(file) != 0) {
+		ok = false;
+	}
+
+	return ok ? 0 : -EIO;
+}
+
+#endif // CONFIG_SCHED_TRACE
@@ -0,0 +1,132 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file LatencyHistogram.hpp
+ *
+ * log2 histogram of publish to callback wakeup latencies
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace uORB
+{
+
+class LatencyHistogram
+{
+public:
+	static constexpr int NUM_BINS = 16; ///< bin i counts latencies in [2^i, 2^(i+1)) us, the last bin everything above
+
+	/**
+	 * Add a sample. Not synchronized, concurrent updates might rarely drop a sample.
+	 */
+	void record(uint32_t latency_us)
+	{
+		int bin = (latency_us > 1) ? (31 - __builtin_clz(latency_us)) : 0;
+
+		if (bin > NUM_BINS - 1) {
+			bin = NUM_BINS - 1;
+		}
+
+		_bins[bin]++;
+		_count++;
+
+		if (latency_us > _max_us) {
+			_max_us = latency_us;
+		}
+	}
+
+	/**
+	 * Add all samples of another histogram, e.g. to combine per thread histograms.
+	 */
+	void merge(const LatencyHistogram &other)
+	{
+		for (int i = 0; i < NUM_BINS; i++) {
+			_bins[i] += other._bins[i];
+		}
+
+		_count += other._count;
+
+		if (other._max_us > _max_us) {
+			_max_us = other._max_us;
+		}
+	}
+
+	void reset()
+	{
+		for (auto &bin : _bins) {
+			bin = 0;
+		}
+
+		_count = 0;
+		_max_us = 0;
+	}
+
+	uint32_t count() const { return _count; }
+	uint32_t max_us() const { return _max_us; }
+	uint32_t bin(int index) const { return _bins[index]; }
+
+	/**
+	 * Upper bound of the bin containing the given percentile
+	 * @param percentile requested percentile [0, 100]
+	 * @return latency upper bound in us, or 0 if there are no samples
+	 */
+	uint32_t percentile_us(uint32_t percentile) const
+	{
+		if (_count == 0) {
+			return 0;
+		}
+
+		const uint64_t threshold = ((uint64_t)_count * percentile + 99) / 100;
+		uint64_t cumulative = 0;
+
+		for (int i = 0; i < NUM_BINS - 1; i++) {
+			cumulative += _bins[i];
+
+			if (cumulative >= threshold) {
+				return (2u << i) < _max_us ? (2u << i) : _max_us;
+			}
+		}
+
+		return _max_us;
+	}
+
+private:
+	uint32_t _bins[NUM_BINS] {};
+	uint32_t _count{0};
+	uint32_t _max_us{0};
+};
+
+} // namespace uORB
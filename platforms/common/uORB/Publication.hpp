@@ -54,6 +54,11 @@ public:
 
 	bool advertised() const { return _handle != nullptr; }
 
+	/**
+	 * Check if anyone is subscribed to the advertised topic instance, to skip filling messages nobody reads.
+	 */
+	bool has_subscribers() const { return advertised() && (Manager::orb_get_subscriber_count(_handle) > 0); }
+
 	bool unadvertise() { return (Manager::orb_unadvertise(_handle) == PX4_OK); }
 
 	orb_id_t get_topic() const { return get_orb_meta(_orb_id); }
@@ -65,8 +70,9 @@ protected:
 	~PublicationBase()
 	{
 		if (_handle != nullptr) {
-			// don't automatically unadvertise queued publications (eg vehicle_command)
-			if (Manager::orb_get_queue_size(_handle) == 1) {
+			// don't automatically unadvertise queued publications (eg vehicle_command),
+			// whatever their runtime queue size is
+			if (get_topic()->o_queue == 1) {
 				unadvertise();
 			}
 		}
@@ -113,6 +119,29 @@ public:
 
 		return (Manager::orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
+
+	/**
+	 * Loan the next queue slot of the topic to fill the message in place, avoiding
+	 * the copy (and the stack frame) of publish() for large queued messages.
+	 * Every successful loan() must be followed by commit().
+	 * @return The message to fill, or nullptr if loans are not supported (use publish() instead).
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(Manager::orb_loan(get_topic(), _handle));
+	}
+
+	/**
+	 * Publish the message previously returned by loan().
+	 */
+	bool commit()
+	{
+		return (Manager::orb_commit(get_topic(), _handle) == PX4_OK);
+	}
 };
 
 /**
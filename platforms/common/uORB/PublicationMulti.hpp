@@ -92,6 +92,28 @@ public:
 		return (orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
 
+	/**
+	 * Loan the next queue slot of the topic to fill the message in place, see Publication::loan().
+	 * Every successful loan() must be followed by commit().
+	 * @return The message to fill, or nullptr if loans are not supported (use publish() instead).
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(Manager::orb_loan(get_topic(), _handle));
+	}
+
+	/**
+	 * Publish the message previously returned by loan().
+	 */
+	bool commit()
+	{
+		return (Manager::orb_commit(get_topic(), _handle) == PX4_OK);
+	}
+
 	int get_instance()
 	{
 		// advertise if not already advertised
@@ -137,6 +137,18 @@ public:
 		return false;
 	}
 
+	/**
+	 * Number of updates published since the last copy (larger than the queue length if some were lost).
+	 */
+	unsigned updates_available()
+	{
+		if (subscribe()) {
+			return Manager::updates_available(_node, _last_generation);
+		}
+
+		return 0;
+	}
+
 	/**
 	 * Update the struct
 	 * @param dst The uORB message struct we are updating.
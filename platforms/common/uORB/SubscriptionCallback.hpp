@@ -39,14 +39,15 @@
 #pragma once
 
 #include <uORB/SubscriptionInterval.hpp>
-#include <containers/List.hpp>
+#include <uORB/LatencyHistogram.hpp>
+#include <containers/IntrusiveSortedList.hpp>
 #include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 
 namespace uORB
 {
 
 // Subscription wrapper class with callbacks on new publications
-class SubscriptionCallback : public SubscriptionInterval, public ListNode<SubscriptionCallback *>
+class SubscriptionCallback : public SubscriptionInterval, public IntrusiveSortedListNode<SubscriptionCallback *>
 {
 public:
 	/**
@@ -135,10 +136,31 @@ public:
 
 	bool registered() const { return _registered; }
 
+	/**
+	 * Relative priority of the callback target, callbacks of a topic are notified in order of decreasing priority
+	 */
+	virtual int8_t callback_priority() const { return INT8_MIN; }
+
+	// callbacks sorted by priority (highest first)
+	bool operator<=(const SubscriptionCallback &rhs) const { return callback_priority() >= rhs.callback_priority(); }
+
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	/**
+	 * Name of the callback target, used for printing the latency statistics
+	 */
+	virtual const char *callback_name() const { return "callback"; }
+
+	const LatencyHistogram &latency_histogram() const { return _latency_histogram; }
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 protected:
 
 	bool _registered{false};
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	LatencyHistogram _latency_histogram {};
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 };
 
 // Subscription with callback that schedules a WorkItem
@@ -160,17 +182,33 @@ public:
 
 	virtual ~SubscriptionCallbackWorkItem() = default;
 
+	int8_t callback_priority() const override { return _work_item->WorkQueuePriority(); }
+
 	void call() override
 	{
 		// schedule immediately if updated (queue depth or subscription interval)
 		if ((_required_updates == 0)
 		    || (Manager::updates_available(_subscription.get_node(), _subscription.get_last_generation()) >= _required_updates)) {
 			if (updated()) {
-				_work_item->ScheduleNow();
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+				// only the first publication since the work item last read the topic is measured
+				const uint32_t now = (uint32_t)hrt_absolute_time();
+				uint32_t expected = 0;
+				_wakeup_time.compare_exchange(&expected, (now != 0) ? now : 1);
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+				_work_item->ScheduleChained();
 			}
 		}
 	}
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	const char *callback_name() const override { return _work_item->ItemName(); }
+
+	// record the latency from the publication to the work item reading the topic
+	bool update(void *dst) { record_wakeup_latency(); return SubscriptionCallback::update(dst); }
+	bool copy(void *dst) { record_wakeup_latency(); return SubscriptionCallback::copy(dst); }
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 	/**
 	 * Optionally limit callback until more samples are available.
 	 *
@@ -183,6 +221,21 @@ public:
 	}
 
 private:
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	void record_wakeup_latency()
+	{
+		const uint32_t wakeup_time = _wakeup_time.fetch_and(0);
+
+		if (wakeup_time != 0) {
+			const uint32_t latency_us = (uint32_t)hrt_absolute_time() - wakeup_time;
+			_latency_histogram.record(latency_us);
+			Manager::record_wakeup_latency(_subscription.get_node(), latency_us);
+		}
+	}
+
+	px4::atomic<uint32_t> _wakeup_time{0}; ///< time of the first unread publication, 0 if none
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 	px4::WorkItem *_work_item;
 
 	uint8_t _required_updates{0};
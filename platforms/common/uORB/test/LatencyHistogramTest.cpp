@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <uORB/LatencyHistogram.hpp>
+
+#include <gtest/gtest.h>
+
+// To run: make tests TESTFILTER=LatencyHistogram
+
+TEST(LatencyHistogramTest, empty)
+{
+	uORB::LatencyHistogram hist;
+	EXPECT_EQ(hist.count(), 0u);
+	EXPECT_EQ(hist.max_us(), 0u);
+	EXPECT_EQ(hist.percentile_us(50), 0u);
+}
+
+TEST(LatencyHistogramTest, bins)
+{
+	uORB::LatencyHistogram hist;
+	hist.record(0);
+	hist.record(1);
+	hist.record(2);
+	hist.record(3);
+	hist.record(1000);
+	hist.record(UINT32_MAX);
+
+	EXPECT_EQ(hist.count(), 6u);
+	EXPECT_EQ(hist.max_us(), UINT32_MAX);
+	EXPECT_EQ(hist.bin(0), 2u);
+	EXPECT_EQ(hist.bin(1), 2u);
+	EXPECT_EQ(hist.bin(9), 1u); // [512, 1024)
+	EXPECT_EQ(hist.bin(uORB::LatencyHistogram::NUM_BINS - 1), 1u);
+}
+
+TEST(LatencyHistogramTest, percentiles)
+{
+	uORB::LatencyHistogram hist;
+
+	for (int i = 0; i < 99; i++) {
+		hist.record(10); // bin [8, 16)
+	}
+
+	hist.record(300);
+
+	EXPECT_EQ(hist.percentile_us(50), 16u);
+	EXPECT_EQ(hist.percentile_us(99), 16u);
+	EXPECT_EQ(hist.percentile_us(100), 300u);
+
+	hist.reset();
+	EXPECT_EQ(hist.count(), 0u);
+	EXPECT_EQ(hist.max_us(), 0u);
+}
+
+TEST(LatencyHistogramTest, merge)
+{
+	uORB::LatencyHistogram a;
+	uORB::LatencyHistogram b;
+	a.record(10);
+	a.record(20);
+	b.record(1000);
+
+	a.merge(b);
+
+	EXPECT_EQ(a.count(), 3u);
+	EXPECT_EQ(a.max_us(), 1000u);
+	EXPECT_EQ(a.bin(3), 1u); // [8, 16)
+	EXPECT_EQ(a.bin(4), 1u); // [16, 32)
+	EXPECT_EQ(a.bin(9), 1u); // [512, 1024)
+	EXPECT_EQ(b.count(), 1u);
+}
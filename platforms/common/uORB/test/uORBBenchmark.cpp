@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Benchmarks of the uORB publication and subscription hot paths
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <uORB/Publication.hpp>
+#include <uORB/PublicationMulti.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/sensor_accel.h>
+#include <uORB/topics/vehicle_local_position.h>
+
+static void BM_Publish(benchmark::State &state)
+{
+	uORB::Publication<sensor_accel_s> pub{ORB_ID(sensor_accel)};
+	sensor_accel_s accel{};
+
+	for (auto _ : state) {
+		accel.timestamp++;
+		pub.publish(accel);
+	}
+
+	state.SetBytesProcessed(state.iterations() * sizeof(accel));
+}
+BENCHMARK(BM_Publish);
+
+static void BM_PublishMulti(benchmark::State &state)
+{
+	uORB::PublicationMulti<sensor_accel_s> pub{ORB_ID(sensor_accel)};
+	sensor_accel_s accel{};
+
+	for (auto _ : state) {
+		accel.timestamp++;
+		pub.publish(accel);
+	}
+
+	state.SetBytesProcessed(state.iterations() * sizeof(accel));
+}
+BENCHMARK(BM_PublishMulti);
+
+// a small (sensor_accel) and a large (vehicle_local_position) topic
+template<typename T, ORB_ID ID>
+static void BM_PublishUpdate(benchmark::State &state)
+{
+	uORB::Publication<T> pub{ID};
+	uORB::Subscription sub{ID};
+	T data{};
+	pub.publish(data);
+
+	for (auto _ : state) {
+		data.timestamp++;
+		pub.publish(data);
+		benchmark::DoNotOptimize(sub.update(&data));
+	}
+
+	state.SetBytesProcessed(state.iterations() * sizeof(T));
+}
+BENCHMARK_TEMPLATE2(BM_PublishUpdate, sensor_accel_s, ORB_ID::sensor_accel);
+BENCHMARK_TEMPLATE2(BM_PublishUpdate, vehicle_local_position_s, ORB_ID::vehicle_local_position);
+
+static void BM_Copy(benchmark::State &state)
+{
+	uORB::Publication<vehicle_local_position_s> pub{ORB_ID(vehicle_local_position)};
+	uORB::Subscription sub{ORB_ID(vehicle_local_position)};
+	vehicle_local_position_s data{};
+	pub.publish(data);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sub.copy(&data));
+	}
+
+	state.SetBytesProcessed(state.iterations() * sizeof(data));
+}
+BENCHMARK(BM_Copy);
+
+static void BM_UpdatedNoData(benchmark::State &state)
+{
+	// the common case of polling a topic without a new publication
+	uORB::Publication<sensor_accel_s> pub{ORB_ID(sensor_accel)};
+	uORB::Subscription sub{ORB_ID(sensor_accel)};
+	sensor_accel_s accel{};
+	pub.publish(accel);
+	sub.update(&accel);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sub.updated());
+	}
+}
+BENCHMARK(BM_UpdatedNoData);
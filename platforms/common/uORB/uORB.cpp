@@ -40,12 +40,14 @@
 
 #include "uORBManager.hpp"
 #include "uORBCommon.hpp"
-#include "uORBMessageFields.hpp"
+#include "uORBDeviceNode.hpp"
+#include "uORBFieldTable.hpp"
 
 
 #include <lib/drivers/device/Device.hpp>
 #include <matrix/Quaternion.hpp>
 #include <mathlib/mathlib.h>
+#include <uORB/topics/uORBTopics.hpp>
 
 #ifdef __PX4_NUTTX
 #include <sys/boardctl.h>
@@ -113,6 +115,76 @@ int uorb_top(char **topic_filter, int num_filters)
 	return OK;
 }
 
+int uorb_memory(void)
+{
+#if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+	if (g_dev != nullptr) {
+		g_dev->printMemory();
+
+	} else {
+		PX4_INFO("uorb is not running");
+	}
+
+#else
+	boardctl(ORBIOCDEVMASTERCMD, ORB_DEVMASTER_MEMORY);
+#endif
+	return OK;
+}
+
+int uorb_latency(orb_latency_cb_t cb, void *user)
+{
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM) && (!defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+
+	if (g_dev == nullptr) {
+		return -ENODEV;
+	}
+
+	g_dev->latencyStatistics(cb, user);
+	return 0;
+#else
+	return -ENOSYS;
+#endif
+}
+
+int uorb_queue(const char *topic_name, uint8_t instance, unsigned queue_size)
+{
+#if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+	if (g_dev == nullptr) {
+		PX4_INFO("uorb is not running");
+		return -ENODEV;
+	}
+
+	const orb_metadata *const *topics = orb_get_topics();
+
+	for (size_t i = 0; i < orb_topics_count(); i++) {
+		if (strcmp(topics[i]->o_name, topic_name) == 0) {
+			uORB::DeviceNode *node = g_dev->getDeviceNode(topics[i], instance);
+
+			if (node == nullptr) {
+				PX4_ERR("%s instance %i does not exist", topic_name, instance);
+				return -ENOENT;
+			}
+
+			const int ret = node->set_queue_size(queue_size);
+
+			if (ret != PX4_OK) {
+				PX4_ERR("setting queue size of %s failed (%i)", topic_name, ret);
+			}
+
+			return ret;
+		}
+	}
+
+	PX4_ERR("topic %s not found", topic_name);
+	return -ENOENT;
+#else
+	PX4_ERR("not supported in protected builds");
+	return -ENOTSUP;
+#endif
+}
+
 orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *data)
 {
 	return uORB::Manager::get_instance()->orb_advertise(meta, data);
@@ -219,271 +291,200 @@ const char *orb_get_c_type(unsigned char short_type)
 uint8_t orb_get_queue_size(const struct orb_metadata *meta)
 {
 	if (meta) {
-		return meta->o_queue;
-	}
-
-	return 0;
-}
-
-void orb_print_message_internal(const orb_metadata *meta, const void *data, bool print_topic_name)
-{
-	if (print_topic_name) {
-		PX4_INFO_RAW(" %s\n", meta->o_name);
-	}
-
-	const hrt_abstime now = hrt_absolute_time();
-	hrt_abstime topic_timestamp = 0;
-
-	const uint8_t *data_ptr = (const uint8_t *)data;
-	int data_offset = 0;
-
-	// Find message format
-	char format_buffer[128];
-	uORB::MessageFormatReader format_reader(format_buffer, sizeof(format_buffer));
-
-	if (!format_reader.readUntilFormat(meta->o_id)) {
-		PX4_ERR("Failed to get uorb format");
-		return;
-	}
-
-	int field_length = 0;
-
-	while (format_reader.readNextField(field_length)) {
-
-		const char *c_type = orb_get_c_type(format_buffer[0]);
-
-		int array_idx = -1;
-		int field_name_idx = -1;
+#if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
 
-		for (int field_idx = 0; field_idx < field_length; ++field_idx) {
-			if (format_buffer[field_idx] == '[') {
-				array_idx = field_idx + 1;
+		// the queue can be resized at runtime (uorb queue)
+		if (g_dev != nullptr) {
+			uORB::DeviceNode *node = g_dev->getDeviceNode(meta, 0);
 
-			} else if (format_buffer[field_idx] == ' ') {
-				field_name_idx = field_idx + 1;
-				break;
+			if (node != nullptr) {
+				return node->get_queue_size();
 			}
 		}
 
-		int array_size = 1;
-
-		if (array_idx >= 0) {
-			array_size = strtol(format_buffer + array_idx, nullptr, 10);
-		}
-
-		const char *field_name = format_buffer + field_name_idx;
-
-		if (c_type) { // built-in type
-			bool dont_print = false;
-
-			// handle special cases
-			if (strncmp(field_name, "_padding", 8) == 0) {
-				dont_print = true;
-
-			} else if (strcmp(c_type, "char") == 0 && array_size > 1) { // string
-				PX4_INFO_RAW("    %s: \"%.*s\"\n", field_name, array_size, (char *)(data_ptr + data_offset));
-				dont_print = true;
-			}
-
-			if (!dont_print) {
-				PX4_INFO_RAW("    %s: ", field_name);
-			}
-
-			if (!dont_print && array_size > 1) {
-				PX4_INFO_RAW("[");
-			}
+#endif
+		return meta->o_queue;
+	}
 
-			const int previous_data_offset = data_offset;
+	return 0;
+}
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wcast-align" // the caller ensures data is aligned
 
-			for (int i = 0; i < array_size; ++i) {
-				if (strcmp(c_type, "int8_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIi8, *(int8_t *)(data_ptr + data_offset)); }
+static void orb_print_field_value(uORB::FieldType type, const uint8_t *data)
+{
+	switch (type) {
+	case uORB::FieldType::INT8: PX4_INFO_RAW("%" PRIi8, *(const int8_t *)data); break;
 
-					data_offset += sizeof(int8_t);
+	case uORB::FieldType::INT16: PX4_INFO_RAW("%" PRIi16, *(const int16_t *)data); break;
 
-				} else if (strcmp(c_type, "int16_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIi16, *(int16_t *)(data_ptr + data_offset)); }
+	case uORB::FieldType::INT32: PX4_INFO_RAW("%" PRIi32, *(const int32_t *)data); break;
 
-					data_offset += sizeof(int16_t);
+	case uORB::FieldType::INT64: PX4_INFO_RAW("%" PRIi64, *(const int64_t *)data); break;
 
-				} else if (strcmp(c_type, "int32_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIi32, *(int32_t *)(data_ptr + data_offset)); }
+	case uORB::FieldType::UINT8: PX4_INFO_RAW("%" PRIu8, *(const uint8_t *)data); break;
 
-					data_offset += sizeof(int32_t);
+	case uORB::FieldType::UINT16: PX4_INFO_RAW("%" PRIu16, *(const uint16_t *)data); break;
 
-				} else if (strcmp(c_type, "int64_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIi64, *(int64_t *)(data_ptr + data_offset)); }
+	case uORB::FieldType::UINT32: PX4_INFO_RAW("%" PRIu32, *(const uint32_t *)data); break;
 
-					data_offset += sizeof(int64_t);
+	case uORB::FieldType::UINT64: PX4_INFO_RAW("%" PRIu64, *(const uint64_t *)data); break;
 
-				} else if (strcmp(c_type, "uint8_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIu8, *(uint8_t *)(data_ptr + data_offset)); }
+	case uORB::FieldType::FLOAT32: PX4_INFO_RAW("%.5f", (double) * (const float *)data); break;
 
-					data_offset += sizeof(uint8_t);
+	case uORB::FieldType::FLOAT64: PX4_INFO_RAW("%.6f", *(const double *)data); break;
 
-				} else if (strcmp(c_type, "uint16_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIu16, *(uint16_t *)(data_ptr + data_offset)); }
+	case uORB::FieldType::BOOL: PX4_INFO_RAW("%s", *(const bool *)data ? "True" : "False"); break;
 
-					data_offset += sizeof(uint16_t);
+	case uORB::FieldType::CHAR: PX4_INFO_RAW("%i", (int) * (const char *)data); break;
 
-				} else if (strcmp(c_type, "uint32_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIu32, *(uint32_t *)(data_ptr + data_offset)); }
+	case uORB::FieldType::NESTED: break;
+	}
+}
 
-					data_offset += sizeof(uint32_t);
+static void orb_print_fields(const uORB::FieldTable &table, const uint8_t *data_ptr, hrt_abstime now)
+{
+	hrt_abstime topic_timestamp = 0;
 
-				} else if (strcmp(c_type, "uint64_t") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%" PRIu64, *(uint64_t *)(data_ptr + data_offset)); }
+	for (unsigned field_idx = 0; field_idx < table.num_fields; ++field_idx) {
+		const uORB::FieldDescriptor &field = table.fields[field_idx];
+		const char *field_name = field.name;
+		const uint8_t *field_data = data_ptr + field.offset;
+		const int array_size = field.array_length;
 
-					data_offset += sizeof(uint64_t);
+		if (field.type == uORB::FieldType::NESTED) {
+			// print recursively
+			for (int i = 0; i < array_size; ++i) {
+				PX4_INFO_RAW("  %s", field_name);
 
-				} else if (strcmp(c_type, "float") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%.5f", (double) * (float *)(data_ptr + data_offset)); }
+				if (array_size > 1) {
+					PX4_INFO_RAW("[%i]", i);
+				}
 
-					data_offset += sizeof(float);
+				PX4_INFO_RAW(" (%s):\n", field.nested->name);
+				orb_print_fields(*field.nested, field_data + i * field.element_size, now);
+			}
 
-				} else if (strcmp(c_type, "double") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%.6f", *(double *)(data_ptr + data_offset)); }
+			continue;
+		}
 
-					data_offset += sizeof(double);
+		bool dont_print = false;
 
-				} else if (strcmp(c_type, "bool") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%s", *(bool *)(data_ptr + data_offset) ? "True" : "False"); }
+		// handle special cases
+		if (strncmp(field_name, "_padding", 8) == 0) {
+			dont_print = true;
 
-					data_offset += sizeof(bool);
+		} else if (field.type == uORB::FieldType::CHAR && array_size > 1) { // string
+			PX4_INFO_RAW("    %s: \"%.*s\"\n", field_name, array_size, (const char *)field_data);
+			dont_print = true;
+		}
 
-				} else if (strcmp(c_type, "char") == 0) {
-					if (!dont_print) { PX4_INFO_RAW("%i", (int) * (char *)(data_ptr + data_offset)); }
+		if (!dont_print) {
+			PX4_INFO_RAW("    %s: ", field_name);
 
-					data_offset += sizeof(char);
+			if (array_size > 1) {
+				PX4_INFO_RAW("[");
+			}
 
-				} else {
-					PX4_ERR("unknown type: %s", c_type);
-					return;
-				}
+			for (int i = 0; i < array_size; ++i) {
+				orb_print_field_value(field.type, field_data + i * field.element_size);
 
-				if (!dont_print && i < array_size - 1) {
+				if (i < array_size - 1) {
 					PX4_INFO_RAW(", ");
 				}
 			}
 
-			if (!dont_print && array_size > 1) {
+			if (array_size > 1) {
 				PX4_INFO_RAW("]");
 			}
+		}
 
-			// handle special cases
-			if (array_size == 1) {
-				if (strcmp(c_type, "uint64_t") == 0 && strcmp(field_name, "timestamp") == 0) {
-					topic_timestamp = *(uint64_t *)(data_ptr + previous_data_offset);
+		// handle special cases
+		if (array_size == 1) {
+			if (field.type == uORB::FieldType::UINT64 && strcmp(field_name, "timestamp") == 0) {
+				topic_timestamp = *(const uint64_t *)field_data;
 
-					if (topic_timestamp != 0) {
-						PX4_INFO_RAW(" (%.6f seconds ago)", (double)((now - topic_timestamp) / 1e6f));
-					}
+				if (topic_timestamp != 0) {
+					PX4_INFO_RAW(" (%.6f seconds ago)", (double)((now - topic_timestamp) / 1e6f));
+				}
 
-				} else if (strcmp(c_type, "uint64_t") == 0 && strcmp(field_name, "timestamp_sample") == 0) {
-					hrt_abstime timestamp = *(uint64_t *)(data_ptr + previous_data_offset);
+			} else if (field.type == uORB::FieldType::UINT64 && strcmp(field_name, "timestamp_sample") == 0) {
+				hrt_abstime timestamp = *(const uint64_t *)field_data;
 
-					if (topic_timestamp != 0 && timestamp != 0) {
-						PX4_INFO_RAW(" (%i us before timestamp)", (int)(topic_timestamp - timestamp));
-					}
+				if (topic_timestamp != 0 && timestamp != 0) {
+					PX4_INFO_RAW(" (%i us before timestamp)", (int)(topic_timestamp - timestamp));
+				}
 
-				} else if (strstr(field_name, "flags") != nullptr) {
-					// bitfield
-					unsigned field_size = 0;
-					uint64_t value = 0;
+			} else if (strstr(field_name, "flags") != nullptr) {
+				// bitfield
+				unsigned field_size = 0;
+				uint64_t value = 0;
 
-					if (strcmp(c_type, "uint8_t") == 0) {
-						field_size = sizeof(uint8_t);
-						value = *(uint8_t *)(data_ptr + previous_data_offset);
+				switch (field.type) {
+				case uORB::FieldType::UINT8: value = *(const uint8_t *)field_data; field_size = sizeof(uint8_t); break;
 
-					} else if (strcmp(c_type, "uint16_t") == 0) {
-						field_size = sizeof(uint16_t);
-						value = *(uint16_t *)(data_ptr + previous_data_offset);
+				case uORB::FieldType::UINT16: value = *(const uint16_t *)field_data; field_size = sizeof(uint16_t); break;
 
-					} else if (strcmp(c_type, "uint32_t") == 0) {
-						field_size = sizeof(uint32_t);
-						value = *(uint32_t *)(data_ptr + previous_data_offset);
+				case uORB::FieldType::UINT32: value = *(const uint32_t *)field_data; field_size = sizeof(uint32_t); break;
 
-					} else if (strcmp(c_type, "uint64_t") == 0) {
-						field_size = sizeof(uint64_t);
-						value = *(uint64_t *)(data_ptr + previous_data_offset);
-					}
+				case uORB::FieldType::UINT64: value = *(const uint64_t *)field_data; field_size = sizeof(uint64_t); break;
 
-					if (field_size > 0 && value != 0) {
-						PX4_INFO_RAW(" (0b");
+				default: break;
+				}
 
-						bool got_set_bit = false;
+				if (field_size > 0 && value != 0) {
+					PX4_INFO_RAW(" (0b");
 
-						for (int i = (field_size * 8) - 1; i >= 0; i--) {
-							unsigned current_bit = (value >> i) & 1;
-							got_set_bit |= current_bit;
+					bool got_set_bit = false;
 
-							if (got_set_bit) {
-								PX4_INFO_RAW("%u%s", current_bit, ((unsigned)i < (field_size * 8) - 1 && i % 4 == 0 && i > 0) ? "'" : "");
-							}
-						}
+					for (int i = (field_size * 8) - 1; i >= 0; i--) {
+						unsigned current_bit = (value >> i) & 1;
+						got_set_bit |= current_bit;
 
-						PX4_INFO_RAW(")");
+						if (got_set_bit) {
+							PX4_INFO_RAW("%u%s", current_bit, ((unsigned)i < (field_size * 8) - 1 && i % 4 == 0 && i > 0) ? "'" : "");
+						}
 					}
 
-				} else if (strcmp(c_type, "uint32_t") == 0 && strstr(field_name, "device_id") != nullptr) {
-					// Device ID
-					uint32_t device_id = *(uint32_t *)(data_ptr + previous_data_offset);
-					char device_id_buffer[80];
-					device::Device::device_id_print_buffer(device_id_buffer, sizeof(device_id_buffer), device_id);
-					PX4_INFO_RAW(" (%s)", device_id_buffer);
+					PX4_INFO_RAW(")");
 				}
 
-			} else if (array_size == 4 && strcmp(c_type, "float") == 0 && (strcmp(field_name, "q") == 0
-					|| strncmp(field_name, "q_", 2) == 0)) {
-				// attitude
-				float *attitude = (float *)(data_ptr + previous_data_offset);
-				matrix::Eulerf euler{matrix::Quatf{attitude}};
-				PX4_INFO_RAW(" (Roll: %.1f deg, Pitch: %.1f deg, Yaw: %.1f deg)",
-					     (double)math::degrees(euler(0)), (double)math::degrees(euler(1)), (double)math::degrees(euler(2)));
+			} else if (field.type == uORB::FieldType::UINT32 && strstr(field_name, "device_id") != nullptr) {
+				// Device ID
+				uint32_t device_id = *(const uint32_t *)field_data;
+				char device_id_buffer[80];
+				device::Device::device_id_print_buffer(device_id_buffer, sizeof(device_id_buffer), device_id);
+				PX4_INFO_RAW(" (%s)", device_id_buffer);
 			}
 
-#pragma GCC diagnostic pop
-
-			PX4_INFO_RAW("\n");
-
-		} else {
-
-			// Get the topic name
-			const size_t topic_name_len = array_size > 1 ? array_idx - 1 : field_name_idx - 1;
-			format_buffer[topic_name_len] = '\0';
-			const char *topic_name = format_buffer;
-
-			// find the metadata
-			const orb_metadata *const *topics = orb_get_topics();
-			const orb_metadata *found_topic = nullptr;
+		} else if (array_size == 4 && field.type == uORB::FieldType::FLOAT32 && (strcmp(field_name, "q") == 0
+				|| strncmp(field_name, "q_", 2) == 0)) {
+			// attitude
+			const float *attitude = (const float *)field_data;
+			matrix::Eulerf euler{matrix::Quatf{attitude}};
+			PX4_INFO_RAW(" (Roll: %.1f deg, Pitch: %.1f deg, Yaw: %.1f deg)",
+				     (double)math::degrees(euler(0)), (double)math::degrees(euler(1)), (double)math::degrees(euler(2)));
+		}
 
-			for (size_t i = 0; i < orb_topics_count(); i++) {
-				if (strcmp(topics[i]->o_name, topic_name) == 0) {
-					found_topic = topics[i];
-					break;
-				}
-			}
+		PX4_INFO_RAW("\n");
+	}
+}
 
-			if (!found_topic) {
-				PX4_ERR("Topic %s did not match any known topics", topic_name);
-				return;
-			}
+#pragma GCC diagnostic pop
 
-			// print recursively
-			for (int i = 0; i < array_size; ++i) {
-				PX4_INFO_RAW("  %s", field_name);
+void orb_print_message_internal(const orb_metadata *meta, const void *data, bool print_topic_name)
+{
+	if (print_topic_name) {
+		PX4_INFO_RAW(" %s\n", meta->o_name);
+	}
 
-				if (array_size > 1) {
-					PX4_INFO_RAW("[%i]", i);
-				}
+	const uORB::FieldTable *table = orb_get_field_table(static_cast<ORB_ID>(meta->o_id));
 
-				PX4_INFO_RAW(" (%s):\n", topic_name);
-				orb_print_message_internal(found_topic, data_ptr + data_offset, false);
-				data_offset += found_topic->o_size;
-			}
-		}
+	if (!table) {
+		PX4_ERR("Failed to get uorb fields");
+		return;
 	}
+
+	orb_print_fields(*table, (const uint8_t *)data, hrt_absolute_time());
 }
@@ -121,6 +121,17 @@ __BEGIN_DECLS
 int uorb_start(void);
 int uorb_status(void);
 int uorb_top(char **topic_filter, int num_filters);
+int uorb_memory(void);
+int uorb_queue(const char *topic_name, uint8_t instance, unsigned queue_size);
+
+typedef void (*orb_latency_cb_t)(const char *line, void *user);
+
+/**
+ * Pass the publish to callback wakeup latencies (CONFIG_ORB_LATENCY_HISTOGRAM) to cb, one line of text
+ * for each topic instance with samples and for each of its callbacks. cb must not advertise topics.
+ * @return 0 on success, -ENOSYS if not supported
+ */
+int uorb_latency(orb_latency_cb_t cb, void *user);
 
 /**
  * ORB topic advertiser handle.
@@ -234,7 +245,8 @@ extern int	orb_get_interval(int handle, unsigned *interval) __EXPORT;
 const char *orb_get_c_type(unsigned char short_type);
 
 /**
- * Returns the queue size of a topic
+ * Returns the queue size of a topic: the runtime size of instance 0 if it exists, otherwise the
+ * ORB_QUEUE_LENGTH of the msg
  * @param meta orb topic metadata
  */
 extern uint8_t orb_get_queue_size(const struct orb_metadata *meta);
@@ -48,6 +48,10 @@
 uORB::DeviceMaster::DeviceMaster()
 {
 	px4_sem_init(&_lock, 0, 1);
+
+#if defined(CONFIG_ORB_ARENA)
+	arenaInit();
+#endif // CONFIG_ORB_ARENA
 }
 
 uORB::DeviceMaster::~DeviceMaster()
@@ -150,7 +154,11 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 
 			// add to the node map.
 			_node_list.add(node);
+#if defined(CONSTRAINED_MEMORY)
 			_node_exists[node->get_instance()].set((orb_id_size_t)node->id(), true);
+#else
+			_node_table[node->get_instance()][(orb_id_size_t)node->id()].store(node);
+#endif // CONSTRAINED_MEMORY
 		}
 
 		group_tries++;
@@ -164,6 +172,87 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 	return ret;
 }
 
+#if defined(CONFIG_ORB_ARENA)
+void uORB::DeviceMaster::arenaInit()
+{
+	const char *topic_names = CONFIG_ORB_ARENA_TOPICS;
+	const orb_metadata *const *topics = orb_get_topics();
+	uint32_t size = 0;
+
+	// space separated list of topic names
+	while (*topic_names != '\0') {
+		while (*topic_names == ' ') {
+			topic_names++;
+		}
+
+		size_t name_length = 0;
+
+		while ((topic_names[name_length] != ' ') && (topic_names[name_length] != '\0')) {
+			name_length++;
+		}
+
+		if (name_length > 0) {
+			bool found = false;
+
+			for (size_t i = 0; i < orb_topics_count(); i++) {
+				if ((strlen(topics[i]->o_name) == name_length) && (strncmp(topics[i]->o_name, topic_names, name_length) == 0)) {
+					if (!_arena_topics[i]) {
+						const uint32_t buffer_size = topics[i]->o_size * topics[i]->o_queue;
+						size += ((buffer_size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT) * ARENA_ALIGNMENT * CONFIG_ORB_ARENA_INSTANCES;
+						_arena_topics.set(i);
+					}
+
+					found = true;
+					break;
+				}
+			}
+
+			if (!found) {
+				PX4_WARN("arena: unknown topic %.*s", (int)name_length, topic_names);
+			}
+		}
+
+		topic_names += name_length;
+	}
+
+	if (size > 0) {
+		// single allocation before anything else fragments the heap
+		_arena = (uint8_t *)px4_cache_aligned_alloc(size + ARENA_ALIGNMENT);
+
+		if (_arena) {
+			_arena_size = size + ARENA_ALIGNMENT;
+
+			// align the first buffer to a cache line
+			const uint32_t misalignment = (uintptr_t)_arena % ARENA_ALIGNMENT;
+			_arena_used.store(misalignment ? (ARENA_ALIGNMENT - misalignment) : 0);
+
+		} else {
+			PX4_ERR("arena: allocating %" PRIu32 " bytes failed", size);
+		}
+	}
+}
+
+void *uORB::DeviceMaster::arenaAlloc(const struct orb_metadata *meta, size_t size)
+{
+	if ((_arena == nullptr) || !_arena_topics[meta->o_id]) {
+		return nullptr;
+	}
+
+	const uint32_t aligned_size = ((size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT) * ARENA_ALIGNMENT;
+	uint32_t used = _arena_used.load();
+
+	do {
+		if (used + aligned_size > _arena_size) {
+			// more instances than reserved, fall back to the heap
+			return nullptr;
+		}
+
+	} while (!_arena_used.compare_exchange(&used, used + aligned_size));
+
+	return _arena + used;
+}
+#endif // CONFIG_ORB_ARENA
+
 void uORB::DeviceMaster::printStatistics()
 {
 	/* Add all nodes to a list while locked, and then print them in unlocked state, to avoid potential
@@ -181,7 +270,11 @@ void uORB::DeviceMaster::printStatistics()
 		return;
 	}
 
-	PX4_INFO_RAW("%-*s INST #SUB #Q SIZE PATH\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+#if defined(CONFIG_ORB_ARENA)
+	PX4_INFO_RAW("arena: %" PRIu32 " / %" PRIu32 " bytes used\n", _arena_used.load(), _arena_size);
+#endif // CONFIG_ORB_ARENA
+
+	PX4_INFO_RAW("%-*s INST #SUB  #Q SIZE SKIP PATH\n", (int)max_topic_name_length - 2, "TOPIC NAME");
 
 	cur_node = first_node;
 
@@ -194,6 +287,91 @@ void uORB::DeviceMaster::printStatistics()
 	}
 }
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+void uORB::DeviceMaster::latencyStatistics(orb_latency_cb_t cb, void *user)
+{
+	lock();
+
+	for (const auto &node : _node_list) {
+		node->latency_statistics(cb, user);
+	}
+
+	unlock();
+}
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
+void uORB::DeviceMaster::printMemory()
+{
+	struct TopicMemory {
+		uint32_t buffer_bytes;
+		uint8_t instances;
+		uint8_t max_queue_size;
+	};
+
+	const size_t num_topics = orb_topics_count();
+	TopicMemory *topics = new TopicMemory[num_topics] {};
+
+	if (topics == nullptr) {
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	size_t num_nodes = 0;
+	size_t total_buffer_bytes = 0;
+
+	lock();
+
+	for (const auto &node : _node_list) {
+		TopicMemory &topic = topics[static_cast<size_t>(node->id())];
+		const size_t buffer_bytes = node->buffer_size();
+
+		topic.buffer_bytes += buffer_bytes;
+		topic.instances++;
+
+		if (node->get_queue_size() > topic.max_queue_size) {
+			topic.max_queue_size = node->get_queue_size();
+		}
+
+		total_buffer_bytes += buffer_bytes;
+		num_nodes++;
+	}
+
+	unlock();
+
+	const orb_metadata *const *metas = orb_get_topics();
+
+	PX4_INFO_RAW("%-32s INST  #Q SIZE  BYTES\n", "TOPIC NAME");
+
+	// largest first (selection, the number of topics is small)
+	while (true) {
+		size_t largest = num_topics;
+
+		for (size_t i = 0; i < num_topics; i++) {
+			if ((topics[i].buffer_bytes > 0)
+			    && ((largest == num_topics) || (topics[i].buffer_bytes > topics[largest].buffer_bytes))) {
+				largest = i;
+			}
+		}
+
+		if (largest == num_topics) {
+			break;
+		}
+
+		TopicMemory &topic = topics[largest];
+		PX4_INFO_RAW("%-32s %4i %3i %4i %6" PRIu32 "\n", metas[largest]->o_name, (int)topic.instances,
+			     (int)topic.max_queue_size, (int)metas[largest]->o_size, topic.buffer_bytes);
+		topic.buffer_bytes = 0;
+	}
+
+	delete[] topics;
+
+	PX4_INFO_RAW("buffers: %zu bytes, nodes: %zu x %zu bytes\n", total_buffer_bytes, num_nodes, sizeof(DeviceNode));
+
+#if defined(CONFIG_ORB_ARENA)
+	PX4_INFO_RAW("arena: %" PRIu32 " / %" PRIu32 " bytes used\n", _arena_used.load(), _arena_size);
+#endif // CONFIG_ORB_ARENA
+}
+
 int uORB::DeviceMaster::addNewDeviceNodes(DeviceNodeStatisticsData **first_node, int &num_topics,
 		size_t &max_topic_name_length, char **topic_filter, int num_filters)
 {
@@ -269,9 +447,11 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 {
 	bool print_active_only = true;
 	bool only_once = false; // if true, run only once, then exit
+	bool print_latency = false; // if true, print the publish to callback latency instead of the rates
 
 	if (topic_filter && num_filters > 0) {
 		bool show_all = false;
+		int num_flags = 0;
 
 		for (int i = 0; i < num_filters; ++i) {
 			if (!strcmp("-a", topic_filter[i])) {
@@ -279,10 +459,18 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 			} else if (!strcmp("-1", topic_filter[i])) {
 				only_once = true;
+				num_flags++;
+
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+
+			} else if (!strcmp("-l", topic_filter[i])) {
+				print_latency = true;
+				num_flags++;
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
 			}
 		}
 
-		print_active_only = only_once ? (num_filters == 1) : false; // print non-active if -a or some filter given
+		print_active_only = (num_flags > 0) ? (num_filters == num_flags) : false; // print non-active if -a or some filter given
 
 		if (show_all || print_active_only) {
 			num_filters = 0;
@@ -384,16 +572,45 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 			PX4_INFO_RAW(CLEAR_LINE "update: 1s, topics: %i, total publications: %i, %.1f kB/s\n",
 				     num_topics, total_msgs, (double)(total_size / 1000.f));
-			PX4_INFO_RAW(CLEAR_LINE "%-*s INST #SUB RATE #Q SIZE\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+			if (print_latency) {
+				PX4_INFO_RAW(CLEAR_LINE "%-*s INST WAKEUPS  P50us  P99us  MAXus\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+
+			} else {
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+				PX4_INFO_RAW(CLEAR_LINE "%-*s INST #SUB RATE #Q SIZE PUB CPUS SUB CPUS\n", (int)max_topic_name_length - 2,
+					     "TOPIC NAME");
+#else
+				PX4_INFO_RAW(CLEAR_LINE "%-*s INST #SUB RATE #Q SIZE\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+#endif // CONFIG_ORB_CPU_AFFINITY
+			}
+
 			cur_node = first_node;
 
 			while (cur_node) {
 
 				if (!print_active_only || (cur_node->pub_msg_delta > 0 && cur_node->node->subscriber_count() > 0)) {
-					PX4_INFO_RAW(CLEAR_LINE "%-*s %2i %4i %4i %2i %4i \n", (int)max_topic_name_length,
-						     cur_node->node->get_meta()->o_name, (int)cur_node->node->get_instance(),
-						     (int)cur_node->node->subscriber_count(), cur_node->pub_msg_delta,
-						     cur_node->node->get_queue_size(), cur_node->node->get_meta()->o_size);
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+
+					if (print_latency) {
+						cur_node->node->print_latency_statistics(max_topic_name_length);
+
+					} else
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+					{
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+						// a subscriber CPU mask differing from the publisher mask means cache lines move between cores
+						PX4_INFO_RAW(CLEAR_LINE "%-*s %2i %4i %4i %2i %4i %8" PRIx32 " %8" PRIx32 "\n", (int)max_topic_name_length,
+							     cur_node->node->get_meta()->o_name, (int)cur_node->node->get_instance(),
+							     (int)cur_node->node->subscriber_count(), cur_node->pub_msg_delta,
+							     cur_node->node->get_queue_size(), cur_node->node->get_meta()->o_size,
+							     cur_node->node->publisher_cpus(), cur_node->node->subscriber_cpus());
+#else
+						PX4_INFO_RAW(CLEAR_LINE "%-*s %2i %4i %4i %2i %4i \n", (int)max_topic_name_length,
+							     cur_node->node->get_meta()->o_name, (int)cur_node->node->get_instance(),
+							     (int)cur_node->node->subscriber_count(), cur_node->pub_msg_delta,
+							     cur_node->node->get_queue_size(), cur_node->node->get_meta()->o_size);
+#endif // CONFIG_ORB_CPU_AFFINITY
+					}
 				}
 
 				cur_node = cur_node->next;
@@ -447,6 +664,7 @@ uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const char *nodepath)
 	return nullptr;
 }
 
+#if defined(CONSTRAINED_MEMORY)
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance)
 {
 	for (uORB::DeviceNode *node : _node_list) {
@@ -457,3 +675,4 @@ uORB::DeviceNode *uORB::DeviceMaster::getDeviceNodeLocked(const struct orb_metad
 
 	return nullptr;
 }
+#endif // CONSTRAINED_MEMORY
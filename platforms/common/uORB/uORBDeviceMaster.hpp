@@ -50,10 +50,15 @@ class Manager;
 #include <string.h>
 #include <stdlib.h>
 
+#include <containers/Bitset.hpp>
 #include <containers/IntrusiveSortedList.hpp>
+#include <px4_platform_common/atomic.h>
+
+#if defined(CONSTRAINED_MEMORY)
 #include <px4_platform_common/atomic_bitset.h>
 
 using px4::AtomicBitset;
+#endif // CONSTRAINED_MEMORY
 
 /**
  * Master control device for ObjDev.
@@ -78,6 +83,8 @@ public:
 			return nullptr;
 		}
 
+#if defined(CONSTRAINED_MEMORY)
+
 		if (!deviceNodeExists(static_cast<ORB_ID>(meta->o_id), instance)) {
 			return nullptr;
 		}
@@ -89,16 +96,25 @@ public:
 		//We can safely return the node that can be used by any thread, because
 		//a DeviceNode never gets deleted.
 		return node;
-
+#else
+		//We can safely return the node that can be used by any thread without locking, because
+		//a DeviceNode never gets deleted and is only added to the table once it is initialized.
+		return findDeviceNode(static_cast<ORB_ID>(meta->o_id), instance);
+#endif // CONSTRAINED_MEMORY
 	}
 
 	bool deviceNodeExists(ORB_ID id, const uint8_t instance)
 	{
+#if defined(CONSTRAINED_MEMORY)
+
 		if ((id == ORB_ID::INVALID) || (instance > ORB_MULTI_MAX_INSTANCES - 1)) {
 			return false;
 		}
 
 		return _node_exists[instance][(orb_id_size_t)id];
+#else
+		return findDeviceNode(id, instance) != nullptr;
+#endif // CONSTRAINED_MEMORY
 	}
 
 	/**
@@ -106,6 +122,12 @@ public:
 	 */
 	void printStatistics();
 
+	/**
+	 * Print the memory used by the message buffers of each topic (summed over the instances),
+	 * largest first.
+	 */
+	void printMemory();
+
 	/**
 	 * Continuously print statistics, like the unix top command for processes.
 	 * Exited when the user presses the enter key.
@@ -115,6 +137,24 @@ public:
 	 */
 	void showTop(char **topic_filter, int num_filters);
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	/**
+	 * Pass the wakeup latencies of all topics to cb, @see uorb_latency()
+	 */
+	void latencyStatistics(orb_latency_cb_t cb, void *user);
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
+#if defined(CONFIG_ORB_ARENA)
+	/**
+	 * Allocate a topic buffer from the arena reserved at boot, if the topic is configured for it.
+	 * Buffers are never returned, as a DeviceNode is never deleted.
+	 * @return buffer or nullptr if the heap has to be used
+	 */
+	void *arenaAlloc(const struct orb_metadata *meta, size_t size);
+
+	bool arenaContains(const void *ptr) const { return (ptr >= _arena) && (ptr < _arena + _arena_size); }
+#endif // CONFIG_ORB_ARENA
+
 private:
 	// Private constructor, uORB::Manager takes care of its creation
 	DeviceMaster();
@@ -137,10 +177,45 @@ private:
 	 * _lock must already be held when calling this.
 	 * @return node if exists, nullptr otherwise
 	 */
+#if defined(CONSTRAINED_MEMORY)
 	uORB::DeviceNode *getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance);
+#else
+	uORB::DeviceNode *getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance)
+	{
+		return findDeviceNode(static_cast<ORB_ID>(meta->o_id), instance);
+	}
+
+	uORB::DeviceNode *findDeviceNode(ORB_ID id, const uint8_t instance) const
+	{
+		if ((id == ORB_ID::INVALID) || (instance > ORB_MULTI_MAX_INSTANCES - 1)) {
+			return nullptr;
+		}
+
+		return _node_table[instance][(orb_id_size_t)id].load();
+	}
+#endif // CONSTRAINED_MEMORY
+
+#if defined(CONFIG_ORB_ARENA)
+	/**
+	 * Reserve the arena for the topics in CONFIG_ORB_ARENA_TOPICS, sized from their metadata
+	 */
+	void arenaInit();
+
+	static constexpr uint32_t ARENA_ALIGNMENT = 64; ///< cache line
+
+	uint8_t *_arena{nullptr};
+	uint32_t _arena_size{0};
+	px4::atomic<uint32_t> _arena_used{0};
+	px4::Bitset<ORB_TOPICS_COUNT> _arena_topics;
+#endif // CONFIG_ORB_ARENA
 
 	IntrusiveSortedList<uORB::DeviceNode *> _node_list;
+#if defined(CONSTRAINED_MEMORY)
 	AtomicBitset<ORB_TOPICS_COUNT> _node_exists[ORB_MULTI_MAX_INSTANCES];
+#else
+	/// direct lookup of the nodes by instance and topic, set once when a node is created (they are never deleted)
+	px4::atomic<uORB::DeviceNode *> _node_table[ORB_MULTI_MAX_INSTANCES][ORB_TOPICS_COUNT] {};
+#endif // CONSTRAINED_MEMORY
 
 	px4_sem_t	_lock; /**< lock to protect access to all class members (also for derived classes) */
 
@@ -38,6 +38,8 @@
 
 #include "SubscriptionCallback.hpp"
 
+#include <px4_platform_common/sched_trace.h>
+
 #ifdef CONFIG_ORB_COMMUNICATOR
 #include "uORBCommunicator.hpp"
 #endif /* CONFIG_ORB_COMMUNICATOR */
@@ -51,13 +53,21 @@ static uORB::SubscriptionInterval *filp_to_subscription(cdev::file_t *filp) { re
 uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const uint8_t instance, const char *path) :
 	CDev(strdup(path)), // success is checked in CDev::init
 	_meta(meta),
-	_instance(instance)
+	_instance(instance),
+	_queue_size(meta->o_queue)
 {
 }
 
 uORB::DeviceNode::~DeviceNode()
 {
-	free(_data);
+#if defined(CONFIG_ORB_ARENA)
+	DeviceMaster *device_master = uORB::Manager::get_instance()->get_device_master();
+
+	if ((device_master == nullptr) || !device_master->arenaContains(_data))
+#endif // CONFIG_ORB_ARENA
+	{
+		free(_data);
+	}
 
 	const char *devname = get_devname();
 
@@ -136,8 +146,8 @@ uORB::DeviceNode::read(cdev::file_t *filp, char *buffer, size_t buflen)
 	return filp_to_subscription(filp)->copy(buffer) ? _meta->o_size : 0;
 }
 
-ssize_t
-uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
+bool
+uORB::DeviceNode::allocate_data()
 {
 	/*
 	 * Writes are legal from interrupt context as long as the
@@ -145,8 +155,6 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	 *
 	 * Writes outside interrupt context will allocate the object
 	 * if it has not yet been allocated.
-	 *
-	 * Note that filp will usually be NULL.
 	 */
 	if (nullptr == _data) {
 
@@ -159,8 +167,20 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 
 			/* re-check size */
 			if (nullptr == _data) {
-				const size_t data_size = _meta->o_size * _meta->o_queue;
-				_data = (uint8_t *) px4_cache_aligned_alloc(data_size);
+				const size_t data_size = _meta->o_size * _queue_size;
+
+#if defined(CONFIG_ORB_ARENA)
+				DeviceMaster *device_master = uORB::Manager::get_instance()->get_device_master();
+
+				if (device_master) {
+					_data = (uint8_t *) device_master->arenaAlloc(_meta, data_size);
+				}
+
+				if (nullptr == _data)
+#endif // CONFIG_ORB_ARENA
+				{
+					_data = (uint8_t *) px4_cache_aligned_alloc(data_size);
+				}
 
 				if (_data) {
 					memset(_data, 0, data_size);
@@ -173,11 +193,32 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 		}
 
 #endif /* __PX4_NUTTX */
+	}
 
-		/* failed or could not allocate */
-		if (nullptr == _data) {
-			return -ENOMEM;
-		}
+	/* failed or could not allocate */
+	return (nullptr != _data);
+}
+
+void
+uORB::DeviceNode::notify_callbacks_locked()
+{
+	// callbacks, highest priority work queues first
+	for (auto item : _callbacks) {
+		item->call();
+	}
+
+	/* Mark at least one data has been published */
+	_data_valid = true;
+}
+
+ssize_t
+uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
+{
+	/*
+	 * Note that filp will usually be NULL.
+	 */
+	if (!allocate_data()) {
+		return -ENOMEM;
 	}
 
 	/* If write size does not match, that is an error */
@@ -187,21 +228,40 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 
 	/* Perform an atomic copy. */
 	ATOMIC_ENTER;
+
+	if (_loaned.load()) {
+		/* the next slot is currently being filled in place by the loan holder */
+		ATOMIC_LEAVE;
+		return -EBUSY;
+	}
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	// odd sequence: lock-free readers in copy() retry until the write has completed
+	_seq.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif // CONFIG_ORB_SEQLOCK
+
 	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
 	unsigned generation = _generation.fetch_add(1);
 
-	memcpy(_data + (_meta->o_size * (generation % _meta->o_queue)), buffer, _meta->o_size);
+	memcpy(_data + (_meta->o_size * (generation % _queue_size)), buffer, _meta->o_size);
+	update_queue_valid(generation);
 
-	// callbacks
-	for (auto item : _callbacks) {
-		item->call();
-	}
+#if defined(CONFIG_ORB_SEQLOCK)
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	_seq.fetch_add(1);
+#endif // CONFIG_ORB_SEQLOCK
 
-	/* Mark at least one data has been published */
-	_data_valid = true;
+	notify_callbacks_locked();
 
 	ATOMIC_LEAVE;
 
+	SCHED_TRACE(SCHED_TRACE_ORB_PUBLISH, _meta->o_name);
+
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+	record_cpu(_publisher_cpus);
+#endif // CONFIG_ORB_CPU_AFFINITY
+
 	/* notify any poll waiters */
 	poll_notify(POLLIN);
 
@@ -291,6 +351,116 @@ uORB::DeviceNode::publish(const orb_metadata *meta, orb_advert_t handle, const v
 	return PX4_OK;
 }
 
+void *
+uORB::DeviceNode::loan(const orb_metadata *meta, orb_advert_t handle)
+{
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if ((devnode == nullptr) || (meta == nullptr) || (devnode->_meta->o_id != meta->o_id)) {
+		errno = EINVAL;
+		return nullptr;
+	}
+
+	return devnode->loan_slot();
+}
+
+int
+uORB::DeviceNode::commit(const orb_metadata *meta, orb_advert_t handle)
+{
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if ((devnode == nullptr) || (meta == nullptr) || (devnode->_meta->o_id != meta->o_id)) {
+		errno = EINVAL;
+		return PX4_ERROR;
+	}
+
+	return devnode->commit_slot();
+}
+
+void *
+uORB::DeviceNode::loan_slot()
+{
+	// a single entry queue has no slot that isn't readable by subscribers
+	if ((_queue_size < 2) || !allocate_data()) {
+		errno = ENOTSUP;
+		return nullptr;
+	}
+
+	ATOMIC_ENTER;
+
+	if (_loaned.load()) {
+		ATOMIC_LEAVE;
+		errno = EBUSY;
+		return nullptr;
+	}
+
+	_loaned.store(true);
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	// invalidate lock-free readers that might still be copying the oldest entry
+	_seq.fetch_add(2);
+#endif // CONFIG_ORB_SEQLOCK
+
+	void *slot = _data + (_meta->o_size * (_generation.load() % _queue_size));
+
+	ATOMIC_LEAVE;
+
+	return slot;
+}
+
+int
+uORB::DeviceNode::commit_slot()
+{
+	ATOMIC_ENTER;
+
+	if (!_loaned.load()) {
+		ATOMIC_LEAVE;
+		errno = EINVAL;
+		return PX4_ERROR;
+	}
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	_seq.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif // CONFIG_ORB_SEQLOCK
+
+	const unsigned generation = _generation.fetch_add(1);
+	_loaned.store(false);
+	update_queue_valid(generation);
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	_seq.fetch_add(1);
+#endif // CONFIG_ORB_SEQLOCK
+
+	notify_callbacks_locked();
+
+	ATOMIC_LEAVE;
+
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+	record_cpu(_publisher_cpus);
+#endif // CONFIG_ORB_CPU_AFFINITY
+
+	/* notify any poll waiters */
+	poll_notify(POLLIN);
+
+#ifdef CONFIG_ORB_COMMUNICATOR
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+
+	if (ch != nullptr) {
+		if (ch->send_message(_meta->o_name, _meta->o_size, _data + (_meta->o_size * (generation % _queue_size))) != 0) {
+			PX4_ERR("Error Sending [%s] topic data over comm_channel", _meta->o_name);
+			return PX4_ERROR;
+		}
+	}
+
+#else
+	(void)generation;
+#endif /* CONFIG_ORB_COMMUNICATOR */
+
+	return PX4_OK;
+}
+
 int uORB::DeviceNode::unadvertise(orb_advert_t handle)
 {
 	if (handle == nullptr) {
@@ -358,12 +528,74 @@ uORB::DeviceNode::print_statistics(int max_topic_length)
 
 	unlock();
 
-	PX4_INFO_RAW("%-*s %2i %4i %2i %4i %s\n", max_topic_length, get_meta()->o_name, (int)instance, (int)sub_count,
-		     get_meta()->o_queue, get_meta()->o_size, get_devname());
+	PX4_INFO_RAW("%-*s %2i %4i %3i %4i %4u %s\n", max_topic_length, get_meta()->o_name, (int)instance, (int)sub_count,
+		     get_queue_size(), get_meta()->o_size, max_generations_skipped(), get_devname());
 
 	return true;
 }
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+int
+uORB::DeviceNode::copy_callback_latencies(CallbackLatency *callbacks, int max_callbacks)
+{
+	int num_callbacks = 0;
+
+	// copy out while locked, callbacks might unregister while printing
+	ATOMIC_ENTER;
+
+	for (auto item : _callbacks) {
+		if (num_callbacks < max_callbacks) {
+			const LatencyHistogram &hist = item->latency_histogram();
+			callbacks[num_callbacks++] = {item->callback_name(), hist.count(), hist.percentile_us(50), hist.percentile_us(99), hist.max_us()};
+		}
+	}
+
+	ATOMIC_LEAVE;
+
+	return num_callbacks;
+}
+
+void
+uORB::DeviceNode::print_latency_statistics(int max_topic_length)
+{
+	CallbackLatency callbacks[MAX_LATENCY_CALLBACKS];
+	const int num_callbacks = copy_callback_latencies(callbacks, MAX_LATENCY_CALLBACKS);
+
+	PX4_INFO_RAW("\033[K%-*s %2i %7" PRIu32 " %6" PRIu32 " %6" PRIu32 " %6" PRIu32 "\n", max_topic_length, get_name(), (int)get_instance(),
+		     _latency_histogram.count(), _latency_histogram.percentile_us(50), _latency_histogram.percentile_us(99),
+		     _latency_histogram.max_us());
+
+	for (int i = 0; i < num_callbacks; i++) {
+		PX4_INFO_RAW("\033[K  -> %-*s %7" PRIu32 " %6" PRIu32 " %6" PRIu32 " %6" PRIu32 "\n", max_topic_length - 2, callbacks[i].name,
+			     callbacks[i].count, callbacks[i].p50_us, callbacks[i].p99_us, callbacks[i].max_us);
+	}
+}
+
+void
+uORB::DeviceNode::latency_statistics(orb_latency_cb_t cb, void *user)
+{
+	if (_latency_histogram.count() == 0) {
+		return;
+	}
+
+	CallbackLatency callbacks[MAX_LATENCY_CALLBACKS];
+	const int num_callbacks = copy_callback_latencies(callbacks, MAX_LATENCY_CALLBACKS);
+	char line[96];
+
+	snprintf(line, sizeof(line), "%s %i: n=%" PRIu32 " p50=%" PRIu32 "us p99=%" PRIu32 "us max=%" PRIu32 "us", get_name(),
+		 (int)get_instance(), _latency_histogram.count(), _latency_histogram.percentile_us(50),
+		 _latency_histogram.percentile_us(99), _latency_histogram.max_us());
+	cb(line, user);
+
+	for (int i = 0; i < num_callbacks; i++) {
+		snprintf(line, sizeof(line), "%s %i -> %s: n=%" PRIu32 " p50=%" PRIu32 "us p99=%" PRIu32 "us max=%" PRIu32 "us",
+			 get_name(), (int)get_instance(), callbacks[i].name, callbacks[i].count, callbacks[i].p50_us, callbacks[i].p99_us,
+			 callbacks[i].max_us);
+		cb(line, user);
+	}
+}
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 void uORB::DeviceNode::add_internal_subscriber()
 {
 	lock();
@@ -414,7 +646,7 @@ int16_t uORB::DeviceNode::process_add_subscription()
 	if (_data != nullptr && ch != nullptr) { // _data will not be null if there is a publisher.
 		// Only send the most recent data to initialize the remote end.
 		if (_data_valid) {
-			ch->send_message(_meta->o_name, _meta->o_size, _data + (_meta->o_size * ((_generation.load() - 1) % _meta->o_queue)));
+			ch->send_message(_meta->o_name, _meta->o_size, _data + (_meta->o_size * ((_generation.load() - 1) % _queue_size)));
 		}
 	}
 
@@ -463,6 +695,84 @@ unsigned uORB::DeviceNode::get_initial_generation()
 	return generation;
 }
 
+int
+uORB::DeviceNode::set_queue_size(unsigned queue_size)
+{
+	// the slot index is generation % queue size, which only stays continuous across the wrap-around for powers of 2
+	if ((queue_size == 0) || (queue_size > UINT8_MAX) || ((queue_size & (queue_size - 1)) != 0)) {
+		return -EINVAL;
+	}
+
+	lock();
+
+	if (_data == nullptr) {
+		// nothing published yet, the buffer gets allocated with the new size
+		_queue_size = queue_size;
+		unlock();
+		return PX4_OK;
+	}
+
+	unlock();
+
+	if (queue_size == _queue_size) {
+		return PX4_OK;
+	}
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	// lock-free readers might still be copying from the current buffer, which can therefore not be released
+	return -EBUSY;
+#else
+	uint8_t *data = (uint8_t *) px4_cache_aligned_alloc(_meta->o_size * queue_size);
+
+	if (data == nullptr) {
+		return -ENOMEM;
+	}
+
+	memset(data, 0, _meta->o_size * queue_size);
+
+	ATOMIC_ENTER;
+
+	if (_loaned.load()) {
+		ATOMIC_LEAVE;
+		free(data);
+		return -EBUSY;
+	}
+
+	// keep the most recent messages at the slot of their generation
+	const unsigned generation = _generation.load();
+	unsigned num_keep = (queue_size < _queue_size) ? queue_size : _queue_size;
+
+	if (num_keep > generation) {
+		num_keep = generation;
+	}
+
+	for (unsigned g = generation - num_keep; g != generation; g++) {
+		memcpy(data + (_meta->o_size * (g % queue_size)), _data + (_meta->o_size * (g % _queue_size)), _meta->o_size);
+	}
+
+	uint8_t *previous_data = _data;
+	_data = data;
+	_queue_size = queue_size;
+
+	// the slots of the older generations are empty, copy() must not hand them out
+	_oldest_valid_generation = generation - num_keep;
+	_queue_partially_valid = (num_keep < queue_size);
+
+	ATOMIC_LEAVE;
+
+#if defined(CONFIG_ORB_ARENA)
+	DeviceMaster *device_master = uORB::Manager::get_instance()->get_device_master();
+
+	if ((device_master == nullptr) || !device_master->arenaContains(previous_data))
+#endif // CONFIG_ORB_ARENA
+	{
+		free(previous_data);
+	}
+
+	return PX4_OK;
+#endif // CONFIG_ORB_SEQLOCK
+}
+
 bool
 uORB::DeviceNode::register_callback(uORB::SubscriptionCallback *callback_sub)
 {
@@ -35,14 +35,22 @@
 
 #include "uORBCommon.hpp"
 #include "uORBDeviceMaster.hpp"
+#include "LatencyHistogram.hpp"
 
 #include <lib/cdev/CDev.hpp>
 
 #include <containers/IntrusiveSortedList.hpp>
-#include <containers/List.hpp>
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+# if defined(__PX4_NUTTX)
+#  include <nuttx/arch.h>
+# else
+#  include <sched.h>
+# endif
+#endif // CONFIG_ORB_CPU_AFFINITY
+
 namespace uORB
 {
 class DeviceNode;
@@ -123,6 +131,20 @@ public:
 
 	static int        unadvertise(orb_advert_t handle);
 
+	/**
+	 * Loan the next queue slot of this node to the publisher, so the message can be
+	 * filled in place instead of being copied from the caller's stack.
+	 * Only supported for queued topics (queue size > 1): while the loan is outstanding
+	 * the oldest queue entry is no longer readable and regular writes are rejected.
+	 * @return pointer to the slot, or nullptr if a loan is not possible
+	 */
+	static void      *loan(const orb_metadata *meta, orb_advert_t handle);
+
+	/**
+	 * Publish the previously loaned slot.
+	 */
+	static int        commit(const orb_metadata *meta, orb_advert_t handle);
+
 #ifdef CONFIG_ORB_COMMUNICATOR
 	/**
 	 * processes a request for topic advertisement from remote
@@ -186,7 +208,25 @@ public:
 	 */
 	bool print_statistics(int max_topic_length);
 
-	uint8_t get_queue_size() const { return _meta->o_queue; }
+	uint8_t get_queue_size() const { return _queue_size; }
+
+	/**
+	 * Size of the allocated message buffer (queue size * message size), 0 if not allocated yet
+	 */
+	size_t buffer_size() const { return (_data != nullptr) ? _meta->o_size * _queue_size : 0; }
+
+	/**
+	 * Change the queue depth of this topic instance at runtime (starting from ORB_QUEUE_LENGTH of the msg).
+	 * The most recent messages are preserved.
+	 * @param queue_size new depth, a power of 2 (required for generation wrap-around) up to 255
+	 * @return PX4_OK on success, otherwise -errno
+	 */
+	int set_queue_size(unsigned queue_size);
+
+	/**
+	 * Largest number of messages a single subscriber lost at once because it read less often than the queue depth.
+	 */
+	unsigned max_generations_skipped() const { return _max_generations_skipped.load(); }
 
 	int8_t subscriber_count() const { return _subscriber_count; }
 
@@ -225,43 +265,87 @@ public:
 	bool copy(void *dst, unsigned &generation)
 	{
 		if ((dst != nullptr) && (_data != nullptr)) {
-			if (_meta->o_queue == 1) {
-				ATOMIC_ENTER;
-				memcpy(dst, _data, _meta->o_size);
-				generation = _generation.load();
-				ATOMIC_LEAVE;
-				return true;
-
-			} else {
-				ATOMIC_ENTER;
-				const unsigned current_generation = _generation.load();
-
-				if (current_generation == generation) {
-					/* The subscriber already read the latest message, but nothing new was published yet.
-					* Return the previous message
-					*/
-					--generation;
-				}
+#if defined(CONFIG_ORB_SEQLOCK)
+			// lock-free read: retry if a publisher wrote to the buffer while copying
+			unsigned seq_begin;
+			unsigned copy_generation;
+
+			do {
+				seq_begin = _seq.load();
+				copy_generation = generation;
 
-				// Compatible with normal and overflow conditions
-				if (!is_in_range(current_generation - _meta->o_queue, generation, current_generation - 1)) {
-					// Reader is too far behind: some messages are lost
-					generation = current_generation - _meta->o_queue;
+				if ((seq_begin & 1u) == 0) {
+					copy_unlocked(dst, copy_generation);
 				}
 
-				memcpy(dst, _data + (_meta->o_size * (generation % _meta->o_queue)), _meta->o_size);
-				ATOMIC_LEAVE;
+				__atomic_thread_fence(__ATOMIC_SEQ_CST);
 
-				++generation;
+			} while ((seq_begin & 1u) || (seq_begin != _seq.load()));
 
-				return true;
-			}
+			generation = copy_generation;
+#else
+			ATOMIC_ENTER;
+			copy_unlocked(dst, generation);
+			ATOMIC_LEAVE;
+#endif // CONFIG_ORB_SEQLOCK
+
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+			record_cpu(_subscriber_cpus);
+#endif // CONFIG_ORB_CPU_AFFINITY
+
+			return true;
 		}
 
 		return false;
 
 	}
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	void record_wakeup_latency(uint32_t latency_us) { _latency_histogram.record(latency_us); }
+
+	/**
+	 * Print the publish to callback wakeup latency of the topic and each registered callback
+	 * @param max_topic_length max topic name length for printing
+	 */
+	void print_latency_statistics(int max_topic_length);
+
+	/**
+	 * Pass the wakeup latency of the topic and each registered callback to cb, one line of text each.
+	 * Nothing if there are no samples.
+	 */
+	void latency_statistics(orb_latency_cb_t cb, void *user);
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+	/**
+	 * Bitmask of the CPUs that published to / copied from this topic instance
+	 */
+	uint32_t publisher_cpus() const { return _publisher_cpus.load(); }
+	uint32_t subscriber_cpus() const { return _subscriber_cpus.load(); }
+
+	static void record_cpu(px4::atomic<uint32_t> &cpus)
+	{
+		const uint32_t bit = 1u << (current_cpu() % 32);
+
+		// only write to the shared cache line when a new CPU shows up
+		if ((cpus.load() & bit) == 0) {
+			cpus.fetch_or(bit);
+		}
+	}
+
+	static unsigned current_cpu()
+	{
+#if defined(__PX4_NUTTX) && defined(CONFIG_SMP)
+		return up_cpu_index();
+#elif defined(__PX4_LINUX)
+		const int cpu = sched_getcpu();
+		return (cpu > 0) ? cpu : 0;
+#else
+		return 0;
+#endif
+	}
+#endif // CONFIG_ORB_CPU_AFFINITY
+
 	// add item to list of work items to schedule on node update
 	bool register_callback(SubscriptionCallback *callback_sub);
 
@@ -277,20 +361,126 @@ protected:
 private:
 	friend uORBTest::UnitTest;
 
+	/**
+	 * Allocate the data buffer if it doesn't exist yet (not possible from interrupt context).
+	 * @return true if the buffer is available
+	 */
+	bool allocate_data();
+
+	/**
+	 * Schedule the registered callbacks after new data was written, must be called with ATOMIC_ENTER held.
+	 */
+	void notify_callbacks_locked();
+
+	void *loan_slot();
+	int commit_slot();
+
 	const orb_metadata *_meta; /**< object metadata information */
 
 	uint8_t *_data{nullptr};   /**< allocated object buffer */
 	bool _data_valid{false}; /**< At least one valid data */
 	px4::atomic<unsigned>  _generation{0};  /**< object generation count */
-	List<uORB::SubscriptionCallback *>	_callbacks;
+	IntrusiveSortedList<uORB::SubscriptionCallback *> _callbacks; ///< sorted by priority, highest first
 
 	const uint8_t _instance; /**< orb multi instance identifier */
+	uint8_t _queue_size; /**< queue depth, initially ORB_QUEUE_LENGTH of the msg */
 	bool _advertised{false};  /**< has ever been advertised (not necessarily published data yet) */
 
 	int8_t _subscriber_count{0};
 
+	px4::atomic<unsigned> _max_generations_skipped{0}; /**< worst case number of messages lost by a subscriber */
+
+	px4::atomic_bool _loaned{false}; /**< a publisher holds a loan on the next queue slot, read by lock-free readers */
+
+	unsigned _oldest_valid_generation{0}; /**< oldest generation kept by the last queue resize */
+	bool _queue_partially_valid{false}; /**< the queue was grown, the slots before _oldest_valid_generation are empty */
+
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	LatencyHistogram _latency_histogram {}; /**< publish to callback wakeup latency of all callbacks */
+
+	static constexpr int MAX_LATENCY_CALLBACKS = 8;
+
+	struct CallbackLatency {
+		const char *name;
+		uint32_t count;
+		uint32_t p50_us;
+		uint32_t p99_us;
+		uint32_t max_us;
+	};
+
+	int copy_callback_latencies(CallbackLatency *callbacks, int max_callbacks);
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
+#if defined(CONFIG_ORB_CPU_AFFINITY)
+	px4::atomic<uint32_t> _publisher_cpus {0};
+	px4::atomic<uint32_t> _subscriber_cpus {0};
+#endif // CONFIG_ORB_CPU_AFFINITY
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	px4::atomic<unsigned> _seq {0}; /**< seqlock sequence, odd while a publisher is writing to _data */
+#endif // CONFIG_ORB_SEQLOCK
+
+	/**
+	 * Copy the message for the given generation into dst. The caller is responsible
+	 * for synchronization with the publisher (node lock or seqlock retry).
+	 */
+	void copy_unlocked(void *dst, unsigned &generation)
+	{
+		if (_queue_size == 1) {
+			memcpy(dst, _data, _meta->o_size);
+			generation = _generation.load();
+
+		} else {
+			const unsigned current_generation = _generation.load();
+
+			if (current_generation == generation) {
+				/* The subscriber already read the latest message, but nothing new was published yet.
+				* Return the previous message
+				*/
+				--generation;
+			}
+
+			// the oldest entry is being overwritten in place while loaned
+			unsigned queue_size = _loaned.load() ? (_queue_size - 1) : _queue_size;
+
+			if (_queue_partially_valid) {
+				// after growing the queue, only the messages kept by the resize and newer ones are valid
+				const unsigned num_valid = current_generation - _oldest_valid_generation;
+
+				if (num_valid < queue_size) {
+					queue_size = (num_valid > 0) ? num_valid : 1;
+				}
+			}
+
+			// Compatible with normal and overflow conditions
+			if (!is_in_range(current_generation - queue_size, generation, current_generation - 1)) {
+				// Reader is too far behind: some messages are lost
+				update_max_generations_skipped((current_generation - queue_size) - generation);
+				generation = current_generation - queue_size;
+			}
+
+			memcpy(dst, _data + (_meta->o_size * (generation % _queue_size)), _meta->o_size);
+
+			++generation;
+		}
+	}
+
+	void update_queue_valid(unsigned generation)
+	{
+		// the grown queue is completely filled again
+		if (_queue_partially_valid && (generation - _oldest_valid_generation >= _queue_size)) {
+			_queue_partially_valid = false;
+		}
+	}
+
+	void update_max_generations_skipped(unsigned skipped)
+	{
+		unsigned max_skipped = _max_generations_skipped.load();
+
+		while ((skipped > max_skipped) && !_max_generations_skipped.compare_exchange(&max_skipped, skipped)) {}
+	}
 
-// Determine the data range
+	// Determine the data range
 	static inline bool is_in_range(unsigned left, unsigned value, unsigned right)
 	{
 		if (right > left) {
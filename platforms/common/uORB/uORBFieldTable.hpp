@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file uORBFieldTable.hpp
+ *
+ * Compile-time field layout of the uORB messages, generated from the msg definitions
+ * (see uORB::fields::<message name> in the generated topic headers).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace uORB
+{
+
+enum class FieldType : uint8_t {
+	INT8,
+	INT16,
+	INT32,
+	INT64,
+	UINT8,
+	UINT16,
+	UINT32,
+	UINT64,
+	FLOAT32,
+	FLOAT64,
+	BOOL,
+	CHAR,
+	NESTED, ///< embedded message, see FieldDescriptor::nested
+};
+
+struct FieldTable;
+
+struct FieldDescriptor {
+	const char *name;
+	uint16_t offset;         ///< byte offset within the message struct
+	uint16_t element_size;   ///< size of a single element in bytes
+	uint16_t array_length;   ///< number of elements (1 for non-arrays)
+	FieldType type;
+	const FieldTable *nested; ///< layout of the embedded message (FieldType::NESTED), nullptr otherwise
+};
+
+struct FieldTable {
+	const char *name;              ///< message name (snake case), also the name of its ulog format
+	const FieldDescriptor *fields; ///< in memory order, including padding fields
+	uint16_t num_fields;
+	uint16_t struct_size;
+};
+
+/**
+ * C type of a built-in field type, as used in the ulog format definitions.
+ * @return type name, or nullptr for FieldType::NESTED
+ */
+static inline const char *field_type_c_name(FieldType type)
+{
+	switch (type) {
+	case FieldType::INT8: return "int8_t";
+
+	case FieldType::INT16: return "int16_t";
+
+	case FieldType::INT32: return "int32_t";
+
+	case FieldType::INT64: return "int64_t";
+
+	case FieldType::UINT8: return "uint8_t";
+
+	case FieldType::UINT16: return "uint16_t";
+
+	case FieldType::UINT32: return "uint32_t";
+
+	case FieldType::UINT64: return "uint64_t";
+
+	case FieldType::FLOAT32: return "float";
+
+	case FieldType::FLOAT64: return "double";
+
+	case FieldType::BOOL: return "bool";
+
+	case FieldType::CHAR: return "char";
+
+	case FieldType::NESTED: break;
+	}
+
+	return nullptr;
+}
+
+} // namespace uORB
@@ -179,6 +179,12 @@ int	uORB::Manager::orb_ioctl(unsigned int cmd, unsigned long arg)
 		}
 		break;
 
+	case ORBIOCDEVSUBSCRIBERCOUNT: {
+			orbiocdevsubscribercount_t *data = (orbiocdevsubscribercount_t *)arg;
+			data->count = uORB::Manager::orb_get_subscriber_count(data->handle);
+		}
+		break;
+
 	case ORBIOCDEVDATACOPY: {
 			orbiocdevdatacopy_t *data = (orbiocdevdatacopy_t *)arg;
 			data->ret = uORB::Manager::orb_data_copy(data->handle, data->dst, data->generation, data->only_if_updated);
@@ -210,6 +216,9 @@ int	uORB::Manager::orb_ioctl(unsigned int cmd, unsigned long arg)
 				if (arg == ORB_DEVMASTER_TOP) {
 					dev->showTop(nullptr, 0);
 
+				} else if (arg == ORB_DEVMASTER_MEMORY) {
+					dev->printMemory();
+
 				} else {
 					dev->printStatistics();
 				}
@@ -375,6 +384,25 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return uORB::DeviceNode::publish(meta, handle, data);
 }
 
+void *uORB::Manager::orb_loan(const struct orb_metadata *meta, orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		errno = ENOTSUP;
+		return nullptr;
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	return uORB::DeviceNode::loan(meta, handle);
+}
+
+int uORB::Manager::orb_commit(const struct orb_metadata *meta, orb_advert_t handle)
+{
+	return uORB::DeviceNode::commit(meta, handle);
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -445,6 +473,8 @@ void uORB::Manager::orb_remove_internal_subscriber(void *node_handle)
 
 uint8_t uORB::Manager::orb_get_queue_size(const void *node_handle) { return static_cast<const DeviceNode *>(node_handle)->get_queue_size(); }
 
+int uORB::Manager::orb_get_subscriber_count(const void *node_handle) { return static_cast<const DeviceNode *>(node_handle)->subscriber_count(); }
+
 bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated)
 {
 	if (!is_advertised(node_handle)) {
@@ -479,6 +509,15 @@ uint8_t uORB::Manager::orb_get_instance(const void *node_handle)
 	return -1;
 }
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+void uORB::Manager::record_wakeup_latency(void *node_handle, uint32_t latency_us)
+{
+	if (node_handle) {
+		static_cast<DeviceNode *>(node_handle)->record_wakeup_latency(latency_us);
+	}
+}
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 /* These are optimized by inlining in NuttX Flat build */
 #if !defined(CONFIG_BUILD_FLAT)
 unsigned uORB::Manager::updates_available(const void *node_handle, unsigned last_generation)
@@ -147,9 +147,16 @@ typedef struct {
 	bool ret;
 } orbiocdevisadvertised_t;
 
+#define ORBIOCDEVSUBSCRIBERCOUNT	_ORBIOCDEV(43)
+typedef struct {
+	const void *handle;
+	int count;
+} orbiocdevsubscribercount_t;
+
 typedef enum {
 	ORB_DEVMASTER_STATUS = 0,
-	ORB_DEVMASTER_TOP = 1
+	ORB_DEVMASTER_TOP = 1,
+	ORB_DEVMASTER_MEMORY = 2
 } orbiocdevmastercmd_t;
 #define ORBIOCDEVMASTERCMD	_ORBIOCDEV(45)
 
@@ -279,6 +286,30 @@ public:
 	 */
 	static int  orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data);
 
+	/**
+	 * Loan the next queue slot of a topic to fill a message in place (zero-copy publication).
+	 *
+	 * Only queued topics (ORB_QUEUE_LENGTH > 1) support loans, and only in builds where
+	 * the topic buffers are accessible to the publisher (not in the user side of a
+	 * NuttX protected build). Callers must fall back to orb_publish() if this fails.
+	 *
+	 * @param meta    The uORB metadata (usually from the ORB_ID() macro)
+	 *      for the topic.
+	 * @param handle  The handle returned from orb_advertise.
+	 * @return    pointer to the message buffer, nullptr on failure with errno set accordingly.
+	 */
+	static void *orb_loan(const struct orb_metadata *meta, orb_advert_t handle);
+
+	/**
+	 * Publish the message previously loaned with orb_loan().
+	 *
+	 * @param meta    The uORB metadata (usually from the ORB_ID() macro)
+	 *      for the topic.
+	 * @param handle  The handle returned from orb_advertise.
+	 * @return    OK on success, PX4_ERROR otherwise with errno set accordingly.
+	 */
+	static int  orb_commit(const struct orb_metadata *meta, orb_advert_t handle);
+
 	/**
 	 * Subscribe to a topic.
 	 *
@@ -440,6 +471,8 @@ public:
 
 	static uint8_t orb_get_queue_size(const void *node_handle);
 
+	static int orb_get_subscriber_count(const void *node_handle);
+
 	static bool orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated);
 
 	static bool register_callback(void *node_handle, SubscriptionCallback *callback_sub);
@@ -448,6 +481,13 @@ public:
 
 	static uint8_t orb_get_instance(const void *node_handle);
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+	/**
+	 * Add a publish to callback wakeup latency sample to the topic statistics.
+	 */
+	static void record_wakeup_latency(void *node_handle, uint32_t latency_us);
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 #if defined(CONFIG_BUILD_FLAT)
 	/* These are optimized by inlining in NuttX Flat build */
 	static unsigned updates_available(const void *node_handle, unsigned last_generation) { return is_advertised(node_handle) ? static_cast<const DeviceNode *>(node_handle)->updates_available(last_generation) : 0; }
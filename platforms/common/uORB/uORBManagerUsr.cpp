@@ -155,6 +155,19 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return d.ret;
 }
 
+void *uORB::Manager::orb_loan(const struct orb_metadata *meta, orb_advert_t handle)
+{
+	// topic buffers live in kernel memory
+	errno = ENOTSUP;
+	return nullptr;
+}
+
+int uORB::Manager::orb_commit(const struct orb_metadata *meta, orb_advert_t handle)
+{
+	errno = EINVAL;
+	return PX4_ERROR;
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -293,6 +306,14 @@ uint8_t uORB::Manager::orb_get_queue_size(const void *node_handle)
 	return data.size;
 }
 
+int uORB::Manager::orb_get_subscriber_count(const void *node_handle)
+{
+	orbiocdevsubscribercount_t data = {node_handle, 0};
+	boardctl(ORBIOCDEVSUBSCRIBERCOUNT, reinterpret_cast<unsigned long>(&data));
+
+	return data.count;
+}
+
 bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated)
 {
 	orbiocdevdatacopy_t data = {node_handle, dst, generation, only_if_updated, false};
@@ -324,6 +345,13 @@ uint8_t uORB::Manager::orb_get_instance(const void *node_handle)
 	return data.instance;
 }
 
+#if defined(CONFIG_ORB_LATENCY_HISTOGRAM)
+void uORB::Manager::record_wakeup_latency(void *node_handle, uint32_t latency_us)
+{
+	// per-topic statistics are kept on the kernel side only, the per-callback ones are still available
+}
+#endif // CONFIG_ORB_LATENCY_HISTOGRAM
+
 unsigned uORB::Manager::updates_available(const void *node_handle, unsigned last_generation)
 {
 	orbiocdevupdatesavail_t data = {node_handle, last_generation, 0};
@@ -0,0 +1,290 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBTest_Stress.hpp"
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <uORB/LatencyHistogram.hpp>
+#include <uORB/PublicationMulti.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/orb_test.h>
+#include <uORB/topics/orb_test_large.h>
+#include <uORB/topics/orb_test_medium.h>
+
+namespace uORBTest
+{
+
+static constexpr int MAX_SUBSCRIBERS = 32;
+
+// spread the publishers and subscribers over both test work queues, so that most
+// publications cross a thread boundary and publishers contend with each other
+static const px4::wq_config_t &work_queue(int index)
+{
+	return (index % 2 == 0) ? px4::wq_configurations::test1 : px4::wq_configurations::test2;
+}
+
+template<typename T>
+class StressPublisher : public px4::ScheduledWorkItem
+{
+public:
+	StressPublisher(const orb_metadata *meta, int index) :
+		ScheduledWorkItem("uorb_stress_pub", work_queue(index)),
+		_pub(meta)
+	{}
+
+	~StressPublisher() override = default;
+
+	bool start(uint32_t interval_us)
+	{
+		if (!_pub.advertise()) {
+			return false;
+		}
+
+		ScheduleOnInterval(interval_us);
+		return true;
+	}
+
+	void stop() { ScheduleClear(); }
+
+	int instance() { return _pub.get_instance(); }
+
+	uint32_t published() const { return _published; }
+	uint64_t run_time_us() const { return _run_time_us; }
+	const uORB::LatencyHistogram &publish_time() const { return _publish_time; }
+
+private:
+	void Run() override
+	{
+		const hrt_abstime now = hrt_absolute_time();
+
+		_msg.timestamp = now;
+		_msg.val++;
+		_pub.publish(_msg);
+
+		const hrt_abstime published = hrt_absolute_time();
+		_publish_time.record(published - now);
+		_run_time_us += published - now;
+		_published++;
+	}
+
+	uORB::PublicationMulti<T> _pub;
+	T _msg{};
+
+	uORB::LatencyHistogram _publish_time{};
+	uint64_t _run_time_us{0};
+	uint32_t _published{0};
+};
+
+template<typename T>
+class StressSubscriber : public px4::WorkItem
+{
+public:
+	StressSubscriber(const orb_metadata *meta, uint8_t instance, int index) :
+		WorkItem("uorb_stress_sub", work_queue(index + 1)),
+		_sub(this, meta, instance)
+	{}
+
+	~StressSubscriber() override = default;
+
+	bool start() { return _sub.registerCallback(); }
+	void stop() { _sub.unregisterCallback(); }
+
+	uint32_t received() const { return _received; }
+	uint32_t missed() const { return _missed; }
+	uint64_t run_time_us() const { return _run_time_us; }
+	const uORB::LatencyHistogram &latency() const { return _latency; }
+
+private:
+	void Run() override
+	{
+		const hrt_abstime start = hrt_absolute_time();
+		T msg;
+
+		while (_sub.update(&msg)) {
+			_latency.record(hrt_absolute_time() - msg.timestamp);
+
+			// publications overwritten before this subscriber ran
+			if ((_received > 0) && (msg.val > _last_val + 1)) {
+				_missed += msg.val - _last_val - 1;
+			}
+
+			_last_val = msg.val;
+			_received++;
+		}
+
+		_run_time_us += hrt_absolute_time() - start;
+	}
+
+	uORB::SubscriptionCallbackWorkItem _sub;
+
+	uORB::LatencyHistogram _latency{};
+	uint64_t _run_time_us{0};
+	uint32_t _received{0};
+	uint32_t _missed{0};
+	int32_t _last_val{0};
+};
+
+template<typename T>
+static int run(const orb_metadata *meta, const StressConfig &config)
+{
+	StressPublisher<T> *publishers[ORB_MULTI_MAX_INSTANCES] {};
+	StressSubscriber<T> *subscribers[MAX_SUBSCRIBERS] {};
+	int ret = PX4_OK;
+
+	for (int i = 0; i < config.publishers; i++) {
+		publishers[i] = new StressPublisher<T>(meta, i);
+
+		// advertise all instances before subscribing
+		if ((publishers[i] == nullptr) || !publishers[i]->start(1e6 / config.rate_hz)) {
+			PX4_ERR("publisher %d setup failed", i);
+			ret = PX4_ERROR;
+			break;
+		}
+	}
+
+	for (int i = 0; (ret == PX4_OK) && (i < config.subscribers); i++) {
+		const int instance = publishers[i % config.publishers]->instance();
+		subscribers[i] = new StressSubscriber<T>(meta, instance, i);
+
+		if ((subscribers[i] == nullptr) || !subscribers[i]->start()) {
+			PX4_ERR("subscriber %d setup failed", i);
+			ret = PX4_ERROR;
+		}
+	}
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	if (ret == PX4_OK) {
+		px4_usleep(config.duration_s * 1'000'000);
+	}
+
+	for (int i = 0; i < config.publishers; i++) {
+		if (publishers[i]) {
+			publishers[i]->stop();
+		}
+	}
+
+	const hrt_abstime duration = hrt_elapsed_time(&start);
+
+	// let the subscribers drain the last publications before unregistering
+	px4_usleep(100'000);
+
+	for (int i = 0; i < config.subscribers; i++) {
+		if (subscribers[i]) {
+			subscribers[i]->stop();
+		}
+	}
+
+	px4_usleep(10'000);
+
+	if (ret == PX4_OK) {
+		uORB::LatencyHistogram publish_time{};
+		uORB::LatencyHistogram latency{};
+		uint64_t run_time_us = 0;
+		uint32_t published = 0;
+		uint32_t expected = 0;
+		uint32_t received = 0;
+		uint32_t missed = 0;
+
+		for (int i = 0; i < config.publishers; i++) {
+			publish_time.merge(publishers[i]->publish_time());
+			run_time_us += publishers[i]->run_time_us();
+			published += publishers[i]->published();
+		}
+
+		for (int i = 0; i < config.subscribers; i++) {
+			latency.merge(subscribers[i]->latency());
+			run_time_us += subscribers[i]->run_time_us();
+			expected += publishers[i % config.publishers]->published();
+			received += subscribers[i]->received();
+			missed += subscribers[i]->missed();
+		}
+
+		PX4_INFO("%d publishers at %" PRIu32 " Hz, %d subscribers, %zu bytes, %.1f s",
+			 config.publishers, config.rate_hz, config.subscribers, sizeof(T), (double)(duration * 1e-6));
+		PX4_INFO("published %" PRIu32 ", received %" PRIu32 " of %" PRIu32 ", missed %" PRIu32,
+			 published, received, expected, missed);
+		PX4_INFO("latency (us)      p50 <%" PRIu32 " p90 <%" PRIu32 " p99 <%" PRIu32 " max %" PRIu32,
+			 latency.percentile_us(50), latency.percentile_us(90), latency.percentile_us(99), latency.max_us());
+		PX4_INFO("publish time (us) p50 <%" PRIu32 " p90 <%" PRIu32 " p99 <%" PRIu32 " max %" PRIu32,
+			 publish_time.percentile_us(50), publish_time.percentile_us(90), publish_time.percentile_us(99),
+			 publish_time.max_us());
+		PX4_INFO("cpu %.2f%% (time in the test work items)", (double)(100.f * run_time_us / duration));
+	}
+
+	for (int i = 0; i < config.subscribers; i++) {
+		delete subscribers[i];
+	}
+
+	for (int i = 0; i < config.publishers; i++) {
+		delete publishers[i];
+	}
+
+	return ret;
+}
+
+int stress_test(const StressConfig &config)
+{
+	if ((config.publishers < 1) || (config.publishers > ORB_MULTI_MAX_INSTANCES)) {
+		PX4_ERR("publishers must be 1 to %d", ORB_MULTI_MAX_INSTANCES);
+		return PX4_ERROR;
+	}
+
+	if ((config.subscribers < 1) || (config.subscribers > MAX_SUBSCRIBERS)) {
+		PX4_ERR("subscribers must be 1 to %d", MAX_SUBSCRIBERS);
+		return PX4_ERROR;
+	}
+
+	if ((config.rate_hz < 1) || (config.rate_hz > 10'000) || (config.duration_s < 1)) {
+		PX4_ERR("invalid rate or duration");
+		return PX4_ERROR;
+	}
+
+	switch (config.size) {
+	case StressConfig::MessageSize::Small:
+		return run<orb_test_s>(ORB_ID(orb_multitest), config);
+
+	case StressConfig::MessageSize::Medium:
+		return run<orb_test_medium_s>(ORB_ID(orb_test_medium_multi), config);
+
+	case StressConfig::MessageSize::Large:
+		return run<orb_test_large_s>(ORB_ID(orb_test_large), config);
+	}
+
+	return PX4_ERROR;
+}
+
+} // namespace uORBTest
@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file uORBTest_Stress.hpp
+ *
+ * uORB load test: N publishers and M subscribers on the test work queues,
+ * reporting the end-to-end latency, the publish time (which grows with lock
+ * contention) and the CPU time spent in the test work items.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace uORBTest
+{
+
+struct StressConfig {
+	enum class MessageSize {
+		Small,  ///< orb_test
+		Medium, ///< orb_test_medium, 64 bytes payload
+		Large,  ///< orb_test_large, 512 bytes payload
+	};
+
+	int publishers{2};              ///< up to ORB_MULTI_MAX_INSTANCES, each publishes its own topic instance
+	int subscribers{8};             ///< subscriber i subscribes to the instance of publisher i % publishers
+	uint32_t rate_hz{1000};         ///< publication rate of each publisher
+	MessageSize size{MessageSize::Medium};
+	uint32_t duration_s{5};
+};
+
+/**
+ * Run the load test, printing the results.
+ * @return PX4_OK, or PX4_ERROR if the configuration is invalid or the setup failed
+ */
+int stress_test(const StressConfig &config);
+
+} // namespace uORBTest
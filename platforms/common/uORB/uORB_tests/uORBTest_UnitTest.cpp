@@ -39,7 +39,9 @@
 #include <errno.h>
 #include <math.h>
 #include <lib/cdev/CDev.hpp>
+#include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
+#include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionMultiArray.hpp>
 
 uORBTest::UnitTest &uORBTest::UnitTest::instance()
@@ -213,7 +215,25 @@ int uORBTest::UnitTest::test()
 		return ret;
 	}
 
-	return test_queue_poll_notify();
+	ret = test_queue_poll_notify();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	ret = test_queue_loan();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	ret = test_queue_resize();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	return test_queue_resize_grow();
 }
 
 int uORBTest::UnitTest::test_unadvertise()
@@ -931,6 +951,237 @@ int uORBTest::UnitTest::test_queue()
 	return test_note("PASS orb queuing");
 }
 
+int uORBTest::UnitTest::test_queue_loan()
+{
+	test_note("Testing orb queue loans");
+
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_queue)};
+	uORB::Subscription sub{ORB_ID(orb_test_medium_queue)};
+	orb_test_medium_s u{};
+
+	if (!pub.advertise()) {
+		return test_fail("advertise failed: %d", errno);
+	}
+
+	// drain anything left from previous tests
+	while (sub.update(&u)) {}
+
+	orb_test_medium_s *msg = pub.loan();
+
+	if (msg == nullptr) {
+		return test_fail("loan failed: %d", errno);
+	}
+
+	if (pub.loan() != nullptr) {
+		return test_fail("second loan succeeded");
+	}
+
+	msg->val = 411;
+
+	if (sub.updated()) {
+		return test_fail("update flag set before commit");
+	}
+
+	orb_test_medium_s t{};
+
+	if (pub.publish(t)) {
+		return test_fail("publish succeeded while loaned");
+	}
+
+	if (!pub.commit()) {
+		return test_fail("commit failed: %d", errno);
+	}
+
+	if (pub.commit()) {
+		return test_fail("commit without loan succeeded");
+	}
+
+	if (!sub.update(&u) || (u.val != 411)) {
+		return test_fail("got wrong element after commit (got %i, should be %i)", u.val, 411);
+	}
+
+	// loans and regular publications interleave in queue order
+	t.val = 412;
+	pub.publish(t);
+
+	msg = pub.loan();
+
+	if (msg == nullptr) {
+		return test_fail("loan failed: %d", errno);
+	}
+
+	msg->val = 413;
+	pub.commit();
+
+	for (int i = 412; i <= 413; ++i) {
+		if (!sub.update(&u) || (u.val != i)) {
+			return test_fail("got wrong element from the queue (got %i, should be %i)", u.val, i);
+		}
+	}
+
+	if (sub.updated()) {
+		return test_fail("spurious updated flag");
+	}
+
+	return test_note("PASS orb queue loans");
+}
+
+int uORBTest::UnitTest::test_queue_resize()
+{
+	test_note("Testing orb queue resize");
+
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_queue)};
+	uORB::Subscription sub{ORB_ID(orb_test_medium_queue)};
+	orb_test_medium_s u{};
+
+	if (!pub.advertise()) {
+		return test_fail("advertise failed: %d", errno);
+	}
+
+	uORB::DeviceNode *node = uORB::Manager::get_instance()->get_device_master()->getDeviceNode(ORB_ID(
+					 orb_test_medium_queue), 0);
+
+	if (node == nullptr) {
+		return test_fail("node not found");
+	}
+
+	if (node->set_queue_size(3) != -EINVAL) {
+		return test_fail("non power of 2 queue size accepted");
+	}
+
+	// drain anything left from previous tests
+	while (sub.update(&u)) {}
+
+	orb_test_medium_s t{};
+
+	for (int i = 0; i < 4; ++i) {
+		t.val = 500 + i;
+		pub.publish(t);
+	}
+
+	int ret = node->set_queue_size(2);
+
+#if defined(CONFIG_ORB_SEQLOCK)
+
+	if (ret != -EBUSY) {
+		return test_fail("resize of an allocated queue with seqlock succeeded");
+	}
+
+	return test_note("SKIP orb queue resize (CONFIG_ORB_SEQLOCK)");
+#else
+
+	if (ret != PX4_OK) {
+		return test_fail("resize failed: %d", ret);
+	}
+
+	if (orb_get_queue_size(ORB_ID(orb_test_medium_queue)) != 2) {
+		return test_fail("runtime queue size not reported (%u)", orb_get_queue_size(ORB_ID(orb_test_medium_queue)));
+	}
+
+	// the two most recent messages are kept, the subscriber lost the other two
+	for (int i = 502; i < 504; ++i) {
+		if (!sub.update(&u) || (u.val != i)) {
+			return test_fail("got wrong element after resize (got %i, should be %i)", u.val, i);
+		}
+	}
+
+	if (node->max_generations_skipped() < 2) {
+		return test_fail("skipped generations not tracked (%u)", node->max_generations_skipped());
+	}
+
+	ret = node->set_queue_size(get_orb_meta(ORB_ID::orb_test_medium_queue)->o_queue);
+
+	if (ret != PX4_OK) {
+		return test_fail("restoring queue size failed: %d", ret);
+	}
+
+	t.val = 504;
+	pub.publish(t);
+
+	if (!sub.update(&u) || (u.val != 504)) {
+		return test_fail("got wrong element after restore (got %i, should be %i)", u.val, 504);
+	}
+
+	return test_note("PASS orb queue resize");
+#endif // CONFIG_ORB_SEQLOCK
+}
+
+int uORBTest::UnitTest::test_queue_resize_grow()
+{
+	test_note("Testing orb queue grow with a lagging subscriber");
+
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_queue)};
+	uORB::Subscription sub{ORB_ID(orb_test_medium_queue)};
+	orb_test_medium_s u{};
+
+	if (!pub.advertise()) {
+		return test_fail("advertise failed: %d", errno);
+	}
+
+	uORB::DeviceNode *node = uORB::Manager::get_instance()->get_device_master()->getDeviceNode(ORB_ID(
+					 orb_test_medium_queue), 0);
+
+	if (node == nullptr) {
+		return test_fail("node not found");
+	}
+
+	while (sub.update(&u)) {}
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	return test_note("SKIP orb queue grow (CONFIG_ORB_SEQLOCK)");
+#else
+	int ret = node->set_queue_size(4);
+
+	if (ret != PX4_OK) {
+		return test_fail("resize to 4 failed: %d", ret);
+	}
+
+	orb_test_medium_s t{};
+
+	// the subscriber falls 8 messages behind, only the last 4 are still in the queue
+	for (int i = 0; i < 8; ++i) {
+		t.val = 600 + i;
+		pub.publish(t);
+	}
+
+	ret = node->set_queue_size(16);
+
+	if (ret != PX4_OK) {
+		return test_fail("resize to 16 failed: %d", ret);
+	}
+
+	// the wider window must not expose the empty slots of the new buffer
+	for (int i = 604; i < 608; ++i) {
+		if (!sub.update(&u) || (u.val != i)) {
+			return test_fail("got wrong element after grow (got %i, should be %i)", u.val, i);
+		}
+	}
+
+	if (sub.update(&u)) {
+		return test_fail("spurious element after grow (%i)", u.val);
+	}
+
+	// once the grown queue has filled up, the full depth is usable again
+	for (int i = 0; i < 20; ++i) {
+		t.val = 700 + i;
+		pub.publish(t);
+	}
+
+	for (int i = 704; i < 720; ++i) {
+		if (!sub.update(&u) || (u.val != i)) {
+			return test_fail("got wrong element after refill (got %i, should be %i)", u.val, i);
+		}
+	}
+
+	ret = node->set_queue_size(get_orb_meta(ORB_ID::orb_test_medium_queue)->o_queue);
+
+	if (ret != PX4_OK) {
+		return test_fail("restoring queue size failed: %d", ret);
+	}
+
+	return test_note("PASS orb queue grow");
+#endif // CONFIG_ORB_SEQLOCK
+}
 
 int uORBTest::UnitTest::pub_test_queue_entry(int argc, char *argv[])
 {
@@ -31,8 +31,12 @@
  *
  ****************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 
+#include <px4_platform_common/getopt.h>
+
+#include "uORBTest_Stress.hpp"
 #include "uORBTest_UnitTest.hpp"
 
 extern "C" { __EXPORT int uorb_tests_main(int argc, char *argv[]); }
@@ -40,6 +44,59 @@ extern "C" { __EXPORT int uorb_tests_main(int argc, char *argv[]); }
 static void usage()
 {
 	PX4_INFO("Usage: uorb_tests [latency_test]");
+	PX4_INFO("       uorb_tests stress [-p <publishers>] [-s <subscribers>] [-r <rate Hz>] [-m small|medium|large] [-d <seconds>]");
+}
+
+static int stress_test(int argc, char *argv[])
+{
+	uORBTest::StressConfig config{};
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "p:s:r:m:d:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'p':
+			config.publishers = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 's':
+			config.subscribers = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 'r':
+			config.rate_hz = strtoul(myoptarg, nullptr, 0);
+			break;
+
+		case 'm':
+			if (!strcmp(myoptarg, "small")) {
+				config.size = uORBTest::StressConfig::MessageSize::Small;
+
+			} else if (!strcmp(myoptarg, "medium")) {
+				config.size = uORBTest::StressConfig::MessageSize::Medium;
+
+			} else if (!strcmp(myoptarg, "large")) {
+				config.size = uORBTest::StressConfig::MessageSize::Large;
+
+			} else {
+				usage();
+				return -EINVAL;
+			}
+
+			break;
+
+		case 'd':
+			config.duration_s = strtoul(myoptarg, nullptr, 0);
+			break;
+
+		default:
+			usage();
+			return -EINVAL;
+		}
+	}
+
+	return uORBTest::stress_test(config);
 }
 
 int
@@ -70,6 +127,13 @@ uorb_tests_main(int argc, char *argv[])
 		return t.latency_test(true);
 	}
 
+	/*
+	 * Load test with many publishers and subscribers.
+	 */
+	if (argc > 1 && !strcmp(argv[1], "stress")) {
+		return stress_test(argc - 1, argv + 1);
+	}
+
 	usage();
 	return -EINVAL;
 }
@@ -38,6 +38,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <poll.h>
+#include <sys/uio.h>
 #include <drivers/drv_hrt.h>
 
 #define MODULE_NAME "SerialImpl"
@@ -365,6 +366,66 @@ ssize_t SerialImpl::write(const void *buffer, size_t buffer_size)
 	return written;
 }
 
+ssize_t SerialImpl::readv(const struct iovec *iov, int iovcnt)
+{
+	if (!_open) {
+		PX4_ERR("Cannot read from serial device until it has been opened");
+		return -1;
+	}
+
+	ssize_t ret = ::readv(_serial_fd, iov, iovcnt);
+
+	if (ret < 0) {
+		if (errno == EAGAIN) {
+			return 0;
+		}
+
+		PX4_DEBUG("%s read error %d", _port, errno);
+	}
+
+	return ret;
+}
+
+ssize_t SerialImpl::writev(const struct iovec *iov, int iovcnt)
+{
+	if (!_open) {
+		PX4_ERR("Cannot write to serial device until it has been opened");
+		return -1;
+	}
+
+	ssize_t written = ::writev(_serial_fd, iov, iovcnt);
+
+	if (written < 0) {
+		if (errno != EAGAIN) {
+			PX4_ERR("%s write error %d", _port, errno);
+		}
+	}
+
+	return written;
+}
+
+int SerialImpl::waitForData(uint32_t timeout_us)
+{
+	if (!_open) {
+		PX4_ERR("Cannot wait on serial device until it has been opened");
+		return -1;
+	}
+
+	pollfd fds[1];
+	fds[0].fd = _serial_fd;
+	fds[0].events = POLLIN;
+
+	// round up, poll() only has a ms resolution
+	int ret = ::poll(fds, 1, (timeout_us + 999) / 1000);
+
+	if (ret > 0 && !(fds[0].revents & POLLIN)) {
+		PX4_ERR("Got a poll error");
+		return -1;
+	}
+
+	return ret;
+}
+
 ssize_t SerialImpl::writeBlocking(const void *buffer, size_t buffer_size, uint32_t timeout_ms)
 {
 	if (!_open) {
@@ -34,7 +34,7 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/console_buffer.h>
 #include <px4_platform_common/defines.h>
-#include <px4_platform_common/sem.h>
+#include <containers/LockFreeByteRing.hpp>
 #include <pthread.h>
 #include <string.h>
 #include <fcntl.h>
@@ -51,22 +51,19 @@ class ConsoleBuffer
 {
 public:
 
-	void write(const char *buffer, size_t len);
+	/**
+	 * Lock-free, does not block higher priority threads while another thread is writing
+	 */
+	void write(const char *buffer, size_t len) { _buffer.write(buffer, len); }
 
 	void print(bool follow);
 
-	int size();
+	int size() { return _buffer.size(); }
 
-	int read(char *buffer, int buffer_length, int *offset);
+	int read(char *buffer, int buffer_length, int *offset) { return _buffer.read(buffer, buffer_length, offset); }
 
 private:
-	void		lock() { do {} while (px4_sem_wait(&_lock) != 0); }
-	void		unlock() { px4_sem_post(&_lock); }
-
-	char _buffer[BOARD_CONSOLE_BUFFER_SIZE];
-	int _head{0};
-	int _tail{0};
-	px4_sem_t _lock = SEM_INITIALIZER(1);
+	LockFreeByteRing<BOARD_CONSOLE_BUFFER_SIZE> _buffer;
 };
 
 void ConsoleBuffer::print(bool follow)
@@ -106,85 +103,6 @@ void ConsoleBuffer::print(bool follow)
 	} while (follow);
 }
 
-void ConsoleBuffer::write(const char *buffer, size_t len)
-{
-	lock(); // same rule as for printf: this cannot be used from IRQ handlers
-
-	for (size_t i = 0; i < len; ++i) {
-		_buffer[_tail] = buffer[i];
-		_tail = (_tail + 1) % BOARD_CONSOLE_BUFFER_SIZE;
-
-		if (_tail == _head) {
-			_head = (_head + 1) % BOARD_CONSOLE_BUFFER_SIZE;
-		}
-	}
-
-	unlock();
-}
-
-int ConsoleBuffer::size()
-{
-	lock();
-	int size;
-
-	if (_head <= _tail) {
-		size = _tail - _head;
-
-	} else {
-		size = BOARD_CONSOLE_BUFFER_SIZE - (_head - _tail);
-	}
-
-	unlock();
-	return size;
-}
-
-int ConsoleBuffer::read(char *buffer, int buffer_length, int *offset)
-{
-	lock();
-
-	if (*offset == -1) {
-		*offset = _head;
-	}
-
-	int size = 0;
-
-	if (*offset < _tail) {
-		size = _tail - *offset;
-
-		if (size > buffer_length) {
-			size = buffer_length;
-		}
-
-		memcpy(buffer, _buffer + *offset, size);
-
-	} else if (_tail < *offset) {
-		size = BOARD_CONSOLE_BUFFER_SIZE - *offset;
-
-		if (size > buffer_length) {
-			size = buffer_length;
-		}
-
-		memcpy(buffer, _buffer + *offset, size);
-		buffer += size;
-		buffer_length -= size;
-
-		int size_secondary = _tail;
-
-		if (size_secondary > buffer_length) {
-			size_secondary = buffer_length;
-		}
-
-		if (size_secondary > 0) {
-			memcpy(buffer, _buffer, size_secondary);
-			size += size_secondary;
-		}
-	}
-
-	unlock();
-	*offset = (*offset + size) % BOARD_CONSOLE_BUFFER_SIZE;
-	return size;
-}
-
 static ConsoleBuffer g_console_buffer;
 
 
@@ -51,6 +51,12 @@ __BEGIN_DECLS
 
 __EXPORT struct system_load_s system_load;
 
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+#  include <dwt.h>
+#  include <nvic.h>
+#  define CPULOAD_DWT_CYCCNT (*(volatile uint32_t *)(DWT_CYCCNT))
+#endif
+
 #if defined(CONFIG_SEGGER_SYSVIEW)
 #  include <nuttx/note/note_sysview.h>
 #  ifndef CONFIG_SEGGER_SYSVIEW_PREFIX
@@ -60,6 +66,31 @@ __EXPORT struct system_load_s system_load;
 
 static px4::atomic_int cpuload_monitor_all_count{0};
 
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+/**
+ * Add the cycles from start to now to runtime [us], carrying the fraction of a us over to the next slot
+ */
+static inline void cpuload_account_cycles(uint64_t &runtime, uint32_t &remainder_cycles, uint32_t start, uint32_t now)
+{
+	const uint32_t cycles = remainder_cycles + (now - start);
+	runtime += cycles / system_load.cycles_per_us;
+	remainder_cycles = cycles % system_load.cycles_per_us;
+}
+
+static inline void cpuload_account_task(system_load_taskinfo_s &task, uint32_t now)
+{
+#if defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+
+	if (system_load.irq_nesting > 0) {
+		// switching tasks from an interrupt handler: the task was already accounted at the interrupt entry
+		return;
+	}
+
+#endif
+	cpuload_account_cycles(task.total_runtime, task.remainder_cycles, task.curr_start_cycles, now);
+}
+#endif
+
 void cpuload_monitor_start()
 {
 	if (cpuload_monitor_all_count.fetch_add(1) == 0) {
@@ -71,8 +102,19 @@ void cpuload_monitor_start()
 		for (int i = 1; i < CONFIG_FS_PROCFS_MAX_TASKS; i++) {
 			system_load.tasks[i].total_runtime = 0;
 			system_load.tasks[i].curr_start_time = 0;
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+			system_load.tasks[i].remainder_cycles = 0;
+#endif
 		}
 
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+
+		// the calling task is accounted from its next scheduling slot on
+		if (system_load.running_index > 0) {
+			system_load.running_index = -1;
+		}
+
+#endif
 		sched_unlock();
 	}
 }
@@ -112,6 +154,26 @@ void cpuload_initialize_once()
 		system_load.tasks[system_load.total_count].valid = true;
 	}
 
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+	// enable the DWT cycle counter and measure its rate against the HRT
+	*(volatile uint32_t *)(NVIC_DEMCR) |= NVIC_DEMCR_TRCENA;
+	*(volatile uint32_t *)(DWT_CTRL) |= DWT_CTRL_CYCCNTENA_MASK;
+
+	const hrt_abstime calibration_start = hrt_absolute_time();
+	const uint32_t calibration_start_cycles = CPULOAD_DWT_CYCCNT;
+
+	while (hrt_elapsed_time(&calibration_start) < 1000) {}
+
+	const uint32_t calibration_cycles = CPULOAD_DWT_CYCCNT - calibration_start_cycles;
+	const uint32_t calibration_us = hrt_elapsed_time(&calibration_start);
+
+	system_load.cycles_per_us = (calibration_cycles + calibration_us / 2) / calibration_us;
+
+	if (system_load.cycles_per_us == 0) {
+		system_load.cycles_per_us = 1;
+	}
+
+#endif
 	system_load.initialized = true;
 }
 
@@ -142,6 +204,13 @@ void sched_note_stop(FAR struct tcb_s *tcb)
 	if (system_load.initialized) {
 		for (auto &task : system_load.tasks) {
 			if (task.tcb && task.tcb->pid == tcb->pid) {
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+
+				if (system_load.running_index == &task - system_load.tasks) {
+					system_load.running_index = -1;
+				}
+
+#endif
 				// mark slot as free
 				task.valid = false;
 				task.total_runtime = 0;
@@ -161,8 +230,17 @@ void sched_note_stop(FAR struct tcb_s *tcb)
 void sched_note_suspend(FAR struct tcb_s *tcb)
 {
 	if (system_load.initialized) {
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+		const uint32_t now_cycles = CPULOAD_DWT_CYCCNT;
+		system_load.running_index = -1;
+#endif
+
 		if (tcb->pid == 0) {
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+			cpuload_account_task(system_load.tasks[0], now_cycles);
+#else
 			system_load.tasks[0].total_runtime += hrt_elapsed_time(&system_load.tasks[0].curr_start_time);
+#endif
 			return;
 
 		} else {
@@ -176,7 +254,11 @@ void sched_note_suspend(FAR struct tcb_s *tcb)
 			if (task.valid && (task.curr_start_time > 0)
 			    && task.tcb && task.tcb->pid == tcb->pid) {
 
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+				cpuload_account_task(task, now_cycles);
+#else
 				task.total_runtime += hrt_elapsed_time(&task.curr_start_time);
+#endif
 				break;
 			}
 		}
@@ -190,8 +272,16 @@ void sched_note_suspend(FAR struct tcb_s *tcb)
 void sched_note_resume(FAR struct tcb_s *tcb)
 {
 	if (system_load.initialized) {
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+		const uint32_t now_cycles = CPULOAD_DWT_CYCCNT;
+#endif
+
 		if (tcb->pid == 0) {
 			hrt_store_absolute_time(&system_load.tasks[0].curr_start_time);
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+			system_load.tasks[0].curr_start_cycles = now_cycles;
+			system_load.running_index = 0;
+#endif
 			return;
 
 		} else {
@@ -205,6 +295,10 @@ void sched_note_resume(FAR struct tcb_s *tcb)
 				// curr_start_time is accessed from an IRQ handler (in logger), so we need
 				// to make the update atomic
 				hrt_store_absolute_time(&task.curr_start_time);
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+				task.curr_start_cycles = now_cycles;
+				system_load.running_index = static_cast<int>(&task - system_load.tasks);
+#endif
 				break;
 			}
 		}
@@ -215,15 +309,46 @@ void sched_note_resume(FAR struct tcb_s *tcb)
 #endif
 }
 
-#ifdef CONFIG_SEGGER_SYSVIEW
-
 #ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
 void sched_note_irqhandler(int irq, FAR void *handler, bool enter)
 {
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+
+	if (system_load.initialized) {
+		const uint32_t now_cycles = CPULOAD_DWT_CYCCNT;
+		const int running_index = system_load.running_index;
+
+		if (enter) {
+			if (system_load.irq_nesting++ == 0) {
+				// stop the slot of the interrupted task, nested handlers count to the outermost one
+				if (running_index >= 0) {
+					system_load_taskinfo_s &task = system_load.tasks[running_index];
+					cpuload_account_cycles(task.total_runtime, task.remainder_cycles, task.curr_start_cycles, now_cycles);
+				}
+
+				system_load.irq_start_cycles = now_cycles;
+			}
+
+		} else if ((system_load.irq_nesting > 0) && (--system_load.irq_nesting == 0)) {
+			cpuload_account_cycles(system_load.irq_runtime, system_load.irq_remainder_cycles, system_load.irq_start_cycles,
+					       now_cycles);
+
+			// continue the slot of the running task, which might have been switched by the handler
+			if (running_index >= 0) {
+				system_load.tasks[running_index].curr_start_cycles = now_cycles;
+			}
+		}
+	}
+
+#endif
+#ifdef CONFIG_SEGGER_SYSVIEW
 	sysview_sched_note_irqhandler(irq, handler, enter);
+#endif
 }
 #endif
 
+#ifdef CONFIG_SEGGER_SYSVIEW
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SYSCALL
 void sched_note_syscall_enter(int nr);
 {
@@ -50,6 +50,10 @@ struct system_load_taskinfo_s {
 	uint64_t curr_start_time{0};		///< Start time of the current scheduling slot
 	struct tcb_s *tcb {nullptr};
 	bool valid{false};			///< Task is currently active / valid
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+	uint32_t curr_start_cycles{0};		///< Cycle counter at the start of the current scheduling slot
+	uint32_t remainder_cycles{0};		///< Cycles not yet accounted in total_runtime (less than 1 us)
+#endif
 };
 
 struct system_load_s {
@@ -58,6 +62,16 @@ struct system_load_s {
 	int total_count{0};
 	int running_count{0};
 	bool initialized{false};
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER)
+	uint32_t cycles_per_us{0};		///< Cycle counter rate, measured at initialization
+	int running_index{-1};			///< Index into tasks of the running task, -1 if not monitored
+# if defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+	uint64_t irq_runtime{0};		///< Runtime of interrupt handlers since boot [us]
+	uint32_t irq_start_cycles{0};		///< Cycle counter at the entry of the outermost interrupt handler
+	uint32_t irq_remainder_cycles{0};
+	int irq_nesting{0};
+# endif
+#endif
 };
 
 __BEGIN_DECLS
@@ -65,6 +65,21 @@ extern struct system_load_s system_load;
 
 #define CL "\033[K" // clear line
 
+#if defined(CONFIG_CPULOAD_CYCLE_COUNTER) && defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+#  define PRINT_LOAD_IRQ_TIME
+#endif
+
+#if defined(PRINT_LOAD_IRQ_TIME)
+static uint64_t irq_runtime()
+{
+	// updated from the interrupt handlers
+	const irqstate_t flags = px4_enter_critical_section();
+	const uint64_t runtime = system_load.irq_runtime;
+	px4_leave_critical_section(flags);
+	return runtime;
+}
+#endif
+
 void init_print_load(struct print_load_s *s)
 {
 	cpuload_monitor_start();
@@ -82,6 +97,10 @@ void init_print_load(struct print_load_s *s)
 	s->last_times[0] = system_load.tasks[0].total_runtime;
 	sched_unlock();
 
+#if defined(PRINT_LOAD_IRQ_TIME)
+	s->last_irq_time = irq_runtime();
+#endif
+
 	for (int i = 1; i < CONFIG_FS_PROCFS_MAX_TASKS; i++) {
 		s->last_times[i] = 0;
 	}
@@ -156,6 +175,10 @@ void print_load_buffer(char *buffer, int buffer_length, print_load_callback_f cb
 
 	sched_unlock();
 
+#if defined(PRINT_LOAD_IRQ_TIME)
+	const uint64_t total_irq_runtime = irq_runtime();
+#endif
+
 	if (print_state->new_time > print_state->interval_start_time) {
 		print_state->interval_time_us = print_state->new_time - print_state->interval_start_time;
 
@@ -325,23 +348,38 @@ void print_load_buffer(char *buffer, int buffer_length, print_load_callback_f cb
 
 	float task_load = (float)(print_state->total_user_time) / print_state->interval_time_us;
 
+#if defined(PRINT_LOAD_IRQ_TIME)
+	const float irq_load = (float)(total_irq_runtime - print_state->last_irq_time) / print_state->interval_time_us;
+	print_state->last_irq_time = total_irq_runtime;
+#else
+	const float irq_load = 0.f;
+#endif
+
 	/* this can happen if one tasks total runtime was not computed
 	   correctly by the scheduler instrumentation TODO */
-	if (task_load > (1.f - idle_load)) {
-		task_load = (1.f - idle_load);
+	if (task_load > (1.f - idle_load - irq_load)) {
+		task_load = (1.f - idle_load - irq_load);
 	}
 
-	const float sched_load = 1.f - idle_load - task_load;
+	const float sched_load = 1.f - idle_load - task_load - irq_load;
 
 	snprintf(buffer, buffer_length, "Processes: %d total, %d running, %d sleeping",
 		 system_load.total_count,
 		 print_state->running_count,
 		 print_state->blocked_count);
 	cb(user);
+#if defined(PRINT_LOAD_IRQ_TIME)
+	snprintf(buffer, buffer_length, "CPU usage: %.2f%% tasks, %.2f%% irq, %.2f%% sched, %.2f%% idle",
+		 (double)(task_load * 100.f),
+		 (double)(irq_load * 100.f),
+		 (double)(sched_load * 100.f),
+		 (double)(idle_load * 100.f));
+#else
 	snprintf(buffer, buffer_length, "CPU usage: %.2f%% tasks, %.2f%% sched, %.2f%% idle",
 		 (double)(task_load * 100.f),
 		 (double)(sched_load * 100.f),
 		 (double)(idle_load * 100.f));
+#endif
 	cb(user);
 #if defined(BOARD_DMA_ALLOC_POOL_SIZE)
 	uint16_t dma_total;
@@ -50,7 +50,6 @@
 #include <queue.h>
 #include <errno.h>
 #include <string.h>
-#include <syslog.h>
 
 #include <board_config.h>
 #include <drivers/drv_hrt.h>
@@ -78,12 +77,25 @@
 # error HRT_TIMER must be 0 for SAMV7 (TC0 Channel 0)
 #endif
 
-/* Minimum/maximum deadlines */
+/* Timer frequency - MCK/32 prescaler (TC_CMR_TCCLKS_MCK32), 4.6875 MHz with MCK = 150 MHz */
+#define HRT_ACTUAL_FREQ		(HRT_TIMER_CLOCK / 32)
+
+/*
+ * The counter counts up to RC and restarts from 0, RC is set to the full 16 bit range.
+ * This gives a period of ~14 ms, which must not be exceeded between two reads of the
+ * counter: the compare interrupt is scheduled at least every HRT_INTERVAL_MAX, and the
+ * RC compare (wrap) interrupt is enabled as well in case a compare was missed.
+ */
+#define HRT_COUNTER_PERIOD	0x10000
+#define HRT_COUNTER_MASK	(HRT_COUNTER_PERIOD - 1)
+
+/* Minimum/maximum deadlines (microseconds) */
 #define HRT_INTERVAL_MIN	50
-#define HRT_INTERVAL_MAX	50000
+#define HRT_INTERVAL_MAX	10000
 
-/* Actual timer frequency - MCK/32 prescaler (TC_CMR_TCCLKS_MCK32) */
-#define HRT_ACTUAL_FREQ		(HRT_TIMER_CLOCK / 32)
+#if (HRT_INTERVAL_MAX * (HRT_ACTUAL_FREQ / 1000)) / 1000 >= HRT_COUNTER_PERIOD
+# error HRT_INTERVAL_MAX exceeds the counter period
+#endif
 
 /* Timer register addresses for TC0 Channel 0 */
 #define rCCR	(HRT_TIMER_BASE + SAM_TC_CCR_OFFSET)
@@ -101,282 +113,404 @@
 #define TC_CCR_CLKDIS		(1 << 1)
 #define TC_CCR_SWTRG		(1 << 2)
 
-/* TC register definitions - use NuttX hardware definitions */
-/* NuttX provides these in hardware/sam_tc.h */
-
-/* Forward declarations */
-static int hrt_tim_isr(int irq, void *context, void *arg);
-
-/* Callout list */
-static struct sq_queue_s callout_queue;
+/*
+ * Queue of callout entries.
+ */
+static struct sq_queue_s	callout_queue;
 
-/* Latency histogram */
-#define LATENCY_BUCKET_COUNT 8
-__EXPORT const uint16_t latency_buckets[LATENCY_BUCKET_COUNT] = { 1, 2, 5, 10, 20, 50, 100, 1000 };
-__EXPORT uint32_t latency_actual_min = UINT32_MAX;
-__EXPORT uint32_t latency_actual_max = 0;
+/* timer ticks to microseconds: usec = ticks * hrt_usec_num / hrt_usec_den (reduced fraction) */
+static uint32_t			hrt_usec_num;
+static uint32_t			hrt_usec_den;
 
-/* HRT clock counter */
-static uint64_t hrt_absolute_time_base;
-static uint32_t hrt_counter_wrap_count;
+#define HRT_COUNTER_SCALE(_c)	(((_c) * hrt_usec_num) / hrt_usec_den)
 
-/**
- * Get absolute time
- */
-hrt_abstime hrt_absolute_time(void)
-{
-	uint64_t base;
-	uint32_t count;
-	irqstate_t flags;
+/* latency baseline (last compare value applied) */
+static uint16_t			latency_baseline;
 
-	flags = enter_critical_section();
+/* timer count at interrupt (for latency purposes) */
+static uint16_t			latency_actual;
 
-	/* Atomic read of base and counter */
-	base = hrt_absolute_time_base;
-	count = getreg32(rCV);
+/* latency histogram */
+const uint16_t latency_bucket_count = LATENCY_BUCKET_COUNT;
+const uint16_t latency_buckets[LATENCY_BUCKET_COUNT] = { 1, 2, 5, 10, 20, 50, 100, 1000 };
+__EXPORT uint32_t latency_counters[LATENCY_BUCKET_COUNT + 1];
 
-	leave_critical_section(flags);
+/* timer-specific functions */
+static void		hrt_tim_init(void);
+static int		hrt_tim_isr(int irq, void *context, void *arg);
+static void		hrt_latency_update(void);
 
-	/* Convert ticks to microseconds */
-	uint64_t total_ticks = base + count;
-	return (total_ticks * 1000000ULL) / HRT_ACTUAL_FREQ;
-}
+/* callout list manipulation */
+static void		hrt_call_internal(struct hrt_call *entry,
+		hrt_abstime deadline,
+		hrt_abstime interval,
+		hrt_callout callout,
+		void *arg);
+static void		hrt_call_enter(struct hrt_call *entry);
+static void		hrt_call_reschedule(void);
+static void		hrt_call_invoke(void);
 
 /**
- * Initialize the HRT
+ * Initialise the timer we are going to use.
  */
-void hrt_init(void)
+static void hrt_tim_init(void)
 {
-	syslog(LOG_ERR, "[hrt] hrt_init starting\n");
-	sq_init(&callout_queue);
+	/* reduce ticks -> microseconds to the smallest fraction, e.g. 16/75 for 4.6875 MHz */
+	uint32_t a = 1000000;
+	uint32_t b = HRT_ACTUAL_FREQ;
+
+	while (b != 0) {
+		const uint32_t t = a % b;
+		a = b;
+		b = t;
+	}
+
+	hrt_usec_num = 1000000 / a;
+	hrt_usec_den = HRT_ACTUAL_FREQ / a;
 
-	/* Enable peripheral clock for TC0 */
-	uint32_t regval = getreg32(SAM_PMC_PCER0);
-	syslog(LOG_ERR, "[hrt] SAM_PMC_PCER0 before: 0x%08lx\n", (unsigned long)regval);
-	regval |= HRT_TIMER_PCER;
-	putreg32(regval, SAM_PMC_PCER0);
-	syslog(LOG_ERR, "[hrt] SAM_PMC_PCER0 after: 0x%08lx\n", (unsigned long)getreg32(SAM_PMC_PCER0));
+	/* enable the peripheral clock for TC0 */
+	putreg32(getreg32(SAM_PMC_PCER0) | HRT_TIMER_PCER, SAM_PMC_PCER0);
 
-	/* Disable TC clock */
+	/* disable the clock while configuring */
 	putreg32(TC_CCR_CLKDIS, rCCR);
 
-	/* Configure TC channel mode:
-	 * - Waveform mode
-	 * - Up mode with automatic reset on RC compare
-	 * - Use MCK/8 prescaler (for ~150MHz MCK gives ~19MHz)
-	 */
-	uint32_t cmr = TC_CMR_WAVE | TC_CMR_WAVSEL_UP;
+	/* waveform mode, count up to RC and restart, MCK/32 */
+	putreg32(TC_CMR_WAVE | TC_CMR_WAVSEL_UPRC | TC_CMR_TCCLKS_MCK32, rCMR);
 
-	/* Select prescaler to get as close to 1MHz as possible */
-	if (HRT_TIMER_CLOCK / 8 > 1000000) {
-		cmr |= TC_CMR_TCCLKS_MCK32;  /* MCK/32 */
-		syslog(LOG_ERR, "[hrt] Using MCK/32 prescaler\n");
-	} else {
-		cmr |= TC_CMR_TCCLKS_MCK8;   /* MCK/8 */
-		syslog(LOG_ERR, "[hrt] Using MCK/8 prescaler\n");
-	}
+	/* free-running over the full 16 bit range */
+	putreg32(HRT_COUNTER_MASK, rRC);
 
-	putreg32(cmr, rCMR);
+	/* set an initial compare a little ways off */
+	putreg32(1000, rRA);
 
-	/* Set RC to maximum value for free-running mode */
-	putreg32(0xFFFFFFFF, rRC);
+	/* disable all interrupts and clear the status */
+	putreg32(0xffffffff, rIDR);
+	(void)getreg32(rSR);
 
-	/* Disable all interrupts */
-	putreg32(0xFFFFFFFF, rIDR);
+	/* claim our interrupt vector */
+	irq_attach(HRT_TIMER_VECTOR, hrt_tim_isr, NULL);
 
-	/* Clear status */
-	(void)getreg32(rSR);
+	/* compare (RA) for the callouts, RC compare (wrap) for the time base */
+	putreg32(TC_INT_CPAS | TC_INT_CPCS, rIER);
 
-	/* Enable TC clock and trigger */
+	/* enable and reset the counter */
 	putreg32(TC_CCR_CLKEN | TC_CCR_SWTRG, rCCR);
 
-	/* Initialize absolute time base */
-	hrt_absolute_time_base = 0;
-	hrt_counter_wrap_count = 0;
+	/* enable interrupts */
+	up_enable_irq(HRT_TIMER_VECTOR);
+}
 
-	/* Attach interrupt handler */
-	irq_attach(HRT_TIMER_VECTOR, hrt_tim_isr, NULL);
+/**
+ * Handle the compare interrupt by calling the callout dispatcher
+ * and then re-scheduling the next deadline.
+ */
+static int hrt_tim_isr(int irq, void *context, void *arg)
+{
+	/* grab the timer for latency tracking purposes */
+	latency_actual = getreg32(rCV) & HRT_COUNTER_MASK;
 
-	/* Enable overflow interrupt (RC compare for wraparound) */
-	putreg32(TC_INT_CPCS, rIER);
+	/* reading the status clears it */
+	const uint32_t status = getreg32(rSR);
 
-	/* Enable interrupt at NVIC level */
-	up_enable_irq(HRT_TIMER_VECTOR);
+	/* was this a compare or a wrap of the counter? */
+	if (status & (TC_INT_CPAS | TC_INT_CPCS)) {
 
-	syslog(LOG_ERR, "[hrt] HRT initialized with interrupts, testing...\n");
+		if (status & TC_INT_CPAS) {
+			/* do latency calculations */
+			hrt_latency_update();
+		}
 
-	/* Test that timer is running */
-	uint32_t cv1 = getreg32(rCV);
-	for (volatile int i = 0; i < 100000; i++);
-	uint32_t cv2 = getreg32(rCV);
-	syslog(LOG_ERR, "[hrt] Counter test: CV1=0x%08lx CV2=0x%08lx diff=%lu\n",
-		(unsigned long)cv1, (unsigned long)cv2, (unsigned long)(cv2 - cv1));
+		/* run any callouts that have met their deadline */
+		hrt_call_invoke();
+
+		/* and schedule the next interrupt */
+		hrt_call_reschedule();
+	}
 
-	hrtinfo("HRT initialized\n");
+	return OK;
 }
 
 /**
- * Call callout entries
+ * Fetch a never-wrapping absolute time value in microseconds from
+ * some arbitrary epoch shortly after system start.
  */
-static void hrt_call_invoke(void)
+hrt_abstime hrt_absolute_time(void)
 {
-	struct hrt_call *call;
-	hrt_abstime deadline __attribute__((unused));
+	hrt_abstime	abstime;
+	uint32_t	count;
+	irqstate_t	flags;
+
+	/*
+	 * Counter state.  Marked volatile as they may change
+	 * inside this routine but outside the irqsave/restore
+	 * pair.  Discourage the compiler from moving loads/stores
+	 * to these outside of the protected range.
+	 */
+	static volatile uint64_t base_ticks;
+	static volatile uint32_t last_count;
 
-	/* Read time once at start to avoid critical section issues */
-	uint32_t now_cv = getreg32(rCV);
-	uint64_t base = hrt_absolute_time_base;
-	uint64_t now_ticks = base + now_cv;
-	hrt_abstime now = (now_ticks * 1000000ULL) / HRT_ACTUAL_FREQ;
+	/* prevent re-entry */
+	flags = px4_enter_critical_section();
 
-	int max_iterations = 16;  /* Prevent infinite loops */
+	/* get the current counter value */
+	count = getreg32(rCV) & HRT_COUNTER_MASK;
 
-	while (max_iterations-- > 0) {
-		call = (struct hrt_call *)sq_peek(&callout_queue);
+	/*
+	 * Determine whether the counter has wrapped since the
+	 * last time we're called.
+	 *
+	 * This simple test is sufficient due to the guarantee that
+	 * we are always called at least once per counter period.
+	 */
+	if (count < last_count) {
+		base_ticks += HRT_COUNTER_PERIOD;
+	}
 
-		if (call == NULL) {
-			break;
-		}
+	/* save the count for next time */
+	last_count = count;
 
-		if (call->deadline > now) {
-			break;
-		}
+	/* compute the current time */
+	abstime = HRT_COUNTER_SCALE(base_ticks + count);
 
-		sq_rem(&call->link, &callout_queue);
-		call->deadline = 0;
+	px4_leave_critical_section(flags);
 
-		/* Invoke callback */
-		if (call->callout) {
-			call->callout(call->arg);
-		}
-	}
+	return abstime;
 }
 
 /**
- * Reschedule next alarm
- * NOTE: Called from within critical section, so don't call hrt_absolute_time()
+ * Store the absolute time in an interrupt-safe fashion
  */
-static void hrt_call_reschedule(void)
+void hrt_store_absolute_time(volatile hrt_abstime *t)
 {
-	/* Read counter directly - already in critical section from caller */
-	uint32_t now_cv = getreg32(rCV);
-	uint64_t base = hrt_absolute_time_base;
-	uint64_t now_ticks = base + now_cv;
-	hrt_abstime now_usec = (now_ticks * 1000000ULL) / HRT_ACTUAL_FREQ;
+	irqstate_t flags = px4_enter_critical_section();
+	*t = hrt_absolute_time();
+	px4_leave_critical_section(flags);
+}
 
-	struct hrt_call *next = (struct hrt_call *)sq_peek(&callout_queue);
+/**
+ * Initialise the high-resolution timing module.
+ */
+void hrt_init(void)
+{
+	sq_init(&callout_queue);
+	hrt_tim_init();
+}
 
-	if (next != NULL) {
-		hrt_abstime deadline = next->deadline;
+/**
+ * Call callout(arg) after interval has elapsed.
+ */
+void hrt_call_after(struct hrt_call *entry, hrt_abstime delay, hrt_callout callout, void *arg)
+{
+	hrt_call_internal(entry, hrt_absolute_time() + delay, 0, callout, arg);
+}
 
-		if (deadline < now_usec) {
-			deadline = now_usec + HRT_INTERVAL_MIN;
-		}
-	}
+/**
+ * Call callout(arg) at calltime.
+ */
+void hrt_call_at(struct hrt_call *entry, hrt_abstime calltime, hrt_callout callout, void *arg)
+{
+	hrt_call_internal(entry, calltime, 0, callout, arg);
 }
 
 /**
- * HRT interrupt handler
+ * Call callout(arg) every period.
  */
-static int hrt_tim_isr(int irq, void *context, void *arg)
+void hrt_call_every(struct hrt_call *entry, hrt_abstime delay, hrt_abstime interval, hrt_callout callout, void *arg)
 {
-	uint32_t status;
+	hrt_call_internal(entry, hrt_absolute_time() + delay, interval, callout, arg);
+}
 
-	/* Read and clear status */
-	status = getreg32(rSR);
+static void hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime interval, hrt_callout callout,
+			      void *arg)
+{
+	irqstate_t flags = px4_enter_critical_section();
 
-	/* Handle counter overflow/wrap */
-	if (status & TC_INT_CPCS) {
-		hrt_counter_wrap_count++;
+	/* if the entry is currently queued, remove it */
+	if (entry->deadline != 0) {
+		sq_rem(&entry->link, &callout_queue);
 	}
 
-	/* Process callouts */
-	hrt_call_invoke();
+	entry->deadline = deadline;
+	entry->period = interval;
+	entry->callout = callout;
+	entry->arg = arg;
 
-	/* Reschedule next interrupt */
-	hrt_call_reschedule();
+	hrt_call_enter(entry);
 
-	return OK;
+	px4_leave_critical_section(flags);
 }
 
 /**
- * Call callout function at specified time
+ * If this returns true, the call has been invoked and removed from the callout list.
+ *
+ * Always returns false for repeating callouts.
  */
-void hrt_call_at(struct hrt_call *entry, hrt_abstime calltime, hrt_callout callout, void *arg)
+bool hrt_called(struct hrt_call *entry)
 {
-	if (entry == NULL || callout == NULL) {
-		return;
-	}
+	return (entry->deadline == 0);
+}
 
-	irqstate_t flags = enter_critical_section();
+/**
+ * Remove the entry from the callout list.
+ */
+void hrt_cancel(struct hrt_call *entry)
+{
+	irqstate_t flags = px4_enter_critical_section();
 
-	/* Remove from queue if already scheduled */
 	sq_rem(&entry->link, &callout_queue);
+	entry->deadline = 0;
 
-	entry->deadline = calltime;
-	entry->callout = callout;
-	entry->arg = arg;
+	/* if this is a periodic call being removed by the callout, prevent it from
+	 * being re-entered when the callout returns.
+	 */
+	entry->period = 0;
 
-	/* Insert into queue in deadline order */
-	struct hrt_call *call;
-	struct hrt_call *prev = NULL;
+	px4_leave_critical_section(flags);
+}
 
-	for (call = (struct hrt_call *)sq_peek(&callout_queue); call != NULL;
-	     call = (struct hrt_call *)sq_next(&call->link)) {
-		if (call->deadline > calltime) {
-			break;
-		}
+static void hrt_call_enter(struct hrt_call *entry)
+{
+	struct hrt_call	*call, *next;
 
-		prev = call;
-	}
+	call = (struct hrt_call *)sq_peek(&callout_queue);
 
-	if (prev == NULL) {
+	if ((call == NULL) || (entry->deadline < call->deadline)) {
 		sq_addfirst(&entry->link, &callout_queue);
+		hrtinfo("call enter at head, reschedule\n");
+		/* we changed the next deadline, reschedule the timer event */
+		hrt_call_reschedule();
 
 	} else {
-		sq_addafter(&prev->link, &entry->link, &callout_queue);
+		do {
+			next = (struct hrt_call *)sq_next(&call->link);
+
+			if ((next == NULL) || (entry->deadline < next->deadline)) {
+				hrtinfo("call enter after head\n");
+				sq_addafter(&call->link, &entry->link, &callout_queue);
+				break;
+			}
+		} while ((call = next) != NULL);
 	}
 
-	hrt_call_reschedule();
-
-	leave_critical_section(flags);
+	hrtinfo("scheduled\n");
 }
 
-/**
- * Call callout function after delay
- */
-void hrt_call_after(struct hrt_call *entry, hrt_abstime delay, hrt_callout callout, void *arg)
+static void hrt_call_invoke(void)
 {
-	hrt_call_at(entry, hrt_absolute_time() + delay, callout, arg);
+	struct hrt_call	*call;
+	hrt_abstime deadline;
+
+	while (true) {
+		/* get the current time */
+		hrt_abstime now = hrt_absolute_time();
+
+		call = (struct hrt_call *)sq_peek(&callout_queue);
+
+		if (call == NULL) {
+			break;
+		}
+
+		if (call->deadline > now) {
+			break;
+		}
+
+		sq_rem(&call->link, &callout_queue);
+		hrtinfo("call pop\n");
+
+		/* save the intended deadline for periodic calls */
+		deadline = call->deadline;
+
+		/* zero the deadline, as the call has occurred */
+		call->deadline = 0;
+
+		/* invoke the callout (if there is one) */
+		if (call->callout) {
+			hrtinfo("call %p: %p(%p)\n", call, call->callout, call->arg);
+			call->callout(call->arg);
+		}
+
+		/* if the callout has a non-zero period, it has to be re-entered */
+		if (call->period != 0) {
+			// re-check call->deadline to allow for
+			// callouts to re-schedule themselves
+			// using hrt_call_delay()
+			if (call->deadline <= now) {
+				call->deadline = deadline + call->period;
+			}
+
+			hrt_call_enter(call);
+		}
+	}
 }
 
 /**
- * Call callout function at periodic intervals
+ * Reschedule the next timer interrupt.
+ *
+ * This routine must be called with interrupts disabled.
  */
-void hrt_call_every(struct hrt_call *entry, hrt_abstime delay, hrt_abstime interval, hrt_callout callout, void *arg)
+static void hrt_call_reschedule(void)
 {
-	entry->period = interval;
-	hrt_call_after(entry, delay, callout, arg);
+	hrt_abstime	now = hrt_absolute_time();
+	hrt_abstime	delay = HRT_INTERVAL_MAX;
+	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
+
+	/*
+	 * Determine what the next deadline will be.
+	 *
+	 * Note that we ensure that this will be within the counter
+	 * period, so that when we truncate to the counter range
+	 * the next time the compare matches it will be the deadline
+	 * we want.
+	 */
+	if (next != NULL) {
+		if (next->deadline <= (now + HRT_INTERVAL_MIN)) {
+			hrtinfo("pre-expired\n");
+			/* set a minimal deadline so that we call ASAP */
+			delay = HRT_INTERVAL_MIN;
+
+		} else if (next->deadline < now + delay) {
+			hrtinfo("due soon\n");
+			delay = next->deadline - now;
+		}
+	}
+
+	/* the compare is relative to the counter, round up so that we never fire early */
+	const uint32_t delay_ticks = (delay * hrt_usec_den + hrt_usec_num - 1) / hrt_usec_num;
+	const uint32_t compare = ((getreg32(rCV) & HRT_COUNTER_MASK) + delay_ticks) & HRT_COUNTER_MASK;
+
+	hrtinfo("schedule in %u us\n", (unsigned)delay);
+
+	/* set the new compare value and remember it for latency tracking */
+	putreg32(compare, rRA);
+	latency_baseline = compare;
 }
 
-/**
- * Cancel a callout
- */
-void hrt_cancel(struct hrt_call *entry)
+static void hrt_latency_update(void)
 {
-	irqstate_t flags = enter_critical_section();
+	const uint16_t latency_ticks = (latency_actual - latency_baseline) & HRT_COUNTER_MASK;
+	const uint32_t latency = HRT_COUNTER_SCALE((uint32_t)latency_ticks);
+	unsigned	index;
+
+	/* bounded buckets */
+	for (index = 0; index < LATENCY_BUCKET_COUNT; index++) {
+		if (latency <= latency_buckets[index]) {
+			latency_counters[index]++;
+			return;
+		}
+	}
 
-	sq_rem(&entry->link, &callout_queue);
-	entry->deadline = 0;
-	entry->period = 0;
+	/* catch-all at the end */
+	latency_counters[index]++;
+}
 
-	leave_critical_section(flags);
+void hrt_call_init(struct hrt_call *entry)
+{
+	memset(entry, 0, sizeof(*entry));
 }
 
-/* CPU load monitoring support function */
-void hrt_store_absolute_time(volatile hrt_abstime *t)
+void hrt_call_delay(struct hrt_call *entry, hrt_abstime delay)
 {
-	*t = hrt_absolute_time();
+	entry->deadline = hrt_absolute_time() + delay;
 }
 
 #endif /* HRT_TIMER */
@@ -58,6 +58,13 @@ public:
 	virtual int	read(unsigned offset, void *data, unsigned count = 1);
 	virtual int	write(unsigned address, void *data, unsigned count = 1);
 
+	/**
+	 * Write registers and read the registers returned in the reply (see PX4IO_PAGE_CYCLE)
+	 * in a single transaction.
+	 * @return reply_count on success
+	 */
+	int		exchange(unsigned address, const void *data, unsigned count, void *reply, unsigned reply_count);
+
 protected:
 	/**
 	 * Does the PX4IO_serial instance initialization.
@@ -96,12 +96,16 @@ static uint8_t output_channel_from_timer_channel(uint8_t timer_index, uint8_t ti
 static void dma_burst_finished_callback(DMA_HANDLE handle, uint8_t status, void *arg);
 static void capture_complete_callback(void *arg);
 
+static void start_capture_channel(uint8_t timer_index, uint8_t capture_channel, DMA_HANDLE *dma_handle);
+static void stop_capture_channel(uint8_t timer_index, uint8_t capture_channel, DMA_HANDLE dma_handle);
+
 static void process_capture_results(uint8_t timer_index, uint8_t channel_index);
 static unsigned calculate_period(uint8_t timer_index, uint8_t channel_index);
 
 // Timer configuration struct
 typedef struct timer_config_t {
 	DMA_HANDLE dma_handle;       	// DMA stream for DMA update and eRPM Capture Compare
+	DMA_HANDLE capture_dma_handles[4]; // DMA streams for capturing all channels at once
 	bool enabled;                   // Timer enabled
 	bool enabled_channels[4];       // Timer Channels enabled (requested)
 	bool initialized;               // Timer initialized
@@ -123,6 +127,7 @@ static uint16_t dshot_capture_buffer[MAX_NUM_CHANNELS_PER_TIMER][CHANNEL_CAPTURE
 px4_cache_aligned_data() = {};
 
 static bool     _bidirectional = false;
+static bool     _capture_all_channels = false; // capture every channel each cycle instead of round robin
 static uint8_t  _bidi_timer_index = 0; // TODO: BDSHOT_TIM param to select timer index?
 static uint32_t _dshot_frequency = 0;
 
@@ -304,6 +309,25 @@ int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq, bool enable_bi
 		channels_init_mask |= init_timer_channels(timer_index);
 	}
 
+	if (_bidirectional) {
+		// Capture the eRPM of all channels after every burst if the board has a capture DMA stream for
+		// each of them, otherwise one channel per burst in round robin
+		unsigned num_capture_channels = 0;
+		bool all_mapped = true;
+
+		for (uint8_t timer_channel_index = 0; timer_channel_index < MAX_NUM_CHANNELS_PER_TIMER; timer_channel_index++) {
+			if (timer_configs[_bidi_timer_index].initialized_channels[timer_channel_index]) {
+				++num_capture_channels;
+				all_mapped &= io_timers[_bidi_timer_index].dshot.dma_map_ch[timer_channel_index] != 0;
+			}
+		}
+
+		_capture_all_channels = all_mapped && num_capture_channels > 1
+					&& num_capture_channels <= BOARD_DMA_NUM_DSHOT_CHANNELS;
+
+		PX4_INFO("Bidirectional DShot eRPM capture: %s", _capture_all_channels ? "all channels" : "round robin");
+	}
+
 	unsigned output_buffer_offset = 0;
 
 	for (unsigned timer_index = 0; timer_index < MAX_IO_TIMERS; timer_index++) {
@@ -330,9 +354,13 @@ int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq, bool enable_bi
 	return channels_init_mask;
 }
 
-// Kicks off a DMA transmit for each configured timer and the associated channels
+// Kicks off a DMA transmit for each configured timer and the associated channels.
+// All DMA streams are set up first and then released together, so the timers start
+// their bursts within a few cycles of each other instead of one setup time apart.
 void up_dshot_trigger()
 {
+	bool timer_ready[MAX_IO_TIMERS] = {};
+
 	// Enable DShot inverted on all channels
 	io_timer_set_enable(true, _bidirectional ? IOTimerChanMode_DshotInverted : IOTimerChanMode_Dshot,
 			    IO_TIMER_ALL_MODES_CHANNELS);
@@ -376,7 +404,7 @@ void up_dshot_trigger()
 			// Clean UDE flag before DMA is started
 			io_timer_update_dma_req(timer_index, false);
 
-			// Trigger DMA (DShot Outputs)
+			// Arm the DMA stream, it waits for the timer update request
 			if (timer_configs[timer_index].bidirectional) {
 				stm32_dmastart(timer_configs[timer_index].dma_handle, dma_burst_finished_callback,
 					       &timer_configs[timer_index].timer_index,
@@ -386,10 +414,20 @@ void up_dshot_trigger()
 				stm32_dmastart(timer_configs[timer_index].dma_handle,  NULL, NULL, false);
 			}
 
-			// Enable DMA update request
+			timer_ready[timer_index] = true;
+		}
+	}
+
+	// Enable the DMA update requests of all timers back to back (DShot Outputs)
+	irqstate_t flags = px4_enter_critical_section();
+
+	for (uint8_t timer_index = 0; timer_index < MAX_IO_TIMERS; timer_index++) {
+		if (timer_ready[timer_index]) {
 			io_timer_update_dma_req(timer_index, true);
 		}
 	}
+
+	px4_leave_critical_section(flags);
 }
 
 static void select_next_capture_channel(uint8_t timer_index)
@@ -451,23 +489,56 @@ void dma_burst_finished_callback(DMA_HANDLE handle, uint8_t status, void *arg)
 	up_clean_dcache((uintptr_t) dshot_capture_buffer,
 			(uintptr_t) dshot_capture_buffer + DSHOT_CAPTURE_BUFFER_SIZE(MAX_NUM_CHANNELS_PER_TIMER));
 
-	// Unallocate timer channel for currently selected capture_channel
-	uint8_t capture_channel = timer_configs[timer_index].capture_channel_index;
-	uint8_t output_channel = output_channel_from_timer_channel(timer_index, capture_channel);
+	if (_capture_all_channels) {
+		for (uint8_t capture_channel = 0; capture_channel < MAX_NUM_CHANNELS_PER_TIMER; capture_channel++) {
+			if (timer_configs[timer_index].initialized_channels[capture_channel]) {
+				start_capture_channel(timer_index, capture_channel, &timer_configs[timer_index].capture_dma_handles[capture_channel]);
+			}
+		}
+
+	} else {
+		// Unallocate timer channel for currently selected capture_channel
+		uint8_t capture_channel = timer_configs[timer_index].capture_channel_index;
+		uint8_t output_channel = output_channel_from_timer_channel(timer_index, capture_channel);
+
+		// Re-initialize output for CaptureDMA for next time
+		io_timer_unallocate_channel(output_channel);
+		io_timer_channel_init(output_channel, IOTimerChanMode_CaptureDMA, NULL, NULL);
 
-	// Re-initialize output for CaptureDMA for next time
-	io_timer_unallocate_channel(output_channel);
-	io_timer_channel_init(output_channel, IOTimerChanMode_CaptureDMA, NULL, NULL);
+		// Select the next capture channel
+		select_next_capture_channel(timer_index);
 
-	// Select the next capture channel
-	select_next_capture_channel(timer_index);
+		start_capture_channel(timer_index, timer_configs[timer_index].capture_channel_index,
+				      &timer_configs[timer_index].dma_handle);
 
-	// Allocate DMA for currently selected capture_channel
-	capture_channel = timer_configs[timer_index].capture_channel_index;
-	timer_configs[timer_index].dma_handle = stm32_dmachannel(io_timers[timer_index].dshot.dma_map_ch[capture_channel]);
+		if (timer_configs[timer_index].dma_handle == NULL) {
+			return;
+		}
+	}
+
+	// Enable CaptureDMA and on all configured channels
+	io_timer_set_enable(true, IOTimerChanMode_CaptureDMA, IO_TIMER_ALL_MODES_CHANNELS);
+
+	// 30us to switch regardless of DShot frequency + eRPM frame time + 10us for good measure
+	hrt_abstime frame_us = (16 * 1000000) / _dshot_frequency; // 16 bits * us_per_s / bits_per_s
+	hrt_abstime delay = 30 + frame_us + 10;
+	hrt_call_after(&_cc_call, delay, capture_complete_callback, arg);
+}
+
+// Switch one channel to input capture and start its capture DMA into dshot_capture_buffer
+static void start_capture_channel(uint8_t timer_index, uint8_t capture_channel, DMA_HANDLE *dma_handle)
+{
+	if (_capture_all_channels) {
+		uint8_t output_channel = output_channel_from_timer_channel(timer_index, capture_channel);
+		io_timer_unallocate_channel(output_channel);
+		io_timer_channel_init(output_channel, IOTimerChanMode_CaptureDMA, NULL, NULL);
+	}
+
+	// Allocate DMA for the capture channel
+	*dma_handle = stm32_dmachannel(io_timers[timer_index].dshot.dma_map_ch[capture_channel]);
 
 	// If DMA handler is valid, start DMA
-	if (timer_configs[timer_index].dma_handle == NULL) {
+	if (*dma_handle == NULL) {
 		PX4_WARN("failed to allocate dma for timer %u channel %u", timer_index, capture_channel);
 		return;
 	}
@@ -480,7 +551,7 @@ void dma_burst_finished_callback(DMA_HANDLE handle, uint8_t status, void *arg)
 	uint32_t periph_addr = io_timers[timer_index].base + STM32_GTIM_CCR1_OFFSET + (4 * capture_channel);
 
 	// Setup DMA for this channel
-	px4_stm32_dmasetup(timer_configs[timer_index].dma_handle,
+	px4_stm32_dmasetup(*dma_handle,
 			   periph_addr,
 			   (uint32_t) dshot_capture_buffer[capture_channel],
 			   CHANNEL_CAPTURE_BUFF_SIZE,
@@ -488,15 +559,18 @@ void dma_burst_finished_callback(DMA_HANDLE handle, uint8_t status, void *arg)
 
 	// NOTE: we can't use DMA callback since GCR encoding creates a variable length pulse train. Instead
 	// we use an hrt callback to schedule the processing of the received and DMAd eRPM frames.
-	stm32_dmastart(timer_configs[timer_index].dma_handle, NULL, NULL, false);
+	stm32_dmastart(*dma_handle, NULL, NULL, false);
+}
 
-	// Enable CaptureDMA and on all configured channels
-	io_timer_set_enable(true, IOTimerChanMode_CaptureDMA, IO_TIMER_ALL_MODES_CHANNELS);
+static void stop_capture_channel(uint8_t timer_index, uint8_t capture_channel, DMA_HANDLE dma_handle)
+{
+	// Disable capture DMA
+	io_timer_capture_dma_req(timer_index, capture_channel, false);
 
-	// 30us to switch regardless of DShot frequency + eRPM frame time + 10us for good measure
-	hrt_abstime frame_us = (16 * 1000000) / _dshot_frequency; // 16 bits * us_per_s / bits_per_s
-	hrt_abstime delay = 30 + frame_us + 10;
-	hrt_call_after(&_cc_call, delay, capture_complete_callback, arg);
+	// Stop DMA (should already be finished)
+	if (dma_handle != NULL) {
+		stm32_dmastop(dma_handle);
+	}
 }
 
 static void capture_complete_callback(void *arg)
@@ -510,11 +584,19 @@ static void capture_complete_callback(void *arg)
 
 	uint8_t capture_channel = timer_configs[timer_index].capture_channel_index;
 
-	// Disable capture DMA
-	io_timer_capture_dma_req(timer_index, capture_channel, false);
+	if (_capture_all_channels) {
+		for (uint8_t channel = 0; channel < MAX_NUM_CHANNELS_PER_TIMER; channel++) {
+			if (timer_configs[timer_index].capture_dma_handles[channel] != NULL) {
+				stop_capture_channel(timer_index, channel, timer_configs[timer_index].capture_dma_handles[channel]);
+				stm32_dmafree(timer_configs[timer_index].capture_dma_handles[channel]);
+				timer_configs[timer_index].capture_dma_handles[channel] = NULL;
+			}
+		}
 
-	// Stop DMA (should already be finished)
-	stm32_dmastop(timer_configs[timer_index].dma_handle);
+	} else {
+		// The stream is freed before the next burst
+		stop_capture_channel(timer_index, capture_channel, timer_configs[timer_index].dma_handle);
+	}
 
 	// Re-initialize all output channels on this timer
 	for (uint8_t output_channel = 0; output_channel < MAX_TIMER_IO_CHANNELS; output_channel++) {
@@ -536,7 +618,16 @@ static void capture_complete_callback(void *arg)
 			     (uintptr_t) dshot_capture_buffer + DSHOT_CAPTURE_BUFFER_SIZE(MAX_NUM_CHANNELS_PER_TIMER));
 
 	// Process eRPM frames from all channels on this timer
-	process_capture_results(timer_index, capture_channel);
+	if (_capture_all_channels) {
+		for (uint8_t channel = 0; channel < MAX_NUM_CHANNELS_PER_TIMER; channel++) {
+			if (timer_configs[timer_index].initialized_channels[channel]) {
+				process_capture_results(timer_index, channel);
+			}
+		}
+
+	} else {
+		process_capture_results(timer_index, capture_channel);
+	}
 
 	// Enable all channels configured as DShotInverted
 	io_timer_set_enable(true, IOTimerChanMode_DshotInverted, IO_TIMER_ALL_MODES_CHANNELS);
@@ -672,7 +763,7 @@ void up_bdshot_status(void)
 	PX4_INFO("dshot driver stats:");
 
 	if (_bidirectional) {
-		PX4_INFO("Bidirectional DShot enabled");
+		PX4_INFO("Bidirectional DShot enabled, eRPM capture: %s", _capture_all_channels ? "all channels" : "round robin");
 	}
 
 	uint8_t timer_index = _bidi_timer_index;
@@ -691,62 +782,13 @@ void up_bdshot_status(void)
 	}
 }
 
-uint8_t nibbles_from_mapped(uint8_t mapped)
-{
-	switch (mapped) {
-	case 0x19:
-		return 0x00;
-
-	case 0x1B:
-		return 0x01;
-
-	case 0x12:
-		return 0x02;
-
-	case 0x13:
-		return 0x03;
-
-	case 0x1D:
-		return 0x04;
-
-	case 0x15:
-		return 0x05;
-
-	case 0x16:
-		return 0x06;
-
-	case 0x17:
-		return 0x07;
-
-	case 0x1a:
-		return 0x08;
-
-	case 0x09:
-		return 0x09;
-
-	case 0x0A:
-		return 0x0A;
-
-	case 0x0B:
-		return 0x0B;
-
-	case 0x1E:
-		return 0x0C;
-
-	case 0x0D:
-		return 0x0D;
-
-	case 0x0E:
-		return 0x0E;
-
-	case 0x0F:
-		return 0x0F;
-
-	default:
-		// Unknown mapped
-		return 0xFF;
-	}
-}
+// GCR 5 bit symbol to nibble, 0xFF for invalid symbols
+static const uint8_t gcr_decode_table[32] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0x00 - 0x07
+	0xFF, 0x09, 0x0A, 0x0B, 0xFF, 0x0D, 0x0E, 0x0F, // 0x08 - 0x0F
+	0xFF, 0xFF, 0x02, 0x03, 0xFF, 0x05, 0x06, 0x07, // 0x10 - 0x17
+	0xFF, 0x00, 0x08, 0x01, 0xFF, 0x04, 0x0C, 0xFF, // 0x18 - 0x1F
+};
 
 unsigned calculate_period(uint8_t timer_index, uint8_t channel_index)
 {
@@ -754,31 +796,37 @@ unsigned calculate_period(uint8_t timer_index, uint8_t channel_index)
 	uint32_t high = 1; // We start off with high
 	unsigned shifted = 0;
 
+	const uint16_t *capture = dshot_capture_buffer[channel_index];
+
 	// We can ignore the very first data point as it's the pulse before it starts.
-	unsigned previous = dshot_capture_buffer[channel_index][1];
+	unsigned previous = capture[1];
 
 	// Loop through the capture buffer for the specified channel
 	for (unsigned i = 2; i < CHANNEL_CAPTURE_BUFF_SIZE; ++i) {
 
-		if (dshot_capture_buffer[channel_index][i] == 0) {
+		if (capture[i] == 0) {
 			// Once we get zeros we're through
 			break;
 		}
 
 		// This seemss to work with dshot 150, 300, 600, 1200
 		// The values were found by trial and error to get the quantization just right.
-		const uint32_t bits = (dshot_capture_buffer[channel_index][i] - previous + 5) / 20;
+		const uint32_t bits = (uint16_t)(capture[i] - previous + 5) / 20;
 
-		// Convert GCR encoded pulse train into value
-		for (unsigned bit = 0; bit < bits; ++bit) {
-			value = (value << 1) | high;
-			++shifted;
+		if (shifted + bits > 21) {
+			// more bits than a frame holds
+			++read_fail_zero[channel_index];
+			return 0;
 		}
 
+		// Convert GCR encoded pulse train into value, a run of equal bits at once
+		value = (value << bits) | (high ? ((1u << bits) - 1) : 0);
+		shifted += bits;
+
 		// The next edge toggles.
 		high = !high;
 
-		previous = dshot_capture_buffer[channel_index][i];
+		previous = capture[i];
 	}
 
 	if (shifted == 0) {
@@ -798,14 +846,14 @@ unsigned calculate_period(uint8_t timer_index, uint8_t channel_index)
 
 	// 20bits -> 5 mapped -> 4 nibbles
 	for (unsigned i = 0; i < 4; ++i) {
-		uint32_t nibble = nibbles_from_mapped(gcr & 0x1F) << (4 * i);
+		const uint32_t nibble = gcr_decode_table[gcr & 0x1F];
 
 		if (nibble == 0xFF) {
-			++read_fail_nibble[channel_index];;
+			++read_fail_nibble[channel_index];
 			return 0;
 		}
 
-		data |= nibble;
+		data |= nibble << (4 * i);
 		gcr >>= 5;
 	}
 
@@ -817,11 +865,11 @@ unsigned calculate_period(uint8_t timer_index, uint8_t channel_index)
 	unsigned calculated_crc = (~(payload ^ (payload >> 4) ^ (payload >> 8))) & 0x0F;
 
 	if (crc != calculated_crc) {
-		++read_fail_crc[channel_index];;
+		++read_fail_crc[channel_index];
 		return 0;
 	}
 
-	++read_ok[channel_index];;
+	++read_ok[channel_index];
 	return period;
 }
 
@@ -61,6 +61,8 @@
 
 #include <board_config.h>
 #include <drivers/drv_hrt.h>
+#include <px4_platform_common/hrt_timer_wheel.h>
+#include <px4_platform_common/sched_trace.h>
 
 
 #include "stm32_gpio.h"
@@ -256,10 +258,20 @@
 # error HRT_TIMER_CHANNEL must be a value between 1 and 4
 #endif
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+/*
+ * Timer wheel of callout entries.
+ */
+static struct hrt_timer_wheel	callout_wheel;
+
+/* deadline of the scheduled compare event */
+static hrt_abstime		scheduled_deadline = HRT_WHEEL_NONE;
+#else
 /*
  * Queue of callout entries.
  */
 static struct sq_queue_s	callout_queue;
+#endif /* CONFIG_HRT_TIMER_WHEEL */
 
 /* latency baseline (last compare value applied) */
 static uint16_t			latency_baseline;
@@ -724,7 +736,11 @@ hrt_store_absolute_time(volatile hrt_abstime *t)
 void
 hrt_init(void)
 {
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	hrt_wheel_init(&callout_wheel, 0);
+#else
 	sq_init(&callout_queue);
+#endif /* CONFIG_HRT_TIMER_WHEEL */
 	hrt_tim_init();
 
 #ifdef HRT_PPM_CHANNEL
@@ -782,7 +798,11 @@ hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime inte
 	   anything actually unsafe.
 	*/
 	if (entry->deadline != 0) {
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+		hrt_wheel_remove(&callout_wheel, entry);
+#else
 		sq_rem(&entry->link, &callout_queue);
+#endif /* CONFIG_HRT_TIMER_WHEEL */
 	}
 
 	entry->deadline = deadline;
@@ -814,7 +834,11 @@ hrt_cancel(struct hrt_call *entry)
 {
 	irqstate_t flags = px4_enter_critical_section();
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	hrt_wheel_remove(&callout_wheel, entry);
+#else
 	sq_rem(&entry->link, &callout_queue);
+#endif /* CONFIG_HRT_TIMER_WHEEL */
 	entry->deadline = 0;
 
 	/* if this is a periodic call being removed by the callout, prevent it from
@@ -828,6 +852,17 @@ hrt_cancel(struct hrt_call *entry)
 static void
 hrt_call_enter(struct hrt_call *entry)
 {
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	/* a callout might have re-entered itself already */
+	hrt_wheel_remove(&callout_wheel, entry);
+	hrt_wheel_add(&callout_wheel, entry);
+
+	if (entry->deadline < scheduled_deadline) {
+		/* we changed the next deadline, reschedule the timer event */
+		hrt_call_reschedule();
+	}
+
+#else
 	struct hrt_call	*call, *next;
 
 	call = (struct hrt_call *)sq_peek(&callout_queue);
@@ -850,6 +885,8 @@ hrt_call_enter(struct hrt_call *entry)
 		} while ((call = next) != NULL);
 	}
 
+#endif /* CONFIG_HRT_TIMER_WHEEL */
+
 	hrtinfo("scheduled\n");
 }
 
@@ -863,6 +900,14 @@ hrt_call_invoke(void)
 		/* get the current time */
 		hrt_abstime now = hrt_absolute_time();
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+		call = hrt_wheel_pop_due(&callout_wheel, now);
+
+		if (call == NULL) {
+			break;
+		}
+
+#else
 		call = (struct hrt_call *)sq_peek(&callout_queue);
 
 		if (call == NULL) {
@@ -874,6 +919,7 @@ hrt_call_invoke(void)
 		}
 
 		sq_rem(&call->link, &callout_queue);
+#endif /* CONFIG_HRT_TIMER_WHEEL */
 		hrtinfo("call pop\n");
 
 		/* save the intended deadline for periodic calls */
@@ -885,6 +931,7 @@ hrt_call_invoke(void)
 		/* invoke the callout (if there is one) */
 		if (call->callout) {
 			hrtinfo("call %p: %p(%p)\n", call, call->callout, call->arg);
+			SCHED_TRACE(SCHED_TRACE_HRT_CALLOUT, call->callout);
 			call->callout(call->arg);
 		}
 
@@ -911,9 +958,17 @@ static void
 hrt_call_reschedule()
 {
 	hrt_abstime	now = hrt_absolute_time();
-	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
 	hrt_abstime	deadline = now + HRT_INTERVAL_MAX;
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	hrt_abstime	next_deadline = hrt_wheel_next_deadline(&callout_wheel);
+	bool		next = (next_deadline != HRT_WHEEL_NONE);
+#else
+	struct hrt_call	*call = (struct hrt_call *)sq_peek(&callout_queue);
+	hrt_abstime	next_deadline = (call != NULL) ? call->deadline : 0;
+	bool		next = (call != NULL);
+#endif /* CONFIG_HRT_TIMER_WHEEL */
+
 	/*
 	 * Determine what the next deadline will be.
 	 *
@@ -926,20 +981,24 @@ hrt_call_reschedule()
 	 * interrupt fires sufficiently often that the base_time update in
 	 * hrt_absolute_time runs at least once per timer period.
 	 */
-	if (next != NULL) {
+	if (next) {
 		hrtinfo("entry in queue\n");
 
-		if (next->deadline <= (now + HRT_INTERVAL_MIN)) {
+		if (next_deadline <= (now + HRT_INTERVAL_MIN)) {
 			hrtinfo("pre-expired\n");
 			/* set a minimal deadline so that we call ASAP */
 			deadline = now + HRT_INTERVAL_MIN;
 
-		} else if (next->deadline < deadline) {
+		} else if (next_deadline < deadline) {
 			hrtinfo("due soon\n");
-			deadline = next->deadline;
+			deadline = next_deadline;
 		}
 	}
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	scheduled_deadline = deadline;
+#endif /* CONFIG_HRT_TIMER_WHEEL */
+
 	hrtinfo("schedule for %u at %u\n", (unsigned)(deadline & 0xffffffff), (unsigned)(now & 0xffffffff));
 
 	/* set the new compare value and remember it for latency tracking */
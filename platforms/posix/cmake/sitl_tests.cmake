@@ -15,6 +15,7 @@ set(tests
 	IntrusiveQueue
 	IntrusiveSortedList
 	List
+	LockFreeByteRing
 	mathlib
 	matrix
 	param
@@ -100,6 +101,34 @@ set_tests_properties(sitl-imu_filtering PROPERTIES PASS_REGULAR_EXPRESSION "ALL
 sanitizer_fail_test_on_error(sitl-imu_filtering)
 
 
+# Dataman with the file backend (the tests above use the memory-mapped file)
+add_test(NAME sitl-dataman_file
+	COMMAND $<TARGET_FILE:px4>
+		-s ${PX4_SOURCE_DIR}/posix-configs/SITL/init/test/test_dataman_file
+		-t ${PX4_SOURCE_DIR}/test_data
+		${PX4_SOURCE_DIR}/ROMFS/px4fmu_test
+	WORKING_DIRECTORY ${SITL_WORKING_DIR}
+)
+
+set_tests_properties(sitl-dataman_file PROPERTIES FAIL_REGULAR_EXPRESSION "dataman FAILED")
+set_tests_properties(sitl-dataman_file PROPERTIES PASS_REGULAR_EXPRESSION "dataman PASSED")
+sanitizer_fail_test_on_error(sitl-dataman_file)
+
+
+# Dataman persistence across restarts, alternating between the file backend and the memory-mapped file
+add_test(NAME sitl-dataman_restart
+	COMMAND $<TARGET_FILE:px4>
+		-s ${PX4_SOURCE_DIR}/posix-configs/SITL/init/test/test_dataman_restart
+		-t ${PX4_SOURCE_DIR}/test_data
+		${PX4_SOURCE_DIR}/ROMFS/px4fmu_test
+	WORKING_DIRECTORY ${SITL_WORKING_DIR}
+)
+
+set_tests_properties(sitl-dataman_restart PROPERTIES FAIL_REGULAR_EXPRESSION "dataman FAILED")
+set_tests_properties(sitl-dataman_restart PROPERTIES PASS_REGULAR_EXPRESSION "dataman PASSED")
+sanitizer_fail_test_on_error(sitl-dataman_restart)
+
+
 
 # # Shutdown test
 # add_test(NAME sitl-shutdown
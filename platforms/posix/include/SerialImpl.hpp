@@ -35,6 +35,7 @@
 
 #include <stdint.h>
 #include <unistd.h>
+#include <sys/uio.h>
 
 #include <px4_platform_common/SerialCommon.hpp>
 
@@ -63,7 +64,11 @@ public:
 	ssize_t read(uint8_t *buffer, size_t buffer_size);
 	ssize_t readAtLeast(uint8_t *buffer, size_t buffer_size, size_t character_count = 1, uint32_t timeout_us = 0);
 
+	ssize_t readv(const struct iovec *iov, int iovcnt);
+	int waitForData(uint32_t timeout_us);
+
 	ssize_t write(const void *buffer, size_t buffer_size);
+	ssize_t writev(const struct iovec *iov, int iovcnt);
 	ssize_t writeBlocking(const void *buffer, size_t buffer_size, uint32_t timeout_us = 0);
 
 	void flush();
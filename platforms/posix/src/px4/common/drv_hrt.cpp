@@ -44,13 +44,25 @@
 #include <px4_platform_common/workqueue.h>
 #include <px4_platform_common/tasks.h>
 #include <drivers/drv_hrt.h>
+#include <px4_platform_common/hrt_timer_wheel.h>
+#include <px4_platform_common/sched_trace.h>
 
 #include <semaphore.h>
 #include <time.h>
 #include <string.h>
 #include <errno.h>
+#include <stdio.h>
 #include "hrt_work.h"
 
+#if defined(CONFIG_HRT_POSIX_FAST_CLOCK) && !defined(ENABLE_LOCKSTEP_SCHEDULER) && !defined(CONFIG_MUORB_APPS_SYNC_TIMESTAMP) \
+	&& defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define HRT_FAST_CLOCK
+#endif
+
+#if defined(HRT_FAST_CLOCK) && defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
 // Voxl2 board specific API definitions to get time offset
 #if defined(CONFIG_MUORB_APPS_SYNC_TIMESTAMP)
 #include "fc_sensor.h"
@@ -64,11 +76,22 @@ static LockstepScheduler lockstep_scheduler {true};
 // Intervals in usec
 static constexpr unsigned HRT_INTERVAL_MIN = 50;
 static constexpr unsigned HRT_INTERVAL_MAX = 50000000;
+static constexpr hrt_abstime HRT_INTERVAL_NONE = UINT64_MAX; // no callout queued
+
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+/*
+ * Timer wheel of callout entries.
+ */
+static struct hrt_timer_wheel	callout_wheel;
 
+/* deadline of the scheduled timer event */
+static hrt_abstime		scheduled_deadline = HRT_INTERVAL_NONE;
+#else
 /*
  * Queue of callout entries.
  */
 static struct sq_queue_s	callout_queue;
+#endif // CONFIG_HRT_TIMER_WHEEL
 
 /* latency baseline (last compare value applied) */
 static uint64_t			latency_baseline;
@@ -89,6 +112,214 @@ static void hrt_latency_update();
 static void hrt_call_reschedule();
 static void hrt_call_invoke();
 
+#if defined(HRT_FAST_CLOCK)
+/*
+ * Fast clock: read the CPU cycle counter (x86 TSC or the ARMv8 virtual counter) and
+ * convert it with a multiplication instead of calling clock_gettime().
+ *
+ * The conversion is slewed towards CLOCK_MONOTONIC every FAST_CLOCK_UPDATE_NS, so that the
+ * time stays consistent with the timed waits of the OS without ever going backwards.
+ * There are two conversion slots: the update writes the inactive one and then switches the
+ * generation, readers retry if the generation changed while they were reading.
+ */
+struct fast_clock_conversion {
+	uint64_t base_cycles;
+	uint64_t base_ns;
+	uint64_t mult; ///< ns per cycle, fixed point with FAST_CLOCK_SHIFT fractional bits
+};
+
+static constexpr int FAST_CLOCK_SHIFT = 32;
+static constexpr int64_t FAST_CLOCK_UPDATE_NS = 1000000000; // slew interval
+static constexpr int64_t FAST_CLOCK_STEP_NS = 1000000; // step forward instead of slewing above this error
+static constexpr int64_t FAST_CLOCK_MAX_SLEW_NS = FAST_CLOCK_UPDATE_NS / 1000; // max 1000 ppm rate adjustment
+
+static fast_clock_conversion fast_clock[2] {};
+static px4::atomic<uint32_t> fast_clock_generation{0}; // active slot: generation & 1
+static px4::atomic<uint32_t> fast_clock_updating{0};
+static uint64_t fast_clock_rate_mult{0}; // calibrated rate, only accessed by the updating thread
+static uint64_t fast_clock_update_cycles{0};
+static bool fast_clock_enabled{false};
+
+static inline uint64_t fast_clock_read_cycles()
+{
+#if defined(__x86_64__)
+	uint32_t lo, hi;
+	// lfence: do not read the TSC before the preceding instructions completed
+	asm volatile("lfence; rdtsc" : "=a"(lo), "=d"(hi) :: "memory");
+	return ((uint64_t)hi << 32) | lo;
+#else
+	uint64_t cycles;
+	asm volatile("isb; mrs %0, cntvct_el0" : "=r"(cycles) :: "memory");
+	return cycles;
+#endif
+}
+
+static inline uint64_t fast_clock_to_ns(const fast_clock_conversion &conversion, uint64_t cycles)
+{
+	// another CPU might have updated the conversion with a slightly later cycle count
+	const int64_t delta = (int64_t)(cycles - conversion.base_cycles);
+
+	if (delta <= 0) {
+		return conversion.base_ns;
+	}
+
+	return conversion.base_ns + (uint64_t)(((unsigned __int128)delta * conversion.mult) >> FAST_CLOCK_SHIFT);
+}
+
+static uint64_t system_monotonic_ns()
+{
+	struct timespec ts;
+	system_clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void fast_clock_update()
+{
+	uint32_t expected = 0;
+
+	if (!fast_clock_updating.compare_exchange(&expected, 1)) {
+		return; // another thread is already updating
+	}
+
+	const uint32_t generation = fast_clock_generation.load();
+	const fast_clock_conversion &current = fast_clock[generation & 1];
+	fast_clock_conversion &next = fast_clock[(generation + 1) & 1];
+
+	const uint64_t monotonic_ns = system_monotonic_ns();
+	const uint64_t cycles = fast_clock_read_cycles();
+
+	if (cycles - current.base_cycles > fast_clock_update_cycles) {
+		// continue from the current time, and correct the error over the next interval
+		const uint64_t now_ns = fast_clock_to_ns(current, cycles);
+		int64_t error = (int64_t)(monotonic_ns - now_ns);
+
+		next.base_cycles = cycles;
+		next.base_ns = now_ns;
+
+		if (error > FAST_CLOCK_STEP_NS) {
+			next.base_ns = monotonic_ns;
+			error = 0;
+
+		} else if (error > FAST_CLOCK_MAX_SLEW_NS) {
+			error = FAST_CLOCK_MAX_SLEW_NS;
+
+		} else if (error < -FAST_CLOCK_MAX_SLEW_NS) {
+			error = -FAST_CLOCK_MAX_SLEW_NS;
+		}
+
+		// PI loop: a persistent error is a wrong rate, the rest is corrected within the next interval
+		fast_clock_rate_mult += (int64_t)((__int128)fast_clock_rate_mult * error / (2 * FAST_CLOCK_UPDATE_NS));
+		next.mult = fast_clock_rate_mult + (int64_t)((__int128)fast_clock_rate_mult * error / FAST_CLOCK_UPDATE_NS);
+
+		fast_clock_generation.fetch_add(1);
+	}
+
+	fast_clock_updating.store(0);
+}
+
+static uint64_t fast_clock_ns()
+{
+	uint32_t generation;
+	uint64_t cycles;
+	uint64_t ns;
+	uint64_t base_cycles;
+
+	do {
+		generation = fast_clock_generation.load();
+		const fast_clock_conversion &conversion = fast_clock[generation & 1];
+		cycles = fast_clock_read_cycles();
+		base_cycles = conversion.base_cycles;
+		ns = fast_clock_to_ns(conversion, cycles);
+	} while (fast_clock_generation.load() != generation);
+
+	if (cycles - base_cycles > fast_clock_update_cycles) {
+		fast_clock_update();
+	}
+
+	return ns;
+}
+
+static bool fast_clock_source_is(const char *expected)
+{
+	// only use the counter if the kernel trusts it as well (e.g. not an unstable TSC)
+	FILE *file = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+
+	if (file == nullptr) {
+		return false;
+	}
+
+	char clocksource[32] {};
+	const bool ret = fgets(clocksource, sizeof(clocksource), file) && strncmp(clocksource, expected, strlen(expected)) == 0;
+	fclose(file);
+	return ret;
+}
+
+#if defined(__x86_64__)
+static void fast_clock_sample(uint64_t *cycles, uint64_t *ns)
+{
+	// take the sample with the least cycles around clock_gettime() to reduce the effect of preemption
+	uint64_t min_cycles = UINT64_MAX;
+
+	for (int i = 0; i < 5; i++) {
+		const uint64_t before = fast_clock_read_cycles();
+		const uint64_t monotonic_ns = system_monotonic_ns();
+		const uint64_t after = fast_clock_read_cycles();
+
+		if (after - before < min_cycles) {
+			min_cycles = after - before;
+			*cycles = before + (after - before) / 2;
+			*ns = monotonic_ns;
+		}
+	}
+}
+#endif
+
+static void fast_clock_init()
+{
+#if defined(__x86_64__)
+	unsigned eax, ebx, ecx, edx;
+
+	// invariant TSC: constant rate and not stopped in deep C-states
+	if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1u << 8)) || !fast_clock_source_is("tsc")) {
+		return;
+	}
+
+	// calibrate the TSC rate against CLOCK_MONOTONIC, the remaining error is corrected by fast_clock_update()
+	uint64_t start_cycles, start_ns, end_cycles, end_ns;
+	fast_clock_sample(&start_cycles, &start_ns);
+	system_usleep(20000);
+	fast_clock_sample(&end_cycles, &end_ns);
+
+	if (end_cycles <= start_cycles || end_ns <= start_ns) {
+		return;
+	}
+
+	fast_clock_rate_mult = (uint64_t)(((unsigned __int128)(end_ns - start_ns) << FAST_CLOCK_SHIFT) / (end_cycles - start_cycles));
+#else
+	uint64_t frequency;
+	asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+
+	if (frequency == 0 || !fast_clock_source_is("arch_sys_counter")) {
+		return;
+	}
+
+	fast_clock_rate_mult = (uint64_t)(((unsigned __int128)1000000000 << FAST_CLOCK_SHIFT) / frequency);
+#endif
+
+	if (fast_clock_rate_mult == 0) {
+		return;
+	}
+
+	fast_clock_update_cycles = (uint64_t)(((unsigned __int128)FAST_CLOCK_UPDATE_NS << FAST_CLOCK_SHIFT) / fast_clock_rate_mult);
+
+	fast_clock[0].mult = fast_clock_rate_mult;
+	fast_clock[0].base_ns = system_monotonic_ns();
+	fast_clock[0].base_cycles = fast_clock_read_cycles();
+
+	fast_clock_enabled = true;
+}
+#endif // HRT_FAST_CLOCK
+
 static void hrt_lock()
 {
 	// loop as the wait may be interrupted by a signal
@@ -110,6 +341,14 @@ hrt_abstime hrt_absolute_time()
 	return lockstep_scheduler.get_absolute_time();
 
 #else // defined(ENABLE_LOCKSTEP_SCHEDULER)
+# if defined(HRT_FAST_CLOCK)
+
+	if (fast_clock_enabled) {
+		return fast_clock_ns() / 1000;
+	}
+
+# endif // defined(HRT_FAST_CLOCK)
+
 	struct timespec ts;
 	px4_clock_gettime(CLOCK_MONOTONIC, &ts);
 
@@ -166,7 +405,11 @@ bool	hrt_called(struct hrt_call *entry)
 void	hrt_cancel(struct hrt_call *entry)
 {
 	hrt_lock();
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	hrt_wheel_remove(&callout_wheel, entry);
+#else
 	sq_rem(&entry->link, &callout_queue);
+#endif // CONFIG_HRT_TIMER_WHEEL
 	entry->deadline = 0;
 
 	/* if this is a periodic call being removed by the callout, prevent it from
@@ -219,7 +462,15 @@ void	hrt_call_delay(struct hrt_call *entry, hrt_abstime delay)
  */
 void	hrt_init()
 {
+#if defined(HRT_FAST_CLOCK)
+	fast_clock_init();
+#endif // HRT_FAST_CLOCK
+
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	hrt_wheel_init(&callout_wheel, hrt_absolute_time());
+#else
 	sq_init(&callout_queue);
+#endif // CONFIG_HRT_TIMER_WHEEL
 
 	int sem_ret = px4_sem_init(&_hrt_lock, 0, 1);
 
@@ -233,6 +484,17 @@ void	hrt_init()
 static void
 hrt_call_enter(struct hrt_call *entry)
 {
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	// a callout might have re-entered itself already
+	hrt_wheel_remove(&callout_wheel, entry);
+	hrt_wheel_add(&callout_wheel, entry);
+
+	if (entry->deadline < scheduled_deadline) {
+		/* we changed the next deadline, reschedule the timer event */
+		hrt_call_reschedule();
+	}
+
+#else
 	struct hrt_call	*call, *next;
 
 	call = (struct hrt_call *)sq_peek(&callout_queue);
@@ -254,6 +516,8 @@ hrt_call_enter(struct hrt_call *entry)
 			}
 		} while ((call = next) != nullptr);
 	}
+
+#endif // CONFIG_HRT_TIMER_WHEEL
 }
 
 /**
@@ -291,9 +555,15 @@ hrt_call_reschedule()
 {
 	hrt_abstime	now = hrt_absolute_time();
 	hrt_abstime	delay = HRT_INTERVAL_MAX;
-	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
 	hrt_abstime	deadline = now + HRT_INTERVAL_MAX;
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	const hrt_abstime next_deadline = hrt_wheel_next_deadline(&callout_wheel);
+#else
+	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
+	const hrt_abstime next_deadline = (next != nullptr) ? next->deadline : HRT_INTERVAL_NONE;
+#endif // CONFIG_HRT_TIMER_WHEEL
+
 	/*
 	 * Determine what the next deadline will be.
 	 *
@@ -306,22 +576,26 @@ hrt_call_reschedule()
 	 * interrupt fires sufficiently often that the base_time update in
 	 * hrt_absolute_time runs at least once per timer period.
 	 */
-	if (next != nullptr) {
+	if (next_deadline != HRT_INTERVAL_NONE) {
 		//lldbg("entry in queue\n");
-		if (next->deadline <= (now + HRT_INTERVAL_MIN)) {
+		if (next_deadline <= (now + HRT_INTERVAL_MIN)) {
 			//lldbg("pre-expired\n");
 			/* set a minimal deadline so that we call ASAP */
 			delay = HRT_INTERVAL_MIN;
 
-		} else if (next->deadline < deadline) {
+		} else if (next_deadline < deadline) {
 			//lldbg("due soon\n");
-			delay = next->deadline - now;
+			delay = next_deadline - now;
 		}
 	}
 
 	/* set the new compare value and remember it for latency tracking */
 	latency_baseline = now + delay;
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	scheduled_deadline = now + delay;
+#endif // CONFIG_HRT_TIMER_WHEEL
+
 	// There is no timer ISR, so simulate one by putting an event on the
 	// high priority work queue
 
@@ -347,7 +621,11 @@ hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime inte
 	   anything actually unsafe.
 	*/
 	if (entry->deadline != 0) {
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+		hrt_wheel_remove(&callout_wheel, entry);
+#else
 		sq_rem(&entry->link, &callout_queue);
+#endif // CONFIG_HRT_TIMER_WHEEL
 	}
 
 #if 1
@@ -419,6 +697,14 @@ hrt_call_invoke()
 		/* get the current time */
 		hrt_abstime now = hrt_absolute_time();
 
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+		call = hrt_wheel_pop_due(&callout_wheel, now);
+
+		if (call == nullptr) {
+			break;
+		}
+
+#else
 		call = (struct hrt_call *)sq_peek(&callout_queue);
 
 		if (call == nullptr) {
@@ -430,6 +716,7 @@ hrt_call_invoke()
 		}
 
 		sq_rem(&call->link, &callout_queue);
+#endif // CONFIG_HRT_TIMER_WHEEL
 		//PX4_INFO("call pop");
 
 		/* save the intended deadline for periodic calls */
@@ -444,6 +731,7 @@ hrt_call_invoke()
 			hrt_unlock();
 
 			//PX4_INFO("call %p: %p(%p)", call, call->callout, call->arg);
+			SCHED_TRACE(SCHED_TRACE_HRT_CALLOUT, call->callout);
 			call->callout(call->arg);
 
 			hrt_lock();
@@ -476,6 +764,16 @@ int px4_clock_gettime(clockid_t clk_id, struct timespec *tp)
 	}
 
 #endif // defined(ENABLE_LOCKSTEP_SCHEDULER)
+#if defined(HRT_FAST_CLOCK)
+
+	if (clk_id == CLOCK_MONOTONIC && fast_clock_enabled) {
+		const uint64_t ns = fast_clock_ns();
+		tp->tv_sec = ns / 1000000000;
+		tp->tv_nsec = ns % 1000000000;
+		return 0;
+	}
+
+#endif // HRT_FAST_CLOCK
 	return system_clock_gettime(clk_id, tp);
 
 }
@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <vector>
@@ -58,6 +59,8 @@ public:
 
 private:
 	struct TimedWait {
+		static constexpr size_t NOT_QUEUED = SIZE_MAX;
+
 		~TimedWait()
 		{
 			if (!done) {
@@ -75,9 +78,9 @@ private:
 				done = true;
 			}
 
-			// If a thread quickly exits after a cond_timedwait(), the
-			// thread_local object can still be in the linked list. In that case
-			// we need to wait until it's removed.
+			// If a thread got canceled during a cond_timedwait(), the
+			// thread_local object is still in the heap. In that case
+			// we need to wait until its deadline is reached and it is removed.
 			while (!removed) {
 				system_usleep(5000);
 			}
@@ -90,14 +93,21 @@ private:
 		std::atomic<bool> done{false};
 		std::atomic<bool> removed{true};
 
-		TimedWait *next{nullptr}; ///< linked list
+		size_t heap_index{NOT_QUEUED}; ///< position in _timed_waits, protected by _timed_waits_mutex
 	};
 
+	// Min-heap of pending timed waits ordered by deadline, so set_absolute_time() only has to
+	// look at the waits that are due. All of these require _timed_waits_mutex to be held.
+	void push_timed_wait(TimedWait *timed_wait);
+	void remove_timed_wait(TimedWait *timed_wait);
+	void swap_timed_waits(size_t a, size_t b);
+	void sift_up(size_t index);
+	void sift_down(size_t index);
+
 	LockstepComponents _components;
 
 	std::atomic<uint64_t> _time_us{0};
 
-	TimedWait *_timed_waits{nullptr}; ///< head of linked list
+	std::vector<TimedWait *> _timed_waits; ///< min-heap ordered by TimedWait::time_us
 	std::mutex _timed_waits_mutex;
-	std::atomic<bool> _setting_time{false}; ///< true if set_absolute_time() is currently being executed
 };
@@ -37,14 +37,15 @@
 
 LockstepScheduler::~LockstepScheduler()
 {
-	// cleanup the linked list
+	// cleanup the heap
 	std::unique_lock<std::mutex> lock_timed_waits(_timed_waits_mutex);
 
-	while (_timed_waits) {
-		TimedWait *tmp = _timed_waits;
-		_timed_waits = _timed_waits->next;
-		tmp->removed = true;
+	for (TimedWait *timed_wait : _timed_waits) {
+		timed_wait->heap_index = TimedWait::NOT_QUEUED;
+		timed_wait->removed = true;
 	}
+
+	_timed_waits.clear();
 }
 
 void LockstepScheduler::set_absolute_time(uint64_t time_us)
@@ -57,30 +58,14 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 
 	{
 		std::unique_lock<std::mutex> lock_timed_waits(_timed_waits_mutex);
-		_setting_time = true;
-
-		TimedWait *timed_wait = _timed_waits;
-		TimedWait *timed_wait_prev = nullptr;
-
-		while (timed_wait) {
-			// Clean up the ones that are already done from last iteration.
-			if (timed_wait->done) {
-				// Erase from the linked list
-				if (timed_wait_prev) {
-					timed_wait_prev->next = timed_wait->next;
-
-				} else {
-					_timed_waits = timed_wait->next;
-				}
-
-				TimedWait *tmp = timed_wait;
-				timed_wait = timed_wait->next;
-				tmp->removed = true;
-				continue;
-			}
 
-			if (timed_wait->time_us <= time_us &&
-			    !timed_wait->timeout) {
+		// Only the waits at the top of the heap can be due, everything else stays untouched.
+		while (!_timed_waits.empty() && _timed_waits.front()->time_us <= time_us) {
+			TimedWait *timed_wait = _timed_waits.front();
+			remove_timed_wait(timed_wait);
+
+			// A wait that is done at this point belongs to a canceled thread (see ~TimedWait()).
+			if (!timed_wait->done) {
 				// We are abusing the condition here to signal that the time
 				// has passed.
 				pthread_mutex_lock(timed_wait->passed_lock);
@@ -89,18 +74,15 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 				pthread_mutex_unlock(timed_wait->passed_lock);
 			}
 
-			timed_wait_prev = timed_wait;
-			timed_wait = timed_wait->next;
+			timed_wait->removed = true;
 		}
-
-		_setting_time = false;
 	}
 }
 
 int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *lock, uint64_t time_us)
 {
-	// A TimedWait object might still be in timed_waits_ after we return, so its lifetime needs to be
-	// longer. And using thread_local is more efficient than malloc.
+	// A TimedWait object is referenced from the heap while waiting (and after we return if the
+	// thread gets canceled), so its lifetime needs to be longer. And using thread_local is more efficient than malloc.
 	static thread_local TimedWait timed_wait;
 	{
 		std::lock_guard<std::mutex> lock_timed_waits(_timed_waits_mutex);
@@ -115,13 +97,9 @@ int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *loc
 		timed_wait.passed_lock = lock;
 		timed_wait.timeout = false;
 		timed_wait.done = false;
+		timed_wait.removed = false;
 
-		// Add to linked list if not removed yet (otherwise just re-use the object)
-		if (timed_wait.removed) {
-			timed_wait.removed = false;
-			timed_wait.next = _timed_waits;
-			_timed_waits = &timed_wait;
-		}
+		push_timed_wait(&timed_wait);
 	}
 
 	int result = pthread_cond_wait(cond, lock);
@@ -134,20 +112,26 @@ int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *loc
 
 	timed_wait.done = true;
 
-	if (!timeout && _setting_time) {
-		// This is where it gets tricky: the timeout has not been triggered yet,
-		// and another thread is in set_absolute_time().
-		// If it already passed the 'done' check, it will access the mutex and
-		// the condition variable next. However they might be invalid as soon as we
-		// return here, so we wait until set_absolute_time() is done.
-		// In addition we have to unlock 'lock', otherwise we risk a
-		// deadlock due to a different locking order in set_absolute_time().
-		// Note that this case does not happen too frequently, and thus can be
-		// a bit more expensive.
-		pthread_mutex_unlock(lock);
-		_timed_waits_mutex.lock();
-		_timed_waits_mutex.unlock();
-		pthread_mutex_lock(lock);
+	if (!timeout) {
+		// We got woken up before the deadline, so the wait is still in the heap and
+		// set_absolute_time() could access the mutex and the condition variable later on.
+		// They might be invalid as soon as we return here, so take it out of the heap now.
+		// If set_absolute_time() is currently running, we have to unlock 'lock' first,
+		// otherwise we risk a deadlock due to a different locking order in set_absolute_time().
+		// If it already picked up this wait, it is removed by the time we get the lock.
+		if (_timed_waits_mutex.try_lock()) {
+			remove_timed_wait(&timed_wait);
+			_timed_waits_mutex.unlock();
+
+		} else {
+			pthread_mutex_unlock(lock);
+			_timed_waits_mutex.lock();
+			remove_timed_wait(&timed_wait);
+			_timed_waits_mutex.unlock();
+			pthread_mutex_lock(lock);
+		}
+
+		timed_wait.removed = true;
 	}
 
 	return result;
@@ -171,3 +155,81 @@ int LockstepScheduler::usleep_until(uint64_t time_us)
 
 	return result;
 }
+
+void LockstepScheduler::push_timed_wait(TimedWait *timed_wait)
+{
+	timed_wait->heap_index = _timed_waits.size();
+	_timed_waits.push_back(timed_wait);
+	sift_up(timed_wait->heap_index);
+}
+
+void LockstepScheduler::remove_timed_wait(TimedWait *timed_wait)
+{
+	const size_t index = timed_wait->heap_index;
+
+	if (index == TimedWait::NOT_QUEUED) {
+		return;
+	}
+
+	const size_t last = _timed_waits.size() - 1;
+
+	if (index != last) {
+		swap_timed_waits(index, last);
+	}
+
+	_timed_waits.pop_back();
+	timed_wait->heap_index = TimedWait::NOT_QUEUED;
+
+	if (index != last) {
+		// the element moved into the gap can be out of order in either direction
+		sift_up(index);
+		sift_down(index);
+	}
+}
+
+void LockstepScheduler::swap_timed_waits(size_t a, size_t b)
+{
+	std::swap(_timed_waits[a], _timed_waits[b]);
+	_timed_waits[a]->heap_index = a;
+	_timed_waits[b]->heap_index = b;
+}
+
+void LockstepScheduler::sift_up(size_t index)
+{
+	while (index > 0) {
+		const size_t parent = (index - 1) / 2;
+
+		if (_timed_waits[parent]->time_us <= _timed_waits[index]->time_us) {
+			break;
+		}
+
+		swap_timed_waits(index, parent);
+		index = parent;
+	}
+}
+
+void LockstepScheduler::sift_down(size_t index)
+{
+	const size_t size = _timed_waits.size();
+
+	while (true) {
+		const size_t left = 2 * index + 1;
+		const size_t right = left + 1;
+		size_t smallest = index;
+
+		if (left < size && _timed_waits[left]->time_us < _timed_waits[smallest]->time_us) {
+			smallest = left;
+		}
+
+		if (right < size && _timed_waits[right]->time_us < _timed_waits[smallest]->time_us) {
+			smallest = right;
+		}
+
+		if (smallest == index) {
+			break;
+		}
+
+		swap_timed_waits(index, smallest);
+		index = smallest;
+	}
+}
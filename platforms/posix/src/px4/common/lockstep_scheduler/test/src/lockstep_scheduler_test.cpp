@@ -307,6 +307,43 @@ void test_usleep()
 	thread.join(ls);
 }
 
+void test_many_usleeps_woken_in_order()
+{
+	LockstepScheduler ls;
+	ls.set_absolute_time(some_time_us);
+
+	constexpr int num_threads = 32;
+	std::atomic<int> num_woken{0};
+	std::atomic<uint64_t> last_wakeup_us{0};
+	std::vector<std::shared_ptr<TestThread>> threads{};
+
+	for (int i = 0; i < num_threads; ++i) {
+		// Spread the deadlines in non-sorted order to exercise the heap ordering.
+		const uint64_t deadline_us = some_time_us + 100 + (i * 7919) % num_threads * 100;
+		threads.push_back(std::make_shared<TestThread>([&ls, &num_woken, &last_wakeup_us, deadline_us]() {
+			EXPECT_EQ(ls.usleep_until(deadline_us), 0);
+			// Only due waits are allowed to wake up, and each step must wake them all.
+			EXPECT_EQ(ls.get_absolute_time(), deadline_us);
+			EXPECT_GE(deadline_us, last_wakeup_us.load());
+			last_wakeup_us = deadline_us;
+			++num_woken;
+		}));
+	}
+
+	// Wait until all threads are queued, otherwise some might see the deadline as passed already.
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	for (int i = 1; i <= num_threads; ++i) {
+		ls.set_absolute_time(some_time_us + i * 100);
+
+		WAIT_FOR(num_woken == i);
+	}
+
+	for (auto &thread : threads) {
+		thread->join(ls);
+	}
+}
+
 TEST(LockstepScheduler, All)
 {
 	for (unsigned iteration = 1; iteration <= 100; ++iteration) {
@@ -316,5 +353,6 @@ TEST(LockstepScheduler, All)
 		test_locked_semaphore_getting_unlocked();
 		test_usleep();
 		test_multiple_semaphores_waiting();
+		test_many_usleeps_woken_in_order();
 	}
 }
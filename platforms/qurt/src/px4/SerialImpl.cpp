@@ -264,6 +264,76 @@ ssize_t SerialImpl::write(const void *buffer, size_t buffer_size)
 	return writeBlocking(buffer, buffer_size, 0);
 }
 
+ssize_t SerialImpl::readv(const struct iovec *iov, int iovcnt)
+{
+	// only read what is already received, read() waits for data otherwise
+	ssize_t bytes_available = bytesAvailable();
+
+	if (bytes_available <= 0) {
+		return bytes_available;
+	}
+
+	ssize_t total_bytes_read = 0;
+
+	for (int i = 0; i < iovcnt && total_bytes_read < bytes_available; i++) {
+		const size_t remaining = bytes_available - total_bytes_read;
+		const size_t length = iov[i].iov_len < remaining ? iov[i].iov_len : remaining;
+		const ssize_t ret = read((uint8_t *)iov[i].iov_base, length);
+
+		if (ret < 0) {
+			return total_bytes_read > 0 ? total_bytes_read : ret;
+		}
+
+		total_bytes_read += ret;
+
+		if ((size_t)ret < length) {
+			break;
+		}
+	}
+
+	return total_bytes_read;
+}
+
+ssize_t SerialImpl::writev(const struct iovec *iov, int iovcnt)
+{
+	ssize_t total_written = 0;
+
+	for (int i = 0; i < iovcnt; i++) {
+		const ssize_t ret = write(iov[i].iov_base, iov[i].iov_len);
+
+		if (ret < 0) {
+			return total_written > 0 ? total_written : ret;
+		}
+
+		total_written += ret;
+
+		if ((size_t)ret < iov[i].iov_len) {
+			break;
+		}
+	}
+
+	return total_written;
+}
+
+int SerialImpl::waitForData(uint32_t timeout_us)
+{
+	// there is no poll() on the QuRT UART, check the receive buffer periodically
+	const hrt_abstime start_time_us = hrt_absolute_time();
+
+	do {
+		const ssize_t bytes_available = bytesAvailable();
+
+		if (bytes_available != 0) {
+			return bytes_available > 0 ? 1 : -1;
+		}
+
+		px4_usleep(1000);
+
+	} while (hrt_elapsed_time(&start_time_us) < timeout_us);
+
+	return 0;
+}
+
 ssize_t SerialImpl::writeBlocking(const void *buffer, size_t buffer_size, uint32_t timeout_ms)
 {
 	if (!_open) {
@@ -110,11 +110,9 @@ bool CanardHandle::init()
 
 void CanardHandle::receive()
 {
-	/* Process received messages */
+	/* Process received messages, the interface provides the payload buffer */
 
-	uint8_t data[64] {};
 	CanardRxFrame received_frame{};
-	received_frame.frame.payload = &data;
 
 	while (_can_interface->receive(&received_frame) > 0) {
 		CanardRxTransfer receive{};
@@ -60,6 +60,7 @@ public:
 
 	/// Receive a CanardFrame
 	/// This function is blocking
+	/// The payload points into the interface's receive buffer and stays valid until the next call.
 	/// The return value is number of bytes received, negative value on error.
 	virtual int16_t receive(CanardRxFrame *rxf) = 0;
 
@@ -33,6 +33,7 @@
 
 #include "CanardNuttXCDev.hpp"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <poll.h>
 
@@ -118,34 +119,44 @@ int16_t CanardNuttXCDev::receive(CanardRxFrame *received_frame)
 		return -1;
 	}
 
-	// File desriptor for CAN.
-	struct pollfd fds {};
-	fds.fd = _fd;
-	fds.events = POLLIN;
+	if (_rx_offset >= _rx_length) {
+		// The character driver returns as many complete messages as fit into the buffer, so a burst of
+		// frames costs one read() instead of a poll() and a read() per frame. The descriptor is non-blocking.
+		_rx_offset = 0;
+		_rx_length = 0;
 
-	// Any recieved CAN messages will cause the poll statement to unblock and run
-	// This way CAN read runs with minimal latency.
-	// Note that multiple messages may be received in a short time, so this will try to read any availible in a loop
-	::poll(&fds, 1, 0);
+		const ssize_t nbytes = ::read(_fd, _rx_buffer, sizeof(_rx_buffer));
 
-	// Only execute this part if can0 is changed.
-	if (fds.revents & POLLIN) {
+		if (nbytes < 0) {
+			return (errno == EAGAIN) ? 0 : -1;
+		}
 
-		// Try to read.
-		struct can_msg_s receive_msg;
-		const ssize_t nbytes = ::read(fds.fd, &receive_msg, sizeof(receive_msg));
+		_rx_length = nbytes;
+	}
 
-		if (nbytes < 0 || (size_t)nbytes < CAN_MSGLEN(0) || (size_t)nbytes > sizeof(receive_msg)) {
-			// error
-			return -1;
+	if (_rx_length - _rx_offset < CAN_MSGLEN(0)) {
+		// error
+		_rx_offset = _rx_length;
+		return (_rx_length == 0) ? 0 : -1;
+	}
 
-		} else {
-			received_frame->frame.extended_can_id = receive_msg.cm_hdr.ch_id;
-			received_frame->frame.payload_size = receive_msg.cm_hdr.ch_dlc;
-			memcpy((void *)received_frame->frame.payload, receive_msg.cm_data, receive_msg.cm_hdr.ch_dlc);
-			return nbytes;
-		}
+	// messages are packed by their actual length, so only the first one is guaranteed to be aligned
+	struct can_hdr_s header;
+	memcpy(&header, &_rx_buffer[_rx_offset], sizeof(header));
+
+	const size_t msg_len = CAN_MSGLEN(header.ch_dlc);
+
+	if (_rx_offset + msg_len > _rx_length) {
+		// error
+		_rx_offset = _rx_length;
+		return -1;
 	}
 
-	return 0;
+	received_frame->frame.extended_can_id = header.ch_id;
+	received_frame->frame.payload_size = header.ch_dlc;
+	received_frame->frame.payload = &_rx_buffer[_rx_offset + CAN_MSGLEN(0)];
+
+	_rx_offset += msg_len;
+
+	return msg_len;
 }
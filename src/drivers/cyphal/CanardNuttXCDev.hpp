@@ -36,6 +36,7 @@
 #include <px4_platform_common/px4_config.h>
 
 #include <canard.h>
+#include <nuttx/can/can.h>
 
 #include "CanardInterface.hpp"
 
@@ -62,6 +63,13 @@ public:
 	int16_t receive(CanardRxFrame *rxf);
 
 private:
+	static constexpr size_t RX_BUFFER_MESSAGES = 8;
+
 	int _fd{-1};
 	bool _can_fd{false};
+
+	// messages of the last read(), packed back to back as returned by the CAN character driver
+	uint8_t _rx_buffer[RX_BUFFER_MESSAGES * sizeof(struct can_msg_s)] {};
+	size_t _rx_length{0};
+	size_t _rx_offset{0};
 };
@@ -44,6 +44,7 @@
 #include <stdbool.h>
 #include <inttypes.h>
 
+#include <px4_boardconfig.h>
 #include <px4_platform_common/time.h>
 #include <queue.h>
 
@@ -84,6 +85,10 @@ typedef struct hrt_call {
 	hrt_callout		usr_callout;
 	void			*usr_arg;
 #endif
+#if defined(CONFIG_HRT_TIMER_WHEEL)
+	struct hrt_call		*wheel_next;
+	struct hrt_call		**wheel_pprev;
+#endif
 } *hrt_call_t;
 
 
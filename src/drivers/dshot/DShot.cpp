@@ -374,6 +374,31 @@ void DShot::mixerChanged()
 
 bool DShot::updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 			  unsigned num_outputs, unsigned num_control_groups_updated)
+{
+	if (!loadOutputs(outputs, num_outputs)) {
+		return false;
+	}
+
+	up_dshot_trigger();
+
+	return true;
+}
+
+bool DShot::updateOutputsFrame(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+			       unsigned num_control_groups_updated, hrt_abstime &trigger_time)
+{
+	if (!loadOutputs(outputs, num_outputs)) {
+		return false;
+	}
+
+	// all channels of all timers go out with one DMA trigger
+	trigger_time = hrt_absolute_time();
+	up_dshot_trigger();
+
+	return true;
+}
+
+bool DShot::loadOutputs(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs)
 {
 	if (!_outputs_on) {
 		return false;
@@ -425,8 +450,6 @@ bool DShot::updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 		}
 	}
 
-	up_dshot_trigger();
-
 	return true;
 }
 
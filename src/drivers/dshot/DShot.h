@@ -93,8 +93,16 @@ public:
 	bool updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 			   unsigned num_outputs, unsigned num_control_groups_updated) override;
 
+	bool updateOutputsFrame(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+				unsigned num_control_groups_updated, hrt_abstime &trigger_time) override;
+
 private:
 
+	/**
+	 * Load the DShot frames of all channels into the DMA buffers, without sending them
+	 */
+	bool loadOutputs(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs);
+
 	/** Disallow copy construction and move assignment. */
 	DShot(const DShot &) = delete;
 	DShot operator=(const DShot &) = delete;
@@ -198,6 +198,7 @@ private:
 	float				_rate{0.0f};					///< position update rate
 	float				_rtcm_injection_rate{0.0f};			///< RTCM message injection rate
 	unsigned			_rtcm_injection_rate_message_count{0};		///< counter for number of RTCM messages
+	unsigned			_rtcm_injection_failures{0};			///< RTCM messages not (completely) written to the device
 	unsigned			_num_bytes_read{0}; 				///< counter for number of read bytes from the UART (within update interval)
 	unsigned			_rate_reading{0}; 				///< reading rate in B/s
 	hrt_abstime			_last_rtcm_injection_time{0};			///< time of last rtcm injection
@@ -473,8 +474,10 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 
 		const ssize_t read_at_least = math::min(character_count, buf_length);
 
-		// handle injection data before read if caught up
-		if (_uart.bytesAvailable() < read_at_least) {
+		// handle injection data before read if caught up, or before the RTCM queue overflows
+		// (a receiver streaming at a high rate is rarely caught up)
+		if (_uart.bytesAvailable() < read_at_least
+		    || _orb_inject_data_sub[_selected_rtcm_instance].updates_available() >= gps_inject_data_s::ORB_QUEUE_LENGTH / 2) {
 			handleInjectDataTopic();
 		}
 
@@ -593,7 +596,9 @@ void GPS::handleInjectDataTopic()
 				* But as we don't write anywhere else to the device during operation, we don't
 				* need to assemble the message first.
 				*/
-				injectData(msg.data, msg.len);
+				if (!injectData(msg.data, msg.len)) {
+					++_rtcm_injection_failures;
+				}
 
 				++_rtcm_injection_rate_message_count;
 				_last_rtcm_injection_time = hrt_absolute_time();
@@ -622,7 +627,12 @@ bool GPS::injectData(uint8_t *data, size_t len)
 	size_t written = 0;
 
 	if (_interface == GPSHelper::Interface::UART) {
-		written = _uart.write((const void *) data, len);
+		// a burst of corrections can exceed the TX buffer, a partially written RTCM message is lost.
+		// Wait up to the transfer time (10 bits per byte) plus a margin for the buffer to drain.
+		const unsigned baudrate = _baudrate == 0 ? 115200 : _baudrate;
+		const uint32_t timeout_ms = len * 10 * 1000 / baudrate + 5;
+		const ssize_t ret = _uart.writeBlocking((const void *) data, len, timeout_ms);
+		written = ret > 0 ? ret : 0;
 
 #ifdef __PX4_LINUX
 
@@ -1188,6 +1198,10 @@ GPS::print_status()
 		PX4_INFO("rate publication:\t\t%6.2f Hz", (double)_rate);
 		PX4_INFO("rate RTCM injection:\t%6.2f Hz", (double)_rtcm_injection_rate);
 
+		if (_rtcm_injection_failures > 0) {
+			PX4_INFO("RTCM injection failures:\t%u", _rtcm_injection_failures);
+		}
+
 		print_message(ORB_ID(sensor_gps), _sensor_gps);
 	}
 
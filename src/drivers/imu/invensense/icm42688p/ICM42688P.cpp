@@ -77,6 +77,9 @@ ICM42688P::~ICM42688P()
 	perf_free(_fifo_empty_perf);
 	perf_free(_fifo_overflow_perf);
 	perf_free(_fifo_reset_perf);
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	perf_free(_fifo_process_overrun_perf);
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 	perf_free(_drdy_missed_perf);
 }
 
@@ -119,6 +122,9 @@ void ICM42688P::print_status()
 	perf_print_counter(_fifo_empty_perf);
 	perf_print_counter(_fifo_overflow_perf);
 	perf_print_counter(_fifo_reset_perf);
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	perf_print_counter(_fifo_process_overrun_perf);
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 	perf_print_counter(_drdy_missed_perf);
 }
 
@@ -532,7 +538,20 @@ uint16_t ICM42688P::FIFOReadCount()
 
 bool ICM42688P::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples)
 {
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	const uint8_t buffer_index = _fifo_buffer_write;
+
+	if (_fifo_buffer_pending.load() & (1 << buffer_index)) {
+		// previous block hasn't been processed yet
+		perf_count(_fifo_process_overrun_perf);
+		return false;
+	}
+
+	FIFOTransferBuffer &buffer = _fifo_buffer[buffer_index];
+	buffer = FIFOTransferBuffer{};
+#else
 	FIFOTransferBuffer buffer{};
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 	const size_t transfer_size = math::min(samples * sizeof(FIFO::DATA) + 4, FIFO::SIZE);
 	SelectRegisterBank(REG_BANK_SEL_BIT::BANK_SEL_0);
 
@@ -611,8 +630,17 @@ bool ICM42688P::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples)
 
 	if (valid_samples > 0) {
 		if (ProcessTemperature(buffer.f, valid_samples)) {
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+			// hand the block over to the rate_ctrl work queue
+			_fifo_buffer_timestamp_sample[buffer_index] = timestamp_sample;
+			_fifo_buffer_samples[buffer_index] = valid_samples;
+			_fifo_buffer_write = buffer_index ^ 1;
+			_fifo_buffer_pending.fetch_or(1 << buffer_index);
+			_fifo_process_work_item.ScheduleNow();
+#else
 			ProcessGyro(timestamp_sample, buffer.f, valid_samples);
 			ProcessAccel(timestamp_sample, buffer.f, valid_samples);
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 			return true;
 		}
 	}
@@ -620,6 +648,24 @@ bool ICM42688P::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples)
 	return false;
 }
 
+void ICM42688P::FIFOProcess()
+{
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	// process filled buffers in order
+	while (_fifo_buffer_pending.load() & (1 << _fifo_buffer_process)) {
+		const uint8_t buffer_index = _fifo_buffer_process;
+
+		ProcessGyro(_fifo_buffer_timestamp_sample[buffer_index], _fifo_buffer[buffer_index].f,
+			    _fifo_buffer_samples[buffer_index]);
+		ProcessAccel(_fifo_buffer_timestamp_sample[buffer_index], _fifo_buffer[buffer_index].f,
+			     _fifo_buffer_samples[buffer_index]);
+
+		_fifo_buffer_process = buffer_index ^ 1;
+		_fifo_buffer_pending.fetch_and(~(1 << buffer_index));
+	}
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
+}
+
 void ICM42688P::FIFOReset()
 {
 	perf_count(_fifo_reset_perf);
@@ -50,6 +50,7 @@
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/i2c_spi_buses.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 
 using namespace InvenSense_ICM42688P;
 
@@ -137,6 +138,7 @@ private:
 	uint16_t FIFOReadCount();
 	bool FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples);
 	void FIFOReset();
+	void FIFOProcess();
 
 	void ProcessAccel(const hrt_abstime &timestamp_sample, const FIFO::DATA fifo[], const uint8_t samples);
 	void ProcessGyro(const hrt_abstime &timestamp_sample, const FIFO::DATA fifo[], const uint8_t samples);
@@ -152,6 +154,9 @@ private:
 	perf_counter_t _fifo_empty_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO empty")};
 	perf_counter_t _fifo_overflow_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO overflow")};
 	perf_counter_t _fifo_reset_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO reset")};
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	perf_counter_t _fifo_process_overrun_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO process overrun")};
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 	perf_counter_t _drdy_missed_perf{nullptr};
 
 	hrt_abstime _reset_timestamp{0};
@@ -221,4 +226,29 @@ private:
 		{ Register::BANK_2::ACCEL_CONFIG_STATIC4, ACCEL_CONFIG_STATIC4_BIT::ACCEL_AAF_BITSHIFT_585HZ_SET | ACCEL_CONFIG_STATIC4_BIT::ACCEL_AAF_DELTSQR_MSB_SET, ACCEL_CONFIG_STATIC4_BIT::ACCEL_AAF_BITSHIFT_585HZ_CLEAR | ACCEL_CONFIG_STATIC4_BIT::ACCEL_AAF_DELTSQR_MSB_CLEAR },
 	};
 	bool isICM686{false};
+
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	// FIFO blocks are processed and published on the rate_ctrl work queue (double buffered),
+	// so the SPI bus work queue is free to read the next block (or other devices on the bus)
+	class FIFOProcessWorkItem : public px4::WorkItem
+	{
+	public:
+		explicit FIFOProcessWorkItem(ICM42688P &driver) : px4::WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
+			_driver(driver) {}
+
+	private:
+		void Run() override { _driver.FIFOProcess(); }
+
+		ICM42688P &_driver;
+	};
+
+	FIFOTransferBuffer _fifo_buffer[2] {};
+	hrt_abstime _fifo_buffer_timestamp_sample[2] {};
+	uint8_t _fifo_buffer_samples[2] {};
+	px4::atomic<uint8_t> _fifo_buffer_pending{0}; // bitmask of filled buffers waiting to be processed
+	uint8_t _fifo_buffer_write{0};
+	uint8_t _fifo_buffer_process{0};
+
+	FIFOProcessWorkItem _fifo_process_work_item{*this};
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 };
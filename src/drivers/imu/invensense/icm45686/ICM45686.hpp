@@ -50,6 +50,7 @@
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/i2c_spi_buses.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 
 using namespace InvenSense_ICM45686;
 
@@ -112,6 +113,7 @@ private:
 	uint16_t FIFOReadCount();
 	bool FIFORead(const hrt_abstime &timestamp_sample);
 	void FIFOReset();
+	void FIFOProcess();
 
 	void ProcessAccel(const hrt_abstime &timestamp_sample, const FIFO::DATA fifo[], const uint8_t samples);
 	void ProcessGyro(const hrt_abstime &timestamp_sample, const FIFO::DATA fifo[], const uint8_t samples);
@@ -125,6 +127,9 @@ private:
 	perf_counter_t _fifo_empty_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO empty")};
 	perf_counter_t _fifo_overflow_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO overflow")};
 	perf_counter_t _fifo_reset_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO reset")};
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	perf_counter_t _fifo_process_overrun_perf{perf_alloc(PC_COUNT, MODULE_NAME": FIFO process overrun")};
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 
 	hrt_abstime _reset_timestamp{0};
 	hrt_abstime _last_config_check_timestamp{0};
@@ -162,4 +167,29 @@ private:
 		{ Register::BANK_0::RTC_CONFIG, 0, 0}, // RTC_MODE[5] set at runtime
 		{ Register::BANK_0::IOC_PAD_SCENARIO_OVRD, 0, 0}, // PADS_INT2_CFG_OVRD and PADS_INT2_CFG_OVRD_VAL set at runtime
 	};
+
+#if defined(CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER)
+	// FIFO blocks are processed and published on the rate_ctrl work queue (double buffered),
+	// so the SPI bus work queue is free to read the next block (or other devices on the bus)
+	class FIFOProcessWorkItem : public px4::WorkItem
+	{
+	public:
+		explicit FIFOProcessWorkItem(ICM45686 &driver) : px4::WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
+			_driver(driver) {}
+
+	private:
+		void Run() override { _driver.FIFOProcess(); }
+
+		ICM45686 &_driver;
+	};
+
+	FIFOTransferBuffer _fifo_buffer[2] {};
+	hrt_abstime _fifo_buffer_timestamp_sample[2] {};
+	uint8_t _fifo_buffer_samples[2] {};
+	px4::atomic<uint8_t> _fifo_buffer_pending{0}; // bitmask of filled buffers waiting to be processed
+	uint8_t _fifo_buffer_write{0};
+	uint8_t _fifo_buffer_process{0};
+
+	FIFOProcessWorkItem _fifo_process_work_item{*this};
+#endif // CONFIG_DRIVERS_IMU_INVENSENSE_FIFO_DOUBLE_BUFFER
 };
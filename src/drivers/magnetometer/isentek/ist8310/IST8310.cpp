@@ -180,75 +180,77 @@ void IST8310::RunImpl()
 		ScheduleDelayed(20_ms); // Wait at least 6ms. (minimum waiting time for 16 times internal average setup)
 		break;
 
-	case STATE::READ: {
-			struct TransferBuffer {
-				uint8_t STAT1;
-				uint8_t DATAXL;
-				uint8_t DATAXH;
-				uint8_t DATAYL;
-				uint8_t DATAYH;
-				uint8_t DATAZL;
-				uint8_t DATAZH;
-			} buffer{};
-
-			bool success = false;
-			uint8_t cmd = static_cast<uint8_t>(Register::STAT1);
+	case STATE::READ:
+		// queue the data read, executed back to back with the other devices on the bus
+		_read_timestamp = now;
+		_read_buffer = {};
+
+		if (transferQueued(&_read_cmd, 1, (uint8_t *)&_read_buffer, sizeof(_read_buffer), &IST8310::ReadCallback,
+				   this) != PX4_OK) {
+			ReadComplete(PX4_ERROR);
+		}
 
-			if (transfer(&cmd, 1, (uint8_t *)&buffer, sizeof(buffer)) == PX4_OK) {
+		break;
+	}
+}
 
-				if (buffer.STAT1 & STAT1_BIT::DRDY) {
-					int16_t x = combine(buffer.DATAXH, buffer.DATAXL);
-					int16_t y = combine(buffer.DATAYH, buffer.DATAYL);
-					int16_t z = combine(buffer.DATAZH, buffer.DATAZL);
+void IST8310::ReadComplete(int result)
+{
+	bool success = false;
 
-					// sensor's frame is +x forward, +y right, +z up
-					z = (z == INT16_MIN) ? INT16_MAX : -z; // flip z
+	if (result == PX4_OK) {
+		if (_read_buffer.STAT1 & STAT1_BIT::DRDY) {
+			int16_t x = combine(_read_buffer.DATAXH, _read_buffer.DATAXL);
+			int16_t y = combine(_read_buffer.DATAYH, _read_buffer.DATAYL);
+			int16_t z = combine(_read_buffer.DATAZH, _read_buffer.DATAZL);
 
-					_px4_mag.set_error_count(perf_event_count(_bad_register_perf) + perf_event_count(_bad_transfer_perf));
-					_px4_mag.update(now, x, y, z);
+			// sensor's frame is +x forward, +y right, +z up
+			z = (z == INT16_MIN) ? INT16_MAX : -z; // flip z
 
-					success = true;
+			_px4_mag.set_error_count(perf_event_count(_bad_register_perf) + perf_event_count(_bad_transfer_perf));
+			_px4_mag.update(_read_timestamp, x, y, z);
 
-					if (_failure_count > 0) {
-						_failure_count--;
-					}
-				}
+			success = true;
 
-			} else {
-				perf_count(_bad_transfer_perf);
+			if (_failure_count > 0) {
+				_failure_count--;
 			}
+		}
 
-			if (!success) {
-				_failure_count++;
+	} else {
+		perf_count(_bad_transfer_perf);
+	}
 
-				// full reset if things are failing consistently
-				if (_failure_count > 10) {
-					Reset();
-					return;
-				}
-			}
+	if (!success) {
+		_failure_count++;
 
-			if (!success || hrt_elapsed_time(&_last_config_check_timestamp) > 100_ms) {
-				// check configuration registers periodically or immediately following any failure
-				if (RegisterCheck(_register_cfg[_checked_register])) {
-					_last_config_check_timestamp = now;
-					_checked_register = (_checked_register + 1) % size_register_cfg;
-
-				} else {
-					// register check failed, force reset
-					perf_count(_bad_register_perf);
-					Reset();
-					return;
-				}
-			}
+		// full reset if things are failing consistently
+		if (_failure_count > 10) {
+			Reset();
+			return;
+		}
+	}
 
-			// initiate next measurement
-			RegisterWrite(Register::CNTL1, CNTL1_BIT::MODE_SINGLE_MEASUREMENT);
-			ScheduleDelayed(20_ms); // Wait at least 6ms. (minimum waiting time for 16 times internal average setup)
+	if (!success || hrt_elapsed_time(&_last_config_check_timestamp) > 100_ms) {
+		// check configuration registers periodically or immediately following any failure
+		if (RegisterCheck(_register_cfg[_checked_register])) {
+			_last_config_check_timestamp = _read_timestamp;
+			_checked_register = (_checked_register + 1) % size_register_cfg;
+
+		} else {
+			// register check failed, force reset
+			perf_count(_bad_register_perf);
+			Reset();
+			return;
 		}
+	}
 
-		break;
+	// initiate next measurement
+	if (transferQueued(_measure_cmd, sizeof(_measure_cmd), nullptr, 0) != PX4_OK) {
+		RegisterWrite(Register::CNTL1, CNTL1_BIT::MODE_SINGLE_MEASUREMENT);
 	}
+
+	ScheduleDelayed(20_ms); // Wait at least 6ms. (minimum waiting time for 16 times internal average setup)
 }
 
 bool IST8310::Configure()
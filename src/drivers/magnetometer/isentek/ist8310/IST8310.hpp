@@ -83,6 +83,20 @@ private:
 	void RegisterWrite(Register reg, uint8_t value);
 	void RegisterSetAndClearBits(Register reg, uint8_t setbits, uint8_t clearbits);
 
+	static void ReadCallback(void *arg, int result) { static_cast<IST8310 *>(arg)->ReadComplete(result); }
+	void ReadComplete(int result);
+
+	// Transfer data
+	struct TransferBuffer {
+		uint8_t STAT1;
+		uint8_t DATAXL;
+		uint8_t DATAXH;
+		uint8_t DATAYL;
+		uint8_t DATAYH;
+		uint8_t DATAZL;
+		uint8_t DATAZH;
+	};
+
 	PX4Magnetometer _px4_mag;
 
 	perf_counter_t _bad_register_perf{perf_alloc(PC_COUNT, MODULE_NAME": bad register")};
@@ -93,6 +107,12 @@ private:
 	hrt_abstime _last_config_check_timestamp{0};
 	int _failure_count{0};
 
+	// queued bus transactions (data read and next measurement trigger)
+	TransferBuffer _read_buffer{};
+	hrt_abstime _read_timestamp{0};
+	const uint8_t _read_cmd{static_cast<uint8_t>(Register::STAT1)};
+	const uint8_t _measure_cmd[2] {static_cast<uint8_t>(Register::CNTL1), CNTL1_BIT::MODE_SINGLE_MEASUREMENT};
+
 	enum class STATE : uint8_t {
 		RESET,
 		WAIT_FOR_RESET,
@@ -47,6 +47,7 @@
 #define PCA9685_DEFAULT_MODE2_CFG PCA9685_MODE2_OUTDRV_MASK
 
 using namespace drv_pca9685_pwm;
+using namespace time_literals;
 
 PCA9685::PCA9685(int bus, int addr):
 	I2C(DRV_PWM_DEVTYPE_PCA9685, MODULE_NAME, bus, addr, 400000),
@@ -109,7 +110,7 @@ int PCA9685::updatePWM(const uint16_t *outputs, unsigned num_outputs)
 		out[i] = calcRawFromPulse(out[i]);
 	}
 
-	return writePWM(0, out, num_outputs);
+	return writeChangedPWM(out, num_outputs);
 }
 
 int PCA9685::updateFreq(float freq)
@@ -134,7 +135,11 @@ int PCA9685::updateFreq(float freq)
 
 int PCA9685::updateRAW(const uint16_t *outputs, unsigned int num_outputs)
 {
-	return writePWM(0, outputs, num_outputs);
+	if (num_outputs > PCA9685_PWM_CHANNEL_COUNT) {
+		num_outputs = PCA9685_PWM_CHANNEL_COUNT;
+	}
+
+	return writeChangedPWM(outputs, num_outputs);
 }
 
 int PCA9685::setAllPWM(uint16_t output)
@@ -146,6 +151,7 @@ int PCA9685::setAllPWM(uint16_t output)
 		(uint8_t)(val & (uint8_t)0xFF),
 		val != 0 ? (uint8_t)(val >> 8) : (uint8_t)PCA9685_LED_ON_FULL_ON_OFF_MASK
 	};
+	lastWrittenMask = 0;
 	return transfer(buf, sizeof(buf), nullptr, 0);
 }
 
@@ -214,6 +220,52 @@ int PCA9685::writePWM(uint8_t idx, const uint16_t *value, uint8_t num)
 	return transfer(buf, num * PCA9685_REG_LED_INCREMENT + 1, nullptr, 0);
 }
 
+int PCA9685::writeChangedPWM(const uint16_t *value, unsigned num)
+{
+	// rewrite everything once a second, in case a register got corrupted
+	if (hrt_elapsed_time(&lastFullWrite) > 1_s) {
+		lastWrittenMask = 0;
+	}
+
+	unsigned first = num;
+	unsigned last = 0;
+
+	for (unsigned i = 0; i < num; ++i) {
+		if (!(lastWrittenMask & (1 << i)) || value[i] != lastWritten[i]) {
+			if (first == num) {
+				first = i;
+			}
+
+			last = i;
+		}
+	}
+
+	if (first == num) {
+		// nothing changed
+		return PX4_OK;
+	}
+
+	// with auto increment the span is a single burst, which the PCA9685 applies at the I2C STOP
+	const unsigned count = last - first + 1;
+	const uint16_t span_mask = ((1 << count) - 1) << first;
+
+	if (first == 0 && count == num) {
+		lastFullWrite = hrt_absolute_time();
+	}
+
+	const int ret = writePWM(first, &value[first], count);
+
+	if (ret == PX4_OK) {
+		memcpy(&lastWritten[first], &value[first], count * sizeof(uint16_t));
+		lastWrittenMask |= span_mask;
+
+	} else {
+		lastWrittenMask &= ~span_mask;
+	}
+
+	return ret;
+}
+
 int PCA9685::setDivider(uint8_t value)
 {
 	uint8_t buf[2] = {};
@@ -34,6 +34,7 @@
 #pragma once
 #include <cstdint>
 #include <drivers/device/i2c.h>
+#include <drivers/drv_hrt.h>
 #include <px4_boardconfig.h>
 
 #define PCA9685_REG_MODE1 0x00			// Mode  register  1
@@ -169,8 +170,17 @@ protected:
 	 */
 	int writePWM(uint8_t idx, const uint16_t *value, uint8_t num);
 
+	/*
+	 * Write only the span from the first to the last channel that differs from what was written before
+	 */
+	int writeChangedPWM(const uint16_t *value, unsigned num);
+
 private:
 	float currentFreq;
+
+	uint16_t lastWritten[PCA9685_PWM_CHANNEL_COUNT] {};
+	uint16_t lastWrittenMask{0};	// channels with a known register content
+	hrt_abstime lastFullWrite{0};
 };
 
 }
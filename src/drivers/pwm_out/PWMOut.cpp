@@ -127,6 +127,30 @@ bool PWMOut::update_pwm_out_state(bool on)
 
 bool PWMOut::updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 			   unsigned num_outputs, unsigned num_control_groups_updated)
+{
+	hrt_abstime trigger_time;
+	return updateOutputsFrame(outputs, num_outputs, num_control_groups_updated, trigger_time);
+}
+
+bool PWMOut::updateOutputsFrame(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+				unsigned num_control_groups_updated, hrt_abstime &trigger_time)
+{
+	// load all compare registers first, then fire the whole frame
+	loadOutputs(outputs, num_outputs);
+
+	trigger_time = hrt_absolute_time();
+
+	/* Trigger all timer's channels in Oneshot mode to fire
+	 * the oneshots with updated values.
+	 */
+	if (num_control_groups_updated > 0) {
+		up_pwm_update(_pwm_mask);
+	}
+
+	return true;
+}
+
+void PWMOut::loadOutputs(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs)
 {
 	/* output to the servos */
 	if (_pwm_initialized) {
@@ -141,15 +165,6 @@ bool PWMOut::updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 			}
 		}
 	}
-
-	/* Trigger all timer's channels in Oneshot mode to fire
-	 * the oneshots with updated values.
-	 */
-	if (num_control_groups_updated > 0) {
-		up_pwm_update(_pwm_mask);
-	}
-
-	return true;
 }
 
 void PWMOut::Run()
@@ -74,9 +74,14 @@ public:
 	bool updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 			   unsigned num_outputs, unsigned num_control_groups_updated) override;
 
+	bool updateOutputsFrame(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+				unsigned num_control_groups_updated, hrt_abstime &trigger_time) override;
+
 private:
 	void Run() override;
 
+	void loadOutputs(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs);
+
 	void update_params();
 	bool update_pwm_out_state(bool on);
 
@@ -108,7 +108,7 @@ public:
 	 * Initialize all class variables.
 	 */
 	PX4IO() = delete;
-	explicit PX4IO(device::Device *interface);
+	explicit PX4IO(PX4IO_serial *interface);
 
 	~PX4IO() override;
 
@@ -168,7 +168,7 @@ private:
 
 	static constexpr int PX4IO_MAX_ACTUATORS = 8;
 
-	device::Device *const _interface;
+	PX4IO_serial *const _interface;
 
 	unsigned		_hardware{0};		///< Hardware revision
 	unsigned		_max_actuators{0};		///< Maximum # of actuators supported by PX4IO
@@ -181,6 +181,9 @@ private:
 
 	hrt_abstime		_poll_last{0};
 
+	uint16_t		_cycle_regs[PX4IO_P_CYCLE_COUNT] {};	///< status and RC input of the last output cycle
+	hrt_abstime		_cycle_last{0};		///< time of the last successful output cycle
+
 	orb_advert_t		_mavlink_log_pub{nullptr};	///< mavlink log pub
 
 	perf_counter_t	_cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
@@ -241,16 +244,18 @@ private:
 	 * Fetch status and alarms from IO
 	 *
 	 * Also publishes battery voltage/current.
+	 *
+	 * @param cycle_regs	Reply of the last PX4IO_PAGE_CYCLE transaction, or nullptr to read from IO.
 	 */
-	int			io_get_status();
+	int			io_get_status(const uint16_t *cycle_regs = nullptr);
 
 	/**
 	 * Fetch RC inputs from IO.
 	 *
-	 * @param input_rc	Input structure to populate.
+	 * @param cycle_regs	Reply of the last PX4IO_PAGE_CYCLE transaction, or nullptr to read from IO.
 	 * @return		OK if data was returned.
 	 */
-	int			io_publish_raw_rc();
+	int			io_publish_raw_rc(const uint16_t *cycle_regs = nullptr);
 
 	/**
 	 * write register(s)
@@ -273,6 +278,20 @@ private:
 	 */
 	int			io_reg_set(uint8_t page, uint8_t offset, const uint16_t value);
 
+	/**
+	 * write register(s) and read the registers of the reply in a single transaction
+	 *
+	 * @param page		Register page to write to.
+	 * @param offset	Register offset to start writing at.
+	 * @param values	Pointer to array of values to write.
+	 * @param num_values	The number of values to write.
+	 * @param reply_values	Pointer to array where the reply should be stored.
+	 * @param num_reply_values	The number of values in the reply.
+	 * @return		OK if all values were written and the reply was read.
+	 */
+	int			io_reg_exchange(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values,
+						uint16_t *reply_values, unsigned num_reply_values);
+
 	/**
 	 * read register(s)
 	 *
@@ -341,7 +360,7 @@ private:
 
 #define PX4IO_DEVICE_PATH	"/dev/px4io"
 
-PX4IO::PX4IO(device::Device *interface) :
+PX4IO::PX4IO(PX4IO_serial *interface) :
 	CDev(PX4IO_DEVICE_PATH),
 	OutputModuleInterface(MODULE_NAME, px4::serial_port_to_wq(PX4IO_SERIAL_DEVICE)),
 	_interface(interface)
@@ -371,8 +390,10 @@ bool PX4IO::updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 	}
 
 	if (!_test_fmu_fail) {
-		/* output to the servos */
-		io_reg_set(PX4IO_PAGE_DIRECT_PWM, 0, outputs, num_outputs);
+		/* output to the servos, the reply contains the status and RC input */
+		if (io_reg_exchange(PX4IO_PAGE_CYCLE, 0, outputs, num_outputs, _cycle_regs, PX4IO_P_CYCLE_COUNT) == OK) {
+			_cycle_last = hrt_absolute_time();
+		}
 	}
 
 	return true;
@@ -528,11 +549,14 @@ void PX4IO::Run()
 		/* run at 50 */
 		_poll_last = hrt_absolute_time();
 
+		/* use the status and RC input from the last output cycle if it is recent, read it from IO otherwise */
+		const uint16_t *cycle_regs = (hrt_elapsed_time(&_cycle_last) < 20_ms) ? _cycle_regs : nullptr;
+
 		/* pull status and alarms from IO */
-		io_get_status();
+		io_get_status(cycle_regs);
 
 		/* get raw R/C input from IO */
-		io_publish_raw_rc();
+		io_publish_raw_rc(cycle_regs);
 	}
 
 	/* check updates on uORB topics and handle it */
@@ -915,17 +939,27 @@ int PX4IO::dsm_bind_ioctl(int dsmMode)
 	return ret;
 }
 
-int PX4IO::io_get_status()
+int PX4IO::io_get_status(const uint16_t *cycle_regs)
 {
 	/* get
 	 * STATUS_FLAGS, STATUS_ALARMS, STATUS_VBATT, STATUS_IBATT,
 	 * STATUS_VSERVO, STATUS_VRSSI
 	 * in that order */
 	uint16_t regs[6] {};
-	int ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &regs[0], sizeof(regs) / sizeof(regs[0]));
+	int ret = OK;
 
-	if (ret != OK) {
-		return ret;
+	if (cycle_regs) {
+		regs[0] = cycle_regs[PX4IO_P_CYCLE_STATUS_FLAGS];
+		regs[1] = cycle_regs[PX4IO_P_CYCLE_STATUS_ALARMS];
+		regs[4] = cycle_regs[PX4IO_P_CYCLE_STATUS_VSERVO];
+		regs[5] = cycle_regs[PX4IO_P_CYCLE_STATUS_VRSSI];
+
+	} else {
+		ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &regs[0], sizeof(regs) / sizeof(regs[0]));
+
+		if (ret != OK) {
+			return ret;
+		}
 	}
 
 	const uint16_t STATUS_FLAGS  = regs[0];
@@ -947,7 +981,8 @@ int PX4IO::io_get_status()
 		_analog_rc_rssi_stable = true;
 	}
 
-	const uint16_t SETUP_ARMING = io_reg_get(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING);
+	const uint16_t SETUP_ARMING = cycle_regs ? cycle_regs[PX4IO_P_CYCLE_SETUP_ARMING] : io_reg_get(PX4IO_PAGE_SETUP,
+				      PX4IO_P_SETUP_ARMING);
 
 	if ((hrt_elapsed_time(&_last_status_publish) >= 1_s)
 	    || (_status != STATUS_FLAGS)
@@ -1024,9 +1059,12 @@ int PX4IO::io_get_status()
 	return ret;
 }
 
-int PX4IO::io_publish_raw_rc()
+int PX4IO::io_publish_raw_rc(const uint16_t *cycle_regs)
 {
-	const uint16_t rc_valid_update_count = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_FRAME_COUNT);
+	const uint16_t *cycle_raw_rc = cycle_regs ? &cycle_regs[PX4IO_P_CYCLE_RAW_RC] : nullptr;
+
+	const uint16_t rc_valid_update_count = cycle_raw_rc ? cycle_raw_rc[PX4IO_P_RAW_FRAME_COUNT] : io_reg_get(
+			PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_FRAME_COUNT);
 	const bool rc_updated = (rc_valid_update_count != _rc_valid_update_count);
 	_rc_valid_update_count = rc_valid_update_count;
 
@@ -1054,10 +1092,18 @@ int PX4IO::io_publish_raw_rc()
 	 *
 	 * This should be the common case (9 channel R/C control being a reasonable upper bound).
 	 */
-	int ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
+	int ret = OK;
 
-	if (ret != OK) {
-		return ret;
+	if (cycle_raw_rc) {
+		static_assert(PX4IO_P_CYCLE_RC_CHANNELS >= input_rc_s::RC_INPUT_MAX_CHANNELS, "cycle reply too small");
+		memcpy(regs, cycle_raw_rc, sizeof(regs));
+
+	} else {
+		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
+
+		if (ret != OK) {
+			return ret;
+		}
 	}
 
 	/*
@@ -1102,7 +1148,7 @@ int PX4IO::io_publish_raw_rc()
 	/* FIELDS NOT SET HERE */
 	/* input_rc.input_source is set after this call XXX we might want to mirror the flags in the RC struct */
 
-	if (channel_count > 9) {
+	if (channel_count > 9 && !cycle_raw_rc) {
 		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + 9, &regs[prolog + 9], channel_count - 9);
 
 		if (ret != OK) {
@@ -1181,6 +1227,27 @@ int PX4IO::io_reg_set(uint8_t page, uint8_t offset, uint16_t value)
 	return io_reg_set(page, offset, &value, 1);
 }
 
+int PX4IO::io_reg_exchange(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values,
+			   uint16_t *reply_values, unsigned num_reply_values)
+{
+	/* range check the transfer */
+	if (num_values > ((_max_transfer) / sizeof(*values))) {
+		PX4_DEBUG("io_reg_exchange: too many registers (%u, max %u)", num_values, _max_transfer / 2);
+		return -EINVAL;
+	}
+
+	perf_begin(_interface_write_perf);
+	int ret = _interface->exchange((page << 8) | offset, values, num_values, reply_values, num_reply_values);
+	perf_end(_interface_write_perf);
+
+	if (ret != (int)num_reply_values) {
+		PX4_DEBUG("io_reg_exchange(%" PRIu8 ",%" PRIu8 ",%u): error %d", page, offset, num_values, ret);
+		return -1;
+	}
+
+	return OK;
+}
+
 int PX4IO::io_reg_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values)
 {
 	/* range check the transfer */
@@ -1402,9 +1469,9 @@ int PX4IO::ioctl(file *filep, int cmd, unsigned long arg)
 	return ret;
 }
 
-static device::Device *get_interface()
+static PX4IO_serial *get_interface()
 {
-	device::Device *interface = PX4IO_serial_interface();
+	PX4IO_serial *interface = PX4IO_serial_interface();
 
 	if (interface != nullptr) {
 		if (interface->init() != OK) {
@@ -1427,7 +1494,7 @@ int PX4IO::checkcrc(int argc, char *argv[])
 		return 1;
 	}
 
-	device::Device *interface = get_interface();
+	PX4IO_serial *interface = get_interface();
 
 	if (interface == nullptr) {
 		PX4_ERR("interface allocation failed");
@@ -1519,7 +1586,7 @@ int PX4IO::bind(int argc, char *argv[])
 
 int PX4IO::task_spawn(int argc, char *argv[])
 {
-	device::Device *interface = get_interface();
+	PX4IO_serial *interface = get_interface();
 
 	if (interface == nullptr) {
 		PX4_ERR("Failed to create interface");
@@ -1577,7 +1644,7 @@ int PX4IO::custom_command(int argc, char *argv[])
 
 		while (ret != OK && retries < MAX_RETRIES) {
 
-			device::Device *interface = get_interface();
+			PX4IO_serial *interface = get_interface();
 
 			if (interface == nullptr) {
 				PX4_ERR("interface allocation failed");
@@ -43,7 +43,7 @@
 
 static PX4IO_serial *g_interface;
 
-device::Device
+PX4IO_serial
 *PX4IO_serial_interface()
 {
 	return new ArchPX4IOSerial();
@@ -151,6 +151,74 @@ PX4IO_serial::write(unsigned address, void *data, unsigned count)
 	return result;
 }
 
+int
+PX4IO_serial::exchange(unsigned address, const void *data, unsigned count, void *reply, unsigned reply_count)
+{
+	uint8_t page = address >> 8;
+	uint8_t offset = address & 0xff;
+	const uint16_t *values = reinterpret_cast<const uint16_t *>(data);
+
+	if (count > PKT_MAX_REGS || reply_count > PKT_MAX_REGS) {
+		return -EINVAL;
+	}
+
+	px4_sem_wait(&_bus_semaphore);
+
+	int result;
+
+	for (unsigned retries = 0; retries < 3; retries++) {
+		_io_buffer_ptr->count_code = count | PKT_CODE_WRITE;
+		_io_buffer_ptr->page = page;
+		_io_buffer_ptr->offset = offset;
+		memcpy((void *)&_io_buffer_ptr->regs[0], (void *)values, (2 * count));
+
+		for (unsigned i = count; i < PKT_MAX_REGS; i++) {
+			_io_buffer_ptr->regs[i] = 0x55aa;
+		}
+
+		_io_buffer_ptr->crc = 0;
+		_io_buffer_ptr->crc = crc_packet(_io_buffer_ptr);
+
+		/* start the transaction and wait for it to complete */
+		result = _bus_exchange(_io_buffer_ptr);
+
+		/* successful transaction? */
+		if (result == OK) {
+
+			/* check result in packet */
+			if (PKT_CODE(*_io_buffer_ptr) == PKT_CODE_ERROR) {
+
+				/* IO didn't like it - no point retrying */
+				result = -EINVAL;
+				perf_count(_pc_protoerrs);
+
+			} else if (PKT_COUNT(*_io_buffer_ptr) != reply_count) {
+
+				/* the write succeeded, but IO returned the wrong number of registers */
+				result = -EIO;
+				perf_count(_pc_protoerrs);
+
+			} else {
+
+				/* copy back the reply */
+				memcpy(reply, &_io_buffer_ptr->regs[0], (2 * reply_count));
+			}
+
+			break;
+		}
+
+		perf_count(_pc_retries);
+	}
+
+	px4_sem_post(&_bus_semaphore);
+
+	if (result == OK) {
+		result = reply_count;
+	}
+
+	return result;
+}
+
 int
 PX4IO_serial::read(unsigned address, void *data, unsigned count)
 {
@@ -36,6 +36,7 @@
 #include "crsf_telemetry.h"
 #include <uORB/topics/vehicle_command_ack.h>
 
+#include <poll.h>
 #include <termios.h>
 
 using namespace time_literals;
@@ -46,7 +47,8 @@ RCInput::RCInput(const char *device) :
 	ModuleParams(nullptr),
 	ScheduledWorkItem(MODULE_NAME, px4::serial_port_to_wq(device)),
 	_cycle_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle time")),
-	_publish_interval_perf(perf_alloc(PC_INTERVAL, MODULE_NAME": publish interval"))
+	_publish_interval_perf(perf_alloc(PC_INTERVAL, MODULE_NAME": publish interval")),
+	_publish_latency_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": publish latency"))
 {
 	// initialize raw_rc values and count
 	for (unsigned i = 0; i < input_rc_s::RC_INPUT_MAX_CHANNELS; i++) {
@@ -76,6 +78,7 @@ RCInput::~RCInput()
 
 	perf_free(_cycle_perf);
 	perf_free(_publish_interval_perf);
+	perf_free(_publish_latency_perf);
 }
 
 int
@@ -464,13 +467,23 @@ void RCInput::Run()
 
 		unsigned frame_drops = 0;
 
-		// TODO: needs work (poll _rcs_fd)
-		// int ret = poll(fds, sizeof(fds) / sizeof(fds[0]), 100);
-		// then update priority to SCHED_PRIORITY_FAST_DRIVER
-		// read all available data from the serial RC input UART
+		// Once locked onto a serial protocol wait for the next frame instead of sampling the UART at a fixed
+		// rate. With RX DMA the serial driver hands over received data when the line goes idle, which is the
+		// end of a frame for all supported protocols, so a frame is decoded right after its last byte.
+		// This runs on the work queue of the RC UART, blocking it for up to one update interval is fine.
+		const bool wait_for_data = _rc_scan_locked && (_rc_scan_state != RC_SCAN_PPM);
+		int poll_ret = 0;
+
+		if (wait_for_data) {
+			pollfd fds{};
+			fds.fd = _rcs_fd;
+			fds.events = POLLIN;
+			poll_ret = ::poll(&fds, 1, _current_update_interval / 1000);
+		}
 
 		// read all available data from the serial RC input UART
 		int newBytes = ::read(_rcs_fd, &_rcs_buf[0], RC_MAX_BUFFER_SIZE);
+		const hrt_abstime rx_timestamp = hrt_absolute_time();
 
 		if (newBytes > 0) {
 			_bytes_rx += newBytes;
@@ -841,6 +854,10 @@ void RCInput::Run()
 
 			_input_rc_pub.publish(_input_rc);
 
+			if (wait_for_data) {
+				perf_set_elapsed(_publish_latency_perf, hrt_elapsed_time(&rx_timestamp));
+			}
+
 		} else if (!rc_updated && !_armed && (hrt_elapsed_time(&_input_rc.timestamp_last_signal) > 1_s)) {
 			_rc_scan_locked = false;
 		}
@@ -858,6 +875,28 @@ void RCInput::Run()
 			_param_rc_input_proto.set(_rc_scan_state);
 			_param_rc_input_proto.commit();
 		}
+
+		// switch between waiting on the UART (locked) and the fixed interval (scanning, PPM)
+		const bool wait_next = _rc_scan_locked && (_rc_scan_state != RC_SCAN_PPM);
+
+		if (wait_next) {
+			if (!_wait_for_data) {
+				ScheduleClear();
+			}
+
+			if (poll_ret > 0 && newBytes <= 0) {
+				// readable without data (e.g. an error condition), don't spin on it
+				ScheduleDelayed(_current_update_interval);
+
+			} else {
+				ScheduleNow();
+			}
+
+		} else if (_wait_for_data) {
+			ScheduleOnInterval(_current_update_interval);
+		}
+
+		_wait_for_data = wait_next;
 	}
 }
 
@@ -932,7 +971,12 @@ int RCInput::custom_command(int argc, char *argv[])
 
 int RCInput::print_status()
 {
-	PX4_INFO("Max update rate: %u Hz", 1000000 / _current_update_interval);
+	if (_wait_for_data) {
+		PX4_INFO("Update: on received data");
+
+	} else {
+		PX4_INFO("Max update rate: %u Hz", 1000000 / _current_update_interval);
+	}
 
 	if (_device[0] != '\0') {
 		PX4_INFO("UART device: %s", _device);
@@ -989,6 +1033,7 @@ int RCInput::print_status()
 
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_publish_interval_perf);
+	perf_print_counter(_publish_latency_perf);
 
 	if (hrt_elapsed_time(&_input_rc.timestamp) < 1_s) {
 		print_message(ORB_ID(input_rc), _input_rc);
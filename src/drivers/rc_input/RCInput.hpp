@@ -133,6 +133,7 @@ private:
 
 	bool _initialized{false};
 	bool _rc_scan_locked{false};
+	bool _wait_for_data{false}; ///< locked onto a serial protocol, Run() is driven by received data
 
 	static constexpr unsigned	_current_update_interval{4000}; // 250 Hz
 
@@ -163,6 +164,7 @@ private:
 
 	perf_counter_t	_cycle_perf;
 	perf_counter_t	_publish_interval_perf;
+	perf_counter_t	_publish_latency_perf;		///< frame readable (line idle) to input_rc published
 	uint32_t	_bytes_rx{0};
 
 	DEFINE_PARAMETERS(
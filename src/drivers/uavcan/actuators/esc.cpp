@@ -53,6 +53,10 @@ UavcanEscController::UavcanEscController(uavcan::INode &node) :
 	_uavcan_sub_status(node)
 {
 	_uavcan_pub_raw_cmd.setPriority(uavcan::TransferPriority::NumericallyMin); // Highest priority
+
+	// A command that could not be sent within one update period is superseded by the next one. Dropping it
+	// instead of queueing it for the default 100 ms keeps a congested bus from falling further behind.
+	_uavcan_pub_raw_cmd.setTxTimeout(uavcan::MonotonicDuration::fromUSec(1000000 / MAX_RATE_HZ));
 }
 
 int
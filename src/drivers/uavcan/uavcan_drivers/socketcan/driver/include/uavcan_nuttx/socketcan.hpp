@@ -68,8 +68,26 @@ class CanIface : public uavcan::ICanIface
 	struct cmsghdr     *_recv_cmsg {};
 	uint8_t            _recv_control[sizeof(struct cmsghdr) + sizeof(struct timeval)] {};
 
+	//// Frames drained from the socket in one go, handed to libuavcan one per receive()
+	static constexpr unsigned RX_BATCH_SIZE = 8;
+
+	struct RxItem {
+		uavcan::CanFrame      frame;
+		uavcan::MonotonicTime ts_monotonic;
+	};
+
+	RxItem             _rx_batch[RX_BATCH_SIZE] {};
+	unsigned           _rx_batch_count{0};
+	unsigned           _rx_batch_index{0};
+
 	SystemClock clock;
 
+	/**
+	 * Reads one frame from the socket.
+	 * @return 1 on success, 0 if the frame was dropped, negative on error (e.g. no more frames)
+	 */
+	int readFrame(RxItem &item);
+
 public:
 	uavcan::uint32_t socketInit(uint32_t index);
 
@@ -90,6 +108,11 @@ public:
 	uavcan::uint16_t getNumFilters() const override;
 
 	int getFD();
+
+	/**
+	 * Whether frames of the last batch are still waiting to be received.
+	 */
+	bool hasBufferedRx() const { return _rx_batch_index < _rx_batch_count; }
 };
 
 /**
@@ -40,6 +40,7 @@
  *
  ****************************************************************************/
 
+#include <px4_platform_common/px4_config.h>
 #include <uavcan_nuttx/socketcan.hpp>
 #include <uavcan_nuttx/clock.hpp>
 #include <uavcan/util/templates.hpp>
@@ -75,8 +76,12 @@ uavcan::uint32_t CanIface::socketInit(uint32_t index)
 	struct sockaddr_can addr;
 	struct ifreq ifr;
 
-	//FIXME Change this when we update to DroneCAN with CAN FD support
-	bool can_fd = 0;
+#if defined(CONFIG_UAVCAN_SOCKETCAN_CANFD) && defined(CONFIG_NET_CAN_CANFD)
+	// libuavcan frames are still at most 8 bytes, CAN FD only shortens them with the faster data phase
+	const bool can_fd = true;
+#else
+	const bool can_fd = false;
+#endif
 
 	_can_fd = can_fd;
 
@@ -181,6 +186,7 @@ uavcan::int16_t CanIface::send(const uavcan::CanFrame &frame, uavcan::MonotonicT
 	if (_can_fd) {
 		_send_frame.can_id = frame.id | CAN_EFF_FLAG;
 		_send_frame.len = frame.dlc;
+		_send_frame.flags = CANFD_BRS;
 		memcpy(&_send_frame.data, frame.data, frame.dlc);
 
 	} else {
@@ -204,48 +210,92 @@ uavcan::int16_t CanIface::send(const uavcan::CanFrame &frame, uavcan::MonotonicT
 	}
 }
 
-uavcan::int16_t CanIface::receive(uavcan::CanFrame &out_frame, uavcan::MonotonicTime &out_ts_monotonic,
-				  uavcan::UtcTime &out_ts_utc, uavcan::CanIOFlags &out_flags)
+int CanIface::readFrame(RxItem &item)
 {
+	_recv_msg.msg_controllen = sizeof(_recv_control);
+
 	int32_t result = recvmsg(_fd, &_recv_msg, MSG_DONTWAIT);
 
 	if (result < 0) {
 		return result;
 	}
 
-	/* Copy SocketCAN frame to CanardFrame */
+	/* Copy SocketCAN frame to CanFrame */
 
 	if (_can_fd) {
 		struct canfd_frame *recv_frame = (struct canfd_frame *)&_recv_frame;
-		out_frame.id = recv_frame->can_id;
 
-		if (recv_frame->len > CANFD_MAX_DLEN) {
-			return -EFAULT;
+		// DroneCAN v0 frames carry at most 8 bytes, anything larger is not ours
+		if (recv_frame->len > uavcan::CanFrame::MaxDataLen) {
+			return 0;
 		}
 
-		out_frame.dlc = recv_frame->len;
-		memcpy(out_frame.data, &recv_frame->data, recv_frame->len);
+		item.frame.id = recv_frame->can_id;
+		item.frame.dlc = recv_frame->len;
+		memcpy(item.frame.data, &recv_frame->data, recv_frame->len);
 
 	} else {
 		struct can_frame *recv_frame = (struct can_frame *)&_recv_frame;
-		out_frame.id = recv_frame->can_id;
 
 		if (recv_frame->can_dlc > CAN_MAX_DLEN) {
 			return -EFAULT;
 		}
 
-		out_frame.dlc = recv_frame->can_dlc;
-		memcpy(out_frame.data, &recv_frame->data, recv_frame->can_dlc);
+		item.frame.id = recv_frame->can_id;
+		item.frame.dlc = recv_frame->can_dlc;
+		memcpy(item.frame.data, &recv_frame->data, recv_frame->can_dlc);
 	}
 
 	/* Read SO_TIMESTAMP value */
 
 	if (_recv_cmsg->cmsg_level == SOL_SOCKET && _recv_cmsg->cmsg_type == SO_TIMESTAMP) {
 		struct timeval *tv = (struct timeval *)CMSG_DATA(_recv_cmsg);
-		out_ts_monotonic = uavcan::MonotonicTime::fromUSec(tv->tv_sec * 1000000ULL + tv->tv_usec);
+		item.ts_monotonic = uavcan::MonotonicTime::fromUSec(tv->tv_sec * 1000000ULL + tv->tv_usec);
+
+	} else {
+		item.ts_monotonic = uavcan::MonotonicTime();
+	}
+
+	return 1;
+}
+
+uavcan::int16_t CanIface::receive(uavcan::CanFrame &out_frame, uavcan::MonotonicTime &out_ts_monotonic,
+				  uavcan::UtcTime &out_ts_utc, uavcan::CanIOFlags &out_flags)
+{
+	if (!hasBufferedRx()) {
+		// Drain what the socket has in one go, so that a burst of frames (e.g. ESC status of all motors)
+		// costs one poll() in select() instead of one per frame. Dropped frames count against the batch
+		// size as well, which bounds the time spent here.
+		_rx_batch_index = 0;
+		_rx_batch_count = 0;
+
+		for (unsigned i = 0; i < RX_BATCH_SIZE; i++) {
+			const int result = readFrame(_rx_batch[_rx_batch_count]);
+
+			if (result < 0) {
+				if (_rx_batch_count == 0 && i == 0) {
+					return result;
+				}
+
+				break;
+			}
+
+			_rx_batch_count += result;
+		}
+
+		if (_rx_batch_count == 0) {
+			return 0;
+		}
+	}
+
+	const RxItem &item = _rx_batch[_rx_batch_index++];
+	out_frame = item.frame;
+
+	if (!item.ts_monotonic.isZero()) {
+		out_ts_monotonic = item.ts_monotonic;
 	}
 
-	return result;
+	return 1;
 }
 
 
@@ -315,9 +365,23 @@ uavcan::int16_t CanDriver::select(uavcan::CanSelectMasks &inout_masks,
 		timeout_usec = 0;
 	}
 
+	const uavcan::uint8_t pending_write = inout_masks.write;
 	inout_masks.read = 0;
 	inout_masks.write = 0;
 
+	for (int i = 0; i < UAVCAN_SOCKETCAN_NUM_IFACES; i++) {
+		if (if_[i].hasBufferedRx()) {
+			inout_masks.read |= 1U << i;
+		}
+	}
+
+	if (inout_masks.read != 0) {
+		// Hand out the rest of the last batch without polling again. Sending never blocks, a frame the
+		// socket does not take stays in the libuavcan TX queue.
+		inout_masks.write = pending_write;
+		return 0;
+	}
+
 	if (poll(pfds, UAVCAN_SOCKETCAN_NUM_IFACES, timeout_usec / 1000) > 0) {
 		for (int i = 0; i < UAVCAN_SOCKETCAN_NUM_IFACES; i++) {
 			if (pfds[i].revents & POLLIN) {
@@ -56,10 +56,12 @@ public:
 		return sz;
 	}
 
+	bool queued(T node) const { return (node->next_intrusive_queue_node() != nullptr) || (node == _tail); }
+
 	void push(T newNode)
 	{
 		// error, node already queued or already inserted
-		if ((newNode->next_intrusive_queue_node() != nullptr) || (newNode == _tail)) {
+		if (queued(newNode)) {
 			return;
 		}
 
@@ -74,6 +76,23 @@ public:
 		_tail = newNode;
 	}
 
+	void push_front(T newNode)
+	{
+		// error, node already queued or already inserted
+		if (queued(newNode)) {
+			return;
+		}
+
+		if (_tail == nullptr) {
+			_tail = newNode;
+
+		} else {
+			newNode->set_next_intrusive_queue_node(_head);
+		}
+
+		_head = newNode;
+	}
+
 	T pop()
 	{
 		T ret = _head;
@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Byte ring buffer with lock-free writers (multiple producers, from any context including interrupts).
+ *
+ * Writes never block and never fail: the oldest data is overwritten once the buffer is full.
+ * Readers use absolute positions and skip data that got overwritten while they were reading.
+ * Data becomes visible to readers once all concurrent writes have completed.
+ */
+template<size_t SIZE>
+class LockFreeByteRing
+{
+	// positions are 32 bit and wrap after 4 GB, which misplaces up to SIZE bytes once if SIZE is not a power of 2
+	static_assert(SIZE > 0 && SIZE < (1u << 30), "invalid SIZE");
+
+public:
+
+	void write(const char *data, size_t len)
+	{
+		if (len == 0) {
+			return;
+		}
+
+		if (len > SIZE) {
+			// only the end fits
+			data += len - SIZE;
+			len = SIZE;
+		}
+
+		const uint32_t start = _head.fetch_add(len);
+		const size_t index = start % SIZE;
+		const size_t first = (len < SIZE - index) ? len : SIZE - index;
+
+		memcpy(_buffer + index, data, first);
+		memcpy(_buffer, data + first, len - first);
+
+		// published once no write is in progress anymore (all reserved bytes are committed)
+		const uint32_t committed = _committed.fetch_add(len) + len;
+
+		if (committed == _head.load()) {
+			uint32_t stable = _stable.load();
+
+			while (((int32_t)(committed - stable) > 0) && !_stable.compare_exchange(&stable, committed)) {}
+		}
+	}
+
+	/**
+	 * Number of bytes available to read
+	 */
+	int size() const
+	{
+		const uint32_t stable = _stable.load();
+		return (stable < SIZE) ? stable : SIZE;
+	}
+
+	/**
+	 * Read from the position in offset, -1 for the oldest data
+	 * @return number of bytes read, offset is advanced accordingly
+	 */
+	int read(char *buffer, int buffer_length, int *offset) const
+	{
+		if (buffer_length <= 0) {
+			return 0;
+		}
+
+		uint32_t position = (*offset == -1) ? oldest(_stable.load()) : (uint32_t) * offset;
+
+		// retry if a writer overwrote the data while copying (only under heavy write load)
+		for (int retry = 0; retry < 3; retry++) {
+			const uint32_t stable = _stable.load();
+			const uint32_t head = _head.load();
+
+			if ((int32_t)(head - SIZE - position) > 0) {
+				// skip what got overwritten
+				position = head - SIZE;
+			}
+
+			if ((int32_t)(stable - position) <= 0) {
+				*offset = (int)position;
+				return 0;
+			}
+
+			const uint32_t available = stable - position;
+			const size_t len = (available < (uint32_t)buffer_length) ? available : buffer_length;
+			const size_t index = position % SIZE;
+			const size_t first = (len < SIZE - index) ? len : SIZE - index;
+
+			memcpy(buffer, _buffer + index, first);
+			memcpy(buffer + first, _buffer, len - first);
+
+			if ((int32_t)(_head.load() - SIZE - position) <= 0) {
+				*offset = (int)(position + len);
+				return (int)len;
+			}
+		}
+
+		return 0;
+	}
+
+private:
+
+	static uint32_t oldest(uint32_t stable) { return (stable < SIZE) ? 0 : stable - SIZE; }
+
+	char _buffer[SIZE] {};
+
+	px4::atomic<uint32_t> _head{0};      ///< total bytes reserved by writers
+	px4::atomic<uint32_t> _committed{0}; ///< total bytes of completed writes
+	px4::atomic<uint32_t> _stable{0};    ///< all bytes before this position are written
+};
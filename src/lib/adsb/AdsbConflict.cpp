@@ -46,11 +46,6 @@ void AdsbConflict::detect_traffic_conflict(double lat_now, double lon_now, float
 		float vz_now)
 
 {
-
-	float d_hor, d_vert;
-	get_distance_to_point_global_wgs84(lat_now, lon_now, alt_now,
-					   _transponder_report.lat, _transponder_report.lon, _transponder_report.altitude, &d_hor, &d_vert);
-
 	const float xyz_traffic_speed = sqrtf(_transponder_report.hor_velocity * _transponder_report.hor_velocity +
 					      _transponder_report.ver_velocity * _transponder_report.ver_velocity);
 
@@ -60,6 +55,15 @@ void AdsbConflict::detect_traffic_conflict(double lat_now, double lon_now, float
 	//assume always pointing at each other
 	const float relative_uav_traffic_speed = xyz_traffic_speed + xyz_uav_speed;
 
+	if (traffic_out_of_reach(lat_now, lon_now, alt_now, relative_uav_traffic_speed)) {
+		_conflict_detected = false;
+		return;
+	}
+
+	float d_hor, d_vert;
+	get_distance_to_point_global_wgs84(lat_now, lon_now, alt_now,
+					   _transponder_report.lat, _transponder_report.lon, _transponder_report.altitude, &d_hor, &d_vert);
+
 
 	// Predict until the vehicle would have passed this system at its current speed
 	const float prediction_distance = d_hor + TRAFFIC_TO_UAV_DISTANCE_EXTENSION;
@@ -92,6 +96,26 @@ void AdsbConflict::detect_traffic_conflict(double lat_now, double lon_now, float
 			      && collision_time_check);
 }
 
+bool AdsbConflict::traffic_out_of_reach(double lat_now, double lon_now, float alt_now, float relative_speed) const
+{
+	if (fabsf(alt_now - _transponder_report.altitude) >= _conflict_detection_params.vertical_separation) {
+		return true;
+	}
+
+	if (relative_speed <= FLT_EPSILON) {
+		return true;
+	}
+
+	// flat earth distance, well within the margin at the ranges ADS-B traffic is received
+	const float d_hor = get_distance_to_next_waypoint_fast(lat_now, lon_now, _transponder_report.lat,
+			    _transponder_report.lon);
+
+	// lower bound of the time to closest approach, closing at the sum of both speeds
+	const float reach = relative_speed * _conflict_detection_params.collision_time_threshold / TRAFFIC_REACH_MARGIN;
+
+	return d_hor > reach;
+}
+
 int AdsbConflict::find_icao_address_in_conflict_list(uint32_t icao_address)
 {
 
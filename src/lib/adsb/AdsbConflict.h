@@ -54,7 +54,7 @@
 
 using namespace time_literals;
 
-static constexpr uint8_t NAVIGATOR_MAX_TRAFFIC{10};
+static constexpr uint8_t NAVIGATOR_MAX_TRAFFIC{32};
 
 static constexpr uint8_t UTM_CALLSIGN_LENGTH{9};
 
@@ -66,6 +66,8 @@ static constexpr uint64_t TRAFFIC_WARNING_TIMESTEP{60_s}; //limits the max warni
 
 static constexpr uint64_t TRAFFIC_CONFLICT_LIFETIME{120_s}; //limits the time a conflict can be in the buffer without being seen (as a conflict)
 
+static constexpr float TRAFFIC_REACH_MARGIN{0.9f}; //tolerated error of the flat earth distance used to pre-filter traffic out of reach
+
 struct traffic_data_s {
 	double lat_traffic;
 	double lon_traffic;
@@ -145,6 +147,17 @@ protected:
 
 private:
 
+	/**
+	 * Cheap pre-filter run before the full conflict prediction.
+	 * Rejects traffic outside the vertical separation and traffic that, even when both vehicles fly straight at
+	 * each other, cannot close the distance within the collision time threshold. The horizontal distance is taken
+	 * on a local flat earth grid around the vehicle, so only contacts close enough to pass this check pay for the
+	 * geodesic crosstrack computation.
+	 *
+	 * @return true if the traffic cannot be in conflict
+	 */
+	bool traffic_out_of_reach(double lat_now, double lon_now, float alt_now, float relative_speed) const;
+
 	crosstrack_error_s _crosstrack_error{};
 
 	transponder_report_s tr{};
@@ -104,6 +104,11 @@ TEST_F(AdsbConflictTest, trafficAlerts)
 	full_buffer.timestamp.push_back(1000_s);
 	full_buffer.timestamp.push_back(58943_s);
 
+	for (uint32_t i = full_buffer.icao_address.size(); i < NAVIGATOR_MAX_TRAFFIC; i++) {
+		full_buffer.icao_address.push_back(100000 + i);
+		full_buffer.timestamp.push_back(58943_s);
+	}
+
 	struct traffic_buffer_s empty_buffer = {};
 
 	TestAdsbConflict 	adsb_conflict;
@@ -238,6 +243,11 @@ TEST_F(AdsbConflictTest, trafficReminder)
 	full_buffer.timestamp.push_back(100_s);
 	full_buffer.timestamp.push_back(5843_s);
 
+	for (uint32_t i = full_buffer.icao_address.size(); i < NAVIGATOR_MAX_TRAFFIC; i++) {
+		full_buffer.icao_address.push_back(100000 + i);
+		full_buffer.timestamp.push_back(5843_s);
+	}
+
 	TestAdsbConflict 	adsb_conflict;
 
 	// GIVEN buffer with 8685 at t=100
@@ -312,3 +322,31 @@ TEST_F(AdsbConflictTest, trafficReminder)
 	printf("adsb_conflict._traffic_state %d \n", (int)adsb_conflict._traffic_state);
 	EXPECT_TRUE(adsb_conflict._traffic_state == TRAFFIC_STATE::ADD_CONFLICT);
 }
+
+TEST_F(AdsbConflictTest, detectTrafficConflictAcrossAntimeridian)
+{
+	TestAdsbConflict 	adsb_conflict;
+
+	adsb_conflict.set_conflict_detection_params(500.0f, 500.0f, 60, 1);
+
+	// GIVEN traffic 2km east of the vehicle across the antimeridian, flying west towards it
+	adsb_conflict._transponder_report.lat = 0.0;
+	adsb_conflict._transponder_report.lon = -179.99;
+	adsb_conflict._transponder_report.altitude = 1000.0f;
+	adsb_conflict._transponder_report.heading = -M_PI_2_F;
+	adsb_conflict._transponder_report.hor_velocity = 50.0f;
+	adsb_conflict._transponder_report.ver_velocity = 0.0f;
+
+	// WHEN detect traffic conflict is called
+	adsb_conflict.detect_traffic_conflict(0.0, 179.992, 1000.0f, 0.0f, 0.0f, 0.0f);
+
+	// THEN expect the conflict not to be filtered out as far away traffic
+	EXPECT_TRUE(adsb_conflict._conflict_detected);
+
+	// WHEN the same traffic is out of reach within the collision time threshold
+	adsb_conflict._transponder_report.lon = -179.0;
+	adsb_conflict.detect_traffic_conflict(0.0, 179.992, 1000.0f, 0.0f, 0.0f, 0.0f);
+
+	// THEN expect no conflict
+	EXPECT_FALSE(adsb_conflict._conflict_detected);
+}
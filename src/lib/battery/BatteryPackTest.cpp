@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file BatteryPackTest.cpp
+ * Tests for combining multiple battery packs.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include <px4_platform_common/defines.h>
+
+#include "battery_pack.h"
+
+static battery_status_s makeBattery(float voltage_v, float current_a, float remaining, uint16_t capacity)
+{
+	battery_status_s battery{};
+	battery.timestamp = 1000;
+	battery.connected = true;
+	battery.voltage_v = voltage_v;
+	battery.current_a = current_a;
+	battery.discharged_mah = 100.f;
+	battery.remaining = remaining;
+	battery.capacity = capacity;
+	battery.time_remaining_s = NAN;
+	return battery;
+}
+
+TEST(BatteryPack, Empty)
+{
+	BatteryPack pack;
+	const battery_pack_status_s status = pack.combine();
+	EXPECT_EQ(status.pack_count, 0);
+	EXPECT_EQ(status.connected_count, 0);
+	EXPECT_FLOAT_EQ(status.current_a, -1.f);
+	EXPECT_FLOAT_EQ(status.remaining, -1.f);
+	EXPECT_FALSE(PX4_ISFINITE(status.time_remaining_s));
+}
+
+TEST(BatteryPack, ParallelWithCapacity)
+{
+	BatteryPack pack;
+	battery_status_s battery0 = makeBattery(24.f, 10.f, 0.5f, 4000);
+	battery0.time_remaining_s = 300.f;
+	battery0.warning = battery_status_s::WARNING_LOW;
+	battery0.faults = 1 << battery_status_s::FAULT_SPIKES;
+	battery_status_s battery1 = makeBattery(23.5f, 20.f, 0.8f, 6000);
+	battery1.timestamp = 900;
+	battery1.time_remaining_s = 600.f;
+	battery1.faults = 1 << battery_status_s::FAULT_OVER_CURRENT;
+	pack.update(0, battery0);
+	pack.update(1, battery1);
+
+	const battery_pack_status_s status = pack.combine();
+	EXPECT_EQ(status.pack_count, 2);
+	EXPECT_EQ(status.connected_count, 2);
+	EXPECT_EQ(status.connected_mask, 0b11);
+	EXPECT_EQ(status.timestamp_oldest, 900u);
+	EXPECT_FLOAT_EQ(status.voltage_v, 23.5f);
+	EXPECT_FLOAT_EQ(status.current_a, 30.f);
+	EXPECT_FLOAT_EQ(status.discharged_mah, 200.f);
+	EXPECT_FLOAT_EQ(status.capacity_mah, 10000.f);
+	EXPECT_FLOAT_EQ(status.remaining, (0.5f * 4000.f + 0.8f * 6000.f) / 10000.f);
+	EXPECT_FLOAT_EQ(status.time_remaining_s, 300.f);
+	EXPECT_EQ(status.warning, static_cast<uint8_t>(battery_status_s::WARNING_LOW));
+	EXPECT_EQ(status.faults, (1 << battery_status_s::FAULT_SPIKES) | (1 << battery_status_s::FAULT_OVER_CURRENT));
+}
+
+TEST(BatteryPack, UnknownCapacityUsesLowestRemaining)
+{
+	BatteryPack pack;
+	pack.update(0, makeBattery(24.f, -1.f, 0.6f, 4000));
+	pack.update(2, makeBattery(24.f, -1.f, 0.4f, 0));
+
+	const battery_pack_status_s status = pack.combine();
+	EXPECT_EQ(status.pack_count, 2);
+	EXPECT_FLOAT_EQ(status.current_a, -1.f);
+	EXPECT_FLOAT_EQ(status.capacity_mah, 0.f);
+	EXPECT_FLOAT_EQ(status.remaining, 0.4f);
+}
+
+TEST(BatteryPack, DisconnectedPackIgnored)
+{
+	BatteryPack pack;
+	battery_status_s battery1 = makeBattery(10.f, 5.f, 0.1f, 1000);
+	battery1.warning = battery_status_s::WARNING_EMERGENCY;
+	pack.update(0, makeBattery(24.f, 10.f, 0.9f, 1000));
+	pack.update(1, battery1);
+	battery1.connected = false;
+	pack.update(1, battery1);
+
+	const battery_pack_status_s status = pack.combine();
+	EXPECT_EQ(status.pack_count, 2);
+	EXPECT_EQ(status.connected_count, 1);
+	EXPECT_EQ(status.connected_mask, 0b01);
+	EXPECT_FLOAT_EQ(status.voltage_v, 24.f);
+	EXPECT_FLOAT_EQ(status.current_a, 10.f);
+	EXPECT_FLOAT_EQ(status.remaining, 0.9f);
+	EXPECT_EQ(status.warning, static_cast<uint8_t>(battery_status_s::WARNING_NONE));
+}
@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "battery_pack.h"
+
+#include <float.h>
+#include <math.h>
+
+#include <px4_platform_common/defines.h>
+
+void BatteryPack::update(int instance, const battery_status_s &battery)
+{
+	if (instance < 0 || instance >= MAX_PACKS) {
+		return;
+	}
+
+	const uint8_t bit = 1u << instance;
+
+	_pack_mask |= bit;
+
+	if (battery.connected) {
+		_connected_mask |= bit;
+
+	} else {
+		_connected_mask &= ~bit;
+	}
+
+	_timestamp[instance] = battery.timestamp;
+	_voltage_v[instance] = battery.voltage_v;
+	_current_a[instance] = battery.current_a;
+	_discharged_mah[instance] = battery.discharged_mah;
+	_capacity_mah[instance] = battery.capacity;
+	_remaining[instance] = battery.remaining;
+	_time_remaining_s[instance] = battery.time_remaining_s;
+	_warning[instance] = battery.warning;
+	_faults[instance] = battery.faults;
+}
+
+battery_pack_status_s BatteryPack::combine() const
+{
+	battery_pack_status_s pack{};
+	pack.voltage_v = 0.f;
+	pack.current_a = -1.f;
+	pack.remaining = -1.f;
+	pack.time_remaining_s = NAN;
+	pack.warning = battery_status_s::WARNING_NONE;
+	pack.connected_mask = _connected_mask;
+
+	float current_sum = 0.f;
+	bool current_valid = false;
+	float remaining_min = FLT_MAX;
+	float remaining_mah = 0.f;
+	float capacity_mah = 0.f;
+	bool capacity_valid = true;
+
+	for (int i = 0; i < MAX_PACKS; i++) {
+		if ((_pack_mask & (1u << i)) == 0) {
+			continue;
+		}
+
+		pack.pack_count++;
+
+		if ((_connected_mask & (1u << i)) == 0) {
+			continue;
+		}
+
+		if (pack.connected_count == 0 || _timestamp[i] < pack.timestamp_oldest) {
+			pack.timestamp_oldest = _timestamp[i];
+		}
+
+		pack.connected_count++;
+
+		if (pack.connected_count == 1 || _voltage_v[i] < pack.voltage_v) {
+			pack.voltage_v = _voltage_v[i];
+		}
+
+		// the current is -1 if a pack does not measure it
+		if (PX4_ISFINITE(_current_a[i]) && _current_a[i] >= 0.f) {
+			current_sum += _current_a[i];
+			current_valid = true;
+		}
+
+		if (PX4_ISFINITE(_discharged_mah[i]) && _discharged_mah[i] > 0.f) {
+			pack.discharged_mah += _discharged_mah[i];
+		}
+
+		if (_capacity_mah[i] > 0.f && _remaining[i] >= 0.f) {
+			capacity_mah += _capacity_mah[i];
+			remaining_mah += _remaining[i] * _capacity_mah[i];
+
+		} else {
+			capacity_valid = false;
+		}
+
+		if (_remaining[i] >= 0.f && _remaining[i] < remaining_min) {
+			remaining_min = _remaining[i];
+		}
+
+		if (PX4_ISFINITE(_time_remaining_s[i])
+		    && (!PX4_ISFINITE(pack.time_remaining_s) || _time_remaining_s[i] < pack.time_remaining_s)) {
+			pack.time_remaining_s = _time_remaining_s[i];
+		}
+
+		if (_warning[i] > pack.warning) {
+			pack.warning = _warning[i];
+		}
+
+		pack.faults |= _faults[i];
+	}
+
+	if (current_valid) {
+		pack.current_a = current_sum;
+	}
+
+	if (pack.connected_count > 0 && capacity_valid) {
+		pack.capacity_mah = capacity_mah;
+		pack.remaining = remaining_mah / capacity_mah;
+
+	} else if (remaining_min < FLT_MAX) {
+		pack.remaining = remaining_min;
+	}
+
+	return pack;
+}
@@ -0,0 +1,83 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file battery_pack.h
+ *
+ * Combines the battery_status of all battery instances into a single vehicle level pack state.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+#include <uORB/topics/battery_pack_status.h>
+#include <uORB/topics/battery_status.h>
+
+class BatteryPack
+{
+public:
+	static constexpr int MAX_PACKS = battery_status_s::MAX_INSTANCES;
+
+	BatteryPack() = default;
+	~BatteryPack() = default;
+
+	/**
+	 * Store the latest state of a pack
+	 *
+	 * @param instance battery_status instance, [0, MAX_PACKS)
+	 */
+	void update(int instance, const battery_status_s &battery);
+
+	/**
+	 * Combine all packs, assuming they are connected in parallel.
+	 * The values that cannot be summed up are the most conservative of the connected packs.
+	 */
+	battery_pack_status_s combine() const;
+
+private:
+	// structure of arrays, index is the battery_status instance
+	uint8_t _pack_mask{0};
+	uint8_t _connected_mask{0};
+
+	hrt_abstime _timestamp[MAX_PACKS] {};
+	float _voltage_v[MAX_PACKS] {};
+	float _current_a[MAX_PACKS] {};
+	float _discharged_mah[MAX_PACKS] {};
+	float _capacity_mah[MAX_PACKS] {};
+	float _remaining[MAX_PACKS] {};
+	float _time_remaining_s[MAX_PACKS] {};
+	uint8_t _warning[MAX_PACKS] {};
+	uint16_t _faults[MAX_PACKS] {};
+};
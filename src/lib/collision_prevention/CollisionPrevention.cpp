@@ -57,6 +57,26 @@ CollisionPrevention::CollisionPrevention(ModuleParams *parent) :
 	for (uint32_t i = 0 ; i < BIN_COUNT; i++) {
 		_obstacle_map_body_frame.distances[i] = UINT16_MAX;
 	}
+
+	_updateBinGeometry();
+}
+
+void CollisionPrevention::_updateBinGeometry()
+{
+	for (int i = 0; i < BIN_COUNT; i++) {
+		const float angle = math::radians((float)i * BIN_SIZE + _obstacle_map_body_frame.angle_offset);
+		_bin_direction_body[i] = {cosf(angle), sinf(angle)};
+
+		_bin_lower_angle[i] = ObstacleMath::get_lower_bound_angle(i, _obstacle_map_body_frame.increment,
+				      _obstacle_map_body_frame.angle_offset);
+		_bin_upper_angle[i] = ObstacleMath::get_lower_bound_angle(i + 1, _obstacle_map_body_frame.increment,
+				      _obstacle_map_body_frame.angle_offset);
+
+		// if a bin stretches over the 0/360 degree line, adjust the angles
+		if (_bin_lower_angle[i] > _bin_upper_angle[i]) {
+			_bin_lower_angle[i] -= 360;
+		}
+	}
 }
 
 hrt_abstime CollisionPrevention::getTime()
@@ -130,19 +150,21 @@ void CollisionPrevention::_updateObstacleMap()
 		}
 	}
 
-	// add obstacle distance data
-	if (_sub_obstacle_distance.update()) {
-		const obstacle_distance_s &obstacle_distance = _sub_obstacle_distance.get();
-
-		// Update map with obstacle data if the data is not stale
-		if (getElapsedTime(&obstacle_distance.timestamp) < RANGE_STREAM_TIMEOUT_US && obstacle_distance.increment > 0.f) {
-			//update message description
-			_obstacle_map_body_frame.timestamp = math::max(_obstacle_map_body_frame.timestamp, obstacle_distance.timestamp);
-			_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance,
-								obstacle_distance.max_distance);
-			_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
-								obstacle_distance.min_distance);
-			_addObstacleSensorData(obstacle_distance, _vehicle_yaw);
+	// add obstacle distance data, each instance can come with its own resolution and offset
+	for (auto &obstacle_distance_sub : _obstacle_distance_subs) {
+		obstacle_distance_s obstacle_distance;
+
+		if (obstacle_distance_sub.update(&obstacle_distance)) {
+			// Update map with obstacle data if the data is not stale
+			if (getElapsedTime(&obstacle_distance.timestamp) < RANGE_STREAM_TIMEOUT_US && obstacle_distance.increment > 0.f) {
+				//update message description
+				_obstacle_map_body_frame.timestamp = math::max(_obstacle_map_body_frame.timestamp, obstacle_distance.timestamp);
+				_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance,
+									obstacle_distance.max_distance);
+				_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
+									obstacle_distance.min_distance);
+				_addObstacleSensorData(obstacle_distance, _vehicle_yaw);
+			}
 		}
 	}
 
@@ -156,28 +178,32 @@ void CollisionPrevention::_updateObstacleData()
 	_closest_dist = UINT16_MAX;
 	_closest_dist_dir.setZero();
 
+	const hrt_abstime now = getTime();
+	const bool map_stale = (now - _obstacle_map_body_frame.timestamp) >= RANGE_STREAM_TIMEOUT_US;
+	int closest_bin = -1;
+
 	for (int i = 0; i < BIN_COUNT; i++) {
 		// if the data is stale, reset the bin
-		if (getTime() - _data_timestamps[i] > RANGE_STREAM_TIMEOUT_US) {
+		if (now - _data_timestamps[i] > RANGE_STREAM_TIMEOUT_US) {
 			_obstacle_map_body_frame.distances[i] = UINT16_MAX;
 		}
 
-		float angle = wrap_2pi(_vehicle_yaw + math::radians((float)i * BIN_SIZE +
-				       _obstacle_map_body_frame.angle_offset));
-		const Vector2f bin_direction = {cosf(angle), sinf(angle)};
 		const uint16_t bin_distance = _obstacle_map_body_frame.distances[i];
 
 		// check if there is avaliable data and the data of the map is not stale
-		if (bin_distance < UINT16_MAX
-		    && (getTime() - _obstacle_map_body_frame.timestamp) < RANGE_STREAM_TIMEOUT_US) {
+		if (bin_distance < UINT16_MAX && !map_stale) {
 			_obstacle_data_present = true;
 		}
 
 		if (bin_distance * 0.01f < _closest_dist) {
 			_closest_dist = bin_distance * 0.01f;
-			_closest_dist_dir = bin_direction;
+			closest_bin = i;
 		}
 	}
+
+	if (closest_bin >= 0) {
+		_closest_dist_dir = Dcm2f(_vehicle_yaw) * _bin_direction_body[closest_bin];
+	}
 }
 
 void CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint_accel, const Vector2f &setpoint_vel)
@@ -224,99 +250,58 @@ void CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint_accel
 	}
 }
 
-// TODO this gives false output if the offset is not a multiple of the resolution. to be fixed...
 void CollisionPrevention::_addObstacleSensorData(const obstacle_distance_s &obstacle, const float vehicle_yaw)
 {
+	float msg_angle_offset = obstacle.angle_offset;
 
-	float vehicle_orientation_deg = math::degrees(vehicle_yaw);
+	if (obstacle.frame == obstacle.MAV_FRAME_GLOBAL || obstacle.frame == obstacle.MAV_FRAME_LOCAL_NED) {
+		// Obstacle message arrives in local_origin frame (north aligned), rotate it into the body frame
+		msg_angle_offset -= math::degrees(vehicle_yaw);
 
+	} else if (obstacle.frame != obstacle.MAV_FRAME_BODY_FRD) {
+		mavlink_log_critical(&_mavlink_log_pub, "Obstacle message received in unsupported frame %i\t",
+				     obstacle.frame);
+		events::send<uint8_t>(events::ID("col_prev_unsup_frame"), events::Log::Error,
+				      "Obstacle message received in unsupported frame {1}", obstacle.frame);
+		return;
+	}
 
-	if (obstacle.frame == obstacle.MAV_FRAME_GLOBAL || obstacle.frame == obstacle.MAV_FRAME_LOCAL_NED) {
-		// Obstacle message arrives in local_origin frame (north aligned)
-		// corresponding data index (convert to world frame and shift by msg offset)
-		for (int i = 0; i < BIN_COUNT; i++) {
-			for (int j = 0; (j < 360 / obstacle.increment) && (j < BIN_COUNT); j++) {
-				float bin_lower_angle = ObstacleMath::get_lower_bound_angle(i, _obstacle_map_body_frame.increment,
-							_obstacle_map_body_frame.angle_offset);
-				float bin_upper_angle = ObstacleMath::get_lower_bound_angle(i + 1, _obstacle_map_body_frame.increment,
-							_obstacle_map_body_frame.angle_offset);
-				float msg_lower_angle = ObstacleMath::get_lower_bound_angle(j, obstacle.increment,
-							obstacle.angle_offset - vehicle_orientation_deg);
-				float msg_upper_angle = ObstacleMath::get_lower_bound_angle(j + 1, obstacle.increment,
-							obstacle.angle_offset - vehicle_orientation_deg);
-
-				// if a bin stretches over the 0/360 degree line, adjust the angles
-				if (bin_lower_angle > bin_upper_angle) {
-					bin_lower_angle -= 360;
-				}
+	// Merge each message bin into the map bins it overlaps. Only the few map bins around the message bin are
+	// candidates, so sensors of any resolution cost a single pass over their own bins.
+	for (int j = 0; (j < 360 / obstacle.increment) && (j < BIN_COUNT); j++) {
+		if (obstacle.distances[j] == UINT16_MAX) {
+			continue;
+		}
 
-				if (msg_lower_angle > msg_upper_angle) {
-					msg_lower_angle -= 360;
-				}
+		float msg_lower_angle = ObstacleMath::get_lower_bound_angle(j, obstacle.increment, msg_angle_offset);
+		const float msg_upper_angle = ObstacleMath::get_lower_bound_angle(j + 1, obstacle.increment, msg_angle_offset);
 
-				// Check for overlaps.
-				if ((msg_lower_angle > bin_lower_angle && msg_lower_angle < bin_upper_angle) ||
-				    (msg_upper_angle > bin_lower_angle && msg_upper_angle < bin_upper_angle) ||
-				    (msg_lower_angle <= bin_lower_angle && msg_upper_angle >= bin_upper_angle) ||
-				    (msg_lower_angle >= bin_lower_angle && msg_upper_angle <= bin_upper_angle)) {
-					if (obstacle.distances[j] != UINT16_MAX) {
-						if (_enterData(i, obstacle.max_distance * 0.01f, obstacle.distances[j] * 0.01f)) {
-							_obstacle_map_body_frame.distances[i] = obstacle.distances[j];
-							_data_timestamps[i] = _obstacle_map_body_frame.timestamp;
-							_data_maxranges[i] = obstacle.max_distance;
-							_data_fov[i] = 1;
-						}
-					}
-				}
+		int first_bin;
+		const int candidates = ObstacleMath::get_candidate_bins(msg_lower_angle, obstacle.increment,
+				       _obstacle_map_body_frame.increment, _obstacle_map_body_frame.angle_offset, first_bin);
 
-			}
+		// if a bin stretches over the 0/360 degree line, adjust the angles
+		if (msg_lower_angle > msg_upper_angle) {
+			msg_lower_angle -= 360;
 		}
 
-	} else if (obstacle.frame == obstacle.MAV_FRAME_BODY_FRD) {
-		// Obstacle message arrives in body frame (front aligned)
-		// corresponding data index (shift by msg offset)
-		for (int i = 0; i < BIN_COUNT; i++) {
-			for (int j = 0; j < 360 / obstacle.increment; j++) {
-				float bin_lower_angle = ObstacleMath::get_lower_bound_angle(i, _obstacle_map_body_frame.increment,
-							_obstacle_map_body_frame.angle_offset);
-				float bin_upper_angle = ObstacleMath::get_lower_bound_angle(i + 1, _obstacle_map_body_frame.increment,
-							_obstacle_map_body_frame.angle_offset);
-				float msg_lower_angle = ObstacleMath::get_lower_bound_angle(j, obstacle.increment, obstacle.angle_offset);
-				float msg_upper_angle = ObstacleMath::get_lower_bound_angle(j + 1, obstacle.increment, obstacle.angle_offset);
-
-				// if a bin stretches over the 0/360 degree line, adjust the angles
-				if (bin_lower_angle > bin_upper_angle) {
-					bin_lower_angle -= 360;
-				}
+		for (int k = 0; k < candidates; k++) {
+			const int i = ObstacleMath::wrap_bin(first_bin + k, BIN_COUNT);
 
-				if (msg_lower_angle > msg_upper_angle) {
-					msg_lower_angle -= 360;
-				}
+			// Check for overlaps.
+			if ((msg_lower_angle > _bin_lower_angle[i] && msg_lower_angle < _bin_upper_angle[i]) ||
+			    (msg_upper_angle > _bin_lower_angle[i] && msg_upper_angle < _bin_upper_angle[i]) ||
+			    (msg_lower_angle <= _bin_lower_angle[i] && msg_upper_angle >= _bin_upper_angle[i]) ||
+			    (msg_lower_angle >= _bin_lower_angle[i] && msg_upper_angle <= _bin_upper_angle[i])) {
 
-				// Check for overlaps.
-				if ((msg_lower_angle > bin_lower_angle && msg_lower_angle < bin_upper_angle) ||
-				    (msg_upper_angle > bin_lower_angle && msg_upper_angle < bin_upper_angle) ||
-				    (msg_lower_angle <= bin_lower_angle && msg_upper_angle >= bin_upper_angle) ||
-				    (msg_lower_angle >= bin_lower_angle && msg_upper_angle <= bin_upper_angle)) {
-					if (obstacle.distances[j] != UINT16_MAX) {
-
-						if (_enterData(i, obstacle.max_distance * 0.01f, obstacle.distances[j] * 0.01f)) {
-							_obstacle_map_body_frame.distances[i] = obstacle.distances[j];
-							_data_timestamps[i] = _obstacle_map_body_frame.timestamp;
-							_data_maxranges[i] = obstacle.max_distance;
-							_data_fov[i] = 1;
-						}
-					}
+				if (_enterData(i, obstacle.max_distance * 0.01f, obstacle.distances[j] * 0.01f)) {
+					_obstacle_map_body_frame.distances[i] = obstacle.distances[j];
+					_data_timestamps[i] = _obstacle_map_body_frame.timestamp;
+					_data_maxranges[i] = obstacle.max_distance;
+					_data_fov[i] = 1;
 				}
-
 			}
 		}
-
-	} else {
-		mavlink_log_critical(&_mavlink_log_pub, "Obstacle message received in unsupported frame %i\t",
-				     obstacle.frame);
-		events::send<uint8_t>(events::ID("col_prev_unsup_frame"), events::Log::Error,
-				      "Obstacle message received in unsupported frame {1}", obstacle.frame);
 	}
 }
 
@@ -355,18 +340,13 @@ CollisionPrevention::_enterData(int map_index, float sensor_range, float sensor_
 bool
 CollisionPrevention::_checkSetpointDirectionFeasability()
 {
-	bool setpoint_feasible = true;
-
-	for (int i = 0; i < BIN_COUNT; i++) {
-		// check if our setpoint is either pointing in a direction where data exists, or if not, wether we are allowed to go where there is no data
-		if ((_obstacle_map_body_frame.distances[i] == UINT16_MAX && i == _setpoint_index) && (!_param_cp_go_no_data.get()
-				|| (_param_cp_go_no_data.get() && _data_fov[i]))) {
-			setpoint_feasible =  false;
-
-		}
+	if (_setpoint_index < 0 || _setpoint_index >= BIN_COUNT) {
+		return true;
 	}
 
-	return setpoint_feasible;
+	// check if our setpoint is either pointing in a direction where data exists, or if not, wether we are allowed to go where there is no data
+	return !(_obstacle_map_body_frame.distances[_setpoint_index] == UINT16_MAX
+		 && (!_param_cp_go_no_data.get() || _data_fov[_setpoint_index]));
 }
 
 void
@@ -525,20 +505,19 @@ void CollisionPrevention::_getVelocityCompensationAcceleration(const float vehic
 		const Vector2f &setpoint_vel,
 		const hrt_abstime now, float &vel_comp_accel, Vector2f &vel_comp_accel_dir)
 {
+	const Dcm2f R_world_body(vehicle_yaw_angle_rad);
+
 	for (int i = 0; i < BIN_COUNT; i++) {
 		const float max_range = _data_maxranges[i] * 0.01f;
-
-		// get the vector pointing into the direction of current bin
-		float bin_angle = wrap_2pi(vehicle_yaw_angle_rad
-					   + math::radians((float)i * BIN_SIZE + _obstacle_map_body_frame.angle_offset));
-
-		const Vector2f bin_direction = { cosf(bin_angle), sinf(bin_angle) };
 		float bin_distance = _obstacle_map_body_frame.distances[i];
 
 		// only consider bins which are between min and max values
 		if (bin_distance > _obstacle_map_body_frame.min_distance && bin_distance < UINT16_MAX) {
 			const float distance = bin_distance * 0.01f;
 
+			// get the vector pointing into the direction of current bin
+			const Vector2f bin_direction = R_world_body * _bin_direction_body[i];
+
 			// Assume current velocity is sufficiently close to the setpoint velocity, this breaks down if flying high
 			// acceleration maneuvers
 			const float curr_vel_parallel = math::max(0.f, setpoint_vel.dot(bin_direction));
@@ -99,6 +99,13 @@ protected:
 	uint64_t _data_timestamps[BIN_COUNT] {};
 	uint16_t _data_maxranges[BIN_COUNT] {}; /**< in cm */
 
+	matrix::Vector2f _bin_direction_body[BIN_COUNT] {};	/**< unit vectors pointing into the center of the bins, body frame */
+	float _bin_lower_angle[BIN_COUNT] {};			/**< in degrees, below zero for the bin stretching over 0/360 */
+	float _bin_upper_angle[BIN_COUNT] {};			/**< in degrees */
+
+	/** Precomputes the bin directions and bounds of the internal obstacle map */
+	void _updateBinGeometry();
+
 	void _addDistanceSensorData(distance_sensor_s &distance_sensor, const matrix::Quatf &vehicle_attitude);
 
 	/**
@@ -183,7 +190,7 @@ private:
 	uORB::Publication<obstacle_distance_s>		_obstacle_distance_fused_pub{ORB_ID(obstacle_distance_fused)};	/**< obstacle_distance publication */
 	uORB::Publication<vehicle_command_s>	_vehicle_command_pub{ORB_ID(vehicle_command)};			/**< vehicle command do publication */
 
-	uORB::SubscriptionData<obstacle_distance_s> _sub_obstacle_distance{ORB_ID(obstacle_distance)}; /**< obstacle distances received form a range sensor */
+	uORB::SubscriptionMultiArray<obstacle_distance_s> _obstacle_distance_subs{ORB_ID::obstacle_distance}; /**< obstacle distances received from range sensors */
 	uORB::SubscriptionMultiArray<distance_sensor_s> _distance_sensor_subs{ORB_ID::distance_sensor};
 
 	static constexpr uint64_t RANGE_STREAM_TIMEOUT_US{500_ms};
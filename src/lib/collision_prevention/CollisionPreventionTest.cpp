@@ -1370,3 +1370,62 @@ TEST_F(CollisionPreventionTest, enterData)
 	EXPECT_TRUE(cp.test_enterData(16, 30.f, 1.5f)); //longer range, reading in range
 	EXPECT_TRUE(cp.test_enterData(16, 30.f, 31.f)); //longer range, reading out of range
 }
+
+TEST_F(CollisionPreventionTest, multipleObstacleSensorsDifferentResolution)
+{
+	// GIVEN: a simple setup condition
+	TestCollisionPrevention cp;
+	Vector2f original_setpoint(10, 0);
+	Vector2f curr_vel(2, 0);
+	vehicle_attitude_s attitude{};
+	attitude.timestamp = hrt_absolute_time();
+	attitude.q[0] = 1.0f;
+
+	param_t param = param_handle(px4::params::CP_DIST);
+	float value = 10;
+	param_set(param, &value);
+	cp.paramsChanged();
+
+	// AND: a forward looking sensor with 10° bins and an obstacle between -5° and 25°
+	obstacle_distance_s coarse_msg{};
+	coarse_msg.frame = coarse_msg.MAV_FRAME_BODY_FRD;
+	coarse_msg.increment = 10.f;
+	coarse_msg.min_distance = 20;
+	coarse_msg.max_distance = 2000;
+	memset(&coarse_msg.distances[0], UINT16_MAX, sizeof(coarse_msg.distances));
+
+	for (int i = 0; i < 3; i++) {
+		coarse_msg.distances[i] = 300;
+	}
+
+	// AND: a 360° sensor with 5° bins and an obstacle behind the vehicle
+	obstacle_distance_s fine_msg{};
+	fine_msg.frame = fine_msg.MAV_FRAME_BODY_FRD;
+	fine_msg.increment = 5.f;
+	fine_msg.min_distance = 20;
+	fine_msg.max_distance = 2000;
+	memset(&fine_msg.distances[0], UINT16_MAX, sizeof(fine_msg.distances));
+	fine_msg.distances[36] = 400;
+
+	// WHEN: both sensors publish on their own instance
+	int instance = 0;
+	coarse_msg.timestamp = hrt_absolute_time();
+	fine_msg.timestamp = hrt_absolute_time();
+	orb_advert_t coarse_pub = orb_advertise_multi(ORB_ID(obstacle_distance), &coarse_msg, &instance);
+	orb_advert_t fine_pub = orb_advertise_multi(ORB_ID(obstacle_distance), &fine_msg, &instance);
+	orb_advert_t vehicle_attitude_pub = orb_advertise(ORB_ID(vehicle_attitude), &attitude);
+	orb_publish(ORB_ID(vehicle_attitude), vehicle_attitude_pub, &attitude);
+	Vector2f modified_setpoint = original_setpoint;
+	cp.modifySetpoint(modified_setpoint, curr_vel);
+
+	// THEN: the internal map should contain the data of both sensors after a single update
+	for (int i = 0; i <= 5; i++) {
+		EXPECT_EQ(300, cp.getObstacleMap().distances[i]) << i;
+	}
+
+	EXPECT_EQ(400, cp.getObstacleMap().distances[36]);
+
+	orb_unadvertise(coarse_pub);
+	orb_unadvertise(fine_pub);
+	orb_unadvertise(vehicle_attitude_pub);
+}
@@ -69,6 +69,23 @@ int get_offset_bin_index(int bin, float bin_width, float angle_offset)
 	return wrap_bin(bin - offset, 360 / bin_width);
 }
 
+int get_candidate_bins(float sector_lower_angle, float sector_width, float bin_width, float angle_offset,
+		       int &first_bin)
+{
+	const int bin_count = 360 / bin_width;
+	const float start = wrap_360(sector_lower_angle - (angle_offset - bin_width / 2.f));
+
+	first_bin = (int)floorf(start / bin_width) - 1;
+	const int candidates = (int)ceilf(sector_width / bin_width) + 3;
+
+	if (candidates >= bin_count) {
+		first_bin = 0;
+		return bin_count;
+	}
+
+	return candidates;
+}
+
 float sensor_orientation_to_yaw_offset(const SensorOrientation orientation, const float q[4])
 {
 	float offset = 0.0f;
@@ -90,6 +90,19 @@ float get_lower_bound_angle(int bin, float bin_width, float angle_offset);
  */
 int get_offset_bin_index(int bin, float bin_width, float angle_offset);
 
+/**
+ * Returns the range of bins of a map which can overlap a sector, e.g. a bin of a sensor with a different resolution.
+ * The range is widened by one bin on each side and capped to the whole map, candidates still need an overlap check.
+ * @param sector_lower_angle lower bound angle of the sector in degrees
+ * @param sector_width width of the sector in degrees
+ * @param bin_width width of a map bin in degrees
+ * @param angle_offset clockwise angle offset of the map in degrees
+ * @param first_bin first candidate bin index, not wrapped
+ * @return number of candidate bins
+ */
+int get_candidate_bins(float sector_lower_angle, float sector_width, float bin_width, float angle_offset,
+		       int &first_bin);
+
 /**
  * Wraps a bin index to the range [0, bin_count)
  * @param bin bin index
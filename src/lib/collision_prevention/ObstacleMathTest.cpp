@@ -255,3 +255,39 @@ TEST(ObstacleMathTest, HandleMissedBins)
 	EXPECT_EQ(measurements[6], 1);
 	EXPECT_EQ(measurements[7], 1);
 }
+
+TEST(ObstacleMathTest, GetCandidateBins)
+{
+	// GIVEN: a 6 degree sector between 27.5 and 33.5 degrees and a map with 5 degree bins
+	int first_bin = -1;
+
+	// WHEN: we get the candidate bins of the map
+	int candidates = ObstacleMath::get_candidate_bins(27.5f, 6.f, 5.f, 0.f, first_bin);
+
+	// THEN: the overlapped bins 6 and 7 should be covered, with one extra bin on each side
+	EXPECT_EQ(first_bin, 5);
+	EXPECT_EQ(candidates, 5);
+
+	// WHEN: the sector stretches over the 0/360 degree line
+	candidates = ObstacleMath::get_candidate_bins(357.f, 6.f, 5.f, 0.f, first_bin);
+
+	// THEN: the overlapped bins 71, 0 and 1 should be covered once wrapped
+	EXPECT_EQ(first_bin, 70);
+	EXPECT_EQ(candidates, 5);
+	EXPECT_EQ(ObstacleMath::wrap_bin(first_bin + 1, 72), 71);
+	EXPECT_EQ(ObstacleMath::wrap_bin(first_bin + 3, 72), 1);
+
+	// WHEN: the map has an angle offset of half a bin
+	candidates = ObstacleMath::get_candidate_bins(10.f, 5.f, 5.f, 2.5f, first_bin);
+
+	// THEN: the sector is aligned with bin 2 which should be covered
+	EXPECT_EQ(first_bin, 1);
+	EXPECT_EQ(candidates, 4);
+
+	// WHEN: the sector is wider than the map
+	candidates = ObstacleMath::get_candidate_bins(0.f, 360.f, 5.f, 0.f, first_bin);
+
+	// THEN: every bin should be a candidate exactly once
+	EXPECT_EQ(first_bin, 0);
+	EXPECT_EQ(candidates, 72);
+}
@@ -0,0 +1,284 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlAllocationActiveSet.cpp
+ */
+
+#include "ControlAllocationActiveSet.hpp"
+
+#include <mathlib/math/Limits.hpp>
+
+void
+ControlAllocationActiveSet::updateHessian()
+{
+	// the control setpoint is in normalized units, like the normalized mix matrix of the pseudo inverse
+	_hessian.setZero();
+
+	for (int i = 0; i < _num_actuators; i++) {
+		for (int k = 0; k <= i; k++) {
+			float h = 0.f;
+
+			for (int j = 0; j < NUM_AXES; j++) {
+				const float scale_sq = _control_allocation_scale(j) * _control_allocation_scale(j);
+				h += AXIS_WEIGHT[j] * AXIS_WEIGHT[j] * scale_sq * _effectiveness(j, i) * _effectiveness(j, k);
+			}
+
+			_hessian(i, k) = h;
+			_hessian(k, i) = h;
+		}
+
+		_hessian(i, i) += GAMMA;
+	}
+}
+
+void
+ControlAllocationActiveSet::solveFree(const ActuatorVector &x, ActuatorVector &x_opt)
+{
+	// free variables in working order
+	uint8_t free_idx[NUM_ACTUATORS];
+	int num_free = 0;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_working_set[i] == 0) {
+			free_idx[num_free++] = i;
+		}
+	}
+
+	x_opt = x;
+
+	if (num_free == 0) {
+		return;
+	}
+
+	// right hand side: linear term minus the coupling to the fixed variables
+	ActuatorVector rhs;
+
+	for (int a = 0; a < num_free; a++) {
+		const int i = free_idx[a];
+		float r = _linear(i);
+
+		for (int k = 0; k < _num_actuators; k++) {
+			if (_working_set[k] != 0) {
+				r -= _hessian(i, k) * x(k);
+			}
+		}
+
+		rhs(a) = r;
+	}
+
+	// Cholesky factorization of the free block (positive definite because of the regularization)
+	for (int a = 0; a < num_free; a++) {
+		for (int b = 0; b <= a; b++) {
+			float sum = _hessian(free_idx[a], free_idx[b]);
+
+			for (int c = 0; c < b; c++) {
+				sum -= _cholesky(a, c) * _cholesky(b, c);
+			}
+
+			if (a == b) {
+				_cholesky(a, a) = sqrtf(fmaxf(sum, GAMMA * GAMMA));
+
+			} else {
+				_cholesky(a, b) = sum / _cholesky(b, b);
+			}
+		}
+	}
+
+	// forward and back substitution
+	for (int a = 0; a < num_free; a++) {
+		float sum = rhs(a);
+
+		for (int c = 0; c < a; c++) {
+			sum -= _cholesky(a, c) * rhs(c);
+		}
+
+		rhs(a) = sum / _cholesky(a, a);
+	}
+
+	for (int a = num_free - 1; a >= 0; a--) {
+		float sum = rhs(a);
+
+		for (int c = a + 1; c < num_free; c++) {
+			sum -= _cholesky(c, a) * rhs(c);
+		}
+
+		rhs(a) = sum / _cholesky(a, a);
+	}
+
+	for (int a = 0; a < num_free; a++) {
+		x_opt(free_idx[a]) = rhs(a);
+	}
+}
+
+void
+ControlAllocationActiveSet::allocate()
+{
+	if (_mix_update_needed) {
+		// also updates the normalization scale
+		updatePseudoInverse();
+		updateHessian();
+	}
+
+	_prev_actuator_sp = _actuator_sp;
+
+	const matrix::Vector<float, NUM_AXES> control = _control_sp - _control_trim;
+
+	// linear term, bounds and warm start (previous setpoint projected on the bounds)
+	ActuatorVector x;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		float f = 0.f;
+
+		for (int j = 0; j < NUM_AXES; j++) {
+			f += AXIS_WEIGHT[j] * AXIS_WEIGHT[j] * _control_allocation_scale(j) * _effectiveness(j, i) * control(j);
+		}
+
+		_linear(i) = f;
+
+		if (_actuator_max(i) < _actuator_min(i)) {
+			// invalid range, the actuator stays at trim
+			_lower(i) = 0.f;
+			_upper(i) = 0.f;
+
+		} else {
+			_lower(i) = _actuator_min(i) - _actuator_trim(i);
+			_upper(i) = _actuator_max(i) - _actuator_trim(i);
+		}
+
+		x(i) = math::constrain(_actuator_sp(i) - _actuator_trim(i), _lower(i), _upper(i));
+
+		if (_lower(i) >= _upper(i)) {
+			_working_set[i] = -1;
+
+		} else if (x(i) <= _lower(i)) {
+			_working_set[i] = (_working_set[i] != 0) ? -1 : 0;
+
+		} else if (x(i) >= _upper(i)) {
+			_working_set[i] = (_working_set[i] != 0) ? 1 : 0;
+
+		} else {
+			_working_set[i] = 0;
+		}
+	}
+
+	ActuatorVector x_opt;
+	_iterations = 0;
+
+	while (_iterations < MAX_ITERATIONS) {
+		++_iterations;
+
+		solveFree(x, x_opt);
+
+		// largest step towards the equality constrained optimum that stays feasible
+		float alpha = 1.f;
+		int blocking = -1;
+		bool blocking_at_lower = false;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if (_working_set[i] != 0) {
+				continue;
+			}
+
+			const float step = x_opt(i) - x(i);
+
+			if ((step < 0.f) && (x(i) + step < _lower(i) - TOLERANCE)) {
+				const float alpha_i = (_lower(i) - x(i)) / step;
+
+				if (alpha_i < alpha) {
+					alpha = alpha_i;
+					blocking = i;
+					blocking_at_lower = true;
+				}
+
+			} else if ((step > 0.f) && (x(i) + step > _upper(i) + TOLERANCE)) {
+				const float alpha_i = (_upper(i) - x(i)) / step;
+
+				if (alpha_i < alpha) {
+					alpha = alpha_i;
+					blocking = i;
+					blocking_at_lower = false;
+				}
+			}
+		}
+
+		if (blocking >= 0) {
+			// add the blocking constraint to the working set
+			for (int i = 0; i < _num_actuators; i++) {
+				if (_working_set[i] == 0) {
+					x(i) += alpha * (x_opt(i) - x(i));
+				}
+			}
+
+			x(blocking) = blocking_at_lower ? _lower(blocking) : _upper(blocking);
+			_working_set[blocking] = blocking_at_lower ? -1 : 1;
+			continue;
+		}
+
+		x = x_opt;
+
+		// Lagrange multipliers of the working set (gradient of the cost pointing into the box)
+		float lambda_min = -TOLERANCE;
+		int release = -1;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if ((_working_set[i] == 0) || (_lower(i) >= _upper(i))) {
+				continue;
+			}
+
+			float gradient = -_linear(i);
+
+			for (int k = 0; k < _num_actuators; k++) {
+				gradient += _hessian(i, k) * x(k);
+			}
+
+			const float lambda = (_working_set[i] < 0) ? gradient : -gradient;
+
+			if (lambda < lambda_min) {
+				lambda_min = lambda;
+				release = i;
+			}
+		}
+
+		if (release < 0) {
+			// optimal
+			break;
+		}
+
+		_working_set[release] = 0;
+	}
+
+	for (int i = 0; i < _num_actuators; i++) {
+		_actuator_sp(i) = _actuator_trim(i) + math::constrain(x(i), _lower(i), _upper(i));
+	}
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlAllocationActiveSet.hpp
+ *
+ * Control allocation as a box constrained quadratic program
+ *
+ * Minimizes the weighted allocation error plus a small regularization towards the trim
+ *   || Wv (B (u - u_trim) - v) ||^2 + gamma || u - u_trim ||^2,  u_min <= u <= u_max
+ * with a primal active set method. The solver is warm started from the previous actuator
+ * setpoint and its working set, and the number of iterations is bounded, so the worst case
+ * runtime is deterministic. Every iterate is feasible, if the iteration limit is reached the
+ * last (suboptimal) iterate is used.
+ *
+ * Härkegård, O. (2002). Efficient active set algorithms for solving constrained least squares
+ * problems in aircraft control allocation. Proceedings of the 41st IEEE CDC.
+ */
+
+#pragma once
+
+#include "ControlAllocationPseudoInverse.hpp"
+
+class ControlAllocationActiveSet: public ControlAllocationPseudoInverse
+{
+public:
+	ControlAllocationActiveSet() = default;
+	virtual ~ControlAllocationActiveSet() = default;
+
+	void allocate() override;
+
+	/**
+	 * Number of active set iterations of the last allocation (1 if the warm start was optimal)
+	 */
+	int getIterations() const { return _iterations; }
+
+	static constexpr int MAX_ITERATIONS{NUM_ACTUATORS};
+
+	// allocation error weights (roll and pitch have priority over yaw and thrust)
+	static constexpr float AXIS_WEIGHT[NUM_AXES] {1.f, 1.f, 0.3f, 0.5f, 0.5f, 0.5f};
+
+	// regularization towards the trim, keeps the problem strictly convex for redundant actuators
+	static constexpr float GAMMA{1e-4f};
+
+private:
+	// bound violations and negative Lagrange multipliers below this are treated as zero, avoids cycling on ties
+	static constexpr float TOLERANCE{1e-5f};
+
+	/**
+	 * Compute the Hessian of the quadratic program after the effectiveness matrix changed.
+	 */
+	void updateHessian();
+
+	/**
+	 * Solve the equality constrained problem with the variables in the working set fixed at their bound.
+	 *
+	 * @param x current iterate, the fixed variables are read from it
+	 * @param x_opt solution (free variables computed, fixed variables copied)
+	 */
+	void solveFree(const ActuatorVector &x, ActuatorVector &x_opt);
+
+	matrix::SquareMatrix<float, NUM_ACTUATORS> _hessian; ///< B^T Wv^2 B + gamma I in normalized units
+	matrix::SquareMatrix<float, NUM_ACTUATORS> _cholesky; ///< factorization of the free part of _hessian (scratch)
+
+	ActuatorVector _linear; ///< B^T Wv^2 v of the current setpoint
+	ActuatorVector _lower;  ///< lower bound relative to trim
+	ActuatorVector _upper;  ///< upper bound relative to trim
+
+	int8_t _working_set[NUM_ACTUATORS] {}; ///< -1: at lower bound, 1: at upper bound, 0: free
+
+	int _iterations{0};
+};
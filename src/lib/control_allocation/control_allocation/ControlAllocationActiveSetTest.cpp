@@ -0,0 +1,194 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlAllocationActiveSetTest.cpp
+ *
+ * Tests for the active set control allocation
+ */
+
+#include <gtest/gtest.h>
+#include <mathlib/math/Limits.hpp>
+#include <ControlAllocationActiveSet.hpp>
+
+using namespace matrix;
+
+namespace
+{
+
+// hexacopter X, normalized thrust
+matrix::Matrix<float, 6, 16> hexacopterEffectiveness()
+{
+	matrix::Matrix<float, 6, 16> effectiveness;
+
+	for (int i = 0; i < 6; i++) {
+		const float angle = math::radians(30.f + 60.f * i);
+		effectiveness(0, i) = -sinf(angle);
+		effectiveness(1, i) = cosf(angle);
+		effectiveness(2, i) = (i % 2 == 0) ? 0.05f : -0.05f;
+		effectiveness(5, i) = -1.f;
+	}
+
+	return effectiveness;
+}
+
+template<class T>
+void configure(T &method, int num_actuators)
+{
+	matrix::Vector<float, 16> actuator_trim;
+	matrix::Vector<float, 16> linearization_point;
+	matrix::Vector<float, 16> actuator_min;
+	matrix::Vector<float, 16> actuator_max;
+	actuator_max.setAll(1.f);
+
+	method.setEffectivenessMatrix(hexacopterEffectiveness(), actuator_trim, linearization_point, num_actuators, true);
+	method.setActuatorMin(actuator_min);
+	method.setActuatorMax(actuator_max);
+}
+
+} // namespace
+
+TEST(ControlAllocationActiveSetTest, Unsaturated)
+{
+	// without saturation the solution matches the pseudo inverse
+	ControlAllocationActiveSet method;
+	ControlAllocationPseudoInverse reference;
+	configure(method, 6);
+	configure(reference, 6);
+
+	matrix::Vector<float, 6> control_sp;
+	control_sp(0) = 0.05f;
+	control_sp(1) = -0.03f;
+	control_sp(2) = 0.02f;
+	control_sp(5) = -0.5f;
+
+	method.setControlSetpoint(control_sp);
+	reference.setControlSetpoint(control_sp);
+	method.allocate();
+	reference.allocate();
+
+	for (int i = 0; i < 6; i++) {
+		EXPECT_NEAR(method.getActuatorSetpoint()(i), reference.getActuatorSetpoint()(i), 1e-2f);
+	}
+
+	// the warm start is optimal when the setpoint does not change
+	method.allocate();
+	EXPECT_EQ(method.getIterations(), 1);
+}
+
+TEST(ControlAllocationActiveSetTest, SaturatedOptimality)
+{
+	ControlAllocationActiveSet method;
+	configure(method, 6);
+
+	srand(1);
+
+	for (int test = 0; test < 500; test++) {
+		matrix::Vector<float, 6> control_sp;
+
+		for (int j = 0; j < 3; j++) {
+			control_sp(j) = (rand() / (float)RAND_MAX - 0.5f) * 2.f;
+		}
+
+		control_sp(5) = -(rand() / (float)RAND_MAX) * 1.5f;
+
+		method.setControlSetpoint(control_sp);
+		method.allocate();
+
+		const matrix::Vector<float, 16> actuator_sp = method.getActuatorSetpoint();
+		const matrix::Vector<float, 6> control_allocated = method.getAllocatedControl();
+		ASSERT_LE(method.getIterations(), ControlAllocationActiveSet::MAX_ITERATIONS);
+
+		for (int i = 0; i < 6; i++) {
+			EXPECT_GE(actuator_sp(i), -1e-5f);
+			EXPECT_LE(actuator_sp(i), 1.f + 1e-5f);
+		}
+
+		// no feasible change of a single actuator reduces the weighted allocation error
+		const auto cost = [&](const matrix::Vector<float, 6> &allocated) {
+			float c = 0.f;
+
+			for (int j = 0; j < 6; j++) {
+				const float error = ControlAllocationActiveSet::AXIS_WEIGHT[j] * (allocated(j) - control_sp(j));
+				c += error * error;
+			}
+
+			return c;
+		};
+
+		if (method.getIterations() < ControlAllocationActiveSet::MAX_ITERATIONS) {
+			const float optimal_cost = cost(control_allocated);
+
+			for (int i = 0; i < 6; i++) {
+				for (float delta : {-0.01f, 0.01f}) {
+					matrix::Vector<float, 16> perturbed = actuator_sp;
+					perturbed(i) = math::constrain(perturbed(i) + delta, 0.f, 1.f);
+					method.setActuatorSetpoint(perturbed);
+					EXPECT_GE(cost(method.getAllocatedControl()), optimal_cost - 1e-4f) << "test " << test;
+				}
+			}
+
+			method.setActuatorSetpoint(actuator_sp);
+		}
+	}
+}
+
+TEST(ControlAllocationActiveSetTest, IterationCount)
+{
+	// the active set converges within MAX_ITERATIONS for a slowly varying, partially saturating setpoint
+	// (the allocation time is measured in ControlAllocationBenchmark)
+	static constexpr int NUM_ALLOCATIONS{20000};
+
+	ControlAllocationActiveSet method;
+	configure(method, 6);
+
+	int max_iterations = 0;
+
+	for (int k = 0; k < NUM_ALLOCATIONS; k++) {
+		const float t = k * 0.001f;
+		matrix::Vector<float, 6> control_sp;
+		control_sp(0) = 0.6f * sinf(3.f * t);
+		control_sp(1) = 0.6f * cosf(2.f * t);
+		control_sp(2) = 0.3f * sinf(t);
+		control_sp(5) = -0.6f - 0.3f * sinf(5.f * t);
+
+		method.setControlSetpoint(control_sp);
+		method.allocate();
+		method.clipActuatorSetpoint();
+
+		max_iterations = math::max(max_iterations, method.getIterations());
+	}
+
+	EXPECT_GT(max_iterations, 0);
+	EXPECT_LE(max_iterations, ControlAllocationActiveSet::MAX_ITERATIONS);
+}
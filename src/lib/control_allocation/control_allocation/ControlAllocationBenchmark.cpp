@@ -0,0 +1,149 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "ControlAllocationActiveSet.hpp"
+#include "ControlAllocationPseudoInverse.hpp"
+#include "ControlAllocationSequentialDesaturation.hpp"
+
+using namespace matrix;
+
+// rotors as {x, y, moment_ratio}, all thrusting upwards with unit thrust coefficient
+static constexpr float kQuadX[4][3] {
+	{1.f, 1.f, 1.f},
+	{-1.f, 1.f, -1.f},
+	{-1.f, -1.f, 1.f},
+	{1.f, -1.f, -1.f},
+};
+
+static constexpr float kHexX[6][3] {
+	{0.f, 1.f, -1.f},
+	{0.f, -1.f, 1.f},
+	{0.866f, -0.5f, -1.f},
+	{-0.866f, 0.5f, 1.f},
+	{0.866f, 0.5f, 1.f},
+	{-0.866f, -0.5f, -1.f},
+};
+
+static void setEffectiveness(ControlAllocation &allocation, const float rotors[][3], int num_rotors)
+{
+	Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> effectiveness{};
+
+	for (int i = 0; i < num_rotors; i++) {
+		effectiveness(ControlAllocation::ControlAxis::ROLL, i) = -rotors[i][1];
+		effectiveness(ControlAllocation::ControlAxis::PITCH, i) = rotors[i][0];
+		effectiveness(ControlAllocation::ControlAxis::YAW, i) = -rotors[i][2];
+		effectiveness(ControlAllocation::ControlAxis::THRUST_Z, i) = -1.f;
+	}
+
+	allocation.setEffectivenessMatrix(effectiveness, ControlAllocation::ActuatorVector{},
+					  ControlAllocation::ActuatorVector{}, num_rotors, true);
+}
+
+static Vector<float, ControlAllocation::NUM_AXES> controlSetpoint(bool saturated)
+{
+	Vector<float, ControlAllocation::NUM_AXES> control_sp{};
+	control_sp(ControlAllocation::ControlAxis::ROLL) = saturated ? 0.5f : 0.01f;
+	control_sp(ControlAllocation::ControlAxis::PITCH) = saturated ? -0.3f : -0.02f;
+	control_sp(ControlAllocation::ControlAxis::YAW) = saturated ? 0.4f : 0.005f;
+	control_sp(ControlAllocation::ControlAxis::THRUST_Z) = saturated ? -0.9f : -0.5f;
+	return control_sp;
+}
+
+// Args: number of rotors (4 or 6), saturated setpoint (0 or 1)
+template<typename Allocation>
+static void BM_Allocate(benchmark::State &state)
+{
+	Allocation allocation;
+
+	if (state.range(0) == 6) {
+		setEffectiveness(allocation, kHexX, 6);
+
+	} else {
+		setEffectiveness(allocation, kQuadX, 4);
+	}
+
+	allocation.setControlSetpoint(controlSetpoint(state.range(1)));
+
+	for (auto _ : state) {
+		allocation.allocate();
+		benchmark::DoNotOptimize(allocation.getActuatorSetpoint());
+	}
+}
+BENCHMARK(BM_Allocate<ControlAllocationPseudoInverse>)->ArgsProduct({{4, 6}, {0, 1}});
+BENCHMARK(BM_Allocate<ControlAllocationSequentialDesaturation>)->ArgsProduct({{4, 6}, {0, 1}});
+
+static void BM_SetEffectivenessMatrix(benchmark::State &state)
+{
+	// recomputes the pseudo inverse, done on every effectiveness update (e.g. tilting rotors)
+	ControlAllocationPseudoInverse allocation;
+
+	for (auto _ : state) {
+		setEffectiveness(allocation, kHexX, 6);
+		allocation.allocate();
+		benchmark::DoNotOptimize(allocation.getActuatorSetpoint());
+	}
+}
+BENCHMARK(BM_SetEffectivenessMatrix);
+
+// Slowly varying, partially saturating setpoint on the hexacopter, clipped to [0, 1] like in the control allocator
+template<typename Allocation>
+static void BM_AllocateVaryingSetpoint(benchmark::State &state)
+{
+	Allocation allocation;
+	setEffectiveness(allocation, kHexX, 6);
+
+	ControlAllocation::ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+	allocation.setActuatorMin(ControlAllocation::ActuatorVector{});
+	allocation.setActuatorMax(actuator_max);
+
+	int k = 0;
+
+	for (auto _ : state) {
+		const float t = (k++ % 20000) * 0.001f;
+		Vector<float, ControlAllocation::NUM_AXES> control_sp{};
+		control_sp(ControlAllocation::ControlAxis::ROLL) = 0.6f * sinf(3.f * t);
+		control_sp(ControlAllocation::ControlAxis::PITCH) = 0.6f * cosf(2.f * t);
+		control_sp(ControlAllocation::ControlAxis::YAW) = 0.3f * sinf(t);
+		control_sp(ControlAllocation::ControlAxis::THRUST_Z) = -0.6f - 0.3f * sinf(5.f * t);
+
+		allocation.setControlSetpoint(control_sp);
+		allocation.allocate();
+		allocation.clipActuatorSetpoint();
+		benchmark::DoNotOptimize(allocation.getActuatorSetpoint());
+	}
+}
+BENCHMARK(BM_AllocateVaryingSetpoint<ControlAllocationPseudoInverse>);
+BENCHMARK(BM_AllocateVaryingSetpoint<ControlAllocationActiveSet>);
@@ -62,7 +62,8 @@ void
 ControlAllocationPseudoInverse::updatePseudoInverse()
 {
 	if (_mix_update_needed) {
-		matrix::geninv(_effectiveness, _mix);
+		updateGramian();
+		matrix::geninvGramian(_effectiveness, _gramian, _mix);
 
 		if (!_metric_allocation) {
 			if (_normalization_needs_update && !_had_actuator_failure) {
@@ -77,6 +78,52 @@ ControlAllocationPseudoInverse::updatePseudoInverse()
 	}
 }
 
+void
+ControlAllocationPseudoInverse::updateGramian()
+{
+	int num_changed = 0;
+	bool changed[NUM_ACTUATORS] {};
+
+	if (_gramian_incremental_updates < MAX_INCREMENTAL_UPDATES) {
+		for (int i = 0; (i < NUM_ACTUATORS) && (num_changed <= MAX_INCREMENTAL_COLUMNS); i++) {
+			for (int j = 0; j < NUM_AXES; j++) {
+				if (_effectiveness(j, i) != _gramian_effectiveness(j, i)) {
+					changed[i] = true;
+					++num_changed;
+					break;
+				}
+			}
+		}
+	}
+
+	if ((_gramian_incremental_updates >= MAX_INCREMENTAL_UPDATES) || (num_changed > MAX_INCREMENTAL_COLUMNS)) {
+		_gramian = _effectiveness.multiplyByTranspose(_effectiveness);
+		_gramian_incremental_updates = 0;
+
+	} else {
+		// rank one updates: remove the previous outer product of the actuator column, add the new one
+		for (int i = 0; i < NUM_ACTUATORS; i++) {
+			if (changed[i]) {
+				for (int j = 0; j < NUM_AXES; j++) {
+					for (int k = 0; k <= j; k++) {
+						const float delta = _effectiveness(j, i) * _effectiveness(k, i)
+								    - _gramian_effectiveness(j, i) * _gramian_effectiveness(k, i);
+						_gramian(j, k) += delta;
+
+						if (k != j) {
+							_gramian(k, j) += delta;
+						}
+					}
+				}
+			}
+		}
+
+		++_gramian_incremental_updates;
+	}
+
+	_gramian_effectiveness = _effectiveness;
+}
+
 void
 ControlAllocationPseudoInverse::updateControlAllocationMatrixScale()
 {
@@ -74,5 +74,22 @@ protected:
 private:
 	void normalizeControlAllocationMatrix();
 	void updateControlAllocationMatrixScale();
+
+	/**
+	 * Update the Gramian (effectiveness * effectiveness^T) used for the pseudo inverse.
+	 * If only a few actuators changed since the last update (e.g. tilting rotors during a transition),
+	 * their contributions are replaced instead of recomputing the full product.
+	 */
+	void updateGramian();
+
+	// replace the contributions of at most this many actuators, otherwise recompute the Gramian
+	static constexpr int MAX_INCREMENTAL_COLUMNS{NUM_ACTUATORS / 4};
+	// limit the accumulation of rounding errors by recomputing the Gramian periodically
+	static constexpr uint8_t MAX_INCREMENTAL_UPDATES{100};
+
+	matrix::SquareMatrix<float, NUM_AXES> _gramian;
+	matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> _gramian_effectiveness; ///< effectiveness matching _gramian
+	uint8_t _gramian_incremental_updates{MAX_INCREMENTAL_UPDATES}; ///< start with a full computation
+
 	bool _normalization_needs_update{false};
 };
@@ -91,3 +91,54 @@ TEST(ControlAllocationMetricTest, AllZeroCase)
 	EXPECT_EQ(actuator_sp, actuator_sp_expected);
 	EXPECT_EQ(control_allocated, control_allocated_expected);
 }
+
+TEST(ControlAllocationTest, IncrementalEffectivenessUpdate)
+{
+	// tilting a few rotors only changes some columns, the incrementally updated allocation must match a new one
+	ControlAllocationPseudoInverse method;
+	method.setMetricAllocation(true);
+
+	matrix::Matrix<float, 6, 16> effectiveness;
+	matrix::Vector<float, 16> actuator_trim;
+	matrix::Vector<float, 16> linearization_point;
+
+	// quad X with tiltable front rotors
+	const float arm = 0.7071f;
+	const float roll_arm[4] {-arm, arm, arm, -arm};
+	const float pitch_arm[4] {arm, -arm, arm, -arm};
+	const float yaw_moment[4] {0.05f, 0.05f, -0.05f, -0.05f};
+
+	matrix::Vector<float, 6> control_sp;
+	control_sp(0) = 0.1f;
+	control_sp(1) = -0.2f;
+	control_sp(2) = 0.05f;
+	control_sp(5) = -0.5f;
+
+	for (int step = 0; step <= 150; step++) {
+		const float tilt = step * 0.01f;
+
+		for (int i = 0; i < 4; i++) {
+			const float rotor_tilt = (i == 0 || i == 2) ? tilt : 0.f;
+			effectiveness(0, i) = roll_arm[i] * cosf(rotor_tilt);
+			effectiveness(1, i) = pitch_arm[i] * cosf(rotor_tilt);
+			effectiveness(2, i) = yaw_moment[i] + roll_arm[i] * sinf(rotor_tilt);
+			effectiveness(3, i) = sinf(rotor_tilt);
+			effectiveness(5, i) = -cosf(rotor_tilt);
+		}
+
+		method.setEffectivenessMatrix(effectiveness, actuator_trim, linearization_point, 4, false);
+		method.setControlSetpoint(control_sp);
+		method.allocate();
+
+		ControlAllocationPseudoInverse reference;
+		reference.setMetricAllocation(true);
+		reference.setEffectivenessMatrix(effectiveness, actuator_trim, linearization_point, 4, false);
+		reference.setControlSetpoint(control_sp);
+		reference.allocate();
+
+		for (int i = 0; i < 4; i++) {
+			const float expected = reference.getActuatorSetpoint()(i);
+			EXPECT_NEAR(method.getActuatorSetpoint()(i), expected, 1e-4f * fmaxf(fabsf(expected), 1.f)) << "step " << step;
+		}
+	}
+}
@@ -45,10 +45,16 @@ void
 ControlAllocationSequentialDesaturation::allocate()
 {
 	//Compute new gains if needed
-	updatePseudoInverse();
+	if (_mix_update_needed) {
+		updatePseudoInverse();
+		updateDesaturationVectors();
+	}
 
 	_prev_actuator_sp = _actuator_sp;
 
+	// control deviation from trim, shared by all mixing steps
+	_control_delta = _control_sp - _control_trim;
+
 	switch (_param_mc_airmode.get()) {
 	case 1:
 		mixAirmodeRP();
@@ -64,11 +70,66 @@ ControlAllocationSequentialDesaturation::allocate()
 	}
 }
 
+void ControlAllocationSequentialDesaturation::updateDesaturationVectors()
+{
+	// the columns of the mix matrix only change with the effectiveness matrix, extract them once
+	_mix_roll.setZero();
+	_mix_pitch.setZero();
+	_mix_yaw.setZero();
+	_mix_thrust_z.setZero();
+
+	for (int i = 0; i < _num_actuators; i++) {
+		_mix_roll(i) = _mix(i, ControlAxis::ROLL);
+		_mix_pitch(i) = _mix(i, ControlAxis::PITCH);
+		_mix_yaw(i) = _mix(i, ControlAxis::YAW);
+		_mix_thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
+	}
+}
+
+void ControlAllocationSequentialDesaturation::mixRollPitchThrust(bool include_yaw)
+{
+	const float roll = _control_delta(ControlAxis::ROLL);
+	const float pitch = _control_delta(ControlAxis::PITCH);
+	const float yaw = _control_delta(ControlAxis::YAW);
+	const float thrust_x = _control_delta(ControlAxis::THRUST_X);
+	const float thrust_y = _control_delta(ControlAxis::THRUST_Y);
+	const float thrust_z = _control_delta(ControlAxis::THRUST_Z);
+
+	if (include_yaw) {
+		for (int i = 0; i < _num_actuators; i++) {
+			_actuator_sp(i) = _actuator_trim(i) +
+					  _mix(i, ControlAxis::ROLL) * roll +
+					  _mix(i, ControlAxis::PITCH) * pitch +
+					  _mix(i, ControlAxis::YAW) * yaw +
+					  _mix(i, ControlAxis::THRUST_X) * thrust_x +
+					  _mix(i, ControlAxis::THRUST_Y) * thrust_y +
+					  _mix(i, ControlAxis::THRUST_Z) * thrust_z;
+		}
+
+	} else {
+		for (int i = 0; i < _num_actuators; i++) {
+			_actuator_sp(i) = _actuator_trim(i) +
+					  _mix(i, ControlAxis::ROLL) * roll +
+					  _mix(i, ControlAxis::PITCH) * pitch +
+					  _mix(i, ControlAxis::THRUST_X) * thrust_x +
+					  _mix(i, ControlAxis::THRUST_Y) * thrust_y +
+					  _mix(i, ControlAxis::THRUST_Z) * thrust_z;
+		}
+	}
+}
+
 void ControlAllocationSequentialDesaturation::desaturateActuators(
 	ActuatorVector &actuator_sp,
 	const ActuatorVector &desaturation_vector, bool increase_only)
 {
-	float gain = computeDesaturationGain(desaturation_vector, actuator_sp);
+	desaturateActuators(actuator_sp, desaturation_vector, _actuator_max, increase_only);
+}
+
+void ControlAllocationSequentialDesaturation::desaturateActuators(
+	ActuatorVector &actuator_sp,
+	const ActuatorVector &desaturation_vector, const ActuatorVector &actuator_max, bool increase_only)
+{
+	float gain = computeDesaturationGain(desaturation_vector, actuator_sp, actuator_max);
 
 	if (increase_only && gain < 0.f) {
 		return;
@@ -78,7 +139,7 @@ void ControlAllocationSequentialDesaturation::desaturateActuators(
 		actuator_sp(i) += gain * desaturation_vector(i);
 	}
 
-	gain = 0.5f * computeDesaturationGain(desaturation_vector, actuator_sp);
+	gain = 0.5f * computeDesaturationGain(desaturation_vector, actuator_sp, actuator_max);
 
 	for (int i = 0; i < _num_actuators; i++) {
 		actuator_sp(i) += gain * desaturation_vector(i);
@@ -86,7 +147,7 @@ void ControlAllocationSequentialDesaturation::desaturateActuators(
 }
 
 float ControlAllocationSequentialDesaturation::computeDesaturationGain(const ActuatorVector &desaturation_vector,
-		const ActuatorVector &actuator_sp)
+		const ActuatorVector &actuator_sp, const ActuatorVector &actuator_max)
 {
 	float k_min = 0.f;
 	float k_max = 0.f;
@@ -105,8 +166,8 @@ float ControlAllocationSequentialDesaturation::computeDesaturationGain(const Act
 			if (k > k_max) { k_max = k; }
 		}
 
-		if (actuator_sp(i) > _actuator_max(i)) {
-			float k = (_actuator_max(i) - actuator_sp(i)) / desaturation_vector(i);
+		if (actuator_sp(i) > actuator_max(i)) {
+			float k = (actuator_max(i) - actuator_sp(i)) / desaturation_vector(i);
 
 			if (k < k_min) { k_min = k; }
 
@@ -124,19 +185,9 @@ ControlAllocationSequentialDesaturation::mixAirmodeRP()
 	// Airmode for roll and pitch, but not yaw
 
 	// Mix without yaw
-	ActuatorVector thrust_z;
-
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-	}
+	mixRollPitchThrust(false);
 
-	desaturateActuators(_actuator_sp, thrust_z);
+	desaturateActuators(_actuator_sp, _mix_thrust_z);
 
 	// Mix yaw independently
 	mixYaw();
@@ -148,26 +199,13 @@ ControlAllocationSequentialDesaturation::mixAirmodeRPY()
 	// Airmode for roll, pitch and yaw
 
 	// Do full mixing
-	ActuatorVector thrust_z;
-	ActuatorVector yaw;
+	mixRollPitchThrust(true);
 
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::YAW) * (_control_sp(ControlAxis::YAW) - _control_trim(ControlAxis::YAW)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-		yaw(i) = _mix(i, ControlAxis::YAW);
-	}
-
-	desaturateActuators(_actuator_sp, thrust_z);
+	desaturateActuators(_actuator_sp, _mix_thrust_z);
 
 	// Unsaturate yaw (in case upper and lower bounds are exceeded)
 	// to prioritize roll/pitch over yaw.
-	desaturateActuators(_actuator_sp, yaw);
+	desaturateActuators(_actuator_sp, _mix_yaw);
 }
 
 void
@@ -176,28 +214,14 @@ ControlAllocationSequentialDesaturation::mixAirmodeDisabled()
 	// Airmode disabled: never allow to increase the thrust to unsaturate a motor
 
 	// Mix without yaw
-	ActuatorVector thrust_z;
-	ActuatorVector roll;
-	ActuatorVector pitch;
-
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-		roll(i) = _mix(i, ControlAxis::ROLL);
-		pitch(i) = _mix(i, ControlAxis::PITCH);
-	}
+	mixRollPitchThrust(false);
 
 	// only reduce thrust
-	desaturateActuators(_actuator_sp, thrust_z, true);
+	desaturateActuators(_actuator_sp, _mix_thrust_z, true);
 
 	// Reduce roll/pitch acceleration if needed to unsaturate
-	desaturateActuators(_actuator_sp, roll);
-	desaturateActuators(_actuator_sp, pitch);
+	desaturateActuators(_actuator_sp, _mix_roll);
+	desaturateActuators(_actuator_sp, _mix_pitch);
 
 	// Mix yaw independently
 	mixYaw();
@@ -207,24 +231,22 @@ void
 ControlAllocationSequentialDesaturation::mixYaw()
 {
 	// Add yaw to outputs
-	ActuatorVector yaw;
-	ActuatorVector thrust_z;
+	const float yaw = _control_delta(ControlAxis::YAW);
+	ActuatorVector max_yaw_margin;
 
 	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) += _mix(i, ControlAxis::YAW) * (_control_sp(ControlAxis::YAW) - _control_trim(ControlAxis::YAW));
-		yaw(i) = _mix(i, ControlAxis::YAW);
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
+		_actuator_sp(i) += _mix_yaw(i) * yaw;
+
+		// allow some yaw response at maximum thrust
+		max_yaw_margin(i) = _actuator_max(i) + (_actuator_max(i) - _actuator_min(i)) * MINIMUM_YAW_MARGIN;
 	}
 
 	// Change yaw acceleration to unsaturate the outputs if needed (do not change roll/pitch),
 	// and allow some yaw response at maximum thrust
-	ActuatorVector max_prev = _actuator_max;
-	_actuator_max += (_actuator_max - _actuator_min) * MINIMUM_YAW_MARGIN;
-	desaturateActuators(_actuator_sp, yaw);
-	_actuator_max = max_prev;
+	desaturateActuators(_actuator_sp, _mix_yaw, max_yaw_margin);
 
 	// reduce thrust only
-	desaturateActuators(_actuator_sp, thrust_z, true);
+	desaturateActuators(_actuator_sp, _mix_thrust_z, true);
 }
 
 void
@@ -81,13 +81,30 @@ private:
 	void desaturateActuators(ActuatorVector &actuator_sp, const ActuatorVector &desaturation_vector,
 				 bool increase_only = false);
 
+	/**
+	 * @see desaturateActuators(), with an upper actuator limit other than the configured maximum
+	 */
+	void desaturateActuators(ActuatorVector &actuator_sp, const ActuatorVector &desaturation_vector,
+				 const ActuatorVector &actuator_max, bool increase_only = false);
+
 	/**
 	 * Computes the gain k by which desaturation_vector has to be multiplied
 	 * in order to unsaturate the output that has the greatest saturation.
 	 *
 	 * @return desaturation gain
 	 */
-	float computeDesaturationGain(const ActuatorVector &desaturation_vector, const ActuatorVector &actuator_sp);
+	float computeDesaturationGain(const ActuatorVector &desaturation_vector, const ActuatorVector &actuator_sp,
+				      const ActuatorVector &actuator_max);
+
+	/**
+	 * Extract the desaturation vectors (mix matrix columns) after the mix matrix changed.
+	 */
+	void updateDesaturationVectors();
+
+	/**
+	 * Set the actuator setpoint from roll, pitch, thrust and optionally yaw (no desaturation).
+	 */
+	void mixRollPitchThrust(bool include_yaw);
 
 	/**
 	 * Mix roll, pitch, yaw, thrust and set the actuator setpoint.
@@ -126,6 +143,14 @@ private:
 	 */
 	void mixYaw();
 
+	// mix matrix columns used as desaturation vectors, only updated with the effectiveness matrix
+	ActuatorVector _mix_roll;
+	ActuatorVector _mix_pitch;
+	ActuatorVector _mix_yaw;
+	ActuatorVector _mix_thrust_z;
+
+	matrix::Vector<float, NUM_AXES> _control_delta; ///< control setpoint relative to trim
+
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::MC_AIRMODE>) _param_mc_airmode   ///< air-mode
 	);
@@ -103,3 +103,17 @@ TEST(Rotations, duplicates)
 		}
 	}
 }
+
+TEST(Rotations, lookup_vs_euler)
+{
+	// the rotation matrices and quaternions are computed at compile time, check them against the runtime conversions
+	for (size_t i = 0; i < (size_t)Rotation::ROTATION_MAX; i++) {
+		const enum Rotation rotation = static_cast<Rotation>(i);
+		const matrix::Eulerf euler{math::radians((float)rot_lookup[i].roll),
+					   math::radians((float)rot_lookup[i].pitch),
+					   math::radians((float)rot_lookup[i].yaw)};
+
+		EXPECT_TRUE(matrix::isEqual(get_rot_matrix(rotation), matrix::Dcmf(euler), 1e-6f)) << "Rotation " << i;
+		EXPECT_TRUE(matrix::isEqual(get_rot_quaternion(rotation), matrix::Quatf(euler), 1e-6f)) << "Rotation " << i;
+	}
+}
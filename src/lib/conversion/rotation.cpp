@@ -39,22 +39,129 @@
 
 #include "rotation.h"
 
+namespace
+{
+
+// sin(x) and cos(x) for |x| <= pi/4 as Taylor series, usable in constant expressions
+constexpr double taylor_sin(double x)
+{
+	double term = x;
+	double sum = x;
+
+	for (int n = 1; n < 12; n++) {
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+
+	return sum;
+}
+
+constexpr double taylor_cos(double x)
+{
+	double term = 1.;
+	double sum = 1.;
+
+	for (int n = 1; n < 12; n++) {
+		term *= -x * x / ((2 * n - 1) * (2 * n));
+		sum += term;
+	}
+
+	return sum;
+}
+
+constexpr double sin_deg(double deg)
+{
+	constexpr double deg_to_rad = 3.14159265358979323846 / 180.;
+
+	while (deg >= 315.) {
+		deg -= 360.;
+	}
+
+	while (deg < -45.) {
+		deg += 360.;
+	}
+
+	if (deg < 45.) {
+		return taylor_sin(deg * deg_to_rad);
+
+	} else if (deg < 135.) {
+		return taylor_cos((deg - 90.) * deg_to_rad);
+
+	} else if (deg < 225.) {
+		return -taylor_sin((deg - 180.) * deg_to_rad);
+	}
+
+	return -taylor_cos((deg - 270.) * deg_to_rad);
+}
+
+constexpr double cos_deg(double deg)
+{
+	return sin_deg(deg + 90.);
+}
+
+/**
+ * Rotation matrices and quaternions of all rotations, computed at compile time from rot_lookup
+ * (same conventions as the matrix::Dcm and matrix::Quaternion constructors from Euler angles)
+ */
+struct RotationTables {
+	matrix::Dcmf dcm[ROTATION_MAX];
+	matrix::Quatf q[ROTATION_MAX];
+
+	constexpr RotationTables()
+	{
+		for (size_t i = 0; i < ROTATION_MAX; i++) {
+			const double roll = rot_lookup[i].roll;
+			const double pitch = rot_lookup[i].pitch;
+			const double yaw = rot_lookup[i].yaw;
+
+			const double cos_phi = cos_deg(roll);
+			const double sin_phi = sin_deg(roll);
+			const double cos_the = cos_deg(pitch);
+			const double sin_the = sin_deg(pitch);
+			const double cos_psi = cos_deg(yaw);
+			const double sin_psi = sin_deg(yaw);
+
+			matrix::Dcmf &R = dcm[i];
+			R(0, 0) = static_cast<float>(cos_the * cos_psi);
+			R(0, 1) = static_cast<float>(-cos_phi * sin_psi + sin_phi * sin_the * cos_psi);
+			R(0, 2) = static_cast<float>(sin_phi * sin_psi + cos_phi * sin_the * cos_psi);
+			R(1, 0) = static_cast<float>(cos_the * sin_psi);
+			R(1, 1) = static_cast<float>(cos_phi * cos_psi + sin_phi * sin_the * sin_psi);
+			R(1, 2) = static_cast<float>(-sin_phi * cos_psi + cos_phi * sin_the * sin_psi);
+			R(2, 0) = static_cast<float>(-sin_the);
+			R(2, 1) = static_cast<float>(sin_phi * cos_the);
+			R(2, 2) = static_cast<float>(cos_phi * cos_the);
+
+			const double cos_phi_2 = cos_deg(roll / 2.);
+			const double sin_phi_2 = sin_deg(roll / 2.);
+			const double cos_the_2 = cos_deg(pitch / 2.);
+			const double sin_the_2 = sin_deg(pitch / 2.);
+			const double cos_psi_2 = cos_deg(yaw / 2.);
+			const double sin_psi_2 = sin_deg(yaw / 2.);
+
+			q[i] = matrix::Quatf(
+				       static_cast<float>(cos_phi_2 * cos_the_2 * cos_psi_2 + sin_phi_2 * sin_the_2 * sin_psi_2),
+				       static_cast<float>(sin_phi_2 * cos_the_2 * cos_psi_2 - cos_phi_2 * sin_the_2 * sin_psi_2),
+				       static_cast<float>(cos_phi_2 * sin_the_2 * cos_psi_2 + sin_phi_2 * cos_the_2 * sin_psi_2),
+				       static_cast<float>(cos_phi_2 * cos_the_2 * sin_psi_2 - sin_phi_2 * sin_the_2 * cos_psi_2));
+		}
+	}
+};
+
+constexpr RotationTables rotation_tables{};
+
+} // namespace
+
 __EXPORT matrix::Dcmf
 get_rot_matrix(enum Rotation rot)
 {
-	return matrix::Dcmf{matrix::Eulerf{
-			math::radians((float)rot_lookup[rot].roll),
-			math::radians((float)rot_lookup[rot].pitch),
-			math::radians((float)rot_lookup[rot].yaw)}};
+	return rotation_tables.dcm[rot];
 }
 
 __EXPORT matrix::Quatf
 get_rot_quaternion(enum Rotation rot)
 {
-	return matrix::Quatf{matrix::Eulerf{
-			math::radians((float)rot_lookup[rot].roll),
-			math::radians((float)rot_lookup[rot].pitch),
-			math::radians((float)rot_lookup[rot].yaw)}};
+	return rotation_tables.q[rot];
 }
 
 __EXPORT void
@@ -61,6 +61,7 @@ DatamanClient::DatamanClient()
 		request.timestamp = timestamp;
 		request.request_type = DM_GET_ID;
 		request.client_id = CLIENT_ID_NOT_SET;
+		request.count = 1;
 
 		bool success = syncHandler(request, response, timestamp, 1000_ms);
 
@@ -90,6 +91,7 @@ bool DatamanClient::syncHandler(const dataman_request_s &request, dataman_respon
 	int32_t ret = 0;
 	hrt_abstime time_elapsed = hrt_elapsed_time(&start_time);
 	perf_begin(_sync_perf);
+	drainResponses();
 	_dataman_request_pub.publish(request);
 
 	while (!response_received && (time_elapsed < timeout)) {
@@ -162,6 +164,7 @@ bool DatamanClient::readSync(dm_item_t item, uint32_t index, uint8_t *buffer, ui
 	request.client_id = _client_id;
 	request.request_type = DM_READ;
 	request.item = static_cast<uint8_t>(item);
+	request.count = 1;
 
 	dataman_response_s response{};
 	bool success = syncHandler(request, response, timestamp, timeout);
@@ -198,6 +201,7 @@ bool DatamanClient::writeSync(dm_item_t item, uint32_t index, uint8_t *buffer, u
 	request.client_id = _client_id;
 	request.request_type = DM_WRITE;
 	request.item = static_cast<uint8_t>(item);
+	request.count = 1;
 
 	memcpy(request.data, buffer, length);
 
@@ -226,6 +230,7 @@ bool DatamanClient::clearSync(dm_item_t item, hrt_abstime timeout)
 	request.client_id = _client_id;
 	request.request_type = DM_CLEAR;
 	request.item = static_cast<uint8_t>(item);
+	request.count = 1;
 
 	dataman_response_s response{};
 	bool success = syncHandler(request, response, timestamp, timeout);
@@ -243,6 +248,37 @@ bool DatamanClient::clearSync(dm_item_t item, hrt_abstime timeout)
 	return success;
 }
 
+void DatamanClient::drainResponses()
+{
+	bool updated = false;
+	orb_check(_dataman_response_sub, &updated);
+
+	while (updated) {
+		dataman_response_s response;
+		orb_copy(ORB_ID(dataman_response), _dataman_response_sub, &response);
+		orb_check(_dataman_response_sub, &updated);
+	}
+}
+
+void DatamanClient::startRequest(const dataman_request_s &request, uint8_t *buffer)
+{
+	drainResponses();
+
+	_active_request.timestamp = request.timestamp;
+	_active_request.request_type = static_cast<dm_function_t>(request.request_type);
+	_active_request.item = static_cast<dm_item_t>(request.item);
+	_active_request.index = request.index;
+	_active_request.buffer = buffer;
+	_active_request.length = request.data_length;
+	_active_request.count = request.count;
+	_active_request.received_mask = 0;
+
+	_response_status = dataman_response_s::STATUS_SUCCESS;
+	_state = State::RequestSent;
+
+	_dataman_request_pub.publish(request);
+}
+
 bool DatamanClient::readAsync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length)
 {
 	if (length > g_per_item_size[item]) {
@@ -254,26 +290,54 @@ bool DatamanClient::readAsync(dm_item_t item, uint32_t index, uint8_t *buffer, u
 
 	if (_state == State::Idle) {
 
-		hrt_abstime timestamp = hrt_absolute_time();
-
 		dataman_request_s request;
-		request.timestamp = timestamp;
+		request.timestamp = hrt_absolute_time();
 		request.index = index;
 		request.data_length = length;
 		request.client_id = _client_id;
 		request.request_type = DM_READ;
 		request.item = static_cast<uint8_t>(item);
+		request.count = 1;
+
+		startRequest(request, buffer);
+
+		success = true;
+	}
+
+	return success;
+}
+
+bool DatamanClient::readBatchAsync(dm_item_t item, uint32_t index, uint8_t count, uint8_t *const buffers[],
+				   uint32_t length)
+{
+	if (length > g_per_item_size[item]) {
+		PX4_ERR("Length  %" PRIu32 " can't fit in data size for item  %" PRIi8, length, static_cast<uint8_t>(item));
+		return false;
+	}
 
-		_active_request.timestamp = timestamp;
-		_active_request.request_type = DM_READ;
-		_active_request.item = item;
-		_active_request.index = index;
-		_active_request.buffer = buffer;
-		_active_request.length = length;
+	if (count == 0 || count > MAX_BATCH_COUNT) {
+		PX4_ERR("Invalid batch size %" PRIu8, count);
+		return false;
+	}
+
+	bool success = false;
+
+	if (_state == State::Idle) {
+
+		for (uint8_t i = 0; i < count; ++i) {
+			_active_request.batch_buffers[i] = buffers[i];
+		}
 
-		_state = State::RequestSent;
+		dataman_request_s request;
+		request.timestamp = hrt_absolute_time();
+		request.index = index;
+		request.data_length = length;
+		request.client_id = _client_id;
+		request.request_type = DM_READ;
+		request.item = static_cast<uint8_t>(item);
+		request.count = count;
 
-		_dataman_request_pub.publish(request);
+		startRequest(request, buffers[0]);
 
 		success = true;
 	}
@@ -292,28 +356,18 @@ bool DatamanClient::writeAsync(dm_item_t item, uint32_t index, uint8_t *buffer,
 
 	if (_state == State::Idle) {
 
-		hrt_abstime timestamp = hrt_absolute_time();
-
 		dataman_request_s request;
-		request.timestamp = timestamp;
+		request.timestamp = hrt_absolute_time();
 		request.index = index;
 		request.data_length = length;
 		request.client_id = _client_id;
 		request.request_type = DM_WRITE;
 		request.item = static_cast<uint8_t>(item);
+		request.count = 1;
 
 		memcpy(request.data, buffer, length);
 
-		_active_request.timestamp = timestamp;
-		_active_request.request_type = DM_WRITE;
-		_active_request.item = item;
-		_active_request.index = index;
-		_active_request.buffer = buffer;
-		_active_request.length = length;
-
-		_state = State::RequestSent;
-
-		_dataman_request_pub.publish(request);
+		startRequest(request, buffer);
 
 		success = true;
 	}
@@ -327,22 +381,16 @@ bool DatamanClient::clearAsync(dm_item_t item)
 
 	if (_state == State::Idle) {
 
-		hrt_abstime timestamp = hrt_absolute_time();
-
 		dataman_request_s request;
-		request.timestamp = timestamp;
+		request.timestamp = hrt_absolute_time();
 		request.client_id = _client_id;
 		request.request_type = DM_CLEAR;
 		request.item = static_cast<uint8_t>(item);
 		request.index = 0;
+		request.data_length = 0;
+		request.count = 1;
 
-		_active_request.timestamp = timestamp;
-		_active_request.request_type = DM_CLEAR;
-		_active_request.item = item;
-		_active_request.index = request.index;
-		_state = State::RequestSent;
-
-		_dataman_request_pub.publish(request);
+		startRequest(request, nullptr);
 
 		success = true;
 	}
@@ -357,30 +405,41 @@ void DatamanClient::update()
 		bool updated = false;
 		orb_check(_dataman_response_sub, &updated);
 
-		dataman_response_s response;
+		// A batch read is answered with one response per item, consume all that are queued
+		while (updated && (_state == State::RequestSent)) {
 
-		if (updated) {
+			dataman_response_s response;
 			orb_copy(ORB_ID(dataman_response), _dataman_response_sub, &response);
 
 			if ((response.client_id == _client_id) &&
 			    (response.request_type == _active_request.request_type) &&
 			    (response.item == _active_request.item) &&
-			    (response.index == _active_request.index)) {
+			    (response.index >= _active_request.index) &&
+			    (response.index - _active_request.index < _active_request.count)) {
+
+				const uint32_t offset = response.index - _active_request.index;
 
 				if (response.request_type == DM_READ) {
-					memcpy(_active_request.buffer, response.data, _active_request.length);
+					uint8_t *buffer = (_active_request.count > 1) ? _active_request.batch_buffers[offset] : _active_request.buffer;
+					memcpy(buffer, response.data, _active_request.length);
 				}
 
-				_response_status = response.status;
+				if (response.status != dataman_response_s::STATUS_SUCCESS) {
 
-				if (_response_status != dataman_response_s::STATUS_SUCCESS) {
+					_response_status = response.status;
 
 					PX4_ERR("Async request type %" PRIu8 " failed! status=%" PRIu8 " item=%" PRIu8 " index=%" PRIu32,
-						response.request_type, response.status, static_cast<uint8_t>(_active_request.item), _active_request.index);
+						response.request_type, response.status, static_cast<uint8_t>(_active_request.item), response.index);
 				}
 
-				_state = State::ResponseReceived;
+				_active_request.received_mask |= (1u << offset);
+
+				if (_active_request.received_mask == (1u << _active_request.count) - 1u) {
+					_state = State::ResponseReceived;
+				}
 			}
+
+			orb_check(_dataman_response_sub, &updated);
 		}
 
 		if (_state == State::RequestSent) {
@@ -401,6 +460,7 @@ void DatamanClient::update()
 				request.client_id = _client_id;
 				request.request_type = static_cast<uint8_t>(_active_request.request_type);
 				request.item = static_cast<uint8_t>(_active_request.item);
+				request.count = _active_request.count;
 
 				if (_active_request.request_type == DM_WRITE) {
 					memcpy(request.data, _active_request.buffer, _active_request.length);
@@ -463,8 +523,16 @@ void DatamanCache::resize(uint32_t num_items)
 	if (new_items != nullptr) {
 		uint32_t num_min = num_items < _num_items ? num_items : _num_items;
 
+		// the request in flight points into the old items, request them again
+		_client.abortCurrentOperation();
+		_batch_size = 0;
+
 		for (uint32_t i = 0; i < num_min; ++i) {
 			new_items[i] = _items[i];
+
+			if (new_items[i].cache_state == State::RequestSent) {
+				new_items[i].cache_state = State::RequestPrepared;
+			}
 		}
 
 		delete[] _items;
@@ -513,6 +581,41 @@ bool DatamanCache::load(dm_item_t item, uint32_t index)
 	return success;
 }
 
+uint32_t DatamanCache::prefetch(dm_item_t item, uint32_t index, uint32_t count, bool reverse)
+{
+	uint32_t num_loaded = 0;
+
+	for (uint32_t i = 0; i < count; ++i) {
+		if (reverse && i > index) {
+			break;
+		}
+
+		if (!load(item, reverse ? index - i : index + i)) {
+			// either already cached or the cache is full
+			if (_item_counter >= _num_items) {
+				break;
+			}
+
+			continue;
+		}
+
+		++num_loaded;
+	}
+
+	return num_loaded;
+}
+
+bool DatamanCache::setGeneration(uint32_t generation)
+{
+	if (generation == _generation) {
+		return false;
+	}
+
+	_generation = generation;
+	invalidate();
+	return true;
+}
+
 bool DatamanCache::loadWait(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length, hrt_abstime timeout)
 {
 	if (length > g_per_item_size[item]) {
@@ -604,34 +707,65 @@ void DatamanCache::update()
 			changeUpdateIndex();
 			break;
 
-		case State::RequestPrepared:
+		case State::RequestPrepared: {
+				// Batch the following prepared items of the same type with consecutive indexes (either direction)
+				const Item &first = _items[_update_index];
+				uint32_t batch_size = 1;
+				int32_t step = 0;
 
-			success = _client.readAsync(static_cast<dm_item_t>(_items[_update_index].response.item),
-						    _items[_update_index].response.index,
-						    _items[_update_index].response.data,
-						    g_per_item_size[_items[_update_index].response.item]);
+				while ((batch_size < DatamanClient::MAX_BATCH_COUNT) && (batch_size < _item_counter)) {
+					const Item &previous = _items[(_update_index + batch_size - 1) % _num_items];
+					const Item &next = _items[(_update_index + batch_size) % _num_items];
+					const int32_t next_step = static_cast<int32_t>(next.response.index - previous.response.index);
 
-			if (success) {
-				_items[_update_index].cache_state = State::RequestSent;
+					if ((next.cache_state != State::RequestPrepared) || (next.response.item != first.response.item) ||
+					    (next_step != 1 && next_step != -1) || (step != 0 && next_step != step)) {
+						break;
+					}
 
-			} else {
-				_items[_update_index].cache_state = State::Error;
-			}
+					step = next_step;
+					++batch_size;
+				}
+
+				const uint32_t first_index = (step < 0) ? first.response.index - (batch_size - 1) : first.response.index;
+				uint8_t *buffers[DatamanClient::MAX_BATCH_COUNT];
+
+				for (uint32_t i = 0; i < batch_size; ++i) {
+					Item &batch_item = _items[(_update_index + i) % _num_items];
+					buffers[batch_item.response.index - first_index] = batch_item.response.data;
+				}
+
+				success = _client.readBatchAsync(static_cast<dm_item_t>(first.response.item), first_index, batch_size, buffers,
+								 g_per_item_size[first.response.item]);
 
+				if (success) {
+					for (uint32_t i = 0; i < batch_size; ++i) {
+						_items[(_update_index + i) % _num_items].cache_state = State::RequestSent;
+					}
+
+					_batch_size = batch_size;
+
+				} else {
+					_items[_update_index].cache_state = State::Error;
+				}
+			}
 			break;
 
 		case State::RequestSent:
 
 			if (_client.lastOperationCompleted(response_success)) {
 
-				if (response_success) {
+				if (!response_success) {
+					PX4_ERR("Caching: item %" PRIu8 ", index %" PRIu32", %" PRIu32 " items failed",
+						_items[_update_index].response.item, _items[_update_index].response.index, _batch_size);
+				}
 
-					_items[_update_index].cache_state = State::ResponseReceived;
+				for (uint32_t i = 0; i < _batch_size; ++i) {
+					_items[_update_index].cache_state = response_success ? State::ResponseReceived : State::Error;
 					changeUpdateIndex();
-
-				} else {
-					_items[_update_index].cache_state = State::Error;
 				}
+
+				_batch_size = 0;
 			}
 
 			break;
@@ -661,6 +795,7 @@ void DatamanCache::invalidate()
 	_update_index = 0;
 	_item_counter = 0;
 	_load_index = 0;
+	_batch_size = 0;
 	_client.abortCurrentOperation();
 }
 
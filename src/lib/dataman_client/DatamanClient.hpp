@@ -119,6 +119,24 @@ public:
 	 */
 	bool writeAsync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length);
 
+	/**
+	 * @brief Initiates an asynchronous request to read consecutive items of the same type.
+	 *
+	 * A single request is sent and dataman answers with one response per item, so N items take one round trip.
+	 *
+	 * @param[in] item The item to read from.
+	 * @param[in] index The index of the first item to read.
+	 * @param[in] count The number of items to read, at most MAX_BATCH_COUNT.
+	 * @param[out] buffers The buffers to store the read data in, buffers[i] receives the item at index + i.
+	 * @param[in] length The length of the data to read per item.
+	 *
+	 * @return True if the read request was successfully queued, false otherwise.
+	 *
+	 * @note The buffers must be kept alive as long as the request did not finish. The request completes
+	 *       once all items are received, the status can be obtained with the lastOperationCompleted() function.
+	 */
+	bool readBatchAsync(dm_item_t item, uint32_t index, uint8_t count, uint8_t *const buffers[], uint32_t length);
+
 	/**
 	 * @brief Initiates an asynchronous request to clear an item in dataman.
 	 *
@@ -153,6 +171,8 @@ public:
 	 */
 	void abortCurrentOperation();
 
+	static constexpr uint8_t MAX_BATCH_COUNT{dataman_request_s::MAX_BATCH_COUNT};
+
 private:
 
 	enum class State {
@@ -168,8 +188,20 @@ private:
 		uint32_t index;
 		uint8_t *buffer;
 		uint32_t length;
+		uint8_t count;				///< number of items requested, > 1 for a batch read
+		uint8_t received_mask;			///< bit i is set once the response for index + i arrived
+		uint8_t *batch_buffers[MAX_BATCH_COUNT];
 	};
 
+	static_assert(MAX_BATCH_COUNT <= 8, "received_mask too small");
+	static_assert(MAX_BATCH_COUNT <= dataman_response_s::ORB_QUEUE_LENGTH, "responses of a batch can get lost");
+
+	/* Discard queued responses, they can only be left over from earlier requests */
+	void drainResponses();
+
+	/* Prepare _active_request for a new async request */
+	void startRequest(const dataman_request_s &request, uint8_t *buffer);
+
 	/* Synchronous response/request handler */
 	bool syncHandler(const dataman_request_s &request, dataman_response_s &response,
 			 const hrt_abstime &start_time, hrt_abstime timeout);
@@ -222,6 +254,31 @@ public:
 	 */
 	bool load(dm_item_t item, uint32_t index);
 
+	/**
+	 * @brief Adds consecutive indexes for items to be cached, e.g. the next items of a mission.
+	 *
+	 * Consecutive items are requested from dataman in batches by 'update()'.
+	 *
+	 * @param[in] item The item to load.
+	 * @param[in] index The index of the first item to load.
+	 * @param[in] count The number of items to load.
+	 * @param[in] reverse Load the items index, index - 1, ... instead of index, index + 1, ...
+	 *
+	 * @return the number of items added to be cached, limited by the size of the cache.
+	 */
+	uint32_t prefetch(dm_item_t item, uint32_t index, uint32_t count, bool reverse = false);
+
+	/**
+	 * @brief Set the generation of the cached data, e.g. a mission or fence id.
+	 *
+	 * The cache is invalidated if the generation differs from the previous one.
+	 *
+	 * @param[in] generation Generation of the data the cache is used for.
+	 *
+	 * @return true if the generation changed and the cache was invalidated.
+	 */
+	bool setGeneration(uint32_t generation);
+
 	/**
 	 * @brief Loads for a specific item from the cache or acquires and wait for it if not found in the cache.
 	 *
@@ -299,6 +356,8 @@ private:
 	uint32_t _update_index{0};	///< index for tracking last index used by update function
 	uint32_t _item_counter{0};	///< number of items to process with update function
 	uint32_t _num_items{0};		///< number of items that cache can store
+	uint32_t _batch_size{0};	///< number of items in the request in flight, starting at _update_index
+	uint32_t _generation{0};	///< generation of the cached data, see setGeneration()
 
 	DatamanClient _client{};
 
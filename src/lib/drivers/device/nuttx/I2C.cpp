@@ -45,6 +45,8 @@
 #if defined(CONFIG_I2C)
 
 #include <px4_platform_common/i2c_spi_buses.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 #include <nuttx/i2c/i2c_master.h>
 
 namespace device
@@ -56,6 +58,127 @@ namespace device
 
 unsigned int I2C::_bus_clocks[PX4_NUMBER_I2C_BUSES] = PX4_I2C_BUS_CLOCK_INIT;
 
+/**
+ * Queue of non-blocking transactions of all devices on a bus, executed in a single bus transfer
+ * (repeated start between the messages) on the bus work queue.
+ */
+class I2C::BusQueue : public px4::WorkItem
+{
+public:
+	explicit BusQueue(const px4::wq_config_t &config) : px4::WorkItem("i2c_bus_queue", config) {}
+
+	struct Transaction {
+		I2C *device;
+		const uint8_t *send;
+		unsigned send_len;
+		uint8_t *recv;
+		unsigned recv_len;
+		transfer_callback_t callback;
+		void *arg;
+	};
+
+	bool push(const Transaction &transaction)
+	{
+		irqstate_t flags = px4_enter_critical_section();
+		const bool queued = (_count < MAX_TRANSACTIONS);
+
+		if (queued) {
+			_transactions[_count++] = transaction;
+		}
+
+		px4_leave_critical_section(flags);
+
+		if (queued) {
+			ScheduleNow();
+		}
+
+		return queued;
+	}
+
+	void cancel(const I2C *device)
+	{
+		irqstate_t flags = px4_enter_critical_section();
+		int count = 0;
+
+		for (int i = 0; i < _count; i++) {
+			if (_transactions[i].device != device) {
+				_transactions[count++] = _transactions[i];
+			}
+		}
+
+		_count = count;
+		px4_leave_critical_section(flags);
+	}
+
+private:
+	static constexpr int MAX_TRANSACTIONS = 16;
+
+	void Run() override;
+
+	Transaction _transactions[MAX_TRANSACTIONS] {};
+	int _count{0};
+};
+
+I2C::BusQueue *I2C::_bus_queues[PX4_NUMBER_I2C_BUSES] {};
+
+void I2C::BusQueue::Run()
+{
+	Transaction transactions[MAX_TRANSACTIONS];
+
+	irqstate_t flags = px4_enter_critical_section();
+	const int count = _count;
+	memcpy(transactions, _transactions, sizeof(Transaction) * count);
+	_count = 0;
+	px4_leave_critical_section(flags);
+
+	if (count == 0) {
+		return;
+	}
+
+	i2c_msg_s msgv[MAX_TRANSACTIONS * 2] {};
+	unsigned msgs = 0;
+
+	for (int i = 0; i < count; i++) {
+		const Transaction &t = transactions[i];
+		const uint32_t frequency = _bus_clocks[t.device->get_device_bus() - 1];
+
+		if (t.send_len > 0) {
+			msgv[msgs].frequency = frequency;
+			msgv[msgs].addr = t.device->get_device_address();
+			msgv[msgs].flags = 0;
+			msgv[msgs].buffer = const_cast<uint8_t *>(t.send);
+			msgv[msgs].length = t.send_len;
+			msgs++;
+		}
+
+		if (t.recv_len > 0) {
+			msgv[msgs].frequency = frequency;
+			msgv[msgs].addr = t.device->get_device_address();
+			msgv[msgs].flags = I2C_M_READ;
+			msgv[msgs].buffer = t.recv;
+			msgv[msgs].length = t.recv_len;
+			msgs++;
+		}
+	}
+
+	const bool success = (I2C_TRANSFER(transactions[0].device->_dev, &msgv[0], msgs) == 0);
+
+	for (int i = 0; i < count; i++) {
+		const Transaction &t = transactions[i];
+		int result = PX4_OK;
+
+		if (!success) {
+			// the bus transfer stops at the first failure (eg NACK), repeat each transaction
+			// individually (with the device's retries) to complete them with their own result
+			result = t.device->transfer(t.send, t.send_len, t.recv, t.recv_len);
+		}
+
+		if (t.callback) {
+			t.callback(t.arg, result);
+		}
+	}
+}
+
 I2C::I2C(uint8_t device_type, const char *name, const int bus, const uint16_t address, const uint32_t frequency) :
 	CDev(name, nullptr),
 	_frequency(frequency)
@@ -74,6 +197,13 @@ I2C::I2C(const I2CSPIDriverConfig &config)
 
 I2C::~I2C()
 {
+	// drop any queued transactions of this device
+	const int bus_index = get_device_bus() - 1;
+
+	if ((bus_index >= 0) && (bus_index < PX4_NUMBER_I2C_BUSES) && (_bus_queues[bus_index] != nullptr)) {
+		_bus_queues[bus_index]->cancel(this);
+	}
+
 	if (_dev) {
 		px4_i2cbus_uninitialize(_dev);
 		_dev = nullptr;
@@ -239,6 +369,37 @@ I2C::transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const
 	return ret;
 }
 
+int
+I2C::transferQueued(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len,
+		    transfer_callback_t callback, void *arg)
+{
+	if (_dev == nullptr) {
+		PX4_ERR("I2C device not opened");
+		return PX4_ERROR;
+	}
+
+	if ((send_len == 0) && (recv_len == 0)) {
+		return -EINVAL;
+	}
+
+	// all devices on a bus run on the same bus work queue, so the lazy allocation is serialized
+	const int bus_index = get_device_bus() - 1;
+
+	if (_bus_queues[bus_index] == nullptr) {
+		_bus_queues[bus_index] = new BusQueue(px4::device_bus_to_wq(get_device_id()));
+
+		if (_bus_queues[bus_index] == nullptr) {
+			return -ENOMEM;
+		}
+	}
+
+	if (!_bus_queues[bus_index]->push(BusQueue::Transaction{this, send, send_len, recv, recv_len, callback, arg})) {
+		return -EBUSY;
+	}
+
+	return PX4_OK;
+}
+
 } // namespace device
 
 #endif // CONFIG_I2C
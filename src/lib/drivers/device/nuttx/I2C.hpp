@@ -108,10 +108,41 @@ protected:
 	 */
 	int		transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len);
 
+	/**
+	 * Completion callback of a queued transaction, called from the bus work queue.
+	 *
+	 * @param arg		Argument passed to transferQueued().
+	 * @param result	OK if the transfer was successful, PX4_ERROR otherwise.
+	 */
+	typedef void (*transfer_callback_t)(void *arg, int result);
+
+	/**
+	 * Queue an I2C transaction to the device without blocking.
+	 *
+	 * The transactions queued by all devices on the bus are executed back to back
+	 * in a single bus transfer on the bus work queue, each one completes with its callback.
+	 * Transactions of a device are executed in order. The buffers must remain valid until completion.
+	 *
+	 * At least one of send_len and recv_len must be non-zero.
+	 *
+	 * @param send		Pointer to bytes to send.
+	 * @param send_len	Number of bytes to send.
+	 * @param recv		Pointer to buffer for bytes received.
+	 * @param recv_len	Number of bytes to receive.
+	 * @param callback	Completion callback (optional).
+	 * @param arg		Argument passed to the callback.
+	 * @return		OK if the transaction was queued, -errno otherwise.
+	 */
+	int		transferQueued(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len,
+				       transfer_callback_t callback = nullptr, void *arg = nullptr);
+
 	bool	external() const override { return px4_i2c_device_external(_device_id.devid); }
 
 private:
+	class BusQueue;
+
 	static unsigned	int	_bus_clocks[PX4_NUMBER_I2C_BUSES];
+	static BusQueue		*_bus_queues[PX4_NUMBER_I2C_BUSES];
 
 	const uint32_t		_frequency;
 	i2c_master_s		*_dev{nullptr};
@@ -119,6 +119,30 @@ protected:
 	 */
 	int		transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len);
 
+	/**
+	 * Completion callback of a queued transaction.
+	 *
+	 * @param arg		Argument passed to transferQueued().
+	 * @param result	OK if the transfer was successful, -errno otherwise.
+	 */
+	typedef void (*transfer_callback_t)(void *arg, int result);
+
+	/**
+	 * Queue an I2C transaction to the device (see nuttx/I2C.hpp).
+	 * Executed immediately on this platform, the callback is called before returning.
+	 */
+	int		transferQueued(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len,
+				       transfer_callback_t callback = nullptr, void *arg = nullptr)
+	{
+		const int result = transfer(send, send_len, recv, recv_len);
+
+		if (callback) {
+			callback(arg, result);
+		}
+
+		return PX4_OK;
+	}
+
 	virtual bool	external() const override { return px4_i2c_bus_external(_device_id.devid_s.bus); }
 
 private:
@@ -136,42 +136,74 @@ void PX4Gyroscope::update(const hrt_abstime &timestamp_sample, float x, float y,
 
 void PX4Gyroscope::updateFIFO(sensor_gyro_fifo_s &sample)
 {
-	// rotate all raw samples and publish fifo
 	const uint8_t N = sample.samples;
 
+	// rotate all raw samples directly into the queue slot of the fifo topic (or in place if it can't be loaned)
+	sensor_gyro_fifo_s *fifo = _sensor_fifo_pub.loan();
+	const bool loaned = (fifo != nullptr);
+
+	if (!loaned) {
+		fifo = &sample;
+	}
+
 	for (int n = 0; n < N; n++) {
-		rotate_3i(_rotation, sample.x[n], sample.y[n], sample.z[n]);
+		int16_t x = sample.x[n];
+		int16_t y = sample.y[n];
+		int16_t z = sample.z[n];
+		rotate_3i(_rotation, x, y, z);
+		fifo->x[n] = x;
+		fifo->y[n] = y;
+		fifo->z[n] = z;
+	}
+
+	if (loaned) {
+		// the slot still holds an older message
+		const size_t unused = sizeof(fifo->x[0]) * (sizeof(fifo->x) / sizeof(fifo->x[0]) - N);
+		memset(&fifo->x[N], 0, unused);
+		memset(&fifo->y[N], 0, unused);
+		memset(&fifo->z[N], 0, unused);
+
+		fifo->timestamp_sample = sample.timestamp_sample;
+		fifo->dt = sample.dt;
+		fifo->samples = N;
 	}
 
-	sample.device_id = _device_id;
-	sample.scale = _scale;
-	sample.timestamp = hrt_absolute_time();
-	_sensor_fifo_pub.publish(sample);
+	fifo->device_id = _device_id;
+	fifo->scale = _scale;
+	fifo->timestamp = hrt_absolute_time();
 
+	// integrate before publishing, a loaned slot must not be accessed after the commit
+	const sensor_gyro_fifo_s &rotated = *fifo;
 
-	// publish
 	sensor_gyro_s report;
-	report.timestamp_sample = sample.timestamp_sample;
+	report.timestamp_sample = rotated.timestamp_sample;
 	report.device_id = _device_id;
 	report.temperature = _temperature;
 	report.error_count = _error_count;
 
 	// trapezoidal integration (equally spaced)
 	const float scale = _scale / (float)N;
-	report.x = (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum(sample.x, N - 1)) * scale;
-	report.y = (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum(sample.y, N - 1)) * scale;
-	report.z = (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum(sample.z, N - 1)) * scale;
+	report.x = (0.5f * (_last_sample[0] + rotated.x[N - 1]) + sum(rotated.x, N - 1)) * scale;
+	report.y = (0.5f * (_last_sample[1] + rotated.y[N - 1]) + sum(rotated.y, N - 1)) * scale;
+	report.z = (0.5f * (_last_sample[2] + rotated.z[N - 1]) + sum(rotated.z, N - 1)) * scale;
 
-	_last_sample[0] = sample.x[N - 1];
-	_last_sample[1] = sample.y[N - 1];
-	_last_sample[2] = sample.z[N - 1];
+	_last_sample[0] = rotated.x[N - 1];
+	_last_sample[1] = rotated.y[N - 1];
+	_last_sample[2] = rotated.z[N - 1];
 
-	report.clip_counter[0] = clipping(sample.x, N);
-	report.clip_counter[1] = clipping(sample.y, N);
-	report.clip_counter[2] = clipping(sample.z, N);
+	report.clip_counter[0] = clipping(rotated.x, N);
+	report.clip_counter[1] = clipping(rotated.y, N);
+	report.clip_counter[2] = clipping(rotated.z, N);
 	report.samples = N;
-	report.timestamp = hrt_absolute_time();
 
+	if (loaned) {
+		_sensor_fifo_pub.commit();
+
+	} else {
+		_sensor_fifo_pub.publish(sample);
+	}
+
+	report.timestamp = hrt_absolute_time();
 	_sensor_pub.publish(report);
 }
 
@@ -67,4 +67,26 @@ void send(event_s &event)
 	pthread_mutex_unlock(&publish_event_mutex);
 }
 
+void send(event_s *events, int num_events)
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	pthread_mutex_lock(&publish_event_mutex);
+
+	for (int i = 0; i < num_events; ++i) {
+		event_s &event = events[i];
+		event.timestamp = now;
+		event.event_sequence = ++event_sequence;
+
+		if (orb_event_pub != nullptr) {
+			orb_publish(ORB_ID(event), orb_event_pub, &event);
+
+		} else {
+			orb_event_pub = orb_advertise(ORB_ID(event), &event);
+		}
+	}
+
+	pthread_mutex_unlock(&publish_event_mutex);
+}
+
 } /* namespace events */
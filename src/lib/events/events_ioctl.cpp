@@ -54,6 +54,12 @@ static int events_ioctl(unsigned int cmd, unsigned long arg)
 		}
 		break;
 
+	case EVENTSIOCSENDBATCH: {
+			eventiocsendbatch_t *data = (eventiocsendbatch_t *)arg;
+			events::send(data->events, data->num_events);
+		}
+		break;
+
 	default:
 		ret = -ENOTTY;
 		break;
@@ -49,3 +49,9 @@
 typedef struct eventiocsend {
 	event_s &event;
 } eventiocsend_t;
+
+#define EVENTSIOCSENDBATCH _EVENTSIOC(2)
+typedef struct eventiocsendbatch {
+	event_s *events;
+	int num_events;
+} eventiocsendbatch_t;
@@ -50,4 +50,10 @@ void send(event_s &event)
 	boardctl(EVENTSIOCSEND, reinterpret_cast<unsigned long>(&data));
 }
 
+void send(event_s *events, int num_events)
+{
+	eventiocsendbatch_t data = {events, num_events};
+	boardctl(EVENTSIOCSENDBATCH, reinterpret_cast<unsigned long>(&data));
+}
+
 } /* namespace events */
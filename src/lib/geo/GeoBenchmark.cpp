@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+#include <benchmark/benchmark.h>
+#include <lib/geo/geo.h>
+
+static constexpr int kNumPoints{1000};
+
+// points within 2 km of the reference
+struct Points {
+	Points()
+	{
+		proj.initReference(473566094 / 1e7, 85190237 / 1e7, 0);
+
+		for (int i = 0; i < kNumPoints; i++) {
+			proj.reproject(2000.f * cosf(i * 0.1f), 2000.f * sinf(i * 0.3f), lat[i], lon[i]);
+		}
+	}
+
+	MapProjection proj;
+	double lat[kNumPoints];
+	double lon[kNumPoints];
+};
+
+// Args: fast projection (0 or 1)
+static void BM_Project(benchmark::State &state)
+{
+	const Points points;
+	matrix::Vector2f xy[kNumPoints];
+
+	for (auto _ : state) {
+		points.proj.project(points.lat, points.lon, xy, kNumPoints, state.range(0));
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * kNumPoints);
+}
+BENCHMARK(BM_Project)->Arg(0)->Arg(1);
+
+// Args: flat earth approximation (0 or 1)
+static void BM_DistanceToNextWaypoint(benchmark::State &state)
+{
+	const Points points;
+	int run = 0;
+
+	for (auto _ : state) {
+		const double lat = points.lat[run];
+		const double lon = points.lon[run];
+		run = (run + 1) % kNumPoints;
+
+		for (int i = 0; i < kNumPoints; i++) {
+			if (state.range(0)) {
+				benchmark::DoNotOptimize(get_distance_to_next_waypoint_fast(lat, lon, points.lat[i], points.lon[i]));
+
+			} else {
+				benchmark::DoNotOptimize(get_distance_to_next_waypoint(lat, lon, points.lat[i], points.lon[i]));
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * kNumPoints);
+}
+BENCHMARK(BM_DistanceToNextWaypoint)->Arg(0)->Arg(1);
@@ -109,6 +109,36 @@ void MapProjection::reproject(float x, float y, double &lat, double &lon) const
 	}
 }
 
+void MapProjection::projectFast(double lat, double lon, float &x, float &y) const
+{
+	const double d_lat = math::radians(lat) - _ref_lat;
+	const double d_lon = matrix::wrap_pi(math::radians(lon) - _ref_lon);
+
+	x = static_cast<float>(d_lat * CONSTANTS_RADIUS_OF_EARTH);
+	y = static_cast<float>(d_lon * _ref_cos_lat * CONSTANTS_RADIUS_OF_EARTH);
+}
+
+void MapProjection::reprojectFast(float x, float y, double &lat, double &lon) const
+{
+	lat = math::degrees(_ref_lat + (double)x / CONSTANTS_RADIUS_OF_EARTH);
+	lon = math::degrees(matrix::wrap_pi(_ref_lon + (double)y / (CONSTANTS_RADIUS_OF_EARTH * _ref_cos_lat)));
+}
+
+void MapProjection::project(const double lat[], const double lon[], matrix::Vector2f xy[], size_t count,
+			    bool fast) const
+{
+	if (fast) {
+		for (size_t i = 0; i < count; i++) {
+			projectFast(lat[i], lon[i], xy[i](0), xy[i](1));
+		}
+
+	} else {
+		for (size_t i = 0; i < count; i++) {
+			project(lat[i], lon[i], xy[i](0), xy[i](1));
+		}
+	}
+}
+
 float get_distance_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next)
 {
 	const double lat_now_rad = math::radians(lat_now);
@@ -125,6 +155,17 @@ float get_distance_to_next_waypoint(double lat_now, double lon_now, double lat_n
 	return static_cast<float>(CONSTANTS_RADIUS_OF_EARTH * 2.0 * c);
 }
 
+float get_distance_to_next_waypoint_fast(double lat_now, double lon_now, double lat_next, double lon_next)
+{
+	const double mean_lat_rad = math::radians((lat_now + lat_next) * 0.5);
+
+	const float d_north = static_cast<float>(math::radians(lat_next - lat_now) * CONSTANTS_RADIUS_OF_EARTH);
+	const float d_east = static_cast<float>(matrix::wrap_pi(math::radians(lon_next - lon_now)) * cos(mean_lat_rad)
+					       * CONSTANTS_RADIUS_OF_EARTH);
+
+	return sqrtf(d_north * d_north + d_east * d_east);
+}
+
 void create_waypoint_from_line_and_dist(double lat_A, double lon_A, double lat_B, double lon_B, float dist,
 					double *lat_target, double *lon_target)
 {
@@ -214,3 +214,83 @@ TEST_F(GeoTest, waypoint_from_line_and_negative_distance)
 	EXPECT_FLOAT_EQ(lat_start - lat_offset, lat_target);
 	EXPECT_DOUBLE_EQ(lon_start, lon_target);
 }
+
+TEST_F(GeoTest, projectFastWithinErrorBound)
+{
+	for (double lat_ref = -60.0; lat_ref <= 60.0; lat_ref += 30.0) {
+		// GIVEN: a reference and points on a circle of 1 km and 10 km around it
+		MapProjection ref(lat_ref, 8.5);
+
+		for (float dist : {1000.f, 10000.f}) {
+			const float bound = dist * dist * tanf(math::radians(fabsf((float)lat_ref))) / CONSTANTS_RADIUS_OF_EARTH_F + 0.01f;
+
+			for (float bearing = 0.f; bearing < 2.f * M_PI_F; bearing += 0.5f) {
+				double lat;
+				double lon;
+				ref.reproject(dist * cosf(bearing), dist * sinf(bearing), lat, lon);
+
+				// WHEN: we project the point exactly and with the flat earth approximation
+				const matrix::Vector2f exact = ref.project(lat, lon);
+				float x_fast;
+				float y_fast;
+				ref.projectFast(lat, lon, x_fast, y_fast);
+
+				// THEN: the difference should stay within the documented bound
+				EXPECT_LT((exact - matrix::Vector2f(x_fast, y_fast)).norm(), bound) << lat_ref << " " << dist;
+
+				// AND: the fast reprojection should be its inverse
+				double lat_back;
+				double lon_back;
+				ref.reprojectFast(x_fast, y_fast, lat_back, lon_back);
+				EXPECT_NEAR(lat, lat_back, 1e-7);
+				EXPECT_NEAR(lon, lon_back, 1e-7);
+			}
+		}
+	}
+}
+
+TEST_F(GeoTest, projectBatch)
+{
+	// GIVEN: a few points around the reference
+	const double lat[] {47.3566094, 47.3570000, 47.3500000, 47.3600000};
+	const double lon[] {8.5190237, 8.5200000, 8.5100000, 8.5300000};
+	matrix::Vector2f xy[4];
+	matrix::Vector2f xy_fast[4];
+
+	// WHEN: we project them as a batch
+	proj.project(lat, lon, xy, 4);
+	proj.project(lat, lon, xy_fast, 4, true);
+
+	// THEN: the results should match the single point functions
+	for (int i = 0; i < 4; i++) {
+		const matrix::Vector2f single = proj.project(lat[i], lon[i]);
+		float x_fast;
+		float y_fast;
+		proj.projectFast(lat[i], lon[i], x_fast, y_fast);
+		EXPECT_FLOAT_EQ(xy[i](0), single(0));
+		EXPECT_FLOAT_EQ(xy[i](1), single(1));
+		EXPECT_FLOAT_EQ(xy_fast[i](0), x_fast);
+		EXPECT_FLOAT_EQ(xy_fast[i](1), y_fast);
+	}
+}
+
+TEST_F(GeoTest, distanceFast)
+{
+	for (double lat = -70.0; lat <= 70.0; lat += 20.0) {
+		for (float dist : {10.f, 1000.f, 100000.f}) {
+			for (float bearing = 0.f; bearing < 2.f * M_PI_F; bearing += 0.7f) {
+				// GIVEN: two points at a known distance
+				double lat_next;
+				double lon_next;
+				waypoint_from_heading_and_distance(lat, 179.9, bearing, dist, &lat_next, &lon_next);
+
+				// WHEN: we get the distance with the flat earth approximation
+				const float exact = get_distance_to_next_waypoint(lat, 179.9, lat_next, lon_next);
+				const float fast = get_distance_to_next_waypoint_fast(lat, 179.9, lat_next, lon_next);
+
+				// THEN: it should match the haversine distance, also across the antimeridian
+				EXPECT_NEAR(fast, exact, exact * 1e-4f + 1e-3f) << lat << " " << dist << " " << bearing;
+			}
+		}
+	}
+}
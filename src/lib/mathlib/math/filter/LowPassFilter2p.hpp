@@ -111,9 +111,28 @@ public:
 	// Filter array of samples in place using the Direct form II.
 	inline void applyArray(T samples[], int num_samples)
 	{
+		// local copies, samples[] could otherwise alias the members (see NotchFilter::applyArray)
+		const float b0 = _b0;
+		const float b1 = _b1;
+		const float b2 = _b2;
+		const float a1 = _a1;
+		const float a2 = _a2;
+
+		T delay_element_1 = _delay_element_1;
+		T delay_element_2 = _delay_element_2;
+
 		for (int n = 0; n < num_samples; n++) {
-			samples[n] = apply(samples[n]);
+			// Direct Form II implementation
+			const T delay_element_0{samples[n] - delay_element_1 * a1 - delay_element_2 * a2};
+
+			samples[n] = delay_element_0 * b0 + delay_element_1 * b1 + delay_element_2 * b2;
+
+			delay_element_2 = delay_element_1;
+			delay_element_1 = delay_element_0;
 		}
+
+		_delay_element_1 = delay_element_1;
+		_delay_element_2 = delay_element_2;
 	}
 
 	// Return the cutoff frequency
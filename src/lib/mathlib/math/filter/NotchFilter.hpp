@@ -82,9 +82,35 @@ public:
 			_initialized = true;
 		}
 
+		// work on local copies of the coefficients and the filter state, otherwise the compiler has to assume that
+		// samples[] aliases the members and reloads/stores them for every sample
+		const float b0 = _b0;
+		const float b1 = _b1;
+		const float b2 = _b2;
+		const float a1 = _a1;
+		const float a2 = _a2;
+
+		T x1 = _delay_element_1;
+		T x2 = _delay_element_2;
+		T y1 = _delay_element_output_1;
+		T y2 = _delay_element_output_2;
+
 		for (int n = 0; n < num_samples; n++) {
-			samples[n] = applyInternal(samples[n]);
+			const T x = samples[n];
+			const T y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+
+			x2 = x1;
+			x1 = x;
+			y2 = y1;
+			y1 = y;
+
+			samples[n] = y;
 		}
+
+		_delay_element_1 = x1;
+		_delay_element_2 = x2;
+		_delay_element_output_1 = y1;
+		_delay_element_output_2 = y2;
 	}
 
 	float getNotchFreq() const { return _notch_freq; }
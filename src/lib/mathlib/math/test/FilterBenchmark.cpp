@@ -0,0 +1,170 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <mathlib/math/filter/AlphaFilter.hpp>
+#include <mathlib/math/filter/LowPassFilter2p.hpp>
+#include <mathlib/math/filter/MedianFilter.hpp>
+#include <mathlib/math/filter/NotchFilter.hpp>
+
+using matrix::Vector3f;
+
+static constexpr float kSampleFrequency = 8000.f; // gyro FIFO sample rate
+static constexpr int kFifoSamples = 32;
+
+static void fillFifo(float samples[kFifoSamples])
+{
+	for (int i = 0; i < kFifoSamples; i++) {
+		samples[i] = sinf(static_cast<float>(i) * 0.3f);
+	}
+}
+
+static void BM_LowPassFilter2pFloat(benchmark::State &state)
+{
+	math::LowPassFilter2p<float> lpf{kSampleFrequency, 30.f};
+	float sample = 1.f;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sample = lpf.apply(sample));
+	}
+}
+BENCHMARK(BM_LowPassFilter2pFloat);
+
+static void BM_LowPassFilter2pVector3f(benchmark::State &state)
+{
+	math::LowPassFilter2p<Vector3f> lpf{kSampleFrequency, 30.f};
+	Vector3f sample{1.f, 2.f, 3.f};
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sample = lpf.apply(sample));
+	}
+}
+BENCHMARK(BM_LowPassFilter2pVector3f);
+
+static void BM_LowPassFilter2pApplyArray(benchmark::State &state)
+{
+	math::LowPassFilter2p<float> lpf{kSampleFrequency, 30.f};
+	float samples[kFifoSamples];
+	fillFifo(samples);
+
+	for (auto _ : state) {
+		lpf.applyArray(samples, kFifoSamples);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * kFifoSamples);
+}
+BENCHMARK(BM_LowPassFilter2pApplyArray);
+
+static void BM_NotchFilterFloat(benchmark::State &state)
+{
+	math::NotchFilter<float> notch;
+	notch.setParameters(kSampleFrequency, 100.f, 20.f);
+	float sample = 1.f;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sample = notch.apply(sample));
+	}
+}
+BENCHMARK(BM_NotchFilterFloat);
+
+static void BM_NotchFilterApplyArray(benchmark::State &state)
+{
+	math::NotchFilter<float> notch;
+	notch.setParameters(kSampleFrequency, 100.f, 20.f);
+	float samples[kFifoSamples];
+	fillFifo(samples);
+
+	for (auto _ : state) {
+		notch.applyArray(samples, kFifoSamples);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * kFifoSamples);
+}
+BENCHMARK(BM_NotchFilterApplyArray);
+
+static void BM_NotchFilterBank(benchmark::State &state)
+{
+	// dynamic notch filtering of a 3 axis gyro FIFO sample, 4 motors with 3 harmonics each
+	static constexpr int kNotches = 4 * 3;
+	math::NotchFilter<float> notches[3][kNotches];
+
+	for (int axis = 0; axis < 3; axis++) {
+		for (int i = 0; i < kNotches; i++) {
+			notches[axis][i].setParameters(kSampleFrequency, 80.f * (i / 4 + 1) + 10.f * (i % 4), 20.f);
+		}
+	}
+
+	float samples[3][kFifoSamples];
+
+	for (int axis = 0; axis < 3; axis++) {
+		fillFifo(samples[axis]);
+	}
+
+	for (auto _ : state) {
+		for (int axis = 0; axis < 3; axis++) {
+			for (int i = 0; i < kNotches; i++) {
+				notches[axis][i].applyArray(samples[axis], kFifoSamples);
+			}
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * kFifoSamples);
+}
+BENCHMARK(BM_NotchFilterBank);
+
+static void BM_AlphaFilterVector3f(benchmark::State &state)
+{
+	AlphaFilter<Vector3f> filter{0.1f};
+	Vector3f sample{1.f, 2.f, 3.f};
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sample = filter.update(sample));
+	}
+}
+BENCHMARK(BM_AlphaFilterVector3f);
+
+static void BM_MedianFilter(benchmark::State &state)
+{
+	math::MedianFilter<float, 5> filter;
+	float sample = 1.f;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sample = filter.apply(sample + 1.f));
+	}
+}
+BENCHMARK(BM_MedianFilter);
@@ -347,3 +347,31 @@ TEST_F(NotchFilterTest, setCoefficients)
 		EXPECT_EQ(b[i], b_new[i]);
 	}
 }
+
+TEST_F(NotchFilterTest, applyArray)
+{
+	// filtering blocks of samples must give the same result as filtering sample by sample
+	NotchFilter<float> notch_array;
+	_notch_float.setParameters(_sample_freq, _notch_freq, _bandwidth);
+	notch_array.setParameters(_sample_freq, _notch_freq, _bandwidth);
+
+	const float omega = 2.f * M_PI_F * 30.f;
+	const float dt = 1.f / _sample_freq;
+	static constexpr int N = 8;
+
+	for (int block = 0; block < 50; block++) {
+		float samples[N];
+		float expected[N];
+
+		for (int n = 0; n < N; n++) {
+			samples[n] = sinf(omega * (block * N + n) * dt) + 0.1f * block;
+			expected[n] = _notch_float.apply(samples[n]);
+		}
+
+		notch_array.applyArray(samples, N);
+
+		for (int n = 0; n < N; n++) {
+			EXPECT_NEAR(samples[n], expected[n], _epsilon_near);
+		}
+	}
+}
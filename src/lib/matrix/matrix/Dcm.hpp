@@ -45,14 +45,14 @@ public:
 	 *
 	 * Initializes to identity
 	 */
-	Dcm() : SquareMatrix<Type, 3>(eye<Type, 3>()) {}
+	constexpr Dcm() : SquareMatrix<Type, 3>(eye<Type, 3>()) {}
 
 	/**
 	 * Constructor from array
 	 *
 	 * @param _data pointer to array
 	 */
-	explicit Dcm(const Type data_[3][3]) : SquareMatrix<Type, 3>(data_)
+	explicit constexpr Dcm(const Type data_[3][3]) : SquareMatrix<Type, 3>(data_)
 	{
 	}
 
@@ -61,7 +61,7 @@ public:
 	 *
 	 * @param _data pointer to array
 	 */
-	explicit Dcm(const Type data_[9]) : SquareMatrix<Type, 3>(data_)
+	explicit constexpr Dcm(const Type data_[9]) : SquareMatrix<Type, 3>(data_)
 	{
 	}
 
@@ -70,7 +70,7 @@ public:
 	 *
 	 * @param other Matrix33 to set dcm to
 	 */
-	Dcm(const Matrix<Type, 3, 3> &other) : SquareMatrix<Type, 3>(other)
+	constexpr Dcm(const Matrix<Type, 3, 3> &other) : SquareMatrix<Type, 3>(other)
 	{
 	}
 
@@ -82,7 +82,7 @@ public:
 	 *
 	 * @param q quaternion to set dcm to
 	 */
-	Dcm(const Quaternion<Type> &q)
+	constexpr Dcm(const Quaternion<Type> &q)
 	{
 		Dcm &dcm = *this;
 		const Type a = q(0);
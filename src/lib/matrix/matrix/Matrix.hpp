@@ -13,6 +13,7 @@
 #include <cstring>
 
 #include "helper_functions.hpp"
+#include "simd.hpp"
 #include "Slice.hpp"
 
 namespace matrix
@@ -28,7 +29,7 @@ public:
 	// Constructors
 	Matrix() = default;
 
-	explicit Matrix(const Type data_[M * N])
+	explicit constexpr Matrix(const Type data_[M * N])
 	{
 		for (size_t i = 0; i < M; i++) {
 			for (size_t j = 0; j < N; j++) {
@@ -37,7 +38,7 @@ public:
 		}
 	}
 
-	explicit Matrix(const Type data_[M][N])
+	explicit constexpr Matrix(const Type data_[M][N])
 	{
 		for (size_t i = 0; i < M; i++) {
 			for (size_t j = 0; j < N; j++) {
@@ -46,7 +47,7 @@ public:
 		}
 	}
 
-	Matrix(const Matrix &other)
+	constexpr Matrix(const Matrix &other)
 	{
 		for (size_t i = 0; i < M; i++) {
 			for (size_t j = 0; j < N; j++) {
@@ -56,7 +57,7 @@ public:
 	}
 
 	template<typename S>
-	Matrix(const Matrix<S, M, N> &aa)
+	constexpr Matrix(const Matrix<S, M, N> &aa)
 	{
 		for (size_t i = 0; i < M; i++) {
 			for (size_t j = 0; j < N; j++) {
@@ -94,7 +95,7 @@ public:
 	 */
 
 
-	inline const Type &operator()(size_t i, size_t j) const
+	inline constexpr const Type &operator()(size_t i, size_t j) const
 	{
 		assert(i < M);
 		assert(j < N);
@@ -102,7 +103,7 @@ public:
 		return _data[i][j];
 	}
 
-	inline Type &operator()(size_t i, size_t j)
+	inline constexpr Type &operator()(size_t i, size_t j)
 	{
 		assert(i < M);
 		assert(j < N);
@@ -110,7 +111,7 @@ public:
 		return _data[i][j];
 	}
 
-	Matrix<Type, M, N> &operator=(const Matrix<Type, M, N> &other)
+	constexpr Matrix<Type, M, N> &operator=(const Matrix<Type, M, N> &other)
 	{
 		if (this != &other) {
 			Matrix<Type, M, N> &self = *this;
@@ -156,11 +157,15 @@ public:
 	// required mult pair, but it provides
 	// compile time size_t checking
 	template<size_t P>
-	Matrix<Type, M, P> operator*(const Matrix<Type, N, P> &other) const
+	constexpr Matrix<Type, M, P> operator*(const Matrix<Type, N, P> &other) const
 	{
 		const Matrix<Type, M, N> &self = *this;
 		Matrix<Type, M, P> res{};
 
+		if (simd::active() && simd::Multiply<Type, M, N, P>::run(&self(0, 0), &other(0, 0), &res(0, 0))) {
+			return res;
+		}
+
 		for (size_t i = 0; i < M; i++) {
 			for (size_t k = 0; k < P; k++) {
 				for (size_t j = 0; j < N; j++) {
@@ -174,7 +179,7 @@ public:
 
 	// Using this function reduces the number of temporary variables needed to compute A * B.T
 	template<size_t P>
-	Matrix<Type, M, M> multiplyByTranspose(const Matrix<Type, P, N> &other) const
+	constexpr Matrix<Type, M, P> multiplyByTranspose(const Matrix<Type, P, N> &other) const
 	{
 		Matrix<Type, M, P> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -190,8 +195,26 @@ public:
 		return res;
 	}
 
+	// Using this function reduces the number of temporary variables needed to compute A.T * B
+	template<size_t P>
+	constexpr Matrix<Type, N, P> transposeMultiply(const Matrix<Type, M, P> &other) const
+	{
+		Matrix<Type, N, P> res;
+		const Matrix<Type, M, N> &self = *this;
+
+		for (size_t i = 0; i < N; i++) {
+			for (size_t k = 0; k < P; k++) {
+				for (size_t j = 0; j < M; j++) {
+					res(i, k) += self(j, i) * other(j, k);
+				}
+			}
+		}
+
+		return res;
+	}
+
 	// Element-wise multiplication
-	Matrix<Type, M, N> emult(const Matrix<Type, M, N> &other) const
+	constexpr Matrix<Type, M, N> emult(const Matrix<Type, M, N> &other) const
 	{
 		Matrix<Type, M, N> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -206,7 +229,7 @@ public:
 	}
 
 	// Element-wise division
-	Matrix<Type, M, N> edivide(const Matrix<Type, M, N> &other) const
+	constexpr Matrix<Type, M, N> edivide(const Matrix<Type, M, N> &other) const
 	{
 		Matrix<Type, M, N> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -220,7 +243,7 @@ public:
 		return res;
 	}
 
-	Matrix<Type, M, N> operator+(const Matrix<Type, M, N> &other) const
+	constexpr Matrix<Type, M, N> operator+(const Matrix<Type, M, N> &other) const
 	{
 		Matrix<Type, M, N> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -234,7 +257,7 @@ public:
 		return res;
 	}
 
-	Matrix<Type, M, N> operator-(const Matrix<Type, M, N> &other) const
+	constexpr Matrix<Type, M, N> operator-(const Matrix<Type, M, N> &other) const
 	{
 		Matrix<Type, M, N> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -249,7 +272,7 @@ public:
 	}
 
 	// unary minus
-	Matrix<Type, M, N> operator-() const
+	constexpr Matrix<Type, M, N> operator-() const
 	{
 		Matrix<Type, M, N> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -263,7 +286,7 @@ public:
 		return res;
 	}
 
-	void operator+=(const Matrix<Type, M, N> &other)
+	constexpr void operator+=(const Matrix<Type, M, N> &other)
 	{
 		Matrix<Type, M, N> &self = *this;
 
@@ -274,7 +297,7 @@ public:
 		}
 	}
 
-	void operator-=(const Matrix<Type, M, N> &other)
+	constexpr void operator-=(const Matrix<Type, M, N> &other)
 	{
 		Matrix<Type, M, N> &self = *this;
 
@@ -286,7 +309,7 @@ public:
 	}
 
 	template<size_t P>
-	void operator*=(const Matrix<Type, N, P> &other)
+	constexpr void operator*=(const Matrix<Type, N, P> &other)
 	{
 		Matrix<Type, M, N> &self = *this;
 		self = self * other;
@@ -296,7 +319,7 @@ public:
 	 * Scalar Operations
 	 */
 
-	Matrix<Type, M, N> operator*(Type scalar) const
+	constexpr Matrix<Type, M, N> operator*(Type scalar) const
 	{
 		Matrix<Type, M, N> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -310,12 +333,12 @@ public:
 		return res;
 	}
 
-	inline Matrix<Type, M, N> operator/(Type scalar) const
+	inline constexpr Matrix<Type, M, N> operator/(Type scalar) const
 	{
 		return (*this) * (1 / scalar);
 	}
 
-	Matrix<Type, M, N> operator+(Type scalar) const
+	constexpr Matrix<Type, M, N> operator+(Type scalar) const
 	{
 		Matrix<Type, M, N> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -329,12 +352,12 @@ public:
 		return res;
 	}
 
-	inline Matrix<Type, M, N> operator-(Type scalar) const
+	inline constexpr Matrix<Type, M, N> operator-(Type scalar) const
 	{
 		return (*this) + (-1 * scalar);
 	}
 
-	void operator*=(Type scalar)
+	constexpr void operator*=(Type scalar)
 	{
 		Matrix<Type, M, N> &self = *this;
 
@@ -345,13 +368,13 @@ public:
 		}
 	}
 
-	void operator/=(Type scalar)
+	constexpr void operator/=(Type scalar)
 	{
 		Matrix<Type, M, N> &self = *this;
 		self *= (Type(1) / scalar);
 	}
 
-	inline void operator+=(Type scalar)
+	inline constexpr void operator+=(Type scalar)
 	{
 		Matrix<Type, M, N> &self = *this;
 
@@ -362,7 +385,7 @@ public:
 		}
 	}
 
-	inline void operator-=(Type scalar)
+	inline constexpr void operator-=(Type scalar)
 	{
 		Matrix<Type, M, N> &self = *this;
 		self += (-scalar);
@@ -448,7 +471,7 @@ public:
 		}
 	}
 
-	Matrix<Type, N, M> transpose() const
+	constexpr Matrix<Type, N, M> transpose() const
 	{
 		Matrix<Type, N, M> res;
 		const Matrix<Type, M, N> &self = *this;
@@ -463,7 +486,7 @@ public:
 	}
 
 	// tranpose alias
-	inline Matrix<Type, N, M> T() const
+	inline constexpr Matrix<Type, N, M> T() const
 	{
 		return transpose();
 	}
@@ -520,17 +543,17 @@ public:
 		slice<M, 1>(0, j) = val;
 	}
 
-	void setZero()
+	constexpr void setZero()
 	{
-		memset(_data, 0, sizeof(_data));
+		setAll(Type(0));
 	}
 
-	inline void zero()
+	inline constexpr void zero()
 	{
 		setZero();
 	}
 
-	void setAll(Type val)
+	constexpr void setAll(Type val)
 	{
 		Matrix<Type, M, N> &self = *this;
 
@@ -541,7 +564,7 @@ public:
 		}
 	}
 
-	inline void setOne()
+	inline constexpr void setOne()
 	{
 		setAll(1);
 	}
@@ -551,7 +574,7 @@ public:
 		setAll(NAN);
 	}
 
-	void setIdentity()
+	constexpr void setIdentity()
 	{
 		setZero();
 		Matrix<Type, M, N> &self = *this;
@@ -563,12 +586,12 @@ public:
 		}
 	}
 
-	inline void identity()
+	inline constexpr void identity()
 	{
 		setIdentity();
 	}
 
-	inline void swapRows(size_t a, size_t b)
+	inline constexpr void swapRows(size_t a, size_t b)
 	{
 		assert(a < M);
 		assert(b < M);
@@ -586,7 +609,7 @@ public:
 		}
 	}
 
-	inline void swapCols(size_t a, size_t b)
+	inline constexpr void swapCols(size_t a, size_t b)
 	{
 		assert(a < N);
 		assert(b < N);
@@ -617,7 +640,7 @@ public:
 		return r;
 	}
 
-	Type max() const
+	constexpr Type max() const
 	{
 		Type max_val = (*this)(0, 0);
 
@@ -634,7 +657,7 @@ public:
 		return max_val;
 	}
 
-	Type min() const
+	constexpr Type min() const
 	{
 		Type min_val = (*this)(0, 0);
 
@@ -682,7 +705,7 @@ public:
 };
 
 template<typename Type, size_t M, size_t N>
-Matrix<Type, M, N> zeros()
+constexpr Matrix<Type, M, N> zeros()
 {
 	Matrix<Type, M, N> m;
 	m.setZero();
@@ -690,7 +713,7 @@ Matrix<Type, M, N> zeros()
 }
 
 template<typename Type, size_t M, size_t N>
-Matrix<Type, M, N> ones()
+constexpr Matrix<Type, M, N> ones()
 {
 	Matrix<Type, M, N> m;
 	m.setOne();
@@ -706,7 +729,7 @@ Matrix<float, M, N> nans()
 }
 
 template<typename Type, size_t  M, size_t N>
-Matrix<Type, M, N> operator*(Type scalar, const Matrix<Type, M, N> &other)
+constexpr Matrix<Type, M, N> operator*(Type scalar, const Matrix<Type, M, N> &other)
 {
 	return other * scalar;
 }
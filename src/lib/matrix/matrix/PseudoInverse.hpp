@@ -15,6 +15,30 @@
 namespace matrix
 {
 
+/**
+ * Geninv for M <= N with a given G * G^T (e.g. updated incrementally by the caller)
+ */
+template<typename Type, size_t M, size_t N>
+bool geninvGramian(const Matrix<Type, M, N> &G, const SquareMatrix<Type, M> &gramian, Matrix<Type, N, M> &res)
+{
+	size_t rank;
+	SquareMatrix<Type, M> L = fullRankCholesky(gramian, rank);
+
+	SquareMatrix<Type, M> A = L.transposeMultiply(L);
+	SquareMatrix<Type, M> X;
+
+	if (!inv(A, X, rank)) {
+		res = Matrix<Type, N, M>();
+		return false; // LCOV_EXCL_LINE -- this can only be hit from numerical issues
+	}
+
+	// doing an intermediate assignment reduces stack usage
+	A = (X * X).multiplyByTranspose(L);
+	res = G.transposeMultiply(L * A);
+
+	return true;
+}
+
 /**
  * Geninv
  * Fast pseudoinverse based on full rank cholesky factorisation
@@ -27,26 +51,13 @@ bool geninv(const Matrix<Type, M, N> &G, Matrix<Type, N, M> &res)
 	size_t rank;
 
 	if (M <= N) {
-		SquareMatrix<Type, M> A = G * G.transpose();
-		SquareMatrix<Type, M> L = fullRankCholesky(A, rank);
-
-		A = L.transpose() * L;
-		SquareMatrix<Type, M> X;
-
-		if (!inv(A, X, rank)) {
-			res = Matrix<Type, N, M>();
-			return false; // LCOV_EXCL_LINE -- this can only be hit from numerical issues
-		}
-
-		// doing an intermediate assignment reduces stack usage
-		A = X * X * L.transpose();
-		res = G.transpose() * (L * A);
+		return geninvGramian(G, SquareMatrix<Type, M>(G.multiplyByTranspose(G)), res);
 
 	} else {
-		SquareMatrix<Type, N> A = G.transpose() * G;
+		SquareMatrix<Type, N> A = G.transposeMultiply(G);
 		SquareMatrix<Type, N> L = fullRankCholesky(A, rank);
 
-		A = L.transpose() * L;
+		A = L.transposeMultiply(L);
 		SquareMatrix<Type, N> X;
 
 		if (!inv(A, X, rank)) {
@@ -55,8 +66,8 @@ bool geninv(const Matrix<Type, M, N> &G, Matrix<Type, N, M> &res)
 		}
 
 		// doing an intermediate assignment reduces stack usage
-		A = X * X * L.transpose();
-		res = (L * A) * G.transpose();
+		A = (X * X).multiplyByTranspose(L);
+		res = (L * A).multiplyByTranspose(G);
 	}
 
 	return true;
@@ -60,7 +60,7 @@ public:
 	 *
 	 * @param data_ array
 	 */
-	explicit Quaternion(const Type data_[4]) :
+	explicit constexpr Quaternion(const Type data_[4]) :
 		Vector4<Type>(data_)
 	{
 	}
@@ -68,7 +68,7 @@ public:
 	/**
 	 * Standard constructor
 	 */
-	Quaternion()
+	constexpr Quaternion()
 	{
 		Quaternion &q = *this;
 		q(0) = 1;
@@ -82,7 +82,7 @@ public:
 	 *
 	 * @param other Matrix41 to copy
 	 */
-	Quaternion(const Matrix41 &other) :
+	constexpr Quaternion(const Matrix41 &other) :
 		Vector4<Type>(other)
 	{
 	}
@@ -249,7 +249,7 @@ public:
 	 * @param c set quaternion value 2
 	 * @param d set quaternion value 3
 	 */
-	Quaternion(Type a, Type b, Type c, Type d)
+	constexpr Quaternion(Type a, Type b, Type c, Type d)
 	{
 		Quaternion &q = *this;
 		q(0) = a;
@@ -264,9 +264,15 @@ public:
 	 * @param q quaternion to multiply with
 	 * @return product
 	 */
-	Quaternion operator*(const Quaternion &p) const
+	constexpr Quaternion operator*(const Quaternion &p) const
 	{
 		const Quaternion &q = *this;
+		Quaternion res;
+
+		if (simd::active() && simd::quaternion_multiply(&q(0), &p(0), &res(0))) {
+			return res;
+		}
+
 		return {
 			q(0) *p(0) - q(1) *p(1) - q(2) *p(2) - q(3) *p(3),
 			q(1) *p(0) + q(0) *p(1) - q(3) *p(2) + q(2) *p(3),
@@ -279,7 +285,7 @@ public:
 	 *
 	 * @param other quaternion to multiply with
 	 */
-	void operator*=(const Quaternion &other)
+	constexpr void operator*=(const Quaternion &other)
 	{
 		Quaternion &self = *this;
 		self = self * other;
@@ -291,7 +297,7 @@ public:
 	 * @param scalar scalar to multiply with
 	 * @return product
 	 */
-	Quaternion operator*(Type scalar) const
+	constexpr Quaternion operator*(Type scalar) const
 	{
 		const Quaternion &q = *this;
 		return scalar * q;
@@ -302,7 +308,7 @@ public:
 	 *
 	 * @param scalar scalar to multiply with
 	 */
-	void operator*=(Type scalar)
+	constexpr void operator*=(Type scalar)
 	{
 		Quaternion &q = *this;
 		q = q * scalar;
@@ -21,17 +21,17 @@ class SquareMatrix : public Matrix<Type, M, M>
 public:
 	SquareMatrix() = default;
 
-	explicit SquareMatrix(const Type data_[M][M]) :
+	explicit constexpr SquareMatrix(const Type data_[M][M]) :
 		Matrix<Type, M, M>(data_)
 	{
 	}
 
-	explicit SquareMatrix(const Type data_[M * M]) :
+	explicit constexpr SquareMatrix(const Type data_[M * M]) :
 		Matrix<Type, M, M>(data_)
 	{
 	}
 
-	SquareMatrix(const Matrix<Type, M, M> &other) :
+	constexpr SquareMatrix(const Matrix<Type, M, M> &other) :
 		Matrix<Type, M, M>(other)
 	{
 	}
@@ -85,7 +85,7 @@ public:
 	}
 
 
-	Vector<Type, M> diag() const
+	constexpr Vector<Type, M> diag() const
 	{
 		Vector<Type, M> res;
 		const SquareMatrix<Type, M> &self = *this;
@@ -116,7 +116,7 @@ public:
 	}
 
 	template <size_t Width>
-	Type trace(size_t first) const
+	constexpr Type trace(size_t first) const
 	{
 		static_assert(Width <= M, "Width bigger than matrix");
 		assert(first + Width <= M);
@@ -131,7 +131,7 @@ public:
 		return res;
 	}
 
-	Type trace() const
+	constexpr Type trace() const
 	{
 		const SquareMatrix<Type, M> &self = *this;
 		return self.trace<M>(0);
@@ -322,7 +322,7 @@ using SquareMatrix3f = SquareMatrix<float, 3>;
 using SquareMatrix3d = SquareMatrix<double, 3>;
 
 template<typename Type, size_t M>
-SquareMatrix<Type, M> eye()
+constexpr SquareMatrix<Type, M> eye()
 {
 	SquareMatrix<Type, M> m;
 	m.setIdentity();
@@ -330,7 +330,7 @@ SquareMatrix<Type, M> eye()
 }
 
 template<typename Type, size_t M>
-SquareMatrix<Type, M> diag(Vector<Type, M> d)
+constexpr SquareMatrix<Type, M> diag(Vector<Type, M> d)
 {
 	SquareMatrix<Type, M> m;
 
@@ -341,6 +341,44 @@ SquareMatrix<Type, M> diag(Vector<Type, M> d)
 	return m;
 }
 
+/**
+ * A * P * A.T (e.g. covariance propagation) without temporaries for A * P, A.T and the
+ * intermediate product: each row of A * P is computed once and directly multiplied by A.T.
+ * Same operations in the same order as the explicit expression with the generic (scalar) product.
+ */
+template<typename Type, size_t M, size_t N>
+constexpr SquareMatrix<Type, M> conjugate(const Matrix<Type, M, N> &A, const Matrix<Type, N, N> &P)
+{
+	SquareMatrix<Type, M> res;
+
+	for (size_t i = 0; i < M; i++) {
+		// row i of A * P
+		Type row[N] {};
+
+		for (size_t k = 0; k < N; k++) {
+			Type sum{};
+
+			for (size_t j = 0; j < N; j++) {
+				sum += A(i, j) * P(j, k);
+			}
+
+			row[k] = sum;
+		}
+
+		for (size_t l = 0; l < M; l++) {
+			Type sum{};
+
+			for (size_t k = 0; k < N; k++) {
+				sum += row[k] * A(l, k);
+			}
+
+			res(i, l) = sum;
+		}
+	}
+
+	return res;
+}
+
 template<typename Type, size_t M>
 SquareMatrix<Type, M> expm(const Matrix<Type, M, M> &A, size_t order = 5)
 {
@@ -607,16 +645,120 @@ SquareMatrix <Type, M> cholesky(const SquareMatrix<Type, M> &A)
 }
 
 /**
- * cholesky inverse
+ * inverse of a lower triangular matrix by forward substitution
  *
- * TODO: Check if gaussian elimination jumps straight to back-substitution
- * for L or we need to do it manually. Will impact speed otherwise.
+ * @return false if a diagonal element is zero
+ */
+template<typename Type, size_t M>
+bool invLowerTriangular(const SquareMatrix<Type, M> &L, SquareMatrix<Type, M> &L_inv)
+{
+	L_inv.setZero();
+
+	for (size_t j = 0; j < M; j++) {
+		if (!(std::fabs(L(j, j)) > Type(0))) {
+			return false;
+		}
+
+		L_inv(j, j) = Type(1) / L(j, j);
+
+		for (size_t i = j + 1; i < M; i++) {
+			Type sum = 0;
+
+			for (size_t k = j; k < i; k++) {
+				sum += L(i, k) * L_inv(k, j);
+			}
+
+			L_inv(i, j) = -sum / L(i, i);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * cholesky inverse
  */
 template<typename Type, size_t M>
 SquareMatrix <Type, M> choleskyInv(const SquareMatrix<Type, M> &A)
 {
-	SquareMatrix<Type, M> L_inv = inv(cholesky(A));
-	return L_inv.T() * L_inv;
+	SquareMatrix<Type, M> L_inv;
+
+	if (!invLowerTriangular(cholesky(A), L_inv)) {
+		return SquareMatrix<Type, M>();
+	}
+
+	return L_inv.transposeMultiply(L_inv);
+}
+
+/**
+ * Solve A * X = B for symmetric positive definite A using an LDL^T factorization
+ * (no square roots and no explicit inverse). Only the lower triangle of A is used.
+ *
+ * Much cheaper than inv(A) * B for the small normal equations of least squares fits.
+ *
+ * @return false if A is not (numerically) positive definite, X is not modified then
+ */
+template<typename Type, size_t M, size_t P>
+bool ldltSolve(const SquareMatrix<Type, M> &A, const Matrix<Type, M, P> &B, Matrix<Type, M, P> &X)
+{
+	// unit lower triangular L below the diagonal, D on the diagonal
+	SquareMatrix<Type, M> LD;
+
+	for (size_t j = 0; j < M; j++) {
+		Type d = A(j, j);
+
+		for (size_t k = 0; k < j; k++) {
+			d -= LD(j, k) * LD(j, k) * LD(k, k);
+		}
+
+		if (!(d > Type(0))) {
+			return false;
+		}
+
+		LD(j, j) = d;
+
+		for (size_t i = j + 1; i < M; i++) {
+			Type sum = A(i, j);
+
+			for (size_t k = 0; k < j; k++) {
+				sum -= LD(i, k) * LD(j, k) * LD(k, k);
+			}
+
+			LD(i, j) = sum / d;
+		}
+	}
+
+	for (size_t p = 0; p < P; p++) {
+		Type y[M] {};
+
+		// L * z = b
+		for (size_t i = 0; i < M; i++) {
+			Type sum = B(i, p);
+
+			for (size_t k = 0; k < i; k++) {
+				sum -= LD(i, k) * y[k];
+			}
+
+			y[i] = sum;
+		}
+
+		// D * L^T * x = z
+		for (size_t i = M; i-- > 0;) {
+			Type sum = y[i] / LD(i, i);
+
+			for (size_t k = i + 1; k < M; k++) {
+				sum -= LD(k, i) * y[k];
+			}
+
+			y[i] = sum;
+		}
+
+		for (size_t i = 0; i < M; i++) {
+			X(i, p) = y[i];
+		}
+	}
+
+	return true;
 }
 
 using Matrix2f = SquareMatrix<float, 2>;
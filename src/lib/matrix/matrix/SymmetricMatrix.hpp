@@ -0,0 +1,305 @@
+/**
+ * @file SymmetricMatrix.hpp
+ *
+ * Symmetric matrix with packed storage.
+ *
+ * Only the upper triangle is stored, column by column (which is the same
+ * as storing the lower triangle row by row), so M * (M + 1) / 2 elements
+ * instead of M * M. Element (i, j) and (j, i) are the same storage.
+ *
+ */
+
+#pragma once
+
+#include "SquareMatrix.hpp"
+
+namespace matrix
+{
+
+template<typename Type, size_t M>
+class SymmetricMatrix;
+
+// view on a block of a symmetric matrix, for reading and block assignment
+template<typename MatrixT, typename Type, size_t P, size_t Q, size_t M>
+class SymmetricSliceT
+{
+public:
+	SymmetricSliceT(size_t x0, size_t y0, MatrixT *data) :
+		_x0(x0),
+		_y0(y0),
+		_data(data)
+	{
+		static_assert(P <= M, "Slice rows bigger than backing matrix");
+		static_assert(Q <= M, "Slice cols bigger than backing matrix");
+		assert(x0 + P <= M);
+		assert(y0 + Q <= M);
+	}
+
+	Type operator()(size_t i, size_t j) const
+	{
+		assert(i < P);
+		assert(j < Q);
+
+		return (*_data)(_x0 + i, _y0 + j);
+	}
+
+	// elements that are mirrored inside the block are taken from the upper triangle of the backing matrix
+	SymmetricSliceT &operator=(const Matrix<Type, P, Q> &other)
+	{
+		for (size_t i = 0; i < P; i++) {
+			for (size_t j = 0; j < Q; j++) {
+				const size_t row = _x0 + i;
+				const size_t col = _y0 + j;
+
+				const bool mirrored = (row > col) && (col >= _x0) && (col < _x0 + P) && (row >= _y0) && (row < _y0 + Q);
+
+				if (!mirrored) {
+					(*_data)(row, col) = other(i, j);
+				}
+			}
+		}
+
+		return *this;
+	}
+
+	SymmetricSliceT &operator=(const Type &other)
+	{
+		for (size_t i = 0; i < P; i++) {
+			for (size_t j = 0; j < Q; j++) {
+				(*_data)(_x0 + i, _y0 + j) = other;
+			}
+		}
+
+		return *this;
+	}
+
+	operator Matrix<Type, P, Q>() const
+	{
+		Matrix<Type, P, Q> res;
+
+		for (size_t i = 0; i < P; i++) {
+			for (size_t j = 0; j < Q; j++) {
+				res(i, j) = (*this)(i, j);
+			}
+		}
+
+		return res;
+	}
+
+	Vector < Type, P < Q ? P : Q > diag() const
+	{
+		Vector < Type, P < Q ? P : Q > res;
+
+		for (size_t j = 0; j < (P < Q ? P : Q); j++) {
+			res(j) = (*this)(j, j);
+		}
+
+		return res;
+	}
+
+private:
+	size_t _x0, _y0;
+	MatrixT *_data;
+};
+
+template<typename Type, size_t M>
+class SymmetricMatrix
+{
+	static constexpr size_t SIZE = M * (M + 1) / 2;
+
+	Type _data[SIZE] {};
+
+	static constexpr size_t index(size_t i, size_t j)
+	{
+		// row i of the lower triangle starts after the i * (i + 1) / 2 elements of the rows above
+		return (i >= j) ? (i * (i + 1) / 2 + j) : (j * (j + 1) / 2 + i);
+	}
+
+public:
+	SymmetricMatrix() = default;
+
+	// the upper triangle of other is used
+	explicit SymmetricMatrix(const Matrix<Type, M, M> &other)
+	{
+		*this = other;
+	}
+
+	SymmetricMatrix<Type, M> &operator=(const Matrix<Type, M, M> &other)
+	{
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j <= i; j++) {
+				_data[index(i, j)] = other(j, i);
+			}
+		}
+
+		return *this;
+	}
+
+	inline Type operator()(size_t i, size_t j) const
+	{
+		assert(i < M);
+		assert(j < M);
+
+		return _data[index(i, j)];
+	}
+
+	inline Type &operator()(size_t i, size_t j)
+	{
+		assert(i < M);
+		assert(j < M);
+
+		return _data[index(i, j)];
+	}
+
+	template<size_t P, size_t Q>
+	SymmetricSliceT<const SymmetricMatrix<Type, M>, Type, P, Q, M> slice(size_t x0, size_t y0) const
+	{
+		return {x0, y0, this};
+	}
+
+	template<size_t P, size_t Q>
+	SymmetricSliceT<SymmetricMatrix<Type, M>, Type, P, Q, M> slice(size_t x0, size_t y0)
+	{
+		return {x0, y0, this};
+	}
+
+	Vector<Type, M> row(size_t i) const
+	{
+		Vector<Type, M> res;
+
+		for (size_t j = 0; j < M; j++) {
+			res(j) = (*this)(i, j);
+		}
+
+		return res;
+	}
+
+	Vector<Type, M> col(size_t j) const
+	{
+		return row(j);
+	}
+
+	SquareMatrix<Type, M> full() const
+	{
+		SquareMatrix<Type, M> res;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j < M; j++) {
+				res(i, j) = (*this)(i, j);
+			}
+		}
+
+		return res;
+	}
+
+	Vector<Type, M> operator*(const Vector<Type, M> &other) const
+	{
+		Vector<Type, M> res;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j <= i; j++) {
+				const Type p = _data[index(i, j)];
+				res(i) += p * other(j);
+
+				if (j != i) {
+					res(j) += p * other(i);
+				}
+			}
+		}
+
+		return res;
+	}
+
+	void setZero()
+	{
+		memset(_data, 0, sizeof(_data));
+	}
+
+	inline void zero()
+	{
+		setZero();
+	}
+
+	Vector<Type, M> diag() const
+	{
+		Vector<Type, M> res;
+
+		for (size_t i = 0; i < M; i++) {
+			res(i) = (*this)(i, i);
+		}
+
+		return res;
+	}
+
+	template <size_t Width>
+	Type trace(size_t first) const
+	{
+		static_assert(Width <= M, "Width bigger than matrix");
+		assert(first + Width <= M);
+
+		Type res = 0;
+
+		for (size_t i = first; i < (first + Width); i++) {
+			res += (*this)(i, i);
+		}
+
+		return res;
+	}
+
+	Type trace() const
+	{
+		return trace<M>(0);
+	}
+
+	template <size_t Width>
+	void uncorrelateCovarianceSetVariance(size_t first, const Vector<Type, Width> &vec)
+	{
+		static_assert(Width <= M, "Width bigger than matrix");
+		assert(first + Width <= M);
+
+		// zero rows (and therefore columns)
+		for (size_t i = first; i < first + Width; i++) {
+			for (size_t j = 0; j < M; j++) {
+				(*this)(i, j) = Type(0);
+			}
+
+			(*this)(i, i) = vec(i - first);
+		}
+	}
+
+	template <size_t Width>
+	void uncorrelateCovarianceSetVariance(size_t first, Type val)
+	{
+		static_assert(Width <= M, "Width bigger than matrix");
+		assert(first + Width <= M);
+
+		for (size_t i = first; i < first + Width; i++) {
+			for (size_t j = 0; j < M; j++) {
+				(*this)(i, j) = Type(0);
+			}
+
+			(*this)(i, i) = val;
+		}
+	}
+
+	template <size_t Width>
+	void uncorrelateCovariance(size_t first)
+	{
+		static_assert(Width <= M, "Width bigger than matrix");
+		assert(first + Width <= M);
+
+		const Vector<Type, Width> diag_elements = slice<Width, Width>(first, first).diag();
+		uncorrelateCovarianceSetVariance<Width>(first, diag_elements);
+	}
+
+	// the storage is symmetric by construction
+	void copyLowerToUpperTriangle() {}
+	void copyUpperToLowerTriangle() {}
+
+	void print(float eps = 1e-9) const
+	{
+		full().print(eps);
+	}
+};
+
+} // namespace matrix
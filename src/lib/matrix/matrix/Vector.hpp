@@ -21,12 +21,12 @@ public:
 
 	Vector() = default;
 
-	Vector(const MatrixM1 &other) :
+	constexpr Vector(const MatrixM1 &other) :
 		MatrixM1(other)
 	{
 	}
 
-	explicit Vector(const Type data_[M]) :
+	explicit constexpr Vector(const Type data_[M]) :
 		MatrixM1(data_)
 	{
 	}
@@ -63,7 +63,7 @@ public:
 		}
 	}
 
-	inline const Type &operator()(size_t i) const
+	inline constexpr const Type &operator()(size_t i) const
 	{
 		assert(i < M);
 
@@ -71,7 +71,7 @@ public:
 		return v(i, 0);
 	}
 
-	inline Type &operator()(size_t i)
+	inline constexpr Type &operator()(size_t i)
 	{
 		assert(i < M);
 
@@ -79,11 +79,15 @@ public:
 		return v(i, 0);
 	}
 
-	Type dot(const MatrixM1 &b) const
+	constexpr Type dot(const MatrixM1 &b) const
 	{
 		const Vector &a(*this);
 		Type r(0);
 
+		if (simd::active() && simd::Dot<Type, M>::run(&a(0), &b(0, 0), &r)) {
+			return r;
+		}
+
 		for (size_t i = 0; i < M; i++) {
 			r += a(i) * b(i, 0);
 		}
@@ -91,13 +95,13 @@ public:
 		return r;
 	}
 
-	inline Type operator*(const MatrixM1 &b) const
+	inline constexpr Type operator*(const MatrixM1 &b) const
 	{
 		const Vector &a(*this);
 		return a.dot(b);
 	}
 
-	inline Vector operator*(Type b) const
+	inline constexpr Vector operator*(Type b) const
 	{
 		return Vector(MatrixM1::operator*(b));
 	}
@@ -108,7 +112,7 @@ public:
 		return Type(std::sqrt(a.dot(a)));
 	}
 
-	Type norm_squared() const
+	constexpr Type norm_squared() const
 	{
 		const Vector &a(*this);
 		return a.dot(a);
@@ -25,17 +25,17 @@ public:
 
 	Vector3() = default;
 
-	Vector3(const Matrix31 &other) :
+	constexpr Vector3(const Matrix31 &other) :
 		Vector<Type, 3>(other)
 	{
 	}
 
-	explicit Vector3(const Type data_[3]) :
+	explicit constexpr Vector3(const Type data_[3]) :
 		Vector<Type, 3>(data_)
 	{
 	}
 
-	Vector3(Type x, Type y, Type z)
+	constexpr Vector3(Type x, Type y, Type z)
 	{
 		Vector3 &v(*this);
 		v(0) = x;
@@ -46,9 +46,15 @@ public:
 	using base = Vector<Type, 3>;
 	using base::base;
 
-	Vector3 cross(const Matrix31 &b) const
+	constexpr Vector3 cross(const Matrix31 &b) const
 	{
 		const Vector3 &a(*this);
+		Vector3 res;
+
+		if (simd::active() && simd::cross(&a(0), &b(0, 0), &res(0))) {
+			return res;
+		}
+
 		return {a(1) *b(2, 0) - a(2) *b(1, 0), -a(0) *b(2, 0) + a(2) *b(0, 0), a(0) *b(1, 0) - a(1) *b(0, 0)};
 	}
 
@@ -56,42 +62,42 @@ public:
 	 * Override matrix ops so Vector3 type is returned
 	 */
 
-	inline Vector3 operator+(Vector3 other) const
+	inline constexpr Vector3 operator+(Vector3 other) const
 	{
 		return Matrix31::operator+(other);
 	}
 
-	inline Vector3 operator+(Type scalar) const
+	inline constexpr Vector3 operator+(Type scalar) const
 	{
 		return Matrix31::operator+(scalar);
 	}
 
-	inline Vector3 operator-(Vector3 other) const
+	inline constexpr Vector3 operator-(Vector3 other) const
 	{
 		return Matrix31::operator-(other);
 	}
 
-	inline Vector3 operator-(Type scalar) const
+	inline constexpr Vector3 operator-(Type scalar) const
 	{
 		return Matrix31::operator-(scalar);
 	}
 
-	inline Vector3 operator-() const
+	inline constexpr Vector3 operator-() const
 	{
 		return Matrix31::operator-();
 	}
 
-	inline Vector3 operator*(Type scalar) const
+	inline constexpr Vector3 operator*(Type scalar) const
 	{
 		return Matrix31::operator*(scalar);
 	}
 
-	inline Type operator*(Vector3 b) const
+	inline constexpr Type operator*(Vector3 b) const
 	{
 		return Vector<Type, 3>::operator*(b);
 	}
 
-	inline Vector3 operator%(const Matrix31 &b) const
+	inline constexpr Vector3 operator%(const Matrix31 &b) const
 	{
 		return (*this).cross(b);
 	}
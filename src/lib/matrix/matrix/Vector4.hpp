@@ -54,17 +54,17 @@ public:
 
 	Vector4() = default;
 
-	Vector4(const Matrix41 &other) :
+	constexpr Vector4(const Matrix41 &other) :
 		Vector<Type, 4>(other)
 	{
 	}
 
-	explicit Vector4(const Type data_[3]) :
+	explicit constexpr Vector4(const Type data_[3]) :
 		Vector<Type, 4>(data_)
 	{
 	}
 
-	Vector4(Type x1, Type x2, Type x3, Type x4)
+	constexpr Vector4(Type x1, Type x2, Type x3, Type x4)
 	{
 		Vector4 &v(*this);
 		v(0) = x1;
@@ -87,37 +87,37 @@ public:
 	 * Override matrix ops so Vector4 type is returned
 	 */
 
-	Vector4 operator+(Vector4 other) const
+	constexpr Vector4 operator+(Vector4 other) const
 	{
 		return Matrix41::operator+(other);
 	}
 
-	Vector4 operator+(Type scalar) const
+	constexpr Vector4 operator+(Type scalar) const
 	{
 		return Matrix41::operator+(scalar);
 	}
 
-	Vector4 operator-(Vector4 other) const
+	constexpr Vector4 operator-(Vector4 other) const
 	{
 		return Matrix41::operator-(other);
 	}
 
-	Vector4 operator-(Type scalar) const
+	constexpr Vector4 operator-(Type scalar) const
 	{
 		return Matrix41::operator-(scalar);
 	}
 
-	Vector4 operator-() const
+	constexpr Vector4 operator-() const
 	{
 		return Matrix41::operator-();
 	}
 
-	Vector4 operator*(Type scalar) const
+	constexpr Vector4 operator*(Type scalar) const
 	{
 		return Matrix41::operator*(scalar);
 	}
 
-	Type operator*(Vector4 b) const
+	constexpr Type operator*(Vector4 b) const
 	{
 		return Vector<Type, 4>::operator*(b);
 	}
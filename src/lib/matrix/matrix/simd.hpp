@@ -0,0 +1,267 @@
+/**
+ * @file simd.hpp
+ *
+ * Optional vectorized float kernels for the most used fixed size operations
+ * (quaternion product, cross product, 3x3 matrix products, 3/4 element dot products).
+ *
+ * Enabled by defining MATRIX_SIMD (CONFIG_LIB_MATRIX_SIMD), the backend is selected at compile time:
+ * Arm Helium (MVE with floating point), AArch64 NEON or SSE2. Without a backend all kernels return false
+ * and the callers use the generic scalar code.
+ *
+ * With MATRIX_SIMD_BITEXACT the kernels use the same operations in the same order as the scalar code
+ * (no fused multiply-add, no reassociated sums), so the results are bit-identical to the scalar code
+ * compiled with -ffp-contract=off. Otherwise fused multiply-add and tree reductions are used where
+ * available.
+ *
+ * The define must be the same for all translation units, the build system sets it globally.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#if defined(MATRIX_SIMD)
+# if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#  include <arm_mve.h>
+#  define MATRIX_SIMD_HELIUM
+# elif defined(__ARM_NEON) && defined(__aarch64__)
+// (32 bit NEON always flushes denormals, so it does not match the scalar code)
+#  include <arm_neon.h>
+#  define MATRIX_SIMD_NEON
+# elif defined(__SSE2__)
+#  include <immintrin.h>
+#  define MATRIX_SIMD_SSE
+# endif
+#endif
+
+namespace matrix
+{
+
+namespace simd
+{
+
+/*
+ * Generic versions: no vectorized implementation, the caller uses the scalar code.
+ */
+
+template<typename Type>
+inline constexpr bool quaternion_multiply(const Type *, const Type *, Type *) { return false; }
+
+template<typename Type>
+inline constexpr bool cross(const Type *, const Type *, Type *) { return false; }
+
+template<typename Type, size_t M, size_t N, size_t P>
+struct Multiply {
+	static constexpr bool run(const Type *, const Type *, Type *) { return false; }
+};
+
+template<typename Type, size_t M>
+struct Dot {
+	static constexpr bool run(const Type *, const Type *, Type *) { return false; }
+};
+
+#if defined(MATRIX_SIMD_HELIUM) || defined(MATRIX_SIMD_NEON) || defined(MATRIX_SIMD_SSE)
+
+static constexpr bool available = true;
+
+namespace detail
+{
+
+#if defined(MATRIX_SIMD_HELIUM) || defined(MATRIX_SIMD_NEON)
+
+using float4 = float32x4_t;
+
+inline float4 load4(const float *p) { return vld1q_f32(p); }
+inline float4 set4(float a, float b, float c, float d) { return float4{a, b, c, d}; }
+inline float4 dup4(float a) { return vdupq_n_f32(a); }
+inline void store4(float *p, float4 a) { vst1q_f32(p, a); }
+inline float4 add(float4 a, float4 b) { return vaddq_f32(a, b); }
+inline float4 sub(float4 a, float4 b) { return vsubq_f32(a, b); }
+inline float4 mul(float4 a, float4 b) { return vmulq_f32(a, b); }
+
+# if defined(MATRIX_SIMD_BITEXACT)
+inline float4 madd(float4 acc, float4 a, float4 b) { return vaddq_f32(acc, vmulq_f32(a, b)); }
+# else
+inline float4 madd(float4 acc, float4 a, float4 b) { return vfmaq_f32(acc, a, b); }
+# endif
+
+# if defined(MATRIX_SIMD_NEON)
+inline float hsum(float4 a) { return vaddvq_f32(a); }
+# else
+inline float hsum(float4 a)
+{
+	return (vgetq_lane_f32(a, 0) + vgetq_lane_f32(a, 1)) + (vgetq_lane_f32(a, 2) + vgetq_lane_f32(a, 3));
+}
+# endif
+
+#else // MATRIX_SIMD_SSE
+
+using float4 = __m128;
+
+inline float4 load4(const float *p) { return _mm_loadu_ps(p); }
+inline float4 set4(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+inline float4 dup4(float a) { return _mm_set1_ps(a); }
+inline void store4(float *p, float4 a) { _mm_storeu_ps(p, a); }
+inline float4 add(float4 a, float4 b) { return _mm_add_ps(a, b); }
+inline float4 sub(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+inline float4 mul(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+
+# if defined(__FMA__) && !defined(MATRIX_SIMD_BITEXACT)
+inline float4 madd(float4 acc, float4 a, float4 b) { return _mm_fmadd_ps(a, b, acc); }
+# else
+inline float4 madd(float4 acc, float4 a, float4 b) { return _mm_add_ps(acc, _mm_mul_ps(a, b)); }
+# endif
+
+inline float hsum(float4 a)
+{
+	const float4 pairs = _mm_add_ps(a, _mm_movehl_ps(a, a)); // (a0 + a2), (a1 + a3)
+	return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+#endif
+
+inline float4 load3(const float *p) { return set4(p[0], p[1], p[2], 0.f); }
+
+inline void store3(float *p, float4 a)
+{
+	float tmp[4];
+	store4(tmp, a);
+	p[0] = tmp[0];
+	p[1] = tmp[1];
+	p[2] = tmp[2];
+}
+
+} // namespace detail
+
+/**
+ * Hamilton product res = q * p
+ */
+inline bool quaternion_multiply(const float *q, const float *p, float *res)
+{
+	using namespace detail;
+
+	// the same products and summation order as the scalar code (subtractions are additions of negated products):
+	// res = q * p0 + a * p1 + b * p2 + c * p3
+	const float4 a = set4(-q[1], q[0], q[3], -q[2]);
+	const float4 b = set4(-q[2], -q[3], q[0], q[1]);
+	const float4 c = set4(-q[3], q[2], -q[1], q[0]);
+
+	float4 r = mul(load4(q), dup4(p[0]));
+	r = madd(r, a, dup4(p[1]));
+	r = madd(r, b, dup4(p[2]));
+	r = madd(r, c, dup4(p[3]));
+	store4(res, r);
+	return true;
+}
+
+/**
+ * Cross product res = a x b of 3 element vectors
+ */
+inline bool cross(const float *a, const float *b, float *res)
+{
+	using namespace detail;
+
+	const float4 l = mul(set4(a[1], a[2], a[0], 0.f), set4(b[2], b[0], b[1], 0.f));
+	const float4 r = mul(set4(a[2], a[0], a[1], 0.f), set4(b[1], b[2], b[0], 0.f));
+	store3(res, sub(l, r));
+	return true;
+}
+
+/**
+ * 3x3 (row-major) times 3x3: every result row is a linear combination of the rows of b
+ */
+template<>
+struct Multiply<float, 3, 3, 3> {
+	static bool run(const float *a, const float *b, float *res)
+	{
+		using namespace detail;
+
+		const float4 b0 = load3(&b[0]);
+		const float4 b1 = load3(&b[3]);
+		const float4 b2 = load3(&b[6]);
+
+		for (size_t i = 0; i < 3; i++) {
+#if defined(MATRIX_SIMD_BITEXACT)
+			// the scalar code accumulates onto zero (which matters for -0)
+			float4 r = madd(dup4(0.f), dup4(a[3 * i]), b0);
+#else
+			float4 r = mul(dup4(a[3 * i]), b0);
+#endif
+			r = madd(r, dup4(a[3 * i + 1]), b1);
+			r = madd(r, dup4(a[3 * i + 2]), b2);
+			store3(&res[3 * i], r);
+		}
+
+		return true;
+	}
+};
+
+/**
+ * 3x3 (row-major) times 3 element vector: linear combination of the columns of a
+ */
+template<>
+struct Multiply<float, 3, 3, 1> {
+	static bool run(const float *a, const float *b, float *res)
+	{
+		using namespace detail;
+
+		const float4 a0 = set4(a[0], a[3], a[6], 0.f);
+		const float4 a1 = set4(a[1], a[4], a[7], 0.f);
+		const float4 a2 = set4(a[2], a[5], a[8], 0.f);
+
+#if defined(MATRIX_SIMD_BITEXACT)
+		float4 r = madd(dup4(0.f), a0, dup4(b[0]));
+#else
+		float4 r = mul(a0, dup4(b[0]));
+#endif
+		r = madd(r, a1, dup4(b[1]));
+		r = madd(r, a2, dup4(b[2]));
+		store3(res, r);
+		return true;
+	}
+};
+
+#if !defined(MATRIX_SIMD_BITEXACT)
+// a tree reduction changes the summation order, so the dot products are only vectorized when not bit-exact
+
+template<>
+struct Dot<float, 3> {
+	static bool run(const float *a, const float *b, float *res)
+	{
+		*res = detail::hsum(detail::mul(detail::load3(a), detail::load3(b)));
+		return true;
+	}
+};
+
+template<>
+struct Dot<float, 4> {
+	static bool run(const float *a, const float *b, float *res)
+	{
+		*res = detail::hsum(detail::mul(detail::load4(a), detail::load4(b)));
+		return true;
+	}
+};
+#endif // !MATRIX_SIMD_BITEXACT
+
+#else
+
+static constexpr bool available = false;
+
+#endif
+
+/**
+ * Whether the kernels can be called: they are not constexpr, so constant evaluation
+ * (e.g. of constexpr rotation matrices) always uses the scalar code.
+ */
+inline constexpr bool active()
+{
+#if defined(MATRIX_SIMD_HELIUM) || defined(MATRIX_SIMD_NEON) || defined(MATRIX_SIMD_SSE)
+	return !__builtin_is_constant_evaluated();
+#else
+	return false;
+#endif
+}
+
+} // namespace simd
+
+} // namespace matrix
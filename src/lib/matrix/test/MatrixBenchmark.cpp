@@ -0,0 +1,205 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <matrix/math.hpp>
+
+using namespace matrix;
+
+template<size_t M>
+static SquareMatrix<float, M> randomSquareMatrix()
+{
+	SquareMatrix<float, M> A;
+
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < M; j++) {
+			A(i, j) = static_cast<float>((i * 7 + j * 13) % 17) / 17.f - 0.5f;
+		}
+
+		// diagonally dominant, always invertible
+		A(i, i) += static_cast<float>(M);
+	}
+
+	return A;
+}
+
+template<size_t M>
+static void BM_MatrixMultiplication(benchmark::State &state)
+{
+	const SquareMatrix<float, M> A = randomSquareMatrix<M>();
+	SquareMatrix<float, M> B = randomSquareMatrix<M>();
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(B = A * B);
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_MatrixMultiplication<3>);
+BENCHMARK(BM_MatrixMultiplication<6>);
+BENCHMARK(BM_MatrixMultiplication<24>); // EKF2 covariance
+
+// covariance propagation F * P * F^T + Q
+template<size_t M>
+static void BM_CovariancePropagation(benchmark::State &state)
+{
+	const SquareMatrix<float, M> F = randomSquareMatrix<M>();
+	const SquareMatrix<float, M> Q = randomSquareMatrix<M>();
+	SquareMatrix<float, M> P = randomSquareMatrix<M>();
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(P = F * P * F.transpose() + Q);
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_CovariancePropagation<6>);
+BENCHMARK(BM_CovariancePropagation<24>);
+
+template<size_t M>
+static void BM_CovariancePropagationConjugate(benchmark::State &state)
+{
+	const SquareMatrix<float, M> F = randomSquareMatrix<M>();
+	const SquareMatrix<float, M> Q = randomSquareMatrix<M>();
+	SquareMatrix<float, M> P = randomSquareMatrix<M>();
+
+	for (auto _ : state) {
+		P = conjugate(F, P);
+		P += Q;
+		benchmark::DoNotOptimize(P);
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_CovariancePropagationConjugate<6>);
+BENCHMARK(BM_CovariancePropagationConjugate<24>);
+
+template<size_t M>
+static void BM_MatrixInverse(benchmark::State &state)
+{
+	SquareMatrix<float, M> A = randomSquareMatrix<M>();
+	SquareMatrix<float, M> A_inv;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(A);
+		benchmark::DoNotOptimize(inv(A, A_inv));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_MatrixInverse<3>);
+BENCHMARK(BM_MatrixInverse<6>);
+BENCHMARK(BM_MatrixInverse<9>);
+
+// symmetric positive definite solve as in the magnetometer calibration fit, compare with BM_MatrixInverse
+template<size_t M>
+static void BM_LdltSolve(benchmark::State &state)
+{
+	const SquareMatrix<float, M> R = randomSquareMatrix<M>();
+	SquareMatrix<float, M> A = R.transposeMultiply(R);
+	Vector<float, M> b;
+	b.setAll(1.f);
+	Vector<float, M> x;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(A);
+		benchmark::DoNotOptimize(ldltSolve(A, b, x));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_LdltSolve<4>);
+BENCHMARK(BM_LdltSolve<9>);
+
+static void BM_MatrixPseudoInverse(benchmark::State &state)
+{
+	// control allocation effectiveness matrix size
+	Matrix<float, 6, 16> B;
+
+	for (size_t i = 0; i < 6; i++) {
+		for (size_t j = 0; j < 16; j++) {
+			B(i, j) = static_cast<float>((i * 7 + j * 13) % 17) / 17.f - 0.5f;
+		}
+	}
+
+	Matrix<float, 16, 6> B_inv;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(geninv(B, B_inv));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_MatrixPseudoInverse);
+
+static void BM_QuaternionRotate(benchmark::State &state)
+{
+	const Quatf q(Eulerf(0.1f, -0.2f, 1.5f));
+	Vector3f v(1.f, 2.f, 3.f);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(v = q.rotateVector(v));
+	}
+}
+BENCHMARK(BM_QuaternionRotate);
+
+static void BM_QuaternionMultiplication(benchmark::State &state)
+{
+	const Quatf dq(AxisAnglef(Vector3f(0.01f, -0.02f, 0.005f)));
+	Quatf q(Eulerf(0.1f, -0.2f, 1.5f));
+
+	for (auto _ : state) {
+		q = q * dq;
+		q.normalize();
+		benchmark::DoNotOptimize(q);
+	}
+}
+BENCHMARK(BM_QuaternionMultiplication);
+
+static void BM_DcmFromQuaternion(benchmark::State &state)
+{
+	Quatf q(Eulerf(0.1f, -0.2f, 1.5f));
+	Dcmf R;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(q);
+		benchmark::DoNotOptimize(R = Dcmf(q));
+	}
+}
+BENCHMARK(BM_DcmFromQuaternion);
+
+static void BM_EulerFromQuaternion(benchmark::State &state)
+{
+	Quatf q(Eulerf(0.1f, -0.2f, 1.5f));
+	Eulerf e;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(q);
+		benchmark::DoNotOptimize(e = Eulerf(q));
+	}
+}
+BENCHMARK(BM_EulerFromQuaternion);
@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <matrix/math.hpp>
+
+using namespace matrix;
+
+// everything below is evaluated by the compiler, the tests only check that the results are usable at runtime
+
+static constexpr float data_33[9] = {1.f, 2.f, 3.f,
+				     4.f, 5.f, 6.f,
+				     7.f, 8.f, 10.f
+				    };
+
+static constexpr Matrix3f A(data_33);
+static constexpr Matrix3f A_T = A.transpose();
+static constexpr Matrix3f A_A_T = A * A_T;
+static constexpr SquareMatrix3f A_sum = A + A_T - eye<float, 3>() * 2.f;
+
+static_assert(A_T(0, 2) == 7.f, "transpose");
+static_assert(A_A_T(0, 0) == 14.f, "product");
+static_assert(A_A_T(2, 1) == 128.f, "product");
+static_assert(A_A_T(1, 2) == A_A_T(2, 1), "product symmetric");
+static_assert(A_sum(1, 1) == 8.f, "sum");
+static_assert(A_sum.trace() == 26.f, "trace");
+static_assert(A.multiplyByTranspose(A)(2, 1) == A_A_T(2, 1), "product by transpose");
+static_assert(conjugate(A, eye<float, 3>())(2, 1) == A_A_T(2, 1), "conjugate");
+
+static constexpr Vector3f v(1.f, 2.f, 3.f);
+static constexpr Vector3f w(-2.f, 0.5f, 4.f);
+static constexpr Vector3f v_cross_w = v % w;
+
+static_assert(v.dot(w) == 11.f, "dot");
+static_assert(v.norm_squared() == 14.f, "squared norm");
+static_assert(v_cross_w(0) == 6.5f && v_cross_w(1) == -10.f && v_cross_w(2) == 4.5f, "cross");
+static_assert((A * v)(2, 0) == 53.f, "matrix vector product");
+
+// 90 degree rotation about z as a quaternion, the Dcm from it is exact
+static constexpr float sqrt1_2 = 0.70710678118654752f;
+static constexpr Quatf q_yaw_90(sqrt1_2, 0.f, 0.f, sqrt1_2);
+static constexpr Dcmf R_yaw_90(q_yaw_90);
+static constexpr Quatf q_yaw_180 = q_yaw_90 * q_yaw_90;
+
+static_assert(R_yaw_90(2, 2) == 1.f, "dcm from quaternion");
+static_assert(q_yaw_180(1) == 0.f && q_yaw_180(2) == 0.f, "quaternion product");
+static_assert(Dcmf()(1, 1) == 1.f && Dcmf()(0, 1) == 0.f, "dcm identity");
+
+TEST(MatrixConstexprTest, Matrix)
+{
+	const float data_check[9] = {14.f, 32.f, 53.f,
+				     32.f, 77.f, 128.f,
+				     53.f, 128.f, 213.f
+				    };
+	EXPECT_EQ(A_A_T, Matrix3f(data_check));
+	EXPECT_EQ(A_A_T, A * A.transpose());
+}
+
+TEST(MatrixConstexprTest, Attitude)
+{
+	EXPECT_EQ(R_yaw_90, Dcmf(Eulerf(0.f, 0.f, M_PI_2_F)));
+	EXPECT_EQ(Quatf(R_yaw_90), q_yaw_90);
+	EXPECT_EQ(Dcmf(q_yaw_180), Dcmf(Eulerf(0.f, 0.f, M_PI_F)));
+}
@@ -193,3 +193,60 @@ TEST(MatrixInverseTest, Inverse)
 	EXPECT_EQ(choleskyInv(A4)*A4, I3);
 	EXPECT_EQ(cholesky(Z3), Z3);
 }
+
+TEST(MatrixInverseTest, TriangularAndLdlt)
+{
+	// symmetric positive definite
+	float data_spd[16] = {
+		4.f, 1.f, 0.5f, -1.f,
+		1.f, 3.f, 0.2f, 0.f,
+		0.5f, 0.2f, 2.f, 0.3f,
+		-1.f, 0.f, 0.3f, 5.f
+	};
+	const SquareMatrix<float, 4> A(data_spd);
+
+	const SquareMatrix<float, 4> L = cholesky(A);
+	SquareMatrix<float, 4> L_inv;
+	EXPECT_TRUE(invLowerTriangular(L, L_inv));
+	EXPECT_EQ(L_inv * L, (eye<float, 4>()));
+	EXPECT_EQ(L_inv, inv(L));
+	EXPECT_EQ(choleskyInv(A), inv(A));
+
+	// single and multiple right hand sides
+	const Vector4f b(1.f, -2.f, 0.5f, 3.f);
+	Vector4f x;
+	EXPECT_TRUE(ldltSolve(A, b, x));
+	EXPECT_EQ(A * x, b);
+	EXPECT_EQ(x, inv(A) * b);
+
+	Matrix<float, 4, 2> B;
+	B.setCol(0, b);
+	B.setCol(1, Vector4f(0.f, 1.f, 0.f, -1.f));
+	Matrix<float, 4, 2> X;
+	EXPECT_TRUE(ldltSolve(A, B, X));
+	EXPECT_EQ(A * X, B);
+
+	// only the lower triangle is used
+	SquareMatrix<float, 4> A_lower = A;
+
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = i + 1; j < 4; j++) {
+			A_lower(i, j) = NAN;
+		}
+	}
+
+	Vector4f x_lower;
+	EXPECT_TRUE(ldltSolve(A_lower, b, x_lower));
+	EXPECT_EQ(x_lower, x);
+
+	// not positive definite: fails and leaves the result untouched
+	SquareMatrix<float, 4> A_indefinite = A;
+	A_indefinite(2, 2) = -1.f;
+	Vector4f x_indefinite(1.f, 1.f, 1.f, 1.f);
+	EXPECT_FALSE(ldltSolve(A_indefinite, b, x_indefinite));
+	EXPECT_EQ(x_indefinite, Vector4f(1.f, 1.f, 1.f, 1.f));
+
+	SquareMatrix<float, 4> Z;
+	EXPECT_FALSE(invLowerTriangular(Z, L_inv));
+	EXPECT_EQ(choleskyInv(Z), Z);
+}
@@ -98,3 +98,51 @@ TEST(MatrixMultiplicationTest, Multiplication)
 	Matrix<float, 4, 2> m42_plus2 = m42 - (-2);
 	EXPECT_EQ(m42_plus2, m42_plus2_check);
 }
+
+TEST(MatrixMultiplicationTest, FusedTransposeProducts)
+{
+	float data_43[12] = {1, 3, 2,
+			     2, 2, 1,
+			     5, 2, 1,
+			     2, 3, 4
+			    };
+	float data_23[6] = {2, 1, 5,
+			    3, 7, 4
+			   };
+	float data_42[8] = {1, 2,
+			    0, 3,
+			    4, 1,
+			    2, 2
+			   };
+	Matrix<float, 4, 3> m43(data_43);
+	Matrix<float, 2, 3> m23(data_23);
+	Matrix<float, 4, 2> m42(data_42);
+
+	// same operations in the same order as the explicit transpose, so exactly equal
+	Matrix<float, 4, 2> m43_m23T = m43.multiplyByTranspose(m23);
+	EXPECT_EQ(m43_m23T, m43 * m23.transpose());
+
+	Matrix<float, 3, 2> m43T_m42 = m43.transposeMultiply(m42);
+	EXPECT_EQ(m43T_m42, m43.transpose() * m42);
+
+	SquareMatrix<float, 3> P;
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			P(i, j) = 0.1f * (i + 1) + 0.03f * j;
+		}
+	}
+
+	SquareMatrix<float, 4> APAT = conjugate(m43, P);
+	EXPECT_EQ(APAT, m43 * P * m43.transpose());
+
+	SquareMatrix<float, 2> BPBT = conjugate(m23, P);
+	EXPECT_EQ(BPBT, m23 * P * m23.transpose());
+
+	// in-place update as used for covariance propagation
+	SquareMatrix<float, 3> Q = diag(Vector3f(1.f, 2.f, 3.f));
+	SquareMatrix<float, 3> F = P + eye<float, 3>();
+	SquareMatrix<float, 3> P_check = F * P * F.transpose() + Q;
+	P = conjugate(F, P) + Q;
+	EXPECT_EQ(P, P_check);
+}
@@ -0,0 +1,182 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Checks the vectorized kernels (simd.hpp) against the scalar code.
+ *
+ * Compiled with MATRIX_SIMD, MATRIX_SIMD_BITEXACT and -ffp-contract=off: the results need to be bit-identical
+ * to the scalar expressions below. Without a SIMD backend on the host this tests the scalar code.
+ */
+
+#include <gtest/gtest.h>
+#include <matrix/math.hpp>
+
+#include <cstdint>
+
+using namespace matrix;
+
+namespace
+{
+
+// deterministic pseudo-random values in [-2, 2), with some exact zeros and negative zeros
+float random_value(uint32_t &state)
+{
+	state = state * 1664525u + 1013904223u;
+
+	const uint32_t kind = state >> 28;
+
+	if (kind == 0) {
+		return 0.f;
+
+	} else if (kind == 1) {
+		return -0.f;
+	}
+
+	return (float)(state >> 8) / (float)(1u << 22) - 2.f;
+}
+
+template<size_t M, size_t N>
+Matrix<float, M, N> random_matrix(uint32_t &state)
+{
+	Matrix<float, M, N> m;
+
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < N; j++) {
+			m(i, j) = random_value(state);
+		}
+	}
+
+	return m;
+}
+
+template<size_t M, size_t N>
+void expect_bit_equal(const Matrix<float, M, N> &a, const Matrix<float, M, N> &b)
+{
+	// also distinguishes -0 from +0
+	EXPECT_EQ(memcmp(&a(0, 0), &b(0, 0), sizeof(float) * M * N), 0) << "simd:\n" << a << "scalar:\n" << b;
+}
+
+static constexpr int ITERATIONS = 10000;
+
+} // namespace
+
+TEST(MatrixSimdTest, QuaternionProduct)
+{
+	uint32_t state = 1;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		const Quatf q(random_matrix<4, 1>(state));
+		const Quatf p(random_matrix<4, 1>(state));
+
+		const Quatf expected(
+			q(0) * p(0) - q(1) * p(1) - q(2) * p(2) - q(3) * p(3),
+			q(1) * p(0) + q(0) * p(1) - q(3) * p(2) + q(2) * p(3),
+			q(2) * p(0) + q(3) * p(1) + q(0) * p(2) - q(1) * p(3),
+			q(3) * p(0) - q(2) * p(1) + q(1) * p(2) + q(0) * p(3));
+
+		expect_bit_equal<4, 1>(q * p, expected);
+	}
+}
+
+TEST(MatrixSimdTest, CrossProduct)
+{
+	uint32_t state = 2;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		const Vector3f a(random_matrix<3, 1>(state));
+		const Vector3f b(random_matrix<3, 1>(state));
+
+		const Vector3f expected(a(1) * b(2) - a(2) * b(1), -a(0) * b(2) + a(2) * b(0), a(0) * b(1) - a(1) * b(0));
+
+		expect_bit_equal<3, 1>(a.cross(b), expected);
+	}
+}
+
+TEST(MatrixSimdTest, MatrixProducts)
+{
+	uint32_t state = 3;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		const Matrix3f a = random_matrix<3, 3>(state);
+		const Matrix3f b = random_matrix<3, 3>(state);
+		const Vector3f v(random_matrix<3, 1>(state));
+
+		Matrix3f expected_ab;
+		Vector3f expected_av;
+
+		for (size_t r = 0; r < 3; r++) {
+			for (size_t c = 0; c < 3; c++) {
+				float sum = 0.f;
+
+				for (size_t k = 0; k < 3; k++) {
+					sum += a(r, k) * b(k, c);
+				}
+
+				expected_ab(r, c) = sum;
+			}
+
+			float sum = 0.f;
+
+			for (size_t k = 0; k < 3; k++) {
+				sum += a(r, k) * v(k);
+			}
+
+			expected_av(r) = sum;
+		}
+
+		expect_bit_equal<3, 3>(a * b, expected_ab);
+		expect_bit_equal<3, 1>(a * v, expected_av);
+	}
+}
+
+TEST(MatrixSimdTest, Attitude)
+{
+	// higher level operations built on the kernels
+	uint32_t state = 4;
+
+	for (int i = 0; i < ITERATIONS / 10; i++) {
+		Quatf q(random_matrix<4, 1>(state));
+		const Vector3f v(random_matrix<3, 1>(state));
+
+		if (q.norm() < 0.1f) {
+			continue;
+		}
+
+		q.normalize();
+
+		const Dcmf R(q);
+		EXPECT_TRUE(isEqual(q.rotateVector(v), Vector3f(R * v), 1e-5f));
+		EXPECT_TRUE(isEqual(Dcmf(q * q), R * R, 1e-5f));
+	}
+}
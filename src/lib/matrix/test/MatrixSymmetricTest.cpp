@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <matrix/math.hpp>
+
+using namespace matrix;
+
+static SquareMatrix<float, 4> symmetric4x4()
+{
+	float data[16] = {4, 1, 2, 3,
+			  1, 5, 6, 7,
+			  2, 6, 8, 9,
+			  3, 7, 9, 10
+			 };
+	return SquareMatrix<float, 4>(data);
+}
+
+TEST(MatrixSymmetricTest, Storage)
+{
+	EXPECT_EQ(sizeof(SymmetricMatrix<float, 24>), 300 * sizeof(float));
+
+	SymmetricMatrix<float, 4> A;
+	EXPECT_EQ(A.full(), (SquareMatrix<float, 4>()));
+
+	A(2, 1) = 3.f;
+	EXPECT_FLOAT_EQ(A(1, 2), 3.f);
+
+	A(0, 3) = -1.f;
+	EXPECT_FLOAT_EQ(A(3, 0), -1.f);
+
+	A.zero();
+	EXPECT_EQ(A.full(), (SquareMatrix<float, 4>()));
+}
+
+TEST(MatrixSymmetricTest, FromSquare)
+{
+	const SquareMatrix<float, 4> S = symmetric4x4();
+	const SymmetricMatrix<float, 4> A(S);
+	EXPECT_EQ(A.full(), S);
+
+	// only the upper triangle is used
+	SquareMatrix<float, 4> upper = S;
+	upper(3, 0) = 100.f;
+	SymmetricMatrix<float, 4> B;
+	B = upper;
+	EXPECT_EQ(B.full(), S);
+}
+
+TEST(MatrixSymmetricTest, Operations)
+{
+	const SquareMatrix<float, 4> S = symmetric4x4();
+	const SymmetricMatrix<float, 4> A(S);
+
+	EXPECT_EQ(A.diag(), S.diag());
+	EXPECT_FLOAT_EQ(A.trace(), S.trace());
+	EXPECT_FLOAT_EQ(A.trace<2>(1), S.trace<2>(1));
+	EXPECT_EQ(A.row(2), (Vector<float, 4>(S.row(2))));
+
+	const Vector<float, 4> v(Vector4f(1.f, -2.f, 0.5f, 3.f));
+	EXPECT_EQ(A * v, (Vector<float, 4>(S * v)));
+}
+
+TEST(MatrixSymmetricTest, Slice)
+{
+	const SquareMatrix<float, 4> S = symmetric4x4();
+	SymmetricMatrix<float, 4> A(S);
+
+	const Matrix<float, 2, 2> block = A.slice<2, 2>(1, 1);
+	const Matrix<float, 2, 2> block_check = S.slice<2, 2>(1, 1);
+	EXPECT_EQ(block, block_check);
+	EXPECT_EQ((A.slice<3, 3>(0, 0).diag()), Vector3f(4.f, 5.f, 8.f));
+
+	const Matrix<float, 2, 1> column = A.slice<2, 1>(0, 3);
+	EXPECT_FLOAT_EQ(column(0, 0), 3.f);
+	EXPECT_FLOAT_EQ(column(1, 0), 7.f);
+
+	// off diagonal block: the mirrored block changes as well
+	float data_off[4] = {-1, -2, -3, -4};
+	A.slice<2, 2>(0, 2) = Matrix<float, 2, 2>(data_off);
+	EXPECT_FLOAT_EQ(A(2, 0), -1.f);
+	EXPECT_FLOAT_EQ(A(3, 0), -2.f);
+	EXPECT_FLOAT_EQ(A(2, 1), -3.f);
+	EXPECT_FLOAT_EQ(A(3, 1), -4.f);
+
+	// diagonal block: the mirrored elements are taken from the upper triangle
+	float data_diag[4] = {1, 2,
+			      0, 3
+			     };
+	A.slice<2, 2>(0, 0) = Matrix<float, 2, 2>(data_diag);
+	EXPECT_FLOAT_EQ(A(0, 0), 1.f);
+	EXPECT_FLOAT_EQ(A(1, 0), 2.f);
+	EXPECT_FLOAT_EQ(A(1, 1), 3.f);
+}
+
+TEST(MatrixSymmetricTest, UncorrelateCovariance)
+{
+	const SquareMatrix<float, 4> S = symmetric4x4();
+
+	SymmetricMatrix<float, 4> A(S);
+	SquareMatrix<float, 4> B = S;
+	A.uncorrelateCovarianceSetVariance<2>(1, Vector2f(20.f, 30.f));
+	B.uncorrelateCovarianceSetVariance<2>(1, Vector2f(20.f, 30.f));
+	EXPECT_EQ(A.full(), B);
+
+	A = S;
+	B = S;
+	A.uncorrelateCovarianceSetVariance<1>(3, 2.f);
+	B.uncorrelateCovarianceSetVariance<1>(3, 2.f);
+	EXPECT_EQ(A.full(), B);
+
+	A = S;
+	B = S;
+	A.uncorrelateCovariance<2>(0);
+	B.uncorrelateCovariance<2>(0);
+	EXPECT_EQ(A.full(), B);
+}
@@ -68,6 +68,11 @@ public:
 
 	virtual bool getLatestSampleTimestamp(hrt_abstime &t) const { return false; }
 
+	/**
+	 * Publication timestamp of the latest setpoint, i.e. when the controller handed it over
+	 */
+	virtual bool getLatestPublicationTimestamp(hrt_abstime &t) const { return false; }
+
 	/**
 	 * Check whether the output (motor) is configured to be reversible
 	 */
@@ -76,6 +76,7 @@ MixingOutput::MixingOutput(const char *param_prefix, uint8_t max_num_outputs, Ou
 	_max_num_outputs(max_num_outputs < MAX_ACTUATORS ? max_num_outputs : MAX_ACTUATORS),
 	_interface(interface),
 	_control_latency_perf(perf_alloc(PC_ELAPSED, "control latency")),
+	_output_interval_perf(perf_alloc(PC_INTERVAL, "output interval")),
 	_param_prefix(param_prefix)
 {
 	/* Safely initialize armed flags */
@@ -102,6 +103,7 @@ MixingOutput::MixingOutput(const char *param_prefix, uint8_t max_num_outputs, Ou
 MixingOutput::~MixingOutput()
 {
 	perf_free(_control_latency_perf);
+	perf_free(_output_interval_perf);
 	px4_sem_destroy(&_lock);
 
 	cleanupFunctions();
@@ -134,6 +136,7 @@ void MixingOutput::printStatus() const
 {
 	PX4_INFO("Param prefix: %s", _param_prefix);
 	perf_print_counter(_control_latency_perf);
+	perf_print_counter(_output_interval_perf);
 
 	if (_wq_switched) {
 		PX4_INFO("Switched to rate_ctrl work queue");
@@ -509,11 +512,11 @@ MixingOutput::limitAndUpdateOutputs(float outputs[MAX_ACTUATORS], bool has_updat
 	}
 
 	/* now return the outputs to the driver */
-	if (_interface.updateOutputs(_current_output_value, _max_num_outputs, has_updates)) {
-		actuator_outputs_s actuator_outputs{};
-		setAndPublishActuatorOutputs(_max_num_outputs, actuator_outputs);
+	hrt_abstime trigger_time = 0;
 
-		updateLatencyPerfCounter(actuator_outputs);
+	if (_interface.updateOutputsFrame(_current_output_value, _max_num_outputs, has_updates, trigger_time)) {
+		actuator_outputs_s actuator_outputs{};
+		setAndPublishActuatorOutputs(_max_num_outputs, trigger_time, actuator_outputs);
 	}
 }
 
@@ -622,7 +625,8 @@ MixingOutput::output_limit_calc(const bool armed, const int num_channels, const
 }
 
 void
-MixingOutput::setAndPublishActuatorOutputs(unsigned num_outputs, actuator_outputs_s &actuator_outputs)
+MixingOutput::setAndPublishActuatorOutputs(unsigned num_outputs, hrt_abstime trigger_time,
+		actuator_outputs_s &actuator_outputs)
 {
 	actuator_outputs.noutputs = num_outputs;
 
@@ -630,21 +634,105 @@ MixingOutput::setAndPublishActuatorOutputs(unsigned num_outputs, actuator_output
 		actuator_outputs.output[i] = _current_output_value[i];
 	}
 
+	updateLatencyPerfCounter(trigger_time, actuator_outputs);
+	updateJitter(trigger_time, actuator_outputs);
+	publishLatencyStatistics(trigger_time);
+
 	actuator_outputs.timestamp = hrt_absolute_time();
 	_outputs_pub.publish(actuator_outputs);
 }
 
 void
-MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs)
+MixingOutput::updateLatencyPerfCounter(hrt_abstime trigger_time, actuator_outputs_s &actuator_outputs)
 {
 	// Just check the first function. It means we only get the latency if motors are assigned first, which is the default
 	if (_function_allocated[0]) {
 		hrt_abstime timestamp_sample;
 
-		if (_function_allocated[0]->getLatestSampleTimestamp(timestamp_sample)) {
-			perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - timestamp_sample);
+		if (_function_allocated[0]->getLatestSampleTimestamp(timestamp_sample) && trigger_time > timestamp_sample) {
+			actuator_outputs.latency = trigger_time - timestamp_sample;
+			perf_set_elapsed(_control_latency_perf, actuator_outputs.latency);
+
+			LatencyStatistics &stats = _latency_statistics;
+			stats.latency_frames++;
+			stats.latency_min = math::min(stats.latency_min, actuator_outputs.latency);
+			stats.latency_max = math::max(stats.latency_max, actuator_outputs.latency);
+			stats.latency_sum += actuator_outputs.latency;
+
+			hrt_abstime timestamp_publication;
+
+			if (_function_allocated[0]->getLatestPublicationTimestamp(timestamp_publication)
+			    && (timestamp_publication >= timestamp_sample) && (timestamp_publication <= trigger_time)) {
+				stats.control_latency_frames++;
+				stats.control_latency_sum += timestamp_publication - timestamp_sample;
+			}
+		}
+	}
+}
+
+void
+MixingOutput::updateJitter(hrt_abstime trigger_time, actuator_outputs_s &actuator_outputs)
+{
+	perf_count_interval(_output_interval_perf, trigger_time);
+
+	if (_last_trigger_time != 0 && trigger_time > _last_trigger_time) {
+		const float interval = trigger_time - _last_trigger_time;
+
+		// reset on large changes, e.g. switching from the low rate schedule to topic updates
+		if (_frame_interval_avg < FLT_EPSILON || fabsf(interval - _frame_interval_avg) > _frame_interval_avg) {
+			_frame_interval_avg = interval;
+		}
+
+		actuator_outputs.jitter = lroundf(fabsf(interval - _frame_interval_avg));
+
+		_latency_statistics.frames++;
+		_latency_statistics.jitter_max = math::max(_latency_statistics.jitter_max, actuator_outputs.jitter);
+		_latency_statistics.jitter_square_sum += (interval - _frame_interval_avg) * (interval - _frame_interval_avg);
+		_frame_interval_avg += 0.05f * (interval - _frame_interval_avg);
+	}
+
+	_last_trigger_time = trigger_time;
+}
+
+void
+MixingOutput::publishLatencyStatistics(hrt_abstime trigger_time)
+{
+	LatencyStatistics &stats = _latency_statistics;
+
+	if (stats.window_start == 0) {
+		stats.window_start = trigger_time;
+		return;
+	}
+
+	if (trigger_time < stats.window_start + 1_s) {
+		return;
+	}
+
+	// only outputs driving motors know the control sample
+	if (stats.latency_frames > 0) {
+		control_latency_s control_latency{};
+		control_latency.frames = stats.frames;
+		control_latency.latency_min = stats.latency_min;
+		control_latency.latency_max = stats.latency_max;
+		control_latency.latency_mean = (float)stats.latency_sum / stats.latency_frames;
+
+		if (stats.control_latency_frames > 0) {
+			control_latency.control_latency_mean = (float)stats.control_latency_sum / stats.control_latency_frames;
+			control_latency.output_latency_mean = control_latency.latency_mean - control_latency.control_latency_mean;
+
+		} else {
+			control_latency.control_latency_mean = NAN;
+			control_latency.output_latency_mean = NAN;
 		}
+
+		control_latency.jitter_max = stats.jitter_max;
+		control_latency.jitter_rms = (stats.frames > 0) ? sqrtf(stats.jitter_square_sum / stats.frames) : NAN;
+		control_latency.timestamp = hrt_absolute_time();
+		_control_latency_pub.publish(control_latency);
 	}
+
+	stats = LatencyStatistics{};
+	stats.window_start = trigger_time;
 }
 
 uint16_t
@@ -59,6 +59,7 @@
 #include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/actuator_armed.h>
 #include <uORB/topics/actuator_outputs.h>
+#include <uORB/topics/control_latency.h>
 #include <uORB/topics/parameter_update.h>
 
 using namespace time_literals;
@@ -87,6 +88,21 @@ public:
 	virtual bool updateOutputs(uint16_t outputs[MAX_ACTUATORS],
 				   unsigned num_outputs, unsigned num_control_groups_updated) = 0;
 
+	/**
+	 * Batched output update: the driver gets the complete frame, loads all channels and then starts
+	 * them with a single trigger (e.g. one DMA burst across all timers).
+	 * The default implementation calls updateOutputs() and takes the time after it returns.
+	 * @param trigger_time set to the time the frame was started, used for the latency and jitter in actuator_outputs
+	 * @return if true, the update got handled, and actuator_outputs can be published
+	 */
+	virtual bool updateOutputsFrame(uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+					unsigned num_control_groups_updated, hrt_abstime &trigger_time)
+	{
+		const bool updated = updateOutputs(outputs, num_outputs, num_control_groups_updated);
+		trigger_time = hrt_absolute_time();
+		return updated;
+	}
+
 	/** called whenever the mixer gets updated/reset */
 	virtual void mixerChanged() {}
 };
@@ -212,9 +228,11 @@ private:
 		return (_armed.prearmed && !_armed.armed) || _armed.in_esc_calibration_mode;
 	}
 
-	void setAndPublishActuatorOutputs(unsigned num_outputs, actuator_outputs_s &actuator_outputs);
+	void setAndPublishActuatorOutputs(unsigned num_outputs, hrt_abstime trigger_time, actuator_outputs_s &actuator_outputs);
 	void publishMixerStatus(const actuator_outputs_s &actuator_outputs);
-	void updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs);
+	void updateLatencyPerfCounter(hrt_abstime trigger_time, actuator_outputs_s &actuator_outputs);
+	void publishLatencyStatistics(hrt_abstime trigger_time);
+	void updateJitter(hrt_abstime trigger_time, actuator_outputs_s &actuator_outputs);
 
 	void cleanupFunctions();
 
@@ -273,6 +291,25 @@ private:
 	OutputModuleInterface &_interface;
 
 	perf_counter_t _control_latency_perf;
+	perf_counter_t _output_interval_perf;
+
+	hrt_abstime _last_trigger_time{0};
+	float _frame_interval_avg{0.f}; ///< [us] running average of the interval between output frames
+
+	struct LatencyStatistics {
+		hrt_abstime window_start{0};
+		uint16_t frames{0};
+		uint16_t latency_frames{0};
+		uint16_t control_latency_frames{0};
+		uint32_t latency_min{UINT32_MAX};
+		uint32_t latency_max{0};
+		uint64_t latency_sum{0};
+		uint64_t control_latency_sum{0};
+		uint32_t jitter_max{0};
+		float jitter_square_sum{0.f};
+	} _latency_statistics{}; ///< accumulated over one control_latency publication interval
+
+	uORB::PublicationMulti<control_latency_s> _control_latency_pub{ORB_ID(control_latency)};
 
 	FunctionProviderBase *_function_allocated[MAX_ACTUATORS] {}; ///< unique allocated functions
 	FunctionProviderBase *_functions[MAX_ACTUATORS] {}; ///< currently assigned functions
@@ -268,6 +268,43 @@ TEST_F(MixerModuleTest, basic)
 	EXPECT_FALSE(test_module.was_scheduled);
 }
 
+class OutputModuleFrameTest : public OutputModuleTest
+{
+public:
+	bool updateOutputsFrame(uint16_t outputs_[MAX_ACTUATORS], unsigned num_outputs_,
+				unsigned num_control_groups_updated, hrt_abstime &trigger_time) override
+	{
+		memcpy(outputs, outputs_, sizeof(outputs));
+		num_outputs = num_outputs_;
+		++num_frames;
+		trigger_time = hrt_absolute_time();
+		return true;
+	}
+
+	int num_frames{0};
+};
+
+TEST_F(MixerModuleTest, OutputFrame)
+{
+	// a driver with batched output gets the complete frame through updateOutputsFrame() only
+	OutputModuleFrameTest test_module;
+	test_module.configureFunctions({(int)OutputFunction::Motor1});
+	MixingOutput mixing_output{PARAM_PREFIX, MAX_NUM_OUTPUTS, test_module, MixingOutput::SchedulingPolicy::Disabled, false, false};
+	mixing_output.setAllDisarmedValues(DISARMED_VALUE);
+	mixing_output.setAllFailsafeValues(FAILSAFE_VALUE);
+	mixing_output.setAllMinValues(MIN_VALUE);
+	mixing_output.setAllMaxValues(MAX_VALUE);
+	mixing_output.updateSubscriptions(false);
+
+	EXPECT_EQ(test_module.num_frames, update(mixing_output));
+	EXPECT_EQ(test_module.num_updates, 0);
+	EXPECT_EQ(test_module.num_outputs, MAX_NUM_OUTPUTS);
+
+	for (int i = 0; i < test_module.num_outputs; ++i) {
+		EXPECT_EQ(test_module.outputs[i], DISARMED_VALUE);
+	}
+}
+
 TEST_F(MixerModuleTest, arming)
 {
 	OutputModuleTest test_module;
@@ -53,6 +53,7 @@ void VelocitySmoothing::reset(float accel, float vel, float pos)
 	_state.x = pos;
 
 	_state_init = _state;
+	_profile_valid = false;
 }
 
 float VelocitySmoothing::saturateT1ForAccel(float a0, float j_max, float T1, float a_max) const
@@ -163,12 +164,50 @@ float VelocitySmoothing::computeT3(float T1, float a0, float j_max) const
 void VelocitySmoothing::updateDurations(float vel_setpoint)
 {
 	_vel_sp = math::constrain(vel_setpoint, -_max_vel, _max_vel);
+
+	_profile_reused = _profile_valid
+			  && (_vel_sp == _profile_vel_sp)
+			  && (_max_jerk == _profile_max_jerk)
+			  && (_max_accel == _profile_max_accel)
+			  && advanceProfile();
+
 	_local_time = 0.f;
 	_state_init = _state;
 
+	if (_profile_reused) {
+		return;
+	}
+
 	_direction = computeDirection();
 
 	updateDurationsMinimizeTotalTime();
+
+	_profile_valid = true;
+	_profile_vel_sp = _vel_sp;
+	_profile_max_jerk = _max_jerk;
+	_profile_max_accel = _max_accel;
+}
+
+bool VelocitySmoothing::advanceProfile()
+{
+	// Once completed, a new profile is computed: it corrects for any remaining difference to the setpoint
+	if (_local_time >= getTotalTime()) {
+		return false;
+	}
+
+	float t_remain = _local_time;
+
+	const float t1 = math::min(t_remain, _T1);
+	_T1 -= t1;
+	t_remain -= t1;
+
+	const float t2 = math::min(t_remain, _T2);
+	_T2 -= t2;
+	t_remain -= t2;
+
+	_T3 -= t_remain;
+
+	return true;
 }
 
 int VelocitySmoothing::computeDirection() const
@@ -247,6 +286,9 @@ void VelocitySmoothing::updateTraj(float dt, float time_stretch)
 	t_remain -= t1;
 
 	if (t_remain > 0.f) {
+		// remove rounding errors of the first phase, which are not corrected when the profile is reused
+		_state.a = math::constrain(_state.a, -_max_accel, _max_accel);
+
 		float t2 = math::min(t_remain, _T2);
 		_state = evaluatePoly(0.f, _state.a, _state.v, _state.x, t2, 0.f);
 		t_remain -= t2;
@@ -265,6 +307,26 @@ void VelocitySmoothing::updateTraj(float dt, float time_stretch)
 
 void VelocitySmoothing::timeSynchronization(VelocitySmoothing *traj, int n_traj)
 {
+	bool all_reused = true;
+
+	for (int i = 0; i < n_traj; i++) {
+		all_reused = all_reused && traj[i].isProfileReused();
+	}
+
+	if (all_reused) {
+		// the reused profiles already have synchronized durations
+		return;
+	}
+
+	for (int i = 0; i < n_traj; i++) {
+		if (traj[i].isProfileReused()) {
+			// synchronize from time-optimal durations, as if all were recomputed
+			traj[i]._direction = traj[i].computeDirection();
+			traj[i].updateDurationsMinimizeTotalTime();
+			traj[i]._profile_reused = false;
+		}
+	}
+
 	float desired_time = 0.f;
 	int longest_traj_index = 0;
 
@@ -289,6 +351,10 @@ void VelocitySmoothing::timeSynchronization(VelocitySmoothing *traj, int n_traj)
 
 void VelocitySmoothing::updateDurationsGivenTotalTime(float T123)
 {
+	// The durations for a given total time do not exactly reach the setpoint,
+	// so these have to be recomputed on every update
+	_profile_valid = false;
+
 	float jerk_max_T1 = _direction * _max_jerk;
 	float delta_v = _vel_sp - _state.v;
 
@@ -75,6 +75,8 @@ public:
 	/**
 	 * Compute T1, T2, T3 depending on the current state and velocity setpoint. This should be called on every cycle
 	 * and before updateTraj().
+	 * If the setpoint and constraints did not change since the last call and the state was not modified
+	 * externally, the remaining part of the current profile is reused instead of solving for a new one.
 	 * @param vel_setpoint velocity setpoint input
 	 */
 	void updateDurations(float vel_setpoint);
@@ -100,10 +102,21 @@ public:
 	void setMaxVel(float max_vel) { _max_vel = max_vel; }
 
 	float getCurrentJerk() const { return _state.j; }
-	void setCurrentAcceleration(const float accel) { _state.a = _state_init.a = accel; }
+	void setCurrentAcceleration(const float accel)
+	{
+		if (accel != _state.a) { _profile_valid = false; }
+
+		_state.a = _state_init.a = accel;
+	}
 	float getCurrentAcceleration() const { return _state.a; }
-	void setCurrentVelocity(const float vel) { _state.v = _state_init.v = vel; }
+	void setCurrentVelocity(const float vel)
+	{
+		if (vel != _state.v) { _profile_valid = false; }
+
+		_state.v = _state_init.v = vel;
+	}
 	float getCurrentVelocity() const { return _state.v; }
+	// the position does not affect the durations, so the current profile stays valid
 	void setCurrentPosition(const float pos) { _state.x = _state_init.x = pos; }
 	float getCurrentPosition() const { return _state.x; }
 
@@ -112,6 +125,11 @@ public:
 	float getT3() const { return _T3; }
 	float getTotalTime() const { return _T1 + _T2 + _T3; }
 
+	/**
+	 * @return true if the last updateDurations() call reused the previous profile
+	 */
+	bool isProfileReused() const { return _profile_reused; }
+
 	/**
 	 * Synchronize several trajectories to have the same total time. This is required to generate
 	 * straight lines.
@@ -129,6 +147,13 @@ private:
 	 */
 	void updateDurationsMinimizeTotalTime();
 
+	/**
+	 * Continue the current profile from the current state: shift the start of the profile
+	 * to the current time by removing the elapsed part of the phases.
+	 * @return false if the profile is completed
+	 */
+	bool advanceProfile();
+
 	/**
 	 * Compute T1, T2, T3 depending on the current state and velocity setpoint.
 	 * @param T123 desired total time of the trajectory
@@ -210,4 +235,11 @@ private:
 	float _T3{0.f}; ///< Decreasing acceleration [s]
 
 	float _local_time{0.f}; ///< Current local time
+
+	/* Inputs the current profile was computed with */
+	bool _profile_valid{false};
+	bool _profile_reused{false};
+	float _profile_vel_sp{0.f};
+	float _profile_max_jerk{0.f};
+	float _profile_max_accel{0.f};
 };
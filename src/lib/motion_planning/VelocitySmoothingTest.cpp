@@ -267,3 +267,56 @@ TEST_F(VelocitySmoothingTest, testZeroSetpoint)
 		EXPECT_FLOAT_EQ(_trajectories[i].getCurrentPosition(), 0.f);
 	}
 }
+
+TEST_F(VelocitySmoothingTest, testProfileReuse)
+{
+	// GIVEN: A set of constraints and a trajectory at rest
+	VelocitySmoothing &trajectory = _trajectories[0];
+	trajectory.setMaxJerk(8.f);
+	trajectory.setMaxAccel(4.f);
+	trajectory.setMaxVel(6.f);
+
+	// WHEN: a new setpoint is given
+	const float dt = 0.01f;
+	trajectory.updateDurations(3.f);
+	const float t123 = trajectory.getTotalTime();
+
+	// THEN: a new profile is computed
+	EXPECT_FALSE(trajectory.isProfileReused());
+
+	// WHEN: the setpoint stays the same
+	trajectory.updateTraj(dt);
+	trajectory.updateDurations(3.f);
+
+	// THEN: the remaining part of the profile is reused
+	EXPECT_TRUE(trajectory.isProfileReused());
+	EXPECT_NEAR(trajectory.getTotalTime(), t123 - dt, 1e-5f);
+
+	// AND: modifying the position does not invalidate it
+	trajectory.updateTraj(dt);
+	trajectory.setCurrentPosition(1.f);
+	trajectory.updateDurations(3.f);
+	EXPECT_TRUE(trajectory.isProfileReused());
+
+	// BUT: changing a constraint does
+	trajectory.updateTraj(dt);
+	trajectory.setMaxAccel(3.f);
+	trajectory.updateDurations(3.f);
+	EXPECT_FALSE(trajectory.isProfileReused());
+
+	// AND: so does modifying the velocity
+	trajectory.updateTraj(dt);
+	trajectory.setCurrentVelocity(0.5f);
+	trajectory.updateDurations(3.f);
+	EXPECT_FALSE(trajectory.isProfileReused());
+
+	// WHEN: the profile is followed until completion
+	for (int i = 0; i < 500; i++) {
+		trajectory.updateTraj(dt);
+		trajectory.updateDurations(3.f);
+	}
+
+	// THEN: the setpoint is reached
+	EXPECT_NEAR(trajectory.getCurrentVelocity(), 3.f, 1e-4f);
+	EXPECT_NEAR(trajectory.getCurrentAcceleration(), 0.f, 1e-4f);
+}
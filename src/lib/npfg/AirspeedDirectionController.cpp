@@ -44,15 +44,21 @@ AirspeedDirectionController::AirspeedDirectionController()
 float AirspeedDirectionController::controlHeading(const float heading_sp, const float heading,
 		const float airspeed) const
 {
-
 	const Vector2f airspeed_vector = Vector2f{cosf(heading), sinf(heading)} * airspeed;
 	const Vector2f airspeed_sp_vector_unit = Vector2f{cosf(heading_sp), sinf(heading_sp)};
 
+	return controlAirspeedDirection(airspeed_sp_vector_unit, airspeed_vector);
+}
+
+float AirspeedDirectionController::controlAirspeedDirection(const Vector2f &airspeed_sp_vector_unit,
+		const Vector2f &airspeed_vector) const
+{
 	const float dot_air_vel_err = airspeed_vector.dot(airspeed_sp_vector_unit);
 	const float cross_air_vel_err = airspeed_vector.cross(airspeed_sp_vector_unit);
 
 	if (dot_air_vel_err < 0.0f) {
 		// hold max lateral acceleration command above 90 deg heading error
+		const float airspeed = airspeed_vector.norm();
 		return p_gain_ * ((cross_air_vel_err < 0.0f) ? -airspeed : airspeed);
 
 	} else {
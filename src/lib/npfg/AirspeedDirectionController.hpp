@@ -59,6 +59,8 @@
 #ifndef PX4_AIRSPEEDDIRECTIONONTROLLER_HPP
 #define PX4_AIRSPEEDDIRECTIONONTROLLER_HPP
 
+#include <matrix/math.hpp>
+
 class AirspeedDirectionController
 {
 public:
@@ -68,6 +70,17 @@ public:
 
 	float controlHeading(const float heading_sp, const float heading, const float airspeed) const;
 
+	/*
+	 * Same as controlHeading(), but with the directions given as vectors, which avoids
+	 * converting them to angles and back.
+	 *
+	 * @param[in] airspeed_sp_vector_unit Unit vector of the airspeed direction setpoint
+	 * @param[in] airspeed_vector Air velocity vector [m/s]
+	 * @return Lateral acceleration setpoint [m/s^2]
+	 */
+	float controlAirspeedDirection(const matrix::Vector2f &airspeed_sp_vector_unit,
+				       const matrix::Vector2f &airspeed_vector) const;
+
 private:
 	float p_gain_{0.8885f}; // proportional gain (computed from period_ and damping_) [rad/s]
 };
@@ -39,21 +39,20 @@ CourseToAirspeedRefMapper::mapCourseSetpointToHeadingSetpoint(const float bearin
 		float airspeed_sp) const
 {
 	const Vector2f bearing_vector = Vector2f{cosf(bearing_setpoint), sinf(bearing_setpoint)};
-	const float wind_cross_bearing = wind_vel.cross(bearing_vector);
-	const float wind_dot_bearing = wind_vel.dot(bearing_vector);
-
-	Vector2f air_vel_ref;
-
-	if (bearingIsFeasible(wind_cross_bearing, wind_dot_bearing, airspeed_sp, wind_vel.norm())) {
+	const Vector2f air_vel_ref = airVelRef(bearing_vector, wind_vel, airspeed_sp);
 
-		const float airsp_dot_bearing = projectAirspOnBearing(airspeed_sp, wind_cross_bearing);
-		air_vel_ref = solveWindTriangle(wind_cross_bearing, airsp_dot_bearing, bearing_vector);
+	return atan2f(air_vel_ref(1), air_vel_ref(0));
+}
 
-	} else {
-		air_vel_ref = infeasibleAirVelRef(wind_vel, bearing_vector, wind_vel.norm(), airspeed_sp);
-	}
+Vector2f
+CourseToAirspeedRefMapper::mapBearingToAirspeedDirection(const Vector2f &bearing_vec, const Vector2f &wind_vel,
+		float airspeed_sp) const
+{
+	const Vector2f air_vel_ref = airVelRef(bearing_vec, wind_vel, airspeed_sp);
+	const float air_vel_ref_norm = air_vel_ref.norm();
 
-	return atan2f(air_vel_ref(1), air_vel_ref(0));
+	// same as the heading of atan2f(0, 0) for a zero reference
+	return (air_vel_ref_norm > FLT_EPSILON) ? Vector2f{air_vel_ref / air_vel_ref_norm} : Vector2f{1.f, 0.f};
 }
 
 float
@@ -61,6 +60,13 @@ CourseToAirspeedRefMapper::getMinAirspeedForCurrentBearing(const float bearing_s
 		float airspeed_max, float min_ground_speed) const
 {
 	const Vector2f bearing_vector = Vector2f{cosf(bearing_setpoint), sinf(bearing_setpoint)};
+	return getMinAirspeedForBearing(bearing_vector, wind_vel, airspeed_max, min_ground_speed);
+}
+
+float
+CourseToAirspeedRefMapper::getMinAirspeedForBearing(const Vector2f &bearing_vector, const Vector2f &wind_vel,
+		float airspeed_max, float min_ground_speed) const
+{
 	const float wind_cross_bearing = wind_vel.cross(bearing_vector);
 	const float wind_dot_bearing = wind_vel.dot(bearing_vector);
 
@@ -78,6 +84,21 @@ CourseToAirspeedRefMapper::getMinAirspeedForCurrentBearing(const float bearing_s
 	return math::min(airspeed_min, airspeed_max);
 }
 
+Vector2f
+CourseToAirspeedRefMapper::airVelRef(const Vector2f &bearing_vector, const Vector2f &wind_vel, float airspeed_sp) const
+{
+	const float wind_cross_bearing = wind_vel.cross(bearing_vector);
+	const float wind_dot_bearing = wind_vel.dot(bearing_vector);
+	const float wind_speed = wind_vel.norm();
+
+	if (bearingIsFeasible(wind_cross_bearing, wind_dot_bearing, airspeed_sp, wind_speed)) {
+		const float airsp_dot_bearing = projectAirspOnBearing(airspeed_sp, wind_cross_bearing);
+		return solveWindTriangle(wind_cross_bearing, airsp_dot_bearing, bearing_vector);
+	}
+
+	return infeasibleAirVelRef(wind_vel, bearing_vector, wind_speed, airspeed_sp);
+}
+
 float CourseToAirspeedRefMapper::projectAirspOnBearing(const float airspeed_true, const float wind_cross_bearing) const
 {
 	// NOTE: wind_cross_bearing must be less than airspeed to use this function
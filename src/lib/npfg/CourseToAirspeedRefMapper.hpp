@@ -76,7 +76,29 @@ public:
 	float getMinAirspeedForCurrentBearing(const float bearing_setpoint,
 					      const matrix::Vector2f &wind_vel, float max_airspeed, float min_ground_speed) const;
 
+	/*
+	 * Vector variants of the above, to be used when the bearing vector is shared by both calls:
+	 * they avoid the trigonometric conversions between angles and vectors.
+	 *
+	 * @param[in] bearing_vec Bearing unit vector
+	 * @return Unit vector of the air velocity reference (heading setpoint)
+	 */
+	matrix::Vector2f mapBearingToAirspeedDirection(const matrix::Vector2f &bearing_vec,
+			const matrix::Vector2f &wind_vel, float airspeed_sp) const;
+	float getMinAirspeedForBearing(const matrix::Vector2f &bearing_vec,
+				       const matrix::Vector2f &wind_vel, float max_airspeed, float min_ground_speed) const;
+
 private:
+	/*
+	 * Air velocity reference for a given bearing vector and wind velocity.
+	 *
+	 * @param[in] bearing_vec Bearing unit vector
+	 * @param[in] wind_vel Wind velocity vector [m/s]
+	 * @param[in] airspeed_sp Vehicle true airspeed setpoint [m/s]
+	 * @return Air velocity reference vector [m/s]
+	 */
+	matrix::Vector2f airVelRef(const matrix::Vector2f &bearing_vec, const matrix::Vector2f &wind_vel,
+				   float airspeed_sp) const;
 	/*
 	 * Projection of the air velocity vector onto the bearing line considering
 	 * a connected wind triangle.
@@ -366,3 +366,42 @@ TEST(NpfgTest, HeadingControl)
 	// THEN: we we expect maxmimum lateral acceleration setpoint
 	EXPECT_NEAR(lateral_acceleration_setpoint, airspeed * p_gain, 0.01f);
 }
+
+TEST(NpfgTest, VectorInterface)
+{
+	// TEST DESCRIPTION: the vector variants match the angle based interface
+	CourseToAirspeedRefMapper _course_to_airspeed;
+	AirspeedDirectionController _airspeed_reference_controller;
+
+	const float airspeed_max = 20.f;
+	const float min_ground_speed = 5.0f;
+	const float airspeed_setpoint = 15.f;
+
+	// GIVEN: feasible and infeasible wind conditions and a range of bearings
+	const Vector2f wind_vels[] = {Vector2f(0.f, 0.f), Vector2f(3.f, -4.f), Vector2f(-18.f, 6.f)};
+
+	for (const Vector2f &wind_vel : wind_vels) {
+		for (float bearing = -M_PI_F; bearing < M_PI_F; bearing += 0.3f) {
+			const Vector2f bearing_vec{cosf(bearing), sinf(bearing)};
+
+			// WHEN: we map the bearing to an airspeed direction
+			const float heading_sp = _course_to_airspeed.mapCourseSetpointToHeadingSetpoint(bearing, wind_vel,
+						 airspeed_setpoint);
+			const Vector2f heading_sp_vec = _course_to_airspeed.mapBearingToAirspeedDirection(bearing_vec, wind_vel,
+							airspeed_setpoint);
+
+			// THEN: both variants give the same result
+			EXPECT_NEAR(heading_sp_vec(0), cosf(heading_sp), 1e-5f);
+			EXPECT_NEAR(heading_sp_vec(1), sinf(heading_sp), 1e-5f);
+			EXPECT_FLOAT_EQ(_course_to_airspeed.getMinAirspeedForBearing(bearing_vec, wind_vel, airspeed_max, min_ground_speed),
+					_course_to_airspeed.getMinAirspeedForCurrentBearing(bearing, wind_vel, airspeed_max, min_ground_speed));
+
+			// AND: the resulting lateral acceleration is the same
+			const float heading = 0.7f;
+			const float airspeed = 12.f;
+			const Vector2f airspeed_vec = Vector2f{cosf(heading), sinf(heading)} * airspeed;
+			EXPECT_NEAR(_airspeed_reference_controller.controlAirspeedDirection(heading_sp_vec, airspeed_vec),
+				    _airspeed_reference_controller.controlHeading(heading_sp, heading, airspeed), 1e-4f);
+		}
+	}
+}
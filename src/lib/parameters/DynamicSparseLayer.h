@@ -37,6 +37,14 @@
 
 #include <px4_platform_common/atomic.h>
 
+/**
+ * Sorted array of the parameters that are set in this layer.
+ *
+ * Writers are serialized with an AtomicTransaction. Readers (get(), contains()) don't lock: writers
+ * make the sequence counter odd while they modify the slots and a reader retries if it overlapped
+ * with a write, falling back to the lock if it keeps colliding. An array replaced by a grow is only
+ * freed once no reader is in the lock-free path anymore.
+ */
 class DynamicSparseLayer : public ParamLayer
 {
 public:
@@ -63,6 +71,8 @@ public:
 		if (_slots.load()) {
 			free(_slots.load());
 		}
+
+		_freeRetired(_retired);
 	}
 
 	bool store(param_t param, param_value_u value) override
@@ -70,22 +80,30 @@ public:
 		AtomicTransaction transaction;
 		Slot *slots = _slots.load();
 
-		const int index = _getIndex(param);
+		const int next_slot = _next_slot.load();
+		const int index = _getIndex(slots, next_slot, param);
 
-		if (index < _next_slot) { // already exists
+		if (index < next_slot) { // already exists
+			_writeBegin();
 			slots[index].value = value;
+			_writeEnd();
 
-		} else if (_next_slot < _n_slots) {
-			slots[_next_slot++] = {param, value};
+		} else if (next_slot < _n_slots) {
+			_writeBegin();
+			slots[next_slot] = {param, value};
+			_next_slot.fetch_add(1);
 			_sort();
+			_writeEnd();
 
 		} else {
 			if (!_grow(transaction)) {
 				return false;
 			}
 
-			_slots.load()[_next_slot++] = {param, value};
+			_writeBegin();
+			_slots.load()[_next_slot.fetch_add(1)] = {param, value};
 			_sort();
+			_writeEnd();
 		}
 
 		return true;
@@ -93,8 +111,7 @@ public:
 
 	bool contains(param_t param) const override
 	{
-		const AtomicTransaction transaction;
-		return _getIndex(param) < _next_slot;
+		return _find(param, nullptr);
 	}
 
 	px4::AtomicBitset<PARAM_COUNT> containedAsBitset() const override
@@ -103,7 +120,7 @@ public:
 		const AtomicTransaction transaction;
 		Slot *slots = _slots.load();
 
-		for (int i = 0; i < _next_slot; i++) {
+		for (int i = 0; i < _next_slot.load(); i++) {
 			set.set(slots[i].param);
 		}
 
@@ -112,13 +129,10 @@ public:
 
 	param_value_u get(param_t param) const override
 	{
-		const AtomicTransaction transaction;
-		Slot *slots = _slots.load();
-
-		const int index = _getIndex(param);
+		param_value_u value;
 
-		if (index < _next_slot) { // exists in our data structure
-			return slots[index].value;
+		if (_find(param, &value)) { // exists in our data structure
+			return value;
 		}
 
 		// Workaround for C++ static initialization bug on SAMV7
@@ -133,13 +147,16 @@ public:
 	void reset(param_t param) override
 	{
 		const AtomicTransaction transaction;
-		int index = _getIndex(param);
 		Slot *slots = _slots.load();
+		const int next_slot = _next_slot.load();
+		const int index = _getIndex(slots, next_slot, param);
 
-		if (index < _next_slot) {
+		if (index < next_slot) {
+			_writeBegin();
 			slots[index] = {UINT16_MAX, param_value_u{}};
 			_sort();
-			_next_slot--;
+			_next_slot.fetch_sub(1);
+			_writeEnd();
 		}
 	}
 
@@ -150,7 +167,7 @@ public:
 
 	int size() const override
 	{
-		return _next_slot;
+		return _next_slot.load();
 	}
 
 	int byteSize() const override
@@ -164,6 +181,8 @@ private:
 		param_value_u value;
 	};
 
+	static_assert(sizeof(Slot) >= sizeof(Slot *), "a retired array stores the link to the next one in its first slot");
+
 	static int _slotCompare(const void *a, const void *b)
 	{
 		return ((int)((Slot *)a)->param) - ((int)((Slot *)b)->param);
@@ -174,11 +193,10 @@ private:
 		qsort(_slots.load(), _n_slots, sizeof(Slot), _slotCompare);
 	}
 
-	int _getIndex(param_t param) const
+	static int _getIndex(const Slot *slots, int next_slot, param_t param)
 	{
 		int left = 0;
-		int right = _next_slot - 1;
-		Slot *slots = _slots.load();
+		int right = next_slot - 1;
 
 		while (left <= right) {
 			int mid = (left + right) / 2;
@@ -194,9 +212,72 @@ private:
 			}
 		}
 
-		return _next_slot;
+		return next_slot;
 	}
 
+	bool _find(param_t param, param_value_u *value) const
+	{
+		static constexpr int MAX_LOCK_FREE_ATTEMPTS = 3;
+
+		// keeps _grow() from freeing the array we might be reading
+		_lock_free_readers.fetch_add(1);
+
+		for (int attempt = 0; attempt < MAX_LOCK_FREE_ATTEMPTS; attempt++) {
+			const uint32_t sequence = _sequence.load();
+
+			if (sequence & 1) {
+				continue; // write in progress
+			}
+
+			// The slot count is read before the slots pointer: the array never shrinks, so the
+			// pointer read afterwards has room for at least that many slots. An array replaced
+			// by _grow() meanwhile is not freed yet, the sequence check discards such reads.
+			const int next_slot = _next_slot.load();
+			const Slot *slots = _slots.load();
+			const int index = _getIndex(slots, next_slot, param);
+			const bool found = index < next_slot;
+			param_value_u found_value{};
+
+			if (found) {
+				found_value = slots[index].value;
+			}
+
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+			if (_sequence.load() == sequence) {
+				_lock_free_readers.fetch_sub(1);
+
+				if (found && value) {
+					*value = found_value;
+				}
+
+				return found;
+			}
+		}
+
+		_lock_free_readers.fetch_sub(1);
+
+		// keeps colliding with a writer (which might be preempted by us), take the lock
+		const AtomicTransaction transaction;
+		const int next_slot = _next_slot.load();
+		const Slot *slots = _slots.load();
+		const int index = _getIndex(slots, next_slot, param);
+
+		if (index < next_slot) {
+			if (value) {
+				*value = slots[index].value;
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	// mark the slots as being modified, the caller holds the AtomicTransaction
+	void _writeBegin() { _sequence.fetch_add(1); }
+	void _writeEnd() { _sequence.fetch_add(1); }
+
 	bool _grow(AtomicTransaction &transaction)
 	{
 		if (_n_slots == 0) {
@@ -207,7 +288,7 @@ private:
 
 		// As malloc uses locking, so we need to re-enable IRQ's during malloc/free and
 		// then atomically exchange the buffer
-		while (_next_slot >= _n_slots && max_retries-- > 0) {
+		while (_next_slot.load() >= _n_slots && max_retries-- > 0) {
 			Slot *previous_slots = nullptr;
 			Slot *new_slots = nullptr;
 
@@ -226,26 +307,55 @@ private:
 					return false;
 				}
 
-			} while (!_slots.compare_exchange(&previous_slots, new_slots));
+			} while (_slots.load() != previous_slots);
 
+			// fill the new array before publishing it to the readers
 			memcpy(new_slots, previous_slots, sizeof(Slot) * _n_slots);
 
 			for (int i = _n_slots; i < _n_slots + _n_grow; i++) {
 				new_slots[i] = {UINT16_MAX, param_value_u{}};
 			}
 
+			_writeBegin();
+			_slots.store(new_slots);
 			_n_slots += _n_grow;
+			_writeEnd();
+
+			// A lock-free reader might still be reading the previous array (or one retired by an
+			// earlier grow). Free them once no reader is in the lock-free path, readers entering
+			// it from now on only see the new array.
+			*(Slot **)previous_slots = _retired;
+			_retired = previous_slots;
+			Slot *unused = nullptr;
+
+			if (_lock_free_readers.load() == 0) {
+				unused = _retired;
+				_retired = nullptr;
+			}
 
 			transaction.unlock();
-			free(previous_slots);
+			_freeRetired(unused);
 			transaction.lock();
 		}
 
-		return _next_slot < _n_slots;
+		return _next_slot.load() < _n_slots;
+	}
+
+	// free a chain of arrays retired by _grow(), linked through their first slot
+	static void _freeRetired(Slot *retired)
+	{
+		while (retired) {
+			Slot *next = *(Slot **)retired;
+			free(retired);
+			retired = next;
+		}
 	}
 
-	int _next_slot = 0;
+	px4::atomic<uint32_t> _sequence{0};
+	px4::atomic<int> _next_slot{0};
 	int _n_slots = 0;
 	const int _n_grow;
 	px4::atomic<Slot *> _slots{nullptr};
+	Slot *_retired{nullptr}; ///< replaced arrays not freed yet, protected by the AtomicTransaction
+	mutable px4::atomic<int> _lock_free_readers{0};
 };
@@ -37,6 +37,7 @@
 #include <uORB/uORBManager.hpp>
 
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 class ParameterTest : public ::testing::Test
 {
@@ -79,6 +80,65 @@ TEST_F(ParameterTest, testParamReadWrite)
 }
 
 
+TEST_F(ParameterTest, testChangeGeneration)
+{
+	// GIVEN: two parameters and the current generation
+	param_t param = param_handle(px4::params::CP_DIST);
+	param_t other = param_handle(px4::params::CP_DELAY);
+	const uint32_t generation = param_generation();
+
+	// THEN: nothing changed yet
+	EXPECT_FALSE(param_changed_since(param, generation));
+
+	// WHEN: we set one parameter
+	float value = 12.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: only this parameter changed
+	EXPECT_TRUE(param_changed_since(param, generation));
+	EXPECT_FALSE(param_changed_since(other, generation));
+
+	// WHEN: we set the same value again
+	const uint32_t generation2 = param_generation();
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: it's not a change
+	EXPECT_EQ(generation2, param_generation());
+
+	// WHEN: we reset it
+	EXPECT_EQ(1, param_reset(param));
+
+	// THEN: that is a change
+	EXPECT_TRUE(param_changed_since(param, generation2));
+}
+
+TEST_F(ParameterTest, testValuesHash)
+{
+	// GIVEN: all parameters at their defaults
+	param_t param = param_handle(px4::params::CP_DIST);
+	const uint32_t default_hash = param_values_hash();
+
+	// WHEN: we only mark a parameter as used
+	param_find("CP_DELAY");
+
+	// THEN: the hash does not change, unlike param_hash_check()
+	EXPECT_EQ(default_hash, param_values_hash());
+
+	// WHEN: we set a value
+	float value = 7.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: the hash changes
+	EXPECT_NE(default_hash, param_values_hash());
+
+	// WHEN: we explicitly set the default value again
+	value = -1.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: it hashes like the default
+	EXPECT_EQ(default_hash, param_values_hash());
+}
+
 TEST_F(ParameterTest, testUorbSendReceive)
 {
 	// GIVEN: a uOrb message
@@ -106,3 +166,44 @@ TEST_F(ParameterTest, testUorbSendReceive)
 	// AND: all the bytes should be equal
 	EXPECT_EQ(0, memcmp(&message, &obstacle_distance, sizeof(message)));
 }
+
+
+TEST_F(ParameterTest, testSaveChangesJournal)
+{
+	// GIVEN: parameters saved to a file
+	static constexpr const char *file = "parameter_test.bson";
+	static constexpr const char *journal = "parameter_test.bson.jnl";
+	ASSERT_EQ(0, param_set_default_file(file));
+
+	param_t param = param_handle(px4::params::CP_DIST);
+	float value = 42.f;
+	EXPECT_EQ(0, param_set(param, &value));
+	EXPECT_EQ(0, param_save_default(true));
+
+	// WHEN: we change the parameter and save the changes
+	value = 43.f;
+	EXPECT_EQ(0, param_set(param, &value));
+	EXPECT_EQ(0, param_save_default_changes());
+
+	// THEN: only the journal is written
+	EXPECT_EQ(0, access(journal, F_OK));
+	EXPECT_FALSE(param_value_unsaved(param));
+
+	// WHEN: we load the parameters again
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+
+	// THEN: the journaled value is restored
+	float value2 = -1999.f;
+	EXPECT_EQ(0, param_get(param, &value2));
+	EXPECT_FLOAT_EQ(43.f, value2);
+
+	// WHEN: we save all parameters
+	EXPECT_EQ(0, param_save_default(true));
+
+	// THEN: the journal is compacted into the file
+	EXPECT_NE(0, access(journal, F_OK));
+
+	unlink(file);
+	param_set_default_file(nullptr);
+}
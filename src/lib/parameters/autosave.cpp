@@ -110,7 +110,8 @@ void ParamAutosave::Run()
 	}
 
 	PX4_DEBUG("Autosaving params");
-	int ret = param_save_default(false);
+	// only append the changes, this falls back to a full save when the journal needs compaction
+	int ret = param_save_default_changes();
 
 	if (ret != PX4_OK) {
 		// re-request to be saved in the future, try 3 times at most
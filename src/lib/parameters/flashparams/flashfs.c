@@ -125,6 +125,10 @@ const flash_file_token_t parameters_token = {
 	.n = {'p', 'a', 'r', 'm'},
 };
 
+const flash_file_token_t parameters_journal_token = {
+	.n = {'p', 'j', 'n', 'l'},
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -739,6 +743,153 @@ static sector_descriptor_t *check_free_space_in_sector(flash_entry_header_t
 	return sm;
 }
 
+/****************************************************************************
+ * Name: next_chain_entry
+ *
+ * Description:
+ *   Given a pointer to a flash entry header returns the entry directly
+ *   following it, if that is a valid entry with the given token
+ *
+ * Input Parameters:
+ *   pf     - A pointer to the current flash entry header
+ *   token  - The token of the chained entries
+ *
+ * Returned value:
+ *  A pointer to the next chained entry or NULL
+ *
+ ****************************************************************************/
+
+static flash_entry_header_t *next_chain_entry(flash_entry_header_t *pf, flash_file_token_t token)
+{
+	sector_descriptor_t *sm = get_sector_info(pf);
+
+	if (sm == 0) {
+		return NULL;
+	}
+
+	uint8_t *psector_end = (uint8_t *) sm->address + sm->size;
+	flash_entry_header_t *pn = next_entry(pf);
+
+	if ((uint8_t *)(pn + 1) > psector_end || !valid_magic((h_magic_t *) pn)) {
+		return NULL;
+	}
+
+	if (pn->size < sizeof(flash_entry_header_t) || (uint8_t *) pn + pn->size > psector_end) {
+		return NULL;
+	}
+
+	if (!valid_entry(pn) || pn->file_token.t != token.t
+	    || pn->crc != crc32(entry_crc_start(pn), entry_crc_length(pn))) {
+		return NULL;
+	}
+
+	return pn;
+}
+
+/****************************************************************************
+ * Name: find_chain_end
+ *
+ * Description:
+ *   Given a pointer to a flash entry header returns the last entry of
+ *   the chain of entries with the given token directly following it
+ *
+ * Input Parameters:
+ *   pf     - A pointer to the first flash entry header of the chain
+ *   token  - The token of the chained entries
+ *
+ * Returned value:
+ *  A pointer to the last entry of the chain, pf if there is none
+ *
+ ****************************************************************************/
+
+static flash_entry_header_t *find_chain_end(flash_entry_header_t *pf, flash_file_token_t token)
+{
+	flash_entry_header_t *pn;
+
+	while ((pn = next_chain_entry(pf, token)) != NULL) {
+		pf = pn;
+	}
+
+	return pf;
+}
+
+/****************************************************************************
+ * Name: erase_chain
+ *
+ * Description:
+ *   Erases the chained entries following the entry, then the entry itself
+ *
+ * Input Parameters:
+ *   pf     - A pointer to the first flash entry header of the chain
+ *   token  - The token of the chained entries
+ *
+ * Returned value:
+ *  >0 On Success or a negative errno
+ *
+ ****************************************************************************/
+
+static int erase_chain(flash_entry_header_t *pf, flash_file_token_t token)
+{
+	for (flash_entry_header_t *pc = next_chain_entry(pf, token); pc != NULL; pc = next_chain_entry(pc, token)) {
+		int rv = erase_entry(pc);
+
+		if (rv < 0) {
+			return rv;
+		}
+	}
+
+	return erase_entry(pf);
+}
+
+/****************************************************************************
+ * Name: commit_entry
+ *
+ * Description:
+ *   Fills in the header of an entry prepared with parameter_flashfs_alloc
+ *   and writes it to the flash
+ *
+ * Input Parameters:
+ *   pf          - Location in flash to write the entry to
+ *   token       - File Token of the entry
+ *   buffer      - The user data, allocated with parameter_flashfs_alloc
+ *   buf_size    - Number of bytes of user data
+ *   size_adjust - Number of padding bytes
+ *   total_size  - Size of the entry including header and padding
+ *
+ * Returned value:
+ *   On success the number of bytes written On Error a negative value of errno
+ *
+ ****************************************************************************/
+
+static int commit_entry(flash_entry_header_t *pf, flash_file_token_t token, uint8_t *buffer, size_t buf_size,
+			size_t size_adjust, size_t total_size)
+{
+	int rv;
+	flash_entry_header_t *pn = (flash_entry_header_t *)(buffer - sizeof(flash_entry_header_t));
+	pn->magic = MagicSig;
+	pn->file_token.t = token.t;
+	pn->flag = ValidEntry + size_adjust;
+	pn->size = total_size;
+
+	for (size_t a = 0; a < size_adjust; a++) {
+		buffer[buf_size + a] = (uint8_t)BlankSig;
+	}
+
+	pn->crc = crc32(entry_crc_start(pn), entry_crc_length(pn));
+#if defined(BOARD_USE_EXTERNAL_FLASH)
+	rv = up_progmem_ext_write((size_t) pf, pn, pn->size);
+#else
+	rv = up_progmem_write((size_t) pf, pn, pn->size);
+#endif
+	int system_bytes = (sizeof(flash_entry_header_t) + size_adjust);
+
+	if (rv >= system_bytes) {
+		rv -= system_bytes;
+	}
+
+	return rv;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -835,11 +986,21 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 
 		} else {
 
+			/* Entries appended behind the entry are replaced as well */
+
+			flash_entry_header_t *pl = find_chain_end(pf, parameters_journal_token);
+
 			/* Do we have space after the entry in the sector for the update */
 
-			sector_descriptor_t *current_sector = check_free_space_in_sector(pf,
+			sector_descriptor_t *current_sector = check_free_space_in_sector(pl,
 							      total_size);
 
+			/* A torn append behind the chain occupies the space */
+
+			if (current_sector == 0 && !blank_check(next_entry(pl), total_size)) {
+				current_sector = get_sector_info(pl);
+			}
+
 
 			if (current_sector == 0) {
 
@@ -849,7 +1010,7 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 				 * at start up
 				 */
 
-				rv = erase_entry(pf);
+				rv = erase_chain(pf, parameters_journal_token);
 
 				if (rv < 0) {
 					return rv;
@@ -857,7 +1018,7 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 
 				/* We had space and marked the last entry erased so use the  Next Free */
 
-				pf = next_entry(pf);
+				pf = next_entry(pl);
 
 			} else {
 
@@ -879,7 +1040,7 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 				 * at start up
 				 */
 
-				rv = erase_entry(pf);
+				rv = erase_chain(pf, parameters_journal_token);
 
 				if (rv < 0) {
 					return rv;
@@ -895,26 +1056,116 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 
 		}
 
-		flash_entry_header_t *pn = (flash_entry_header_t *)(buffer - sizeof(flash_entry_header_t));
-		pn->magic = MagicSig;
-		pn->file_token.t = token.t;
-		pn->flag = ValidEntry + size_adjust;
-		pn->size = total_size;
+		rv = commit_entry(pf, token, buffer, buf_size, size_adjust, total_size);
+	}
+
+	return rv;
+}
+
+/****************************************************************************
+ * Name: parameter_flashfs_append
+ *
+ * Description:
+ *   This function writes user data from the buffer allocated with a previous call
+ *   to parameter_flashfs_alloc as an additional entry directly behind the
+ *   entry of the base token and the entries appended to it before. Nothing
+ *   is erased, a subsequent parameter_flashfs_write of the base token
+ *   replaces the base entry together with all appended entries.
+ *
+ * Input Parameters:
+ *   base        - File Token of the entry to append to
+ *   token       - File Token of the appended entry
+ *   buffer      - A pointer to a buffer with buf_size bytes to be written
+ *                 to the flash. This buffer must be allocated
+ *                 with a previous call to parameter_flashfs_alloc
+ *   buf_size    - Number of bytes to write
+ *
+ * Returned value:
+ *   On success the number of bytes written On Error a negative value of errno,
+ *   -ENOENT if there is no base entry and -ENOSPC if the sector is full
+ *
+ ****************************************************************************/
+
+int
+parameter_flashfs_append(flash_file_token_t base, flash_file_token_t token, uint8_t *buffer, size_t buf_size)
+{
+	int rv = -ENXIO;
+
+	if (sector_map) {
+
+		/* Calculate the total space needed */
 
-		for (size_t a = 0; a < size_adjust; a++) {
-			buffer[buf_size + a] = (uint8_t)BlankSig;
+		size_t total_size = buf_size + sizeof(flash_entry_header_t);
+		size_t alignment = sizeof(h_magic_t) - 1;
+		size_t  size_adjust = ((total_size + alignment) & ~alignment) - total_size;
+		total_size += size_adjust;
+
+		flash_entry_header_t *pf = find_entry(base);
+
+		if (!pf) {
+			return -ENOENT;
 		}
 
-		pn->crc = crc32(entry_crc_start(pn), entry_crc_length(pn));
-#if defined(BOARD_USE_EXTERNAL_FLASH)
-		rv = up_progmem_ext_write((size_t) pf, pn, pn->size);
-#else
-		rv = up_progmem_write((size_t) pf, pn, pn->size);
-#endif
-		int system_bytes = (sizeof(flash_entry_header_t) + size_adjust);
+		/* Append behind the last entry of the chain, if there is space left in its sector */
+
+		pf = find_chain_end(pf, token);
+
+		if (check_free_space_in_sector(pf, total_size) != 0) {
+			return -ENOSPC;
+		}
+
+		pf = next_entry(pf);
 
-		if (rv >= system_bytes) {
-			rv -= system_bytes;
+		if (!blank_check(pf, total_size)) {
+			return -ENOSPC;
+		}
+
+		rv = commit_entry(pf, token, buffer, buf_size, size_adjust, total_size);
+	}
+
+	return rv;
+}
+
+/****************************************************************************
+ * Name: parameter_flashfs_read_chain
+ *
+ * Description:
+ *   This function returns a pointer to the locations of the data of an
+ *   entry appended to the entry of the base token with parameter_flashfs_append.
+ *
+ * Input Parameters:
+ *   base        - File Token of the entry that was appended to
+ *   token       - File Token of the appended entries
+ *   index       - Index of the appended entry, in the order they were written
+ *   buffer      - A pointer to a pointer that will receive the address
+ *                 in flash of the data of the entry
+ *   buf_size    - A pointer to receive the number of bytes in the entry
+ *
+ * Returned value:
+ *   On success number of bytes read or a negative errno value,
+ *   -ENOENT if there is no such entry
+ *
+ ****************************************************************************/
+
+int parameter_flashfs_read_chain(flash_file_token_t base, flash_file_token_t token, unsigned index, uint8_t **buffer,
+				 size_t *buf_size)
+{
+	int rv = -ENXIO;
+
+	if (sector_map) {
+
+		rv = -ENOENT;
+		flash_entry_header_t *pf = find_entry(base);
+
+		if (pf) {
+			for (pf = next_chain_entry(pf, token); pf != NULL; pf = next_chain_entry(pf, token)) {
+				if (index-- == 0) {
+					(*buffer) = entry_data(pf);
+					rv = entry_data_length(pf);
+					*buf_size = rv;
+					break;
+				}
+			}
 		}
 	}
 
@@ -87,6 +87,11 @@ typedef struct flash_file_token_t {
  */
 __EXPORT extern const flash_file_token_t parameters_token;
 
+/* Token of the entries holding incremental parameter changes
+ * that are appended behind the parameters_token entry
+ */
+__EXPORT extern const flash_file_token_t parameters_journal_token;
+
 /* Define the elements of the array passed to the
  * parameter_flashfs_init function
  *
@@ -177,6 +182,57 @@ __EXPORT int parameter_flashfs_read(flash_file_token_t ft, uint8_t **buffer, siz
 
 __EXPORT int parameter_flashfs_write(flash_file_token_t ft, uint8_t *buffer, size_t buf_size);
 
+/****************************************************************************
+ * Name: parameter_flashfs_append
+ *
+ * Description:
+ *   This function writes user data from the buffer allocated with a previous call
+ *   to parameter_flashfs_alloc as an additional entry directly behind the
+ *   entry of the base token and the entries appended to it before. Nothing
+ *   is erased, a subsequent parameter_flashfs_write of the base token
+ *   replaces the base entry together with all appended entries.
+ *
+ * Input Parameters:
+ *   base        - File Token of the entry to append to
+ *   token       - File Token of the appended entry
+ *   buffer      - A pointer to a buffer with buf_size bytes to be written
+ *                 to the flash. This buffer must be allocated
+ *                 with a previous call to parameter_flashfs_alloc
+ *   buf_size    - Number of bytes to write
+ *
+ * Returned value:
+ *   On success the number of bytes written On Error a negative value of errno,
+ *   -ENOENT if there is no base entry and -ENOSPC if the sector is full
+ *
+ ****************************************************************************/
+
+__EXPORT int parameter_flashfs_append(flash_file_token_t base, flash_file_token_t token, uint8_t *buffer,
+				      size_t buf_size);
+
+/****************************************************************************
+ * Name: parameter_flashfs_read_chain
+ *
+ * Description:
+ *   This function returns a pointer to the locations of the data of an
+ *   entry appended to the entry of the base token with parameter_flashfs_append.
+ *
+ * Input Parameters:
+ *   base        - File Token of the entry that was appended to
+ *   token       - File Token of the appended entries
+ *   index       - Index of the appended entry, in the order they were written
+ *   buffer      - A pointer to a pointer that will receive the address
+ *                 in flash of the data of the entry
+ *   buf_size    - A pointer to receive the number of bytes in the entry
+ *
+ * Returned value:
+ *   On success number of bytes read or a negative errno value,
+ *   -ENOENT if there is no such entry
+ *
+ ****************************************************************************/
+
+__EXPORT int parameter_flashfs_read_chain(flash_file_token_t base, flash_file_token_t token, unsigned index,
+		uint8_t **buffer, size_t *buf_size);
+
 /****************************************************************************
  * Name: parameter_flashfs_erase
  *
@@ -231,6 +231,18 @@ param_import_callback(bson_decoder_t decoder, bson_node_t node)
 		v = &f;
 		break;
 
+	case BSON_BOOL:
+		if (node->b) {
+			PX4_WARN("unexpected type for %s", node->name);
+
+		} else {
+			/* journal record of a parameter reset to its default */
+			param_reset_external(param, true);
+		}
+
+		result = 1;
+		goto out;
+
 	default:
 		PX4_ERR("%s unrecognised node type %d", node->name, node->type);
 		result = 1; // just skip this entry
@@ -250,15 +262,78 @@ out:
 }
 
 static int
-param_import_internal()
+param_journal_append(param_filter_func filter)
+{
+	bson_encoder_s encoder{};
+	int     result = -1;
+
+	bson_encoder_init_buf(&encoder, nullptr, 0);
+
+	for (param_t param = 0; param < user_config.PARAM_COUNT; param++) {
+
+		if (!filter(param)) {
+			continue;
+		}
+
+		/* a parameter back at its default is recorded as a reset */
+
+		if (!user_config.contains(param)) {
+			result = bson_encoder_append_bool(&encoder, param_name(param), false);
+
+		} else if (param_type(param) == PARAM_TYPE_INT32) {
+			result = bson_encoder_append_int32(&encoder, param_name(param), user_config.get(param).i);
+
+		} else {
+			result = bson_encoder_append_double(&encoder, param_name(param), (double)user_config.get(param).f);
+		}
+
+		if (result) {
+			debug("BSON append failed for '%s'", param_name(param));
+			break;
+		}
+	}
+
+	void *enc_buff = bson_encoder_buf_data(&encoder);
+
+	if (result == 0) {
+
+		/* Finalize the bison encoding*/
+
+		bson_encoder_fini(&encoder);
+
+		const size_t size = bson_encoder_buf_size(&encoder);
+		size_t buf_size = size;
+
+		/* Get a buffer from the flash driver with enough space */
+
+		uint8_t *buffer;
+		result = parameter_flashfs_alloc(parameters_journal_token, &buffer, &buf_size);
+
+		if (result == OK) {
+			if (buf_size >= size) {
+				memcpy(buffer, enc_buff, size);
+				result = parameter_flashfs_append(parameters_token, parameters_journal_token, buffer, size);
+				result = result == (int)size ? OK : result < 0 ? result : -EFBIG;
+
+			} else {
+				result = -EFBIG;
+			}
+
+			parameter_flashfs_free();
+		}
+	}
+
+	free(enc_buff);
+
+	return result;
+}
+
+static int
+param_decode(uint8_t *buffer, size_t buf_size)
 {
 	bson_decoder_s decoder{};
 	int result = -1;
 
-	uint8_t *buffer = 0;
-	size_t buf_size;
-	parameter_flashfs_read(parameters_token, &buffer, &buf_size);
-
 	if (bson_decoder_init_buf(&decoder, buffer, buf_size, param_import_callback)) {
 		debug("decoder init failed");
 		goto out;
@@ -278,11 +353,52 @@ out:
 	return result;
 }
 
+static int
+param_import_internal()
+{
+	uint8_t *buffer = 0;
+	size_t buf_size;
+	parameter_flashfs_read(parameters_token, &buffer, &buf_size);
+
+	return param_decode(buffer, buf_size);
+}
+
+static int
+param_import_journal_internal()
+{
+	uint8_t *buffer;
+	size_t buf_size;
+	int result = 0;
+
+	/* the entries are only readable if they passed their crc check */
+
+	for (unsigned index = 0; parameter_flashfs_read_chain(parameters_token, parameters_journal_token, index, &buffer,
+			&buf_size) >= 0; index++) {
+		result = param_decode(buffer, buf_size);
+
+		if (result < 0) {
+			break;
+		}
+	}
+
+	return result;
+}
+
 int flash_param_save(param_filter_func filter)
 {
 	return param_export_internal(filter);
 }
 
+int flash_param_save_changes(param_filter_func filter)
+{
+	return param_journal_append(filter);
+}
+
+int flash_param_import_journal()
+{
+	return param_import_journal_internal();
+}
+
 int flash_param_load()
 {
 	param_reset_all();
@@ -61,12 +61,17 @@ __BEGIN_DECLS
 __EXPORT extern DynamicSparseLayer user_config;
 __EXPORT int param_set_external(param_t param, const void *val, bool mark_saved, bool notify_changes);
 __EXPORT void param_get_external(param_t param, void *val);
+__EXPORT int param_reset_external(param_t param, bool notify_changes);
 
 /* The interface hooks to the Flash based storage. The caller is responsible for locking */
 __EXPORT int flash_param_save(param_filter_func filter);
 __EXPORT int flash_param_load();
 __EXPORT int flash_param_import();
 
+/* Append the parameters passing the filter to the journal behind the saved parameters */
+__EXPORT int flash_param_save_changes(param_filter_func filter);
+__EXPORT int flash_param_import_journal();
+
 __END_DECLS
 
 #endif /* _SYSTEMLIB_FLASHPARAMS_FLASHPARAMS_H */
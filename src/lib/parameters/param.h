@@ -189,6 +189,28 @@ __EXPORT bool		param_value_is_default(param_t param);
  */
 __EXPORT bool		param_value_unsaved(param_t param);
 
+/**
+ * Get the current parameter change generation.
+ *
+ * The generation is incremented for every change of a parameter value (including resets
+ * and changes of the default value). Use it with param_changed_since().
+ *
+ * @return		The current generation.
+ */
+__EXPORT uint32_t	param_generation(void);
+
+/**
+ * Test whether a parameter's value changed after a given generation.
+ *
+ * Only the most recent changes are tracked individually, if it can't be told anymore
+ * (many changes since the generation), this conservatively returns true.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @param generation	Generation returned by param_generation() when the value was read.
+ * @return		If true, the parameter's value might have changed.
+ */
+__EXPORT bool		param_changed_since(param_t param, uint32_t generation);
+
 /**
  * Obtain the type of a parameter.
  *
@@ -424,6 +446,29 @@ __EXPORT const char	*param_get_backup_file(void);
  */
 __EXPORT int 		param_save_default(bool blocking);
 
+/**
+ * Save the parameters changed since the last save to the default file.
+ *
+ * The changes are appended to a journal next to the default file (or behind the
+ * parameters in FLASH) instead of rewriting all parameters. A full save, which
+ * also compacts the journal, is done instead if the journal grew too large, too
+ * many parameters changed, or the journal cannot be trusted (e.g. after an import
+ * or a failed append).
+ *
+ * @return		Zero on success, -EWOULDBLOCK if the file is busy.
+ */
+__EXPORT int 		param_save_default_changes(void);
+
+/**
+ * Apply the changes journaled with param_save_default_changes() on top of
+ * the current parameters. Use after importing the default file.
+ *
+ * Replay stops at the first damaged record, the next save then does a full save.
+ *
+ * @return		Zero on success (including no journal), nonzero on failure.
+ */
+__EXPORT int 		param_import_journal(void);
+
 /**
  * Load parameters from the default parameter file.
  *
@@ -438,6 +483,16 @@ __EXPORT int 		param_load_default(void);
  */
 __EXPORT uint32_t	param_hash_check(void);
 
+/**
+ * Generate the hash of all parameter values that differ from their compiled-in default
+ *
+ * Unlike param_hash_check() this does not depend on which parameters are used,
+ * so it can be compared between processors running the same firmware.
+ *
+ * @return		CRC32 hash of the indices and values of all non-default parameters
+ */
+__EXPORT uint32_t	param_values_hash(void);
+
 /**
  * Print the status of the param system
  *
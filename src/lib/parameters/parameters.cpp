@@ -89,16 +89,29 @@ using namespace time_literals;
 inline static int flash_param_save(param_filter_func filter) { return -1; }
 inline static int flash_param_load() { return -1; }
 inline static int flash_param_import() { return -1; }
+inline static int flash_param_save_changes(param_filter_func filter) { return -1; }
+inline static int flash_param_import_journal() { return -1; }
 #endif
 
 static char *param_default_file = nullptr;
 static char *param_backup_file = nullptr;
+static char *param_journal_file = nullptr;
 
 #include "autosave.h"
 static ParamAutosave *autosave_instance {nullptr};
 
 static px4::AtomicBitset<param_info_count> params_active;  // params found
 static px4::AtomicBitset<param_info_count> params_unsaved;
+static px4::AtomicBitset<param_info_count> params_journal_pending; // changed since the last save
+static px4::AtomicBitset<param_info_count> params_journal_saving;  // being appended to the journal (file_mutex held)
+
+// the journal can't be appended to, the next save has to write all parameters
+static px4::atomic_bool param_journal_compaction_required{true};
+
+// Recent parameter changes, entry n holds (generation n << 16) | param of the n-th change
+static constexpr uint32_t PARAM_CHANGE_HISTORY_SIZE = 32; // power of 2
+static px4::atomic<uint32_t> param_change_generation{0};
+static px4::atomic<uint32_t> param_change_history[PARAM_CHANGE_HISTORY_SIZE] {};
 
 static ConstLayer firmware_defaults;
 static DynamicSparseLayer runtime_defaults{&firmware_defaults};
@@ -157,6 +170,11 @@ param_notify_changes()
 {
 // Don't send if this is a remote node. Only the primary
 // sends out update notices
+#if defined(CONFIG_PARAM_PRIMARY)
+	// make sure the remote has the new values before its modules are notified
+	param_primary_flush();
+#endif
+
 #if not defined(CONFIG_PARAM_REMOTE)
 	parameter_update_s pup {};
 	pup.instance = param_instance++;
@@ -179,10 +197,50 @@ param_notify_changes()
 #endif
 }
 
+#if defined(CONFIG_PARAM_FIND_HASH)
+/**
+ * FNV-1a with the seed mixed into the offset basis, must match param_hash() in px_generate_params.py
+ */
+static inline uint32_t param_hash(const char *name, uint32_t seed)
+{
+	uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+
+	for (const char *c = name; *c != '\0'; c++) {
+		h ^= static_cast<uint8_t>(*c);
+		h *= 16777619u;
+	}
+
+	h ^= h >> 16;
+	h *= 0x45d9f3bu;
+	h ^= h >> 16;
+	return h;
+}
+#endif // CONFIG_PARAM_FIND_HASH
+
 static param_t param_find_internal(const char *name, bool notification)
 {
 	perf_count(param_find_perf);
 
+#if defined(CONFIG_PARAM_FIND_HASH)
+	/* look up the only candidate in the generated perfect hash, then confirm the name */
+	static constexpr uint32_t num_buckets = sizeof(px4::parameters_hash_displacements) / sizeof(
+			px4::parameters_hash_displacements[0]);
+	static constexpr uint32_t num_slots = sizeof(px4::parameters_hash_slots) / sizeof(px4::parameters_hash_slots[0]);
+
+	const int32_t displacement = px4::parameters_hash_displacements[param_hash(name, 0) % num_buckets];
+	const uint32_t slot = (displacement < 0) ? static_cast<uint32_t>(-displacement - 1) :
+			      (param_hash(name, displacement) % num_slots);
+	const param_t param = px4::parameters_hash_slots[slot];
+
+	if (handle_in_range(param) && (strcmp(name, param_name(param)) == 0)) {
+		if (notification) {
+			param_set_used(param);
+		}
+
+		return param;
+	}
+
+#else
 	param_t middle;
 	param_t front = 0;
 	param_t last = param_info_count;
@@ -212,6 +270,8 @@ static param_t param_find_internal(const char *name, bool notification)
 		}
 	}
 
+#endif // CONFIG_PARAM_FIND_HASH
+
 	/* not found */
 	return PARAM_INVALID;
 }
@@ -283,6 +343,38 @@ param_value_unsaved(param_t param)
 	return handle_in_range(param) ? params_unsaved[param] : false;
 }
 
+// record a change of the value of param, call after storing the new value
+static void param_mark_changed(param_t param)
+{
+	const uint32_t generation = param_change_generation.fetch_add(1) + 1;
+	param_change_history[generation % PARAM_CHANGE_HISTORY_SIZE].store((generation << 16) | param);
+}
+
+uint32_t param_generation()
+{
+	return param_change_generation.load();
+}
+
+bool param_changed_since(param_t param, uint32_t generation)
+{
+	const uint32_t current = param_change_generation.load();
+
+	if (current - generation > PARAM_CHANGE_HISTORY_SIZE) {
+		return true; // history already overwritten
+	}
+
+	for (uint32_t g = generation + 1; g - generation <= current - generation; g++) {
+		const uint32_t entry = param_change_history[g % PARAM_CHANGE_HISTORY_SIZE].load();
+
+		// a mismatching generation is a change that is not recorded yet or already overwritten
+		if (((entry >> 16) != (g & UINT16_MAX)) || ((entry & UINT16_MAX) == param)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 int
 param_get(param_t param, void *val)
 {
@@ -441,12 +533,18 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 		params_unsaved.set(param, !mark_saved);
 		result = PX4_OK;
 
+		// exact comparison, modules only re-read values marked as changed
+		if (user_config_value.i != new_value.i) {
+			param_mark_changed(param);
+		}
+
 	} else {
 		PX4_ERR("param_set failed to store param %s", param_name(param));
 		result = PX4_ERROR;
 	}
 
 	if ((result == PX4_OK) && param_changed && !mark_saved) { // this is false when importing parameters
+		params_journal_pending.set(param, true);
 		param_autosave();
 	}
 
@@ -571,6 +669,7 @@ int param_set_default_value(param_t param, const void *val)
 		runtime_defaults.reset(param);
 
 		result = PX4_OK;
+		param_mark_changed(param);
 
 	} else {
 		param_value_u new_value{};
@@ -593,6 +692,7 @@ int param_set_default_value(param_t param, const void *val)
 		if (runtime_defaults.store(param, new_value)) {
 			user_config.refresh(param);
 			result = PX4_OK;
+			param_mark_changed(param);
 
 		} else {
 			result = PX4_ERROR;
@@ -621,7 +721,15 @@ static int param_reset_internal(param_t param, bool notify = true, bool autosave
 		user_config.reset(param);
 	}
 
+	if (param_found) {
+		param_mark_changed(param);
+	}
+
 	if (autosave) {
+		if (param_found) {
+			params_journal_pending.set(param, true);
+		}
+
 		param_autosave();
 	}
 
@@ -639,6 +747,13 @@ static int param_reset_internal(param_t param, bool notify = true, bool autosave
 int param_reset(param_t param) { return param_reset_internal(param, true); }
 int param_reset_no_notification(param_t param) { return param_reset_internal(param, false); }
 
+#if defined(FLASH_BASED_PARAMS)
+int param_reset_external(param_t param, bool notify_changes)
+{
+	return param_reset_internal(param, notify_changes, false);
+}
+#endif
+
 static void
 param_reset_all_internal(bool auto_save)
 {
@@ -651,6 +766,8 @@ param_reset_all_internal(bool auto_save)
 		param_reset_internal(param, false, false);
 	}
 
+	param_journal_compaction_required.store(true);
+
 	if (auto_save) {
 		param_autosave();
 	}
@@ -737,10 +854,26 @@ param_set_default_file(const char *filename)
 		param_default_file = nullptr;
 	}
 
+	if (param_journal_file != nullptr) {
+		free(param_journal_file);
+		param_journal_file = nullptr;
+	}
+
 	if (filename) {
 		param_default_file = strdup(filename);
+
+		// the journal of changes lives next to the default file
+		const size_t journal_file_len = strlen(filename) + sizeof(".jnl");
+		param_journal_file = (char *)malloc(journal_file_len);
+
+		if (param_journal_file) {
+			snprintf(param_journal_file, journal_file_len, "%s.jnl", filename);
+		}
 	}
 
+	// whatever is in the new file does not match the current parameters
+	param_journal_compaction_required.store(true);
+
 #endif /* FLASH_BASED_PARAMS */
 
 	return 0;
@@ -782,31 +915,22 @@ const char *param_get_backup_file()
 static int param_export_internal(int fd, param_filter_func filter);
 static int param_verify(int fd);
 
-int param_save_default(bool blocking)
+// save all parameters and compact the journal, caller is responsible for locking
+static int param_save_default_internal()
 {
-	PX4_DEBUG("param_save_default");
-
-	// take the file lock
-	if (blocking) {
-		pthread_mutex_lock(&file_mutex);
-
-	} else {
-		if (pthread_mutex_trylock(&file_mutex) != 0) {
-			PX4_DEBUG("param_save_default: file lock failed (already locked)");
-			return -EWOULDBLOCK;
-		}
-	}
-
-	int shutdown_lock_ret = px4_shutdown_lock();
-
-	if (shutdown_lock_ret != 0) {
-		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
-	}
-
 	int res = PX4_ERROR;
 	const char *filename = param_get_default_file();
 
+	// everything changed so far goes into this save
+	params_journal_pending.reset();
+	param_journal_compaction_required.store(true);
+
 	if (filename) {
+		// drop the journal first, it must never be replayed on top of a newer file
+		if (param_journal_file && (::unlink(param_journal_file) != 0) && (errno != ENOENT)) {
+			PX4_ERR("removing %s failed (%i)", param_journal_file, errno);
+		}
+
 		static constexpr int MAX_ATTEMPTS = 3;
 
 		for (int attempt = 1; attempt <= MAX_ATTEMPTS; attempt++) {
@@ -847,6 +971,7 @@ int param_save_default(bool blocking)
 
 	} else {
 		params_unsaved.reset();
+		param_journal_compaction_required.store(false);
 
 		// backup file
 		if (param_backup_file) {
@@ -869,6 +994,227 @@ int param_save_default(bool blocking)
 		}
 	}
 
+	return res;
+}
+
+int param_save_default(bool blocking)
+{
+	PX4_DEBUG("param_save_default");
+
+	// take the file lock
+	if (blocking) {
+		pthread_mutex_lock(&file_mutex);
+
+	} else {
+		if (pthread_mutex_trylock(&file_mutex) != 0) {
+			PX4_DEBUG("param_save_default: file lock failed (already locked)");
+			return -EWOULDBLOCK;
+		}
+	}
+
+	int shutdown_lock_ret = px4_shutdown_lock();
+
+	if (shutdown_lock_ret != 0) {
+		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
+	}
+
+	int res = param_save_default_internal();
+
+	pthread_mutex_unlock(&file_mutex);
+
+	if (shutdown_lock_ret == 0) {
+		px4_shutdown_unlock();
+	}
+
+	return res;
+}
+
+/**
+ * Journal of parameter changes.
+ *
+ * Each save of the changed parameters appends one record to the journal file next to the
+ * default file: a header followed by a BSON document with the new values of the changed
+ * parameters, where a parameter reset to its default is stored as BSON bool false. The
+ * records are replayed in order on top of the default file on import. A full save
+ * (compaction) removes the journal.
+ */
+static constexpr uint32_t PARAM_JOURNAL_MAGIC = 0x4c4e4a50; // "PJNL"
+static constexpr size_t PARAM_JOURNAL_MAX_SIZE = 4096;      // compact once the journal would grow beyond this
+static constexpr size_t PARAM_JOURNAL_MAX_CHANGES = 64;     // save larger batches of changes as a full save
+
+struct param_journal_header_s {
+	uint32_t magic;
+	uint32_t length; // of the BSON document following the header
+	uint32_t crc;    // crc32 of the BSON document
+};
+
+static bool param_journal_saving_filter(param_t param)
+{
+	return params_journal_saving[param];
+}
+
+// append the parameters in params_journal_saving to the journal file, caller is responsible for locking
+static int param_journal_append()
+{
+	if (!param_journal_file) {
+		return PX4_ERROR;
+	}
+
+	bson_encoder_s encoder{};
+
+	if (bson_encoder_init_buf(&encoder, nullptr, 0) != 0) {
+		return PX4_ERROR;
+	}
+
+	int result = PX4_OK;
+
+	for (param_t param = 0; handle_in_range(param) && (result == PX4_OK); param++) {
+		if (!params_journal_saving[param]) {
+			continue;
+		}
+
+		const char *name = param_name(param);
+
+		if (!user_config.contains(param)) {
+			result = bson_encoder_append_bool(&encoder, name, false);
+
+		} else if (param_type(param) == PARAM_TYPE_INT32) {
+			result = bson_encoder_append_int32(&encoder, name, user_config.get(param).i);
+
+		} else if (param_type(param) == PARAM_TYPE_FLOAT) {
+			result = bson_encoder_append_double(&encoder, name, (double)user_config.get(param).f);
+		}
+
+		if (result != PX4_OK) {
+			PX4_ERR("BSON append failed for '%s'", name);
+		}
+	}
+
+	if ((result == PX4_OK) && (bson_encoder_fini(&encoder) != PX4_OK)) {
+		PX4_ERR("BSON encoder finalize failed");
+		result = PX4_ERROR;
+	}
+
+	uint8_t *data = (uint8_t *)bson_encoder_buf_data(&encoder);
+	const size_t size = bson_encoder_buf_size(&encoder);
+
+	if ((result != PX4_OK) || (data == nullptr)) {
+		free(data);
+		return PX4_ERROR;
+	}
+
+	const param_journal_header_s header{PARAM_JOURNAL_MAGIC, (uint32_t)size, crc32(data, size)};
+
+	int fd = ::open(param_journal_file, O_RDWR | O_CREAT | O_APPEND, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' failed (%i)", param_journal_file, errno);
+		free(data);
+		return PX4_ERROR;
+	}
+
+	const off_t offset = ::lseek(fd, 0, SEEK_END);
+
+	if ((offset < 0) || (offset + sizeof(header) + size > PARAM_JOURNAL_MAX_SIZE)) {
+		// journal full, compact
+		result = -EFBIG;
+
+	} else if ((::write(fd, &header, sizeof(header)) != sizeof(header))
+		   || (::write(fd, data, size) != (ssize_t)size)
+		   || (::fsync(fd) != 0)) {
+		PX4_ERR("journal write to '%s' failed (%i)", param_journal_file, errno);
+		result = PX4_ERROR;
+
+	} else {
+		// read the record back to verify it
+		param_journal_header_s header_verify{};
+		uint8_t *data_verify = (uint8_t *)malloc(size);
+
+		if ((data_verify == nullptr)
+		    || (::lseek(fd, offset, SEEK_SET) != offset)
+		    || (::read(fd, &header_verify, sizeof(header_verify)) != sizeof(header_verify))
+		    || (::read(fd, data_verify, size) != (ssize_t)size)
+		    || (memcmp(&header, &header_verify, sizeof(header)) != 0)
+		    || (memcmp(data, data_verify, size) != 0)) {
+			PX4_ERR("journal verify of '%s' failed", param_journal_file);
+			result = PX4_ERROR;
+		}
+
+		free(data_verify);
+	}
+
+	::close(fd);
+	free(data);
+
+	return result;
+}
+
+int param_save_default_changes()
+{
+	PX4_DEBUG("param_save_default_changes");
+
+	if (pthread_mutex_trylock(&file_mutex) != 0) {
+		PX4_DEBUG("param_save_default_changes: file lock failed (already locked)");
+		return -EWOULDBLOCK;
+	}
+
+	int shutdown_lock_ret = px4_shutdown_lock();
+
+	if (shutdown_lock_ret != 0) {
+		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
+	}
+
+	int res = PX4_ERROR;
+
+	if (!param_journal_compaction_required.load() && (params_journal_pending.count() <= PARAM_JOURNAL_MAX_CHANGES)) {
+		params_journal_saving.reset();
+		bool changed = false;
+
+		for (param_t param = 0; handle_in_range(param); param++) {
+			if (params_journal_pending[param]) {
+				params_journal_pending.set(param, false);
+				params_journal_saving.set(param, true);
+				changed = true;
+			}
+		}
+
+		if (changed) {
+			perf_begin(param_export_perf);
+
+			if (param_get_default_file()) {
+				res = param_journal_append();
+
+			} else {
+				res = flash_param_save_changes(param_journal_saving_filter);
+			}
+
+			perf_end(param_export_perf);
+
+		} else {
+			res = PX4_OK;
+		}
+
+		for (param_t param = 0; handle_in_range(param); param++) {
+			if (params_journal_saving[param]) {
+				if (res == PX4_OK) {
+					params_unsaved.set(param, false);
+
+				} else {
+					params_journal_pending.set(param, true);
+				}
+			}
+		}
+
+		if (res != PX4_OK) {
+			// a failed append may have left a partial record, don't append behind it
+			param_journal_compaction_required.store(true);
+		}
+	}
+
+	if (res != PX4_OK) {
+		res = param_save_default_internal();
+	}
+
 	pthread_mutex_unlock(&file_mutex);
 
 	if (shutdown_lock_ret == 0) {
@@ -888,7 +1234,13 @@ param_load_default()
 	const char *filename = param_get_default_file();
 
 	if (!filename) {
-		return flash_param_load();
+		int result = flash_param_load();
+
+		if (result == 0) {
+			param_import_journal();
+		}
+
+		return result;
 	}
 
 	int fd_load = ::open(filename, O_RDONLY);
@@ -911,6 +1263,8 @@ param_load_default()
 		return -2;
 	}
 
+	param_import_journal();
+
 	return res;
 }
 
@@ -989,8 +1343,9 @@ static int param_verify(int fd)
 	}
 
 	bson_decoder_s decoder{};
+	uint8_t bson_buffer[256];
 
-	if (bson_decoder_init_file(&decoder, fd, param_verify_callback) == 0) {
+	if (bson_decoder_init_buf_file(&decoder, fd, &bson_buffer, sizeof(bson_buffer), param_verify_callback) == 0) {
 		int result = -1;
 
 		do {
@@ -1201,6 +1556,18 @@ param_import_callback(bson_decoder_t decoder, bson_node_t node)
 		}
 		break;
 
+	case BSON_BOOL: {
+			// journal record of a parameter reset to its default
+			if (!node->b) {
+				param_reset_internal(param, true, false);
+				PX4_DEBUG("Imported %s reset", param_name(param));
+
+			} else {
+				PX4_WARN("unexpected type for %s", node->name);
+			}
+		}
+		break;
+
 	default:
 		PX4_ERR("import: unrecognised node type for '%s'", node->name);
 	}
@@ -1216,8 +1583,9 @@ param_import_internal(int fd)
 
 	for (int attempt = 1; attempt <= MAX_ATTEMPTS; attempt++) {
 		bson_decoder_s decoder{};
+		uint8_t bson_buffer[256];
 
-		if (bson_decoder_init_file(&decoder, fd, param_import_callback) == 0) {
+		if (bson_decoder_init_buf_file(&decoder, fd, &bson_buffer, sizeof(bson_buffer), param_import_callback) == 0) {
 			int result = -1;
 
 			do {
@@ -1268,6 +1636,9 @@ param_import_internal(int fd)
 int
 param_import(int fd)
 {
+	// the imported values are not in the default file yet
+	param_journal_compaction_required.store(true);
+
 	if (fd < 0) {
 		return flash_param_import();
 	}
@@ -1278,6 +1649,8 @@ param_import(int fd)
 int
 param_load(int fd)
 {
+	param_journal_compaction_required.store(true);
+
 	if (fd < 0) {
 		return flash_param_load();
 	}
@@ -1286,6 +1659,89 @@ param_load(int fd)
 	return param_import_internal(fd);
 }
 
+int
+param_import_journal()
+{
+	if (!param_get_default_file()) {
+		return flash_param_import_journal();
+	}
+
+	if (!param_journal_file) {
+		return 0;
+	}
+
+	int fd = ::open(param_journal_file, O_RDONLY);
+
+	if (fd < 0) {
+		// no journal is OK, otherwise this is an error
+		if (errno != ENOENT) {
+			PX4_ERR("open '%s' for reading failed (%i)", param_journal_file, errno);
+			return -1;
+		}
+
+		return 0;
+	}
+
+	unsigned records = 0;
+	bool damaged = false;
+
+	for (;;) {
+		param_journal_header_s header{};
+		const ssize_t header_read = ::read(fd, &header, sizeof(header));
+
+		if (header_read == 0) {
+			break; // end of journal
+		}
+
+		// a record torn by a power loss during the append ends the journal
+		if ((header_read != sizeof(header)) || (header.magic != PARAM_JOURNAL_MAGIC)
+		    || (header.length > PARAM_JOURNAL_MAX_SIZE)) {
+			damaged = true;
+			break;
+		}
+
+		uint8_t *data = (uint8_t *)malloc(header.length);
+
+		if ((data == nullptr) || (::read(fd, data, header.length) != (ssize_t)header.length)
+		    || (crc32(data, header.length) != header.crc)) {
+			free(data);
+			damaged = true;
+			break;
+		}
+
+		bson_decoder_s decoder{};
+		int result = -1;
+
+		if (bson_decoder_init_buf(&decoder, data, header.length, param_import_callback) == 0) {
+			do {
+				result = bson_decoder_next(&decoder);
+
+			} while (result > 0);
+		}
+
+		free(data);
+
+		if (result != 0) {
+			damaged = true;
+			break;
+		}
+
+		records++;
+	}
+
+	::close(fd);
+
+	if (damaged) {
+		PX4_WARN("%s damaged after %u records, ignoring the rest", param_journal_file, records);
+		param_journal_compaction_required.store(true);
+
+	} else if (records > 0) {
+		PX4_INFO("applied %u records from %s", records, param_journal_file);
+	}
+
+	return 0;
+}
+
 void
 param_foreach(void (*func)(void *arg, param_t param), void *arg, bool only_changed, bool only_used)
 {
@@ -1326,6 +1782,24 @@ uint32_t param_hash_check()
 	return param_hash;
 }
 
+uint32_t param_values_hash()
+{
+	uint32_t hash = 0;
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		const param_value_u value = user_config.get(param);
+
+		if (value.i == firmware_defaults.get(param).i) {
+			continue;
+		}
+
+		hash = crc32part((const uint8_t *)&param, sizeof(param), hash);
+		hash = crc32part((const uint8_t *)&value.i, sizeof(value.i), hash);
+	}
+
+	return hash;
+}
+
 void param_print_status()
 {
 	PX4_INFO("summary: %d/%d (used/total)", param_count_used(), param_count());
@@ -1341,6 +1815,11 @@ void param_print_status()
 		PX4_INFO("backup file: %s", param_backup_file);
 	}
 
+	if (param_journal_file) {
+		PX4_INFO("journal: %s%s", param_journal_file,
+			 param_journal_compaction_required.load() ? " (full save pending)" : "");
+	}
+
 #endif /* FLASH_BASED_PARAMS */
 
 	PX4_INFO("storage array: %d/%d elements (%zu bytes total)",
@@ -1370,8 +1849,10 @@ void param_print_status()
 	param_primary_get_counters(&counts);
 	PX4_INFO("set value requests received: %" PRIu32 ", set value responses sent: %" PRIu32,
 		 counts.set_value_request_received, counts.set_value_response_sent);
-	PX4_INFO("set value requests sent: %" PRIu32 ", set value responses received: %" PRIu32,
-		 counts.set_value_request_sent, counts.set_value_response_received);
+	PX4_INFO("sync requests received: %" PRIu32 ", full syncs: %" PRIu32 ", values queued: %" PRIu32,
+		 counts.sync_request_received, counts.full_sync_count, counts.set_value_queued);
+	PX4_INFO("batches sent: %" PRIu32 ", batches acknowledged: %" PRIu32,
+		 counts.batch_sent, counts.batch_ack_received);
 	PX4_INFO("resets sent: %" PRIu32 ", set used requests received: %" PRIu32,
 		 counts.reset_sent, counts.set_used_received);
 #endif
@@ -1379,8 +1860,8 @@ void param_print_status()
 #if defined(CONFIG_PARAM_REMOTE)
 	struct param_remote_counters counts;
 	param_remote_get_counters(&counts);
-	PX4_INFO("set value requests received: %" PRIu32 ", set value responses sent: %" PRIu32,
-		 counts.set_value_request_received, counts.set_value_response_sent);
+	PX4_INFO("sync requests sent: %" PRIu32 ", batches received: %" PRIu32 ", values received: %" PRIu32,
+		 counts.sync_request_sent, counts.batch_received, counts.values_received);
 	PX4_INFO("set value requests sent: %" PRIu32 ", set value responses received: %" PRIu32,
 		 counts.set_value_request_sent, counts.set_value_response_received);
 	PX4_INFO("resets received: %" PRIu32 ", set used requests sent: %" PRIu32,
@@ -35,6 +35,13 @@
 
 #include "uORB/uORBManager.hpp"
 
+#include <inttypes.h>
+#include <pthread.h>
+
+#include <parameters/px4_parameters.hpp>
+
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/atomic_bitset.h>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/tasks.h>
 
@@ -43,6 +50,8 @@
 #include <uORB/topics/parameter_set_used_request.h>
 #include <uORB/topics/parameter_set_value_request.h>
 #include <uORB/topics/parameter_set_value_response.h>
+#include <uORB/topics/parameter_sync_request.h>
+#include <uORB/topics/parameter_value_batch.h>
 
 // Debug flag
 static bool debug = false;
@@ -51,14 +60,205 @@ static struct param_primary_counters param_primary_counters;
 
 #define TIMEOUT_WAIT 1000
 #define TIMEOUT_COUNT 50
+#define BATCH_RETRIES 3
+#define DELTA_INTERVAL_MS 100
+
+static constexpr uint16_t param_info_count = sizeof(px4::parameters) / sizeof(param_info_s);
 
 static px4_task_t sync_thread_tid;
 static const char *sync_thread_name = "param_primary_sync";
 
-static orb_advert_t param_set_value_req_h = nullptr;
-static orb_advert_t param_reset_req_h     = nullptr;
+static orb_advert_t param_value_batch_h = nullptr;
+static orb_advert_t param_reset_req_h   = nullptr;
+
+static int param_batch_ack_fd = PX4_ERROR;
+
+// Values are not pushed to the remote when they are set. Instead they are
+// marked dirty and sent in batches, either when parameter changes are
+// notified or periodically by the sync thread. Nothing is sent before the
+// remote requested a full sync, as that transfers all values anyway.
+static px4::AtomicBitset<param_info_count> params_dirty;
+static px4::atomic<uint32_t> sync_session{0}; ///< 0 until the remote requested a sync
+static uint16_t batch_sequence;
+
+static pthread_mutex_t batch_mutex = PTHREAD_MUTEX_INITIALIZER; ///< serializes batch transfers
+
+static bool wait_for_batch_ack(const parameter_value_batch_s &batch)
+{
+	bool updated = false;
+
+	px4_usleep(TIMEOUT_WAIT);
+	int count = TIMEOUT_COUNT;
+
+	while (--count) {
+		(void) orb_check(param_batch_ack_fd, &updated);
+
+		struct parameter_set_value_response_s rsp;
+
+		while (updated) {
+			orb_copy(ORB_ID(parameter_remote_set_value_response), param_batch_ack_fd, &rsp);
+
+			if ((rsp.request_timestamp == batch.timestamp) && (rsp.parameter_index == batch.sequence)) {
+				return true;
+			}
+
+			(void) orb_check(param_batch_ack_fd, &updated);
+		}
+
+		px4_usleep(TIMEOUT_WAIT);
+	}
+
+	return false;
+}
+
+// Must be called with batch_mutex held
+static bool send_batch_locked(parameter_value_batch_s &batch)
+{
+	if (param_batch_ack_fd == PX4_ERROR) {
+		param_batch_ack_fd = orb_subscribe(ORB_ID(parameter_remote_set_value_response));
+
+		if (param_batch_ack_fd == PX4_ERROR) {
+			PX4_ERR("Subscription to parameter_remote_set_value_response failed");
+			return false;
+		}
+	}
+
+	batch.session = sync_session.load();
+	batch.sequence = batch_sequence++;
+
+	for (int attempt = 0; attempt < BATCH_RETRIES; attempt++) {
+		batch.timestamp = hrt_absolute_time();
+
+		if (debug) {
+			PX4_INFO("Sending parameter batch %u with %u values", batch.sequence, batch.count);
+		}
+
+		if (param_value_batch_h == nullptr) {
+			param_value_batch_h = orb_advertise(ORB_ID(parameter_value_batch), &batch);
+
+		} else {
+			orb_publish(ORB_ID(parameter_value_batch), param_value_batch_h, &batch);
+		}
+
+		param_primary_counters.batch_sent++;
+
+		if (wait_for_batch_ack(batch)) {
+			param_primary_counters.batch_ack_received++;
+			return true;
+		}
+	}
+
+	PX4_ERR("Timeout waiting for the remote to acknowledge parameter batch %u", batch.sequence);
+	return false;
+}
+
+// Appends the current value of param to the batch and sends the batch once it is full
+static bool add_to_batch_locked(parameter_value_batch_s &batch, param_t param)
+{
+	int32_t value = 0;
+
+	if (param_get(param, &value) != PX4_OK) {
+		return true;
+	}
+
+	batch.parameter_index[batch.count] = param;
+	batch.value[batch.count] = value;
+	batch.count++;
+
+	if (batch.count == parameter_value_batch_s::BATCH_SIZE) {
+		const bool sent = send_batch_locked(batch);
+		batch.count = 0;
+		return sent;
+	}
+
+	return true;
+}
+
+static bool value_is_system_default(param_t param)
+{
+	int32_t value = 0;
+	int32_t system_default = 0;
+
+	if ((param_get(param, &value) != PX4_OK) || (param_get_system_default_value(param, &system_default) != PX4_OK)) {
+		return true;
+	}
+
+	return value == system_default;
+}
 
-static int param_set_rsp_fd = PX4_ERROR;
+static void param_primary_full_sync(const parameter_sync_request_s &req)
+{
+	pthread_mutex_lock(&batch_mutex);
+
+	sync_session.store(req.session);
+	batch_sequence = 0;
+	param_primary_counters.full_sync_count++;
+
+	const hrt_abstime start = hrt_absolute_time();
+	parameter_value_batch_s batch{};
+	bool success = true;
+	unsigned values = 0;
+
+	if (param_values_hash() == req.values_hash) {
+		params_dirty.reset();
+		batch.flags = parameter_value_batch_s::FLAG_IN_SYNC | parameter_value_batch_s::FLAG_LAST;
+
+	} else {
+		batch.flags = parameter_value_batch_s::FLAG_FULL_SYNC;
+
+		for (param_t param = 0; (param < param_info_count) && success; param++) {
+			// clear before reading the value, a concurrent change marks it dirty again
+			params_dirty.set(param, false);
+
+			if (!value_is_system_default(param)) {
+				success = add_to_batch_locked(batch, param);
+				values++;
+			}
+		}
+
+		batch.flags |= parameter_value_batch_s::FLAG_LAST;
+	}
+
+	if (success) {
+		batch.values_hash = param_values_hash();
+		success = send_batch_locked(batch);
+	}
+
+	if (success) {
+		PX4_INFO("Parameter sync with remote: %u values in %u batches, %.1f ms", values, batch_sequence,
+			 (double)(hrt_elapsed_time(&start) * 1e-3));
+
+	} else {
+		// the remote requests a new sync if it does not receive the last batch
+		sync_session.store(0);
+	}
+
+	pthread_mutex_unlock(&batch_mutex);
+}
+
+// Must be called with batch_mutex held
+static void param_primary_send_deltas_locked()
+{
+	if ((sync_session.load() == 0) || (params_dirty.count() == 0)) {
+		return;
+	}
+
+	parameter_value_batch_s batch{};
+
+	for (param_t param = 0; param < param_info_count; param++) {
+		if (params_dirty[param]) {
+			params_dirty.set(param, false);
+
+			if (!add_to_batch_locked(batch, param)) {
+				return;
+			}
+		}
+	}
+
+	if (batch.count > 0) {
+		send_batch_locked(batch);
+	}
+}
 
 static int primary_sync_thread(int argc, char *argv[])
 {
@@ -73,19 +273,22 @@ static int primary_sync_thread(int argc, char *argv[])
 
 	int _set_used_req_fd  = orb_subscribe(ORB_ID(parameter_set_used_request));
 	int _set_value_req_fd = orb_subscribe(ORB_ID(parameter_primary_set_value_request));
+	int _sync_req_fd      = orb_subscribe(ORB_ID(parameter_sync_request));
 
 	struct parameter_set_used_request_s   _set_used_request;
 	struct parameter_set_value_request_s  _set_value_request;
 	struct parameter_set_value_response_s _set_value_response;
+	struct parameter_sync_request_s       _sync_request;
 
-	px4_pollfd_struct_t fds[2] = { { .fd = _set_used_req_fd,  .events = POLLIN },
-		{ .fd = _set_value_req_fd, .events = POLLIN }
+	px4_pollfd_struct_t fds[3] = { { .fd = _set_used_req_fd,  .events = POLLIN },
+		{ .fd = _set_value_req_fd, .events = POLLIN },
+		{ .fd = _sync_req_fd, .events = POLLIN }
 	};
 
 	PX4_INFO("Starting parameter primary sync thread");
 
 	while (true) {
-		px4_poll(fds, 2, 1000);
+		px4_poll(fds, 3, DELTA_INTERVAL_MS);
 
 		if (fds[0].revents & POLLIN) {
 			bool updated = true;
@@ -150,6 +353,26 @@ static int primary_sync_thread(int argc, char *argv[])
 				(void) orb_check(_set_value_req_fd, &updated);
 			}
 		}
+
+		if (fds[2].revents & POLLIN) {
+			bool updated = true;
+
+			// only the most recent request matters
+			while (updated) {
+				orb_copy(ORB_ID(parameter_sync_request), _sync_req_fd, &_sync_request);
+				param_primary_counters.sync_request_received++;
+				(void) orb_check(_sync_req_fd, &updated);
+			}
+
+			if (debug) {
+				PX4_INFO("Got parameter_sync_request, session %" PRIu32, _sync_request.session);
+			}
+
+			param_primary_full_sync(_sync_request);
+		}
+
+		// pick up values that were set without notification
+		param_primary_flush();
 	}
 
 	return 0;
@@ -167,105 +390,22 @@ void param_primary_init()
 
 }
 
-// void param_primary_set_value(param_t param, const void *val, bool from_file)
 void param_primary_set_value(param_t param, const void *val)
 {
-	bool send_request = true;
-	struct parameter_set_value_request_s req;
-	req.timestamp = hrt_absolute_time();
-	req.parameter_index = param;
-
-	switch (param_type(param)) {
-	case PARAM_TYPE_INT32:
-		req.int_value = *(int32_t *)val;
-
-		if (debug) {
-			PX4_INFO("*** Setting %s to %d ***", param_name(req.parameter_index), req.int_value);
-		}
-
-		break;
-
-	case PARAM_TYPE_FLOAT:
-		req.float_value = *(float *)val;
-
-		if (debug) {
-			PX4_INFO("*** Setting %s to %f ***", param_name(req.parameter_index), (double) req.float_value);
-		}
-
-		break;
-
-	default:
-		PX4_ERR("Parameter must be either int or float");
-		send_request = false;
-		break;
-	}
-
-	if (param_set_rsp_fd == PX4_ERROR) {
-		if (debug) {
-			PX4_INFO("Subscribing to parameter_client_set_value_response");
-		}
-
-		param_set_rsp_fd = orb_subscribe(ORB_ID(parameter_remote_set_value_response));
-
-		if (param_set_rsp_fd == PX4_ERROR) {
-			PX4_ERR("Subscription to parameter_remote_set_value_response failed");
+	// the value is read when the batch is sent, so repeated changes coalesce
+	params_dirty.set(param, true);
+	param_primary_counters.set_value_queued++;
+}
 
-		} else {
-			if (debug) {
-				PX4_INFO("Subscription to parameter_client_set_value_response succeeded");
-			}
-		}
+void param_primary_flush()
+{
+	if ((sync_session.load() == 0) || (params_dirty.count() == 0)) {
+		return;
 	}
 
-	if (send_request) {
-		if (debug) {
-			PX4_INFO("Sending param set request to remote for %s", param_name(req.parameter_index));
-		}
-
-		if (param_set_value_req_h == nullptr) {
-			param_set_value_req_h = orb_advertise(ORB_ID(parameter_remote_set_value_request), nullptr);
-		}
-
-		orb_publish(ORB_ID(parameter_remote_set_value_request), param_set_value_req_h, &req);
-
-		param_primary_counters.set_value_request_sent++;
-
-		// Wait for response
-		bool updated = false;
-
-		if (debug) {
-			PX4_INFO("Waiting for parameter_client_set_value_response for %s", param_name(req.parameter_index));
-		}
-
-		px4_usleep(TIMEOUT_WAIT);
-		int count = TIMEOUT_COUNT;
-
-		while (--count) {
-			(void) orb_check(param_set_rsp_fd, &updated);
-
-			struct parameter_set_value_response_s rsp;
-
-			while (updated) {
-
-				orb_copy(ORB_ID(parameter_remote_set_value_response), param_set_rsp_fd, &rsp);
-
-				if ((rsp.request_timestamp == req.timestamp) && (rsp.parameter_index == req.parameter_index)) {
-					if (debug) {
-						PX4_INFO("Got parameter_remote_set_value_response for %s", param_name(req.parameter_index));
-					}
-
-					param_primary_counters.set_value_response_received++;
-					return;
-				}
-
-				(void) orb_check(param_set_rsp_fd, &updated);
-			}
-
-			px4_usleep(TIMEOUT_WAIT);
-		}
-
-		PX4_ERR("Timeout waiting for parameter_client_set_value_response for %s", param_name(req.parameter_index));
-	}
+	pthread_mutex_lock(&batch_mutex);
+	param_primary_send_deltas_locked();
+	pthread_mutex_unlock(&batch_mutex);
 }
 
 static void param_primary_reset_internal(param_t param, bool reset_all)
@@ -39,13 +39,22 @@ struct param_primary_counters {
 	uint32_t set_value_request_received;
 	uint32_t set_value_response_sent;
 	uint32_t reset_sent;
-	uint32_t set_value_request_sent;
-	uint32_t set_value_response_received;
+	uint32_t set_value_queued;
 	uint32_t set_used_received;
+	uint32_t sync_request_received;
+	uint32_t full_sync_count;
+	uint32_t batch_sent;
+	uint32_t batch_ack_received;
 };
 
 void param_primary_init();
 void param_primary_set_value(param_t param, const void *val);
+
+/**
+ * Send all values changed since the last batch to the remote and wait until
+ * they are acknowledged. No-op until the remote has requested a sync.
+ */
+void param_primary_flush();
 void param_primary_reset(param_t param);
 void param_primary_reset_all();
 void param_primary_get_counters(struct param_primary_counters *cnt);
@@ -37,6 +37,8 @@
 
 #include <inttypes.h>
 
+#include <containers/Bitset.hpp>
+#include <parameters/px4_parameters.hpp>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/tasks.h>
 
@@ -45,6 +47,8 @@
 #include <uORB/topics/parameter_set_used_request.h>
 #include <uORB/topics/parameter_set_value_request.h>
 #include <uORB/topics/parameter_set_value_response.h>
+#include <uORB/topics/parameter_sync_request.h>
+#include <uORB/topics/parameter_value_batch.h>
 
 // Debug flag
 static bool debug = false;
@@ -53,6 +57,10 @@ static struct param_remote_counters param_remote_counters;
 
 #define TIMEOUT_WAIT 1000
 #define TIMEOUT_COUNT 50
+#define SYNC_REQUEST_INTERVAL 1000000 // us
+#define SYNC_REQUEST_RETRIES 30
+
+static constexpr uint16_t param_info_count = sizeof(px4::parameters) / sizeof(param_info_s);
 
 static orb_advert_t parameter_set_used_h = nullptr;
 static orb_advert_t param_set_value_req_h = nullptr;
@@ -62,31 +70,146 @@ static int param_set_rsp_fd = PX4_ERROR;
 static px4_task_t sync_thread_tid;
 static const char *sync_thread_name = "param_remote_sync";
 
+struct remote_sync_state {
+	orb_advert_t sync_req_h{nullptr};
+	orb_advert_t batch_ack_h{nullptr};
+	uint32_t session{0};
+	hrt_abstime request_time{0};
+	int requests{0};
+	bool synced{false};
+	px4::Bitset<param_info_count> received; ///< values received in the current full sync
+};
+
+static void request_sync(remote_sync_state &state)
+{
+	parameter_sync_request_s req{};
+	req.timestamp = hrt_absolute_time();
+	// a new session for every request, so that batches of an earlier one are ignored
+	req.session = (uint32_t)req.timestamp | 1;
+	req.values_hash = param_values_hash();
+
+	if (state.sync_req_h == nullptr) {
+		state.sync_req_h = orb_advertise(ORB_ID(parameter_sync_request), &req);
+
+	} else {
+		orb_publish(ORB_ID(parameter_sync_request), state.sync_req_h, &req);
+	}
+
+	state.session = req.session;
+	state.request_time = req.timestamp;
+	state.requests++;
+	state.synced = false;
+	state.received.reset();
+	param_remote_counters.sync_request_sent++;
+
+	if (debug) {
+		PX4_INFO("Requesting parameter sync, session %" PRIu32, req.session);
+	}
+}
+
+static void reset_values_not_received(const remote_sync_state &state)
+{
+	for (param_t param = 0; param < param_info_count; param++) {
+		if (state.received[param]) {
+			continue;
+		}
+
+		int32_t value = 0;
+		int32_t system_default = 0;
+
+		if ((param_get(param, &value) == PX4_OK) && (param_get_system_default_value(param, &system_default) == PX4_OK)
+		    && (value != system_default)) {
+			param_reset_no_notification(param);
+		}
+	}
+}
+
+static void handle_batch(remote_sync_state &state, const parameter_value_batch_s &batch)
+{
+	if (batch.session != state.session) {
+		// stale batch of an earlier session, the primary times out and gives up on it
+		return;
+	}
+
+	param_remote_counters.batch_received++;
+	state.request_time = hrt_absolute_time();
+
+	const bool full_sync = batch.flags & parameter_value_batch_s::FLAG_FULL_SYNC;
+
+	for (int i = 0; (i < batch.count) && (i < parameter_value_batch_s::BATCH_SIZE); i++) {
+		const param_t param = batch.parameter_index[i];
+
+		if (param >= param_info_count) {
+			PX4_ERR("Parameter batch contains invalid index %u", param);
+			continue;
+		}
+
+		// the raw value is valid for both int and float parameters
+		param_set_no_remote_update(param, (const void *) &batch.value[i], false);
+		param_remote_counters.values_received++;
+
+		if (full_sync) {
+			state.received.set(param);
+		}
+	}
+
+	parameter_set_value_response_s ack{};
+	ack.timestamp = hrt_absolute_time();
+	ack.request_timestamp = batch.timestamp;
+	ack.parameter_index = batch.sequence;
+
+	if (state.batch_ack_h == nullptr) {
+		state.batch_ack_h = orb_advertise(ORB_ID(parameter_remote_set_value_response), &ack);
+
+	} else {
+		orb_publish(ORB_ID(parameter_remote_set_value_response), state.batch_ack_h, &ack);
+	}
+
+	param_remote_counters.batch_ack_sent++;
+
+	if (batch.flags & parameter_value_batch_s::FLAG_LAST) {
+		if (full_sync) {
+			reset_values_not_received(state);
+		}
+
+		const uint32_t values_hash = param_values_hash();
+
+		if (values_hash == batch.values_hash) {
+			PX4_INFO("Parameters in sync with primary after %" PRIu16 " batches", (uint16_t)(batch.sequence + 1));
+			state.synced = true;
+
+		} else if (state.requests < SYNC_REQUEST_RETRIES) {
+			PX4_WARN("Parameter hash mismatch after sync (%" PRIx32 " != %" PRIx32 "), retrying", values_hash, batch.values_hash);
+			request_sync(state);
+		}
+	}
+}
+
 static int remote_sync_thread(int argc, char *argv[])
 {
 	// This thread gets started by the remote side during PX4 initialization.
-	// We cannot send out the subscribe request immediately because the other
+	// We cannot send out the sync request immediately because the other
 	// side will not be ready to receive it on the muorb yet and it will get dropped.
 	// So, sleep a little bit to give other side a chance to finish initialization
-	// of the muorb. But don't wait too long otherwise a set request from the server
-	// side could be missed.
+	// of the muorb. Requests are repeated until the primary answers.
 	usleep(200000);
 
-	orb_advert_t _set_value_rsp_h = nullptr;
+	int _reset_req_fd = orb_subscribe(ORB_ID(parameter_reset_request));
+	int _batch_fd     = orb_subscribe(ORB_ID(parameter_value_batch));
 
-	int _reset_req_fd  = orb_subscribe(ORB_ID(parameter_reset_request));
-	int _set_value_req_fd = orb_subscribe(ORB_ID(parameter_remote_set_value_request));
+	struct parameter_reset_request_s _reset_request;
+	struct parameter_value_batch_s   _batch;
 
-	struct parameter_reset_request_s      _reset_request;
-	struct parameter_set_value_request_s  _set_value_request;
-	struct parameter_set_value_response_s _set_value_response;
+	remote_sync_state state{};
 
 	px4_pollfd_struct_t fds[2] = { { .fd = _reset_req_fd,  .events = POLLIN },
-		{ .fd = _set_value_req_fd, .events = POLLIN }
+		{ .fd = _batch_fd, .events = POLLIN }
 	};
 
 	PX4_INFO("Starting parameter remote sync thread");
 
+	request_sync(state);
+
 	while (true) {
 		px4_poll(fds, 2, 1000);
 
@@ -118,50 +241,25 @@ static int remote_sync_thread(int argc, char *argv[])
 			bool updated = true;
 
 			while (updated) {
-				orb_copy(ORB_ID(parameter_primary_set_value_request), _set_value_req_fd, &_set_value_request);
+				orb_copy(ORB_ID(parameter_value_batch), _batch_fd, &_batch);
 
 				if (debug) {
-					PX4_INFO("Got parameter_remote_set_value_request for %s", param_name(_set_value_request.parameter_index));
-				}
-
-				param_remote_counters.set_value_request_received++;
-
-				switch (param_type(_set_value_request.parameter_index)) {
-				case PARAM_TYPE_INT32:
-					param_set_no_remote_update(_set_value_request.parameter_index,
-								   (const void *) &_set_value_request.int_value,
-								   false);
-					break;
-
-				case PARAM_TYPE_FLOAT:
-					param_set_no_remote_update(_set_value_request.parameter_index,
-								   (const void *) &_set_value_request.float_value,
-								   false);
-					break;
-
-				default:
-					PX4_ERR("Parameter must be either int or float");
-					break;
+					PX4_INFO("Got parameter_value_batch %u with %u values", _batch.sequence, _batch.count);
 				}
 
-				_set_value_response.timestamp = hrt_absolute_time();
-				_set_value_response.request_timestamp = _set_value_request.timestamp;
-				_set_value_response.parameter_index = _set_value_request.parameter_index;
-
-				if (_set_value_rsp_h == nullptr) {
-					_set_value_rsp_h = orb_advertise(ORB_ID(parameter_remote_set_value_response), &_set_value_response);
+				handle_batch(state, _batch);
 
-				} else {
-					if (debug) {
-						PX4_INFO("Sending set value response for %s", param_name(_set_value_request.parameter_index));
-					}
-
-					orb_publish(ORB_ID(parameter_remote_set_value_response), _set_value_rsp_h, &_set_value_response);
-				}
+				(void) orb_check(_batch_fd, &updated);
+			}
+		}
 
-				param_remote_counters.set_value_response_sent++;
+		if (!state.synced && (hrt_elapsed_time(&state.request_time) > SYNC_REQUEST_INTERVAL)) {
+			if (state.requests < SYNC_REQUEST_RETRIES) {
+				request_sync(state);
 
-				(void) orb_check(_set_value_req_fd, &updated);
+			} else if (state.requests == SYNC_REQUEST_RETRIES) {
+				PX4_ERR("No parameter sync from primary after %d requests", state.requests);
+				state.requests++;
 			}
 		}
 	}
@@ -36,8 +36,10 @@
 #include "param.h"
 
 struct param_remote_counters {
-	uint32_t set_value_request_received;
-	uint32_t set_value_response_sent;
+	uint32_t batch_received;
+	uint32_t batch_ack_sent;
+	uint32_t values_received;
+	uint32_t sync_request_sent;
 	uint32_t reset_received;
 	uint32_t set_value_request_sent;
 	uint32_t set_value_response_received;
@@ -19,6 +19,73 @@ except ImportError as e:
 
 import os
 
+def param_hash(name, seed):
+    """
+    FNV-1a over the parameter name, with the seed mixed into the offset basis and a final
+    avalanche step (the low bits of plain FNV-1a do not depend on the seed).
+    Must match param_hash() in parameters.cpp.
+    """
+    h = 2166136261 ^ ((seed * 0x9e3779b9) & 0xffffffff)
+    for c in name.encode():
+        h ^= c
+        h = (h * 16777619) & 0xffffffff
+    h ^= h >> 16
+    h = (h * 0x45d9f3b) & 0xffffffff
+    h ^= h >> 16
+    return h
+
+def generate_perfect_hash(names):
+    """
+    Build a minimal perfect hash over the sorted parameter names (hash and displace).
+
+    The names are distributed into buckets by param_hash(name, 0). For each bucket with
+    several names, largest first, a seed is searched that maps all of them to free slots.
+    A bucket with a single name stores -(slot + 1) instead of a seed.
+
+    @return: (displacements, slots) where slots holds the parameter index for each slot
+    """
+    size = max(len(names), 1)
+
+    for keys_per_bucket in (4, 3, 2, 1):
+        num_buckets = max((len(names) + keys_per_bucket - 1) // keys_per_bucket, 1)
+        buckets = [[] for _ in range(num_buckets)]
+
+        for index, name in enumerate(names):
+            buckets[param_hash(name, 0) % num_buckets].append(index)
+
+        displacements = [0] * num_buckets
+        slots = [None] * size
+        success = True
+
+        for bucket in sorted(range(num_buckets), key=lambda b: -len(buckets[b])):
+            keys = buckets[bucket]
+
+            if len(keys) > 1:
+                # the seed is stored as int16
+                for seed in range(1, 32768):
+                    candidates = [param_hash(names[k], seed) % size for k in keys]
+
+                    if len(set(candidates)) == len(candidates) and all(slots[c] is None for c in candidates):
+                        break
+                else:
+                    success = False
+                    break
+
+                for k, c in zip(keys, candidates):
+                    slots[c] = k
+
+                displacements[bucket] = seed
+
+            elif len(keys) == 1:
+                free = slots.index(None)
+                slots[free] = keys[0]
+                displacements[bucket] = -free - 1
+
+        if success:
+            return displacements, [s if s is not None else 0 for s in slots]
+
+    raise Exception("Failed to generate the parameter hash")
+
 def generate(xml_file, dest='.'):
     """
     Generate px4 param source from xml.
@@ -39,6 +106,8 @@ def generate(xml_file, dest='.'):
 
     params = sorted(params, key=lambda name: name.attrib["name"])
 
+    hash_displacements, hash_slots = generate_perfect_hash([p.attrib["name"] for p in params])
+
     script_path = os.path.dirname(os.path.realpath(__file__))
 
     # for jinja docs see: http://jinja.pocoo.org/docs/2.9/api/
@@ -55,7 +124,8 @@ def generate(xml_file, dest='.'):
         template = env.get_template(template_file)
         with open(os.path.join(
                 dest, template_file.replace('.jinja','')), 'w') as fid:
-            fid.write(template.render(params=params))
+            fid.write(template.render(params=params,
+                hash_displacements=hash_displacements, hash_slots=hash_slots))
 
 if __name__ == "__main__":
     arg_parser = argparse.ArgumentParser()
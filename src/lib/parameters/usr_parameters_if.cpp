@@ -95,6 +95,22 @@ param_value_unsaved(param_t param)
 	return data.ret;
 }
 
+uint32_t
+param_generation()
+{
+	paramiocgeneration_t data = {0};
+	boardctl(PARAMIOCGENERATION, reinterpret_cast<unsigned long>(&data));
+	return data.ret;
+}
+
+bool
+param_changed_since(param_t param, uint32_t generation)
+{
+	paramiocchangedsince_t data = {param, generation, true};
+	boardctl(PARAMIOCCHANGEDSINCE, reinterpret_cast<unsigned long>(&data));
+	return data.ret;
+}
+
 int
 param_get(param_t param, void *val)
 {
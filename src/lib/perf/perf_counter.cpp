@@ -44,6 +44,7 @@
 #include <drivers/drv_hrt.h>
 #include <math.h>
 #include <pthread.h>
+#include <px4_platform_common/atomic.h>
 #include <systemlib/err.h>
 
 #include "perf_counter.h"
@@ -91,11 +92,73 @@ struct perf_ctr_interval : public perf_ctr_header {
 	float			M2{0.0f};
 };
 
+/**
+ * PC_HISTOGRAM counter.
+ *
+ * Updates are lock-free (32 bit atomics), time_start is only used by perf_begin/perf_end
+ * and needs to be used from a single context at a time, like PC_ELAPSED.
+ */
+struct perf_ctr_histogram : public perf_ctr_header {
+	px4::atomic<uint32_t>	buckets[PERF_HISTOGRAM_BUCKETS] {};
+	px4::atomic<uint32_t>	event_count{0};
+	px4::atomic<uint32_t>	time_most{0};
+	uint64_t		time_start{0};
+};
+
+static void
+perf_histogram_record(struct perf_ctr_histogram *pch, uint32_t elapsed)
+{
+	int bucket = (elapsed > 1) ? (31 - __builtin_clz(elapsed)) : 0;
+
+	if (bucket > PERF_HISTOGRAM_BUCKETS - 1) {
+		bucket = PERF_HISTOGRAM_BUCKETS - 1;
+	}
+
+	pch->buckets[bucket].fetch_add(1);
+	pch->event_count.fetch_add(1);
+
+	uint32_t most = pch->time_most.load();
+
+	while ((elapsed > most) && !pch->time_most.compare_exchange(&most, elapsed)) {}
+}
+
+/**
+ * Upper bound of the bucket containing the given percentile in us, 0 without events.
+ */
+static uint32_t
+perf_histogram_percentile(struct perf_ctr_histogram *pch, uint32_t percentile)
+{
+	const uint32_t count = pch->event_count.load();
+
+	if (count == 0) {
+		return 0;
+	}
+
+	const uint64_t threshold = ((uint64_t)count * percentile + 99) / 100;
+	const uint32_t most = pch->time_most.load();
+	uint64_t cumulative = 0;
+
+	for (int i = 0; i < PERF_HISTOGRAM_BUCKETS - 1; i++) {
+		cumulative += pch->buckets[i].load();
+
+		if (cumulative >= threshold) {
+			return ((2u << i) < most) ? (2u << i) : most;
+		}
+	}
+
+	return most;
+}
+
 /**
  * List of all known counters.
  */
 static sq_queue_t	perf_counters = { nullptr, nullptr };
 
+/**
+ * number of counters ever allocated, new counters are added to the front of the list
+ */
+static px4::atomic<uint32_t>	perf_counters_allocated{0};
+
 /**
  * mutex protecting access to the perf_counters linked list (which is read from & written to by different threads)
  */
@@ -126,6 +189,10 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr = new perf_ctr_interval();
 		break;
 
+	case PC_HISTOGRAM:
+		ctr = new perf_ctr_histogram();
+		break;
+
 	default:
 		break;
 	}
@@ -135,6 +202,7 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr->name = name;
 		pthread_mutex_lock(&perf_counters_mutex);
 		sq_addfirst(&ctr->link, &perf_counters);
+		perf_counters_allocated.fetch_add(1);
 		pthread_mutex_unlock(&perf_counters_mutex);
 	}
 
@@ -194,6 +262,10 @@ perf_free(perf_counter_t handle)
 		delete (struct perf_ctr_interval *)handle;
 		break;
 
+	case PC_HISTOGRAM:
+		delete (struct perf_ctr_histogram *)handle;
+		break;
+
 	default:
 		break;
 	}
@@ -232,6 +304,10 @@ perf_begin(perf_counter_t handle)
 		((struct perf_ctr_elapsed *)handle)->time_start = hrt_absolute_time();
 		break;
 
+	case PC_HISTOGRAM:
+		((struct perf_ctr_histogram *)handle)->time_start = hrt_absolute_time();
+		break;
+
 	default:
 		break;
 	}
@@ -254,6 +330,16 @@ perf_end(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			if (pch->time_start != 0) {
+				perf_histogram_record(pch, hrt_elapsed_time(&pch->time_start));
+				pch->time_start = 0;
+			}
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -294,6 +380,13 @@ perf_set_elapsed(perf_counter_t handle, int64_t elapsed)
 		}
 		break;
 
+	case PC_HISTOGRAM:
+		if (elapsed >= 0) {
+			perf_histogram_record((struct perf_ctr_histogram *)handle, (elapsed > UINT32_MAX) ? UINT32_MAX : elapsed);
+		}
+
+		break;
+
 	default:
 		break;
 	}
@@ -353,6 +446,22 @@ perf_count_interval(perf_counter_t handle, hrt_abstime now)
 	}
 }
 
+int
+perf_histogram_buckets(perf_counter_t handle, uint32_t buckets[PERF_HISTOGRAM_BUCKETS])
+{
+	if ((handle == nullptr) || (handle->type != PC_HISTOGRAM)) {
+		return -1;
+	}
+
+	struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+	for (int i = 0; i < PERF_HISTOGRAM_BUCKETS; i++) {
+		buckets[i] = pch->buckets[i].load();
+	}
+
+	return 0;
+}
+
 void
 perf_set_count(perf_counter_t handle, uint64_t count)
 {
@@ -387,6 +496,10 @@ perf_cancel(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM:
+		((struct perf_ctr_histogram *)handle)->time_start = 0;
+		break;
+
 	default:
 		break;
 	}
@@ -428,6 +541,19 @@ perf_reset(perf_counter_t handle)
 			pci->M2 = 0.0f;
 			break;
 		}
+
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			for (auto &bucket : pch->buckets) {
+				bucket.store(0);
+			}
+
+			pch->event_count.store(0);
+			pch->time_most.store(0);
+			pch->time_start = 0;
+			break;
+		}
 	}
 }
 
@@ -474,6 +600,28 @@ perf_print_counter(perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			PX4_INFO_RAW("%s: %" PRIu32 " events, p50 %" PRIu32 "us p99 %" PRIu32 "us max %" PRIu32 "us\n",
+				     handle->name,
+				     pch->event_count.load(),
+				     perf_histogram_percentile(pch, 50),
+				     perf_histogram_percentile(pch, 99),
+				     pch->time_most.load());
+
+			for (int i = 0; i < PERF_HISTOGRAM_BUCKETS; i++) {
+				const uint32_t count = pch->buckets[i].load();
+
+				if (count > 0) {
+					PX4_INFO_RAW("    %s%6" PRIu32 "us : %" PRIu32 "\n", (i == PERF_HISTOGRAM_BUCKETS - 1) ? ">=" : " <",
+						     (i == PERF_HISTOGRAM_BUCKETS - 1) ? (1u << i) : (2u << i), count);
+				}
+			}
+
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -526,6 +674,19 @@ perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			num_written = snprintf(buffer, length,
+					       "%s: %" PRIu32 " events, p50 %" PRIu32 "us p99 %" PRIu32 "us max %" PRIu32 "us",
+					       handle->name,
+					       pch->event_count.load(),
+					       perf_histogram_percentile(pch, 50),
+					       perf_histogram_percentile(pch, 99),
+					       pch->time_most.load());
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -555,6 +716,9 @@ perf_event_count(perf_counter_t handle)
 			return pci->event_count;
 		}
 
+	case PC_HISTOGRAM:
+		return ((struct perf_ctr_histogram *)handle)->event_count.load();
+
 	default:
 		break;
 	}
@@ -587,6 +751,76 @@ perf_mean(perf_counter_t handle)
 	return 0.0f;
 }
 
+const char *
+perf_name(perf_counter_t handle)
+{
+	if (handle == nullptr) {
+		return nullptr;
+	}
+
+	return handle->name;
+}
+
+uint32_t
+perf_name_id(perf_counter_t handle)
+{
+	if (handle == nullptr) {
+		return 0;
+	}
+
+	uint32_t hash = 2166136261u;
+
+	for (const char *c = handle->name; *c != '\0'; c++) {
+		hash = (hash ^ (uint8_t)*c) * 16777619u;
+	}
+
+	return hash;
+}
+
+int
+perf_get_stats(perf_counter_t handle, struct perf_counter_stats *stats)
+{
+	if ((handle == nullptr) || (stats == nullptr)) {
+		return -1;
+	}
+
+	stats->type = handle->type;
+	stats->event_count = perf_event_count(handle);
+	stats->time_avg_us = 0;
+	stats->time_min_us = 0;
+	stats->time_max_us = 0;
+
+	switch (handle->type) {
+	case PC_ELAPSED: {
+			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
+			stats->time_avg_us = (uint32_t)(1e6f * pce->mean);
+			stats->time_min_us = pce->time_least;
+			stats->time_max_us = pce->time_most;
+		}
+		break;
+
+	case PC_INTERVAL: {
+			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
+			stats->time_avg_us = (uint32_t)(1e6f * pci->mean);
+			stats->time_min_us = pci->time_least;
+			stats->time_max_us = pci->time_most;
+		}
+		break;
+
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			stats->time_avg_us = perf_histogram_percentile(pch, 50);
+			stats->time_max_us = pch->time_most.load();
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
 void
 perf_iterate_all(perf_callback cb, void *user)
 {
@@ -601,6 +835,29 @@ perf_iterate_all(perf_callback cb, void *user)
 	pthread_mutex_unlock(&perf_counters_mutex);
 }
 
+uint32_t
+perf_iterate_new(uint32_t generation, perf_callback cb, void *user)
+{
+	if (perf_counters_allocated.load() == generation) {
+		return generation;
+	}
+
+	pthread_mutex_lock(&perf_counters_mutex);
+	const uint32_t allocated = perf_counters_allocated.load();
+	uint32_t remaining = allocated - generation;
+	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+
+	while (handle != nullptr && remaining > 0) {
+		cb(handle, user);
+		handle = (perf_counter_t)sq_next(&handle->link);
+		remaining--;
+	}
+
+	pthread_mutex_unlock(&perf_counters_mutex);
+
+	return allocated;
+}
+
 void
 perf_print_all(void)
 {
@@ -48,12 +48,30 @@
 enum perf_counter_type {
 	PC_COUNT,		/**< count the number of times an event occurs */
 	PC_ELAPSED,		/**< measure the time elapsed performing an event */
-	PC_INTERVAL		/**< measure the interval between instances of an event */
+	PC_INTERVAL,		/**< measure the interval between instances of an event */
+	PC_HISTOGRAM		/**< log2 histogram of the time elapsed performing an event, lock-free */
 };
 
+/**
+ * Number of PC_HISTOGRAM buckets: bucket i counts times in [2^i, 2^(i+1)) us (the first one [0, 2) us),
+ * the last one everything above.
+ */
+#define PERF_HISTOGRAM_BUCKETS 16
+
 struct perf_ctr_header;
 typedef struct perf_ctr_header	*perf_counter_t;
 
+/**
+ * Snapshot of a performance counter, see perf_get_stats().
+ */
+struct perf_counter_stats {
+	enum perf_counter_type	type;
+	uint64_t		event_count;
+	uint32_t		time_avg_us;	/**< PC_ELAPSED/PC_INTERVAL mean, PC_HISTOGRAM p50, 0 for PC_COUNT */
+	uint32_t		time_min_us;	/**< PC_ELAPSED/PC_INTERVAL minimum, 0 for PC_HISTOGRAM and PC_COUNT */
+	uint32_t		time_max_us;	/**< PC_ELAPSED/PC_INTERVAL/PC_HISTOGRAM maximum, 0 for PC_COUNT */
+};
+
 __BEGIN_DECLS
 
 /**
@@ -120,6 +138,7 @@ __EXPORT extern void		perf_end(perf_counter_t handle);
  * This call applies to counters that operate over ranges of time; PC_ELAPSED etc.
  * If a call is made without a corresponding perf_begin call. It sets the
  * value provided as argument as a new measurement.
+ * For PC_HISTOGRAM it is lock-free and can be called concurrently, also from interrupts.
  *
  * @param handle		The handle returned from perf_alloc.
  * @param elapsed		The time elapsed. Negative values lead to incrementing the overrun counter.
@@ -138,6 +157,15 @@ __EXPORT extern void		perf_set_elapsed(perf_counter_t handle, int64_t elapsed);
  */
 __EXPORT extern void		perf_count_interval(perf_counter_t handle, uint64_t time);
 
+/**
+ * Get the buckets of a PC_HISTOGRAM counter.
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @param buckets		Output array of PERF_HISTOGRAM_BUCKETS bucket counts.
+ * @return			0 on success, -1 if the counter is not a histogram.
+ */
+__EXPORT extern int		perf_histogram_buckets(perf_counter_t handle, uint32_t buckets[PERF_HISTOGRAM_BUCKETS]);
+
 /**
  * Set a counter
  *
@@ -204,6 +232,19 @@ typedef void (*perf_callback)(perf_counter_t handle, void *user);
  */
 __EXPORT extern void	perf_iterate_all(perf_callback cb, void *user);
 
+/**
+ * Iterate over the performance counters allocated after a previous call, newest first.
+ *
+ * Counters freed in between can make older counters show up again. Same locking
+ * caution as perf_iterate_all().
+ *
+ * @param generation value returned by the previous call, 0 to iterate over all counters
+ * @param cb callback method
+ * @param user custom argument for the callback
+ * @return generation to pass to the next call
+ */
+__EXPORT extern uint32_t	perf_iterate_new(uint32_t generation, perf_callback cb, void *user);
+
 /**
  * Print hrt latency counters.
  */
@@ -230,6 +271,31 @@ __EXPORT extern uint64_t	perf_event_count(perf_counter_t handle);
  */
 __EXPORT extern float		perf_mean(perf_counter_t handle);
 
+/**
+ * Return the name of a counter
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @return			name, nullptr for an invalid handle
+ */
+__EXPORT extern const char	*perf_name(perf_counter_t handle);
+
+/**
+ * Return a stable 32 bit ID of a counter, derived from its name (FNV-1a hash).
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @return			ID, 0 for an invalid handle
+ */
+__EXPORT extern uint32_t	perf_name_id(perf_counter_t handle);
+
+/**
+ * Get a snapshot of the statistics of a counter.
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @param stats			Output statistics.
+ * @return			0 on success, -1 for an invalid handle
+ */
+__EXPORT extern int		perf_get_stats(perf_counter_t handle, struct perf_counter_stats *stats);
+
 __END_DECLS
 
 #endif
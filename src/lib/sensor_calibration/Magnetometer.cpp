@@ -128,6 +128,7 @@ bool Magnetometer::set_scale(const Vector3f &scale)
 			_scale(0, 0) = scale(0);
 			_scale(1, 1) = scale(1);
 			_scale(2, 2) = scale(2);
+			UpdateRotationScale();
 
 			_calibration_count++;
 			return true;
@@ -150,6 +151,7 @@ bool Magnetometer::set_offdiagonal(const Vector3f &offdiagonal)
 
 			_scale(1, 2) = offdiagonal(2);
 			_scale(2, 1) = offdiagonal(2);
+			UpdateRotationScale();
 
 			_calibration_count++;
 			return true;
@@ -171,6 +173,7 @@ void Magnetometer::set_rotation(const Rotation rotation)
 
 	// always apply level adjustments
 	_rotation = Dcmf(GetSensorLevelAdjustment()) * get_rot_matrix(_rotation_enum);
+	UpdateRotationScale();
 
 	// clear any custom rotation
 	_rotation_custom_euler.zero();
@@ -185,6 +188,7 @@ void Magnetometer::set_custom_rotation(const Eulerf &rotation)
 
 	// always apply board level adjustments
 	_rotation = Dcmf(GetSensorLevelAdjustment()) * Dcmf(_rotation_custom_euler);
+	UpdateRotationScale();
 
 	// TODO: Note that ideally this shouldn't be necessary for an external sensors, as the definition of *rotation
 	// between sensor frame & vehicle's body frame isn't affected by the rotation of the Autopilot.
@@ -313,6 +317,7 @@ void Magnetometer::Reset()
 
 	_offset.zero();
 	_scale.setIdentity();
+	UpdateRotationScale();
 
 	_power_compensation.zero();
 	_power = 0.f;
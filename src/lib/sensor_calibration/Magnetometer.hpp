@@ -97,7 +97,7 @@ public:
 	// rotate corrected measurements from sensor to body frame
 	inline matrix::Vector3f Correct(const matrix::Vector3f &data) const
 	{
-		return _rotation * (_scale * ((data + _power * _power_compensation) - _offset));
+		return _rotation_scale * ((data + _power * _power_compensation) - _offset);
 	}
 
 	// Compute sensor offset from bias (board frame)
@@ -118,6 +118,8 @@ public:
 	void UpdatePower(float power) { _power = power; }
 
 private:
+	void UpdateRotationScale() { _rotation_scale = _rotation * _scale; }
+
 	uORB::Subscription _sensor_correction_sub{ORB_ID(sensor_correction)};
 
 	Rotation _rotation_enum{ROTATION_NONE};
@@ -131,6 +133,7 @@ private:
 
 	matrix::Vector3f _offset;
 	matrix::Matrix3f _scale;
+	matrix::Matrix3f _rotation_scale; // _rotation * _scale, combined once instead of for every sample
 	matrix::Vector3f _thermal_offset;
 	matrix::Vector3f _power_compensation;
 
@@ -37,6 +37,9 @@
 #include <lib/drivers/device/Device.hpp>
 #include <lib/mathlib/mathlib.h>
 #include <lib/parameters/param.h>
+#include <px4_platform_common/atomic.h>
+
+#include <string.h>
 
 #if defined(CONFIG_I2C)
 # include <px4_platform_common/i2c.h>
@@ -56,6 +59,85 @@ namespace calibration
 
 static constexpr int MAX_SENSOR_COUNT = 4; // TODO: per sensor?
 
+// The calibration parameter handles are looked up by name only once and then cached. The parameter table is static,
+// so the handles never change, and the calibration reloads after every parameter change only read the values.
+static constexpr const char *SENSOR_TYPES[] {"ACC", "GYRO", "MAG", "BARO"};
+static constexpr const char *SCALAR_CAL_TYPES[] {"ID", "PRIO", "ROT", "OFF", "ROLL", "PITCH", "YAW"};
+static constexpr const char *VECTOR_CAL_TYPES[] {"OFF", "SCALE", "ODIAG", "COMP"};
+
+static constexpr int SENSOR_TYPE_COUNT = sizeof(SENSOR_TYPES) / sizeof(SENSOR_TYPES[0]);
+static constexpr int SCALAR_CAL_TYPE_COUNT = sizeof(SCALAR_CAL_TYPES) / sizeof(SCALAR_CAL_TYPES[0]);
+static constexpr int VECTOR_CAL_TYPE_COUNT = sizeof(VECTOR_CAL_TYPES) / sizeof(VECTOR_CAL_TYPES[0]);
+static constexpr int PARAMS_PER_INSTANCE = SCALAR_CAL_TYPE_COUNT + 3 * VECTOR_CAL_TYPE_COUNT;
+
+// 0: not looked up yet, UINT16_MAX: no such parameter, otherwise the handle + 1
+static px4::atomic<uint16_t> param_handle_cache[SENSOR_TYPE_COUNT][MAX_SENSOR_COUNT][PARAMS_PER_INSTANCE] {};
+
+template<size_t N>
+static int FindString(const char *const(&strings)[N], const char *str)
+{
+	for (size_t i = 0; i < N; i++) {
+		if (strcmp(strings[i], str) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Get the handle of CAL_<sensor_type><instance>_<cal_type>, or of CAL_<sensor_type><instance>_{X,Y,Z}<cal_type>
+ * for an axis >= 0. Lookups of unknown sensor or calibration types are not cached.
+ */
+static param_t FindCalibrationParam(const char *sensor_type, const char *cal_type, uint8_t instance, int axis = -1)
+{
+	const int sensor_index = FindString(SENSOR_TYPES, sensor_type);
+	int param_index = -1;
+
+	if (axis < 0) {
+		param_index = FindString(SCALAR_CAL_TYPES, cal_type);
+
+	} else if (axis < 3) {
+		const int vector_index = FindString(VECTOR_CAL_TYPES, cal_type);
+
+		if (vector_index >= 0) {
+			param_index = SCALAR_CAL_TYPE_COUNT + 3 * vector_index + axis;
+		}
+	}
+
+	px4::atomic<uint16_t> *cached = nullptr;
+
+	if ((sensor_index >= 0) && (param_index >= 0) && (instance < MAX_SENSOR_COUNT)) {
+		cached = &param_handle_cache[sensor_index][instance][param_index];
+
+		const uint16_t value = cached->load();
+
+		if (value != 0) {
+			return (value == UINT16_MAX) ? PARAM_INVALID : static_cast<param_t>(value - 1);
+		}
+	}
+
+	char str[20] {};
+
+	if (axis < 0) {
+		// eg CAL_MAGn_ID/CAL_MAGn_ROT
+		snprintf(str, sizeof(str), "CAL_%s%" PRIu8 "_%s", sensor_type, instance, cal_type);
+
+	} else {
+		// eg CAL_MAGn_{X,Y,Z}OFF
+		snprintf(str, sizeof(str), "CAL_%s%" PRIu8 "_%c%s", sensor_type, instance, 'X' + axis, cal_type);
+	}
+
+	const param_t handle = param_find_no_notification(str);
+
+	if (cached) {
+		// concurrent lookups store the same value
+		cached->store((handle == PARAM_INVALID) ? UINT16_MAX : static_cast<uint16_t>(handle + 1));
+	}
+
+	return handle;
+}
+
 int8_t FindCurrentCalibrationIndex(const char *sensor_type, uint32_t device_id)
 {
 	if (device_id == 0) {
@@ -63,19 +145,18 @@ int8_t FindCurrentCalibrationIndex(const char *sensor_type, uint32_t device_id)
 	}
 
 	for (unsigned i = 0; i < MAX_SENSOR_COUNT; ++i) {
-		char str[20] {};
-		snprintf(str, sizeof(str), "CAL_%s%u_ID", sensor_type, i);
-
-		int32_t device_id_val = 0;
-
-		param_t param_handle = param_find_no_notification(str);
+		const param_t param_handle = FindCalibrationParam(sensor_type, "ID", i);
 
 		if (param_handle == PARAM_INVALID) {
 			continue;
 		}
 
-		// find again and get value, but this time mark it active
-		if (param_get(param_find(str), &device_id_val) != OK) {
+		// mark it active
+		param_set_used(param_handle);
+
+		int32_t device_id_val = 0;
+
+		if (param_get(param_handle, &device_id_val) != OK) {
 			continue;
 		}
 
@@ -102,11 +183,9 @@ int8_t FindAvailableCalibrationIndex(const char *sensor_type, uint32_t device_id
 	uint32_t cal_device_ids[MAX_SENSOR_COUNT] {};
 
 	for (unsigned i = 0; i < MAX_SENSOR_COUNT; ++i) {
-		char str[20] {};
-		snprintf(str, sizeof(str), "CAL_%s%u_ID", sensor_type, i);
 		int32_t device_id_val = 0;
 
-		if (param_get(param_find_no_notification(str), &device_id_val) == PX4_OK) {
+		if (param_get(FindCalibrationParam(sensor_type, "ID", i), &device_id_val) == PX4_OK) {
 			cal_device_ids[i] = device_id_val;
 		}
 	}
@@ -134,16 +213,23 @@ int8_t FindAvailableCalibrationIndex(const char *sensor_type, uint32_t device_id
 	return calibration_index;
 }
 
-int32_t GetCalibrationParamInt32(const char *sensor_type, const char *cal_type, uint8_t instance)
+param_t GetCalibrationParamHandle(const char *sensor_type, const char *cal_type, uint8_t instance)
 {
-	// eg CAL_MAGn_ID/CAL_MAGn_ROT
-	char str[20] {};
-	snprintf(str, sizeof(str), "CAL_%s%" PRIu8 "_%s", sensor_type, instance, cal_type);
+	const param_t handle = FindCalibrationParam(sensor_type, cal_type, instance);
+
+	if (handle != PARAM_INVALID) {
+		param_set_used(handle);
+	}
 
+	return handle;
+}
+
+int32_t GetCalibrationParamInt32(const char *sensor_type, const char *cal_type, uint8_t instance)
+{
 	int32_t value = 0;
 
-	if (param_get(param_find(str), &value) != 0) {
-		PX4_ERR("failed to get %s", str);
+	if (param_get(GetCalibrationParamHandle(sensor_type, cal_type, instance), &value) != 0) {
+		PX4_ERR("failed to get CAL_%s%" PRIu8 "_%s", sensor_type, instance, cal_type);
 	}
 
 	return value;
@@ -152,13 +238,10 @@ int32_t GetCalibrationParamInt32(const char *sensor_type, const char *cal_type,
 float GetCalibrationParamFloat(const char *sensor_type, const char *cal_type, uint8_t instance)
 {
 	// eg CAL_BAROn_OFF
-	char str[20] {};
-	snprintf(str, sizeof(str), "CAL_%s%" PRIu8 "_%s", sensor_type, instance, cal_type);
-
 	float value = NAN;
 
-	if (param_get(param_find(str), &value) != 0) {
-		PX4_ERR("failed to get %s", str);
+	if (param_get(GetCalibrationParamHandle(sensor_type, cal_type, instance), &value) != 0) {
+		PX4_ERR("failed to get CAL_%s%" PRIu8 "_%s", sensor_type, instance, cal_type);
 	}
 
 	return value;
@@ -168,16 +251,16 @@ Vector3f GetCalibrationParamsVector3f(const char *sensor_type, const char *cal_t
 {
 	Vector3f values{0.f, 0.f, 0.f};
 
-	char str[20] {};
-
 	for (int axis = 0; axis < 3; axis++) {
-		char axis_char = 'X' + axis;
-
 		// eg CAL_MAGn_{X,Y,Z}OFF
-		snprintf(str, sizeof(str), "CAL_%s%" PRIu8 "_%c%s", sensor_type, instance, axis_char, cal_type);
+		const param_t handle = FindCalibrationParam(sensor_type, cal_type, instance, axis);
+
+		if (handle != PARAM_INVALID) {
+			param_set_used(handle);
+		}
 
-		if (param_get(param_find(str), &values(axis)) != 0) {
-			PX4_ERR("failed to get %s", str);
+		if (param_get(handle, &values(axis)) != 0) {
+			PX4_ERR("failed to get CAL_%s%" PRIu8 "_%c%s", sensor_type, instance, 'X' + axis, cal_type);
 		}
 	}
 
@@ -187,16 +270,18 @@ Vector3f GetCalibrationParamsVector3f(const char *sensor_type, const char *cal_t
 bool SetCalibrationParamsVector3f(const char *sensor_type, const char *cal_type, uint8_t instance, Vector3f values)
 {
 	int ret = PX4_OK;
-	char str[20] {};
 
 	for (int axis = 0; axis < 3; axis++) {
-		char axis_char = 'X' + axis;
-
 		// eg CAL_MAGn_{X,Y,Z}OFF
-		snprintf(str, sizeof(str), "CAL_%s%" PRIu8 "_%c%s", sensor_type, instance, axis_char, cal_type);
+		const param_t handle = FindCalibrationParam(sensor_type, cal_type, instance, axis);
+
+		if (handle != PARAM_INVALID) {
+			param_set_used(handle);
+		}
 
-		if (param_set_no_notification(param_find(str), &values(axis)) != 0) {
-			PX4_ERR("failed to set %s = %.4f", str, (double)values(axis));
+		if (param_set_no_notification(handle, &values(axis)) != 0) {
+			PX4_ERR("failed to set CAL_%s%" PRIu8 "_%c%s = %.4f", sensor_type, instance, 'X' + axis, cal_type,
+				(double)values(axis));
 			ret = PX4_ERROR;
 		}
 	}
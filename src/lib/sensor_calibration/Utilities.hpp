@@ -62,6 +62,16 @@ int8_t FindCurrentCalibrationIndex(const char *sensor_type, uint32_t device_id);
  */
 int8_t FindAvailableCalibrationIndex(const char *sensor_type, uint32_t device_id, int8_t preferred_index = -1);
 
+/**
+ * @brief Get the handle of a sensor calibration parameter (looked up by name only once) and mark it used.
+ *
+ * @param sensor_type Calibration parameter abbreviated sensor string ("ACC", "GYRO", "MAG")
+ * @param cal_type Calibration parameter abbreviated type ("ID", "SCALE", "ROT", "PRIO")
+ * @param instance Calibration index (0 - 3)
+ * @return param_t The parameter handle, PARAM_INVALID if it does not exist.
+ */
+param_t GetCalibrationParamHandle(const char *sensor_type, const char *cal_type, uint8_t instance);
+
 /**
  * @brief Get sensor calibration parameter value.
  *
@@ -85,15 +95,11 @@ float GetCalibrationParamFloat(const char *sensor_type, const char *cal_type, ui
 template<typename T>
 bool SetCalibrationParam(const char *sensor_type, const char *cal_type, uint8_t instance, T value)
 {
-	char str[20] {};
-
 	// eg CAL_MAGn_ID/CAL_MAGn_ROT
-	snprintf(str, sizeof(str), "CAL_%s%u_%s", sensor_type, instance, cal_type);
-
-	int ret = param_set_no_notification(param_find(str), &value);
+	int ret = param_set_no_notification(GetCalibrationParamHandle(sensor_type, cal_type, instance), &value);
 
 	if (ret != PX4_OK) {
-		PX4_ERR("failed to set %s", str);
+		PX4_ERR("failed to set CAL_%s%u_%s", sensor_type, instance, cal_type);
 	}
 
 	return ret == PX4_OK;
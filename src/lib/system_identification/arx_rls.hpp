@@ -122,11 +122,22 @@ public:
 		}
 
 		const matrix::Vector < float, N + M + 1 > phi = constructDesignVector();
-		const matrix::Matrix < float, 1, N + M + 1 > phi_t = phi.transpose();
 
-		_P = (_P - _P * phi * phi_t * _P / (_lambda + (phi_t * _P * phi)(0, 0))) / _lambda;
-		_innovation = _y[N] - (phi_t * _theta_hat)(0, 0);
-		_theta_hat = _theta_hat + _P * phi * _innovation;
+		// P is symmetric: P * phi * phi' * P = k * k' with k = P * phi, and the
+		// updated P * phi is k / (lambda + phi' * k), which avoids all the matrix-matrix products
+		const matrix::Vector < float, N + M + 1 > k = _P * phi;
+		const float denominator = _lambda + phi.dot(k);
+
+		for (size_t i = 0; i < N + M + 1; i++) {
+			for (size_t j = i; j < N + M + 1; j++) {
+				// only the upper triangle is computed, which also keeps P exactly symmetric
+				_P(i, j) = (_P(i, j) - k(i) * k(j) / denominator) / _lambda;
+				_P(j, i) = _P(i, j);
+			}
+		}
+
+		_innovation = _y[N] - phi.dot(_theta_hat);
+		_theta_hat = _theta_hat + k * (_innovation / denominator);
 
 		for (size_t i = 0; i < N + M + 1; i++) {
 			_diff_theta_hat(i) = fabsf(_theta_hat(i) - theta_prev(i));
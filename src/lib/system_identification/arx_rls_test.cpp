@@ -114,3 +114,32 @@ TEST_F(ArxRlsTest, resetTest)
 	// THEN: the result should be exactly the same
 	EXPECT_TRUE((coefficients - _rls.getCoefficients()).abs().max() < 1e-8f);
 }
+
+TEST_F(ArxRlsTest, identifySecondOrderSystem)
+{
+	// GIVEN: a discrete second order system y(k) = 1.5 y(k-1) - 0.7 y(k-2) + 0.2 u(k-1) + 0.1 u(k-2)
+	ArxRls<2, 1, 1> _rls;
+	_rls.setForgettingFactor(0.999f);
+
+	float y[3] {};
+	float u[3] {};
+
+	for (int k = 0; k < 2000; k++) {
+		// pseudo random binary excitation
+		u[0] = ((k * 7919) % 13) < 6 ? 1.f : -1.f;
+		y[0] = 1.5f * y[1] - 0.7f * y[2] + 0.2f * u[1] + 0.1f * u[2];
+
+		_rls.update(u[0], y[0]);
+
+		u[2] = u[1];
+		u[1] = u[0];
+		y[2] = y[1];
+		y[1] = y[0];
+	}
+
+	// THEN: the model converges to the true coefficients [a_1 a_2 b_0 b_1] and the variances decrease
+	const Vector4f coefficients_check(-1.5f, 0.7f, 0.2f, 0.1f);
+	EXPECT_TRUE((_rls.getCoefficients() - coefficients_check).abs().max() < 1e-3f);
+	EXPECT_TRUE(_rls.getVariances().max() < 1.f);
+	EXPECT_TRUE(_rls.getVariances().min() > 0.f);
+}
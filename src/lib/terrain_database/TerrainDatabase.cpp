@@ -0,0 +1,435 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "TerrainDatabase.hpp"
+
+#include <crc32.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <lib/geo/geo.h>
+#include <lib/mathlib/mathlib.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+
+TerrainDatabase::TerrainDatabase(ModuleParams *parent, int cache_tiles, const char *directory) :
+	ModuleParams(parent),
+	ScheduledWorkItem("terrain_database", px4::wq_configurations::lp_default),
+	_directory(directory),
+	_cache_tiles(math::max(cache_tiles, 1))
+{
+	pthread_mutex_init(&_mutex, nullptr);
+
+	for (int i = 0; i < MISSING_CELLS; i++) {
+		_missing_cells[i] = INVALID_KEY;
+	}
+}
+
+TerrainDatabase::~TerrainDatabase()
+{
+	ScheduleClear();
+	delete[] _tiles;
+	pthread_mutex_destroy(&_mutex);
+	perf_free(_load_perf);
+}
+
+bool TerrainDatabase::toLookup(double lat, double lon, Lookup &lookup)
+{
+	if (!PX4_ISFINITE(lat) || !PX4_ISFINITE(lon) || (lat < -90.0) || (lat >= 90.0) || (lon < -180.0) || (lon >= 180.0)) {
+		return false;
+	}
+
+	const double cell_lat = floor(lat);
+	const double cell_lon = floor(lon);
+
+	// position within the cell in tiles
+	const double tile_y = (lat - cell_lat) * TILES_PER_DEGREE;
+	const double tile_x = (lon - cell_lon) * TILES_PER_DEGREE;
+	const int tile_row = math::constrain((int)tile_y, 0, TILES_PER_DEGREE - 1);
+	const int tile_col = math::constrain((int)tile_x, 0, TILES_PER_DEGREE - 1);
+
+	lookup.key = ((uint32_t)((int)cell_lat + 90) << 24) | ((uint32_t)((int)cell_lon + 180) << 10)
+		     | (uint32_t)(tile_row * TILES_PER_DEGREE + tile_col);
+	lookup.row = math::constrain((float)((tile_y - tile_row) * TILE_INTERVALS), 0.f, (float)TILE_INTERVALS);
+	lookup.col = math::constrain((float)((tile_x - tile_col) * TILE_INTERVALS), 0.f, (float)TILE_INTERVALS);
+	return true;
+}
+
+TerrainDatabase::Tile *TerrainDatabase::findLocked(uint32_t key)
+{
+	if (_tiles == nullptr) {
+		return nullptr;
+	}
+
+	for (int i = 0; i < _cache_tiles; i++) {
+		if ((_tiles[i].state != TileState::Empty) && (_tiles[i].key == key)) {
+			return &_tiles[i];
+		}
+	}
+
+	return nullptr;
+}
+
+bool TerrainDatabase::isMissingLocked(uint32_t key) const
+{
+	const uint32_t cell = key & ~0x3ffu;
+
+	for (int i = 0; i < MISSING_CELLS; i++) {
+		if (_missing_cells[i] == cell) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void TerrainDatabase::queueLocked(uint32_t key)
+{
+	if (findLocked(key) || isMissingLocked(key)) {
+		return;
+	}
+
+	for (int i = 0; i < _queue_count; i++) {
+		if (_queue[i] == key) {
+			return;
+		}
+	}
+
+	if (_queue_count < QUEUE_SIZE) {
+		_queue[_queue_count++] = key;
+		ScheduleNow();
+	}
+}
+
+TerrainDatabase::LookupResult TerrainDatabase::lookupLocked(const Lookup &lookup, bool conservative, float &height)
+{
+	if (isMissingLocked(lookup.key)) {
+		return LookupResult::NoData;
+	}
+
+	Tile *tile = findLocked(lookup.key);
+
+	if ((tile == nullptr) || (tile->state == TileState::Loading)) {
+		_misses++;
+		return LookupResult::NotCached;
+	}
+
+	tile->last_used = ++_use_counter;
+	_hits++;
+
+	if (tile->state != TileState::Valid) {
+		return LookupResult::NoData;
+	}
+
+	const int row = math::min((int)lookup.row, TILE_INTERVALS - 1);
+	const int col = math::min((int)lookup.col, TILE_INTERVALS - 1);
+	const int16_t *s = &tile->samples[row * TILE_SAMPLES + col];
+	const int16_t h00 = s[0];
+	const int16_t h01 = s[1];
+	const int16_t h10 = s[TILE_SAMPLES];
+	const int16_t h11 = s[TILE_SAMPLES + 1];
+
+	if ((h00 == NO_DATA) || (h01 == NO_DATA) || (h10 == NO_DATA) || (h11 == NO_DATA)) {
+		return LookupResult::NoData;
+	}
+
+	if (conservative) {
+		height = math::max(math::max(h00, h01), math::max(h10, h11));
+
+	} else {
+		const float fy = lookup.row - row;
+		const float fx = lookup.col - col;
+		height = (h00 * (1.f - fx) + h01 * fx) * (1.f - fy) + (h10 * (1.f - fx) + h11 * fx) * fy;
+	}
+
+	return LookupResult::Found;
+}
+
+TerrainDatabase::LookupResult TerrainDatabase::get(const Lookup &lookup, bool conservative, bool wait, float &height)
+{
+	pthread_mutex_lock(&_mutex);
+	LookupResult result = lookupLocked(lookup, conservative, height);
+
+	if ((result == LookupResult::NotCached) && !wait) {
+		queueLocked(lookup.key);
+	}
+
+	pthread_mutex_unlock(&_mutex);
+
+	// the work queue might be loading the tile already, give it a moment
+	for (int attempt = 0; (result == LookupResult::NotCached) && wait && (attempt < 100); attempt++) {
+		load(lookup.key);
+
+		pthread_mutex_lock(&_mutex);
+		result = lookupLocked(lookup, conservative, height);
+		pthread_mutex_unlock(&_mutex);
+
+		if (result == LookupResult::NotCached) {
+			px4_usleep(1000);
+		}
+	}
+
+	return result;
+}
+
+bool TerrainDatabase::terrainHeight(double lat, double lon, float &height, bool wait)
+{
+	Lookup lookup;
+	return toLookup(lat, lon, lookup) && (get(lookup, false, wait, height) == LookupResult::Found);
+}
+
+bool TerrainDatabase::pathClearance(double lat_start, double lon_start, float alt_start,
+				   double lat_end, double lon_end, float alt_end, float &clearance, bool wait)
+{
+	const float distance = get_distance_to_next_waypoint(lat_start, lon_start, lat_end, lon_end);
+	const int steps = math::constrain((int)ceilf(distance / PATH_SAMPLE_DISTANCE), 1, PATH_MAX_SAMPLES);
+
+	bool complete = true;
+	clearance = INFINITY;
+
+	for (int i = 0; i <= steps; i++) {
+		const float t = (float)i / steps;
+		Lookup lookup;
+		float height = NAN;
+
+		// linear in latitude and longitude is accurate enough over the distances flown
+		if (!toLookup(lat_start + t * (lat_end - lat_start), lon_start + t * (lon_end - lon_start), lookup)
+		    || (get(lookup, true, wait, height) != LookupResult::Found)) {
+			// keep going to queue all missing tiles along the path
+			complete = false;
+			continue;
+		}
+
+		clearance = math::min(clearance, alt_start + t * (alt_end - alt_start) - height);
+	}
+
+	return complete;
+}
+
+void TerrainDatabase::prefetchPath(double lat_start, double lon_start, double lat_end, double lon_end)
+{
+	const float distance = get_distance_to_next_waypoint(lat_start, lon_start, lat_end, lon_end);
+
+	// half a tile in latitude, so that no tile along the path is skipped
+	const float step = 111000.f / TILES_PER_DEGREE / 2.f;
+	const int steps = math::constrain((int)ceilf(distance / step), 1, PATH_MAX_SAMPLES);
+	uint32_t last_key = INVALID_KEY;
+	int tiles = 0;
+
+	pthread_mutex_lock(&_mutex);
+
+	// tiles beyond the cache size would only evict the ones closer to the start
+	for (int i = 0; (i <= steps) && (tiles < _cache_tiles); i++) {
+		const float t = (float)i / steps;
+		Lookup lookup;
+
+		if (toLookup(lat_start + t * (lat_end - lat_start), lon_start + t * (lon_end - lon_start), lookup)
+		    && (lookup.key != last_key)) {
+			queueLocked(lookup.key);
+			last_key = lookup.key;
+			tiles++;
+		}
+	}
+
+	pthread_mutex_unlock(&_mutex);
+}
+
+void TerrainDatabase::Run()
+{
+	while (true) {
+		pthread_mutex_lock(&_mutex);
+
+		if (_queue_count == 0) {
+			pthread_mutex_unlock(&_mutex);
+			return;
+		}
+
+		const uint32_t key = _queue[0];
+		_queue_count--;
+		memmove(&_queue[0], &_queue[1], _queue_count * sizeof(_queue[0]));
+
+		pthread_mutex_unlock(&_mutex);
+
+		load(key);
+	}
+}
+
+void TerrainDatabase::load(uint32_t key)
+{
+	pthread_mutex_lock(&_mutex);
+
+	if (_tiles == nullptr) {
+		_tiles = new Tile[_cache_tiles];
+
+		if (_tiles == nullptr) {
+			pthread_mutex_unlock(&_mutex);
+			PX4_ERR("terrain cache allocation failed");
+			return;
+		}
+	}
+
+	if (findLocked(key) || isMissingLocked(key)) {
+		pthread_mutex_unlock(&_mutex);
+		return;
+	}
+
+	// evict the least recently used tile, tiles being loaded stay
+	Tile *tile = nullptr;
+
+	for (int i = 0; i < _cache_tiles; i++) {
+		if (_tiles[i].state == TileState::Loading) {
+			continue;
+		}
+
+		if ((tile == nullptr) || (_tiles[i].state == TileState::Empty)
+		    || ((tile->state != TileState::Empty) && (_tiles[i].last_used < tile->last_used))) {
+			tile = &_tiles[i];
+		}
+	}
+
+	if (tile == nullptr) {
+		pthread_mutex_unlock(&_mutex);
+		return;
+	}
+
+	tile->key = key;
+	tile->state = TileState::Loading;
+	tile->last_used = ++_use_counter;
+
+	pthread_mutex_unlock(&_mutex);
+
+	// the slot is reserved, read without holding the lock
+	perf_begin(_load_perf);
+	const ReadResult result = readTile(key, tile->samples);
+	perf_end(_load_perf);
+
+	pthread_mutex_lock(&_mutex);
+
+	switch (result) {
+	case ReadResult::Valid:
+		tile->state = TileState::Valid;
+		_loads++;
+		break;
+
+	case ReadResult::NoData:
+		tile->state = TileState::NoData;
+		_loads++;
+		break;
+
+	case ReadResult::Corrupt:
+		// must not be used, but also not be retried all the time
+		tile->state = TileState::NoData;
+		_errors++;
+		break;
+
+	case ReadResult::MissingFile:
+		// remember the cell instead of caching its tiles
+		tile->state = TileState::Empty;
+		tile->key = INVALID_KEY;
+		_missing_cells[_missing_cells_next] = key & ~0x3ffu;
+		_missing_cells_next = (_missing_cells_next + 1) % MISSING_CELLS;
+		break;
+	}
+
+	pthread_mutex_unlock(&_mutex);
+}
+
+TerrainDatabase::ReadResult TerrainDatabase::readTile(uint32_t key, int16_t *samples)
+{
+	const int lat = cellLat(key);
+	const int lon = cellLon(key);
+
+	char path[64];
+	snprintf(path, sizeof(path), "%s/%c%02d%c%03d.ter", _directory, lat >= 0 ? 'N' : 'S', abs(lat),
+		 lon >= 0 ? 'E' : 'W', abs(lon));
+
+	int fd = ::open(path, O_RDONLY);
+
+	if (fd < 0) {
+		return ReadResult::MissingFile;
+	}
+
+	FileHeader header{};
+	uint32_t offset = 0;
+	uint32_t crc = 0;
+	bool valid = (::read(fd, &header, sizeof(header)) == sizeof(header))
+		     && (header.magic == FILE_MAGIC) && (header.version == FILE_VERSION)
+		     && (header.tiles_per_degree == TILES_PER_DEGREE) && (header.lat_deg == lat) && (header.lon_deg == lon);
+
+	if (valid) {
+		valid = (::lseek(fd, sizeof(header) + tileIndex(key) * sizeof(offset), SEEK_SET) >= 0)
+			&& (::read(fd, &offset, sizeof(offset)) == sizeof(offset));
+	}
+
+	// a tile without data is a valid part of the database, e.g. over the sea
+	const bool no_data = valid && (offset == 0);
+
+	if (valid && !no_data) {
+		const ssize_t size = TILE_SAMPLES * TILE_SAMPLES * sizeof(samples[0]);
+		valid = (::lseek(fd, offset, SEEK_SET) >= 0)
+			&& (::read(fd, samples, size) == size)
+			&& (::read(fd, &crc, sizeof(crc)) == sizeof(crc))
+			&& (crc32part((const uint8_t *)samples, size, 0) == crc);
+	}
+
+	::close(fd);
+
+	if (!valid) {
+		PX4_ERR("invalid terrain tile %d in %s", tileIndex(key), path);
+		return ReadResult::Corrupt;
+	}
+
+	return no_data ? ReadResult::NoData : ReadResult::Valid;
+}
+
+void TerrainDatabase::printStatus()
+{
+	pthread_mutex_lock(&_mutex);
+
+	int cached = 0;
+
+	for (int i = 0; (_tiles != nullptr) && (i < _cache_tiles); i++) {
+		cached += (_tiles[i].state == TileState::Valid) ? 1 : 0;
+	}
+
+	PX4_INFO("terrain database %s: %d/%d tiles cached, %" PRIu32 " hits, %" PRIu32 " misses, %" PRIu32 " loads, %" PRIu32
+		 " errors", enabled() ? "enabled" : "disabled", cached, _cache_tiles, _hits, _misses, _loads, _errors);
+
+	pthread_mutex_unlock(&_mutex);
+
+	perf_print_counter(_load_perf);
+}
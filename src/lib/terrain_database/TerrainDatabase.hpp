@@ -0,0 +1,226 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file TerrainDatabase.hpp
+ *
+ * Terrain heights from a tiled elevation database on the storage device.
+ *
+ * The database is a directory with one file per 1x1 degree cell, named after the
+ * south-west corner of the cell, e.g. N47E008.ter covers 47..48N and 8..9E. A file
+ * starts with a FileHeader, followed by the tile index (TILES_PER_DEGREE^2 uint32
+ * file offsets, row major from the south-west, 0 for tiles without data) and the
+ * tiles. A tile is a TileData grid of TILE_SAMPLES x TILE_SAMPLES heights, also row
+ * major from the south-west. Neighbouring tiles share their edge samples, so a
+ * lookup never needs more than one tile.
+ *
+ * Lookups are answered from a fixed size LRU cache. Tiles that are not cached are
+ * loaded on the low priority work queue, lookups only block on the storage if
+ * explicitly asked to.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include <lib/perf/perf_counter.h>
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+
+class TerrainDatabase : public ModuleParams, public px4::ScheduledWorkItem
+{
+public:
+	static constexpr uint32_t FILE_MAGIC = 0x44545850; // "PXTD"
+	static constexpr uint16_t FILE_VERSION = 1;
+	static constexpr int TILES_PER_DEGREE = 32;
+	static constexpr int TILE_INTERVALS = 32;
+	static constexpr int TILE_SAMPLES = TILE_INTERVALS + 1; ///< ~108 m sample spacing in latitude
+	static constexpr int16_t NO_DATA = INT16_MIN;
+
+	struct __attribute__((packed)) FileHeader {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t tiles_per_degree;
+		int16_t lat_deg;	///< south edge of the cell
+		int16_t lon_deg;	///< west edge of the cell
+		uint32_t reserved;
+	};
+
+	struct __attribute__((packed)) TileData {
+		int16_t samples[TILE_SAMPLES * TILE_SAMPLES];	///< heights AMSL [m], NO_DATA if unknown
+		uint32_t crc;					///< crc32 of the samples
+	};
+
+	/**
+	 * @param parent parameter parent
+	 * @param cache_tiles number of tiles kept in RAM, each takes about 2.2 kB
+	 * @param directory database location
+	 */
+	TerrainDatabase(ModuleParams *parent, int cache_tiles, const char *directory = PX4_STORAGEDIR "/terrain");
+	~TerrainDatabase() override;
+
+	TerrainDatabase(const TerrainDatabase &) = delete;
+	TerrainDatabase &operator=(const TerrainDatabase &) = delete;
+
+	/**
+	 * @return true if the database is enabled by TDB_EN
+	 */
+	bool enabled() const { return _param_tdb_en.get(); }
+
+	/**
+	 * @return minimum clearance above the terrain for missions and RTL [m]
+	 */
+	float minClearance() const { return _param_tdb_clearance.get(); }
+
+	/**
+	 * Get the terrain height at a position.
+	 *
+	 * @param lat latitude [deg]
+	 * @param lon longitude [deg]
+	 * @param height bilinearly interpolated terrain height AMSL [m]
+	 * @param wait load a missing tile synchronously instead of queueing it for the work queue
+	 * @return false if the database has no data for the position, or it is not loaded yet
+	 */
+	bool terrainHeight(double lat, double lon, float &height, bool wait = false);
+
+	/**
+	 * Get the minimum clearance above the terrain along a straight path, with the altitude
+	 * changing linearly from start to end. The terrain is sampled conservatively, the highest
+	 * sample of each grid cell counts.
+	 *
+	 * @param clearance minimum altitude above the terrain along the path [m], INFINITY if nothing is known
+	 * @param wait load missing tiles synchronously instead of queueing them for the work queue
+	 * @return false if the terrain is not known for the whole path, clearance then covers the known part
+	 */
+	bool pathClearance(double lat_start, double lon_start, float alt_start,
+			   double lat_end, double lon_end, float alt_end, float &clearance, bool wait = false);
+
+	/**
+	 * Queue the tiles along a straight path for loading on the work queue.
+	 */
+	void prefetchPath(double lat_start, double lon_start, double lat_end, double lon_end);
+
+	void printStatus();
+
+private:
+	static constexpr uint32_t INVALID_KEY = UINT32_MAX;
+	static constexpr int QUEUE_SIZE = 8;
+	static constexpr int MISSING_CELLS = 4;
+	static constexpr float PATH_SAMPLE_DISTANCE = 50.f;	///< [m]
+	static constexpr int PATH_MAX_SAMPLES = 500;
+
+	enum class TileState : uint8_t {
+		Empty,
+		Loading,
+		Valid,
+		NoData		///< tile not in the database or failed to load
+	};
+
+	struct Tile {
+		uint32_t key{INVALID_KEY};
+		uint32_t last_used{0};
+		TileState state{TileState::Empty};
+		int16_t samples[TILE_SAMPLES * TILE_SAMPLES];
+	};
+
+	struct Lookup {
+		uint32_t key;
+		float row;	///< position within the tile in samples, from the south edge
+		float col;	///< position within the tile in samples, from the west edge
+	};
+
+	enum class ReadResult {
+		Valid,
+		NoData,
+		Corrupt,
+		MissingFile
+	};
+
+	enum class LookupResult {
+		Found,
+		NoData,
+		NotCached
+	};
+
+	void Run() override;
+
+	static bool toLookup(double lat, double lon, Lookup &lookup);
+	static int cellLat(uint32_t key) { return (int)(key >> 24) - 90; }
+	static int cellLon(uint32_t key) { return (int)((key >> 10) & 0x3ff) - 180; }
+	static int tileIndex(uint32_t key) { return key & 0x3ff; }
+
+	LookupResult lookupLocked(const Lookup &lookup, bool conservative, float &height);
+	Tile *findLocked(uint32_t key);
+	bool isMissingLocked(uint32_t key) const;
+	void queueLocked(uint32_t key);
+
+	/**
+	 * Load a tile into the cache, evicting the least recently used one.
+	 * Does nothing if the tile is already cached or being loaded.
+	 */
+	void load(uint32_t key);
+	ReadResult readTile(uint32_t key, int16_t *samples);
+
+	/**
+	 * Look up a height, loading the tile synchronously if requested.
+	 */
+	LookupResult get(const Lookup &lookup, bool conservative, bool wait, float &height);
+
+	const char *_directory;
+	const int _cache_tiles;
+	Tile *_tiles{nullptr};	///< allocated on first use
+
+	pthread_mutex_t _mutex;
+	uint32_t _use_counter{0};
+
+	uint32_t _queue[QUEUE_SIZE] {};
+	int _queue_count{0};
+
+	uint32_t _missing_cells[MISSING_CELLS] {};	///< cells without a file, as tile key without the tile index
+	int _missing_cells_next{0};
+
+	uint32_t _hits{0};
+	uint32_t _misses{0};
+	uint32_t _loads{0};
+	uint32_t _errors{0};
+
+	perf_counter_t _load_perf{perf_alloc(PC_ELAPSED, "terrain_database: load")};
+
+	DEFINE_PARAMETERS(
+		(ParamBool<px4::params::TDB_EN>) _param_tdb_en,
+		(ParamFloat<px4::params::TDB_CLEARANCE>) _param_tdb_clearance
+	)
+};
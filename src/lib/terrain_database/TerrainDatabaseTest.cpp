@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include "TerrainDatabase.hpp"
+
+#include <crc32.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+// to run: make tests TESTFILTER=TerrainDatabase
+
+static constexpr const char *TEST_DIRECTORY = "terrain_database_test";
+static constexpr int N = TerrainDatabase::TILES_PER_DEGREE;
+static constexpr int S = TerrainDatabase::TILE_SAMPLES;
+
+class TerrainDatabaseTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		mkdir(TEST_DIRECTORY, 0777);
+
+		// cell 47N 8E: tile 0 is a slope, tile 1 is flat at 500 m, tile 2 is corrupt, all others have no data
+		TerrainDatabase::FileHeader header{};
+		header.magic = TerrainDatabase::FILE_MAGIC;
+		header.version = TerrainDatabase::FILE_VERSION;
+		header.tiles_per_degree = N;
+		header.lat_deg = 47;
+		header.lon_deg = 8;
+
+		uint32_t index[N * N] {};
+		TerrainDatabase::TileData tiles[3] {};
+
+		for (int row = 0; row < S; row++) {
+			for (int col = 0; col < S; col++) {
+				tiles[0].samples[row * S + col] = row * 10 + col;
+				tiles[1].samples[row * S + col] = 500;
+				tiles[2].samples[row * S + col] = 100;
+			}
+		}
+
+		for (int i = 0; i < 3; i++) {
+			tiles[i].crc = crc32part((const uint8_t *)tiles[i].samples, sizeof(tiles[i].samples), 0);
+			index[i] = sizeof(header) + sizeof(index) + i * sizeof(TerrainDatabase::TileData);
+		}
+
+		tiles[2].crc++;
+
+		FILE *file = fopen("terrain_database_test/N47E008.ter", "wb");
+		ASSERT_NE(file, nullptr);
+		fwrite(&header, sizeof(header), 1, file);
+		fwrite(index, sizeof(index), 1, file);
+		fwrite(tiles, sizeof(tiles), 1, file);
+		fclose(file);
+	}
+
+	void TearDown() override
+	{
+		unlink("terrain_database_test/N47E008.ter");
+		rmdir(TEST_DIRECTORY);
+	}
+
+	// position of a sample in the cell 47N 8E
+	static double lat(int tile_row, float sample_row) { return 47.0 + (tile_row + sample_row / (S - 1)) / N; }
+	static double lon(int tile_col, float sample_col) { return 8.0 + (tile_col + sample_col / (S - 1)) / N; }
+};
+
+TEST_F(TerrainDatabaseTest, interpolation)
+{
+	// GIVEN: a database
+	TerrainDatabase terrain(nullptr, 4, TEST_DIRECTORY);
+	float height = NAN;
+
+	// WHEN: we look up a sample of the slope
+	// THEN: we get its value
+	EXPECT_TRUE(terrain.terrainHeight(lat(0, 2.f), lon(0, 3.f), height, true));
+	EXPECT_NEAR(height, 23.f, 0.01f);
+
+	// WHEN: we look up a position between samples
+	// THEN: it is interpolated bilinearly
+	EXPECT_TRUE(terrain.terrainHeight(lat(0, 2.5f), lon(0, 3.25f), height, true));
+	EXPECT_NEAR(height, 28.25f, 0.01f);
+
+	// WHEN: we look up the flat tile
+	EXPECT_TRUE(terrain.terrainHeight(lat(0, 10.f), lon(1, 10.f), height, true));
+	EXPECT_NEAR(height, 500.f, 0.01f);
+}
+
+TEST_F(TerrainDatabaseTest, noData)
+{
+	TerrainDatabase terrain(nullptr, 4, TEST_DIRECTORY);
+	float height = NAN;
+
+	// tile without data
+	EXPECT_FALSE(terrain.terrainHeight(lat(5, 1.f), lon(5, 1.f), height, true));
+
+	// tile with a wrong checksum
+	EXPECT_FALSE(terrain.terrainHeight(lat(0, 1.f), lon(2, 1.f), height, true));
+
+	// cell without a file
+	EXPECT_FALSE(terrain.terrainHeight(46.5, 8.5, height, true));
+
+	// invalid position
+	EXPECT_FALSE(terrain.terrainHeight(91.0, 8.5, height, true));
+}
+
+TEST_F(TerrainDatabaseTest, leastRecentlyUsedEviction)
+{
+	// GIVEN: a cache for a single tile, holding tile 0
+	TerrainDatabase terrain(nullptr, 1, TEST_DIRECTORY);
+	float height = NAN;
+	EXPECT_TRUE(terrain.terrainHeight(lat(0, 1.f), lon(0, 1.f), height, true));
+	EXPECT_TRUE(terrain.terrainHeight(lat(0, 1.f), lon(0, 1.f), height));
+
+	// WHEN: tile 1 is loaded
+	EXPECT_TRUE(terrain.terrainHeight(lat(0, 1.f), lon(1, 1.f), height, true));
+
+	// THEN: tile 0 is not cached anymore
+	EXPECT_FALSE(terrain.terrainHeight(lat(0, 1.f), lon(0, 1.f), height));
+}
+
+TEST_F(TerrainDatabaseTest, pathClearance)
+{
+	TerrainDatabase terrain(nullptr, 4, TEST_DIRECTORY);
+	float clearance = NAN;
+
+	// WHEN: we fly level across the flat tile
+	EXPECT_TRUE(terrain.pathClearance(lat(0, 5.f), lon(1, 1.f), 520.f, lat(0, 25.f), lon(1, 30.f), 520.f, clearance, true));
+
+	// THEN: the clearance is the altitude above it
+	EXPECT_NEAR(clearance, 20.f, 0.01f);
+
+	// WHEN: we descend along the slope to the south-west corner
+	EXPECT_TRUE(terrain.pathClearance(lat(0, 30.f), lon(0, 30.f), 700.f, lat(0, 0.f), lon(0, 0.f), 10.f, clearance, true));
+
+	// THEN: the clearance is the smallest one, at the end of the path
+	EXPECT_NEAR(clearance, 10.f - 11.f, 0.5f);
+
+	// WHEN: the path crosses a tile without data
+	// THEN: the terrain is unknown
+	EXPECT_FALSE(terrain.pathClearance(lat(0, 5.f), lon(1, 5.f), 520.f, lat(5, 5.f), lon(1, 5.f), 520.f, clearance, true));
+}
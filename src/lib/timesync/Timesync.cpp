@@ -53,6 +53,9 @@ void Timesync::update(const uint64_t now_us, const int64_t remote_timestamp_ns,
 		// Calculate the round trip time (RTT) it took the timesync packet to bounce back to us from remote system
 		uint64_t rtt_us = now_us - (originate_timestamp_ns / 1000ULL);
 
+		_round_trip_time = (rtt_us < UINT32_MAX) ? rtt_us : UINT32_MAX;
+		_round_trip_time_samples++;
+
 		// Calculate the difference of this sample from the current estimate
 		uint64_t deviation = llabs((int64_t)_time_offset - offset_us);
 
@@ -73,21 +76,8 @@ void Timesync::update(const uint64_t now_us, const int64_t remote_timestamp_ns,
 
 			} else {
 
-				// Filter gain scheduling
-				if (!sync_converged()) {
-					// Interpolate with a sigmoid function
-					double progress = (double)_sequence / (double)CONVERGENCE_WINDOW;
-					double p = 1.0 - exp(0.5 * (1.0 - 1.0 / (1.0 - progress)));
-					_filter_alpha = p * ALPHA_GAIN_FINAL + (1.0 - p) * ALPHA_GAIN_INITIAL;
-					_filter_beta = p * BETA_GAIN_FINAL + (1.0 - p) * BETA_GAIN_INITIAL;
-
-				} else {
-					_filter_alpha = ALPHA_GAIN_FINAL;
-					_filter_beta = BETA_GAIN_FINAL;
-				}
-
 				// Perform filter update
-				add_sample(offset_us);
+				add_sample(now_us, offset_us, rtt_us);
 
 				// Increment sequence counter after filter update
 				_sequence++;
@@ -132,24 +122,45 @@ uint64_t Timesync::sync_stamp(uint64_t usec)
 	}
 }
 
-void Timesync::add_sample(int64_t offset_us)
+void Timesync::add_sample(uint64_t now_us, int64_t offset_us, uint64_t rtt_us)
 {
-	// Online exponential smoothing filter. The derivative of the estimate is also
-	// estimated in order to produce an estimate without steady state lag:
-	// https://en.wikipedia.org/wiki/Exponential_smoothing#Double_exponential_smoothing
-	double time_offset_prev = _time_offset;
+	// The one way delays are unknown, the true offset is anywhere within +-RTT/2 of the
+	// sample: use the variance of a uniform distribution over that interval
+	const double rtt = (double)rtt_us;
+	const double sample_var = fmax(rtt * rtt / 12.0, MIN_OFFSET_SAMPLE_STD * MIN_OFFSET_SAMPLE_STD);
 
 	if (_sequence == 0) {
 		// First offset sample
 		_time_offset = offset_us;
+		_time_skew = 0.0;
+		_offset_var = sample_var;
+		_offset_skew_cov = 0.0;
+		_skew_var = SKEW_INITIAL_STD * SKEW_INITIAL_STD;
+		_last_sample_us = now_us;
+		return;
+	}
 
-	} else {
-		// Update the clock offset estimate
-		_time_offset = _filter_alpha * offset_us + (1.0 - _filter_alpha) * (_time_offset + _time_skew);
+	// Prediction, the skew (ppm) is the drift of the offset in us per second
+	const double dt = (double)(now_us - _last_sample_us) * 1e-6;
+	_last_sample_us = now_us;
 
-		// Update the clock skew estimate
-		_time_skew = _filter_beta * (_time_offset - time_offset_prev) + (1.0 - _filter_beta) * _time_skew;
-	}
+	_time_offset += _time_skew * dt;
+	_offset_var += dt * (2.0 * _offset_skew_cov + dt * _skew_var) + OFFSET_NOISE_PSD * dt;
+	_offset_skew_cov += dt * _skew_var;
+	_skew_var += SKEW_NOISE_PSD * dt;
+
+	// Correction with the offset sample
+	const double innovation_var = _offset_var + sample_var;
+	const double k_offset = _offset_var / innovation_var;
+	const double k_skew = _offset_skew_cov / innovation_var;
+	const double innovation = (double)offset_us - _time_offset;
+
+	_time_offset += k_offset * innovation;
+	_time_skew += k_skew * innovation;
+
+	_skew_var -= k_skew * _offset_skew_cov;
+	_offset_skew_cov -= k_offset * _offset_skew_cov;
+	_offset_var -= k_offset * _offset_var;
 }
 
 void Timesync::reset_filter()
@@ -158,8 +169,10 @@ void Timesync::reset_filter()
 	_sequence = 0;
 	_time_offset = 0.0;
 	_time_skew = 0.0;
-	_filter_alpha = ALPHA_GAIN_INITIAL;
-	_filter_beta = BETA_GAIN_INITIAL;
+	_offset_var = 0.0;
+	_offset_skew_cov = 0.0;
+	_skew_var = 0.0;
+	_last_sample_us = 0;
 	_high_deviation_count = 0;
 	_high_rtt_count = 0;
 }
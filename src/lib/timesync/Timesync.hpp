@@ -52,28 +52,27 @@ using namespace time_literals;
 
 static constexpr time_t PX4_EPOCH_SECS = 1234567890ULL;
 
-// Filter gains
+// Offset and skew estimator
 //
-// Alpha : Used to smooth the overall clock offset estimate. Smaller values will lead
-// to a smoother estimate, but track time drift more slowly, introducing a bias
-// in the estimate. Larger values will cause low-amplitude oscillations.
+// The clock offset and skew are estimated with a two state Kalman filter, with the time
+// between the samples in the prediction, so that the estimate stays accurate at low
+// timesync rates.
 //
-// Beta : Used to smooth the clock skew estimate. Smaller values will lead to a
-// tighter estimation of the skew (derivative), but will negatively affect how fast the
-// filter reacts to clock skewing (e.g cause by temperature changes to the oscillator).
-// Larger values will cause large-amplitude oscillations.
-static constexpr double ALPHA_GAIN_INITIAL = 0.05;
-static constexpr double BETA_GAIN_INITIAL = 0.05;
-static constexpr double ALPHA_GAIN_FINAL = 0.003;
-static constexpr double BETA_GAIN_FINAL = 0.003;
-
-// Filter gain scheduling
+// OFFSET_NOISE_PSD : offset random walk, covers oscillator phase noise and jitter (us^2/s).
+// SKEW_NOISE_PSD : skew random walk, covers the drift of the oscillators with temperature (ppm^2/s).
+// SKEW_INITIAL_STD : uncertainty of the skew at start (ppm), covers the tolerance of two crystals.
+// MIN_OFFSET_SAMPLE_STD : lower bound of the offset sample noise (us). The noise of a sample is
+// derived from its round-trip time, as the asymmetry of the two paths is unknown.
 //
-// The filter interpolates between the INITIAL and FINAL gains while the number of
-// exhanged timesync packets is less than CONVERGENCE_WINDOW. A lower value will
-// allow the timesync to converge faster, but with potentially less accurate initial
-// offset and skew estimates.
-static constexpr uint32_t CONVERGENCE_WINDOW = 500;
+// The estimate is converged after at least CONVERGENCE_MIN_SAMPLES samples once the offset
+// standard deviation drops below CONVERGENCE_OFFSET_STD.
+static constexpr double OFFSET_NOISE_PSD = 25.0;
+static constexpr double SKEW_NOISE_PSD = 0.05 * 0.05;
+static constexpr double SKEW_INITIAL_STD = 100.0;
+static constexpr double MIN_OFFSET_SAMPLE_STD = 10.0;
+
+static constexpr uint32_t CONVERGENCE_MIN_SAMPLES = 10;
+static constexpr double CONVERGENCE_OFFSET_STD = 500.0;
 
 // Outlier rejection and filter reset
 //
@@ -110,10 +109,23 @@ public:
 	 * Return true if the timesync algorithm converged to a good estimate,
 	 * return false otherwise
 	 */
-	bool sync_converged() const { return _sequence >= CONVERGENCE_WINDOW; }
+	bool sync_converged() const
+	{
+		return (_sequence >= CONVERGENCE_MIN_SAMPLES) && (_offset_var < CONVERGENCE_OFFSET_STD * CONVERGENCE_OFFSET_STD);
+	}
+
+	/**
+	 * Round trip time of the last timesync exchange (usec), including samples rejected by the filter
+	 */
+	uint32_t round_trip_time() const { return _round_trip_time; }
 
 	/**
-	 * Reset the exponential filter and its states
+	 * Number of round trip time samples, to detect new ones
+	 */
+	uint32_t round_trip_time_samples() const { return _round_trip_time_samples; }
+
+	/**
+	 * Reset the filter and its states
 	 */
 	void reset_filter();
 
@@ -121,24 +133,29 @@ public:
 private:
 
 	/**
-	 * Online exponential filter to smooth time offset
+	 * Kalman filter update with an offset sample
 	 */
-	void add_sample(int64_t offset_us);
+	void add_sample(uint64_t now_us, int64_t offset_us, uint64_t rtt_us);
 	uORB::PublicationMulti<timesync_status_s>  _timesync_status_pub{ORB_ID(timesync_status)};
 
 	uint32_t _sequence{0};
 
 	// Timesync statistics
-	double _time_offset{0};
-	double _time_skew{0};
+	double _time_offset{0};	// us
+	double _time_skew{0};	// ppm
 
-	// Filter parameters
-	double _filter_alpha{ALPHA_GAIN_INITIAL};
-	double _filter_beta{BETA_GAIN_INITIAL};
+	// Filter covariance
+	double _offset_var{0};
+	double _offset_skew_cov{0};
+	double _skew_var{0};
+	uint64_t _last_sample_us{0};
 
 	// Outlier rejection and filter reset
 	uint32_t _high_deviation_count{0};
 	uint32_t _high_rtt_count{0};
 
+	uint32_t _round_trip_time{0};
+	uint32_t _round_trip_time_samples{0};
+
 	uint8_t _source{};
 };
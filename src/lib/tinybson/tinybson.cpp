@@ -59,6 +59,35 @@ read_x(bson_decoder_t decoder, void *p, size_t s)
 {
 	CODER_CHECK(decoder);
 
+	/* bson buffered file decoder */
+	if (decoder->fd > -1 && decoder->buf != nullptr) {
+		uint8_t *dst = (uint8_t *)p;
+
+		while (s > 0) {
+			if (decoder->bufpos >= decoder->buflen) {
+				int ret = ::read(decoder->fd, decoder->buf, decoder->bufsize);
+
+				if (ret <= 0) {
+					return -1;
+				}
+
+				decoder->buflen = ret;
+				decoder->bufpos = 0;
+			}
+
+			const size_t buffered = decoder->buflen - decoder->bufpos;
+			const size_t n = (s < buffered) ? s : buffered;
+			memcpy(dst, decoder->buf + decoder->bufpos, n);
+			decoder->bufpos += n;
+			decoder->total_decoded_size += n;
+			dst += n;
+			s -= n;
+		}
+
+		return 0;
+	}
+
+	/* bson file decoder (non-buffered) */
 	if (decoder->fd > -1) {
 		int ret = ::read(decoder->fd, p, s);
 
@@ -133,6 +162,22 @@ bson_decoder_init_file(bson_decoder_t decoder, int fd, bson_decoder_callback cal
 	return 0;
 }
 
+int
+bson_decoder_init_buf_file(bson_decoder_t decoder, int fd, void *buf, unsigned bufsize, bson_decoder_callback callback)
+{
+	/* argument sanity */
+	if ((buf == nullptr) || (bufsize == 0)) {
+		return -1;
+	}
+
+	decoder->buf = (uint8_t *)buf;
+	decoder->bufsize = bufsize;
+	decoder->bufpos = 0;
+	decoder->buflen = 0;
+
+	return bson_decoder_init_file(decoder, fd, callback);
+}
+
 int
 bson_decoder_init_buf(bson_decoder_t decoder, void *buf, unsigned bufsize, bson_decoder_callback callback)
 {
@@ -107,10 +107,11 @@ struct bson_decoder_s {
 	/* file reader state */
 	int			fd{-1};
 
-	/* buffer reader state */
+	/* buffer reader state (also the read buffer of the buffered file reader) */
 	uint8_t			*buf{nullptr};
 	size_t			bufsize{0};
 	unsigned		bufpos{0};
+	unsigned		buflen{0}; ///< valid bytes in buf (buffered file reader)
 
 	bool			dead{false};
 	bson_decoder_callback	callback;
@@ -139,6 +140,21 @@ struct bson_decoder_s {
  */
 __EXPORT int bson_decoder_init_file(bson_decoder_t decoder, int fd, bson_decoder_callback callback);
 
+/**
+ * Initialise the decoder to read from a file in blocks of the buffer size, instead of
+ * reading every field (and every character of a node name) from the file separately.
+ * The file position is undefined after decoding (the file is read ahead).
+ *
+ * @param decoder		Decoder state structure to be initialised.
+ * @param fd			File to read BSON data from.
+ * @param buf			Read buffer to use, can't be nullptr
+ * @param bufsize		Supplied buffer size
+ * @param callback		Callback to be invoked by bson_decoder_next
+ * @return			Zero on success.
+ */
+__EXPORT int bson_decoder_init_buf_file(bson_decoder_t decoder, int fd, void *buf, unsigned bufsize,
+					bson_decoder_callback callback);
+
 /**
  * Initialise the decoder to read from a buffer in memory.
  *
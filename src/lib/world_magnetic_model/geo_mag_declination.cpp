@@ -66,7 +66,14 @@ static unsigned get_lookup_table_index(float *val, float min, float max)
 	return static_cast<unsigned>((-(min) + *val) / SAMPLING_RES);
 }
 
-static float get_table_data(float latitude_deg, float longitude_deg, const int16_t table[LAT_DIM][LON_DIM])
+struct TableCell {
+	unsigned lat_index;
+	unsigned lon_index;
+	float lat_scale;
+	float lon_scale;
+};
+
+static TableCell get_table_cell(float latitude_deg, float longitude_deg)
 {
 	latitude_deg = math::constrain(latitude_deg, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
 
@@ -82,23 +89,44 @@ static float get_table_data(float latitude_deg, float longitude_deg, const int16
 	float min_lat = floorf(latitude_deg / SAMPLING_RES) * SAMPLING_RES;
 	float min_lon = floorf(longitude_deg / SAMPLING_RES) * SAMPLING_RES;
 
+	TableCell cell;
+
 	/* find index of nearest low sampling point */
-	unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
-	unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
+	cell.lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
+	cell.lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
+
+	/* bilinear interpolation weights within the cell */
+	cell.lat_scale = constrain((latitude_deg - min_lat) / SAMPLING_RES, 0.f, 1.f);
+	cell.lon_scale = constrain((longitude_deg - min_lon) / SAMPLING_RES, 0.f, 1.f);
 
-	const float data_sw = table[min_lat_index][min_lon_index];
-	const float data_se = table[min_lat_index][min_lon_index + 1];
-	const float data_ne = table[min_lat_index + 1][min_lon_index + 1];
-	const float data_nw = table[min_lat_index + 1][min_lon_index];
+	return cell;
+}
 
+static void get_cell_corners(const TableCell &cell, const int16_t table[LAT_DIM][LON_DIM], float corners[4])
+{
+	corners[0] = table[cell.lat_index][cell.lon_index];         // sw
+	corners[1] = table[cell.lat_index][cell.lon_index + 1];     // se
+	corners[2] = table[cell.lat_index + 1][cell.lon_index + 1]; // ne
+	corners[3] = table[cell.lat_index + 1][cell.lon_index];     // nw
+}
+
+static float interpolate(const TableCell &cell, const float corners[4])
+{
 	/* perform bilinear interpolation on the four grid corners */
-	const float lat_scale = constrain((latitude_deg - min_lat) / SAMPLING_RES, 0.f, 1.f);
-	const float lon_scale = constrain((longitude_deg - min_lon) / SAMPLING_RES, 0.f, 1.f);
+	const float data_min = cell.lon_scale * (corners[1] - corners[0]) + corners[0];
+	const float data_max = cell.lon_scale * (corners[2] - corners[3]) + corners[3];
 
-	const float data_min = lon_scale * (data_se - data_sw) + data_sw;
-	const float data_max = lon_scale * (data_ne - data_nw) + data_nw;
+	return cell.lat_scale * (data_max - data_min) + data_min;
+}
 
-	return lat_scale * (data_max - data_min) + data_min;
+static float get_table_data(float latitude_deg, float longitude_deg, const int16_t table[LAT_DIM][LON_DIM])
+{
+	const TableCell cell = get_table_cell(latitude_deg, longitude_deg);
+
+	float corners[4];
+	get_cell_corners(cell, table, corners);
+
+	return interpolate(cell, corners);
 }
 
 float get_mag_declination_degrees(float latitude_deg, float longitude_deg)
@@ -125,3 +153,26 @@ float get_mag_strength_tesla(float latitude_deg, float longitude_deg)
 	return get_table_data(latitude_deg, longitude_deg, totalintensity_table)
 	       * WMM_TOTALINTENSITY_SCALE_TO_NANOTESLA * 1e-9f;
 }
+
+void get_mag_field(float latitude_deg, float longitude_deg, float &declination_deg, float &inclination_deg,
+		   float &strength_gauss, MagFieldLookupCache *cache)
+{
+	const TableCell cell = get_table_cell(latitude_deg, longitude_deg);
+
+	MagFieldLookupCache local;
+	MagFieldLookupCache &c = cache ? *cache : local;
+
+	if ((c.lat_index != static_cast<int16_t>(cell.lat_index)) || (c.lon_index != static_cast<int16_t>(cell.lon_index))) {
+		get_cell_corners(cell, declination_table, c.corners[0]);
+		get_cell_corners(cell, inclination_table, c.corners[1]);
+		get_cell_corners(cell, totalintensity_table, c.corners[2]);
+		c.lat_index = cell.lat_index;
+		c.lon_index = cell.lon_index;
+	}
+
+	declination_deg = interpolate(cell, c.corners[0]) * WMM_DECLINATION_SCALE_TO_DEGREES;
+	inclination_deg = interpolate(cell, c.corners[1]) * WMM_INCLINATION_SCALE_TO_DEGREES;
+
+	// table stored as scaled nanotesla, 1 Gauss = 1e4 Tesla
+	strength_gauss = interpolate(cell, c.corners[2]) * WMM_TOTALINTENSITY_SCALE_TO_NANOTESLA * 1e-9f * 1e4f;
+}
@@ -41,6 +41,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 // Return magnetic declination in degrees
 float get_mag_declination_degrees(float latitude_deg, float longitude_deg);
 
@@ -50,3 +52,15 @@ float get_mag_inclination_degrees(float latitude_deg, float longitude_deg);
 // return magnetic field strength in Gauss or Tesla
 float get_mag_strength_gauss(float latitude_deg, float longitude_deg);
 float get_mag_strength_tesla(float latitude_deg, float longitude_deg);
+
+// Grid cell of the last combined lookup, so repeated queries within the same cell skip the table reads.
+// Owned by the caller (e.g. one per estimator instance), so concurrent users never share state.
+struct MagFieldLookupCache {
+	int16_t lat_index{-1};
+	int16_t lon_index{-1};
+	float corners[3][4] {}; // declination, inclination, intensity (scaled table units), sw/se/ne/nw
+};
+
+// Return declination (degrees), inclination (degrees) and field strength (Gauss) from a single table lookup
+void get_mag_field(float latitude_deg, float longitude_deg, float &declination_deg, float &inclination_deg,
+		   float &strength_gauss, MagFieldLookupCache *cache = nullptr);
@@ -5086,3 +5086,25 @@ TEST(GeoLookupTest, strength)
 	EXPECT_NEAR(get_mag_strength_tesla(60, 175) * 1e9, 54170, 145 + 542);
 	EXPECT_NEAR(get_mag_strength_tesla(60, 180) * 1e9, 53929, 145 + 539);
 }
+
+TEST(GeoLookupTest, combined)
+{
+	MagFieldLookupCache cache{};
+
+	// walk across cell boundaries, the antimeridian and the poles; cached and uncached results must match the single lookups
+	for (float latitude = -90.f; latitude <= 90.f; latitude += 3.7f) {
+		for (float longitude = -185.f; longitude <= 185.f; longitude += 4.3f) {
+			float declination_deg, inclination_deg, strength_gauss;
+			get_mag_field(latitude, longitude, declination_deg, inclination_deg, strength_gauss);
+			EXPECT_EQ(declination_deg, get_mag_declination_degrees(latitude, longitude));
+			EXPECT_EQ(inclination_deg, get_mag_inclination_degrees(latitude, longitude));
+			EXPECT_EQ(strength_gauss, get_mag_strength_gauss(latitude, longitude));
+
+			float declination_cached_deg, inclination_cached_deg, strength_cached_gauss;
+			get_mag_field(latitude, longitude, declination_cached_deg, inclination_cached_deg, strength_cached_gauss, &cache);
+			EXPECT_EQ(declination_cached_deg, declination_deg);
+			EXPECT_EQ(inclination_cached_deg, inclination_deg);
+			EXPECT_EQ(strength_cached_gauss, strength_gauss);
+		}
+	}
+}
@@ -1972,9 +1972,10 @@ void Commander::run()
 
 		perf_end(_loop_perf);
 
-		// sleep if there are no vehicle_commands or action_requests to process
-		if (!_vehicle_command_sub.updated() && !_action_request_sub.updated()) {
-			px4_usleep(COMMANDER_MONITORING_INTERVAL);
+		// sleep if there are no action_requests to process, until the next vehicle_command
+		// or at most for the monitoring interval
+		if (!_action_request_sub.updated()) {
+			_vehicle_command_sub.updatedBlocking(COMMANDER_MONITORING_INTERVAL);
 		}
 	}
 
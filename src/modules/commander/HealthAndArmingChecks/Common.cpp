@@ -85,7 +85,7 @@ Report::EventBufferHeader *Report::addEventToBuffer(uint32_t event_id, const eve
 		uint32_t modes, unsigned args_size)
 {
 	unsigned total_size = sizeof(EventBufferHeader) + args_size;
-	EventBufferHeader *header = (EventBufferHeader *)(_event_buffer + _next_buffer_idx);
+	EventBufferHeader *header = (EventBufferHeader *)(eventBuffer() + _next_buffer_idx);
 	memcpy(&header->id, &event_id, sizeof(event_id)); // header might be unaligned
 	header->log_levels = ((uint8_t)log_levels.internal << 4) | (uint8_t)log_levels.external;
 	header->size = args_size;
@@ -106,13 +106,13 @@ bool Report::addExternalEvent(const event_s &event, NavModes modes)
 
 	unsigned total_size = sizeof(EventBufferHeader) + args_size;
 
-	if (total_size > sizeof(_event_buffer) - _next_buffer_idx) {
+	if (total_size > sizeof(_event_buffer[0]) - _next_buffer_idx) {
 		_buffer_overflowed = true;
 		return false;
 	}
 
 	events::LogLevels log_levels{events::externalLogLevel(event.log_levels), events::internalLogLevel((event.log_levels))};
-	memcpy(_event_buffer + _next_buffer_idx + sizeof(EventBufferHeader), &event.arguments, args_size);
+	memcpy(eventBuffer() + _next_buffer_idx + sizeof(EventBufferHeader), &event.arguments, args_size);
 	addEventToBuffer(event.id, log_levels, (uint32_t)modes, args_size);
 	return true;
 }
@@ -213,6 +213,58 @@ void Report::prepare(uint8_t vehicle_type)
 	mode_util::getModeRequirements(vehicle_type, _failsafe_flags);
 }
 
+void Report::beginCheck()
+{
+	_stashed_results = _results[_current_result];
+	_results[_current_result].reset();
+	_check_buffer_start = _next_buffer_idx;
+}
+
+void Report::endCheck(CheckResults &check_results)
+{
+	check_results.results = _results[_current_result];
+	check_results.event_buffer_start = _check_buffer_start;
+	check_results.event_buffer_end = _next_buffer_idx;
+	// events that did not fit are not in the buffer, so the results cannot be replayed
+	check_results.valid = !_buffer_overflowed;
+
+	_results[_current_result] = _stashed_results;
+	mergeResults(check_results.results);
+}
+
+bool Report::replayCheck(CheckResults &check_results)
+{
+	const int size = check_results.event_buffer_end - check_results.event_buffer_start;
+
+	if (!check_results.valid || size > (int)sizeof(_event_buffer[0]) - _next_buffer_idx) {
+		return false;
+	}
+
+	const uint8_t *previous_buffer = _event_buffer[(_current_result + 1) % 2];
+	memcpy(eventBuffer() + _next_buffer_idx, previous_buffer + check_results.event_buffer_start, size);
+
+	check_results.event_buffer_start = _next_buffer_idx;
+	_next_buffer_idx += size;
+	check_results.event_buffer_end = _next_buffer_idx;
+
+	mergeResults(check_results.results);
+	return true;
+}
+
+void Report::mergeResults(const Results &results)
+{
+	Results &current = _results[_current_result];
+	current.health.is_present = current.health.is_present | results.health.is_present;
+	current.health.error = current.health.error | results.health.error;
+	current.health.warning = current.health.warning | results.health.warning;
+	current.arming_checks.error = current.arming_checks.error | results.arming_checks.error;
+	current.arming_checks.warning = current.arming_checks.warning | results.arming_checks.warning;
+	current.arming_checks.can_arm = current.arming_checks.can_arm & results.arming_checks.can_arm;
+	current.arming_checks.can_run = current.arming_checks.can_run & results.arming_checks.can_run;
+	current.num_events += results.num_events;
+	current.event_id_hash ^= results.event_id_hash;
+}
+
 NavModes Report::getModeGroup(uint8_t nav_state) const
 {
 	// Note: this needs to match with the json metadata definition "navigation_mode_groups"
@@ -251,8 +303,6 @@ bool Report::report(bool force)
 	const Results &current_results = _results[_current_result];
 
 	// If we have too many events, the result is still correct, we just don't report everything
-	const int max_num_events = event_s::ORB_QUEUE_LENGTH - 2;
-
 	if (_buffer_overflowed || current_results.num_events > max_num_events) {
 		PX4_WARN("Too many arming check events (%i, %i > %i). Not reporting all", _buffer_overflowed,
 			 current_results.num_events, max_num_events);
@@ -290,23 +340,33 @@ bool Report::report(bool force)
 		       (navigation_mode_group_t)current_results.arming_checks.can_arm,
 		       (navigation_mode_group_t)current_results.arming_checks.can_run);
 
-	// send all events
+	// send all events, in batches
 	int offset = 0;
-	event_s event;
+	event_s batch[event_batch_size];
+	int batch_size = 0;
 
 	for (int i = 0; i < max_num_events && offset < _next_buffer_idx; ++i) {
-		EventBufferHeader *header = (EventBufferHeader *)(_event_buffer + offset);
+		EventBufferHeader *header = (EventBufferHeader *)(eventBuffer() + offset);
+		event_s &event = batch[batch_size++];
 		memcpy(&event.id, &header->id, sizeof(event.id));
 		event.log_levels = header->log_levels;
-		memcpy(event.arguments, _event_buffer + offset + sizeof(EventBufferHeader), header->size);
+		memcpy(event.arguments, eventBuffer() + offset + sizeof(EventBufferHeader), header->size);
 		memset(event.arguments + header->size, 0, sizeof(event.arguments) - header->size);
-		events::send(event);
 		offset += sizeof(EventBufferHeader) + header->size;
 #ifdef CONSOLE_PRINT_ARMING_CHECK_EVENT
 		const char *message;
 		memcpy(&message, &header->message, sizeof(header->message));
 		PX4_INFO_RAW("   Event 0x%08" PRIx32 ": %s\n", event.id, message);
 #endif
+
+		if (batch_size == event_batch_size) {
+			events::send(batch, batch_size);
+			batch_size = 0;
+		}
+	}
+
+	if (batch_size > 0) {
+		events::send(batch, batch_size);
 	}
 
 	// send health summary
@@ -41,6 +41,7 @@
 #include <uORB/topics/failsafe_flags.h>
 #include <systemlib/mavlink_log.h>
 #include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
 
 #include <stdint.h>
 #include <limits.h>
@@ -305,6 +306,18 @@ private:
 		}
 	};
 
+public:
+	/**
+	 * Cached contribution of a single check, used to skip checks whose inputs did not change.
+	 */
+	struct CheckResults {
+		Results results; ///< results of the check alone (bits and events it added)
+		uint16_t event_buffer_start{0};
+		uint16_t event_buffer_end{0};
+		bool valid{false};
+	};
+private:
+
 	struct __attribute__((__packed__)) EventBufferHeader {
 		uint8_t size; ///< arguments size
 		uint32_t id;
@@ -325,6 +338,10 @@ private:
 
 	NavModes reportedModes(NavModes required_modes);
 
+	uint8_t *eventBuffer() { return _event_buffer[_current_result]; }
+
+	void mergeResults(const Results &results);
+
 	NavModes getModeGroup(uint8_t nav_state) const;
 
 	friend class HealthAndArmingChecks;
@@ -335,6 +352,7 @@ private:
 	FRIEND_TEST(ReporterTest, arming_checks_mode_category2);
 	FRIEND_TEST(ReporterTest, reporting);
 	FRIEND_TEST(ReporterTest, reporting_multiple);
+	FRIEND_TEST(ReporterTest, replay_check);
 
 	/**
 	 * Reset current results.
@@ -353,6 +371,22 @@ private:
 
 	bool report(bool force);
 
+	/**
+	 * Isolate the results of a single check, so they can be cached and replayed later on:
+	 * - beginCheck()
+	 * - run the check
+	 * - endCheck() stores the results of the check and merges them into the current results
+	 */
+	void beginCheck();
+	void endCheck(CheckResults &check_results);
+
+	/**
+	 * Apply the cached results of a check instead of running it.
+	 * Events are copied from the previous run's buffer.
+	 * @return false if the cached results cannot be used and the check needs to run
+	 */
+	bool replayCheck(CheckResults &check_results);
+
 	/**
 	 * Send out any unreported changes if there are any
 	 */
@@ -360,9 +394,17 @@ private:
 
 	const hrt_abstime _min_reporting_interval;
 
-	/// event buffer: stores current events + arguments.
+	/// Maximum number of events per report (excluding the 2 summary events). A report uses at most half of the
+	/// event queue, so other events published at the same time do not overflow it.
+	static constexpr int max_num_events = event_s::ORB_QUEUE_LENGTH / 2 - 2;
+
+	/// Events are published in batches of this size
+	static constexpr int event_batch_size = 4;
+
+	/// event buffer: stores current events + arguments, double-buffered (like _results) so skipped checks can
+	/// copy their events from the previous run.
 	/// Since the amount of extra arguments varies, 4 bytes is used here as estimate
-	uint8_t _event_buffer[(event_s::ORB_QUEUE_LENGTH - 2) * (sizeof(EventBufferHeader) + 1 + 1 + 4)];
+	uint8_t _event_buffer[2][max_num_events * (sizeof(EventBufferHeader) + 1 + 1 + 4)];
 	int _next_buffer_idx{0};
 	bool _buffer_overflowed{false};
 
@@ -374,6 +416,9 @@ private:
 	Results _results[2]; ///< Previous and current results to check for changes
 	int _current_result{0};
 
+	Results _stashed_results; ///< accumulated results while a single check is run isolated
+	int _check_buffer_start{0};
+
 	failsafe_flags_s &_failsafe_flags;
 
 	orb_advert_t *_mavlink_log_pub{nullptr}; ///< mavlink log publication for legacy reporting
@@ -403,12 +448,12 @@ bool Report::addEvent(uint32_t event_id, const events::LogLevels &log_levels, co
 	static_assert(args_size <= sizeof(event_s::arguments), "Too many arguments");
 	unsigned total_size = sizeof(EventBufferHeader) + args_size;
 
-	if (total_size > sizeof(_event_buffer) - _next_buffer_idx) {
+	if (total_size > sizeof(_event_buffer[0]) - _next_buffer_idx) {
 		_buffer_overflowed = true;
 		return false;
 	}
 
-	events::util::fillEventArguments(_event_buffer + _next_buffer_idx + sizeof(EventBufferHeader), modes, args...);
+	events::util::fillEventArguments(eventBuffer() + _next_buffer_idx + sizeof(EventBufferHeader), modes, args...);
 	// We split out the part of the code not requiring templating to reduce flash usage a bit
 	EventBufferHeader *header = addEventToBuffer(event_id, log_levels, modes, args_size);
 #ifdef CONSOLE_PRINT_ARMING_CHECK_EVENT
@@ -432,5 +477,21 @@ public:
 
 	virtual void checkAndReport(const Context &context, Report &reporter) = 0;
 
+	/**
+	 * Dependency tracking: a check whose results only depend on its input topics, the vehicle status and
+	 * parameters overrides this and returns whether any of its input topics got updated since the last run.
+	 * Otherwise the cached results of the previous run are used (the check still runs at a low rate).
+	 * Checks that depend on time (timeouts, hysteresis) or on results of other checks keep the default
+	 * and run on every update.
+	 */
+	virtual bool inputsUpdated() { return true; }
+
 	void updateParams() override { ModuleParams::updateParams(); }
+
+private:
+	friend class HealthAndArmingChecks;
+
+	Report::CheckResults _cached_results{};
+	hrt_abstime _last_run{0};
+	perf_counter_t _perf{nullptr};
 };
@@ -49,6 +49,62 @@ HealthAndArmingChecks::HealthAndArmingChecks(ModuleParams *parent, vehicle_statu
 	_failsafe_flags.auto_mission_missing = true;
 	_failsafe_flags.offboard_control_signal_lost = true;
 	_failsafe_flags.home_position_invalid = true;
+
+	for (unsigned i = 0; i < sizeof(_checks) / sizeof(_checks[0]); ++i) {
+		if (!_checks[i].check) {
+			break;
+		}
+
+		_checks[i].check->_perf = perf_alloc(PC_ELAPSED, _checks[i].perf_name);
+	}
+}
+
+HealthAndArmingChecks::~HealthAndArmingChecks()
+{
+	for (unsigned i = 0; i < sizeof(_checks) / sizeof(_checks[0]); ++i) {
+		if (!_checks[i].check) {
+			break;
+		}
+
+		perf_free(_checks[i].check->_perf);
+	}
+}
+
+bool HealthAndArmingChecks::vehicleStatusChanged()
+{
+	// compare everything but the timestamp, the checks only see the content
+	vehicle_status_s status;
+	memcpy(&status, &_context.status(), sizeof(status));
+	status.timestamp = _last_status.timestamp;
+
+	const bool changed = memcmp(&status, &_last_status, sizeof(status)) != 0;
+	memcpy(&_last_status, &status, sizeof(status));
+	return changed;
+}
+
+void HealthAndArmingChecks::runChecks(bool run_all)
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	for (unsigned i = 0; i < sizeof(_checks) / sizeof(_checks[0]); ++i) {
+		HealthAndArmingCheckBase *check = _checks[i].check;
+
+		if (!check) {
+			break;
+		}
+
+		if (!run_all && !check->inputsUpdated() && (now < check->_last_run + CHECK_RERUN_INTERVAL)
+		    && _reporter.replayCheck(check->_cached_results)) {
+			continue;
+		}
+
+		perf_begin(check->_perf);
+		_reporter.beginCheck();
+		check->checkAndReport(_context, _reporter);
+		_reporter.endCheck(check->_cached_results);
+		perf_end(check->_perf);
+		check->_last_run = now;
+	}
 }
 
 bool HealthAndArmingChecks::update(bool force_reporting, bool is_arming_request)
@@ -62,13 +118,10 @@ bool HealthAndArmingChecks::update(bool force_reporting, bool is_arming_request)
 
 	_context.setIsArmingRequest(is_arming_request);
 
-	for (unsigned i = 0; i < sizeof(_checks) / sizeof(_checks[0]); ++i) {
-		if (!_checks[i]) {
-			break;
-		}
-
-		_checks[i]->checkAndReport(_context, _reporter);
-	}
+	// skipping checks with unchanged inputs is only valid as long as the context they see did not change
+	const bool status_changed = vehicleStatusChanged();
+	runChecks(_run_all_checks || status_changed || force_reporting || is_arming_request);
+	_run_all_checks = false;
 
 	const bool results_changed = _reporter.finalize();
 	const bool reported = _reporter.report(force_reporting);
@@ -83,14 +136,7 @@ bool HealthAndArmingChecks::update(bool force_reporting, bool is_arming_request)
 		_reporter.reset();
 
 		_reporter.prepare(vehicle_type);
-
-		for (unsigned i = 0; i < sizeof(_checks) / sizeof(_checks[0]); ++i) {
-			if (!_checks[i]) {
-				break;
-			}
-
-			_checks[i]->checkAndReport(_context, _reporter);
-		}
+		runChecks(true);
 
 		_reporter.finalize();
 		_reporter.report(false);
@@ -117,12 +163,14 @@ bool HealthAndArmingChecks::update(bool force_reporting, bool is_arming_request)
 void HealthAndArmingChecks::updateParams()
 {
 	for (unsigned i = 0; i < sizeof(_checks) / sizeof(_checks[0]); ++i) {
-		if (!_checks[i]) {
+		if (!_checks[i].check) {
 			break;
 		}
 
-		_checks[i]->updateParams();
+		_checks[i].check->updateParams();
 	}
+
+	_run_all_checks = true;
 }
 
 bool HealthAndArmingChecks::reportIfUnreportedDifferences()
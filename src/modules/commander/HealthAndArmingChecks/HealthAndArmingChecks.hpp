@@ -78,7 +78,7 @@ class HealthAndArmingChecks : public ModuleParams
 {
 public:
 	HealthAndArmingChecks(ModuleParams *parent, vehicle_status_s &status);
-	~HealthAndArmingChecks() = default;
+	~HealthAndArmingChecks();
 
 	/**
 	 * Run arming checks and report if necessary.
@@ -115,10 +115,20 @@ public:
 protected:
 	void updateParams() override;
 private:
+	static constexpr hrt_abstime CHECK_RERUN_INTERVAL{1_s}; ///< maximum age of cached results of skipped checks
+
+	/**
+	 * Run all checks. Checks with unchanged inputs are skipped and their cached results used, unless run_all is set.
+	 */
+	void runChecks(bool run_all);
+
+	bool vehicleStatusChanged();
 	failsafe_flags_s _failsafe_flags{};
 
 	Context _context;
 	Report _reporter{_failsafe_flags};
+	vehicle_status_s _last_status{}; ///< vehicle status at the previous update, to detect context changes
+	bool _run_all_checks{true}; ///< invalidates all cached check results (e.g. after parameter changes)
 	orb_advert_t _mavlink_log_pub{nullptr};
 
 	uORB::Publication<health_report_s> _health_report_pub{ORB_ID(health_report)};
@@ -161,41 +171,46 @@ private:
 	ExternalChecks _external_checks;
 #endif
 
-	HealthAndArmingCheckBase *_checks[40] = {
+	struct CheckEntry {
+		HealthAndArmingCheckBase *check;
+		const char *perf_name;
+	};
+
+	CheckEntry _checks[40] = {
 #ifndef CONSTRAINED_FLASH
-		&_external_checks,
+		{&_external_checks, "commander: external check"},
 #endif
-		&_accelerometer_checks,
-		&_airspeed_checks,
-		&_arm_permission_checks,
-		&_baro_checks,
-		&_cpu_resource_checks,
-		&_distance_sensor_checks,
-		&_optical_flow_check,
-		&_esc_checks,
-		&_estimator_checks,
-		&_failure_detector_checks,
-		&_navigator_checks,
-		&_gyro_checks,
-		&_imu_consistency_checks,
-		&_logger_checks,
-		&_magnetometer_checks,
-		&_manual_control_checks,
-		&_home_position_checks,
-		&_mission_checks,
-		&_offboard_checks, // must be after _estimator_checks
-		&_mode_checks, // must be after _estimator_checks, _home_position_checks, _mission_checks, _offboard_checks, _external_checks
-		&_open_drone_id_checks,
-		&_parachute_checks,
-		&_power_checks,
-		&_rc_calibration_checks,
-		&_sd_card_checks,
-		&_system_checks, // must be after _estimator_checks & _home_position_checks
-		&_battery_checks,
-		&_wind_checks,
-		&_geofence_checks, // must be after _home_position_checks
-		&_flight_time_checks,
-		&_rc_and_data_link_checks,
-		&_vtol_checks,
+		{&_accelerometer_checks, "commander: accelerometer check"},
+		{&_airspeed_checks, "commander: airspeed check"},
+		{&_arm_permission_checks, "commander: arm permission check"},
+		{&_baro_checks, "commander: baro check"},
+		{&_cpu_resource_checks, "commander: cpu resource check"},
+		{&_distance_sensor_checks, "commander: distance sensor check"},
+		{&_optical_flow_check, "commander: optical flow check"},
+		{&_esc_checks, "commander: esc check"},
+		{&_estimator_checks, "commander: estimator check"},
+		{&_failure_detector_checks, "commander: failure detector check"},
+		{&_navigator_checks, "commander: navigator check"},
+		{&_gyro_checks, "commander: gyro check"},
+		{&_imu_consistency_checks, "commander: imu consistency check"},
+		{&_logger_checks, "commander: logger check"},
+		{&_magnetometer_checks, "commander: magnetometer check"},
+		{&_manual_control_checks, "commander: manual control check"},
+		{&_home_position_checks, "commander: home position check"},
+		{&_mission_checks, "commander: mission check"},
+		{&_offboard_checks, "commander: offboard check"}, // must be after _estimator_checks
+		{&_mode_checks, "commander: mode check"}, // must be after _estimator_checks, _home_position_checks, _mission_checks, _offboard_checks, _external_checks
+		{&_open_drone_id_checks, "commander: open drone id check"},
+		{&_parachute_checks, "commander: parachute check"},
+		{&_power_checks, "commander: power check"},
+		{&_rc_calibration_checks, "commander: rc calibration check"},
+		{&_sd_card_checks, "commander: sd card check"},
+		{&_system_checks, "commander: system check"}, // must be after _estimator_checks & _home_position_checks
+		{&_battery_checks, "commander: battery check"},
+		{&_wind_checks, "commander: wind check"},
+		{&_geofence_checks, "commander: geofence check"}, // must be after _home_position_checks
+		{&_flight_time_checks, "commander: flight time check"},
+		{&_rc_and_data_link_checks, "commander: rc and data link check"},
+		{&_vtol_checks, "commander: vtol check"},
 	};
 };
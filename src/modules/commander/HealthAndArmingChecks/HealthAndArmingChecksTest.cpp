@@ -285,3 +285,77 @@ TEST_F(ReporterTest, reporting_multiple)
 		}
 	}
 }
+
+TEST_F(ReporterTest, replay_check)
+{
+	failsafe_flags_s failsafe_flags{};
+	Report reporter{failsafe_flags, 0_s};
+
+	uORB::Subscription event_sub{ORB_ID(event)};
+	event_sub.subscribe();
+	event_s event;
+
+	while (event_sub.update(&event)); // clear all updates
+
+	Report::CheckResults check1_results{};
+	Report::CheckResults check2_results{};
+
+	for (int i = 0; i < 3; ++i) {
+		reporter.reset();
+
+		// check 1 runs only the first time, afterwards its cached results are replayed
+		if (i == 0) {
+			reporter.beginCheck();
+			reporter.armingCheckFailure<uint16_t>(NavModes::PositionControl, health_component_t::remote_control,
+							      events::ID("arming_test_replay_check_fail1"), events::Log::Warning, "", 4938);
+			reporter.setIsPresent(health_component_t::remote_control);
+			reporter.endCheck(check1_results);
+
+		} else {
+			ASSERT_TRUE(reporter.replayCheck(check1_results));
+		}
+
+		// check 2 always runs, and fails from the second run on
+		reporter.beginCheck();
+
+		if (i > 0) {
+			reporter.healthFailure(NavModes::Mission, health_component_t::battery,
+					       events::ID("arming_test_replay_check_fail2"), events::Log::Error, "");
+		}
+
+		reporter.endCheck(check2_results);
+
+		reporter.finalize();
+		reporter.report(false);
+
+		ASSERT_FALSE(reporter.canArm(vehicle_status_s::NAVIGATION_STATE_POSCTL));
+		ASSERT_EQ(reporter.canArm(vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION), i == 0);
+		ASSERT_EQ(reporter.armingCheckResults().warning, events::px4::enums::health_component_t::remote_control);
+		ASSERT_EQ(reporter.healthResults().is_present, events::px4::enums::health_component_t::remote_control);
+		ASSERT_EQ(reporter.healthResults().error,
+			  i == 0 ? (health_component_t)0 : events::px4::enums::health_component_t::battery);
+
+		if (i < 2) {
+			// the replayed event must be reported with its arguments
+			ASSERT_TRUE(event_sub.update(&event));
+			ASSERT_EQ(event.id, events::ID("commander_arming_check_summary"));
+			ASSERT_TRUE(event_sub.update(&event));
+			ASSERT_EQ(event.id, events::ID("arming_test_replay_check_fail1"));
+			uint16_t arg;
+			memcpy(&arg, event.arguments + sizeof(uint32_t) + sizeof(uint8_t), sizeof(arg));
+			ASSERT_EQ(arg, 4938);
+
+			if (i == 1) {
+				ASSERT_TRUE(event_sub.update(&event));
+				ASSERT_EQ(event.id, events::ID("arming_test_replay_check_fail2"));
+			}
+
+			ASSERT_TRUE(event_sub.update(&event));
+			ASSERT_EQ(event.id, events::ID("commander_health_summary"));
+
+		} else {
+			// unchanged results
+			ASSERT_FALSE(event_sub.updated());
+		}
+	}
+}
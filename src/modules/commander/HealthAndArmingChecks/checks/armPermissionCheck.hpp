@@ -43,6 +43,8 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override { return false; } // parameters only
+
 private:
 	DEFINE_PARAMETERS_CUSTOM_PARENT(HealthAndArmingCheckBase,
 					(ParamInt<px4::params::COM_ARMABLE>) _param_com_armable
@@ -103,6 +103,8 @@ void BatteryChecks::checkAndReport(const Context &context, Report &reporter)
 			continue;
 		}
 
+		_battery_pack.update(index, battery);
+
 		if (battery.is_required && !battery.connected) {
 			is_required_battery_missing = true;
 			/* EVENT
@@ -268,6 +270,10 @@ void BatteryChecks::checkAndReport(const Context &context, Report &reporter)
 
 	rtlEstimateCheck(context, reporter, worst_battery_time_s);
 
+	battery_pack_status_s battery_pack_status = _battery_pack.combine();
+	battery_pack_status.timestamp = hrt_absolute_time();
+	_battery_pack_status_pub.publish(battery_pack_status);
+
 	reporter.failsafeFlags().battery_unhealthy =
 		// All connected batteries are regularly being published
 		hrt_elapsed_time(&oldest_update) > 5_s
@@ -35,8 +35,11 @@
 
 #include "../Common.hpp"
 
+#include <lib/battery/battery_pack.h>
+#include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionMultiArray.hpp>
+#include <uORB/topics/battery_pack_status.h>
 #include <uORB/topics/battery_status.h>
 #include <uORB/topics/rtl_time_estimate.h>
 
@@ -53,6 +56,8 @@ private:
 
 	uORB::SubscriptionMultiArray<battery_status_s, battery_status_s::MAX_INSTANCES> _battery_status_subs{ORB_ID::battery_status};
 	uORB::Subscription					_rtl_time_estimate_sub{ORB_ID(rtl_time_estimate)};
+	uORB::Publication<battery_pack_status_s>		_battery_pack_status_pub{ORB_ID(battery_pack_status)};
+	BatteryPack _battery_pack{};
 	bool _last_armed{false};
 	bool _battery_connected_at_arming[battery_status_s::MAX_INSTANCES] {};
 
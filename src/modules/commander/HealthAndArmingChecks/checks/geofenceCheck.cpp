@@ -114,3 +114,12 @@ void GeofenceChecks::checkAndReport(const Context &context, Report &reporter)
 		}
 	}
 }
+
+bool GeofenceChecks::inputsUpdated()
+{
+	// The home validity comes from the home position check, so consume the topic here to only trigger once per update
+	home_position_s home_position;
+	const bool home_position_updated = _home_position_sub.update(&home_position);
+
+	return _geofence_result_sub.updated() || home_position_updated;
+}
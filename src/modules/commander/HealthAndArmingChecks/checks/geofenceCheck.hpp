@@ -37,6 +37,7 @@
 
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/geofence_result.h>
+#include <uORB/topics/home_position.h>
 
 class GeofenceChecks : public HealthAndArmingCheckBase
 {
@@ -46,6 +47,9 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override;
+
 private:
 	uORB::Subscription _geofence_result_sub{ORB_ID(geofence_result)};
+	uORB::Subscription _home_position_sub{ORB_ID(home_position)}; ///< only for dependency tracking of home_position_invalid
 };
@@ -46,6 +46,8 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override { return _home_position_sub.updated(); }
+
 private:
 	uORB::Subscription _home_position_sub{ORB_ID(home_position)};
 };
@@ -46,6 +46,8 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override { return _sensors_status_imu_sub.updated(); }
+
 private:
 	uORB::Subscription _sensors_status_imu_sub{ORB_ID(sensors_status_imu)};
 
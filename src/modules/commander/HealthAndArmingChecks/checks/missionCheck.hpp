@@ -46,6 +46,8 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override { return _mission_result_sub.updated(); }
+
 private:
 	uORB::Subscription _mission_result_sub{ORB_ID(mission_result)};
 };
@@ -46,6 +46,8 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override { return _navigator_status_sub.updated(); }
+
 private:
 	uORB::Subscription _navigator_status_sub{ORB_ID(navigator_status)};
 };
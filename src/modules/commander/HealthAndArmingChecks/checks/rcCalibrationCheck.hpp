@@ -46,6 +46,8 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override { return false; } // vehicle status and parameters only
+
 private:
 	void updateParams() override;
 
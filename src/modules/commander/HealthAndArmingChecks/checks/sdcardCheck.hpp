@@ -43,6 +43,8 @@ public:
 
 	void checkAndReport(const Context &context, Report &reporter) override;
 
+	bool inputsUpdated() override { return false; } // card detection is retried at the rerun interval
+
 private:
 #ifdef PX4_STORAGEDIR
 	bool _sdcard_detected {false};
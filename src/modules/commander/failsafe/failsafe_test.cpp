@@ -457,3 +457,57 @@ TEST_F(FailsafeTest, user_termination)
 	EXPECT_EQ(updated_user_intented_mode, state.user_intended_mode);
 	EXPECT_EQ(failsafe.selectedAction(), FailsafeBase::Action::Terminate);
 }
+
+TEST_F(FailsafeTest, fallback_chain)
+{
+	FailsafeTester failsafe(nullptr);
+
+	failsafe_flags_s failsafe_flags{};
+	FailsafeBase::State state{};
+	state.armed = true;
+	state.user_intended_mode = vehicle_status_s::NAVIGATION_STATE_POSCTL;
+	state.vehicle_type = vehicle_status_s::VEHICLE_TYPE_ROTARY_WING;
+	hrt_abstime time = 5_s;
+
+	// Wind limit exceeded -> RTL (no user takeover, so no delay)
+	failsafe_flags.wind_limit_exceeded = true;
+	uint8_t updated_user_intented_mode = failsafe.update(time, state, false, false, failsafe_flags);
+	ASSERT_EQ(updated_user_intented_mode, state.user_intended_mode);
+	ASSERT_EQ(failsafe.selectedAction(), FailsafeBase::Action::RTL);
+
+	// Home position lost, RTL cannot run -> Land
+	time += 10_ms;
+	failsafe_flags.home_position_invalid = true;
+	failsafe_flags.mode_req_home_position = 1u << vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
+	failsafe.update(time, state, false, false, failsafe_flags);
+	ASSERT_EQ(failsafe.selectedAction(), FailsafeBase::Action::Land);
+
+	// Local position lost, Land cannot run -> Descend
+	time += 10_ms;
+	failsafe_flags.local_position_invalid = true;
+	failsafe_flags.mode_req_local_position = (1u << vehicle_status_s::NAVIGATION_STATE_AUTO_LAND)
+			| (1u << vehicle_status_s::NAVIGATION_STATE_AUTO_RTL);
+	failsafe.update(time, state, false, false, failsafe_flags);
+	ASSERT_EQ(failsafe.selectedAction(), FailsafeBase::Action::Descend);
+
+	// Home position regained, but RTL still requires local position -> stay in Descend
+	time += 10_ms;
+	failsafe_flags.home_position_invalid = false;
+	failsafe.update(time, state, false, false, failsafe_flags);
+	ASSERT_EQ(failsafe.selectedAction(), FailsafeBase::Action::Descend);
+
+	// Local position regained -> back to RTL
+	time += 10_ms;
+	failsafe_flags.local_position_invalid = false;
+	failsafe.update(time, state, false, false, failsafe_flags);
+	ASSERT_EQ(failsafe.selectedAction(), FailsafeBase::Action::RTL);
+
+	// Nothing can run -> Terminate
+	time += 10_ms;
+	failsafe_flags.attitude_invalid = true;
+	failsafe_flags.mode_req_attitude = (1u << vehicle_status_s::NAVIGATION_STATE_AUTO_RTL)
+					   | (1u << vehicle_status_s::NAVIGATION_STATE_AUTO_LAND)
+					   | (1u << vehicle_status_s::NAVIGATION_STATE_DESCEND);
+	failsafe.update(time, state, false, false, failsafe_flags);
+	ASSERT_EQ(failsafe.selectedAction(), FailsafeBase::Action::Terminate);
+}
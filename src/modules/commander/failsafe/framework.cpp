@@ -79,6 +79,8 @@ uint8_t FailsafeBase::update(const hrt_abstime &time_us, const State &state, boo
 		updateDelay(time_us - _last_update);
 	}
 
+	updateActionTable(status_flags);
+
 	checkStateAndMode(time_us, state, status_flags);
 	removeNonActivatedActions();
 	clearDelayIfNeeded(state, status_flags);
@@ -535,90 +537,18 @@ void FailsafeBase::getSelectedAction(const State &state, const failsafe_flags_s
 	}
 
 	// Check if the selected action is possible, and fall back if needed
-	switch (selected_action) {
-
-	case Action::FallbackPosCtrl:
-		if (modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_POSCTL)) {
-			selected_action = Action::FallbackPosCtrl;
-			break;
-		}
-
-		returned_state.cause = Cause::Generic;
-
-	// fallthrough
-	case Action::FallbackAltCtrl:
-		if (modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_ALTCTL)) {
-			selected_action = Action::FallbackAltCtrl;
-			break;
-		}
-
-		returned_state.cause = Cause::Generic;
-
-	// fallthrough
-	case Action::FallbackStab:
-		if (modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_STAB)) {
-			selected_action = Action::FallbackStab;
-			break;
-		} // else: fall through here as well. If stabilized isn't available, we most certainly end up in Terminate
-
-		returned_state.cause = Cause::Generic;
-
-	// fallthrough
-	case Action::Hold:
-		if (modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER)) {
-			selected_action = Action::Hold;
-			break;
-		}
-
-		returned_state.cause = Cause::Generic;
-
-	// fallthrough
-	case Action::RTL:
-		if (modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_AUTO_RTL)) {
-			selected_action = Action::RTL;
-			break;
-		}
-
-		returned_state.cause = Cause::Generic;
-
-	// fallthrough
-	case Action::Land:
-		if (modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_AUTO_LAND)) {
-			selected_action = Action::Land;
-			break;
-		}
-
-		returned_state.cause = Cause::Generic;
-
-	// fallthrough
-	case Action::Descend:
-		if (modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_DESCEND)) {
-			selected_action = Action::Descend;
-			break;
-		}
+	const Action resolved_action = _action_table.resolved[(int)selected_action];
 
+	if (resolved_action != selected_action) {
+		selected_action = resolved_action;
 		returned_state.cause = Cause::Generic;
-
-	// fallthrough
-	case Action::Terminate:
-		selected_action = Action::Terminate;
-		break;
-
-	case Action::Disarm:
-		selected_action = Action::Disarm;
-		break;
-
-	case Action::None:
-	case Action::Warn:
-	case Action::Count:
-		break;
 	}
 
 	// UX improvement (this is optional for safety): change failsafe to a warning in certain situations.
 	// If already landing, do not go into RTL
 	if (returned_state.updated_user_intended_mode == vehicle_status_s::NAVIGATION_STATE_AUTO_LAND) {
 		if ((selected_action == Action::RTL || returned_state.delayed_action == Action::RTL)
-		    && modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_AUTO_LAND)) {
+		    && modeAvailable(vehicle_status_s::NAVIGATION_STATE_AUTO_LAND)) {
 			selected_action = Action::Warn;
 			returned_state.delayed_action = Action::None;
 		}
@@ -627,7 +557,7 @@ void FailsafeBase::getSelectedAction(const State &state, const failsafe_flags_s
 	// If already in RTL, do not go into RTL again (would cause a Hold delay first, then re-start RTL)
 	if (returned_state.updated_user_intended_mode == vehicle_status_s::NAVIGATION_STATE_AUTO_RTL) {
 		if ((selected_action == Action::RTL || returned_state.delayed_action == Action::RTL)
-		    && modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_AUTO_RTL)) {
+		    && modeAvailable(vehicle_status_s::NAVIGATION_STATE_AUTO_RTL)) {
 			selected_action = Action::Warn;
 			returned_state.delayed_action = Action::None;
 		}
@@ -637,7 +567,7 @@ void FailsafeBase::getSelectedAction(const State &state, const failsafe_flags_s
 	if (returned_state.updated_user_intended_mode == vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND) {
 		if ((selected_action == Action::RTL || selected_action == Action::Land ||
 		     returned_state.delayed_action == Action::RTL || returned_state.delayed_action == Action::Land)
-		    && modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND)) {
+		    && modeAvailable(vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND)) {
 			selected_action = Action::Warn;
 			returned_state.delayed_action = Action::None;
 		}
@@ -657,7 +587,7 @@ void FailsafeBase::clearDelayIfNeeded(const State &state,
 	// - Already in a failsafe
 	// - Hold not available
 	// - Takeover is active (due to a mode switch during the delay)
-	if (_selected_action > Action::Hold || !modeCanRun(status_flags, vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER)
+	if (_selected_action > Action::Hold || !modeAvailable(vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER)
 	    || _user_takeover_active) {
 		if (_current_delay > 0) {
 			PX4_DEBUG("Clearing delay, Hold not available, already in failsafe or taken over");
@@ -696,23 +626,62 @@ uint8_t FailsafeBase::modeFromAction(const Action &action, uint8_t user_intended
 	return user_intended_mode;
 }
 
-bool FailsafeBase::modeCanRun(const failsafe_flags_s &status_flags, uint8_t mode)
+uint32_t FailsafeBase::unavailableModes(const failsafe_flags_s &status_flags)
 {
-	uint32_t mode_mask = 1u << mode;
 	// mode_req_wind_and_flight_time_compliance: does not need to be handled here (these are separate failsafe triggers)
 	// mode_req_manual_control: is handled separately
-	return
-		(!status_flags.angular_velocity_invalid || ((status_flags.mode_req_angular_velocity & mode_mask) == 0)) &&
-		(!status_flags.attitude_invalid || ((status_flags.mode_req_attitude & mode_mask) == 0)) &&
-		(!status_flags.local_position_invalid || ((status_flags.mode_req_local_position & mode_mask) == 0)) &&
-		(!status_flags.local_position_invalid_relaxed || ((status_flags.mode_req_local_position_relaxed & mode_mask) == 0)) &&
-		(!status_flags.global_position_invalid || ((status_flags.mode_req_global_position & mode_mask) == 0)) &&
-		(!status_flags.global_position_invalid_relaxed || ((status_flags.mode_req_global_position_relaxed & mode_mask) == 0)) &&
-		(!status_flags.local_altitude_invalid || ((status_flags.mode_req_local_alt & mode_mask) == 0)) &&
-		(!status_flags.auto_mission_missing || ((status_flags.mode_req_mission & mode_mask) == 0)) &&
-		(!status_flags.offboard_control_signal_lost || ((status_flags.mode_req_offboard_signal & mode_mask) == 0)) &&
-		(!status_flags.home_position_invalid || ((status_flags.mode_req_home_position & mode_mask) == 0)) &&
-		((status_flags.mode_req_other & mode_mask) == 0);
+	return status_flags.mode_req_other
+	       | (status_flags.angular_velocity_invalid ? status_flags.mode_req_angular_velocity : 0u)
+	       | (status_flags.attitude_invalid ? status_flags.mode_req_attitude : 0u)
+	       | (status_flags.local_position_invalid ? status_flags.mode_req_local_position : 0u)
+	       | (status_flags.local_position_invalid_relaxed ? status_flags.mode_req_local_position_relaxed : 0u)
+	       | (status_flags.global_position_invalid ? status_flags.mode_req_global_position : 0u)
+	       | (status_flags.global_position_invalid_relaxed ? status_flags.mode_req_global_position_relaxed : 0u)
+	       | (status_flags.local_altitude_invalid ? status_flags.mode_req_local_alt : 0u)
+	       | (status_flags.auto_mission_missing ? status_flags.mode_req_mission : 0u)
+	       | (status_flags.offboard_control_signal_lost ? status_flags.mode_req_offboard_signal : 0u)
+	       | (status_flags.home_position_invalid ? status_flags.mode_req_home_position : 0u);
+}
+
+void FailsafeBase::updateActionTable(const failsafe_flags_s &status_flags)
+{
+	const uint32_t unavailable_modes = unavailableModes(status_flags);
+
+	if (_action_table.valid && _action_table.unavailable_modes == unavailable_modes) {
+		return;
+	}
+
+	// Fallback order: if the mode of an action cannot run, the next one is tried. Terminate is always possible.
+	static constexpr struct {
+		Action action;
+		uint8_t nav_state;
+	} fallback_chain[] = {
+		{Action::FallbackPosCtrl, vehicle_status_s::NAVIGATION_STATE_POSCTL},
+		{Action::FallbackAltCtrl, vehicle_status_s::NAVIGATION_STATE_ALTCTL},
+		{Action::FallbackStab, vehicle_status_s::NAVIGATION_STATE_STAB},
+		{Action::Hold, vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER},
+		{Action::RTL, vehicle_status_s::NAVIGATION_STATE_AUTO_RTL},
+		{Action::Land, vehicle_status_s::NAVIGATION_STATE_AUTO_LAND},
+		{Action::Descend, vehicle_status_s::NAVIGATION_STATE_DESCEND},
+	};
+
+	// Actions without a mode (None, Warn, Disarm, Terminate) are always possible
+	for (int i = 0; i < (int)Action::Count; ++i) {
+		_action_table.resolved[i] = (Action)i;
+	}
+
+	Action next_possible_action = Action::Terminate;
+
+	for (int i = sizeof(fallback_chain) / sizeof(fallback_chain[0]) - 1; i >= 0; --i) {
+		if ((unavailable_modes & (1u << fallback_chain[i].nav_state)) == 0) {
+			next_possible_action = fallback_chain[i].action;
+		}
+
+		_action_table.resolved[(int)fallback_chain[i].action] = next_possible_action;
+	}
+
+	_action_table.unavailable_modes = unavailable_modes;
+	_action_table.valid = true;
 }
 
 bool FailsafeBase::deferFailsafes(bool enabled, int timeout_s)
@@ -229,7 +229,16 @@ protected:
 
 	int genCallerId() { return ++_next_caller_id; }
 
-	static bool modeCanRun(const failsafe_flags_s &status_flags, uint8_t mode);
+	static bool modeCanRun(const failsafe_flags_s &status_flags, uint8_t mode)
+	{
+		return (unavailableModes(status_flags) & (1u << mode)) == 0;
+	}
+
+	/**
+	 * Get all modes that cannot run with the given condition flags
+	 * @return bitmask of navigation states (bit i = nav_state i)
+	 */
+	static uint32_t unavailableModes(const failsafe_flags_s &status_flags);
 
 	/**
 	 * Allows to modify the user intended mode. Use only in limited cases.
@@ -266,9 +275,29 @@ private:
 
 	void updateFailsafeDeferState(const hrt_abstime &time_us, bool defer);
 
+	/**
+	 * Rebuild the action table if the set of unavailable modes changed
+	 */
+	void updateActionTable(const failsafe_flags_s &status_flags);
+
+	bool modeAvailable(uint8_t mode) const { return (_action_table.unavailable_modes & (1u << mode)) == 0; }
+
+	/**
+	 * Precomputed decision table: for each requested action, the action that is executed after following the
+	 * fallback chain (e.g. RTL -> Land -> Descend -> Terminate) through the unavailable modes.
+	 * Keyed on the unavailable modes, so it only needs to be rebuilt when mode availability changes.
+	 */
+	struct ActionTable {
+		uint32_t unavailable_modes{0};
+		Action resolved[(int)Action::Count] {};
+		bool valid{false};
+	};
+
 	static constexpr int max_num_actions{8};
 	ActionOptions _actions[max_num_actions]; ///< currently active actions
 
+	ActionTable _action_table{};
+
 	hrt_abstime _last_update{};
 	bool _last_armed{false};
 	uint8_t _last_user_intended_mode{0};
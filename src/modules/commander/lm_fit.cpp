@@ -76,8 +76,8 @@ void lm_sphere_fit_iteration(const float x[], const float y[], const float z[],
 		residual = params.radius - length;
 
 		for (uint8_t i = 0; i < 4; i++) {
-			// compute JTJ
-			for (uint8_t j = 0; j < 4; j++) {
+			// compute JTJ (only the lower triangle, it is symmetric and the solver only reads that)
+			for (uint8_t j = 0; j <= i; j++) {
 				JTJ(i, j) += sphere_jacob[i] * sphere_jacob[j];
 			}
 
@@ -91,7 +91,6 @@ void lm_sphere_fit_iteration(const float x[], const float y[], const float z[],
 	float fit1_params[4] = {params.radius, params.offset(0), params.offset(1), params.offset(2)};
 	float fit2_params[4];
 	memcpy(fit2_params, fit1_params, sizeof(fit1_params));
-	JTJ = (JTJ + JTJ.transpose()) * 0.5f; // fix numerical issues
 	matrix::SquareMatrix<float, 4> JTJ2 = JTJ;
 
 	for (uint8_t i = 0; i < 4; i++) {
@@ -99,22 +98,19 @@ void lm_sphere_fit_iteration(const float x[], const float y[], const float z[],
 		JTJ2(i, i) += result.gradient_damping / lma_damping;
 	}
 
-	if (!JTJ.I(JTJ)) {
-		result.result = iteration_result::STATUS::FAILURE;
-		return;
-	}
+	// JTJ is symmetric positive definite with the damping, solve for the steps instead of inverting it
+	const matrix::Vector<float, 4> JTFI_vec(JTFI);
+	matrix::Vector<float, 4> step1;
+	matrix::Vector<float, 4> step2;
 
-	if (!JTJ2.I(JTJ2)) {
+	if (!matrix::ldltSolve(JTJ, JTFI_vec, step1) || !matrix::ldltSolve(JTJ2, JTFI_vec, step2)) {
 		result.result = iteration_result::STATUS::FAILURE;
 		return;
-
 	}
 
 	for (uint8_t row = 0; row < 4; row++) {
-		for (uint8_t col = 0; col < 4; col++) {
-			fit1_params[row] -= JTFI[col] * JTJ(row, col);
-			fit2_params[row] -= JTFI[col] * JTJ2(row, col);
-		}
+		fit1_params[row] -= step1(row);
+		fit2_params[row] -= step2(row);
 	}
 
 	// Calculate mean squared residuals
@@ -214,8 +210,8 @@ void lm_ellipsoid_fit_iteration(const float x[], const float y[], const float z[
 		ellipsoid_jacob[8] = -1.0f * (((z[k] - params.offset(2)) * B) + ((y[k] - params.offset(1)) * C)) / length;
 
 		for (uint8_t i = 0; i < 9; i++) {
-			// compute JTJ
-			for (uint8_t j = 0; j < 9; j++) {
+			// compute JTJ (only the lower triangle, it is symmetric and the solver only reads that)
+			for (uint8_t j = 0; j <= i; j++) {
 				JTJ(i, j) += ellipsoid_jacob[i] * ellipsoid_jacob[j];
 			}
 
@@ -237,21 +233,19 @@ void lm_ellipsoid_fit_iteration(const float x[], const float y[], const float z[
 	}
 
 
-	if (!JTJ.I(JTJ)) {
-		result.result = iteration_result::STATUS::FAILURE;
-		return;
-	}
+	// JTJ is symmetric positive definite with the damping, solve for the steps instead of inverting it
+	const matrix::Vector<float, 9> JTFI_vec(JTFI);
+	matrix::Vector<float, 9> step1;
+	matrix::Vector<float, 9> step2;
 
-	if (!JTJ2.I(JTJ2)) {
+	if (!matrix::ldltSolve(JTJ, JTFI_vec, step1) || !matrix::ldltSolve(JTJ2, JTFI_vec, step2)) {
 		result.result = iteration_result::STATUS::FAILURE;
 		return;
 	}
 
 	for (uint8_t row = 0; row < 9; row++) {
-		for (uint8_t col = 0; col < 9; col++) {
-			fit1_params[row] -= JTFI[col] * JTJ(row, col);
-			fit2_params[row] -= JTFI[col] * JTJ2(row, col);
-		}
+		fit1_params[row] -= step1(row);
+		fit2_params[row] -= step2(row);
 	}
 
 	// Calculate mean squared residuals
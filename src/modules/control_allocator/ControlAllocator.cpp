@@ -52,7 +52,8 @@ using namespace time_literals;
 ControlAllocator::ControlAllocator() :
 	ModuleParams(nullptr),
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
-	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle"))
+	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")),
+	_effectiveness_update_perf(perf_alloc(PC_COUNT, MODULE_NAME": effectiveness update"))
 {
 	_control_allocator_status_pub[0].advertise();
 	_control_allocator_status_pub[1].advertise();
@@ -73,6 +74,9 @@ ControlAllocator::ControlAllocator() :
 		_param_handles.slew_rate_servos[i] = param_find(buffer);
 	}
 
+	// owned by mc_rate_control, PARAM_INVALID if it's not part of the build
+	_param_handles.mc_inner_loop = param_find("MC_INNER_LOOP");
+
 	parameters_updated();
 }
 
@@ -85,11 +89,23 @@ ControlAllocator::~ControlAllocator()
 	delete _actuator_effectiveness;
 
 	perf_free(_loop_perf);
+	perf_free(_effectiveness_update_perf);
 }
 
 bool
 ControlAllocator::init()
 {
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+	int32_t inner_loop = 0;
+
+	if (_param_handles.mc_inner_loop != PARAM_INVALID) {
+		param_get(_param_handles.mc_inner_loop, &inner_loop);
+	}
+
+	// run right after the rate controller publishes the torque setpoint instead of being queued
+	SetInline(inner_loop != 0);
+#endif // CONFIG_WQ_INLINE_CHAIN
+
 	if (!_vehicle_torque_setpoint_sub.registerCallback()) {
 		PX4_ERR("callback registration failed");
 		return false;
@@ -182,6 +198,10 @@ ControlAllocator::update_allocation_method(bool force)
 				_control_allocation[i] = new ControlAllocationSequentialDesaturation();
 				break;
 
+			case AllocationMethod::ACTIVE_SET:
+				_control_allocation[i] = new ControlAllocationActiveSet();
+				break;
+
 			default:
 				PX4_ERR("Unknown allocation method");
 				break;
@@ -411,17 +431,20 @@ ControlAllocator::Run()
 		c[0](5) = _thrust_sp(2);
 
 		if (_num_control_allocation > 1) {
-			if (_vehicle_torque_setpoint1_sub.copy(&vehicle_torque_setpoint)) {
-				c[1](0) = vehicle_torque_setpoint.xyz[0];
-				c[1](1) = vehicle_torque_setpoint.xyz[1];
-				c[1](2) = vehicle_torque_setpoint.xyz[2];
+			// only copy the setpoints of the 2. matrix when they changed
+			if (_vehicle_torque_setpoint1_sub.update(&vehicle_torque_setpoint)) {
+				_control_sp1(0) = vehicle_torque_setpoint.xyz[0];
+				_control_sp1(1) = vehicle_torque_setpoint.xyz[1];
+				_control_sp1(2) = vehicle_torque_setpoint.xyz[2];
 			}
 
-			if (_vehicle_thrust_setpoint1_sub.copy(&vehicle_thrust_setpoint)) {
-				c[1](3) = vehicle_thrust_setpoint.xyz[0];
-				c[1](4) = vehicle_thrust_setpoint.xyz[1];
-				c[1](5) = vehicle_thrust_setpoint.xyz[2];
+			if (_vehicle_thrust_setpoint1_sub.update(&vehicle_thrust_setpoint)) {
+				_control_sp1(3) = vehicle_thrust_setpoint.xyz[0];
+				_control_sp1(4) = vehicle_thrust_setpoint.xyz[1];
+				_control_sp1(5) = vehicle_thrust_setpoint.xyz[2];
 			}
+
+			c[1] = _control_sp1;
 		}
 
 		for (int i = 0; i < _num_control_allocation; ++i) {
@@ -582,17 +605,37 @@ ControlAllocator::update_effectiveness_matrix_if_needed(EffectivenessUpdateReaso
 				}
 			}
 
-			// Assign control effectiveness matrix
+			// Assign control effectiveness matrix (the allocation recomputes its mix on the next update)
+			perf_count(_effectiveness_update_perf);
 			int total_num_actuators = config.num_actuators_matrix[i];
 			_control_allocation[i]->setEffectivenessMatrix(config.effectiveness_matrices[i], config.trim[i],
 					config.linearization_point[i], total_num_actuators, reason == EffectivenessUpdateReason::CONFIGURATION_UPDATE);
 		}
 
+		update_output_mapping();
+
 		trims.timestamp = hrt_absolute_time();
 		_actuator_servos_trim_pub.publish(trims);
 	}
 }
 
+void
+ControlAllocator::update_output_mapping()
+{
+	int actuator_idx = 0;
+	int actuator_idx_matrix[ActuatorEffectiveness::MAX_NUM_MATRICES] {};
+
+	_num_motor_outputs = math::min(_num_actuators[0], (int)actuator_motors_s::NUM_CONTROLS);
+	_num_servo_outputs = math::min(_num_actuators[1], (int)actuator_servos_s::NUM_CONTROLS);
+	_num_servo_outputs = math::min(_num_servo_outputs, NUM_ACTUATORS - _num_motor_outputs);
+
+	for (; actuator_idx < _num_motor_outputs + _num_servo_outputs; ++actuator_idx) {
+		const int selected_matrix = _control_allocation_selection_indexes[actuator_idx];
+		_output_mapping[actuator_idx].matrix = selected_matrix;
+		_output_mapping[actuator_idx].index = actuator_idx_matrix[selected_matrix]++;
+	}
+}
+
 void
 ControlAllocator::publish_control_allocator_status(int matrix_index)
 {
@@ -663,48 +706,36 @@ ControlAllocator::publish_actuator_controls()
 
 	actuator_motors.reversible_flags = _param_r_rev.get();
 
-	int actuator_idx = 0;
-	int actuator_idx_matrix[ActuatorEffectiveness::MAX_NUM_MATRICES] {};
-
 	uint32_t stopped_motors = _actuator_effectiveness->getStoppedMotors()
 				  | _handled_motor_failure_bitmask
 				  | _motor_stop_mask;
 
 	// motors
-	int motors_idx;
-
-	for (motors_idx = 0; motors_idx < _num_actuators[0] && motors_idx < actuator_motors_s::NUM_CONTROLS; motors_idx++) {
-		int selected_matrix = _control_allocation_selection_indexes[actuator_idx];
-		float actuator_sp = _control_allocation[selected_matrix]->getActuatorSetpoint()(actuator_idx_matrix[selected_matrix]);
+	for (int motors_idx = 0; motors_idx < _num_motor_outputs; motors_idx++) {
+		const OutputMapping &mapping = _output_mapping[motors_idx];
+		const float actuator_sp = _control_allocation[mapping.matrix]->getActuatorSetpoint()(mapping.index);
 		actuator_motors.control[motors_idx] = PX4_ISFINITE(actuator_sp) ? actuator_sp : NAN;
 
 		if (stopped_motors & (1u << motors_idx)) {
 			actuator_motors.control[motors_idx] = NAN;
 		}
-
-		++actuator_idx_matrix[selected_matrix];
-		++actuator_idx;
 	}
 
-	for (int i = motors_idx; i < actuator_motors_s::NUM_CONTROLS; i++) {
+	for (int i = _num_motor_outputs; i < actuator_motors_s::NUM_CONTROLS; i++) {
 		actuator_motors.control[i] = NAN;
 	}
 
 	_actuator_motors_pub.publish(actuator_motors);
 
 	// servos
-	if (_num_actuators[1] > 0) {
-		int servos_idx;
-
-		for (servos_idx = 0; servos_idx < _num_actuators[1] && servos_idx < actuator_servos_s::NUM_CONTROLS; servos_idx++) {
-			int selected_matrix = _control_allocation_selection_indexes[actuator_idx];
-			float actuator_sp = _control_allocation[selected_matrix]->getActuatorSetpoint()(actuator_idx_matrix[selected_matrix]);
+	if (_num_servo_outputs > 0) {
+		for (int servos_idx = 0; servos_idx < _num_servo_outputs; servos_idx++) {
+			const OutputMapping &mapping = _output_mapping[_num_motor_outputs + servos_idx];
+			const float actuator_sp = _control_allocation[mapping.matrix]->getActuatorSetpoint()(mapping.index);
 			actuator_servos.control[servos_idx] = PX4_ISFINITE(actuator_sp) ? actuator_sp : NAN;
-			++actuator_idx_matrix[selected_matrix];
-			++actuator_idx;
 		}
 
-		for (int i = servos_idx; i < actuator_servos_s::NUM_CONTROLS; i++) {
+		for (int i = _num_servo_outputs; i < actuator_servos_s::NUM_CONTROLS; i++) {
 			actuator_servos.control[i] = NAN;
 		}
 
@@ -808,6 +839,10 @@ int ControlAllocator::print_status()
 		PX4_INFO("Method: Sequential desaturation");
 		break;
 
+	case AllocationMethod::ACTIVE_SET:
+		PX4_INFO("Method: Active set");
+		break;
+
 	case AllocationMethod::AUTO:
 		PX4_INFO("Method: Auto");
 		break;
@@ -842,6 +877,7 @@ int ControlAllocator::print_status()
 
 	// Print perf
 	perf_print_counter(_loop_perf);
+	perf_print_counter(_effectiveness_update_perf);
 
 	return 0;
 }
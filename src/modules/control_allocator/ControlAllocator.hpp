@@ -58,6 +58,7 @@
 #include <ControlAllocation.hpp>
 #include <ControlAllocationPseudoInverse.hpp>
 #include <ControlAllocationSequentialDesaturation.hpp>
+#include <ControlAllocationActiveSet.hpp>
 
 #include <lib/matrix/matrix/math.hpp>
 #include <lib/perf/perf_counter.h>
@@ -116,6 +117,7 @@ private:
 	struct ParamHandles {
 		param_t slew_rate_motors[MAX_NUM_MOTORS];
 		param_t slew_rate_servos[MAX_NUM_SERVOS];
+		param_t mc_inner_loop;
 	};
 
 	struct Params {
@@ -135,6 +137,8 @@ private:
 
 	void check_for_motor_failures();
 
+	void update_output_mapping();
+
 	void publish_control_allocator_status(int matrix_index);
 
 	void publish_actuator_controls();
@@ -174,6 +178,16 @@ private:
 	uint8_t _control_allocation_selection_indexes[NUM_ACTUATORS * ActuatorEffectiveness::MAX_NUM_MATRICES] {};
 	int _num_actuators[(int)ActuatorType::COUNT] {};
 
+	struct OutputMapping {
+		uint8_t matrix; ///< allocation matrix index
+		uint8_t index; ///< actuator index within that matrix
+	};
+
+	/// output index (motors followed by servos) -> allocation matrix setpoint, updated with the effectiveness matrix
+	OutputMapping _output_mapping[NUM_ACTUATORS] {};
+	int _num_motor_outputs{0};
+	int _num_servo_outputs{0};
+
 	// Inputs
 	uORB::SubscriptionCallbackWorkItem _vehicle_torque_setpoint_sub{this, ORB_ID(vehicle_torque_setpoint)};  /**< vehicle torque setpoint subscription */
 	uORB::Subscription _vehicle_thrust_setpoint_sub{ORB_ID(vehicle_thrust_setpoint)};	 /**< vehicle thrust setpoint subscription */
@@ -196,6 +210,7 @@ private:
 
 	matrix::Vector3f _torque_sp;
 	matrix::Vector3f _thrust_sp;
+	matrix::Vector<float, NUM_AXES> _control_sp1; ///< control setpoint of the 2. matrix
 	bool _publish_controls{true};
 
 	// Reflects motor failures that are currently handled, not motor failures that are reported.
@@ -204,6 +219,7 @@ private:
 	uint16_t _motor_stop_mask{0};
 
 	perf_counter_t	_loop_perf;			/**< loop duration performance counter */
+	perf_counter_t	_effectiveness_update_perf;	/**< effectiveness matrix updates (pseudo-inverse recomputations) */
 
 	bool _armed{false};
 	hrt_abstime _last_run{0};
@@ -59,10 +59,17 @@
 
 #include "dataman.h"
 
+#ifdef CONFIG_DATAMAN_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 __BEGIN_DECLS
 __EXPORT int dataman_main(int argc, char *argv[]);
 __END_DECLS
 
+using namespace time_literals;
+
 static constexpr int TASK_STACK_SIZE = 1420;
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
@@ -72,6 +79,16 @@ static ssize_t _file_read(dm_item_t item, unsigned index, void *buf, size_t coun
 static int  _file_clear(dm_item_t item);
 static int _file_initialize(unsigned max_offset);
 static void _file_shutdown();
+static bool _file_flush(bool force);
+#endif
+
+#ifdef CONFIG_DATAMAN_MMAP
+/* Private memory-mapped file based Operations */
+static ssize_t _mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count);
+static int  _mmap_clear(dm_item_t item);
+static int _mmap_initialize(unsigned max_offset);
+static void _mmap_shutdown();
+static bool _mmap_flush(bool force);
 #endif
 
 /* Private Ram based Operations */
@@ -88,6 +105,7 @@ typedef struct dm_operations_t {
 	int (*initialize)(unsigned max_offset);
 	void (*shutdown)();
 	int (*wait)(px4_sem_t *sem);
+	bool (*flush)(bool force); /* write out pending data, returns true if some is still pending (optional) */
 } dm_operations_t;
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
@@ -98,6 +116,20 @@ static constexpr dm_operations_t dm_file_operations = {
 	.initialize = _file_initialize,
 	.shutdown = _file_shutdown,
 	.wait = px4_sem_wait,
+	.flush = _file_flush,
+};
+#endif
+
+#ifdef CONFIG_DATAMAN_MMAP
+/* reads and writes are plain memory copies into the mapping, shared with the RAM backend */
+static constexpr dm_operations_t dm_mmap_operations = {
+	.write   = _mmap_write,
+	.read    = _ram_read,
+	.clear   = _mmap_clear,
+	.initialize = _mmap_initialize,
+	.shutdown = _mmap_shutdown,
+	.wait = px4_sem_wait,
+	.flush = _mmap_flush,
 };
 #endif
 
@@ -108,6 +140,7 @@ static constexpr dm_operations_t dm_ram_operations = {
 	.initialize = _ram_initialize,
 	.shutdown = _ram_shutdown,
 	.wait = px4_sem_wait,
+	.flush = nullptr,
 };
 
 static const dm_operations_t *g_dm_ops;
@@ -157,6 +190,65 @@ static perf_counter_t _dm_write_perf{nullptr};
 /* The data manager store file handle and file name */
 static const char *default_device_path = PX4_STORAGEDIR "/dataman";
 static char *k_data_manager_device_path = nullptr;
+
+/* Items that are written and synced to the file immediately. All others are kept in the RAM cache and written
+ * behind. The items written behind only become reachable through their state item (a mission or fence upload
+ * writes the items first, then the state), and every write-through flushes the pending items first, so the
+ * file never has a state pointing to items that are not on the media yet. */
+static constexpr bool g_item_write_through[DM_KEY_NUM_KEYS] = {
+	true,	/* DM_KEY_SAFE_POINTS_0 */
+	true,	/* DM_KEY_SAFE_POINTS_1 */
+	true,	/* DM_KEY_SAFE_POINTS_STATE */
+	false,	/* DM_KEY_FENCE_POINTS_0 */
+	false,	/* DM_KEY_FENCE_POINTS_1 */
+	true,	/* DM_KEY_FENCE_POINTS_STATE */
+	false,	/* DM_KEY_WAYPOINTS_OFFBOARD_0 */
+	false,	/* DM_KEY_WAYPOINTS_OFFBOARD_1 */
+	true,	/* DM_KEY_MISSION_STATE */
+	true	/* DM_KEY_COMPAT */
+};
+
+static constexpr size_t max_item_size_with_hdr()
+{
+	size_t max_size = 0;
+
+	for (size_t size : g_per_item_size_with_hdr) {
+		max_size = size > max_size ? size : max_size;
+	}
+
+	return max_size;
+}
+
+/* Maximum time pending writes stay in the cache before they are flushed to the file */
+static constexpr hrt_abstime DM_CACHE_FLUSH_INTERVAL = 500_ms;
+
+/* LRU cache of file items, in the on-disk format (header + data) */
+typedef struct {
+	int offset;		/* file offset of the item, -1 if the entry is unused */
+	uint32_t last_used;	/* LRU stamp */
+	uint16_t length;	/* number of bytes to write out, including the header */
+	bool dirty;		/* not written to the file yet */
+	uint8_t data[max_item_size_with_hdr()];
+} dm_cache_entry_t;
+
+static struct {
+	dm_cache_entry_t *entries;
+	unsigned num_entries;
+	uint32_t use_counter;
+	hrt_abstime dirty_since;	/* time of the oldest write not synced to the media yet, 0 if none */
+	unsigned hits;
+	unsigned misses;
+	unsigned flushes;
+	unsigned flush_errors;
+} g_file_cache{};
+#endif
+
+#ifdef CONFIG_DATAMAN_MMAP
+static struct {
+	size_t size;			/* size of the mapping */
+	hrt_abstime dirty_since;	/* time of the oldest write not synced to the media yet, 0 if none */
+	unsigned syncs;
+} g_mmap{};
 #endif
 
 static enum {
@@ -167,6 +259,21 @@ static enum {
 } backend = BACKEND_NONE;
 
 static px4_sem_t g_init_sema;
+static bool g_init_signaled = false;
+static bool g_init_async = false; /* signal startup before the backend is initialized */
+
+#ifdef CONFIG_DATAMAN_MMAP
+static bool g_file_io = false; /* use the file backend instead of mapping the file */
+#endif
+
+/* Tell startup to continue, only the first call has an effect */
+static void signal_init_done()
+{
+	if (!g_init_signaled) {
+		g_init_signaled = true;
+		px4_sem_post(&g_init_sema);
+	}
+}
 
 static bool g_task_should_exit;	/**< if true, dataman task should exit */
 
@@ -248,6 +355,164 @@ static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_
 }
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+/* write a raw item (header + data) at a file offset, without syncing */
+static int
+_file_write_sector(int offset, const uint8_t *buffer, size_t count)
+{
+	for (int i = 0; i < 2; i++) {
+		int ret_seek = lseek(dm_operations_data.file.fd, offset, SEEK_SET);
+
+		if (ret_seek < 0) {
+			PX4_ERR("file write lseek failed %d", errno);
+			continue;
+		}
+
+		if (ret_seek != offset) {
+			PX4_ERR("file write lseek failed, incorrect offset %d vs %d", ret_seek, offset);
+			continue;
+		}
+
+		int ret_write = write(dm_operations_data.file.fd, buffer, count);
+
+		if (ret_write < 0) {
+			PX4_ERR("file write failed %d", errno);
+			continue;
+		}
+
+		if (ret_write != (ssize_t)count) {
+			PX4_ERR("file write failed, wrote %d bytes, expected %zu", ret_write, count);
+			continue;
+
+		} else {
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/* find the cache entry of a file offset */
+static dm_cache_entry_t *
+_file_cache_find(int offset)
+{
+	for (unsigned i = 0; i < g_file_cache.num_entries; i++) {
+		if (g_file_cache.entries[i].offset == offset) {
+			g_file_cache.entries[i].last_used = ++g_file_cache.use_counter;
+			return &g_file_cache.entries[i];
+		}
+	}
+
+	return nullptr;
+}
+
+/* get a cache entry for a file offset, evicting the least recently used one if needed */
+static dm_cache_entry_t *
+_file_cache_insert(int offset)
+{
+	dm_cache_entry_t *victim = nullptr;
+
+	for (unsigned i = 0; i < g_file_cache.num_entries; i++) {
+		dm_cache_entry_t &entry = g_file_cache.entries[i];
+
+		if (entry.offset < 0) {
+			victim = &entry;
+			break;
+		}
+
+		if (!victim || entry.last_used < victim->last_used) {
+			victim = &entry;
+		}
+	}
+
+	if (!victim) {
+		return nullptr;
+	}
+
+	if (victim->dirty) {
+		/* synced with the next flush, dirty_since is still set */
+		if (_file_write_sector(victim->offset, victim->data, victim->length) < 0) {
+			return nullptr;
+		}
+
+		victim->dirty = false;
+	}
+
+	victim->offset = offset;
+	victim->last_used = ++g_file_cache.use_counter;
+	return victim;
+}
+
+/* drop the cache entries of an item type, including pending writes */
+static void
+_file_cache_invalidate(dm_item_t item)
+{
+	const int begin = calculate_offset(item, 0);
+	const int end = begin + g_per_item_max_index[item] * g_per_item_size_with_hdr[item];
+
+	for (unsigned i = 0; i < g_file_cache.num_entries; i++) {
+		dm_cache_entry_t &entry = g_file_cache.entries[i];
+
+		if (entry.offset >= begin && entry.offset < end) {
+			entry.offset = -1;
+			entry.dirty = false;
+		}
+	}
+}
+
+/* Write out the pending items once they are older than DM_CACHE_FLUSH_INTERVAL (or immediately if forced).
+ * They are written in file order, which groups them by item type and index, followed by a single sync.
+ * Returns true while writes are pending, which after a forced flush means that it failed. */
+static bool
+_file_flush(bool force)
+{
+	if (g_file_cache.dirty_since == 0) {
+		return false;
+	}
+
+	if (!force && hrt_elapsed_time(&g_file_cache.dirty_since) < DM_CACHE_FLUSH_INTERVAL) {
+		return true;
+	}
+
+	while (true) {
+		dm_cache_entry_t *next = nullptr;
+
+		for (unsigned i = 0; i < g_file_cache.num_entries; i++) {
+			dm_cache_entry_t &entry = g_file_cache.entries[i];
+
+			if (entry.dirty && (!next || entry.offset < next->offset)) {
+				next = &entry;
+			}
+		}
+
+		if (!next) {
+			break;
+		}
+
+		if (_file_write_sector(next->offset, next->data, next->length) < 0) {
+			/* The client already got a success: keep the item pending (and readable from the cache) and retry later.
+			 * Until then the write-through items are refused, as they must not reach the media before it. */
+			PX4_ERR("cache flush failed at offset %d", next->offset);
+			g_file_cache.dirty_since = hrt_absolute_time();
+			g_file_cache.flush_errors++;
+			return true;
+		}
+
+		next->dirty = false;
+	}
+
+	/* Make sure data is written to physical media */
+	if (fsync(dm_operations_data.file.fd) != 0) {
+		PX4_ERR("cache flush sync failed %d", errno);
+		g_file_cache.dirty_since = hrt_absolute_time();
+		g_file_cache.flush_errors++;
+		return true;
+	}
+
+	g_file_cache.dirty_since = 0;
+	g_file_cache.flushes++;
+	return false;
+}
+
 /* write to the data manager file */
 static ssize_t
 _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
@@ -283,44 +548,44 @@ _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
 
 	count += DM_SECTOR_HDR_SIZE;
 
-	bool write_success = false;
+	dm_cache_entry_t *entry = _file_cache_find(offset);
 
-	for (int i = 0; i < 2; i++) {
-		int ret_seek = lseek(dm_operations_data.file.fd, offset, SEEK_SET);
-
-		if (ret_seek < 0) {
-			PX4_ERR("file write lseek failed %d", errno);
-			continue;
+	if (!g_item_write_through[item]) {
+		if (!entry) {
+			entry = _file_cache_insert(offset);
 		}
 
-		if (ret_seek != offset) {
-			PX4_ERR("file write lseek failed, incorrect offset %d vs %d", ret_seek, offset);
-			continue;
-		}
+		if (entry) {
+			memcpy(entry->data, buffer, count);
+			entry->length = count;
+			entry->dirty = true;
 
-		int ret_write = write(dm_operations_data.file.fd, buffer, count);
+			if (g_file_cache.dirty_since == 0) {
+				g_file_cache.dirty_since = hrt_absolute_time();
+			}
 
-		if (ret_write < 0) {
-			PX4_ERR("file write failed %d", errno);
-			continue;
+			return count - DM_SECTOR_HDR_SIZE;
 		}
+	}
 
-		if (ret_write != (ssize_t)count) {
-			PX4_ERR("file write failed, wrote %d bytes, expected %zu", ret_write, count);
-			continue;
+	/* Everything written before has to reach the media before this item does */
+	if (_file_flush(true)) {
+		return -1;
+	}
 
-		} else {
-			write_success = true;
-			break;
+	/* Make sure data is written to physical media */
+	if (_file_write_sector(offset, buffer, count) < 0 || fsync(dm_operations_data.file.fd) != 0) {
+		if (entry) {
+			entry->offset = -1;
 		}
-	}
 
-	if (!write_success) {
 		return -1;
 	}
 
-	/* Make sure data is written to physical media */
-	fsync(dm_operations_data.file.fd);
+	if (entry) {
+		memcpy(entry->data, buffer, count);
+		entry->length = count;
+	}
 
 	/* All is well... return the number of user data written */
 	return count - DM_SECTOR_HDR_SIZE;
@@ -394,44 +659,63 @@ _file_read(dm_item_t item, unsigned index, void *buf, size_t count)
 		return -E2BIG;
 	}
 
-	int len = -1;
-	bool read_success = false;
+	dm_cache_entry_t *entry = _file_cache_find(offset);
 
-	for (int i = 0; i < 2; i++) {
-		int ret_seek = lseek(dm_operations_data.file.fd, offset, SEEK_SET);
+	if (entry) {
+		g_file_cache.hits++;
+		memcpy(buffer, entry->data, entry->length);
 
-		if ((ret_seek < 0) && !dm_operations_data.silence) {
-			PX4_ERR("file read lseek failed %d", errno);
-			continue;
-		}
+	} else {
+		int len = -1;
+		bool read_success = false;
 
-		if ((ret_seek != offset) && !dm_operations_data.silence) {
-			PX4_ERR("file read lseek failed, incorrect offset %d vs %d", ret_seek, offset);
-			continue;
-		}
+		for (int i = 0; i < 2; i++) {
+			int ret_seek = lseek(dm_operations_data.file.fd, offset, SEEK_SET);
 
-		/* Read the prefix and data */
-		len = read(dm_operations_data.file.fd, buffer, count + DM_SECTOR_HDR_SIZE);
+			if ((ret_seek < 0) && !dm_operations_data.silence) {
+				PX4_ERR("file read lseek failed %d", errno);
+				continue;
+			}
 
-		/* Check for read error */
-		if (len >= 0) {
-			read_success = true;
-			break;
+			if ((ret_seek != offset) && !dm_operations_data.silence) {
+				PX4_ERR("file read lseek failed, incorrect offset %d vs %d", ret_seek, offset);
+				continue;
+			}
 
-		} else {
-			if (!dm_operations_data.silence) {
-				PX4_ERR("file read failed %d", errno);
+			/* Read the prefix and data, the whole item so that it can be cached */
+			len = read(dm_operations_data.file.fd, buffer, sizeof(buffer));
+
+			/* Check for read error */
+			if (len >= 0) {
+				read_success = true;
+				break;
+
+			} else {
+				if (!dm_operations_data.silence) {
+					PX4_ERR("file read failed %d", errno);
+				}
 			}
 		}
-	}
 
-	if (!read_success) {
-		return -1;
-	}
+		if (!read_success) {
+			return -1;
+		}
+
+		/* A zero length entry is a empty entry */
+		if (len == 0) {
+			buffer[0] = 0;
+		}
+
+		/* Only cache complete items, a short read happens past the end of the file */
+		if (len == (int)sizeof(buffer) || buffer[0] == 0) {
+			g_file_cache.misses++;
+			entry = _file_cache_insert(offset);
 
-	/* A zero length entry is a empty entry */
-	if (len == 0) {
-		buffer[0] = 0;
+			if (entry) {
+				memcpy(entry->data, buffer, DM_SECTOR_HDR_SIZE + buffer[0]);
+				entry->length = DM_SECTOR_HDR_SIZE + buffer[0];
+			}
+		}
 	}
 
 	/* See if we got data */
@@ -501,6 +785,8 @@ _file_clear(dm_item_t item)
 		return -1;
 	}
 
+	_file_cache_invalidate(item);
+
 	int result = 0;
 
 	/* Clear all items of this type */
@@ -542,27 +828,10 @@ _file_clear(dm_item_t item)
 #endif
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
-static int
-_file_initialize(unsigned max_offset)
+/* reset the storage if the file is new or its layout is not compatible */
+static void
+_file_check_compat(bool file_existed)
 {
-	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
-
-	/* Open or create the data manager file */
-	dm_operations_data.file.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
-
-	if (dm_operations_data.file.fd < 0) {
-		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
-		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
-		return -1;
-	}
-
-	if ((unsigned)lseek(dm_operations_data.file.fd, max_offset, SEEK_SET) != max_offset) {
-		close(dm_operations_data.file.fd);
-		PX4_WARN("Could not seek data manager file %s", k_data_manager_device_path);
-		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
-		return -1;
-	}
-
 	dataman_compat_s compat_state{};
 
 	dm_operations_data.silence = true;
@@ -602,11 +871,174 @@ _file_initialize(unsigned max_offset)
 		g_dm_ops->write(DM_KEY_FENCE_POINTS_STATE, 0, reinterpret_cast<uint8_t *>(&stats), sizeof(mission_stats_entry_s));
 		g_dm_ops->write(DM_KEY_SAFE_POINTS_STATE, 0, reinterpret_cast<uint8_t *>(&stats), sizeof(mission_stats_entry_s));
 	}
+}
+#endif
+
+#ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+static int
+_file_initialize(unsigned max_offset)
+{
+	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
+
+	/* Open or create the data manager file */
+	dm_operations_data.file.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (dm_operations_data.file.fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		signal_init_done(); /* Don't want to hang startup */
+		return -1;
+	}
+
+	if ((unsigned)lseek(dm_operations_data.file.fd, max_offset, SEEK_SET) != max_offset) {
+		close(dm_operations_data.file.fd);
+		PX4_WARN("Could not seek data manager file %s", k_data_manager_device_path);
+		signal_init_done(); /* Don't want to hang startup */
+		return -1;
+	}
+
+	g_file_cache = {};
+
+	if (CONFIG_DATAMAN_FILE_CACHE_ITEMS > 0) {
+		g_file_cache.entries = (dm_cache_entry_t *)malloc(CONFIG_DATAMAN_FILE_CACHE_ITEMS * sizeof(dm_cache_entry_t));
+
+		if (g_file_cache.entries) {
+			g_file_cache.num_entries = CONFIG_DATAMAN_FILE_CACHE_ITEMS;
+
+			for (unsigned i = 0; i < g_file_cache.num_entries; i++) {
+				g_file_cache.entries[i].offset = -1;
+				g_file_cache.entries[i].last_used = 0;
+				g_file_cache.entries[i].dirty = false;
+			}
+
+		} else {
+			PX4_WARN("Could not allocate the item cache, using the file directly");
+		}
+	}
+
+	_file_check_compat(file_existed);
+
+	dm_operations_data.running = true;
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_DATAMAN_MMAP
+static ssize_t
+_mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count)
+{
+	const ssize_t ret = _ram_write(item, index, buf, count);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (g_item_write_through[item]) {
+		/* syncs all pages, so the items written before reach the media no later than this one */
+		if (msync(dm_operations_data.ram.data, g_mmap.size, MS_SYNC) != 0) {
+			PX4_ERR("msync failed %d", errno);
+			g_mmap.dirty_since = hrt_absolute_time();
+			return -1;
+		}
+
+		g_mmap.dirty_since = 0;
+		g_mmap.syncs++;
+
+	} else if (g_mmap.dirty_since == 0) {
+		g_mmap.dirty_since = hrt_absolute_time();
+	}
+
+	return ret;
+}
+
+static int
+_mmap_clear(dm_item_t item)
+{
+	const int result = _ram_clear(item);
+
+	msync(dm_operations_data.ram.data, g_mmap.size, MS_SYNC);
+	g_mmap.dirty_since = 0;
+	g_mmap.syncs++;
+
+	return result;
+}
+
+static bool
+_mmap_flush(bool force)
+{
+	if (g_mmap.dirty_since == 0) {
+		return false;
+	}
+
+	if (!force && hrt_elapsed_time(&g_mmap.dirty_since) < DM_CACHE_FLUSH_INTERVAL) {
+		return true;
+	}
+
+	if (msync(dm_operations_data.ram.data, g_mmap.size, MS_SYNC) != 0) {
+		/* retried later, the next write-through item fails if it still does */
+		PX4_ERR("msync failed %d", errno);
+		g_mmap.dirty_since = hrt_absolute_time();
+		return true;
+	}
+
+	g_mmap.dirty_since = 0;
+	g_mmap.syncs++;
+	return false;
+}
+
+static int
+_mmap_initialize(unsigned max_offset)
+{
+	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
+
+	int fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		signal_init_done(); /* Don't want to hang startup */
+		return -1;
+	}
+
+	/* a file written by the file backend can be shorter, missing items read as empty */
+	struct stat st;
+
+	if (fstat(fd, &st) != 0 || ((size_t)st.st_size < max_offset && ftruncate(fd, max_offset) != 0)) {
+		close(fd);
+		PX4_WARN("Could not resize data manager file %s", k_data_manager_device_path);
+		signal_init_done(); /* Don't want to hang startup */
+		return -1;
+	}
+
+	void *data = mmap(nullptr, max_offset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	/* the mapping stays valid after closing the file */
+	close(fd);
+
+	if (data == MAP_FAILED) {
+		PX4_WARN("Could not map data manager file (%d), using file I/O", errno);
+		g_dm_ops = &dm_file_operations;
+		return g_dm_ops->initialize(max_offset);
+	}
+
+	g_mmap = {};
+	g_mmap.size = max_offset;
+	dm_operations_data.ram.data = (uint8_t *)data;
+	dm_operations_data.ram.data_end = &dm_operations_data.ram.data[max_offset - 1];
+
+	_file_check_compat(file_existed);
 
 	dm_operations_data.running = true;
 
 	return 0;
 }
+
+static void
+_mmap_shutdown()
+{
+	_mmap_flush(true);
+	munmap(dm_operations_data.ram.data, g_mmap.size);
+	dm_operations_data.running = false;
+}
 #endif
 
 static int
@@ -617,7 +1049,7 @@ _ram_initialize(unsigned max_offset)
 
 	if (dm_operations_data.ram.data == nullptr) {
 		PX4_WARN("Could not allocate %u bytes of memory", max_offset);
-		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		signal_init_done(); /* Don't want to hang startup */
 		return -1;
 	}
 
@@ -632,6 +1064,10 @@ _ram_initialize(unsigned max_offset)
 static void
 _file_shutdown()
 {
+	_file_flush(true);
+	free(g_file_cache.entries);
+	g_file_cache.entries = nullptr;
+	g_file_cache.num_entries = 0;
 	close(dm_operations_data.file.fd);
 	dm_operations_data.running = false;
 }
@@ -652,7 +1088,11 @@ task_main(int argc, char *argv[])
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 
 	case BACKEND_FILE:
+#ifdef CONFIG_DATAMAN_MMAP
+		g_dm_ops = g_file_io ? &dm_file_operations : &dm_mmap_operations;
+#else
 		g_dm_ops = &dm_file_operations;
+#endif
 		break;
 #endif
 
@@ -691,6 +1131,12 @@ task_main(int argc, char *argv[])
 	_dm_read_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": read");
 	_dm_write_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": write");
 
+	if (g_init_async) {
+		/* requests published from now on are handled once the backend is initialized
+		 * (clients resend requests that are not answered in time) */
+		signal_init_done();
+	}
+
 	int ret = g_dm_ops->initialize(max_offset);
 
 	if (ret) {
@@ -702,7 +1148,8 @@ task_main(int argc, char *argv[])
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 
 	case BACKEND_FILE:
-		PX4_INFO("data manager file '%s' size is %u bytes", k_data_manager_device_path, max_offset);
+		PX4_INFO("data manager file '%s' size is %u bytes%s", k_data_manager_device_path, max_offset,
+			 g_dm_ops == &dm_file_operations ? "" : " (memory-mapped)");
 
 		break;
 #endif
@@ -720,12 +1167,15 @@ task_main(int argc, char *argv[])
 	fds.events = POLLIN;
 
 	/* Tell startup that the worker thread has completed its initialization */
-	px4_sem_post(&g_init_sema);
+	signal_init_done();
 
 	/* Start the endless loop, waiting for then processing work requests */
 	while (true) {
 
-		ret = px4_poll(&fds, 1, 1000);
+		/* wake up sooner while writes are pending in the cache */
+		const bool flush_pending = g_dm_ops->flush && g_dm_ops->flush(false);
+
+		ret = px4_poll(&fds, 1, flush_pending ? 100 : 1000);
 
 		if (ret > 0) {
 
@@ -778,22 +1228,35 @@ task_main(int argc, char *argv[])
 
 					break;
 
-				case DM_READ:
+				case DM_READ: {
+						/* A batch read is answered with one response per item, the last one is published below */
+						const uint8_t count = request.count > dataman_request_s::MAX_BATCH_COUNT ? dataman_request_s::MAX_BATCH_COUNT :
+								      (request.count > 0 ? request.count : 1);
 
-					g_func_counts[DM_READ]++;
-					perf_begin(_dm_read_perf);
-					result = g_dm_ops->read(static_cast<dm_item_t>(request.item), request.index,
-								&(response.data), request.data_length);
+						for (uint8_t i = 0; i < count; ++i) {
+							if (i > 0) {
+								response.timestamp = hrt_absolute_time();
+								dataman_response_pub.publish(response);
+								memset(response.data, 0, sizeof(response.data));
+							}
 
-					perf_end(_dm_read_perf);
+							response.index = request.index + i;
 
-					if (result >= 0) {
-						response.status = dataman_response_s::STATUS_SUCCESS;
+							g_func_counts[DM_READ]++;
+							perf_begin(_dm_read_perf);
+							result = g_dm_ops->read(static_cast<dm_item_t>(request.item), response.index,
+										&(response.data), request.data_length);
 
-					} else {
-						response.status = dataman_response_s::STATUS_FAILURE_READ_FAILED;
-					}
+							perf_end(_dm_read_perf);
 
+							if (result >= 0) {
+								response.status = dataman_response_s::STATUS_SUCCESS;
+
+							} else {
+								response.status = dataman_response_s::STATUS_FAILURE_READ_FAILED;
+							}
+						}
+					}
 					break;
 
 				case DM_CLEAR:
@@ -846,6 +1309,7 @@ static int
 start()
 {
 	px4_sem_init(&g_init_sema, 1, 0);
+	g_init_signaled = false;
 
 	/* g_init_sema use case is a signal */
 
@@ -877,6 +1341,23 @@ status()
 
 	perf_print_counter(_dm_read_perf);
 	perf_print_counter(_dm_write_perf);
+
+#ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+
+	if (backend == BACKEND_FILE) {
+#ifdef CONFIG_DATAMAN_MMAP
+
+		if (g_dm_ops == &dm_mmap_operations) {
+			PX4_INFO("Mapped   %zu bytes, %u syncs", g_mmap.size, g_mmap.syncs);
+			return;
+		}
+
+#endif
+		PX4_INFO("Cache    %u items, %u hits, %u misses, %u flushes, %u flush errors", g_file_cache.num_entries,
+			 g_file_cache.hits, g_file_cache.misses, g_file_cache.flushes, g_file_cache.flush_errors);
+	}
+
+#endif
 }
 
 static void
@@ -903,6 +1384,13 @@ Each type has a specific type and a fixed maximum amount of storage items, so th
 ### Implementation
 Reading and writing a single item is always atomic.
 
+The file backend keeps the most recently used items in a RAM cache (`DATAMAN_FILE_CACHE_ITEMS`).
+Mission and geofence items are written behind and flushed in file order with a single sync,
+at the latest after 500 ms and always before a state item is written.
+Safe points and state items are written and synced to the file immediately.
+If the pending items can't be written out, they are kept in the cache and retried, and the next safe point or state item write fails.
+On POSIX targets (`DATAMAN_MMAP`) the file is memory-mapped instead (unless started with `-i`), with the same sync points.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("dataman", "system");
@@ -911,6 +1399,10 @@ Reading and writing a single item is always atomic.
 	PRINT_MODULE_USAGE_PARAM_STRING('f', nullptr, "<file>", "Storage file", true);
 #endif
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Use RAM backend (NOT persistent)", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('a', "Return without waiting for the storage to be initialized", true);
+#ifdef CONFIG_DATAMAN_MMAP
+	PRINT_MODULE_USAGE_PARAM_FLAG('i', "Use file I/O with the item cache instead of memory-mapping the file", true);
+#endif
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f and -r are mutually exclusive. If nothing is specified, a file 'dataman' is used");
 #endif
@@ -947,9 +1439,13 @@ dataman_main(int argc, char *argv[])
 		int dmoptind = 1;
 		const char *dmoptarg = nullptr;
 
+#ifdef CONFIG_DATAMAN_MMAP
+		g_file_io = false;
+#endif
+
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:r", &dmoptind, &dmoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "f:rai", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				if (backend_check()) {
@@ -974,6 +1470,16 @@ dataman_main(int argc, char *argv[])
 				backend = BACKEND_RAM;
 				break;
 
+			case 'a':
+				g_init_async = true;
+				break;
+
+			case 'i':
+#ifdef CONFIG_DATAMAN_MMAP
+				g_file_io = true;
+#endif
+				break;
+
 			//no break
 			default:
 				usage();
@@ -992,7 +1498,7 @@ dataman_main(int argc, char *argv[])
 
 		start();
 
-		if (!is_running()) {
+		if (!g_init_async && !is_running()) {
 			PX4_ERR("dataman start failed");
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 			free(k_data_manager_device_path);
@@ -44,13 +44,19 @@
 #include <cstdio>
 #include <cstring>
 
+// With CONFIG_EKF2_STATIC_BUFFERS the storage of every buffer (CONFIG_EKF2_BUFFER_LENGTH samples) is part of the
+// object and allocate() only selects the used length, the buffer memory is fixed when the estimator is created
 template <typename data_type>
 class RingBuffer
 {
 public:
+	RingBuffer() = default;
 	explicit RingBuffer(size_t size) { allocate(size); }
-	RingBuffer() = delete;
+#if defined(CONFIG_EKF2_STATIC_BUFFERS)
+	~RingBuffer() = default;
+#else
 	~RingBuffer() { delete[] _buffer; }
+#endif // CONFIG_EKF2_STATIC_BUFFERS
 
 	// no copy, assignment, move, move assignment
 	RingBuffer(const RingBuffer &) = delete;
@@ -69,6 +75,14 @@ public:
 			return false;
 		}
 
+#if defined(CONFIG_EKF2_STATIC_BUFFERS)
+
+		if (size > kMaxSize) {
+			return false;
+		}
+
+#else
+
 		if (_buffer != nullptr) {
 			delete[] _buffer;
 		}
@@ -79,6 +93,8 @@ public:
 			return false;
 		}
 
+#endif // CONFIG_EKF2_STATIC_BUFFERS
+
 		_size = size;
 
 		reset();
@@ -88,6 +104,10 @@ public:
 
 	bool valid() const { return (_buffer != nullptr) && (_size > 0); }
 
+#if defined(CONFIG_EKF2_STATIC_BUFFERS)
+	static constexpr uint8_t kMaxSize = CONFIG_EKF2_BUFFER_LENGTH;
+#endif // CONFIG_EKF2_STATIC_BUFFERS
+
 	void push(const data_type &sample)
 	{
 		uint8_t head_new = _head;
@@ -119,6 +139,12 @@ public:
 
 	bool pop_first_older_than(const uint64_t &timestamp, data_type *sample)
 	{
+		// nothing buffered or all buffered samples are newer than timestamp (the common case for
+		// inactive sensors or between two samples), skip the search
+		if (_first_write || (_buffer[_tail].time_us > timestamp)) {
+			return false;
+		}
+
 		// start looking from newest observation data
 		for (uint8_t i = 0; i < _size; i++) {
 			int index = (_head - i);
@@ -153,8 +179,13 @@ public:
 		return false;
 	}
 
+#if defined(CONFIG_EKF2_STATIC_BUFFERS)
+	int get_used_size() const { return sizeof(*this) - sizeof(data_type) * (kMaxSize - entries()); }
+	int get_total_size() const { return sizeof(*this); }
+#else
 	int get_used_size() const { return sizeof(*this) + sizeof(data_type) * entries(); }
 	int get_total_size() const { return sizeof(*this) + sizeof(data_type) * _size; }
+#endif // CONFIG_EKF2_STATIC_BUFFERS
 
 	int entries() const
 	{
@@ -183,7 +214,12 @@ public:
 	}
 
 private:
+#if defined(CONFIG_EKF2_STATIC_BUFFERS)
+	data_type _storage[kMaxSize] {};
+	data_type *const _buffer{_storage};
+#else
 	data_type *_buffer{nullptr};
+#endif // CONFIG_EKF2_STATIC_BUFFERS
 
 	uint8_t _head{0};
 	uint8_t _tail{0};
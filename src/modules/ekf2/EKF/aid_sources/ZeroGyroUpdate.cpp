@@ -63,12 +63,20 @@ bool ZeroGyroUpdate::update(Ekf &ekf, const estimator::imuSample &imu_delayed)
 
 			const float obs_var = sq(math::constrain(ekf.getGyroNoise(), 0.f, 1.f));
 
+			const Vector3f gyro_bias_var = ekf.getGyroBiasVariance();
+
+			float innovation[3];
+			float innov_var[3];
+			float R[3];
+
 			for (unsigned i = 0; i < 3; i++) {
-				const float innovation = ekf.state().gyro_bias(i) - gyro_bias(i);
-				const float innov_var = ekf.getGyroBiasVariance()(i) + obs_var;
-				ekf.fuseDirectStateMeasurement(innovation, innov_var, obs_var, State::gyro_bias.idx + i);
+				innovation[i] = ekf.state().gyro_bias(i) - gyro_bias(i);
+				innov_var[i] = gyro_bias_var(i) + obs_var;
+				R[i] = obs_var;
 			}
 
+			ekf.fuseDirectStateMeasurements(innovation, innov_var, R, State::gyro_bias.idx);
+
 			// Reset the integrators
 			_zgup_delta_ang.setZero();
 			_zgup_delta_ang_dt = 0.f;
@@ -62,13 +62,20 @@ bool ZeroVelocityUpdate::update(Ekf &ekf, const estimator::imuSample &imu_delaye
 			// Set a low variance initially for faster leveling and higher
 			// later to let the states follow the measurements
 			const float obs_var = ekf.control_status_flags().tilt_align ? sq(0.2f) : sq(0.001f);
-			Vector3f innov_var = ekf.getVelocityVariance() + obs_var;
+			const Vector3f vel_var = ekf.getVelocityVariance();
+
+			float innovation[3];
+			float innov_var[3];
+			float R[3];
 
 			for (unsigned i = 0; i < 3; i++) {
-				const float innovation = ekf.state().vel(i) - vel_obs(i);
-				ekf.fuseDirectStateMeasurement(innovation, innov_var(i), obs_var, State::vel.idx + i);
+				innovation[i] = ekf.state().vel(i) - vel_obs(i);
+				innov_var[i] = vel_var(i) + obs_var;
+				R[i] = obs_var;
 			}
 
+			ekf.fuseDirectStateMeasurements(innovation, innov_var, R, State::vel.idx);
+
 			_time_last_fuse = imu_delayed.time_us;
 
 			return true;
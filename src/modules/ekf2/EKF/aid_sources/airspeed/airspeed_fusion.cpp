@@ -87,7 +87,7 @@ void Ekf::controlAirDataFusion(const imuSample &imu_delayed)
 		return;
 	}
 
-	if (_airspeed_buffer && _airspeed_buffer->pop_first_older_than(imu_delayed.time_us, &_airspeed_sample_delayed)) {
+	if (_airspeed_buffer.valid() && _airspeed_buffer.pop_first_older_than(imu_delayed.time_us, &_airspeed_sample_delayed)) {
 
 		const airspeedSample &airspeed_sample = _airspeed_sample_delayed;
 
@@ -35,10 +35,10 @@
 
 void Ekf::controlAuxVelFusion(const imuSample &imu_sample)
 {
-	if (_auxvel_buffer) {
+	if (_auxvel_buffer.valid()) {
 		auxVelSample sample;
 
-		if (_auxvel_buffer->pop_first_older_than(imu_sample.time_us, &sample)) {
+		if (_auxvel_buffer.pop_first_older_than(imu_sample.time_us, &sample)) {
 
 			updateAidSourceStatus(_aid_src_aux_vel,
 					      sample.time_us,                                           // sample timestamp
@@ -45,7 +45,7 @@
 
 void Ekf::controlDragFusion(const imuSample &imu_delayed)
 {
-	if ((_params.ekf2_drag_ctrl > 0) && _drag_buffer) {
+	if ((_params.ekf2_drag_ctrl > 0) && _drag_buffer.valid()) {
 
 		if (!_control_status.flags.wind && !_control_status.flags.fake_pos && _control_status.flags.in_air) {
 			_control_status.flags.wind = true;
@@ -57,7 +57,7 @@ void Ekf::controlDragFusion(const imuSample &imu_delayed)
 
 		dragSample drag_sample;
 
-		if (_drag_buffer->pop_first_older_than(imu_delayed.time_us, &drag_sample)) {
+		if (_drag_buffer.pop_first_older_than(imu_delayed.time_us, &drag_sample)) {
 			fuseDrag(drag_sample);
 		}
 	}
@@ -47,7 +47,7 @@ void Ekf::controlExternalVisionFusion(const imuSample &imu_sample)
 	// Check for new external vision data
 	extVisionSample ev_sample;
 
-	if (_ext_vision_buffer && _ext_vision_buffer->pop_first_older_than(imu_sample.time_us, &ev_sample)) {
+	if (_ext_vision_buffer.valid() && _ext_vision_buffer.pop_first_older_than(imu_sample.time_us, &ev_sample)) {
 
 		bool ev_reset = (ev_sample.reset_counter != _ev_sample_prev.reset_counter);
 
@@ -59,7 +59,7 @@ void Ekf::controlExternalVisionFusion(const imuSample &imu_sample)
 				&& ((_params.ekf2_ev_qmin <= 0)
 				    || (_ev_sample_prev.quality >= _params.ekf2_ev_qmin)) // previous quality sufficient
 				&& ((_params.ekf2_ev_qmin <= 0)
-				    || (_ext_vision_buffer->get_newest().quality >= _params.ekf2_ev_qmin)) // newest quality sufficient
+				    || (_ext_vision_buffer.get_newest().quality >= _params.ekf2_ev_qmin)) // newest quality sufficient
 				&& isNewestSampleRecent(_time_last_ext_vision_buffer_push, EV_MAX_INTERVAL);
 
 		updateEvAttitudeErrorFilter(ev_sample, ev_reset);
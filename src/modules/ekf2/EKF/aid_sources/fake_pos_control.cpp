@@ -109,10 +109,8 @@ bool Ekf::runFakePosStateMachine(const bool enable_conditions_passing, bool stat
 	if (status_flag) {
 		if (enable_conditions_passing) {
 			if (!aid_src.innovation_rejected) {
-				for (unsigned i = 0; i < 2; i++) {
-					fuseDirectStateMeasurement(aid_src.innovation[i], aid_src.innovation_variance[i], aid_src.observation_variance[i],
-								   State::pos.idx + i);
-				}
+				fuseDirectStateMeasurements(aid_src.innovation, aid_src.innovation_variance, aid_src.observation_variance,
+							    State::pos.idx);
 
 				aid_src.fused = true;
 				aid_src.time_last_fuse = _time_delayed_us;
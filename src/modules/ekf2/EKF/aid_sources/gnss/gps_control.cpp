@@ -41,7 +41,7 @@
 
 void Ekf::controlGpsFusion(const imuSample &imu_delayed)
 {
-	if (!_gps_buffer || (_params.ekf2_gps_ctrl == 0)) {
+	if (!_gps_buffer.valid() || (_params.ekf2_gps_ctrl == 0)) {
 		stopGnssFusion();
 		return;
 	}
@@ -58,7 +58,7 @@ void Ekf::controlGpsFusion(const imuSample &imu_delayed)
 	_gps_intermittent = !isNewestSampleRecent(_time_last_gps_buffer_push, 2 * GNSS_MAX_INTERVAL);
 
 	// check for arrival of new sensor data at the fusion time horizon
-	_gps_data_ready = _gps_buffer->pop_first_older_than(imu_delayed.time_us, &_gps_sample_delayed);
+	_gps_data_ready = _gps_buffer.pop_first_older_than(imu_delayed.time_us, &_gps_sample_delayed);
 
 	if (_gps_data_ready) {
 		const gnssSample &gnss_sample = _gps_sample_delayed;
@@ -61,7 +61,7 @@ void Ekf::controlMagFusion(const imuSample &imu_sample)
 
 	magSample mag_sample;
 
-	if (_mag_buffer && _mag_buffer->pop_first_older_than(imu_sample.time_us, &mag_sample)) {
+	if (_mag_buffer.valid() && _mag_buffer.pop_first_older_than(imu_sample.time_us, &mag_sample)) {
 
 		if (mag_sample.reset || (_mag_counter == 0)) {
 			// sensor or calibration has changed, reset low pass filter
@@ -626,9 +626,13 @@ float Ekf::getMagDeclination()
 bool Ekf::updateWorldMagneticModel(const double latitude_deg, const double longitude_deg)
 {
 	// set the magnetic field data returned by the geo library using the current GPS position
-	const float declination_rad = math::radians(get_mag_declination_degrees(latitude_deg, longitude_deg));
-	const float inclination_rad = math::radians(get_mag_inclination_degrees(latitude_deg, longitude_deg));
-	const float strength_gauss = get_mag_strength_gauss(latitude_deg, longitude_deg);
+	float declination_deg = NAN;
+	float inclination_deg = NAN;
+	float strength_gauss = NAN;
+	get_mag_field(latitude_deg, longitude_deg, declination_deg, inclination_deg, strength_gauss, &_wmm_lookup_cache);
+
+	const float declination_rad = math::radians(declination_deg);
+	const float inclination_rad = math::radians(inclination_deg);
 
 	if (PX4_ISFINITE(declination_rad) && PX4_ISFINITE(inclination_rad) && PX4_ISFINITE(strength_gauss)) {
 
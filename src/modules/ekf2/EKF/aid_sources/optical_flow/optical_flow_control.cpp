@@ -42,7 +42,7 @@
 
 void Ekf::controlOpticalFlowFusion(const imuSample &imu_delayed)
 {
-	if (!_flow_buffer || (_params.ekf2_of_ctrl != 1)) {
+	if (!_flow_buffer.valid() || (_params.ekf2_of_ctrl != 1)) {
 		stopFlowFusion();
 		return;
 	}
@@ -50,7 +50,7 @@ void Ekf::controlOpticalFlowFusion(const imuSample &imu_delayed)
 	VectorState H;
 
 	// New optical flow data is available and is ready to be fused when the midpoint of the sample falls behind the fusion time horizon
-	if (_flow_buffer->pop_first_older_than(imu_delayed.time_us, &_flow_sample_delayed)) {
+	if (_flow_buffer.pop_first_older_than(imu_delayed.time_us, &_flow_sample_delayed)) {
 
 		// flow gyro has opposite sign convention
 		_ref_body_rate = -(imu_delayed.delta_ang / imu_delayed.delta_ang_dt - getGyroBias());
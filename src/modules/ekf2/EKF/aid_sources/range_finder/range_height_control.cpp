@@ -46,9 +46,9 @@ void Ekf::controlRangeHaglFusion(const imuSample &imu_sample)
 
 	bool rng_data_ready = false;
 
-	if (_range_buffer) {
+	if (_range_buffer.valid()) {
 		// Get range data from buffer and check validity
-		rng_data_ready = _range_buffer->pop_first_older_than(imu_sample.time_us, _range_sensor.getSampleAddress());
+		rng_data_ready = _range_buffer.pop_first_older_than(imu_sample.time_us, _range_sensor.getSampleAddress());
 		_range_sensor.setDataReadiness(rng_data_ready);
 
 		// update range sensor angle parameters in case they have changed
@@ -49,10 +49,10 @@ void Ekf::controlFusionModes(const imuSample &imu_delayed)
 	_control_status_prev.value = _control_status.value;
 	_state_reset_count_prev = _state_reset_status.reset_count;
 
-	if (_system_flag_buffer) {
+	if (_system_flag_buffer.valid()) {
 		systemFlagUpdate system_flags_delayed;
 
-		if (_system_flag_buffer->pop_first_older_than(imu_delayed.time_us, &system_flags_delayed)) {
+		if (_system_flag_buffer.pop_first_older_than(imu_delayed.time_us, &system_flags_delayed)) {
 
 			set_vehicle_at_rest(system_flags_delayed.at_rest);
 			set_in_air_status(system_flags_delayed.in_air);
@@ -42,7 +42,7 @@
  */
 
 #include "ekf.h"
-#include <ekf_derivation/generated/predict_covariance.h>
+#include "covariance_prediction.hpp"
 
 #include <math.h>
 #include <mathlib/mathlib.h>
@@ -133,11 +133,26 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 		}
 	}
 
-	// calculate variances and upper diagonal covariances for quaternion, velocity, position and gyro bias states
-	P = sym::PredictCovariance(_state.vector(), P,
-				   imu_delayed.delta_vel / imu_delayed.delta_vel_dt, accel_var,
-				   imu_delayed.delta_ang / imu_delayed.delta_ang_dt, gyro_var,
-				   dt);
+	const Vector3f accel = imu_delayed.delta_vel / imu_delayed.delta_vel_dt;
+
+	static constexpr unsigned kKinematicDof = CovariancePrediction::kKinematicDof;
+	const CovariancePrediction prediction(_state, accel, dt);
+
+	// the remaining states (mag, wind, terrain) are stationary and only change through their covariance with the
+	// kinematic states, skip the ones that are uncorrelated (inhibited or freshly reset) as a zero covariance stays zero
+	for (unsigned column = kKinematicDof; column < State::size; column++) {
+		for (unsigned row = 0; row < kKinematicDof; row++) {
+			if (fabsf(P(row, column)) > 0.f) {
+				const matrix::Vector<float, kKinematicDof> P_cross = P.slice<kKinematicDof, 1>(0, column);
+				P.slice<kKinematicDof, 1>(0, column) = prediction.cross(P_cross);
+				break;
+			}
+		}
+	}
+
+	// calculate variances and covariances of the kinematic states
+	const matrix::SquareMatrix<float, kKinematicDof> P_kinematic = P.slice<kKinematicDof, kKinematicDof>(0, 0);
+	P.slice<kKinematicDof, kKinematicDof>(0, 0) = prediction.kinematic(P_kinematic, accel_var, gyro_var);
 
 	// Construct the process noise variance diagonal for those states with a stationary process model
 	// These are kinematic states and their error growth is controlled separately by the IMU noise variances
@@ -232,11 +247,7 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 #endif // CONFIG_EKF2_TERRAIN
 
 	// covariance matrix is symmetrical, so copy upper half to lower half
-	for (unsigned row = 0; row < State::size; row++) {
-		for (unsigned column = 0; column < row; column++) {
-			P(row, column) = P(column, row);
-		}
-	}
+	P.copyUpperToLowerTriangle();
 
 	constrainStateVariances();
 }
@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file covariance_prediction.hpp
+ * @brief Block-wise covariance prediction of the IMU driven (kinematic) states
+ *
+ * Hand-written equivalent of predict_covariance() in ekf_derivation/derivation.py restricted to
+ * the quaternion, velocity, position and IMU bias states. The remaining states are stationary,
+ * so only their covariance with the kinematic states is propagated, which skips the work for
+ * uncorrelated states. Checked against the generated full prediction in
+ * test/test_EKF_covariance_prediction_blockwise.cpp, keep both in sync with the derivation.
+ *
+ * Error-state transition of the kinematic states (3x3 blocks, a = accel - accel_bias):
+ *
+ *     | I               0     0  -R*dt   0     |  theta
+ *     | -[R*a]x * dt    I     0   0     -R*dt  |  vel
+ *     | 0               I*dt  I   0      0     |  pos
+ *     | 0               0     0   I      0     |  gyro_bias
+ *     | 0               0     0   0      I     |  accel_bias
+ */
+
+#ifndef EKF_COVARIANCE_PREDICTION_HPP
+#define EKF_COVARIANCE_PREDICTION_HPP
+
+#include <ekf_derivation/generated/state.h>
+#include <matrix/math.hpp>
+
+namespace estimator
+{
+
+class CovariancePrediction
+{
+public:
+	// quaternion, velocity, position and IMU bias states, the only states with an IMU driven process model
+	static constexpr unsigned kKinematicDof = State::accel_bias.idx + State::accel_bias.dof;
+
+	CovariancePrediction(const StateSample &state, const matrix::Vector3f &accel, float dt) :
+		_R_dt(matrix::Dcmf(state.quat_nominal) * dt),
+		_vel_theta(-matrix::Vector3f(_R_dt * (accel - state.accel_bias)).hat()),
+		_dt(dt)
+	{}
+
+	/**
+	 * Predict the variances and covariances of the kinematic states
+	 * @param P kinematic block of the covariance matrix
+	 * @param accel_var accelerometer noise variance (m/s^2)^2
+	 * @param gyro_var gyro noise variance (rad/s)^2
+	 */
+	matrix::SquareMatrix<float, kKinematicDof> kinematic(const matrix::SquareMatrix<float, kKinematicDof> &P,
+			const matrix::Vector3f &accel_var, float gyro_var) const
+	{
+		// A * P * A^T, using the symmetry of P: (A * P)^T = P * A^T
+		const matrix::Matrix<float, kKinematicDof, kKinematicDof> AP = transition(P);
+		matrix::SquareMatrix<float, kKinematicDof> P_new = transition(AP.transpose());
+
+		// G * var_u * G^T, the IMU noise enters the angle and velocity errors through -R * dt
+		const matrix::SquareMatrix3f theta_noise = _R_dt * _R_dt.transpose() * gyro_var;
+		const matrix::SquareMatrix3f vel_noise = _R_dt * matrix::diag(accel_var) * _R_dt.transpose();
+
+		P_new.slice<3, 3>(State::quat_nominal.idx, State::quat_nominal.idx) += theta_noise;
+		P_new.slice<3, 3>(State::vel.idx, State::vel.idx) += vel_noise;
+
+		return P_new;
+	}
+
+	/**
+	 * Predict the covariance between the kinematic states and a single stationary state
+	 * @param P_cross column of the covariance matrix above the stationary state
+	 */
+	matrix::Vector<float, kKinematicDof> cross(const matrix::Vector<float, kKinematicDof> &P_cross) const
+	{
+		return transition(P_cross);
+	}
+
+private:
+	// left multiplication by the transition matrix, exploiting its sparsity
+	template<size_t N>
+	matrix::Matrix<float, kKinematicDof, N> transition(const matrix::Matrix<float, kKinematicDof, N> &M) const
+	{
+		const matrix::Matrix<float, 3, N> theta = M.template slice<3, N>(State::quat_nominal.idx, 0);
+		const matrix::Matrix<float, 3, N> vel = M.template slice<3, N>(State::vel.idx, 0);
+		const matrix::Matrix<float, 3, N> gyro_bias = M.template slice<3, N>(State::gyro_bias.idx, 0);
+		const matrix::Matrix<float, 3, N> accel_bias = M.template slice<3, N>(State::accel_bias.idx, 0);
+
+		matrix::Matrix<float, kKinematicDof, N> res = M;
+		res.template slice<3, N>(State::quat_nominal.idx, 0) -= _R_dt * gyro_bias;
+		res.template slice<3, N>(State::vel.idx, 0) += _vel_theta * theta - _R_dt * accel_bias;
+		res.template slice<3, N>(State::pos.idx, 0) += vel * _dt;
+
+		return res;
+	}
+
+	const matrix::SquareMatrix3f _R_dt; // rotation from body to earth frame scaled by dt
+	const matrix::SquareMatrix3f _vel_theta; // velocity error per angle error: -[R*a]x * dt
+	const float _dt;
+};
+
+} // namespace estimator
+
+#endif // !EKF_COVARIANCE_PREDICTION_HPP
@@ -413,7 +413,7 @@ void Ekf::updateParameters()
 template<typename T>
 static void printRingBuffer(const char *name, RingBuffer<T> *rb)
 {
-	if (rb) {
+	if (rb->valid()) {
 		printf("%s: %d/%d entries (%d/%d Bytes) (%zu Bytes per entry)\n",
 		       name,
 		       rb->entries(), rb->get_length(), rb->get_used_size(), rb->get_total_size(),
@@ -503,42 +503,42 @@ void Ekf::print_status()
 	printf("minimum observation interval %d us\n", _min_obs_interval_us);
 
 	printRingBuffer("IMU buffer", &_imu_buffer);
-	printRingBuffer("system flag buffer", _system_flag_buffer);
+	printRingBuffer("system flag buffer", &_system_flag_buffer);
 
 #if defined(CONFIG_EKF2_AIRSPEED)
-	printRingBuffer("airspeed buffer", _airspeed_buffer);
+	printRingBuffer("airspeed buffer", &_airspeed_buffer);
 #endif // CONFIG_EKF2_AIRSPEED
 
 #if defined(CONFIG_EKF2_AUXVEL)
-	printRingBuffer("aux vel buffer", _auxvel_buffer);
+	printRingBuffer("aux vel buffer", &_auxvel_buffer);
 #endif // CONFIG_EKF2_AUXVEL
 
 #if defined(CONFIG_EKF2_BAROMETER)
-	printRingBuffer("baro buffer", _baro_buffer);
+	printRingBuffer("baro buffer", &_baro_buffer);
 #endif // CONFIG_EKF2_BAROMETER
 
 #if defined(CONFIG_EKF2_DRAG_FUSION)
-	printRingBuffer("drag buffer", _drag_buffer);
+	printRingBuffer("drag buffer", &_drag_buffer);
 #endif // CONFIG_EKF2_DRAG_FUSION
 
 #if defined(CONFIG_EKF2_EXTERNAL_VISION)
-	printRingBuffer("ext vision buffer", _ext_vision_buffer);
+	printRingBuffer("ext vision buffer", &_ext_vision_buffer);
 #endif // CONFIG_EKF2_EXTERNAL_VISION
 
 #if defined(CONFIG_EKF2_GNSS)
-	printRingBuffer("gps buffer", _gps_buffer);
+	printRingBuffer("gps buffer", &_gps_buffer);
 #endif // CONFIG_EKF2_GNSS
 
 #if defined(CONFIG_EKF2_MAGNETOMETER)
-	printRingBuffer("mag buffer", _mag_buffer);
+	printRingBuffer("mag buffer", &_mag_buffer);
 #endif // CONFIG_EKF2_MAGNETOMETER
 
 #if defined(CONFIG_EKF2_OPTICAL_FLOW)
-	printRingBuffer("flow buffer", _flow_buffer);
+	printRingBuffer("flow buffer", &_flow_buffer);
 #endif // CONFIG_EKF2_OPTICAL_FLOW
 
 #if defined(CONFIG_EKF2_RANGE_FINDER)
-	printRingBuffer("range buffer", _range_buffer);
+	printRingBuffer("range buffer", &_range_buffer);
 #endif // CONFIG_EKF2_RANGE_FINDER
 
 
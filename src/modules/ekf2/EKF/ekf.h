@@ -56,6 +56,8 @@
 
 #include <ekf_derivation/generated/state.h>
 
+#include <lib/world_magnetic_model/geo_mag_declination.h>
+
 #include <uORB/topics/estimator_aid_source1d.h>
 #include <uORB/topics/estimator_aid_source2d.h>
 #include <uORB/topics/estimator_aid_source3d.h>
@@ -75,6 +77,11 @@ class Ekf final : public EstimatorInterface
 public:
 	typedef matrix::Vector<float, State::size> VectorState;
 	typedef matrix::SquareMatrix<float, State::size> SquareMatrixState;
+#if defined(CONFIG_EKF2_PACKED_COVARIANCE)
+	typedef matrix::SymmetricMatrix<float, State::size> CovarianceMatrixState;
+#else
+	typedef SquareMatrixState CovarianceMatrixState;
+#endif // CONFIG_EKF2_PACKED_COVARIANCE
 
 	Ekf()
 	{
@@ -170,10 +177,10 @@ public:
 	matrix::Vector<float, S.dof>getStateVariance() const { return P.slice<S.dof, S.dof>(S.idx, S.idx).diag(); } // calling getStateCovariance().diag() uses more flash space
 
 	template <const IdxDof &S>
-	matrix::SquareMatrix<float, S.dof>getStateCovariance() const { return P.slice<S.dof, S.dof>(S.idx, S.idx); }
+	matrix::SquareMatrix<float, S.dof>getStateCovariance() const { return matrix::SquareMatrix<float, S.dof>(P.slice<S.dof, S.dof>(S.idx, S.idx)); }
 
 	// get the full covariance matrix
-	const matrix::SquareMatrix<float, State::size> &covariances() const { return P; }
+	const CovarianceMatrixState &covariances() const { return P; }
 	float stateCovariance(unsigned r, unsigned c) const { return P(r, c); }
 
 	// get the diagonal elements of the covariance matrix
@@ -261,6 +268,47 @@ public:
 	// fuse single direct state measurement (eg NED velocity, NED position, mag earth field, etc)
 	void fuseDirectStateMeasurement(const float innov, const float innov_var, const float R, const int state_index);
 
+	// fuse direct measurements of N consecutive states sharing the same fusion time horizon (eg NED velocity)
+	// The covariance is updated sequentially and the state correction is applied once. With the innovations and
+	// innovation variances adjusted for the previous updates of the batch, this is equivalent to a joint update.
+	template <size_t N>
+	void fuseDirectStateMeasurements(const float (&innov)[N], const float (&innov_var)[N], const float (&R)[N],
+					 const int state_index)
+	{
+		// the innovation variance can be larger than P + R (e.g.: inflated observation variance)
+		float innov_var_offset[N];
+
+		for (size_t i = 0; i < N; i++) {
+			innov_var_offset[i] = innov_var[i] - P(state_index + i, state_index + i);
+		}
+
+		VectorState correction;
+
+		for (size_t i = 0; i < N; i++) {
+			const int index = state_index + i;
+			const float innovation = innov[i] - correction(index);
+			const float innovation_variance = P(index, index) + innov_var_offset[i];
+
+			VectorState K;
+
+			for (int row = 0; row < State::size; row++) {
+				K(row) = P(row, index) / innovation_variance;
+			}
+
+			clearInhibitedStateKalmanGains(K);
+
+			const VectorState PH = P.row(index);
+			josephCovarianceUpdate(K, PH, P(index, index) + R[i]);
+
+			correction += K * innovation;
+		}
+
+		constrainStateVariances();
+
+		// apply the state corrections
+		fuse(correction, 1.f);
+	}
+
 	bool measurementUpdate(VectorState &K, const VectorState &H, const float R, const float innovation);
 
 	// gyro bias
@@ -516,7 +564,7 @@ private:
 	AlphaFilter<float> _height_rate_lpf{_kHeightRateLpfTimeConstant};
 #endif // CONFIG_EKF2_WIND
 
-	SquareMatrixState P{};	///< state covariance matrix
+	CovarianceMatrixState P{};	///< state covariance matrix
 
 #if defined(CONFIG_EKF2_DRAG_FUSION)
 	estimator_aid_source2d_s _aid_src_drag {};
@@ -626,6 +674,8 @@ private:
 	// Variables used to control activation of post takeoff functionality
 	uint64_t _flt_mag_align_start_time{0};	///< time that inflight magnetic field alignment started (uSec)
 	uint64_t _time_last_mag_check_failing{0};
+
+	MagFieldLookupCache _wmm_lookup_cache{}; ///< world magnetic model grid cell of the last lookup
 #endif // CONFIG_EKF2_MAGNETOMETER
 
 	// variables used to inhibit accel bias learning
@@ -816,6 +866,12 @@ private:
 
 	void clearInhibitedStateKalmanGains(VectorState &K) const;
 
+	// P * H for an observation jacobian H with only a few non-zero elements
+	VectorState covarianceTimesSparse(const VectorState &H) const;
+
+	// Joseph stabilized covariance update of a scalar measurement, given PH = P * H and HPH_R = H.T * P * H + R
+	void josephCovarianceUpdate(const VectorState &K, const VectorState &PH, float HPH_R);
+
 	// limit the diagonal of the covariance matrix
 	void constrainStateVariances();
 
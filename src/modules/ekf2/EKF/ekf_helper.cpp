@@ -1050,34 +1050,9 @@ void Ekf::fuseDirectStateMeasurement(const float innov, const float innov_var, c
 	const VectorState KR = K * R;
 	P += KR.multiplyByTranspose(K);
 #else
-	// Efficient implementation of the Joseph stabilized covariance update
-	// Based on "G. J. Bierman. Factorization Methods for Discrete Sequential Estimation. Academic Press, Dover Publications, New York, 1977, 2006"
-	// P = (I - K * H) * P * (I - K * H).T   + K * R * K.T
-	//   =      P_temp     * (I - H.T * K.T) + K * R * K.T
-	//   =      P_temp - P_temp * H.T * K.T  + K * R * K.T
-
-	// Step 1: conventional update
-	// Compute P_temp and store it in P to avoid allocating more memory
-	// P is symmetric, so PH == H.T * P.T == H.T * P. Taking the row is faster as matrices are row-major
-	VectorState PH = P.row(state_index);
-
-	for (unsigned i = 0; i < State::size; i++) {
-		for (unsigned j = 0; j < State::size; j++) {
-			P(i, j) -= K(i) * PH(j); // P is now not symmetric if K is not optimal (e.g.: some gains have been zeroed)
-		}
-	}
-
-	// Step 2: stabilized update
-	// P (or "P_temp") is not symmetric so we must take the column
-	PH = P.col(state_index);
-
-	for (unsigned i = 0; i < State::size; i++) {
-		for (unsigned j = 0; j <= i; j++) {
-			P(i, j) = P(i, j) - PH(i) * K(j) + K(i) * R * K(j);
-			P(j, i) = P(i, j);
-		}
-	}
-
+	// H selects a single state: P is symmetric, so PH == H.T * P. Taking the row is faster as matrices are row-major
+	const VectorState PH = P.row(state_index);
+	josephCovarianceUpdate(K, PH, P(state_index, state_index) + R);
 #endif
 
 	constrainStateVariances();
@@ -1101,40 +1076,59 @@ bool Ekf::measurementUpdate(VectorState &K, const VectorState &H, const float R,
 	const VectorState KR = K * R;
 	P += KR.multiplyByTranspose(K);
 #else
-	// Efficient implementation of the Joseph stabilized covariance update
-	// Based on "G. J. Bierman. Factorization Methods for Discrete Sequential Estimation. Academic Press, Dover Publications, New York, 1977, 2006"
-	// P = (I - K * H) * P * (I - K * H).T   + K * R * K.T
-	//   =      P_temp     * (I - H.T * K.T) + K * R * K.T
-	//   =      P_temp - P_temp * H.T * K.T  + K * R * K.T
+	const VectorState PH = covarianceTimesSparse(H); // H is stored as a column vector. H is in fact H.T
+	josephCovarianceUpdate(K, PH, H.dot(PH) + R);
+#endif
 
-	// Step 1: conventional update
-	// Compute P_temp and store it in P to avoid allocating more memory
-	// P is symmetric, so PH == H.T * P.T == H.T * P. Taking the row is faster as matrices are row-major
-	VectorState PH = P * H; // H is stored as a column vector. H is in fact H.T
+	constrainStateVariances();
 
-	for (unsigned i = 0; i < State::size; i++) {
-		for (unsigned j = 0; j < State::size; j++) {
-			P(i, j) -= K(i) * PH(j); // P is now not symmetrical if K is not optimal (e.g.: some gains have been zeroed)
+	// apply the state corrections
+	fuse(K, innovation);
+	return true;
+}
+
+Ekf::VectorState Ekf::covarianceTimesSparse(const VectorState &H) const
+{
+	// P is symmetric, so P * H is the sum of the rows of P weighted by the elements of H.
+	// Observation jacobians only depend on a few states, the rows of the other states are skipped.
+	VectorState PH;
+
+	for (unsigned j = 0; j < State::size; j++) {
+		const float H_j = H(j);
+
+		if (fabsf(H_j) > 0.f) {
+			for (unsigned i = 0; i < State::size; i++) {
+				PH(i) += P(j, i) * H_j;
+			}
 		}
 	}
 
-	// Step 2: stabilized update
-	PH = P * H; // H is stored as a column vector. H is in fact H.T
+	return PH;
+}
 
+void Ekf::josephCovarianceUpdate(const VectorState &K, const VectorState &PH, const float HPH_R)
+{
+	// Efficient implementation of the Joseph stabilized covariance update
+	// Based on "G. J. Bierman. Factorization Methods for Discrete Sequential Estimation. Academic Press, Dover Publications, New York, 1977, 2006"
+	// P = (I - K * H) * P * (I - K * H).T   + K * R * K.T
+	//   =      P_temp     * (I - H.T * K.T) + K * R * K.T
+	//   =      P_temp - P_temp * H.T * K.T  + K * R * K.T
+	//
+	// with P_temp = P - K * PH.T and P_temp * H.T = PH - K * H.T * P * H, this expands to the symmetric rank-2 update
+	// P = P - K * PH.T - PH * K.T + (H.T * P * H + R) * K * K.T
+	// which holds for any K (e.g.: some gains have been zeroed), so only the lower triangle needs to be computed
 	for (unsigned i = 0; i < State::size; i++) {
+		const float K_i = K(i);
+		const float PH_i = PH(i);
+		const float KS_i = K_i * HPH_R;
+
+		// contiguous inner loop over the row, without dependencies between the iterations so that it can be vectorized
 		for (unsigned j = 0; j <= i; j++) {
-			P(i, j) = P(i, j) - PH(i) * K(j) + K(i) * R * K(j);
-			P(j, i) = P(i, j);
+			P(i, j) += KS_i * K(j) - K_i * PH(j) - PH_i * K(j);
 		}
 	}
 
-#endif
-
-	constrainStateVariances();
-
-	// apply the state corrections
-	fuse(K, innovation);
-	return true;
+	P.copyLowerToUpperTriangle();
 }
 
 void Ekf::resetAidSourceStatusZeroInnovation(estimator_aid_source1d_s &status) const
@@ -44,37 +44,6 @@
 
 #include <mathlib/mathlib.h>
 
-EstimatorInterface::~EstimatorInterface()
-{
-#if defined(CONFIG_EKF2_GNSS)
-	delete _gps_buffer;
-#endif // CONFIG_EKF2_GNSS
-#if defined(CONFIG_EKF2_MAGNETOMETER)
-	delete _mag_buffer;
-#endif // CONFIG_EKF2_MAGNETOMETER
-#if defined(CONFIG_EKF2_BAROMETER)
-	delete _baro_buffer;
-#endif // CONFIG_EKF2_BAROMETER
-#if defined(CONFIG_EKF2_RANGE_FINDER)
-	delete _range_buffer;
-#endif // CONFIG_EKF2_RANGE_FINDER
-#if defined(CONFIG_EKF2_AIRSPEED)
-	delete _airspeed_buffer;
-#endif // CONFIG_EKF2_AIRSPEED
-#if defined(CONFIG_EKF2_OPTICAL_FLOW)
-	delete _flow_buffer;
-#endif // CONFIG_EKF2_OPTICAL_FLOW
-#if defined(CONFIG_EKF2_EXTERNAL_VISION)
-	delete _ext_vision_buffer;
-#endif // CONFIG_EKF2_EXTERNAL_VISION
-#if defined(CONFIG_EKF2_DRAG_FUSION)
-	delete _drag_buffer;
-#endif // CONFIG_EKF2_DRAG_FUSION
-#if defined(CONFIG_EKF2_AUXVEL)
-	delete _auxvel_buffer;
-#endif // CONFIG_EKF2_AUXVEL
-}
-
 // Accumulate imu data and store to buffer at desired rate
 void EstimatorInterface::setIMUData(const imuSample &imu_sample)
 {
@@ -127,15 +96,9 @@ void EstimatorInterface::setMagData(const magSample &mag_sample)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_mag_buffer == nullptr) {
-		_mag_buffer = new RingBuffer<magSample>(_obs_buffer_length);
-
-		if (_mag_buffer == nullptr || !_mag_buffer->valid()) {
-			delete _mag_buffer;
-			_mag_buffer = nullptr;
-			printBufferAllocationFailed("mag");
-			return;
-		}
+	if (!_mag_buffer.valid() && !_mag_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("mag");
+		return;
 	}
 
 	const int64_t time_us = mag_sample.time_us
@@ -143,16 +106,16 @@ void EstimatorInterface::setMagData(const magSample &mag_sample)
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_mag_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_mag_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		magSample mag_sample_new{mag_sample};
 		mag_sample_new.time_us = time_us;
 
-		_mag_buffer->push(mag_sample_new);
+		_mag_buffer.push(mag_sample_new);
 		_time_last_mag_buffer_push = _time_latest_us;
 
 	} else {
-		ECL_WARN("mag data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _mag_buffer->get_newest().time_us,
+		ECL_WARN("mag data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _mag_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -166,15 +129,9 @@ void EstimatorInterface::setGpsData(const gnssSample &gnss_sample, const bool pp
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_gps_buffer == nullptr) {
-		_gps_buffer = new RingBuffer<gnssSample>(_obs_buffer_length);
-
-		if (_gps_buffer == nullptr || !_gps_buffer->valid()) {
-			delete _gps_buffer;
-			_gps_buffer = nullptr;
-			printBufferAllocationFailed("GPS");
-			return;
-		}
+	if (!_gps_buffer.valid() && !_gps_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("GPS");
+		return;
 	}
 
 	const int64_t delay = pps_compensation ? 0 : static_cast<int64_t>(_params.ekf2_gps_delay * 1000);
@@ -183,13 +140,13 @@ void EstimatorInterface::setGpsData(const gnssSample &gnss_sample, const bool pp
 				- delay
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
-	if (time_us >= static_cast<int64_t>(_gps_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_gps_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		gnssSample gnss_sample_new(gnss_sample);
 
 		gnss_sample_new.time_us = time_us;
 
-		_gps_buffer->push(gnss_sample_new);
+		_gps_buffer.push(gnss_sample_new);
 		_time_last_gps_buffer_push = _time_latest_us;
 
 #if defined(CONFIG_EKF2_GNSS_YAW)
@@ -201,7 +158,7 @@ void EstimatorInterface::setGpsData(const gnssSample &gnss_sample, const bool pp
 #endif // CONFIG_EKF2_GNSS_YAW
 
 	} else {
-		ECL_WARN("GPS data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _gps_buffer->get_newest().time_us,
+		ECL_WARN("GPS data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _gps_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -215,15 +172,9 @@ void EstimatorInterface::setBaroData(const baroSample &baro_sample)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_baro_buffer == nullptr) {
-		_baro_buffer = new RingBuffer<baroSample>(_obs_buffer_length);
-
-		if (_baro_buffer == nullptr || !_baro_buffer->valid()) {
-			delete _baro_buffer;
-			_baro_buffer = nullptr;
-			printBufferAllocationFailed("baro");
-			return;
-		}
+	if (!_baro_buffer.valid() && !_baro_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("baro");
+		return;
 	}
 
 	const int64_t time_us = baro_sample.time_us
@@ -231,16 +182,16 @@ void EstimatorInterface::setBaroData(const baroSample &baro_sample)
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_baro_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_baro_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		baroSample baro_sample_new{baro_sample};
 		baro_sample_new.time_us = time_us;
 
-		_baro_buffer->push(baro_sample_new);
+		_baro_buffer.push(baro_sample_new);
 		_time_last_baro_buffer_push = _time_latest_us;
 
 	} else {
-		ECL_WARN("baro data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _baro_buffer->get_newest().time_us,
+		ECL_WARN("baro data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _baro_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -254,15 +205,9 @@ void EstimatorInterface::setAirspeedData(const airspeedSample &airspeed_sample)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_airspeed_buffer == nullptr) {
-		_airspeed_buffer = new RingBuffer<airspeedSample>(_obs_buffer_length);
-
-		if (_airspeed_buffer == nullptr || !_airspeed_buffer->valid()) {
-			delete _airspeed_buffer;
-			_airspeed_buffer = nullptr;
-			printBufferAllocationFailed("airspeed");
-			return;
-		}
+	if (!_airspeed_buffer.valid() && !_airspeed_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("airspeed");
+		return;
 	}
 
 	const int64_t time_us = airspeed_sample.time_us
@@ -270,15 +215,15 @@ void EstimatorInterface::setAirspeedData(const airspeedSample &airspeed_sample)
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_airspeed_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_airspeed_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		airspeedSample airspeed_sample_new{airspeed_sample};
 		airspeed_sample_new.time_us = time_us;
 
-		_airspeed_buffer->push(airspeed_sample_new);
+		_airspeed_buffer.push(airspeed_sample_new);
 
 	} else {
-		ECL_WARN("airspeed data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _airspeed_buffer->get_newest().time_us,
+		ECL_WARN("airspeed data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _airspeed_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -292,15 +237,9 @@ void EstimatorInterface::setRangeData(const sensor::rangeSample &range_sample)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_range_buffer == nullptr) {
-		_range_buffer = new RingBuffer<sensor::rangeSample>(_obs_buffer_length);
-
-		if (_range_buffer == nullptr || !_range_buffer->valid()) {
-			delete _range_buffer;
-			_range_buffer = nullptr;
-			printBufferAllocationFailed("range");
-			return;
-		}
+	if (!_range_buffer.valid() && !_range_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("range");
+		return;
 	}
 
 	const int64_t time_us = range_sample.time_us
@@ -308,16 +247,16 @@ void EstimatorInterface::setRangeData(const sensor::rangeSample &range_sample)
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_range_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_range_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		sensor::rangeSample range_sample_new{range_sample};
 		range_sample_new.time_us = time_us;
 
-		_range_buffer->push(range_sample_new);
+		_range_buffer.push(range_sample_new);
 		_time_last_range_buffer_push = _time_latest_us;
 
 	} else {
-		ECL_WARN("range data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _range_buffer->get_newest().time_us,
+		ECL_WARN("range data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _range_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -331,15 +270,9 @@ void EstimatorInterface::setOpticalFlowData(const flowSample &flow)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_flow_buffer == nullptr) {
-		_flow_buffer = new RingBuffer<flowSample>(_imu_buffer_length);
-
-		if (_flow_buffer == nullptr || !_flow_buffer->valid()) {
-			delete _flow_buffer;
-			_flow_buffer = nullptr;
-			printBufferAllocationFailed("flow");
-			return;
-		}
+	if (!_flow_buffer.valid() && !_flow_buffer.allocate(_imu_buffer_length)) {
+		printBufferAllocationFailed("flow");
+		return;
 	}
 
 	const int64_t time_us = flow.time_us
@@ -347,15 +280,15 @@ void EstimatorInterface::setOpticalFlowData(const flowSample &flow)
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_flow_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_flow_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		flowSample optflow_sample_new{flow};
 		optflow_sample_new.time_us = time_us;
 
-		_flow_buffer->push(optflow_sample_new);
+		_flow_buffer.push(optflow_sample_new);
 
 	} else {
-		ECL_WARN("optical flow data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _flow_buffer->get_newest().time_us,
+		ECL_WARN("optical flow data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _flow_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -369,15 +302,9 @@ void EstimatorInterface::setExtVisionData(const extVisionSample &evdata)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_ext_vision_buffer == nullptr) {
-		_ext_vision_buffer = new RingBuffer<extVisionSample>(_obs_buffer_length);
-
-		if (_ext_vision_buffer == nullptr || !_ext_vision_buffer->valid()) {
-			delete _ext_vision_buffer;
-			_ext_vision_buffer = nullptr;
-			printBufferAllocationFailed("vision");
-			return;
-		}
+	if (!_ext_vision_buffer.valid() && !_ext_vision_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("vision");
+		return;
 	}
 
 	// calculate the system time-stamp for the mid point of the integration period
@@ -386,16 +313,16 @@ void EstimatorInterface::setExtVisionData(const extVisionSample &evdata)
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_ext_vision_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_ext_vision_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		extVisionSample ev_sample_new{evdata};
 		ev_sample_new.time_us = time_us;
 
-		_ext_vision_buffer->push(ev_sample_new);
+		_ext_vision_buffer.push(ev_sample_new);
 		_time_last_ext_vision_buffer_push = _time_latest_us;
 
 	} else {
-		ECL_WARN("EV data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _ext_vision_buffer->get_newest().time_us,
+		ECL_WARN("EV data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _ext_vision_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -409,15 +336,9 @@ void EstimatorInterface::setAuxVelData(const auxVelSample &auxvel_sample)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_auxvel_buffer == nullptr) {
-		_auxvel_buffer = new RingBuffer<auxVelSample>(_obs_buffer_length);
-
-		if (_auxvel_buffer == nullptr || !_auxvel_buffer->valid()) {
-			delete _auxvel_buffer;
-			_auxvel_buffer = nullptr;
-			printBufferAllocationFailed("aux vel");
-			return;
-		}
+	if (!_auxvel_buffer.valid() && !_auxvel_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("aux vel");
+		return;
 	}
 
 	const int64_t time_us = auxvel_sample.time_us
@@ -425,15 +346,15 @@ void EstimatorInterface::setAuxVelData(const auxVelSample &auxvel_sample)
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_auxvel_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_auxvel_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		auxVelSample auxvel_sample_new{auxvel_sample};
 		auxvel_sample_new.time_us = time_us;
 
-		_auxvel_buffer->push(auxvel_sample_new);
+		_auxvel_buffer.push(auxvel_sample_new);
 
 	} else {
-		ECL_WARN("aux velocity data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _auxvel_buffer->get_newest().time_us,
+		ECL_WARN("aux velocity data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _auxvel_buffer.get_newest().time_us,
 			 _min_obs_interval_us);
 	}
 }
@@ -446,31 +367,25 @@ void EstimatorInterface::setSystemFlagData(const systemFlagUpdate &system_flags)
 	}
 
 	// Allocate the required buffer size if not previously done
-	if (_system_flag_buffer == nullptr) {
-		_system_flag_buffer = new RingBuffer<systemFlagUpdate>(_obs_buffer_length);
-
-		if (_system_flag_buffer == nullptr || !_system_flag_buffer->valid()) {
-			delete _system_flag_buffer;
-			_system_flag_buffer = nullptr;
-			printBufferAllocationFailed("system flag");
-			return;
-		}
+	if (!_system_flag_buffer.valid() && !_system_flag_buffer.allocate(_obs_buffer_length)) {
+		printBufferAllocationFailed("system flag");
+		return;
 	}
 
 	const int64_t time_us = system_flags.time_us
 				- static_cast<int64_t>(_dt_ekf_avg * 5e5f); // seconds to microseconds divided by 2
 
 	// limit data rate to prevent data being lost
-	if (time_us >= static_cast<int64_t>(_system_flag_buffer->get_newest().time_us + _min_obs_interval_us)) {
+	if (time_us >= static_cast<int64_t>(_system_flag_buffer.get_newest().time_us + _min_obs_interval_us)) {
 
 		systemFlagUpdate system_flags_new{system_flags};
 		system_flags_new.time_us = time_us;
 
-		_system_flag_buffer->push(system_flags_new);
+		_system_flag_buffer.push(system_flags_new);
 
 	} else {
 		ECL_DEBUG("system flag update too fast %" PRIi64 " < %" PRIu64 " + %d", time_us,
-			  _system_flag_buffer->get_newest().time_us, _min_obs_interval_us);
+			  _system_flag_buffer.get_newest().time_us, _min_obs_interval_us);
 	}
 }
 
@@ -482,15 +397,9 @@ void EstimatorInterface::setDragData(const imuSample &imu)
 	if (_params.ekf2_drag_ctrl > 0) {
 
 		// Allocate the required buffer size if not previously done
-		if (_drag_buffer == nullptr) {
-			_drag_buffer = new RingBuffer<dragSample>(_obs_buffer_length);
-
-			if (_drag_buffer == nullptr || !_drag_buffer->valid()) {
-				delete _drag_buffer;
-				_drag_buffer = nullptr;
-				printBufferAllocationFailed("drag");
-				return;
-			}
+		if (!_drag_buffer.valid() && !_drag_buffer.allocate(_obs_buffer_length)) {
+			printBufferAllocationFailed("drag");
+			return;
 		}
 
 		// don't use any accel samples that are clipping
@@ -526,7 +435,7 @@ void EstimatorInterface::setDragData(const imuSample &imu)
 			_drag_down_sampled.time_us /= _drag_sample_count;
 
 			// write to buffer
-			_drag_buffer->push(_drag_down_sampled);
+			_drag_buffer.push(_drag_down_sampled);
 
 			// reset accumulators
 			_drag_sample_count = 0;
@@ -545,6 +454,16 @@ bool EstimatorInterface::initialise_interface(uint64_t timestamp)
 	// calculate the IMU buffer length required to accomodate the maximum delay with some allowance for jitter
 	_imu_buffer_length = math::max(2, (int)ceilf(_params.ekf2_delay_max / filter_update_period_ms));
 
+#if defined(CONFIG_EKF2_STATIC_BUFFERS)
+
+	if (_imu_buffer_length > RingBuffer<imuSample>::kMaxSize) {
+		ECL_WARN("EKF max delay %.1f ms exceeds buffer length %d", (double)_params.ekf2_delay_max,
+			 RingBuffer<imuSample>::kMaxSize);
+		_imu_buffer_length = RingBuffer<imuSample>::kMaxSize;
+	}
+
+#endif // CONFIG_EKF2_STATIC_BUFFERS
+
 	// set the observation buffer length to handle the minimum time of arrival between observations in combination
 	// with the worst case delay from current time to ekf fusion time
 	// allow for worst case 50% extension of the ekf fusion time horizon delay due to timing jitter
@@ -26,9 +26,9 @@ namespace sym {
  *     Hy: Matrix24_1
  *     Hz: Matrix24_1
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 void ComputeBodyVelInnovVarH(const matrix::Matrix<Scalar, 25, 1>& state,
-                             const matrix::Matrix<Scalar, 24, 24>& P,
+                             const MatrixP& P,
                              const matrix::Matrix<Scalar, 3, 1>& R,
                              matrix::Matrix<Scalar, 3, 1>* const innov_var = nullptr,
                              matrix::Matrix<Scalar, 24, 1>* const Hx = nullptr,
@@ -23,9 +23,9 @@ namespace sym {
  * Outputs:
  *     innov_var: Scalar
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 void ComputeBodyVelYInnovVar(const matrix::Matrix<Scalar, 25, 1>& state,
-                             const matrix::Matrix<Scalar, 24, 24>& P, const Scalar R,
+                             const MatrixP& P, const Scalar R,
                              Scalar* const innov_var = nullptr) {
   // Total ops: 138
 
@@ -28,9 +28,9 @@ namespace sym {
  *     innov_var: Scalar
  *     Hy: Matrix24_1
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 void ComputeDragYInnovVarAndH(const matrix::Matrix<Scalar, 25, 1>& state,
-                              const matrix::Matrix<Scalar, 24, 24>& P, const Scalar rho,
+                              const MatrixP& P, const Scalar rho,
                               const Scalar cd, const Scalar cm, const Scalar R,
                               const Scalar epsilon, Scalar* const innov_var = nullptr,
                               matrix::Matrix<Scalar, 24, 1>* const Hy = nullptr) {
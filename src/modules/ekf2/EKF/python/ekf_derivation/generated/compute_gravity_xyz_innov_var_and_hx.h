@@ -24,9 +24,9 @@ namespace sym {
  *     innov_var: Matrix31
  *     Hx: Matrix24_1
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 void ComputeGravityXyzInnovVarAndHx(const matrix::Matrix<Scalar, 25, 1>& state,
-                                    const matrix::Matrix<Scalar, 24, 24>& P, const Scalar R,
+                                    const MatrixP& P, const Scalar R,
                                     matrix::Matrix<Scalar, 3, 1>* const innov_var = nullptr,
                                     matrix::Matrix<Scalar, 24, 1>* const Hx = nullptr) {
   // Total ops: 53
@@ -27,9 +27,9 @@ namespace sym {
  *     innov_var: Matrix31
  *     Hx: Matrix24_1
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 void ComputeMagInnovInnovVarAndHx(const matrix::Matrix<Scalar, 25, 1>& state,
-                                  const matrix::Matrix<Scalar, 24, 24>& P,
+                                  const MatrixP& P,
                                   const matrix::Matrix<Scalar, 3, 1>& meas, const Scalar R,
                                   const Scalar epsilon,
                                   matrix::Matrix<Scalar, 3, 1>* const innov = nullptr,
@@ -25,9 +25,9 @@ namespace sym {
  *     innov_var: Scalar
  *     H: Matrix24_1
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 void ComputeMagYInnovVarAndH(const matrix::Matrix<Scalar, 25, 1>& state,
-                             const matrix::Matrix<Scalar, 24, 24>& P, const Scalar R,
+                             const MatrixP& P, const Scalar R,
                              const Scalar epsilon, Scalar* const innov_var = nullptr,
                              matrix::Matrix<Scalar, 24, 1>* const H = nullptr) {
   // Total ops: 159
@@ -27,9 +27,9 @@ namespace sym {
  * Outputs:
  *     res: Matrix24_24
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 matrix::Matrix<Scalar, 24, 24> PredictCovariance(const matrix::Matrix<Scalar, 25, 1>& state,
-                                                const matrix::Matrix<Scalar, 24, 24>& P,
+                                                const MatrixP& P,
                                                 const matrix::Matrix<Scalar, 3, 1>& accel,
                                                 const matrix::Matrix<Scalar, 3, 1>& accel_var,
                                                 const matrix::Matrix<Scalar, 3, 1>& gyro,
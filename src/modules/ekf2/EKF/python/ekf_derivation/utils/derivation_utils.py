@@ -77,6 +77,20 @@ def generate_px4_function(function_name, output_names):
 
             print(line, end='')
 
+    # Take the covariance matrix as a template type, it can then be passed in any storage
+    # providing element access (e.g. matrix::SymmetricMatrix)
+    with open(os.path.abspath(metadata.generated_files[0]), 'r') as file:
+        code = file.read()
+
+    covariance_arg = re.compile(r'const matrix::Matrix<Scalar, (\d+), \1>& P\b')
+
+    if covariance_arg.search(code):
+        code = covariance_arg.sub('const MatrixP& P', code)
+        code = code.replace('template <typename Scalar>', 'template <typename Scalar, typename MatrixP>', 1)
+
+        with open(os.path.abspath(metadata.generated_files[0]), 'w') as file:
+            file.write(code)
+
 def generate_python_function(function_name, output_names):
     from symforce.codegen import Codegen, PythonConfig
     codegen = Codegen.function(
@@ -37,10 +37,8 @@ bool Ekf::fuseHorizontalVelocity(estimator_aid_source2d_s &aid_src)
 {
 	// vx, vy
 	if (!aid_src.innovation_rejected) {
-		for (unsigned i = 0; i < 2; i++) {
-			fuseDirectStateMeasurement(aid_src.innovation[i], aid_src.innovation_variance[i], aid_src.observation_variance[i],
-						   State::vel.idx + i);
-		}
+		fuseDirectStateMeasurements(aid_src.innovation, aid_src.innovation_variance, aid_src.observation_variance,
+					    State::vel.idx);
 
 		aid_src.fused = true;
 		aid_src.time_last_fuse = _time_delayed_us;
@@ -58,10 +56,8 @@ bool Ekf::fuseVelocity(estimator_aid_source3d_s &aid_src)
 {
 	// vx, vy, vz
 	if (!aid_src.innovation_rejected) {
-		for (unsigned i = 0; i < 3; i++) {
-			fuseDirectStateMeasurement(aid_src.innovation[i], aid_src.innovation_variance[i], aid_src.observation_variance[i],
-						   State::vel.idx + i);
-		}
+		fuseDirectStateMeasurements(aid_src.innovation, aid_src.innovation_variance, aid_src.observation_variance,
+					    State::vel.idx);
 
 		aid_src.fused = true;
 		aid_src.time_last_fuse = _time_delayed_us;
@@ -99,8 +99,16 @@ void EKFGSF_yaw::predict(const matrix::Vector3f &delta_ang, const float delta_an
 		}
 	}
 
+	// generate an attitude reference for each model using IMU data
+	const float ahrs_accel_fusion_gain = ahrsCalcAccelGain();
+
 	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-		predictEKF(model_index, delta_ang, delta_ang_dt, delta_vel, delta_vel_dt, in_air);
+		ahrsPredict(model_index, delta_ang, delta_ang_dt, ahrs_accel_fusion_gain);
+	}
+
+	// we don't start running the EKF part of the algorithm until there are regular velocity observations
+	if (_ekf_gsf_vel_fuse_started) {
+		predictEKF(delta_ang, delta_ang_dt, delta_vel, delta_vel_dt, in_air);
 	}
 }
 
@@ -119,42 +127,34 @@ void EKFGSF_yaw::fuseVelocity(const Vector2f &vel_NE, const float vel_accuracy,
 		}
 
 	} else {
-		bool bad_update = false;
-
-		for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
-			// subsequent measurements are fused as direct state observations
-			if (!updateEKF(model_index, vel_NE, vel_accuracy)) {
-				bad_update = true;
-			}
-		}
-
-		if (!bad_update) {
-			float total_weight = 0.0f;
-			// calculate weighting for each model assuming a normal distribution
-			const float min_weight = 1e-5f;
+		// subsequent measurements are fused as direct state observations
+		updateEKF(vel_NE, vel_accuracy);
 
-			for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-				_model_weights(model_index) = gaussianDensity(model_index) * _model_weights(model_index);
+		float total_weight = 0.0f;
+		// calculate weighting for each model assuming a normal distribution
+		const float min_weight = 1e-5f;
 
-				if (_model_weights(model_index) < min_weight) {
-					_model_weights(model_index) = min_weight;
-				}
+		for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
+			_model_weights(model_index) = gaussianDensity(model_index) * _model_weights(model_index);
 
-				total_weight += _model_weights(model_index);
+			if (_model_weights(model_index) < min_weight) {
+				_model_weights(model_index) = min_weight;
 			}
 
-			// normalise the weighting function
-			_model_weights /= total_weight;
+			total_weight += _model_weights(model_index);
 		}
 
+		// normalise the weighting function
+		_model_weights /= total_weight;
+
 		// Calculate a composite yaw vector as a weighted average of the states for each model.
 		// To avoid issues with angle wrapping, the yaw state is converted to a vector with length
 		// equal to the weighting value before it is summed.
 		Vector2f yaw_vector;
 
 		for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-			yaw_vector(0) += _model_weights(model_index) * cosf(_ekf_gsf[model_index].X(2));
-			yaw_vector(1) += _model_weights(model_index) * sinf(_ekf_gsf[model_index].X(2));
+			yaw_vector(0) += _model_weights(model_index) * cosf(_ekf_gsf.yaw[model_index]);
+			yaw_vector(1) += _model_weights(model_index) * sinf(_ekf_gsf.yaw[model_index]);
 		}
 
 		_gsf_yaw = atan2f(yaw_vector(1), yaw_vector(0));
@@ -164,8 +164,8 @@ void EKFGSF_yaw::fuseVelocity(const Vector2f &vel_NE, const float vel_accuracy,
 		_gsf_yaw_variance = 0.0f;
 
 		for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-			const float yaw_delta = wrap_pi(_ekf_gsf[model_index].X(2) - _gsf_yaw);
-			_gsf_yaw_variance += _model_weights(model_index) * (_ekf_gsf[model_index].P(2, 2) + yaw_delta * yaw_delta);
+			const float yaw_delta = wrap_pi(_ekf_gsf.yaw[model_index] - _gsf_yaw);
+			_gsf_yaw_variance += _model_weights(model_index) * (_ekf_gsf.P22[model_index] + yaw_delta * yaw_delta);
 		}
 
 		if (_gsf_yaw_variance <= 0.f || !PX4_ISFINITE(_gsf_yaw_variance)) {
@@ -174,18 +174,14 @@ void EKFGSF_yaw::fuseVelocity(const Vector2f &vel_NE, const float vel_accuracy,
 	}
 }
 
-void EKFGSF_yaw::ahrsPredict(const uint8_t model_index, const Vector3f &delta_ang, const float delta_ang_dt)
+void EKFGSF_yaw::ahrsPredict(const uint8_t model_index, const Vector3f &delta_ang, const float delta_ang_dt,
+			     const float ahrs_accel_fusion_gain)
 {
 	// generate attitude solution using simple complementary filter for the selected model
 	const Vector3f ang_rate = delta_ang / fmaxf(delta_ang_dt, 0.001f) - _ahrs_ekf_gsf[model_index].gyro_bias;
 
 	const Vector3f gravity_direction_bf = _ahrs_ekf_gsf[model_index].q.inversed().dcm_z();
 
-	const float ahrs_accel_norm = _ahrs_accel.norm();
-
-	// gain from accel vector tilt error to rate gyro correction used by AHRS calculation
-	const float ahrs_accel_fusion_gain = ahrsCalcAccelGain();
-
 	// Perform angular rate correction using accel data and reduce correction as accel magnitude moves away from 1 g (reduces drift when vehicle picked up and moved).
 	// During fixed wing flight, compensate for centripetal acceleration assuming coordinated turns and X axis forward
 	Vector3f tilt_correction{};
@@ -203,7 +199,7 @@ void EKFGSF_yaw::ahrsPredict(const uint8_t model_index, const Vector3f &delta_an
 			accel -= centripetal_accel_bf;
 		}
 
-		tilt_correction = (gravity_direction_bf % accel) * ahrs_accel_fusion_gain / ahrs_accel_norm;
+		tilt_correction = (gravity_direction_bf % accel) * ahrs_accel_fusion_gain / _ahrs_accel.norm();
 	}
 
 	// Gyro bias estimation
@@ -244,36 +240,28 @@ void EKFGSF_yaw::ahrsAlignYaw()
 {
 	// Align yaw angle for each model
 	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
-		const float yaw = wrap_pi(_ekf_gsf[model_index].X(2));
+		const float yaw = wrap_pi(_ekf_gsf.yaw[model_index]);
 		const Dcmf R(_ahrs_ekf_gsf[model_index].q);
 		_ahrs_ekf_gsf[model_index].q = Quatf(updateYawInRotMat(yaw, R));
 	}
 }
 
-void EKFGSF_yaw::predictEKF(const uint8_t model_index, const Vector3f &delta_ang, const float delta_ang_dt,
-			    const Vector3f &delta_vel, const float delta_vel_dt, bool in_air)
+void EKFGSF_yaw::setModelCovariance(const uint8_t model_index, const matrix::SquareMatrix<float, 3> &P)
 {
-	// generate an attitude reference using IMU data
-	ahrsPredict(model_index, delta_ang, delta_ang_dt);
-
-	// we don't start running the EKF part of the algorithm until there are regular velocity observations
-	if (!_ekf_gsf_vel_fuse_started) {
-		return;
-	}
-
-	const Dcmf R(_ahrs_ekf_gsf[model_index].q);
-
-	// Calculate the yaw state using a projection onto the horizontal that avoids gimbal lock
-	_ekf_gsf[model_index].X(2) = getEulerYaw(R);
+	// constrain variances
+	const float min_var = 1e-6f;
 
-	// calculate delta velocity in a horizontal front-right frame
-	const Vector3f del_vel_NED = R * delta_vel;
-	const float cos_yaw = cosf(_ekf_gsf[model_index].X(2));
-	const float sin_yaw = sinf(_ekf_gsf[model_index].X(2));
-	const float dvx =   del_vel_NED(0) * cos_yaw + del_vel_NED(1) * sin_yaw;
-	const float dvy = - del_vel_NED(0) * sin_yaw + del_vel_NED(1) * cos_yaw;
-	const float daz = Vector3f(R * delta_ang)(2);
+	_ekf_gsf.P00[model_index] = fmaxf(P(0, 0), min_var);
+	_ekf_gsf.P01[model_index] = P(0, 1);
+	_ekf_gsf.P02[model_index] = P(0, 2);
+	_ekf_gsf.P11[model_index] = fmaxf(P(1, 1), min_var);
+	_ekf_gsf.P12[model_index] = P(1, 2);
+	_ekf_gsf.P22[model_index] = fmaxf(P(2, 2), min_var);
+}
 
+void EKFGSF_yaw::predictEKF(const Vector3f &delta_ang, const float delta_ang_dt,
+			    const Vector3f &delta_vel, const float delta_vel_dt, bool in_air)
+{
 	// delta velocity process noise double if we're not in air
 	const float accel_noise = in_air ? _accel_noise : 2.f * _accel_noise;
 	const float d_vel_var = sq(accel_noise * delta_vel_dt);
@@ -281,85 +269,100 @@ void EKFGSF_yaw::predictEKF(const uint8_t model_index, const Vector3f &delta_ang
 	// Use fixed values for delta angle process noise variances
 	const float d_ang_var = sq(_gyro_noise * delta_ang_dt);
 
-	_ekf_gsf[model_index].P = sym::YawEstPredictCovariance(_ekf_gsf[model_index].X, _ekf_gsf[model_index].P, Vector2f(dvx,
-				  dvy), d_vel_var, daz, d_ang_var);
+	// earth frame delta velocity and delta yaw angle of each model
+	float dvel_n[N_MODELS_EKFGSF];
+	float dvel_e[N_MODELS_EKFGSF];
+	float dang_z[N_MODELS_EKFGSF];
 
-	// covariance matrix is symmetrical, so copy upper half to lower half
-	_ekf_gsf[model_index].P(1, 0) = _ekf_gsf[model_index].P(0, 1);
-	_ekf_gsf[model_index].P(2, 0) = _ekf_gsf[model_index].P(0, 2);
-	_ekf_gsf[model_index].P(2, 1) = _ekf_gsf[model_index].P(1, 2);
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		const Dcmf R(_ahrs_ekf_gsf[model_index].q);
 
-	// constrain variances
-	const float min_var = 1e-6f;
+		// Calculate the yaw state using a projection onto the horizontal that avoids gimbal lock
+		_ekf_gsf.yaw[model_index] = getEulerYaw(R);
+
+		// only the first two rows of R * delta_vel and the last of R * delta_ang are needed
+		dvel_n[model_index] = R(0, 0) * delta_vel(0) + R(0, 1) * delta_vel(1) + R(0, 2) * delta_vel(2);
+		dvel_e[model_index] = R(1, 0) * delta_vel(0) + R(1, 1) * delta_vel(1) + R(1, 2) * delta_vel(2);
+		dang_z[model_index] = R(2, 0) * delta_ang(0) + R(2, 1) * delta_ang(1) + R(2, 2) * delta_ang(2);
+	}
+
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		// calculate delta velocity in a horizontal front-right frame
+		const float cos_yaw = cosf(_ekf_gsf.yaw[model_index]);
+		const float sin_yaw = sinf(_ekf_gsf.yaw[model_index]);
+		const float dvx =   dvel_n[model_index] * cos_yaw + dvel_e[model_index] * sin_yaw;
+		const float dvy = - dvel_n[model_index] * sin_yaw + dvel_e[model_index] * cos_yaw;
+
+		const Vector3f X(_ekf_gsf.vel_n[model_index], _ekf_gsf.vel_e[model_index], _ekf_gsf.yaw[model_index]);
 
-	for (unsigned index = 0; index < 3; index++) {
-		_ekf_gsf[model_index].P(index, index) = fmaxf(_ekf_gsf[model_index].P(index, index), min_var);
+		setModelCovariance(model_index, sym::YawEstPredictCovariance(X, ModelCovariance(_ekf_gsf, model_index),
+				   Vector2f(dvx, dvy), d_vel_var, dang_z[model_index], d_ang_var));
 	}
 
 	// sum delta velocities in earth frame:
-	_ekf_gsf[model_index].X(0) += del_vel_NED(0);
-	_ekf_gsf[model_index].X(1) += del_vel_NED(1);
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		_ekf_gsf.vel_n[model_index] += dvel_n[model_index];
+		_ekf_gsf.vel_e[model_index] += dvel_e[model_index];
+	}
 }
 
-bool EKFGSF_yaw::updateEKF(const uint8_t model_index, const Vector2f &vel_NE, const float vel_accuracy)
+void EKFGSF_yaw::updateEKF(const Vector2f &vel_NE, const float vel_accuracy)
 {
 	// set observation variance from accuracy estimate supplied by GPS and apply a sanity check minimum
 	const float vel_obs_var = sq(fmaxf(vel_accuracy, 0.01f));
 
-	// calculate velocity observation innovations
-	_ekf_gsf[model_index].innov = _ekf_gsf[model_index].X.xy() - vel_NE;
-
-	matrix::Matrix<float, 3, 2> K;
-	matrix::SquareMatrix<float, 3> P_new;
-	matrix::SquareMatrix<float, 2> S_inverse;
+	float delta_yaw[N_MODELS_EKFGSF];
 
-	sym::YawEstComputeMeasurementUpdate(_ekf_gsf[model_index].P,
-					    vel_obs_var,
-					    FLT_EPSILON,
-					    &S_inverse,
-					    &_ekf_gsf[model_index].S_det_inverse,
-					    &K,
-					    &P_new);
-
-	_ekf_gsf[model_index].P = P_new;
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		// calculate velocity observation innovations
+		Vector2f innov(_ekf_gsf.vel_n[model_index] - vel_NE(0), _ekf_gsf.vel_e[model_index] - vel_NE(1));
+
+		matrix::Matrix<float, 3, 2> K;
+		matrix::SquareMatrix<float, 3> P_new;
+		matrix::SquareMatrix<float, 2> S_inverse;
+
+		sym::YawEstComputeMeasurementUpdate(ModelCovariance(_ekf_gsf, model_index),
+						    vel_obs_var,
+						    FLT_EPSILON,
+						    &S_inverse,
+						    &_ekf_gsf.S_det_inverse[model_index],
+						    &K,
+						    &P_new);
+
+		setModelCovariance(model_index, P_new);
+
+		// normalized innovation squared = transpose(innovation) * inverse(innovation variance) * innovation = [1x2] * [2,2] * [2,1] = [1,1]
+		float nis = innov * (S_inverse * innov);
+
+		// Perform a chi-square innovation consistency test and calculate a compression scale factor
+		// that limits the magnitude of innovations to 5-sigma
+		// If the normalized innovation squared is greater than 25 (5 Sigma) then reduce the length of the innovation vector to clip it at 5-Sigma
+		// This protects from large measurement spikes
+		if (nis > sq(5.f)) {
+			innov *= sqrtf(sq(5.f) / nis);
+			nis = sq(5.f);
+		}
 
-	// copy upper to lower diagonal
-	_ekf_gsf[model_index].P(1, 0) = _ekf_gsf[model_index].P(0, 1);
-	_ekf_gsf[model_index].P(2, 0) = _ekf_gsf[model_index].P(0, 2);
-	_ekf_gsf[model_index].P(2, 1) = _ekf_gsf[model_index].P(1, 2);
+		_ekf_gsf.nis[model_index] = nis;
+		_ekf_gsf.innov_n[model_index] = innov(0);
+		_ekf_gsf.innov_e[model_index] = innov(1);
 
-	// constrain variances
-	const float min_var = 1e-6f;
-
-	for (unsigned index = 0; index < 3; index++) {
-		_ekf_gsf[model_index].P(index, index) = fmaxf(_ekf_gsf[model_index].P(index, index), min_var);
+		// Correct the state vector
+		const Vector3f delta_state = -K * innov;
+		_ekf_gsf.vel_n[model_index] += delta_state(0);
+		_ekf_gsf.vel_e[model_index] += delta_state(1);
+		delta_yaw[model_index] = delta_state(2);
 	}
 
-	// normalized innovation squared = transpose(innovation) * inverse(innovation variance) * innovation = [1x2] * [2,2] * [2,1] = [1,1]
-	_ekf_gsf[model_index].nis = _ekf_gsf[model_index].innov * (S_inverse * _ekf_gsf[model_index].innov);
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		const float yawDelta = delta_yaw[model_index];
+		_ekf_gsf.yaw[model_index] = wrap_pi(_ekf_gsf.yaw[model_index] + yawDelta);
 
-	// Perform a chi-square innovation consistency test and calculate a compression scale factor
-	// that limits the magnitude of innovations to 5-sigma
-	// If the normalized innovation squared is greater than 25 (5 Sigma) then reduce the length of the innovation vector to clip it at 5-Sigma
-	// This protects from large measurement spikes
-	if (_ekf_gsf[model_index].nis > sq(5.f)) {
-		_ekf_gsf[model_index].innov *= sqrtf(sq(5.f) / _ekf_gsf[model_index].nis);
-		_ekf_gsf[model_index].nis = sq(5.f);
+		// Apply the change in yaw angle to the AHRS using left multiplication to rotate
+		// the attitude around the earth Down axis
+		const Quatf dq(cosf(yawDelta / 2.f), 0.f, 0.f, sinf(yawDelta / 2.f));
+		_ahrs_ekf_gsf[model_index].q = (dq * _ahrs_ekf_gsf[model_index].q).normalized();
 	}
-
-	// Correct the state vector
-	const Vector3f delta_state = -K * _ekf_gsf[model_index].innov;
-	const float yawDelta = delta_state(2);
-
-	_ekf_gsf[model_index].X.xy() += delta_state.xy();
-	_ekf_gsf[model_index].X(2) = wrap_pi(_ekf_gsf[model_index].X(2) + yawDelta);
-
-	// Apply the change in yaw angle to the AHRS using left multiplication to rotate
-	// the attitude around the earth Down axis
-	const Quatf dq(cosf(yawDelta / 2.f), 0.f, 0.f, sinf(yawDelta / 2.f));
-	_ahrs_ekf_gsf[model_index].q = (dq * _ahrs_ekf_gsf[model_index].q).normalized();
-
-	return true;
 }
 
 void EKFGSF_yaw::initialiseEKFGSF(const Vector2f &vel_NE, const float vel_accuracy)
@@ -370,27 +373,27 @@ void EKFGSF_yaw::initialiseEKFGSF(const Vector2f &vel_NE, const float vel_accura
 
 	const float yaw_increment = 2.f * M_PI_F / (float)N_MODELS_EKFGSF;
 
-	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
-		_ekf_gsf[model_index] = {};
+	_ekf_gsf = {};
 
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
 		// evenly space initial yaw estimates in the region between +-Pi
-		_ekf_gsf[model_index].X(2) = -M_PI_F + (0.5f * yaw_increment) + ((float)model_index * yaw_increment);
+		_ekf_gsf.yaw[model_index] = -M_PI_F + (0.5f * yaw_increment) + ((float)model_index * yaw_increment);
 
 		// take velocity states and corresponding variance from last measurement
-		_ekf_gsf[model_index].X(0) = vel_NE(0);
-		_ekf_gsf[model_index].X(1) = vel_NE(1);
+		_ekf_gsf.vel_n[model_index] = vel_NE(0);
+		_ekf_gsf.vel_e[model_index] = vel_NE(1);
 
-		_ekf_gsf[model_index].P(0, 0) = sq(fmaxf(vel_accuracy, 0.01f));
-		_ekf_gsf[model_index].P(1, 1) = _ekf_gsf[model_index].P(0, 0);
+		_ekf_gsf.P00[model_index] = sq(fmaxf(vel_accuracy, 0.01f));
+		_ekf_gsf.P11[model_index] = _ekf_gsf.P00[model_index];
 
 		// use half yaw interval for yaw uncertainty
-		_ekf_gsf[model_index].P(2, 2) = sq(0.5f * yaw_increment);
+		_ekf_gsf.P22[model_index] = sq(0.5f * yaw_increment);
 	}
 }
 
 float EKFGSF_yaw::gaussianDensity(const uint8_t model_index) const
 {
-	return (1.f / (2.f * M_PI_F)) * sqrtf(_ekf_gsf[model_index].S_det_inverse) * expf(-0.5f * _ekf_gsf[model_index].nis);
+	return (1.f / (2.f * M_PI_F)) * sqrtf(_ekf_gsf.S_det_inverse[model_index]) * expf(-0.5f * _ekf_gsf.nis[model_index]);
 }
 
 bool EKFGSF_yaw::getLogData(float *yaw_composite, float *yaw_variance, float yaw[N_MODELS_EKFGSF],
@@ -401,9 +404,9 @@ bool EKFGSF_yaw::getLogData(float *yaw_composite, float *yaw_variance, float yaw
 		*yaw_variance = _gsf_yaw_variance;
 
 		for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
-			yaw[model_index] = _ekf_gsf[model_index].X(2);
-			innov_VN[model_index] = _ekf_gsf[model_index].innov(0);
-			innov_VE[model_index] = _ekf_gsf[model_index].innov(1);
+			yaw[model_index] = _ekf_gsf.yaw[model_index];
+			innov_VN[model_index] = _ekf_gsf.innov_n[model_index];
+			innov_VE[model_index] = _ekf_gsf.innov_e[model_index];
 			weight[model_index] = _model_weights(model_index);
 		}
 
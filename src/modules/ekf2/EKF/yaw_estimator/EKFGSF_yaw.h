@@ -105,7 +105,9 @@ private:
 	float ahrsCalcAccelGain() const;
 
 	// update specified AHRS rotation matrix using IMU and optionally true airspeed data
-	void ahrsPredict(const uint8_t model_index, const matrix::Vector3f &delta_ang, const float delta_ang_dt);
+	// accel_fusion_gain: result of ahrsCalcAccelGain(), the same for all models
+	void ahrsPredict(const uint8_t model_index, const matrix::Vector3f &delta_ang, const float delta_ang_dt,
+			 const float accel_fusion_gain);
 
 	// align all AHRS roll and pitch orientations using IMU delta velocity vector
 	void ahrsAlignTilt(const matrix::Vector3f &delta_vel);
@@ -114,27 +116,70 @@ private:
 	void ahrsAlignYaw();
 
 	// Declarations used by a bank of N_MODELS_EKFGSF EKFs
+	// The filters are identical, so they are stored as structure of arrays (element i belongs to model i)
+	// and each processing step runs over the whole bank in straight loops.
+
+	struct EkfBank {
+		float vel_n[N_MODELS_EKFGSF] {};         // state: Vel North (m/s)
+		float vel_e[N_MODELS_EKFGSF] {};         // state: Vel East (m/s)
+		float yaw[N_MODELS_EKFGSF] {};           // state: yaw (rad)
+
+		// upper triangle of the symmetric covariance matrix
+		float P00[N_MODELS_EKFGSF] {};
+		float P01[N_MODELS_EKFGSF] {};
+		float P02[N_MODELS_EKFGSF] {};
+		float P11[N_MODELS_EKFGSF] {};
+		float P12[N_MODELS_EKFGSF] {};
+		float P22[N_MODELS_EKFGSF] {};
+
+		float nis[N_MODELS_EKFGSF] {};           // normalized innovation squared
+		float S_det_inverse[N_MODELS_EKFGSF] {}; // inverse of the innovation covariance matrix determinant
+		float innov_n[N_MODELS_EKFGSF] {};       // Velocity N innovation (m/s)
+		float innov_e[N_MODELS_EKFGSF] {};       // Velocity E innovation (m/s)
+	} _ekf_gsf{};
+
+	// covariance matrix of one model of the bank, as input of the generated code
+	class ModelCovariance
+	{
+	public:
+		ModelCovariance(const EkfBank &bank, uint8_t model_index) : _bank(bank), _i(model_index) {}
 
-	struct {
-		matrix::Vector3f X{};                       // Vel North (m/s),  Vel East (m/s), yaw (rad)s
-		matrix::SquareMatrix<float, 3> P{};         // covariance matrix
-		float nis{};                                // normalized innovation squared
-		float S_det_inverse{};                      // inverse of the innovation covariance matrix determinant
-		matrix::Vector2f innov{};                   // Velocity N,E innovation (m/s)
-	} _ekf_gsf[N_MODELS_EKFGSF] {};
+		float operator()(size_t row, size_t col) const
+		{
+			switch ((row < col) ? (row * 3 + col) : (col * 3 + row)) {
+			case 0: return _bank.P00[_i];
+
+			case 1: return _bank.P01[_i];
+
+			case 2: return _bank.P02[_i];
+
+			case 4: return _bank.P11[_i];
+
+			case 5: return _bank.P12[_i];
+
+			default: return _bank.P22[_i];
+			}
+		}
+
+	private:
+		const EkfBank &_bank;
+		const uint8_t _i;
+	};
+
+	// store the upper triangle of a model covariance matrix and constrain its variances
+	void setModelCovariance(uint8_t model_index, const matrix::SquareMatrix<float, 3> &P);
 
 	bool _ekf_gsf_vel_fuse_started{}; // true when the EKF's have started fusing velocity data and the prediction and update processing is active
 
 	// initialise states and covariance data for the GSF and EKF filters
 	void initialiseEKFGSF(const matrix::Vector2f &vel_NE, const float vel_accuracy);
 
-	// predict state and covariance for the specified EKF using inertial data
-	void predictEKF(const uint8_t model_index, const matrix::Vector3f &delta_ang, const float delta_ang_dt,
+	// predict state and covariance of all EKFs using inertial data
+	void predictEKF(const matrix::Vector3f &delta_ang, const float delta_ang_dt,
 			const matrix::Vector3f &delta_vel, const float delta_vel_dt, bool in_air = false);
 
-	// update state and covariance for the specified EKF using a NE velocity measurement
-	// return false if update failed
-	bool updateEKF(const uint8_t model_index, const matrix::Vector2f &vel_NE, const float vel_accuracy);
+	// update state and covariance of all EKFs using a NE velocity measurement
+	void updateEKF(const matrix::Vector2f &vel_NE, const float vel_accuracy);
 
 	inline float sq(float x) const { return x * x; };
 
@@ -26,8 +26,8 @@ namespace sym {
  *     K: Matrix32
  *     P_new: Matrix33
  */
-template <typename Scalar>
-void YawEstComputeMeasurementUpdate(const matrix::Matrix<Scalar, 3, 3>& P, const Scalar vel_obs_var,
+template <typename Scalar, typename MatrixP>
+void YawEstComputeMeasurementUpdate(const MatrixP& P, const Scalar vel_obs_var,
                                     const Scalar epsilon,
                                     matrix::Matrix<Scalar, 2, 2>* const S_inv = nullptr,
                                     Scalar* const S_det_inv = nullptr,
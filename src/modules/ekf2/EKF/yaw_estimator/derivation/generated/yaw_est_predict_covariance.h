@@ -26,9 +26,9 @@ namespace sym {
  * Outputs:
  *     res: Matrix33
  */
-template <typename Scalar>
+template <typename Scalar, typename MatrixP>
 matrix::Matrix<Scalar, 3, 3> YawEstPredictCovariance(const matrix::Matrix<Scalar, 3, 1>& state,
-                                                    const matrix::Matrix<Scalar, 3, 3>& P,
+                                                    const MatrixP& P,
                                                     const matrix::Matrix<Scalar, 2, 1>& d_vel,
                                                     const Scalar d_vel_var, const Scalar d_ang,
                                                     const Scalar d_ang_var) {
@@ -818,7 +818,14 @@ void EKF2::Run()
 			PublishStatus(now);
 			PublishStatusFlags(now);
 
-			if (_param_ekf2_log_verbose.get()) {
+			// the verbose logging topics are rate limited, except in replay where they are compared at the filter rate
+			const float log_rate = _param_ekf2_log_rate.get();
+			const bool log_verbose_update = _replay_mode || (log_rate <= 0.f)
+							|| (now >= _verbose_log_last + static_cast<hrt_abstime>(1e6f / log_rate));
+
+			if (_param_ekf2_log_verbose.get() && log_verbose_update) {
+				_verbose_log_last = now;
+
 				PublishAidSourceStatus(now);
 				PublishInnovations(now);
 				PublishInnovationTestRatios(now);
@@ -1035,6 +1042,10 @@ void EKF2::PublishAidSourceStatus(const hrt_abstime &timestamp)
 
 void EKF2::PublishAttitude(const hrt_abstime &timestamp)
 {
+	if (!OutputRequired(_attitude_pub)) {
+		return;
+	}
+
 	if (_ekf.attitude_valid()) {
 		// generate vehicle attitude quaternion data
 		vehicle_attitude_s att;
@@ -1186,6 +1197,10 @@ void EKF2::PublishEventFlags(const hrt_abstime &timestamp)
 
 void EKF2::PublishGlobalPosition(const hrt_abstime &timestamp)
 {
+	if (!OutputRequired(_global_position_pub)) {
+		return;
+	}
+
 	if (_ekf.global_origin_valid() && _ekf.control_status().flags.yaw_align) {
 		// generate and publish global position data
 		vehicle_global_position_s global_pos{};
@@ -1556,6 +1571,12 @@ void EKF2::PublishInnovationVariances(const hrt_abstime &timestamp)
 
 void EKF2::PublishLocalPosition(const hrt_abstime &timestamp)
 {
+	if (!OutputRequired(_local_position_pub)) {
+		// keep the averaging window of the acceleration the same as the publication interval
+		_ekf.resetVelocityDerivativeAccumulation();
+		return;
+	}
+
 	vehicle_local_position_s lpos{};
 	// generate vehicle local position data
 	lpos.timestamp_sample = timestamp;
@@ -1679,6 +1700,12 @@ void EKF2::PublishLocalPosition(const hrt_abstime &timestamp)
 
 void EKF2::PublishOdometry(const hrt_abstime &timestamp, const imuSample &imu_sample)
 {
+	if (!OutputRequired(_odometry_pub)) {
+		// keep the averaging window of the angular velocity the same as the publication interval
+		_ekf.getAngularVelocityAndResetAccumulator();
+		return;
+	}
+
 	// generate vehicle odometry data
 	vehicle_odometry_s odom;
 	odom.timestamp_sample = imu_sample.time_us;
@@ -2014,7 +2041,7 @@ void EKF2::PublishYawEstimatorStatus(const hrt_abstime &timestamp)
 #if defined(CONFIG_EKF2_WIND)
 void EKF2::PublishWindEstimate(const hrt_abstime &timestamp)
 {
-	if (_ekf.get_wind_status()) {
+	if (_ekf.get_wind_status() && OutputRequired(_wind_pub)) {
 		// Publish wind estimate only if ekf declares them valid
 		wind_s wind{};
 		wind.timestamp_sample = _ekf.time_delayed_us();
@@ -2843,9 +2870,13 @@ int EKF2::task_spawn(int argc, char *argv[])
 	}
 
 	if (multi_mode && !replay_mode) {
+		// run all instances on the INS thread pool instead of one queue per IMU
+		int32_t multi_parallel = 0;
+		param_get(param_find("EKF2_MULTI_PAR"), &multi_parallel);
+
 		// Start EKF2Selector if it's not already running
 		if (_ekf2_selector.load() == nullptr) {
-			EKF2Selector *inst = new EKF2Selector();
+			EKF2Selector *inst = new EKF2Selector(multi_parallel != 0);
 
 			if (inst) {
 				_ekf2_selector.store(inst);
@@ -2884,7 +2915,8 @@ int EKF2::task_spawn(int argc, char *argv[])
 					if ((vehicle_mag_sub.advertised() || mag == 0) && (vehicle_imu_sub.advertised())) {
 
 						if (!ekf2_instance_created[imu][mag]) {
-							EKF2 *ekf2_inst = new EKF2(true, px4::ins_instance_to_wq(imu), false);
+							const px4::wq_config_t &wq_config = multi_parallel ? px4::wq_configurations::INS_pool : px4::ins_instance_to_wq(imu);
+							EKF2 *ekf2_inst = new EKF2(true, wq_config, false);
 
 							if (ekf2_inst && ekf2_inst->multi_init(imu, mag)) {
 								int actual_instance = ekf2_inst->instance(); // match uORB instance numbering
@@ -167,6 +167,11 @@ private:
 	void AdvertiseTopics();
 	void VerifyParams();
 
+	// the estimator_* outputs of the instances not selected by the EKF2Selector usually have no subscribers,
+	// skip filling them in multi-instance mode unless someone is listening
+	template<typename T>
+	bool OutputRequired(const uORB::PublicationMulti<T> &pub) const { return !_multi_mode || _replay_mode || pub.has_subscribers(); }
+
 	void PublishAidSourceStatus(const hrt_abstime &timestamp);
 	void PublishAttitude(const hrt_abstime &timestamp);
 
@@ -295,6 +300,8 @@ private:
 
 	hrt_abstime _last_sensor_bias_published{0};
 
+	hrt_abstime _verbose_log_last{0};	///< last publication of the verbose logging topics
+
 	hrt_abstime _status_fake_hgt_pub_last{0};
 	hrt_abstime _status_fake_pos_pub_last{0};
 
@@ -485,6 +492,7 @@ private:
 
 	DEFINE_PARAMETERS(
 		(ParamBool<px4::params::EKF2_LOG_VERBOSE>) _param_ekf2_log_verbose,
+		(ParamFloat<px4::params::EKF2_LOG_RATE>) _param_ekf2_log_rate,
 		(ParamExtInt<px4::params::EKF2_PREDICT_US>) _param_ekf2_predict_us,
 		(ParamExtFloat<px4::params::EKF2_DELAY_MAX>) _param_ekf2_delay_max,
 		(ParamExtInt<px4::params::EKF2_IMU_CTRL>) _param_ekf2_imu_ctrl,
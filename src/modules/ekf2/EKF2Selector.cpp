@@ -39,9 +39,10 @@ using matrix::Vector2f;
 using math::constrain;
 using math::radians;
 
-EKF2Selector::EKF2Selector() :
+EKF2Selector::EKF2Selector(bool parallel) :
 	ModuleParams(nullptr),
-	ScheduledWorkItem("ekf2_selector", px4::wq_configurations::nav_and_controllers)
+	ScheduledWorkItem("ekf2_selector", px4::wq_configurations::nav_and_controllers),
+	_parallel(parallel)
 {
 	_estimator_selector_status_pub.advertise();
 	_sensor_selection_pub.advertise();
@@ -120,7 +121,10 @@ bool EKF2Selector::SelectInstance(uint8_t ekf_instance)
 		if (_selected_instance != INVALID_INSTANCE) {
 			// switch callback registration
 			_instance[_selected_instance].estimator_attitude_sub.unregisterCallback();
-			_instance[_selected_instance].estimator_status_sub.unregisterCallback();
+
+			if (!_parallel) {
+				_instance[_selected_instance].estimator_status_sub.unregisterCallback();
+			}
 
 			PrintInstanceChange(_selected_instance, ekf_instance);
 		}
@@ -144,6 +148,25 @@ bool EKF2Selector::SelectInstance(uint8_t ekf_instance)
 	return false;
 }
 
+bool EKF2Selector::AllInstancesUpdated()
+{
+	for (uint8_t i = 0; i < EKF2_MAX_INSTANCES; i++) {
+		EstimatorInstance &inst = _instance[i];
+
+		// every instance triggers the selector, the last one to finish the IMU sample completes the barrier
+		if (!inst.estimator_status_sub.registered()) {
+			inst.estimator_status_sub.registerCallback();
+		}
+
+		if (inst.estimator_status_sub.advertised() && !inst.timeout && !inst.estimator_status_sub.updated()) {
+			// don't wait for a stalled instance longer than the backup period
+			return hrt_elapsed_time(&_last_barrier) > FILTER_UPDATE_PERIOD;
+		}
+	}
+
+	return true;
+}
+
 bool EKF2Selector::UpdateErrorScores()
 {
 	// first check imu inconsistencies
@@ -250,6 +273,7 @@ bool EKF2Selector::UpdateErrorScores()
 
 	bool updated = false;
 	bool primary_updated = false;
+	bool status_updated[EKF2_MAX_INSTANCES] {};
 
 	// default estimator timeout
 	const hrt_abstime status_timeout = 50_ms;
@@ -262,6 +286,7 @@ bool EKF2Selector::UpdateErrorScores()
 
 		if (_instance[i].estimator_status_sub.update(&status)) {
 
+			status_updated[i] = true;
 			_instance[i].timestamp_last = status.timestamp;
 
 			_instance[i].accel_device_id = status.accel_device_id;
@@ -335,24 +360,69 @@ bool EKF2Selector::UpdateErrorScores()
 		}
 	}
 
-	// update relative test ratios if primary has updated
-	if (primary_updated) {
-		for (uint8_t i = 0; i < _available_instances; i++) {
-			if (i != _selected_instance) {
+	// accumulate the relative test ratio of every instance that published since the last update (against the latest
+	// primary test ratio) and track the best alternatives in the same pass, Run() only evaluates the result
+	_best = {};
 
-				const float error_delta = _instance[i].combined_test_ratio - _instance[_selected_instance].combined_test_ratio;
+	if (_selected_instance == INVALID_INSTANCE) {
+		return (primary_updated || updated);
+	}
 
-				// reduce error only if its better than the primary instance by at least EKF2_SEL_ERR_RED to prevent unnecessary selection changes
-				const float threshold = _gyro_fault_detected ? 0.0f : fmaxf(_param_ekf2_sel_err_red.get(), 0.05f);
+	// reduce error only if its better than the primary instance by at least EKF2_SEL_ERR_RED to prevent unnecessary selection changes
+	const float threshold = _gyro_fault_detected ? 0.0f : fmaxf(_param_ekf2_sel_err_red.get(), 0.05f);
+	const EstimatorInstance &primary = _instance[_selected_instance];
 
-				if (error_delta > 0 || error_delta < -threshold) {
-					_instance[i].relative_test_ratio += error_delta;
-					_instance[i].relative_test_ratio = constrain(_instance[i].relative_test_ratio, -_rel_err_score_lim, _rel_err_score_lim);
+	float best_test_ratio = FLT_MAX;
+	_best.ekf = _selected_instance;
 
-					if ((error_delta < -threshold) && (_instance[i].relative_test_ratio < 1.f)) {
-						// increase status publication rate if there's movement towards a potential instance change
-						_selector_status_publish = true;
-					}
+	for (uint8_t i = 0; i < _available_instances; i++) {
+		if (i == _selected_instance) {
+			continue;
+		}
+
+		EstimatorInstance &inst = _instance[i];
+
+		if (status_updated[i] && PX4_ISFINITE(primary.combined_test_ratio)) {
+			const float error_delta = inst.combined_test_ratio - primary.combined_test_ratio;
+
+			if (error_delta > 0 || error_delta < -threshold) {
+				inst.relative_test_ratio += error_delta;
+				inst.relative_test_ratio = constrain(inst.relative_test_ratio, -_rel_err_score_lim, _rel_err_score_lim);
+
+				if ((error_delta < -threshold) && (inst.relative_test_ratio < 1.f)) {
+					// increase status publication rate if there's movement towards a potential instance change
+					_selector_status_publish = true;
+				}
+			}
+		}
+
+		// Use an alternative instance if  -
+		// (healthy and has updated recently)
+		// AND
+		// (has relative error less than selected instance and has not been the selected instance for at least 10 seconds
+		// OR
+		// selected instance has stopped updating
+		if (inst.healthy.get_state()) {
+			const float test_ratio = inst.combined_test_ratio;
+			const float relative_error = inst.relative_test_ratio;
+
+			if (relative_error < _best.alternative_error) {
+				_best.ekf_alternate = i;
+				_best.alternative_error = relative_error;
+
+				// relative error less than selected instance and has not been the selected instance for at least 10 seconds
+				if ((relative_error <= -_rel_err_thresh) && hrt_elapsed_time(&inst.time_last_selected) > 10_s) {
+					_best.lower_error_available = true;
+				}
+			}
+
+			if ((test_ratio > 0) && (test_ratio < best_test_ratio)) {
+				_best.ekf = i;
+				best_test_ratio = test_ratio;
+
+				// also check next best available ekf using a different IMU
+				if (inst.accel_device_id != primary.accel_device_id) {
+					_best.ekf_different_imu = i;
 				}
 			}
 		}
@@ -710,7 +780,14 @@ void EKF2Selector::Run()
 	}
 
 	// update combined test ratio for all estimators
-	const bool updated = UpdateErrorScores();
+	bool updated = false;
+
+	if (!_parallel || AllInstancesUpdated()) {
+		// with parallel instances compare them only once all have processed the same IMU sample,
+		// the selected instance's outputs are still republished immediately below
+		updated = UpdateErrorScores();
+		_last_barrier = hrt_absolute_time();
+	}
 
 	// if no valid instance then force select first instance with valid IMU
 	if (_selected_instance == INVALID_INSTANCE) {
@@ -737,63 +814,21 @@ void EKF2Selector::Run()
 		const uint32_t instance_changed_count_prev = _instance_changed_count;
 		const hrt_abstime last_instance_change_prev = _last_instance_change;
 
-		bool lower_error_available = false;
-		float alternative_error = 0.f; // looking for instances that have error lower than the current primary
-		float best_test_ratio = FLT_MAX;
-
-		uint8_t best_ekf = _selected_instance;
-		uint8_t best_ekf_alternate = INVALID_INSTANCE;
-		uint8_t best_ekf_different_imu = INVALID_INSTANCE;
-
-		// loop through all available instances to find if an alternative is available
-		for (int i = 0; i < _available_instances; i++) {
-			// Use an alternative instance if  -
-			// (healthy and has updated recently)
-			// AND
-			// (has relative error less than selected instance and has not been the selected instance for at least 10 seconds
-			// OR
-			// selected instance has stopped updating
-			if (_instance[i].healthy.get_state() && (i != _selected_instance)) {
-				const float test_ratio = _instance[i].combined_test_ratio;
-				const float relative_error = _instance[i].relative_test_ratio;
-
-				if (relative_error < alternative_error) {
-					best_ekf_alternate = i;
-					alternative_error = relative_error;
-
-					// relative error less than selected instance and has not been the selected instance for at least 10 seconds
-					if ((relative_error <= -_rel_err_thresh) && hrt_elapsed_time(&_instance[i].time_last_selected) > 10_s) {
-						lower_error_available = true;
-					}
-				}
-
-				if ((test_ratio > 0) && (test_ratio < best_test_ratio)) {
-					best_ekf = i;
-					best_test_ratio = test_ratio;
-
-					// also check next best available ekf using a different IMU
-					if (_instance[i].accel_device_id != _instance[_selected_instance].accel_device_id) {
-						best_ekf_different_imu = i;
-					}
-				}
-			}
-		}
-
 		if (!_instance[_selected_instance].healthy.get_state()) {
 			// prefer the best healthy instance using a different IMU
-			if (!SelectInstance(best_ekf_different_imu)) {
+			if (!SelectInstance(_best.ekf_different_imu)) {
 				// otherwise switch to the healthy instance with best overall test ratio
-				SelectInstance(best_ekf);
+				SelectInstance(_best.ekf);
 			}
 
-		} else if (lower_error_available
+		} else if (_best.lower_error_available
 			   && ((hrt_elapsed_time(&_last_instance_change) > 10_s)
 			       || (_instance[_selected_instance].warning
 				   && (hrt_elapsed_time(&_instance[_selected_instance].time_last_no_warning) > 1_s)))) {
 
 			// if this instance has a significantly lower relative error to the active primary, we consider it as a
 			// better instance and would like to switch to it even if the current primary is healthy
-			SelectInstance(best_ekf_alternate);
+			SelectInstance(_best.ekf_alternate);
 
 		} else if (_request_instance.load() != INVALID_INSTANCE) {
 
@@ -864,7 +899,7 @@ void EKF2Selector::PublishEstimatorSelectorStatus()
 
 void EKF2Selector::PrintStatus()
 {
-	PX4_INFO("available instances: %" PRIu8, _available_instances);
+	PX4_INFO("available instances: %" PRIu8 "%s", _available_instances, _parallel ? " (parallel)" : "");
 
 	if (_selected_instance == INVALID_INSTANCE) {
 		PX4_WARN("selected instance: None");
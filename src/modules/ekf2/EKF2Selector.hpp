@@ -67,7 +67,7 @@ using namespace time_literals;
 class EKF2Selector : public ModuleParams, public px4::ScheduledWorkItem
 {
 public:
-	EKF2Selector();
+	EKF2Selector(bool parallel = false);
 	~EKF2Selector() override;
 
 	void Stop();
@@ -93,6 +93,9 @@ private:
 
 	bool SelectInstance(uint8_t instance);
 
+	// parallel instances: true once all running instances have published a new status
+	bool AllInstancesUpdated();
+
 	// Update the error scores for all available instances
 	bool UpdateErrorScores();
 
@@ -180,10 +183,22 @@ private:
 	bool _gyro_fault_detected{false};
 	bool _accel_fault_detected{false};
 
+	const bool _parallel; // instances run in parallel (EKF2_MULTI_PAR), selection waits for all of them
+	hrt_abstime _last_barrier{0};
+
 	uint8_t _available_instances{0};
 	uint8_t _selected_instance{INVALID_INSTANCE};
 	px4::atomic<uint8_t> _request_instance{INVALID_INSTANCE};
 
+	// best alternatives to the selected instance, found by UpdateErrorScores()
+	struct BestInstances {
+		uint8_t ekf{INVALID_INSTANCE};               // healthy instance with the lowest combined test ratio
+		uint8_t ekf_alternate{INVALID_INSTANCE};     // healthy instance with the lowest relative test ratio
+		uint8_t ekf_different_imu{INVALID_INSTANCE}; // best instance not using the accelerometer of the selected instance
+		float alternative_error{0.f};                // relative test ratio of ekf_alternate
+		bool lower_error_available{false};
+	} _best{};
+
 	uint32_t _instance_changed_count{0};
 	hrt_abstime _last_instance_change{0};
 
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "EKF/ekf.h"
+#include "sensor_simulator/sensor_simulator.h"
+#include "sensor_simulator/ekf_wrapper.h"
+#include "test_helper/comparison_helper.h"
+
+#include "../EKF/python/ekf_derivation/generated/predict_covariance.h"
+
+using namespace matrix;
+
+// simulated time per benchmark iteration, one filter update at the default EKF2_PREDICT_US
+static constexpr uint32_t kFilterUpdatePeriodUs = 10'000;
+
+class EkfBenchmark : public benchmark::Fixture
+{
+public:
+	void SetUp(const benchmark::State &state) override
+	{
+		_ekf = std::make_shared<Ekf>();
+		_sensor_simulator = std::make_unique<SensorSimulator>(_ekf);
+		_ekf_wrapper = std::make_unique<EkfWrapper>(_ekf);
+
+		// run briefly to init, then in air with the basic sensors (IMU, baro, mag)
+		_ekf->init(0);
+		_sensor_simulator->runSeconds(0.1);
+		_ekf->set_in_air_status(false);
+		_ekf->set_vehicle_at_rest(true);
+		_sensor_simulator->runSeconds(2);
+
+		if (state.range(0)) {
+			_ekf_wrapper->enableGpsFusion();
+			_sensor_simulator->startGps();
+			_sensor_simulator->runSeconds(11);
+		}
+
+		_ekf->set_in_air_status(true);
+		_ekf->set_vehicle_at_rest(false);
+	}
+
+	void TearDown(const benchmark::State &state) override
+	{
+		_ekf_wrapper.reset();
+		_sensor_simulator.reset();
+		_ekf.reset();
+	}
+
+protected:
+	std::shared_ptr<Ekf> _ekf;
+	std::unique_ptr<SensorSimulator> _sensor_simulator;
+	std::unique_ptr<EkfWrapper> _ekf_wrapper;
+};
+
+// Arg: GNSS fusion (0 or 1)
+BENCHMARK_DEFINE_F(EkfBenchmark, Update)(benchmark::State &state)
+{
+	for (auto _ : state) {
+		// includes the sensor simulation, small compared to the filter update
+		_sensor_simulator->runMicroseconds(kFilterUpdatePeriodUs);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(EkfBenchmark, Update)->Arg(0)->Arg(1);
+
+static void BM_PredictCovarianceGenerated(benchmark::State &state)
+{
+	StateSample ekf_state{};
+	ekf_state.quat_nominal = Quatf(Eulerf(0.1f, -0.2f, 1.5f));
+	ekf_state.vel = Vector3f(1.f, -2.f, 0.5f);
+
+	SquareMatrixState P = createRandomCovarianceMatrix();
+
+	const Vector3f accel(0.3f, -0.1f, -9.7f);
+	const Vector3f accel_var(0.01f, 0.01f, 0.01f);
+	const Vector3f gyro(0.02f, 0.1f, -0.05f);
+	const float gyro_var = 1e-4f;
+	const float dt = kFilterUpdatePeriodUs * 1e-6f;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(P);
+		benchmark::DoNotOptimize(sym::PredictCovariance(ekf_state.vector(), P, accel, accel_var, gyro, gyro_var, dt));
+	}
+}
+BENCHMARK(BM_PredictCovarianceGenerated);
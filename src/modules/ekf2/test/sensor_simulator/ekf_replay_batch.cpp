@@ -0,0 +1,364 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Offline batch replay of recorded sensor data through the EKF.
+ *
+ * The sensor data file (see convertULogToSensorData.py) is parsed once and replayed
+ * as fast as possible through one Ekf instance per parameter set, the parameter sets
+ * are processed in parallel by a pool of threads. Each run writes the states and
+ * variances at a fixed rate to <output dir>/<parameter file name>.csv.
+ *
+ * Parameter files use the same format as the replay override file (replay_params.txt):
+ * one "EKF2_PARAM_NAME value" per line, lines starting with '#' are ignored.
+ *
+ * Usage: ekf_replay_batch [-j threads] [-r output rate Hz] [-o output dir] <sensor data> [<params file>...]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <strings.h>
+#include <thread>
+#include <unistd.h>
+
+#include "sensor_simulator.h"
+#include "ekf_logger.h"
+
+namespace
+{
+
+struct ParamEntry {
+	const char *name;
+	float parameters::*value_float;
+	int32_t parameters::*value_int;
+};
+
+#define EKF_PARAM_FLOAT(x) ParamEntry{#x, &parameters::x, nullptr}
+#define EKF_PARAM_INT(x) ParamEntry{#x, nullptr, &parameters::x}
+
+const ParamEntry param_table[] {
+	EKF_PARAM_INT(ekf2_predict_us),
+	EKF_PARAM_INT(ekf2_imu_ctrl),
+	EKF_PARAM_INT(ekf2_hgt_ref),
+	EKF_PARAM_FLOAT(ekf2_delay_max),
+	EKF_PARAM_FLOAT(ekf2_gyr_noise),
+	EKF_PARAM_FLOAT(ekf2_acc_noise),
+	EKF_PARAM_FLOAT(ekf2_gyr_b_noise),
+	EKF_PARAM_FLOAT(ekf2_acc_b_noise),
+	EKF_PARAM_FLOAT(ekf2_gbias_init),
+	EKF_PARAM_FLOAT(ekf2_abias_init),
+	EKF_PARAM_FLOAT(ekf2_angerr_init),
+	EKF_PARAM_FLOAT(ekf2_noaid_noise),
+	EKF_PARAM_FLOAT(ekf2_hdg_gate),
+	EKF_PARAM_FLOAT(ekf2_head_noise),
+	EKF_PARAM_FLOAT(ekf2_abl_lim),
+	EKF_PARAM_FLOAT(ekf2_abl_acclim),
+	EKF_PARAM_FLOAT(ekf2_abl_gyrlim),
+	EKF_PARAM_FLOAT(ekf2_abl_tau),
+	EKF_PARAM_FLOAT(ekf2_gyr_b_lim),
+#if defined(CONFIG_EKF2_WIND)
+	EKF_PARAM_FLOAT(ekf2_wind_nsd),
+#endif // CONFIG_EKF2_WIND
+#if defined(CONFIG_EKF2_BAROMETER)
+	EKF_PARAM_INT(ekf2_baro_ctrl),
+	EKF_PARAM_FLOAT(ekf2_baro_delay),
+	EKF_PARAM_FLOAT(ekf2_baro_noise),
+	EKF_PARAM_FLOAT(ekf2_baro_gate),
+	EKF_PARAM_FLOAT(ekf2_gnd_eff_dz),
+	EKF_PARAM_FLOAT(ekf2_gnd_max_hgt),
+#endif // CONFIG_EKF2_BAROMETER
+#if defined(CONFIG_EKF2_GNSS)
+	EKF_PARAM_INT(ekf2_gps_ctrl),
+	EKF_PARAM_INT(ekf2_gps_mode),
+	EKF_PARAM_FLOAT(ekf2_gps_delay),
+	EKF_PARAM_FLOAT(ekf2_gps_v_noise),
+	EKF_PARAM_FLOAT(ekf2_gps_p_noise),
+	EKF_PARAM_FLOAT(ekf2_gps_p_gate),
+	EKF_PARAM_FLOAT(ekf2_gps_v_gate),
+	EKF_PARAM_INT(ekf2_gps_check),
+	EKF_PARAM_FLOAT(ekf2_req_eph),
+	EKF_PARAM_FLOAT(ekf2_req_epv),
+	EKF_PARAM_FLOAT(ekf2_req_sacc),
+	EKF_PARAM_INT(ekf2_req_nsats),
+	EKF_PARAM_FLOAT(ekf2_req_pdop),
+	EKF_PARAM_FLOAT(ekf2_req_hdrift),
+	EKF_PARAM_FLOAT(ekf2_req_vdrift),
+	EKF_PARAM_INT(ekf2_req_fix),
+	EKF_PARAM_FLOAT(ekf2_gsf_tas),
+#endif // CONFIG_EKF2_GNSS
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+	EKF_PARAM_FLOAT(ekf2_mag_delay),
+	EKF_PARAM_FLOAT(ekf2_mag_e_noise),
+	EKF_PARAM_FLOAT(ekf2_mag_b_noise),
+	EKF_PARAM_FLOAT(ekf2_mag_noise),
+	EKF_PARAM_FLOAT(ekf2_mag_decl),
+	EKF_PARAM_FLOAT(ekf2_mag_gate),
+	EKF_PARAM_INT(ekf2_decl_type),
+	EKF_PARAM_INT(ekf2_mag_type),
+	EKF_PARAM_FLOAT(ekf2_mag_acclim),
+	EKF_PARAM_INT(ekf2_mag_check),
+#endif // CONFIG_EKF2_MAGNETOMETER
+#if defined(CONFIG_EKF2_AIRSPEED)
+	EKF_PARAM_FLOAT(ekf2_asp_delay),
+	EKF_PARAM_FLOAT(ekf2_tas_gate),
+	EKF_PARAM_FLOAT(ekf2_eas_noise),
+	EKF_PARAM_FLOAT(ekf2_arsp_thr),
+#endif // CONFIG_EKF2_AIRSPEED
+#if defined(CONFIG_EKF2_TERRAIN)
+	EKF_PARAM_FLOAT(ekf2_terr_noise),
+	EKF_PARAM_FLOAT(ekf2_terr_grad),
+#endif // CONFIG_EKF2_TERRAIN
+#if defined(CONFIG_EKF2_RANGE_FINDER)
+	EKF_PARAM_INT(ekf2_rng_ctrl),
+	EKF_PARAM_FLOAT(ekf2_rng_delay),
+	EKF_PARAM_FLOAT(ekf2_rng_noise),
+	EKF_PARAM_FLOAT(ekf2_rng_gate),
+	EKF_PARAM_FLOAT(ekf2_rng_sfe),
+#endif // CONFIG_EKF2_RANGE_FINDER
+#if defined(CONFIG_EKF2_OPTICAL_FLOW)
+	EKF_PARAM_INT(ekf2_of_ctrl),
+	EKF_PARAM_FLOAT(ekf2_of_delay),
+	EKF_PARAM_FLOAT(ekf2_of_n_min),
+	EKF_PARAM_FLOAT(ekf2_of_n_max),
+	EKF_PARAM_FLOAT(ekf2_of_gate),
+#endif // CONFIG_EKF2_OPTICAL_FLOW
+};
+
+#undef EKF_PARAM_FLOAT
+#undef EKF_PARAM_INT
+
+struct ReplayJob {
+	std::string name;
+	std::string params_file; ///< empty: default parameters
+};
+
+struct ReplayOptions {
+	std::string output_dir{"."};
+	float output_rate_hz{10.f};
+	bool start_gps{false};
+	bool start_flow{false};
+	bool start_range{false};
+	bool start_airspeed{false};
+};
+
+std::mutex print_mutex;
+
+bool applyParamsFromFile(parameters &params, const std::string &file_name)
+{
+	std::ifstream file(file_name);
+
+	if (!file.is_open()) {
+		fprintf(stderr, "failed to open %s\n", file_name.c_str());
+		return false;
+	}
+
+	std::string line;
+
+	while (std::getline(file, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+
+		std::istringstream line_stream(line);
+		std::string name;
+		double value = 0.;
+
+		if (!(line_stream >> name >> value)) {
+			continue;
+		}
+
+		bool found = false;
+
+		for (const ParamEntry &entry : param_table) {
+			if (strcasecmp(entry.name, name.c_str()) == 0) {
+				if (entry.value_float) {
+					params.*entry.value_float = static_cast<float>(value);
+
+				} else {
+					params.*entry.value_int = static_cast<int32_t>(value);
+				}
+
+				found = true;
+				break;
+			}
+		}
+
+		if (!found) {
+			fprintf(stderr, "%s: unsupported parameter %s\n", file_name.c_str(), name.c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool runJob(const ReplayJob &job, const std::shared_ptr<const std::vector<sensor_info>> &replay_data,
+	    const ReplayOptions &options)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	std::shared_ptr<Ekf> ekf = std::make_shared<Ekf>();
+
+	if (!job.params_file.empty() && !applyParamsFromFile(*ekf->getParamHandle(), job.params_file)) {
+		return false;
+	}
+
+	ekf->init(0);
+
+	SensorSimulator sensor_simulator(ekf);
+	sensor_simulator.setReplayData(replay_data);
+
+	if (options.start_gps) { sensor_simulator.startGps(); }
+
+	if (options.start_flow) { sensor_simulator.startFlow(); }
+
+	if (options.start_range) { sensor_simulator.startRangeFinder(); }
+
+	if (options.start_airspeed) { sensor_simulator.startAirspeedSensor(); }
+
+	EkfLogger ekf_logger(ekf);
+	ekf_logger.setFilePath(options.output_dir + "/" + job.name + ".csv");
+
+	while (!sensor_simulator.replayFinished()) {
+		sensor_simulator.runReplaySeconds(1.f / options.output_rate_hz);
+		ekf_logger.writeStateToFile();
+	}
+
+	const double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const double replay_s = sensor_simulator.getTime() * 1e-6;
+
+	std::lock_guard<std::mutex> lock(print_mutex);
+	printf("%s: %.1f s replayed in %.2f s (%.0fx)\n", job.name.c_str(), replay_s, elapsed_s,
+	       (elapsed_s > 0.) ? replay_s / elapsed_s : 0.);
+
+	return true;
+}
+
+std::string jobName(const std::string &params_file)
+{
+	size_t begin = params_file.find_last_of('/');
+	begin = (begin == std::string::npos) ? 0 : begin + 1;
+	const size_t end = params_file.find_last_of('.');
+
+	return params_file.substr(begin, (end == std::string::npos || end < begin) ? std::string::npos : end - begin);
+}
+
+void usage()
+{
+	fprintf(stderr, "usage: ekf_replay_batch [-j threads] [-r output rate Hz] [-o output dir] <sensor data> [<params file>...]\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	ReplayOptions options;
+	unsigned num_threads = std::thread::hardware_concurrency();
+	int ch;
+
+	while ((ch = getopt(argc, argv, "j:r:o:h")) != -1) {
+		switch (ch) {
+		case 'j':
+			num_threads = strtoul(optarg, nullptr, 10);
+			break;
+
+		case 'r':
+			options.output_rate_hz = strtof(optarg, nullptr);
+			break;
+
+		case 'o':
+			options.output_dir = optarg;
+			break;
+
+		default:
+			usage();
+			return 1;
+		}
+	}
+
+	if (optind >= argc || !(options.output_rate_hz > 0.f)) {
+		usage();
+		return 1;
+	}
+
+	const auto replay_data = SensorSimulator::readSensorDataFile(argv[optind]);
+
+	if (replay_data->empty()) {
+		fprintf(stderr, "no sensor data in %s\n", argv[optind]);
+		return 1;
+	}
+
+	// only run the simulated sensors that have data in the file
+	for (const sensor_info &sample : *replay_data) {
+		options.start_gps |= sample.sensor_type == sensor_info::measurement_t::GPS;
+		options.start_flow |= sample.sensor_type == sensor_info::measurement_t::FLOW;
+		options.start_range |= sample.sensor_type == sensor_info::measurement_t::RANGE;
+		options.start_airspeed |= sample.sensor_type == sensor_info::measurement_t::AIRSPEED;
+	}
+
+	std::vector<ReplayJob> jobs;
+
+	for (int i = optind + 1; i < argc; i++) {
+		jobs.push_back({jobName(argv[i]), argv[i]});
+	}
+
+	if (jobs.empty()) {
+		jobs.push_back({"default", ""});
+	}
+
+	num_threads = math::constrain(num_threads, 1u, static_cast<unsigned>(jobs.size()));
+
+	std::atomic<size_t> next_job{0};
+	std::atomic<int> num_failed{0};
+	std::vector<std::thread> threads;
+
+	for (unsigned i = 0; i < num_threads; i++) {
+		threads.emplace_back([&]() {
+			for (size_t job = next_job++; job < jobs.size(); job = next_job++) {
+				if (!runJob(jobs[job], replay_data, options)) {
+					num_failed++;
+				}
+			}
+		});
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	return (num_failed > 0) ? 1 : 0;
+}
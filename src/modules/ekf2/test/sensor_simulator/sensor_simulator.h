@@ -119,6 +119,12 @@ public:
 
 	void loadSensorDataFromFile(std::string filename);
 
+	// parse a sensor data file once, the result can be shared by several simulators (read only)
+	static std::shared_ptr<const std::vector<sensor_info>> readSensorDataFile(const std::string &file_name);
+	void setReplayData(std::shared_ptr<const std::vector<sensor_info>> replay_data);
+
+	bool replayFinished() const { return !_replay_data || (_current_replay_data_index >= _replay_data->size()); }
+
 	Airspeed    _airspeed;
 	Baro        _baro;
 	Flow        _flow;
@@ -141,7 +147,7 @@ private:
 
 	std::shared_ptr<Ekf> _ekf{nullptr};
 
-	std::vector<sensor_info> _replay_data{};
+	std::shared_ptr<const std::vector<sensor_info>> _replay_data{};
 
 	bool _has_replay_data{false};
 
@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include "EKF/ekf.h"
+#include "EKF/covariance_prediction.hpp"
+#include "test_helper/comparison_helper.h"
+
+#include "../EKF/python/ekf_derivation/generated/predict_covariance.h"
+#include "../EKF/python/ekf_derivation/generated/state.h"
+
+using namespace matrix;
+
+static constexpr unsigned kKinematicDof = CovariancePrediction::kKinematicDof;
+
+TEST(CovariancePredictionBlockwise, matchesGeneratedFull)
+{
+	// GIVEN: a random state and covariance with some stationary states uncorrelated
+	StateSample state{};
+	state.quat_nominal = Quatf(Eulerf(0.1f, -0.2f, 1.5f));
+	state.vel = Vector3f(randf(), randf(), randf());
+	state.gyro_bias = Vector3f(randf(), randf(), randf()) * 0.01f;
+	state.accel_bias = Vector3f(randf(), randf(), randf()) * 0.1f;
+
+	SquareMatrixState P = createRandomCovarianceMatrix();
+
+	for (unsigned i = kKinematicDof; i < State::size; i += 2) {
+		P.uncorrelateCovarianceSetVariance<1>(i, P(i, i));
+	}
+
+	const Vector3f accel(0.3f, -0.1f, -9.7f);
+	const Vector3f accel_var(0.01f, 0.01f, 0.01f);
+	const Vector3f gyro(0.02f, 0.1f, -0.05f);
+	const float gyro_var = 1e-4f;
+	const float dt = 0.01f;
+
+	// WHEN: the covariance is predicted block by block, skipping the uncorrelated states
+	const CovariancePrediction prediction(state, accel, dt);
+	SquareMatrixState P_blockwise = P;
+
+	for (unsigned column = kKinematicDof; column < State::size; column++) {
+		const Vector<float, kKinematicDof> P_cross = P.slice<kKinematicDof, 1>(0, column);
+
+		if (P_cross.abs().max() > 0.f) {
+			P_blockwise.slice<kKinematicDof, 1>(0, column) = prediction.cross(P_cross);
+		}
+	}
+
+	const SquareMatrix<float, kKinematicDof> P_kinematic = P.slice<kKinematicDof, kKinematicDof>(0, 0);
+	P_blockwise.slice<kKinematicDof, kKinematicDof>(0, 0) = prediction.kinematic(P_kinematic, accel_var, gyro_var);
+
+	const SquareMatrixState P_full = sym::PredictCovariance(state.vector(), P, accel, accel_var, gyro, gyro_var, dt);
+
+	// THEN: the upper triangle matches the full prediction and the uncorrelated states stay uncorrelated
+	for (unsigned row = 0; row < State::size; row++) {
+		for (unsigned column = row; column < State::size; column++) {
+			EXPECT_NEAR(P_blockwise(row, column), P_full(row, column), 1e-6f) << "P(" << row << ", " << column << ")";
+		}
+	}
+
+	for (unsigned i = kKinematicDof; i < State::size; i += 2) {
+		for (unsigned row = 0; row < kKinematicDof; row++) {
+			EXPECT_EQ(P_blockwise(row, i), 0.f);
+		}
+	}
+}
@@ -142,6 +142,29 @@ TEST_F(EkfRingBufferTest, askingForTooNewSample)
 	EXPECT_EQ(false, _buffer->pop_first_older_than(_y.time_us + 100000, &pop));
 }
 
+TEST_F(EkfRingBufferTest, popFromEmptyBuffer)
+{
+	ASSERT_EQ(true, _buffer->allocate(3));
+
+	sample pop = {};
+	// WHEN: nothing was pushed yet
+	// THEN: should get no sample returned
+	EXPECT_EQ(false, _buffer->pop_first_older_than(_x.time_us, &pop));
+
+	// WHEN: the newest sample was popped (older samples are discarded)
+	_buffer->push(_x);
+	_buffer->push(_y);
+	EXPECT_EQ(true, _buffer->pop_first_older_than(_y.time_us, &pop));
+	EXPECT_EQ(_y.time_us, pop.time_us);
+
+	// THEN: the buffer is empty until the next push
+	EXPECT_EQ(false, _buffer->pop_first_older_than(_x.time_us, &pop));
+	_buffer->push(_z);
+	EXPECT_EQ(false, _buffer->pop_first_older_than(_y.time_us, &pop));
+	EXPECT_EQ(true, _buffer->pop_first_older_than(_z.time_us, &pop));
+	EXPECT_EQ(_z.time_us, pop.time_us);
+}
+
 TEST_F(EkfRingBufferTest, reallocateBuffer)
 {
 	ASSERT_EQ(true, _buffer->allocate(5));
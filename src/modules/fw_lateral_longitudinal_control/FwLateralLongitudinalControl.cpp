@@ -234,39 +234,39 @@ void FwLateralLongitudinalControl::Run()
 				_fw_lateral_ctrl_sub.copy(&_lat_control_sp);
 			}
 
-			float airspeed_direction_sp{NAN};
+			// the directions are handled as unit vectors, avoiding conversions to angles and back
+			Vector2f airspeed_direction_sp{NAN, NAN};
 			float lateral_accel_sp {NAN};
 			const Vector2f airspeed_vector = _lateral_control_state.ground_speed - _lateral_control_state.wind_speed;
 
 			if (PX4_ISFINITE(_lat_control_sp.course) && !PX4_ISFINITE(_lat_control_sp.airspeed_direction)) {
 				// only use the course setpoint if it's finite but airspeed_direction is not
+				const Vector2f bearing_vector{cosf(_lat_control_sp.course), sinf(_lat_control_sp.course)};
 
-				airspeed_direction_sp = _course_to_airspeed.mapCourseSetpointToHeadingSetpoint(
-								_lat_control_sp.course, _lateral_control_state.wind_speed,
+				airspeed_direction_sp = _course_to_airspeed.mapBearingToAirspeedDirection(
+								bearing_vector, _lateral_control_state.wind_speed,
 								airspeed_sp_eas);
 
 				// Note: the here updated _min_airspeed_from_guidance is only used in the next iteration
 				// in the longitudinal controller.
 				const float max_true_airspeed = _performance_model.getMaximumCalibratedAirspeed() * _long_control_state.eas2tas;
-				_min_airspeed_from_guidance = _course_to_airspeed.getMinAirspeedForCurrentBearing(
-								      _lat_control_sp.course, _lateral_control_state.wind_speed,
+				_min_airspeed_from_guidance = _course_to_airspeed.getMinAirspeedForBearing(
+								      bearing_vector, _lateral_control_state.wind_speed,
 								      max_true_airspeed, _param_fw_gnd_spd_min.get())
 							      / _long_control_state.eas2tas;
 
 			} else if (PX4_ISFINITE(_lat_control_sp.airspeed_direction)) {
 				// If the airspeed_direction is finite we use that instead of the course.
 
-				airspeed_direction_sp = _lat_control_sp.airspeed_direction;
+				airspeed_direction_sp = Vector2f{cosf(_lat_control_sp.airspeed_direction), sinf(_lat_control_sp.airspeed_direction)};
 				_min_airspeed_from_guidance = 0.f; // reset if no longer in course control
 
 			} else {
 				_min_airspeed_from_guidance = 0.f; // reset if no longer in course control
 			}
 
-			if (PX4_ISFINITE(airspeed_direction_sp)) {
-				const float heading = atan2f(airspeed_vector(1), airspeed_vector(0));
-				lateral_accel_sp = _airspeed_direction_control.controlHeading(airspeed_direction_sp, heading,
-						   airspeed_vector.norm());
+			if (airspeed_direction_sp.isAllFinite()) {
+				lateral_accel_sp = _airspeed_direction_control.controlAirspeedDirection(airspeed_direction_sp, airspeed_vector);
 			}
 
 			if (PX4_ISFINITE(_lat_control_sp.lateral_acceleration)) {
@@ -306,6 +306,9 @@ void FwLateralLongitudinalControl::Run()
 			// roll slew rate
 			roll_body = _roll_slew_rate.update(roll_body, control_interval);
 
+			// load factor of the roll setpoint, used for the minimum airspeed in the next iteration
+			_load_factor_from_roll_sp = 1.f / math::max(cosf(roll_body), FLT_EPSILON);
+
 			_att_sp.timestamp = hrt_absolute_time();
 			const Quatf q(Eulerf(roll_body, pitch_body, yaw_body));
 			q.copyTo(_att_sp.q_d);
@@ -837,15 +840,7 @@ void FwLateralLongitudinalControl::updateLongitudinalControlConfiguration(const
 
 float FwLateralLongitudinalControl::getLoadFactor() const
 {
-	float load_factor_from_bank_angle = 1.f;
-
-	const float roll_body = Eulerf(Quatf(_att_sp.q_d)).phi();
-
-	if (PX4_ISFINITE(roll_body)) {
-		load_factor_from_bank_angle = 1.f / math::max(cosf(roll_body), FLT_EPSILON);
-	}
-
-	return load_factor_from_bank_angle;
+	return _load_factor_from_roll_sp;
 }
 
 extern "C" __EXPORT int fw_lat_lon_control_main(int argc, char *argv[])
@@ -198,6 +198,7 @@ private:
 	hrt_abstime _time_since_first_reduced_roll{0U}; ///< absolute time since start when entering reduced roll angle for the first time
 	hrt_abstime _time_since_last_npfg_call{0U}; 	///< absolute time since start when the npfg reduced roll angle calculations was last performed
 	vehicle_attitude_setpoint_s _att_sp{};
+	float _load_factor_from_roll_sp{1.f}; ///< load factor due to banking of the last published roll setpoint
 	bool _landed{false};
 	float _can_run_factor{0.f};
 	SlewRate<float> _airspeed_slew_rate_controller;
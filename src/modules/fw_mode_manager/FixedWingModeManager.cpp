@@ -2571,14 +2571,21 @@ DirectionalGuidanceOutput FixedWingModeManager::navigateLine(const Vector2f &poi
 		const Vector2f &point_on_line_2,
 		const Vector2f &vehicle_pos, const Vector2f &ground_vel, const Vector2f &wind_vel)
 {
-	const Vector2f line_segment = point_on_line_2 - point_on_line_1;
+	if (!matrix::isEqual(point_on_line_1, _line_segment_start, 0.f)
+	    || !matrix::isEqual(point_on_line_2, _line_segment_end, 0.f)) {
+		const Vector2f line_segment = point_on_line_2 - point_on_line_1;
 
-	if (line_segment.norm() <= FLT_EPSILON) {
-		// degenerate case: line segment has zero length. maintain the last npfg command.
-		return DirectionalGuidanceOutput{};
+		if (line_segment.norm() <= FLT_EPSILON) {
+			// degenerate case: line segment has zero length. maintain the last npfg command.
+			return DirectionalGuidanceOutput{};
+		}
+
+		_line_segment_start = point_on_line_1;
+		_line_segment_end = point_on_line_2;
+		_line_segment_unit_tangent = line_segment.normalized();
 	}
 
-	const Vector2f unit_path_tangent = line_segment.normalized();
+	const Vector2f &unit_path_tangent = _line_segment_unit_tangent;
 
 	const Vector2f point_1_to_vehicle = vehicle_pos - point_on_line_1;
 	_closest_point_on_path = point_on_line_1 + point_1_to_vehicle.dot(unit_path_tangent) * unit_path_tangent;
@@ -379,6 +379,11 @@ private:
 	// CLosest point on path to track
 	matrix::Vector2f _closest_point_on_path;
 
+	// unit tangent of the last line segment, only recomputed when the segment changes
+	matrix::Vector2f _line_segment_start{NAN, NAN};
+	matrix::Vector2f _line_segment_end{NAN, NAN};
+	matrix::Vector2f _line_segment_unit_tangent{NAN, NAN};
+
 	// nonlinear path following guidance - lateral-directional position control
 	DirectionalGuidance _directional_guidance;
 
@@ -48,7 +48,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <px4_platform_common/defines.h>
-#include <px4_platform_common/tasks.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 
 #include "gimbal_params.h"
 #include "input_mavlink.h"
@@ -57,473 +57,424 @@
 #include "output_rc.h"
 #include "output_mavlink.h"
 
+#include <lib/perf/perf_counter.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionInterval.hpp>
 #include <uORB/topics/parameter_update.h>
 
 #include <px4_platform_common/module.h>
-#include <px4_platform_common/atomic.h>
 
 using namespace time_literals;
 using namespace gimbal;
 
-static px4::atomic<bool> thread_should_exit {false};
-static px4::atomic<bool> thread_running {false};
+static void update_params(ParameterHandles &param_handles, Parameters &params);
+static bool initialize_params(ParameterHandles &param_handles, Parameters &params);
 
-static constexpr int input_objs_len_max = 3;
+class Gimbal : public ModuleBase<Gimbal>, public px4::ScheduledWorkItem
+{
+public:
+	Gimbal();
+	~Gimbal() override;
 
-struct ThreadData {
-	InputBase *input_objs[input_objs_len_max] = {nullptr, nullptr, nullptr};
-	int input_objs_len = 0;
-	int last_input_active = -1;
-	OutputBase *output_obj = nullptr;
-	InputTest *test_input = nullptr;
-	ControlData control_data {};
-};
-static ThreadData *g_thread_data = nullptr;
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
 
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
 
-static void usage();
-static void update_params(ParameterHandles &param_handles, Parameters &params);
-static bool initialize_params(ParameterHandles &param_handles, Parameters &params);
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	bool init();
 
-static int gimbal_thread_main(int argc, char *argv[]);
-extern "C" __EXPORT int gimbal_main(int argc, char *argv[]);
+private:
+	void Run() override;
 
-static int gimbal_thread_main(int argc, char *argv[])
+	int test_command(int argc, char *argv[]);
+	int primary_control_command(int argc, char *argv[]);
+
+	static constexpr int input_objs_len_max = 3;
+
+	// output update interval while it changes without new input, and the keepalive interval otherwise
+	static constexpr hrt_abstime PERIODIC_UPDATE_INTERVAL{20_ms};
+	static constexpr hrt_abstime IDLE_UPDATE_INTERVAL{200_ms};
+
+	ParameterHandles _param_handles{};
+	Parameters _params{};
+
+	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
+
+	InputBase *_input_objs[input_objs_len_max] {nullptr, nullptr, nullptr};
+	int _input_objs_len{0};
+	int _last_input_active{-1};
+	OutputBase *_output_obj{nullptr};
+	InputTest *_test_input{nullptr};
+	ControlData _control_data{};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
+};
+
+Gimbal::Gimbal() :
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default)
 {
-	ParameterHandles param_handles;
-	Parameters params {};
-	ThreadData thread_data;
+}
 
-	if (!initialize_params(param_handles, params)) {
-		PX4_ERR("could not get mount parameters!");
-		delete g_thread_data->test_input;
-		return -1;
+Gimbal::~Gimbal()
+{
+	for (int i = 0; i < input_objs_len_max; ++i) {
+		delete _input_objs[i];
+		_input_objs[i] = nullptr;
 	}
 
-	uORB::SubscriptionInterval parameter_update_sub{ORB_ID(parameter_update), 1_s};
-	thread_running.store(true);
-	g_thread_data = &thread_data;
+	_input_objs_len = 0;
+
+	delete _output_obj;
+	_output_obj = nullptr;
 
-	thread_data.test_input = new InputTest(params);
+	perf_free(_cycle_perf);
+}
 
-	bool alloc_failed = false;
+bool Gimbal::init()
+{
+	if (!initialize_params(_param_handles, _params)) {
+		PX4_ERR("could not get mount parameters!");
+		return false;
+	}
 
-	thread_data.input_objs[thread_data.input_objs_len++] = thread_data.test_input;
+	_test_input = new InputTest(_params);
+	_input_objs[_input_objs_len++] = _test_input;
 
-	switch (params.mnt_mode_in) {
+	switch (_params.mnt_mode_in) {
 	case MNT_MODE_IN_AUTO:
 		// Automatic
 		// MAVLINK_V2 as well as RC input are supported together.
 		// Whichever signal is updated last, gets control, for RC there is a deadzone
 		// to avoid accidental activation.
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkGimbalV2(params);
+		_input_objs[_input_objs_len++] = new InputMavlinkGimbalV2(_params, this);
 
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputRC(params);
+		_input_objs[_input_objs_len++] = new InputRC(_params, this);
 		break;
 
 	case MNT_MODE_IN_RC: // RC only
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputRC(params);
+		_input_objs[_input_objs_len++] = new InputRC(_params, this);
 		break;
 
 	case MNT_MODE_IN_MAVLINK_ROI: // MAVLINK_ROI commands only (to be deprecated)
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkROI(params);
+		_input_objs[_input_objs_len++] = new InputMavlinkROI(_params, this);
 		break;
 
 	case MNT_MODE_IN_MAVLINK_DO_MOUNT: // MAVLINK_DO_MOUNT commands only (to be deprecated)
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkCmdMount(params);
+		_input_objs[_input_objs_len++] = new InputMavlinkCmdMount(_params, this);
 		break;
 
 	case MNT_MODE_IN_MAVLINK_V2: //MAVLINK_V2
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkGimbalV2(params);
+		_input_objs[_input_objs_len++] = new InputMavlinkGimbalV2(_params, this);
 		break;
 
 	default:
-		PX4_ERR("invalid input mode %" PRId32, params.mnt_mode_in);
+		PX4_ERR("invalid input mode %" PRId32, _params.mnt_mode_in);
 		break;
 	}
 
-	for (int i = 0; i < thread_data.input_objs_len; ++i) {
-		if (!thread_data.input_objs[i]) {
-			alloc_failed = true;
+	for (int i = 0; i < _input_objs_len; ++i) {
+		if (!_input_objs[i]) {
+			PX4_ERR("input objs memory allocation failed");
+			return false;
 		}
 	}
 
-	if (alloc_failed) {
-		PX4_ERR("input objs memory allocation failed");
-		thread_should_exit.store(true);
-	}
-
-	if (!alloc_failed) {
-		for (int i = 0; i < thread_data.input_objs_len; ++i) {
-			if (thread_data.input_objs[i]->initialize() != 0) {
-				PX4_ERR("Input %d failed", i);
-				thread_should_exit.store(true);
-			}
+	// the inputs register their subscription callbacks on this work item
+	for (int i = 0; i < _input_objs_len; ++i) {
+		if (_input_objs[i]->initialize() != 0) {
+			PX4_ERR("Input %d failed", i);
+			return false;
 		}
 	}
 
-	switch (params.mnt_mode_out) {
+	switch (_params.mnt_mode_out) {
 	case MNT_MODE_OUT_AUX: //AUX
-		thread_data.output_obj = new OutputRC(params);
-
-		if (!thread_data.output_obj) { alloc_failed = true; }
-
+		_output_obj = new OutputRC(_params);
 		break;
 
 	case MNT_MODE_OUT_MAVLINK_V1: //MAVLink gimbal v1 protocol
-		thread_data.output_obj = new OutputMavlinkV1(params);
-
-		if (!thread_data.output_obj) { alloc_failed = true; }
-
+		_output_obj = new OutputMavlinkV1(_params);
 		break;
 
 	case MNT_MODE_OUT_MAVLINK_V2: //MAVLink gimbal v2 protocol
-		thread_data.output_obj = new OutputMavlinkV2(params);
-
-		if (!thread_data.output_obj) { alloc_failed = true; }
-
+		_output_obj = new OutputMavlinkV2(_params);
 		break;
 
 	default:
-		PX4_ERR("invalid output mode %" PRId32, params.mnt_mode_out);
-		thread_should_exit.store(true);
-		break;
+		PX4_ERR("invalid output mode %" PRId32, _params.mnt_mode_out);
+		return false;
 	}
 
-	if (alloc_failed) {
+	if (!_output_obj) {
 		PX4_ERR("output memory allocation failed");
-		thread_should_exit.store(true);
+		return false;
 	}
 
-	while (!thread_should_exit.load()) {
+	ScheduleNow();
+	return true;
+}
 
-		const bool updated = parameter_update_sub.updated();
+void Gimbal::Run()
+{
+	if (should_exit()) {
+		exit_and_cleanup();
+		return;
+	}
 
-		if (updated) {
-			parameter_update_s pupdate;
-			parameter_update_sub.copy(&pupdate);
-			update_params(param_handles, params);
-		}
+	perf_begin(_cycle_perf);
 
-		InputBase::UpdateResult update_result = InputBase::UpdateResult::NoUpdate;
+	if (_parameter_update_sub.updated()) {
+		parameter_update_s pupdate;
+		_parameter_update_sub.copy(&pupdate);
+		update_params(_param_handles, _params);
+	}
 
-		if (thread_data.input_objs_len > 0) {
+	InputBase::UpdateResult update_result = InputBase::UpdateResult::NoUpdate;
 
-			// get input: we cannot make the timeout too large, because the output needs to update
-			// periodically for stabilization and angle updates.
+	// every input consumes its own updates, the first one taking control wins
+	for (int i = 0; i < _input_objs_len; ++i) {
 
-			for (int i = 0; i < thread_data.input_objs_len; ++i) {
+		const bool already_active = (_last_input_active == i);
 
-				const bool already_active = (thread_data.last_input_active == i);
-				// poll only on active input to reduce latency, or on all if none is active
-				const unsigned int poll_timeout =
-					(already_active || thread_data.last_input_active == -1) ? 20 : 0;
+		update_result = _input_objs[i]->update(_control_data, already_active);
 
-				update_result = thread_data.input_objs[i]->update(poll_timeout, thread_data.control_data, already_active);
+		bool break_loop = false;
 
-				bool break_loop = false;
+		switch (update_result) {
+		case InputBase::UpdateResult::NoUpdate:
+			if (already_active) {
+				// No longer active.
+				_last_input_active = -1;
+			}
 
-				switch (update_result) {
-				case InputBase::UpdateResult::NoUpdate:
-					if (already_active) {
-						// No longer active.
-						thread_data.last_input_active = -1;
-					}
+			break;
 
-					break;
+		case InputBase::UpdateResult::UpdatedActive:
+			_last_input_active = i;
+			break_loop = true;
+			break;
 
-				case InputBase::UpdateResult::UpdatedActive:
-					thread_data.last_input_active = i;
-					break_loop = true;
-					break;
+		case InputBase::UpdateResult::UpdatedActiveOnce:
+			_last_input_active = -1;
+			break_loop = true;
+			break;
 
-				case InputBase::UpdateResult::UpdatedActiveOnce:
-					thread_data.last_input_active = -1;
-					break_loop = true;
-					break;
+		case InputBase::UpdateResult::UpdatedNotActive:
+			// Ignore, input not active
+			break;
+		}
 
-				case InputBase::UpdateResult::UpdatedNotActive:
-					// Ignore, input not active
-					break;
-				}
+		if (break_loop) {
+			break;
+		}
+	}
 
-				if (break_loop) {
-					break;
-				}
-			}
+	if (_params.mnt_do_stab == 1) {
+		_output_obj->set_stabilize(true, true, true);
 
-			if (params.mnt_do_stab == 1) {
-				thread_data.output_obj->set_stabilize(true, true, true);
+	} else if (_params.mnt_do_stab == 2) {
+		_output_obj->set_stabilize(false, false, true);
 
-			} else if (params.mnt_do_stab == 2) {
-				thread_data.output_obj->set_stabilize(false, false, true);
+	} else {
+		_output_obj->set_stabilize(false, false, false);
+	}
 
-			} else {
-				thread_data.output_obj->set_stabilize(false, false, false);
-			}
+	if (_output_obj->check_and_handle_setpoint_timeout(_control_data, hrt_absolute_time())) {
+		// Without flagging an update the changes are not processed in the output
+		update_result = InputBase::UpdateResult::UpdatedActive;
+	}
 
-			if (thread_data.output_obj->check_and_handle_setpoint_timeout(thread_data.control_data, hrt_absolute_time())) {
-				// Without flagging an update the changes are not processed in the output
-				update_result = InputBase::UpdateResult::UpdatedActive;
-			}
+	// Update output
+	_output_obj->update(_control_data, update_result != InputBase::UpdateResult::NoUpdate, _control_data.device_compid);
 
-			// Update output
-			thread_data.output_obj->update(
-				thread_data.control_data,
-				update_result != InputBase::UpdateResult::NoUpdate, thread_data.control_data.device_compid);
+	// Only publish the mount orientation if the mode is not mavlink v1 or v2
+	// If the gimbal speaks mavlink it publishes its own orientation.
+	if (_params.mnt_mode_out != MNT_MODE_OUT_MAVLINK_V1 && _params.mnt_mode_out != MNT_MODE_OUT_MAVLINK_V2) {
+		_output_obj->publish();
+	}
 
-			// Only publish the mount orientation if the mode is not mavlink v1 or v2
-			// If the gimbal speaks mavlink it publishes its own orientation.
-			if (params.mnt_mode_out != MNT_MODE_OUT_MAVLINK_V1 && params.mnt_mode_out != MNT_MODE_OUT_MAVLINK_V2) {
-				thread_data.output_obj->publish();
-			}
+	// input updates schedule immediately, this is the fallback if none arrive
+	ScheduleDelayed(_output_obj->requires_periodic_update(_control_data) ? PERIODIC_UPDATE_INTERVAL : IDLE_UPDATE_INTERVAL);
 
-		} else {
-			// We still need to wake up regularly to check for thread exit requests
-			px4_usleep(1e6);
+	perf_end(_cycle_perf);
+}
+
+int Gimbal::task_spawn(int argc, char *argv[])
+{
+	Gimbal *instance = new Gimbal();
+
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
+
+		if (instance->init()) {
+			return PX4_OK;
 		}
+
+	} else {
+		PX4_ERR("alloc failed");
 	}
 
-	g_thread_data = nullptr;
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
 
-	for (int i = 0; i < input_objs_len_max; ++i) {
-		if (thread_data.input_objs[i]) {
-			delete (thread_data.input_objs[i]);
-			thread_data.input_objs[i] = nullptr;
-		}
+	return PX4_ERROR;
+}
+
+int Gimbal::custom_command(int argc, char *argv[])
+{
+	if (!is_running()) {
+		PX4_WARN("not running");
+		print_usage();
+		return 1;
 	}
 
-	thread_data.input_objs_len = 0;
+	if (!strcmp(argv[0], "test")) {
+		return get_instance()->test_command(argc, argv);
+	}
 
-	if (thread_data.output_obj) {
-		delete (thread_data.output_obj);
-		thread_data.output_obj = nullptr;
+	if (!strcmp(argv[0], "primary-control")) {
+		return get_instance()->primary_control_command(argc, argv);
 	}
 
-	thread_running.store(false);
-	return 0;
+	return print_usage("unrecognized command");
 }
 
-int gimbal_main(int argc, char *argv[])
+int Gimbal::test_command(int argc, char *argv[])
 {
-	if (argc < 2) {
-		PX4_ERR("missing command");
-		usage();
+	if (argc < 3) {
+		PX4_ERR("No angles or angle rates set");
+		print_usage();
 		return -1;
 	}
 
-	if (!strcmp(argv[1], "start")) {
+	float roll_deg = 0.0f;
+	float pitch_deg = 0.0f;
+	float yaw_deg = 0.0f;
+	float rollrate_deg_s = 0.0f;
+	float pitchrate_deg_s = 0.0f;
+	float yawrate_deg_s = 0.0f;
 
-		if (thread_running.load()) {
-			PX4_WARN("mount driver already running");
-			return 1;
-		}
+	bool angles_set = false;
+	bool rates_set = false;
 
-		thread_should_exit.store(false);
+	for (int arg_i = 1 ; arg_i < (argc - 1); ++arg_i) {
 
-		int gimbal_task = px4_task_spawn_cmd("gimbal",
-						     SCHED_DEFAULT,
-						     SCHED_PRIORITY_DEFAULT,
-						     2100,
-						     gimbal_thread_main,
-						     nullptr);
+		if (!strcmp(argv[arg_i], "roll")) {
+			roll_deg = (int)strtof(argv[arg_i + 1], nullptr);
+			angles_set = true;
 
-		int counter = 0;
+		} else if (!strcmp(argv[arg_i], "pitch")) {
+			pitch_deg = (int)strtof(argv[arg_i + 1], nullptr);
+			angles_set = true;
 
-		while (!thread_running.load() && gimbal_task >= 0) {
-			px4_usleep(5000);
+		} else if (!strcmp(argv[arg_i], "yaw")) {
+			yaw_deg = (int)strtof(argv[arg_i + 1], nullptr);
+			angles_set = true;
 
-			if (++counter >= 100) {
-				break;
-			}
-		}
+		} else if (!strcmp(argv[arg_i], "rollrate")) {
+			rollrate_deg_s = (int)strtof(argv[arg_i + 1], nullptr);
+			rates_set = true;
 
-		if (gimbal_task < 0) {
-			PX4_ERR("failed to start");
+		} else if (!strcmp(argv[arg_i], "pitchrate")) {
+			pitchrate_deg_s = (int)strtof(argv[arg_i + 1], nullptr);
+			rates_set = true;
+
+		} else if (!strcmp(argv[arg_i], "yawrate")) {
+			yawrate_deg_s = (int)strtof(argv[arg_i + 1], nullptr);
+			rates_set = true;
+
+		} else {
+			PX4_ERR("Unknown argument: %s", argv[arg_i]);
+			print_usage();
 			return -1;
 		}
-
-		return counter < 100 || thread_should_exit.load() ? 0 : -1;
 	}
 
-	else if (!strcmp(argv[1], "stop")) {
-
-		if (!thread_running.load()) {
-			PX4_WARN("mount driver not running");
-			return 0;
-		}
+	if (angles_set && rates_set) {
+		PX4_ERR("This driver doesn't support both, angles and rates, to be set");
+		print_usage();
+		return -1;
 
-		thread_should_exit.store(true);
+	} else if (angles_set) {
+		_test_input->set_test_input_angles(roll_deg, pitch_deg, yaw_deg);
 
-		while (thread_running.load()) {
-			px4_usleep(100000);
-		}
+	} else if (rates_set) {
+		_test_input->set_test_input_angle_rates(rollrate_deg_s, pitchrate_deg_s, yawrate_deg_s);
 
-		return 0;
+	} else {
+		PX4_ERR("No angles or angle rates set");
+		print_usage();
+		return -1;
 	}
 
-	else if (!strcmp(argv[1], "test")) {
-
-		if (thread_running.load() && g_thread_data && g_thread_data->test_input) {
-
-			if (argc >= 4) {
-
-				float roll_deg = 0.0f;
-				float pitch_deg = 0.0f;
-				float yaw_deg = 0.0f;
-				float rollrate_deg_s = 0.0f;
-				float pitchrate_deg_s = 0.0f;
-				float yawrate_deg_s = 0.0f;
-
-				bool angles_set = false;
-				bool rates_set = false;
-
-				for (int arg_i = 2 ; arg_i < (argc - 1); ++arg_i) {
-
-					if (!strcmp(argv[arg_i], "roll")) {
-						roll_deg = (int)strtof(argv[arg_i + 1], nullptr);
-						angles_set = true;
-
-					} else if (!strcmp(argv[arg_i], "pitch")) {
-						pitch_deg = (int)strtof(argv[arg_i + 1], nullptr);
-						angles_set = true;
-
-					} else if (!strcmp(argv[arg_i], "yaw")) {
-						yaw_deg = (int)strtof(argv[arg_i + 1], nullptr);
-						angles_set = true;
-
-					} else if (!strcmp(argv[arg_i], "rollrate")) {
-						rollrate_deg_s = (int)strtof(argv[arg_i + 1], nullptr);
-						rates_set = true;
-
-					} else if (!strcmp(argv[arg_i], "pitchrate")) {
-						pitchrate_deg_s = (int)strtof(argv[arg_i + 1], nullptr);
-						rates_set = true;
-
-					} else if (!strcmp(argv[arg_i], "yawrate")) {
-						yawrate_deg_s = (int)strtof(argv[arg_i + 1], nullptr);
-						rates_set = true;
-
-					} else {
-						PX4_ERR("Unknown argument: %s", argv[arg_i]);
-						usage();
-						return -1;
-					}
-				}
-
-				if (angles_set && rates_set) {
-					PX4_ERR("This driver doesn't support both, angles and rates, to be set");
-					usage();
-					return -1;
-
-				} else if (angles_set) {
-					g_thread_data->test_input->set_test_input_angles(
-						roll_deg,
-						pitch_deg,
-						yaw_deg
-					);
-					return 0;
-
-				} else if (rates_set) {
-
-					g_thread_data->test_input->set_test_input_angle_rates(
-						rollrate_deg_s,
-						pitchrate_deg_s,
-						yawrate_deg_s
-					);
-					return 0;
-
-				} else {
-					PX4_ERR("No angles or angle rates set");
-					usage();
-					return -1;
-				}
-			}
+	// the test input has no subscription to trigger an update
+	ScheduleNow();
+	return 0;
+}
 
-		} else {
-			PX4_WARN("not running");
-			usage();
-			return 1;
-		}
+int Gimbal::primary_control_command(int argc, char *argv[])
+{
+	if (argc != 3) {
+		PX4_ERR("not enough arguments");
+		print_usage();
+		return 1;
 	}
 
-	else if (!strcmp(argv[1], "primary-control")) {
+	_control_data.sysid_primary_control = (uint8_t)strtol(argv[1], nullptr, 0);
+	_control_data.compid_primary_control = (uint8_t)strtol(argv[2], nullptr, 0);
 
-		if (thread_running.load() && g_thread_data && g_thread_data->test_input) {
+	PX4_INFO("Control set to: %d/%d", _control_data.sysid_primary_control, _control_data.compid_primary_control);
 
-			if (argc == 4) {
-				g_thread_data->control_data.sysid_primary_control = (uint8_t)strtol(argv[2], nullptr, 0);
-				g_thread_data->control_data.compid_primary_control = (uint8_t)strtol(argv[3], nullptr, 0);
+	return 0;
+}
 
-				PX4_INFO("Control set to: %d/%d",
-					 g_thread_data->control_data.sysid_primary_control,
-					 g_thread_data->control_data.compid_primary_control);
+int Gimbal::print_status()
+{
+	if (_input_objs_len == 0) {
+		PX4_INFO("Input: None");
 
-				return 0;
+	} else {
+		PX4_INFO("Input Selected");
 
-			} else {
-				PX4_ERR("not enough arguments");
-				usage();
-				return 1;
+		for (int i = 0; i < _input_objs_len; ++i) {
+			if (i == _last_input_active) {
+				_input_objs[i]->print_status();
 			}
-
-		} else {
-			PX4_WARN("not running");
-			usage();
-			return 1;
 		}
-	}
-
-	else if (!strcmp(argv[1], "status")) {
-		if (thread_running.load() && g_thread_data && g_thread_data->test_input) {
 
-			if (g_thread_data->input_objs_len == 0) {
-				PX4_INFO("Input: None");
-
-			} else {
-				PX4_INFO("Input Selected");
-
-				for (int i = 0; i < g_thread_data->input_objs_len; ++i) {
-					if (i == g_thread_data->last_input_active) {
-						g_thread_data->input_objs[i]->print_status();
-					}
-				}
-
-				PX4_INFO("Input not selected");
-
-				for (int i = 0; i < g_thread_data->input_objs_len; ++i) {
-					if (i != g_thread_data->last_input_active) {
-						g_thread_data->input_objs[i]->print_status();
-					}
-				}
-
-				PX4_INFO("Primary control:   %d/%d",
-					 g_thread_data->control_data.sysid_primary_control, g_thread_data->control_data.compid_primary_control);
+		PX4_INFO("Input not selected");
 
+		for (int i = 0; i < _input_objs_len; ++i) {
+			if (i != _last_input_active) {
+				_input_objs[i]->print_status();
 			}
+		}
 
-			if (g_thread_data->output_obj) {
-				g_thread_data->output_obj->print_status();
-
-			} else {
-				PX4_INFO("Output: None");
-			}
+		PX4_INFO("Primary control:   %d/%d", _control_data.sysid_primary_control, _control_data.compid_primary_control);
+	}
 
-		} else {
-			PX4_INFO("not running");
-		}
+	if (_output_obj) {
+		_output_obj->print_status();
 
-		return 0;
+	} else {
+		PX4_INFO("Output: None");
 	}
 
-	PX4_ERR("unrecognized command");
-	usage();
-	return -1;
+	perf_print_counter(_cycle_perf);
+
+	return 0;
 }
 
-void update_params(ParameterHandles &param_handles, Parameters &params)
+static void update_params(ParameterHandles &param_handles, Parameters &params)
 {
 	param_get(param_handles.mnt_mode_in, &params.mnt_mode_in);
 	param_get(param_handles.mnt_mode_out, &params.mnt_mode_out);
@@ -548,7 +499,7 @@ void update_params(ParameterHandles &param_handles, Parameters &params)
 	param_get(param_handles.mnt_lnd_p_max, &params.mnt_lnd_p_max);
 }
 
-bool initialize_params(ParameterHandles &param_handles, Parameters &params)
+static bool initialize_params(ParameterHandles &param_handles, Parameters &params)
 {
 	param_handles.mnt_mode_in = param_find("MNT_MODE_IN");
 	param_handles.mnt_mode_out = param_find("MNT_MODE_OUT");
@@ -601,8 +552,12 @@ bool initialize_params(ParameterHandles &param_handles, Parameters &params)
 	return true;
 }
 
-static void usage()
+int Gimbal::print_usage(const char *reason)
 {
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
+
 	PRINT_MODULE_DESCRIPTION(
 		R"DESCR_STR(
 ### Description
@@ -611,6 +566,10 @@ output (eg. AUX channels or MAVLink).
 
 Documentation how to use it is on the [gimbal_control](https://docs.px4.io/main/en/advanced/gimbal_control.html) page.
 
+### Implementation
+The driver runs on a work queue. It is scheduled by updates of the configured inputs, and additionally at 50 Hz
+while the output changes on its own (stabilization, ROI tracking or angular rate setpoints), or at 5 Hz otherwise.
+
 ### Examples
 Test the output by setting a angles (all omitted axes are set to 0):
 $ gimbal test pitch -45 yaw 30
@@ -618,11 +577,17 @@ $ gimbal test pitch -45 yaw 30
 
 	PRINT_MODULE_USAGE_NAME("gimbal", "driver");
 	PRINT_MODULE_USAGE_COMMAND("start");
-	PRINT_MODULE_USAGE_COMMAND("status");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("primary-control", "Set who is in control of gimbal");
 	PRINT_MODULE_USAGE_ARG("<sysid> <compid>", "MAVLink system ID and MAVLink component ID", false);
 	PRINT_MODULE_USAGE_COMMAND_DESCR("test", "Test the output: set a fixed angle for one or multiple axes (gimbal must be running)");
 	PRINT_MODULE_USAGE_ARG("roll|pitch|yaw <angle>", "Specify an axis and an angle in degrees", false);
 	PRINT_MODULE_USAGE_ARG("rollrate|pitchrate|yawrate <angle rate>", "Specify an axis and an angle rate in degrees / second", false);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+
+	return 0;
+}
+
+extern "C" __EXPORT int gimbal_main(int argc, char *argv[])
+{
+	return Gimbal::main(argc, argv);
 }
@@ -57,7 +57,11 @@ public:
 	virtual ~InputBase() = default;
 
 	virtual int initialize() = 0;
-	virtual UpdateResult update(unsigned int timeout_ms, ControlData &control_data, bool already_active) = 0;
+
+	/**
+	 * Process the new input data (the subscriptions schedule the gimbal work item on updates)
+	 */
+	virtual UpdateResult update(ControlData &control_data, bool already_active) = 0;
 	virtual void print_status() const = 0;
 protected:
 	void control_data_set_lon_lat(ControlData &control_data, double lon, double lat, float altitude, uint64_t timestamp);
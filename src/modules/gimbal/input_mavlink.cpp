@@ -48,56 +48,27 @@ using namespace matrix;
 namespace gimbal
 {
 
-InputMavlinkROI::InputMavlinkROI(Parameters &parameters) :
-	InputBase(parameters) {}
-
-InputMavlinkROI::~InputMavlinkROI()
-{
-	if (_vehicle_roi_sub >= 0) {
-		orb_unsubscribe(_vehicle_roi_sub);
-	}
-
-	if (_position_setpoint_triplet_sub >= 0) {
-		orb_unsubscribe(_position_setpoint_triplet_sub);
-	}
-}
+InputMavlinkROI::InputMavlinkROI(Parameters &parameters, px4::WorkItem *work_item) :
+	InputBase(parameters),
+	_vehicle_roi_sub(work_item, ORB_ID(vehicle_roi)),
+	_position_setpoint_triplet_sub(work_item, ORB_ID(position_setpoint_triplet))
+{}
 
 int InputMavlinkROI::initialize()
 {
-	_vehicle_roi_sub = orb_subscribe(ORB_ID(vehicle_roi));
-
-	if (_vehicle_roi_sub < 0) {
-		return -errno;
-	}
-
-	_position_setpoint_triplet_sub = orb_subscribe(ORB_ID(position_setpoint_triplet));
-
-	if (_position_setpoint_triplet_sub < 0) {
-		return -errno;
+	if (!_vehicle_roi_sub.registerCallback() || !_position_setpoint_triplet_sub.registerCallback()) {
+		return PX4_ERROR;
 	}
 
-	return 0;
+	return PX4_OK;
 }
 
 InputMavlinkROI::UpdateResult
-InputMavlinkROI::update(unsigned int timeout_ms, ControlData &control_data, bool already_active)
+InputMavlinkROI::update(ControlData &control_data, bool already_active)
 {
-	const int num_poll = 2;
-	px4_pollfd_struct_t polls[num_poll];
-	polls[0].fd = _vehicle_roi_sub;
-	polls[0].events = POLLIN;
-	polls[1].fd = _position_setpoint_triplet_sub;
-	polls[1].events = POLLIN;
+	vehicle_roi_s vehicle_roi;
 
-	int ret = px4_poll(polls, num_poll, timeout_ms);
-
-	if (ret <= 0) {
-		return UpdateResult::NoUpdate;
-	}
-
-	if (polls[0].revents & POLLIN) {
-		vehicle_roi_s vehicle_roi;
-		orb_copy(ORB_ID(vehicle_roi), _vehicle_roi_sub, &vehicle_roi);
+	if (_vehicle_roi_sub.update(&vehicle_roi)) {
 
 		if (vehicle_roi.mode == vehicle_roi_s::ROI_NONE) {
 
@@ -137,18 +108,14 @@ InputMavlinkROI::update(unsigned int timeout_ms, ControlData &control_data, bool
 		return UpdateResult::NoUpdate;
 	}
 
-	// check whether the position setpoint has been updated
-	if (polls[1].revents & POLLIN) {
-		if (_cur_roi_mode == vehicle_roi_s::ROI_WPNEXT) {
-			_read_control_data_from_position_setpoint_sub(control_data);
+	// check whether the position setpoint has been updated (consume it in every case)
+	position_setpoint_triplet_s position_setpoint_triplet;
 
-			return UpdateResult::UpdatedActive;
+	if (_position_setpoint_triplet_sub.update(&position_setpoint_triplet)
+	    && (_cur_roi_mode == vehicle_roi_s::ROI_WPNEXT)) {
+		_read_control_data_from_position_setpoint_sub(control_data);
 
-		} else { // must do an orb_copy() in *every* case
-			position_setpoint_triplet_s position_setpoint_triplet;
-			orb_copy(ORB_ID(position_setpoint_triplet), _position_setpoint_triplet_sub,
-				 &position_setpoint_triplet);
-		}
+		return UpdateResult::UpdatedActive;
 	}
 
 	return UpdateResult::NoUpdate;
@@ -156,8 +123,8 @@ InputMavlinkROI::update(unsigned int timeout_ms, ControlData &control_data, bool
 
 void InputMavlinkROI::_read_control_data_from_position_setpoint_sub(ControlData &control_data)
 {
-	position_setpoint_triplet_s position_setpoint_triplet;
-	orb_copy(ORB_ID(position_setpoint_triplet), _position_setpoint_triplet_sub, &position_setpoint_triplet);
+	position_setpoint_triplet_s position_setpoint_triplet{};
+	_position_setpoint_triplet_sub.copy(&position_setpoint_triplet);
 	control_data.timestamp_last_update = position_setpoint_triplet.timestamp;
 	control_data.type_data.lonlat.lon = position_setpoint_triplet.current.lon;
 	control_data.type_data.lonlat.lat = position_setpoint_triplet.current.lat;
@@ -169,75 +136,35 @@ void InputMavlinkROI::print_status() const
 	PX4_INFO("Input: Mavlink (ROI)");
 }
 
-InputMavlinkCmdMount::InputMavlinkCmdMount(Parameters &parameters) :
-	InputBase(parameters)
+InputMavlinkCmdMount::InputMavlinkCmdMount(Parameters &parameters, px4::WorkItem *work_item) :
+	InputBase(parameters),
+	_vehicle_command_sub(work_item, ORB_ID(vehicle_command))
 {}
 
-InputMavlinkCmdMount::~InputMavlinkCmdMount()
-{
-	if (_vehicle_command_sub >= 0) {
-		orb_unsubscribe(_vehicle_command_sub);
-	}
-}
-
 int InputMavlinkCmdMount::initialize()
 {
-	if ((_vehicle_command_sub = orb_subscribe(ORB_ID(vehicle_command))) < 0) {
-		return -errno;
+	if (!_vehicle_command_sub.registerCallback()) {
+		return PX4_ERROR;
 	}
 
-	// rate-limit inputs to 100Hz. If we don't do this and the output is configured to mavlink mode,
-	// it will publish vehicle_command's as well, causing the input poll() in here to return
-	// immediately, which in turn will cause an output update and thus a busy loop.
-	orb_set_interval(_vehicle_command_sub, 10);
-
-	return 0;
+	return PX4_OK;
 }
 
 
 InputMavlinkCmdMount::UpdateResult
-InputMavlinkCmdMount::update(unsigned int timeout_ms, ControlData &control_data, bool already_active)
+InputMavlinkCmdMount::update(ControlData &control_data, bool already_active)
 {
-	const int num_poll = 1;
-	px4_pollfd_struct_t polls[num_poll];
-	polls[0].fd = _vehicle_command_sub;
-	polls[0].events = POLLIN;
-
-	int poll_timeout = (int) timeout_ms;
-
-	const hrt_abstime poll_start = hrt_absolute_time();
-
-	// If we get a command that we need to handle we exit the loop, otherwise we poll until we
-	// reach the timeout.
-	// We can't return early instead because we need to copy all topics that triggered poll.
-
-	bool exit_loop = false;
 	UpdateResult update_result = UpdateResult::NoUpdate;
 
-	while (!exit_loop && poll_timeout >= 0) {
+	// handle all queued commands, the last one that concerns us wins
+	vehicle_command_s vehicle_command;
 
-		const int ret = px4_poll(polls, num_poll, poll_timeout);
+	while (_vehicle_command_sub.update(&vehicle_command)) {
+		const UpdateResult result = _process_command(control_data, vehicle_command);
 
-		if (ret <= 0) {
-			// Error, or timeout, give up.
-			exit_loop = true;
+		if (result != UpdateResult::NoUpdate) {
+			update_result = result;
 		}
-
-		if (polls[0].revents & POLLIN) {
-
-			vehicle_command_s vehicle_command;
-			orb_copy(ORB_ID(vehicle_command), _vehicle_command_sub, &vehicle_command);
-
-			update_result = _process_command(control_data, vehicle_command);
-
-		}
-
-		if (update_result != UpdateResult::NoUpdate) {
-			exit_loop = true;
-		}
-
-		// Keep going reading commands until timeout is up.
-		poll_timeout = timeout_ms - (hrt_absolute_time() - poll_start) / 1000;
 	}
 
 	return update_result;
@@ -384,35 +311,16 @@ void InputMavlinkCmdMount::print_status() const
 	PX4_INFO("Input: Mavlink (CMD_MOUNT)");
 }
 
-InputMavlinkGimbalV2::InputMavlinkGimbalV2(Parameters &parameters) :
-	InputBase(parameters)
+InputMavlinkGimbalV2::InputMavlinkGimbalV2(Parameters &parameters, px4::WorkItem *work_item) :
+	InputBase(parameters),
+	_vehicle_roi_sub(work_item, ORB_ID(vehicle_roi)),
+	_gimbal_manager_set_attitude_sub(work_item, ORB_ID(gimbal_manager_set_attitude)),
+	_gimbal_manager_set_manual_control_sub(work_item, ORB_ID(gimbal_manager_set_manual_control)),
+	_position_setpoint_triplet_sub(work_item, ORB_ID(position_setpoint_triplet)),
+	_vehicle_command_sub(work_item, ORB_ID(vehicle_command))
 {
 }
 
-InputMavlinkGimbalV2::~InputMavlinkGimbalV2()
-{
-	if (_vehicle_roi_sub >= 0) {
-		orb_unsubscribe(_vehicle_roi_sub);
-	}
-
-	if (_position_setpoint_triplet_sub >= 0) {
-		orb_unsubscribe(_position_setpoint_triplet_sub);
-	}
-
-	if (_gimbal_manager_set_attitude_sub >= 0) {
-		orb_unsubscribe(_gimbal_manager_set_attitude_sub);
-	}
-
-	if (_vehicle_command_sub >= 0) {
-		orb_unsubscribe(_vehicle_command_sub);
-	}
-
-	if (_gimbal_manager_set_manual_control_sub >= 0) {
-		orb_unsubscribe(_gimbal_manager_set_manual_control_sub);
-	}
-}
-
-
 void InputMavlinkGimbalV2::print_status() const
 {
 	PX4_INFO("Input: Mavlink (Gimbal V2)");
@@ -420,38 +328,15 @@ void InputMavlinkGimbalV2::print_status() const
 
 int InputMavlinkGimbalV2::initialize()
 {
-	_vehicle_roi_sub = orb_subscribe(ORB_ID(vehicle_roi));
-
-	if (_vehicle_roi_sub < 0) {
-		return -errno;
+	if (!_vehicle_roi_sub.registerCallback()
+	    || !_position_setpoint_triplet_sub.registerCallback()
+	    || !_gimbal_manager_set_attitude_sub.registerCallback()
+	    || !_vehicle_command_sub.registerCallback()
+	    || !_gimbal_manager_set_manual_control_sub.registerCallback()) {
+		return PX4_ERROR;
 	}
 
-	_position_setpoint_triplet_sub = orb_subscribe(ORB_ID(position_setpoint_triplet));
-
-	if (_position_setpoint_triplet_sub < 0) {
-		return -errno;
-	}
-
-	_gimbal_manager_set_attitude_sub = orb_subscribe(ORB_ID(gimbal_manager_set_attitude));
-
-	if (_gimbal_manager_set_attitude_sub < 0) {
-		return -errno;
-	}
-
-	if ((_vehicle_command_sub = orb_subscribe(ORB_ID(vehicle_command))) < 0) {
-		return -errno;
-	}
-
-	if ((_gimbal_manager_set_manual_control_sub = orb_subscribe(ORB_ID(gimbal_manager_set_manual_control))) < 0) {
-		return -errno;
-	}
-
-	// rate-limit inputs to 100Hz. If we don't do this and the output is configured to mavlink mode,
-	// it will publish vehicle_command's as well, causing the input poll() in here to return
-	// immediately, which in turn will cause an output update and thus a busy loop.
-	orb_set_interval(_vehicle_command_sub, 10);
-
-	return 0;
+	return PX4_OK;
 }
 
 void InputMavlinkGimbalV2::_stream_gimbal_manager_status(const ControlData &control_data)
@@ -521,93 +406,51 @@ void InputMavlinkGimbalV2::_stream_gimbal_manager_information(const ControlData
 }
 
 InputMavlinkGimbalV2::UpdateResult
-InputMavlinkGimbalV2::update(unsigned int timeout_ms, ControlData &control_data, bool already_active)
+InputMavlinkGimbalV2::update(ControlData &control_data, bool already_active)
 {
-
-	const int num_poll = 5;
-	px4_pollfd_struct_t polls[num_poll];
-	polls[0].fd = _gimbal_manager_set_attitude_sub;
-	polls[0].events = POLLIN;
-	polls[1].fd = _vehicle_roi_sub;
-	polls[1].events = POLLIN;
-	polls[2].fd = _position_setpoint_triplet_sub;
-	polls[2].events = POLLIN;
-	polls[3].fd = _vehicle_command_sub;
-	polls[3].events = POLLIN;
-	polls[4].fd = _gimbal_manager_set_manual_control_sub;
-	polls[4].events = POLLIN;
-
-	int poll_timeout = (int) timeout_ms;
-
-	hrt_abstime poll_start = hrt_absolute_time();
-
-	// If we get a command that we need to handle we exit the loop, otherwise we poll until we
-	// reach the timeout.
-	// We can't return early instead because we need to copy all topics that triggered poll.
-
-	bool exit_loop = false;
 	UpdateResult update_result = UpdateResult::NoUpdate;
 
-	while (!exit_loop && poll_timeout >= 0) {
+	gimbal_manager_set_attitude_s set_attitude;
 
-		const int ret = px4_poll(polls, num_poll, poll_timeout);
+	while (_gimbal_manager_set_attitude_sub.update(&set_attitude)) {
+		update_result = _process_set_attitude(control_data, set_attitude);
+	}
 
-		if (ret <= 0) {
-			// Error, or timeout, give up.
-			exit_loop = true;
-		}
+	vehicle_roi_s vehicle_roi;
 
-		if (polls[0].revents & POLLIN) {
-			gimbal_manager_set_attitude_s set_attitude;
-			orb_copy(ORB_ID(gimbal_manager_set_attitude), _gimbal_manager_set_attitude_sub, &set_attitude);
+	if (_vehicle_roi_sub.update(&vehicle_roi)) {
+		UpdateResult new_result = _process_vehicle_roi(control_data, vehicle_roi);
 
-			update_result = _process_set_attitude(control_data, set_attitude);
-		}
-
-		if (polls[1].revents & POLLIN) {
-			vehicle_roi_s vehicle_roi;
-			orb_copy(ORB_ID(vehicle_roi), _vehicle_roi_sub, &vehicle_roi);
-
-			UpdateResult new_result = _process_vehicle_roi(control_data, vehicle_roi);
-
-			if (new_result != UpdateResult::NoUpdate) {
-				update_result = new_result;
-			}
+		if (new_result != UpdateResult::NoUpdate) {
+			update_result = new_result;
 		}
+	}
 
-		// check whether the position setpoint got updated
-		if (polls[2].revents & POLLIN) {
-			position_setpoint_triplet_s position_setpoint_triplet;
-			orb_copy(ORB_ID(position_setpoint_triplet), _position_setpoint_triplet_sub,
-				 &position_setpoint_triplet);
+	// check whether the position setpoint got updated
+	position_setpoint_triplet_s position_setpoint_triplet;
 
-			UpdateResult new_result = _process_position_setpoint_triplet(control_data, position_setpoint_triplet);
+	if (_position_setpoint_triplet_sub.update(&position_setpoint_triplet)) {
+		UpdateResult new_result = _process_position_setpoint_triplet(control_data, position_setpoint_triplet);
 
-			if (new_result != UpdateResult::NoUpdate) {
-				update_result = new_result;
-			}
+		if (new_result != UpdateResult::NoUpdate) {
+			update_result = new_result;
 		}
+	}
 
-		if (polls[3].revents & POLLIN) {
-			vehicle_command_s vehicle_command;
-			orb_copy(ORB_ID(vehicle_command), _vehicle_command_sub, &vehicle_command);
+	vehicle_command_s vehicle_command;
 
-			UpdateResult new_result = _process_command(control_data, vehicle_command);
+	while (_vehicle_command_sub.update(&vehicle_command)) {
+		UpdateResult new_result = _process_command(control_data, vehicle_command);
 
-			if (new_result != UpdateResult::NoUpdate) {
-				update_result = new_result;
-			}
+		if (new_result != UpdateResult::NoUpdate) {
+			update_result = new_result;
 		}
+	}
 
-		if (polls[4].revents & POLLIN) {
-			gimbal_manager_set_manual_control_s set_manual_control;
-			orb_copy(ORB_ID(gimbal_manager_set_manual_control), _gimbal_manager_set_manual_control_sub,
-				 &set_manual_control);
+	gimbal_manager_set_manual_control_s set_manual_control;
 
-			update_result = _process_set_manual_control(control_data, set_manual_control);
-		}
-
-		poll_timeout = timeout_ms - (hrt_absolute_time() - poll_start) / 1000;
+	while (_gimbal_manager_set_manual_control_sub.update(&set_manual_control)) {
+		update_result = _process_set_manual_control(control_data, set_manual_control);
 	}
 
 	_stream_gimbal_manager_status(control_data);
@@ -1014,8 +857,8 @@ void InputMavlinkGimbalV2::_ack_vehicle_command(const vehicle_command_s &cmd, ui
 
 void InputMavlinkGimbalV2::_read_control_data_from_position_setpoint_sub(ControlData &control_data)
 {
-	position_setpoint_triplet_s position_setpoint_triplet;
-	orb_copy(ORB_ID(position_setpoint_triplet), _position_setpoint_triplet_sub, &position_setpoint_triplet);
+	position_setpoint_triplet_s position_setpoint_triplet{};
+	_position_setpoint_triplet_sub.copy(&position_setpoint_triplet);
 	control_data.timestamp_last_update = position_setpoint_triplet.timestamp;
 	control_data.type_data.lonlat.lon = position_setpoint_triplet.current.lon;
 	control_data.type_data.lonlat.lat = position_setpoint_triplet.current.lat;
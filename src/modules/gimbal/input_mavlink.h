@@ -39,7 +39,9 @@
 #include <cstdint>
 
 #include <uORB/Publication.hpp>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/gimbal_device_attitude_status.h>
 #include <uORB/topics/gimbal_device_information.h>
 #include <uORB/topics/gimbal_manager_information.h>
@@ -59,18 +61,18 @@ class InputMavlinkROI : public InputBase
 {
 public:
 	InputMavlinkROI() = delete;
-	explicit InputMavlinkROI(Parameters &parameters);
-	virtual ~InputMavlinkROI();
+	InputMavlinkROI(Parameters &parameters, px4::WorkItem *work_item);
+	virtual ~InputMavlinkROI() = default;
 
 	void print_status() const override;
-	UpdateResult update(unsigned int timeout_ms, ControlData &control_data, bool already_active) override;
+	UpdateResult update(ControlData &control_data, bool already_active) override;
 	int initialize() override;
 
 private:
 	void _read_control_data_from_position_setpoint_sub(ControlData &control_data);
 
-	int _vehicle_roi_sub = -1;
-	int _position_setpoint_triplet_sub = -1;
+	uORB::SubscriptionCallbackWorkItem _vehicle_roi_sub;
+	uORB::SubscriptionCallbackWorkItem _position_setpoint_triplet_sub;
 	uint8_t _cur_roi_mode {vehicle_roi_s::ROI_NONE};
 };
 
@@ -79,28 +81,28 @@ class InputMavlinkCmdMount : public InputBase
 {
 public:
 	InputMavlinkCmdMount() = delete;
-	explicit InputMavlinkCmdMount(Parameters &parameters);
-	virtual ~InputMavlinkCmdMount();
+	InputMavlinkCmdMount(Parameters &parameters, px4::WorkItem *work_item);
+	virtual ~InputMavlinkCmdMount() = default;
 
 	void print_status() const override;
-	UpdateResult update(unsigned int timeout_ms, ControlData &control_data, bool already_active) override;
+	UpdateResult update(ControlData &control_data, bool already_active) override;
 	int initialize() override;
 
 private:
 	UpdateResult _process_command(ControlData &control_data, const vehicle_command_s &vehicle_command);
 	void _ack_vehicle_command(const vehicle_command_s &cmd);
 
-	int _vehicle_command_sub = -1;
+	uORB::SubscriptionCallbackWorkItem _vehicle_command_sub;
 };
 
 class InputMavlinkGimbalV2 : public InputBase
 {
 public:
 	InputMavlinkGimbalV2() = delete;
-	explicit InputMavlinkGimbalV2(Parameters &parameters);
-	virtual ~InputMavlinkGimbalV2();
+	InputMavlinkGimbalV2(Parameters &parameters, px4::WorkItem *work_item);
+	virtual ~InputMavlinkGimbalV2() = default;
 
-	UpdateResult update(unsigned int timeout_ms, ControlData &control_data, bool already_active) override;
+	UpdateResult update(ControlData &control_data, bool already_active) override;
 	int initialize() override;
 	void print_status() const override;
 
@@ -119,11 +121,11 @@ private:
 	void _stream_gimbal_manager_status(const ControlData &control_data);
 	void _read_control_data_from_position_setpoint_sub(ControlData &control_data);
 
-	int _vehicle_roi_sub = -1;
-	int _gimbal_manager_set_attitude_sub = -1;
-	int _gimbal_manager_set_manual_control_sub = -1;
-	int _position_setpoint_triplet_sub = -1;
-	int _vehicle_command_sub = -1;
+	uORB::SubscriptionCallbackWorkItem _vehicle_roi_sub;
+	uORB::SubscriptionCallbackWorkItem _gimbal_manager_set_attitude_sub;
+	uORB::SubscriptionCallbackWorkItem _gimbal_manager_set_manual_control_sub;
+	uORB::SubscriptionCallbackWorkItem _position_setpoint_triplet_sub;
+	uORB::SubscriptionCallbackWorkItem _vehicle_command_sub;
 
 	uORB::Subscription _gimbal_device_attitude_status_sub{ORB_ID(gimbal_device_attitude_status)};
 	uORB::Subscription _gimbal_device_information_sub{ORB_ID(gimbal_device_information)};
@@ -45,59 +45,40 @@
 namespace gimbal
 {
 
-InputRC::InputRC(Parameters &parameters) :
-	InputBase(parameters)
+InputRC::InputRC(Parameters &parameters, px4::WorkItem *work_item) :
+	InputBase(parameters),
+	_manual_control_setpoint_sub(work_item, ORB_ID(manual_control_setpoint))
 {}
 
-InputRC::~InputRC()
-{
-	if (_manual_control_setpoint_sub >= 0) {
-		orb_unsubscribe(_manual_control_setpoint_sub);
-	}
-}
-
 int InputRC::initialize()
 {
-	_manual_control_setpoint_sub = orb_subscribe(ORB_ID(manual_control_setpoint));
-
-	if (_manual_control_setpoint_sub < 0) {
-		return -errno;
+	if (!_manual_control_setpoint_sub.registerCallback()) {
+		return PX4_ERROR;
 	}
 
-	return 0;
+	return PX4_OK;
 }
 
-InputRC::UpdateResult InputRC::update(unsigned int timeout_ms, ControlData &control_data, bool already_active)
+InputRC::UpdateResult InputRC::update(ControlData &control_data, bool already_active)
 {
-	px4_pollfd_struct_t polls[1];
-	polls[0].fd = 		_manual_control_setpoint_sub;
-	polls[0].events = 	POLLIN;
-
-	int ret = px4_poll(polls, 1, timeout_ms);
+	manual_control_setpoint_s manual_control_setpoint;
 
-	if (ret < 0) {
-		return UpdateResult::NoUpdate;
+	if (_manual_control_setpoint_sub.update(&manual_control_setpoint)) {
+		return _read_control_data_from_subscription(control_data, manual_control_setpoint, already_active);
 	}
 
-	if (ret == 0) {
-		// If we have been active before, we stay active, unless someone steals
-		// the control away.
-		if (already_active) {
-			return UpdateResult::UpdatedActive;
-		}
-	}
-
-	if (polls[0].revents & POLLIN) {
-		return _read_control_data_from_subscription(control_data, already_active);
+	// If we have been active before, we stay active, unless someone steals
+	// the control away.
+	if (already_active) {
+		return UpdateResult::UpdatedActive;
 	}
 
 	return UpdateResult::NoUpdate;
 }
 
-InputRC::UpdateResult InputRC::_read_control_data_from_subscription(ControlData &control_data, bool already_active)
+InputRC::UpdateResult InputRC::_read_control_data_from_subscription(ControlData &control_data,
+		const manual_control_setpoint_s &manual_control_setpoint, bool already_active)
 {
-	manual_control_setpoint_s manual_control_setpoint{};
-	orb_copy(ORB_ID(manual_control_setpoint), _manual_control_setpoint_sub, &manual_control_setpoint);
 	control_data.type = ControlData::Type::Angle;
 	control_data.timestamp_last_update = manual_control_setpoint.timestamp;
 
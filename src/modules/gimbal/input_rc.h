@@ -36,6 +36,8 @@
 
 #include "input.h"
 #include "gimbal_params.h"
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/manual_control_setpoint.h>
 
 namespace gimbal
@@ -45,21 +47,22 @@ class InputRC : public InputBase
 {
 public:
 	InputRC() = delete;
-	explicit InputRC(Parameters &parameters);
+	InputRC(Parameters &parameters, px4::WorkItem *work_item);
 
-	virtual ~InputRC();
+	virtual ~InputRC() = default;
 
 	virtual void print_status() const;
 
-	virtual UpdateResult update(unsigned int timeout_ms, ControlData &control_data, bool already_active);
+	virtual UpdateResult update(ControlData &control_data, bool already_active);
 
 	virtual int initialize();
 
 private:
-	virtual UpdateResult _read_control_data_from_subscription(ControlData &control_data, bool already_active);
+	virtual UpdateResult _read_control_data_from_subscription(ControlData &control_data,
+			const manual_control_setpoint_s &manual_control_setpoint, bool already_active);
 	float _get_aux_value(const manual_control_setpoint_s &manual_control_setpoint, int channel_idx);
 
-	int _manual_control_setpoint_sub{-1};
+	uORB::SubscriptionCallbackWorkItem _manual_control_setpoint_sub;
 
 	float _last_set_aux_values[3] {};
 };
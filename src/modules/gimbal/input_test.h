@@ -46,7 +46,7 @@ public:
 	explicit InputTest(Parameters &parameters);
 	virtual ~InputTest() = default;
 
-	UpdateResult update(unsigned int timeout_ms, ControlData &control_data, bool already_active) override;
+	UpdateResult update(ControlData &control_data, bool already_active) override;
 	int initialize() override;
 	void print_status() const override;
 
@@ -104,6 +104,22 @@ bool OutputBase::check_and_handle_setpoint_timeout(ControlData &control_data, co
 	return ret;
 }
 
+bool OutputBase::requires_periodic_update(const ControlData &control_data) const
+{
+	if (control_data.type == ControlData::Type::LonLat) {
+		return true;
+	}
+
+	for (int i = 0; i < 3; ++i) {
+		if ((_stabilize[i] && _absolute_angle[i])
+		    || (PX4_ISFINITE(_angle_velocity[i]) && (fabsf(_angle_velocity[i]) > FLT_EPSILON))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void OutputBase::_set_angle_setpoints(const ControlData &control_data)
 {
 	switch (control_data.type) {
@@ -71,6 +71,13 @@ public:
 	 */
 	bool check_and_handle_setpoint_timeout(ControlData &control_data, const hrt_abstime &now);
 
+	/**
+	 * Whether the output changes without new input data and therefore needs regular updates:
+	 * stabilization, tracking a location or integrating angular rates.
+	 * @param control_data current setpoint
+	 */
+	bool requires_periodic_update(const ControlData &control_data) const;
+
 protected:
 	float _calculate_pitch(double lon, double lat, float altitude,
 			       const vehicle_global_position_s &global_position);
@@ -67,12 +67,19 @@ GyroFFT::~GyroFFT()
 	delete[] _fft_input_buffer;
 	delete[] _fft_outupt_buffer;
 	delete[] _peak_magnitudes_all;
+	delete[] _sdft_bins_x;
+	delete[] _sdft_bins_y;
+	delete[] _sdft_bins_z;
+	delete[] _sdft_twiddle;
+	delete[] _sdft_spectrum;
 }
 
 bool GyroFFT::init()
 {
 	bool buffers_allocated = false;
 
+	_sliding_dft = (_param_imu_gyro_fft_mod.get() == 1);
+
 	// arm_rfft_init_q15(&_rfft_q15, _imu_gyro_fft_len, 0, 1) manually inlined to save flash
 	_rfft_q15.pTwiddleAReal = (q15_t *) realCoefAQ15;
 	_rfft_q15.pTwiddleBReal = (q15_t *) realCoefBQ15;
@@ -141,12 +148,25 @@ bool GyroFFT::init()
 	if (buffers_allocated) {
 		_imu_gyro_fft_len = _param_imu_gyro_fft_len.get();
 
-		// init Hanning window
-		for (int n = 0; n < _imu_gyro_fft_len; n++) {
-			const float hanning_value = 0.5f * (1.f - cosf(2.f * M_PI_F * n / (_imu_gyro_fft_len - 1)));
-			arm_float_to_q15(&hanning_value, &_hanning_window[n], 1);
+		if (_sliding_dft) {
+			// init twiddle factors e^(j 2 pi k / N) for bins 0...N/2
+			for (int k = 0; k <= _imu_gyro_fft_len / 2; k++) {
+				_sdft_twiddle[2 * k]     = cosf(2.f * M_PI_F * k / _imu_gyro_fft_len);
+				_sdft_twiddle[2 * k + 1] = sinf(2.f * M_PI_F * k / _imu_gyro_fft_len);
+			}
+
+			_sdft_damping_n = powf(SDFT_DAMPING, _imu_gyro_fft_len);
+
+		} else {
+			// init Hanning window
+			for (int n = 0; n < _imu_gyro_fft_len; n++) {
+				const float hanning_value = 0.5f * (1.f - cosf(2.f * M_PI_F * n / (_imu_gyro_fft_len - 1)));
+				arm_float_to_q15(&hanning_value, &_hanning_window[n], 1);
+			}
 		}
 
+		UpdateFrequencyBand();
+
 		if (!SensorSelectionUpdate(true)) {
 			ScheduleDelayed(500_ms);
 		}
@@ -249,12 +269,50 @@ void GyroFFT::VehicleIMUStatusUpdate(bool force)
 					_gyro_sample_rate_hz = vehicle_imu_status.gyro_rate_hz;
 				}
 
+				UpdateFrequencyBand();
 				return;
 			}
 		}
 	}
 }
 
+void GyroFFT::UpdateFrequencyBand()
+{
+	// bins within [IMU_GYRO_FFT_MIN, IMU_GYRO_FFT_MAX], leaving room for the peak estimate (+-1 bin)
+	// and the sliding DFT frequency domain windowing (+-1 bin)
+	const float resolution_hz = _gyro_sample_rate_hz / _imu_gyro_fft_len;
+	const int bin_limit = _imu_gyro_fft_len / 2 - 2;
+
+	const int bin_min = math::constrain((int)ceilf(_param_imu_gyro_fft_min.get() / resolution_hz), 2, bin_limit);
+	const int bin_max = math::constrain((int)floorf(_param_imu_gyro_fft_max.get() / resolution_hz), bin_min, bin_limit);
+
+	if ((bin_min != _bin_min) || (bin_max != _bin_max)) {
+		_bin_min = bin_min;
+		_bin_max = bin_max;
+
+		// sliding DFT only tracks the bins of the band
+		if (_sliding_dft) {
+			ResetBuffers();
+		}
+	}
+}
+
+void GyroFFT::ResetBuffers()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		_fft_buffer_index[axis] = 0;
+	}
+
+	if (_sliding_dft) {
+		float *sdft_bins[] {_sdft_bins_x, _sdft_bins_y, _sdft_bins_z};
+
+		for (int axis = 0; axis < 3; axis++) {
+			memset(sdft_bins[axis], 0, sizeof(float) * (_imu_gyro_fft_len + 2));
+			_sdft_sample_count[axis] = 0;
+		}
+	}
+}
+
 // helper function used for frequency estimation
 static inline float tau(float x)
 {
@@ -266,7 +324,8 @@ static inline float tau(float x)
 	return (0.25f * p1 - sqrtf(6.f) / 24.f * p2);
 }
 
-float GyroFFT::EstimatePeakFrequencyBin(q15_t fft[], int peak_index)
+template<typename T>
+float GyroFFT::EstimatePeakFrequencyBin(const T fft[], int peak_index)
 {
 	if (peak_index >= 2) {
 		// find peak location using Quinn's Second Estimator (2020-06-14: http://dspguru.com/dsp/howtos/how-to-interpolate-fft-peak/)
@@ -321,6 +380,7 @@ void GyroFFT::Run()
 		_parameter_update_sub.copy(&param_update);
 
 		updateParams();
+		UpdateFrequencyBand();
 	}
 
 	const bool selection_updated = SensorSelectionUpdate();
@@ -336,9 +396,7 @@ void GyroFFT::Run()
 		while (_sensor_gyro_fifo_sub.update(&sensor_gyro_fifo)) {
 			if (_sensor_gyro_fifo_sub.get_last_generation() != _gyro_last_generation + 1) {
 				// force reset if we've missed a sample
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				ResetBuffers();
 
 				perf_count(_gyro_fifo_generation_gap_perf);
 			}
@@ -347,9 +405,7 @@ void GyroFFT::Run()
 
 			if (fabsf(sensor_gyro_fifo.scale - _fifo_last_scale) > FLT_EPSILON) {
 				// force reset if scale has changed
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				ResetBuffers();
 
 				_fifo_last_scale = sensor_gyro_fifo.scale;
 			}
@@ -365,9 +421,7 @@ void GyroFFT::Run()
 		while (_sensor_gyro_sub.update(&sensor_gyro)) {
 			if (_sensor_gyro_sub.get_last_generation() != _gyro_last_generation + 1) {
 				// force reset if we've missed a sample
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				ResetBuffers();
 
 				perf_count(_gyro_generation_gap_perf);
 			}
@@ -394,6 +448,11 @@ void GyroFFT::Run()
 
 void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N)
 {
+	if (_sliding_dft) {
+		UpdateSlidingDFT(timestamp_sample, input, N);
+		return;
+	}
+
 	q15_t *gyro_data_buffer[] {_gyro_data_buffer_x, _gyro_data_buffer_y, _gyro_data_buffer_z};
 
 	for (int axis = 0; axis < 3; axis++) {
@@ -415,7 +474,7 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 
 				_fft_updated = true;
 
-				FindPeaks(timestamp_sample, axis, _fft_outupt_buffer);
+				FindPeaks(timestamp_sample, axis, _fft_outupt_buffer, 0, _imu_gyro_fft_len / 2 - 1, _imu_gyro_fft_len - 1);
 
 				// reset
 				// shift buffer (3/4 overlap)
@@ -429,29 +488,106 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 	}
 }
 
-void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *fft_outupt_buffer)
+void GyroFFT::UpdateSlidingDFT(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N)
+{
+	perf_begin(_fft_perf);
+
+	q15_t *gyro_data_buffer[] {_gyro_data_buffer_x, _gyro_data_buffer_y, _gyro_data_buffer_z};
+	float *sdft_bins[] {_sdft_bins_x, _sdft_bins_y, _sdft_bins_z};
+
+	// raw bins needed for the Hanning windowed bins [_bin_min - 1, _bin_max + 1]
+	const int k_first = _bin_min - 2;
+	const int k_last = _bin_max + 2;
+
+	for (int axis = 0; axis < 3; axis++) {
+		int &buffer_index = _fft_buffer_index[axis];
+		float *bins = sdft_bins[axis];
+
+		for (int n = 0; n < N; n++) {
+			// convert int16_t -> q15_t (scaling isn't relevant)
+			const q15_t sample = input[axis][n] / 2;
+
+			// sample leaving the window (buffer is circular, zero until filled)
+			float sample_oldest = 0.f;
+
+			if (_sdft_sample_count[axis] >= _imu_gyro_fft_len) {
+				sample_oldest = _sdft_damping_n * gyro_data_buffer[axis][buffer_index];
+
+			} else {
+				_sdft_sample_count[axis]++;
+			}
+
+			gyro_data_buffer[axis][buffer_index] = sample;
+			buffer_index = (buffer_index + 1 < _imu_gyro_fft_len) ? buffer_index + 1 : 0;
+
+			// X_k = e^(j 2 pi k / N) * (r * X_k + x[n] - r^N * x[n - N])
+			const float delta = sample - sample_oldest;
+
+			for (int k = k_first; k <= k_last; k++) {
+				const float real = SDFT_DAMPING * bins[2 * k] + delta;
+				const float imag = SDFT_DAMPING * bins[2 * k + 1];
+
+				bins[2 * k]     = real * _sdft_twiddle[2 * k] - imag * _sdft_twiddle[2 * k + 1];
+				bins[2 * k + 1] = real * _sdft_twiddle[2 * k + 1] + imag * _sdft_twiddle[2 * k];
+			}
+		}
+	}
+
+	perf_end(_fft_perf);
+
+	// peak search on one axis per cycle (round robin)
+	if (!_fft_updated) {
+		for (int i = 0; i < 3; i++) {
+			const int axis = (_sdft_axis_next + i) % 3;
+
+			if (_sdft_sample_count[axis] >= _imu_gyro_fft_len) {
+				const float *bins = sdft_bins[axis];
+
+				// apply Hanning window in the frequency domain: Y_k = 0.5 X_k - 0.25 (X_k-1 + X_k+1)
+				const int bin_first = _bin_min - 1;
+				const int bin_last = _bin_max + 1;
+
+				for (int k = bin_first; k <= bin_last; k++) {
+					const int i_spectrum = 2 * (k - bin_first);
+					_sdft_spectrum[i_spectrum]     = 0.5f * bins[2 * k]     - 0.25f * (bins[2 * (k - 1)]     + bins[2 * (k + 1)]);
+					_sdft_spectrum[i_spectrum + 1] = 0.5f * bins[2 * k + 1] - 0.25f * (bins[2 * (k - 1) + 1] + bins[2 * (k + 1) + 1]);
+				}
+
+				// same SNR scaling as the full FFT (2 * number of bins - 1)
+				const int num_bins = bin_last - bin_first + 1;
+				FindPeaks(timestamp_sample, axis, _sdft_spectrum, bin_first, bin_last, 2 * num_bins - 1);
+
+				_fft_updated = true;
+				_sdft_axis_next = (axis + 1) % 3;
+				break;
+			}
+		}
+	}
+}
+
+template<typename T>
+void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, const T *spectrum, int bin_first, int bin_last,
+			float snr_scale)
 {
 	const float resolution_hz = _gyro_sample_rate_hz / _imu_gyro_fft_len;
 
 	// sum total energy across all used buckets for SNR
 	float bin_mag_sum = 0;
 
-	// FFT output buffer is ordered [real[0], imag[0], real[1], imag[1], real[2], imag[2] ... real[(N/2)-1], imag[(N/2)-1]
-	for (uint16_t fft_index = 2; fft_index < _imu_gyro_fft_len; fft_index += 2) {
+	// spectrum buffer is ordered [real[0], imag[0], real[1], imag[1], real[2], imag[2] ...
+	for (int bin_index = math::max(bin_first, 1); bin_index <= bin_last; bin_index++) {
 
-		const float real = fft_outupt_buffer[fft_index];
-		const float imag = fft_outupt_buffer[fft_index + 1];
+		const float real = spectrum[2 * (bin_index - bin_first)];
+		const float imag = spectrum[2 * (bin_index - bin_first) + 1];
 
 		const float fft_magnitude = sqrtf(real * real + imag * imag);
 
-		int bin_index = fft_index / 2;
-
 		_peak_magnitudes_all[bin_index] = fft_magnitude;
 		bin_mag_sum += fft_magnitude;
 	}
 
 
-	// find raw peaks
+	// find raw peaks within the configured band
 	uint16_t raw_peak_index[MAX_NUM_PEAKS] {};
 	float peak_magnitude[MAX_NUM_PEAKS] {};
 
@@ -460,14 +596,8 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 		float largest_peak = 0;
 		int largest_peak_index = 0;
 
-		for (int bin_index = 1; bin_index < _imu_gyro_fft_len; bin_index++) {
-
-			const float freq_hz = bin_index * resolution_hz;
-
-			if ((_peak_magnitudes_all[bin_index] > largest_peak)
-			    && (freq_hz >= _param_imu_gyro_fft_min.get())
-			    && (freq_hz <= _param_imu_gyro_fft_max.get())) {
-
+		for (int bin_index = _bin_min; bin_index <= _bin_max; bin_index++) {
+			if (_peak_magnitudes_all[bin_index] > largest_peak) {
 				largest_peak = _peak_magnitudes_all[bin_index];
 				largest_peak_index = bin_index;
 			}
@@ -504,12 +634,13 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 	for (int peak_new = 0; peak_new < MAX_NUM_PEAKS; peak_new++) {
 		if (raw_peak_index[peak_new] > 0) {
 
-			const float adjusted_bin = 0.5f * EstimatePeakFrequencyBin(fft_outupt_buffer, 2 * raw_peak_index[peak_new]);
+			const float adjusted_bin = bin_first + 0.5f * EstimatePeakFrequencyBin(spectrum,
+						   2 * (raw_peak_index[peak_new] - bin_first));
 
 			if (PX4_ISFINITE(adjusted_bin)) {
 				const float freq_adjusted = resolution_hz * adjusted_bin;
 
-				const float snr = 10.f * log10f((_imu_gyro_fft_len - 1) * peak_magnitude[peak_new] /
+				const float snr = 10.f * log10f(snr_scale * peak_magnitude[peak_new] /
 								(bin_mag_sum - peak_magnitude[peak_new]));
 
 				if (PX4_ISFINITE(freq_adjusted)
@@ -703,6 +834,8 @@ int GyroFFT::task_spawn(int argc, char *argv[])
 int GyroFFT::print_status()
 {
 	PX4_INFO("gyro sample rate: %.3f Hz", (double)_gyro_sample_rate_hz);
+	PX4_INFO("%s, length: %" PRId32 ", bins: %d - %d", _sliding_dft ? "sliding DFT" : "FFT", _imu_gyro_fft_len,
+		 _bin_min, _bin_max);
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_cycle_interval_perf);
 	perf_print_counter(_fft_perf);
@@ -84,12 +84,24 @@ private:
 	static constexpr int MAX_NUM_PEAKS = sizeof(sensor_gyro_fft_s::peak_frequencies_x) / sizeof(
 			sensor_gyro_fft_s::peak_frequencies_x[0]);
 
+	// sliding DFT damping factor (r) to keep the recursive bin updates numerically stable
+	static constexpr float SDFT_DAMPING = 0.99999f;
+
 	void Run() override;
-	inline void FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *fft_outupt_buffer);
-	inline float EstimatePeakFrequencyBin(q15_t fft[], int peak_index);
+
+	// spectrum is interleaved [real, imag] starting at bin_first, peaks are searched within [_bin_min, _bin_max]
+	template<typename T>
+	inline void FindPeaks(const hrt_abstime &timestamp_sample, int axis, const T *spectrum, int bin_first, int bin_last,
+			      float snr_scale);
+	template<typename T>
+	inline float EstimatePeakFrequencyBin(const T fft[], int peak_index);
+
 	inline void Publish();
+	void ResetBuffers();
 	bool SensorSelectionUpdate(bool force = false);
 	void Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N);
+	void UpdateFrequencyBand();
+	void UpdateSlidingDFT(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N);
 	inline void UpdateOutput(const hrt_abstime &timestamp_sample, int axis, float peak_frequencies[MAX_NUM_PEAKS],
 				 float peak_snr[MAX_NUM_PEAKS], int num_peaks_found);
 	void VehicleIMUStatusUpdate(bool force = false);
@@ -100,13 +112,30 @@ private:
 		_gyro_data_buffer_x = new q15_t[N];
 		_gyro_data_buffer_y = new q15_t[N];
 		_gyro_data_buffer_z = new q15_t[N];
+
+		_peak_magnitudes_all = new float[N];
+
+		if (_sliding_dft) {
+			// complex state and twiddle factor for bins 0...N/2
+			_sdft_bins_x = new float[N + 2];
+			_sdft_bins_y = new float[N + 2];
+			_sdft_bins_z = new float[N + 2];
+			_sdft_twiddle = new float[N + 2];
+			_sdft_spectrum = new float[N + 2];
+
+			return (_gyro_data_buffer_x && _gyro_data_buffer_y && _gyro_data_buffer_z
+				&& _peak_magnitudes_all
+				&& _sdft_bins_x && _sdft_bins_y && _sdft_bins_z
+				&& _sdft_twiddle
+				&& _sdft_spectrum);
+		}
+
 		_hanning_window = new q15_t[N];
 		_fft_input_buffer = new q15_t[N];
 		_fft_outupt_buffer = new q15_t[N * 2];
 
-		_peak_magnitudes_all = new float[N];
-
 		return (_gyro_data_buffer_x && _gyro_data_buffer_y && _gyro_data_buffer_z
+			&& _peak_magnitudes_all
 			&& _hanning_window
 			&& _fft_input_buffer
 			&& _fft_outupt_buffer);
@@ -143,6 +172,24 @@ private:
 
 	float *_peak_magnitudes_all{nullptr};
 
+	// sliding DFT (IMU_GYRO_FFT_MOD)
+	float *_sdft_bins_x{nullptr};
+	float *_sdft_bins_y{nullptr};
+	float *_sdft_bins_z{nullptr};
+	float *_sdft_twiddle{nullptr};
+	float *_sdft_spectrum{nullptr};
+
+	float _sdft_damping_n{1.f}; // SDFT_DAMPING^N
+
+	int _sdft_sample_count[3] {};
+	int _sdft_axis_next{0};
+
+	bool _sliding_dft{false};
+
+	// peak search band (IMU_GYRO_FFT_MIN, IMU_GYRO_FFT_MAX)
+	int _bin_min{0};
+	int _bin_max{0};
+
 	float _gyro_sample_rate_hz{8000}; // 8 kHz default
 
 	float _fifo_last_scale{0};
@@ -166,7 +213,8 @@ private:
 		(ParamInt<px4::params::IMU_GYRO_FFT_LEN>) _param_imu_gyro_fft_len,
 		(ParamFloat<px4::params::IMU_GYRO_FFT_MIN>) _param_imu_gyro_fft_min,
 		(ParamFloat<px4::params::IMU_GYRO_FFT_MAX>) _param_imu_gyro_fft_max,
-		(ParamFloat<px4::params::IMU_GYRO_FFT_SNR>) _param_imu_gyro_fft_snr
+		(ParamFloat<px4::params::IMU_GYRO_FFT_SNR>) _param_imu_gyro_fft_snr,
+		(ParamInt<px4::params::IMU_GYRO_FFT_MOD>) _param_imu_gyro_fft_mod
 	)
 };
 
@@ -83,3 +83,17 @@ PARAM_DEFINE_INT32(IMU_GYRO_FFT_LEN, 512);
 * @group Sensors
 */
 PARAM_DEFINE_FLOAT(IMU_GYRO_FFT_SNR, 10.f);
+
+/**
+* IMU gyro FFT mode.
+*
+* Full FFT recomputes the spectrum over the whole buffer at a fixed overlap.
+* Sliding DFT updates the spectrum bins within IMU_GYRO_FFT_MIN and IMU_GYRO_FFT_MAX
+* on every gyro sample at constant cost, for faster peak tracking without CPU spikes.
+*
+* @value 0 Full FFT
+* @value 1 Sliding DFT
+* @reboot_required true
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_FFT_MOD, 0);
@@ -69,14 +69,14 @@ LandDetector::~LandDetector()
 
 void LandDetector::start()
 {
-	ScheduleDelayed(50_ms);
+	ScheduleDelayed(DEFAULT_INTERVAL_US);
 	_vehicle_local_position_sub.registerCallback();
 }
 
 void LandDetector::Run()
 {
 	// push backup schedule
-	ScheduleDelayed(50_ms);
+	ScheduleDelayed(_reduced_rate ? REDUCED_INTERVAL_US : DEFAULT_INTERVAL_US);
 
 	perf_begin(_cycle_perf);
 
@@ -201,6 +201,16 @@ void LandDetector::Run()
 
 	_previous_armed_state = _armed;
 
+	// While armed in flight and far from any landed state, evaluate at a reduced rate (vehicle_local_position callback
+	// interval) and switch back to every local position update as soon as landing becomes possible again.
+	const bool reduced_rate = _armed && !landDetected && !maybe_landedDetected && !ground_contactDetected
+				  && !freefallDetected && !in_ground_effect && _get_far_from_landing();
+
+	if (reduced_rate != _reduced_rate) {
+		_vehicle_local_position_sub.set_interval_us(reduced_rate ? REDUCED_INTERVAL_US : 0);
+		_reduced_rate = reduced_rate;
+	}
+
 	perf_end(_cycle_perf);
 
 	if (should_exit()) {
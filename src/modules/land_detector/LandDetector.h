@@ -140,6 +140,13 @@ protected:
 	virtual bool _get_vertical_movement() { return false; }
 	virtual bool _get_rotational_movement() { return false; }
 	virtual bool _get_close_to_ground_or_skipped_check() {  return false; }
+
+	/**
+	 * @return true if none of the landed states can be reached from the current state (e.g. high thrust in flight),
+	 * the detector then runs at a reduced rate. The detection must not depend on the update rate in this case.
+	 */
+	virtual bool _get_far_from_landing() { return false; }
+
 	virtual void _set_hysteresis_factor(const int factor) = 0;
 
 	systemlib::Hysteresis _freefall_hysteresis{false};
@@ -163,6 +170,9 @@ private:
 
 	void UpdateVehicleAtRest();
 
+	static constexpr hrt_abstime DEFAULT_INTERVAL_US = 50_ms;
+	static constexpr hrt_abstime REDUCED_INTERVAL_US = 100_ms; ///< update interval while far from landing
+
 	vehicle_land_detected_s _land_detected{};
 	hrt_abstime _takeoff_time{0};
 	hrt_abstime _total_flight_time{0};	///< total vehicle flight time in microseconds
@@ -187,6 +197,7 @@ private:
 	uint32_t _device_id_gyro{0};
 
 	bool _at_rest{true};
+	bool _reduced_rate{false};
 
 	DEFINE_PARAMETERS_CUSTOM_PARENT(
 		ModuleParams,
@@ -303,6 +303,18 @@ bool MulticopterLandDetector::_get_ground_effect_state()
 	       _takeoff_state == takeoff_status_s::TAKEOFF_STATE_RAMPUP;
 }
 
+bool MulticopterLandDetector::_get_far_from_landing()
+{
+	// ground contact (and therefore maybe landed and landed) requires low throttle, and the 8 s minimum thrust
+	// fallback requires even lower thrust. Any thrust drop is picked up within one reduced rate interval,
+	// which is short compared to the ground contact trigger time.
+	return (_takeoff_state == takeoff_status_s::TAKEOFF_STATE_FLIGHT)
+	       && !_has_low_throttle
+	       && !_in_descend
+	       && !_below_gnd_effect_hgt
+	       && !_is_close_to_ground();
+}
+
 bool MulticopterLandDetector::_is_close_to_ground()
 {
 	if (_vehicle_local_position.dist_bottom_valid) {
@@ -76,6 +76,7 @@ protected:
 	bool _get_vertical_movement() override { return _vertical_movement; }
 	bool _get_rotational_movement() override { return _rotational_movement; }
 	bool _get_close_to_ground_or_skipped_check() override { return _close_to_ground_or_skipped_check; }
+	bool _get_far_from_landing() override;
 
 	void _set_hysteresis_factor(const int factor) override;
 private:
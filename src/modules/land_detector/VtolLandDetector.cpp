@@ -81,4 +81,14 @@ bool VtolLandDetector::_get_freefall_state()
 	return _vehicle_status.vehicle_type != vehicle_status_s::VEHICLE_TYPE_FIXED_WING && free_fall_detected;
 }
 
+bool VtolLandDetector::_get_far_from_landing()
+{
+	// In Fixed-wing mode landing is only detected on disarm
+	if (_vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING) {
+		return true;
+	}
+
+	return MulticopterLandDetector::_get_far_from_landing();
+}
+
 } // namespace land_detector
@@ -59,6 +59,7 @@ protected:
 	bool _get_landed_state() override;
 	bool _get_maybe_landed_state() override;
 	bool _get_freefall_state() override;
+	bool _get_far_from_landing() override;
 };
 
 } // namespace land_detector
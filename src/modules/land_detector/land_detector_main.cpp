@@ -105,7 +105,8 @@ int LandDetector::task_spawn(int argc, char *argv[])
 
 int LandDetector::print_status()
 {
-	PX4_INFO("running (%s)", _currentMode);
+	PX4_INFO("running (%s)%s", _currentMode, _reduced_rate ? ", reduced rate" : "");
+	perf_print_counter(_cycle_perf);
 	return 0;
 }
 int LandDetector::print_usage(const char *reason)
@@ -137,7 +138,9 @@ position controller sets the thrust setpoint to zero.
 
 **landed**: it requires maybe_landed to be true for time LAND_DETECTOR_TRIGGER_TIME_US.
 
-The module runs periodically on the HP work queue.
+The module runs on every vehicle_local_position update (at least at 20 Hz). When the vehicle is armed and flying and
+none of the landed states can be reached (multicopter: thrust clearly above the ground contact threshold, not descending
+and not close to the ground), it runs at 10 Hz instead.
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("land_detector", "system");
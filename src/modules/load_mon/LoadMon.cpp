@@ -109,6 +109,12 @@ void LoadMon::Run()
 
 #endif
 
+	perf_counter_snapshot();
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+	work_item_timing();
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
 	if (should_exit()) {
 		ScheduleClear();
 #if defined (__PX4_LINUX)
@@ -303,6 +309,113 @@ void LoadMon::stack_usage()
 }
 #endif
 
+struct perf_snapshot_data_t {
+	perf_counter_snapshot_s snapshots[perf_counter_snapshot_s::ORB_QUEUE_LENGTH];
+	unsigned first_index;
+	unsigned index;
+};
+
+static void fill_perf_counter_snapshot(perf_counter_t handle, void *user)
+{
+	perf_snapshot_data_t &data = *static_cast<perf_snapshot_data_t *>(user);
+	const unsigned index = data.index++;
+
+	if (index < data.first_index) {
+		return;
+	}
+
+	const unsigned batch = (index - data.first_index) / perf_counter_snapshot_s::MAX_COUNTERS;
+
+	if (batch >= perf_counter_snapshot_s::ORB_QUEUE_LENGTH) {
+		return;
+	}
+
+	perf_counter_snapshot_s &snapshot = data.snapshots[batch];
+	perf_counter_stats stats;
+
+	if (perf_get_stats(handle, &stats) == 0) {
+		snapshot.id[snapshot.count] = perf_name_id(handle);
+		snapshot.type[snapshot.count] = stats.type;
+		snapshot.event_count[snapshot.count] = stats.event_count;
+		snapshot.time_avg_us[snapshot.count] = stats.time_avg_us;
+		snapshot.time_max_us[snapshot.count] = stats.time_max_us;
+		snapshot.count++;
+	}
+}
+
+void LoadMon::perf_counter_snapshot()
+{
+	// fill up to ORB_QUEUE_LENGTH batches, so that the logger picks up all of them
+	perf_snapshot_data_t data{};
+	data.first_index = _perf_counter_index;
+
+	perf_iterate_all(fill_perf_counter_snapshot, &data);
+
+	const hrt_abstime now = hrt_absolute_time();
+	unsigned first_index = _perf_counter_index;
+
+	for (auto &snapshot : data.snapshots) {
+		if (snapshot.count == 0) {
+			break;
+		}
+
+		snapshot.timestamp = now;
+		snapshot.num_counters = data.index;
+		snapshot.first_index = first_index;
+		_perf_counter_snapshot_pub.publish(snapshot);
+
+		first_index += snapshot.count;
+	}
+
+	// continue with the next counters next cycle, or start over
+	_perf_counter_index = (first_index < data.index) ? first_index : 0;
+}
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+static void copy_histogram(const uORB::LatencyHistogram &histogram, uint32_t bins[uORB::LatencyHistogram::NUM_BINS])
+{
+	for (int i = 0; i < uORB::LatencyHistogram::NUM_BINS; i++) {
+		bins[i] = histogram.bin(i);
+	}
+}
+
+static void fill_work_item_timing(const px4::WorkQueue &wq, const px4::WorkItem &item, void *arg)
+{
+	work_item_timing_s &timing = *static_cast<work_item_timing_s *>(arg);
+
+	strncpy(timing.item_name, item.ItemName(), sizeof(timing.item_name) - 1);
+	timing.item_name[sizeof(timing.item_name) - 1] = '\0';
+	strncpy(timing.queue_name, wq.get_name(), sizeof(timing.queue_name) - 1);
+	timing.queue_name[sizeof(timing.queue_name) - 1] = '\0';
+
+	timing.run_count = item.run_time_histogram().count();
+	copy_histogram(item.run_time_histogram(), timing.run_time_hist);
+	timing.run_time_max_us = item.run_time_histogram().max_us();
+	copy_histogram(item.schedule_latency_histogram(), timing.latency_hist);
+	timing.latency_max_us = item.schedule_latency_histogram().max_us();
+}
+
+void LoadMon::work_item_timing()
+{
+	static_assert(sizeof(work_item_timing_s::run_time_hist) / sizeof(uint32_t) == uORB::LatencyHistogram::NUM_BINS,
+		      "work_item_timing histogram size mismatch");
+
+	work_item_timing_s timing{};
+
+	if (!px4::WorkQueueManagerVisitItem(_work_item_index, fill_work_item_timing, &timing)) {
+		// past the last item, start over next cycle
+		_work_item_index = 0;
+		return;
+	}
+
+	timing.timestamp = hrt_absolute_time();
+	_work_item_timing_pub.publish(timing);
+
+	// Continue with the next item next cycle
+	_work_item_index++;
+}
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
 int LoadMon::print_usage(const char *reason)
 {
 	if (reason) {
@@ -317,6 +430,10 @@ usage and publish the `cpuload` topic.
 
 On NuttX it also checks the stack usage of each process and if it falls below 300 bytes, a warning is output,
 which will also appear in the log file.
+
+It also publishes `perf_counter_snapshot`, cycling through all perf counters.
+
+With CONFIG_WQ_ITEM_HISTOGRAMS it publishes `work_item_timing` for one work item per cycle.
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("load_mon", "system");
@@ -46,7 +46,9 @@
 #include <px4_platform/cpuload.h>
 #include <uORB/Publication.hpp>
 #include <uORB/topics/cpuload.h>
+#include <uORB/topics/perf_counter_snapshot.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/work_item_timing.h>
 
 #if defined(__PX4_LINUX)
 #include <sys/times.h>
@@ -92,6 +94,22 @@ private:
 #endif
 	uORB::Publication<cpuload_s> _cpuload_pub {ORB_ID(cpuload)};
 
+	/* Publish the next batches of perf counters */
+	void perf_counter_snapshot();
+
+	unsigned _perf_counter_index{0};
+
+	uORB::Publication<perf_counter_snapshot_s> _perf_counter_snapshot_pub{ORB_ID(perf_counter_snapshot)};
+
+#if defined(CONFIG_WQ_ITEM_HISTOGRAMS)
+	/* Publish the timing histograms of the next work item */
+	void work_item_timing();
+
+	unsigned _work_item_index{0};
+
+	uORB::Publication<work_item_timing_s> _work_item_timing_pub{ORB_ID(work_item_timing)};
+#endif // CONFIG_WQ_ITEM_HISTOGRAMS
+
 #if defined(__PX4_LINUX)
 	FILE *_proc_fd = nullptr;
 	/* calculate usage directly from clock ticks on Linux */
@@ -973,8 +973,8 @@ void BlockLocalPositionEstimator::predict(const sensor_combined_s &imu)
 
 	// propagate
 	_x += dx;
-	Matrix<float, n_x, n_x> dP = (m_A * m_P + m_P * m_A.transpose() +
-				      m_B * m_R * m_B.transpose() + m_Q) * getDt();
+	Matrix<float, n_x, n_x> dP = (m_A * m_P + m_P.multiplyByTranspose(m_A) +
+				      conjugate(m_B, m_R) + m_Q) * getDt();
 
 	// covariance propagation logic
 	for (size_t i = 0; i < n_x; i++) {
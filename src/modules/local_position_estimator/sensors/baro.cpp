@@ -66,9 +66,11 @@ void BlockLocalPositionEstimator::baroCorrect()
 	R.setZero();
 	R(0, 0) = _param_lpe_bar_z.get() * _param_lpe_bar_z.get();
 
+	const Matrix<float, n_x, n_y_baro> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual
 	Matrix<float, n_y_baro, n_y_baro> S_I =
-		inv<float, n_y_baro>((C * m_P * C.transpose()) + R);
+		inv<float, n_y_baro>(C * PCt + R);
 	Vector<float, n_y_baro> r = y - (C * _x);
 
 	// fault detection
@@ -87,10 +89,10 @@ void BlockLocalPositionEstimator::baroCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_baro> K = m_P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_baro> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	m_P -= K * C * m_P;
+	m_P -= K * PCt.transpose();
 }
 
 void BlockLocalPositionEstimator::baroCheckTimeout()
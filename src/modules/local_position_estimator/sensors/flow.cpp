@@ -166,8 +166,10 @@ void BlockLocalPositionEstimator::flowCorrect()
 	// residual
 	Vector<float, 2> r = y - C * _x;
 
+	const Matrix<float, n_x, n_y_flow> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual covariance
-	Matrix<float, n_y_flow, n_y_flow> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_flow, n_y_flow> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().flow[0] = r(0);
@@ -193,11 +195,10 @@ void BlockLocalPositionEstimator::flowCorrect()
 	}
 
 	if (!(_sensorFault & SENSOR_FLOW)) {
-		Matrix<float, n_x, n_y_flow> K =
-			m_P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_flow> K = PCt * S_I;
 		Vector<float, n_x> dx = K * r;
 		_x += dx;
-		m_P -= K * C * m_P;
+		m_P -= K * PCt.transpose();
 	}
 }
 
@@ -185,8 +185,10 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	// residual
 	Vector<float, n_y_gps> r = y - C * x0;
 
+	const Matrix<float, n_x, n_y_gps> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual covariance
-	Matrix<float, n_y_gps, n_y_gps> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_gps, n_y_gps> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().gps_hpos[0] = r(0);
@@ -227,10 +229,10 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	}
 
 	// kalman filter correction always for GPS
-	Matrix<float, n_x, n_y_gps> K = m_P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_gps> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	m_P -= K * C * m_P;
+	m_P -= K * PCt.transpose();
 }
 
 void BlockLocalPositionEstimator::gpsCheckTimeout()
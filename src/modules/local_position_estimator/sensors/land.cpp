@@ -58,8 +58,10 @@ void BlockLocalPositionEstimator::landCorrect()
 	R(Y_land_vy, Y_land_vy) = _param_lpe_land_vxy.get() * _param_lpe_land_vxy.get();
 	R(Y_land_agl, Y_land_agl) = _param_lpe_land_z.get() * _param_lpe_land_z.get();
 
+	const Matrix<float, n_x, n_y_land> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual
-	Matrix<float, n_y_land, n_y_land> S_I = inv<float, n_y_land>((C * m_P * C.transpose()) + R);
+	Matrix<float, n_y_land, n_y_land> S_I = inv<float, n_y_land>(C * PCt + R);
 	Vector<float, n_y_land> r = y - C * _x;
 	_pub_innov.get().hagl = r(Y_land_agl);
 	_pub_innov_var.get().hagl = R(Y_land_agl, Y_land_agl);
@@ -85,10 +87,10 @@ void BlockLocalPositionEstimator::landCorrect()
 	}
 
 	// kalman filter correction always for land detector
-	Matrix<float, n_x, n_y_land> K = m_P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_land> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	m_P -= K * C * m_P;
+	m_P -= K * PCt.transpose();
 }
 
 void BlockLocalPositionEstimator::landCheckTimeout()
@@ -80,9 +80,11 @@ void BlockLocalPositionEstimator::landingTargetCorrect()
 	// residual
 	Vector<float, n_y_target> r = y - C * _x;
 
+	const Matrix<float, n_x, n_y_target> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual covariance, (inverse)
 	Matrix<float, n_y_target, n_y_target> S_I =
-		inv<float, n_y_target>(C * m_P * C.transpose() + R);
+		inv<float, n_y_target>(C * PCt + R);
 
 	// fault detection
 	float beta = (r.transpose()  * (S_I * r))(0, 0);
@@ -102,11 +104,10 @@ void BlockLocalPositionEstimator::landingTargetCorrect()
 	}
 
 	// kalman filter correction
-	Matrix<float, n_x, n_y_target> K =
-		m_P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_target> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	m_P -= K * C * m_P;
+	m_P -= K * PCt.transpose();
 
 }
 
@@ -88,8 +88,11 @@ void BlockLocalPositionEstimator::lidarCorrect()
 
 	// residual
 	Vector<float, n_y_lidar> r = y - C * _x;
+
+	const Matrix<float, n_x, n_y_lidar> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual covariance
-	Matrix<float, n_y_lidar, n_y_lidar> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_lidar, n_y_lidar> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().hagl = r(0);
@@ -116,10 +119,10 @@ void BlockLocalPositionEstimator::lidarCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_lidar> K = m_P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_lidar> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	m_P -= K * C * m_P;
+	m_P -= K * PCt.transpose();
 }
 
 void BlockLocalPositionEstimator::lidarCheckTimeout()
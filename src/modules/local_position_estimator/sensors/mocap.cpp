@@ -138,8 +138,11 @@ void BlockLocalPositionEstimator::mocapCorrect()
 
 	// residual
 	Vector<float, n_y_mocap> r = y - C * _x;
+
+	const Matrix<float, n_x, n_y_mocap> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual covariance
-	Matrix<float, n_y_mocap, n_y_mocap> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_mocap, n_y_mocap> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().ev_hpos[0] = r(0);
@@ -175,10 +178,10 @@ void BlockLocalPositionEstimator::mocapCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_mocap> K = m_P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_mocap> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	m_P -= K * C * m_P;
+	m_P -= K * PCt.transpose();
 }
 
 void BlockLocalPositionEstimator::mocapCheckTimeout()
@@ -108,8 +108,11 @@ void BlockLocalPositionEstimator::sonarCorrect()
 
 	// residual
 	Vector<float, n_y_sonar> r = y - C * _x;
+
+	const Matrix<float, n_x, n_y_sonar> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual covariance
-	Matrix<float, n_y_sonar, n_y_sonar> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_sonar, n_y_sonar> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().hagl = r(0);
@@ -137,11 +140,10 @@ void BlockLocalPositionEstimator::sonarCorrect()
 
 	// kalman filter correction if no fault
 	if (!(_sensorFault & SENSOR_SONAR)) {
-		Matrix<float, n_x, n_y_sonar> K =
-			m_P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_sonar> K = PCt * S_I;
 		Vector<float, n_x> dx = K * r;
 		_x += dx;
-		m_P -= K * C * m_P;
+		m_P -= K * PCt.transpose();
 	}
 }
 
@@ -155,8 +155,11 @@ void BlockLocalPositionEstimator::visionCorrect()
 
 	// residual
 	Matrix<float, n_y_vision, 1> r = y - C * x0;
+
+	const Matrix<float, n_x, n_y_vision> PCt = m_P.multiplyByTranspose(C); // = (C * P)^T, P is symmetric
+
 	// residual covariance
-	Matrix<float, n_y_vision, n_y_vision> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_vision, n_y_vision> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().ev_hpos[0] = r(0, 0);
@@ -193,10 +196,10 @@ void BlockLocalPositionEstimator::visionCorrect()
 
 	// kalman filter correction if no fault
 	if (!(_sensorFault & SENSOR_VISION)) {
-		Matrix<float, n_x, n_y_vision> K = m_P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_vision> K = PCt * S_I;
 		Vector<float, n_x> dx = K * r;
 		_x += dx;
-		m_P -= K * C * m_P;
+		m_P -= K * PCt.transpose();
 	}
 }
 
@@ -0,0 +1,167 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file delta_encoding.h
+ *
+ * Encoding of ULogMessageType::DATA_DELTA messages, used by the logger and replay.
+ *
+ * The payload (after the msg_id) is a bitmask with one bit per top-level field of the logged format (LSB first),
+ * followed by the values of the fields that changed with respect to the previous data message of the same msg_id.
+ * Fields are taken from the uORB field table, limited to the logged size (o_size_no_padding).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <uORB/uORBFieldTable.hpp>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * get the field length within the logged size, 0 if the field is not logged
+ */
+static inline size_t delta_field_length(const uORB::FieldDescriptor &field, size_t size)
+{
+	if (field.offset >= size) {
+		return 0;
+	}
+
+	const size_t end = field.offset + (size_t)field.element_size * field.array_length;
+	return (end > size ? size : end) - field.offset;
+}
+
+static inline size_t delta_mask_size(const uORB::FieldTable &fields, size_t size)
+{
+	size_t num_fields = 0;
+
+	for (int i = 0; i < fields.num_fields; ++i) {
+		if (delta_field_length(fields.fields[i], size) > 0) {
+			++num_fields;
+		}
+	}
+
+	return (num_fields + 7) / 8;
+}
+
+/**
+ * Encode data relative to reference
+ * @param size logged size of data and reference
+ * @param out output buffer with at least size bytes
+ * @return encoded size, 0 if it would not be smaller than size (a full data message should be written instead)
+ */
+static inline size_t delta_encode(const uORB::FieldTable &fields, size_t size, const uint8_t *reference,
+				  const uint8_t *data, uint8_t *out)
+{
+	const size_t mask_size = delta_mask_size(fields, size);
+
+	if (mask_size >= size) {
+		return 0;
+	}
+
+	memset(out, 0, mask_size);
+	size_t pos = mask_size;
+	int field_idx = 0;
+
+	for (int i = 0; i < fields.num_fields; ++i) {
+		const uORB::FieldDescriptor &field = fields.fields[i];
+		const size_t length = delta_field_length(field, size);
+
+		if (length == 0) {
+			continue;
+		}
+
+		if (memcmp(reference + field.offset, data + field.offset, length) != 0) {
+			if (pos + length >= size) {
+				return 0;
+			}
+
+			out[field_idx / 8] |= 1 << (field_idx % 8);
+			memcpy(out + pos, data + field.offset, length);
+			pos += length;
+		}
+
+		++field_idx;
+	}
+
+	return pos;
+}
+
+/**
+ * Apply an encoded delta to reference
+ * @param size logged size of reference
+ * @return false if the encoded data is inconsistent with the field table
+ */
+static inline bool delta_decode(const uORB::FieldTable &fields, size_t size, const uint8_t *in, size_t in_size,
+				uint8_t *reference)
+{
+	const size_t mask_size = delta_mask_size(fields, size);
+
+	if (in_size < mask_size) {
+		return false;
+	}
+
+	size_t pos = mask_size;
+	int field_idx = 0;
+
+	for (int i = 0; i < fields.num_fields; ++i) {
+		const uORB::FieldDescriptor &field = fields.fields[i];
+		const size_t length = delta_field_length(field, size);
+
+		if (length == 0) {
+			continue;
+		}
+
+		if (in[field_idx / 8] & (1 << (field_idx % 8))) {
+			if (pos + length > in_size) {
+				return false;
+			}
+
+			memcpy(reference + field.offset, in + pos, length);
+			pos += length;
+		}
+
+		++field_idx;
+	}
+
+	return pos == in_size;
+}
+
+} // namespace logger
+} // namespace px4
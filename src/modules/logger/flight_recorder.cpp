@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "flight_recorder.h"
+#include "messages.h"
+
+#include <string.h>
+
+#include <mathlib/mathlib.h>
+
+namespace px4
+{
+namespace logger
+{
+
+FlightRecorder::~FlightRecorder()
+{
+	delete[] _buffer;
+}
+
+bool FlightRecorder::init(size_t size)
+{
+	delete[] _buffer;
+	_buffer = new uint8_t[size];
+
+	if (!_buffer) {
+		_size = 0;
+		return false;
+	}
+
+	_size = size;
+	reset();
+	return true;
+}
+
+size_t FlightRecorder::message_size(size_t pos) const
+{
+	const uint8_t size_lsb = _buffer[pos];
+	const uint8_t size_msb = _buffer[(pos + 1) % _size];
+	return ((size_t)size_msb << 8 | size_lsb) + ULOG_MSG_HEADER_LEN;
+}
+
+void FlightRecorder::write(const uint8_t *msg, size_t size)
+{
+	if (_frozen || size > _size) {
+		return;
+	}
+
+	// drop the oldest messages
+	while (_size - _count < size) {
+		const size_t oldest_size = message_size(_start);
+		_start = (_start + oldest_size) % _size;
+		_count -= oldest_size;
+	}
+
+	const size_t head = (_start + _count) % _size;
+	const size_t first_part = math::min(size, _size - head);
+	memcpy(_buffer + head, msg, first_part);
+	memcpy(_buffer, msg + first_part, size - first_part);
+	_count += size;
+}
+
+size_t FlightRecorder::get_read_ptr(const uint8_t **ptr) const
+{
+	*ptr = _buffer + _start;
+	return (_count < _size - _start) ? _count : _size - _start;
+}
+
+void FlightRecorder::mark_read(size_t n)
+{
+	_start = (_start + n) % _size;
+	_count -= n;
+}
+
+void FlightRecorder::reset()
+{
+	_start = 0;
+	_count = 0;
+	_frozen = false;
+}
+
+} // namespace logger
+} // namespace px4
@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file flight_recorder.h
+ *
+ * RAM ring buffer of ULog data messages for the last few seconds (the flight recorder).
+ * The oldest messages are dropped when the ring is full. When triggered, the ring is frozen
+ * until its content is written to a file.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace px4
+{
+namespace logger
+{
+
+class FlightRecorder
+{
+public:
+	FlightRecorder() = default;
+	~FlightRecorder();
+
+	/**
+	 * allocate the ring
+	 * @param size ring size in bytes
+	 * @return true on success
+	 */
+	bool init(size_t size);
+
+	bool allocated() const { return _buffer != nullptr; }
+
+	/**
+	 * Add a complete ULog message (including header) to the ring, dropping the oldest messages
+	 * if required. Does nothing while frozen.
+	 */
+	void write(const uint8_t *msg, size_t size);
+
+	/**
+	 * stop recording, the content can then be read with get_read_ptr() and mark_read()
+	 */
+	void freeze() { _frozen = true; }
+
+	bool frozen() const { return _frozen; }
+
+	/**
+	 * get a pointer to the oldest data (which always starts with a complete message)
+	 * @return number of contiguous bytes available at ptr
+	 */
+	size_t get_read_ptr(const uint8_t **ptr) const;
+
+	void mark_read(size_t n);
+
+	/**
+	 * clear the ring and continue recording
+	 */
+	void reset();
+
+	size_t count() const { return _count; }
+	size_t size() const { return _size; }
+
+private:
+	/** size of the message at the given ring position (the header might wrap around) */
+	size_t message_size(size_t pos) const;
+
+	uint8_t *_buffer{nullptr};
+	size_t _size{0};
+	size_t _start{0}; ///< position of the oldest message
+	size_t _count{0}; ///< number of used bytes
+	bool _frozen{false};
+};
+
+} // namespace logger
+} // namespace px4
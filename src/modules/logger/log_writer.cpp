@@ -180,6 +180,19 @@ int LogWriter::write_message(LogType type, void *ptr, size_t size, uint64_t drop
 	return ret_mavlink;
 }
 
+void *LogWriter::reserve_message(LogType type, size_t size)
+{
+	if (!_log_writer_file_for_write || _log_writer_file_for_write->need_reliable_transfer()) {
+		return nullptr;
+	}
+
+	if (_log_writer_mavlink_for_write && _log_writer_mavlink_for_write->is_started()) {
+		return nullptr;
+	}
+
+	return _log_writer_file_for_write->reserve_message(type, size);
+}
+
 void LogWriter::select_write_backend(Backend sel_backend)
 {
 	if (sel_backend & BackendFile) {
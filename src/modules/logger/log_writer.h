@@ -94,6 +94,19 @@ public:
 	 */
 	int write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start = 0);
 
+	/**
+	 * Reserve space to construct a message directly in the file backend buffer, see
+	 * LogWriterFile::reserve_message(). Only available while the file is the only active backend and
+	 * no reliable transfer is needed. The caller must call lock() before calling this.
+	 * @return pointer to the space, nullptr if not available (use write_message() instead)
+	 */
+	void *reserve_message(LogType type, size_t size);
+
+	/**
+	 * Add a message constructed in the space returned by reserve_message()
+	 */
+	void commit_message(LogType type, size_t size) { _log_writer_file_for_write->commit_message(type, size); }
+
 	/**
 	 * Select a backend, so that future calls to write_message() only write to the selected
 	 * sel_backend, until unselect_write_backend() is called.
@@ -126,6 +139,13 @@ public:
 		return 0;
 	}
 
+	uint64_t get_file_offset(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_file_offset(type); }
+
+		return 0;
+	}
+
 	size_t get_buffer_size_file(LogType type) const
 	{
 		if (_log_writer_file) { return _log_writer_file->get_buffer_size(type); }
@@ -175,6 +195,18 @@ public:
 	}
 #endif // PX4_CRYPTO
 
+	void set_file_options(size_t preallocate_size, size_t write_block_size)
+	{
+		if (_log_writer_file) { _log_writer_file->set_file_options(preallocate_size, write_block_size); }
+	}
+
+#if defined(CONFIG_LOGGER_COMPRESSION)
+	void set_compression(bool enable)
+	{
+		if (_log_writer_file) { _log_writer_file->set_compression(enable); }
+	}
+#endif // CONFIG_LOGGER_COMPRESSION
+
 private:
 
 	LogWriterFile *_log_writer_file = nullptr;
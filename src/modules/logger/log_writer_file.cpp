@@ -67,16 +67,31 @@ LogWriterFile::LogWriterFile(size_t buffer_size)
 	{
 		buffer_size,
 		_min_write_chunk + 300,
-		perf_alloc(PC_ELAPSED, "logger_sd_write"), perf_alloc(PC_ELAPSED, "logger_sd_fsync")},
+		perf_alloc(PC_ELAPSED, "logger_sd_write"), perf_alloc(PC_ELAPSED, "logger_sd_fsync"),
+		perf_alloc(PC_HISTOGRAM, "logger_sd_write_latency")},
 
 	{
 		300, // buffer size for the mission log (can be kept fairly small)
 		1,
-		perf_alloc(PC_ELAPSED, "logger_sd_write_mission"), perf_alloc(PC_ELAPSED, "logger_sd_fsync_mission")}
+		perf_alloc(PC_ELAPSED, "logger_sd_write_mission"), perf_alloc(PC_ELAPSED, "logger_sd_fsync_mission")},
+
+	{
+		8192, // flight recorder dump, only allocated when triggered the first time
+		1024,
+		perf_alloc(PC_ELAPSED, "logger_sd_write_recorder"), perf_alloc(PC_ELAPSED, "logger_sd_fsync_recorder")}
 }
 {
-	pthread_mutex_init(&_mtx, nullptr);
-	pthread_cond_init(&_cv, nullptr);
+	for (int i = 0; i < (int)LogType::Count; ++i) {
+		_threads[i].writer = this;
+		_threads[i].type = (LogType)i;
+		pthread_mutex_init(&_threads[i].mtx, nullptr);
+		pthread_cond_init(&_threads[i].cv, nullptr);
+	}
+
+#if defined(PX4_CRYPTO)
+	pthread_mutex_init(&_crypto_mtx, nullptr);
+	_perf_encrypt = perf_alloc(PC_ELAPSED, "logger_sd_encrypt");
+#endif // PX4_CRYPTO
 }
 
 bool LogWriterFile::init()
@@ -86,11 +101,31 @@ bool LogWriterFile::init()
 
 LogWriterFile::~LogWriterFile()
 {
-	pthread_mutex_destroy(&_mtx);
-	pthread_cond_destroy(&_cv);
+	for (int i = 0; i < (int)LogType::Count; ++i) {
+		pthread_mutex_destroy(&_threads[i].mtx);
+		pthread_cond_destroy(&_threads[i].cv);
+	}
+
+#if defined(PX4_CRYPTO)
+	pthread_mutex_destroy(&_crypto_mtx);
+	perf_free(_perf_encrypt);
+#endif // PX4_CRYPTO
+
+#if defined(CONFIG_LOGGER_COMPRESSION)
+	delete[] _compressed_buffer;
+#endif // CONFIG_LOGGER_COMPRESSION
 }
 
 #if defined(PX4_CRYPTO)
+void LogWriterFile::release_crypto_session(const LogType type)
+{
+	_crypto_users &= ~(1u << (int)type);
+
+	if (_crypto_users == 0) {
+		_crypto.close();
+	}
+}
+
 bool LogWriterFile::init_logfile_encryption(const LogType type)
 {
 	if (_algorithm == CRYPTO_NONE) {
@@ -191,21 +226,30 @@ bool LogWriterFile::init_logfile_encryption(const LogType type)
 #endif // PX4_CRYPTO
 
 
-bool LogWriterFile::start_log(LogType type, const char *filename)
+bool LogWriterFile::start_log(LogType type, const char *filename, bool register_hardfault)
 {
 	// At this point we don't expect the file to be open, but it can happen for very fast consecutive stop & start
 	// calls. In that case we wait for the thread to close the file first.
-	lock();
+	lock(type);
 
 	while (_buffers[(int)type].fd() >= 0) {
-		unlock();
+		unlock(type);
 		system_usleep(5000);
-		lock();
+		lock(type);
 	}
 
-	unlock();
+	unlock(type);
 
-	if (type == LogType::Full) {
+	if (!_threads[(int)type].started) {
+		int ret = thread_start(type);
+
+		if (ret) {
+			PX4_ERR("failed to start %s log writer thread (%i)", log_type_str(type), ret);
+			return false;
+		}
+	}
+
+	if (type == LogType::Full && register_hardfault) {
 		// register the current file with the hardfault handler: if the system crashes,
 		// the hardfault handler will append the crash log to that file on the next reboot.
 		// Note that we don't deregister it when closing the log, so that crashes after disarming
@@ -217,14 +261,58 @@ bool LogWriterFile::start_log(LogType type, const char *filename)
 		}
 	}
 
-	if (_buffers[(int)type].start_log(filename)) {
+#if defined(CONFIG_LOGGER_COMPRESSION)
+
+	const bool compress = _compression && (type == LogType::Full);
+
+	if (compress && (_compressed_buffer == nullptr)) {
+		_compressed_buffer = new uint8_t[_compressed_buffer_size];
+
+		if (_compressed_buffer == nullptr) {
+			PX4_ERR("Failed to allocate the compression buffer");
+			return false;
+		}
+	}
+
+	// the ULog header and flag bits stay uncompressed, so that the hardfault handler can append to the file
+	_buffers[(int)type]._compress = compress;
+	_buffers[(int)type]._uncompressed_remaining = sizeof(ulog_file_header_s) + sizeof(ulog_message_flag_bits_s);
+#endif // CONFIG_LOGGER_COMPRESSION
+
+#if defined(PX4_CRYPTO)
+	// the full log is encrypted by a separate thread, the low rate mission log inline by its writer thread
+	const bool encrypt_thread = (type == LogType::Full) && (_algorithm != CRYPTO_NONE);
+
+	if (encrypt_thread && !_encrypt_thread_started) {
+		int ret = encrypt_thread_start();
+
+		if (ret) {
+			PX4_WARN("failed to start log encryption thread (%i), encrypting inline", ret);
+		}
+	}
+
+	lock(type);
+	_buffers[(int)type]._encrypt = encrypt_thread && _encrypt_thread_started;
+	unlock(type);
+#endif // PX4_CRYPTO
+
+	if (_buffers[(int)type].start_log(filename, (type == LogType::Full) ? _preallocate_size : 0, _write_block_size)) {
 
 #if PX4_CRYPTO
+		pthread_mutex_lock(&_crypto_mtx);
 		bool enc_init = init_logfile_encryption(type);
 
+		if (enc_init) {
+			_crypto_users |= 1u << (int)type;
+
+		} else {
+			release_crypto_session(type);
+		}
+
+		pthread_mutex_unlock(&_crypto_mtx);
+
 		if (!enc_init) {
 			PX4_ERR("Failed to start encrypted logging");
-			_crypto.close();
 			_buffers[(int)type]._should_run = false;
 			_buffers[(int)type].close_file();
 			_buffers[(int)type].reset();
@@ -275,13 +363,18 @@ int LogWriterFile::hardfault_store_filename(const char *log_file)
 
 void LogWriterFile::stop_log(LogType type)
 {
-	lock();
+	lock(type);
 	_buffers[(int)type]._should_run = false;
-	unlock();
-	notify();
+	unlock(type);
+	pthread_cond_broadcast(&_threads[(int)type].cv);
 }
 
 int LogWriterFile::thread_start()
+{
+	return thread_start(LogType::Full);
+}
+
+int LogWriterFile::thread_start(LogType type)
 {
 	pthread_attr_t thr_attr;
 	pthread_attr_init(&thr_attr);
@@ -293,9 +386,12 @@ int LogWriterFile::thread_start()
 
 	pthread_attr_setstacksize(&thr_attr, PX4_STACK_ADJUSTED(1170));
 
-	int ret = pthread_create(&_thread, &thr_attr, &LogWriterFile::run_helper, this);
+	WriterThread &writer_thread = _threads[(int)type];
+	int ret = pthread_create(&writer_thread.thread, &thr_attr, &LogWriterFile::run_helper, &writer_thread);
 	pthread_attr_destroy(&thr_attr);
 
+	writer_thread.started = ret == 0;
+
 	return ret;
 }
 
@@ -304,38 +400,179 @@ void LogWriterFile::thread_stop()
 	// this will terminate the main loop of the writer thread
 	lock();
 	_exit_thread.store(true);
-	_buffers[0]._should_run = _buffers[1]._should_run = false;
+
+	for (int i = 0; i < (int)LogType::Count; ++i) {
+		_buffers[i]._should_run = false;
+	}
+
 	unlock();
 
 	notify();
 
-	// wait for thread to complete
-	int ret = pthread_join(_thread, nullptr);
+	// wait for the threads to complete
+	for (int i = 0; i < (int)LogType::Count; ++i) {
+		if (!_threads[i].started) {
+			continue;
+		}
+
+		int ret = pthread_join(_threads[i].thread, nullptr);
+
+		if (ret) {
+			PX4_WARN("join failed: %d", ret);
+		}
 
-	if (ret) {
-		PX4_WARN("join failed: %d", ret);
+		_threads[i].started = false;
 	}
+
+#if defined(PX4_CRYPTO)
+
+	// the writer thread of the full log only exits after the encryption thread processed all data
+	if (_encrypt_thread_started) {
+		notify();
+
+		int ret = pthread_join(_encrypt_thread, nullptr);
+
+		if (ret) {
+			PX4_WARN("join failed: %d", ret);
+		}
+
+		_encrypt_thread_started = false;
+	}
+
+#endif // PX4_CRYPTO
 }
 
 void *LogWriterFile::run_helper(void *context)
 {
-	px4_prctl(PR_SET_NAME, "log_writer_file", px4_getpid());
+	static constexpr const char *thread_names[(int)LogType::Count] = {
+		"log_writer_file",
+		"log_writer_mission",
+		"log_writer_recorder"
+	};
+
+	WriterThread *writer_thread = static_cast<WriterThread *>(context);
+	px4_prctl(PR_SET_NAME, thread_names[(int)writer_thread->type], px4_getpid());
 
-	static_cast<LogWriterFile *>(context)->run();
+	writer_thread->writer->run(writer_thread->type);
 	return nullptr;
 }
 
-void LogWriterFile::run()
+#if defined(PX4_CRYPTO)
+int LogWriterFile::encrypt_thread_start()
+{
+	pthread_attr_t thr_attr;
+	pthread_attr_init(&thr_attr);
+
+	sched_param param;
+	/* same priority as the writer threads */
+	param.sched_priority = SCHED_PRIORITY_DEFAULT - 40;
+	(void)pthread_attr_setschedparam(&thr_attr, &param);
+
+	pthread_attr_setstacksize(&thr_attr, PX4_STACK_ADJUSTED(1170));
+
+	int ret = pthread_create(&_encrypt_thread, &thr_attr, &LogWriterFile::encrypt_run_helper, this);
+	pthread_attr_destroy(&thr_attr);
+
+	_encrypt_thread_started = ret == 0;
+
+	return ret;
+}
+
+void *LogWriterFile::encrypt_run_helper(void *context)
+{
+	px4_prctl(PR_SET_NAME, "log_writer_crypt", px4_getpid());
+
+	static_cast<LogWriterFile *>(context)->encrypt_run();
+	return nullptr;
+}
+
+void LogWriterFile::encrypt_run()
+{
+	WriterThread &writer_thread = _threads[(int)LogType::Full];
+	LogFileBuffer &buffer = _buffers[(int)LogType::Full];
+
+	pthread_mutex_lock(&writer_thread.mtx);
+
+	while (true) {
+		void *ptr = nullptr;
+		size_t size = buffer._encrypt ? buffer.get_encrypt_ptr(&ptr) : 0;
+
+		// Encrypt in chunks of the write size (so that the writer thread can start while the next chunk is
+		// encrypted), and in multiples of the cipher block size to keep the key stream continuous.
+		size = math::min(size, math::max(_min_write_chunk, _write_block_size));
+		size = (size / _min_blocksize) * _min_blocksize;
+
+		if (size == 0) {
+			// only exit when all the data is encrypted, the writer thread still needs to write it
+			if (_exit_thread.load()) {
+				break;
+			}
+
+			pthread_cond_wait(&writer_thread.cv, &writer_thread.mtx);
+			continue;
+		}
+
+		const uint32_t session = buffer.session();
+		pthread_mutex_unlock(&writer_thread.mtx);
+
+		/* This makes the same assumptions as the inline encryption: the cipher size is the same as the
+		 * input size and the encryption can be done in place. Only this thread and the logger (behind the
+		 * head) access the buffer, the writer thread only reads the encrypted data before it. */
+		size_t out = size;
+
+		perf_begin(_perf_encrypt);
+		pthread_mutex_lock(&_crypto_mtx);
+		_crypto.encrypt_data(_key_idx, (uint8_t *)ptr, size, (uint8_t *)ptr, &out);
+		pthread_mutex_unlock(&_crypto_mtx);
+		perf_end(_perf_encrypt);
+
+		if (out != size) {
+			PX4_ERR("Encryption output size mismatch, logfile corrupted");
+		}
+
+		pthread_mutex_lock(&writer_thread.mtx);
+
+		// the buffer might have been reset in the meantime (write error)
+		if (buffer.session() == session) {
+			buffer.mark_encrypted(size);
+		}
+
+		pthread_cond_broadcast(&writer_thread.cv);
+	}
+
+	pthread_mutex_unlock(&writer_thread.mtx);
+}
+#endif // PX4_CRYPTO
+
+bool LogWriterFile::encryption_pending(const LogFileBuffer &buffer) const
 {
+#if defined(PX4_CRYPTO)
+	return buffer._encrypt && (buffer.unencrypted() >= (size_t)_min_blocksize);
+#else
+	return false;
+#endif // PX4_CRYPTO
+}
+
+void LogWriterFile::run(LogType type)
+{
+	WriterThread &writer_thread = _threads[(int)type];
+	LogFileBuffer &buffer = _buffers[(int)type];
+	pthread_mutex_t &mtx = writer_thread.mtx;
+
 	while (!_exit_thread.load()) {
 		// Outer endless loop
 		// Wait for _should_run flag
 		while (!_exit_thread.load()) {
 			bool start = false;
-			pthread_mutex_lock(&_mtx);
-			pthread_cond_wait(&_cv, &_mtx);
-			start = _buffers[0]._should_run || _buffers[1]._should_run;
-			pthread_mutex_unlock(&_mtx);
+			pthread_mutex_lock(&mtx);
+
+			// the file might already have been started before the thread
+			if (!buffer._should_run) {
+				pthread_cond_wait(&writer_thread.cv, &mtx);
+			}
+
+			start = buffer._should_run;
+			pthread_mutex_unlock(&mtx);
 
 			if (start) {
 				break;
@@ -349,43 +586,55 @@ void LogWriterFile::run()
 		int poll_count = 0;
 		hrt_abstime last_fsync = hrt_absolute_time();
 
-		pthread_mutex_lock(&_mtx);
+		pthread_mutex_lock(&mtx);
 
 		while (true) {
 
 			const hrt_abstime now = hrt_absolute_time();
 
 			/* call fsync periodically to minimize potential loss of data */
-			const bool call_fsync = ++poll_count >= 100 || now - last_fsync > 1_s || _want_fsync.load();
-			_want_fsync.store(false);
+			const bool call_fsync = ++poll_count >= 100 || now - last_fsync > 1_s || writer_thread.want_fsync.load();
+			writer_thread.want_fsync.store(false);
 
 			if (call_fsync) {
 				last_fsync = now;
 				poll_count = 0;
 			}
 
-			constexpr size_t min_available[(int)LogType::Count] = {
-				_min_write_chunk,
-				1 // For the mission log, write as soon as there is data available
-			};
+			// For the other logs, write as soon as there is data available
+			const size_t min_available = (type == LogType::Full) ? math::max(_min_write_chunk, _write_block_size) : 1;
 
-			/* Check all buffers for available data. Mission log is first to avoid drops */
-			int i = (int)LogType::Count - 1;
+			bool is_part;
 
-			while (i >= 0) {
+			do {
 				void *read_ptr;
-				bool is_part;
-				LogFileBuffer &buffer = _buffers[i];
 				size_t available = buffer.get_read_ptr(&read_ptr, &is_part);
 
 #if defined(PX4_CRYPTO)
-				// Split into min blocksize chunks, so it is good for encrypting in pieces
-				available = (available / _min_blocksize) * _min_blocksize;
+
+				if (buffer._encrypt) {
+					// only write what the encryption thread already processed
+					if (available > buffer.encrypted()) {
+						available = buffer.encrypted();
+						is_part = false;
+					}
+
+				} else {
+					// Split into min blocksize chunks, so it is good for encrypting in pieces
+					available = (available / _min_blocksize) * _min_blocksize;
+				}
+
 #endif // PX4_CRYPTO
 
+				// Write the full log in multiples of the write block size, so that the writes stay aligned
+				// (the buffer size is a multiple of it as well). Only the remainder is written when stopping.
+				if ((type == LogType::Full) && buffer._should_run && !is_part) {
+					available = (available / _write_block_size) * _write_block_size;
+				}
+
 				/* if sufficient data available or partial read or terminating, write data */
-				if (available >= min_available[i] || is_part || (!buffer._should_run && available > 0)) {
-					pthread_mutex_unlock(&_mtx);
+				if (available >= min_available || is_part || (!buffer._should_run && available > 0)) {
+					pthread_mutex_unlock(&mtx);
 
 #if defined(PX4_CRYPTO)
 					/* This makes the following assumptions:
@@ -398,13 +647,15 @@ void LogWriterFile::run()
 
 					size_t out = available;
 
-					if (_algorithm != CRYPTO_NONE) {
+					if (_algorithm != CRYPTO_NONE && !buffer._encrypt) {
+						pthread_mutex_lock(&_crypto_mtx);
 						_crypto.encrypt_data(
 							_key_idx,
 							(uint8_t *)read_ptr,
 							available,
 							(uint8_t *)read_ptr,
 							&out);
+						pthread_mutex_unlock(&_crypto_mtx);
 
 						if (out != available) {
 							PX4_ERR("Encryption output size mismatch, logfile corrupted");
@@ -413,17 +664,17 @@ void LogWriterFile::run()
 
 #endif // PX4_CRYPTO
 
-					int written = buffer.write_to_file(read_ptr, available, call_fsync);
+					int written = write_to_file(buffer, read_ptr, available, call_fsync);
 
 					if (written < 0) {
 						// retry once
 						PX4_ERR("write failed errno:%i (%s), retrying", errno, strerror(errno));
 						px4_usleep(10000); // 10 milliseconds
-						written = buffer.write_to_file(read_ptr, available, call_fsync);
+						written = write_to_file(buffer, read_ptr, available, call_fsync);
 					}
 
-					/* buffer.mark_read() requires _mtx to be locked */
-					pthread_mutex_lock(&_mtx);
+					/* buffer.mark_read() requires the lock to be held */
+					pthread_mutex_lock(&mtx);
 
 					if (written >= 0) {
 						/* subtract bytes written from number in buffer (count -= written) */
@@ -431,9 +682,9 @@ void LogWriterFile::run()
 
 						if (!buffer._should_run && written == static_cast<int>(available) && !is_part) {
 							/* Stop only when all data written */
-							pthread_mutex_unlock(&_mtx);
+							pthread_mutex_unlock(&mtx);
 							buffer.close_file();
-							pthread_mutex_lock(&_mtx);
+							pthread_mutex_lock(&mtx);
 							buffer.reset();
 						}
 
@@ -441,37 +692,37 @@ void LogWriterFile::run()
 						PX4_ERR("write failed (%i)", errno);
 						buffer._had_write_error.store(true);
 						buffer._should_run = false;
-						pthread_mutex_unlock(&_mtx);
+						pthread_mutex_unlock(&mtx);
 						buffer.close_file();
-						pthread_mutex_lock(&_mtx);
+						pthread_mutex_lock(&mtx);
 						buffer.reset();
 					}
 
 				} else if (call_fsync && buffer._should_run) {
-					pthread_mutex_unlock(&_mtx);
+					pthread_mutex_unlock(&mtx);
 					buffer.fsync();
-					pthread_mutex_lock(&_mtx);
+					pthread_mutex_lock(&mtx);
 
-				} else if (available == 0 && !buffer._should_run) {
-					pthread_mutex_unlock(&_mtx);
+				} else if (available == 0 && !buffer._should_run && !encryption_pending(buffer)) {
+					pthread_mutex_unlock(&mtx);
 					buffer.close_file();
-					pthread_mutex_lock(&_mtx);
+					pthread_mutex_lock(&mtx);
 					buffer.reset();
 				}
 
 				/* if split into 2 parts, write the second part immediately as well */
-				if (!is_part) {
-					--i;
-				}
-			}
+			} while (is_part);
 
 
-			if (_buffers[0].fd() < 0 && _buffers[1].fd() < 0) {
-				// stop when both files are closed
+			if (buffer.fd() < 0) {
+				// stop when the file is closed
 #if defined(PX4_CRYPTO)
-				/* close the crypto session */
 
-				_crypto.close();
+				/* the crypto session is shared, the other log might still be flushing */
+				pthread_mutex_lock(&_crypto_mtx);
+				release_crypto_session(type);
+				pthread_mutex_unlock(&_crypto_mtx);
+
 #endif // PX4_CRYPTO
 
 				break;
@@ -482,17 +733,121 @@ void LogWriterFile::run()
 			 * and calling pthread_cond_wait() will still wait for the next notify(). But this is generally
 			 * not an issue because notify() is called regularly.
 			 * If the logger was switched off in the meantime, do not wait for data, instead run this loop
-			 * once more to write remaining data and close the file. */
-			if (_buffers[0]._should_run || _buffers[1]._should_run) {
-				pthread_cond_wait(&_cv, &_mtx);
+			 * once more to write remaining data and close the file (unless the encryption thread still
+			 * has to process data, it notifies when done). */
+			if (buffer._should_run || encryption_pending(buffer)) {
+				pthread_cond_wait(&writer_thread.cv, &mtx);
 			}
 		}
 
 		// go back to idle
-		pthread_mutex_unlock(&_mtx);
+		pthread_mutex_unlock(&mtx);
+	}
+}
+
+ssize_t LogWriterFile::write_to_file(LogFileBuffer &buffer, const void *data, size_t size, bool call_fsync)
+{
+#if defined(CONFIG_LOGGER_COMPRESSION)
+
+	if (buffer._compress) {
+		return write_compressed(buffer, static_cast<const uint8_t *>(data), size, call_fsync);
 	}
+
+#endif // CONFIG_LOGGER_COMPRESSION
+
+	return buffer.write_to_file(data, size, call_fsync);
 }
 
+#if defined(CONFIG_LOGGER_COMPRESSION)
+ssize_t LogWriterFile::write_compressed(LogFileBuffer &buffer, const uint8_t *data, size_t size, bool call_fsync)
+{
+	size_t remaining = size;
+
+	if (buffer._uncompressed_remaining > 0) {
+		const size_t n = math::min(remaining, buffer._uncompressed_remaining);
+
+		if (buffer.write_to_file(data, n, false) != (ssize_t)n) {
+			return -1;
+		}
+
+		buffer._uncompressed_remaining -= n;
+		data += n;
+		remaining -= n;
+	}
+
+	size_t compressed_count = 0;
+
+	while (remaining > 0) {
+		const size_t block_size = math::min(remaining, _compression_block_size);
+		uint8_t *block = &_compressed_buffer[compressed_count];
+		uint8_t *out = &block[_compression_block_header_size];
+		const size_t out_size = _compression_block_max_size - _compression_block_header_size;
+		size_t sunk_total = 0;
+		size_t out_count = 0;
+		bool ok = true;
+
+		heatshrink_encoder_reset(&_hse);
+
+		while (ok && sunk_total < block_size) {
+			size_t sunk = 0;
+			ok = heatshrink_encoder_sink(&_hse, const_cast<uint8_t *>(&data[sunk_total]), block_size - sunk_total,
+						     &sunk) == HSER_SINK_OK;
+			sunk_total += sunk;
+
+			HSE_poll_res pres;
+
+			do {
+				size_t polled = 0;
+				pres = heatshrink_encoder_poll(&_hse, &out[out_count], out_size - out_count, &polled);
+				out_count += polled;
+			} while (pres == HSER_POLL_MORE);
+
+			ok = ok && (pres == HSER_POLL_EMPTY);
+		}
+
+		while (ok && heatshrink_encoder_finish(&_hse) == HSER_FINISH_MORE) {
+			HSE_poll_res pres;
+
+			do {
+				size_t polled = 0;
+				pres = heatshrink_encoder_poll(&_hse, &out[out_count], out_size - out_count, &polled);
+				out_count += polled;
+			} while (pres == HSER_POLL_MORE);
+
+			ok = (pres == HSER_POLL_EMPTY);
+		}
+
+		if (!ok) {
+			PX4_ERR("compression failed");
+			return -1;
+		}
+
+		block[0] = 0xA5;
+		block[1] = 0x5A;
+		block[2] = (uint8_t)out_count;
+		block[3] = (uint8_t)(out_count >> 8);
+		block[4] = (uint8_t)block_size;
+		block[5] = (uint8_t)(block_size >> 8);
+		compressed_count += _compression_block_header_size + out_count;
+
+		data += block_size;
+		remaining -= block_size;
+
+		// write in chunks of at least _min_write_chunk
+		if ((compressed_count >= _min_write_chunk) || (remaining == 0)) {
+			if (buffer.write_to_file(_compressed_buffer, compressed_count, call_fsync && (remaining == 0))
+			    != (ssize_t)compressed_count) {
+				return -1;
+			}
+
+			compressed_count = 0;
+		}
+	}
+
+	return size;
+}
+#endif // CONFIG_LOGGER_COMPRESSION
+
 int LogWriterFile::write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start)
 {
 	if (_need_reliable_transfer) {
@@ -561,6 +916,15 @@ int LogWriterFile::write(LogType type, void *ptr, size_t size, uint64_t dropout_
 	return 0;
 }
 
+void *LogWriterFile::reserve_message(LogType type, size_t size)
+{
+	if (!is_started(type)) {
+		return nullptr;
+	}
+
+	return _buffers[(int)type].reserve(size);
+}
+
 const char *log_type_str(LogType type)
 {
 	switch (type) {
@@ -568,6 +932,8 @@ const char *log_type_str(LogType type)
 
 	case LogType::Mission: return "mission";
 
+	case LogType::FlightRecorder: return "flight recorder";
+
 	case LogType::Count: break;
 	}
 
@@ -575,11 +941,12 @@ const char *log_type_str(LogType type)
 }
 
 LogWriterFile::LogFileBuffer::LogFileBuffer(size_t log_buffer_desired_size, size_t log_buffer_min_size,
-		perf_counter_t perf_write, perf_counter_t perf_fsync) :
+		perf_counter_t perf_write, perf_counter_t perf_fsync, perf_counter_t perf_write_latency) :
 	_buffer_size(log_buffer_desired_size),
 	_buffer_size_min(log_buffer_min_size),
 	_perf_write(perf_write),
-	_perf_fsync(perf_fsync)
+	_perf_fsync(perf_fsync),
+	_perf_write_latency(perf_write_latency)
 {
 }
 
@@ -593,6 +960,7 @@ LogWriterFile::LogFileBuffer::~LogFileBuffer()
 
 	perf_free(_perf_write);
 	perf_free(_perf_fsync);
+	perf_free(_perf_write_latency);
 }
 
 void LogWriterFile::LogFileBuffer::write_no_check(void *ptr, size_t size)
@@ -616,8 +984,35 @@ void LogWriterFile::LogFileBuffer::write_no_check(void *ptr, size_t size)
 	memcpy(&(_buffer[_head]), &(buffer_c[n]), p);
 	_head = (_head + p) % _buffer_size;
 	_count += size;
+	_stream_offset += size;
 }
 
+void *LogWriterFile::LogFileBuffer::reserve(size_t size)
+{
+	// the free space up to the end of the buffer (or up to the unread data)
+	if ((size > available()) || (size > _buffer_size - _head)) {
+		return nullptr;
+	}
+
+	return &_buffer[_head];
+}
+
+#if defined(PX4_CRYPTO)
+size_t LogWriterFile::LogFileBuffer::get_encrypt_ptr(void **ptr) const
+{
+	size_t start = _head + _buffer_size - _count + _encrypted;
+
+	if (start >= _buffer_size) {
+		start -= _buffer_size;
+	}
+
+	*ptr = &_buffer[start];
+
+	// up to the end of the buffer if the unencrypted data wraps around
+	return math::min(_count - _encrypted, _buffer_size - start);
+}
+#endif // PX4_CRYPTO
+
 size_t LogWriterFile::LogFileBuffer::get_read_ptr(void **ptr, bool *is_part)
 {
 	// bytes available to read
@@ -636,7 +1031,7 @@ size_t LogWriterFile::LogFileBuffer::get_read_ptr(void **ptr, bool *is_part)
 	}
 }
 
-bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
+bool LogWriterFile::LogFileBuffer::start_log(const char *filename, size_t preallocate_size, size_t write_block_size)
 {
 	_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
 	_had_write_error.store(false);
@@ -646,6 +1041,24 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 		return false;
 	}
 
+	// Allocate the file clusters now instead of during the flight, the file is trimmed when closing
+	_preallocated = false;
+
+	if (preallocate_size > 0) {
+#if defined(__PX4_LINUX)
+		const int ret = posix_fallocate(_fd, 0, preallocate_size);
+#else
+		const int ret = (ftruncate(_fd, preallocate_size) == 0) ? 0 : errno;
+#endif
+
+		if (ret == 0) {
+			_preallocated = true;
+
+		} else {
+			PX4_WARN("preallocating %zu bytes failed (%i)", preallocate_size, ret);
+		}
+	}
+
 	if (_buffer == nullptr) {
 		_buffer_size = math::max(_buffer_size, _buffer_size_min);
 
@@ -666,6 +1079,11 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 
 #endif // __PX4_NUTTX
 
+		// a multiple of the write block size keeps the writes aligned when wrapping around
+		if (_buffer_size >= _buffer_size_min + write_block_size) {
+			_buffer_size = _buffer_size / write_block_size * write_block_size;
+		}
+
 		_buffer = (uint8_t *) px4_cache_aligned_alloc(_buffer_size);
 
 		if (_buffer == nullptr) {
@@ -679,7 +1097,11 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 	// Clear buffer and counters
 	_head = 0;
 	_count = 0;
+#if defined(PX4_CRYPTO)
+	_encrypted = 0;
+#endif // PX4_CRYPTO
 	_total_written = 0;
+	_stream_offset = 0;
 
 	_should_run = true;
 
@@ -696,7 +1118,9 @@ void LogWriterFile::LogFileBuffer::fsync() const
 ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync) const
 {
 	perf_begin(_perf_write);
+	perf_begin(_perf_write_latency);
 	ssize_t ret = ::write(_fd, buffer, size);
+	perf_end(_perf_write_latency);
 	perf_end(_perf_write);
 
 	if (call_fsync) {
@@ -709,6 +1133,15 @@ ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t s
 void LogWriterFile::LogFileBuffer::close_file()
 {
 	if (_fd >= 0) {
+		if (_preallocated) {
+			// trim the preallocated space that was not used
+			const off_t file_size = lseek(_fd, 0, SEEK_CUR);
+
+			if ((file_size < 0) || (ftruncate(_fd, file_size) != 0)) {
+				PX4_WARN("trimming log file failed (%i)", errno);
+			}
+		}
+
 		int res = close(_fd);
 
 		if (res) {
@@ -725,6 +1158,10 @@ void LogWriterFile::LogFileBuffer::reset()
 	_head = 0;
 	_count = 0;
 	_fd = -1;
+#if defined(PX4_CRYPTO)
+	_encrypted = 0;
+	++_session;
+#endif // PX4_CRYPTO
 }
 
 }
@@ -39,6 +39,12 @@
 #include <pthread.h>
 #include <drivers/drv_hrt.h>
 #include <perf/perf_counter.h>
+#include <mathlib/mathlib.h>
+
+#if defined(CONFIG_LOGGER_COMPRESSION)
+# define HEATSHRINK_DYNAMIC_ALLOC 0
+# include <lib/heatshrink/heatshrink/heatshrink_encoder.h>
+#endif // CONFIG_LOGGER_COMPRESSION
 
 #if defined(PX4_CRYPTO)
 # include <px4_platform_common/crypto.h>
@@ -56,6 +62,7 @@ namespace logger
 enum class LogType {
 	Full = 0, //!< Normal, full size log
 	Mission,  //!< reduced mission log (e.g. for geotagging)
+	FlightRecorder, //!< dump of the in-RAM flight recorder (full rate data before a trigger)
 
 	Count
 };
@@ -75,14 +82,18 @@ public:
 	bool init();
 
 	/**
-	 * start the thread
+	 * start the writer thread of the full log (the others are started with their first log file)
 	 * @return 0 on success, error number otherwise (@see pthread_create)
 	 */
 	int thread_start();
 
 	void thread_stop();
 
-	bool start_log(LogType type, const char *filename);
+	/**
+	 * @param register_hardfault register the full log file with the hardfault handler (so that crash logs are
+	 *                           appended to it). Disable for files that are not real logs (e.g. benchmarks).
+	 */
+	bool start_log(LogType type, const char *filename, bool register_hardfault = true);
 
 	void stop_log(LogType type);
 
@@ -91,19 +102,43 @@ public:
 	/** @see LogWriter::write_message() */
 	int write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start = 0);
 
+	/**
+	 * Reserve contiguous space in the buffer to construct a message in place, which avoids copying it
+	 * through an intermediate buffer. The message is added with commit_message(), the lock must be
+	 * held in between.
+	 * @param size space to reserve (can be larger than the message)
+	 * @return pointer to the space, nullptr if not started or not enough contiguous space is available
+	 */
+	void *reserve_message(LogType type, size_t size);
+
+	/**
+	 * Add a message constructed in the space returned by reserve_message()
+	 * @param size message size, at most the reserved size
+	 */
+	void commit_message(LogType type, size_t size) { _buffers[(int)type].commit(size); }
+
+	/**
+	 * lock all buffers (always in the same order)
+	 */
 	void lock()
 	{
-		pthread_mutex_lock(&_mtx);
+		for (int i = 0; i < (int)LogType::Count; ++i) {
+			pthread_mutex_lock(&_threads[i].mtx);
+		}
 	}
 
 	void unlock()
 	{
-		pthread_mutex_unlock(&_mtx);
+		for (int i = (int)LogType::Count - 1; i >= 0; --i) {
+			pthread_mutex_unlock(&_threads[i].mtx);
+		}
 	}
 
 	void notify()
 	{
-		pthread_cond_broadcast(&_cv);
+		for (int i = 0; i < (int)LogType::Count; ++i) {
+			pthread_cond_broadcast(&_threads[i].cv);
+		}
 	}
 
 	size_t get_total_written(LogType type) const
@@ -111,6 +146,14 @@ public:
 		return _buffers[(int)type].total_written();
 	}
 
+	/**
+	 * Get the file offset (of the uncompressed log) where the next message will be written to
+	 */
+	uint64_t get_file_offset(LogType type) const
+	{
+		return _buffers[(int)type].stream_offset();
+	}
+
 	size_t get_buffer_size(LogType type) const
 	{
 		return _buffers[(int)type].buffer_size();
@@ -124,7 +167,9 @@ public:
 	void set_need_reliable_transfer(bool need_reliable)
 	{
 		if (!need_reliable && _need_reliable_transfer) {
-			_want_fsync.store(true);
+			for (int i = 0; i < (int)LogType::Count; ++i) {
+				_threads[i].want_fsync.store(true);
+			}
 		}
 
 		_need_reliable_transfer = need_reliable;
@@ -135,9 +180,19 @@ public:
 		return _need_reliable_transfer;
 	}
 
+	/**
+	 * Get the histogram of the file write() latencies (only available for the full log)
+	 * @return 0 on success, -1 otherwise (@see perf_histogram_buckets())
+	 */
+	int get_write_latency_histogram(LogType type, uint32_t buckets[PERF_HISTOGRAM_BUCKETS]) const
+	{
+		return perf_histogram_buckets(_buffers[(int)type].perf_write_latency(), buckets);
+	}
+
 	bool had_write_error() const { return _buffers[(int)LogType::Full]._had_write_error.load(); }
 
-	pthread_t thread_id() const { return _thread; }
+	/** thread id of the full log writer thread */
+	pthread_t thread_id() const { return _threads[(int)LogType::Full].thread; }
 
 #if defined(PX4_CRYPTO)
 	void set_encryption_parameters(px4_crypto_algorithm_t algorithm, uint8_t key_idx,  uint8_t exchange_key_idx)
@@ -148,10 +203,38 @@ public:
 	}
 #endif // PX4_CRYPTO
 
+	/**
+	 * Set the file options for logs started afterwards
+	 * @param preallocate_size preallocate the file to this size (trimmed when closing), 0 to disable
+	 * @param write_block_size write the full log in multiples of this size (e.g. the SD card erase block size)
+	 */
+	void set_file_options(size_t preallocate_size, size_t write_block_size)
+	{
+		_preallocate_size = preallocate_size;
+		_write_block_size = math::max(write_block_size, (size_t)1);
+	}
+
+#if defined(CONFIG_LOGGER_COMPRESSION)
+	/**
+	 * Enable compression for full logs started afterwards (the encoder state belongs to the full log writer thread)
+	 */
+	void set_compression(bool enable) { _compression = enable; }
+#endif // CONFIG_LOGGER_COMPRESSION
+
 private:
+	struct WriterThread;
+
 	static void *run_helper(void *);
 
-	void run();
+	int thread_start(LogType type);
+
+	/**
+	 * writer thread main loop for the buffer of a single log type
+	 */
+	void run(LogType type);
+
+	void lock(LogType type) { pthread_mutex_lock(&_threads[(int)type].mtx); }
+	void unlock(LogType type) { pthread_mutex_unlock(&_threads[(int)type].mtx); }
 
 	/**
 	 * permanently store the ulog file name for the hardfault crash handler, so that it can
@@ -166,6 +249,19 @@ private:
 	 */
 	int write(LogType type, void *ptr, size_t size, uint64_t dropout_start);
 
+	class LogFileBuffer;
+
+	/**
+	 * write data from the buffer to its file (from the writer thread, w/o holding the lock)
+	 * @return number of bytes of data written, <0 on error
+	 */
+	ssize_t write_to_file(LogFileBuffer &buffer, const void *data, size_t size, bool call_fsync);
+
+	/**
+	 * whether the encryption thread still has data of the buffer to process (the lock must be held)
+	 */
+	bool encryption_pending(const LogFileBuffer &buffer) const;
+
 	/* 512 didn't seem to work properly, 4096 should match the FAT cluster size */
 	static constexpr size_t	_min_write_chunk = 4096;
 
@@ -173,11 +269,15 @@ private:
 	{
 	public:
 		LogFileBuffer(size_t log_buffer_desired_size, size_t log_buffer_min_size,
-			      perf_counter_t perf_write, perf_counter_t perf_fsync);
+			      perf_counter_t perf_write, perf_counter_t perf_fsync, perf_counter_t perf_write_latency = nullptr);
 
 		~LogFileBuffer();
 
-		bool start_log(const char *filename);
+		/**
+		 * @param preallocate_size preallocate the file to this size, 0 to disable
+		 * @param write_block_size the buffer size is rounded to a multiple of this when allocated
+		 */
+		bool start_log(const char *filename, size_t preallocate_size, size_t write_block_size);
 
 		void close_file();
 
@@ -190,6 +290,16 @@ private:
 		 */
 		inline void write_no_check(void *ptr, size_t size);
 
+		/**
+		 * Get a pointer to size bytes of contiguous free space, nullptr if not available
+		 */
+		void *reserve(size_t size);
+
+		/**
+		 * Add size bytes written to the space returned by reserve()
+		 */
+		void commit(size_t size) { _head = (_head + size) % _buffer_size; _count += size; _stream_offset += size; }
+
 		size_t available() const { return _buffer_size - _count; }
 
 		int fd() const { return _fd; }
@@ -198,14 +308,46 @@ private:
 
 		inline void fsync() const;
 
-		void mark_read(size_t n) { _count -= n; _total_written += n; }
+		void mark_read(size_t n)
+		{
+			_count -= n;
+			_total_written += n;
+#if defined(PX4_CRYPTO)
+			_encrypted -= math::min(n, _encrypted);
+#endif // PX4_CRYPTO
+		}
 
 		size_t total_written() const { return _total_written; }
+		uint64_t stream_offset() const { return _stream_offset; }
 		size_t buffer_size() const { return _buffer_size; }
 		size_t count() const { return _count; }
+		perf_counter_t perf_write_latency() const { return _perf_write_latency; }
 
 		bool _should_run = false;
 		px4::atomic_bool _had_write_error{false};
+
+#if defined(CONFIG_LOGGER_COMPRESSION)
+		bool _compress = false;
+		size_t _uncompressed_remaining = 0; ///< bytes at the file start that are not compressed
+#endif // CONFIG_LOGGER_COMPRESSION
+
+#if defined(PX4_CRYPTO)
+		/**
+		 * Get the contiguous data following the already encrypted data
+		 * @return number of bytes not encrypted yet at ptr
+		 */
+		size_t get_encrypt_ptr(void **ptr) const;
+
+		void mark_encrypted(size_t n) { _encrypted = math::min(_encrypted + n, _count); }
+
+		size_t encrypted() const { return _encrypted; }
+		size_t unencrypted() const { return _count - _encrypted; }
+
+		/** incremented on every reset(), so that the encryption thread can detect that its data is gone */
+		uint32_t session() const { return _session; }
+
+		bool _encrypt = false; ///< encrypted by the encryption thread, only encrypted data is written
+#endif // PX4_CRYPTO
 	private:
 		size_t _buffer_size;
 		const size_t _buffer_size_min;
@@ -214,23 +356,88 @@ private:
 		size_t _head = 0; ///< next position to write to
 		size_t _count = 0; ///< number of bytes in _buffer to be written
 		size_t _total_written = 0;
+		uint64_t _stream_offset = 0; ///< total number of bytes written to the buffer (uncompressed file offset)
+		bool _preallocated = false;
 		perf_counter_t _perf_write;
 		perf_counter_t _perf_fsync;
+		perf_counter_t _perf_write_latency; ///< histogram of the write latencies
+
+#if defined(PX4_CRYPTO)
+		size_t _encrypted = 0; ///< number of bytes from the read position on that are encrypted
+		uint32_t _session = 0;
+#endif // PX4_CRYPTO
 	};
 
 	LogFileBuffer _buffers[(int)LogType::Count];
 
+	/**
+	 * Each log type is written by its own thread, with its own lock, so that a slow storage device
+	 * (e.g. the mission log on a different medium) does not block the writes of the other log.
+	 */
+	struct WriterThread {
+		LogWriterFile *writer{nullptr};
+		LogType type{LogType::Full};
+		pthread_mutex_t mtx; ///< protects the buffer of this type
+		pthread_cond_t cv;
+		pthread_t thread{0};
+		bool started{false};
+		px4::atomic_bool want_fsync{false};
+	};
+
+	WriterThread _threads[(int)LogType::Count];
+
 	px4::atomic_bool	_exit_thread{false};
 	bool			_need_reliable_transfer{false};
-	px4::atomic_bool	_want_fsync{false};
-	pthread_mutex_t		_mtx;
-	pthread_cond_t		_cv;
-	pthread_t _thread = 0;
+
+	size_t			_preallocate_size{0};
+	size_t			_write_block_size{_min_write_chunk};
+
+#if defined(CONFIG_LOGGER_COMPRESSION)
+	/**
+	 * Compress the data in independent blocks and write them to the file
+	 * @return number of bytes of data written, -1 on error
+	 */
+	ssize_t write_compressed(LogFileBuffer &buffer, const uint8_t *data, size_t size, bool call_fsync);
+
+	/* Every block (of up to 1 kB uncompressed) consists of a marker, the compressed and uncompressed size
+	 * (uint16 LE) and the heatshrink data. At most 9 bits are needed per input byte. */
+	static constexpr size_t	_compression_block_size = 1024;
+	static constexpr size_t	_compression_block_header_size = 6;
+	static constexpr size_t	_compression_block_max_size = _compression_block_header_size
+			+ (_compression_block_size * 9 + 7) / 8 + 1;
+	static constexpr size_t	_compressed_buffer_size = _min_write_chunk + _compression_block_max_size;
+
+	bool			_compression{false};
+	heatshrink_encoder	_hse;
+	uint8_t			*_compressed_buffer{nullptr};
+#endif // CONFIG_LOGGER_COMPRESSION
 
 #if defined(PX4_CRYPTO)
 	bool init_logfile_encryption(const LogType type);
-	PX4Crypto _crypto;
-	int _min_blocksize;
+
+	/**
+	 * Start the encryption thread of the full log. It encrypts the buffer in place ahead of the writer
+	 * thread, so that encryption and file writes of the previous block overlap.
+	 */
+	int encrypt_thread_start();
+
+	static void *encrypt_run_helper(void *context);
+
+	void encrypt_run();
+
+	/**
+	 * Drop the log type from the users of the crypto session and close it with the last one.
+	 * Must be called with _crypto_mtx held.
+	 */
+	void release_crypto_session(const LogType type);
+
+	PX4Crypto _crypto; ///< shared by all log types, protected by _crypto_mtx
+	pthread_mutex_t _crypto_mtx;
+	uint8_t _crypto_users{0}; ///< bitmask of the log types using _crypto, protected by _crypto_mtx
+	pthread_t _encrypt_thread{0};
+	bool _encrypt_thread_started{false};
+	perf_counter_t _perf_encrypt{nullptr};
+	int _min_blocksize{1};
 	px4_crypto_algorithm_t _algorithm;
 	uint8_t _key_idx;
 	uint8_t _exchange_key_idx;
@@ -75,6 +75,8 @@ void LogWriterMavlink::start_log()
 	_ulog_stream_data.msg_sequence = 0;
 	_ulog_stream_data.length = 0;
 	_ulog_stream_data.first_message_offset = 0;
+	_num_unacked = 0;
+	_window_size = 1;
 
 	_is_started = true;
 }
@@ -122,6 +124,12 @@ void LogWriterMavlink::set_need_reliable_transfer(bool need_reliable)
 			// make sure to send previous data using reliable transfer
 			publish_message();
 		}
+
+		// all the reliable data must be acked before continuing with unreliable data
+		if (_is_started && !wait_for_acks(0)) {
+			PX4_ERR("Ack timeout. Stopping mavlink log");
+			stop_log();
+		}
 	}
 
 	_need_reliable_transfer = need_reliable;
@@ -134,54 +142,68 @@ int LogWriterMavlink::publish_message()
 
 	if (_need_reliable_transfer) {
 		_ulog_stream_data.flags = _ulog_stream_data.FLAGS_NEED_ACK;
+
+		// we need to wait for space in the ack window. Note that this blocks the main logger thread, so if a file
+		// logging is already running, it will miss samples.
+		if (!wait_for_acks(_window_size - 1)) {
+			PX4_ERR("Ack timeout. Stopping mavlink log");
+			stop_log();
+			return -2;
+		}
+
+		if (_num_unacked == 0) {
+			_first_unacked_sequence = _ulog_stream_data.msg_sequence;
+		}
+
+		++_num_unacked;
 	}
 
 	_ulog_stream_pub.publish(_ulog_stream_data);
 
-	if (_need_reliable_transfer) {
-		// we need to wait for an ack. Note that this blocks the main logger thread, so if a file logging
-		// is already running, it will miss samples.
-		px4_pollfd_struct_t fds[1];
-		fds[0].fd = _ulog_stream_ack_sub;
-		fds[0].events = POLLIN;
-		bool got_ack = false;
-		const int timeout_ms = ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES;
+	_ulog_stream_data.msg_sequence++;
+	_ulog_stream_data.length = 0;
+	_ulog_stream_data.first_message_offset = 255;
+	return 0;
+}
 
-		hrt_abstime started = hrt_absolute_time();
+bool LogWriterMavlink::wait_for_acks(int max_unacked)
+{
+	px4_pollfd_struct_t fds[1];
+	fds[0].fd = _ulog_stream_ack_sub;
+	fds[0].events = POLLIN;
+	const int timeout_ms = ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES;
 
-		do {
-			int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
+	hrt_abstime started = hrt_absolute_time();
 
-			if (ret <= 0) {
-				break;
-			}
+	while (_num_unacked > max_unacked) {
+		if (hrt_elapsed_time(&started) / 1000 >= timeout_ms) {
+			return false;
+		}
 
-			if (fds[0].revents & POLLIN) {
-				ulog_stream_ack_s ack;
-				orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
+		int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
 
-				if (ack.msg_sequence == _ulog_stream_data.msg_sequence) {
-					got_ack = true;
-				}
+		if (ret <= 0 || !(fds[0].revents & POLLIN)) {
+			return false;
+		}
 
-			} else {
-				break;
-			}
-		} while (!got_ack && hrt_elapsed_time(&started) / 1000 < timeout_ms);
+		ulog_stream_ack_s ack;
+		orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
 
-		if (!got_ack) {
-			PX4_ERR("Ack timeout. Stopping mavlink log");
-			stop_log();
-			return -2;
+		// acks are cumulative, so it does not matter if we miss one
+		const uint16_t num_acked = ack.msg_sequence - _first_unacked_sequence + 1;
+
+		if (num_acked <= _num_unacked) {
+			_num_unacked -= num_acked;
+			_first_unacked_sequence = ack.msg_sequence + 1;
 		}
 
-		PX4_DEBUG("got ack in %i ms", (int)(hrt_elapsed_time(&started) / 1000));
+		if (ack.window_size > 0) {
+			_window_size = math::min(ack.window_size, (uint8_t)ulog_stream_s::ORB_QUEUE_LENGTH);
+		}
 	}
 
-	_ulog_stream_data.msg_sequence++;
-	_ulog_stream_data.length = 0;
-	_ulog_stream_data.first_message_offset = 255;
-	return 0;
+	PX4_DEBUG("got acks in %i ms", (int)(hrt_elapsed_time(&started) / 1000));
+	return true;
 }
 
 }
@@ -73,12 +73,21 @@ public:
 
 private:
 
-	/** publish message, wait for ack if needed & reset message */
+	/** publish message, wait for space in the ack window if needed & reset message */
 	int publish_message();
 
+	/**
+	 * wait for acks until at most max_unacked messages are in flight
+	 * @return true on success, false on timeout
+	 */
+	bool wait_for_acks(int max_unacked);
+
 	ulog_stream_s _ulog_stream_data{};
 	uORB::Publication<ulog_stream_s> _ulog_stream_pub{ORB_ID(ulog_stream)};
 	int _ulog_stream_ack_sub{-1};
+	uint16_t _first_unacked_sequence{0};
+	uint8_t _num_unacked{0}; ///< number of acked messages in flight
+	uint8_t _window_size{1}; ///< maximum number of acked messages in flight, announced by the receiver
 	bool _need_reliable_transfer{false};
 	bool _is_started{false};
 };
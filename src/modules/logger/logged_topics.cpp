@@ -52,6 +52,7 @@ void LoggedTopics::add_default_topics()
 	add_optional_topic("airspeed_validated", 200);
 	add_optional_topic("autotune_attitude_control_status", 100);
 	add_topic_multi("battery_info", 5000, 3);
+	add_optional_topic("battery_pack_status", 1000);
 	add_optional_topic("camera_capture");
 	add_optional_topic("camera_trigger");
 	add_topic("cellular_status", 200);
@@ -99,6 +100,7 @@ void LoggedTopics::add_default_topics()
 	add_topic("offboard_control_mode", 100);
 	add_topic("onboard_computer_status", 10);
 	add_topic("parameter_update");
+	add_topic("perf_counter_snapshot");
 	add_topic("position_controller_status", 500);
 	add_topic("position_controller_landing_status", 100);
 	add_optional_topic("pure_pursuit_status", 100);
@@ -151,6 +153,7 @@ void LoggedTopics::add_default_topics()
 	add_topic("vehicle_status");
 	add_optional_topic("vtol_vehicle_status", 200);
 	add_topic("wind", 1000);
+	add_optional_topic("work_item_timing");
 	add_topic("fixed_wing_lateral_setpoint");
 	add_topic("fixed_wing_longitudinal_setpoint");
 	add_topic("longitudinal_control_configuration");
@@ -163,6 +166,7 @@ void LoggedTopics::add_default_topics()
 	add_optional_topic_multi("actuator_outputs", 100, 3);
 	add_optional_topic_multi("airspeed_wind", 1000, 4);
 	add_optional_topic_multi("control_allocator_status", 200, 2);
+	add_optional_topic_multi("control_latency", 1000, 2);
 	add_optional_topic_multi("rate_ctrl_status", 200, 2);
 	add_optional_topic_multi("sensor_hygrometer", 500, 4);
 	add_optional_topic_multi("rpm", 200);
@@ -342,7 +346,7 @@ void LoggedTopics::add_vision_and_avoidance_topics()
 	add_topic("collision_constraints");
 	add_topic_multi("distance_sensor");
 	add_topic("obstacle_distance_fused");
-	add_topic("obstacle_distance");
+	add_topic_multi("obstacle_distance");
 	add_topic("vehicle_mocap_odometry", 30);
 	add_topic("vehicle_visual_odometry", 30);
 }
@@ -375,6 +379,12 @@ void LoggedTopics::add_high_rate_sensors_topics()
 	add_topic_multi("sensor_mag", 0, 4);
 }
 
+void LoggedTopics::add_high_rate_gyro_compact_topics()
+{
+	// full rate filtered angular velocity at about half the size of vehicle_angular_velocity (e.g. for vibration analysis)
+	add_topic("vehicle_angular_velocity_compact");
+}
+
 void LoggedTopics::add_mavlink_tunnel()
 {
 	add_topic("mavlink_tunnel");
@@ -474,6 +484,7 @@ bool LoggedTopics::add_topic(const orb_metadata *topic, uint16_t interval_ms, ui
 	RequestedSubscription &sub = _subscriptions.sub[_subscriptions.count++];
 	sub.interval_ms = interval_ms;
 	sub.instance = instance;
+	sub.delta_encoding = false;
 	sub.id = static_cast<ORB_ID>(topic->o_id);
 	return true;
 }
@@ -540,9 +551,134 @@ bool LoggedTopics::initialize_logged_topics(SDLogProfileMask profile)
 		initialize_configured_topics(profile);
 	}
 
+	enable_delta_encoding("vehicle_status");
+	enable_delta_encoding("battery_status");
+	enable_delta_encoding("estimator_status_flags");
+
+	initialize_topic_priorities();
+
 	return _subscriptions.count > 0;
 }
 
+void LoggedTopics::enable_delta_encoding(const char *name)
+{
+	for (int i = 0; i < _subscriptions.count; ++i) {
+		RequestedSubscription &sub = _subscriptions.sub[i];
+
+		if (strcmp(get_orb_meta(sub.id)->o_name, name) == 0) {
+			sub.delta_encoding = true;
+		}
+	}
+}
+
+void LoggedTopics::set_priority(const char *name, TopicPriority priority)
+{
+	for (int i = 0; i < _subscriptions.count; ++i) {
+		RequestedSubscription &sub = _subscriptions.sub[i];
+
+		if (strcmp(get_orb_meta(sub.id)->o_name, name) == 0) {
+			sub.priority = priority;
+		}
+	}
+}
+
+void LoggedTopics::initialize_topic_priorities()
+{
+	// state and events needed to understand any flight
+	set_priority("actuator_armed", TopicPriority::High);
+	set_priority("battery_status", TopicPriority::High);
+	set_priority("failsafe_flags", TopicPriority::High);
+	set_priority("failure_detector_status", TopicPriority::High);
+	set_priority("home_position", TopicPriority::High);
+	set_priority("mission_result", TopicPriority::High);
+	set_priority("vehicle_command", TopicPriority::High);
+	set_priority("vehicle_command_ack", TopicPriority::High);
+	set_priority("vehicle_land_detected", TopicPriority::High);
+	set_priority("vehicle_status", TopicPriority::High);
+
+	// diagnostics and raw sensor data
+	set_priority("cellular_status", TopicPriority::Low);
+	set_priority("cpuload", TopicPriority::Low);
+	set_priority("debug_array", TopicPriority::Low);
+	set_priority("debug_key_value", TopicPriority::Low);
+	set_priority("debug_value", TopicPriority::Low);
+	set_priority("debug_vect", TopicPriority::Low);
+	set_priority("mavlink_tunnel", TopicPriority::Low);
+	set_priority("perf_counter_snapshot", TopicPriority::Low);
+	set_priority("radio_status", TopicPriority::Low);
+	set_priority("rtl_time_estimate", TopicPriority::Low);
+	set_priority("satellite_info", TopicPriority::Low);
+	set_priority("sensor_accel", TopicPriority::Low);
+	set_priority("sensor_baro", TopicPriority::Low);
+	set_priority("sensor_gyro", TopicPriority::Low);
+	set_priority("sensor_mag", TopicPriority::Low);
+	set_priority("sensors_status_imu", TopicPriority::Low);
+	set_priority("telemetry_status", TopicPriority::Low);
+}
+
+int LoggedTopics::enable_flight_recorder(const char *name)
+{
+	int num_selected = 0;
+
+	for (int i = 0; i < _subscriptions.count; ++i) {
+		RequestedSubscription &sub = _subscriptions.sub[i];
+
+		if (strcmp(get_orb_meta(sub.id)->o_name, name) == 0) {
+			sub.flight_recorder = true;
+			++num_selected;
+		}
+	}
+
+	return num_selected;
+}
+
+int LoggedTopics::initialize_flight_recorder_topics()
+{
+	int num_selected = 0;
+
+	FILE *fp = fopen(PX4_STORAGEDIR "/etc/logging/recorder_topics.txt", "r");
+
+	if (fp) {
+		// one topic name per line
+		char line[80];
+
+		while (fgets(line, sizeof(line), fp) != nullptr) {
+			char topic_name[80];
+
+			if ((strlen(line) < 2) || (line[0] == '#') || sscanf(line, "%79s", topic_name) != 1) {
+				continue;
+			}
+
+			const int n = enable_flight_recorder(topic_name);
+
+			if (n == 0) {
+				PX4_ERR("flight recorder: %s is not logged", topic_name);
+			}
+
+			num_selected += n;
+		}
+
+		fclose(fp);
+
+		if (num_selected > 0) {
+			return num_selected;
+		}
+	}
+
+	num_selected += enable_flight_recorder("actuator_motors");
+	num_selected += enable_flight_recorder("actuator_outputs");
+	num_selected += enable_flight_recorder("failsafe_flags");
+	num_selected += enable_flight_recorder("sensor_combined");
+	num_selected += enable_flight_recorder("vehicle_angular_velocity");
+	num_selected += enable_flight_recorder("vehicle_attitude");
+	num_selected += enable_flight_recorder("vehicle_attitude_setpoint");
+	num_selected += enable_flight_recorder("vehicle_local_position");
+	num_selected += enable_flight_recorder("vehicle_rates_setpoint");
+	num_selected += enable_flight_recorder("vehicle_status");
+
+	return num_selected;
+}
+
 void LoggedTopics::initialize_configured_topics(SDLogProfileMask profile)
 {
 	// load appropriate topics for profile
@@ -594,4 +730,8 @@ void LoggedTopics::initialize_configured_topics(SDLogProfileMask profile)
 	if (profile & SDLogProfileMask::HIGH_RATE_SENSORS) {
 		add_high_rate_sensors_topics();
 	}
+
+	if (profile & SDLogProfileMask::HIGH_RATE_GYRO_COMPACT) {
+		add_high_rate_gyro_compact_topics();
+	}
 }
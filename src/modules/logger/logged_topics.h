@@ -55,7 +55,8 @@ enum class SDLogProfileMask : int32_t {
 	RAW_IMU_GYRO_FIFO =     1 << 8,
 	RAW_IMU_ACCEL_FIFO =    1 << 9,
 	MAVLINK_TUNNEL =        1 << 10,
-	HIGH_RATE_SENSORS =     1 << 11
+	HIGH_RATE_SENSORS =     1 << 11,
+	HIGH_RATE_GYRO_COMPACT = 1 << 12
 };
 
 enum class MissionLogType : int32_t {
@@ -80,9 +81,21 @@ public:
 
 	static constexpr int MAX_EXCLUDED_OPTIONAL_TOPICS_NUM = 40;
 
+	/**
+	 * Topic priority for the rate reduction when the write buffer fills up (SDLOG_WM_HIGH)
+	 */
+	enum class TopicPriority : uint8_t {
+		Low = 0, ///< reduced first
+		Normal,  ///< reduced if the buffer is close to overflowing
+		High     ///< never reduced
+	};
+
 	struct RequestedSubscription {
 		uint16_t interval_ms;
 		uint8_t instance;
+		bool delta_encoding{false}; ///< log only the changed fields between keyframes (if enabled via SDLOG_DELTA)
+		bool flight_recorder{false}; ///< record at full rate in the flight recorder (if enabled via SDLOG_FR_SIZE)
+		TopicPriority priority{TopicPriority::Normal};
 		ORB_ID id{ORB_ID::INVALID};
 	};
 	struct RequestedSubscriptionArray {
@@ -104,6 +117,13 @@ public:
 
 	bool initialize_logged_topics(SDLogProfileMask profile);
 
+	/**
+	 * Select the topics for the flight recorder, from etc/logging/recorder_topics.txt if it exists.
+	 * Only topics of the full log can be recorded. Must be called after initialize_logged_topics().
+	 * @return number of selected subscriptions
+	 */
+	int initialize_flight_recorder_topics();
+
 	const RequestedSubscriptionArray &subscriptions() const { return _subscriptions; }
 	int numMissionSubscriptions() const { return _num_mission_subs; }
 
@@ -144,6 +164,29 @@ private:
 		return add_topic_multi(name, interval_ms, max_num_instances, true);
 	}
 
+	/**
+	 * Enable delta encoding for all added instances of a topic. Intended for slowly changing topics.
+	 * @param name topic name
+	 */
+	void enable_delta_encoding(const char *name);
+
+	/**
+	 * Set the priority of all added instances of a topic
+	 */
+	void set_priority(const char *name, TopicPriority priority);
+
+	/**
+	 * Set the priorities of the topics that differ from TopicPriority::Normal
+	 */
+	void initialize_topic_priorities();
+
+	/**
+	 * Record all added instances of a topic in the flight recorder
+	 * @param name topic name
+	 * @return number of instances selected
+	 */
+	int enable_flight_recorder(const char *name);
+
 	/**
 	 * Parse a file containing a list of uORB topics to log, calling add_topic for each
 	 * @param fname name of file
@@ -177,6 +220,7 @@ private:
 	void add_raw_imu_accel_fifo();
 	void add_mavlink_tunnel();
 	void add_high_rate_sensors_topics();
+	void add_high_rate_gyro_compact_topics();
 
 	/**
 	 * add a logged topic (called by add_topic() above).
@@ -44,7 +44,6 @@
 #include <stdlib.h>
 #include <time.h>
 
-#include <uORB/uORBMessageFields.hpp>
 #include <uORB/Publication.hpp>
 #include <uORB/topics/uORBTopics.hpp>
 #include <uORB/topics/parameter_update.h>
@@ -69,10 +68,6 @@
 
 //#define DBGPRINT //write status output every few seconds
 
-static_assert(uORB::orb_untokenized_fields_max_length < sizeof(ulog_message_format_s::format) -
-	      HEATSHRINK_DECODER_INPUT_BUFFER_SIZE(_),
-	      "msg definition too long / buffer too short");
-
 #if defined(DBGPRINT)
 // needed for mallinfo
 #if defined(__PX4_POSIX) && !defined(__PX4_DARWIN)
@@ -168,6 +163,11 @@ int Logger::custom_command(int argc, char *argv[])
 		return 0;
 	}
 
+	if (!strcmp(argv[0], "trigger")) {
+		get_instance()->trigger_flight_recorder();
+		return 0;
+	}
+
 	return print_usage("unknown command");
 }
 
@@ -213,6 +213,15 @@ int Logger::print_status()
 		is_logging = true;
 	}
 
+	if (_rate_reduction_level > 0) {
+		PX4_INFO("Logging rates reduced (level %i)", _rate_reduction_level);
+	}
+
+	if (_flight_recorder.allocated()) {
+		PX4_INFO("Flight recorder: %i topics, %zu/%zu bytes used%s", _num_recorder_subs, _flight_recorder.count(),
+			 _flight_recorder.size(), _flight_recorder.frozen() ? " (frozen, writing file)" : "");
+	}
+
 	if (!is_logging) {
 		PX4_INFO("Not logging");
 	}
@@ -415,7 +424,15 @@ Logger::~Logger()
 	}
 
 	delete[](_msg_buffer);
+	delete[](_delta_msg_buffer);
 	delete[](_subscriptions);
+
+	for (int i = 0; i < _num_delta_encoders; ++i) {
+		delete[](_delta_encoders[i].reference);
+	}
+
+	delete[](_delta_encoders);
+	delete[](_recorder_subscriptions);
 }
 
 void Logger::update_params()
@@ -561,14 +578,112 @@ bool Logger::initialize_topics()
 		for (int i = 0; i < logged_topics.subscriptions().count; ++i) {
 			const LoggedTopics::RequestedSubscription &sub = logged_topics.subscriptions().sub[i];
 			_subscriptions[i] = LoggerSubscription(sub.id, sub.interval_ms, sub.instance);
+			_subscriptions[i].base_interval_ms = sub.interval_ms;
+			// the mission log rates are never reduced
+			_subscriptions[i].priority = (i < _num_mission_subs) ? LoggedTopics::TopicPriority::High : sub.priority;
 			_subscriptions[i].subscribe();
 		}
 	}
 
 	_num_subscriptions = logged_topics.subscriptions().count;
+
+	// delta encoding for slowly changing topics
+	if (_param_sdlog_delta.get() > 0 && !_delta_encoders) {
+		int num_delta_encoders = 0;
+
+		for (int i = 0; i < _num_subscriptions; ++i) {
+			if (logged_topics.subscriptions().sub[i].delta_encoding) {
+				++num_delta_encoders;
+			}
+		}
+
+		num_delta_encoders = math::min(num_delta_encoders, (int)DELTA_ENCODER_INVALID);
+
+		if (num_delta_encoders > 0) {
+			_delta_encoders = new DeltaEncoder[num_delta_encoders];
+
+			if (!_delta_encoders) {
+				PX4_ERR("alloc failed");
+				return true; // not fatal, log without delta encoding
+			}
+		}
+
+		for (int i = 0; i < _num_subscriptions && _num_delta_encoders < num_delta_encoders; ++i) {
+			const LoggedTopics::RequestedSubscription &sub = logged_topics.subscriptions().sub[i];
+
+			if (!sub.delta_encoding) {
+				continue;
+			}
+
+			DeltaEncoder &encoder = _delta_encoders[_num_delta_encoders];
+			encoder.fields = orb_get_field_table(sub.id);
+			encoder.reference = new uint8_t[get_orb_meta(sub.id)->o_size_no_padding];
+
+			if (encoder.fields && encoder.reference) {
+				_subscriptions[i].delta_encoder = _num_delta_encoders++;
+
+			} else {
+				delete[](encoder.reference);
+				encoder.reference = nullptr;
+			}
+		}
+	}
+
+	initialize_flight_recorder(logged_topics);
+
 	return true;
 }
 
+void Logger::initialize_flight_recorder(LoggedTopics &logged_topics)
+{
+	if (_param_sdlog_fr_size.get() <= 0 || _flight_recorder.allocated()) {
+		return;
+	}
+
+#if defined(PX4_CRYPTO)
+
+	if (_param_sdlog_crypto_algorithm.get() != 0) {
+		PX4_WARN("flight recorder is not supported with encrypted logs");
+		return;
+	}
+
+#endif // PX4_CRYPTO
+
+	const int num_recorder_subs = logged_topics.initialize_flight_recorder_topics();
+
+	if (num_recorder_subs <= 0) {
+		return;
+	}
+
+	_recorder_subscriptions = new RecorderSubscription[num_recorder_subs];
+
+	if (!_recorder_subscriptions || !_flight_recorder.init(_param_sdlog_fr_size.get() * 1024)) {
+		PX4_ERR("flight recorder alloc failed");
+		delete[](_recorder_subscriptions);
+		_recorder_subscriptions = nullptr;
+		return;
+	}
+
+	for (int i = 0; i < _num_subscriptions && _num_recorder_subs < num_recorder_subs; ++i) {
+		const LoggedTopics::RequestedSubscription &sub = logged_topics.subscriptions().sub[i];
+
+		if (sub.flight_recorder) {
+			RecorderSubscription &recorder_sub = _recorder_subscriptions[_num_recorder_subs++];
+			recorder_sub.sub = uORB::Subscription(sub.id, sub.instance);
+			recorder_sub.sub_idx = i;
+			_subscriptions[i].flight_recorder = true;
+		}
+	}
+
+	int mkdir_ret = mkdir(LOG_ROOT[(int)LogType::FlightRecorder], S_IRWXU | S_IRWXG | S_IRWXO);
+
+	if (mkdir_ret != 0 && errno != EEXIST) {
+		PX4_ERR("failed creating log root dir: %s (%i)", LOG_ROOT[(int)LogType::FlightRecorder], errno);
+	}
+
+	PX4_INFO("flight recorder: %i topics, %i kB", _num_recorder_subs, (int)_param_sdlog_fr_size.get());
+}
+
 void Logger::run()
 {
 	PX4_INFO("logger started (mode=%s)", configured_backend_mode());
@@ -635,6 +750,16 @@ void Logger::run()
 			PX4_ERR("failed to alloc message buffer");
 			return;
 		}
+
+		if (_num_delta_encoders > 0) {
+			delete[](_delta_msg_buffer);
+			_delta_msg_buffer = new uint8_t[_msg_buffer_len];
+
+			if (!_delta_msg_buffer) {
+				PX4_ERR("failed to alloc message buffer");
+				return;
+			}
+		}
 	}
 
 
@@ -717,6 +842,10 @@ void Logger::run()
 
 		const hrt_abstime loop_time = hrt_absolute_time();
 
+		if (_flight_recorder.allocated()) {
+			update_flight_recorder();
+		}
+
 		if (_writer.is_started(LogType::Full)) { // mission log only runs when full log is also started
 
 			if (!was_started) {
@@ -746,6 +875,9 @@ void Logger::run()
 				}
 			}
 
+			/* Add the names of perf counters allocated in flight */
+			update_perf_names();
+
 			/* wait for lock on log buffer */
 			_writer.lock();
 
@@ -756,26 +888,56 @@ void Logger::run()
 				 */
 				const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
 
-				if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_s), try_to_subscribe)) {
+				// If possible copy the data straight from the topic into the log buffer. Subscribing writes
+				// to the log buffer as well, so this is only done for already subscribed topics.
+				uint8_t *msg_buffer = nullptr;
+
+				if (sub.valid() && (_statistics[(int)LogType::Full].dropout_start == 0)
+				    && (sub.delta_encoder == DELTA_ENCODER_INVALID)) {
+					msg_buffer = (uint8_t *)_writer.reserve_message(LogType::Full,
+							sizeof(ulog_message_data_s) + sub.get_topic()->o_size);
+				}
+
+				const bool in_place = (msg_buffer != nullptr);
+
+				if (!in_place) {
+					msg_buffer = _msg_buffer;
+				}
+
+				if (copy_if_updated(sub_idx, msg_buffer + sizeof(ulog_message_data_s), try_to_subscribe)) {
 					// each message consists of a header followed by an orb data object
 					const size_t msg_size = sizeof(ulog_message_data_s) + sub.get_topic()->o_size_no_padding;
 					const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
 					const uint16_t write_msg_id = sub.msg_id;
 
 					//write one byte after another (necessary because of alignment)
-					_msg_buffer[0] = (uint8_t)write_msg_size;
-					_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
-					_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
-					_msg_buffer[3] = (uint8_t)write_msg_id;
-					_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
+					msg_buffer[0] = (uint8_t)write_msg_size;
+					msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+					msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+					msg_buffer[3] = (uint8_t)write_msg_id;
+					msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
 
 					// PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.get_topic()->o_name, sub.get_topic()->o_size, msg_size);
 
 					// full log
-					if (write_message(LogType::Full, _msg_buffer, msg_size)) {
+					size_t written_size = 0;
+
+					if (in_place) {
+						_writer.commit_message(LogType::Full, msg_size);
+						written_size = msg_size;
+
+					} else if (sub.delta_encoder != DELTA_ENCODER_INVALID) {
+						written_size = write_delta_message(sub, msg_buffer, msg_size, loop_time);
+
+					} else if (write_message(LogType::Full, msg_buffer, msg_size)) {
+						written_size = msg_size;
+					}
+
+					if (written_size > 0) {
+						update_index_topic(sub_idx, written_size);
 
 #ifdef DBGPRINT
-						total_bytes += msg_size;
+						total_bytes += written_size;
 #endif /* DBGPRINT */
 					}
 
@@ -789,7 +951,7 @@ void Logger::run()
 									_mission_subscriptions[sub_idx].next_write_time = (loop_time / 100000) + delta_time / 100;
 								}
 
-								write_message(LogType::Mission, _msg_buffer, msg_size);
+								write_message(LogType::Mission, msg_buffer, msg_size);
 							}
 						}
 					}
@@ -807,16 +969,7 @@ void Logger::run()
 				int message_len = strlen(message);
 
 				if (message_len > 0) {
-					uint16_t write_msg_size = sizeof(ulog_message_logging_s) - sizeof(ulog_message_logging_s::message)
-								  - ULOG_MSG_HEADER_LEN + message_len;
-					_msg_buffer[0] = (uint8_t)write_msg_size;
-					_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
-					_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::LOGGING);
-					_msg_buffer[3] = log_message.severity + '0';
-					memcpy(_msg_buffer + 4, &log_message.timestamp, sizeof(ulog_message_logging_s::timestamp));
-					strncpy((char *)(_msg_buffer + 12), message, sizeof(ulog_message_logging_s::message));
-
-					write_message(LogType::Full, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+					write_logging_message(LogType::Full, log_message.severity, log_message.timestamp, message);
 				}
 			}
 
@@ -841,6 +994,12 @@ void Logger::run()
 				_last_sync_time = loop_time;
 			}
 
+			// Add seek index
+			if (_index_topics && loop_time >= _index_next_time) {
+				write_index(loop_time);
+				_index_next_time = loop_time + _param_sdlog_index.get() * 1_s;
+			}
+
 			// update buffer statistics
 			for (int i = 0; i < (int)LogType::Count; ++i) {
 				if (!_statistics[i].dropout_start && (_writer.get_buffer_fill_count_file((LogType)i) > _statistics[i].high_water)) {
@@ -848,6 +1007,8 @@ void Logger::run()
 				}
 			}
 
+			update_rate_reduction(loop_time);
+
 			publish_logger_status();
 
 			/* release the log buffer */
@@ -932,6 +1093,7 @@ void Logger::run()
 
 	stop_log_file(LogType::Full);
 	stop_log_file(LogType::Mission);
+	stop_log_file(LogType::FlightRecorder);
 
 	hrt_cancel(&timer_call);
 	px4_sem_destroy(&_timer_callback_data.semaphore);
@@ -1198,6 +1360,241 @@ void Logger::handle_vehicle_command_update()
 	}
 }
 
+size_t Logger::write_delta_message(LoggerSubscription &sub, uint8_t *msg_buffer, size_t msg_size, hrt_abstime now)
+{
+	DeltaEncoder &encoder = _delta_encoders[sub.delta_encoder];
+	const uint8_t *data = msg_buffer + sizeof(ulog_message_data_s);
+	const size_t data_size = msg_size - sizeof(ulog_message_data_s);
+	uint8_t *write_buffer = msg_buffer;
+	size_t write_size = msg_size;
+
+	// write a keyframe periodically and after a dropout, so that readers can (re)synchronize
+	if (now < encoder.next_keyframe && _statistics[(int)LogType::Full].dropout_start == 0) {
+		const size_t encoded_size = delta_encode(*encoder.fields, data_size, encoder.reference, data,
+					    _delta_msg_buffer + sizeof(ulog_message_data_delta_s));
+
+		if (encoded_size > 0) {
+			write_size = sizeof(ulog_message_data_delta_s) + encoded_size;
+			const uint16_t write_msg_size = static_cast<uint16_t>(write_size - ULOG_MSG_HEADER_LEN);
+			_delta_msg_buffer[0] = (uint8_t)write_msg_size;
+			_delta_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+			_delta_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA_DELTA);
+			_delta_msg_buffer[3] = msg_buffer[3]; // msg_id
+			_delta_msg_buffer[4] = msg_buffer[4];
+			write_buffer = _delta_msg_buffer;
+		}
+	}
+
+	if (!write_message(LogType::Full, write_buffer, write_size)) {
+		return 0;
+	}
+
+	memcpy(encoder.reference, data, data_size);
+
+	if (write_buffer == msg_buffer) {
+		encoder.next_keyframe = now + _param_sdlog_delta.get() * 1_s;
+	}
+
+	return write_size;
+}
+
+void Logger::update_rate_reduction(hrt_abstime now)
+{
+	const size_t buffer_size = _writer.get_buffer_size_file(LogType::Full);
+	const int watermark_high = _param_sdlog_wm_high.get();
+
+	if (watermark_high <= 0 || buffer_size == 0) {
+		return;
+	}
+
+	const int fill_percent = _writer.get_buffer_fill_count_file(LogType::Full) * 100 / buffer_size;
+	int level = _rate_reduction_level;
+
+	if (fill_percent >= (watermark_high + 100) / 2) {
+		level = 2;
+
+	} else if (fill_percent >= watermark_high) {
+		level = math::max(level, 1);
+	}
+
+	if (level > _rate_reduction_level) {
+		_rate_reduction_low_since = 0;
+
+	} else if (level > 0 && fill_percent <= _param_sdlog_wm_low.get()) {
+		// restore step by step, once the buffer fill stays low
+		if (_rate_reduction_low_since == 0) {
+			_rate_reduction_low_since = now;
+
+		} else if (now - _rate_reduction_low_since > 1_s) {
+			--level;
+			_rate_reduction_low_since = 0;
+		}
+
+	} else {
+		_rate_reduction_low_since = 0;
+	}
+
+	if (level == _rate_reduction_level) {
+		return;
+	}
+
+	char message[64];
+	snprintf(message, sizeof(message), "logging rate reduction %i -> %i (buffer %i%% full)", _rate_reduction_level,
+		 level, fill_percent);
+	PX4_INFO("%s", message);
+	write_logging_message(LogType::Full, (level > _rate_reduction_level) ? 4 : 6, now, message);
+
+	set_rate_reduction_level(level);
+}
+
+void Logger::set_rate_reduction_level(int level)
+{
+	// minimum interval for reduced topics that are logged at full rate
+	static constexpr uint32_t min_reduced_interval_ms = 10;
+
+	for (int i = 0; i < _num_subscriptions; ++i) {
+		LoggerSubscription &sub = _subscriptions[i];
+		uint32_t factor = 1;
+
+		if (sub.priority == LoggedTopics::TopicPriority::Low && level > 0) {
+			factor = (level > 1) ? 8 : 4;
+
+		} else if (sub.priority == LoggedTopics::TopicPriority::Normal && level > 1) {
+			factor = 2;
+		}
+
+		if (factor == 1) {
+			sub.set_interval_ms(sub.base_interval_ms);
+
+		} else {
+			sub.set_interval_ms(math::max((uint32_t)sub.base_interval_ms, min_reduced_interval_ms) * factor);
+		}
+	}
+
+	_rate_reduction_level = level;
+}
+
+void Logger::write_logging_message(LogType type, uint8_t log_level, uint64_t timestamp, const char *message)
+{
+	const int message_len = math::min(strlen(message), sizeof(ulog_message_logging_s::message));
+	uint16_t write_msg_size = sizeof(ulog_message_logging_s) - sizeof(ulog_message_logging_s::message)
+				  - ULOG_MSG_HEADER_LEN + message_len;
+	_msg_buffer[0] = (uint8_t)write_msg_size;
+	_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+	_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::LOGGING);
+	_msg_buffer[3] = log_level + '0';
+	memcpy(_msg_buffer + 4, &timestamp, sizeof(ulog_message_logging_s::timestamp));
+	strncpy((char *)(_msg_buffer + 12), message, sizeof(ulog_message_logging_s::message));
+
+	write_message(type, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+}
+
+bool Logger::flight_recorder_triggered()
+{
+	bool triggered = _flight_recorder_trigger.load();
+	_flight_recorder_trigger.store(false);
+
+	vehicle_status_s vehicle_status;
+
+	if (_recorder_vehicle_status_sub.update(&vehicle_status)) {
+		const int32_t triggers = _param_sdlog_fr_trig.get();
+
+		if ((triggers & (int32_t)FlightRecorderTrigger::Failsafe) && vehicle_status.failsafe && !_recorder_prev_failsafe) {
+			triggered = true;
+		}
+
+		if ((triggers & (int32_t)FlightRecorderTrigger::FailureDetector) && vehicle_status.failure_detector_status != 0
+		    && _recorder_prev_failure_detector_status == 0) {
+			triggered = true;
+		}
+
+		_recorder_prev_failsafe = vehicle_status.failsafe;
+		_recorder_prev_failure_detector_status = vehicle_status.failure_detector_status;
+	}
+
+	return triggered;
+}
+
+void Logger::update_flight_recorder()
+{
+	if (!_flight_recorder.frozen()) {
+		for (int i = 0; i < _num_recorder_subs; ++i) {
+			RecorderSubscription &recorder_sub = _recorder_subscriptions[i];
+			LoggerSubscription &sub = _subscriptions[recorder_sub.sub_idx];
+
+			if (!recorder_sub.sub.update(_msg_buffer + sizeof(ulog_message_data_s))) {
+				continue;
+			}
+
+			// the flight recorder uses the same msg_id's as the full log
+			if (sub.msg_id == MSG_ID_INVALID) {
+				if (_next_topic_id == MSG_ID_INVALID) {
+					continue;
+				}
+
+				sub.msg_id = _next_topic_id++;
+			}
+
+			const size_t msg_size = sizeof(ulog_message_data_s) + sub.get_topic()->o_size_no_padding;
+			const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
+			_msg_buffer[0] = (uint8_t)write_msg_size;
+			_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+			_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+			_msg_buffer[3] = sub.msg_id;
+			_msg_buffer[4] = 0;
+
+			_flight_recorder.write(_msg_buffer, msg_size);
+		}
+
+		if (!flight_recorder_triggered() || _flight_recorder.count() == 0) {
+			return;
+		}
+
+		PX4_INFO("flight recorder triggered, writing %zu bytes", _flight_recorder.count());
+		_flight_recorder.freeze();
+		start_log_file(LogType::FlightRecorder);
+	}
+
+	if (!_writer.is_started(LogType::FlightRecorder, LogWriter::BackendFile)) {
+		// the file could not be opened: discard and continue recording
+		_flight_recorder.reset();
+		return;
+	}
+
+	// copy as much as fits into the write buffer, the rest in the next iterations
+	_writer.lock();
+
+	const uint8_t *data;
+	size_t available;
+
+	while ((available = _flight_recorder.get_read_ptr(&data)) > 0) {
+		const size_t buffer_free = _writer.get_buffer_size_file(LogType::FlightRecorder)
+					   - _writer.get_buffer_fill_count_file(LogType::FlightRecorder);
+		const size_t write_size = math::min(available, buffer_free);
+
+		if (write_size == 0 || _writer.write_message(LogType::FlightRecorder, (void *)data, write_size) != 0) {
+			break;
+		}
+
+		_flight_recorder.mark_read(write_size);
+	}
+
+	_writer.unlock();
+	_writer.notify();
+
+	if (_flight_recorder.count() == 0) {
+		stop_log_file(LogType::FlightRecorder);
+		_flight_recorder.reset();
+	}
+}
+
+void Logger::reset_delta_encoders()
+{
+	for (int i = 0; i < _num_delta_encoders; ++i) {
+		_delta_encoders[i].next_keyframe = 0;
+	}
+}
+
 bool Logger::write_message(LogType type, void *ptr, size_t size)
 {
 	Statistics &stats = _statistics[(int)type];
@@ -1311,6 +1708,13 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 	}
 
 #endif // PX4_CRYPTO
+#if defined(CONFIG_LOGGER_COMPRESSION)
+
+	if (type == LogType::Full && compress_log_file()) {
+		crypto_suffix = "z";
+	}
+
+#endif // CONFIG_LOGGER_COMPRESSION
 
 	char *log_file_name = _file_name[(int)type].log_file_name;
 
@@ -1421,7 +1825,35 @@ void Logger::start_log_file(LogType type)
 		_param_sdlog_crypto_exchange_key.get());
 #endif // PX4_CRYPTO
 
+	_writer.set_file_options((size_t)_param_sdlog_prealloc.get() * 1024 * 1024,
+				 (size_t)_param_sdlog_wr_block.get() * 1024);
+
+#if defined(CONFIG_LOGGER_COMPRESSION)
+	_writer.set_compression(compress_log_file());
+#endif // CONFIG_LOGGER_COMPRESSION
+
+	if (type == LogType::Full && _param_sdlog_index.get() > 0) {
+		_index_topics = new IndexTopicRange[_num_subscriptions];
+
+		if (!_index_topics) {
+			PX4_ERR("alloc failed, logging without seek index");
+		}
+
+		_index_last_offset = 0;
+		_index_next_time = 0;
+	}
+
+	if (type == LogType::Full && _writer.is_started(LogType::Full)) {
+		// the mavlink log must not miss names when the header below restarts the table
+		update_perf_names();
+	}
+
 	if (_writer.start_log_file(type, file_name)) {
+		if (type == LogType::Full) {
+			reset_delta_encoders();
+			set_rate_reduction_level(0);
+		}
+
 		_writer.select_write_backend(LogWriter::BackendFile);
 		_writer.set_need_reliable_transfer(true);
 
@@ -1433,6 +1865,7 @@ void Logger::start_log_file(LogType type)
 			write_parameters(type);
 			write_parameter_defaults(type);
 			write_perf_data(PrintLoadReason::Preflight);
+			write_perf_names();
 			write_console_output();
 			write_events_file(LogType::Full);
 			write_excluded_optional_topics(type);
@@ -1449,6 +1882,10 @@ void Logger::start_log_file(LogType type)
 		}
 
 		_statistics[(int) type].start_time_file = hrt_absolute_time();
+
+	} else if (type == LogType::Full) {
+		delete[] _index_topics;
+		_index_topics = nullptr;
 	}
 
 }
@@ -1463,6 +1900,12 @@ void Logger::stop_log_file(LogType type)
 		_writer.set_need_reliable_transfer(true);
 		write_perf_data(PrintLoadReason::Postflight);
 		_writer.set_need_reliable_transfer(false);
+
+		if (_index_topics) {
+			write_index_footer();
+			delete[] _index_topics;
+			_index_topics = nullptr;
+		}
 	}
 
 	_writer.stop_log_file(type);
@@ -1483,7 +1926,13 @@ void Logger::start_log_mavlink()
 
 	PX4_INFO("Start mavlink log");
 
+	if (_writer.is_started(LogType::Full)) {
+		// the file log must not miss names when the header below restarts the table
+		update_perf_names();
+	}
+
 	_writer.start_log_mavlink();
+	reset_delta_encoders();
 	_writer.select_write_backend(LogWriter::BackendMavlink);
 	_writer.set_need_reliable_transfer(true);
 	write_header(LogType::Full);
@@ -1492,6 +1941,7 @@ void Logger::start_log_mavlink()
 	write_parameters(LogType::Full);
 	write_parameter_defaults(LogType::Full);
 	write_perf_data(PrintLoadReason::Preflight);
+	write_perf_names();
 	write_console_output();
 	write_events_file(LogType::Full);
 	write_excluded_optional_topics(LogType::Full);
@@ -1567,6 +2017,58 @@ void Logger::perf_iterate_callback(perf_counter_t handle, void *user)
 	++callback_data->counter;
 }
 
+void Logger::write_index(hrt_abstime now)
+{
+	// a dropout message would be written in front and invalidate the offset
+	if (_statistics[(int)LogType::Full].dropout_start != 0) {
+		return;
+	}
+
+	ulog_message_index_s msg{};
+	msg.timestamp = now;
+	msg.offset = _writer.get_file_offset(LogType::Full);
+	msg.prev_offset = _index_last_offset;
+
+	if (write_message(LogType::Full, &msg, sizeof(msg))) {
+		_index_last_offset = msg.offset;
+	}
+}
+
+void Logger::write_index_footer()
+{
+	ulog_message_index_footer_s footer{};
+
+	_writer.lock();
+	_writer.set_need_reliable_transfer(true);
+
+	for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
+		const LoggerSubscription &sub = _subscriptions[sub_idx];
+
+		if (sub.msg_id == MSG_ID_INVALID || _index_topics[sub_idx].first_offset == 0) {
+			continue;
+		}
+
+		ulog_message_index_topic_s msg{};
+		msg.msg_id = sub.msg_id;
+		msg.first_offset = _index_topics[sub_idx].first_offset;
+		msg.last_offset = _index_topics[sub_idx].last_offset;
+
+		if (write_message(LogType::Full, &msg, sizeof(msg))) {
+			if (footer.topic_index_count++ == 0) {
+				footer.topic_index_offset = _writer.get_file_offset(LogType::Full) - sizeof(msg);
+			}
+		}
+	}
+
+	write_index(hrt_absolute_time());
+
+	footer.index_offset = _index_last_offset;
+	write_message(LogType::Full, &footer, sizeof(footer));
+
+	_writer.set_need_reliable_transfer(false);
+	_writer.unlock();
+}
+
 void Logger::write_perf_data(PrintLoadReason reason)
 {
 	perf_callback_data_t callback_data = {};
@@ -1576,6 +2078,64 @@ void Logger::write_perf_data(PrintLoadReason reason)
 
 	// write the perf counters
 	perf_iterate_all(perf_iterate_callback, &callback_data);
+
+	// and the uORB wakeup latencies, if enabled
+	callback_data.counter = 0;
+	uorb_latency(orb_latency_callback, &callback_data);
+}
+
+void Logger::orb_latency_callback(const char *line, void *user)
+{
+	perf_callback_data_t *callback_data = (perf_callback_data_t *)user;
+	const char *name;
+
+	switch (callback_data->reason) {
+	case PrintLoadReason::Preflight:
+	default:
+		name = "orb_latency_preflight";
+		break;
+
+	case PrintLoadReason::Postflight:
+		name = "orb_latency_postflight";
+		break;
+
+	case PrintLoadReason::Watchdog:
+		name = "orb_latency_watchdog";
+		break;
+	}
+
+	callback_data->logger->write_info_multiple(LogType::Full, name, line, callback_data->counter != 0);
+	++callback_data->counter;
+}
+
+void Logger::perf_name_callback(perf_counter_t handle, void *user)
+{
+	perf_callback_data_t *callback_data = (perf_callback_data_t *)user;
+	char buffer[80];
+
+	snprintf(buffer, sizeof(buffer), "%08" PRIx32 " %s", perf_name_id(handle), perf_name(handle));
+
+	callback_data->logger->write_info_multiple(LogType::Full, "perf_counter_names", buffer, callback_data->counter != 0);
+	++callback_data->counter;
+}
+
+void Logger::write_perf_names()
+{
+	perf_callback_data_t callback_data = {};
+	callback_data.logger = this;
+	callback_data.counter = 0;
+
+	_perf_names_generation = perf_iterate_new(0, perf_name_callback, &callback_data);
+}
+
+void Logger::update_perf_names()
+{
+	// continue the table written into the header
+	perf_callback_data_t callback_data = {};
+	callback_data.logger = this;
+	callback_data.counter = 1;
+
+	_perf_names_generation = perf_iterate_new(_perf_names_generation, perf_name_callback, &callback_data);
 }
 
 
@@ -1698,122 +2258,101 @@ void Logger::write_formats(LogType type)
 		sub_count = _num_mission_subs;
 	}
 
-	// Keep a bitset of all required formats (nested definitions are added later on to the bitset)
-	px4::Bitset<ORB_TOPICS_COUNT> formats_to_write;
+	// Keep a bitset of all written formats, so that nested definitions are written only once
+	px4::Bitset<ORB_TOPICS_COUNT> formats_written;
 
 	for (int i = 0; i < sub_count; ++i) {
 		const LoggerSubscription &sub = _subscriptions[i];
 
-		if (sub.get_topic()->o_id < formats_to_write.size()) {
-			formats_to_write.set(sub.get_topic()->o_id);
-
-		} else {
-			PX4_ERR("logic error");
+		if (type == LogType::FlightRecorder && !sub.flight_recorder) {
+			continue;
 		}
-	}
-
-	formats_to_write.set(_event_subscription.get_topic()->o_id);
-
-
-	static_assert(sizeof(msg.format) > uORB::orb_tokenized_fields_max_length, "uORB message definition too long");
-	uORB::MessageFormatReader format_reader(msg.format, sizeof(msg.format));
-	bool done = false;
 
-	while (!done) {
-		switch (format_reader.readMore()) {
-		case uORB::MessageFormatReader::State::FormatComplete: {
-				unsigned format_length = format_reader.formatLength();
-				// Move the left-over (the part after the format if any) to the end of the buffer
-				const unsigned leftover_length = format_reader.moveLeftoverToBufferEnd();
+		write_format(type, *sub.get_topic(), formats_written, msg);
+	}
 
-				bool needs_expansion = true;
-				int last_name_length = 0;
-				bool format_error = false;
+	write_format(type, *_event_subscription.get_topic(), formats_written, msg);
 
-				for (const orb_id_size_t orb_id : format_reader.orbIDs()) {
-					if (orb_id >= formats_to_write.size() || !formats_to_write[orb_id]) {
-						continue;
-					}
+	_writer.unlock();
+}
 
-					// Make sure to write dependencies too
-					for (const orb_id_size_t orb_id_dep : format_reader.orbIDsDependencies()) {
-						formats_to_write.set(orb_id_dep);
-					}
+void Logger::write_format(LogType type, const orb_metadata &meta, px4::Bitset<ORB_TOPICS_COUNT> &formats_written,
+			  ulog_message_format_s &msg)
+{
+	if (meta.o_id >= formats_written.size()) {
+		PX4_ERR("logic error");
+		return;
+	}
 
-					formats_to_write.set(orb_id, false);
-					const orb_metadata &meta = *get_orb_meta((ORB_ID) orb_id);
+	if (formats_written[meta.o_id]) {
+		return;
+	}
 
-					PX4_DEBUG("writing format for %s", meta.o_name);
+	formats_written.set(meta.o_id);
 
-					// Expand if needed (first time only)
-					if (needs_expansion) {
-						const int ret = uORB::MessageFormatReader::expandMessageFormat(msg.format, format_length,
-								sizeof(msg.format) - leftover_length);
+	const uORB::FieldTable *fields = orb_get_field_table(static_cast<ORB_ID>(meta.o_id));
 
-						if (ret < 0) {
-							PX4_ERR("Format %s error (too long?)", meta.o_name);
-							format_error = true;
+	if (!fields) {
+		PX4_ERR("no format for %s", meta.o_name);
+		return;
+	}
 
-						} else {
-							format_length = ret;
-						}
+	// Nested definitions are referenced by message name, which is also the name of their main topic.
+	// Write them first, msg is reused for each of them.
+	for (unsigned i = 0; i < fields->num_fields; ++i) {
+		const uORB::FieldDescriptor &field = fields->fields[i];
 
-						needs_expansion = false;
-					}
+		if (field.type != uORB::FieldType::NESTED) {
+			continue;
+		}
 
-					// Prepend format name and ':'
-					const int name_length = strlen(meta.o_name) + 1; // + 1 for ':'
+		const orb_metadata *const *topics = orb_get_topics();
+		const orb_metadata *nested_meta = nullptr;
 
-					if (format_length + name_length - last_name_length + 1 > sizeof(msg.format) - leftover_length) {
-						PX4_ERR("Format %s too long", meta.o_name);
-						format_error = true;
-					}
+		for (size_t j = 0; j < orb_topics_count(); ++j) {
+			if (strcmp(topics[j]->o_name, field.nested->name) == 0) {
+				nested_meta = topics[j];
+				break;
+			}
+		}
 
-					if (format_error) {
-						break;
-					}
+		if (nested_meta) {
+			write_format(type, *nested_meta, formats_written, msg);
 
-					if (last_name_length != name_length) {
-						memmove(msg.format + name_length, msg.format + last_name_length,
-							format_length + 1 - last_name_length);
-						msg.format[name_length - 1] = ':';
-						format_length += name_length - last_name_length;
-						last_name_length = name_length;
-					}
+		} else {
+			PX4_ERR("no topic for nested format %s", field.nested->name);
+		}
+	}
 
-					memcpy(msg.format, meta.o_name, name_length - 1);
+	PX4_DEBUG("writing format for %s", meta.o_name);
 
-					size_t msg_size = sizeof(msg) - sizeof(msg.format) + format_length;
-					msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
-					write_message(type, &msg, msg_size);
-				}
+	int format_length = snprintf(msg.format, sizeof(msg.format), "%s:", meta.o_name);
 
-				// Move left-over back
-				format_reader.clearFormatAndRestoreLeftover();
-				break;
-			}
-			break;
+	for (unsigned i = 0; i < fields->num_fields; ++i) {
+		const uORB::FieldDescriptor &field = fields->fields[i];
+		const char *type_name = field.type == uORB::FieldType::NESTED ? field.nested->name : uORB::field_type_c_name(field.type);
+		const int remaining = sizeof(msg.format) - format_length;
+		int ret;
 
-		case uORB::MessageFormatReader::State::Failure:
-			PX4_ERR("Failed to read formats");
-			done = true;
-			break;
+		// padding is always an array, even if only a single byte
+		if (field.array_length > 1 || strncmp(field.name, "_padding", 8) == 0) {
+			ret = snprintf(msg.format + format_length, remaining, "%s[%u] %s;", type_name, field.array_length, field.name);
 
-		case uORB::MessageFormatReader::State::Complete:
-			done = true;
-			break;
+		} else {
+			ret = snprintf(msg.format + format_length, remaining, "%s %s;", type_name, field.name);
+		}
 
-		default:
-			break;
+		if (ret < 0 || ret >= remaining) {
+			PX4_ERR("Format %s too long", meta.o_name);
+			return;
 		}
-	}
 
-	if (formats_to_write.count() > 0) {
-		// Getting here is a bug. Maybe the ordering of nested formats is not as expected?
-		PX4_ERR("Not all formats written");
+		format_length += ret;
 	}
 
-	_writer.unlock();
+	size_t msg_size = sizeof(msg) - sizeof(msg.format) + format_length;
+	msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+	write_message(type, &msg, msg_size);
 }
 
 void Logger::write_all_add_logged_msg(LogType type)
@@ -1831,7 +2370,11 @@ void Logger::write_all_add_logged_msg(LogType type)
 	for (int i = 0; i < sub_count; ++i) {
 		LoggerSubscription &sub = _subscriptions[i];
 
-		if (sub.valid()) {
+		// the flight recorder has its own subscriptions, the msg_id is assigned as soon as data is recorded
+		const bool add = (type == LogType::FlightRecorder) ? (sub.flight_recorder && sub.msg_id != MSG_ID_INVALID)
+				 : sub.valid();
+
+		if (add) {
 			write_add_logged_msg(type, sub);
 			added_subscriptions = true;
 		}
@@ -2050,6 +2593,14 @@ void Logger::write_header(LogType type)
 
 	flag_bits.compat_flags[0] = ULOG_COMPAT_FLAG0_DEFAULT_PARAMETERS_MASK;
 
+	if (type == LogType::Full && _index_topics) {
+		flag_bits.compat_flags[0] |= ULOG_COMPAT_FLAG0_SEEK_INDEX_MASK;
+	}
+
+	if (type == LogType::Full && _num_delta_encoders > 0) {
+		flag_bits.incompat_flags[0] |= ULOG_INCOMPAT_FLAG0_DELTA_DATA_MASK;
+	}
+
 	flag_bits.msg_size = sizeof(flag_bits) - ULOG_MSG_HEADER_LEN;
 	flag_bits.msg_type = static_cast<uint8_t>(ULogMessageType::FLAG_BITS);
 
@@ -2432,14 +2983,19 @@ log. The mission log is a reduced ulog file and can be used for example for geot
 vehicle management. It can be enabled and configured via SDLOG_MISSION parameter.
 The normal log is always a superset of the mission log.
 
+Optionally (SDLOG_FR_SIZE), a flight recorder continuously records a set of topics at full rate
+into a RAM ring buffer. On a trigger (failsafe, failure detector, see SDLOG_FR_TRIG, or `logger trigger`),
+the ring is frozen and written to a separate file, which contains the last seconds before the trigger.
+The recorded topics can be configured in etc/logging/recorder_topics.txt (one topic name per line).
+
 ### Implementation
-The implementation uses two threads:
+The implementation uses these threads:
 - The main thread, running at a fixed rate (or polling on a topic if started with -p) and checking for
   data updates
-- The writer thread, writing data to the file
+- A writer thread per log file type, writing data to the file
 
-In between there is a write buffer with configurable size (and another fixed-size buffer for
-the mission log). It should be large to avoid dropouts.
+In between there is a write buffer with configurable size (and other fixed-size buffers for
+the mission log and flight recorder file). It should be large to avoid dropouts.
 
 ### Examples
 Typical usage to start logging immediately:
@@ -2464,6 +3020,7 @@ $ logger on
 	PRINT_MODULE_USAGE_PARAM_FLOAT('c', 1.0, 0.2, 2.0, "Log rate factor (higher is faster)", true);
 	PRINT_MODULE_USAGE_COMMAND_DESCR("on", "start logging now, override arming (logger must be running)");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("off", "stop logging now, override arming (logger must be running)");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("trigger", "freeze the flight recorder and write it to a file (if enabled)");
 #ifdef __PX4_NUTTX
 	PRINT_MODULE_USAGE_COMMAND_DESCR("trigger_watchdog", "manually trigger the watchdog now");
 #endif
@@ -36,8 +36,11 @@
 #include "log_writer.h"
 #include "logged_topics.h"
 #include "messages.h"
+#include "delta_encoding.h"
+#include "flight_recorder.h"
 #include "watchdog.h"
 #include <containers/Array.hpp>
+#include <containers/Bitset.hpp>
 #include "util.h"
 #include <px4_platform_common/defines.h>
 #include <drivers/drv_hrt.h>
@@ -70,6 +73,7 @@ namespace logger
 {
 
 static constexpr uint8_t MSG_ID_INVALID = UINT8_MAX;
+static constexpr uint8_t DELTA_ENCODER_INVALID = UINT8_MAX;
 
 struct LoggerSubscription : public uORB::SubscriptionInterval {
 	LoggerSubscription() = default;
@@ -79,6 +83,10 @@ struct LoggerSubscription : public uORB::SubscriptionInterval {
 	{}
 
 	uint8_t msg_id{MSG_ID_INVALID};
+	uint8_t delta_encoder{DELTA_ENCODER_INVALID}; ///< index into Logger::_delta_encoders
+	bool flight_recorder{false}; ///< also recorded (at full rate) in the flight recorder
+	LoggedTopics::TopicPriority priority{LoggedTopics::TopicPriority::Normal};
+	uint16_t base_interval_ms{0}; ///< configured interval, without rate reduction
 };
 
 class Logger : public ModuleBase<Logger>, public ModuleParams
@@ -146,6 +154,9 @@ public:
 
 	void set_arm_override(bool override) { _manually_logging_override = override; }
 
+	/** freeze the flight recorder and write it to a file */
+	void trigger_flight_recorder() { _flight_recorder_trigger.store(true); }
+
 	void trigger_watchdog_now()
 	{
 #ifdef __PX4_NUTTX
@@ -159,7 +170,8 @@ private:
 	static constexpr unsigned	MAX_NO_LOGFILE = 999;	/**< Maximum number of log files */
 	static constexpr const char	*LOG_ROOT[(int)LogType::Count] = {
 		CONFIG_BOARD_ROOT_PATH "/log",
-		CONFIG_BOARD_ROOT_PATH "/mission_log"
+		CONFIG_BOARD_ROOT_PATH "/mission_log",
+		CONFIG_BOARD_ROOT_PATH "/flight_recorder"
 	};
 
 	struct LogFileName {
@@ -182,6 +194,27 @@ private:
 		unsigned next_write_time{0};     ///< next time to write in 0.1 seconds
 	};
 
+	struct DeltaEncoder {
+		const uORB::FieldTable *fields{nullptr};
+		uint8_t *reference{nullptr};     ///< last written data
+		hrt_abstime next_keyframe{0};    ///< 0 forces a keyframe
+	};
+
+	struct RecorderSubscription {
+		uORB::Subscription sub;          ///< full rate subscription
+		int sub_idx{0};                  ///< index into _subscriptions
+	};
+
+	enum class FlightRecorderTrigger : int32_t {
+		Failsafe = 1 << 0,
+		FailureDetector = 1 << 1,
+	};
+
+	struct IndexTopicRange {
+		uint64_t first_offset{0};        ///< file offset of the first data message (0 = none written)
+		uint64_t last_offset{0};         ///< file offset of the last data message
+	};
+
 	/**
 	 * @brief Updates and checks for updated uORB parameters.
 	 */
@@ -213,6 +246,23 @@ private:
 	 */
 	int get_log_file_name(LogType type, char *file_name, size_t file_name_size, bool notify);
 
+#if defined(CONFIG_LOGGER_COMPRESSION)
+	/**
+	 * Whether new log files are compressed (SDLOG_COMPRESS, encrypted logs are not compressed)
+	 */
+	bool compress_log_file()
+	{
+#if defined(PX4_CRYPTO)
+
+		if (_param_sdlog_crypto_algorithm.get() != 0) {
+			return false;
+		}
+
+#endif // PX4_CRYPTO
+		return _param_sdlog_compress.get();
+	}
+#endif // CONFIG_LOGGER_COMPRESSION
+
 	void start_log_file(LogType type);
 
 	void stop_log_file(LogType type);
@@ -236,13 +286,103 @@ private:
 	 */
 	void write_header(LogType type);
 
+	/**
+	 * write the ulog format definitions of all logged topics, built from the generated field tables
+	 */
 	void write_formats(LogType type);
 
+	/**
+	 * write the format of a single topic, preceded by the formats of its nested messages if not yet written
+	 */
+	void write_format(LogType type, const orb_metadata &meta, px4::Bitset<ORB_TOPICS_COUNT> &formats_written,
+			  ulog_message_format_s &msg);
+
+	/**
+	 * write a data message of a delta encoded subscription to the full log: either a keyframe (full data
+	 * message) or the changed fields only
+	 * @param msg_buffer full data message
+	 * @return written size, 0 on failure
+	 */
+	size_t write_delta_message(LoggerSubscription &sub, uint8_t *msg_buffer, size_t msg_size, hrt_abstime now);
+
+	/**
+	 * force a keyframe for all delta encoded subscriptions, called when a new log is started
+	 */
+	void reset_delta_encoders();
+
+	/**
+	 * Reduce the rates of low priority topics when the full log write buffer fill level passes SDLOG_WM_HIGH,
+	 * and restore them once it is below SDLOG_WM_LOW. Must be called with the writer lock held.
+	 */
+	void update_rate_reduction(hrt_abstime now);
+
+	/**
+	 * set the intervals of all subscriptions for a rate reduction level (0 = configured rates)
+	 */
+	void set_rate_reduction_level(int level);
+
+	/**
+	 * write a logged string message. Must be called with the writer lock held.
+	 * @param log_level same levels as in the linux kernel
+	 */
+	void write_logging_message(LogType type, uint8_t log_level, uint64_t timestamp, const char *message);
+
+	/**
+	 * allocate the flight recorder and its subscriptions (if enabled via SDLOG_FR_SIZE)
+	 */
+	void initialize_flight_recorder(LoggedTopics &logged_topics);
+
+	/**
+	 * record the flight recorder topics, check the triggers and write the frozen flight recorder to its file
+	 */
+	void update_flight_recorder();
+
+	/**
+	 * @return true if one of the configured trigger conditions became true (or a manual trigger)
+	 */
+	bool flight_recorder_triggered();
+
+	/**
+	 * write a seek index message (full log only). Must be called with the writer lock held.
+	 */
+	void write_index(hrt_abstime now);
+
+	/**
+	 * write the topic index and the index footer before closing the full log
+	 */
+	void write_index_footer();
+
+	/**
+	 * remember the file offset of a data message for the topic index, called right after writing it
+	 * @param msg_size size of the written message
+	 */
+	void update_index_topic(int sub_idx, size_t msg_size)
+	{
+		if (_index_topics) {
+			IndexTopicRange &range = _index_topics[sub_idx];
+			range.last_offset = _writer.get_file_offset(LogType::Full) - msg_size;
+
+			if (range.first_offset == 0) {
+				range.first_offset = range.last_offset;
+			}
+		}
+	}
+
 	/**
 	 * write performance counters
 	 */
 	void write_perf_data(PrintLoadReason reason);
 
+	/**
+	 * write the name table of the perf counters, used to decode the perf_counter_snapshot topic
+	 */
+	void write_perf_names();
+
+	/**
+	 * append the names of the perf counters allocated since the table was last written to the started logs
+	 */
+	void update_perf_names();
+
 	/**
 	 * write bootup console output
 	 */
@@ -253,6 +393,16 @@ private:
 	 */
 	static void perf_iterate_callback(perf_counter_t handle, void *user);
 
+	/**
+	 * callback to write the name table of the performance counters
+	 */
+	static void perf_name_callback(perf_counter_t handle, void *user);
+
+	/**
+	 * callback to write the uORB publish to callback latencies
+	 */
+	static void orb_latency_callback(const char *line, void *user);
+
 	/**
 	 * callback for print_load_buffer() to print the process load
 	 */
@@ -350,6 +500,24 @@ private:
 	Statistics					_statistics[(int)LogType::Count];
 	hrt_abstime					_last_sync_time{0}; ///< last time a sync msg was sent
 
+	DeltaEncoder					*_delta_encoders{nullptr};
+	int						_num_delta_encoders{0};
+	uint8_t						*_delta_msg_buffer{nullptr}; ///< encoded message, same size as _msg_buffer
+
+	int						_rate_reduction_level{0}; ///< 0: configured rates, 1: low priority reduced, 2: all reduced
+	hrt_abstime					_rate_reduction_low_since{0}; ///< time since the buffer fill is below SDLOG_WM_LOW
+
+	FlightRecorder					_flight_recorder;
+	RecorderSubscription				*_recorder_subscriptions{nullptr};
+	int						_num_recorder_subs{0};
+	px4::atomic_bool				_flight_recorder_trigger{false};
+	bool						_recorder_prev_failsafe{false};
+	uint16_t					_recorder_prev_failure_detector_status{0};
+
+	IndexTopicRange					*_index_topics{nullptr}; ///< per subscription offsets, non-null if the full log has a seek index
+	uint64_t					_index_last_offset{0}; ///< file offset of the last index message
+	hrt_abstime					_index_next_time{0};
+
 	LogMode						_log_mode;
 	const bool					_log_name_timestamp;
 
@@ -376,8 +544,9 @@ private:
 	print_load_s					_load{}; ///< process load data
 	hrt_abstime					_next_load_print{0}; ///< timestamp when to print the process load
 	PrintLoadReason					_print_load_reason {PrintLoadReason::Preflight};
+	uint32_t					_perf_names_generation{0}; ///< perf counter generation of the last name table update
 
-	uORB::PublicationMulti<logger_status_s>		_logger_status_pub[(int)LogType::Count] { ORB_ID(logger_status), ORB_ID(logger_status) };
+	uORB::PublicationMulti<logger_status_s>		_logger_status_pub[(int)LogType::Count] { ORB_ID(logger_status), ORB_ID(logger_status), ORB_ID(logger_status) };
 
 	hrt_abstime					_logger_status_last {0};
 	int						_lockstep_component{-1};
@@ -389,6 +558,7 @@ private:
 	uORB::Subscription				_manual_control_setpoint_sub{ORB_ID(manual_control_setpoint)};
 	uORB::Subscription				_vehicle_command_sub{ORB_ID(vehicle_command)};
 	uORB::Subscription				_vehicle_status_sub{ORB_ID(vehicle_status)};
+	uORB::Subscription				_recorder_vehicle_status_sub{ORB_ID(vehicle_status)};
 	uORB::SubscriptionInterval			_log_message_sub{ORB_ID(log_message), 20};
 	uORB::SubscriptionInterval			_parameter_update_sub{ORB_ID(parameter_update), 1_s};
 
@@ -398,12 +568,23 @@ private:
 		(ParamInt<px4::params::SDLOG_PROFILE>) _param_sdlog_profile,
 		(ParamInt<px4::params::SDLOG_MISSION>) _param_sdlog_mission,
 		(ParamBool<px4::params::SDLOG_BOOT_BAT>) _param_sdlog_boot_bat,
-		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid
+		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid,
+		(ParamInt<px4::params::SDLOG_PREALLOC>) _param_sdlog_prealloc,
+		(ParamInt<px4::params::SDLOG_WR_BLOCK>) _param_sdlog_wr_block,
+		(ParamInt<px4::params::SDLOG_INDEX>) _param_sdlog_index,
+		(ParamInt<px4::params::SDLOG_DELTA>) _param_sdlog_delta,
+		(ParamInt<px4::params::SDLOG_FR_SIZE>) _param_sdlog_fr_size,
+		(ParamInt<px4::params::SDLOG_FR_TRIG>) _param_sdlog_fr_trig,
+		(ParamInt<px4::params::SDLOG_WM_HIGH>) _param_sdlog_wm_high,
+		(ParamInt<px4::params::SDLOG_WM_LOW>) _param_sdlog_wm_low
 #if defined(PX4_CRYPTO)
 		, (ParamInt<px4::params::SDLOG_ALGORITHM>) _param_sdlog_crypto_algorithm,
 		(ParamInt<px4::params::SDLOG_KEY>) _param_sdlog_crypto_key,
 		(ParamInt<px4::params::SDLOG_EXCH_KEY>) _param_sdlog_crypto_exchange_key
 #endif // PX4_CRYPTO
+#if defined(CONFIG_LOGGER_COMPRESSION)
+		, (ParamBool<px4::params::SDLOG_COMPRESS>) _param_sdlog_compress
+#endif // CONFIG_LOGGER_COMPRESSION
 	)
 };
 
@@ -38,6 +38,7 @@
 enum class ULogMessageType : uint8_t {
 	FORMAT = 'F',
 	DATA = 'D',
+	DATA_DELTA = 'G',
 	INFO = 'I',
 	INFO_MULTIPLE = 'M',
 	PARAMETER = 'P',
@@ -49,6 +50,9 @@ enum class ULogMessageType : uint8_t {
 	LOGGING = 'L',
 	LOGGING_TAGGED = 'C',
 	FLAG_BITS = 'B',
+	INDEX = 'X',
+	INDEX_TOPIC = 'Y',
+	INDEX_FOOTER = 'Z',
 };
 
 
@@ -157,6 +161,56 @@ struct ulog_message_sync_s {
 	uint8_t sync_magic[8];
 };
 
+/**
+ * @brief Seek Index Message
+ *
+ * Written periodically into the data section. All messages following it in the file were written after the
+ * given timestamp. The messages are linked backwards via prev_offset, so that a reader can find all of them
+ * from the footer without parsing the whole file.
+ *
+ * File offsets refer to the uncompressed, unencrypted ULog stream.
+ */
+struct ulog_message_index_s {
+	uint16_t msg_size = sizeof(ulog_message_index_s) - ULOG_MSG_HEADER_LEN; ///< size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::INDEX);
+
+	uint64_t timestamp; ///< logger time when the message was written
+	uint64_t offset; ///< file offset of this message
+	uint64_t prev_offset; ///< file offset of the previous index message, 0 if this is the first one
+};
+
+/**
+ * @brief Topic Index Message
+ *
+ * Written for each logged topic when the log is closed: file offsets of the first and the last data message.
+ */
+struct ulog_message_index_topic_s {
+	uint16_t msg_size = sizeof(ulog_message_index_topic_s) - ULOG_MSG_HEADER_LEN; ///< size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::INDEX_TOPIC);
+
+	uint16_t msg_id; ///< matches the msg_id in ulog_message_add_logged_s
+	uint64_t first_offset;
+	uint64_t last_offset;
+};
+
+#define ULOG_INDEX_FOOTER_MAGIC "ULogIdx"
+
+/**
+ * @brief Index Footer Message
+ *
+ * The last message of a cleanly closed log file with a seek index (unless data was appended afterwards, see
+ * ulog_message_flag_bits_s::appended_offsets). Readers check for it at the file end.
+ */
+struct ulog_message_index_footer_s {
+	uint16_t msg_size = sizeof(ulog_message_index_footer_s) - ULOG_MSG_HEADER_LEN; ///< size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::INDEX_FOOTER);
+
+	uint64_t index_offset; ///< file offset of the last index message
+	uint64_t topic_index_offset; ///< file offset of the first topic index message (they are consecutive)
+	uint16_t topic_index_count; ///< number of topic index messages
+	char magic[8] = ULOG_INDEX_FOOTER_MAGIC;
+};
+
 struct ulog_message_dropout_s {
 	uint16_t msg_size = sizeof(uint16_t); ///< size of message - ULOG_MSG_HEADER_LEN
 	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::DROPOUT);
@@ -179,6 +233,20 @@ struct ulog_message_data_s {
 	uint16_t msg_id;
 };
 
+/**
+ * @brief Delta Encoded Data Message
+ *
+ * Same header as ulog_message_data_s. The data contains only the fields that changed since the previous
+ * (full or delta encoded) data message with the same msg_id, see delta_encoding.h. Full data messages are
+ * written periodically as keyframes.
+ */
+struct ulog_message_data_delta_s {
+	uint16_t msg_size; ///< size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::DATA_DELTA);
+
+	uint16_t msg_id;
+};
+
 /**
  * @brief Information Message
  *
@@ -282,8 +350,10 @@ struct ulog_message_parameter_default_s {
 
 
 #define ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK (1<<0)
+#define ULOG_INCOMPAT_FLAG0_DELTA_DATA_MASK (1<<1) ///< the data section contains delta encoded data, @see ulog_message_data_delta_s
 
 #define ULOG_COMPAT_FLAG0_DEFAULT_PARAMETERS_MASK (1<<0)
+#define ULOG_COMPAT_FLAG0_SEEK_INDEX_MASK (1<<1) ///< the data section contains index messages, @see ulog_message_index_s
 
 struct ulog_message_flag_bits_s {
 	uint16_t msg_size;
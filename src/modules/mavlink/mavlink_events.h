@@ -74,7 +74,7 @@ public:
 	 * Create an event buffer. Required memory: sizeof(Event) * capacity.
 	 * @param capacity maximum number of buffered events
 	 */
-	EventBuffer(int capacity = 20);
+	EventBuffer(int capacity = CONFIG_MAVLINK_EVENT_BUFFER_SIZE);
 	~EventBuffer();
 
 	int init();
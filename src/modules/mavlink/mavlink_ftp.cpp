@@ -54,24 +54,57 @@ constexpr const char MavlinkFTP::_root_dir[];
 MavlinkFTP::MavlinkFTP(Mavlink &mavlink) :
 	_mavlink(mavlink)
 {
-	// initialize session
-	_session_info.fd = -1;
+	// initialize sessions
+	for (SessionInfo &session : _session_info) {
+		session.fd = -1;
+	}
 }
 
 MavlinkFTP::~MavlinkFTP()
 {
+	for (uint8_t i = 0; i < kMaxSessions; ++i) {
+		_close_session(i);
+	}
+
 	delete[] _work_buffer1;
 	delete[] _work_buffer2;
+	delete[] _stream_buffer;
 }
 
 unsigned
 MavlinkFTP::get_size()
 {
-	if (_session_info.stream_download) {
-		return MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+	for (const SessionInfo &session : _session_info) {
+		if (session.stream_download) {
+			return MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+		}
+	}
 
-	} else {
-		return 0;
+	return 0;
+}
+
+MavlinkFTP::SessionInfo *
+MavlinkFTP::_get_session(const PayloadHeader *payload)
+{
+	if (payload->session >= kMaxSessions || _session_info[payload->session].fd < 0) {
+		return nullptr;
+	}
+
+	return &_session_info[payload->session];
+}
+
+void
+MavlinkFTP::_close_session(uint8_t session)
+{
+	if (_session_info[session].fd >= 0) {
+		::close(_session_info[session].fd);
+	}
+
+	_session_info[session].fd = -1;
+	_session_info[session].stream_download = false;
+
+	if (_stream_buffer_session == session) {
+		_stream_buffer_session = -1;
 	}
 }
 
@@ -503,7 +536,13 @@ MavlinkFTP::_workList(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 {
-	if (_session_info.fd >= 0) {
+	uint8_t session = 0;
+
+	while (session < kMaxSessions && _session_info[session].fd >= 0) {
+		++session;
+	}
+
+	if (session == kMaxSessions) {
 		PX4_ERR("FTP: Open failed - out of sessions");
 		return kErrNoSessionsAvailable;
 	}
@@ -541,11 +580,15 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 		return kErrFailErrno;
 	}
 
-	_session_info.fd = fd;
-	_session_info.file_size = fileSize;
-	_session_info.stream_download = false;
+	_session_info[session].fd = fd;
+	_session_info[session].file_size = fileSize;
+	_session_info[session].stream_download = false;
+
+	if (_stream_buffer_session == session) {
+		_stream_buffer_session = -1;
+	}
 
-	payload->session = 0;
+	payload->session = session;
 	payload->size = sizeof(uint32_t);
 	std::memcpy(payload->data, &fileSize, payload->size);
 
@@ -556,27 +599,29 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workRead(PayloadHeader *payload)
 {
-	if (payload->session != 0 || _session_info.fd < 0) {
+	SessionInfo *session = _get_session(payload);
+
+	if (!session) {
 		return kErrInvalidSession;
 	}
 
 	PX4_DEBUG("FTP: read offset:%ld" PRIu32, payload->offset);
 
 	// We have to test seek past EOF ourselves, lseek will allow seek past EOF
-	if (payload->offset >= _session_info.file_size) {
+	if (payload->offset >= session->file_size) {
 		PX4_WARN("request past EOF");
 		return kErrEOF;
 	}
 
 	PX4_DEBUG("lseek with offset: %ld", payload->offset);
 
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
+	if (lseek(session->fd, payload->offset, SEEK_SET) < 0) {
 		_our_errno = errno;
 		PX4_ERR("seek fail: %s", strerror(_our_errno));
 		return kErrFailErrno;
 	}
 
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], payload->size);
+	int bytes_read = ::read(session->fd, &payload->data[0], payload->size);
 
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
@@ -594,19 +639,21 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t target_component_id)
 {
-	if (payload->session != 0 && _session_info.fd < 0) {
+	SessionInfo *session = _get_session(payload);
+
+	if (!session) {
 		PX4_DEBUG("_workBurst: no session or no fd");
 		return kErrInvalidSession;
 	}
 
 	PX4_DEBUG("FTP: burst offset:%" PRIu32, payload->offset);
 	// Setup for streaming sends
-	_session_info.stream_download = true;
-	_session_info.stream_offset = payload->offset;
-	_session_info.stream_chunk_transmitted = 0;
-	_session_info.stream_seq_number = payload->seq_number + 1;
-	_session_info.stream_target_system_id = target_system_id;
-	_session_info.stream_target_component_id = target_component_id;
+	session->stream_download = true;
+	session->stream_offset = payload->offset;
+	session->stream_chunk_transmitted = 0;
+	session->stream_seq_number = payload->seq_number + 1;
+	session->stream_target_system_id = target_system_id;
+	session->stream_target_component_id = target_component_id;
 
 	return kErrNone;
 }
@@ -615,7 +662,9 @@ MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workWrite(PayloadHeader *payload)
 {
-	if (payload->session != 0 && _session_info.fd < 0) {
+	SessionInfo *session = _get_session(payload);
+
+	if (!session) {
 		PX4_DEBUG("_workWrite: no session or no fd");
 		return kErrInvalidSession;
 	}
@@ -624,14 +673,18 @@ MavlinkFTP::_workWrite(PayloadHeader *payload)
 		return kErrFailFileProtected;
 	}
 
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
+	if (_stream_buffer_session == payload->session) {
+		_stream_buffer_session = -1;
+	}
+
+	if (lseek(session->fd, payload->offset, SEEK_SET) < 0) {
 		// Unable to see to the specified location
 		PX4_ERR("seek fail");
 		return kErrFailErrno;
 	}
 
 	PX4_DEBUG("write %d bytes", payload->size);
-	int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
+	int bytes_written = ::write(session->fd, &payload->data[0], payload->size);
 
 	if (bytes_written < 0) {
 		// Negative return indicates error other than eof
@@ -790,14 +843,12 @@ MavlinkFTP::_workTruncateFile(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workTerminate(PayloadHeader *payload)
 {
-	if (payload->session != 0 || _session_info.fd < 0) {
+	if (!_get_session(payload)) {
 		return kErrInvalidSession;
 	}
 
 	PX4_DEBUG("work terminate: close");
-	::close(_session_info.fd);
-	_session_info.fd = -1;
-	_session_info.stream_download = false;
+	_close_session(payload->session);
 
 	payload->size = 0;
 
@@ -810,10 +861,8 @@ MavlinkFTP::_workReset(PayloadHeader *payload)
 {
 	PX4_DEBUG("work reset: close");
 
-	if (_session_info.fd != -1) {
-		::close(_session_info.fd);
-		_session_info.fd = -1;
-		_session_info.stream_download = false;
+	for (uint8_t i = 0; i < kMaxSessions; ++i) {
+		_close_session(i);
 	}
 
 	payload->size = 0;
@@ -1010,6 +1059,63 @@ MavlinkFTP::_copy_file(const char *src_path, const char *dst_path, size_t length
 	return (length > 0) ? -1 : 0;
 }
 
+int MavlinkFTP::_stream_read(uint8_t session, uint32_t offset, uint8_t *dst, unsigned len)
+{
+	const int fd = _session_info[session].fd;
+
+	if (!_stream_buffer) {
+		_stream_buffer = new uint8_t[_stream_buffer_len];
+	}
+
+	if (!_stream_buffer) {
+		// read directly
+		if (lseek(fd, offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		return ::read(fd, dst, len);
+	}
+
+	if (_stream_buffer_session != session || offset < _stream_buffer_offset
+	    || offset > _stream_buffer_offset + _stream_buffer_fill) {
+		// not a continuation of the buffered data: start at an aligned offset
+		_stream_buffer_session = session;
+		_stream_buffer_offset = offset - (offset % kStreamReadLen);
+		_stream_buffer_fill = 0;
+	}
+
+	while (offset + len > _stream_buffer_offset + _stream_buffer_fill) {
+		// keep the part not sent yet and append the next block (file reads stay aligned)
+		const unsigned consumed = offset - _stream_buffer_offset;
+		memmove(_stream_buffer, _stream_buffer + consumed, _stream_buffer_fill - consumed);
+		_stream_buffer_offset += consumed;
+		_stream_buffer_fill -= consumed;
+
+		if (lseek(fd, _stream_buffer_offset + _stream_buffer_fill, SEEK_SET) < 0) {
+			_stream_buffer_session = -1;
+			return -1;
+		}
+
+		const int bytes_read = ::read(fd, _stream_buffer + _stream_buffer_fill, kStreamReadLen);
+
+		if (bytes_read < 0) {
+			_stream_buffer_session = -1;
+			return -1;
+		}
+
+		_stream_buffer_fill += bytes_read;
+
+		if (bytes_read < (int)kStreamReadLen) {
+			break; // end of file
+		}
+	}
+
+	const unsigned available = _stream_buffer_offset + _stream_buffer_fill - offset;
+	const unsigned bytes = (len < available) ? len : available;
+	memcpy(dst, _stream_buffer + (offset - _stream_buffer_offset), bytes);
+	return bytes;
+}
+
 void MavlinkFTP::send()
 {
 
@@ -1025,24 +1131,41 @@ void MavlinkFTP::send()
 				delete[] _work_buffer2;
 				_work_buffer2 = nullptr;
 			}
+
+			if (_stream_buffer) {
+				delete[] _stream_buffer;
+				_stream_buffer = nullptr;
+				_stream_buffer_session = -1;
+			}
 		}
 
-	} else if (_session_info.fd != -1) {
-		// close session without activity
-		if (hrt_elapsed_time(&_last_work_buffer_access) > 10_s) {
-			::close(_session_info.fd);
-			_session_info.fd = -1;
-			_session_info.stream_download = false;
-			_last_reply_valid = false;
-			PX4_WARN("Session was closed without activity");
+	} else if (hrt_elapsed_time(&_last_work_buffer_access) > 10_s) {
+		// close sessions without activity
+		for (uint8_t i = 0; i < kMaxSessions; ++i) {
+			if (_session_info[i].fd != -1) {
+				_close_session(i);
+				_last_reply_valid = false;
+				PX4_WARN("Session was closed without activity");
+			}
 		}
 	}
 
-	// Anything to stream?
-	if (!_session_info.stream_download) {
+	// Anything to stream? Sessions take turns.
+	uint8_t session_index = 0;
+	bool found = false;
+
+	for (uint8_t i = 0; i < kMaxSessions && !found; ++i) {
+		session_index = (_next_stream_session + i) % kMaxSessions;
+		found = _session_info[session_index].stream_download;
+	}
+
+	if (!found) {
 		return;
 	}
 
+	_next_stream_session = (session_index + 1) % kMaxSessions;
+	SessionInfo &session = _session_info[session_index];
+
 #ifndef MAVLINK_FTP_UNIT_TEST
 	// Skip send if not enough room
 	unsigned max_bytes_to_send = _mavlink.get_free_tx_buf();
@@ -1066,30 +1189,23 @@ void MavlinkFTP::send()
 		mavlink_file_transfer_protocol_t ftp_msg;
 		PayloadHeader *payload = reinterpret_cast<PayloadHeader *>(&ftp_msg.payload[0]);
 
-		payload->seq_number = _session_info.stream_seq_number;
-		payload->session = 0;
+		payload->seq_number = session.stream_seq_number;
+		payload->session = session_index;
 		payload->opcode = kRspAck;
 		payload->req_opcode = kCmdBurstReadFile;
-		payload->offset = _session_info.stream_offset;
-		_session_info.stream_seq_number++;
+		payload->offset = session.stream_offset;
+		session.stream_seq_number++;
 
-		PX4_DEBUG("stream send: offset %" PRIu32, _session_info.stream_offset);
+		PX4_DEBUG("stream send: offset %" PRIu32, session.stream_offset);
 
 		// We have to test seek past EOF ourselves, lseek will allow seek past EOF
-		if (_session_info.stream_offset >= _session_info.file_size) {
+		if (session.stream_offset >= session.file_size) {
 			error_code = kErrEOF;
 			PX4_DEBUG("stream download: sending Nak EOF");
 		}
 
 		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-				PX4_WARN("stream download: seek fail");
-			}
-		}
-
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+			int bytes_read = _stream_read(session_index, payload->offset, &payload->data[0], kMaxDataLength);
 
 			if (bytes_read < 0) {
 				// Negative return indicates error other than eof
@@ -1098,8 +1214,8 @@ void MavlinkFTP::send()
 
 			} else {
 				payload->size = bytes_read;
-				_session_info.stream_offset += bytes_read;
-				_session_info.stream_chunk_transmitted += bytes_read;
+				session.stream_offset += bytes_read;
+				session.stream_chunk_transmitted += bytes_read;
 			}
 		}
 
@@ -1114,7 +1230,7 @@ void MavlinkFTP::send()
 				payload->data[1] = _our_errno;
 			}
 
-			_session_info.stream_download = false;
+			session.stream_download = false;
 
 		} else {
 #ifndef MAVLINK_FTP_UNIT_TEST
@@ -1123,10 +1239,10 @@ void MavlinkFTP::send()
 				more_data = false;
 
 				/* perform transfers in 35K chunks - this is determined empirical */
-				if (_session_info.stream_chunk_transmitted > 35000) {
+				if (session.stream_chunk_transmitted > 35000) {
 					payload->burst_complete = true;
-					_session_info.stream_download = false;
-					_session_info.stream_chunk_transmitted = 0;
+					session.stream_download = false;
+					session.stream_chunk_transmitted = 0;
 				}
 
 			} else {
@@ -1140,9 +1256,9 @@ void MavlinkFTP::send()
 #endif
 		}
 
-		ftp_msg.target_system = _session_info.stream_target_system_id;
+		ftp_msg.target_system = session.stream_target_system_id;
 		ftp_msg.target_network = 0;
-		ftp_msg.target_component = _session_info.stream_target_component_id;
+		ftp_msg.target_component = session.stream_target_component_id;
 		_reply(&ftp_msg);
 	} while (more_data);
 }
@@ -171,6 +171,16 @@ private:
 	/// @brief Maximum data size in RequestHeader::data
 	static const uint8_t	kMaxDataLength = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(PayloadHeader);
 
+	/// @brief Maximum number of sessions (open files) at the same time
+	static constexpr uint8_t kMaxSessions = 2;
+
+	/// @brief Size of the reads for burst downloads
+#if defined(CONSTRAINED_MEMORY)
+	static constexpr unsigned kStreamReadLen = 1024;
+#else
+	static constexpr unsigned kStreamReadLen = 4096;
+#endif
+
 	struct SessionInfo {
 		int		fd;
 		uint32_t	file_size;
@@ -181,7 +191,29 @@ private:
 		uint8_t         stream_target_component_id;
 		unsigned	stream_chunk_transmitted;
 	};
-	struct SessionInfo _session_info {};	///< Session info, fd=-1 for no active session
+	struct SessionInfo _session_info[kMaxSessions] {};	///< Session info, fd=-1 for no active session
+	uint8_t _next_stream_session{0};	///< session to stream first on the next send()
+
+	/**
+	 * @return the open session addressed by the payload, nullptr if there is none
+	 */
+	SessionInfo *_get_session(const PayloadHeader *payload);
+
+	void _close_session(uint8_t session);
+
+	/**
+	 * Read file data of a burst download through the read-ahead buffer, so that the file is read in
+	 * aligned blocks of kStreamReadLen instead of once per packet.
+	 * @return number of bytes read, <0 on error
+	 */
+	int _stream_read(uint8_t session, uint32_t offset, uint8_t *dst, unsigned len);
+
+	/// read-ahead buffer for burst downloads, allocated on the first burst
+	uint8_t *_stream_buffer{nullptr};
+	static constexpr unsigned _stream_buffer_len = kStreamReadLen + kMaxDataLength;
+	uint32_t _stream_buffer_offset{0};	///< file offset of _stream_buffer[0]
+	unsigned _stream_buffer_fill{0};
+	int _stream_buffer_session{-1};	///< session of the buffered data, -1 if the buffer is empty
 
 	ReceiveMessageFunc_t	_utRcvMsgFunc{};	///< Unit test override for mavlink message sending
 	void			*_worker_data{nullptr};	///< Additional parameter to _utRcvMsgFunc;
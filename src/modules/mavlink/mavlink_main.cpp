@@ -85,6 +85,7 @@ static pthread_mutex_t mavlink_event_buffer_mutex = PTHREAD_MUTEX_INITIALIZER;
 events::EventBuffer *Mavlink::_event_buffer = nullptr;
 
 Mavlink *mavlink_module_instances[MAVLINK_COMM_NUM_BUFFERS] {};
+static MavlinkRoutingTable mavlink_routing_table; ///< protected by mavlink_module_mutex
 
 void mavlink_send_uart_bytes(mavlink_channel_t chan, const uint8_t *ch, int length) { mavlink_module_instances[chan]->send_bytes(ch, length); }
 void mavlink_start_uart_send(mavlink_channel_t chan, int length) { mavlink_module_instances[chan]->send_start(length); }
@@ -265,6 +266,7 @@ Mavlink::set_instance_id()
 		if (mavlink_module_instances[instance_id] == nullptr) {
 			mavlink_module_instances[instance_id] = this;
 			_instance_id = instance_id;
+			mavlink_routing_table.remove_link(instance_id); // routes of a previous instance
 			return true;
 		}
 	}
@@ -443,6 +445,14 @@ Mavlink::component_was_seen(int system_id, int component_id, Mavlink &self)
 	return false;
 }
 
+void
+Mavlink::add_route(uint8_t system_id, uint8_t component_id, Mavlink &self)
+{
+	LockGuard lg{mavlink_module_mutex};
+
+	mavlink_routing_table.add(system_id, component_id, self.get_instance_id());
+}
+
 void
 Mavlink::forward_message(const mavlink_message_t *msg, Mavlink *self)
 {
@@ -479,6 +489,29 @@ Mavlink::forward_message(const mavlink_message_t *msg, Mavlink *self)
 
 	LockGuard lg{mavlink_module_mutex};
 
+	// the same packet received over another link (redundant links or a loop) was already forwarded
+	if (mavlink_routing_table.is_duplicate(*msg, hrt_absolute_time())) {
+		return;
+	}
+
+	uint32_t links = 0;
+
+	if (mavlink_routing_table.links(target_system_id, target_component_id, links)) {
+		// Pass message only to the links on which the target component was seen before
+		links &= ~(1u << self->get_instance_id());
+
+		for (int i = 0; links != 0; ++i, links >>= 1) {
+			Mavlink *inst = mavlink_module_instances[i];
+
+			if ((links & 1u) && inst && inst->get_forwarding_on()) {
+				inst->pass_message(msg);
+			}
+		}
+
+		return;
+	}
+
+	// routing table overflowed, check every instance
 	for (Mavlink *inst : mavlink_module_instances) {
 		if (inst && (inst != self) && (inst->get_forwarding_on())) {
 			// Pass message only if target component was seen before
@@ -760,6 +793,8 @@ void Mavlink::send_finish()
 
 	int ret = -1;
 
+	_tx_bytes_total += _buf_fill;
+
 	// send message to UART
 	if (get_protocol() == Protocol::SERIAL) {
 		ret = ::write(_uart_fd, _buf, _buf_fill);
@@ -768,39 +803,21 @@ void Mavlink::send_finish()
 #if defined(MAVLINK_UDP)
 
 	else if (get_protocol() == Protocol::UDP) {
-
-# if defined(CONFIG_NET)
-
-		if (_src_addr_initialized) {
-# endif // CONFIG_NET
-			ret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_src_addr, sizeof(_src_addr));
-# if defined(CONFIG_NET)
-		}
-
-# endif // CONFIG_NET
-
-		if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
-		    (!get_client_source_initialized() || !is_gcs_connected())) {
-
-			if (!_broadcast_address_found) {
-				find_broadcast_address();
+		if (_udp_tx_coalescing) {
+			if (_udp_tx_fill + _buf_fill > sizeof(_udp_tx_buf)) {
+				udp_flush_locked();
 			}
 
-			if (_broadcast_address_found && _buf_fill > 0) {
-
-				int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
-
-				if (bret <= 0) {
-					if (!_broadcast_failed_warned) {
-						PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
-						_broadcast_failed_warned = true;
-					}
+			memcpy(&_udp_tx_buf[_udp_tx_fill], _buf, _buf_fill);
+			_udp_tx_fill += _buf_fill;
+			++_udp_tx_num_msgs;
+			_buf_fill = 0;
 
-				} else {
-					_broadcast_failed_warned = false;
-				}
-			}
+			pthread_mutex_unlock(&_send_mutex);
+			return;
 		}
+
+		ret = udp_send(_buf, _buf_fill);
 	}
 
 #endif // MAVLINK_UDP
@@ -833,6 +850,115 @@ void Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 }
 
 #ifdef MAVLINK_UDP
+int Mavlink::udp_send(const uint8_t *buf, unsigned len)
+{
+	sockaddr_in *dest[2];
+	int num_dest = 0;
+	int bcast_index = -1;
+
+# if defined(CONFIG_NET)
+
+	if (_src_addr_initialized)
+# endif // CONFIG_NET
+	{
+		dest[num_dest++] = &_src_addr;
+	}
+
+	if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
+	    (!get_client_source_initialized() || !is_gcs_connected())) {
+
+		if (!_broadcast_address_found) {
+			find_broadcast_address();
+		}
+
+		if (_broadcast_address_found) {
+			bcast_index = num_dest;
+			dest[num_dest++] = &_bcast_addr;
+		}
+	}
+
+	int sent[2] {-1, -1};
+
+# if defined(__PX4_LINUX)
+
+	if (num_dest > 1) {
+		// one system call for all destinations
+		iovec iov{const_cast<uint8_t *>(buf), len};
+		mmsghdr msgs[2] {};
+
+		for (int i = 0; i < num_dest; ++i) {
+			msgs[i].msg_hdr.msg_name = dest[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			msgs[i].msg_hdr.msg_iov = &iov;
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int num_sent = sendmmsg(_socket_fd, msgs, num_dest, 0);
+
+		for (int i = 0; i < num_sent; ++i) {
+			sent[i] = msgs[i].msg_len;
+		}
+
+	} else
+# endif // __PX4_LINUX
+	{
+		for (int i = 0; i < num_dest; ++i) {
+			sent[i] = sendto(_socket_fd, buf, len, 0, (struct sockaddr *)dest[i], sizeof(sockaddr_in));
+		}
+	}
+
+	if (bcast_index >= 0) {
+		if (sent[bcast_index] <= 0) {
+			if (!_broadcast_failed_warned) {
+				PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+				_broadcast_failed_warned = true;
+			}
+
+		} else {
+			_broadcast_failed_warned = false;
+		}
+	}
+
+	return (bcast_index == 0 || num_dest == 0) ? -1 : sent[0];
+}
+
+void Mavlink::udp_flush_locked()
+{
+	if (_udp_tx_fill == 0) {
+		return;
+	}
+
+	const int ret = udp_send(_udp_tx_buf, _udp_tx_fill);
+
+	if (ret == (int)_udp_tx_fill) {
+		_tstatus.tx_message_count += _udp_tx_num_msgs;
+		count_txbytes(_udp_tx_fill);
+		_last_write_success_time = _last_write_try_time;
+
+	} else {
+		count_txerrbytes(_udp_tx_fill);
+	}
+
+	_udp_tx_fill = 0;
+	_udp_tx_num_msgs = 0;
+}
+
+void Mavlink::set_udp_tx_coalescing(bool enable)
+{
+	if (get_protocol() != Protocol::UDP) {
+		return;
+	}
+
+	pthread_mutex_lock(&_send_mutex);
+
+	if (!enable) {
+		udp_flush_locked();
+	}
+
+	_udp_tx_coalescing = enable;
+	pthread_mutex_unlock(&_send_mutex);
+}
+
 void Mavlink::find_broadcast_address()
 {
 	struct ifconf ifconf;
@@ -1168,6 +1294,8 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 
 	for (const auto &stream : _streams) {
 		if (strcmp(stream_name, stream->get_name()) == 0) {
+			_stream_scheduler.invalidate();
+
 			if (interval != 0) {
 				/* set new interval */
 				stream->set_interval(interval);
@@ -1189,6 +1317,7 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 	if (stream != nullptr) {
 		stream->set_interval(interval);
 		_streams.add(stream);
+		_stream_scheduler.invalidate();
 
 		return OK;
 	}
@@ -1284,14 +1413,19 @@ Mavlink::update_rate_mult()
 {
 	float const_rate = 0.0f;
 	float rate = 0.0f;
+	float priority_rate[MavlinkStream::NUM_PRIORITIES] {};
 
 	/* scale down rates if their theoretical bandwidth is exceeding the link bandwidth */
 	for (const auto &stream : _streams) {
+		const float stream_rate = (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() :
+					  0;
+
 		if (stream->const_rate()) {
-			const_rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			const_rate += stream_rate;
 
 		} else {
-			rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			rate += stream_rate;
+			priority_rate[(int)stream->get_priority()] += stream_rate;
 		}
 	}
 
@@ -1341,6 +1475,40 @@ Mavlink::update_rate_mult()
 
 	pthread_mutex_unlock(&_radio_status_mutex);
 
+	// scale down if the round trip time increases, indicating that the link is queueing
+	const uint32_t rtt_samples = _receiver.round_trip_time_samples();
+
+	if (rtt_samples != _rtt_samples) {
+		const uint32_t rtt = _receiver.round_trip_time();
+		_rtt_samples = rtt_samples;
+		_rtt_sample_time = hrt_absolute_time();
+
+		// baseline of the uncongested link, slowly following increases (e.g. route changes)
+		if (_rtt_baseline == 0 || rtt < _rtt_baseline) {
+			_rtt_baseline = rtt;
+
+		} else {
+			_rtt_baseline += (rtt - _rtt_baseline) / 64;
+		}
+
+		if (rtt > 2 * _rtt_baseline + RTT_CONGESTION_MARGIN) {
+			_rtt_mult *= 0.8f;
+
+		} else if (rtt < _rtt_baseline + _rtt_baseline / 2 + RTT_CONGESTION_MARGIN) {
+			_rtt_mult *= 1.025f;
+		}
+
+		_rtt_mult = math::constrain(_rtt_mult, 0.05f, 1.0f);
+
+	} else if ((_rtt_sample_time != 0) && (hrt_elapsed_time(&_rtt_sample_time) > 5_s)) {
+		// no timesync partner (anymore)
+		_rtt_mult = 1.0f;
+		_rtt_baseline = 0;
+		_rtt_sample_time = 0;
+	}
+
+	hardware_mult *= _rtt_mult;
+
 	if (log_radio_timeout) {
 		PX4_ERR("instance %d: RADIO_STATUS timeout", _instance_id);
 	}
@@ -1350,6 +1518,21 @@ Mavlink::update_rate_mult()
 
 	/* ensure the rate multiplier never drops below 5% so that something is always sent */
 	_rate_mult = math::constrain(_rate_mult, 0.05f, 1.0f);
+
+	/* distribute the resulting bandwidth in priority order: higher priority streams keep their
+	 * rate as long as possible, lower priority streams get what remains */
+	float bandwidth = _rate_mult * rate;
+
+	for (int i = 0; i < MavlinkStream::NUM_PRIORITIES; ++i) {
+		float mult = 1.0f;
+
+		if (priority_rate[i] > 0.f) {
+			mult = math::constrain(bandwidth / priority_rate[i], 0.05f, 1.0f);
+			bandwidth = fmaxf(bandwidth - mult * priority_rate[i], 0.f);
+		}
+
+		_priority_rate_mult[i] = mult;
+	}
 }
 
 void
@@ -2371,6 +2554,11 @@ Mavlink::task_main(int argc, char *argv[])
 		perf_count(_loop_interval_perf);
 		perf_begin(_loop_perf);
 
+#if defined(MAVLINK_UDP)
+		// send the packets of this iteration in as few datagrams as possible
+		set_udp_tx_coalescing(true);
+#endif // MAVLINK_UDP
+
 		const hrt_abstime t = hrt_absolute_time();
 
 		update_rate_mult();
@@ -2394,27 +2582,24 @@ Mavlink::task_main(int argc, char *argv[])
 
 		check_requested_subscriptions();
 
-		/* update streams */
-		for (const auto &stream : _streams) {
-			stream->update(t);
+		/* update the streams that are due */
+		_stream_scheduler.update(_streams, t, _priority_rate_mult);
 
-			if (!_first_heartbeat_sent) {
-				if (_mode == MAVLINK_MODE_IRIDIUM) {
-					if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
+		send_bench_load(t);
 
-				} else {
-					if (stream->get_id() == MAVLINK_MSG_ID_HEARTBEAT) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
+		if (!_first_heartbeat_sent) {
+			const uint16_t heartbeat_id = (_mode == MAVLINK_MODE_IRIDIUM) ? MAVLINK_MSG_ID_HIGH_LATENCY2 : MAVLINK_MSG_ID_HEARTBEAT;
+
+			for (const auto &stream : _streams) {
+				if (stream->get_id() == heartbeat_id) {
+					_first_heartbeat_sent = stream->first_message_sent();
 				}
 			}
 		}
 
 		/* check for ulog streaming messages */
 		if (_mavlink_ulog) {
-			const int ret = _mavlink_ulog->handle_update(get_channel());
+			const int ret = _mavlink_ulog->handle_update(get_channel(), get_free_tx_buf());
 
 			if (ret < 0) { // abort the streaming on error
 				if (ret != -1) {
@@ -2485,6 +2670,8 @@ Mavlink::task_main(int argc, char *argv[])
 				_bytes_tx = 0;
 				_bytes_txerr = 0;
 				_bytes_rx = 0;
+
+				publish_stream_status(t - _bytes_timestamp);
 			}
 
 			_bytes_timestamp = t;
@@ -2495,6 +2682,11 @@ Mavlink::task_main(int argc, char *argv[])
 			publish_telemetry_status();
 		}
 
+#if defined(MAVLINK_UDP)
+		set_udp_tx_coalescing(false);
+#endif // MAVLINK_UDP
+
+		_tx_cpu_time.fetch_add(hrt_elapsed_time(&t));
 		perf_end(_loop_perf);
 	}
 
@@ -2504,6 +2696,7 @@ Mavlink::task_main(int argc, char *argv[])
 	_subscribe_to_stream = nullptr;
 
 	/* delete streams */
+	_stream_scheduler.invalidate();
 	_streams.clear();
 
 	if (_uart_fd >= 0) {
@@ -2826,6 +3019,39 @@ void Mavlink::publish_telemetry_status()
 	_tstatus_updated = false;
 }
 
+void Mavlink::publish_stream_status(uint32_t interval)
+{
+	mavlink_stream_status_s stream_status{};
+	stream_status.instance_id = get_instance_id();
+	stream_status.total_streams = _streams.size();
+	stream_status.interval = interval;
+
+	uint8_t index = 0;
+
+	for (const auto &stream : _streams) {
+		stream->rotate_statistics();
+
+		const MavlinkStream::Statistics &stats = stream->statistics();
+		const uint8_t i = stream_status.num_streams++;
+		stream_status.msg_id[i] = stream->get_id();
+		stream_status.sent[i] = stats.sent;
+		stream_status.cpu_time[i] = stats.cpu_time;
+		stream_status.tx_bytes[i] = stats.tx_bytes;
+		stream_status.tx_skipped[i] = stats.tx_skipped;
+		++index;
+
+		if (stream_status.num_streams == mavlink_stream_status_s::MAX_STREAMS || index == stream_status.total_streams) {
+			stream_status.timestamp = hrt_absolute_time();
+			_stream_status_pub.publish(stream_status);
+
+			stream_status.first_stream = index;
+			stream_status.num_streams = 0;
+		}
+	}
+
+	_stream_stats_interval = interval;
+}
+
 void Mavlink::configure_sik_radio()
 {
 	/* radio config check */
@@ -3083,9 +3309,10 @@ Mavlink::display_status()
 void
 Mavlink::display_status_streams()
 {
-	printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
+	printf("\t%-30s%-22s %8s %9s %10s %9s %10s\n", "Name", "Rate Config (current) [Hz]", "Size [B]", "Sent [Hz]",
+	       "CPU [us/s]", "TX [B/s]", "Skip [1/s]");
 
-	const float rate_mult = _rate_mult;
+	const float stats_interval = _stream_stats_interval * 1e-6f;
 
 	for (const auto &stream : _streams) {
 		const int interval = stream->get_interval();
@@ -3099,14 +3326,25 @@ Mavlink::display_status_streams()
 			float rate = 1000000.0f / (float)interval;
 			// Note that the actual current rate can be lower if the associated uORB topic updates at a
 			// lower rate.
-			float rate_current = stream->const_rate() ? rate : rate * rate_mult;
+			float rate_current = stream->const_rate() ? rate : rate * get_rate_mult(stream->get_priority());
 			snprintf(rate_str, sizeof(rate_str), "%6.2f (%.3f)", (double)rate, (double)rate_current);
 		}
 
-		printf("\t%-30s%-16s", stream->get_name(), rate_str);
+		printf("\t%-30s%-22s", stream->get_name(), rate_str);
 
 		if (size > 0) {
-			printf(" %3u\n", size);
+			printf(" %8u", size);
+
+		} else {
+			printf(" %8s", "");
+		}
+
+		if (stats_interval > 0.f) {
+			// statistics of the last interval (updated once per second)
+			const MavlinkStream::Statistics &stats = stream->statistics();
+			printf(" %9.2f %10.0f %9.0f %10.2f\n", (double)(stats.sent / stats_interval),
+			       (double)(stats.cpu_time / stats_interval), (double)(stats.tx_bytes / stats_interval),
+			       (double)(stats.tx_skipped / stats_interval));
 
 		} else {
 			printf("\n");
@@ -3369,6 +3607,164 @@ Mavlink::set_boot_complete()
 
 }
 
+void Mavlink::send_bench_load(const hrt_abstime &t)
+{
+	const uint32_t rate = _bench_rate.load();
+
+	if (rate == 0) {
+		_bench_next_send = 0;
+		return;
+	}
+
+	// don't try to catch up after a stall, this only reduces the load
+	if (_bench_next_send == 0 || t > _bench_next_send + 1_s) {
+		_bench_next_send = t;
+	}
+
+	mavlink_tunnel_t tunnel{};
+	tunnel.payload_type = MAV_TUNNEL_PAYLOAD_TYPE_UNKNOWN;
+	tunnel.payload_length = math::min(_bench_payload_size.load(), (uint32_t)sizeof(tunnel.payload));
+
+	// non-zero payload, MAVLink 2 truncates trailing zeros
+	memset(tunnel.payload, 0xAA, tunnel.payload_length);
+
+	const unsigned packet_size = MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_TUNNEL_LEN;
+
+	while (_bench_next_send <= t) {
+		if (get_free_tx_buf() >= packet_size) {
+			mavlink_msg_tunnel_send_struct(get_channel(), &tunnel);
+			_bench_sent.fetch_add(1);
+
+		} else {
+			_bench_skipped.fetch_add(1);
+		}
+
+		_bench_next_send += 1_s / rate;
+	}
+}
+
+int
+Mavlink::bench_command(int argc, char *argv[])
+{
+	const char *device_name = nullptr;
+	int rate = 0;
+	int payload_size = 128;
+	int duration = 10;
+#ifdef MAVLINK_UDP
+	int network_port = -1;
+#endif // MAVLINK_UDP
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc - 1, argv + 1, "d:u:r:s:t:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'd':
+			device_name = myoptarg;
+			break;
+#ifdef MAVLINK_UDP
+
+		case 'u':
+			network_port = strtol(myoptarg, nullptr, 0);
+			break;
+#endif // MAVLINK_UDP
+
+		case 'r':
+			rate = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 's':
+			payload_size = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 't':
+			duration = strtol(myoptarg, nullptr, 0);
+			break;
+
+		default:
+			return 1;
+		}
+	}
+
+	if (rate < 0 || rate > 10000 || payload_size < 0 || payload_size > MAVLINK_MSG_TUNNEL_FIELD_PAYLOAD_LEN
+	    || duration <= 0) {
+		PX4_ERR("invalid argument");
+		return 1;
+	}
+
+	Mavlink *inst = nullptr;
+
+	if (device_name) {
+		inst = get_instance_for_device(device_name);
+	}
+
+#ifdef MAVLINK_UDP
+
+	else if (network_port >= 0) {
+		inst = get_instance_for_network_port(network_port);
+	}
+
+#endif // MAVLINK_UDP
+
+	if (inst == nullptr) {
+		PX4_ERR("mavlink instance not found, select it with -d or -u");
+		return 1;
+	}
+
+	struct Snapshot {
+		hrt_abstime time;
+		uint32_t tx_messages;
+		uint32_t tx_bytes;
+		uint32_t tx_buffer_overruns;
+		uint32_t tx_cpu_time;
+		uint32_t bench_sent;
+		uint32_t bench_skipped;
+		uint32_t rx_messages;
+		uint32_t rx_lost;
+		uint32_t rx_parse_errors;
+		uint32_t rx_cpu_time;
+	};
+
+	auto snapshot = [inst]() {
+		const telemetry_status_s &tstatus = inst->telemetry_status();
+		return Snapshot{hrt_absolute_time(), tstatus.tx_message_count, inst->get_tx_bytes_total(),
+				tstatus.tx_buffer_overruns, inst->_tx_cpu_time.load(), inst->_bench_sent.load(),
+				inst->_bench_skipped.load(), tstatus.rx_message_count, tstatus.rx_message_lost_count,
+				tstatus.rx_parse_errors, inst->_receiver.rx_cpu_time()};
+	};
+
+	PX4_INFO("instance #%i: synthetic load %i Hz (%i B payload), measuring for %i s", inst->get_instance_id(), rate,
+		 payload_size, duration);
+
+	inst->_bench_payload_size.store(payload_size);
+	inst->_bench_rate.store(rate);
+
+	const Snapshot start = snapshot();
+	px4_sleep(duration);
+	const Snapshot end = snapshot();
+
+	inst->_bench_rate.store(0);
+
+	const float dt = (end.time - start.time) * 1e-6f;
+	const uint32_t tx_messages = end.tx_messages - start.tx_messages;
+	const uint32_t rx_messages = end.rx_messages - start.rx_messages;
+
+	printf("TX: %8.1f msg/s %9.1f B/s, CPU: %6.1f us/msg (%.1f%%), buffer overruns: %.1f/s\n",
+	       (double)(tx_messages / dt), (double)((end.tx_bytes - start.tx_bytes) / dt),
+	       (double)(tx_messages > 0 ? (float)(end.tx_cpu_time - start.tx_cpu_time) / tx_messages : 0.f),
+	       (double)((end.tx_cpu_time - start.tx_cpu_time) / dt * 1e-4f),
+	       (double)((end.tx_buffer_overruns - start.tx_buffer_overruns) / dt));
+	printf("    synthetic: %8.1f msg/s, TX buffer full: %.1f/s\n",
+	       (double)((end.bench_sent - start.bench_sent) / dt), (double)((end.bench_skipped - start.bench_skipped) / dt));
+	printf("RX: %8.1f msg/s, CPU: %6.1f us/msg (%.1f%%), lost: %" PRIu32 ", parse errors: %" PRIu32 "\n",
+	       (double)(rx_messages / dt),
+	       (double)(rx_messages > 0 ? (float)(end.rx_cpu_time - start.rx_cpu_time) / rx_messages : 0.f),
+	       (double)((end.rx_cpu_time - start.rx_cpu_time) / dt * 1e-4f),
+	       end.rx_lost - start.rx_lost, end.rx_parse_errors - start.rx_parse_errors);
+
+	return 0;
+}
+
 static void usage()
 {
 
@@ -3400,6 +3796,11 @@ $ mavlink start -d /dev/ttyS1 -b 921600 -m onboard -r 80000
 Start mavlink on UDP port 14556 and enable the HIGHRES_IMU message with 50Hz:
 $ mavlink start -u 14556 -r 1000000
 $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
+
+Measure the TX and RX rates and CPU usage with an additional synthetic load of 500 messages/s on an instance
+whose UDP port is looped back to itself (the RX side then parses the instance's own messages):
+$ mavlink start -u 14600 -o 14600 -t 127.0.0.1 -r 1000000
+$ mavlink bench -u 14600 -r 500 -t 10
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("mavlink", "communication");
@@ -3446,6 +3847,16 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_STRING('s', nullptr, nullptr, "Mavlink stream to configure", false);
 	PRINT_MODULE_USAGE_PARAM_FLOAT('r', -1.0f, 0.0f, 2000.0f, "Rate in Hz (0 = turn off, -1 = set to default)", false);
 
+	PRINT_MODULE_USAGE_COMMAND_DESCR("bench",
+					 "Measure message rates and CPU usage of a running instance, optionally with a synthetic load");
+#if defined(CONFIG_NET) || defined(__PX4_POSIX)
+	PRINT_MODULE_USAGE_PARAM_INT('u', -1, 0, 65536, "Select Mavlink instance via local Network Port", true);
+#endif
+	PRINT_MODULE_USAGE_PARAM_STRING('d', nullptr, "<file:dev>", "Select Mavlink instance via Serial Device", true);
+	PRINT_MODULE_USAGE_PARAM_INT('r', 0, 0, 10000, "Rate of the synthetic load (TUNNEL messages) in Hz", true);
+	PRINT_MODULE_USAGE_PARAM_INT('s', 128, 0, 128, "Payload size of the synthetic load messages in bytes", true);
+	PRINT_MODULE_USAGE_PARAM_INT('t', 10, 1, 3600, "Measurement duration in seconds", true);
+
 	PRINT_MODULE_USAGE_COMMAND_DESCR("boot_complete",
 					 "Enable sending of messages. (Must be) called as last step in startup script.");
 
@@ -3474,6 +3885,9 @@ extern "C" __EXPORT int mavlink_main(int argc, char *argv[])
 	} else if (!strcmp(argv[1], "stream")) {
 		return Mavlink::stream_command(argc, argv);
 
+	} else if (!strcmp(argv[1], "bench")) {
+		return Mavlink::bench_command(argc, argv);
+
 	} else if (!strcmp(argv[1], "boot_complete")) {
 		Mavlink::set_boot_complete();
 		return 0;
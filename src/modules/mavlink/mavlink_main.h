@@ -72,6 +72,7 @@
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/SubscriptionInterval.hpp>
+#include <uORB/topics/mavlink_stream_status.h>
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/radio_status.h>
 #include <uORB/topics/telemetry_status.h>
@@ -83,17 +84,22 @@
 #include "mavlink_events.h"
 #include "mavlink_messages.h"
 #include "mavlink_receiver.h"
+#include "mavlink_routing.h"
 #include "mavlink_shell.h"
+#include "mavlink_stream_scheduler.h"
 #include "mavlink_ulog.h"
 
 #define DEFAULT_BAUD_RATE       57600
 #define DEFAULT_DEVICE_NAME     "/dev/ttyS1"
 
 #define HASH_PARAM              "_HASH_CHECK"
+#define HASH_CHUNK_PARAM        "_HASH_CHUNK"
+#define SNAPSHOT_PARAM          "_PARAM_SNAPSHOT"
 
 #if defined(CONFIG_NET) || defined(__PX4_POSIX)
 # define MAVLINK_UDP
 # define DEFAULT_REMOTE_PORT_UDP 14550 ///< GCS port per MAVLink spec
+# define MAVLINK_UDP_TX_BUF_LEN 1472 ///< coalesced UDP payload: 1500 bytes MTU - IP and UDP headers
 #endif // CONFIG_NET || __PX4_POSIX
 
 enum class Protocol {
@@ -127,6 +133,7 @@ public:
 
 	static int stop_command(int argc, char *argv[]);
 	static int stream_command(int argc, char *argv[]);
+	static int bench_command(int argc, char *argv[]);
 
 	static int instance_count();
 	static Mavlink *new_instance();
@@ -145,6 +152,11 @@ public:
 	static bool component_was_seen(int system_id, int component_id, Mavlink &self);
 	static void forward_message(const mavlink_message_t *msg, Mavlink *self);
 
+	/**
+	 * Record a component seen on a link for routing forwarded messages
+	 */
+	static void add_route(uint8_t system_id, uint8_t component_id, Mavlink &self);
+
 	bool check_events() const { return _should_check_events.load(); }
 	void check_events_enable() { _should_check_events.store(true); }
 	void check_events_disable() { _should_check_events.store(false); }
@@ -378,8 +390,16 @@ public:
 
 	List<MavlinkStream *> &get_streams() { return _streams; }
 
+	/** the due time of a stream changed outside of its update() */
+	void			reschedule_streams() { _stream_scheduler.invalidate(); }
+
 	float			get_rate_mult() const { return _rate_mult; }
 
+	/**
+	 * Get the rate multiplier for the streams of a priority
+	 */
+	float			get_rate_mult(MavlinkStream::Priority priority) const { return _priority_rate_mult[(int)priority]; }
+
 	float			get_baudrate() { return _baudrate; }
 
 	/* Functions for waiting to start transmission until message received. */
@@ -394,6 +414,11 @@ public:
 	 */
 	void			count_txbytes(unsigned n) { _bytes_tx += n; };
 
+	/**
+	 * Get the total number of bytes accepted for sending (including bytes still in the UDP coalescing buffer)
+	 */
+	uint32_t		get_tx_bytes_total() const { return _tx_bytes_total; }
+
 	/**
 	 * Count bytes not transmitted because of errors
 	 */
@@ -460,7 +485,7 @@ public:
 	{
 		if (_mavlink_ulog) { return; }
 
-		_mavlink_ulog = MavlinkULog::try_start(_datarate, 0.7f, target_system, target_component);
+		_mavlink_ulog = MavlinkULog::try_start(_datarate, 0.7f, _param_mav_ulog_win.get(), target_system, target_component);
 	}
 
 	const events::SendProtocol &get_events_protocol() const { return _events; };
@@ -468,6 +493,7 @@ public:
 
 	bool hash_check_enabled() const { return _param_mav_hash_chk_en.get(); }
 	bool forward_heartbeats_enabled() const { return _param_mav_hb_forw_en.get(); }
+	int mission_window() const { return _param_mav_mis_win.get(); }
 
 	bool failure_injection_enabled() const { return _param_sys_failure_injection_enabled.get(); }
 
@@ -507,6 +533,7 @@ private:
 
 	uORB::Publication<vehicle_command_ack_s> _vehicle_command_ack_pub{ORB_ID(vehicle_command_ack)};
 	uORB::PublicationMulti<telemetry_status_s> _telemetry_status_pub{ORB_ID(telemetry_status)};
+	uORB::PublicationMulti<mavlink_stream_status_s> _stream_status_pub{ORB_ID(mavlink_stream_status)};
 
 	uORB::Subscription _event_sub{ORB_ID(event)};
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
@@ -533,9 +560,17 @@ private:
 	px4::atomic_bool	_should_check_events{false};    /**< Events subscription: only one MAVLink instance should check */
 	px4::atomic_bool	_sending_parameters{false};     /**< True if parameters are currently sent out */
 
+	px4::atomic<uint32_t>	_bench_rate{0};			/**< synthetic load (TUNNEL messages) [Hz], 0 if disabled, set by 'mavlink bench' */
+	px4::atomic<uint32_t>	_bench_payload_size{0};		/**< payload size of the synthetic load messages [B] */
+	px4::atomic<uint32_t>	_bench_sent{0};			/**< synthetic load messages sent */
+	px4::atomic<uint32_t>	_bench_skipped{0};		/**< synthetic load messages not sent because the TX buffer was full */
+	px4::atomic<uint32_t>	_tx_cpu_time{0};		/**< total time spent in the send loop [us] */
+	hrt_abstime		_bench_next_send{0};
+
 	unsigned		_main_loop_delay{1000};	/**< mainloop delay, depends on data rate */
 
 	List<MavlinkStream *>		_streams;
+	MavlinkStreamScheduler		_stream_scheduler;
 
 	MavlinkShell		*_mavlink_shell{nullptr};
 	pthread_mutex_t		_mavlink_shell_mutex{};
@@ -556,6 +591,12 @@ private:
 	int			_baudrate{57600};
 	int			_datarate{1000};		///< data rate for normal streams (attitude, position, etc.)
 	float			_rate_mult{1.0f};
+	float			_priority_rate_mult[MavlinkStream::NUM_PRIORITIES] {1.0f, 1.0f, 1.0f};
+
+	float			_rtt_mult{1.0f};		///< rate multiplier from the round trip time
+	uint32_t		_rtt_baseline{0};		///< round trip time of the uncongested link [us]
+	uint32_t		_rtt_samples{0};
+	hrt_abstime		_rtt_sample_time{0};
 	float			_high_latency_freq{0.015f};	///< frequency of HIGH_LATENCY2 stream
 
 	bool			_radio_status_available{false};
@@ -584,6 +625,8 @@ private:
 	unsigned		_bytes_txerr{0};
 	unsigned		_bytes_rx{0};
 	hrt_abstime		_bytes_timestamp{0};
+	uint32_t		_tx_bytes_total{0};
+	uint32_t		_stream_stats_interval{0};	///< length of the last stream statistics interval [us]
 
 #if defined(MAVLINK_UDP)
 	BROADCAST_MODE		_mav_broadcast {BROADCAST_MODE_OFF};
@@ -599,6 +642,11 @@ private:
 
 	unsigned short		_network_port{14556};
 	unsigned short		_remote_port{DEFAULT_REMOTE_PORT_UDP};
+
+	uint8_t			_udp_tx_buf[MAVLINK_UDP_TX_BUF_LEN] {}; ///< coalesced packets, protected by _send_mutex
+	unsigned		_udp_tx_fill{0};
+	unsigned		_udp_tx_num_msgs{0};
+	bool			_udp_tx_coalescing{false};
 #endif // MAVLINK_UDP
 
 	uint8_t			_buf[MAVLINK_MAX_PACKET_LEN] {};
@@ -634,6 +682,8 @@ private:
 		(ParamBool<px4::params::MAV_HASH_CHK_EN>) _param_mav_hash_chk_en,
 		(ParamBool<px4::params::MAV_HB_FORW_EN>) _param_mav_hb_forw_en,
 		(ParamInt<px4::params::MAV_RADIO_TOUT>)      _param_mav_radio_timeout,
+		(ParamInt<px4::params::MAV_ULOG_WIN>) _param_mav_ulog_win,
+		(ParamInt<px4::params::MAV_MIS_WIN>) _param_mav_mis_win,
 		(ParamInt<px4::params::SYS_HITL>) _param_sys_hitl,
 		(ParamBool<px4::params::SYS_FAILURE_EN>) _param_sys_failure_injection_enabled
 	)
@@ -645,6 +695,11 @@ private:
 
 	void			mavlink_update_parameters();
 
+	/**
+	 * Send the synthetic load messages that are due
+	 */
+	void			send_bench_load(const hrt_abstime &t);
+
 	int mavlink_open_uart(const int baudrate = DEFAULT_BAUD_RATE,
 			      const char *uart_name = DEFAULT_DEVICE_NAME,
 			      const FLOW_CONTROL_MODE flow_control = FLOW_CONTROL_AUTO);
@@ -652,6 +707,7 @@ private:
 	static constexpr unsigned RADIO_BUFFER_CRITICAL_LOW_PERCENTAGE = 25;
 	static constexpr unsigned RADIO_BUFFER_LOW_PERCENTAGE = 35;
 	static constexpr unsigned RADIO_BUFFER_HALF_PERCENTAGE = 50;
+	static constexpr uint32_t RTT_CONGESTION_MARGIN = 50_ms; ///< round trip time jitter tolerated before reducing the rate
 
 	static hrt_abstime _first_start_time;
 
@@ -675,6 +731,11 @@ private:
 
 	void publish_telemetry_status();
 
+	/**
+	 * Complete the statistics interval of all streams and publish them
+	 */
+	void publish_stream_status(uint32_t interval);
+
 	void check_requested_subscriptions();
 
 	void handleCommands();
@@ -702,6 +763,23 @@ private:
 	void find_broadcast_address();
 
 	void init_udp();
+
+	/**
+	 * Send a datagram to the client and the broadcast address (if enabled).
+	 * @return result of the send to the client, -1 if there is no client
+	 */
+	int udp_send(const uint8_t *buf, unsigned len);
+
+	/**
+	 * Send the coalesced UDP packets. _send_mutex must be locked.
+	 */
+	void udp_flush_locked();
+
+	/**
+	 * While enabled, MAVLink packets on UDP are collected into datagrams of up to
+	 * MAVLINK_UDP_TX_BUF_LEN bytes. Disabling sends the collected packets.
+	 */
+	void set_udp_tx_coalescing(bool enable);
 #endif // MAVLINK_UDP
 
 
@@ -524,6 +524,61 @@ static const StreamListItem streams_list[] = {
 #endif // GLOBAL_POSITION_HPP
 };
 
+static MavlinkStream::Priority get_stream_priority(const uint16_t msg_id)
+{
+	switch (msg_id) {
+	case MAVLINK_MSG_ID_HEARTBEAT:
+	case MAVLINK_MSG_ID_SYS_STATUS:
+	case MAVLINK_MSG_ID_EXTENDED_SYS_STATE:
+	case MAVLINK_MSG_ID_BATTERY_STATUS:
+	case MAVLINK_MSG_ID_ATTITUDE:
+	case MAVLINK_MSG_ID_ATTITUDE_QUATERNION:
+	case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+	case MAVLINK_MSG_ID_LOCAL_POSITION_NED:
+	case MAVLINK_MSG_ID_GPS_RAW_INT:
+	case MAVLINK_MSG_ID_VFR_HUD:
+	case MAVLINK_MSG_ID_HOME_POSITION:
+	case MAVLINK_MSG_ID_STATUSTEXT:
+	case MAVLINK_MSG_ID_COMMAND_LONG:
+		return MavlinkStream::Priority::High;
+
+	case MAVLINK_MSG_ID_DEBUG:
+	case MAVLINK_MSG_ID_DEBUG_VECT:
+	case MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY:
+	case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
+	case MAVLINK_MSG_ID_ESC_INFO:
+	case MAVLINK_MSG_ID_ESC_STATUS:
+	case MAVLINK_MSG_ID_SCALED_IMU:
+	case MAVLINK_MSG_ID_SCALED_IMU2:
+	case MAVLINK_MSG_ID_SCALED_IMU3:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE2:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE3:
+	case MAVLINK_MSG_ID_ACTUATOR_OUTPUT_STATUS:
+	case MAVLINK_MSG_ID_SERVO_OUTPUT_RAW:
+	case MAVLINK_MSG_ID_VIBRATION:
+	case MAVLINK_MSG_ID_ESTIMATOR_STATUS:
+	case MAVLINK_MSG_ID_WIND_COV:
+	case MAVLINK_MSG_ID_EFI_STATUS:
+	case MAVLINK_MSG_ID_RAW_RPM:
+		return MavlinkStream::Priority::Low;
+
+	default:
+		return MavlinkStream::Priority::Normal;
+	}
+}
+
+static MavlinkStream *create_stream_instance(const StreamListItem &stream, Mavlink *mavlink)
+{
+	MavlinkStream *instance = stream.new_instance(mavlink);
+
+	if (instance) {
+		instance->set_priority(get_stream_priority(stream.get_id()));
+	}
+
+	return instance;
+}
+
 const char *get_stream_name(const uint16_t msg_id)
 {
 	// search for stream with specified msg id in supported streams list
@@ -542,7 +597,7 @@ MavlinkStream *create_mavlink_stream(const char *stream_name, Mavlink *mavlink)
 	if (stream_name != nullptr) {
 		for (const auto &stream : streams_list) {
 			if (strcmp(stream_name, stream.get_name()) == 0) {
-				return stream.new_instance(mavlink);
+				return create_stream_instance(stream, mavlink);
 			}
 		}
 	}
@@ -555,7 +610,7 @@ MavlinkStream *create_mavlink_stream(const uint16_t msg_id, Mavlink *mavlink)
 	// search for stream with specified name in supported streams list
 	for (const auto &stream : streams_list) {
 		if (msg_id == stream.get_id()) {
-			return stream.new_instance(mavlink);
+			return create_stream_instance(stream, mavlink);
 		}
 	}
 
@@ -100,6 +100,11 @@ MavlinkMissionManager::MavlinkMissionManager(Mavlink &mavlink) :
 	_my_safepoint_dataman_id = _safepoint_dataman_id;
 }
 
+MavlinkMissionManager::~MavlinkMissionManager()
+{
+	delete[] _transfer_buffer;
+}
+
 void
 MavlinkMissionManager::init_offboard_mission(const mission_s &mission_state)
 {
@@ -479,6 +484,21 @@ MavlinkMissionManager::send_mission_request(uint8_t sysid, uint8_t compid, uint1
 	}
 }
 
+void
+MavlinkMissionManager::request_transfer_items()
+{
+	const uint16_t window_end = math::min<uint32_t>(_transfer_seq + _transfer_window, _transfer_count);
+
+	if (_transfer_requested < _transfer_seq) {
+		_transfer_requested = _transfer_seq;
+	}
+
+	while (_transfer_requested < window_end) {
+		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_requested);
+		_transfer_requested++;
+	}
+}
+
 void
 MavlinkMissionManager::send_mission_item_reached(uint16_t seq)
 {
@@ -561,8 +581,9 @@ MavlinkMissionManager::send()
 	if (_state == MAVLINK_WPM_STATE_GETLIST && (_time_last_sent > 0)
 	    && hrt_elapsed_time(&_time_last_sent) > MAVLINK_MISSION_RETRY_TIMEOUT_DEFAULT) {
 
-		// try to request item again after timeout
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		// try to request the outstanding items again after timeout
+		_transfer_requested = _transfer_seq;
+		request_transfer_items();
 
 	} else if (_state != MAVLINK_WPM_STATE_IDLE && (_time_last_recv > 0)
 		   && hrt_elapsed_time(&_time_last_recv) > MAVLINK_MISSION_PROTOCOL_TIMEOUT_DEFAULT) {
@@ -659,14 +680,9 @@ MavlinkMissionManager::handle_mission_ack(const mavlink_message_t *msg)
 				// INT or float mode is not supported
 				if (wpa.type == MAV_MISSION_UNSUPPORTED) {
 
-					if (_int_mode) {
-						_int_mode = false;
-						send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
-
-					} else {
-						_int_mode = true;
-						send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
-					}
+					_int_mode = !_int_mode;
+					_transfer_requested = _transfer_seq;
+					request_transfer_items();
 
 				} else if (wpa.type == MAV_MISSION_OPERATION_CANCELLED) {
 					PX4_DEBUG("WPM: MISSION_ACK CANCELLED, switch to state IDLE");
@@ -759,6 +775,7 @@ MavlinkMissionManager::handle_mission_request_list(const mavlink_message_t *msg)
 
 			_transfer_seq = 0;
 			_transfer_count = current_item_count();
+			_transfer_window = math::constrain(_mavlink.mission_window(), 1, 32);
 			_transfer_partner_sysid = msg->sysid;
 			_transfer_partner_compid = msg->compid;
 
@@ -829,7 +846,13 @@ MavlinkMissionManager::handle_mission_request_both(const mavlink_message_t *msg)
 
 					_transfer_seq++;
 
-				} else if (wpr.seq == _transfer_seq - 1) {
+				} else if (wpr.seq > _transfer_seq && wpr.seq < _transfer_seq + _transfer_window && wpr.seq < _transfer_count) {
+					// pipelined download: the partner requests ahead, earlier requests were lost or will be repeated
+					PX4_DEBUG("WPM: MISSION_ITEM_REQUEST(_INT) seq %u from ID %u (ahead of %u)", wpr.seq, msg->sysid, _transfer_seq);
+
+					_transfer_seq = wpr.seq + 1;
+
+				} else if (wpr.seq < _transfer_seq && wpr.seq + _transfer_window >= _transfer_seq) {
 					PX4_DEBUG("WPM: MISSION_ITEM_REQUEST(_INT) seq %u from ID %u (again)", wpr.seq, msg->sysid);
 
 				} else {
@@ -993,6 +1016,22 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_state = MAVLINK_WPM_STATE_GETLIST;
 			_transfer_seq = 0;
 			_transfer_count = wpc.count;
+			_transfer_window = math::constrain(_mavlink.mission_window(), 1, 32);
+			_transfer_restart_seq = UINT16_MAX;
+
+			delete[] _transfer_buffer;
+			_transfer_buffer = nullptr;
+			_transfer_buffer_count = 0;
+
+			if (_transfer_window > 1) {
+				_transfer_buffer = new mission_item_s[_transfer_window];
+
+				if (_transfer_buffer == nullptr) {
+					PX4_ERR("transfer buffer alloc failed");
+					_transfer_window = 1;
+				}
+			}
+
 			_transfer_current_seq = -1;
 			_transfer_land_start_marker = -1;
 			_transfer_land_marker = -1;
@@ -1032,7 +1071,8 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			return;
 		}
 
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		_transfer_requested = _transfer_seq;
+		request_transfer_items();
 	}
 }
 
@@ -1040,6 +1080,10 @@ void
 MavlinkMissionManager::switch_to_idle_state()
 {
 	_state = MAVLINK_WPM_STATE_IDLE;
+
+	delete[] _transfer_buffer;
+	_transfer_buffer = nullptr;
+	_transfer_buffer_count = 0;
 }
 
 
@@ -1089,6 +1133,13 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 				if (wp.seq != _transfer_seq) {
 					PX4_DEBUG("WPM: MISSION_ITEM ERROR: seq %u was not the expected %u", wp.seq, _transfer_seq);
 
+					if (wp.seq > _transfer_seq && _transfer_restart_seq != _transfer_seq) {
+						/* an item of the request window got lost, request again from the missing one (once) */
+						_transfer_restart_seq = _transfer_seq;
+						_transfer_requested = _transfer_seq;
+						request_transfer_items();
+					}
+
 					/* Item sequence not expected, ignore item */
 					return;
 				}
@@ -1099,6 +1150,10 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 					// but the GCS did not receive the last ack and sent the same item again
 					send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ACCEPTED, _transfer_current_crc32);
 
+				} else if (_transfer_window > 1 && wp.seq < _transfer_seq) {
+					// late duplicate of a re-requested item of a pipelined upload
+					PX4_DEBUG("WPM: MISSION_ITEM seq %u ignored (duplicate)", wp.seq);
+
 				} else {
 					PX4_DEBUG("WPM: MISSION_ITEM ERROR: no transfer");
 
@@ -1155,11 +1210,6 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 						check_failed = true;
 
 					} else {
-
-						write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-								reinterpret_cast<uint8_t *>(&mission_item),
-								sizeof(struct mission_item_s));
-
 						// Check for land start marker
 						if ((mission_item.nav_cmd == MAV_CMD_DO_LAND_START) && (_transfer_land_start_marker == -1)) {
 							_transfer_land_start_marker = wp.seq;
@@ -1174,51 +1224,22 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 								_transfer_land_start_marker = _transfer_land_marker;
 							}
 						}
-
-						if (!write_failed) {
-							/* waypoint marked as current */
-							if (wp.current) {
-								_transfer_current_seq = wp.seq;
-							}
-						}
 					}
 				}
 				break;
 
-			case MAV_MISSION_TYPE_FENCE: { // Write a geofence point
-					mission_fence_point_s mission_fence_point;
-					mission_fence_point.nav_cmd = mission_item.nav_cmd;
-					mission_fence_point.lat = mission_item.lat;
-					mission_fence_point.lon = mission_item.lon;
-					mission_fence_point.alt = mission_item.altitude;
-
-					if (mission_item.nav_cmd == MAV_CMD_NAV_FENCE_POLYGON_VERTEX_INCLUSION ||
-					    mission_item.nav_cmd == MAV_CMD_NAV_FENCE_POLYGON_VERTEX_EXCLUSION) {
-						mission_fence_point.vertex_count = mission_item.vertex_count;
-
-						if (mission_item.vertex_count < 3) { // feasibility check
-							PX4_ERR("Fence: too few vertices");
-							check_failed = true;
-						}
-
-					} else {
-						mission_fence_point.circle_radius = mission_item.circle_radius;
-					}
-
-					mission_fence_point.frame = mission_item.frame;
-
-					if (!check_failed) {
-						write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-								reinterpret_cast<uint8_t *>(&mission_fence_point), sizeof(mission_fence_point_s));
+			case MAV_MISSION_TYPE_FENCE:
+				if (mission_item.nav_cmd == MAV_CMD_NAV_FENCE_POLYGON_VERTEX_INCLUSION ||
+				    mission_item.nav_cmd == MAV_CMD_NAV_FENCE_POLYGON_VERTEX_EXCLUSION) {
+					if (mission_item.vertex_count < 3) { // feasibility check
+						PX4_ERR("Fence: too few vertices");
+						check_failed = true;
 					}
-
 				}
+
 				break;
 
-			case MAV_MISSION_TYPE_RALLY: { // Write a safe point / rally point
-					write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-							reinterpret_cast<uint8_t *>(&mission_item), sizeof(mission_item_s), 2_s);
-				}
+			case MAV_MISSION_TYPE_RALLY:
 				break;
 
 			default:
@@ -1228,6 +1249,10 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 				break;
 			}
 
+			if (!check_failed) {
+				write_failed = !store_transfer_item(wp.seq, mission_item);
+			}
+
 			if (write_failed || check_failed) {
 				PX4_DEBUG("WPM: MISSION_ITEM ERROR: error writing seq %u to dataman ID %i", wp.seq, _transfer_dataman_id);
 
@@ -1309,8 +1334,8 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 				_transfer_in_progress = false;
 
 			} else {
-				/* request next item */
-				send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+				/* request next item(s) */
+				request_transfer_items();
 			}
 
 		} else {
@@ -1324,6 +1349,80 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 }
 
 
+bool
+MavlinkMissionManager::store_transfer_item(uint16_t seq, mission_item_s &mission_item)
+{
+	if (_transfer_buffer == nullptr) {
+		return write_transfer_item(seq, mission_item);
+	}
+
+	if (_transfer_buffer_count == 0) {
+		_transfer_buffer_start = seq;
+	}
+
+	_transfer_buffer[_transfer_buffer_count++] = mission_item;
+
+	if (_transfer_buffer_count < _transfer_window && seq + 1 < _transfer_count) {
+		return true;
+	}
+
+	return flush_transfer_buffer();
+}
+
+bool
+MavlinkMissionManager::flush_transfer_buffer()
+{
+	for (uint16_t i = 0; i < _transfer_buffer_count; i++) {
+		if (!write_transfer_item(_transfer_buffer_start + i, _transfer_buffer[i])) {
+			PX4_DEBUG("WPM: MISSION_ITEM ERROR: error writing seq %u to dataman ID %i", _transfer_buffer_start + i,
+				  _transfer_dataman_id);
+			_transfer_buffer_count = 0;
+			return false;
+		}
+	}
+
+	_transfer_buffer_count = 0;
+	return true;
+}
+
+bool
+MavlinkMissionManager::write_transfer_item(uint16_t seq, mission_item_s &mission_item)
+{
+	switch (_mission_type) {
+	case MAV_MISSION_TYPE_MISSION:
+		return _dataman_client.writeSync(_transfer_dataman_id, seq,
+						 reinterpret_cast<uint8_t *>(&mission_item), sizeof(struct mission_item_s));
+
+	case MAV_MISSION_TYPE_FENCE: { // Write a geofence point
+			mission_fence_point_s mission_fence_point;
+			mission_fence_point.nav_cmd = mission_item.nav_cmd;
+			mission_fence_point.lat = mission_item.lat;
+			mission_fence_point.lon = mission_item.lon;
+			mission_fence_point.alt = mission_item.altitude;
+
+			if (mission_item.nav_cmd == MAV_CMD_NAV_FENCE_POLYGON_VERTEX_INCLUSION ||
+			    mission_item.nav_cmd == MAV_CMD_NAV_FENCE_POLYGON_VERTEX_EXCLUSION) {
+				mission_fence_point.vertex_count = mission_item.vertex_count;
+
+			} else {
+				mission_fence_point.circle_radius = mission_item.circle_radius;
+			}
+
+			mission_fence_point.frame = mission_item.frame;
+
+			return _dataman_client.writeSync(_transfer_dataman_id, seq,
+							 reinterpret_cast<uint8_t *>(&mission_fence_point), sizeof(mission_fence_point_s));
+		}
+
+	case MAV_MISSION_TYPE_RALLY: // Write a safe point / rally point
+		return _dataman_client.writeSync(_transfer_dataman_id, seq,
+						 reinterpret_cast<uint8_t *>(&mission_item), sizeof(mission_item_s), 2_s);
+
+	default:
+		return true;
+	}
+}
+
 void
 MavlinkMissionManager::handle_mission_clear_all(const mavlink_message_t *msg)
 {
@@ -87,7 +87,7 @@ class MavlinkMissionManager
 public:
 	explicit MavlinkMissionManager(Mavlink &mavlink);
 
-	~MavlinkMissionManager() = default;
+	~MavlinkMissionManager();
 
 	/**
 	 * Handle sending of messages. Call this regularly at a fixed frequency.
@@ -138,6 +138,13 @@ private:
 	uint16_t		_transfer_count{0};			///< Items count in current transmission
 	uint32_t		_transfer_current_crc32{0};		///< Current CRC32 checksum of current transmission
 	uint16_t		_transfer_seq{0};			///< Item sequence in current transmission
+	uint16_t		_transfer_requested{0};			///< Next item sequence to request in current transmission
+	uint16_t		_transfer_window{1};			///< Maximum number of outstanding item requests in current transmission
+	uint16_t		_transfer_restart_seq{UINT16_MAX};	///< Item sequence the request window was last restarted from
+
+	mission_item_s		*_transfer_buffer{nullptr};		///< Received items not yet written to dataman (_transfer_window items)
+	uint16_t		_transfer_buffer_start{0};		///< Item sequence of the first buffered item
+	uint16_t		_transfer_buffer_count{0};		///< Number of buffered items
 
 	int32_t			_transfer_current_seq{-1};		///< Current item ID for current transmission (-1 means not initialized)
 
@@ -223,6 +230,24 @@ private:
 
 	void send_mission_request(uint8_t sysid, uint8_t compid, uint16_t seq);
 
+	/**
+	 * Request items of the current upload until _transfer_window requests are outstanding
+	 */
+	void request_transfer_items();
+
+	/**
+	 * Store a received item of the current upload, either directly to dataman or to the
+	 * transfer buffer, which is written once full or when the last item was received.
+	 * @return false if writing to dataman failed
+	 */
+	bool store_transfer_item(uint16_t seq, mission_item_s &mission_item);
+
+	/** write all items of the transfer buffer to dataman */
+	bool flush_transfer_buffer();
+
+	/** write a single item of the current upload to dataman */
+	bool write_transfer_item(uint16_t seq, mission_item_s &mission_item);
+
 	/**
 	 *  @brief emits a message that a waypoint reached
 	 *
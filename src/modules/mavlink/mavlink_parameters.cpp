@@ -42,6 +42,11 @@
  */
 
 #include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <crc32.h>
+#include <mathlib/mathlib.h>
 
 #include "mavlink_parameters.h"
 #include "mavlink_main.h"
@@ -204,6 +209,32 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 						memcpy(&param_value.param_value, &hash, sizeof(hash));
 						mavlink_msg_param_value_send_struct(_mavlink.get_channel(), &param_value);
 
+					} else if (strncmp(req_read.param_id, HASH_CHUNK_PARAM, strlen(HASH_CHUNK_PARAM)) == 0) {
+						char name[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1];
+						strncpy(name, req_read.param_id, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+						name[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN] = '\0';
+
+						if (!handle_chunk_request(name + strlen(HASH_CHUNK_PARAM))) {
+							send_error(MAV_PARAM_ERROR_DOES_NOT_EXIST, name, -1, msg->sysid, msg->compid);
+						}
+
+					} else if (strncmp(req_read.param_id, SNAPSHOT_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN) == 0) {
+						const uint32_t hash = param_hash_check();
+
+						if (write_snapshot(hash)) {
+							/* the ground station can download the snapshot via FTP now */
+							mavlink_param_value_t param_value;
+							param_value.param_count = param_count_used();
+							param_value.param_index = -1;
+							strncpy(param_value.param_id, SNAPSHOT_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+							param_value.param_type = MAV_PARAM_TYPE_UINT32;
+							memcpy(&param_value.param_value, &hash, sizeof(hash));
+							mavlink_msg_param_value_send_struct(_mavlink.get_channel(), &param_value);
+
+						} else {
+							send_error(MAV_PARAM_ERROR_READ_FAIL, SNAPSHOT_PARAM, -1, msg->sysid, msg->compid);
+						}
+
 					} else {
 						/* local name buffer to enforce null-terminated string */
 						char name[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1];
@@ -375,6 +406,9 @@ MavlinkParametersManager::send_params()
 	if (send_one()) {
 		return true;
 
+	} else if (send_chunks()) {
+		return true;
+
 	} else if (send_untransmitted()) {
 		return true;
 	}
@@ -382,6 +416,184 @@ MavlinkParametersManager::send_params()
 	return false;
 }
 
+int
+MavlinkParametersManager::chunk_size()
+{
+	const int count = param_count_used();
+	return math::max(MIN_CHUNK_SIZE, (count + MAX_NUM_CHUNKS - 1) / MAX_NUM_CHUNKS);
+}
+
+int
+MavlinkParametersManager::num_chunks()
+{
+	const int size = chunk_size();
+	return (param_count_used() + size - 1) / size;
+}
+
+uint32_t
+MavlinkParametersManager::chunk_hash(int chunk)
+{
+	// same as param_hash_check(), but only over the chunk
+	uint32_t hash = 0;
+	const int size = chunk_size();
+	const int end = math::min((chunk + 1) * size, (int)param_count_used());
+
+	for (int i = chunk * size; i < end; ++i) {
+		const param_t param = param_for_used_index(i);
+
+		if (param == PARAM_INVALID || param_is_volatile(param)) {
+			continue;
+		}
+
+		const char *name = param_name(param);
+		int32_t value = 0;
+		param_get(param, &value);
+		hash = crc32part((const uint8_t *)name, strlen(name), hash);
+		hash = crc32part((const uint8_t *)&value, param_size(param), hash);
+	}
+
+	return hash;
+}
+
+bool
+MavlinkParametersManager::handle_chunk_request(const char *suffix)
+{
+	if (suffix[0] == '\0') {
+		// send all chunk hashes
+		_send_chunk_hash_index = 0;
+		return true;
+	}
+
+	char *end = nullptr;
+	const long chunk = strtol(suffix, &end, 10);
+
+	if (end == suffix || *end != '\0' || chunk < 0 || chunk >= num_chunks()) {
+		return false;
+	}
+
+	_requested_chunks |= (uint64_t)1 << chunk;
+	return true;
+}
+
+bool
+MavlinkParametersManager::send_chunks()
+{
+	if (_send_chunk_hash_index >= 0) {
+		if (_send_chunk_hash_index < num_chunks()) {
+			const uint32_t hash = chunk_hash(_send_chunk_hash_index);
+
+			mavlink_param_value_t msg;
+			msg.param_count = num_chunks();
+			msg.param_index = _send_chunk_hash_index;
+			strncpy(msg.param_id, HASH_CHUNK_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+			msg.param_type = MAV_PARAM_TYPE_UINT32;
+			memcpy(&msg.param_value, &hash, sizeof(hash));
+			mavlink_msg_param_value_send_struct(_mavlink.get_channel(), &msg);
+
+			++_send_chunk_hash_index;
+			return true;
+		}
+
+		_send_chunk_hash_index = -1;
+	}
+
+	if (_chunk_param_index < 0 && _requested_chunks != 0) {
+		// start with the next requested chunk
+		int chunk = 0;
+
+		while (!(_requested_chunks & ((uint64_t)1 << chunk))) {
+			++chunk;
+		}
+
+		_requested_chunks &= ~((uint64_t)1 << chunk);
+		_chunk_param_index = chunk * chunk_size();
+		_chunk_param_end = math::min(_chunk_param_index + chunk_size(), (int)param_count_used());
+	}
+
+	if (_chunk_param_index >= 0) {
+		if (_chunk_param_index < _chunk_param_end) {
+			const param_t param = param_for_used_index(_chunk_param_index);
+
+			if (param != PARAM_INVALID && send_param(param) == 1) {
+				return false; // no TX buffer space, retry later
+			}
+
+			++_chunk_param_index;
+
+			if (_chunk_param_index < _chunk_param_end) {
+				return true;
+			}
+		}
+
+		_chunk_param_index = -1;
+		return true;
+	}
+
+	return false;
+}
+
+bool
+MavlinkParametersManager::write_snapshot(uint32_t hash)
+{
+	if (_snapshot_valid && _snapshot_hash == hash && access(PARAM_SNAPSHOT_FILE, F_OK) == 0) {
+		return true;
+	}
+
+	_snapshot_valid = false;
+
+	int fd = ::open(PARAM_SNAPSHOT_FILE, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("failed to open %s (%i)", PARAM_SNAPSHOT_FILE, errno);
+		return false;
+	}
+
+	static constexpr int ENTRY_SIZE = MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1 + 4;
+	uint8_t buffer[16 * ENTRY_SIZE];
+	const uint32_t count = param_count_used();
+
+	memcpy(buffer, "PXPS", 4);
+	buffer[4] = 1; // version
+	memset(buffer + 5, 0, 3);
+	memcpy(buffer + 8, &hash, sizeof(hash));
+	memcpy(buffer + 12, &count, sizeof(count));
+	bool success = ::write(fd, buffer, 16) == 16;
+
+	int fill = 0;
+
+	for (uint32_t i = 0; i < count && success; ++i) {
+		const param_t param = param_for_used_index(i);
+		uint8_t *entry = buffer + fill;
+		memset(entry, 0, ENTRY_SIZE);
+
+		if (param != PARAM_INVALID) {
+			strncpy((char *)entry, param_name(param), MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+			entry[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN] = (param_type(param) == PARAM_TYPE_INT32) ?
+					MAV_PARAM_TYPE_INT32 : MAV_PARAM_TYPE_REAL32;
+			param_get(param, entry + MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1);
+		}
+
+		fill += ENTRY_SIZE;
+
+		if (fill == sizeof(buffer) || i == count - 1) {
+			success = ::write(fd, buffer, fill) == fill;
+			fill = 0;
+		}
+	}
+
+	::close(fd);
+
+	if (!success) {
+		PX4_ERR("failed to write %s", PARAM_SNAPSHOT_FILE);
+		unlink(PARAM_SNAPSHOT_FILE);
+		return false;
+	}
+
+	_snapshot_hash = hash;
+	_snapshot_valid = true;
+	return true;
+}
+
 bool
 MavlinkParametersManager::send_untransmitted()
 {
@@ -43,6 +43,7 @@
 #pragma once
 
 #include <parameters/param.h>
+#include <px4_platform_common/defines.h>
 
 #include "mavlink_bridge_header.h"
 #include <uORB/Publication.hpp>
@@ -110,6 +111,45 @@ protected:
 	 */
 	bool send_untransmitted();
 
+	/**
+	 * Parameter chunks: the used parameters are grouped by their used index into chunks, each with its own hash.
+	 * A ground station that has a cached copy requests the chunk hashes (PARAM_REQUEST_READ of "_HASH_CHUNK"),
+	 * and then only the parameters of the chunks that differ (PARAM_REQUEST_READ of "_HASH_CHUNK<index>").
+	 * The chunk hashes are sent as PARAM_VALUE "_HASH_CHUNK" with param_index = chunk index and
+	 * param_count = number of chunks.
+	 */
+	static constexpr int MAX_NUM_CHUNKS = 64;
+	static constexpr int MIN_CHUNK_SIZE = 32;
+
+	static int chunk_size();
+	static int num_chunks();
+	static uint32_t chunk_hash(int chunk);
+
+	/**
+	 * Handle a PARAM_REQUEST_READ of a "_HASH_CHUNK" parameter
+	 * @param suffix name after "_HASH_CHUNK" (null-terminated)
+	 * @return true if it is a valid request
+	 */
+	bool handle_chunk_request(const char *suffix);
+
+	/**
+	 * Send a chunk hash or a parameter of a requested chunk
+	 * @return true if a message was sent
+	 */
+	bool send_chunks();
+
+	/**
+	 * Write a binary snapshot of all used parameters to PARAM_SNAPSHOT_FILE, so it can be downloaded with MAVLink FTP.
+	 * It is only rewritten if the parameter hash changed. Format (little endian):
+	 * - header: "PXPS", uint8 version (1), 3 bytes reserved, uint32 hash (as _HASH_CHECK), uint32 number of entries
+	 * - entries ordered by used index: char[16] name (not null-terminated if 16 characters), uint8 MAV_PARAM_TYPE,
+	 *   4 bytes value
+	 * @return true on success
+	 */
+	bool write_snapshot(uint32_t hash);
+
+	static constexpr const char *PARAM_SNAPSHOT_FILE = PX4_STORAGEDIR "/param_snapshot.bin";
+
 	int send_param(param_t param, int component_id = -1);
 
 	/**
@@ -182,6 +222,14 @@ protected:
 
 	hrt_abstime _last_param_sent{0};
 
+	int _send_chunk_hash_index{-1}; ///< next chunk hash to send, -1 if none
+	uint64_t _requested_chunks{0}; ///< bitmask of the chunks to send
+	int _chunk_param_index{-1}; ///< used index of the next parameter of the current chunk, -1 if none
+	int _chunk_param_end{0};
+
+	uint32_t _snapshot_hash{0};
+	bool _snapshot_valid{false};
+
 	bool _first_send{false};
 	hrt_abstime _last_param_sent_timestamp{0}; // time at which the last parameter was sent
 };
@@ -154,3 +154,33 @@ PARAM_DEFINE_INT32(MAV_HB_FORW_EN, 1);
  * @max 250
  */
 PARAM_DEFINE_INT32(MAV_RADIO_TOUT, 5);
+
+/**
+ * ULog streaming acknowledgement window
+ *
+ * Maximum number of acked ULog streaming messages (the definitions and
+ * parameters at the start of a log) that can be in flight before the logger
+ * waits for an acknowledgement. Lost messages are retransmitted individually.
+ * A value larger than 1 requires the receiver to reorder acked messages by
+ * their sequence number, so only increase it if the ground station supports it.
+ *
+ * @group MAVLink
+ * @min 1
+ * @max 16
+ */
+PARAM_DEFINE_INT32(MAV_ULOG_WIN, 1);
+
+/**
+ * Mission transfer window
+ *
+ * Maximum number of mission items requested at once during a mission upload
+ * from the ground station. With a value larger than 1 the received items are
+ * buffered and written to storage in batches of this size, and during a mission
+ * download requests for items up to this far ahead of the expected one are accepted.
+ * Only increase it if the ground station handles multiple outstanding requests.
+ *
+ * @group MAVLink
+ * @min 1
+ * @max 32
+ */
+PARAM_DEFINE_INT32(MAV_MIS_WIN, 1);
@@ -66,8 +66,10 @@
 
 #ifdef CONFIG_NET
 #define MAVLINK_RECEIVER_NET_ADDED_STACK 1360
+#define MAVLINK_RECEIVER_SERIAL_ADDED_STACK 0
 #else
 #define MAVLINK_RECEIVER_NET_ADDED_STACK 0
+#define MAVLINK_RECEIVER_SERIAL_ADDED_STACK (MAVLINK_MAX_PACKET_LEN - 64) // serial read buffer fits a full packet
 #endif
 
 MavlinkReceiver::~MavlinkReceiver()
@@ -3119,6 +3121,137 @@ void MavlinkReceiver::handle_message_open_drone_id_system(
 
 	_open_drone_id_system_pub.publish(odid_system);
 }
+size_t
+MavlinkReceiver::parse_frame(const uint8_t *buf, size_t len, mavlink_message_t &msg)
+{
+	mavlink_status_t *status = _mavlink.get_status();
+
+	if (status->parse_state > MAVLINK_PARSE_STATE_IDLE || status->signing != nullptr) {
+		return 0;
+	}
+
+	const bool mavlink1 = (buf[0] == MAVLINK_STX_MAVLINK1);
+
+	if (!mavlink1 && buf[0] != MAVLINK_STX) {
+		return 0;
+	}
+
+	const size_t header_len = mavlink1 ? MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 : MAVLINK_NUM_HEADER_BYTES;
+
+	if (len < header_len || len < header_len + buf[1] + MAVLINK_NUM_CHECKSUM_BYTES) {
+		return 0;
+	}
+
+	if (mavlink1) {
+		msg.incompat_flags = 0;
+		msg.compat_flags = 0;
+		msg.seq = buf[2];
+		msg.sysid = buf[3];
+		msg.compid = buf[4];
+		msg.msgid = buf[5];
+
+	} else {
+		if (buf[2] != 0) {
+			// signed packet or unsupported incompatibility flags
+			return 0;
+		}
+
+		msg.incompat_flags = buf[2];
+		msg.compat_flags = buf[3];
+		msg.seq = buf[4];
+		msg.sysid = buf[5];
+		msg.compid = buf[6];
+		msg.msgid = buf[7] | (buf[8] << 8) | (buf[9] << 16);
+	}
+
+	const mavlink_msg_entry_t *entry = mavlink_get_msg_entry(msg.msgid);
+
+	if (entry == nullptr) {
+		return 0;
+	}
+
+	// CRC over the whole span after the start byte, plus the message specific CRC extra
+	const uint8_t payload_len = buf[1];
+	uint16_t crc;
+	crc_init(&crc);
+	crc_accumulate_buffer(&crc, reinterpret_cast<const char *>(&buf[1]), header_len - 1 + payload_len);
+	crc_accumulate(entry->crc_extra, &crc);
+
+	const uint8_t *ck = &buf[header_len + payload_len];
+
+	if (ck[0] != (crc & 0xFF) || ck[1] != (crc >> 8)) {
+		return 0;
+	}
+
+	msg.magic = buf[0];
+	msg.len = payload_len;
+	msg.checksum = crc;
+	msg.ck[0] = ck[0];
+	msg.ck[1] = ck[1];
+
+	uint8_t *payload = _MAV_PAYLOAD_NON_CONST(&msg);
+	memcpy(payload, &buf[header_len], payload_len);
+
+	// zero-fill truncated payloads, as the byte-wise parser does
+	if (payload_len < entry->max_msg_len) {
+		memset(&payload[payload_len], 0, entry->max_msg_len - payload_len);
+	}
+
+	// keep the channel status consistent with mavlink_parse_char()
+	if (mavlink1) {
+		status->flags |= MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+
+	} else {
+		status->flags &= ~MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+	}
+
+	status->current_rx_seq = msg.seq;
+
+	if (status->packet_rx_success_count == 0) {
+		status->packet_rx_drop_count = 0;
+	}
+
+	status->packet_rx_success_count++;
+
+	_status.parse_state = status->parse_state;
+	_status.packet_idx = status->packet_idx;
+	_status.current_rx_seq = status->current_rx_seq + 1;
+	_status.packet_rx_success_count = status->packet_rx_success_count;
+	_status.packet_rx_drop_count = status->parse_error;
+	_status.flags = status->flags;
+	status->parse_error = 0;
+
+	return header_len + payload_len + MAVLINK_NUM_CHECKSUM_BYTES;
+}
+
+void
+MavlinkReceiver::handle_received_message(mavlink_message_t &msg)
+{
+	// If we receive a complete MAVLink 2 packet, also switch the outgoing protocol version
+	if (!(_mavlink.get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)
+	    && _mavlink.getProtocolVersion() != 2) {
+		PX4_INFO("Upgrade to MAVLink v2 because of incoming packet");
+		_mavlink.setProtocolVersion(2);
+	}
+
+	switch (_mavlink.get_mode()) {
+	case Mavlink::MAVLINK_MODE::MAVLINK_MODE_GIMBAL:
+		handle_messages_in_gimbal_mode(msg);
+		break;
+
+	default:
+		handle_message(&msg);
+		break;
+	}
+
+	_mavlink.set_has_received_messages(true); // Received first message, unlock wait to transmit '-w' command-line flag
+	update_rx_stats(msg);
+
+	if (_message_statistics_enabled) {
+		update_message_statistics(msg);
+	}
+}
+
 void
 MavlinkReceiver::run()
 {
@@ -3139,8 +3272,8 @@ MavlinkReceiver::run()
 	/* 1500 is the Wifi MTU, so we make sure to fit a full packet */
 	uint8_t buf[1000];
 #else
-	/* the serial port buffers internally as well, we just need to fit a small chunk */
-	uint8_t buf[64];
+	/* the serial port buffers internally as well, but fit a full packet so it can be framed in one go */
+	uint8_t buf[MAVLINK_MAX_PACKET_LEN];
 #endif
 	mavlink_message_t msg;
 
@@ -3224,38 +3357,30 @@ MavlinkReceiver::run()
 			if (_mavlink.get_protocol() != Protocol::UDP || _mavlink.get_client_source_initialized()) {
 #endif // MAVLINK_UDP
 
-				/* if read failed, this loop won't execute */
-				for (ssize_t i = 0; i < nread; i++) {
-					if (mavlink_parse_char(_mavlink.get_channel(), buf[i], &msg, &_status)) {
-
-						// If we receive a complete MAVLink 2 packet, also switch the outgoing protocol version
-						if (!(_mavlink.get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)
-						    && _mavlink.getProtocolVersion() != 2) {
-							PX4_INFO("Upgrade to MAVLink v2 because of incoming packet");
-							_mavlink.setProtocolVersion(2);
-						}
-
-						switch (_mavlink.get_mode()) {
-						case Mavlink::MAVLINK_MODE::MAVLINK_MODE_GIMBAL:
-							handle_messages_in_gimbal_mode(msg);
-							break;
+				const hrt_abstime parse_start = hrt_absolute_time();
 
-						default:
-							handle_message(&msg);
-							break;
-						}
-
-						_mavlink.set_has_received_messages(true); // Received first message, unlock wait to transmit '-w' command-line flag
-						update_rx_stats(msg);
+				/* if read failed, this loop won't execute */
+				for (ssize_t i = 0; i < nread;) {
+					// complete frames are taken from the buffer in one go, partial or invalid ones
+					// continue byte by byte
+					const size_t frame_len = parse_frame(&buf[i], nread - i, msg);
+
+					if (frame_len > 0) {
+						handle_received_message(msg);
+						i += frame_len;
+						continue;
+					}
 
-						if (_message_statistics_enabled) {
-							update_message_statistics(msg);
-						}
+					if (mavlink_parse_char(_mavlink.get_channel(), buf[i], &msg, &_status)) {
+						handle_received_message(msg);
 					}
+
+					i++;
 				}
 
 				/* count received bytes (nread will be -1 on read error) */
 				if (nread > 0) {
+					_rx_cpu_time.fetch_add(hrt_elapsed_time(&parse_start));
 					_mavlink.count_rxbytes(nread);
 
 					telemetry_status_s &tstatus = _mavlink.telemetry_status();
@@ -3369,6 +3494,8 @@ void MavlinkReceiver::update_rx_stats(const mavlink_message_t &message)
 
 				_component_states_count = i + 1;
 
+				Mavlink::add_route(message.sysid, message.compid, _mavlink);
+
 				// Also update overall stats
 				++_total_received_counter;
 
@@ -3507,7 +3634,8 @@ void MavlinkReceiver::start()
 	(void)pthread_attr_setschedparam(&receiveloop_attr, &param);
 
 	pthread_attr_setstacksize(&receiveloop_attr,
-				  PX4_STACK_ADJUSTED(sizeof(MavlinkReceiver) + 2840 + MAVLINK_RECEIVER_NET_ADDED_STACK));
+				  PX4_STACK_ADJUSTED(sizeof(MavlinkReceiver) + 2840 + MAVLINK_RECEIVER_NET_ADDED_STACK +
+						  MAVLINK_RECEIVER_SERIAL_ADDED_STACK));
 
 	pthread_create(&_thread, &receiveloop_attr, MavlinkReceiver::start_trampoline, (void *)this);
 
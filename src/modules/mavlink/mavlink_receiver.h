@@ -133,6 +133,15 @@ public:
 	void stop();
 
 	bool component_was_seen(int system_id, int component_id);
+
+	/**
+	 * Round trip time to the timesync partner (usec) and the number of samples
+	 */
+	uint32_t round_trip_time() const { return _mavlink_timesync.round_trip_time(); }
+	uint32_t round_trip_time_samples() const { return _mavlink_timesync.round_trip_time_samples(); }
+
+	/** total time spent parsing and handling received data [us] */
+	uint32_t rx_cpu_time() const { return _rx_cpu_time.load(); }
 	void enable_message_statistics() { _message_statistics_enabled = true; }
 	void print_detailed_rx_stats() const;
 
@@ -155,6 +164,18 @@ private:
 					       float param4 = 0.0f, float param5 = 0.0f, float param6 = 0.0f, float param7 = 0.0f);
 
 	void handle_message(mavlink_message_t *msg);
+
+	/**
+	 * Handle a message received by run(), either from parse_frame() or mavlink_parse_char()
+	 */
+	void handle_received_message(mavlink_message_t &msg);
+
+	/**
+	 * Frame a complete, unsigned packet at the start of buf without going through the byte-wise parser.
+	 * Only used while the byte-wise parser is idle, its channel status is updated accordingly.
+	 * @return length of the packet, or 0 if buf does not start with a complete valid packet
+	 */
+	size_t parse_frame(const uint8_t *buf, size_t len, mavlink_message_t &msg);
 	void handle_messages_in_gimbal_mode(mavlink_message_t &msg);
 
 	void handle_message_adsb_vehicle(mavlink_message_t *msg);
@@ -243,6 +264,7 @@ private:
 	void publish_hil_battery();
 
 	px4::atomic_bool 	_should_exit{false};
+	px4::atomic<uint32_t>	_rx_cpu_time{0};
 	pthread_t		_thread {};
 	/**
 	 * @brief Updates optical flow parameters.
@@ -310,7 +332,7 @@ private:
 	uORB::Publication<log_message_s>			_log_message_pub{ORB_ID(log_message)};
 	uORB::Publication<mavlink_tunnel_s>			_mavlink_tunnel_pub{ORB_ID(mavlink_tunnel)};
 	uORB::Publication<mavlink_tunnel_s>			_esc_serial_passthru_pub{ORB_ID(esc_serial_passthru)};
-	uORB::Publication<obstacle_distance_s>			_obstacle_distance_pub{ORB_ID(obstacle_distance)};
+	uORB::PublicationMulti<obstacle_distance_s>		_obstacle_distance_pub{ORB_ID(obstacle_distance)};
 	uORB::Publication<offboard_control_mode_s>		_offboard_control_mode_pub{ORB_ID(offboard_control_mode)};
 	uORB::Publication<onboard_computer_status_s>		_onboard_computer_status_pub{ORB_ID(onboard_computer_status)};
 	uORB::Publication<velocity_limits_s>			_velocity_limits_pub{ORB_ID(velocity_limits)};
@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_routing.cpp
+ */
+
+#include "mavlink_routing.h"
+
+void MavlinkRoutingTable::add(uint8_t system_id, uint8_t component_id, int link)
+{
+	for (int i = 0; i < _num_routes; ++i) {
+		if (_routes[i].system_id == system_id && _routes[i].component_id == component_id) {
+			_routes[i].links |= 1u << link;
+			return;
+		}
+	}
+
+	if (_num_routes < MAX_ROUTES) {
+		_routes[_num_routes++] = Route{system_id, component_id, 1u << link};
+
+	} else {
+		_overflow = true;
+	}
+}
+
+void MavlinkRoutingTable::remove_link(int link)
+{
+	int n = 0;
+
+	for (int i = 0; i < _num_routes; ++i) {
+		_routes[i].links &= ~(1u << link);
+
+		if (_routes[i].links != 0) {
+			_routes[n++] = _routes[i];
+		}
+	}
+
+	_num_routes = n;
+}
+
+bool MavlinkRoutingTable::links(int target_system_id, int target_component_id, uint32_t &links) const
+{
+	if (_overflow) {
+		return false;
+	}
+
+	links = 0;
+
+	for (int i = 0; i < _num_routes; ++i) {
+		if (target_system_id == 0
+		    || (_routes[i].system_id == target_system_id
+			&& (target_component_id == 0 || _routes[i].component_id == target_component_id))) {
+			links |= _routes[i].links;
+		}
+	}
+
+	return true;
+}
+
+bool MavlinkRoutingTable::is_duplicate(const mavlink_message_t &msg, const hrt_abstime &now)
+{
+	const uint32_t hash = (msg.checksum ^ (msg.seq << 8) ^ (msg.sysid << 16) ^ (msg.compid << 24) ^ msg.msgid) * 2654435761u;
+	RecentPacket &recent = _recent[(hash >> 27) & (RECENT_PACKETS - 1)];
+
+	if (recent.time != 0 && now < recent.time + DUPLICATE_TIMEOUT
+	    && recent.msgid == msg.msgid && recent.checksum == msg.checksum && recent.seq == msg.seq
+	    && recent.system_id == msg.sysid && recent.component_id == msg.compid) {
+		return true;
+	}
+
+	recent = RecentPacket{now, msg.msgid, msg.checksum, msg.sysid, msg.compid, msg.seq};
+	return false;
+}
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mavlink_routing.h
+ * Routing table and duplicate filter for forwarding messages between mavlink instances.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <drivers/drv_hrt.h>
+#include "mavlink_bridge_header.h"
+
+/**
+ * @class MavlinkRoutingTable
+ * Remembers on which links (mavlink instances) each system/component was seen, so a forwarded
+ * message only needs to be passed to the links that lead to its target. Recently forwarded
+ * packets are kept in a small hashed cache to drop copies arriving over redundant links.
+ *
+ * Not thread-safe, the caller needs to hold mavlink_module_mutex.
+ */
+class MavlinkRoutingTable
+{
+public:
+	MavlinkRoutingTable() = default;
+	~MavlinkRoutingTable() = default;
+
+	/**
+	 * Record that a component was seen on a link
+	 */
+	void add(uint8_t system_id, uint8_t component_id, int link);
+
+	/**
+	 * Forget all routes over a link
+	 */
+	void remove_link(int link);
+
+	/**
+	 * Get the links on which the target was seen, with the same semantics as
+	 * MavlinkReceiver::component_was_seen() (0 for system or component matches any).
+	 * @param links bitmask of the links
+	 * @return false if the table is incomplete (overflowed), so the result cannot be used
+	 */
+	bool links(int target_system_id, int target_component_id, uint32_t &links) const;
+
+	/**
+	 * Check if the same packet (sender, sequence, message ID and checksum) was checked
+	 * recently, and remember it otherwise.
+	 * @return true for a duplicate
+	 */
+	bool is_duplicate(const mavlink_message_t &msg, const hrt_abstime &now);
+
+private:
+	struct Route {
+		uint8_t system_id;
+		uint8_t component_id;
+		uint32_t links;
+	};
+
+	struct RecentPacket {
+		hrt_abstime time;
+		uint32_t msgid;
+		uint16_t checksum;
+		uint8_t system_id;
+		uint8_t component_id;
+		uint8_t seq;
+	};
+
+	static constexpr int MAX_ROUTES = 32;
+	static constexpr int RECENT_PACKETS = 32; ///< power of 2
+	static constexpr hrt_abstime DUPLICATE_TIMEOUT = 500_ms;
+
+	static_assert(MAVLINK_COMM_NUM_BUFFERS <= 32, "links mask too small");
+
+	Route _routes[MAX_ROUTES] {};
+	int _num_routes{0};
+	bool _overflow{false};
+
+	RecentPacket _recent[RECENT_PACKETS] {};
+};
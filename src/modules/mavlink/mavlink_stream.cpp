@@ -64,7 +64,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// this will give different messages on the same run a different
 		// initial timestamp which will help spacing them out
 		// on the link scheduling
-		if (send()) {
+		if (send_measured()) {
 			_last_sent = hrt_absolute_time();
 
 			if (!_first_message_sent) {
@@ -85,7 +85,7 @@ MavlinkStream::update(const hrt_abstime &t)
 	int interval = _interval;
 
 	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
+		interval /= _mavlink->get_rate_mult(_priority);
 	}
 
 	// We don't need to send anything if the inverval is 0. send() will be called manually.
@@ -112,7 +112,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// do not use the actual time but increment at a fixed rate, so that processing delays do not
 		// distort the average rate. The check of the maximum interval is done to ensure that after a
 		// long time not sending anything, sending multiple messages in a short time is avoided.
-		if (send()) {
+		if (send_measured()) {
 			_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
 
 			if (!_first_message_sent) {
@@ -128,3 +128,57 @@ MavlinkStream::update(const hrt_abstime &t)
 
 	return -1;
 }
+
+bool
+MavlinkStream::send_measured()
+{
+	const hrt_abstime start = hrt_absolute_time();
+	const uint32_t tx_bytes = _mavlink->get_tx_bytes_total();
+	const uint32_t tx_buffer_overruns = _mavlink->telemetry_status().tx_buffer_overruns;
+
+	const bool sent = send();
+
+	_stats.cpu_time += hrt_elapsed_time(&start);
+	_stats.tx_bytes += _mavlink->get_tx_bytes_total() - tx_bytes;
+	_stats.tx_skipped += _mavlink->telemetry_status().tx_buffer_overruns - tx_buffer_overruns;
+
+	if (sent) {
+		_stats.sent++;
+	}
+
+	return sent;
+}
+
+hrt_abstime
+MavlinkStream::next_due()
+{
+	if (_last_sent == 0 || has_update_data()) {
+		return 0;
+	}
+
+	int interval = _interval;
+
+	if (!const_rate()) {
+		interval /= _mavlink->get_rate_mult(_priority);
+	}
+
+	if (interval == 0) {
+		// only sent manually
+		return UINT64_MAX;
+	}
+
+	if (interval < 0) {
+		return 0;
+	}
+
+	// same condition as in update()
+	const int64_t due = (int64_t)_last_sent + interval - (_mavlink->get_main_loop_delay() / 10) * 3 + 1;
+	return due > 0 ? due : 0;
+}
+
+void
+MavlinkStream::reset_last_sent()
+{
+	_last_sent = 0;
+	_mavlink->reschedule_streams();
+}
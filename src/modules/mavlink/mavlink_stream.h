@@ -52,6 +52,17 @@ class MavlinkStream : public ListNode<MavlinkStream *>
 
 public:
 
+	/**
+	 * Order in which the stream rates are reduced when the link is congested
+	 */
+	enum class Priority : uint8_t {
+		High = 0,	///< reduced last (attitude, position, system status)
+		Normal,
+		Low,		///< reduced first (debug values, detailed sensor and actuator data)
+	};
+
+	static constexpr int NUM_PRIORITIES = 3;
+
 	MavlinkStream(Mavlink *mavlink);
 	virtual ~MavlinkStream() = default;
 
@@ -75,10 +86,20 @@ public:
 	 */
 	int get_interval() { return _interval; }
 
+	void set_priority(Priority priority) { _priority = priority; }
+	Priority get_priority() const { return _priority; }
+
 	/**
 	 * @return 0 if updated / sent, -1 if unchanged
 	 */
 	int update(const hrt_abstime &t);
+
+	/**
+	 * Get the time from which on update() can send the next message
+	 *
+	 * @return the time in microseconds, 0 if update() needs to be called on every iteration
+	 */
+	hrt_abstime next_due();
 	virtual const char *get_name() const = 0;
 	virtual uint16_t get_id() = 0;
 
@@ -87,6 +108,11 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * @return true if update_data() is implemented, so it needs to be called on every iteration
+	 */
+	virtual bool has_update_data() { return false; }
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -120,7 +146,28 @@ public:
 	 * Reset the time of last sent to 0. Can be used if a message over this
 	 * stream needs to be sent immediately.
 	 */
-	void reset_last_sent() { _last_sent = 0; }
+	void reset_last_sent();
+
+	struct Statistics {
+		uint32_t cpu_time;	///< time spent in send() [us]
+		uint32_t tx_bytes;	///< bytes written by send()
+		uint16_t tx_skipped;	///< messages not sent because the TX buffer was full
+		uint16_t sent;		///< successful send() calls
+	};
+
+	/**
+	 * @return the statistics of the last interval completed with rotate_statistics()
+	 */
+	const Statistics &statistics() const { return _stats_last; }
+
+	/**
+	 * Complete the current statistics interval and start a new one
+	 */
+	void rotate_statistics()
+	{
+		_stats_last = _stats;
+		_stats = {};
+	}
 
 protected:
 	Mavlink      *const _mavlink;
@@ -137,8 +184,17 @@ protected:
 	virtual void update_data() { }
 
 private:
+	/**
+	 * send() with accounting of its resource usage
+	 */
+	bool send_measured();
+
 	hrt_abstime _last_sent{0};
 	bool _first_message_sent{false};
+	Priority _priority{Priority::Normal};
+
+	Statistics _stats{};
+	Statistics _stats_last{};
 };
 
 
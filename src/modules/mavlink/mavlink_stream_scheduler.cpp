@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mavlink_stream_scheduler.cpp
+ * Time-ordered scheduling of the mavlink streams.
+ */
+
+#include "mavlink_stream_scheduler.h"
+
+MavlinkStreamScheduler::~MavlinkStreamScheduler()
+{
+	delete[] _heap;
+	delete[] _due;
+}
+
+void MavlinkStreamScheduler::update(List<MavlinkStream *> &streams, const hrt_abstime &t,
+				    const float (&rate_mult)[MavlinkStream::NUM_PRIORITIES])
+{
+	// the due times get earlier when a rate multiplier increases, later ones are handled by
+	// MavlinkStream::update() not sending and the stream being rescheduled
+	bool rate_increased = false;
+
+	for (int i = 0; i < MavlinkStream::NUM_PRIORITIES; ++i) {
+		rate_increased |= rate_mult[i] > _rate_mult[i] * 1.05f;
+	}
+
+	if (!_valid || rate_increased) {
+		rebuild(streams);
+
+		for (int i = 0; i < MavlinkStream::NUM_PRIORITIES; ++i) {
+			_rate_mult[i] = rate_mult[i];
+		}
+
+	} else {
+		for (int i = 0; i < MavlinkStream::NUM_PRIORITIES; ++i) {
+			if (rate_mult[i] < _rate_mult[i]) {
+				_rate_mult[i] = rate_mult[i];
+			}
+		}
+	}
+
+	if (!_heap) {
+		// allocation failed, update all the streams
+		for (const auto &stream : streams) {
+			stream->update(t);
+		}
+
+		return;
+	}
+
+	int num_due = 0;
+
+	while (_size > 0 && _heap[0].due <= t) {
+		_due[num_due++] = _heap[0].stream;
+		pop();
+	}
+
+	for (int i = 0; i < num_due; ++i) {
+		_due[i]->update(t);
+	}
+
+	// update() can invalidate the schedule (reset_last_sent()), then the streams are added on the next rebuild
+	if (_valid) {
+		for (int i = 0; i < num_due; ++i) {
+			push(_due[i]);
+		}
+	}
+}
+
+void MavlinkStreamScheduler::rebuild(List<MavlinkStream *> &streams)
+{
+	const int num_streams = streams.size();
+
+	if (num_streams > _capacity) {
+		delete[] _heap;
+		delete[] _due;
+		const int capacity = num_streams + 8;
+		_heap = new Entry[capacity];
+		_due = new MavlinkStream *[capacity];
+
+		if (!_heap || !_due) {
+			delete[] _heap;
+			delete[] _due;
+			_heap = nullptr;
+			_due = nullptr;
+			_capacity = 0;
+			return;
+		}
+
+		_capacity = capacity;
+	}
+
+	_size = 0;
+	_valid = true;
+
+	for (const auto &stream : streams) {
+		push(stream);
+	}
+}
+
+void MavlinkStreamScheduler::push(MavlinkStream *stream)
+{
+	int i = _size++;
+	_heap[i] = Entry{stream->next_due(), stream};
+
+	while (i > 0) {
+		const int parent = (i - 1) / 2;
+
+		if (_heap[parent].due <= _heap[i].due) {
+			break;
+		}
+
+		const Entry tmp = _heap[parent];
+		_heap[parent] = _heap[i];
+		_heap[i] = tmp;
+		i = parent;
+	}
+}
+
+void MavlinkStreamScheduler::pop()
+{
+	_heap[0] = _heap[--_size];
+	int i = 0;
+
+	while (true) {
+		const int left = 2 * i + 1;
+		const int right = left + 1;
+		int smallest = i;
+
+		if (left < _size && _heap[left].due < _heap[smallest].due) {
+			smallest = left;
+		}
+
+		if (right < _size && _heap[right].due < _heap[smallest].due) {
+			smallest = right;
+		}
+
+		if (smallest == i) {
+			break;
+		}
+
+		const Entry tmp = _heap[smallest];
+		_heap[smallest] = _heap[i];
+		_heap[i] = tmp;
+		i = smallest;
+	}
+}
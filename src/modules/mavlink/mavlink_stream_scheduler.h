@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mavlink_stream_scheduler.h
+ * Time-ordered scheduling of the mavlink streams.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <containers/List.hpp>
+
+#include "mavlink_stream.h"
+
+/**
+ * @class MavlinkStreamScheduler
+ * Min-heap of the streams, ordered by the time at which they are due next. An iteration only
+ * updates the streams that are due instead of all the configured ones, and each stream at most once.
+ */
+class MavlinkStreamScheduler
+{
+public:
+	MavlinkStreamScheduler() = default;
+	~MavlinkStreamScheduler();
+
+	// no copy, assignment, move, move assignment
+	MavlinkStreamScheduler(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler &operator=(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler(MavlinkStreamScheduler &&) = delete;
+	MavlinkStreamScheduler &operator=(MavlinkStreamScheduler &&) = delete;
+
+	/**
+	 * The stream list or the stream configuration changed: rebuild the schedule on the next update.
+	 * This must be called before a stream is deleted.
+	 */
+	void invalidate() { _valid = false; }
+
+	/**
+	 * Update the streams that are due.
+	 * @param streams list of all the streams
+	 * @param t current time
+	 * @param rate_mult current rate multipliers of the link, for each stream priority
+	 */
+	void update(List<MavlinkStream *> &streams, const hrt_abstime &t,
+		    const float (&rate_mult)[MavlinkStream::NUM_PRIORITIES]);
+
+private:
+	struct Entry {
+		hrt_abstime due;
+		MavlinkStream *stream;
+	};
+
+	void rebuild(List<MavlinkStream *> &streams);
+
+	void push(MavlinkStream *stream);
+	void pop();
+
+	Entry *_heap{nullptr};
+	MavlinkStream **_due{nullptr}; ///< streams updated in the current iteration
+	int _capacity{0};
+	int _size{0};
+	float _rate_mult[MavlinkStream::NUM_PRIORITIES] {1.f, 1.f, 1.f}; ///< lowest rate multipliers since the schedule was built
+	bool _valid{false};
+};
@@ -452,6 +452,54 @@ bool MavlinkFtpTest::_terminate_badsession_test()
 	return true;
 }
 
+/// @brief Tests for correct reponse to Open commands until all sessions are used.
+bool MavlinkFtpTest::_open_sessions_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+	const char				*file = _rgDownloadTestCases[0].file;
+
+	for (int i = 0; i <= MavlinkFTP::kMaxSessions; i++) {
+		payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+		payload.offset = 0;
+		payload.size = strlen(file) + 1;
+
+		bool success = _send_receive_msg(&payload,	// FTP payload header
+						 (uint8_t *)file,	// Data to start into FTP message payload
+						 payload.size,	// size in bytes of data
+						 &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		if (i < MavlinkFTP::kMaxSessions) {
+			ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+			ut_compare("Incorrect session", reply->session, i);
+
+		} else {
+			ut_compare("Didn't get Nak back", reply->opcode, MavlinkFTP::kRspNak);
+			ut_compare("Incorrect error code", reply->data[0], MavlinkFTP::kErrNoSessionsAvailable);
+		}
+	}
+
+	payload.opcode = MavlinkFTP::kCmdResetSessions;
+	payload.size = 0;
+
+	bool success = _send_receive_msg(&payload,	// FTP payload header
+					 nullptr,	// Data to start into FTP message payload
+					 0,		// size in bytes of data
+					 &reply);	// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	return true;
+}
+
 /// @brief Tests for correct reponse to a Read command on an open session.
 bool MavlinkFtpTest::_read_test()
 {
@@ -1014,6 +1062,7 @@ bool MavlinkFtpTest::run_tests()
 	ut_run_test(_open_badfile_test);
 	ut_run_test(_open_terminate_test);
 	ut_run_test(_terminate_badsession_test);
+	ut_run_test(_open_sessions_test);
 	ut_run_test(_read_test);
 	ut_run_test(_read_badsession_test);
 	ut_run_test(_burst_test);
@@ -87,6 +87,7 @@ private:
 	bool _open_badfile_test(void);
 	bool _open_terminate_test(void);
 	bool _terminate_badsession_test(void);
+	bool _open_sessions_test(void);
 	bool _read_test(void);
 	bool _read_badsession_test(void);
 	bool _burst_test(void);
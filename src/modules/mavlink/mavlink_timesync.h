@@ -60,6 +60,9 @@ public:
 	 */
 	uint64_t sync_stamp(uint64_t usec) { return _timesync.sync_stamp(usec); }
 
+	uint32_t round_trip_time() const { return _timesync.round_trip_time(); }
+	uint32_t round_trip_time_samples() const { return _timesync.round_trip_time_samples(); }
+
 private:
 	Mavlink &_mavlink;
 	Timesync _timesync{};
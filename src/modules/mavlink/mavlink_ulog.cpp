@@ -48,13 +48,17 @@ MavlinkULog *MavlinkULog::_instance = nullptr;
 px4_sem_t MavlinkULog::_lock;
 
 
-MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component)
-	: _target_system(target_system), _target_component(target_component),
+MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, int window_size, uint8_t target_system,
+			 uint8_t target_component)
+	: _window_size(math::constrain(window_size, 1, (int)ulog_stream_s::ORB_QUEUE_LENGTH)),
+	  _target_system(target_system), _target_component(target_component),
 	  _max_rate_factor(max_rate_factor),
 	  _max_num_messages(math::max(1, (int)ceilf((_rate_calculation_delta_t / 1e6f) * _max_rate_factor * datarate /
 				      (MAVLINK_MSG_ID_LOGGING_DATA_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES)))),
 	  _current_rate_factor(max_rate_factor)
 {
+	_window = new AckedMessage[_window_size];
+
 	// make sure we won't read any old messages
 	while (_ulog_stream_sub.update()) {
 
@@ -67,6 +71,7 @@ MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_sys
 
 MavlinkULog::~MavlinkULog()
 {
+	delete[] _window;
 	perf_free(_msg_missed_ulog_stream_perf);
 }
 
@@ -79,7 +84,7 @@ void MavlinkULog::start_ack_received()
 	}
 }
 
-int MavlinkULog::handle_update(mavlink_channel_t channel)
+int MavlinkULog::handle_update(mavlink_channel_t channel, unsigned free_tx_buf)
 {
 	static_assert(sizeof(ulog_stream_s::data) == MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN,
 		      "Invalid uorb ulog_stream.data length");
@@ -95,45 +100,37 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 		return 0;
 	}
 
-	// check if we're waiting for an ACK
-	if (_last_sent_time) {
-		bool check_for_updates = false;
+	static constexpr unsigned msg_len = math::max(MAVLINK_MSG_ID_LOGGING_DATA_LEN,
+					    MAVLINK_MSG_ID_LOGGING_DATA_ACKED_LEN) + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+
+	lock();
 
-		if (_ack_received) {
-			_last_sent_time = 0;
-			check_for_updates = true;
+	// selectively re-send the acked messages that timed out
+	for (int i = 0; i < _window_count; ++i) {
+		AckedMessage &acked_msg = _window[(_window_start + i) % _window_size];
 
-		} else {
+		if (!acked_msg.acked && hrt_elapsed_time(&acked_msg.sent_time) > ulog_stream_ack_s::ACK_TIMEOUT * 1000) {
+			if (acked_msg.tries >= ulog_stream_ack_s::ACK_MAX_TRIES) {
+				unlock();
+				return -ETIMEDOUT;
+			}
 
-			if (hrt_elapsed_time(&_last_sent_time) > ulog_stream_ack_s::ACK_TIMEOUT * 1000) {
-				if (++_sent_tries > ulog_stream_ack_s::ACK_MAX_TRIES) {
-					return -ETIMEDOUT;
-
-				} else {
-					PX4_DEBUG("re-sending ulog mavlink message (try=%i)", _sent_tries);
-					_last_sent_time = hrt_absolute_time();
-
-					const ulog_stream_s &ulog_data = _ulog_stream_sub.get();
-
-					mavlink_logging_data_acked_t msg;
-					msg.sequence = ulog_data.msg_sequence;
-					msg.length = ulog_data.length;
-					msg.first_message_offset = ulog_data.first_message_offset;
-					msg.target_system = _target_system;
-					msg.target_component = _target_component;
-					memcpy(msg.data, ulog_data.data, sizeof(msg.data));
-					mavlink_msg_logging_data_acked_send_struct(channel, &msg);
-				}
+			if (_current_num_msgs >= _max_num_messages || free_tx_buf < msg_len) {
+				break;
 			}
-		}
 
-		if (!check_for_updates) {
-			return 0;
+			++acked_msg.tries;
+			PX4_DEBUG("re-sending ulog mavlink message %i (try=%i)", acked_msg.data.msg_sequence, acked_msg.tries);
+			acked_msg.sent_time = hrt_absolute_time();
+			send_acked(channel, acked_msg.data);
+			free_tx_buf -= msg_len;
+			++_current_num_msgs;
 		}
 	}
 
-
-	while ((_current_num_msgs < _max_num_messages) && _ulog_stream_sub.updated()) {
+	// send new messages while the rate limit, the TX buffer and the ack window allow it
+	while ((_current_num_msgs < _max_num_messages) && free_tx_buf >= msg_len && _window_count < _window_size
+	       && _ulog_stream_sub.updated()) {
 		const unsigned last_generation = _ulog_stream_sub.get_last_generation();
 		_ulog_stream_sub.update();
 
@@ -145,21 +142,13 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 
 		if (ulog_data.timestamp > 0) {
 			if (ulog_data.flags & ulog_stream_s::FLAGS_NEED_ACK) {
-				_sent_tries = 1;
-				_last_sent_time = hrt_absolute_time();
-				lock();
-				_wait_for_ack_sequence = ulog_data.msg_sequence;
-				_ack_received = false;
-				unlock();
-
-				mavlink_logging_data_acked_t msg;
-				msg.sequence = ulog_data.msg_sequence;
-				msg.length = ulog_data.length;
-				msg.first_message_offset = ulog_data.first_message_offset;
-				msg.target_system = _target_system;
-				msg.target_component = _target_component;
-				memcpy(msg.data, ulog_data.data, sizeof(msg.data));
-				mavlink_msg_logging_data_acked_send_struct(channel, &msg);
+				AckedMessage &acked_msg = _window[(_window_start + _window_count) % _window_size];
+				acked_msg.data = ulog_data;
+				acked_msg.sent_time = hrt_absolute_time();
+				acked_msg.tries = 1;
+				acked_msg.acked = false;
+				++_window_count;
+				send_acked(channel, ulog_data);
 
 			} else {
 				mavlink_logging_data_t msg;
@@ -171,11 +160,15 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 				memcpy(msg.data, ulog_data.data, sizeof(msg.data));
 				mavlink_msg_logging_data_send_struct(channel, &msg);
 			}
+
+			free_tx_buf -= msg_len;
 		}
 
 		++_current_num_msgs;
 	}
 
+	unlock();
+
 	//need to update the rate?
 	hrt_abstime t = hrt_absolute_time();
 
@@ -206,7 +199,7 @@ void MavlinkULog::initialize()
 	_init = true;
 }
 
-MavlinkULog *MavlinkULog::try_start(int datarate, float max_rate_factor, uint8_t target_system,
+MavlinkULog *MavlinkULog::try_start(int datarate, float max_rate_factor, int window_size, uint8_t target_system,
 				    uint8_t target_component)
 {
 	MavlinkULog *ret = nullptr;
@@ -214,10 +207,15 @@ MavlinkULog *MavlinkULog::try_start(int datarate, float max_rate_factor, uint8_t
 	lock();
 
 	if (!_instance) {
-		ret = _instance = new MavlinkULog(datarate, max_rate_factor, target_system, target_component);
+		ret = _instance = new MavlinkULog(datarate, max_rate_factor, window_size, target_system, target_component);
 
 		if (!_instance) {
 			failed = true;
+
+		} else if (!_instance->_window) {
+			delete _instance;
+			ret = _instance = nullptr;
+			failed = true;
 		}
 	}
 
@@ -247,9 +245,28 @@ void MavlinkULog::handle_ack(mavlink_logging_ack_t ack)
 	lock();
 
 	if (_instance) { // make sure stop() was not called right before
-		if (_wait_for_ack_sequence == ack.sequence) {
-			_ack_received = true;
-			publish_ack(ack.sequence);
+		for (int i = 0; i < _window_count; ++i) {
+			AckedMessage &acked_msg = _window[(_window_start + i) % _window_size];
+
+			if (acked_msg.data.msg_sequence == ack.sequence) {
+				acked_msg.acked = true;
+				break;
+			}
+		}
+
+		// move the window past the acked messages at its start, and ack them cumulatively
+		bool window_moved = false;
+		uint16_t last_acked_sequence = 0;
+
+		while (_window_count > 0 && _window[_window_start].acked) {
+			last_acked_sequence = _window[_window_start].data.msg_sequence;
+			_window_start = (_window_start + 1) % _window_size;
+			--_window_count;
+			window_moved = true;
+		}
+
+		if (window_moved) {
+			publish_ack(last_acked_sequence);
 		}
 	}
 
@@ -261,6 +278,19 @@ void MavlinkULog::publish_ack(uint16_t sequence)
 	ulog_stream_ack_s ack;
 	ack.timestamp = hrt_absolute_time();
 	ack.msg_sequence = sequence;
+	ack.window_size = _window_size;
 
 	_ulog_stream_ack_pub.publish(ack);
 }
+
+void MavlinkULog::send_acked(mavlink_channel_t channel, const ulog_stream_s &ulog_data)
+{
+	mavlink_logging_data_acked_t msg;
+	msg.sequence = ulog_data.msg_sequence;
+	msg.length = ulog_data.length;
+	msg.first_message_offset = ulog_data.first_message_offset;
+	msg.target_system = _target_system;
+	msg.target_component = _target_component;
+	memcpy(msg.data, ulog_data.data, sizeof(msg.data));
+	mavlink_msg_logging_data_acked_send_struct(channel, &msg);
+}
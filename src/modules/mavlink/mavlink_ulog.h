@@ -73,11 +73,13 @@ public:
 	 * thread-safe
 	 * @param datarate maximum link data rate in B/s
 	 * @param max_rate_factor let ulog streaming use a maximum of max_rate_factor * datarate
+	 * @param window_size maximum number of acked messages in flight
 	 * @param target_system ID for mavlink message
 	 * @param target_component ID for mavlink message
 	 * @return instance, or nullptr
 	 */
-	static MavlinkULog *try_start(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component);
+	static MavlinkULog *try_start(int datarate, float max_rate_factor, int window_size, uint8_t target_system,
+				      uint8_t target_component);
 
 	/**
 	 * stop the stream. It also deletes the singleton object, so make sure cleanup
@@ -88,9 +90,10 @@ public:
 
 	/**
 	 * periodic update method: check for ulog stream messages and handle retransmission.
+	 * @param free_tx_buf free space in the TX buffer of the channel in bytes
 	 * @return 0 on success, <0 otherwise
 	 */
-	int handle_update(mavlink_channel_t channel);
+	int handle_update(mavlink_channel_t channel, unsigned free_tx_buf);
 
 	/** ack from mavlink for a data message */
 	void handle_ack(mavlink_logging_ack_t ack);
@@ -103,7 +106,15 @@ public:
 
 private:
 
-	MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component);
+	/** an acked message in flight */
+	struct AckedMessage {
+		ulog_stream_s data;
+		hrt_abstime sent_time;
+		uint8_t tries;
+		bool acked;
+	};
+
+	MavlinkULog(int datarate, float max_rate_factor, int window_size, uint8_t target_system, uint8_t target_component);
 
 	~MavlinkULog();
 
@@ -119,6 +130,8 @@ private:
 
 	void publish_ack(uint16_t sequence);
 
+	void send_acked(mavlink_channel_t channel, const ulog_stream_s &ulog_data);
+
 	static px4_sem_t _lock;
 	static bool _init;
 	static MavlinkULog *_instance;
@@ -126,10 +139,11 @@ private:
 
 	uORB::SubscriptionData<ulog_stream_s> _ulog_stream_sub{ORB_ID(ulog_stream)};
 	uORB::Publication<ulog_stream_ack_s> _ulog_stream_ack_pub{ORB_ID(ulog_stream_ack)};
-	uint16_t _wait_for_ack_sequence;
-	uint8_t _sent_tries = 0;
-	volatile bool _ack_received = false; ///< set to true if a matching ack received
-	hrt_abstime _last_sent_time = 0; ///< last time we sent a message that requires an ack
+	AckedMessage *_window{nullptr}; ///< ring buffer of the acked messages in flight, protected by _lock
+	const uint8_t _window_size;
+	uint8_t _window_start{0}; ///< index of the oldest message in _window
+	uint8_t _window_count{0}; ///< number of messages in _window
+	hrt_abstime _last_sent_time = 0; ///< start time of waiting for the initial ack
 	bool _waiting_for_initial_ack = false;
 	const uint8_t _target_system;
 	const uint8_t _target_component;
@@ -189,6 +189,8 @@ private:
 		return ret;
 	}
 
+	bool has_update_data() override { return true; }
+
 	void update_data() override
 	{
 		// Keep track of externally registered modes
@@ -505,6 +505,8 @@ private:
 		return false;
 	}
 
+	bool has_update_data() override { return true; }
+
 	void update_data() override
 	{
 		const hrt_abstime t = hrt_absolute_time();
@@ -218,8 +218,9 @@ MulticopterAttitudeControl::Run()
 		parameter_update_s param_update;
 		_parameter_update_sub.copy(&param_update);
 
-		updateParams();
-		parameters_updated();
+		if (updateParamsIfChanged()) {
+			parameters_updated();
+		}
 	}
 
 	// Update hover thrust for stick scaling
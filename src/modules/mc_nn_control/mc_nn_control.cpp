@@ -48,7 +48,10 @@
 namespace
 {
 // This number should be the number of operations in the model, like tanh and fully connected
-using NNControlOpResolver = tflite::MicroMutableOpResolver<3>;
+using NNControlOpResolver = tflite::MicroMutableOpResolver<5>;
+
+// Upper bound for the tensor arena, the final arena is sized to what the model actually needs
+static constexpr size_t kMaxTensorArenaSize = 64 * 1024;
 
 TfLiteStatus RegisterOps(NNControlOpResolver &op_resolver)
 {
@@ -56,26 +59,83 @@ TfLiteStatus RegisterOps(NNControlOpResolver &op_resolver)
 	TF_LITE_ENSURE_STATUS(op_resolver.AddFullyConnected());
 	TF_LITE_ENSURE_STATUS(op_resolver.AddRelu());
 	TF_LITE_ENSURE_STATUS(op_resolver.AddAdd());
+	// Needed by int8 models exported with float inputs and outputs
+	TF_LITE_ENSURE_STATUS(op_resolver.AddQuantize());
+	TF_LITE_ENSURE_STATUS(op_resolver.AddDequantize());
 	return kTfLiteOk;
 }
+
+bool TensorTypeSupported(const TfLiteTensor *tensor)
+{
+	return tensor->type == kTfLiteFloat32 || tensor->type == kTfLiteInt8;
+}
 }  // namespace
 
+NNLayerProfiler::~NNLayerProfiler()
+{
+	for (int i = 0; i < MAX_LAYERS; i++) {
+		perf_free(_layer_perf[i]);
+	}
+}
+
+uint32_t NNLayerProfiler::BeginEvent(const char *tag)
+{
+	const int layer = _next_layer++;
+
+	if (layer >= MAX_LAYERS) {
+		return MAX_LAYERS;
+	}
+
+	if (_layer_perf[layer] == nullptr) {
+		// perf counters keep a pointer to the name, it has to stay valid
+		snprintf(_layer_perf_names[layer], sizeof(_layer_perf_names[layer]), MODULE_NAME": layer %d %s", layer,
+			 tag ? tag : "");
+		_layer_perf[layer] = perf_alloc(PC_ELAPSED, _layer_perf_names[layer]);
+	}
+
+	perf_begin(_layer_perf[layer]);
+	return layer;
+}
+
+void NNLayerProfiler::EndEvent(uint32_t event_handle)
+{
+	if (event_handle < MAX_LAYERS) {
+		perf_end(_layer_perf[event_handle]);
+	}
+}
+
+void NNLayerProfiler::Print() const
+{
+	for (int i = 0; i < MAX_LAYERS; i++) {
+		if (_layer_perf[i]) {
+			perf_print_counter(_layer_perf[i]);
+		}
+	}
+}
+
 MulticopterNeuralNetworkControl::MulticopterNeuralNetworkControl() :
 	ModuleParams(nullptr),
 	WorkItem(MODULE_NAME, px4::wq_configurations::nav_and_controllers),
-	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle"))
+	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")),
+	_deadline_miss_perf(perf_alloc(PC_COUNT, MODULE_NAME": deadline miss"))
 {
 
 }
 
 MulticopterNeuralNetworkControl::~MulticopterNeuralNetworkControl()
 {
+	WaitForInference();
+	delete _interpreter;
+	delete[] _tensor_arena;
 	perf_free(_loop_perf);
+	perf_free(_deadline_miss_perf);
 }
 
 
 bool MulticopterNeuralNetworkControl::init()
 {
+	_async = _param_async.get();
+
 	if (!_angular_velocity_sub.registerCallback()) {
 		PX4_ERR("callback registration failed");
 		return false;
@@ -97,9 +157,37 @@ int MulticopterNeuralNetworkControl::InitializeNetwork()
 		return -1;
 	}
 
-	constexpr int kTensorArenaSize = 10 * 1024;
-	static uint8_t tensor_arena[kTensorArenaSize];
-	_interpreter = new tflite::MicroInterpreter(control_model, resolver, tensor_arena, kTensorArenaSize);
+	// Plan the model in a temporary arena of the maximum size to find out how much it actually needs
+	{
+		uint8_t *probe_arena = new uint8_t[kMaxTensorArenaSize];
+
+		if (probe_arena == nullptr) {
+			PX4_ERR("Failed to allocate probe tensor arena");
+			return -1;
+		}
+
+		tflite::MicroInterpreter probe(control_model, resolver, probe_arena, kMaxTensorArenaSize);
+
+		if (probe.AllocateTensors() != kTfLiteOk) {
+			PX4_ERR("AllocateTensors() failed, model needs more than %zu bytes", kMaxTensorArenaSize);
+			delete[] probe_arena;
+			return -1;
+		}
+
+		// Margin for the alignment of the arena start
+		_tensor_arena_size = probe.arena_used_bytes() + 16;
+		delete[] probe_arena;
+	}
+
+	_tensor_arena = new uint8_t[_tensor_arena_size];
+
+	if (_tensor_arena == nullptr) {
+		PX4_ERR("Failed to allocate tensor arena");
+		return -1;
+	}
+
+	_interpreter = new tflite::MicroInterpreter(control_model, resolver, _tensor_arena, _tensor_arena_size, nullptr,
+			&_layer_profiler);
 
 	// Allocate memory for the model's tensors
 	TfLiteStatus allocate_status = _interpreter->AllocateTensors();
@@ -116,6 +204,18 @@ int MulticopterNeuralNetworkControl::InitializeNetwork()
 		return -1;
 	}
 
+	_output_tensor = _interpreter->output(0);
+
+	if (_output_tensor == nullptr) {
+		PX4_ERR("Output tensor is null");
+		return -1;
+	}
+
+	if (!TensorTypeSupported(_input_tensor) || !TensorTypeSupported(_output_tensor)) {
+		PX4_ERR("Unsupported tensor type, input: %d output: %d", _input_tensor->type, _output_tensor->type);
+		return -1;
+	}
+
 	return PX4_OK;
 }
 
@@ -168,6 +268,18 @@ void MulticopterNeuralNetworkControl::ConfigureNeuralFlightMode(int8 mode_id)
 	config_control_setpoints.flag_control_climb_rate_enabled = true;
 	config_control_setpoints.flag_control_allocation_enabled = false;
 	config_control_setpoints.flag_control_termination_enabled = true;
+
+	if (_fallback_active) {
+		// The classical multicopter cascade tracks the same position setpoint
+		config_control_setpoints.flag_multicopter_position_control_enabled = true;
+		config_control_setpoints.flag_control_position_enabled = true;
+		config_control_setpoints.flag_control_velocity_enabled = true;
+		config_control_setpoints.flag_control_altitude_enabled = true;
+		config_control_setpoints.flag_control_attitude_enabled = true;
+		config_control_setpoints.flag_control_rates_enabled = true;
+		config_control_setpoints.flag_control_allocation_enabled = true;
+	}
+
 	_config_control_setpoints_pub.publish(config_control_setpoints);
 }
 
@@ -329,28 +441,56 @@ void MulticopterNeuralNetworkControl::PopulateInputTensor()
 					     _angular_velocity.xyz[2]);
 	angular_vel_local = frame_transf * angular_vel_local;
 
-	_input_tensor->data.f[0] = trajectory_setpoint_local(0) - position_local(0);
-	_input_tensor->data.f[1] = trajectory_setpoint_local(1) - position_local(1);
-	_input_tensor->data.f[2] = trajectory_setpoint_local(2) - position_local(2);
-	_input_tensor->data.f[3] = _attitude_local_mat(0, 0);
-	_input_tensor->data.f[4] = _attitude_local_mat(0, 1);
-	_input_tensor->data.f[5] = _attitude_local_mat(0, 2);
-	_input_tensor->data.f[6] = _attitude_local_mat(1, 0);
-	_input_tensor->data.f[7] = _attitude_local_mat(1, 1);
-	_input_tensor->data.f[8] = _attitude_local_mat(1, 2);
-	_input_tensor->data.f[9] = linear_velocity_local(0);
-	_input_tensor->data.f[10] = linear_velocity_local(1);
-	_input_tensor->data.f[11] = linear_velocity_local(2);
-	_input_tensor->data.f[12] = angular_vel_local(0);
-	_input_tensor->data.f[13] = angular_vel_local(1);
-	_input_tensor->data.f[14] = angular_vel_local(2);
+	_input_data[0] = trajectory_setpoint_local(0) - position_local(0);
+	_input_data[1] = trajectory_setpoint_local(1) - position_local(1);
+	_input_data[2] = trajectory_setpoint_local(2) - position_local(2);
+	_input_data[3] = _attitude_local_mat(0, 0);
+	_input_data[4] = _attitude_local_mat(0, 1);
+	_input_data[5] = _attitude_local_mat(0, 2);
+	_input_data[6] = _attitude_local_mat(1, 0);
+	_input_data[7] = _attitude_local_mat(1, 1);
+	_input_data[8] = _attitude_local_mat(1, 2);
+	_input_data[9] = linear_velocity_local(0);
+	_input_data[10] = linear_velocity_local(1);
+	_input_data[11] = linear_velocity_local(2);
+	_input_data[12] = angular_vel_local(0);
+	_input_data[13] = angular_vel_local(1);
+	_input_data[14] = angular_vel_local(2);
+
+	if (_input_tensor->type == kTfLiteInt8) {
+		const float scale = _input_tensor->params.scale;
+		const int32_t zero_point = _input_tensor->params.zero_point;
 
-	for (int i = 0; i < 15; i++) {
-		_input_data[i] = _input_tensor->data.f[i];
+		for (int i = 0; i < 15; i++) {
+			const int32_t q = static_cast<int32_t>(lroundf(_input_data[i] / scale)) + zero_point;
+			_input_tensor->data.int8[i] = static_cast<int8_t>(math::constrain(q, (int32_t)INT8_MIN, (int32_t)INT8_MAX));
+		}
+
+	} else {
+		for (int i = 0; i < 15; i++) {
+			_input_tensor->data.f[i] = _input_data[i];
+		}
 	}
 
 }
 
+void MulticopterNeuralNetworkControl::ReadOutputTensor()
+{
+	if (_output_tensor->type == kTfLiteInt8) {
+		const float scale = _output_tensor->params.scale;
+		const int32_t zero_point = _output_tensor->params.zero_point;
+
+		for (int i = 0; i < 4; i++) {
+			_output_data[i] = (static_cast<int32_t>(_output_tensor->data.int8[i]) - zero_point) * scale;
+		}
+
+	} else {
+		for (int i = 0; i < 4; i++) {
+			_output_data[i] = _output_tensor->data.f[i];
+		}
+	}
+}
+
 void MulticopterNeuralNetworkControl::PublishOutput(float *command_actions)
 {
 
@@ -388,24 +528,165 @@ inline void MulticopterNeuralNetworkControl::RescaleActions()
 
 	for (int i = 0; i < 4; i++) {
 
-		if (_output_tensor->data.f[i] < -1.0f) {
-			_output_tensor->data.f[i] = -1.0f;
+		if (_output_data[i] < -1.0f) {
+			_output_data[i] = -1.0f;
 
-		} else if (_output_tensor->data.f[i] > 1.0f) {
-			_output_tensor->data.f[i] = 1.0f;
+		} else if (_output_data[i] > 1.0f) {
+			_output_data[i] = 1.0f;
 		}
 
-		_output_tensor->data.f[i] = _output_tensor->data.f[i] + 1.0f;
-		float rps = _output_tensor->data.f[i] / thrust_coeff;
+		_output_data[i] = _output_data[i] + 1.0f;
+		float rps = _output_data[i] / thrust_coeff;
 		rps = sqrt(rps);
 		float rpm = rps * 60.0f;
-		_output_tensor->data.f[i] = (rpm * 2.0f - max_rpm - min_rpm) / (max_rpm - min_rpm);
-		_output_tensor->data.f[i] = a * (((_output_tensor->data.f[i] + 1.0f) / 2.0f + tmp1) * ((
-				_output_tensor->data.f[i] + 1.0f) / 2.0f + tmp1) - tmp2);
+		_output_data[i] = (rpm * 2.0f - max_rpm - min_rpm) / (max_rpm - min_rpm);
+		_output_data[i] = a * (((_output_data[i] + 1.0f) / 2.0f + tmp1) * ((
+				_output_data[i] + 1.0f) / 2.0f + tmp1) - tmp2);
 	}
 }
 
 
+void NNInferenceWorker::Run()
+{
+	_parent.RunInference();
+}
+
+void MulticopterNeuralNetworkControl::RunInference()
+{
+	const int32_t start_time = GetTime();
+	_layer_profiler.Reset();
+	_inference_ok = (_interpreter->Invoke() == kTfLiteOk);
+	_inference_time = GetTime() - start_time;
+
+	// hand the tensors back to the controller
+	_inference_busy.store(false);
+}
+
+void MulticopterNeuralNetworkControl::WaitForInference()
+{
+	// an inference still queued or running uses the interpreter, bounded in case it was never started
+	for (int i = 0; i < 100 && _inference_busy.load(); i++) {
+		px4_usleep(1000);
+	}
+}
+
+void MulticopterNeuralNetworkControl::RunAsync(int32_t start_time)
+{
+	const hrt_abstime now = hrt_absolute_time();
+	const hrt_abstime deadline = _param_deadline.get();
+
+	if (_inference_scheduled) {
+		if (!_inference_busy.load()) {
+			_inference_scheduled = false;
+
+			if (_inference_ok && (now - _inference_sample) <= deadline) {
+				ReadOutputTensor();
+				RescaleActions();
+
+				if (!_fallback_active) {
+					PublishOutput(_output_data);
+				}
+
+				PublishNeuralControl(_inference_time, GetTime() - start_time);
+				DeadlineMet();
+
+			} else if (!_deadline_missed) {
+				DeadlineMissed();
+			}
+
+		} else if (!_deadline_missed && (now - _inference_sample) > deadline) {
+			// still running, count it now rather than when it finally completes
+			DeadlineMissed();
+		}
+	}
+
+	if (!_inference_scheduled) {
+		PopulateInputTensor();
+		_inference_sample = _angular_velocity.timestamp_sample;
+		_inference_scheduled = true;
+		_deadline_missed = false;
+		_inference_busy.store(true);
+		_inference_worker.ScheduleNow();
+	}
+
+	if (_fallback_active) {
+		PublishFallbackSetpoint();
+	}
+}
+
+void MulticopterNeuralNetworkControl::DeadlineMissed()
+{
+	_deadline_missed = true;
+	_deadline_miss_count++;
+	perf_count(_deadline_miss_perf);
+	_on_time_count = 0;
+
+	SetFallback(true);
+}
+
+void MulticopterNeuralNetworkControl::DeadlineMet()
+{
+	if (_fallback_active && ++_on_time_count >= FALLBACK_RECOVERY_COUNT) {
+		SetFallback(false);
+	}
+}
+
+void MulticopterNeuralNetworkControl::SetFallback(bool fallback)
+{
+	if (fallback != _fallback_active) {
+		_fallback_active = fallback;
+		_on_time_count = 0;
+
+		if (_mode_id != -1) {
+			ConfigureNeuralFlightMode(_mode_id);
+		}
+	}
+}
+
+void MulticopterNeuralNetworkControl::PublishFallbackSetpoint()
+{
+	// offboard setpoints already reach the position controller, the manually generated ones do not
+	if (!_param_manual_control.get()) {
+		return;
+	}
+
+	trajectory_setpoint_s setpoint{};
+	setpoint.position[0] = _trajectory_setpoint.position[0];
+	setpoint.position[1] = _trajectory_setpoint.position[1];
+	setpoint.position[2] = _trajectory_setpoint.position[2];
+
+	for (int i = 0; i < 3; i++) {
+		setpoint.velocity[i] = NAN;
+		setpoint.acceleration[i] = NAN;
+		setpoint.jerk[i] = NAN;
+	}
+
+	setpoint.yaw = matrix::Eulerf(matrix::Quatf(_attitude.q)).psi();
+	setpoint.yawspeed = NAN;
+	setpoint.timestamp = hrt_absolute_time();
+	_trajectory_setpoint_pub.publish(setpoint);
+}
+
+void MulticopterNeuralNetworkControl::PublishNeuralControl(int32_t inference_time, int32_t controller_time)
+{
+	neural_control_s neural_control;
+	neural_control.timestamp = hrt_absolute_time();
+	neural_control.inference_time = inference_time;
+	neural_control.controller_time = controller_time;
+
+	for (int i = 0; i < 15; i++) {
+		neural_control.observation[i] = _input_data[i];
+	}
+
+	neural_control.network_output[0] = _output_data[0];
+	neural_control.network_output[1] = _output_data[1];
+	neural_control.network_output[2] = _output_data[2];
+	neural_control.network_output[3] = _output_data[3];
+	neural_control.deadline_miss_count = _deadline_miss_count;
+	neural_control.fallback_active = _fallback_active;
+	_neural_control_pub.publish(neural_control);
+}
+
 int MulticopterNeuralNetworkControl::task_spawn(int argc, char *argv[])
 {
 	// This function loads the model, sets up the interpreter, allocates memory for the model's tensors, and prepares the input data.
@@ -437,6 +718,7 @@ void MulticopterNeuralNetworkControl::Run()
 {
 	if (should_exit()) {
 		_angular_velocity_sub.unregisterCallback();
+		WaitForInference();
 
 		if (_sent_mode_registration) {
 			UnregisterNeuralFlightMode(_arming_check_id, _mode_id);
@@ -474,6 +756,11 @@ void MulticopterNeuralNetworkControl::Run()
 	if (_vehicle_status_sub.updated()) {
 		_vehicle_status_sub.copy(&vehicle_status);
 		_use_neural = vehicle_status.nav_state == _mode_id;
+
+		if (!_use_neural) {
+			// start the next activation with the network in control
+			SetFallback(false);
+		}
 	}
 
 	if (_parameter_update_sub.updated()) {
@@ -534,9 +821,16 @@ void MulticopterNeuralNetworkControl::Run()
 			}
 		}
 
+		if (_async) {
+			RunAsync(start_time1);
+			perf_end(_loop_perf);
+			return;
+		}
+
 		PopulateInputTensor();
 
 		int32_t start_time2 = GetTime();
+		_layer_profiler.Reset();
 		TfLiteStatus invoke_status = _interpreter->Invoke();
 		int32_t inference_time = GetTime() - start_time2;
 
@@ -545,35 +839,17 @@ void MulticopterNeuralNetworkControl::Run()
 			return;
 		}
 
-		_output_tensor = _interpreter->output(0);
-
-		if (_output_tensor == nullptr) {
-			PX4_ERR("Output tensor is null");
-			return;
-		}
+		ReadOutputTensor();
 
 		// Convert the output tensor to actuator values
 		RescaleActions();
 
-		PublishOutput(_output_tensor->data.f);
+		PublishOutput(_output_data);
 
 		int32_t full_controller_time = GetTime() - start_time1;
 
 		// Publish the neural control debug message
-		neural_control_s neural_control;
-		neural_control.timestamp = hrt_absolute_time();
-		neural_control.inference_time = inference_time;
-		neural_control.controller_time = full_controller_time;
-
-		for (int i = 0; i < 15; i++) {
-			neural_control.observation[i] = _input_data[i];
-		}
-
-		neural_control.network_output[0] = _output_tensor->data.f[0];
-		neural_control.network_output[1] = _output_tensor->data.f[1];
-		neural_control.network_output[2] = _output_tensor->data.f[2];
-		neural_control.network_output[3] = _output_tensor->data.f[3];
-		_neural_control_pub.publish(neural_control);
+		PublishNeuralControl(inference_time, full_controller_time);
 	}
 
 	perf_end(_loop_perf);
@@ -594,6 +870,23 @@ int MulticopterNeuralNetworkControl::print_status()
 		PX4_INFO("Neural control flight mode: Registered, mode id: %d, arming check id: %d", _mode_id, _arming_check_id);
 	}
 
+	PX4_INFO("Model: %s, tensor arena: %zu bytes", _input_tensor && _input_tensor->type == kTfLiteInt8 ? "int8" : "float32",
+		 _tensor_arena_size);
+#if defined(CONFIG_LIB_TFLM_CMSIS_NN)
+	PX4_INFO("Kernels: CMSIS-NN");
+#else
+	PX4_INFO("Kernels: reference");
+#endif // CONFIG_LIB_TFLM_CMSIS_NN
+
+	if (_async) {
+		PX4_INFO("Asynchronous inference, deadline: %" PRId32 " us, misses: %" PRIu32 ", fallback %s",
+			 _param_deadline.get(), _deadline_miss_count, _fallback_active ? "active" : "inactive");
+	}
+
+	perf_print_counter(_loop_perf);
+	perf_print_counter(_deadline_miss_perf);
+	_layer_profiler.Print();
+
 	return 0;
 }
 
@@ -41,6 +41,7 @@
 #pragma once
 
 #include <perf/perf_counter.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/log.h>
@@ -51,6 +52,7 @@
 
 #include <tflite_micro/tensorflow/lite/micro/micro_mutable_op_resolver.h>
 #include <tflite_micro/tensorflow/lite/micro/micro_interpreter.h>
+#include <tflite_micro/tensorflow/lite/micro/micro_profiler_interface.h>
 #include <tflite_micro/tensorflow/lite/schema/schema_generated.h>
 
 // Include model
@@ -80,6 +82,54 @@
 #include <uORB/topics/arming_check_reply.h>
 
 using namespace time_literals; // For the 1_s in the subscription interval
+
+/**
+ * Per layer execution time of the network, the interpreter reports the start and end of every operator.
+ * Layers are numbered in the order they run and each gets a perf counter on its first run.
+ */
+class NNLayerProfiler : public tflite::MicroProfilerInterface
+{
+public:
+	NNLayerProfiler() = default;
+	~NNLayerProfiler() override;
+
+	uint32_t BeginEvent(const char *tag) override;
+	void EndEvent(uint32_t event_handle) override;
+
+	/**
+	 * Call before every inference
+	 */
+	void Reset() { _next_layer = 0; }
+
+	void Print() const;
+
+private:
+	static constexpr int MAX_LAYERS = 16;
+
+	perf_counter_t _layer_perf[MAX_LAYERS] {};
+	char _layer_perf_names[MAX_LAYERS][48] {};
+	int _next_layer{0};
+};
+
+class MulticopterNeuralNetworkControl;
+
+/**
+ * Runs the network on wq:nn_inference (MC_NN_ASYNC), off the controller work queue.
+ */
+class NNInferenceWorker : public px4::WorkItem
+{
+public:
+	explicit NNInferenceWorker(MulticopterNeuralNetworkControl &parent) :
+		WorkItem(MODULE_NAME"_inference", px4::wq_configurations::nn_inference),
+		_parent(parent)
+	{}
+
+private:
+	void Run() override;
+
+	MulticopterNeuralNetworkControl &_parent;
+};
+
 class MulticopterNeuralNetworkControl : public ModuleBase<MulticopterNeuralNetworkControl>, public ModuleParams,
 	public px4::WorkItem
 {
@@ -103,10 +153,21 @@ public:
 	bool init();
 
 private:
+	friend class NNInferenceWorker;
+
 	void Run() override;
 
 	// Functions
+	void RunAsync(int32_t start_time);
+	void RunInference();
+	void WaitForInference();
+	void DeadlineMissed();
+	void DeadlineMet();
+	void SetFallback(bool fallback);
+	void PublishFallbackSetpoint();
+	void PublishNeuralControl(int32_t inference_time, int32_t controller_time);
 	void PopulateInputTensor();
+	void ReadOutputTensor();
 	void PublishOutput(float *command_actions);
 	void RescaleActions();
 	int InitializeNetwork();
@@ -138,6 +199,7 @@ private:
 	uORB::Publication<unregister_ext_component_s> _unregister_ext_component_pub{ORB_ID(unregister_ext_component)};
 	uORB::Publication<vehicle_control_mode_s> _config_control_setpoints_pub{ORB_ID(config_control_setpoints)};
 	uORB::Publication<arming_check_reply_s> _arming_check_reply_pub{ORB_ID(arming_check_reply)};
+	uORB::Publication<trajectory_setpoint_s> _trajectory_setpoint_pub{ORB_ID(trajectory_setpoint)};
 
 	// Variables
 	bool _use_neural{false};
@@ -147,20 +209,42 @@ private:
 	uint8 _mode_request_id{231}; //Random value
 	int8 _arming_check_id{-1};
 	int8 _mode_id{-1};
-	tflite::MicroInterpreter *_interpreter;
-	TfLiteTensor *_input_tensor;
-	TfLiteTensor *_output_tensor;
+	tflite::MicroInterpreter *_interpreter{nullptr};
+	uint8_t *_tensor_arena{nullptr};
+	size_t _tensor_arena_size{0};
+	NNLayerProfiler _layer_profiler;
+	TfLiteTensor *_input_tensor{nullptr};
+	TfLiteTensor *_output_tensor{nullptr};
 	float _input_data[15];
+	float _output_data[4];
 	trajectory_setpoint_s _trajectory_setpoint;
 	vehicle_angular_velocity_s _angular_velocity;
 	vehicle_local_position_s _position;
 	vehicle_attitude_s _attitude;
 	manual_control_setpoint_s _manual_control_setpoint{};
 
+	// Asynchronous inference, the worker owns the interpreter and tensors while _inference_busy is set
+	static constexpr int FALLBACK_RECOVERY_COUNT = 50; ///< on time outputs before handing control back to the network
+
+	bool _async{false}; ///< MC_NN_ASYNC, fixed at startup
+	NNInferenceWorker _inference_worker{*this};
+	px4::atomic_bool _inference_busy{false};
+	bool _inference_scheduled{false};
+	bool _inference_ok{false};
+	int32_t _inference_time{0};
+	hrt_abstime _inference_sample{0}; ///< timestamp_sample of the angular velocity the scheduled inference is based on
+	bool _deadline_missed{false};
+	bool _fallback_active{false};
+	int _on_time_count{0};
+	uint32_t _deadline_miss_count{0};
+	perf_counter_t _deadline_miss_perf;
+
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::MC_NN_MAX_RPM>) _param_max_rpm,
 		(ParamInt<px4::params::MC_NN_MIN_RPM>) _param_min_rpm,
 		(ParamFloat<px4::params::MC_NN_THRST_COEF>) _param_thrust_coeff,
-		(ParamBool<px4::params::MC_NN_MANL_CTRL>) _param_manual_control
+		(ParamBool<px4::params::MC_NN_MANL_CTRL>) _param_manual_control,
+		(ParamBool<px4::params::MC_NN_ASYNC>) _param_async,
+		(ParamInt<px4::params::MC_NN_DEADLINE>) _param_deadline
 	)
 };
@@ -81,3 +81,31 @@ PARAM_DEFINE_FLOAT(MC_NN_THRST_COEF, 1.2f);
  * @group Neural Control
  */
 PARAM_DEFINE_INT32(MC_NN_MANL_CTRL, 1);
+
+/**
+ * Run the neural network asynchronously on its own work queue.
+ *
+ * The inference runs on wq:nn_inference (which can be pinned to a spare core) instead of
+ * the controller work queue, so its variable run time does not delay the controller. Every
+ * result is published one angular velocity update later. If a result misses MC_NN_DEADLINE
+ * the flight mode falls back to the classical multicopter controllers.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group Neural Control
+ */
+PARAM_DEFINE_INT32(MC_NN_ASYNC, 0);
+
+/**
+ * Deadline of an asynchronous inference.
+ *
+ * Maximum age of the angular velocity sample a network output is based on when it is used.
+ * A late output is dropped, counted and switches the flight mode to the classical multicopter
+ * controllers until outputs are on time again. Only used with MC_NN_ASYNC.
+ *
+ * @unit us
+ * @min 500
+ * @max 20000
+ * @group Neural Control
+ */
+PARAM_DEFINE_INT32(MC_NN_DEADLINE, 4000);
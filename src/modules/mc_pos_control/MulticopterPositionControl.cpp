@@ -64,6 +64,9 @@ bool MulticopterPositionControl::init()
 		return false;
 	}
 
+	// shares wq:nav_and_controllers with slower items (eg. land detector), run first in EDF mode
+	SetDeadline(2_ms);
+
 	_time_stamp_last_loop = hrt_absolute_time();
 	ScheduleNow();
 
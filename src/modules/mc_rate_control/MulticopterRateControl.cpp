@@ -64,6 +64,11 @@ MulticopterRateControl::~MulticopterRateControl()
 bool
 MulticopterRateControl::init()
 {
+#if defined(CONFIG_WQ_INLINE_CHAIN)
+	// run right after the angular velocity publication instead of being queued
+	SetInline(_param_mc_inner_loop.get());
+#endif // CONFIG_WQ_INLINE_CHAIN
+
 	if (!_vehicle_angular_velocity_sub.registerCallback()) {
 		PX4_ERR("callback registration failed");
 		return false;
@@ -116,8 +121,9 @@ MulticopterRateControl::Run()
 		parameter_update_s param_update;
 		_parameter_update_sub.copy(&param_update);
 
-		updateParams();
-		parameters_updated();
+		if (updateParamsIfChanged()) {
+			parameters_updated();
+		}
 	}
 
 	/* run controller on gyro changes */
@@ -305,3 +305,17 @@ PARAM_DEFINE_INT32(MC_BAT_SCALE_EN, 0);
  * @group Multicopter Rate Control
  */
 PARAM_DEFINE_FLOAT(MC_YAW_TQ_CUTOFF, 2.f);
+
+/**
+ * Fused inner loop
+ *
+ * Run the rate controller and the control allocation directly after the angular velocity
+ * update on the rate control work queue, as stages of a single pipeline run instead of
+ * separately scheduled work items. The intermediate topics are still published.
+ * Requires firmware built with CONFIG_WQ_INLINE_CHAIN, otherwise it has no effect.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group Multicopter Rate Control
+ */
+PARAM_DEFINE_INT32(MC_INNER_LOOP, 0);
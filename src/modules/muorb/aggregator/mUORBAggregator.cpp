@@ -31,6 +31,7 @@
  *
  ****************************************************************************/
 
+#include <inttypes.h>
 #include <px4_platform_common/log.h>
 #include "mUORBAggregator.hpp"
 
@@ -48,10 +49,28 @@ bool mUORB::Aggregator::NewRecordOverflows(const char *messageName, int32_t leng
 void mUORB::Aggregator::MoveToNextBuffer()
 {
 	bufferWriteIndex = 0;
+	bufferRecords = 0;
+	bufferDeadline = 0;
 	bufferId++;
 	bufferId %= numBuffers;
 }
 
+mUORB::Aggregator::TopicClass mUORB::Aggregator::GetTopicClass(const char *messageName)
+{
+	static const char *const immediate_topics[] = { "sensor_accel", "sensor_gyro", "sensor_imu", "vehicle_imu" };
+	static const char *const low_topics[] = { "battery_status", "cpuload", "esc_status", "estimator_status", "sensor_baro", "sensor_mag" };
+
+	for (const char *prefix : immediate_topics) {
+		if (strncmp(messageName, prefix, strlen(prefix)) == 0) { return TopicClass::Immediate; }
+	}
+
+	for (const char *prefix : low_topics) {
+		if (strncmp(messageName, prefix, strlen(prefix)) == 0) { return TopicClass::Low; }
+	}
+
+	return TopicClass::Normal;
+}
+
 void mUORB::Aggregator::AddRecordToBuffer(const char *messageName, int32_t length, const uint8_t *data)
 {
 	if (! messageName) { return; }
@@ -67,6 +86,12 @@ void mUORB::Aggregator::AddRecordToBuffer(const char *messageName, int32_t lengt
 	bufferWriteIndex += messageNameLength;
 	memcpy(&buffer[bufferId][bufferWriteIndex], data, length);
 	bufferWriteIndex += length;
+
+	if (bufferRecords == 0) {
+		bufferFirstRecord = hrt_absolute_time();
+	}
+
+	bufferRecords++;
 }
 
 int16_t mUORB::Aggregator::SendData()
@@ -77,6 +102,17 @@ int16_t mUORB::Aggregator::SendData()
 		if (aggregationEnabled) {
 			if (bufferWriteIndex) {
 				rc = sendFunc(topicName.c_str(), buffer[bufferId], bufferWriteIndex);
+
+				const uint32_t latency = hrt_elapsed_time(&bufferFirstRecord);
+				stats.batches++;
+				stats.records += bufferRecords;
+				stats.bytes += bufferWriteIndex;
+				stats.latencySum += latency;
+
+				if (bufferWriteIndex > stats.maxBatchBytes) { stats.maxBatchBytes = bufferWriteIndex; }
+
+				if (latency > stats.latencyMax) { stats.latencyMax = latency; }
+
 				MoveToNextBuffer();
 			}
 		}
@@ -85,18 +121,59 @@ int16_t mUORB::Aggregator::SendData()
 	return rc;
 }
 
+int16_t mUORB::Aggregator::SendDataIfDue()
+{
+	if (bufferWriteIndex && hrt_absolute_time() >= bufferDeadline) {
+		stats.flushDeadline++;
+		return SendData();
+	}
+
+	return 0;
+}
+
 int16_t mUORB::Aggregator::ProcessTransmitTopic(const char *topic, const uint8_t *data, uint32_t length_in_bytes)
 {
 	int16_t rc = 0;
 
 	if (sendFunc) {
-		if (aggregationEnabled) {
+		if (aggregationEnabled && topic) {
+			if (headerSize + strlen(topic) + length_in_bytes > directRecordSize) {
+				// Large topic: send the pending records first to keep the order, then
+				// hand the data over directly instead of copying it into the buffer
+				SendData();
+				rc = sendFunc(topic, data, length_in_bytes);
+				stats.direct++;
+				return rc;
+			}
+
 			if (NewRecordOverflows(topic, length_in_bytes)) {
+				stats.flushFull++;
 				rc = SendData();
 			}
 
 			AddRecordToBuffer(topic, length_in_bytes, data);
 
+			switch (GetTopicClass(topic)) {
+			case TopicClass::Immediate:
+				stats.flushImmediate++;
+				rc = SendData();
+				break;
+
+			case TopicClass::Normal:
+				if (bufferRecords == 1 || bufferFirstRecord + normalDeadline < bufferDeadline) {
+					bufferDeadline = bufferFirstRecord + normalDeadline;
+				}
+
+				break;
+
+			case TopicClass::Low:
+				if (bufferRecords == 1) {
+					bufferDeadline = bufferFirstRecord + lowDeadline;
+				}
+
+				break;
+			}
+
 		} else if (topic) {
 			rc = sendFunc(topic, data, length_in_bytes);
 		}
@@ -105,6 +182,23 @@ int16_t mUORB::Aggregator::ProcessTransmitTopic(const char *topic, const uint8_t
 	return rc;
 }
 
+void mUORB::Aggregator::PrintStatistics()
+{
+	PX4_INFO("muorb aggregator: %u batches, %u records, %" PRIu64 " bytes, max batch %u bytes, %u direct",
+		 stats.batches, stats.records, stats.bytes, stats.maxBatchBytes, stats.direct);
+
+	if (stats.batches > 0) {
+		PX4_INFO("avg batch: %.1f records, %" PRIu64 " bytes", (double)stats.records / stats.batches,
+			 stats.bytes / stats.batches);
+
+		if (stats.flushFull + stats.flushImmediate + stats.flushDeadline > 0) {
+			PX4_INFO("flush: %u full, %u immediate, %u deadline, latency avg %" PRIu64 " us, max %u us",
+				 stats.flushFull, stats.flushImmediate, stats.flushDeadline,
+				 stats.latencySum / stats.batches, stats.latencyMax);
+		}
+	}
+}
+
 void mUORB::Aggregator::ProcessReceivedTopic(const char *topic, const uint8_t *data, uint32_t length_in_bytes)
 {
 	if (isAggregate(topic)) {
@@ -114,6 +208,11 @@ void mUORB::Aggregator::ProcessReceivedTopic(const char *topic, const uint8_t *d
 		const uint32_t name_buffer_length = 80;
 		char name_buffer[name_buffer_length];
 
+		stats.batches++;
+		stats.bytes += length_in_bytes;
+
+		if (length_in_bytes > stats.maxBatchBytes) { stats.maxBatchBytes = length_in_bytes; }
+
 		while ((current_index + headerSize) < length_in_bytes) {
 			uint32_t sync_flag = *((uint32_t *) &data[current_index]);
 
@@ -156,12 +255,15 @@ void mUORB::Aggregator::ProcessReceivedTopic(const char *topic, const uint8_t *d
 							     data_length,
 							     const_cast<uint8_t *>(&data[current_index]));
 			current_index += data_length;
+			stats.records++;
 		}
 
 	} else {
 		if (debugFlag) { PX4_INFO("Got non-aggregate buffer for topic %s", topic); }
 
 		// It isn't an aggregated buffer so just process normally
+		stats.direct++;
+
 		_RxHandler->process_received_message(topic,
 						     length_in_bytes,
 						     const_cast<uint8_t *>(data));
@@ -35,6 +35,7 @@
 
 #include <string>
 #include <string.h>
+#include <drivers/drv_hrt.h>
 #include "uORB/uORBCommunicator.hpp"
 
 namespace mUORB
@@ -55,6 +56,26 @@ public:
 
 	int16_t SendData();
 
+	// Send the aggregated buffer if the deadline of one of its records expired
+	int16_t SendDataIfDue();
+
+	void PrintStatistics();
+
+	struct Statistics {
+		uint32_t batches;        // aggregated buffers sent or received
+		uint32_t records;        // records within aggregated buffers
+		uint64_t bytes;          // bytes of aggregated buffers
+		uint32_t maxBatchBytes;
+		uint32_t direct;         // large or non-aggregated records sent/received on their own
+		uint32_t flushFull;      // transmit: flushed because the next record didn't fit
+		uint32_t flushImmediate; // transmit: flushed for a latency critical topic
+		uint32_t flushDeadline;  // transmit: flushed because the deadline expired
+		uint64_t latencySum;     // transmit: time from the first record to the send [us]
+		uint32_t latencyMax;
+	};
+
+	const Statistics &GetStatistics() const { return stats; }
+
 private:
 	static const bool debugFlag;
 
@@ -71,10 +92,28 @@ private:
 	static const uint32_t numBuffers = 2;
 	static const uint32_t bufferSize = 2048;
 
-	uint32_t bufferId;
-	uint32_t bufferWriteIndex;
+	// Records larger than this are sent on their own instead of being copied into the buffer
+	static const uint32_t directRecordSize = bufferSize / 2;
+
+	// Maximum queueing time of a record in the buffer, by topic class
+	enum class TopicClass {
+		Immediate, // latency critical (IMU data), flushed right away
+		Normal,
+		Low,
+	};
+
+	static const hrt_abstime normalDeadline = 2000;
+	static const hrt_abstime lowDeadline = 10000;
+
+	uint32_t bufferId{0};
+	uint32_t bufferWriteIndex{0};
+	uint32_t bufferRecords{0};
+	hrt_abstime bufferFirstRecord{0};
+	hrt_abstime bufferDeadline{0};
 	uint8_t  buffer[numBuffers][bufferSize];
 
+	Statistics stats{};
+
 	uORBCommunicator::IChannelRxHandler *_RxHandler;
 
 	sendFuncPtr sendFunc;
@@ -86,6 +125,8 @@ private:
 	void MoveToNextBuffer();
 
 	void AddRecordToBuffer(const char *messageName, int32_t length, const uint8_t *data);
+
+	static TopicClass GetTopicClass(const char *messageName);
 };
 
 }
@@ -45,6 +45,16 @@ static bool enable_debug = false;
 int
 muorb_main(int argc, char *argv[])
 {
+	if (argc >= 2 && strcmp(argv[1], "status") == 0) {
+		if (uORB::AppsProtobufChannel::isInstance()) {
+			uORB::AppsProtobufChannel::GetInstance()->PrintStatistics();
+			return OK;
+		}
+
+		PX4_INFO("not running");
+		return -EINVAL;
+	}
+
 	return muorb_init();
 }
 
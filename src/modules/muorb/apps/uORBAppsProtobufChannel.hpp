@@ -156,6 +156,11 @@ public:
 	 */
 	bool Test();
 
+	/**
+	 * @brief Print the statistics of the aggregated buffers received from the DSP.
+	 */
+	void PrintStatistics() { _Aggregator.PrintStatistics(); }
+
 private:
 	/**
 	 * Data Members
@@ -0,0 +1,233 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test for the shared memory uORB communicator: processes dying in the middle of a write
+ */
+
+#include <gtest/gtest.h>
+#include "uORBShmChannel.hpp"
+#include <uORB/topics/sensor_accel.h>
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+using namespace uORB;
+
+static const char *const accel_topic = (ORB_ID(sensor_accel))->o_name;
+
+class ReceivedMessages : public uORBCommunicator::IChannelRxHandler
+{
+public:
+	int16_t process_remote_topic(const char *topic_name) override { return 0; }
+	int16_t process_add_subscription(const char *messageName) override { return 0; }
+	int16_t process_remove_subscription(const char *messageName) override { return 0; }
+
+	int16_t process_received_message(const char *messageName, int32_t length, uint8_t *data) override
+	{
+		count++;
+		memcpy(&last, data, sizeof(last));
+		return 0;
+	}
+
+	int count{0};
+	sensor_accel_s last{};
+};
+
+class ShmChannelTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		snprintf(_shm_name, sizeof(_shm_name), "/px4_uorb_test_%i", (int)getpid());
+		shm_unlink(_shm_name);
+
+		_writer = attach();
+		_reader = attach();
+		ASSERT_NE(_writer, nullptr);
+		ASSERT_NE(_reader, nullptr);
+
+		_topic = _writer->topic_index(accel_topic);
+		ASSERT_GE(_topic, 0);
+
+		_reader->register_handler(&_received);
+		_reader->add_subscription(accel_topic, 0);
+	}
+
+	void TearDown() override
+	{
+		delete_channel(_writer);
+		delete_channel(_reader);
+		shm_unlink(_shm_name);
+	}
+
+	ShmChannel *attach()
+	{
+		ShmChannel *channel = new ShmChannel();
+
+		if (!channel->attach(_shm_name)) {
+			delete channel;
+			return nullptr;
+		}
+
+		return channel;
+	}
+
+	void delete_channel(ShmChannel *channel)
+	{
+		if (channel) {
+			channel->detach();
+			delete channel;
+		}
+	}
+
+	/**
+	 * Attach a child process that subscribes to the topic, takes the slot lock,
+	 * starts a write and dies before completing it
+	 */
+	void die_while_writing()
+	{
+		const pid_t pid = fork();
+
+		if (pid == 0) {
+			ShmChannel *channel = attach();
+
+			if (channel) {
+				channel->add_subscription(accel_topic, 0);
+
+				ShmChannel::TopicSlot &s = channel->_header->topics[_topic];
+				channel->lock_slot(s);
+				__atomic_fetch_or(&s.seq, 1u, __ATOMIC_SEQ_CST);
+				memset(channel->_base + s.offset, 0xff, s.size);
+			}
+
+			_exit(channel ? 0 : 1);
+		}
+
+		ASSERT_GT(pid, 0);
+
+		int status = 0;
+		ASSERT_EQ(waitpid(pid, &status, 0), pid);
+		ASSERT_TRUE(WIFEXITED(status));
+		ASSERT_EQ(WEXITSTATUS(status), 0);
+
+		_dead_pid = pid;
+	}
+
+	ShmChannel::TopicSlot &slot() { return _writer->_header->topics[_topic]; }
+
+	bool pending(ShmChannel *channel) { return channel->pending_topics(channel->_process_index)[_topic / 32] & (1u << (_topic % 32)); }
+
+	void mark_pending(ShmChannel *channel) { _writer->mark_pending(channel->_process_index, _topic); }
+
+	uint32_t process_bit(ShmChannel *channel) { return channel->_process_bit; }
+
+	int publish(float x)
+	{
+		sensor_accel_s accel{};
+		accel.x = x;
+		return _writer->send_message(accel_topic, sizeof(accel), (uint8_t *)&accel);
+	}
+
+	void receive() { _reader->process_data_changes(); }
+
+	char _shm_name[32] {};
+	ShmChannel *_writer{nullptr};
+	ShmChannel *_reader{nullptr};
+	int _topic{-1};
+	pid_t _dead_pid{0};
+	ReceivedMessages _received;
+};
+
+TEST_F(ShmChannelTest, Publish)
+{
+	ASSERT_EQ(publish(1.f), 0);
+	EXPECT_TRUE(pending(_reader));
+	EXPECT_FALSE(pending(_writer));
+
+	receive();
+	EXPECT_EQ(_received.count, 1);
+	EXPECT_FLOAT_EQ(_received.last.x, 1.f);
+	EXPECT_FALSE(pending(_reader));
+
+	// nothing new
+	receive();
+	EXPECT_EQ(_received.count, 1);
+}
+
+TEST_F(ShmChannelTest, ReaderSkipsSlotOfDeadWriter)
+{
+	die_while_writing();
+	EXPECT_EQ(slot().lock, _dead_pid);
+	EXPECT_TRUE(slot().seq & 1u);
+
+	// the reader does not block on the incomplete write and keeps the topic pending
+	mark_pending(_reader);
+	receive();
+	EXPECT_EQ(_received.count, 0);
+	EXPECT_TRUE(pending(_reader));
+}
+
+TEST_F(ShmChannelTest, WriterTakesOverLockOfDeadWriter)
+{
+	die_while_writing();
+
+	// the next write takes over the lock and completes the sequence
+	ASSERT_EQ(publish(2.f), 0);
+	EXPECT_EQ(slot().lock, 0);
+	EXPECT_FALSE(slot().seq & 1u);
+
+	receive();
+	EXPECT_EQ(_received.count, 1);
+	EXPECT_FLOAT_EQ(_received.last.x, 2.f);
+}
+
+TEST_F(ShmChannelTest, DeadProcessIndexIsReclaimed)
+{
+	die_while_writing();
+	const uint32_t dead_bit = slot().subscribers & ~(process_bit(_writer) | process_bit(_reader));
+	EXPECT_NE(dead_bit, 0u);
+
+	// a new process takes the index of the dead one and releases what it left behind
+	ShmChannel *channel = attach();
+	ASSERT_NE(channel, nullptr);
+	EXPECT_EQ(process_bit(channel), dead_bit);
+	EXPECT_EQ(slot().lock, 0);
+	EXPECT_EQ(slot().subscribers & dead_bit, 0u);
+
+	delete_channel(channel);
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBShmChannel.hpp"
+
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+#include <uORB/uORBManager.hpp>
+
+#include <string.h>
+
+extern "C" __EXPORT int muorb_shm_main(int argc, char *argv[]);
+
+static void usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Shared memory uORB communicator for POSIX (Linux) targets.
+
+Every px4 process started with this module attaches to the same POSIX shared memory segment,
+and topics (instance 0) subscribed in one process are forwarded from the publishers in the other
+processes without serialization. Publications wake the receivers with a futex.
+
+The topic data is copied through the segment, it is not shared storage: only the latest sample of
+each topic is forwarded, so a queued topic only sees the samples the receiver picks up.
+
+All processes need to be built from the same msg definitions.
+
+### Examples
+$ muorb_shm start -n /px4_uorb
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("muorb_shm", "communication");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_PARAM_STRING('n', "/px4_uorb", nullptr, "Shared memory segment name", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "Print attached processes and statistics");
+}
+
+int muorb_shm_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		usage();
+		return -1;
+	}
+
+	const char *shm_name = "/px4_uorb";
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "n:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'n':
+			shm_name = myoptarg;
+			break;
+
+		default:
+			usage();
+			return -1;
+		}
+	}
+
+	if (myoptind >= argc) {
+		usage();
+		return -1;
+	}
+
+	uORB::ShmChannel *channel = uORB::ShmChannel::GetInstance();
+
+	if (!strcmp(argv[myoptind], "start")) {
+		if (channel && channel->Initialize(shm_name)) {
+			uORB::Manager::get_instance()->set_uorb_communicator(channel);
+			return 0;
+		}
+
+		return -1;
+
+	} else if (!strcmp(argv[myoptind], "status")) {
+		if (channel) {
+			channel->print_status();
+		}
+
+		return 0;
+	}
+
+	usage();
+	return -1;
+}
@@ -0,0 +1,585 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBShmChannel.hpp"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+#include <px4_platform_common/tasks.h>
+#include <uORB/uORBTopics.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+static constexpr uint32_t SHM_MAGIC = 0x50583455; // 'PX4U'
+static constexpr uint32_t RECEIVER_TIMEOUT_NS = 100 * 1000 * 1000; // 100 ms
+static constexpr int READ_RETRIES = 8; // a slot that is still being written is read again on the next wakeup
+static constexpr unsigned LOCK_SPINS = 1000; // attempts between checks whether the lock owner is still alive
+
+static constexpr size_t align8(size_t size) { return (size + 7) & ~(size_t)7; }
+
+uORB::ShmChannel *uORB::ShmChannel::_instance = nullptr;
+
+uint32_t uORB::ShmChannel::compute_topics_hash()
+{
+	// FNV-1a over the layout relevant metadata of all topics
+	uint32_t hash = 2166136261u;
+	const orb_metadata *const *topics = orb_get_topics();
+
+	for (size_t i = 0; i < orb_topics_count(); i++) {
+		const uint32_t values[2] {topics[i]->message_hash, topics[i]->o_size};
+
+		for (uint32_t value : values) {
+			for (int b = 0; b < 4; b++) {
+				hash ^= (value >> (8 * b)) & 0xff;
+				hash *= 16777619u;
+			}
+		}
+	}
+
+	return hash;
+}
+
+bool uORB::ShmChannel::Initialize(const char *shm_name)
+{
+	if (_header != nullptr) {
+		return true;
+	}
+
+	if (!attach(shm_name)) {
+		return false;
+	}
+
+	int task_id = px4_task_spawn_cmd("muorb_shm_rx", SCHED_DEFAULT, SCHED_PRIORITY_MAX - 10, PX4_STACK_ADJUSTED(2048),
+					 (px4_main_t)&receiver_trampoline, nullptr);
+
+	if (task_id < 0) {
+		PX4_ERR("receiver thread start failed");
+		return false;
+	}
+
+	PX4_INFO("attached to %s as process %" PRIu32, shm_name, _process_index);
+
+	return true;
+}
+
+bool uORB::ShmChannel::attach(const char *shm_name)
+{
+	const orb_metadata *const *topics = orb_get_topics();
+	const uint32_t num_topics = orb_topics_count();
+
+	_pending_words = (num_topics + 31) / 32;
+	_pending_offset = align8(sizeof(Header) + num_topics * sizeof(TopicSlot));
+
+	size_t total_size = _pending_offset + align8(MAX_PROCESSES * _pending_words * sizeof(uint32_t));
+
+	for (uint32_t i = 0; i < num_topics; i++) {
+		total_size += align8(topics[i]->o_size);
+
+		if (topics[i]->o_size > _max_topic_size) {
+			_max_topic_size = topics[i]->o_size;
+		}
+	}
+
+	int fd = shm_open(shm_name, O_RDWR | O_CREAT, 0666);
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed (%i)", shm_name, errno);
+		return false;
+	}
+
+	// serialize segment initialization and process registration between processes
+	flock(fd, LOCK_EX);
+
+	struct stat st {};
+
+	if ((fstat(fd, &st) != 0) || ((st.st_size == 0) && (ftruncate(fd, total_size) != 0))) {
+		PX4_ERR("sizing %s failed (%i)", shm_name, errno);
+		flock(fd, LOCK_UN);
+		close(fd);
+		return false;
+	}
+
+	if ((st.st_size != 0) && ((size_t)st.st_size != total_size)) {
+		PX4_ERR("%s has a different size (%zu != %zu), built from other msg definitions?", shm_name, (size_t)st.st_size,
+			total_size);
+		flock(fd, LOCK_UN);
+		close(fd);
+		return false;
+	}
+
+	void *mem = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	if (mem == MAP_FAILED) {
+		PX4_ERR("mmap %s failed (%i)", shm_name, errno);
+		flock(fd, LOCK_UN);
+		close(fd);
+		return false;
+	}
+
+	_base = static_cast<uint8_t *>(mem);
+	_header = static_cast<Header *>(mem);
+	_total_size = total_size;
+
+	const uint32_t topics_hash = compute_topics_hash();
+
+	if (__atomic_load_n(&_header->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC) {
+		// first process: lay out the topic table
+		memset(mem, 0, total_size);
+		_header->topics_hash = topics_hash;
+		_header->num_topics = num_topics;
+		_header->total_size = total_size;
+
+		size_t offset = _pending_offset + align8(MAX_PROCESSES * _pending_words * sizeof(uint32_t));
+
+		for (uint32_t i = 0; i < num_topics; i++) {
+			_header->topics[i].offset = offset;
+			_header->topics[i].size = topics[i]->o_size;
+			offset += align8(topics[i]->o_size);
+		}
+
+		__atomic_store_n(&_header->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+
+	} else if ((_header->topics_hash != topics_hash) || (_header->num_topics != num_topics)) {
+		PX4_ERR("%s was created from other msg definitions", shm_name);
+		munmap(mem, total_size);
+		_header = nullptr;
+		_base = nullptr;
+		flock(fd, LOCK_UN);
+		close(fd);
+		return false;
+	}
+
+	// claim a free (or stale) process index
+	int process_index = -1;
+
+	for (int i = 0; i < MAX_PROCESSES; i++) {
+		const pid_t pid = _header->pids[i];
+
+		if ((pid == 0) || ((kill(pid, 0) != 0) && (errno == ESRCH))) {
+			process_index = i;
+			break;
+		}
+	}
+
+	if (process_index >= 0) {
+		const int32_t stale_pid = _header->pids[process_index];
+
+		_process_index = process_index;
+		_process_bit = 1u << process_index;
+		_header->pids[process_index] = getpid();
+
+		// clear anything left behind by a crashed process with the same index
+		for (uint32_t i = 0; i < num_topics; i++) {
+			__atomic_fetch_and(&_header->topics[i].advertisers, ~_process_bit, __ATOMIC_SEQ_CST);
+			__atomic_fetch_and(&_header->topics[i].subscribers, ~_process_bit, __ATOMIC_SEQ_CST);
+
+			if (stale_pid != 0) {
+				int32_t owner = stale_pid;
+				__atomic_compare_exchange_n(&_header->topics[i].lock, &owner, 0, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+			}
+		}
+
+		for (uint32_t w = 0; w < _pending_words; w++) {
+			__atomic_store_n(&pending_topics(_process_index)[w], 0, __ATOMIC_RELAXED);
+		}
+	}
+
+	flock(fd, LOCK_UN);
+	close(fd);
+
+	if (process_index < 0) {
+		PX4_ERR("too many processes attached to %s", shm_name);
+		munmap(mem, total_size);
+		_header = nullptr;
+		_base = nullptr;
+		return false;
+	}
+
+	_known_advertisers = new uint32_t[num_topics] {};
+	_known_subscribers = new uint32_t[num_topics] {};
+	_sorted_topics = new uint16_t[num_topics];
+	_rx_buffer = new uint8_t[_max_topic_size];
+
+	// insertion sort by name, the topic list is small and sorted only once
+	for (uint32_t i = 0; i < num_topics; i++) {
+		uint32_t j = i;
+
+		while ((j > 0) && (strcmp(topics[_sorted_topics[j - 1]]->o_name, topics[i]->o_name) > 0)) {
+			_sorted_topics[j] = _sorted_topics[j - 1];
+			j--;
+		}
+
+		_sorted_topics[j] = i;
+	}
+
+	// force a scan of the current advertisers and subscribers
+	_last_control_doorbell = __atomic_load_n(&_header->control_doorbell, __ATOMIC_ACQUIRE) - 1;
+
+	return true;
+}
+
+void uORB::ShmChannel::detach()
+{
+	if (_header == nullptr) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < _header->num_topics; i++) {
+		__atomic_fetch_and(&_header->topics[i].advertisers, ~_process_bit, __ATOMIC_SEQ_CST);
+		__atomic_fetch_and(&_header->topics[i].subscribers, ~_process_bit, __ATOMIC_SEQ_CST);
+	}
+
+	__atomic_store_n(&_header->pids[_process_index], 0, __ATOMIC_RELEASE);
+	wake(true);
+
+	munmap(_base, _total_size);
+	_header = nullptr;
+	_base = nullptr;
+
+	delete[] _known_advertisers;
+	delete[] _known_subscribers;
+	delete[] _sorted_topics;
+	delete[] _rx_buffer;
+	_known_advertisers = nullptr;
+	_known_subscribers = nullptr;
+	_sorted_topics = nullptr;
+	_rx_buffer = nullptr;
+}
+
+int uORB::ShmChannel::receiver_trampoline(int argc, char *argv[])
+{
+	_instance->receiver_run();
+	return 0;
+}
+
+void uORB::ShmChannel::receiver_run()
+{
+	while (!_should_exit) {
+		const uint32_t doorbell = __atomic_load_n(&_header->data_doorbell, __ATOMIC_ACQUIRE);
+
+		if (_rx_handler != nullptr) {
+			const uint32_t control = __atomic_load_n(&_header->control_doorbell, __ATOMIC_ACQUIRE);
+
+			if (control != _last_control_doorbell) {
+				_last_control_doorbell = control;
+				process_control_changes();
+			}
+
+			process_data_changes();
+		}
+
+		// sleep until the next publication from any process
+		struct timespec timeout {0, RECEIVER_TIMEOUT_NS};
+		__atomic_fetch_add(&_header->waiters, 1, __ATOMIC_SEQ_CST);
+		syscall(SYS_futex, &_header->data_doorbell, FUTEX_WAIT, doorbell, &timeout, nullptr, 0);
+		__atomic_fetch_sub(&_header->waiters, 1, __ATOMIC_SEQ_CST);
+	}
+}
+
+void uORB::ShmChannel::process_control_changes()
+{
+	const orb_metadata *const *topics = orb_get_topics();
+
+	for (uint32_t i = 0; i < _header->num_topics; i++) {
+		TopicSlot &slot = _header->topics[i];
+
+		const uint32_t advertisers = __atomic_load_n(&slot.advertisers, __ATOMIC_ACQUIRE) & ~_process_bit;
+
+		if (advertisers & ~_known_advertisers[i]) {
+			_rx_handler->process_remote_topic(topics[i]->o_name);
+		}
+
+		_known_advertisers[i] = advertisers;
+
+		const uint32_t subscribers = __atomic_load_n(&slot.subscribers, __ATOMIC_ACQUIRE) & ~_process_bit;
+
+		if (subscribers & ~_known_subscribers[i]) {
+			// sends the current data of a local publisher to the new remote subscriber
+			_rx_handler->process_add_subscription(topics[i]->o_name);
+
+		} else if ((subscribers == 0) && (_known_subscribers[i] != 0)) {
+			_rx_handler->process_remove_subscription(topics[i]->o_name);
+		}
+
+		_known_subscribers[i] = subscribers;
+	}
+}
+
+void uORB::ShmChannel::process_data_changes()
+{
+	const orb_metadata *const *topics = orb_get_topics();
+	uint32_t *pending = pending_topics(_process_index);
+
+	for (uint32_t w = 0; w < _pending_words; w++) {
+		uint32_t topic_bits = __atomic_exchange_n(&pending[w], 0, __ATOMIC_ACQUIRE);
+
+		while (topic_bits != 0) {
+			const uint32_t i = w * 32 + __builtin_ctz(topic_bits);
+			topic_bits &= topic_bits - 1;
+
+			if (!(__atomic_load_n(&_header->topics[i].subscribers, __ATOMIC_RELAXED) & _process_bit)) {
+				continue;
+			}
+
+			uint32_t writer = 0;
+
+			if (!read_topic(i, writer)) {
+				// a write in progress (or a writer that died), read it again on the next wakeup
+				mark_pending(_process_index, i);
+
+			} else if (writer != _process_index) {
+				_rx_handler->process_received_message(topics[i]->o_name, _header->topics[i].size, _rx_buffer);
+				_rx_count.fetch_add(1);
+			}
+		}
+	}
+}
+
+bool uORB::ShmChannel::read_topic(uint32_t i, uint32_t &writer)
+{
+	TopicSlot &slot = _header->topics[i];
+
+	// seqlock read, retry a few times on a concurrent write. The retries are bounded,
+	// so a writer that died in the middle of a write cannot block the receiver.
+	for (int retry = 0; retry < READ_RETRIES; retry++) {
+		const uint32_t seq = __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE);
+
+		if (seq & 1u) {
+			sched_yield();
+			continue;
+		}
+
+		memcpy(_rx_buffer, _base + slot.offset, slot.size);
+		writer = __atomic_load_n(&slot.writer, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+		if (__atomic_load_n(&slot.seq, __ATOMIC_RELAXED) == seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int uORB::ShmChannel::topic_index(const char *messageName) const
+{
+	const orb_metadata *const *topics = orb_get_topics();
+	int left = 0;
+	int right = (int)_header->num_topics - 1;
+
+	while (left <= right) {
+		const int mid = (left + right) / 2;
+		const int cmp = strcmp(messageName, topics[_sorted_topics[mid]]->o_name);
+
+		if (cmp == 0) {
+			return _sorted_topics[mid];
+
+		} else if (cmp < 0) {
+			right = mid - 1;
+
+		} else {
+			left = mid + 1;
+		}
+	}
+
+	return -1;
+}
+
+void uORB::ShmChannel::lock_slot(TopicSlot &slot)
+{
+	const int32_t pid = getpid();
+
+	for (unsigned attempt = 1; ; attempt++) {
+		int32_t owner = 0;
+
+		if (__atomic_compare_exchange_n(&slot.lock, &owner, pid, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			return;
+		}
+
+		if ((attempt % LOCK_SPINS) == 0) {
+			// take over the lock of an owner that died while writing
+			if ((owner != pid) && (kill(owner, 0) != 0) && (errno == ESRCH)
+			    && __atomic_compare_exchange_n(&slot.lock, &owner, pid, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+				return;
+			}
+
+			sched_yield();
+		}
+	}
+}
+
+void uORB::ShmChannel::wake(bool control_change)
+{
+	if (control_change) {
+		__atomic_fetch_add(&_header->control_doorbell, 1, __ATOMIC_SEQ_CST);
+	}
+
+	__atomic_fetch_add(&_header->data_doorbell, 1, __ATOMIC_SEQ_CST);
+
+	// avoid the syscall if no receiver is sleeping
+	if (__atomic_load_n(&_header->waiters, __ATOMIC_SEQ_CST) > 0) {
+		syscall(SYS_futex, &_header->data_doorbell, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+}
+
+int16_t uORB::ShmChannel::topic_advertised(const char *messageName)
+{
+	const int index = (_header != nullptr) ? topic_index(messageName) : -1;
+
+	if (index < 0) {
+		return -1;
+	}
+
+	__atomic_fetch_or(&_header->topics[index].advertisers, _process_bit, __ATOMIC_SEQ_CST);
+	wake(true);
+	return 0;
+}
+
+int16_t uORB::ShmChannel::add_subscription(const char *messageName, int32_t msgRateInHz)
+{
+	const int index = (_header != nullptr) ? topic_index(messageName) : -1;
+
+	if (index < 0) {
+		return -1;
+	}
+
+	__atomic_fetch_or(&_header->topics[index].subscribers, _process_bit, __ATOMIC_SEQ_CST);
+	wake(true);
+	return 0;
+}
+
+int16_t uORB::ShmChannel::remove_subscription(const char *messageName)
+{
+	const int index = (_header != nullptr) ? topic_index(messageName) : -1;
+
+	if (index < 0) {
+		return -1;
+	}
+
+	__atomic_fetch_and(&_header->topics[index].subscribers, ~_process_bit, __ATOMIC_SEQ_CST);
+	wake(true);
+	return 0;
+}
+
+int16_t uORB::ShmChannel::register_handler(uORBCommunicator::IChannelRxHandler *handler)
+{
+	_rx_handler = handler;
+	return 0;
+}
+
+int16_t uORB::ShmChannel::send_message(const char *messageName, int32_t length, uint8_t *data)
+{
+	const int index = (_header != nullptr) ? topic_index(messageName) : -1;
+
+	if (index < 0) {
+		return -1;
+	}
+
+	TopicSlot &slot = _header->topics[index];
+
+	// fast path: nobody else is interested
+	if ((__atomic_load_n(&slot.subscribers, __ATOMIC_RELAXED) & ~_process_bit) == 0) {
+		return 0;
+	}
+
+	if ((uint32_t)length != slot.size) {
+		return -1;
+	}
+
+	lock_slot(slot);
+
+	// write side of the seqlock (odd sequence). The sequence is already odd if the
+	// previous owner died while writing, this write completes it.
+	const uint32_t seq = __atomic_load_n(&slot.seq, __ATOMIC_RELAXED) | 1u;
+	__atomic_store_n(&slot.seq, seq, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	memcpy(_base + slot.offset, data, length);
+	__atomic_store_n(&slot.writer, _process_index, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot.seq, seq + 1, __ATOMIC_RELEASE);
+	__atomic_store_n(&slot.lock, 0, __ATOMIC_RELEASE);
+
+	uint32_t subscribers = __atomic_load_n(&slot.subscribers, __ATOMIC_RELAXED) & ~_process_bit;
+
+	while (subscribers != 0) {
+		mark_pending(__builtin_ctz(subscribers), index);
+		subscribers &= subscribers - 1;
+	}
+
+	_tx_count.fetch_add(1);
+
+	wake(false);
+	return 0;
+}
+
+void uORB::ShmChannel::print_status()
+{
+	if (_header == nullptr) {
+		PX4_INFO("not attached");
+		return;
+	}
+
+	PX4_INFO("process index: %" PRIu32 ", segment size: %" PRIu32 " bytes", _process_index, _header->total_size);
+
+	for (int i = 0; i < MAX_PROCESSES; i++) {
+		if (_header->pids[i] != 0) {
+			PX4_INFO_RAW("  process %i: pid %i\n", i, (int)_header->pids[i]);
+		}
+	}
+
+	const orb_metadata *const *topics = orb_get_topics();
+
+	PX4_INFO_RAW("  topics with remote subscribers:\n");
+
+	for (uint32_t i = 0; i < _header->num_topics; i++) {
+		const uint32_t subscribers = __atomic_load_n(&_header->topics[i].subscribers, __ATOMIC_RELAXED) & ~_process_bit;
+
+		if (subscribers != 0) {
+			PX4_INFO_RAW("    %s (%i)\n", topics[i]->o_name, __builtin_popcount(subscribers));
+		}
+	}
+
+	PX4_INFO("sent: %" PRIu32 ", received: %" PRIu32, _tx_count.load(), _rx_count.load());
+}
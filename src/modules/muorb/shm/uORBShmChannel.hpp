@@ -0,0 +1,207 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file uORBShmChannel.hpp
+ *
+ * uORB communicator exchanging topics with other px4 processes on the same
+ * host through a POSIX shared memory segment.
+ *
+ * The segment holds one slot per topic (instance 0, single entry buffer) laid out
+ * from the generated topic metadata, so only processes built from the same msg
+ * definitions can attach. Publishers write with a seqlock, mark the topic pending
+ * for each subscribing process and wake the receiver threads of the other processes
+ * through a futex in the header. A receiver only reads the topics pending for it.
+ *
+ * This is a communicator, not shared DeviceNode storage: the receiver copies the
+ * latest sample of a slot into the local DeviceNode of its process, so queued
+ * topics only see the samples the receiver picked up, and multi-instance topics
+ * only share instance 0.
+ *
+ * The seqlock writers are serialized with a lock word holding the pid of the writer.
+ * A process that dies while writing does not block the others: readers give up on a
+ * slot after a few retries, and the next writer takes over the lock of a dead owner
+ * and completes the sequence.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <px4_platform_common/atomic.h>
+#include <uORB/uORBCommunicator.hpp>
+
+class ShmChannelTest;
+
+namespace uORB
+{
+
+class ShmChannel final : public uORBCommunicator::IChannel
+{
+public:
+	static constexpr int MAX_PROCESSES = 32;
+
+	static ShmChannel *GetInstance()
+	{
+		if (_instance == nullptr) {
+			_instance = new ShmChannel();
+		}
+
+		return _instance;
+	}
+
+	/**
+	 * Create or attach to the shared memory segment and start the receiver thread.
+	 * @param shm_name name of the segment (eg. "/px4_uorb")
+	 * @return true on success
+	 */
+	bool Initialize(const char *shm_name);
+
+	void print_status();
+
+	// uORBCommunicator::IChannel
+	int16_t topic_advertised(const char *messageName) override;
+	int16_t add_subscription(const char *messageName, int32_t msgRateInHz) override;
+	int16_t remove_subscription(const char *messageName) override;
+	int16_t register_handler(uORBCommunicator::IChannelRxHandler *handler) override;
+	int16_t send_message(const char *messageName, int32_t length, uint8_t *data) override;
+
+private:
+	ShmChannel() = default;
+	~ShmChannel() = default;
+
+	struct TopicSlot {
+		uint32_t seq;               ///< seqlock sequence, odd while a publisher is writing
+		int32_t lock;               ///< pid of the process writing the slot, 0 if free
+		uint32_t writer;            ///< process index of the last writer
+		uint32_t advertisers;       ///< bitmask of processes that advertised the topic
+		uint32_t subscribers;       ///< bitmask of processes with local subscribers
+		uint32_t offset;            ///< offset of the data from the start of the segment
+		uint32_t size;
+	};
+
+	/**
+	 * Map the shared memory segment and claim a process index, without starting the receiver thread
+	 */
+	bool attach(const char *shm_name);
+
+	/**
+	 * Unmap the segment and release the process index. The receiver thread must not be running.
+	 */
+	void detach();
+
+	struct Header {
+		uint32_t magic;
+		uint32_t topics_hash;       ///< hash over all message hashes, must match to attach
+		uint32_t num_topics;
+		uint32_t total_size;
+		uint32_t data_doorbell;     ///< futex, incremented on each publication
+		uint32_t control_doorbell;  ///< incremented on (un)advertise/(un)subscribe, always followed by a data_doorbell wakeup
+		uint32_t waiters;           ///< number of receiver threads sleeping on data_doorbell
+		int32_t pids[MAX_PROCESSES];
+		TopicSlot topics[];
+		// followed by the pending topic bitmasks of each process, then the topic data
+	};
+
+	static int receiver_trampoline(int argc, char *argv[]);
+	void receiver_run();
+
+	void process_control_changes();
+	void process_data_changes();
+
+	/**
+	 * Copy the data of a topic slot into _rx_buffer
+	 * @param writer set to the process index of the last writer
+	 * @return false if the slot is being written
+	 */
+	bool read_topic(uint32_t index, uint32_t &writer);
+
+	int topic_index(const char *messageName) const;
+
+	/**
+	 * Bitmask (one bit per topic) of the topics published since the process last read them
+	 */
+	uint32_t *pending_topics(uint32_t process_index) const
+	{
+		return reinterpret_cast<uint32_t *>(_base + _pending_offset) + process_index * _pending_words;
+	}
+
+	void mark_pending(uint32_t process_index, uint32_t topic)
+	{
+		__atomic_fetch_or(&pending_topics(process_index)[topic / 32], 1u << (topic % 32), __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * Take the write lock of a slot, taking it over from an owner process that died
+	 */
+	void lock_slot(TopicSlot &slot);
+
+	/**
+	 * Wake up the receiver threads of all processes
+	 * @param control_change true if advertisers or subscribers changed
+	 */
+	void wake(bool control_change);
+
+	static uint32_t compute_topics_hash();
+
+	static ShmChannel *_instance;
+
+	uORBCommunicator::IChannelRxHandler *_rx_handler{nullptr};
+
+	Header *_header{nullptr};
+	uint8_t *_base{nullptr};
+	size_t _total_size{0};
+	size_t _pending_offset{0};
+	uint32_t _pending_words{0}; ///< words per process in the pending topic bitmasks
+	uint32_t _process_index{0};
+	uint32_t _process_bit{0};
+
+	// per topic state of this process (indexed like the segment topic table)
+	uint32_t *_known_advertisers{nullptr};
+	uint32_t *_known_subscribers{nullptr};
+	uint16_t *_sorted_topics{nullptr}; ///< topic indices sorted by name for the lookup in send_message()
+
+	uint8_t *_rx_buffer{nullptr};
+	uint32_t _max_topic_size{0};
+
+	uint32_t _last_control_doorbell{0};
+
+	px4::atomic<uint32_t> _tx_count{0};
+	px4::atomic<uint32_t> _rx_count{0};
+
+	volatile bool _should_exit{false};
+
+	friend class ::ShmChannelTest;
+};
+
+} // namespace uORB
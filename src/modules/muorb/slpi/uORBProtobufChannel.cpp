@@ -79,12 +79,18 @@ static void aggregator_thread_func(void *ptr)
 	PX4_INFO("muorb aggregator thread running");
 
 	uORB::ProtobufChannel *muorb = uORB::ProtobufChannel::GetInstance();
+	hrt_abstime last_statistics = hrt_absolute_time();
 
 	while (true) {
-		// Check for timeout. Send buffer if timeout happened.
+		// Check for timeout. Send buffer if the deadline of a record expired.
 		muorb->SendAggregateData();
 
-		qurt_timer_sleep(2000);
+		if (_px4_muorb_debug && hrt_elapsed_time(&last_statistics) > 10000000) {
+			muorb->PrintAggregatorStatistics();
+			last_statistics = hrt_absolute_time();
+		}
+
+		qurt_timer_sleep(1000);
 	}
 
 	qurt_thread_exit(QURT_EOK);
@@ -157,7 +157,14 @@ public:
 	void SendAggregateData()
 	{
 		pthread_mutex_lock(&_tx_mutex);
-		_Aggregator.SendData();
+		_Aggregator.SendDataIfDue();
+		pthread_mutex_unlock(&_tx_mutex);
+	}
+
+	void PrintAggregatorStatistics()
+	{
+		pthread_mutex_lock(&_tx_mutex);
+		_Aggregator.PrintStatistics();
 		pthread_mutex_unlock(&_tx_mutex);
 	}
 
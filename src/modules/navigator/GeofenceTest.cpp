@@ -0,0 +1,237 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GeofenceTest.cpp
+ * Compares the cached and band indexed polygon check of the geofence with the crossing test on the raw dataman vertices.
+ */
+
+#include <gtest/gtest.h>
+
+#include <math.h>
+#include <vector>
+
+#include "geofence.h"
+
+static constexpr double REF_LAT = 47.397742;
+static constexpr double REF_LON = 8.545594;
+
+class GeofenceTest : public ::testing::Test
+{
+public:
+	void TearDown() override
+	{
+		Geofence::freePolygonCache(_polygon);
+	}
+
+protected:
+	/**
+	 * Cache the polygon given by north/east offsets from the reference [m], like Geofence::buildPolygonCache()
+	 * does with the vertices read from dataman.
+	 */
+	void setPolygon(const std::vector<matrix::Vector2d> &offsets)
+	{
+		Geofence::freePolygonCache(_polygon);
+		_points.clear();
+
+		for (const matrix::Vector2d &offset : offsets) {
+			mission_fence_point_s point{};
+			toGlobal(offset(0), offset(1), point.lat, point.lon);
+			point.nav_cmd = NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION;
+			point.frame = NAV_FRAME_GLOBAL;
+			point.vertex_count = offsets.size();
+			_points.push_back(point);
+		}
+
+		_polygon = Geofence::PolygonInfo{};
+		_polygon.vertex_count = _points.size();
+
+		Geofence::FenceVertex *vertices = new Geofence::FenceVertex[_points.size()];
+		Geofence::setPolygonReference(_polygon, _points[0].lat, _points[0].lon);
+
+		for (size_t i = 0; i < _points.size(); ++i) {
+			vertices[i] = Geofence::toPolygonFrame(_polygon, _points[i].lat, _points[i].lon);
+		}
+
+		Geofence::indexPolygon(_polygon, vertices);
+	}
+
+	bool isIndexed() const { return _polygon.band_edges != nullptr; }
+
+	bool insideCache(double lat, double lon) const { return Geofence::insidePolygonCache(_polygon, lat, lon); }
+
+	/** Geofence::insidePolygonDataman() on the raw vertices */
+	bool insideDataman(double lat, double lon) const
+	{
+		bool c = false;
+
+		for (size_t i = 0, j = _points.size() - 1; i < _points.size(); j = i++) {
+			if (Geofence::crossesEdge(_points[i], _points[j], lat, lon)) {
+				c = !c;
+			}
+		}
+
+		return c;
+	}
+
+	static void toGlobal(double north, double east, double &lat, double &lon)
+	{
+		lat = REF_LAT + math::degrees(north / CONSTANTS_RADIUS_OF_EARTH);
+		lon = REF_LON + math::degrees(east / (CONSTANTS_RADIUS_OF_EARTH * cos(math::radians(REF_LAT))));
+	}
+
+	/** Check the point at the given north/east offset from the reference [m], returns whether it is inside */
+	bool checkPoint(double north, double east)
+	{
+		double lat, lon;
+		toGlobal(north, east, lat, lon);
+		const bool inside = insideDataman(lat, lon);
+		EXPECT_EQ(insideCache(lat, lon), inside) << "north " << north << " east " << east;
+		return inside;
+	}
+
+	/** Check a grid over the bounding box (and a margin around it), returns the number of points inside */
+	int checkGrid(double extent, int steps)
+	{
+		// the vertices have round coordinates, keep the grid points off the edges where the result is undefined
+		const double start = -extent + 0.123;
+		int num_inside = 0;
+
+		for (int i = 0; i <= steps; ++i) {
+			for (int j = 0; j <= steps; ++j) {
+				num_inside += checkPoint(start + 2. * extent * i / steps, start + 2. * extent * j / steps);
+			}
+		}
+
+		return num_inside;
+	}
+
+	/** Check points just inside and outside of each edge, and on the horizontal of each vertex */
+	void checkEdges(const std::vector<matrix::Vector2d> &offsets, double distance)
+	{
+		for (size_t i = 0, j = offsets.size() - 1; i < offsets.size(); j = i++) {
+			const matrix::Vector2d edge = offsets[i] - offsets[j];
+			const matrix::Vector2d normal = matrix::Vector2d(-edge(1), edge(0)).normalized();
+
+			for (double t : {0.01, 0.25, 0.5, 0.75, 0.99}) {
+				const matrix::Vector2d p = offsets[j] + edge * t;
+				const bool left = checkPoint(p(0) + normal(0) * distance, p(1) + normal(1) * distance);
+				const bool right = checkPoint(p(0) - normal(0) * distance, p(1) - normal(1) * distance);
+
+				// a simple polygon has one side of each edge inside
+				EXPECT_NE(left, right) << "edge " << i << " t " << t;
+			}
+
+			// the crossing test ray passes through the vertex
+			checkPoint(offsets[i](0) - 1., offsets[i](1));
+			checkPoint(offsets[i](0) + 1., offsets[i](1));
+		}
+	}
+
+	/** Star shaped polygon with alternating radii */
+	static std::vector<matrix::Vector2d> star(int num_vertices, double outer_radius, double inner_radius)
+	{
+		std::vector<matrix::Vector2d> offsets;
+
+		for (int i = 0; i < num_vertices; ++i) {
+			const double angle = 2. * M_PI * i / num_vertices;
+			const double radius = (i % 2 == 0) ? outer_radius : inner_radius;
+			offsets.emplace_back(radius * cos(angle), radius * sin(angle));
+		}
+
+		return offsets;
+	}
+
+	Geofence::PolygonInfo _polygon{};
+	std::vector<mission_fence_point_s> _points;
+};
+
+TEST_F(GeofenceTest, smallPolygonNotIndexed)
+{
+	const std::vector<matrix::Vector2d> square{{-100., -100.}, {-100., 100.}, {100., 100.}, {100., -100.}};
+	setPolygon(square);
+	EXPECT_FALSE(isIndexed());
+
+	EXPECT_GT(checkGrid(150., 60), 0);
+	checkEdges(square, 0.01);
+}
+
+TEST_F(GeofenceTest, starIndexed)
+{
+	const std::vector<matrix::Vector2d> offsets = star(32, 500., 200.);
+	setPolygon(offsets);
+	EXPECT_TRUE(isIndexed());
+
+	EXPECT_GT(checkGrid(600., 120), 0);
+	checkEdges(offsets, 0.01);
+}
+
+TEST_F(GeofenceTest, combIndexed)
+{
+	// concave polygon: teeth along the east axis, so every band holds several edges
+	std::vector<matrix::Vector2d> offsets;
+
+	for (int tooth = 0; tooth < 12; ++tooth) {
+		offsets.emplace_back(0., tooth * 50.);
+		offsets.emplace_back(400., tooth * 50. + 10.);
+		offsets.emplace_back(400., tooth * 50. + 25.);
+		offsets.emplace_back(20., tooth * 50. + 35.);
+	}
+
+	offsets.emplace_back(-50., 12 * 50.);
+	offsets.emplace_back(-50., 0.);
+	setPolygon(offsets);
+	EXPECT_TRUE(isIndexed());
+
+	EXPECT_GT(checkGrid(700., 140), 0);
+	checkEdges(offsets, 0.01);
+}
+
+TEST_F(GeofenceTest, longEdgesIndexed)
+{
+	// a dense arc closed by long edges spanning all bands, which makes the index use fewer bands
+	std::vector<matrix::Vector2d> offsets;
+
+	for (int i = 0; i < 64; ++i) {
+		const double angle = M_PI * i / 63;
+		offsets.emplace_back(1000. * sin(angle) * (1. + 0.05 * (i % 3)), -1000. * cos(angle));
+	}
+
+	offsets.emplace_back(-20., 1000.);
+	offsets.emplace_back(-20., -1000.);
+	setPolygon(offsets);
+	EXPECT_TRUE(isIndexed());
+
+	EXPECT_GT(checkGrid(1100., 110), 0);
+	checkEdges(offsets, 0.01);
+}
@@ -88,6 +88,7 @@ Geofence::Geofence(Navigator *navigator) :
 Geofence::~Geofence()
 {
 	if (_polygons) {
+		freePolygonCaches();
 		delete[](_polygons);
 	}
 }
@@ -211,6 +212,7 @@ void Geofence::_updateFence()
 	bool is_circle_area = false;
 
 	// iterate over all polygons and store their starting vertices
+	freePolygonCaches();
 	_num_polygons = 0;
 	int current_seq = 0;
 
@@ -249,6 +251,9 @@ void Geofence::_updateFence()
 
 					if (new_polygons) {
 						memcpy(new_polygons, _polygons, sizeof(PolygonInfo) * _num_polygons);
+
+					} else {
+						freePolygonCaches();
 					}
 
 					delete[](_polygons);
@@ -275,6 +280,7 @@ void Geofence::_updateFence()
 				} else {
 					polygon.vertex_count = mission_fence_point.vertex_count;
 					current_seq += mission_fence_point.vertex_count;
+					buildPolygonCache(polygon);
 				}
 
 				// check if requiremetns for Home location are met
@@ -287,6 +293,8 @@ void Geofence::_updateFence()
 				if (home_check_okay && current_position_check_okay) {
 					++_num_polygons;
 
+				} else {
+					freePolygonCache(polygon);
 				}
 			}
 
@@ -300,6 +308,193 @@ void Geofence::_updateFence()
 	}
 }
 
+void Geofence::buildPolygonCache(PolygonInfo &polygon)
+{
+	const int vertex_count = polygon.vertex_count;
+
+	if (vertex_count < 3) {
+		return;
+	}
+
+	FenceVertex *vertices = new FenceVertex[vertex_count];
+
+	if (!vertices) {
+		PX4_WARN("fence cache alloc failed");
+		return;
+	}
+
+	const dm_item_t fence_dataman_id{static_cast<dm_item_t>(_stats.dataman_id)};
+	mission_fence_point_s vertex{};
+
+	for (int i = 0; i < vertex_count; ++i) {
+		bool success = _dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + i,
+						       reinterpret_cast<uint8_t *>(&vertex), sizeof(mission_fence_point_s));
+
+		switch (vertex.frame) {
+		case NAV_FRAME_GLOBAL:
+		case NAV_FRAME_GLOBAL_INT:
+		case NAV_FRAME_GLOBAL_RELATIVE_ALT:
+		case NAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
+			break;
+
+		default:
+			// unsupported frames are reported by the dataman path
+			success = false;
+			break;
+		}
+
+		if (!success) {
+			delete[](vertices);
+			return;
+		}
+
+		if (i == 0) {
+			setPolygonReference(polygon, vertex.lat, vertex.lon);
+		}
+
+		vertices[i] = toPolygonFrame(polygon, vertex.lat, vertex.lon);
+	}
+
+	indexPolygon(polygon, vertices);
+}
+
+void Geofence::setPolygonReference(PolygonInfo &polygon, double lat, double lon)
+{
+	// equirectangular frame around the first vertex: linear in lat/lon, so edges stay straight lines
+	polygon.ref_lat = lat;
+	polygon.ref_lon = lon;
+	polygon.lon_scale = M_DEG_TO_RAD * CONSTANTS_RADIUS_OF_EARTH * cos(math::radians(lat));
+}
+
+Geofence::FenceVertex Geofence::toPolygonFrame(const PolygonInfo &polygon, double lat, double lon)
+{
+	return FenceVertex{static_cast<float>((lat - polygon.ref_lat) * M_DEG_TO_RAD * CONSTANTS_RADIUS_OF_EARTH),
+			   static_cast<float>((lon - polygon.ref_lon) * polygon.lon_scale)};
+}
+
+void Geofence::indexPolygon(PolygonInfo &polygon, FenceVertex *vertices)
+{
+	const int vertex_count = polygon.vertex_count;
+
+	polygon.vertices = vertices;
+	polygon.min_x = polygon.max_x = vertices[0].x;
+	polygon.min_y = polygon.max_y = vertices[0].y;
+
+	for (int i = 1; i < vertex_count; ++i) {
+		polygon.min_x = math::min(polygon.min_x, vertices[i].x);
+		polygon.max_x = math::max(polygon.max_x, vertices[i].x);
+		polygon.min_y = math::min(polygon.min_y, vertices[i].y);
+		polygon.max_y = math::max(polygon.max_y, vertices[i].y);
+	}
+
+	// small polygons are cheap enough with the bounding box alone
+	static constexpr int MIN_VERTICES_FOR_INDEX = 16;
+	static constexpr int VERTICES_PER_BAND = 8;
+	static constexpr int MAX_BANDS = 64;
+
+	const float height = polygon.max_y - polygon.min_y;
+
+	if (vertex_count < MIN_VERTICES_FOR_INDEX || height < FLT_EPSILON) {
+		return;
+	}
+
+	const auto band_of = [&polygon](float y, float band_scale, int num_bands) {
+		return math::constrain(static_cast<int>((y - polygon.min_y) * band_scale), 0, num_bands - 1);
+	};
+
+	// Count the band entries, and halve the number of bands while long edges make the index much larger than the polygon
+	int num_bands = math::min(vertex_count / VERTICES_PER_BAND, MAX_BANDS);
+	int num_entries = 0;
+
+	for (; num_bands > 1; num_bands /= 2) {
+		const float band_scale = num_bands / height;
+		num_entries = 0;
+
+		for (int i = 0, j = vertex_count - 1; i < vertex_count; j = i++) {
+			const int band_lo = band_of(math::min(vertices[i].y, vertices[j].y), band_scale, num_bands);
+			const int band_hi = band_of(math::max(vertices[i].y, vertices[j].y), band_scale, num_bands);
+			num_entries += band_hi - band_lo + 1;
+		}
+
+		if (num_entries <= 4 * vertex_count) {
+			break;
+		}
+	}
+
+	if (num_bands < 2 || num_entries > UINT16_MAX) {
+		return;
+	}
+
+	uint16_t *band_offsets = new uint16_t[num_bands + 1];
+	uint16_t *band_edges = new uint16_t[num_entries];
+
+	if (!band_offsets || !band_edges) {
+		PX4_WARN("fence index alloc failed");
+		delete[](band_offsets);
+		delete[](band_edges);
+		return;
+	}
+
+	// two passes: per band counts turned into offsets, then fill in the edges (edge i connects vertex i-1 and i)
+	const float band_scale = num_bands / height;
+
+	for (int b = 0; b <= num_bands; ++b) {
+		band_offsets[b] = 0;
+	}
+
+	for (int i = 0, j = vertex_count - 1; i < vertex_count; j = i++) {
+		const int band_lo = band_of(math::min(vertices[i].y, vertices[j].y), band_scale, num_bands);
+		const int band_hi = band_of(math::max(vertices[i].y, vertices[j].y), band_scale, num_bands);
+
+		for (int b = band_lo; b <= band_hi; ++b) {
+			++band_offsets[b + 1];
+		}
+	}
+
+	for (int b = 0; b < num_bands; ++b) {
+		band_offsets[b + 1] += band_offsets[b];
+	}
+
+	for (int i = 0, j = vertex_count - 1; i < vertex_count; j = i++) {
+		const int band_lo = band_of(math::min(vertices[i].y, vertices[j].y), band_scale, num_bands);
+		const int band_hi = band_of(math::max(vertices[i].y, vertices[j].y), band_scale, num_bands);
+
+		for (int b = band_lo; b <= band_hi; ++b) {
+			// band_offsets[b] is used as the write cursor, and ends up at the start of band b + 1
+			band_edges[band_offsets[b]++] = i;
+		}
+	}
+
+	for (int b = num_bands; b > 0; --b) {
+		band_offsets[b] = band_offsets[b - 1];
+	}
+
+	band_offsets[0] = 0;
+
+	polygon.band_offsets = band_offsets;
+	polygon.band_edges = band_edges;
+	polygon.num_bands = num_bands;
+	polygon.band_scale = band_scale;
+}
+
+void Geofence::freePolygonCache(PolygonInfo &polygon)
+{
+	delete[](polygon.vertices);
+	delete[](polygon.band_offsets);
+	delete[](polygon.band_edges);
+	polygon.vertices = nullptr;
+	polygon.band_offsets = nullptr;
+	polygon.band_edges = nullptr;
+	polygon.num_bands = 0;
+}
+
+void Geofence::freePolygonCaches()
+{
+	for (int i = 0; i < _num_polygons; ++i) {
+		freePolygonCache(_polygons[i]);
+	}
+}
+
 bool Geofence::checkHomeRequirementsForGeofence(const PolygonInfo &polygon)
 {
 	bool checks_pass = true;
@@ -439,6 +634,56 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 	 * Only supports non-complex polygons (not self intersecting)
 	 */
 
+	if (!polygon.vertices) {
+		return insidePolygonDataman(polygon, lat, lon);
+	}
+
+	return insidePolygonCache(polygon, lat, lon);
+}
+
+bool Geofence::insidePolygonCache(const PolygonInfo &polygon, double lat, double lon)
+{
+	const FenceVertex p = toPolygonFrame(polygon, lat, lon);
+	const float x = p.x;
+	const float y = p.y;
+
+	if (x < polygon.min_x || x > polygon.max_x || y < polygon.min_y || y > polygon.max_y) {
+		return false;
+	}
+
+	const FenceVertex *vertices = polygon.vertices;
+	bool c = false;
+
+	if (polygon.band_edges) {
+		// the crossing test only counts edges spanning y, which are all in the band containing y
+		const int band = math::constrain(static_cast<int>((y - polygon.min_y) * polygon.band_scale), 0, polygon.num_bands - 1);
+
+		for (int k = polygon.band_offsets[band]; k < polygon.band_offsets[band + 1]; ++k) {
+			const int i = polygon.band_edges[k];
+			const FenceVertex &vi = vertices[i];
+			const FenceVertex &vj = vertices[i == 0 ? polygon.vertex_count - 1 : i - 1];
+
+			if ((vi.y >= y) != (vj.y >= y) && (x <= (vj.x - vi.x) * (y - vi.y) / (vj.y - vi.y) + vi.x)) {
+				c = !c;
+			}
+		}
+
+	} else {
+		for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
+			const FenceVertex &vi = vertices[i];
+			const FenceVertex &vj = vertices[j];
+
+			if ((vi.y >= y) != (vj.y >= y) && (x <= (vj.x - vi.x) * (y - vi.y) / (vj.y - vi.y) + vi.x)) {
+				c = !c;
+			}
+		}
+	}
+
+	return c;
+}
+
+bool Geofence::insidePolygonDataman(const PolygonInfo &polygon, double lat, double lon)
+{
 	mission_fence_point_s temp_vertex_i{};
 	mission_fence_point_s temp_vertex_j{};
 	bool c = false;
@@ -474,9 +719,7 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 
 		}
 
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
+		if (crossesEdge(temp_vertex_i, temp_vertex_j, lat, lon)) {
 			c = !c;
 		}
 	}
@@ -484,6 +727,14 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 	return c;
 }
 
+bool Geofence::crossesEdge(const mission_fence_point_s &vertex_i, const mission_fence_point_s &vertex_j, double lat,
+			   double lon)
+{
+	return ((double)vertex_i.lon >= lon) != ((double)vertex_j.lon >= lon) &&
+	       (lat <= (double)(vertex_j.lat - vertex_i.lat) * (lon - (double)vertex_i.lon) /
+		(double)(vertex_j.lon - vertex_i.lon) + (double)vertex_i.lat);
+}
+
 bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
 
@@ -721,4 +972,22 @@ void Geofence::printStatus()
 	PX4_INFO("Geofence: %i inclusion, %i exclusion polygons, %i inclusion circles, %i exclusion circles, %i total vertices",
 		 num_inclusion_polygons, num_exclusion_polygons, num_inclusion_circles, num_exclusion_circles,
 		 total_num_vertices);
+
+	int num_cached = 0, num_indexed = 0;
+	size_t cache_bytes = 0;
+
+	for (int i = 0; i < _num_polygons; ++i) {
+		if (_polygons[i].vertices) {
+			++num_cached;
+			cache_bytes += _polygons[i].vertex_count * sizeof(FenceVertex);
+		}
+
+		if (_polygons[i].band_edges) {
+			++num_indexed;
+			cache_bytes += (_polygons[i].num_bands + 1) * sizeof(uint16_t)
+				       + _polygons[i].band_offsets[_polygons[i].num_bands] * sizeof(uint16_t);
+		}
+	}
+
+	PX4_INFO("Geofence: %i polygons cached, %i indexed, %zu bytes", num_cached, num_indexed, cache_bytes);
 }
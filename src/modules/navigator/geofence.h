@@ -57,6 +57,7 @@
 #define GEOFENCE_FILENAME PX4_STORAGEDIR"/etc/geofence.txt"
 
 class Navigator;
+class GeofenceTest;
 
 class Geofence : public ModuleParams
 {
@@ -148,6 +149,7 @@ public:
 	void printStatus();
 
 private:
+	friend class ::GeofenceTest;
 
 	enum class DatamanState {
 		UpdateRequestWait,
@@ -157,6 +159,11 @@ private:
 		Error
 	};
 
+	struct FenceVertex {
+		float x; ///< north offset from the polygon reference [m]
+		float y; ///< east offset from the polygon reference [m]
+	};
+
 	struct PolygonInfo {
 		uint16_t fence_type; ///< one of MAV_CMD_NAV_FENCE_* (can also be a circular region)
 		uint16_t dataman_index;
@@ -164,6 +171,25 @@ private:
 			uint16_t vertex_count;
 			float circle_radius;
 		};
+
+		/**
+		 * RAM copy of the polygon vertices (nullptr for circles or if caching failed).
+		 * The frame is linear in lat/lon, so the crossing test gives the same result as on the raw coordinates.
+		 */
+		FenceVertex *vertices{nullptr};
+		double ref_lat{0.0}; ///< reference of the local frame [deg]
+		double ref_lon{0.0}; ///< reference of the local frame [deg]
+		double lon_scale{0.0}; ///< [m/deg] east scale at the reference latitude
+		float min_x{0.f}, min_y{0.f}, max_x{0.f}, max_y{0.f}; ///< bounding box in the local frame [m]
+
+		/**
+		 * Band index: the bounding box is cut into num_bands slabs along y, and band b holds the edges
+		 * band_edges[band_offsets[b]..band_offsets[b+1]) that overlap it. nullptr if not indexed.
+		 */
+		uint16_t *band_offsets{nullptr};
+		uint16_t *band_edges{nullptr};
+		float band_scale{0.f}; ///< [1/m] num_bands / (max_y - min_y)
+		uint16_t num_bands{0};
 	};
 
 	Navigator   *_navigator{nullptr};
@@ -194,12 +220,60 @@ private:
 	void _updateFence();
 
 
+	/**
+	 * Copy the vertices of a polygon into RAM, compute its bounding box and build the band index.
+	 * Leaves polygon.vertices at nullptr if the polygon can't be cached, in which case the dataman path is used.
+	 */
+	void buildPolygonCache(PolygonInfo &polygon);
+
+	/**
+	 * Set the reference of the local frame of the polygon cache
+	 */
+	static void setPolygonReference(PolygonInfo &polygon, double lat, double lon);
+
+	/**
+	 * Convert a global position to the local frame of the polygon cache
+	 */
+	static FenceVertex toPolygonFrame(const PolygonInfo &polygon, double lat, double lon);
+
+	/**
+	 * Take ownership of the cached vertices, compute the bounding box and build the band index
+	 */
+	static void indexPolygon(PolygonInfo &polygon, FenceVertex *vertices);
+
+	/**
+	 * Release the memory allocated by buildPolygonCache()
+	 */
+	static void freePolygonCache(PolygonInfo &polygon);
+
+	/**
+	 * Release the caches of all stored polygons
+	 */
+	void freePolygonCaches();
+
 	/**
 	 * Check if a single point is within a polygon
 	 * @return true if within polygon
 	 */
 	bool insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude);
 
+	/**
+	 * insidePolygon() reading the vertices from dataman, used for polygons that are not cached
+	 */
+	bool insidePolygonDataman(const PolygonInfo &polygon, double lat, double lon);
+
+	/**
+	 * insidePolygon() on the cached vertices
+	 * @param polygon must be cached!
+	 */
+	static bool insidePolygonCache(const PolygonInfo &polygon, double lat, double lon);
+
+	/**
+	 * PNPOLY crossing test of a single edge on the raw vertex coordinates
+	 */
+	static bool crossesEdge(const mission_fence_point_s &vertex_i, const mission_fence_point_s &vertex_j, double lat,
+				double lon);
+
 	/**
 	 * Check if a single point is within a circle
 	 * @param polygon must be a circle!
@@ -43,7 +43,6 @@
 
 #include "px4_platform_common/defines.h"
 
-#include "mission_feasibility_checker.h"
 #include "navigator.h"
 
 MissionBase::MissionBase(Navigator *navigator, int32_t dataman_cache_size_signed, uint8_t navigator_state_id) :
@@ -77,10 +76,9 @@ MissionBase::updateDatamanCache()
 		const int32_t end_index = math::constrain(start_index + _dataman_cache_size_signed, INT32_C(0),
 					  int32_t(_mission.count) - 1);
 
-		for (int32_t index = start_index; index != end_index; index += math::signNoZero(_dataman_cache_size_signed)) {
-
-			_dataman_cache.load(static_cast<dm_item_t>(_mission.mission_dataman_id), index);
-		}
+		// the cache requests consecutive items from dataman in batches
+		_dataman_cache.prefetch(static_cast<dm_item_t>(_mission.mission_dataman_id), start_index,
+					abs(end_index - start_index), _dataman_cache_size_signed < 0);
 
 		_load_mission_index = _mission.current_seq;
 	}
@@ -122,7 +120,8 @@ void MissionBase::updateMavlinkMission()
 void MissionBase::onMissionUpdate(bool has_mission_items_changed)
 {
 	if (has_mission_items_changed) {
-		_dataman_cache.invalidate();
+		// drop the items cached for the previous mission, including requests still in flight
+		_dataman_cache.setGeneration(_mission.mission_id);
 		_load_mission_index = -1;
 
 		if (canRunMissionFeasibility()) {
@@ -774,8 +773,11 @@ MissionBase::check_mission_valid(bool forced)
 		_navigator->get_mission_result()->geofence_id = _mission.geofence_id;
 		_navigator->get_mission_result()->home_position_counter = _navigator->get_home_position()->update_count;
 
-		MissionFeasibilityChecker missionFeasibilityChecker(_navigator, _dataman_client);
-		_navigator->get_mission_result()->valid = missionFeasibilityChecker.checkMissionFeasible(_mission);
+		if (forced) {
+			_mission_feasibility_checker.invalidate();
+		}
+
+		_navigator->get_mission_result()->valid = _mission_feasibility_checker.checkMissionFeasible(_mission);
 		_navigator->get_mission_result()->seq_total = _mission.count;
 		_navigator->get_mission_result()->seq_reached = -1;
 		_navigator->get_mission_result()->failure = false;
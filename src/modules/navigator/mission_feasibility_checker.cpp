@@ -52,6 +52,26 @@
 #include <uORB/Subscription.hpp>
 #include <px4_platform_common/events.h>
 
+#include <crc32.h>
+
+/**
+ * Hash over the mission item fields the geofence check depends on. The jump counters are stored
+ * in the same item and change during the mission, so the whole item cannot be used.
+ */
+static uint32_t crc32_for_geofence_check(const mission_item_s &mission_item)
+{
+	struct __attribute__((packed)) {
+		double lat;
+		double lon;
+		float altitude;
+		uint16_t nav_cmd;
+		uint8_t altitude_is_relative;
+	} fields{mission_item.lat, mission_item.lon, mission_item.altitude, mission_item.nav_cmd,
+		 static_cast<uint8_t>(mission_item.altitude_is_relative)};
+
+	return crc32part(reinterpret_cast<const uint8_t *>(&fields), sizeof(fields), 0);
+}
+
 bool
 MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission)
 {
@@ -73,9 +93,42 @@ MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission)
 		return false;
 	}
 
+	enum class GeofenceFailure {
+		None,
+		HomeRequired,
+		HomeRequiredRelativeAlt,
+		Violation
+	} geofence_failure = GeofenceFailure::None;
+
+	size_t geofence_violation_index = 0;
+	bool check_geofence = false;
+
+	if (_navigator->get_geofence().isHomeRequired() && !home_valid) {
+		geofence_failure = GeofenceFailure::HomeRequired;
+
+	} else if (_navigator->get_geofence().valid()) {
+		check_geofence = true;
+		prepareGeofenceResults(mission, mission.count);
+	}
+
+	const float home_alt = _navigator->get_home_position()->alt;
+	bool check_items = true;
 	bool failed = false;
 
-	for (size_t i = 0; i < mission.count; i++) {
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	bool check_terrain = _navigator->get_terrain_database().enabled();
+	bool terrain_failed = false;
+	size_t terrain_violation_index = 0;
+	float terrain_clearance = NAN;
+	_terrain_last_lat = (double)NAN;
+	_terrain_last_lon = (double)NAN;
+	_terrain_last_alt = NAN;
+	_terrain_landing = false;
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
+	// Every item is read once and feeds both the per item checks and the geofence check. The per item
+	// checks depend on the previous items and always run, the geofence result is reused for unchanged items.
+	for (size_t i = 0; i < mission.count && (check_items || check_geofence); i++) {
 		struct mission_item_s missionitem = {};
 
 		bool success = _dataman_client.readSync((dm_item_t)mission.mission_dataman_id, i,
@@ -88,67 +141,182 @@ MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission)
 			return false;
 		}
 
-		if (!_feasibility_checker.processNextItem(missionitem, i, mission.count)) {
+		if (check_geofence) {
+			if (missionitem.altitude_is_relative && !home_valid) {
+				geofence_failure = GeofenceFailure::HomeRequiredRelativeAlt;
+				check_geofence = false;
+
+			} else if (!checkItemAgainstGeofence(missionitem, i, home_alt)) {
+				geofence_failure = GeofenceFailure::Violation;
+				geofence_violation_index = i;
+				check_geofence = false;
+			}
+		}
+
+		if (check_items && !_feasibility_checker.processNextItem(missionitem, i, mission.count)) {
 			failed = true;
-			break;
+			check_items = false;
+		}
+
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
+		if (check_terrain && !checkItemAgainstTerrain(missionitem, home_alt, terrain_clearance)) {
+			terrain_failed = true;
+			terrain_violation_index = i;
+			check_terrain = false;
 		}
 
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
 	}
 
 	failed |= _feasibility_checker.someCheckFailed();
 
-	failed |= !checkMissionAgainstGeofence(mission, _navigator->get_home_position()->alt, home_valid);
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
+	if (terrain_failed) {
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: waypoint %zu only %d m above terrain\t",
+				     terrain_violation_index + 1, (int)terrain_clearance);
+		events::send<int16_t, float>(events::ID("navigator_mis_terrain_clearance"), {events::Log::Error, events::LogInternal::Info},
+					     "Mission rejected: waypoint {1} or the leg to it is only {2:.0m_v} above terrain",
+					     terrain_violation_index + 1, terrain_clearance);
+		failed = true;
+	}
+
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
+	switch (geofence_failure) {
+	case GeofenceFailure::None:
+		break;
+
+	case GeofenceFailure::HomeRequired:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
+		events::send(events::ID("navigator_mis_geofence_no_home"), {events::Log::Error, events::LogInternal::Info},
+			     "Geofence requires a valid home position");
+		break;
+
+	case GeofenceFailure::HomeRequiredRelativeAlt:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
+		events::send(events::ID("navigator_mis_geofence_no_home2"), {events::Log::Error, events::LogInternal::Info},
+			     "Geofence requires a valid home position");
+		break;
+
+	case GeofenceFailure::Violation:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu\t",
+				     geofence_violation_index + 1);
+		events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
+				      "Geofence violation for waypoint {1}",
+				      geofence_violation_index + 1);
+		break;
+	}
+
+	failed |= (geofence_failure != GeofenceFailure::None);
+
+	PX4_DEBUG("mission check: %" PRIu32 " of %" PRIu32 " geofence results reused", _geofence_checks_reused, _geofence_checks);
 
 	_navigator->get_mission_result()->warning = failed;
 
 	return !failed;
 }
 
+void
+MissionFeasibilityChecker::prepareGeofenceResults(const mission_s &mission, uint16_t count)
+{
+	const home_position_s &home = *_navigator->get_home_position();
+
+	// the max distance and max altitude checks are relative to home
+	const bool stale = _geofence_results_stale || (mission.geofence_id != _geofence_id)
+			   || (home.lat != _home_lat) || (home.lon != _home_lon) || (home.alt != _home_alt);
+
+	if (count > _geofence_results_size) {
+		delete[] _geofence_results;
+		_geofence_results = new GeofenceResult[count] {};
+		_geofence_results_size = (_geofence_results != nullptr) ? count : 0;
+
+	} else if (stale) {
+		for (uint16_t i = 0; i < _geofence_results_size; i++) {
+			_geofence_results[i].valid = false;
+		}
+	}
+
+	_geofence_results_stale = false;
+	_geofence_id = mission.geofence_id;
+	_home_lat = home.lat;
+	_home_lon = home.lon;
+	_home_alt = home.alt;
+	_geofence_checks = 0;
+	_geofence_checks_reused = 0;
+}
+
 bool
-MissionFeasibilityChecker::checkMissionAgainstGeofence(const mission_s &mission, float home_alt, bool home_valid)
+MissionFeasibilityChecker::checkItemAgainstGeofence(const mission_item_s &mission_item, uint16_t index, float home_alt)
 {
-	if (_navigator->get_geofence().isHomeRequired() && !home_valid) {
-		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
-		events::send(events::ID("navigator_mis_geofence_no_home"), {events::Log::Error, events::LogInternal::Info},
-			     "Geofence requires a valid home position");
-		return false;
+	if (!MissionBlock::item_contains_position(mission_item)) {
+		return true;
 	}
 
-	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
-	if (_navigator->get_geofence().valid()) {
-		for (size_t i = 0; i < mission.count; i++) {
-			struct mission_item_s missionitem = {};
+	++_geofence_checks;
 
-			bool success = _dataman_client.readSync((dm_item_t)mission.mission_dataman_id, i,
-								reinterpret_cast<uint8_t *>(&missionitem),
-								sizeof(mission_item_s));
+	const uint32_t key = crc32_for_geofence_check(mission_item);
+	GeofenceResult *result = (index < _geofence_results_size) ? &_geofence_results[index] : nullptr;
 
-			if (!success) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
+	if ((result != nullptr) && result->valid && (result->key == key)) {
+		++_geofence_checks_reused;
+		return result->inside;
+	}
 
-			if (missionitem.altitude_is_relative && !home_valid) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
-				events::send(events::ID("navigator_mis_geofence_no_home2"), {events::Log::Error, events::LogInternal::Info},
-					     "Geofence requires a valid home position");
-				return false;
-			}
+	// Geofence function checks against home altitude amsl
+	const float altitude = mission_item.altitude_is_relative ? mission_item.altitude + home_alt : mission_item.altitude;
+	const bool inside = _navigator->get_geofence().checkPointAgainstAllGeofences(mission_item.lat, mission_item.lon,
+			    altitude);
 
-			// Geofence function checks against home altitude amsl
-			missionitem.altitude = missionitem.altitude_is_relative ? missionitem.altitude + home_alt : missionitem.altitude;
+	if (result != nullptr) {
+		result->key = key;
+		result->valid = true;
+		result->inside = inside;
+	}
 
-			if (MissionBlock::item_contains_position(missionitem) && !_navigator->get_geofence().checkPointAgainstAllGeofences(
-				    missionitem.lat, missionitem.lon, missionitem.altitude)) {
+	return inside;
+}
 
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu\t", i + 1);
-				events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
-						      "Geofence violation for waypoint {1}",
-						      i + 1);
-				return false;
-			}
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+bool
+MissionFeasibilityChecker::checkItemAgainstTerrain(const mission_item_s &mission_item, float home_alt, float &clearance)
+{
+	if (mission_item.nav_cmd == NAV_CMD_DO_LAND_START) {
+		// the landing approach descends to the ground on purpose
+		_terrain_landing = true;
+	}
+
+	if (!MissionBlock::item_contains_position(mission_item)) {
+		return true;
+	}
+
+	TerrainDatabase &terrain = _navigator->get_terrain_database();
+	const bool takeoff = (mission_item.nav_cmd == NAV_CMD_TAKEOFF) || (mission_item.nav_cmd == NAV_CMD_VTOL_TAKEOFF);
+	const bool landing = _terrain_landing || (mission_item.nav_cmd == NAV_CMD_LAND)
+			     || (mission_item.nav_cmd == NAV_CMD_VTOL_LAND);
+	const float altitude = mission_item.altitude_is_relative ? mission_item.altitude + home_alt : mission_item.altitude;
+	bool passed = true;
+
+	if (!takeoff && !landing) {
+		if (PX4_ISFINITE(_terrain_last_alt)) {
+			// an incomplete result still covers the part of the leg with terrain data
+			terrain.pathClearance(_terrain_last_lat, _terrain_last_lon, _terrain_last_alt,
+					      mission_item.lat, mission_item.lon, altitude, clearance, true);
+
+		} else {
+			float height = NAN;
+			clearance = terrain.terrainHeight(mission_item.lat, mission_item.lon, height, true) ? altitude - height : INFINITY;
 		}
+
+		passed = clearance >= terrain.minClearance();
 	}
 
-	return true;
+	// the vehicle climbs at the takeoff position, so legs start at the takeoff altitude
+	_terrain_last_lat = landing ? (double)NAN : mission_item.lat;
+	_terrain_last_lon = landing ? (double)NAN : mission_item.lon;
+	_terrain_last_alt = landing ? NAN : altitude;
+
+	return passed;
 }
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
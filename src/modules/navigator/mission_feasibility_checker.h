@@ -52,11 +52,58 @@ class Navigator;
 class MissionFeasibilityChecker: public ModuleParams
 {
 private:
+	/**
+	 * Geofence result of a mission item from a previous check. It is reused as long as
+	 * the position of the item, the fence and home did not change.
+	 */
+	struct GeofenceResult {
+		uint32_t key;	///< crc32 over the item fields the geofence check depends on
+		bool valid;
+		bool inside;
+	};
+
 	Navigator *_navigator{nullptr};
 	DatamanClient &_dataman_client;
 	FeasibilityChecker _feasibility_checker;
 
-	bool checkMissionAgainstGeofence(const mission_s &mission, float home_alt, bool home_valid);
+	GeofenceResult *_geofence_results{nullptr};
+	uint16_t _geofence_results_size{0};
+	bool _geofence_results_stale{true};
+	uint32_t _geofence_id{0};		///< geofence generation the cached results belong to
+	double _home_lat{(double)NAN};		///< home position the cached results belong to
+	double _home_lon{(double)NAN};
+	float _home_alt{NAN};
+
+	uint32_t _geofence_checks{0};		///< number of items checked against the geofence
+	uint32_t _geofence_checks_reused{0};	///< number of those answered from the cache
+
+	/**
+	 * Drop the cached geofence results if the fence or home changed, and make room for count items.
+	 */
+	void prepareGeofenceResults(const mission_s &mission, uint16_t count);
+
+	/**
+	 * Check a single mission item against the geofence, reusing the result of the previous check if possible.
+	 *
+	 * @return false for a geofence violation
+	 */
+	bool checkItemAgainstGeofence(const mission_item_s &mission_item, uint16_t index, float home_alt);
+
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	double _terrain_last_lat{(double)NAN};	///< previous item, start of the leg to the next one
+	double _terrain_last_lon{(double)NAN};
+	float _terrain_last_alt{NAN};
+	bool _terrain_landing{false};		///< items after DO_LAND_START are not checked
+
+	/**
+	 * Check a mission item and the leg to it against the terrain database. Only the parts
+	 * with terrain data are checked, takeoff and landing items are skipped.
+	 *
+	 * @param clearance smallest clearance above the terrain found [m]
+	 * @return false if the clearance is below TDB_CLEARANCE
+	 */
+	bool checkItemAgainstTerrain(const mission_item_s &mission_item, float home_alt, float &clearance);
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
 
 public:
 	MissionFeasibilityChecker(Navigator *navigator, DatamanClient &dataman_client) :
@@ -67,7 +114,7 @@ public:
 	{
 
 	}
-	~MissionFeasibilityChecker() = default;
+	~MissionFeasibilityChecker() { delete[] _geofence_results; }
 
 	MissionFeasibilityChecker(const MissionFeasibilityChecker &) = delete;
 	MissionFeasibilityChecker &operator=(const MissionFeasibilityChecker &) = delete;
@@ -76,4 +123,9 @@ public:
 	 * Returns true if mission is feasible and false otherwise
 	 */
 	bool checkMissionFeasible(const mission_s &mission);
+
+	/*
+	 * Forget the results of previous checks, e.g. after a parameter change
+	 */
+	void invalidate() { _geofence_results_stale = true; }
 };
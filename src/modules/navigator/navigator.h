@@ -60,6 +60,9 @@
 #if CONFIG_NAVIGATOR_ADSB
 #include <lib/adsb/AdsbConflict.h>
 #endif // CONFIG_NAVIGATOR_ADSB
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+#include <lib/terrain_database/TerrainDatabase.hpp>
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/events.h>
 #include <px4_platform_common/module.h>
@@ -179,6 +182,10 @@ public:
 
 	Geofence &get_geofence() { return _geofence; }
 
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	TerrainDatabase &get_terrain_database() { return _terrain_database; }
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
 	float get_default_loiter_rad() { return fabsf(_param_nav_loiter_rad.get()); }
 	bool get_default_loiter_CCW() { return _param_nav_loiter_rad.get() < -FLT_EPSILON; }
 
@@ -356,6 +363,11 @@ private:
 	GeofenceBreachAvoidance _gf_breach_avoidance;
 	hrt_abstime _last_geofence_check{0};
 
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	TerrainDatabase	_terrain_database{this, CONFIG_NAVIGATOR_TERRAIN_CACHE_TILES};
+	hrt_abstime	_last_terrain_prefetch{0};
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
 	bool _navigator_status_updated{false};
 	hrt_abstime _last_navigator_status_publication{0};
 
@@ -378,7 +390,6 @@ private:
 	RTL 		_rtl;				/**< class that handles RTL */
 #if CONFIG_NAVIGATOR_ADSB
 	AdsbConflict 	_adsb_conflict;			/**< class that handles ADSB conflict avoidance */
-	traffic_buffer_s _traffic_buffer{};
 #endif // CONFIG_NAVIGATOR_ADSB
 
 	NavigatorMode *_navigation_mode{nullptr};	/**< abstract pointer to current navigation mode class */
@@ -422,6 +433,13 @@ private:
 
 	bool geofence_allows_position(const vehicle_global_position_s &pos);
 
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	/**
+	 * Queue the terrain tiles along the current and next mission leg and the way home for loading
+	 */
+	void terrain_prefetch();
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
 	DEFINE_PARAMETERS(
 		(ParamFloat<px4::params::NAV_LOITER_RAD>)   _param_nav_loiter_rad,	/**< loiter radius for fixedwing */
 		(ParamFloat<px4::params::NAV_ACC_RAD>)      _param_nav_acc_rad,		/**< acceptance for takeoff */
@@ -765,6 +765,11 @@ void Navigator::run()
 		/* Check geofence violation */
 		geofence_breach_check();
 
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+		/* Keep the terrain along the path cached */
+		terrain_prefetch();
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
 		/* Do stuff according to navigation state set by commander */
 		NavigatorMode *navigation_mode_new{nullptr};
 
@@ -1111,6 +1116,10 @@ int Navigator::print_status()
 	PX4_INFO("Running");
 
 	_geofence.printStatus();
+
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	_terrain_database.printStatus();
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
 	return 0;
 }
 
@@ -1263,8 +1272,8 @@ void Navigator::run_fake_traffic()
 
 void Navigator::check_traffic()
 {
-	if (_traffic_sub.updated()) {
-		_traffic_sub.copy(&_adsb_conflict._transponder_report);
+	// drain the queue, with dense traffic several reports arrive per navigator cycle
+	while (_traffic_sub.update(&_adsb_conflict._transponder_report)) {
 
 		uint16_t required_flags = transponder_report_s::PX4_ADSB_FLAGS_VALID_COORDS |
 					  transponder_report_s::PX4_ADSB_FLAGS_VALID_HEADING |
@@ -1583,6 +1592,40 @@ bool Navigator::geofence_allows_position(const vehicle_global_position_s &pos)
 	return true;
 }
 
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+void Navigator::terrain_prefetch()
+{
+	if (!_terrain_database.enabled() || (hrt_elapsed_time(&_last_terrain_prefetch) < 1_s)) {
+		return;
+	}
+
+	_last_terrain_prefetch = hrt_absolute_time();
+
+	const double lat = _global_pos.lat;
+	const double lon = _global_pos.lon;
+
+	if ((_global_pos.timestamp == 0) || !PX4_ISFINITE(lat) || !PX4_ISFINITE(lon)) {
+		return;
+	}
+
+	// the way home is needed by RTL
+	if (_home_pos.valid_hpos) {
+		_terrain_database.prefetchPath(lat, lon, _home_pos.lat, _home_pos.lon);
+	}
+
+	const position_setpoint_s &current = _pos_sp_triplet.current;
+	const position_setpoint_s &next = _pos_sp_triplet.next;
+
+	if (current.valid) {
+		_terrain_database.prefetchPath(lat, lon, current.lat, current.lon);
+
+		if (next.valid) {
+			_terrain_database.prefetchPath(current.lat, current.lon, next.lat, next.lon);
+		}
+	}
+}
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
 void Navigator::preproject_stop_point(double &lat, double &lon)
 {
 	// For multirotors we need to account for the braking distance, otherwise the vehicle will overshoot and go back
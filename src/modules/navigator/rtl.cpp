@@ -476,6 +476,10 @@ void RTL::findRtlDestination(DestinationType &destination_type, PositionYawSetpo
 	} else {
 		rtl_alt = max(_global_pos_sub.get().alt, rtl_position.alt + _param_rtl_return_alt.get());
 	}
+
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	rtl_alt = terrain_safe_return_alt(rtl_position, rtl_alt);
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
 }
 
 void RTL::setLandPosAsDestination(PositionYawSetpoint &rtl_position, mission_item_s &land_mission_item) const
@@ -552,6 +556,28 @@ float RTL::calculate_return_alt_from_cone_half_angle(const PositionYawSetpoint &
 	return constrain(return_altitude_amsl, _global_pos_sub.get().alt, max_return_altitude);
 }
 
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+float RTL::terrain_safe_return_alt(const PositionYawSetpoint &rtl_position, float rtl_alt) const
+{
+	TerrainDatabase &terrain = _navigator->get_terrain_database();
+	const vehicle_global_position_s &global_pos = _global_pos_sub.get();
+	float clearance = INFINITY;
+
+	if (!terrain.enabled()) {
+		return rtl_alt;
+	}
+
+	// the vehicle climbs to the return altitude first and then flies straight to the destination
+	terrain.pathClearance(global_pos.lat, global_pos.lon, rtl_alt, rtl_position.lat, rtl_position.lon, rtl_alt, clearance);
+
+	if (clearance < terrain.minClearance()) {
+		rtl_alt += terrain.minClearance() - clearance;
+	}
+
+	return rtl_alt;
+}
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
 void RTL::init_rtl_mission_type()
 {
 	RtlType new_rtl_mission_type{RtlType::RTL_DIRECT_MISSION_LAND};
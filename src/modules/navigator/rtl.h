@@ -156,6 +156,19 @@ private:
 	float calculate_return_alt_from_cone_half_angle(const PositionYawSetpoint &rtl_position,
 			float cone_half_angle_deg) const;
 
+#if CONFIG_NAVIGATOR_TERRAIN_DATABASE
+	/**
+	 * @brief raise the return altitude to clear the terrain on the direct return path
+	 *
+	 * Only uses cached terrain, the navigator keeps the way home cached.
+	 *
+	 * @param[in] rtl_position landing position of the rtl
+	 * @param[in] rtl_alt return altitude AMSL [m]
+	 * @return return altitude AMSL with at least TDB_CLEARANCE above the known terrain [m]
+	 */
+	float terrain_safe_return_alt(const PositionYawSetpoint &rtl_position, float rtl_alt) const;
+#endif // CONFIG_NAVIGATOR_TERRAIN_DATABASE
+
 	/**
 	 * @brief initialize RTL mission type
 	 *
@@ -77,7 +77,7 @@
 
 #define REG_TO_BOOL(_reg) 	((bool)(_reg))
 
-#define PX4IO_PROTOCOL_VERSION		5
+#define PX4IO_PROTOCOL_VERSION		6
 
 /* maximum allowable sizes on this protocol version */
 #define PX4IO_PROTOCOL_MAX_CONTROL_COUNT	8	/**< The protocol does not support more than set here, individual units might support less - see PX4IO_P_CONFIG_CONTROL_COUNT */
@@ -202,6 +202,18 @@ enum {							/* DSM bind states */
 /* PWM output */
 #define PX4IO_PAGE_DIRECT_PWM			54		/**< 0..CONFIG_ACTUATOR_COUNT-1 */
 
+/* control cycle: a write sets the PWM outputs like PX4IO_PAGE_DIRECT_PWM, and the reply to it
+ * contains the status and RC input, so that a single transaction per control cycle is needed */
+#define PX4IO_PAGE_CYCLE			56		/**< 0..CONFIG_ACTUATOR_COUNT-1 */
+#define PX4IO_P_CYCLE_STATUS_FLAGS		0	/* PX4IO_P_STATUS_FLAGS */
+#define PX4IO_P_CYCLE_STATUS_ALARMS		1	/* PX4IO_P_STATUS_ALARMS */
+#define PX4IO_P_CYCLE_STATUS_VSERVO		2	/* PX4IO_P_STATUS_VSERVO */
+#define PX4IO_P_CYCLE_STATUS_VRSSI		3	/* PX4IO_P_STATUS_VRSSI */
+#define PX4IO_P_CYCLE_SETUP_ARMING		4	/* PX4IO_P_SETUP_ARMING */
+#define PX4IO_P_CYCLE_RAW_RC			5	/* PX4IO_PAGE_RAW_RC_INPUT, starting at PX4IO_P_RAW_RC_COUNT */
+#define PX4IO_P_CYCLE_RC_CHANNELS		18	/* number of RC channels in the reply */
+#define PX4IO_P_CYCLE_COUNT			(PX4IO_P_CYCLE_RAW_RC + PX4IO_P_RAW_RC_BASE + PX4IO_P_CYCLE_RC_CHANNELS)
+
 /* PWM failsafe values - zero disables the output */
 #define PX4IO_PAGE_FAILSAFE_PWM			55		/**< 0..CONFIG_ACTUATOR_COUNT-1 */
 
@@ -227,6 +239,10 @@ struct IOPacket {
 };
 #pragma pack(pop)
 
+#if (PX4IO_P_CYCLE_COUNT > PKT_MAX_REGS)
+#error The control cycle reply must fit into an IO packet
+#endif
+
 #if (PX4IO_MAX_TRANSFER_LEN > PKT_MAX_REGS * 2)
 #error The max transfer length of the IO protocol must not be larger than the IO packet size
 #endif
@@ -184,6 +184,7 @@ registers_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num
 	switch (page) {
 	/* handle raw PWM input */
 	case PX4IO_PAGE_DIRECT_PWM:
+	case PX4IO_PAGE_CYCLE:
 
 		/* copy channel data */
 		while ((offset < PX4IO_CONTROL_CHANNELS) && (num_values > 0)) {
@@ -561,6 +562,26 @@ registers_get(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_val
 		SELECT_PAGE(r_page_status);
 		break;
 
+	case PX4IO_PAGE_CYCLE:
+		/* update the dynamic status registers */
+		registers_get(PX4IO_PAGE_STATUS, 0, values, num_values);
+
+		memset(r_page_scratch, 0, sizeof(r_page_scratch));
+		r_page_scratch[PX4IO_P_CYCLE_STATUS_FLAGS] = r_page_status[PX4IO_P_STATUS_FLAGS];
+		r_page_scratch[PX4IO_P_CYCLE_STATUS_ALARMS] = r_page_status[PX4IO_P_STATUS_ALARMS];
+		r_page_scratch[PX4IO_P_CYCLE_STATUS_VSERVO] = r_page_status[PX4IO_P_STATUS_VSERVO];
+		r_page_scratch[PX4IO_P_CYCLE_STATUS_VRSSI] = r_page_status[PX4IO_P_STATUS_VRSSI];
+		r_page_scratch[PX4IO_P_CYCLE_SETUP_ARMING] = r_setup_arming;
+
+		for (unsigned i = 0; (i < PX4IO_P_RAW_RC_BASE + PX4IO_RC_INPUT_CHANNELS)
+		     && (i < PX4IO_P_RAW_RC_BASE + PX4IO_P_CYCLE_RC_CHANNELS); i++) {
+			r_page_scratch[PX4IO_P_CYCLE_RAW_RC + i] = r_page_raw_rc_input[i];
+		}
+
+		*values = &r_page_scratch[0];
+		*num_values = PX4IO_P_CYCLE_COUNT;
+		break;
+
 	case PX4IO_PAGE_RAW_ADC_INPUT:
 		memset(r_page_scratch, 0, sizeof(r_page_scratch));
 
@@ -189,6 +189,17 @@ rx_handle_packet(void)
 
 		} else {
 			dma_packet.count_code = PKT_CODE_SUCCESS;
+
+			if (dma_packet.page == PX4IO_PAGE_CYCLE) {
+				/* reply with the status and RC input of this cycle */
+				unsigned count;
+				uint16_t *registers;
+
+				if (registers_get(PX4IO_PAGE_CYCLE, 0, &registers, &count) == 0) {
+					memcpy((void *)&dma_packet.regs[0], registers, count * 2);
+					dma_packet.count_code = count | PKT_CODE_SUCCESS;
+				}
+			}
 		}
 
 		return;
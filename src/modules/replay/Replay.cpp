@@ -60,6 +60,7 @@
 #include <stdlib.h>
 #include <string>
 
+#include <logger/delta_encoding.h>
 #include <logger/messages.h>
 
 #include "Replay.hpp"
@@ -334,9 +335,10 @@ Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
 
 	// handle & validate the flags
 	bool contains_appended_data = incompat_flags[0] & ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK;
+	_has_delta_data = incompat_flags[0] & ULOG_INCOMPAT_FLAG0_DELTA_DATA_MASK;
 	bool has_unknown_incompat_bits = false;
 
-	if (incompat_flags[0] & ~0x1) {
+	if (incompat_flags[0] & ~(ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK | ULOG_INCOMPAT_FLAG0_DELTA_DATA_MASK)) {
 		has_unknown_incompat_bits = true;
 	}
 
@@ -529,6 +531,10 @@ Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 	subscription->multi_id = multi_id;
 	subscription->compat = compat;
 
+	if (_has_delta_data) {
+		subscription->delta_fields = orb_get_field_table(static_cast<ORB_ID>(orb_meta->o_id));
+	}
+
 	//find the timestamp offset
 	int field_size;
 	bool timestamp_found = findFieldOffset(orb_fields, "timestamp", subscription->timestamp_offset, field_size);
@@ -607,7 +613,7 @@ Replay::findFieldOffset(const string &format, const string &field_name, int &off
 }
 
 bool
-Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position)
+Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position, bool params_only)
 {
 	ulog_message_header_s message_header;
 
@@ -627,7 +633,13 @@ Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_
 			break;
 
 		case (int)ULogMessageType::DROPOUT:
-			readDropout(file, message_header.msg_size);
+			if (params_only) {
+				file.seekg(message_header.msg_size, ios::cur);
+
+			} else {
+				readDropout(file, message_header.msg_size);
+			}
+
 			break;
 
 		default: //skip all others
@@ -728,8 +740,21 @@ Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg
 				if (msg_id == file_msg_id) {
 					if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
 						subscription.next_read_pos = cur_pos;
-						file.seekg(subscription.timestamp_offset, ios::cur);
-						file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
+
+						if (subscription.delta_fields) {
+							// keep the data as reference for delta encoded messages
+							subscription.delta_data.resize(subscription.orb_meta->o_size_no_padding);
+							file.read((char *)subscription.delta_data.data(), subscription.delta_data.size());
+							subscription.delta_data_valid = file.good();
+							memcpy(&subscription.next_timestamp, subscription.delta_data.data() + subscription.timestamp_offset,
+							       sizeof(subscription.next_timestamp));
+
+						} else {
+							file.seekg(subscription.timestamp_offset, ios::cur);
+							file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
+						}
+
+						subscription.next_is_delta = false;
 						subscription.published = false;
 						done = true;
 
@@ -747,6 +772,38 @@ Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg
 
 			break;
 
+		case (int)ULogMessageType::DATA_DELTA:
+			file.read((char *)&file_msg_id, sizeof(file_msg_id));
+
+			if (file) {
+				const size_t encoded_size = message_header.msg_size - sizeof(file_msg_id);
+
+				if (msg_id == file_msg_id && subscription.delta_fields && subscription.delta_data_valid) {
+					_delta_read_buffer.resize(encoded_size);
+					file.read((char *)_delta_read_buffer.data(), encoded_size);
+
+					if (file && logger::delta_decode(*subscription.delta_fields, subscription.delta_data.size(),
+									 _delta_read_buffer.data(), encoded_size, subscription.delta_data.data())) {
+						subscription.next_read_pos = cur_pos;
+						memcpy(&subscription.next_timestamp, subscription.delta_data.data() + subscription.timestamp_offset,
+						       sizeof(subscription.next_timestamp));
+						subscription.next_is_delta = true;
+						subscription.published = false;
+						done = true;
+
+					} else if (file) {
+						PX4_ERR("invalid delta encoded message for %s. Skipping until the next keyframe",
+							subscription.orb_meta->o_name);
+						subscription.delta_data_valid = false;
+					}
+
+				} else { // not the one we are looking for, or no keyframe yet
+					file.seekg(encoded_size, ios::cur);
+				}
+			}
+
+			break;
+
 		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
 		case (int)ULogMessageType::ADD_LOGGED_MSG:
 		case (int)ULogMessageType::PARAMETER:
@@ -756,6 +813,9 @@ Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg
 		case (int)ULogMessageType::SYNC:
 		case (int)ULogMessageType::LOGGING:
 		case (int)ULogMessageType::PARAMETER_DEFAULT:
+		case (int)ULogMessageType::INDEX:
+		case (int)ULogMessageType::INDEX_TOPIC:
+		case (int)ULogMessageType::INDEX_FOOTER:
 			file.seekg(message_header.msg_size, ios::cur);
 			break;
 
@@ -776,6 +836,101 @@ Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg
 	return file.good();
 }
 
+std::streampos
+Replay::seekToTime(std::ifstream &file, uint64_t seek_time)
+{
+	streampos seek_pos = _data_section_start;
+	std::map<uint16_t, uint64_t> last_offsets; // from the topic index
+
+	// the index footer is the last message, unless there's appended data
+	file.clear();
+	file.seekg(0, ios::end);
+	streamoff end_pos = min((streamoff)file.tellg(), (streamoff)_read_until_file_position);
+	ulog_message_index_footer_s footer;
+	bool has_index = false;
+
+	if (end_pos >= (streamoff)sizeof(footer)) {
+		file.seekg(end_pos - (streamoff)sizeof(footer));
+		file.read((char *)&footer, sizeof(footer));
+		has_index = file && footer.msg_type == (uint8_t)ULogMessageType::INDEX_FOOTER &&
+			    footer.msg_size == sizeof(footer) - ULOG_MSG_HEADER_LEN &&
+			    memcmp(footer.magic, ULOG_INDEX_FOOTER_MAGIC, sizeof(footer.magic)) == 0;
+	}
+
+	if (has_index) {
+		// walk back the index messages until we're before the seek time
+		uint64_t offset = footer.index_offset;
+
+		while (offset > 0) {
+			ulog_message_index_s index;
+			file.seekg(offset);
+			file.read((char *)&index, sizeof(index));
+
+			if (!file || index.msg_type != (uint8_t)ULogMessageType::INDEX || index.offset != offset
+			    || index.prev_offset >= offset) {
+				PX4_ERR("invalid seek index at offset %" PRIu64, offset);
+				break;
+			}
+
+			if (index.timestamp <= seek_time) {
+				seek_pos = offset;
+				break;
+			}
+
+			offset = index.prev_offset;
+		}
+
+		file.seekg(footer.topic_index_offset);
+
+		for (int i = 0; i < footer.topic_index_count; ++i) {
+			ulog_message_index_topic_s topic_index;
+			file.read((char *)&topic_index, sizeof(topic_index));
+
+			if (!file || topic_index.msg_type != (uint8_t)ULogMessageType::INDEX_TOPIC) {
+				PX4_ERR("invalid topic index");
+				break;
+			}
+
+			last_offsets[topic_index.msg_id] = topic_index.last_offset;
+		}
+
+	} else {
+		PX4_WARN("Log has no seek index, parsing the file to seek");
+	}
+
+	file.clear();
+
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		Subscription *subscription = _subscriptions[i];
+
+		if (!subscription || !subscription->orb_meta) {
+			continue;
+		}
+
+		auto last_offset = last_offsets.find(i);
+
+		if (last_offset != last_offsets.end() && (streamoff)last_offset->second < (streamoff)seek_pos) {
+			// no more data of this topic after the seek position
+			subscription->orb_meta = nullptr;
+			continue;
+		}
+
+		if (subscription->next_read_pos < seek_pos) {
+			// the message at seek_pos (index or ADD_LOGGED_MSG) is skipped
+			subscription->next_read_pos = seek_pos;
+			subscription->delta_data_valid = false; // wait for the next keyframe
+			nextDataMessage(file, *subscription, i);
+		}
+
+		while (subscription->orb_meta && subscription->next_timestamp < seek_time) {
+			nextDataMessage(file, *subscription, i);
+		}
+	}
+
+	file.clear();
+	return seek_pos;
+}
+
 const orb_metadata *
 Replay::findTopic(const std::string &name)
 {
@@ -896,6 +1051,28 @@ Replay::run()
 		_speed_factor = atof(speedup);
 	}
 
+	const char *start_time = getenv(replay::ENV_START_TIME);
+	const char *end_time = getenv(replay::ENV_END_TIME);
+	const char *warmup = getenv(replay::ENV_WARMUP);
+	uint64_t start_offset = 0;
+
+	if (start_time) {
+		start_offset = (uint64_t)(fmax(atof(start_time), 0.) * 1e6);
+	}
+
+	// replay the warm-up period before the start time (so that e.g. the estimator has converged), but without delays
+	_seek_offset = start_offset;
+
+	if (warmup) {
+		_seek_offset -= min((uint64_t)(fmax(atof(warmup), 0.) * 1e6), start_offset);
+	}
+
+	_window_start = _file_start_time + start_offset;
+
+	if (end_time) {
+		_window_end = _file_start_time + (uint64_t)(fmax(atof(end_time), 0.) * 1e6);
+	}
+
 	onEnterMainLoop();
 
 	_replay_start_time = hrt_absolute_time();
@@ -928,9 +1105,24 @@ Replay::run()
 	replay_file.seekg(_data_section_start);
 	replay_file.clear();
 
+	streampos last_additional_message_pos = _data_section_start;
+
+	if (_seek_offset > 0) {
+		PX4_INFO("Seeking to %.3lf s", (double)_seek_offset / 1.e6);
+		last_additional_message_pos = seekToTime(replay_file, _file_start_time + _seek_offset);
+
+		// apply the parameter changes logged before the seek position
+		replay_file.seekg(_data_section_start);
+		readAndHandleAdditionalMessages(replay_file, last_additional_message_pos, true);
+		replay_file.clear();
+	}
+
+	if (_window_start > _file_start_time + _seek_offset) {
+		PX4_INFO("Warm-up until %.3lf s", (double)(_window_start - _file_start_time) / 1.e6);
+	}
+
 	const uint64_t timestamp_offset = getTimestampOffset();
 	uint32_t nr_published_messages = 0;
-	streampos last_additional_message_pos = _data_section_start;
 
 	while (!should_exit() && replay_file) {
 
@@ -960,6 +1152,11 @@ Replay::run()
 			break; //no active subscription anymore. We're done.
 		}
 
+		if (next_file_time > _window_end) {
+			PX4_INFO("Reached the end time %.3lf s", (double)(_window_end - _file_start_time) / 1.e6);
+			break;
+		}
+
 		Subscription &sub = *_subscriptions[next_msg_id];
 
 		if (next_file_time == 0 || next_file_time < _file_start_time) {
@@ -1044,6 +1241,12 @@ Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_fil
 	const size_t msg_read_size = sub.orb_meta->o_size_no_padding;
 	const size_t msg_write_size = sub.orb_meta->o_size;
 	_read_buffer.reserve(msg_write_size);
+
+	if (sub.next_is_delta) {
+		memcpy(_read_buffer.data(), sub.delta_data.data(), msg_read_size);
+		return;
+	}
+
 	replay_file.seekg(sub.next_read_pos + (streamoff)(ULOG_MSG_HEADER_LEN + 2)); //skip header & msg id
 	replay_file.read((char *)_read_buffer.data(), msg_read_size);
 }
@@ -1064,7 +1267,8 @@ Replay::handleTopicDelay(uint64_t next_file_time, uint64_t timestamp_offset)
 
 	// if some topics have a timestamp smaller than the log file start, publish them immediately
 	if (cur_time < publish_timestamp && next_file_time > _file_start_time) {
-		if (_speed_factor > FLT_EPSILON) {
+		// no delay during the warm-up before the start time
+		if (_speed_factor > FLT_EPSILON && next_file_time >= _window_start) {
 			// avoid many small usleep calls
 			_accumulated_delay += (publish_timestamp - cur_time) / _speed_factor;
 
@@ -1245,6 +1449,11 @@ the log file to be replayed. The second is the mode, specified via `replay_mode`
 - Generic otherwise: this can be used to replay any module(s), but the replay will be done with the same speed as the
   log was recorded.
 
+Optionally `replay_start` can be set to a time in seconds (relative to the log start) to start the replay from.
+This is fast for logs with a seek index (SDLOG_INDEX). The parameter changes logged before are applied.
+`replay_warmup` (in seconds) replays that much data before `replay_start` as fast as possible, so that the state
+(e.g. of the estimator) is converged at the start time. `replay_end` stops the replay at the given time in seconds.
+
 The module is typically used together with uORB publisher rules, to specify which messages should be replayed.
 The replay module will just publish all messages that are found in the log. It also applies the parameters from
 the log.
@@ -43,6 +43,7 @@
 #include "definitions.hpp"
 
 #include <px4_platform_common/module.h>
+#include <uORB/uORBFieldTable.hpp>
 #include <uORB/topics/uORBTopics.hpp>
 
 namespace px4
@@ -139,6 +140,12 @@ protected:
 
 		CompatBase *compat = nullptr;
 
+		// delta encoded data (ULogMessageType::DATA_DELTA)
+		const uORB::FieldTable *delta_fields = nullptr; ///< set if the log contains delta encoded data
+		std::vector<uint8_t> delta_data; ///< data of the last message, reference for the next delta
+		bool delta_data_valid = false;
+		bool next_is_delta = false; ///< if true, the data of the next message is in delta_data
+
 		// statistics
 		int approx_timestamp_counter = 0;
 		int publication_counter = 0;
@@ -211,11 +218,12 @@ protected:
 	{
 		//we update the timestamps from the file by a constant offset to match
 		//the current replay time
-		return _replay_start_time - _file_start_time;
+		return _replay_start_time - _file_start_time - _seek_offset;
 	}
 
 	std::vector<Subscription *> _subscriptions;
 	std::vector<uint8_t> _read_buffer;
+	std::vector<uint8_t> _delta_read_buffer;
 
 	float _speed_factor{1.f}; ///< from PX4_SIM_SPEED_FACTOR env variable (set to 0 to avoid usleep = unlimited rate)
 
@@ -249,6 +257,12 @@ private:
 
 	int64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
 
+	bool _has_delta_data{false}; ///< the log contains delta encoded data messages
+
+	uint64_t _seek_offset{0}; ///< replay start time relative to the log start [us] (replay_start minus replay_warmup)
+	uint64_t _window_start{0}; ///< absolute log time of replay_start, data before is replayed without delay [us]
+	uint64_t _window_end{UINT64_MAX}; ///< absolute log time at which the replay stops (from env variable replay_end) [us]
+
 	float _accumulated_delay{0.f};
 
 	bool readFileHeader(std::ifstream &file);
@@ -280,10 +294,22 @@ private:
 	 * We need to handle these separately, because they have no timestamp. We look at the file position instead.
 	 * @return false on file error
 	 */
-	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position);
+	/**
+	 * Apply parameter changes and report dropouts from the current file position up to end_position.
+	 * @param params_only only apply the parameter changes (e.g. when skipping over data after a seek)
+	 */
+	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position, bool params_only = false);
 	bool readDropout(std::ifstream &file, uint16_t msg_size);
 	bool readAndApplyParameter(std::ifstream &file, uint16_t msg_size);
 
+	/**
+	 * Move all subscriptions to the first message at or after a given time, using the seek index if the log has one.
+	 * Must be called after all subscriptions are added.
+	 * @param seek_time file time [us]
+	 * @return file position from where to continue reading additional messages
+	 */
+	std::streampos seekToTime(std::ifstream &file, uint64_t seek_time);
+
 	static const orb_metadata *findTopic(const std::string &name);
 
 	/** get the array size from a type. eg. float[3] -> return float */
@@ -40,6 +40,9 @@ namespace replay
 
 static const char __attribute__((unused)) *ENV_FILENAME = "replay"; ///< name for getenv()
 static const char __attribute__((unused)) *ENV_MODE = "replay_mode";  ///< name for getenv()
+static const char __attribute__((unused)) *ENV_START_TIME = "replay_start";  ///< name for getenv()
+static const char __attribute__((unused)) *ENV_END_TIME = "replay_end";  ///< name for getenv()
+static const char __attribute__((unused)) *ENV_WARMUP = "replay_warmup";  ///< name for getenv()
 
 
 } //namespace replay
@@ -44,7 +44,14 @@ RoverDifferential::RoverDifferential() :
 
 bool RoverDifferential::init()
 {
-	ScheduleOnInterval(10_ms); // 100 Hz
+	// run on local position updates, limited to 100 Hz
+	_vehicle_local_position_sub.set_interval_ms(10);
+
+	if (!_vehicle_local_position_sub.registerCallback()) {
+		PX4_ERR("callback registration failed");
+		return false;
+	}
+
 	return true;
 }
 
@@ -55,6 +62,19 @@ void RoverDifferential::updateParams()
 
 void RoverDifferential::Run()
 {
+	if (should_exit()) {
+		_vehicle_local_position_sub.unregisterCallback();
+		exit_and_cleanup();
+		return;
+	}
+
+	// backup schedule, so the vehicle is still stopped on disarm if the local position stops updating
+	ScheduleDelayed(100_ms);
+
+	// the controllers use their own subscriptions, this only triggers the cycle
+	vehicle_local_position_s vehicle_local_position;
+	_vehicle_local_position_sub.update(&vehicle_local_position);
+
 	if (_parameter_update_sub.updated()) {
 		parameter_update_s param_update{};
 		_parameter_update_sub.copy(&param_update);
@@ -75,6 +75,43 @@ public:
 		}
 	}
 
+	/**
+	 * Put a block of items into the integral.
+	 *
+	 * @param val		Items to put.
+	 * @param dt		Time intervals of the items.
+	 * @param N		Number of items.
+	 */
+	inline void put(const matrix::Vector3f val[], const float dt[], int N)
+	{
+		// integrator state is kept in locals for the whole block
+		matrix::Vector3f alpha{_alpha};
+		matrix::Vector3f last_val{_last_val};
+		float integral_dt = _integral_dt;
+		uint8_t integrated_samples = _integrated_samples;
+
+		for (int n = 0; n < N; n++) {
+			if ((dt[n] > DT_MIN) && (integral_dt + dt[n] < DT_MAX)) {
+				// trapezoidal integration
+				alpha += (val[n] + last_val) * dt[n] * 0.5f;
+				integral_dt += dt[n];
+				integrated_samples++;
+
+			} else {
+				alpha.zero();
+				integral_dt = 0;
+				integrated_samples = 0;
+			}
+
+			last_val = val[n];
+		}
+
+		_alpha = alpha;
+		_last_val = last_val;
+		_integral_dt = integral_dt;
+		_integrated_samples = integrated_samples;
+	}
+
 	/**
 	 * Set reset interval during runtime. This won't reset the integrator.
 	 *
@@ -97,6 +134,18 @@ public:
 	 */
 	inline bool integral_ready() const { return (_integrated_samples >= _reset_samples_min) || (_integral_dt >= _reset_interval_min); }
 
+	/**
+	 * Will the Integrator be ready to reset after integrating additional samples?
+	 *
+	 * @param samples	Number of additional samples.
+	 * @param dt		Additional integration time.
+	 * @return		true if integrator has sufficient data (minimum interval & samples satisfied) to reset.
+	 */
+	inline bool integral_ready(int samples, float dt) const
+	{
+		return (_integrated_samples + samples >= _reset_samples_min) || (_integral_dt + dt >= _reset_interval_min);
+	}
+
 	float integral_dt() const { return _integral_dt; }
 
 	void reset()
@@ -186,6 +235,58 @@ public:
 		}
 	}
 
+	/**
+	 * Put a block of items into the integral.
+	 *
+	 * @param val		Items to put.
+	 * @param dt		Time intervals of the items.
+	 * @param N		Number of items.
+	 */
+	inline void put(const matrix::Vector3f val[], const float dt[], int N)
+	{
+		// integrator and coning state is kept in locals for the whole block
+		matrix::Vector3f alpha{_alpha};
+		matrix::Vector3f beta{_beta};
+		matrix::Vector3f last_alpha{_last_alpha};
+		matrix::Vector3f last_delta_alpha{_last_delta_alpha};
+		matrix::Vector3f last_val{_last_val};
+		float integral_dt = _integral_dt;
+		uint8_t integrated_samples = _integrated_samples;
+
+		for (int n = 0; n < N; n++) {
+			if ((dt[n] > DT_MIN) && (integral_dt + dt[n] < DT_MAX)) {
+				// trapezoidal integration
+				const matrix::Vector3f delta_alpha{(val[n] + last_val) * dt[n] * 0.5f};
+				integral_dt += dt[n];
+				integrated_samples++;
+
+				// coning corrections (see put())
+				beta += ((last_alpha + last_delta_alpha * (1.f / 6.f)) % delta_alpha) * 0.5f;
+				last_delta_alpha = delta_alpha;
+				last_alpha = alpha;
+
+				alpha += delta_alpha;
+
+			} else {
+				alpha.zero();
+				beta.zero();
+				last_alpha.zero();
+				integral_dt = 0;
+				integrated_samples = 0;
+			}
+
+			last_val = val[n];
+		}
+
+		_alpha = alpha;
+		_beta = beta;
+		_last_alpha = last_alpha;
+		_last_delta_alpha = last_delta_alpha;
+		_last_val = last_val;
+		_integral_dt = integral_dt;
+		_integrated_samples = integrated_samples;
+	}
+
 	void reset()
 	{
 		Integrator::reset();
@@ -92,6 +92,7 @@ DataValidator *DataValidatorGroup::add_new_validator()
 	_last->setSibling(validator);
 	_last = validator;
 	_last->set_timeout(_timeout_interval_us);
+	_fast_path_valid = false;
 	return _last;
 }
 
@@ -128,6 +129,11 @@ void DataValidatorGroup::put(unsigned index, uint64_t timestamp, const float val
 
 	while (next != nullptr) {
 		if (i == index) {
+			if (next->priority() != priority) {
+				// a priority change can change the selection
+				_fast_path_valid = false;
+			}
+
 			next->put(timestamp, val, error_count, priority);
 			break;
 		}
@@ -139,6 +145,18 @@ void DataValidatorGroup::put(unsigned index, uint64_t timestamp, const float val
 
 float *DataValidatorGroup::get_best(uint64_t timestamp, int *index)
 {
+	// Fast path: the current best sensor has full confidence and no other sensor has a higher priority,
+	// so none of the others can replace it. The full scan still runs periodically to keep the state of
+	// all sensors up to date (e.g. timeouts).
+	if (_fast_path_valid && (_curr_best >= 0)
+	    && (timestamp >= _last_full_scan) && (timestamp < _last_full_scan + FULL_SCAN_INTERVAL_US)
+	    && (_best->confidence(timestamp) >= 1.f)) {
+
+		*index = _curr_best;
+		return _best->value();
+	}
+
+	_last_full_scan = timestamp;
 
 	DataValidator *next = _first;
 
@@ -149,6 +167,7 @@ float *DataValidatorGroup::get_best(uint64_t timestamp, int *index)
 	float max_confidence = -1.0f;
 	int max_priority = -1000;
 	int max_index = -1;
+	int highest_priority = -1;
 	DataValidator *best = nullptr;
 
 	int i = 0;
@@ -179,6 +198,10 @@ float *DataValidatorGroup::get_best(uint64_t timestamp, int *index)
 	while (next != nullptr) {
 		float confidence = next->confidence(timestamp);
 
+		if (next->priority() > highest_priority) {
+			highest_priority = next->priority();
+		}
+
 		/*
 		 * Switch if:
 		 * 1) the confidence is higher and priority is equal or higher
@@ -241,6 +264,9 @@ float *DataValidatorGroup::get_best(uint64_t timestamp, int *index)
 		_curr_best = max_index;
 	}
 
+	_best = (_curr_best >= 0) ? best : nullptr;
+	_fast_path_valid = (_best != nullptr) && (_best->priority() >= highest_priority);
+
 	*index = max_index;
 	return (best) ? best->value() : nullptr;
 }
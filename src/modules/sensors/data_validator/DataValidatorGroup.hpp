@@ -140,11 +140,16 @@ private:
 	int _curr_best{-1}; /**< currently best index */
 	int _prev_best{-1}; /**< the previous best index */
 
+	DataValidator *_best{nullptr}; /**< currently best validator */
+	bool _fast_path_valid{false}; /**< the current best can only be replaced if its own confidence drops */
+	uint64_t _last_full_scan{0}; /**< timestamp of the last evaluation of all validators */
+
 	uint64_t _first_failover_time{0}; /**< timestamp where the first failover occured or zero if none occured */
 
 	unsigned _toggle_count{0}; /**< number of back and forth switches between two sensors */
 
 	static constexpr float MIN_REGULAR_CONFIDENCE = 0.9f;
+	static constexpr uint64_t FULL_SCAN_INTERVAL_US = 20000; /**< maximum interval between evaluations of all validators */
 
 	/* we don't want this class to be copied */
 	DataValidatorGroup(const DataValidatorGroup &);
@@ -330,6 +330,47 @@ void test_simple_failover()
 	delete  group; //cleanup
 }
 
+/**
+ * Verify that a timeout of the best sensor is detected while the other sensors are not re-evaluated
+ */
+void test_best_timeout()
+{
+	unsigned num_siblings = 0;
+	DataValidator *validator1 = nullptr;
+	DataValidator *validator2 = nullptr;
+
+	uint64_t timestamp = base_timestamp;
+
+	DataValidatorGroup *group = setup_group_with_two_validator_handles(&validator1, &validator2, &num_siblings);
+	int val1_idx = (int)num_siblings - 2;
+	int val2_idx = (int)num_siblings - 1;
+
+	fill_two_with_valid_data(group, val1_idx, val2_idx, 100);
+
+	int best_idx = -1;
+	float *best_data = nullptr;
+
+	//only the second sensor continues to publish, the best sensor is kept until it times out
+	float new_best_val = 3.14159f;
+	float data[DataValidator::dimensions] = {new_best_val};
+
+	for (int i = 0; i < 10; i++) {
+		timestamp += base_timeout_usec / 4;
+		group->put(val2_idx, timestamp, data, 0, 10);
+		group->get_best(timestamp, &best_idx);
+	}
+
+	best_data = group->get_best(timestamp, &best_idx);
+	assert(nullptr != best_data);
+	assert(new_best_val == best_data[0]);
+	assert(best_idx == val2_idx);
+	//should have detected a real failover
+	assert(1 == group->failover_count());
+	assert(DataValidator::ERROR_FLAG_TIMEOUT == (DataValidator::ERROR_FLAG_TIMEOUT & validator1->state()));
+
+	delete  group; //cleanup
+}
+
 /**
  * Force once sensor to fail and ensure that we detect it
  */
@@ -379,6 +420,7 @@ int main(int argc, char *argv[])
 	test_put();
 	test_simple_failover();
 	test_priority_switch();
+	test_best_timeout();
 	test_sensor_failure();
 
 	return 0; //passed
@@ -168,6 +168,9 @@ void VehicleAirData::Run()
 		}
 
 		if (_advertised[uorb_index]) {
+			// thermal corrections change slowly, check once per cycle rather than per sample
+			_calibration[uorb_index].SensorCorrectionsUpdate();
+
 			int sensor_sub_updates = 0;
 			sensor_baro_s report;
 
@@ -208,7 +211,6 @@ void VehicleAirData::Run()
 					}
 
 					// pressure corrected with offset (if available)
-					_calibration[uorb_index].SensorCorrectionsUpdate();
 					const float pressure_corrected = _calibration[uorb_index].Correct(report.pressure);
 					const float pressure_sealevel_pa = _param_sens_baro_qnh.get() * 100.f;
 
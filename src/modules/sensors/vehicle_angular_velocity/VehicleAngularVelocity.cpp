@@ -47,6 +47,9 @@ VehicleAngularVelocity::VehicleAngularVelocity() :
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl)
 {
 	_vehicle_angular_velocity_pub.advertise();
+
+	// advertised upfront so that the (optional) high rate logging subscription can be detected
+	_vehicle_angular_velocity_compact_pub.advertise();
 }
 
 VehicleAngularVelocity::~VehicleAngularVelocity()
@@ -722,8 +725,10 @@ void VehicleAngularVelocity::UpdateDynamicNotchFFT(const hrt_abstime &time_now_u
 #endif // !CONSTRAINED_FLASH
 }
 
-float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int N)
+Vector3f VehicleAngularVelocity::FilterAngularVelocity(float *const data[3], int N)
 {
+	// each filter stage runs over the whole block of all three axes, so the enable checks are done once per block
+	// and the filter state stays in registers within NotchFilter/LowPassFilter2p::applyArray()
 #if !defined(CONSTRAINED_FLASH)
 
 	// Apply dynamic notch filter from ESC RPM
@@ -731,8 +736,10 @@ float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int
 		for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
 			if (_esc_available[esc]) {
 				for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
-					if (_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].getNotchFreq() > 0.f) {
-						_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].applyArray(data, N);
+					for (int axis = 0; axis < 3; axis++) {
+						if (_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].getNotchFreq() > 0.f) {
+							_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].applyArray(data[axis], N);
+						}
 					}
 				}
 			}
@@ -742,40 +749,50 @@ float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int
 	// Apply dynamic notch filter from FFT
 	if (_dynamic_notch_fft_available) {
 		for (int peak = MAX_NUM_FFT_PEAKS - 1; peak >= 0; peak--) {
-			if (_dynamic_notch_filter_fft[axis][peak].getNotchFreq() > 0.f) {
-				_dynamic_notch_filter_fft[axis][peak].applyArray(data, N);
+			for (int axis = 0; axis < 3; axis++) {
+				if (_dynamic_notch_filter_fft[axis][peak].getNotchFreq() > 0.f) {
+					_dynamic_notch_filter_fft[axis][peak].applyArray(data[axis], N);
+				}
 			}
 		}
 	}
 
 #endif // !CONSTRAINED_FLASH
 
-	// Apply general notch filter 0 (IMU_GYRO_NF0_FRQ)
-	if (_notch_filter0_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter0_velocity[axis].applyArray(data, N);
-	}
+	for (int axis = 0; axis < 3; axis++) {
+		// Apply general notch filter 0 (IMU_GYRO_NF0_FRQ)
+		if (_notch_filter0_velocity[axis].getNotchFreq() > 0.f) {
+			_notch_filter0_velocity[axis].applyArray(data[axis], N);
+		}
 
-	// Apply general notch filter 1 (IMU_GYRO_NF1_FRQ)
-	if (_notch_filter1_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter1_velocity[axis].applyArray(data, N);
-	}
+		// Apply general notch filter 1 (IMU_GYRO_NF1_FRQ)
+		if (_notch_filter1_velocity[axis].getNotchFreq() > 0.f) {
+			_notch_filter1_velocity[axis].applyArray(data[axis], N);
+		}
 
-	// Apply general low-pass filter (IMU_GYRO_CUTOFF)
-	_lp_filter_velocity[axis].applyArray(data, N);
+		// Apply general low-pass filter (IMU_GYRO_CUTOFF)
+		_lp_filter_velocity[axis].applyArray(data[axis], N);
+	}
 
 	// return last filtered sample
-	return data[N - 1];
+	return Vector3f{data[0][N - 1], data[1][N - 1], data[2][N - 1]};
 }
 
-float VehicleAngularVelocity::FilterAngularAcceleration(int axis, float inverse_dt_s, float data[], int N)
+Vector3f VehicleAngularVelocity::FilterAngularAcceleration(float inverse_dt_s, const float *const data[3], int N)
 {
 	// angular acceleration: Differentiate & apply specific angular acceleration (D-term) low-pass (IMU_DGYRO_CUTOFF)
-	float angular_acceleration_filtered = 0.f;
+	Vector3f angular_acceleration_filtered;
+
+	for (int axis = 0; axis < 3; axis++) {
+		float angular_velocity_prev = _angular_velocity_raw_prev(axis);
+
+		for (int n = 0; n < N; n++) {
+			const float angular_acceleration = (data[axis][n] - angular_velocity_prev) * inverse_dt_s;
+			angular_acceleration_filtered(axis) = _lp_filter_acceleration[axis].update(angular_acceleration);
+			angular_velocity_prev = data[axis][n];
+		}
 
-	for (int n = 0; n < N; n++) {
-		const float angular_acceleration = (data[n] - _angular_velocity_raw_prev(axis)) * inverse_dt_s;
-		angular_acceleration_filtered = _lp_filter_acceleration[axis].update(angular_acceleration);
-		_angular_velocity_raw_prev(axis) = data[n];
+		_angular_velocity_raw_prev(axis) = angular_velocity_prev;
 	}
 
 	return angular_acceleration_filtered;
@@ -836,21 +853,23 @@ void VehicleAngularVelocity::Run()
 				Vector3f angular_velocity_uncalibrated;
 				Vector3f angular_acceleration_uncalibrated;
 
-				int16_t *raw_data_array[] {sensor_fifo_data.x, sensor_fifo_data.y, sensor_fifo_data.z};
+				// copy raw int16 sensor samples to float arrays for filtering
+				const int16_t *raw_data_array[] {sensor_fifo_data.x, sensor_fifo_data.y, sensor_fifo_data.z};
+				float data_x[FIFO_SIZE_MAX];
+				float data_y[FIFO_SIZE_MAX];
+				float data_z[FIFO_SIZE_MAX];
+				float *const data[3] {data_x, data_y, data_z};
 
 				for (int axis = 0; axis < 3; axis++) {
-					// copy raw int16 sensor samples to float array for filtering
-					float data[FIFO_SIZE_MAX];
-
 					for (int n = 0; n < N; n++) {
-						data[n] = sensor_fifo_data.scale * raw_data_array[axis][n];
+						data[axis][n] = sensor_fifo_data.scale * raw_data_array[axis][n];
 					}
-
-					// save last filtered sample
-					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data, N);
-					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data, N);
 				}
 
+				// save last filtered sample
+				angular_velocity_uncalibrated = FilterAngularVelocity(data, N);
+				angular_acceleration_uncalibrated = FilterAngularAcceleration(inverse_dt_s, data, N);
+
 				// Publish
 				if (!_sensor_gyro_fifo_sub.updated()) {
 					if (CalibrateAndPublish(sensor_fifo_data.timestamp_sample,
@@ -885,16 +904,15 @@ void VehicleAngularVelocity::Run()
 				Vector3f angular_velocity_uncalibrated;
 				Vector3f angular_acceleration_uncalibrated;
 
-				float raw_data_array[] {sensor_data.x, sensor_data.y, sensor_data.z};
+				// copy sensor sample to float arrays for filtering
+				float data_x[1] {sensor_data.x};
+				float data_y[1] {sensor_data.y};
+				float data_z[1] {sensor_data.z};
+				float *const data[3] {data_x, data_y, data_z};
 
-				for (int axis = 0; axis < 3; axis++) {
-					// copy sensor sample to float array for filtering
-					float data[1] {raw_data_array[axis]};
-
-					// save last filtered sample
-					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data);
-					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data);
-				}
+				// save last filtered sample
+				angular_velocity_uncalibrated = FilterAngularVelocity(data);
+				angular_acceleration_uncalibrated = FilterAngularAcceleration(inverse_dt_s, data);
 
 				// Publish
 				if (!_sensor_sub.updated()) {
@@ -939,6 +957,10 @@ bool VehicleAngularVelocity::CalibrateAndPublish(const hrt_abstime &timestamp_sa
 		angular_velocity.timestamp = hrt_absolute_time();
 		_vehicle_angular_velocity_pub.publish(angular_velocity);
 
+		if (_vehicle_angular_velocity_compact_pub.has_subscribers()) {
+			PublishCompact(angular_velocity);
+		}
+
 		// shift last publish time forward, but don't let it get further behind than the interval
 		_last_publish = math::constrain(_last_publish + _publish_interval_min_us,
 						timestamp_sample - _publish_interval_min_us, timestamp_sample);
@@ -949,6 +971,31 @@ bool VehicleAngularVelocity::CalibrateAndPublish(const hrt_abstime &timestamp_sa
 	return false;
 }
 
+static int16_t to_fixed_point(float value, float scale)
+{
+	if (!PX4_ISFINITE(value)) {
+		return 0;
+	}
+
+	return static_cast<int16_t>(math::constrain(roundf(value / scale), (float)INT16_MIN, (float)INT16_MAX));
+}
+
+void VehicleAngularVelocity::PublishCompact(const vehicle_angular_velocity_s &angular_velocity)
+{
+	vehicle_angular_velocity_compact_s compact;
+	compact.timestamp = angular_velocity.timestamp;
+	compact.timestamp_sample_age = math::min(angular_velocity.timestamp - angular_velocity.timestamp_sample,
+				       (hrt_abstime)UINT16_MAX);
+
+	for (int axis = 0; axis < 3; axis++) {
+		compact.xyz[axis] = to_fixed_point(angular_velocity.xyz[axis], vehicle_angular_velocity_compact_s::XYZ_SCALE);
+		compact.xyz_derivative[axis] = to_fixed_point(angular_velocity.xyz_derivative[axis],
+					       vehicle_angular_velocity_compact_s::XYZ_DERIVATIVE_SCALE);
+	}
+
+	_vehicle_angular_velocity_compact_pub.publish(compact);
+}
+
 void VehicleAngularVelocity::PrintStatus()
 {
 	PX4_INFO_RAW("[vehicle_angular_velocity] selected sensor: %" PRIu32
@@ -56,6 +56,7 @@
 #include <uORB/topics/sensor_gyro_fifo.h>
 #include <uORB/topics/sensor_selection.h>
 #include <uORB/topics/vehicle_angular_velocity.h>
+#include <uORB/topics/vehicle_angular_velocity_compact.h>
 
 using namespace time_literals;
 
@@ -78,8 +79,11 @@ private:
 	bool CalibrateAndPublish(const hrt_abstime &timestamp_sample, const matrix::Vector3f &angular_velocity_uncalibrated,
 				 const matrix::Vector3f &angular_acceleration_uncalibrated);
 
-	inline float FilterAngularVelocity(int axis, float data[], int N = 1);
-	inline float FilterAngularAcceleration(int axis, float inverse_dt_s, float data[], int N = 1);
+	void PublishCompact(const vehicle_angular_velocity_s &angular_velocity);
+
+	// filter a block of N samples of all three axes in place (data[axis][n]), returns the last filtered sample
+	inline matrix::Vector3f FilterAngularVelocity(float *const data[3], int N = 1);
+	inline matrix::Vector3f FilterAngularAcceleration(float inverse_dt_s, const float *const data[3], int N = 1);
 
 	void DisableDynamicNotchEscRpm();
 	void DisableDynamicNotchFFT();
@@ -99,6 +103,7 @@ private:
 	static constexpr int MAX_SENSOR_COUNT = 4;
 
 	uORB::Publication<vehicle_angular_velocity_s>     _vehicle_angular_velocity_pub{ORB_ID(vehicle_angular_velocity)};
+	uORB::Publication<vehicle_angular_velocity_compact_s> _vehicle_angular_velocity_compact_pub{ORB_ID(vehicle_angular_velocity_compact)};
 
 	uORB::Subscription _estimator_selector_status_sub{ORB_ID(estimator_selector_status)};
 	uORB::Subscription _estimator_sensor_bias_sub{ORB_ID(estimator_sensor_bias)};
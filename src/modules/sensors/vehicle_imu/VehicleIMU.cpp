@@ -219,7 +219,7 @@ void VehicleIMU::Run()
 
 		// update gyro until integrator ready and not falling behind
 		if (!_gyro_integrator.integral_ready() || consume_all_gyro) {
-			if (UpdateGyro()) {
+			if (UpdateGyro(consume_all_gyro)) {
 				updated = true;
 			}
 		}
@@ -407,14 +407,19 @@ bool VehicleIMU::UpdateAccel()
 	return updated;
 }
 
-bool VehicleIMU::UpdateGyro()
+bool VehicleIMU::UpdateGyro(bool consume_all)
 {
 	bool updated = false;
 
-	// integrate queued gyro
+	// integrate queued gyro, samples are collected and integrated as one block
+	Vector3f gyro_samples[sensor_gyro_s::ORB_QUEUE_LENGTH];
+	float gyro_samples_dt[sensor_gyro_s::ORB_QUEUE_LENGTH];
+	float gyro_samples_dt_sum = 0.f;
+	int gyro_samples_count = 0;
+
 	sensor_gyro_s gyro;
 
-	if (_sensor_gyro_sub.update(&gyro)) {
+	while ((gyro_samples_count < sensor_gyro_s::ORB_QUEUE_LENGTH) && _sensor_gyro_sub.update(&gyro)) {
 		if (_sensor_gyro_sub.get_last_generation() != _gyro_last_generation + 1) {
 			_data_gap = true;
 			perf_count(_gyro_generation_gap_perf);
@@ -482,7 +487,11 @@ bool VehicleIMU::UpdateGyro()
 
 		const Vector3f gyro_raw{gyro.x, gyro.y, gyro.z};
 		_raw_gyro_mean.update(gyro_raw);
-		_gyro_integrator.put(gyro_raw, dt);
+
+		gyro_samples[gyro_samples_count] = gyro_raw;
+		gyro_samples_dt[gyro_samples_count] = dt;
+		gyro_samples_dt_sum += dt;
+		gyro_samples_count++;
 
 		updated = true;
 
@@ -531,8 +540,15 @@ bool VehicleIMU::UpdateGyro()
 				}
 			}
 		}
+
+		// stop once the integrator is ready unless catching up
+		if (!consume_all && _gyro_integrator.integral_ready(gyro_samples_count, gyro_samples_dt_sum)) {
+			break;
+		}
 	}
 
+	_gyro_integrator.put(gyro_samples, gyro_samples_dt, gyro_samples_count);
+
 	return updated;
 }
 
@@ -82,7 +82,7 @@ private:
 	void Run() override;
 
 	bool UpdateAccel();
-	bool UpdateGyro();
+	bool UpdateGyro(bool consume_all);
 
 	void UpdateIntegratorConfiguration();
 
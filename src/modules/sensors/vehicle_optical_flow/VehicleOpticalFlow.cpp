@@ -140,10 +140,17 @@ void VehicleOpticalFlow::Run()
 				_delta_angle += _flow_rotation * delta_angle;
 			}
 
-			_delta_angle_available = true;
+			if (!_delta_angle_available) {
+				// gyro isn't needed while the flow sensor provides its own delta angle, stop running for every gyro update
+				_sensor_gyro_sub.unregisterCallback();
+				_delta_angle_available = true;
+			}
 
 		} else {
-			_delta_angle_available = false;
+			if (_delta_angle_available) {
+				_sensor_gyro_sub.registerCallback();
+				_delta_angle_available = false;
+			}
 
 			// integrate synchronized gyro
 			gyroSample gyro_sample;
@@ -335,6 +335,12 @@ void GZBridge::clockCallback(const gz::msgs::Clock &msg)
 	ts.tv_sec = msg.sim().sec();
 	ts.tv_nsec = msg.sim().nsec();
 
+	{
+		// publish what is left of the previous step before the time advances
+		std::lock_guard<std::mutex> lock(_pending_mutex);
+		publishPendingSensors();
+	}
+
 	if (!_realtime_clock_set) {
 		// Set initial real time clock at startup
 		px4_clock_settime(CLOCK_REALTIME, &ts);
@@ -403,7 +409,9 @@ void GZBridge::magnetometerCallback(const gz::msgs::Magnetometer &msg)
 	report.y = -msg.field_tesla().x();
 	report.z = msg.field_tesla().z();
 
-	_sensor_mag_pub.publish(report);
+	std::lock_guard<std::mutex> lock(_pending_mutex);
+	_pending_mag = report;
+	_pending_sensors |= PENDING_MAG;
 }
 
 void GZBridge::airPressureCallback(const gz::msgs::FluidPressure &msg)
@@ -422,7 +430,10 @@ void GZBridge::airPressureCallback(const gz::msgs::FluidPressure &msg)
 	report.device_id = id.devid;
 	report.pressure = msg.pressure();
 	report.temperature = this->_temperature;
-	_sensor_baro_pub.publish(report);
+
+	std::lock_guard<std::mutex> lock(_pending_mutex);
+	_pending_baro = report;
+	_pending_sensors |= PENDING_BARO;
 }
 
 void GZBridge::airspeedCallback(const gz::msgs::AirSpeed &msg)
@@ -441,59 +452,70 @@ void GZBridge::airspeedCallback(const gz::msgs::AirSpeed &msg)
 	report.device_id = id.devid;
 	report.differential_pressure_pa = msg.diff_pressure(); // hPa to Pa;
 	report.temperature = static_cast<float>(msg.temperature()) + atmosphere::kAbsoluteNullCelsius; // K to C
-	_differential_pressure_pub.publish(report);
 
 	this->_temperature = report.temperature;
+
+	std::lock_guard<std::mutex> lock(_pending_mutex);
+	_pending_differential_pressure = report;
+	_pending_sensors |= PENDING_DIFFERENTIAL_PRESSURE;
 }
 
 void GZBridge::imuCallback(const gz::msgs::IMU &msg)
 {
 	const uint64_t timestamp = hrt_absolute_time();
 
-	// FLU -> FRD
-	static const auto q_FLU_to_FRD = gz::math::Quaterniond(0, 1, 0, 0);
-
-	gz::math::Vector3d accel_b = q_FLU_to_FRD.RotateVector(gz::math::Vector3d(
-					     msg.linear_acceleration().x(),
-					     msg.linear_acceleration().y(),
-					     msg.linear_acceleration().z()));
-
 	device::Device::DeviceId id{};
 	id.devid_s.bus_type = device::Device::DeviceBusType::DeviceBusType_SIMULATION;
 	id.devid_s.devtype = DRV_IMU_DEVTYPE_SIM;
 	id.devid_s.bus = 1;
 	id.devid_s.address = 1;
 
-	// publish accel
-	sensor_accel_s accel{};
+	// FLU -> FRD (rotation by 180 deg around x), applied directly on the message fields
+	const gz::msgs::Vector3d &linear_acceleration = msg.linear_acceleration();
+	const gz::msgs::Vector3d &angular_velocity = msg.angular_velocity();
 
+	sensor_accel_s accel{};
 	accel.timestamp_sample = timestamp;
 	accel.timestamp = timestamp;
 	accel.device_id = id.devid;
-
-	accel.x = accel_b.X();
-	accel.y = accel_b.Y();
-	accel.z = accel_b.Z();
+	accel.x = linear_acceleration.x();
+	accel.y = -linear_acceleration.y();
+	accel.z = -linear_acceleration.z();
 	accel.temperature = NAN;
 	accel.samples = 1;
-	_sensor_accel_pub.publish(accel);
-
-	gz::math::Vector3d gyro_b = q_FLU_to_FRD.RotateVector(gz::math::Vector3d(
-					    msg.angular_velocity().x(),
-					    msg.angular_velocity().y(),
-					    msg.angular_velocity().z()));
 
-	// publish gyro
 	sensor_gyro_s gyro{};
 	gyro.timestamp_sample = timestamp;
 	gyro.timestamp = timestamp;
 	gyro.device_id = id.devid;
-	gyro.x = gyro_b.X();
-	gyro.y = gyro_b.Y();
-	gyro.z = gyro_b.Z();
+	gyro.x = angular_velocity.x();
+	gyro.y = -angular_velocity.y();
+	gyro.z = -angular_velocity.z();
 	gyro.temperature = NAN;
 	gyro.samples = 1;
+
+	// publish the IMU together with the other sensors of this step
+	std::lock_guard<std::mutex> lock(_pending_mutex);
+	_sensor_accel_pub.publish(accel);
 	_sensor_gyro_pub.publish(gyro);
+	publishPendingSensors();
+}
+
+void GZBridge::publishPendingSensors()
+{
+	if (_pending_sensors & PENDING_MAG) {
+		_sensor_mag_pub.publish(_pending_mag);
+	}
+
+	if (_pending_sensors & PENDING_BARO) {
+		_sensor_baro_pub.publish(_pending_baro);
+	}
+
+	if (_pending_sensors & PENDING_DIFFERENTIAL_PRESSURE) {
+		_differential_pressure_pub.publish(_pending_differential_pressure);
+	}
+
+	_pending_sensors = 0;
 }
 
 void GZBridge::poseInfoCallback(const gz::msgs::Pose_V &msg)
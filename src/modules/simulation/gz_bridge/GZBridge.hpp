@@ -67,6 +67,8 @@
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/vehicle_odometry.h>
 
+#include <mutex>
+
 #include <gz/math.hh>
 #include <gz/msgs.hh>
 #include <gz/transport.hh>
@@ -132,6 +134,12 @@ private:
 	void opticalFlowCallback(const px4::msgs::OpticalFlow &msg);
 	void magnetometerCallback(const gz::msgs::Magnetometer &msg);
 
+	/**
+	 * Publish the slow sensors (mag, baro, airspeed) received since the last IMU message,
+	 * so that all sensor data of a simulation step is published together. Requires _pending_mutex.
+	 */
+	void publishPendingSensors();
+
 	static void rotateQuaternion(gz::math::Quaterniond &q_FRD_to_NED, const gz::math::Quaterniond q_FLU_to_ENU);
 
 	static float generate_wgn();
@@ -143,7 +151,7 @@ private:
 
 	uORB::Publication<distance_sensor_s>          _distance_sensor_pub{ORB_ID(distance_sensor)};
 	uORB::Publication<differential_pressure_s>    _differential_pressure_pub{ORB_ID(differential_pressure)};
-	uORB::Publication<obstacle_distance_s>        _obstacle_distance_pub{ORB_ID(obstacle_distance)};
+	uORB::PublicationMulti<obstacle_distance_s>   _obstacle_distance_pub{ORB_ID(obstacle_distance)};
 	uORB::Publication<vehicle_angular_velocity_s> _angular_velocity_ground_truth_pub{ORB_ID(vehicle_angular_velocity_groundtruth)};
 	uORB::Publication<vehicle_attitude_s>         _attitude_ground_truth_pub{ORB_ID(vehicle_attitude_groundtruth)};
 	uORB::Publication<vehicle_global_position_s>  _gpos_ground_truth_pub{ORB_ID(vehicle_global_position_groundtruth)};
@@ -177,6 +185,20 @@ private:
 	float _temperature{288.15};  // 15 degrees
 
 	bool _realtime_clock_set{false};
+
+	// sensor data of the current simulation step, published with the IMU or before the clock advances
+	enum PendingSensor : uint8_t {
+		PENDING_MAG = 1 << 0,
+		PENDING_BARO = 1 << 1,
+		PENDING_DIFFERENTIAL_PRESSURE = 1 << 2,
+	};
+
+	std::mutex _pending_mutex;
+	uint8_t _pending_sensors{0};
+	sensor_mag_s _pending_mag{};
+	sensor_baro_s _pending_baro{};
+	differential_pressure_s _pending_differential_pressure{};
+
 	gz::transport::Node _node;
 
 	// GPS noise model
@@ -113,9 +113,11 @@ void SensorMagSim::Run()
 			if (gpos.eph < 1000) {
 
 				// magnetic field data returned by the geo library using the current GPS position
-				const float declination_rad = math::radians(get_mag_declination_degrees(gpos.lat, gpos.lon));
-				const float inclination_rad = math::radians(get_mag_inclination_degrees(gpos.lat, gpos.lon));
-				const float field_strength_gauss = get_mag_strength_gauss(gpos.lat, gpos.lon);
+				float declination_deg, inclination_deg, field_strength_gauss;
+				get_mag_field(gpos.lat, gpos.lon, declination_deg, inclination_deg, field_strength_gauss);
+
+				const float declination_rad = math::radians(declination_deg);
+				const float inclination_rad = math::radians(inclination_deg);
 
 				_mag_earth_pred = Dcmf(Eulerf(0, -inclination_rad, declination_rad)) * Vector3f(field_strength_gauss, 0, 0);
 
@@ -544,7 +544,8 @@ void SimulatorMavlink::handle_message_hil_sensor(const mavlink_message_t *msg)
 
 #endif
 
-		px4_lockstep_progress(_lockstep_component);
+		// reported once the whole received batch is handled (see run())
+		_lockstep_progress_pending = true;
 	}
 }
 
@@ -1231,7 +1232,9 @@ void SimulatorMavlink::run()
 
 			int len = ::recvfrom(_fd, _buf, sizeof(_buf), 0, (struct sockaddr *)&_srcaddr, (socklen_t *)&_addrlen);
 
-			if (len > 0) {
+			// Drain everything already queued on the socket without going through poll() again,
+			// so that all sensor instances of a step are published before lockstep progresses.
+			while (len > 0) {
 				mavlink_message_t msg;
 
 				for (int i = 0; i < len; i++) {
@@ -1239,6 +1242,13 @@ void SimulatorMavlink::run()
 						handle_message(&msg);
 					}
 				}
+
+				len = ::recvfrom(_fd, _buf, sizeof(_buf), MSG_DONTWAIT, (struct sockaddr *)&_srcaddr, (socklen_t *)&_addrlen);
+			}
+
+			if (_lockstep_progress_pending) {
+				_lockstep_progress_pending = false;
+				px4_lockstep_progress(_lockstep_component);
 			}
 		}
 	}
@@ -315,6 +315,7 @@ private:
 #endif
 
 	int _lockstep_component{-1};
+	bool _lockstep_progress_pending{false};
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::MAV_TYPE>) _param_mav_type,
@@ -118,10 +118,19 @@ void Sih::lockstep_loop()
 		speed_factor = atof(speedup);
 	}
 
-	int rt_interval_us = int(roundf(sim_interval_us / speed_factor));
+	// A speed factor of 0 runs the simulation as fast as the stack can process it (no sleeps)
+	const bool unlimited_speed = speed_factor < FLT_EPSILON;
+	const int rt_interval_us = unlimited_speed ? 0 : int(roundf(sim_interval_us / speed_factor));
 
 	PX4_INFO("Simulation loop with %d Hz (%d us sim time interval)", rate, sim_interval_us);
-	PX4_INFO("Simulation with %.1fx speedup. Loop with (%d us wall time interval)", (double)speed_factor, rt_interval_us);
+
+	if (unlimited_speed) {
+		PX4_INFO("Simulation with unlimited speedup");
+
+	} else {
+		PX4_INFO("Simulation with %.1fx speedup. Loop with (%d us wall time interval)", (double)speed_factor, rt_interval_us);
+	}
+
 	uint64_t pre_compute_wall_time_us;
 
 	while (!should_exit()) {
@@ -152,9 +161,15 @@ void Sih::lockstep_loop()
 			sleep_time = math::max(0, rt_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
 		}
 
-		_achieved_speedup = 0.99f * _achieved_speedup + 0.01f * ((float)sim_interval_us / (float)(
-					    current_wall_time_us - pre_compute_wall_time_us + sleep_time));
-		usleep(sleep_time);
+		const uint64_t step_wall_time_us = current_wall_time_us - pre_compute_wall_time_us + sleep_time;
+
+		if (step_wall_time_us > 0) {
+			_achieved_speedup = 0.99f * _achieved_speedup + 0.01f * ((float)sim_interval_us / (float)step_wall_time_us);
+		}
+
+		if (sleep_time > 0) {
+			usleep(sleep_time);
+		}
 	}
 }
 #endif
@@ -21,6 +21,7 @@ import os
 #include <uxr/client/client.h>
 #include <ucdr/microcdr.h>
 
+#include <drivers/drv_hrt.h>
 #include <mathlib/mathlib.h>
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
@@ -35,6 +36,11 @@ import os
 typedef bool (*UcdrSerializeMethod)(const void* data, ucdrBuffer& buf, int64_t time_offset);
 
 static constexpr int max_topic_size = 512;
+
+// XRCE message header (session id, stream id, sequence number and client key) and the per sample overhead
+// (submessage header, object id, request id and alignment), used to fill up the MTU
+static constexpr uint32_t xrce_message_header_size = 8;
+static constexpr uint32_t xrce_submessage_overhead = 12;
 @[    for pub in publications]@
 static_assert(sizeof(@(pub['simple_base_type'])_s) <= max_topic_size, "topic too large, increase max_topic_size");
 @[    end for]@
@@ -67,6 +73,7 @@ struct SendSubscription {
 	uint32_t topic_size;
 	UcdrSerializeMethod ucdr_serialize_method;
 	uint64_t publish_interval_ms;
+	hrt_abstime flush_deadline_us; ///< max time a sample can be held back to be batched with other samples, 0 to send it in the same cycle
 };
 
 // Subscribers for messages to send
@@ -81,17 +88,29 @@ struct SendTopicsSubs {
 			  ucdr_topic_size_@(pub['simple_base_type'])(),
 			  &ucdr_serialize_@(pub['simple_base_type']),
 			  static_cast<uint64_t>((@(pub.get('rate_limit', 0)) > 0) ? (1e3 / @(pub.get('rate_limit', 1e3))) : UXRCE_DEFAULT_POLL_INTERVAL_MS),
+			  static_cast<hrt_abstime>(@(pub.get('flush_deadline', 0)) * 1000),
 			},
 @[    end for]@
 	};
 
 	px4_pollfd_struct_t fds[@(len(publications))] {};
 
+	// deadline of samples that are held back to be sent together with other samples (0 if none)
+	hrt_abstime deferred_until[@(len(publications))] {};
+
 	uint32_t num_payload_sent{};
 
 	bool init(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId reliable_in_stream_id, uxrStreamId best_effort_in_stream_id, uxrObjectId participant_id, const char *client_namespace);
 	void update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace);
 	void reset();
+
+	/**
+	 * Earliest deadline of the held back samples, 0 if there are none
+	 */
+	hrt_abstime next_deadline() const;
+
+private:
+	void send(uxrSession *session, uxrStreamId best_effort_stream_id, unsigned idx, char *topic_data, uint32_t &batch_size);
 };
 
 bool SendTopicsSubs::init(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId reliable_in_stream_id, uxrStreamId best_effort_in_stream_id, uxrObjectId participant_id, const char *client_namespace) {
@@ -118,39 +137,94 @@ void SendTopicsSubs::reset() {
 		send_subscriptions[idx].data_writer = uxr_object_id(0, UXR_INVALID_ID);
 		orb_unsubscribe(fds[idx].fd);
 		fds[idx].fd = -1;
+		deferred_until[idx] = 0;
 	}
 };
 
+hrt_abstime SendTopicsSubs::next_deadline() const
+{
+	hrt_abstime deadline = 0;
+
+	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
+		if (deferred_until[idx] != 0 && (deadline == 0 || deferred_until[idx] < deadline)) {
+			deadline = deferred_until[idx];
+		}
+	}
+
+	return deadline;
+}
+
 void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace)
 {
-	int64_t time_offset_us = session->time_offset / 1000; // ns -> us
+	const hrt_abstime now = hrt_absolute_time();
+	bool send_deferred = false;
+
+	// Samples with a flush deadline are held back until another sample is sent or the deadline expires,
+	// so that they share an XRCE message instead of adding the header and framing overhead of their own
+	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
+		if (deferred_until[idx] != 0) {
+			if (now >= deferred_until[idx]) {
+				send_deferred = true;
+			}
+
+		} else if (fds[idx].revents & POLLIN) {
+			if (send_subscriptions[idx].flush_deadline_us > 0) {
+				deferred_until[idx] = now + send_subscriptions[idx].flush_deadline_us;
+				fds[idx].events = 0; // don't wake up for this topic until it's sent
+
+			} else {
+				send_deferred = true;
+			}
+		}
+	}
 
 	alignas(sizeof(uint64_t)) char topic_data[max_topic_size];
 
+	// the output stream is flushed by uxr_run_session_timeout() after each update
+	uint32_t batch_size = xrce_message_header_size;
+
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
-		if (fds[idx].revents & POLLIN) {
-			// Topic updated, copy data and send
-			orb_copy(send_subscriptions[idx].orb_meta, fds[idx].fd, &topic_data);
+		if (deferred_until[idx] != 0) {
+			if (send_deferred) {
+				deferred_until[idx] = 0;
+				fds[idx].events = POLLIN;
+				send(session, best_effort_stream_id, idx, topic_data, batch_size);
+			}
+
+		} else if (fds[idx].revents & POLLIN) {
+			send(session, best_effort_stream_id, idx, topic_data, batch_size);
+		}
+	}
+}
 
-			if (send_subscriptions[idx].data_writer.id != UXR_INVALID_ID) {
+void SendTopicsSubs::send(uxrSession *session, uxrStreamId best_effort_stream_id, unsigned idx, char *topic_data, uint32_t &batch_size)
+{
+	// Topic updated, copy data and send
+	orb_copy(send_subscriptions[idx].orb_meta, fds[idx].fd, topic_data);
 
-				ucdrBuffer ub;
-				uint32_t topic_size = send_subscriptions[idx].topic_size;
-				if (uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID) {
-					send_subscriptions[idx].ucdr_serialize_method(&topic_data, ub, time_offset_us);
-					// TODO: fill up the MTU and then flush, which reduces the packet overhead
-					uxr_flash_output_streams(session);
-					num_payload_sent += topic_size;
+	if (send_subscriptions[idx].data_writer.id != UXR_INVALID_ID) {
 
-				} else {
-					//PX4_ERR("Error uxr_prepare_output_stream UXR_INVALID_REQUEST_ID %s", send_subscriptions[idx].subscription.get_topic()->o_name);
-				}
+		ucdrBuffer ub;
+		uint32_t topic_size = send_subscriptions[idx].topic_size;
 
-			} else {
-				//PX4_ERR("Error UXR_INVALID_ID %s", send_subscriptions[idx].subscription.get_topic()->o_name);
-			}
+		// fill up the MTU and then flush, which reduces the packet overhead
+		if (batch_size > xrce_message_header_size && batch_size + xrce_submessage_overhead + topic_size > session->comm->mtu) {
+			uxr_flash_output_streams(session);
+			batch_size = xrce_message_header_size;
+		}
 
+		if (uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID) {
+			int64_t time_offset_us = session->time_offset / 1000; // ns -> us
+			send_subscriptions[idx].ucdr_serialize_method(topic_data, ub, time_offset_us);
+			batch_size += xrce_submessage_overhead + topic_size;
+			num_payload_sent += topic_size;
+
+		} else {
+			//PX4_ERR("Error uxr_prepare_output_stream UXR_INVALID_REQUEST_ID %s", send_subscriptions[idx].subscription.get_topic()->o_name);
 		}
+
+	} else {
+		//PX4_ERR("Error UXR_INVALID_ID %s", send_subscriptions[idx].subscription.get_topic()->o_name);
 	}
 }
 
@@ -655,11 +655,20 @@ void UxrceddsClient::run()
 				}
 			}
 
+			// don't wait longer than the deadline of held back samples
+			const hrt_abstime flush_deadline = _subs->next_deadline();
+
+			if (flush_deadline != 0) {
+				const hrt_abstime now = hrt_absolute_time();
+				orb_poll_timeout_ms = (now >= flush_deadline) ? 0 : math::min(orb_poll_timeout_ms,
+						      static_cast<int>((flush_deadline - now + 999) / 1000));
+			}
+
 			/* Wait for topic updates for max 10 ms */
 			int poll = px4_poll(_subs->fds, (sizeof(_subs->fds) / sizeof(_subs->fds[0])), orb_poll_timeout_ms);
 
 			/* Handle the poll results */
-			if (poll > 0) {
+			if (poll > 0 || (poll == 0 && flush_deadline != 0 && hrt_absolute_time() >= flush_deadline)) {
 				_subs->update(&session, _reliable_out, _best_effort_out, _participant_id, _client_namespace);
 
 			} else {
@@ -57,7 +57,9 @@ using namespace time_literals;
 VtolAttitudeControl::VtolAttitudeControl() :
 	ModuleParams(nullptr),
 	WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
-	_loop_perf(perf_alloc(PC_ELAPSED, "vtol_att_control: cycle"))
+	_loop_perf(perf_alloc(PC_ELAPSED, "vtol_att_control: cycle")),
+	_transition_to_fw_perf(perf_alloc(PC_ELAPSED, "vtol_att_control: transition to fw")),
+	_transition_to_mc_perf(perf_alloc(PC_ELAPSED, "vtol_att_control: transition to mc"))
 {
 	// start vtol in rotary wing mode
 	_vtol_vehicle_status.vehicle_vtol_state = vtol_vehicle_status_s::VEHICLE_VTOL_STATE_MC;
@@ -89,6 +91,8 @@ VtolAttitudeControl::VtolAttitudeControl() :
 VtolAttitudeControl::~VtolAttitudeControl()
 {
 	perf_free(_loop_perf);
+	perf_free(_transition_to_fw_perf);
+	perf_free(_transition_to_mc_perf);
 }
 
 bool
@@ -400,11 +404,16 @@ VtolAttitudeControl::Run()
 		// update the vtol state machine which decides which mode we are in
 		_vtol_type->update_vtol_state();
 
+		// transition cycles (blending of both controllers) are timed separately
+		perf_counter_t transition_perf = nullptr;
+
 		// check in which mode we are in and call mode specific functions
 		switch (_vtol_type->get_mode()) {
 		case mode::TRANSITION_TO_FW:
 			// vehicle is doing a transition to FW
 			_vtol_vehicle_status.vehicle_vtol_state = vtol_vehicle_status_s::VEHICLE_VTOL_STATE_TRANSITION_TO_FW;
+			transition_perf = _transition_to_fw_perf;
+			perf_begin(transition_perf);
 
 			if (mc_att_sp_updated || fw_att_sp_updated) {
 				_vtol_type->update_transition_state();
@@ -416,6 +425,8 @@ VtolAttitudeControl::Run()
 		case mode::TRANSITION_TO_MC:
 			// vehicle is doing a transition to MC
 			_vtol_vehicle_status.vehicle_vtol_state = vtol_vehicle_status_s::VEHICLE_VTOL_STATE_TRANSITION_TO_MC;
+			transition_perf = _transition_to_mc_perf;
+			perf_begin(transition_perf);
 
 			if (mc_att_sp_updated || fw_att_sp_updated) {
 				_vtol_type->update_transition_state();
@@ -449,6 +460,10 @@ VtolAttitudeControl::Run()
 
 		_vtol_type->fill_actuator_outputs();
 
+		if (transition_perf) {
+			perf_end(transition_perf);
+		}
+
 		_vehicle_thrust_setpoint0_pub.publish(_thrust_setpoint_0);
 		_vehicle_thrust_setpoint1_pub.publish(_thrust_setpoint_1);
 		_vehicle_torque_setpoint0_pub.publish(_torque_setpoint_0);
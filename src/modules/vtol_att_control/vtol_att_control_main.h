@@ -231,6 +231,8 @@ private:
 	bool		_initialized{false};
 
 	perf_counter_t	_loop_perf;		// loop performance counter
+	perf_counter_t	_transition_to_fw_perf;	// cycles in front transition
+	perf_counter_t	_transition_to_mc_perf;	// cycles in back transition
 
 	void		vehicle_status_poll();
 
@@ -13,12 +13,17 @@
 @{
 import os
 
+# optional publisher QoS fields: max rate [Hz], deadline [ms], latest only
+def qos_fields(pub):
+    if not any(key in pub for key in ('rate_limit', 'deadline', 'latest_only')):
+        return ''
+    return ';%g;%d;%d' % (pub.get('rate_limit', 0), pub.get('deadline', 0), 1 if pub.get('latest_only', False) else 0)
 
 }@
 
 const char* default_pub_config =
 @[    for pub in publications]@
-	"@(pub['topic']);@(pub['simple_base_type']);0\n"
+	"@(pub['topic']);@(pub['simple_base_type']);0@(qos_fields(pub))\n"
 @[    end for]@
 ;
 
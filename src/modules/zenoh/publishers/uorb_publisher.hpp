@@ -42,6 +42,8 @@
 #pragma once
 
 #include "zenoh_publisher.hpp"
+#include "../zenoh_config.hpp"
+#include <drivers/drv_hrt.h>
 #include <uORB/Subscription.hpp>
 #include <dds_serializer.h>
 
@@ -53,7 +55,8 @@ public:
 	uORB_Zenoh_Publisher(const orb_metadata *meta, const uint32_t *ops, int instance) :
 		Zenoh_Publisher(),
 		_uorb_meta{meta},
-		_cdr_ops(ops)
+		_cdr_ops(ops),
+		_instance(instance)
 	{
 		if (instance <= 0) { // default (<0) or =0
 			_uorb_sub = orb_subscribe(meta); // orb_subscribe subscribes to the 0th/first instance by default
@@ -79,20 +82,31 @@ public:
 		uint8_t data[_uorb_meta->o_size];
 		orb_copy(_uorb_meta, _uorb_sub, data);
 
+		if (_qos.latest_only) {
+			// skip to the newest sample if there are more queued
+			bool updated = false;
+
+			while (orb_check(_uorb_sub, &updated) == PX4_OK && updated) {
+				orb_copy(_uorb_meta, _uorb_sub, data);
+			}
+		}
+
+		_last_update = hrt_absolute_time();
+
 		uint8_t buf[_uorb_meta->o_size + 4 + CDR_SAFETY_MARGIN];
 		memcpy(buf, ros2_header, sizeof(ros2_header));
 
 		dds_ostream_t os;
 		os.m_buffer = &buf[4];
 		os.m_index = 0;
-		os.m_size = (uint32_t)sizeof(ros2_header) + _uorb_meta->o_size + CDR_SAFETY_MARGIN;
+		os.m_size = (uint32_t)sizeof(buf) - sizeof(ros2_header);
 		os.m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_1;
 
 		if (dds_stream_write(&os,
 				     &dds_allocator,
 				     (const char *)&data,
 				     _cdr_ops)) {
-			return publish((const uint8_t *)buf, os.m_size);
+			return publish((const uint8_t *)buf, sizeof(ros2_header) + os.m_index);
 
 		} else {
 			return _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
@@ -109,6 +123,11 @@ public:
 	{
 		printf("uORB %s -> ", _uorb_meta->o_name);
 		Zenoh_Publisher::print();
+
+		if (_qos.max_rate > 0.f || _qos.deadline_ms > 0 || _qos.latest_only) {
+			printf("\tQoS: max rate %.1f Hz, deadline %" PRIu32 " ms (%" PRIu32 " missed), latest only %d\n",
+			       (double)_qos.max_rate, _qos.deadline_ms, _deadline_missed, _qos.latest_only);
+		}
 	}
 
 	const char *getName()
@@ -116,8 +135,42 @@ public:
 		return _uorb_meta->o_name;
 	}
 
+	int getInstance() const { return _instance; }
+
+	void setQos(const Zenoh_Publisher_Qos &qos)
+	{
+		_qos = qos;
+		// downsample at the source: uORB only reports updates at the maximum rate
+		orb_set_interval(_uorb_sub, (qos.max_rate > 0.f) ? static_cast<unsigned>(1000.f / qos.max_rate) : 0);
+	}
+
+	// Count a missed deadline if there was no update within the deadline, returns the time until the next check
+	hrt_abstime checkDeadline(const hrt_abstime now)
+	{
+		if (_qos.deadline_ms == 0) {
+			return UINT64_MAX;
+		}
+
+		const hrt_abstime deadline = _qos.deadline_ms * 1000ULL;
+
+		if (_last_update == 0) {
+			_last_update = now;
+
+		} else if (now - _last_update >= deadline) {
+			_deadline_missed++;
+			_last_update = now; // count once per deadline period
+		}
+
+		return _last_update + deadline - now;
+	}
+
 private:
 	const orb_metadata *_uorb_meta;
 	int _uorb_sub;
 	const uint32_t *_cdr_ops;
+	const int _instance;
+
+	Zenoh_Publisher_Qos _qos{};
+	hrt_abstime _last_update{0};
+	uint32_t _deadline_missed{0};
 };
@@ -91,8 +91,10 @@ int8_t Zenoh_Publisher::publish(const uint8_t *buf, int size)
 
 	options.attachment = z_move(z_attachment);
 
+	// zenoh-pico encodes the payload into the transport buffer within z_publisher_put(),
+	// so the caller's buffer can be handed over without an intermediate copy
 	z_owned_bytes_t payload;
-	z_bytes_copy_from_buf(&payload, buf, size);
+	z_bytes_from_static_buf(&payload, buf, size);
 	return z_publisher_put(z_loan(_pub), z_move(payload), &options);
 }
 
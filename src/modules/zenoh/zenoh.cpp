@@ -41,6 +41,7 @@
 #include <fcntl.h>
 #include <systemlib/err.h>
 #include <drivers/drv_hrt.h>
+#include <lib/mathlib/mathlib.h>
 #include <ctype.h>
 #include <string.h>
 
@@ -330,9 +331,10 @@ int ZENOH::setupTopics(px4_pollfd_struct_t *pfds)
 		char topic[TOPIC_INFO_SIZE];
 		char type[TOPIC_INFO_SIZE];
 		int instance;
+		Zenoh_Publisher_Qos qos;
 
 		for (i = 0; i < _pub_count; i++) {
-			if (_config.getPublisherMapping(topic, type, &instance)) {
+			if (_config.getPublisherMapping(topic, type, &instance, &qos)) {
 				_zenoh_publishers[i] = genPublisher(type, instance);
 				const uint8_t *rihs_hash = getRIHS01_Hash(type);
 
@@ -340,6 +342,7 @@ int ZENOH::setupTopics(px4_pollfd_struct_t *pfds)
 				    generate_rmw_zenoh_topic_keyexpr(topic, rihs_hash, type, keyexpr) > 0) {
 					_zenoh_publishers[i]->declare_publisher(_s, keyexpr, (uint8_t *)&_px4_guid);
 					_zenoh_publishers[i]->setPollFD(&pfds[i]);
+					_zenoh_publishers[i]->setQos(qos);
 #ifdef CONFIG_ZENOH_RMW_LIVELINESS
 
 					if (generate_rmw_zenoh_topic_liveliness_keyexpr(&self_id, topic, rihs_hash, type, keyexpr, "MP") > 0) {
@@ -409,8 +412,10 @@ void ZENOH::run()
 		}
 	}
 
+	int poll_timeout_ms = 100;
+
 	while (!should_exit()) {
-		int pret = px4_poll(pfds, _pub_count, 100);
+		int pret = px4_poll(pfds, _pub_count, poll_timeout_ms);
 
 		if (pret == 0) {
 			//PX4_INFO("Zenoh poll timeout\n");
@@ -427,6 +432,18 @@ void ZENOH::run()
 				}
 			}
 		}
+
+		// wake up in time for the next publisher deadline
+		const hrt_abstime now = hrt_absolute_time();
+		hrt_abstime next_check = 100 * 1000; // 100 ms poll timeout
+
+		for (i = 0; i < _pub_count; i++) {
+			if (_zenoh_publishers[i]) {
+				next_check = math::min(next_check, _zenoh_publishers[i]->checkDeadline(now));
+			}
+		}
+
+		poll_timeout_ms = math::max((int)(next_check / 1000), 1);
 	}
 
 	// Exiting cleaning up publisher and subscribers
@@ -460,6 +477,17 @@ int ZENOH::custom_command(int argc, char *argv[])
 		Zenoh_Config z_config;
 
 		if (z_config.cli(argc, argv) == 0) {
+			// apply QoS changes to the running publishers
+			if (argc >= 3 && strcmp(argv[1], "qos") == 0 && is_running()) {
+				char type[TOPIC_INFO_SIZE];
+				int instance;
+				Zenoh_Publisher_Qos qos;
+
+				if (z_config.getPublisherQos(argv[2], type, &instance, &qos)) {
+					get_instance()->setPublisherQos(type, instance, qos);
+				}
+			}
+
 			return 0;
 		}
 	}
@@ -467,6 +495,18 @@ int ZENOH::custom_command(int argc, char *argv[])
 	return print_usage("Unrecognized command.");
 }
 
+void ZENOH::setPublisherQos(const char *type, int instance, const Zenoh_Publisher_Qos &qos)
+{
+	if (_zenoh_publishers) {
+		for (int i = 0; i < _pub_count; i++) {
+			if (_zenoh_publishers[i] && strcmp(_zenoh_publishers[i]->getName(), type) == 0
+			    && _zenoh_publishers[i]->getInstance() == instance) {
+				_zenoh_publishers[i]->setQos(qos);
+			}
+		}
+	}
+}
+
 int ZENOH::print_usage(const char *reason)
 {
 	if (reason) {
@@ -487,6 +527,10 @@ Zenoh demo bridge
 	PX4_INFO_RAW("     add subscriber <zenoh_topic> <uorb_topic> <optional uorb_instance>  Publish Zenoh topic to uORB\n");
 	PX4_INFO_RAW("     delete publisher  <zenoh_topic>\n");
 	PX4_INFO_RAW("     delete subscriber <zenoh_topic>\n");
+	PX4_INFO_RAW("     qos <zenoh_topic> <max_rate> <optional deadline> <optional latest_only>  Publisher QoS\n");
+	PX4_INFO_RAW("          <max_rate>    maximum publication rate [Hz], 0 for every update\n");
+	PX4_INFO_RAW("          <deadline>    maximum expected interval between updates [ms], 0 to disable\n");
+	PX4_INFO_RAW("          <latest_only> 1: only publish the latest sample, skip queued ones\n");
 	PX4_INFO_RAW("     net           <mode> <locator>            Zenoh network mode\n");
 	PX4_INFO_RAW("          <mode>    values: client|peer   \n");
 	PX4_INFO_RAW("          <locator> client: locator address e.g. tcp/10.41.10.1:7447#iface=eth0\n");
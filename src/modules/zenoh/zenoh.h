@@ -82,6 +82,9 @@ public:
 
 	void run() override;
 
+	// update the QoS of the publishers of a uORB topic instance
+	void setPublisherQos(const char *type, int instance, const Zenoh_Publisher_Qos &qos);
+
 private:
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::ZENOH_DOMAIN_ID>) _zenoh_domain_id
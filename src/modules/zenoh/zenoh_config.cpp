@@ -209,6 +209,85 @@ int Zenoh_Config::DeletePubSub(char *topic, const char *filename)
 }
 
 
+int Zenoh_Config::SetPublisherQos(const char *topic, const Zenoh_Publisher_Qos &qos)
+{
+	FILE *file = fopen(ZENOH_PUB_CONFIG_PATH, "r");
+
+	if (!file) {
+		return -1;
+	}
+
+	// Create a temporary file for writing
+	char temp_filename[256];
+	snprintf(temp_filename, sizeof(temp_filename), "%s.tmp", ZENOH_PUB_CONFIG_PATH);
+	FILE *temp_file = fopen(temp_filename, "w");
+
+	if (!temp_file) {
+		fclose(file);
+		return -1;
+	}
+
+	char line[MAX_LINE_SIZE];
+	char line_copy[MAX_LINE_SIZE];
+	const char *fields[3];
+	int found = 0;
+
+	while (fgets(line, sizeof(line), file)) {
+		// Remove newline if present
+		size_t len = strlen(line);
+
+		if (len > 0 && line[len - 1] == '\n') {
+			line[len - 1] = '\0';
+		}
+
+		strncpy(line_copy, line, sizeof(line_copy) - 1);
+		line_copy[sizeof(line_copy) - 1] = '\0';
+		int num_fields = parse_csv_line(line_copy, fields, 3);
+
+		// Rewrite the matching line with the new QoS fields, keep all other lines
+		if (num_fields >= 2 && strcmp(fields[0], topic) == 0) {
+			fprintf(temp_file, "%s;%s;%s;%.3f;%" PRIu32 ";%d\n", fields[0], fields[1], (num_fields == 3) ? fields[2] : "0",
+				(double)qos.max_rate, qos.deadline_ms, qos.latest_only ? 1 : 0);
+			found = 1;
+
+		} else {
+			fprintf(temp_file, "%s\n", line);
+		}
+	}
+
+	fclose(file);
+	fclose(temp_file);
+
+	if (!found) {
+		remove(temp_filename);
+		return 0;
+	}
+
+	if (remove(ZENOH_PUB_CONFIG_PATH) != 0 || rename(temp_filename, ZENOH_PUB_CONFIG_PATH) != 0) {
+		remove(temp_filename);
+		return -1;
+	}
+
+	return 1;
+}
+
+bool Zenoh_Config::getPublisherQos(const char *topic, char *type, int *instance, Zenoh_Publisher_Qos *qos)
+{
+	char f_topic[TOPIC_INFO_SIZE];
+	bool found = false;
+
+	while (getPubSubMapping(f_topic, type, instance, ZENOH_PUB_CONFIG_PATH, qos) > 0) {
+		if (strcmp(topic, f_topic) == 0) {
+			found = true;
+			break;
+		}
+	}
+
+	closePubSubMapping();
+	return found;
+}
+
+
 int Zenoh_Config::SetNetworkConfig(char *mode, char *locator)
 {
 
@@ -232,6 +311,42 @@ int Zenoh_Config::SetNetworkConfig(char *mode, char *locator)
 
 int Zenoh_Config::cli(int argc, char *argv[])
 {
+	if (argc >= 2 && strcmp(argv[1], "qos") == 0) {
+		if (argc < 4) {
+			printf("The publisher topic and maximum rate need to be specified.\n");
+			return 0;
+		}
+
+		Zenoh_Publisher_Qos qos{};
+		int deadline_ms = 0;
+		int latest_only = 0;
+
+		if (sscanf(argv[3], "%f", &qos.max_rate) != 1 || qos.max_rate < 0.f
+		    || (argc >= 5 && (sscanf(argv[4], "%d", &deadline_ms) != 1 || deadline_ms < 0))
+		    || (argc >= 6 && sscanf(argv[5], "%d", &latest_only) != 1)) {
+			printf("Invalid QoS (rate [Hz] >= 0, deadline [ms] >= 0, latest_only 0|1)\n");
+			return 0;
+		}
+
+		qos.deadline_ms = deadline_ms;
+		qos.latest_only = (latest_only != 0);
+
+		int res = SetPublisherQos(argv[2], qos);
+
+		if (res > 0) {
+			printf("Set QoS of publisher %s: max rate %.1f Hz, deadline %" PRIu32 " ms, latest only %d\n", argv[2],
+			       (double)qos.max_rate, qos.deadline_ms, qos.latest_only);
+
+		} else if (res == 0) {
+			printf("Publisher topic %s not found\n", argv[2]);
+
+		} else {
+			printf("Could not set QoS of publisher topic %s\n", argv[2]);
+		}
+
+		return 0;
+	}
+
 	if (argc == 1) {
 		dump_config();
 
@@ -444,7 +559,8 @@ int Zenoh_Config::closePubSubMapping()
 
 
 // Very rudamentary here but we've to wait for a more advanced param system
-int Zenoh_Config::getPubSubMapping(char *topic, char *type, int *instance, const char *filename)
+int Zenoh_Config::getPubSubMapping(char *topic, char *type, int *instance, const char *filename,
+				   Zenoh_Publisher_Qos *qos)
 {
 	char buffer[MAX_LINE_SIZE];
 
@@ -456,12 +572,28 @@ int Zenoh_Config::getPubSubMapping(char *topic, char *type, int *instance, const
 		while (fgets(buffer, MAX_LINE_SIZE, fp_mapping) != NULL) {
 
 			if (buffer[0] != '\n') {
-				const char *fields[3];
-				int nfields = parse_csv_line(buffer, fields, 3);
+				const char *fields[6];
+				int nfields = parse_csv_line(buffer, fields, 6);
 
 
 				if (nfields >= 2) {
-					if (nfields == 3) {
+					if (qos) {
+						*qos = Zenoh_Publisher_Qos{};
+
+						if (nfields >= 4) {
+							qos->max_rate = strtof(fields[3], nullptr);
+						}
+
+						if (nfields >= 5) {
+							qos->deadline_ms = strtoul(fields[4], nullptr, 10);
+						}
+
+						if (nfields >= 6) {
+							qos->latest_only = (atoi(fields[5]) != 0);
+						}
+					}
+
+					if (nfields >= 3) {
 						if (sscanf(fields[2], "%d", instance) != 1) {
 							PX4_WARN("Malformed zenoh config instance %s (instance field should be an integer following the type)\n", fields[2]);
 							return -1;
@@ -518,12 +650,19 @@ void Zenoh_Config::dump_config()
 		char type[TOPIC_INFO_SIZE];
 		int instance_no;
 
+		Zenoh_Publisher_Qos qos;
+
 		printf("Publisher config:\n");
 
-		while (getPubSubMapping(topic, type, &instance_no, ZENOH_PUB_CONFIG_PATH) > 0) {
+		while (getPubSubMapping(topic, type, &instance_no, ZENOH_PUB_CONFIG_PATH, &qos) > 0) {
 			printf("Topic: %s\n", topic);
 			printf("Type: %s\n", type);
 			printf("Instance: %d\n", instance_no);
+
+			if (qos.max_rate > 0.f || qos.deadline_ms > 0 || qos.latest_only) {
+				printf("QoS: max rate %.1f Hz, deadline %" PRIu32 " ms, latest only %d\n", (double)qos.max_rate, qos.deadline_ms,
+				       qos.latest_only);
+			}
 		}
 
 		printf("\nSubscriber config:\n");
@@ -64,6 +64,14 @@
 #define MAX_LINE_SIZE (2 * TOPIC_INFO_SIZE)
 #define KEYEXPR_SIZE (MAX_LINE_SIZE + KEYEXPR_MSG_NAME_SIZE + KEYEXPR_RIHS01_SIZE + 128)
 
+// Optional per publisher QoS, stored as additional fields in the publisher config:
+// <zenoh_topic>;<uorb_topic>;<instance>;<max_rate>;<deadline>;<latest_only>
+struct Zenoh_Publisher_Qos {
+	float max_rate{0.f};     ///< [Hz] maximum publication rate (downsampled at the uORB subscription), 0 for every update
+	uint32_t deadline_ms{0}; ///< [ms] maximum expected interval between updates (missed deadlines are counted), 0 to disable
+	bool latest_only{false}; ///< publish only the latest sample, skipping samples still queued in uORB
+};
+
 class Zenoh_Config
 {
 public:
@@ -81,10 +89,12 @@ public:
 	{
 		return getLineCount(ZENOH_SUB_CONFIG_PATH);
 	}
-	int getPublisherMapping(char *topic, char *type, int *instance)
+	int getPublisherMapping(char *topic, char *type, int *instance, Zenoh_Publisher_Qos *qos = nullptr)
 	{
-		return getPubSubMapping(topic, type, instance, ZENOH_PUB_CONFIG_PATH);
+		return getPubSubMapping(topic, type, instance, ZENOH_PUB_CONFIG_PATH, qos);
 	}
+	// lookup the uORB topic, instance and QoS of a configured publisher
+	bool getPublisherQos(const char *topic, char *type, int *instance, Zenoh_Publisher_Qos *qos);
 	// existing_instance will be either 0 (should create a new instance) or nonzero (should reuse the existing 0 instance)
 	int getSubscriberMapping(char *topic, char *type, int *existing_instance)
 	{
@@ -94,9 +104,11 @@ public:
 
 
 private:
-	int getPubSubMapping(char *topic, char *type, int *new_instance, const char *filename);
+	int getPubSubMapping(char *topic, char *type, int *new_instance, const char *filename,
+			     Zenoh_Publisher_Qos *qos = nullptr);
 	int AddPubSub(char *topic, char *datatype, int new_instance, const char *filename);
 	int DeletePubSub(char *topic, const char *filename);
+	int SetPublisherQos(const char *topic, const Zenoh_Publisher_Qos &qos);
 	int SetNetworkConfig(char *mode, char *locator);
 	int getLineCount(const char *filename);
 
@@ -0,0 +1,68 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/heap_usage.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+#include <string.h>
+
+static void print_usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Print the C++ heap usage (operator new) per tag: the WorkItem that allocated on a work queue thread,
+the module for allocations during its 'start' command, or otherwise the thread name.
+Current and peak bytes are counted per tag, allocations freed by another tag are still
+subtracted from the tag that allocated them.
+
+### Example
+$ heap_usage status
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("heap_usage", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "Print the heap usage per tag");
+}
+
+extern "C" __EXPORT int heap_usage_main(int argc, char *argv[])
+{
+	if ((argc == 2) && (strcmp(argv[1], "status") == 0)) {
+		px4::heap_usage::print_status();
+		return 0;
+	}
+
+	print_usage();
+	return -1;
+}
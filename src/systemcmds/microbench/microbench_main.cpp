@@ -38,13 +38,20 @@
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <inttypes.h>
+
+#include "microbench.h"
 
 __BEGIN_DECLS
 
+extern int test_microbench_allocation(int argc, char *argv[]);
 extern int test_microbench_atomic(int argc, char *argv[]);
+extern int test_microbench_ekf2(int argc, char *argv[]);
+extern int test_microbench_filters(int argc, char *argv[]);
 extern int test_microbench_hrt(int argc, char *argv[]);
 extern int test_microbench_math(int argc, char *argv[]);
 extern int test_microbench_matrix(int argc, char *argv[]);
+extern int test_microbench_param(int argc, char *argv[]);
 extern int test_microbench_uorb(int argc, char *argv[]);
 
 __END_DECLS
@@ -63,10 +70,18 @@ const struct {
 	{"help",		microbench_help,		OPT_NOALLTEST | OPT_NOHELP},
 	{"all",		microbench_all,		OPT_NOALLTEST},
 
+#if defined(CONFIG_MODULES_CONTROL_ALLOCATOR)
+	{"microbench_allocation",	test_microbench_allocation,	0},
+#endif
 	{"microbench_atomic",	test_microbench_atomic,	0},
+#if defined(CONFIG_MODULES_EKF2)
+	{"microbench_ekf2",	test_microbench_ekf2,	0},
+#endif
+	{"microbench_filters",	test_microbench_filters,	0},
 	{"microbench_hrt",	test_microbench_hrt,	0},
 	{"microbench_math",	test_microbench_math,	0},
 	{"microbench_matrix",	test_microbench_matrix,	0},
+	{"microbench_param",	test_microbench_param,	0},
 	{"microbench_uorb",	test_microbench_uorb,	0},
 
 	{"null",			nullptr, 		0}
@@ -74,8 +89,33 @@ const struct {
 
 #define NMICROBENCHMARKS (sizeof(microbenchmarks) / sizeof(microbenchmarks[0]))
 
+static bool csv_output = false;
+
+void microbench::set_csv_output(bool enabled)
+{
+	csv_output = enabled;
+}
+
+void microbench::print_result(perf_counter_t handle)
+{
+	if (!csv_output) {
+		perf_print_counter(handle);
+		return;
+	}
+
+	perf_counter_stats stats;
+
+	if (perf_get_stats(handle, &stats) == 0) {
+		// mean from perf_mean() for sub-us resolution, stats.time_avg_us is truncated
+		printf("%s,%llu,%.3f,%" PRIu32 ",%" PRIu32 "\n", perf_name(handle), (unsigned long long)stats.event_count,
+		       (double)(perf_mean(handle) * 1e6f), stats.time_min_us, stats.time_max_us);
+	}
+}
+
 static int microbench_help(int argc, char *argv[])
 {
+	printf("usage: microbench [-c] <test>\n");
+	printf("  -c  print the results as CSV: name,events,mean_us,min_us,max_us\n\n");
 	printf("Available tests:\n");
 
 	for (int i = 0; microbenchmarks[i].name; i++) {
@@ -144,6 +184,14 @@ static int microbench_runner(unsigned option)
 
 extern "C" __EXPORT int microbench_main(int argc, char *argv[])
 {
+	microbench::set_csv_output(false);
+
+	if ((argc >= 2) && !strcmp(argv[1], "-c")) {
+		microbench::set_csv_output(true);
+		argc--;
+		argv++;
+	}
+
 	if (argc < 2) {
 		PX4_WARN("missing test name - 'microbench help' for a list of tests");
 		return 1;
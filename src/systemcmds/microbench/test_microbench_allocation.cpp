@@ -0,0 +1,192 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_allocation.cpp
+ * Microbenchmarks of the multicopter control allocation.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include "microbench.h"
+
+#include <lib/control_allocation/control_allocation/ControlAllocationSequentialDesaturation.hpp>
+
+namespace MicroBenchAllocation
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		microbench::print_result(p); \
+		perf_free(p); \
+	} while (0)
+
+using matrix::Vector;
+
+class MicroBenchAllocation : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_allocate_quad();
+	bool time_allocate_hex();
+
+	void reset() {}
+
+	void setEffectiveness(ControlAllocation &allocation, const float rotors[][4], int num_rotors);
+	void setControlSetpoint(float roll, float pitch, float yaw, float thrust);
+
+	ControlAllocationSequentialDesaturation _allocation;
+	Vector<float, ControlAllocation::NUM_AXES> _control_sp{};
+};
+
+bool MicroBenchAllocation::run_tests()
+{
+	ut_run_test(time_allocate_quad);
+	ut_run_test(time_allocate_hex);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchAllocation::setEffectiveness(ControlAllocation &allocation, const float rotors[][4], int num_rotors)
+{
+	// rotors given as {x, y, moment_ratio, thrust_coef}, all thrusting upwards
+	matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> effectiveness{};
+
+	for (int i = 0; i < num_rotors; i++) {
+		effectiveness(ControlAllocation::ControlAxis::ROLL, i) = -rotors[i][1] * rotors[i][3];
+		effectiveness(ControlAllocation::ControlAxis::PITCH, i) = rotors[i][0] * rotors[i][3];
+		effectiveness(ControlAllocation::ControlAxis::YAW, i) = -rotors[i][2] * rotors[i][3];
+		effectiveness(ControlAllocation::ControlAxis::THRUST_Z, i) = -rotors[i][3];
+	}
+
+	allocation.setEffectivenessMatrix(effectiveness, ControlAllocation::ActuatorVector{},
+					  ControlAllocation::ActuatorVector{}, num_rotors, true);
+}
+
+void MicroBenchAllocation::setControlSetpoint(float roll, float pitch, float yaw, float thrust)
+{
+	_control_sp.zero();
+	_control_sp(ControlAllocation::ControlAxis::ROLL) = roll;
+	_control_sp(ControlAllocation::ControlAxis::PITCH) = pitch;
+	_control_sp(ControlAllocation::ControlAxis::YAW) = yaw;
+	_control_sp(ControlAllocation::ControlAxis::THRUST_Z) = thrust;
+	_allocation.setControlSetpoint(_control_sp);
+}
+
+bool MicroBenchAllocation::time_allocate_quad()
+{
+	static constexpr float quad_x[4][4] {
+		{1.f, 1.f, 1.f, 1.f},
+		{-1.f, 1.f, -1.f, 1.f},
+		{-1.f, -1.f, 1.f, 1.f},
+		{1.f, -1.f, -1.f, 1.f},
+	};
+
+	setEffectiveness(_allocation, quad_x, 4);
+
+	setControlSetpoint(0.01f, -0.02f, 0.005f, -0.5f);
+	PERF("SequentialDesaturation allocate quad (unsaturated)", _allocation.allocate(), 1000);
+
+	setControlSetpoint(0.5f, -0.3f, 0.4f, -0.9f);
+	PERF("SequentialDesaturation allocate quad (saturated)", _allocation.allocate(), 1000);
+
+	return true;
+}
+
+bool MicroBenchAllocation::time_allocate_hex()
+{
+	static constexpr float hex_x[6][4] {
+		{0.f, 1.f, -1.f, 1.f},
+		{0.f, -1.f, 1.f, 1.f},
+		{0.866f, -0.5f, -1.f, 1.f},
+		{-0.866f, 0.5f, 1.f, 1.f},
+		{0.866f, 0.5f, 1.f, 1.f},
+		{-0.866f, -0.5f, -1.f, 1.f},
+	};
+
+	setEffectiveness(_allocation, hex_x, 6);
+
+	setControlSetpoint(0.01f, -0.02f, 0.005f, -0.5f);
+	PERF("SequentialDesaturation allocate hex (unsaturated)", _allocation.allocate(), 1000);
+
+	setControlSetpoint(0.5f, -0.3f, 0.4f, -0.9f);
+	PERF("SequentialDesaturation allocate hex (saturated)", _allocation.allocate(), 1000);
+
+	return true;
+}
+
+ut_declare_test_c(test_microbench_allocation, MicroBenchAllocation)
+
+} // namespace MicroBenchAllocation
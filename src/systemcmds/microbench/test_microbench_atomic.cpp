@@ -48,6 +48,8 @@
 #include <px4_platform_common/micro_hal.h>
 #include <px4_platform_common/atomic.h>
 
+#include "microbench.h"
+
 #ifdef __PX4_NUTTX
 #include <nuttx/irq.h>
 #endif
@@ -68,7 +70,7 @@ namespace MicroBenchAtomic
 			unlock(); \
 			reset(); \
 		} \
-		perf_print_counter(p); \
+		microbench::print_result(p); \
 		perf_free(p); \
 	} while (0)
 
@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_ekf2.cpp
+ * Microbenchmarks of the EKF2 covariance prediction and fusion kernels.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include "microbench.h"
+
+#include <modules/ekf2/EKF/ekf.h>
+#include <ekf_derivation/generated/predict_covariance.h>
+
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+# include <ekf_derivation/generated/compute_mag_innov_innov_var_and_hx.h>
+#endif // CONFIG_EKF2_MAGNETOMETER
+
+namespace MicroBenchEKF2
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		microbench::print_result(p); \
+		perf_free(p); \
+	} while (0)
+
+using matrix::Vector3f;
+
+class MicroBenchEKF2 : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_covariance_prediction();
+	bool time_fusion();
+	bool time_update();
+
+	void reset();
+
+	void updateImu();
+
+	static constexpr uint32_t FILTER_UPDATE_PERIOD_US = 10'000;
+
+	Ekf _ekf{};
+	imuSample _imu_sample{};
+
+	StateSample _state{};
+	Ekf::SquareMatrixState _P{};
+	Ekf::SquareMatrixState _P_predicted{};
+
+	Ekf::VectorState _H{};
+	Ekf::VectorState _K{};
+	Ekf::VectorState _H_mag{};
+	Vector3f _mag_innov{};
+	Vector3f _mag_innov_var{};
+};
+
+bool MicroBenchEKF2::run_tests()
+{
+	_ekf.init(0);
+
+	// level and at rest, run long enough for the tilt alignment to complete
+	_imu_sample.delta_vel = Vector3f(0.f, 0.f, -CONSTANTS_ONE_G) * (FILTER_UPDATE_PERIOD_US * 1e-6f);
+
+	for (int i = 0; i < 500; i++) {
+		updateImu();
+	}
+
+	ut_run_test(time_covariance_prediction);
+	ut_run_test(time_fusion);
+	ut_run_test(time_update);
+
+	return (_tests_failed == 0);
+}
+
+template<typename T>
+T random(T min, T max)
+{
+	const T scale = rand() / (T) RAND_MAX; /* [0, 1.0] */
+	return min + scale * (max - min);      /* [min, max] */
+}
+
+void MicroBenchEKF2::reset()
+{
+	srand(time(nullptr));
+
+	// initialize with random data
+	_state.quat_nominal = matrix::Quatf(matrix::Eulerf(random(-0.5f, 0.5f), random(-0.5f, 0.5f), random(-3.f, 3.f)));
+	_state.vel = Vector3f(random(-5.f, 5.f), random(-5.f, 5.f), random(-5.f, 5.f));
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+	_state.mag_I = Vector3f(0.2f, 0.f, 0.4f);
+#endif // CONFIG_EKF2_MAGNETOMETER
+
+	_P.setZero();
+
+	for (unsigned i = 0; i < State::size; i++) {
+		_P(i, i) = random(1e-4f, 1e-1f);
+	}
+
+	// a scalar height observation
+	_H.setZero();
+	_H(State::pos.idx + 2) = 1.f;
+
+	_K.setZero();
+	_K(State::pos.idx + 2) = 1e-3f;
+}
+
+void MicroBenchEKF2::updateImu()
+{
+	_imu_sample.time_us += FILTER_UPDATE_PERIOD_US;
+	_imu_sample.delta_ang_dt = FILTER_UPDATE_PERIOD_US * 1e-6f;
+	_imu_sample.delta_vel_dt = FILTER_UPDATE_PERIOD_US * 1e-6f;
+	_ekf.setIMUData(_imu_sample);
+	_ekf.update();
+}
+
+bool MicroBenchEKF2::time_covariance_prediction()
+{
+	const Vector3f accel(0.3f, -0.1f, -9.7f);
+	const Vector3f accel_var(0.01f, 0.01f, 0.01f);
+	const Vector3f gyro(0.02f, 0.1f, -0.05f);
+	const float gyro_var = 1e-4f;
+	const float dt = FILTER_UPDATE_PERIOD_US * 1e-6f;
+
+	PERF("ekf2 PredictCovariance (generated)",
+	     _P_predicted = sym::PredictCovariance(_state.vector(), _P, accel, accel_var, gyro, gyro_var, dt), 100);
+
+	return true;
+}
+
+bool MicroBenchEKF2::time_fusion()
+{
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+	const Vector3f mag(0.2f, 0.05f, 0.4f);
+
+	PERF("ekf2 ComputeMagInnovInnovVarAndHx (generated)",
+	     sym::ComputeMagInnovInnovVarAndHx(_state.vector(), _P, mag, 1e-3f, FLT_EPSILON, &_mag_innov, &_mag_innov_var, &_H_mag), 100);
+#endif // CONFIG_EKF2_MAGNETOMETER
+
+	// sparse P * H, Joseph covariance update and state correction of a scalar observation
+	PERF("ekf2 measurementUpdate", _ekf.measurementUpdate(_K, _H, 1e-3f, 1e-3f), 100);
+
+	return true;
+}
+
+bool MicroBenchEKF2::time_update()
+{
+	// a complete filter update without aiding: state and covariance prediction and fake position fusion
+	PERF("ekf2 update (IMU only)", updateImu(), 100);
+
+	return true;
+}
+
+ut_declare_test_c(test_microbench_ekf2, MicroBenchEKF2)
+
+} // namespace MicroBenchEKF2
@@ -0,0 +1,214 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_filters.cpp
+ * Microbenchmarks of the sensor filters and integrators run on every gyro/accel sample.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include "microbench.h"
+
+#include <lib/mathlib/math/filter/LowPassFilter2p.hpp>
+#include <lib/mathlib/math/filter/NotchFilter.hpp>
+#include <matrix/math.hpp>
+#include <modules/sensors/Integrator.hpp>
+
+namespace MicroBenchFilters
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		microbench::print_result(p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchFilters : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_lowpass();
+	bool time_notch();
+	bool time_integrator();
+
+	void reset();
+
+	void applyNotchBank()
+	{
+		for (int axis = 0; axis < 3; axis++) {
+			for (int i = 0; i < NOTCH_BANK; i++) {
+				_notch_bank[axis][i].applyArray(_fifo[axis], FIFO_SAMPLES);
+			}
+		}
+	}
+
+	// a full gyro FIFO sample (8 kHz sampling, 1 kHz publication), filtered per axis
+	static constexpr int FIFO_SAMPLES = 8;
+
+	// dynamic notch filter bank: 4 ESC RPM with 3 harmonics each
+	static constexpr int NOTCH_BANK = 4 * 3;
+
+	static constexpr float SAMPLE_RATE_HZ = 8000.f;
+
+	math::LowPassFilter2p<float> _lpf_float{SAMPLE_RATE_HZ, 30.f};
+	math::LowPassFilter2p<matrix::Vector3f> _lpf_vector3f{SAMPLE_RATE_HZ, 30.f};
+	math::NotchFilter<float> _notch_float;
+	math::NotchFilter<float> _notch_bank[3][NOTCH_BANK] {};
+
+	sensors::Integrator _integrator{};
+	sensors::IntegratorConing _integrator_coning{};
+
+	float _f{0.f};
+	matrix::Vector3f _v{};
+	float _fifo[3][FIFO_SAMPLES] {};
+	matrix::Vector3f _fifo_vector[FIFO_SAMPLES] {};
+	float _fifo_dt[FIFO_SAMPLES] {};
+};
+
+bool MicroBenchFilters::run_tests()
+{
+	_notch_float.setParameters(SAMPLE_RATE_HZ, 100.f, 20.f);
+
+	for (int axis = 0; axis < 3; axis++) {
+		for (int i = 0; i < NOTCH_BANK; i++) {
+			// harmonics of 4 motors spread between 80 Hz and 950 Hz
+			_notch_bank[axis][i].setParameters(SAMPLE_RATE_HZ, 80.f * (i / 4 + 1) + 10.f * (i % 4), 20.f);
+		}
+	}
+
+	ut_run_test(time_lowpass);
+	ut_run_test(time_notch);
+	ut_run_test(time_integrator);
+
+	return (_tests_failed == 0);
+}
+
+template<typename T>
+T random(T min, T max)
+{
+	const T scale = rand() / (T) RAND_MAX; /* [0, 1.0] */
+	return min + scale * (max - min);      /* [min, max] */
+}
+
+void MicroBenchFilters::reset()
+{
+	srand(time(nullptr));
+
+	// initialize with random data
+	_f = random(-10.f, 10.f);
+	_v = matrix::Vector3f(random(-10.f, 10.f), random(-10.f, 10.f), random(-10.f, 10.f));
+
+	for (int n = 0; n < FIFO_SAMPLES; n++) {
+		for (int axis = 0; axis < 3; axis++) {
+			_fifo[axis][n] = random(-10.f, 10.f);
+		}
+
+		_fifo_vector[n] = matrix::Vector3f(_fifo[0][n], _fifo[1][n], _fifo[2][n]);
+		_fifo_dt[n] = 1.f / SAMPLE_RATE_HZ;
+	}
+}
+
+bool MicroBenchFilters::time_lowpass()
+{
+	PERF("LowPassFilter2p<float> apply", _f = _lpf_float.apply(_f), 1000);
+	PERF("LowPassFilter2p<Vector3f> apply", _v = _lpf_vector3f.apply(_v), 1000);
+	PERF("LowPassFilter2p<float> applyArray 8 samples", _lpf_float.applyArray(_fifo[0], FIFO_SAMPLES), 1000);
+	return true;
+}
+
+bool MicroBenchFilters::time_notch()
+{
+	PERF("NotchFilter<float> apply", _f = _notch_float.apply(_f), 1000);
+	PERF("NotchFilter<float> applyArray 8 samples", _notch_float.applyArray(_fifo[0], FIFO_SAMPLES), 1000);
+
+	// the dynamic notch bank applied to a full 3 axis gyro FIFO sample, as in VehicleAngularVelocity
+	PERF("NotchFilter<float> bank 3x12 applyArray 8 samples", applyNotchBank(), 100);
+
+	return true;
+}
+
+bool MicroBenchFilters::time_integrator()
+{
+	PERF("Integrator put", _integrator.put(_v, 1.f / SAMPLE_RATE_HZ), 1000);
+	PERF("Integrator put 8 samples", _integrator.put(_fifo_vector, _fifo_dt, FIFO_SAMPLES), 1000);
+	PERF("IntegratorConing put", _integrator_coning.put(_v, 1.f / SAMPLE_RATE_HZ), 1000);
+	PERF("IntegratorConing put 8 samples", _integrator_coning.put(_fifo_vector, _fifo_dt, FIFO_SAMPLES), 1000);
+	return true;
+}
+
+ut_declare_test_c(test_microbench_filters, MicroBenchFilters)
+
+} // namespace MicroBenchFilters
@@ -38,15 +38,19 @@
 
 #include <unit_test.h>
 
+#include <inttypes.h>
 #include <time.h>
 #include <stdlib.h>
 #include <unistd.h>
 
 #include <drivers/drv_hrt.h>
+#include <lib/mathlib/mathlib.h>
 #include <perf/perf_counter.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
 
+#include "microbench.h"
+
 namespace MicroBenchHRT
 {
 
@@ -82,7 +86,7 @@ void unlock()
 			unlock(); \
 			reset(); \
 		} \
-		perf_print_counter(p); \
+		microbench::print_result(p); \
 		perf_free(p); \
 	} while (0)
 
@@ -94,6 +98,8 @@ public:
 private:
 
 	bool time_px4_hrt();
+	bool time_px4_hrt_monotonic();
+	bool time_px4_hrt_callout();
 
 	void reset();
 
@@ -118,6 +124,8 @@ private:
 bool MicroBenchHRT::run_tests()
 {
 	ut_run_test(time_px4_hrt);
+	ut_run_test(time_px4_hrt_monotonic);
+	ut_run_test(time_px4_hrt_callout);
 
 	return (_tests_failed == 0);
 }
@@ -145,6 +153,89 @@ bool MicroBenchHRT::time_px4_hrt()
 	PERF("hrt_absolute_time()", u_64_out = hrt_absolute_time(), 1000);
 	PERF("hrt_elapsed_time()", u_64_out = hrt_elapsed_time(&u_64), 1000);
 
+	struct timespec ts;
+	PERF("px4_clock_gettime(CLOCK_MONOTONIC)", px4_clock_gettime(CLOCK_MONOTONIC, &ts), 1000);
+
+	return true;
+}
+
+bool MicroBenchHRT::time_px4_hrt_monotonic()
+{
+	// timestamps must never go backwards, and subsequent calls should be close together
+	hrt_abstime last = hrt_absolute_time();
+	hrt_abstime max_step = 0;
+
+	for (int i = 0; i < 100000; i++) {
+		const hrt_abstime now = hrt_absolute_time();
+		ut_assert_true(now >= last);
+
+		if (now - last > max_step) {
+			max_step = now - last;
+		}
+
+		last = now;
+	}
+
+	PX4_INFO("hrt_absolute_time() max step: %" PRIu64 " us", max_step);
+
+	return true;
+}
+
+struct CalloutLatency {
+	hrt_abstime deadline;
+	volatile hrt_abstime called;
+};
+
+static void callout_latency(void *arg)
+{
+	CalloutLatency *latency = static_cast<CalloutLatency *>(arg);
+	latency->called = hrt_absolute_time();
+}
+
+bool MicroBenchHRT::time_px4_hrt_callout()
+{
+	// time from the deadline of a hrt_call_at() callout until it runs
+	static constexpr int count = 200;
+
+	struct hrt_call call {};
+	CalloutLatency latency{};
+	hrt_abstime latency_max = 0;
+	hrt_abstime latency_sum = 0;
+	int missed = 0;
+
+	for (int i = 0; i < count; i++) {
+		latency.called = 0;
+		latency.deadline = hrt_absolute_time() + 1000 + (i % 10) * 100;
+		hrt_call_at(&call, latency.deadline, callout_latency, &latency);
+
+		const hrt_abstime timeout = latency.deadline + 100000;
+
+		while (latency.called == 0 && hrt_absolute_time() < timeout) {
+			px4_usleep(100);
+		}
+
+		if (latency.called == 0) {
+			hrt_cancel(&call);
+			missed++;
+			continue;
+		}
+
+		// never early
+		ut_assert_true(latency.called >= latency.deadline);
+
+		const hrt_abstime delay = latency.called - latency.deadline;
+		latency_sum += delay;
+
+		if (delay > latency_max) {
+			latency_max = delay;
+		}
+	}
+
+	PX4_INFO("hrt callout latency: avg %" PRIu64 " us, max %" PRIu64 " us, %d missed",
+		 latency_sum / math::max(count - missed, 1), latency_max, missed);
+
+	ut_assert_true(missed == 0);
+
 	return true;
 }
 
@@ -47,6 +47,8 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
 
+#include "microbench.h"
+
 #include <matrix/math.hpp>
 
 namespace MicroBenchMatrix
@@ -84,7 +86,7 @@ void unlock()
 			unlock(); \
 			reset(); \
 		} \
-		perf_print_counter(p); \
+		microbench::print_result(p); \
 		perf_free(p); \
 	} while (0)
 
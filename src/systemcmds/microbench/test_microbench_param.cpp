@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_param.cpp
+ * Microbenchmarks of the parameter lookup and access.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include "microbench.h"
+
+#include <parameters/param.h>
+
+namespace MicroBenchParam
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		microbench::print_result(p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchParam : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_param_find();
+	bool time_param_get();
+
+	void reset() {}
+
+	param_t _param{PARAM_INVALID};
+	int32_t _value{0};
+
+	// looked up at runtime, the set of parameters depends on the board configuration
+	const char *_name_first{nullptr};
+	const char *_name_last{nullptr};
+};
+
+bool MicroBenchParam::run_tests()
+{
+	if (param_count() == 0) {
+		return false;
+	}
+
+	_name_first = param_name(param_for_index(0));
+	_name_last = param_name(param_for_index(param_count() - 1));
+
+	ut_run_test(time_param_find);
+	ut_run_test(time_param_get);
+
+	return (_tests_failed == 0);
+}
+
+bool MicroBenchParam::time_param_find()
+{
+	PERF("param_find first", _param = param_find_no_notification(_name_first), 1000);
+	PERF("param_find last", _param = param_find_no_notification(_name_last), 1000);
+	PERF("param_find unknown", _param = param_find_no_notification("MICROBENCH_X"), 1000);
+	PERF("param_find (marks used)", _param = param_find(_name_last), 1000);
+	return true;
+}
+
+bool MicroBenchParam::time_param_get()
+{
+	const param_t param = param_find(_name_last);
+
+	if (param_type(param) != PARAM_TYPE_INT32 && param_type(param) != PARAM_TYPE_FLOAT) {
+		return false;
+	}
+
+	PERF("param_get", param_get(param, &_value), 1000);
+	PERF("param_value_is_default", param_value_is_default(param), 1000);
+	return true;
+}
+
+ut_declare_test_c(test_microbench_param, MicroBenchParam)
+
+} // namespace MicroBenchParam
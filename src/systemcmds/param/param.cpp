@@ -76,7 +76,7 @@ enum class COMPARE_ERROR_LEVEL {
 
 static int 	do_save(const char *param_file_name);
 static int	do_save_default();
-static int 	do_load(const char *param_file_name);
+static int 	do_load(const char *param_file_name = nullptr);
 static int	do_import(const char *param_file_name = nullptr);
 static int	do_show(const char *search_string, bool only_changed);
 static int	do_show_for_airframe();
@@ -207,7 +207,7 @@ param_main(int argc, char *argv[])
 				return do_load(argv[2]);
 
 			} else {
-				return do_load(param_get_default_file());
+				return do_load();
 			}
 		}
 
@@ -428,6 +428,13 @@ do_save(const char *param_file_name)
 static int
 do_load(const char *param_file_name)
 {
+	// the default file is followed by the journal of changes saved since
+	const bool load_default = param_file_name == nullptr;
+
+	if (load_default) {
+		param_file_name = param_get_default_file();
+	}
+
 	int fd = -1;
 
 	if (param_file_name) { // passing NULL means to select the flash storage
@@ -456,13 +463,20 @@ do_load(const char *param_file_name)
 		return 1;
 	}
 
+	if (load_default) {
+		param_import_journal();
+	}
+
 	return 0;
 }
 
 static int
 do_import(const char *param_file_name)
 {
-	if (param_file_name == nullptr) {
+	// the default file is followed by the journal of changes saved since
+	const bool import_default = param_file_name == nullptr;
+
+	if (import_default) {
 		param_file_name = param_get_default_file();
 	}
 
@@ -496,6 +510,10 @@ do_import(const char *param_file_name)
 		return 1;
 	}
 
+	if (import_default) {
+		param_import_journal();
+	}
+
 	return 0;
 }
 
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/sched_trace.h>
+#include <string.h>
+
+static void print_usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Record a scheduler trace: work item start/stop, uORB publications, HRT callouts and work queue wakeups,
+with a ring buffer per CPU that keeps the latest events.
+
+The dump is in the Chrome trace event format and can be opened in Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+
+### Example
+$ sched_trace start
+$ sched_trace dump
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("sched_trace", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Clear the buffers and start recording");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("stop", "Stop recording");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "Print the recording state");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("dump", "Stop recording and write the trace to a file");
+	PRINT_MODULE_USAGE_ARG("<file>", "Output file (default " PX4_STORAGEDIR "/sched_trace.json)", true);
+}
+
+extern "C" __EXPORT int sched_trace_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		print_usage();
+		return -1;
+	}
+
+	if (strcmp(argv[1], "start") == 0) {
+		sched_trace_enable(true);
+		return 0;
+
+	} else if (strcmp(argv[1], "stop") == 0) {
+		sched_trace_enable(false);
+		return 0;
+
+	} else if (strcmp(argv[1], "status") == 0) {
+		PX4_INFO("%s, %" PRIu32 " events recorded", sched_trace_enabled() ? "recording" : "stopped",
+			 sched_trace_event_count());
+		return 0;
+
+	} else if (strcmp(argv[1], "dump") == 0) {
+		const char *path = (argc > 2) ? argv[2] : PX4_STORAGEDIR "/sched_trace.json";
+		const int ret = sched_trace_dump(path);
+
+		if (ret != 0) {
+			PX4_ERR("writing %s failed (%i)", path, ret);
+			return -1;
+		}
+
+		PX4_INFO("trace written to %s", path);
+		return 0;
+	}
+
+	print_usage();
+	return -1;
+}
@@ -50,6 +50,14 @@
 
 #include <drivers/drv_hrt.h>
 
+#if defined(CONFIG_MODULES_LOGGER)
+#include <string.h>
+#include <parameters/param.h>
+#include <perf/perf_counter.h>
+#include <modules/logger/log_writer_file.h>
+#include <modules/logger/messages.h>
+#endif // CONFIG_MODULES_LOGGER
+
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
 
 typedef struct sdb_config {
@@ -74,6 +82,35 @@ static inline unsigned int time_fsync(int fd);
 
 static const char *BENCHMARK_FILE = PX4_STORAGEDIR"/benchmark.tmp";
 
+#if defined(CONFIG_MODULES_LOGGER)
+/** a simulated logged topic */
+struct sdb_topic {
+	int size; ///< message payload size [bytes]
+	int rate; ///< logging rate [Hz]
+};
+
+static constexpr int MAX_TOPICS = 32;
+static constexpr int MAX_TOPIC_SIZE = 1024;
+
+/**
+ * Default topic mix, roughly the default logging profile (~60 KB/s):
+ * sensor_combined, attitude, rates, setpoints, estimator status, position, etc.
+ */
+static const char *DEFAULT_TOPIC_MIX = "48:200,40:100,36:100,64:50,92:50,120:50,200:20,300:10,400:5,80:200";
+
+/**
+ * Parse a topic mix of the form size:rate[,size:rate...]
+ * @return number of topics, -1 on error
+ */
+static int parse_topic_mix(const char *mix, sdb_topic topics[MAX_TOPICS]);
+
+/**
+ * Logger access pattern test: messages of the topic mix are written at their rates via the logger's
+ * LogWriterFile (same buffer, write chunking and fsync pattern), at the logger's default update interval.
+ */
+static int logger_test(sdb_config_t *cfg, const sdb_topic *topics, int num_topics, int buffer_size);
+#endif // CONFIG_MODULES_LOGGER
+
 static void usage()
 {
 	PRINT_MODULE_DESCRIPTION("Test the speed of an SD Card");
@@ -87,6 +124,13 @@ static void usage()
 	PRINT_MODULE_USAGE_PARAM_FLAG('u', "Test performance with unaligned data", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('U', "Test performance with forced byte unaligned data", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('v', "Verify data and block number", true);
+#if defined(CONFIG_MODULES_LOGGER)
+	PRINT_MODULE_USAGE_PARAM_FLAG('l', "Replay the logger access pattern (buffer, write chunks and fsync) "
+				      "and report dropouts and write latencies", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('m', nullptr, "<size:rate,...>",
+					"Logger test: topic mix, message sizes [bytes] and rates [Hz] (default: ~60 KB/s)", true);
+	PRINT_MODULE_USAGE_PARAM_INT('B', 12, 4, 10000, "Logger test: buffer size in KiB (logger -b)", true);
+#endif // CONFIG_MODULES_LOGGER
 }
 
 extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
@@ -104,8 +148,13 @@ extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
 	cfg.unaligned = 0;
 	uint8_t *block = nullptr;
 	uint8_t *block_alloc = nullptr;
+	bool logger_mode = false;
+#if defined(CONFIG_MODULES_LOGGER)
+	const char *topic_mix = nullptr;
+	int logger_buffer_size = 12 * 1024;
+#endif // CONFIG_MODULES_LOGGER
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:ksuUv", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:ksuUvlm:B:", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			block_size = strtol(myoptarg, nullptr, 0);
@@ -139,6 +188,21 @@ extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
 			verify = true;
 			break;
 
+		case 'l':
+			logger_mode = true;
+			break;
+
+#if defined(CONFIG_MODULES_LOGGER)
+
+		case 'm':
+			topic_mix = myoptarg;
+			break;
+
+		case 'B':
+			logger_buffer_size = strtol(myoptarg, nullptr, 0) * 1024;
+			break;
+#endif // CONFIG_MODULES_LOGGER
+
 		default:
 			usage();
 			return -1;
@@ -151,6 +215,29 @@ extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
 		return -1;
 	}
 
+	if (logger_mode) {
+#if defined(CONFIG_MODULES_LOGGER)
+		sdb_topic topics[MAX_TOPICS];
+		int num_topics = parse_topic_mix(topic_mix ? topic_mix : DEFAULT_TOPIC_MIX, topics);
+
+		if (num_topics <= 0 || logger_buffer_size <= 0) {
+			PX4_ERR("invalid argument");
+			return -1;
+		}
+
+		int ret = logger_test(&cfg, topics, num_topics, logger_buffer_size);
+
+		if (!keep) {
+			unlink(BENCHMARK_FILE);
+		}
+
+		return ret;
+#else
+		PX4_ERR("logger not enabled");
+		return -1;
+#endif // CONFIG_MODULES_LOGGER
+	}
+
 	int bench_fd = open(BENCHMARK_FILE, O_CREAT | (verify ? O_RDWR : O_WRONLY) | O_TRUNC, PX4_O_MODE_666);
 
 	if (bench_fd < 0) {
@@ -367,3 +454,242 @@ int read_test(int fd, sdb_config_t *cfg, uint8_t *block, int block_size)
 	free(block_alloc);
 	return 0;
 }
+
+#if defined(CONFIG_MODULES_LOGGER)
+using namespace px4::logger;
+
+int parse_topic_mix(const char *mix, sdb_topic topics[MAX_TOPICS])
+{
+	int num_topics = 0;
+	const char *p = mix;
+
+	while (*p) {
+		char *end = nullptr;
+		const int size = strtol(p, &end, 0);
+
+		if (end == p || *end != ':' || num_topics >= MAX_TOPICS) {
+			return -1;
+		}
+
+		p = end + 1;
+		const int rate = strtol(p, &end, 0);
+
+		if (end == p || (*end != ',' && *end != '\0')) {
+			return -1;
+		}
+
+		if (size <= 0 || size > MAX_TOPIC_SIZE || rate <= 0 || rate > 10000) {
+			return -1;
+		}
+
+		topics[num_topics].size = size;
+		topics[num_topics].rate = rate;
+		++num_topics;
+		p = (*end == ',') ? end + 1 : end;
+	}
+
+	return num_topics;
+}
+
+/**
+ * Get the latency (upper bound of the histogram bucket) below which the given fraction of the writes are.
+ * @return latency [us], 0 if there are no samples
+ */
+static uint32_t histogram_percentile(const uint32_t buckets[PERF_HISTOGRAM_BUCKETS], float fraction)
+{
+	uint64_t total = 0;
+
+	for (int i = 0; i < PERF_HISTOGRAM_BUCKETS; ++i) {
+		total += buckets[i];
+	}
+
+	if (total == 0) {
+		return 0;
+	}
+
+	const uint64_t target = (uint64_t)(total * (double)fraction);
+	uint64_t count = 0;
+
+	for (int i = 0; i < PERF_HISTOGRAM_BUCKETS; ++i) {
+		count += buckets[i];
+
+		if (count > target) {
+			return 1u << (i + 1);
+		}
+	}
+
+	return 1u << PERF_HISTOGRAM_BUCKETS;
+}
+
+int logger_test(sdb_config_t *cfg, const sdb_topic *topics, int num_topics, int buffer_size)
+{
+	// the logger's default update interval (logger -r)
+	static constexpr hrt_abstime LOGGER_INTERVAL = 3500;
+
+	int32_t prealloc_mb = 0;
+	int32_t write_block_kb = 4;
+	param_get(param_find("SDLOG_PREALLOC"), &prealloc_mb);
+	param_get(param_find("SDLOG_WR_BLOCK"), &write_block_kb);
+
+	double data_rate = 0.;
+
+	for (int i = 0; i < num_topics; ++i) {
+		data_rate += (double)(topics[i].size + sizeof(ulog_message_data_s)) * topics[i].rate;
+	}
+
+	PX4_INFO("");
+	PX4_INFO("Testing Logger Access Pattern...");
+	PX4_INFO("  %i topics, %.2lf KB/s, buffer: %i KiB, write block: %i KiB, prealloc: %i MiB",
+		 num_topics, data_rate / 1024., buffer_size / 1024, (int)write_block_kb, (int)prealloc_mb);
+
+	uint8_t *msg = (uint8_t *)malloc(MAX_TOPIC_SIZE + sizeof(ulog_message_data_s));
+	hrt_abstime *next_publish = (hrt_abstime *)malloc(num_topics * sizeof(hrt_abstime));
+	LogWriterFile *writer = new LogWriterFile(buffer_size);
+
+	if (!msg || !next_publish || !writer) {
+		PX4_ERR("alloc failed");
+		free(msg);
+		free(next_publish);
+		delete writer;
+		return -1;
+	}
+
+	memset(msg, 0x55, MAX_TOPIC_SIZE + sizeof(ulog_message_data_s));
+	writer->set_file_options((size_t)prealloc_mb * 1024 * 1024, (size_t)write_block_kb * 1024);
+
+	if (!writer->init() || !writer->start_log(LogType::Full, BENCHMARK_FILE, false)) {
+		PX4_ERR("Can't open benchmark file %s", BENCHMARK_FILE);
+		free(msg);
+		free(next_publish);
+		delete writer;
+		return -1;
+	}
+
+	unsigned int total_dropouts = 0;
+	hrt_abstime max_dropout = 0;
+	size_t max_high_water = 0;
+	size_t total_messages = 0;
+	double total_elapsed = 0.;
+	size_t total_written = 0;
+
+	for (int run = 0; run < cfg->num_runs; ++run) {
+		const hrt_abstime start = hrt_absolute_time();
+		const size_t written_start = writer->get_total_written(LogType::Full);
+		hrt_abstime dropout_start = 0;
+		hrt_abstime dropout_time = 0;
+		hrt_abstime run_max_dropout = 0;
+		unsigned int dropouts = 0;
+		size_t messages = 0;
+		size_t high_water = 0;
+
+		for (int i = 0; i < num_topics; ++i) {
+			next_publish[i] = start;
+		}
+
+		while ((int64_t)hrt_elapsed_time(&start) < cfg->run_duration * 1000) {
+			const hrt_abstime now = hrt_absolute_time();
+
+			writer->lock();
+
+			for (int i = 0; i < num_topics; ++i) {
+				const hrt_abstime interval = 1000000 / topics[i].rate;
+
+				while (next_publish[i] <= now) {
+					ulog_message_data_s *header = (ulog_message_data_s *)msg;
+					header->msg_size = (uint16_t)(topics[i].size + sizeof(header->msg_id));
+					header->msg_type = static_cast<uint8_t>(ULogMessageType::DATA);
+					header->msg_id = (uint16_t)i;
+					const size_t msg_size = topics[i].size + sizeof(ulog_message_data_s);
+
+					// same dropout handling as Logger::write_message()
+					if (writer->write_message(LogType::Full, msg, msg_size, dropout_start) != -1) {
+						if (dropout_start) {
+							const hrt_abstime duration = hrt_elapsed_time(&dropout_start);
+							dropout_time += duration;
+							run_max_dropout = MAX(run_max_dropout, duration);
+							dropout_start = 0;
+						}
+
+						++messages;
+
+					} else if (!dropout_start) {
+						dropout_start = hrt_absolute_time();
+						++dropouts;
+					}
+
+					next_publish[i] += interval;
+				}
+			}
+
+			if (!dropout_start) {
+				high_water = MAX(high_water, writer->get_buffer_fill_count(LogType::Full));
+			}
+
+			writer->unlock();
+			writer->notify();
+
+			if (writer->had_write_error()) {
+				PX4_ERR("Write error: %d", errno);
+				break;
+			}
+
+			const hrt_abstime elapsed = hrt_elapsed_time(&now);
+
+			if (elapsed < LOGGER_INTERVAL) {
+				px4_usleep(LOGGER_INTERVAL - elapsed);
+			}
+		}
+
+		if (dropout_start) {
+			const hrt_abstime duration = hrt_elapsed_time(&dropout_start);
+			dropout_time += duration;
+			run_max_dropout = MAX(run_max_dropout, duration);
+		}
+
+		//report
+		const double elapsed = hrt_elapsed_time(&start) / 1.e6;
+		const size_t written = writer->get_total_written(LogType::Full) - written_start;
+		PX4_INFO("  Run %2i: %8.2lf KB/s, dropouts: %u (%.3lf s, max: %.3lf s), max buffer used: %zu / %zu B",
+			 run, (double)written / elapsed / 1024., dropouts, dropout_time / 1.e6, run_max_dropout / 1.e6,
+			 high_water, writer->get_buffer_size(LogType::Full));
+
+		total_elapsed += elapsed;
+		total_written += written;
+		total_messages += messages;
+		total_dropouts += dropouts;
+		max_dropout = MAX(max_dropout, run_max_dropout);
+		max_high_water = MAX(max_high_water, high_water);
+
+		if (writer->had_write_error()) {
+			break;
+		}
+	}
+
+	uint32_t buckets[PERF_HISTOGRAM_BUCKETS] {};
+	writer->get_write_latency_histogram(LogType::Full, buckets);
+
+	writer->stop_log(LogType::Full);
+	writer->thread_stop();
+	const bool write_error = writer->had_write_error();
+	delete writer;
+	free(next_publish);
+	free(msg);
+
+	PX4_INFO("  Avg   : %8.2lf KB/s, %zu messages", (double)total_written / total_elapsed / 1024., total_messages);
+	PX4_INFO("  Dropouts: %u, max: %.3lf s, max buffer used: %zu B", total_dropouts, max_dropout / 1.e6, max_high_water);
+	PX4_INFO("  Write latency [us]: p50 < %u, p90 < %u, p99 < %u, p99.9 < %u, max < %u",
+		 histogram_percentile(buckets, 0.5f), histogram_percentile(buckets, 0.9f), histogram_percentile(buckets, 0.99f),
+		 histogram_percentile(buckets, 0.999f), histogram_percentile(buckets, 1.f));
+
+	if (write_error) {
+		return -1;
+	}
+
+	if (total_dropouts > 0) {
+		PX4_WARN("Logger dropouts expected with this topic mix and buffer size");
+		return 1;
+	}
+
+	return 0;
+}
+#endif // CONFIG_MODULES_LOGGER
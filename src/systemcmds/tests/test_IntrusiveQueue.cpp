@@ -52,6 +52,7 @@ public:
 	bool test_push_duplicate();
 	bool test_remove();
 	bool test_reinsert();
+	bool test_push_front();
 
 };
 
@@ -62,6 +63,7 @@ bool IntrusiveQueueTest::run_tests()
 	ut_run_test(test_push_duplicate);
 	ut_run_test(test_remove);
 	ut_run_test(test_reinsert);
+	ut_run_test(test_push_front);
 
 	return (_tests_failed == 0);
 }
@@ -383,4 +385,40 @@ bool IntrusiveQueueTest::test_reinsert()
 	return true;
 }
 
+bool IntrusiveQueueTest::test_push_front()
+{
+	IntrusiveQueue<testContainer *> q1;
+
+	testContainer *first = new testContainer();
+	first->i = 1;
+	testContainer *second = new testContainer();
+	second->i = 2;
+	testContainer *front = new testContainer();
+	front->i = 0;
+
+	// push_front into an empty queue
+	q1.push_front(first);
+	ut_assert_true(q1.front() == first);
+	ut_assert_true(q1.back() == first);
+
+	q1.push(second);
+	q1.push_front(front);
+	ut_compare("size 3", q1.size(), 3);
+
+	// duplicates are ignored
+	q1.push_front(second);
+	ut_compare("size still 3", q1.size(), 3);
+
+	// pop in order 0, 1, 2
+	for (int i = 0; i < 3; i++) {
+		auto t = q1.pop();
+		ut_compare("stored i", i, t->i);
+		delete t;
+	}
+
+	ut_assert_true(q1.empty());
+
+	return true;
+}
+
 ut_declare_test_c(test_IntrusiveQueue, IntrusiveQueueTest)
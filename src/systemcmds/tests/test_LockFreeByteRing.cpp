@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <unit_test.h>
+
+#include <include/containers/LockFreeByteRing.hpp>
+
+#include <string.h>
+
+class LockFreeByteRingTest : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool writeReadTest();
+	bool overwriteTest();
+	bool followTest();
+};
+
+bool LockFreeByteRingTest::run_tests()
+{
+	ut_run_test(writeReadTest);
+	ut_run_test(overwriteTest);
+	ut_run_test(followTest);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_LockFreeByteRing, LockFreeByteRingTest)
+
+bool LockFreeByteRingTest::writeReadTest()
+{
+	LockFreeByteRing<16> ring;
+	char buffer[16] {};
+	int offset = -1;
+
+	ut_compare("empty size", ring.size(), 0);
+	ut_compare("empty read", ring.read(buffer, sizeof(buffer), &offset), 0);
+
+	ring.write("hello", 5);
+	ring.write(" world", 6);
+	ut_compare("size", ring.size(), 11);
+
+	offset = -1;
+	ut_compare("read all", ring.read(buffer, sizeof(buffer), &offset), 11);
+	ut_assert_true(memcmp(buffer, "hello world", 11) == 0);
+	ut_compare("offset", offset, 11);
+	ut_compare("nothing new", ring.read(buffer, sizeof(buffer), &offset), 0);
+
+	return true;
+}
+
+bool LockFreeByteRingTest::overwriteTest()
+{
+	LockFreeByteRing<12> ring;
+	char buffer[16] {};
+	int offset = -1;
+
+	ring.write("0123456789", 10);
+	ring.write("abcdef", 6); // wraps, overwrites "0123"
+	ut_compare("size full", ring.size(), 12);
+
+	ut_compare("read oldest", ring.read(buffer, sizeof(buffer), &offset), 12);
+	ut_assert_true(memcmp(buffer, "456789abcdef", 12) == 0);
+
+	// longer than the buffer: only the end is kept
+	ring.write("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 26);
+	offset = -1;
+	ut_compare("read end", ring.read(buffer, sizeof(buffer), &offset), 12);
+	ut_assert_true(memcmp(buffer, "OPQRSTUVWXYZ", 12) == 0);
+
+	return true;
+}
+
+bool LockFreeByteRingTest::followTest()
+{
+	LockFreeByteRing<8> ring;
+	char buffer[8] {};
+	int offset = -1;
+
+	ring.write("abc", 3);
+	ut_compare("first", ring.read(buffer, sizeof(buffer), &offset), 3);
+
+	ring.write("de", 2);
+	ut_compare("new data", ring.read(buffer, sizeof(buffer), &offset), 2);
+	ut_assert_true(memcmp(buffer, "de", 2) == 0);
+
+	// the reader falls behind by more than the buffer size: skips to the oldest data still available
+	ring.write("01234", 5);
+	ring.write("56789", 5);
+	ut_compare("skipped", ring.read(buffer, sizeof(buffer), &offset), 8);
+	ut_assert_true(memcmp(buffer, "23456789", 8) == 0);
+	ut_compare("offset", offset, 15);
+
+	return true;
+}
@@ -43,6 +43,8 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <systemlib/err.h>
 #include <lib/tinybson/tinybson.h>
@@ -55,7 +57,7 @@ static const int64_t sample_big_int = (int64_t)INT_MAX + 123LL;
 static const double sample_double = 2.5f;
 static const char *sample_string = "this is a test";
 static const uint8_t sample_data[256] = {0};
-//static const char *sample_filename = "/fs/microsd/bson.test";
+static const char *sample_filename = PX4_STORAGEDIR "/bson.test";
 
 static int
 encode(bson_encoder_t encoder)
@@ -293,7 +295,44 @@ test_bson(int argc, char *argv[])
 	}
 
 	decode(&decoder);
+
+	/* decode it from a file, through a read buffer smaller than most nodes */
+	int fd = open(sample_filename, O_CREAT | O_TRUNC | O_RDWR, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("FAIL: open %s", sample_filename);
+		free(buf);
+		return 1;
+	}
+
+	const bool written = (write(fd, buf, len) == len) && (lseek(fd, 0, SEEK_SET) == 0);
 	free(buf);
 
+	if (!written) {
+		PX4_ERR("FAIL: writing %s", sample_filename);
+		close(fd);
+		unlink(sample_filename);
+		return 1;
+	}
+
+	bson_decoder_s file_decoder{};
+	uint8_t read_buffer[7];
+
+	if (bson_decoder_init_buf_file(&file_decoder, fd, read_buffer, sizeof(read_buffer), decode_callback)) {
+		PX4_ERR("FAIL: bson_decoder_init_buf_file");
+		close(fd);
+		unlink(sample_filename);
+		return 1;
+	}
+
+	decode(&file_decoder);
+	close(fd);
+	unlink(sample_filename);
+
+	if (file_decoder.dead || (file_decoder.total_decoded_size != len)) {
+		PX4_ERR("FAIL: buffered file decoder (decoded %" PRId32 " of %d bytes)", file_decoder.total_decoded_size, len);
+		return 1;
+	}
+
 	return PX4_OK;
 }
@@ -38,6 +38,7 @@
 
 #include <unit_test.h>
 
+#include <lib/mathlib/mathlib.h>
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 #include <stdint.h>
@@ -87,9 +88,24 @@ private:
 	bool testAsyncMutipleClients();
 	bool testAsyncWriteReadAllItemsMaxSize();
 	bool testAsyncClearAll();
+	bool testAsyncReadBatch();
 
 	//Cache
 	bool testCache();
+	bool testCachePrefetch();
+
+	//Write-behind of the storage backend
+	bool testWriteBehindEviction();
+	bool testWriteBehindFlush();
+	bool testClearPendingWrites();
+
+	//Data of the previous run, across a restart of dataman or with another backend
+	bool testPersistenceCheck();
+	bool testPersistenceWrite();
+
+	bool writePattern(dm_item_t item, uint32_t index, uint8_t seed);
+	bool checkPattern(dm_item_t item, uint32_t index, uint8_t seed);
+	bool evictBackendCache();
 
 	//This will reset the items but it will not restore the compact key.
 	bool testResetItems();
@@ -119,6 +135,17 @@ private:
 	uint16_t _max_index[DM_KEY_NUM_KEYS] {};
 
 	static constexpr uint32_t OVERFLOW_LENGTH = sizeof(_buffer_write) + 1;
+
+	static constexpr uint32_t PERSISTENCE_MAGIC = 0x504d5444; ///< 'DTMP'
+	static constexpr uint32_t PERSISTENCE_ITEMS = 8; ///< items before the marker
+
+	uint8_t _persistence_seed{1};
+
+#ifdef CONFIG_DATAMAN_FILE_CACHE_ITEMS
+	static constexpr uint32_t BACKEND_CACHE_ITEMS = CONFIG_DATAMAN_FILE_CACHE_ITEMS;
+#else
+	static constexpr uint32_t BACKEND_CACHE_ITEMS = 0;
+#endif
 };
 
 DatamanTest::DatamanTest()
@@ -942,6 +969,165 @@ DatamanTest::testCache()
 	return true;
 }
 
+bool
+DatamanTest::testAsyncReadBatch()
+{
+	dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_1;
+	uint32_t uniq_number = 29;
+	uint32_t first_index = 3;
+	static constexpr uint8_t count = DatamanClient::MAX_BATCH_COUNT;
+
+	for (uint32_t index = first_index; index < first_index + count; ++index) {
+		memset(_buffer_write, index + uniq_number, sizeof(_buffer_write));
+
+		if (!_dataman_client1.writeSync(item, index, _buffer_write, sizeof(_buffer_write))) {
+			return false;
+		}
+	}
+
+	uint8_t batch_data[count][DM_MAX_DATA_SIZE] {};
+	uint8_t *buffers[count];
+
+	for (uint8_t i = 0; i < count; ++i) {
+		buffers[i] = batch_data[i];
+	}
+
+	if (!_dataman_client1.readBatchAsync(item, first_index, count, buffers, DM_MAX_DATA_SIZE)) {
+		PX4_ERR("readBatchAsync failed");
+		return false;
+	}
+
+	// only one request at a time
+	if (_dataman_client1.readBatchAsync(item, first_index, count, buffers, DM_MAX_DATA_SIZE)) {
+		PX4_ERR("readBatchAsync unexpectedly succeeded");
+		return false;
+	}
+
+	hrt_abstime start_time = hrt_absolute_time();
+	bool success = false;
+
+	while (!_dataman_client1.lastOperationCompleted(success)) {
+
+		px4_usleep(1_ms);
+		_dataman_client1.update();
+
+		if (hrt_elapsed_time(&start_time) > 2_s) {
+			PX4_ERR("Test timeout!");
+			return false;
+		}
+	}
+
+	if (!success) {
+		PX4_ERR("batch read failed");
+		return false;
+	}
+
+	for (uint8_t i = 0; i < count; ++i) {
+		for (uint32_t j = 0; j < DM_MAX_DATA_SIZE; ++j) {
+			if (batch_data[i][j] != first_index + i + uniq_number) {
+				PX4_ERR("Wrong data recived %" PRIu8" , expected %" PRIu32, batch_data[i][j], first_index + i + uniq_number);
+				return false;
+			}
+		}
+	}
+
+	// a batch reaching past the last index fails
+	if (!_dataman_client1.readBatchAsync(item, _max_index[item] - 1, 2, buffers, DM_MAX_DATA_SIZE)) {
+		return false;
+	}
+
+	start_time = hrt_absolute_time();
+
+	while (!_dataman_client1.lastOperationCompleted(success)) {
+
+		px4_usleep(1_ms);
+		_dataman_client1.update();
+
+		if (hrt_elapsed_time(&start_time) > 2_s) {
+			PX4_ERR("Test timeout!");
+			return false;
+		}
+	}
+
+	return !success;
+}
+
+bool
+DatamanTest::testCachePrefetch()
+{
+	dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_0;
+	uint32_t uniq_number = 41;
+	uint32_t num_items = 20;
+
+	for (uint32_t index = 0; index < num_items; ++index) {
+		memset(_buffer_write, index + uniq_number, sizeof(_buffer_write));
+
+		if (!_dataman_cache.client().writeSync(item, index, _buffer_write, sizeof(_buffer_write))) {
+			return false;
+		}
+	}
+
+	const uint32_t cache_size = 12;
+	_dataman_cache.resize(cache_size);
+	_dataman_cache.setGeneration(1);
+
+	// forward and reverse, each one spanning several batches
+	for (int direction = 0; direction < 2; ++direction) {
+		const bool reverse = (direction == 1);
+		const uint32_t first_index = reverse ? num_items - 1 : 0;
+
+		if (_dataman_cache.prefetch(item, first_index, cache_size, reverse) != cache_size) {
+			PX4_ERR("prefetch failed");
+			return false;
+		}
+
+		hrt_abstime start_time = hrt_absolute_time();
+
+		while (_dataman_cache.isLoading()) {
+
+			px4_usleep(1_ms);
+			_dataman_cache.update();
+
+			if (hrt_elapsed_time(&start_time) > 2_s) {
+				PX4_ERR("Test timeout!");
+				return false;
+			}
+		}
+
+		for (uint32_t i = 0; i < cache_size; ++i) {
+			const uint32_t index = reverse ? first_index - i : first_index + i;
+
+			if (!_dataman_cache.loadWait(item, index, _buffer_read, sizeof(_buffer_read))) {
+				PX4_ERR("Failed loadWait at index %" PRIu32, index);
+				return false;
+			}
+
+			if (_buffer_read[0] != index + uniq_number) {
+				PX4_ERR("Wrong data recived %" PRIu8" , expected %" PRIu32, _buffer_read[0], index + uniq_number);
+				return false;
+			}
+		}
+
+		// same generation keeps the data, a new one drops it
+		if (_dataman_cache.setGeneration(1 + direction)) {
+			PX4_ERR("cache invalidated for the same generation");
+			return false;
+		}
+
+		if (!_dataman_cache.setGeneration(2 + direction)) {
+			PX4_ERR("cache not invalidated for a new generation");
+			return false;
+		}
+
+		if (_dataman_cache.loadWait(item, first_index, _buffer_read, sizeof(_buffer_read))) {
+			PX4_ERR("loadWait unexpectedly succeeded after generation change");
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool
 DatamanTest::testResetItems()
 {
@@ -990,8 +1176,216 @@ DatamanTest::testResetItems()
 	return success;
 }
 
+bool
+DatamanTest::writePattern(dm_item_t item, uint32_t index, uint8_t seed)
+{
+	for (uint32_t i = 0; i < g_per_item_size[item]; ++i) {
+		_buffer_write[i] = (uint8_t)(seed + i);
+	}
+
+	if (!_dataman_client1.writeSync(item, index, _buffer_write, g_per_item_size[item])) {
+		PX4_ERR("writeSync failed at item = %" PRIu8 ", index = %" PRIu32, (uint8_t)item, index);
+		return false;
+	}
+
+	return true;
+}
+
+bool
+DatamanTest::checkPattern(dm_item_t item, uint32_t index, uint8_t seed)
+{
+	memset(_buffer_read, 0xff, sizeof(_buffer_read));
+
+	if (!_dataman_client1.readSync(item, index, _buffer_read, g_per_item_size[item])) {
+		PX4_ERR("readSync failed at item = %" PRIu8 ", index = %" PRIu32, (uint8_t)item, index);
+		return false;
+	}
+
+	for (uint32_t i = 0; i < g_per_item_size[item]; ++i) {
+		// a cleared item reads as zeros
+		const uint8_t expected_value = (seed == 0) ? 0 : (uint8_t)(seed + i);
+
+		if (_buffer_read[i] != expected_value) {
+			PX4_ERR("wrong data at item = %" PRIu8 ", index = %" PRIu32 ", element = %" PRIu32 ", expected: %" PRIu8
+				", received: %" PRIu8, (uint8_t)item, index, i, expected_value, _buffer_read[i]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+DatamanTest::evictBackendCache()
+{
+	// each read of an item that is not cached replaces the least recently used entry of the backend cache
+	const uint32_t count = math::min(2 * BACKEND_CACHE_ITEMS + 1, (uint32_t)_max_index[DM_KEY_WAYPOINTS_OFFBOARD_1]);
+
+	for (uint32_t index = 0; index < count; ++index) {
+		if (!_dataman_client1.readSync(DM_KEY_WAYPOINTS_OFFBOARD_1, index, _buffer_read,
+					       g_per_item_size[DM_KEY_WAYPOINTS_OFFBOARD_1])) {
+			PX4_ERR("readSync failed at index = %" PRIu32, index);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+DatamanTest::testWriteBehindEviction()
+{
+	const dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_0;
+
+	// more pending items than the cache holds, the least recently used ones are written out to make room
+	const uint32_t count = math::min(2 * BACKEND_CACHE_ITEMS + 1, (uint32_t)_max_index[item]);
+
+	for (uint32_t index = 0; index < count; ++index) {
+		if (!writePattern(item, index, (uint8_t)(index + 1))) {
+			return false;
+		}
+	}
+
+	for (uint32_t index = 0; index < count; ++index) {
+		if (!checkPattern(item, index, (uint8_t)(index + 1))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+DatamanTest::testWriteBehindFlush()
+{
+	const dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_0;
+
+	// flushed after at most 500 ms: the entry is then clean, and evicting it must not lose it
+	if (!writePattern(item, 0, 0x55)) {
+		return false;
+	}
+
+	px4_usleep(1_s);
+
+	if (!evictBackendCache() || !checkPattern(item, 0, 0x55)) {
+		return false;
+	}
+
+	// flushed before a write-through item is written
+	if (!writePattern(item, 1, 0x66) || !writePattern(DM_KEY_SAFE_POINTS_0, 0, 0x67)) {
+		return false;
+	}
+
+	if (!evictBackendCache() || !checkPattern(item, 1, 0x66) || !checkPattern(DM_KEY_SAFE_POINTS_0, 0, 0x67)) {
+		return false;
+	}
+
+	return true;
+}
+
+bool
+DatamanTest::testClearPendingWrites()
+{
+	const dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_0;
+	const uint32_t count = 4;
+
+	for (uint32_t index = 0; index < count; ++index) {
+		if (!writePattern(item, index, (uint8_t)(0x70 + index))) {
+			return false;
+		}
+	}
+
+	if (!_dataman_client1.clearSync(item)) {
+		PX4_ERR("clearSync failed");
+		return false;
+	}
+
+	for (uint32_t index = 0; index < count; ++index) {
+		if (!checkPattern(item, index, 0)) {
+			return false;
+		}
+	}
+
+	// the writes dropped by the clear must not reach the storage with a later flush
+	px4_usleep(1_s);
+
+	if (!evictBackendCache()) {
+		return false;
+	}
+
+	for (uint32_t index = 0; index < count; ++index) {
+		if (!checkPattern(item, index, 0)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+DatamanTest::testPersistenceCheck()
+{
+	const dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_1;
+
+	if (!_dataman_client1.readSync(item, PERSISTENCE_ITEMS, _buffer_read, g_per_item_size[item])) {
+		PX4_ERR("readSync failed");
+		return false;
+	}
+
+	uint32_t magic;
+	memcpy(&magic, _buffer_read, sizeof(magic));
+
+	if (magic != PERSISTENCE_MAGIC) {
+		PX4_INFO("no data of a previous run");
+		return true;
+	}
+
+	// the marker is written last, so the items of the previous run must be complete
+	const uint8_t seed = _buffer_read[sizeof(magic)];
+
+	for (uint32_t index = 0; index < PERSISTENCE_ITEMS; ++index) {
+		if (!checkPattern(item, index, (uint8_t)(seed + index))) {
+			return false;
+		}
+	}
+
+	_persistence_seed = (uint8_t)(seed + PERSISTENCE_ITEMS);
+	return true;
+}
+
+bool
+DatamanTest::testPersistenceWrite()
+{
+	const dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_1;
+
+	// seeds change from run to run, and skip 0 which is the pattern of a cleared item
+	if (_persistence_seed == 0 || (uint8_t)(_persistence_seed + PERSISTENCE_ITEMS) < _persistence_seed) {
+		_persistence_seed = 1;
+	}
+
+	for (uint32_t index = 0; index < PERSISTENCE_ITEMS; ++index) {
+		if (!writePattern(item, index, (uint8_t)(_persistence_seed + index))) {
+			return false;
+		}
+	}
+
+	// written behind like the items, at a higher file offset, so it is flushed after them
+	memset(_buffer_write, 0, sizeof(_buffer_write));
+	memcpy(_buffer_write, &PERSISTENCE_MAGIC, sizeof(PERSISTENCE_MAGIC));
+	_buffer_write[sizeof(PERSISTENCE_MAGIC)] = _persistence_seed;
+
+	if (!_dataman_client1.writeSync(item, PERSISTENCE_ITEMS, _buffer_write, g_per_item_size[item])) {
+		PX4_ERR("writeSync failed");
+		return false;
+	}
+
+	return true;
+}
+
 bool DatamanTest::run_tests()
 {
+	ut_run_test(testPersistenceCheck);
+
 	ut_run_test(testSyncReadInvalidIndex);
 	ut_run_test(testSyncWriteInvalidIndex);
 	ut_run_test(testSyncReadBufferOverflow);
@@ -1007,11 +1401,19 @@ bool DatamanTest::run_tests()
 	ut_run_test(testAsyncMutipleClients);
 	ut_run_test(testAsyncWriteReadAllItemsMaxSize);
 	ut_run_test(testAsyncClearAll);
+	ut_run_test(testAsyncReadBatch);
 
 	ut_run_test(testCache);
+	ut_run_test(testCachePrefetch);
+
+	ut_run_test(testWriteBehindEviction);
+	ut_run_test(testWriteBehindFlush);
+	ut_run_test(testClearPendingWrites);
 
 	ut_run_test(testResetItems);
 
+	ut_run_test(testPersistenceWrite);
+
 	return (_tests_failed == 0);
 }
 
@@ -90,6 +90,7 @@ const struct {
 	{"IntrusiveQueue",	test_IntrusiveQueue,	0},
 	{"IntrusiveSortedList",	test_IntrusiveSortedList, 0},
 	{"List",		test_List,		0},
+	{"LockFreeByteRing",	test_LockFreeByteRing,	0},
 	{"mathlib",		test_mathlib,		0},
 	{"matrix",		test_matrix,		0},
 	{"param",		test_param,		0},
@@ -58,6 +58,7 @@ extern int test_IntrusiveQueue(int argc, char *argv[]);
 extern int test_led(int argc, char *argv[]);
 extern int test_IntrusiveSortedList(int argc, char *argv[]);
 extern int test_List(int argc, char *argv[]);
+extern int test_LockFreeByteRing(int argc, char *argv[]);
 extern int test_mathlib(int argc, char *argv[]);
 extern int test_matrix(int argc, char *argv[]);
 extern int test_mount(int argc, char *argv[]);
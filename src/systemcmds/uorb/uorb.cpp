@@ -31,6 +31,7 @@
  *
  ****************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <uORB/uORB.h>
@@ -57,6 +58,24 @@ int uorb_main(int argc, char *argv[])
 
 	} else if (!strcmp(argv[1], "top")) {
 		return uorb_top(argv + 2, argc - 2);
+
+	} else if (!strcmp(argv[1], "memory")) {
+		return uorb_memory();
+
+	} else if (!strcmp(argv[1], "queue")) {
+		if (argc < 4) {
+			usage();
+			return -1;
+		}
+
+		const int instance = (argc > 4) ? atoi(argv[4]) : 0;
+
+		if ((instance < 0) || (instance >= ORB_MULTI_MAX_INSTANCES)) {
+			PX4_ERR("invalid instance %i", instance);
+			return -1;
+		}
+
+		return uorb_queue(argv[2], instance, strtoul(argv[3], nullptr, 10));
 	}
 
 	usage();
@@ -84,6 +103,14 @@ modules are allowed to publish which topics. This is used for system-wide replay
 ### Examples
 Monitor topic publication rates. Besides `top`, this is an important command for general system inspection:
 $ uorb top
+
+The SKIP column of `uorb status` shows the largest number of messages a subscriber lost at once, because
+it did not keep up with the queue depth. Use it together with `uorb queue` to size the queues:
+$ uorb queue vehicle_command 8
+
+`uorb memory` lists the message buffer memory per topic (queue depth * message size, summed over the
+instances), largest first. Together with `heap_usage status`, `work_queue status` (stack usage per WorkItem)
+and the `bloaty_ram` build target (static RAM per compile unit) it shows where the RAM goes.
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("uorb", "communication");
@@ -91,5 +118,9 @@ $ uorb top
 	PRINT_MODULE_USAGE_COMMAND_DESCR("top", "Monitor topic publication rates");
 	PRINT_MODULE_USAGE_PARAM_FLAG('a', "print all instead of only currently publishing topics with subscribers", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('1', "run only once, then exit", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('l', "print publish to callback wakeup latency (requires CONFIG_ORB_LATENCY_HISTOGRAM)", true);
 	PRINT_MODULE_USAGE_ARG("<filter1> [<filter2>]", "topic(s) to match (implies -a)", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("memory", "Print the message buffer memory per topic");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("queue", "Change the queue depth of an existing topic instance");
+	PRINT_MODULE_USAGE_ARG("<topic> <depth> [<instance>]", "topic name, new queue depth (power of 2) and instance (default 0)", false);
 }